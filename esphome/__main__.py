@@ -1,15 +1,21 @@
 import argparse
 import functools
+import hashlib
 import logging
+import math
 import os
+import shutil
+import subprocess
 import sys
+import threading
+import time
 from datetime import datetime
 
-from esphome import const, writer, yaml_util
+from esphome import config_cache, const, writer, yaml_util
 import esphome.codegen as cg
 from esphome.config import iter_components, read_config, strip_default_ids
 from esphome.const import CONF_BAUD_RATE, CONF_BROKER, CONF_LOGGER, CONF_OTA, \
-    CONF_PASSWORD, CONF_PORT, CONF_ESPHOME, CONF_PLATFORMIO_OPTIONS
+    CONF_PASSWORD, CONF_PORT, CONF_ESPHOME, CONF_PLATFORMIO_OPTIONS, CONF_SPLIT_SETUP
 from esphome.core import CORE, EsphomeError, coroutine, coroutine_with_priority
 from esphome.helpers import color, indent
 from esphome.util import run_external_command, run_external_process, safe_print, list_yaml_files, \
@@ -137,8 +143,12 @@ def generate_cpp_contents(config):
 def write_cpp_file():
     writer.write_platformio_project()
 
-    code_s = indent(CORE.cpp_main_section)
-    writer.write_cpp(code_s)
+    if CORE.config[CONF_ESPHOME][CONF_SPLIT_SETUP]:
+        writer.write_split_cpp()
+    else:
+        writer.remove_split_setup_sources()
+        code_s = indent(CORE.cpp_main_section)
+        writer.write_cpp(code_s)
     return 0
 
 
@@ -189,10 +199,20 @@ def upload_program(config, args, host):
         raise EsphomeError("Cannot upload Over the Air as the config does not include the ota: "
                            "component")
 
+    from esphome.storage_json import StorageJSON, ota_base_path, storage_path
+
     ota_conf = config[CONF_OTA]
     remote_port = ota_conf[CONF_PORT]
     password = ota_conf[CONF_PASSWORD]
-    return espota2.run_ota(host, remote_port, password, CORE.firmware_bin)
+    storage = StorageJSON.load(storage_path())
+    base = storage.ota_base_bin_path if storage is not None else None
+    rc = espota2.run_ota(host, remote_port, password, CORE.firmware_bin, base)
+    if rc == 0 and storage is not None:
+        # The ESP runs this image now, the next upload can be a delta to it
+        storage.ota_base_bin_path = ota_base_path()
+        shutil.copyfile(CORE.firmware_bin, storage.ota_base_bin_path)
+        storage.save(storage_path())
+    return rc
 
 
 def show_logs(config, args, port):
@@ -202,6 +222,10 @@ def show_logs(config, args, port):
         run_miniterm(config, port)
         return 0
     if get_port_type(port) == 'NETWORK' and 'api' in config:
+        if getattr(args, 'stored', False):
+            from esphome.api.client import run_stored_logs
+
+            return run_stored_logs(config, port)
         from esphome.api.client import run_logs
 
         return run_logs(config, port)
@@ -261,14 +285,29 @@ def command_wizard(args):
     return wizard.wizard(args.configuration[0])
 
 
+def get_substitutions(args):
+    return dict(args.substitution) if args.substitution else {}
+
+
 def command_config(args, config):
     _LOGGER.info("Configuration is valid!")
     if not CORE.verbose:
         config = strip_default_ids(config)
-    safe_print(yaml_util.dump(config))
+    dump = yaml_util.dump(config)
+    if not CORE.verbose:
+        config_cache.store(get_substitutions(args), config=dump)
+    safe_print(dump)
     return 0
 
 
+def command_config_cached(args, cached):
+    if CORE.verbose or 'config' not in cached:
+        return False
+    _LOGGER.info("Configuration is valid! (unchanged since the last validation)")
+    safe_print(cached['config'])
+    return True
+
+
 def command_vscode(args):
     from esphome import vscode
 
@@ -276,7 +315,24 @@ def command_vscode(args):
     vscode.read_config(args)
 
 
+def get_config_hash(config):
+    # The version is part of the hash, another esphome version generates other code.
+    # Not stripped of the default ids, that would modify the config that is compiled.
+    dump = yaml_util.dump(config)
+    return hashlib.sha256(f'{const.__version__}\n{dump}'.encode()).hexdigest()
+
+
 def command_compile(args, config):
+    from esphome.storage_json import StorageJSON, storage_path
+
+    config_hash = get_config_hash(config)
+    config_cache.store(get_substitutions(args), config_hash=config_hash)
+    if args.if_changed and not args.only_generate:
+        storage = StorageJSON.load(storage_path())
+        if storage is not None and storage.config_hash == config_hash and \
+                os.path.isfile(CORE.firmware_bin):
+            _LOGGER.info("Configuration is unchanged since the last build, skipping compile.")
+            return 0
     exit_code = write_cpp(config)
     if exit_code != 0:
         return exit_code
@@ -286,10 +342,27 @@ def command_compile(args, config):
     exit_code = compile_program(args, config)
     if exit_code != 0:
         return exit_code
+    storage = StorageJSON.load(storage_path())
+    if storage is not None:
+        storage.config_hash = config_hash
+        storage.save(storage_path())
     _LOGGER.info("Successfully compiled program.")
     return 0
 
 
+def command_compile_cached(args, cached):
+    from esphome.storage_json import StorageJSON, storage_path
+
+    if not args.if_changed or args.only_generate or 'config_hash' not in cached:
+        return False
+    storage = StorageJSON.load(storage_path())
+    if storage is None or storage.config_hash != cached['config_hash'] or \
+            storage.firmware_bin_path is None or not os.path.isfile(storage.firmware_bin_path):
+        return False
+    _LOGGER.info("Configuration is unchanged since the last build, skipping validation and compile.")
+    return True
+
+
 def command_upload(args, config):
     port = choose_upload_log_host(default=args.upload_port, check_default=None,
                                   show_ota=True, show_mqtt=False, show_api=False)
@@ -358,12 +431,35 @@ def command_dashboard(args):
     return dashboard.start_web_server(args)
 
 
+def parse_update_stages(value):
+    try:
+        stages = [float(x) for x in value.split(',')]
+    except ValueError as err:
+        raise argparse.ArgumentTypeError(f"Invalid stages '{value}'") from err
+    if not stages or any(not 0 < x <= 100 for x in stages) or stages != sorted(stages):
+        raise argparse.ArgumentTypeError("Stages must be increasing percentages up to 100")
+    if stages[-1] != 100:
+        stages.append(100)
+    return stages
+
+
 def command_update_all(args):
+    """Compile and upload all configurations in a folder.
+
+    The configurations are compiled one after another, compiles of unchanged configurations are
+    skipped. Up to upload_workers uploads run concurrently with that, their output is printed once
+    they are done. With stages the devices are updated in waves of the given cumulative percentages,
+    a wave with a failure stops the rollout.
+    """
+    from concurrent.futures import ThreadPoolExecutor
     import click
 
-    success = {}
     files = list_yaml_files(args.configuration[0])
     twidth = 60
+    stats = {f: {'status': 'SKIPPED'} for f in files}
+    print_lock = threading.Lock()
+    # With concurrent uploads every step runs in the background and its output is printed at once
+    capture = args.upload_workers > 1
 
     def print_bar(middle_text):
         middle_text = f" {middle_text} "
@@ -371,31 +467,72 @@ def command_update_all(args):
         half_line = "=" * ((twidth - width) // 2)
         click.echo(f"{half_line}{middle_text}{half_line}")
 
-    for f in files:
-        print("Updating {}".format(color('cyan', f)))
-        print('-' * twidth)
-        print()
-        rc = run_external_process('esphome', '--dashboard', f, 'run', '--no-logs', '--upload-port',
-                                  'OTA')
-        if rc == 0:
-            print_bar("[{}] {}".format(color('bold_green', 'SUCCESS'), f))
-            success[f] = True
+    def run_step(f, step, *cmd):
+        start = time.time()
+        if not capture:
+            print("{} {}".format(color('cyan', f), step))
+            print('-' * twidth)
+        if capture:
+            proc = subprocess.run(['esphome', '--dashboard', f] + list(cmd), stdout=subprocess.PIPE,
+                                  stderr=subprocess.STDOUT, check=False)
+            rc, output = proc.returncode, proc.stdout.decode(errors='replace')
         else:
-            print_bar("[{}] {}".format(color('bold_red', 'ERROR'), f))
-            success[f] = False
-
-        print()
-        print()
-        print()
+            rc, output = run_external_process('esphome', '--dashboard', f, *cmd), None
+        stats[f][step] = time.time() - start
+        with print_lock:
+            if output is not None:
+                print("{} {}".format(color('cyan', f), step))
+                print('-' * twidth)
+                print(output)
+            if rc == 0:
+                print_bar("[{}] {} {}".format(color('bold_green', 'SUCCESS'), step, f))
+            else:
+                print_bar("[{}] {} {}".format(color('bold_red', 'ERROR'), step, f))
+            print()
+        return rc == 0
+
+    def upload(f):
+        ok = run_step(f, 'upload', 'upload', '--upload-port', 'OTA')
+        stats[f]['status'] = 'SUCCESS' if ok else 'FAILED'
+        return ok
+
+    done = 0
+    for percentage in args.stages:
+        end = max(done + 1, math.ceil(len(files) * percentage / 100.0))
+        wave = files[done:end]
+        if not wave:
+            continue
+        if len(args.stages) > 1:
+            print_bar('[{}]'.format(color('bold_white', f'STAGE {percentage:g}%: {len(wave)} DEVICES')))
+        with ThreadPoolExecutor(max_workers=args.upload_workers) as executor:
+            for f in wave:
+                if not run_step(f, 'compile', 'compile', '--if-changed'):
+                    stats[f]['status'] = 'FAILED'
+                elif capture:
+                    executor.submit(upload, f)
+                else:
+                    upload(f)
+        done = end
+        if any(stats[f]['status'] == 'FAILED' for f in wave) and done < len(files):
+            print_bar('[{}]'.format(color('bold_red', 'STAGE FAILED, STOPPING ROLLOUT')))
+            break
 
     print_bar('[{}]'.format(color('bold_white', 'SUMMARY')))
     failed = 0
     for f in files:
-        if success[f]:
-            print("  - {}: {}".format(f, color('green', 'SUCCESS')))
-        else:
-            print("  - {}: {}".format(f, color('bold_red', 'FAILED')))
+        stat = stats[f]
+        times = ', '.join(f'{step} {stat[step]:.1f}s' for step in ('compile', 'upload') if step in stat)
+        status = stat['status']
+        if status == 'SUCCESS':
+            status = color('green', status)
+        elif status == 'FAILED':
+            status = color('bold_red', status)
             failed += 1
+        print("  - {}: {}{}".format(f, status, f' ({times})' if times else ''))
+    uploads = [stats[f]['upload'] for f in files if 'upload' in stats[f]]
+    if uploads:
+        print("  Uploads took {:.1f}s on average, {:.1f}s at most".format(
+            sum(uploads) / len(uploads), max(uploads)))
     return failed
 
 
@@ -418,6 +555,13 @@ POST_CONFIG_ACTIONS = {
     'clean': command_clean,
 }
 
+# Commands that can skip loading the configuration if it's unchanged, see config_cache.
+# They return whether the cached results were enough.
+CACHED_CONFIG_ACTIONS = {
+    'config': command_config_cached,
+    'compile': command_compile_cached,
+}
+
 
 def parse_args(argv):
     parser = argparse.ArgumentParser(description=f'ESPHome v{const.__version__}')
@@ -439,6 +583,10 @@ def parse_args(argv):
     parser_compile.add_argument('--only-generate',
                                 help="Only generate source code, do not compile.",
                                 action='store_true')
+    parser_compile.add_argument('--if-changed',
+                                help="Skip compiling if the configuration is unchanged since the "
+                                     "last build.",
+                                action='store_true')
 
     parser_upload = subparsers.add_parser('upload', help='Validate the configuration '
                                                          'and upload the latest binary.')
@@ -453,6 +601,9 @@ def parse_args(argv):
     parser_logs.add_argument('--client-id', help='Manually set the client id.')
     parser_logs.add_argument('--serial-port', help="Manually specify a serial port to use"
                                                    "For example /dev/cu.SLAB_USBtoUART.")
+    parser_logs.add_argument('--stored', action='store_true',
+                             help="Download the logs kept by persistent_log instead of following "
+                                  "the live logs.")
 
     parser_run = subparsers.add_parser('run', help='Validate the configuration, create a binary, '
                                                    'upload it, and start MQTT logs.')
@@ -498,11 +649,23 @@ def parse_args(argv):
                            action="store_true")
     dashboard.add_argument("--socket",
                            help="Make the dashboard serve under a unix socket", type=str)
+    dashboard.add_argument("--update-workers", help="The number of concurrent uploads of "
+                                                    "'Update All'. Defaults to 1.",
+                           type=int, default=1)
+    dashboard.add_argument("--update-stages", help="The cumulative percentages of the devices "
+                                                   "'Update All' updates in waves, for example "
+                                                   "10,50,100. Defaults to 100.",
+                           type=str, default='100')
 
     vscode = subparsers.add_parser('vscode', help=argparse.SUPPRESS)
     vscode.add_argument('--ace', action='store_true')
 
-    subparsers.add_parser('update-all', help=argparse.SUPPRESS)
+    update_all = subparsers.add_parser('update-all', help=argparse.SUPPRESS)
+    update_all.add_argument('--upload-workers', help="The number of concurrent uploads.",
+                            type=int, default=1)
+    update_all.add_argument('--stages', help="Update in waves of these cumulative percentages of "
+                                             "the devices, for example 10,50,100.",
+                            type=parse_update_stages, default=[100.0])
 
     return parser.parse_args(argv[1:])
 
@@ -532,7 +695,13 @@ def run_esphome(argv):
         CORE.config_path = conf_path
         CORE.dashboard = args.dashboard
 
-        config = read_config(dict(args.substitution) if args.substitution else {})
+        if args.command in CACHED_CONFIG_ACTIONS:
+            cached = config_cache.load(get_substitutions(args))
+            if cached is not None and CACHED_CONFIG_ACTIONS[args.command](args, cached):
+                CORE.reset()
+                continue
+
+        config = read_config(get_substitutions(args))
         if config is None:
             return 1
         CORE.config = config
@@ -21,9 +21,86 @@ DESCRIPTOR = _descriptor.FileDescriptor(
   package='',
   syntax='proto3',
   serialized_options=None,
-  serialized_pb=_b('\n\tapi.proto\"#\n\x0cHelloRequest\x12\x13\n\x0b\x63lient_info\x18\x01 \x01(\t\"Z\n\rHelloResponse\x12\x19\n\x11\x61pi_version_major\x18\x01 \x01(\r\x12\x19\n\x11\x61pi_version_minor\x18\x02 \x01(\r\x12\x13\n\x0bserver_info\x18\x03 \x01(\t\"\"\n\x0e\x43onnectRequest\x12\x10\n\x08password\x18\x01 \x01(\t\"+\n\x0f\x43onnectResponse\x12\x18\n\x10invalid_password\x18\x01 \x01(\x08\"\x13\n\x11\x44isconnectRequest\"\x14\n\x12\x44isconnectResponse\"\r\n\x0bPingRequest\"\x0e\n\x0cPingResponse\"\x13\n\x11\x44\x65viceInfoRequest\"\xad\x01\n\x12\x44\x65viceInfoResponse\x12\x15\n\ruses_password\x18\x01 \x01(\x08\x12\x0c\n\x04name\x18\x02 \x01(\t\x12\x13\n\x0bmac_address\x18\x03 \x01(\t\x12\x1c\n\x14\x65sphome_core_version\x18\x04 \x01(\t\x12\x18\n\x10\x63ompilation_time\x18\x05 \x01(\t\x12\r\n\x05model\x18\x06 \x01(\t\x12\x16\n\x0ehas_deep_sleep\x18\x07 \x01(\x08\"\x15\n\x13ListEntitiesRequest\"\x9a\x01\n ListEntitiesBinarySensorResponse\x12\x11\n\tobject_id\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\x07\x12\x0c\n\x04name\x18\x03 \x01(\t\x12\x11\n\tunique_id\x18\x04 \x01(\t\x12\x14\n\x0c\x64\x65vice_class\x18\x05 \x01(\t\x12\x1f\n\x17is_status_binary_sensor\x18\x06 \x01(\x08\"s\n\x19ListEntitiesCoverResponse\x12\x11\n\tobject_id\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\x07\x12\x0c\n\x04name\x18\x03 \x01(\t\x12\x11\n\tunique_id\x18\x04 \x01(\t\x12\x15\n\ris_optimistic\x18\x05 \x01(\x08\"\x90\x01\n\x17ListEntitiesFanResponse\x12\x11\n\tobject_id\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\x07\x12\x0c\n\x04name\x18\x03 \x01(\t\x12\x11\n\tunique_id\x18\x04 \x01(\t\x12\x1c\n\x14supports_oscillation\x18\x05 \x01(\x08\x12\x16\n\x0esupports_speed\x18\x06 \x01(\x08\"\x8a\x02\n\x19ListEntitiesLightResponse\x12\x11\n\tobject_id\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\x07\x12\x0c\n\x04name\x18\x03 \x01(\t\x12\x11\n\tunique_id\x18\x04 \x01(\t\x12\x1b\n\x13supports_brightness\x18\x05 \x01(\x08\x12\x14\n\x0csupports_rgb\x18\x06 \x01(\x08\x12\x1c\n\x14supports_white_value\x18\x07 \x01(\x08\x12\"\n\x1asupports_color_temperature\x18\x08 \x01(\x08\x12\x12\n\nmin_mireds\x18\t \x01(\x02\x12\x12\n\nmax_mireds\x18\n \x01(\x02\x12\x0f\n\x07\x65\x66\x66\x65\x63ts\x18\x0b \x03(\t\"\xa3\x01\n\x1aListEntitiesSensorResponse\x12\x11\n\tobject_id\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\x07\x12\x0c\n\x04name\x18\x03 \x01(\t\x12\x11\n\tunique_id\x18\x04 \x01(\t\x12\x0c\n\x04icon\x18\x05 \x01(\t\x12\x1b\n\x13unit_of_measurement\x18\x06 \x01(\t\x12\x19\n\x11\x61\x63\x63uracy_decimals\x18\x07 \x01(\x05\"\x7f\n\x1aListEntitiesSwitchResponse\x12\x11\n\tobject_id\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\x07\x12\x0c\n\x04name\x18\x03 \x01(\t\x12\x11\n\tunique_id\x18\x04 \x01(\t\x12\x0c\n\x04icon\x18\x05 \x01(\t\x12\x12\n\noptimistic\x18\x06 \x01(\x08\"o\n\x1eListEntitiesTextSensorResponse\x12\x11\n\tobject_id\x18\x01 \x01(\t\x12\x0b\n\x03key\x18\x02 \x01(\x07\x12\x0c\n\x04name\x18\x03 \x01(\t\x12\x11\n\tunique_id\x18\x04 \x01(\t\x12\x0c\n\x04icon\x18\x05 \x01(\t\"\x1a\n\x18ListEntitiesDoneResponse\"\x18\n\x16SubscribeStatesRequest\"7\n\x19\x42inarySensorStateResponse\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\r\n\x05state\x18\x02 \x01(\x08\"t\n\x12\x43overStateResponse\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12-\n\x05state\x18\x02 \x01(\x0e\x32\x1e.CoverStateResponse.CoverState\"\"\n\nCoverState\x12\x08\n\x04OPEN\x10\x00\x12\n\n\x06\x43LOSED\x10\x01\"]\n\x10\x46\x61nStateResponse\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\r\n\x05state\x18\x02 \x01(\x08\x12\x13\n\x0boscillating\x18\x03 \x01(\x08\x12\x18\n\x05speed\x18\x04 \x01(\x0e\x32\t.FanSpeed\"\xa8\x01\n\x12LightStateResponse\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\r\n\x05state\x18\x02 \x01(\x08\x12\x12\n\nbrightness\x18\x03 \x01(\x02\x12\x0b\n\x03red\x18\x04 \x01(\x02\x12\r\n\x05green\x18\x05 \x01(\x02\x12\x0c\n\x04\x62lue\x18\x06 \x01(\x02\x12\r\n\x05white\x18\x07 \x01(\x02\x12\x19\n\x11\x63olor_temperature\x18\x08 \x01(\x02\x12\x0e\n\x06\x65\x66\x66\x65\x63t\x18\t \x01(\t\"1\n\x13SensorStateResponse\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\r\n\x05state\x18\x02 \x01(\x02\"1\n\x13SwitchStateResponse\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\r\n\x05state\x18\x02 \x01(\x08\"5\n\x17TextSensorStateResponse\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\r\n\x05state\x18\x02 \x01(\t\"\x98\x01\n\x13\x43overCommandRequest\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\x11\n\thas_state\x18\x02 \x01(\x08\x12\x32\n\x07\x63ommand\x18\x03 \x01(\x0e\x32!.CoverCommandRequest.CoverCommand\"-\n\x0c\x43overCommand\x12\x08\n\x04OPEN\x10\x00\x12\t\n\x05\x43LOSE\x10\x01\x12\x08\n\x04STOP\x10\x02\"\x9d\x01\n\x11\x46\x61nCommandRequest\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\x11\n\thas_state\x18\x02 \x01(\x08\x12\r\n\x05state\x18\x03 \x01(\x08\x12\x11\n\thas_speed\x18\x04 \x01(\x08\x12\x18\n\x05speed\x18\x05 \x01(\x0e\x32\t.FanSpeed\x12\x17\n\x0fhas_oscillating\x18\x06 \x01(\x08\x12\x13\n\x0boscillating\x18\x07 \x01(\x08\"\x95\x03\n\x13LightCommandRequest\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\x11\n\thas_state\x18\x02 \x01(\x08\x12\r\n\x05state\x18\x03 \x01(\x08\x12\x16\n\x0ehas_brightness\x18\x04 \x01(\x08\x12\x12\n\nbrightness\x18\x05 \x01(\x02\x12\x0f\n\x07has_rgb\x18\x06 \x01(\x08\x12\x0b\n\x03red\x18\x07 \x01(\x02\x12\r\n\x05green\x18\x08 \x01(\x02\x12\x0c\n\x04\x62lue\x18\t \x01(\x02\x12\x11\n\thas_white\x18\n \x01(\x08\x12\r\n\x05white\x18\x0b \x01(\x02\x12\x1d\n\x15has_color_temperature\x18\x0c \x01(\x08\x12\x19\n\x11\x63olor_temperature\x18\r \x01(\x02\x12\x1d\n\x15has_transition_length\x18\x0e \x01(\x08\x12\x19\n\x11transition_length\x18\x0f \x01(\r\x12\x18\n\x10has_flash_length\x18\x10 \x01(\x08\x12\x14\n\x0c\x66lash_length\x18\x11 \x01(\r\x12\x12\n\nhas_effect\x18\x12 \x01(\x08\x12\x0e\n\x06\x65\x66\x66\x65\x63t\x18\x13 \x01(\t\"2\n\x14SwitchCommandRequest\x12\x0b\n\x03key\x18\x01 \x01(\x07\x12\r\n\x05state\x18\x02 \x01(\x08\"E\n\x14SubscribeLogsRequest\x12\x18\n\x05level\x18\x01 \x01(\x0e\x32\t.LogLevel\x12\x13\n\x0b\x64ump_config\x18\x02 \x01(\x08\"d\n\x15SubscribeLogsResponse\x12\x18\n\x05level\x18\x01 \x01(\x0e\x32\t.LogLevel\x12\x0b\n\x03tag\x18\x02 \x01(\t\x12\x0f\n\x07message\x18\x03 \x01(\t\x12\x13\n\x0bsend_failed\x18\x04 \x01(\x08\"\x1e\n\x1cSubscribeServiceCallsRequest\"\xdf\x02\n\x13ServiceCallResponse\x12\x0f\n\x07service\x18\x01 \x01(\t\x12,\n\x04\x64\x61ta\x18\x02 \x03(\x0b\x32\x1e.ServiceCallResponse.DataEntry\x12=\n\rdata_template\x18\x03 \x03(\x0b\x32&.ServiceCallResponse.DataTemplateEntry\x12\x36\n\tvariables\x18\x04 \x03(\x0b\x32#.ServiceCallResponse.VariablesEntry\x1a+\n\tDataEntry\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t:\x02\x38\x01\x1a\x33\n\x11\x44\x61taTemplateEntry\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t:\x02\x38\x01\x1a\x30\n\x0eVariablesEntry\x12\x0b\n\x03key\x18\x01 \x01(\t\x12\r\n\x05value\x18\x02 \x01(\t:\x02\x38\x01\"%\n#SubscribeHomeAssistantStatesRequest\"8\n#SubscribeHomeAssistantStateResponse\x12\x11\n\tentity_id\x18\x01 \x01(\t\">\n\x1aHomeAssistantStateResponse\x12\x11\n\tentity_id\x18\x01 \x01(\t\x12\r\n\x05state\x18\x02 \x01(\t\"\x10\n\x0eGetTimeRequest\"(\n\x0fGetTimeResponse\x12\x15\n\repoch_seconds\x18\x01 \x01(\x07*)\n\x08\x46\x61nSpeed\x12\x07\n\x03LOW\x10\x00\x12\n\n\x06MEDIUM\x10\x01\x12\x08\n\x04HIGH\x10\x02*]\n\x08LogLevel\x12\x08\n\x04NONE\x10\x00\x12\t\n\x05\x45RROR\x10\x01\x12\x08\n\x04WARN\x10\x02\x12\x08\n\x04INFO\x10\x03\x12\t\n\x05\x44\x45\x42UG\x10\x04\x12\x0b\n\x07VERBOSE\x10\x05\x12\x10\n\x0cVERY_VERBOSE\x10\x06\x62\x06proto3')
+  serialized_pb=_b('\n\tapi.proto\"/\n\x0cHelloRequest\x12\x1f\n\x0b\x63lient_info\x18\x01 \x01(\tR\nclientInfo\"\xc2\x01\n\rHelloResponse\x12*\n\x11\x61pi_version_major\x18\x01 \x01(\rR\x0f\x61piVersionMajor\x12*\n\x11\x61pi_version_minor\x18\x02 \x01(\rR\x0f\x61piVersionMinor\x12\x1f\n\x0bserver_info\x18\x03 \x01(\tR\nserverInfo\x12\x38\n\x18supports_states_snapshot\x18\x04 \x01(\x08R\x16supportsStatesSnapshot\",\n\x0e\x43onnectRequest\x12\x1a\n\x08password\x18\x01 \x01(\tR\x08password\"<\n\x0f\x43onnectResponse\x12)\n\x10invalid_password\x18\x01 \x01(\x08R\x0finvalidPassword\"\x13\n\x11\x44isconnectRequest\"\x14\n\x12\x44isconnectResponse\"\r\n\x0bPingRequest\"\x0e\n\x0cPingResponse\"\x13\n\x11\x44\x65viceInfoRequest\"\xfe\x01\n\x12\x44\x65viceInfoResponse\x12#\n\ruses_password\x18\x01 \x01(\x08R\x0cusesPassword\x12\x12\n\x04name\x18\x02 \x01(\tR\x04name\x12\x1f\n\x0bmac_address\x18\x03 \x01(\tR\nmacAddress\x12\'\n\x0f\x65sphome_version\x18\x04 \x01(\tR\x0e\x65sphomeVersion\x12)\n\x10\x63ompilation_time\x18\x05 \x01(\tR\x0f\x63ompilationTime\x12\x14\n\x05model\x18\x06 \x01(\tR\x05model\x12$\n\x0ehas_deep_sleep\x18\x07 \x01(\x08R\x0chasDeepSleep\"\x15\n\x13ListEntitiesRequest\"\x1a\n\x18ListEntitiesDoneResponse\"A\n\x16SubscribeStatesRequest\x12\'\n\x0fstates_snapshot\x18\x01 \x01(\x08R\x0estatesSnapshot\"\x92\x04\n\x16StatesSnapshotResponse\x12\x30\n\x12\x62inary_sensor_keys\x18\x01 \x03(\x07\x42\x02\x10\x01R\x10\x62inarySensorKeys\x12\x34\n\x14\x62inary_sensor_states\x18\x02 \x03(\x08\x42\x02\x10\x01R\x12\x62inarySensorStates\x12!\n\ncover_keys\x18\x03 \x03(\x07\x42\x02\x10\x01R\tcoverKeys\x12+\n\x0f\x63over_positions\x18\x04 \x03(\x02\x42\x02\x10\x01R\x0e\x63overPositions\x12#\n\x0b\x63over_tilts\x18\x05 \x03(\x02\x42\x02\x10\x01R\ncoverTilts\x12M\n\x18\x63over_current_operations\x18\x06 \x03(\x0e\x32\x0f.CoverOperationB\x02\x10\x01R\x16\x63overCurrentOperations\x12#\n\x0bsensor_keys\x18\x07 \x03(\x07\x42\x02\x10\x01R\nsensorKeys\x12\'\n\rsensor_states\x18\x08 \x03(\x02\x42\x02\x10\x01R\x0csensorStates\x12#\n\x0bswitch_keys\x18\t \x03(\x07\x42\x02\x10\x01R\nswitchKeys\x12\'\n\rswitch_states\x18\n \x03(\x08\x42\x02\x10\x01R\x0cswitchStates\x12\x30\n\x12missing_state_keys\x18\x0b \x03(\x07\x42\x02\x10\x01R\x10missingStateKeys\"\xdc\x01\n ListEntitiesBinarySensorResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12!\n\x0c\x64\x65vice_class\x18\x05 \x01(\tR\x0b\x64\x65viceClass\x12\x35\n\x17is_status_binary_sensor\x18\x06 \x01(\x08R\x14isStatusBinarySensor\"h\n\x19\x42inarySensorStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x14\n\x05state\x18\x02 \x01(\x08R\x05state\x12#\n\rmissing_state\x18\x03 \x01(\x08R\x0cmissingState\"\x95\x02\n\x19ListEntitiesCoverResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12#\n\rassumed_state\x18\x05 \x01(\x08R\x0c\x61ssumedState\x12+\n\x11supports_position\x18\x06 \x01(\x08R\x10supportsPosition\x12#\n\rsupports_tilt\x18\x07 \x01(\x08R\x0csupportsTilt\x12!\n\x0c\x64\x65vice_class\x18\x08 \x01(\tR\x0b\x64\x65viceClass\"\xca\x01\n\x12\x43overStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x34\n\x0clegacy_state\x18\x02 \x01(\x0e\x32\x11.LegacyCoverStateR\x0blegacyState\x12\x1a\n\x08position\x18\x03 \x01(\x02R\x08position\x12\x12\n\x04tilt\x18\x04 \x01(\x02R\x04tilt\x12<\n\x11\x63urrent_operation\x18\x05 \x01(\x0e\x32\x0f.CoverOperationR\x10\x63urrentOperation\"\x93\x02\n\x13\x43overCommandRequest\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12,\n\x12has_legacy_command\x18\x02 \x01(\x08R\x10hasLegacyCommand\x12:\n\x0elegacy_command\x18\x03 \x01(\x0e\x32\x13.LegacyCoverCommandR\rlegacyCommand\x12!\n\x0chas_position\x18\x04 \x01(\x08R\x0bhasPosition\x12\x1a\n\x08position\x18\x05 \x01(\x02R\x08position\x12\x19\n\x08has_tilt\x18\x06 \x01(\x08R\x07hasTilt\x12\x12\n\x04tilt\x18\x07 \x01(\x02R\x04tilt\x12\x12\n\x04stop\x18\x08 \x01(\x08R\x04stop\"\x82\x02\n\x17ListEntitiesFanResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12\x31\n\x14supports_oscillation\x18\x05 \x01(\x08R\x13supportsOscillation\x12%\n\x0esupports_speed\x18\x06 \x01(\x08R\rsupportsSpeed\x12-\n\x12supports_direction\x18\x07 \x01(\x08R\x11supportsDirection\"\xaa\x01\n\x10\x46\x61nStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x14\n\x05state\x18\x02 \x01(\x08R\x05state\x12 \n\x0boscillating\x18\x03 \x01(\x08R\x0boscillating\x12\x1f\n\x05speed\x18\x04 \x01(\x0e\x32\t.FanSpeedR\x05speed\x12+\n\tdirection\x18\x05 \x01(\x0e\x32\r.FanDirectionR\tdirection\"\xb3\x02\n\x11\x46\x61nCommandRequest\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x1b\n\thas_state\x18\x02 \x01(\x08R\x08hasState\x12\x14\n\x05state\x18\x03 \x01(\x08R\x05state\x12\x1b\n\thas_speed\x18\x04 \x01(\x08R\x08hasSpeed\x12\x1f\n\x05speed\x18\x05 \x01(\x0e\x32\t.FanSpeedR\x05speed\x12\'\n\x0fhas_oscillating\x18\x06 \x01(\x08R\x0ehasOscillating\x12 \n\x0boscillating\x18\x07 \x01(\x08R\x0boscillating\x12#\n\rhas_direction\x18\x08 \x01(\x08R\x0chasDirection\x12+\n\tdirection\x18\t \x01(\x0e\x32\r.FanDirectionR\tdirection\"\x97\x03\n\x19ListEntitiesLightResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12/\n\x13supports_brightness\x18\x05 \x01(\x08R\x12supportsBrightness\x12!\n\x0csupports_rgb\x18\x06 \x01(\x08R\x0bsupportsRgb\x12\x30\n\x14supports_white_value\x18\x07 \x01(\x08R\x12supportsWhiteValue\x12<\n\x1asupports_color_temperature\x18\x08 \x01(\x08R\x18supportsColorTemperature\x12\x1d\n\nmin_mireds\x18\t \x01(\x02R\tminMireds\x12\x1d\n\nmax_mireds\x18\n \x01(\x02R\tmaxMireds\x12\x18\n\x07\x65\x66\x66\x65\x63ts\x18\x0b \x03(\tR\x07\x65\x66\x66\x65\x63ts\"\xf3\x01\n\x12LightStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x14\n\x05state\x18\x02 \x01(\x08R\x05state\x12\x1e\n\nbrightness\x18\x03 \x01(\x02R\nbrightness\x12\x10\n\x03red\x18\x04 \x01(\x02R\x03red\x12\x14\n\x05green\x18\x05 \x01(\x02R\x05green\x12\x12\n\x04\x62lue\x18\x06 \x01(\x02R\x04\x62lue\x12\x14\n\x05white\x18\x07 \x01(\x02R\x05white\x12+\n\x11\x63olor_temperature\x18\x08 \x01(\x02R\x10\x63olorTemperature\x12\x16\n\x06\x65\x66\x66\x65\x63t\x18\t \x01(\tR\x06\x65\x66\x66\x65\x63t\"\xef\x04\n\x13LightCommandRequest\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x1b\n\thas_state\x18\x02 \x01(\x08R\x08hasState\x12\x14\n\x05state\x18\x03 \x01(\x08R\x05state\x12%\n\x0ehas_brightness\x18\x04 \x01(\x08R\rhasBrightness\x12\x1e\n\nbrightness\x18\x05 \x01(\x02R\nbrightness\x12\x17\n\x07has_rgb\x18\x06 \x01(\x08R\x06hasRgb\x12\x10\n\x03red\x18\x07 \x01(\x02R\x03red\x12\x14\n\x05green\x18\x08 \x01(\x02R\x05green\x12\x12\n\x04\x62lue\x18\t \x01(\x02R\x04\x62lue\x12\x1b\n\thas_white\x18\n \x01(\x08R\x08hasWhite\x12\x14\n\x05white\x18\x0b \x01(\x02R\x05white\x12\x32\n\x15has_color_temperature\x18\x0c \x01(\x08R\x13hasColorTemperature\x12+\n\x11\x63olor_temperature\x18\r \x01(\x02R\x10\x63olorTemperature\x12\x32\n\x15has_transition_length\x18\x0e \x01(\x08R\x13hasTransitionLength\x12+\n\x11transition_length\x18\x0f \x01(\rR\x10transitionLength\x12(\n\x10has_flash_length\x18\x10 \x01(\x08R\x0ehasFlashLength\x12!\n\x0c\x66lash_length\x18\x11 \x01(\rR\x0b\x66lashLength\x12\x1d\n\nhas_effect\x18\x12 \x01(\x08R\thasEffect\x12\x16\n\x06\x65\x66\x66\x65\x63t\x18\x13 \x01(\tR\x06\x65\x66\x66\x65\x63t\"\xb3\x02\n\x1aListEntitiesSensorResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12\x12\n\x04icon\x18\x05 \x01(\tR\x04icon\x12.\n\x13unit_of_measurement\x18\x06 \x01(\tR\x11unitOfMeasurement\x12+\n\x11\x61\x63\x63uracy_decimals\x18\x07 \x01(\x05R\x10\x61\x63\x63uracyDecimals\x12!\n\x0c\x66orce_update\x18\x08 \x01(\x08R\x0b\x66orceUpdate\x12!\n\x0c\x64\x65vice_class\x18\t \x01(\tR\x0b\x64\x65viceClass\"b\n\x13SensorStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x14\n\x05state\x18\x02 \x01(\x02R\x05state\x12#\n\rmissing_state\x18\x03 \x01(\x08R\x0cmissingState\"\xb5\x01\n\x1aListEntitiesSwitchResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12\x12\n\x04icon\x18\x05 \x01(\tR\x04icon\x12#\n\rassumed_state\x18\x06 \x01(\x08R\x0c\x61ssumedState\"=\n\x13SwitchStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x14\n\x05state\x18\x02 \x01(\x08R\x05state\">\n\x14SwitchCommandRequest\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x14\n\x05state\x18\x02 \x01(\x08R\x05state\"\x94\x01\n\x1eListEntitiesTextSensorResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12\x12\n\x04icon\x18\x05 \x01(\tR\x04icon\"f\n\x17TextSensorStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x14\n\x05state\x18\x02 \x01(\tR\x05state\x12#\n\rmissing_state\x18\x03 \x01(\x08R\x0cmissingState\"p\n\x14SubscribeLogsRequest\x12\x1f\n\x05level\x18\x01 \x01(\x0e\x32\t.LogLevelR\x05level\x12\x1f\n\x0b\x64ump_config\x18\x02 \x01(\x08R\ndumpConfig\x12\x16\n\x06\x62inary\x18\x03 \x01(\x08R\x06\x62inary\"\x85\x01\n\x15SubscribeLogsResponse\x12\x1f\n\x05level\x18\x01 \x01(\x0e\x32\t.LogLevelR\x05level\x12\x10\n\x03tag\x18\x02 \x01(\tR\x03tag\x12\x18\n\x07message\x18\x03 \x01(\tR\x07message\x12\x1f\n\x0bsend_failed\x18\x04 \x01(\x08R\nsendFailed\"\x8b\x01\n\x11\x42inaryLogResponse\x12\x1f\n\x05level\x18\x01 \x01(\x0e\x32\t.LogLevelR\x05level\x12\x10\n\x03tag\x18\x02 \x01(\tR\x03tag\x12\x12\n\x04line\x18\x03 \x01(\rR\x04line\x12\x1b\n\tformat_id\x18\x04 \x01(\x07R\x08\x66ormatId\x12\x12\n\x04\x61rgs\x18\x05 \x01(\x0cR\x04\x61rgs\"\'\n%SubscribeHomeassistantServicesRequest\"A\n\x17HomeassistantServiceMap\x12\x10\n\x03key\x18\x01 \x01(\tR\x03key\x12\x14\n\x05value\x18\x02 \x01(\tR\x05value\"\xf8\x01\n\x1cHomeassistantServiceResponse\x12\x18\n\x07service\x18\x01 \x01(\tR\x07service\x12,\n\x04\x64\x61ta\x18\x02 \x03(\x0b\x32\x18.HomeassistantServiceMapR\x04\x64\x61ta\x12=\n\rdata_template\x18\x03 \x03(\x0b\x32\x18.HomeassistantServiceMapR\x0c\x64\x61taTemplate\x12\x36\n\tvariables\x18\x04 \x03(\x0b\x32\x18.HomeassistantServiceMapR\tvariables\x12\x19\n\x08is_event\x18\x05 \x01(\x08R\x07isEvent\"?\n#SubscribeHomeAssistantStatesRequest\x12\x18\n\x07\x63ompact\x18\x01 \x01(\x08R\x07\x63ompact\"t\n#SubscribeHomeAssistantStateResponse\x12\x1b\n\tentity_id\x18\x01 \x01(\tR\x08\x65ntityId\x12\x16\n\x06handle\x18\x02 \x01(\rR\x06handle\x12\x18\n\x07numeric\x18\x03 \x01(\x08R\x07numeric\"O\n\x1aHomeAssistantStateResponse\x12\x1b\n\tentity_id\x18\x01 \x01(\tR\x08\x65ntityId\x12\x14\n\x05state\x18\x02 \x01(\tR\x05state\"\xa2\x01\n!HomeAssistantCompactStateResponse\x12\x16\n\x06handle\x18\x01 \x01(\rR\x06handle\x12\x14\n\x05state\x18\x02 \x01(\tR\x05state\x12*\n\x11has_numeric_state\x18\x03 \x01(\x08R\x0fhasNumericState\x12#\n\rnumeric_state\x18\x04 \x01(\x02R\x0cnumericState\"\x10\n\x0eGetTimeRequest\"6\n\x0fGetTimeResponse\x12#\n\repoch_seconds\x18\x01 \x01(\x07R\x0c\x65pochSeconds\"W\n\x1cListEntitiesServicesArgument\x12\x12\n\x04name\x18\x01 \x01(\tR\x04name\x12#\n\x04type\x18\x02 \x01(\x0e\x32\x0f.ServiceArgTypeR\x04type\"w\n\x1cListEntitiesServicesResponse\x12\x12\n\x04name\x18\x01 \x01(\tR\x04name\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x31\n\x04\x61rgs\x18\x03 \x03(\x0b\x32\x1d.ListEntitiesServicesArgumentR\x04\x61rgs\"\x9b\x02\n\x16\x45xecuteServiceArgument\x12\x13\n\x05\x62ool_\x18\x01 \x01(\x08R\x04\x62ool\x12\x1d\n\nlegacy_int\x18\x02 \x01(\x05R\tlegacyInt\x12\x15\n\x06\x66loat_\x18\x03 \x01(\x02R\x05\x66loat\x12\x17\n\x07string_\x18\x04 \x01(\tR\x06string\x12\x11\n\x04int_\x18\x05 \x01(\x11R\x03int\x12!\n\nbool_array\x18\x06 \x03(\x08\x42\x02\x10\x00R\tboolArray\x12\x1f\n\tint_array\x18\x07 \x03(\x11\x42\x02\x10\x00R\x08intArray\x12#\n\x0b\x66loat_array\x18\x08 \x03(\x02\x42\x02\x10\x00R\nfloatArray\x12!\n\x0cstring_array\x18\t \x03(\tR\x0bstringArray\"V\n\x15\x45xecuteServiceRequest\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12+\n\x04\x61rgs\x18\x02 \x03(\x0b\x32\x17.ExecuteServiceArgumentR\x04\x61rgs\"|\n\x1aListEntitiesCameraResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\"m\n\x13\x43\x61meraImageResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x12\n\x04\x64\x61ta\x18\x02 \x01(\x0cR\x04\x64\x61ta\x12\x12\n\x04\x64one\x18\x03 \x01(\x08R\x04\x64one\x12\x1c\n\tframerate\x18\x04 \x01(\x02R\tframerate\"\xa5\x01\n\x12\x43\x61meraImageRequest\x12\x16\n\x06single\x18\x01 \x01(\x08R\x06single\x12\x16\n\x06stream\x18\x02 \x01(\x08R\x06stream\x12#\n\rmax_framerate\x18\x03 \x01(\x02R\x0cmaxFramerate\x12\x1b\n\tmax_width\x18\x04 \x01(\rR\x08maxWidth\x12\x1d\n\nmax_height\x18\x05 \x01(\rR\tmaxHeight\"\xc2\x05\n\x1bListEntitiesClimateResponse\x12\x1b\n\tobject_id\x18\x01 \x01(\tR\x08objectId\x12\x10\n\x03key\x18\x02 \x01(\x07R\x03key\x12\x12\n\x04name\x18\x03 \x01(\tR\x04name\x12\x1b\n\tunique_id\x18\x04 \x01(\tR\x08uniqueId\x12@\n\x1csupports_current_temperature\x18\x05 \x01(\x08R\x1asupportsCurrentTemperature\x12P\n%supports_two_point_target_temperature\x18\x06 \x01(\x08R!supportsTwoPointTargetTemperature\x12\x35\n\x0fsupported_modes\x18\x07 \x03(\x0e\x32\x0c.ClimateModeR\x0esupportedModes\x12\x34\n\x16visual_min_temperature\x18\x08 \x01(\x02R\x14visualMinTemperature\x12\x34\n\x16visual_max_temperature\x18\t \x01(\x02R\x14visualMaxTemperature\x12\x36\n\x17visual_temperature_step\x18\n \x01(\x02R\x15visualTemperatureStep\x12#\n\rsupports_away\x18\x0b \x01(\x08R\x0csupportsAway\x12\'\n\x0fsupports_action\x18\x0c \x01(\x08R\x0esupportsAction\x12?\n\x13supported_fan_modes\x18\r \x03(\x0e\x32\x0f.ClimateFanModeR\x11supportedFanModes\x12\x45\n\x15supported_swing_modes\x18\x0e \x03(\x0e\x32\x11.ClimateSwingModeR\x13supportedSwingModes\"\xb2\x03\n\x14\x43limateStateResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12 \n\x04mode\x18\x02 \x01(\x0e\x32\x0c.ClimateModeR\x04mode\x12/\n\x13\x63urrent_temperature\x18\x03 \x01(\x02R\x12\x63urrentTemperature\x12-\n\x12target_temperature\x18\x04 \x01(\x02R\x11targetTemperature\x12\x34\n\x16target_temperature_low\x18\x05 \x01(\x02R\x14targetTemperatureLow\x12\x36\n\x17target_temperature_high\x18\x06 \x01(\x02R\x15targetTemperatureHigh\x12\x12\n\x04\x61way\x18\x07 \x01(\x08R\x04\x61way\x12&\n\x06\x61\x63tion\x18\x08 \x01(\x0e\x32\x0e.ClimateActionR\x06\x61\x63tion\x12*\n\x08\x66\x61n_mode\x18\t \x01(\x0e\x32\x0f.ClimateFanModeR\x07\x66\x61nMode\x12\x30\n\nswing_mode\x18\n \x01(\x0e\x32\x11.ClimateSwingModeR\tswingMode\"\x8a\x05\n\x15\x43limateCommandRequest\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x19\n\x08has_mode\x18\x02 \x01(\x08R\x07hasMode\x12 \n\x04mode\x18\x03 \x01(\x0e\x32\x0c.ClimateModeR\x04mode\x12\x34\n\x16has_target_temperature\x18\x04 \x01(\x08R\x14hasTargetTemperature\x12-\n\x12target_temperature\x18\x05 \x01(\x02R\x11targetTemperature\x12;\n\x1ahas_target_temperature_low\x18\x06 \x01(\x08R\x17hasTargetTemperatureLow\x12\x34\n\x16target_temperature_low\x18\x07 \x01(\x02R\x14targetTemperatureLow\x12=\n\x1bhas_target_temperature_high\x18\x08 \x01(\x08R\x18hasTargetTemperatureHigh\x12\x36\n\x17target_temperature_high\x18\t \x01(\x02R\x15targetTemperatureHigh\x12\x19\n\x08has_away\x18\n \x01(\x08R\x07hasAway\x12\x12\n\x04\x61way\x18\x0b \x01(\x08R\x04\x61way\x12 \n\x0chas_fan_mode\x18\x0c \x01(\x08R\nhasFanMode\x12*\n\x08\x66\x61n_mode\x18\r \x01(\x0e\x32\x0f.ClimateFanModeR\x07\x66\x61nMode\x12$\n\x0ehas_swing_mode\x18\x0e \x01(\x08R\x0chasSwingMode\x12\x30\n\nswing_mode\x18\x0f \x01(\x0e\x32\x11.ClimateSwingModeR\tswingMode\"l\n\x0eHistoryRequest\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x32\n\nresolution\x18\x02 \x01(\x0e\x32\x12.HistoryResolutionR\nresolution\x12\x14\n\x05since\x18\x03 \x01(\rR\x05since\"\x95\x01\n\x0fHistoryResponse\x12\x10\n\x03key\x18\x01 \x01(\x07R\x03key\x12\x32\n\nresolution\x18\x02 \x01(\x0e\x32\x12.HistoryResolutionR\nresolution\x12\x10\n\x03utc\x18\x03 \x01(\x08R\x03utc\x12\x16\n\x06points\x18\x04 \x01(\x0cR\x06points\x12\x12\n\x04\x64one\x18\x05 \x01(\x08R\x04\x64one\"+\n)SubscribeBluetoothLEAdvertisementsRequest\"\x82\x01\n\x1b\x42luetoothLERawAdvertisement\x12\x18\n\x07\x61\x64\x64ress\x18\x01 \x01(\x04R\x07\x61\x64\x64ress\x12\x12\n\x04rssi\x18\x02 \x01(\x11R\x04rssi\x12!\n\x0c\x61\x64\x64ress_type\x18\x03 \x01(\rR\x0b\x61\x64\x64ressType\x12\x12\n\x04\x64\x61ta\x18\x04 \x01(\x0cR\x04\x64\x61ta\"l\n$BluetoothLERawAdvertisementsResponse\x12\x44\n\x0e\x61\x64vertisements\x18\x01 \x03(\x0b\x32\x1c.BluetoothLERawAdvertisementR\x0e\x61\x64vertisements\"/\n\x11StoredLogsRequest\x12\x1a\n\x08position\x18\x01 \x01(\rR\x08position\"g\n\x12StoredLogsResponse\x12\x18\n\x07records\x18\x01 \x01(\x0cR\x07records\x12#\n\rnext_position\x18\x02 \x01(\rR\x0cnextPosition\x12\x12\n\x04\x64one\x18\x03 \x01(\x08R\x04\x64one*N\n\x10LegacyCoverState\x12\x1b\n\x17LEGACY_COVER_STATE_OPEN\x10\x00\x12\x1d\n\x19LEGACY_COVER_STATE_CLOSED\x10\x01*j\n\x0e\x43overOperation\x12\x18\n\x14\x43OVER_OPERATION_IDLE\x10\x00\x12\x1e\n\x1a\x43OVER_OPERATION_IS_OPENING\x10\x01\x12\x1e\n\x1a\x43OVER_OPERATION_IS_CLOSING\x10\x02*r\n\x12LegacyCoverCommand\x12\x1d\n\x19LEGACY_COVER_COMMAND_OPEN\x10\x00\x12\x1e\n\x1aLEGACY_COVER_COMMAND_CLOSE\x10\x01\x12\x1d\n\x19LEGACY_COVER_COMMAND_STOP\x10\x02*G\n\x08\x46\x61nSpeed\x12\x11\n\rFAN_SPEED_LOW\x10\x00\x12\x14\n\x10\x46\x41N_SPEED_MEDIUM\x10\x01\x12\x12\n\x0e\x46\x41N_SPEED_HIGH\x10\x02*D\n\x0c\x46\x61nDirection\x12\x19\n\x15\x46\x41N_DIRECTION_FORWARD\x10\x00\x12\x19\n\x15\x46\x41N_DIRECTION_REVERSE\x10\x01*\xa3\x01\n\x08LogLevel\x12\x12\n\x0eLOG_LEVEL_NONE\x10\x00\x12\x13\n\x0fLOG_LEVEL_ERROR\x10\x01\x12\x12\n\x0eLOG_LEVEL_WARN\x10\x02\x12\x12\n\x0eLOG_LEVEL_INFO\x10\x03\x12\x13\n\x0fLOG_LEVEL_DEBUG\x10\x04\x12\x15\n\x11LOG_LEVEL_VERBOSE\x10\x05\x12\x1a\n\x16LOG_LEVEL_VERY_VERBOSE\x10\x06*\x84\x02\n\x0eServiceArgType\x12\x19\n\x15SERVICE_ARG_TYPE_BOOL\x10\x00\x12\x18\n\x14SERVICE_ARG_TYPE_INT\x10\x01\x12\x1a\n\x16SERVICE_ARG_TYPE_FLOAT\x10\x02\x12\x1b\n\x17SERVICE_ARG_TYPE_STRING\x10\x03\x12\x1f\n\x1bSERVICE_ARG_TYPE_BOOL_ARRAY\x10\x04\x12\x1e\n\x1aSERVICE_ARG_TYPE_INT_ARRAY\x10\x05\x12 \n\x1cSERVICE_ARG_TYPE_FLOAT_ARRAY\x10\x06\x12!\n\x1dSERVICE_ARG_TYPE_STRING_ARRAY\x10\x07*\x99\x01\n\x0b\x43limateMode\x12\x14\n\x10\x43LIMATE_MODE_OFF\x10\x00\x12\x15\n\x11\x43LIMATE_MODE_AUTO\x10\x01\x12\x15\n\x11\x43LIMATE_MODE_COOL\x10\x02\x12\x15\n\x11\x43LIMATE_MODE_HEAT\x10\x03\x12\x19\n\x15\x43LIMATE_MODE_FAN_ONLY\x10\x04\x12\x14\n\x10\x43LIMATE_MODE_DRY\x10\x05*\xda\x01\n\x0e\x43limateFanMode\x12\x12\n\x0e\x43LIMATE_FAN_ON\x10\x00\x12\x13\n\x0f\x43LIMATE_FAN_OFF\x10\x01\x12\x14\n\x10\x43LIMATE_FAN_AUTO\x10\x02\x12\x13\n\x0f\x43LIMATE_FAN_LOW\x10\x03\x12\x16\n\x12\x43LIMATE_FAN_MEDIUM\x10\x04\x12\x14\n\x10\x43LIMATE_FAN_HIGH\x10\x05\x12\x16\n\x12\x43LIMATE_FAN_MIDDLE\x10\x06\x12\x15\n\x11\x43LIMATE_FAN_FOCUS\x10\x07\x12\x17\n\x13\x43LIMATE_FAN_DIFFUSE\x10\x08*{\n\x10\x43limateSwingMode\x12\x15\n\x11\x43LIMATE_SWING_OFF\x10\x00\x12\x16\n\x12\x43LIMATE_SWING_BOTH\x10\x01\x12\x1a\n\x16\x43LIMATE_SWING_VERTICAL\x10\x02\x12\x1c\n\x18\x43LIMATE_SWING_HORIZONTAL\x10\x03*\xab\x01\n\rClimateAction\x12\x16\n\x12\x43LIMATE_ACTION_OFF\x10\x00\x12\x1a\n\x16\x43LIMATE_ACTION_COOLING\x10\x02\x12\x1a\n\x16\x43LIMATE_ACTION_HEATING\x10\x03\x12\x17\n\x13\x43LIMATE_ACTION_IDLE\x10\x04\x12\x19\n\x15\x43LIMATE_ACTION_DRYING\x10\x05\x12\x16\n\x12\x43LIMATE_ACTION_FAN\x10\x06*j\n\x11HistoryResolution\x12\x1a\n\x16HISTORY_RESOLUTION_RAW\x10\x00\x12\x1b\n\x17HISTORY_RESOLUTION_1MIN\x10\x01\x12\x1c\n\x18HISTORY_RESOLUTION_15MIN\x10\x02\x62\x06proto3')
 )
 
+_LEGACYCOVERSTATE = _descriptor.EnumDescriptor(
+  name='LegacyCoverState',
+  full_name='LegacyCoverState',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='LEGACY_COVER_STATE_OPEN', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='LEGACY_COVER_STATE_CLOSED', index=1, number=1,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=10210,
+  serialized_end=10288,
+)
+_sym_db.RegisterEnumDescriptor(_LEGACYCOVERSTATE)
+
+LegacyCoverState = enum_type_wrapper.EnumTypeWrapper(_LEGACYCOVERSTATE)
+_COVEROPERATION = _descriptor.EnumDescriptor(
+  name='CoverOperation',
+  full_name='CoverOperation',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='COVER_OPERATION_IDLE', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='COVER_OPERATION_IS_OPENING', index=1, number=1,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='COVER_OPERATION_IS_CLOSING', index=2, number=2,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=10290,
+  serialized_end=10396,
+)
+_sym_db.RegisterEnumDescriptor(_COVEROPERATION)
+
+CoverOperation = enum_type_wrapper.EnumTypeWrapper(_COVEROPERATION)
+_LEGACYCOVERCOMMAND = _descriptor.EnumDescriptor(
+  name='LegacyCoverCommand',
+  full_name='LegacyCoverCommand',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='LEGACY_COVER_COMMAND_OPEN', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='LEGACY_COVER_COMMAND_CLOSE', index=1, number=1,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='LEGACY_COVER_COMMAND_STOP', index=2, number=2,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=10398,
+  serialized_end=10512,
+)
+_sym_db.RegisterEnumDescriptor(_LEGACYCOVERCOMMAND)
+
+LegacyCoverCommand = enum_type_wrapper.EnumTypeWrapper(_LEGACYCOVERCOMMAND)
 _FANSPEED = _descriptor.EnumDescriptor(
   name='FanSpeed',
   full_name='FanSpeed',
@@ -31,26 +108,49 @@ _FANSPEED = _descriptor.EnumDescriptor(
   file=DESCRIPTOR,
   values=[
     _descriptor.EnumValueDescriptor(
-      name='LOW', index=0, number=0,
+      name='FAN_SPEED_LOW', index=0, number=0,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='MEDIUM', index=1, number=1,
+      name='FAN_SPEED_MEDIUM', index=1, number=1,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='HIGH', index=2, number=2,
+      name='FAN_SPEED_HIGH', index=2, number=2,
       serialized_options=None,
       type=None),
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=3822,
-  serialized_end=3863,
+  serialized_start=10514,
+  serialized_end=10585,
 )
 _sym_db.RegisterEnumDescriptor(_FANSPEED)
 
 FanSpeed = enum_type_wrapper.EnumTypeWrapper(_FANSPEED)
+_FANDIRECTION = _descriptor.EnumDescriptor(
+  name='FanDirection',
+  full_name='FanDirection',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='FAN_DIRECTION_FORWARD', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='FAN_DIRECTION_REVERSE', index=1, number=1,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=10587,
+  serialized_end=10655,
+)
+_sym_db.RegisterEnumDescriptor(_FANDIRECTION)
+
+FanDirection = enum_type_wrapper.EnumTypeWrapper(_FANDIRECTION)
 _LOGLEVEL = _descriptor.EnumDescriptor(
   name='LogLevel',
   full_name='LogLevel',
@@ -58,101 +158,333 @@ _LOGLEVEL = _descriptor.EnumDescriptor(
   file=DESCRIPTOR,
   values=[
     _descriptor.EnumValueDescriptor(
-      name='NONE', index=0, number=0,
+      name='LOG_LEVEL_NONE', index=0, number=0,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='ERROR', index=1, number=1,
+      name='LOG_LEVEL_ERROR', index=1, number=1,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='WARN', index=2, number=2,
+      name='LOG_LEVEL_WARN', index=2, number=2,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='INFO', index=3, number=3,
+      name='LOG_LEVEL_INFO', index=3, number=3,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='DEBUG', index=4, number=4,
+      name='LOG_LEVEL_DEBUG', index=4, number=4,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='VERBOSE', index=5, number=5,
+      name='LOG_LEVEL_VERBOSE', index=5, number=5,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='VERY_VERBOSE', index=6, number=6,
+      name='LOG_LEVEL_VERY_VERBOSE', index=6, number=6,
       serialized_options=None,
       type=None),
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=3865,
-  serialized_end=3958,
+  serialized_start=10658,
+  serialized_end=10821,
 )
 _sym_db.RegisterEnumDescriptor(_LOGLEVEL)
 
 LogLevel = enum_type_wrapper.EnumTypeWrapper(_LOGLEVEL)
-LOW = 0
-MEDIUM = 1
-HIGH = 2
-NONE = 0
-ERROR = 1
-WARN = 2
-INFO = 3
-DEBUG = 4
-VERBOSE = 5
-VERY_VERBOSE = 6
+_SERVICEARGTYPE = _descriptor.EnumDescriptor(
+  name='ServiceArgType',
+  full_name='ServiceArgType',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_BOOL', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_INT', index=1, number=1,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_FLOAT', index=2, number=2,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_STRING', index=3, number=3,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_BOOL_ARRAY', index=4, number=4,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_INT_ARRAY', index=5, number=5,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_FLOAT_ARRAY', index=6, number=6,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='SERVICE_ARG_TYPE_STRING_ARRAY', index=7, number=7,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=10824,
+  serialized_end=11084,
+)
+_sym_db.RegisterEnumDescriptor(_SERVICEARGTYPE)
+
+ServiceArgType = enum_type_wrapper.EnumTypeWrapper(_SERVICEARGTYPE)
+_CLIMATEMODE = _descriptor.EnumDescriptor(
+  name='ClimateMode',
+  full_name='ClimateMode',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_MODE_OFF', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_MODE_AUTO', index=1, number=1,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_MODE_COOL', index=2, number=2,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_MODE_HEAT', index=3, number=3,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_MODE_FAN_ONLY', index=4, number=4,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_MODE_DRY', index=5, number=5,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=11087,
+  serialized_end=11240,
+)
+_sym_db.RegisterEnumDescriptor(_CLIMATEMODE)
+
+ClimateMode = enum_type_wrapper.EnumTypeWrapper(_CLIMATEMODE)
+_CLIMATEFANMODE = _descriptor.EnumDescriptor(
+  name='ClimateFanMode',
+  full_name='ClimateFanMode',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_ON', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_OFF', index=1, number=1,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_AUTO', index=2, number=2,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_LOW', index=3, number=3,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_MEDIUM', index=4, number=4,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_HIGH', index=5, number=5,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_MIDDLE', index=6, number=6,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_FOCUS', index=7, number=7,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_FAN_DIFFUSE', index=8, number=8,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=11243,
+  serialized_end=11461,
+)
+_sym_db.RegisterEnumDescriptor(_CLIMATEFANMODE)
 
+ClimateFanMode = enum_type_wrapper.EnumTypeWrapper(_CLIMATEFANMODE)
+_CLIMATESWINGMODE = _descriptor.EnumDescriptor(
+  name='ClimateSwingMode',
+  full_name='ClimateSwingMode',
+  filename=None,
+  file=DESCRIPTOR,
+  values=[
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_SWING_OFF', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_SWING_BOTH', index=1, number=1,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_SWING_VERTICAL', index=2, number=2,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_SWING_HORIZONTAL', index=3, number=3,
+      serialized_options=None,
+      type=None),
+  ],
+  containing_type=None,
+  serialized_options=None,
+  serialized_start=11463,
+  serialized_end=11586,
+)
+_sym_db.RegisterEnumDescriptor(_CLIMATESWINGMODE)
 
-_COVERSTATERESPONSE_COVERSTATE = _descriptor.EnumDescriptor(
-  name='CoverState',
-  full_name='CoverStateResponse.CoverState',
+ClimateSwingMode = enum_type_wrapper.EnumTypeWrapper(_CLIMATESWINGMODE)
+_CLIMATEACTION = _descriptor.EnumDescriptor(
+  name='ClimateAction',
+  full_name='ClimateAction',
   filename=None,
   file=DESCRIPTOR,
   values=[
     _descriptor.EnumValueDescriptor(
-      name='OPEN', index=0, number=0,
+      name='CLIMATE_ACTION_OFF', index=0, number=0,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_ACTION_COOLING', index=1, number=2,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='CLOSED', index=1, number=1,
+      name='CLIMATE_ACTION_HEATING', index=2, number=3,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_ACTION_IDLE', index=3, number=4,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_ACTION_DRYING', index=4, number=5,
+      serialized_options=None,
+      type=None),
+    _descriptor.EnumValueDescriptor(
+      name='CLIMATE_ACTION_FAN', index=5, number=6,
       serialized_options=None,
       type=None),
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=1808,
-  serialized_end=1842,
+  serialized_start=11589,
+  serialized_end=11760,
 )
-_sym_db.RegisterEnumDescriptor(_COVERSTATERESPONSE_COVERSTATE)
+_sym_db.RegisterEnumDescriptor(_CLIMATEACTION)
 
-_COVERCOMMANDREQUEST_COVERCOMMAND = _descriptor.EnumDescriptor(
-  name='CoverCommand',
-  full_name='CoverCommandRequest.CoverCommand',
+ClimateAction = enum_type_wrapper.EnumTypeWrapper(_CLIMATEACTION)
+_HISTORYRESOLUTION = _descriptor.EnumDescriptor(
+  name='HistoryResolution',
+  full_name='HistoryResolution',
   filename=None,
   file=DESCRIPTOR,
   values=[
     _descriptor.EnumValueDescriptor(
-      name='OPEN', index=0, number=0,
+      name='HISTORY_RESOLUTION_RAW', index=0, number=0,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='CLOSE', index=1, number=1,
+      name='HISTORY_RESOLUTION_1MIN', index=1, number=1,
       serialized_options=None,
       type=None),
     _descriptor.EnumValueDescriptor(
-      name='STOP', index=2, number=2,
+      name='HISTORY_RESOLUTION_15MIN', index=2, number=2,
       serialized_options=None,
       type=None),
   ],
   containing_type=None,
   serialized_options=None,
-  serialized_start=2375,
-  serialized_end=2420,
+  serialized_start=11762,
+  serialized_end=11868,
 )
-_sym_db.RegisterEnumDescriptor(_COVERCOMMANDREQUEST_COVERCOMMAND)
+_sym_db.RegisterEnumDescriptor(_HISTORYRESOLUTION)
+
+HistoryResolution = enum_type_wrapper.EnumTypeWrapper(_HISTORYRESOLUTION)
+LEGACY_COVER_STATE_OPEN = 0
+LEGACY_COVER_STATE_CLOSED = 1
+COVER_OPERATION_IDLE = 0
+COVER_OPERATION_IS_OPENING = 1
+COVER_OPERATION_IS_CLOSING = 2
+LEGACY_COVER_COMMAND_OPEN = 0
+LEGACY_COVER_COMMAND_CLOSE = 1
+LEGACY_COVER_COMMAND_STOP = 2
+FAN_SPEED_LOW = 0
+FAN_SPEED_MEDIUM = 1
+FAN_SPEED_HIGH = 2
+FAN_DIRECTION_FORWARD = 0
+FAN_DIRECTION_REVERSE = 1
+LOG_LEVEL_NONE = 0
+LOG_LEVEL_ERROR = 1
+LOG_LEVEL_WARN = 2
+LOG_LEVEL_INFO = 3
+LOG_LEVEL_DEBUG = 4
+LOG_LEVEL_VERBOSE = 5
+LOG_LEVEL_VERY_VERBOSE = 6
+SERVICE_ARG_TYPE_BOOL = 0
+SERVICE_ARG_TYPE_INT = 1
+SERVICE_ARG_TYPE_FLOAT = 2
+SERVICE_ARG_TYPE_STRING = 3
+SERVICE_ARG_TYPE_BOOL_ARRAY = 4
+SERVICE_ARG_TYPE_INT_ARRAY = 5
+SERVICE_ARG_TYPE_FLOAT_ARRAY = 6
+SERVICE_ARG_TYPE_STRING_ARRAY = 7
+CLIMATE_MODE_OFF = 0
+CLIMATE_MODE_AUTO = 1
+CLIMATE_MODE_COOL = 2
+CLIMATE_MODE_HEAT = 3
+CLIMATE_MODE_FAN_ONLY = 4
+CLIMATE_MODE_DRY = 5
+CLIMATE_FAN_ON = 0
+CLIMATE_FAN_OFF = 1
+CLIMATE_FAN_AUTO = 2
+CLIMATE_FAN_LOW = 3
+CLIMATE_FAN_MEDIUM = 4
+CLIMATE_FAN_HIGH = 5
+CLIMATE_FAN_MIDDLE = 6
+CLIMATE_FAN_FOCUS = 7
+CLIMATE_FAN_DIFFUSE = 8
+CLIMATE_SWING_OFF = 0
+CLIMATE_SWING_BOTH = 1
+CLIMATE_SWING_VERTICAL = 2
+CLIMATE_SWING_HORIZONTAL = 3
+CLIMATE_ACTION_OFF = 0
+CLIMATE_ACTION_COOLING = 2
+CLIMATE_ACTION_HEATING = 3
+CLIMATE_ACTION_IDLE = 4
+CLIMATE_ACTION_DRYING = 5
+CLIMATE_ACTION_FAN = 6
+HISTORY_RESOLUTION_RAW = 0
+HISTORY_RESOLUTION_1MIN = 1
+HISTORY_RESOLUTION_15MIN = 2
+
 
 
 _HELLOREQUEST = _descriptor.Descriptor(
@@ -182,7 +514,7 @@ _HELLOREQUEST = _descriptor.Descriptor(
   oneofs=[
   ],
   serialized_start=13,
-  serialized_end=48,
+  serialized_end=60,
 )
 
 
@@ -214,6 +546,13 @@ _HELLORESPONSE = _descriptor.Descriptor(
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_states_snapshot', full_name='HelloResponse.supports_states_snapshot', index=3,
+      number=4, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -226,8 +565,8 @@ _HELLORESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=50,
-  serialized_end=140,
+  serialized_start=63,
+  serialized_end=257,
 )
 
 
@@ -257,8 +596,8 @@ _CONNECTREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=142,
-  serialized_end=176,
+  serialized_start=259,
+  serialized_end=303,
 )
 
 
@@ -288,8 +627,8 @@ _CONNECTRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=178,
-  serialized_end=221,
+  serialized_start=305,
+  serialized_end=365,
 )
 
 
@@ -312,8 +651,8 @@ _DISCONNECTREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=223,
-  serialized_end=242,
+  serialized_start=367,
+  serialized_end=386,
 )
 
 
@@ -336,8 +675,8 @@ _DISCONNECTRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=244,
-  serialized_end=264,
+  serialized_start=388,
+  serialized_end=408,
 )
 
 
@@ -360,8 +699,8 @@ _PINGREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=266,
-  serialized_end=279,
+  serialized_start=410,
+  serialized_end=423,
 )
 
 
@@ -384,8 +723,8 @@ _PINGRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=281,
-  serialized_end=295,
+  serialized_start=425,
+  serialized_end=439,
 )
 
 
@@ -408,8 +747,8 @@ _DEVICEINFOREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=297,
-  serialized_end=316,
+  serialized_start=441,
+  serialized_end=460,
 )
 
 
@@ -442,7 +781,7 @@ _DEVICEINFORESPONSE = _descriptor.Descriptor(
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='esphome_core_version', full_name='DeviceInfoResponse.esphome_core_version', index=3,
+      name='esphome_version', full_name='DeviceInfoResponse.esphome_version', index=3,
       number=4, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
@@ -481,8 +820,8 @@ _DEVICEINFORESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=319,
-  serialized_end=492,
+  serialized_start=463,
+  serialized_end=717,
 )
 
 
@@ -505,60 +844,18 @@ _LISTENTITIESREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=494,
-  serialized_end=515,
+  serialized_start=719,
+  serialized_end=740,
 )
 
 
-_LISTENTITIESBINARYSENSORRESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesBinarySensorResponse',
-  full_name='ListEntitiesBinarySensorResponse',
+_LISTENTITIESDONERESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesDoneResponse',
+  full_name='ListEntitiesDoneResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
-    _descriptor.FieldDescriptor(
-      name='object_id', full_name='ListEntitiesBinarySensorResponse.object_id', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='key', full_name='ListEntitiesBinarySensorResponse.key', index=1,
-      number=2, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='name', full_name='ListEntitiesBinarySensorResponse.name', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='unique_id', full_name='ListEntitiesBinarySensorResponse.unique_id', index=3,
-      number=4, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='device_class', full_name='ListEntitiesBinarySensorResponse.device_class', index=4,
-      number=5, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='is_status_binary_sensor', full_name='ListEntitiesBinarySensorResponse.is_status_binary_sensor', index=5,
-      number=6, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -571,50 +868,22 @@ _LISTENTITIESBINARYSENSORRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=518,
-  serialized_end=672,
+  serialized_start=742,
+  serialized_end=768,
 )
 
 
-_LISTENTITIESCOVERRESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesCoverResponse',
-  full_name='ListEntitiesCoverResponse',
+_SUBSCRIBESTATESREQUEST = _descriptor.Descriptor(
+  name='SubscribeStatesRequest',
+  full_name='SubscribeStatesRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='object_id', full_name='ListEntitiesCoverResponse.object_id', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='key', full_name='ListEntitiesCoverResponse.key', index=1,
-      number=2, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='name', full_name='ListEntitiesCoverResponse.name', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='unique_id', full_name='ListEntitiesCoverResponse.unique_id', index=3,
-      number=4, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='is_optimistic', full_name='ListEntitiesCoverResponse.is_optimistic', index=4,
-      number=5, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='states_snapshot', full_name='SubscribeStatesRequest.states_snapshot', index=0,
+      number=1, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -630,60 +899,95 @@ _LISTENTITIESCOVERRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=674,
-  serialized_end=789,
+  serialized_start=770,
+  serialized_end=835,
 )
 
 
-_LISTENTITIESFANRESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesFanResponse',
-  full_name='ListEntitiesFanResponse',
+_STATESSNAPSHOTRESPONSE = _descriptor.Descriptor(
+  name='StatesSnapshotResponse',
+  full_name='StatesSnapshotResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='object_id', full_name='ListEntitiesFanResponse.object_id', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='binary_sensor_keys', full_name='StatesSnapshotResponse.binary_sensor_keys', index=0,
+      number=1, type=7, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='key', full_name='ListEntitiesFanResponse.key', index=1,
-      number=2, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
+      name='binary_sensor_states', full_name='StatesSnapshotResponse.binary_sensor_states', index=1,
+      number=2, type=8, cpp_type=7, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='name', full_name='ListEntitiesFanResponse.name', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='cover_keys', full_name='StatesSnapshotResponse.cover_keys', index=2,
+      number=3, type=7, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='unique_id', full_name='ListEntitiesFanResponse.unique_id', index=3,
-      number=4, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='cover_positions', full_name='StatesSnapshotResponse.cover_positions', index=3,
+      number=4, type=2, cpp_type=6, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='supports_oscillation', full_name='ListEntitiesFanResponse.supports_oscillation', index=4,
-      number=5, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='cover_tilts', full_name='StatesSnapshotResponse.cover_tilts', index=4,
+      number=5, type=2, cpp_type=6, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='supports_speed', full_name='ListEntitiesFanResponse.supports_speed', index=5,
-      number=6, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='cover_current_operations', full_name='StatesSnapshotResponse.cover_current_operations', index=5,
+      number=6, type=14, cpp_type=8, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='sensor_keys', full_name='StatesSnapshotResponse.sensor_keys', index=6,
+      number=7, type=7, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='sensor_states', full_name='StatesSnapshotResponse.sensor_states', index=7,
+      number=8, type=2, cpp_type=6, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='switch_keys', full_name='StatesSnapshotResponse.switch_keys', index=8,
+      number=9, type=7, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='switch_states', full_name='StatesSnapshotResponse.switch_states', index=9,
+      number=10, type=8, cpp_type=7, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='missing_state_keys', full_name='StatesSnapshotResponse.missing_state_keys', index=10,
+      number=11, type=7, cpp_type=3, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=_b('\020\001'), file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -696,92 +1000,102 @@ _LISTENTITIESFANRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=792,
-  serialized_end=936,
+  serialized_start=838,
+  serialized_end=1368,
 )
 
 
-_LISTENTITIESLIGHTRESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesLightResponse',
-  full_name='ListEntitiesLightResponse',
+_LISTENTITIESBINARYSENSORRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesBinarySensorResponse',
+  full_name='ListEntitiesBinarySensorResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='object_id', full_name='ListEntitiesLightResponse.object_id', index=0,
+      name='object_id', full_name='ListEntitiesBinarySensorResponse.object_id', index=0,
       number=1, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='key', full_name='ListEntitiesLightResponse.key', index=1,
+      name='key', full_name='ListEntitiesBinarySensorResponse.key', index=1,
       number=2, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='name', full_name='ListEntitiesLightResponse.name', index=2,
+      name='name', full_name='ListEntitiesBinarySensorResponse.name', index=2,
       number=3, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='unique_id', full_name='ListEntitiesLightResponse.unique_id', index=3,
+      name='unique_id', full_name='ListEntitiesBinarySensorResponse.unique_id', index=3,
       number=4, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='supports_brightness', full_name='ListEntitiesLightResponse.supports_brightness', index=4,
-      number=5, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='device_class', full_name='ListEntitiesBinarySensorResponse.device_class', index=4,
+      number=5, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='supports_rgb', full_name='ListEntitiesLightResponse.supports_rgb', index=5,
+      name='is_status_binary_sensor', full_name='ListEntitiesBinarySensorResponse.is_status_binary_sensor', index=5,
       number=6, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=1371,
+  serialized_end=1591,
+)
+
+
+_BINARYSENSORSTATERESPONSE = _descriptor.Descriptor(
+  name='BinarySensorStateResponse',
+  full_name='BinarySensorStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
     _descriptor.FieldDescriptor(
-      name='supports_white_value', full_name='ListEntitiesLightResponse.supports_white_value', index=6,
-      number=7, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='key', full_name='BinarySensorStateResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='supports_color_temperature', full_name='ListEntitiesLightResponse.supports_color_temperature', index=7,
-      number=8, type=8, cpp_type=7, label=1,
+      name='state', full_name='BinarySensorStateResponse.state', index=1,
+      number=2, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='min_mireds', full_name='ListEntitiesLightResponse.min_mireds', index=8,
-      number=9, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='max_mireds', full_name='ListEntitiesLightResponse.max_mireds', index=9,
-      number=10, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='effects', full_name='ListEntitiesLightResponse.effects', index=10,
-      number=11, type=9, cpp_type=9, label=3,
-      has_default_value=False, default_value=[],
+      name='missing_state', full_name='BinarySensorStateResponse.missing_state', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -797,64 +1111,71 @@ _LISTENTITIESLIGHTRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=939,
-  serialized_end=1205,
+  serialized_start=1593,
+  serialized_end=1697,
 )
 
 
-_LISTENTITIESSENSORRESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesSensorResponse',
-  full_name='ListEntitiesSensorResponse',
+_LISTENTITIESCOVERRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesCoverResponse',
+  full_name='ListEntitiesCoverResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='object_id', full_name='ListEntitiesSensorResponse.object_id', index=0,
+      name='object_id', full_name='ListEntitiesCoverResponse.object_id', index=0,
       number=1, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='key', full_name='ListEntitiesSensorResponse.key', index=1,
+      name='key', full_name='ListEntitiesCoverResponse.key', index=1,
       number=2, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='name', full_name='ListEntitiesSensorResponse.name', index=2,
+      name='name', full_name='ListEntitiesCoverResponse.name', index=2,
       number=3, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='unique_id', full_name='ListEntitiesSensorResponse.unique_id', index=3,
+      name='unique_id', full_name='ListEntitiesCoverResponse.unique_id', index=3,
       number=4, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='icon', full_name='ListEntitiesSensorResponse.icon', index=4,
-      number=5, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='assumed_state', full_name='ListEntitiesCoverResponse.assumed_state', index=4,
+      number=5, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='unit_of_measurement', full_name='ListEntitiesSensorResponse.unit_of_measurement', index=5,
-      number=6, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='supports_position', full_name='ListEntitiesCoverResponse.supports_position', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='accuracy_decimals', full_name='ListEntitiesSensorResponse.accuracy_decimals', index=6,
-      number=7, type=5, cpp_type=1, label=1,
-      has_default_value=False, default_value=0,
+      name='supports_tilt', full_name='ListEntitiesCoverResponse.supports_tilt', index=6,
+      number=7, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='device_class', full_name='ListEntitiesCoverResponse.device_class', index=7,
+      number=8, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -870,57 +1191,50 @@ _LISTENTITIESSENSORRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1208,
-  serialized_end=1371,
+  serialized_start=1700,
+  serialized_end=1977,
 )
 
 
-_LISTENTITIESSWITCHRESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesSwitchResponse',
-  full_name='ListEntitiesSwitchResponse',
+_COVERSTATERESPONSE = _descriptor.Descriptor(
+  name='CoverStateResponse',
+  full_name='CoverStateResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='object_id', full_name='ListEntitiesSwitchResponse.object_id', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='key', full_name='ListEntitiesSwitchResponse.key', index=1,
-      number=2, type=7, cpp_type=3, label=1,
+      name='key', full_name='CoverStateResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='name', full_name='ListEntitiesSwitchResponse.name', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='legacy_state', full_name='CoverStateResponse.legacy_state', index=1,
+      number=2, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='unique_id', full_name='ListEntitiesSwitchResponse.unique_id', index=3,
-      number=4, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='position', full_name='CoverStateResponse.position', index=2,
+      number=3, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='icon', full_name='ListEntitiesSwitchResponse.icon', index=4,
-      number=5, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='tilt', full_name='CoverStateResponse.tilt', index=3,
+      number=4, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='optimistic', full_name='ListEntitiesSwitchResponse.optimistic', index=5,
-      number=6, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='current_operation', full_name='CoverStateResponse.current_operation', index=4,
+      number=5, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -936,56 +1250,77 @@ _LISTENTITIESSWITCHRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1373,
-  serialized_end=1500,
+  serialized_start=1980,
+  serialized_end=2182,
 )
 
 
-_LISTENTITIESTEXTSENSORRESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesTextSensorResponse',
-  full_name='ListEntitiesTextSensorResponse',
+_COVERCOMMANDREQUEST = _descriptor.Descriptor(
+  name='CoverCommandRequest',
+  full_name='CoverCommandRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='object_id', full_name='ListEntitiesTextSensorResponse.object_id', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='key', full_name='CoverCommandRequest.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='key', full_name='ListEntitiesTextSensorResponse.key', index=1,
-      number=2, type=7, cpp_type=3, label=1,
+      name='has_legacy_command', full_name='CoverCommandRequest.has_legacy_command', index=1,
+      number=2, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='legacy_command', full_name='CoverCommandRequest.legacy_command', index=2,
+      number=3, type=14, cpp_type=8, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='name', full_name='ListEntitiesTextSensorResponse.name', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='has_position', full_name='CoverCommandRequest.has_position', index=3,
+      number=4, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='unique_id', full_name='ListEntitiesTextSensorResponse.unique_id', index=3,
-      number=4, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='position', full_name='CoverCommandRequest.position', index=4,
+      number=5, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='icon', full_name='ListEntitiesTextSensorResponse.icon', index=4,
-      number=5, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='has_tilt', full_name='CoverCommandRequest.has_tilt', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='tilt', full_name='CoverCommandRequest.tilt', index=6,
+      number=7, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='stop', full_name='CoverCommandRequest.stop', index=7,
+      number=8, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
   ],
-  extensions=[
-  ],
+  extensions=[
+  ],
   nested_types=[],
   enum_types=[
   ],
@@ -995,18 +1330,67 @@ _LISTENTITIESTEXTSENSORRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1502,
-  serialized_end=1613,
+  serialized_start=2185,
+  serialized_end=2460,
 )
 
 
-_LISTENTITIESDONERESPONSE = _descriptor.Descriptor(
-  name='ListEntitiesDoneResponse',
-  full_name='ListEntitiesDoneResponse',
+_LISTENTITIESFANRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesFanResponse',
+  full_name='ListEntitiesFanResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
+    _descriptor.FieldDescriptor(
+      name='object_id', full_name='ListEntitiesFanResponse.object_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='key', full_name='ListEntitiesFanResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ListEntitiesFanResponse.name', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='unique_id', full_name='ListEntitiesFanResponse.unique_id', index=3,
+      number=4, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_oscillation', full_name='ListEntitiesFanResponse.supports_oscillation', index=4,
+      number=5, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_speed', full_name='ListEntitiesFanResponse.supports_speed', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_direction', full_name='ListEntitiesFanResponse.supports_direction', index=6,
+      number=7, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -1019,18 +1403,53 @@ _LISTENTITIESDONERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1615,
-  serialized_end=1641,
+  serialized_start=2463,
+  serialized_end=2721,
 )
 
 
-_SUBSCRIBESTATESREQUEST = _descriptor.Descriptor(
-  name='SubscribeStatesRequest',
-  full_name='SubscribeStatesRequest',
+_FANSTATERESPONSE = _descriptor.Descriptor(
+  name='FanStateResponse',
+  full_name='FanStateResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='FanStateResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='FanStateResponse.state', index=1,
+      number=2, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='oscillating', full_name='FanStateResponse.oscillating', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='speed', full_name='FanStateResponse.speed', index=3,
+      number=4, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='direction', full_name='FanStateResponse.direction', index=4,
+      number=5, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -1043,32 +1462,81 @@ _SUBSCRIBESTATESREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1643,
-  serialized_end=1667,
+  serialized_start=2724,
+  serialized_end=2894,
 )
 
 
-_BINARYSENSORSTATERESPONSE = _descriptor.Descriptor(
-  name='BinarySensorStateResponse',
-  full_name='BinarySensorStateResponse',
+_FANCOMMANDREQUEST = _descriptor.Descriptor(
+  name='FanCommandRequest',
+  full_name='FanCommandRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='BinarySensorStateResponse.key', index=0,
+      name='key', full_name='FanCommandRequest.key', index=0,
       number=1, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='BinarySensorStateResponse.state', index=1,
+      name='has_state', full_name='FanCommandRequest.has_state', index=1,
       number=2, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='FanCommandRequest.state', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_speed', full_name='FanCommandRequest.has_speed', index=3,
+      number=4, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='speed', full_name='FanCommandRequest.speed', index=4,
+      number=5, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_oscillating', full_name='FanCommandRequest.has_oscillating', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='oscillating', full_name='FanCommandRequest.oscillating', index=6,
+      number=7, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_direction', full_name='FanCommandRequest.has_direction', index=7,
+      number=8, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='direction', full_name='FanCommandRequest.direction', index=8,
+      number=9, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -1081,38 +1549,100 @@ _BINARYSENSORSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1669,
-  serialized_end=1724,
+  serialized_start=2897,
+  serialized_end=3204,
 )
 
 
-_COVERSTATERESPONSE = _descriptor.Descriptor(
-  name='CoverStateResponse',
-  full_name='CoverStateResponse',
+_LISTENTITIESLIGHTRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesLightResponse',
+  full_name='ListEntitiesLightResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='CoverStateResponse.key', index=0,
-      number=1, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
+      name='object_id', full_name='ListEntitiesLightResponse.object_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='CoverStateResponse.state', index=1,
-      number=2, type=14, cpp_type=8, label=1,
+      name='key', full_name='ListEntitiesLightResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ListEntitiesLightResponse.name', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='unique_id', full_name='ListEntitiesLightResponse.unique_id', index=3,
+      number=4, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_brightness', full_name='ListEntitiesLightResponse.supports_brightness', index=4,
+      number=5, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_rgb', full_name='ListEntitiesLightResponse.supports_rgb', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_white_value', full_name='ListEntitiesLightResponse.supports_white_value', index=6,
+      number=7, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='supports_color_temperature', full_name='ListEntitiesLightResponse.supports_color_temperature', index=7,
+      number=8, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='min_mireds', full_name='ListEntitiesLightResponse.min_mireds', index=8,
+      number=9, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='max_mireds', full_name='ListEntitiesLightResponse.max_mireds', index=9,
+      number=10, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='effects', full_name='ListEntitiesLightResponse.effects', index=10,
+      number=11, type=9, cpp_type=9, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
   nested_types=[],
   enum_types=[
-    _COVERSTATERESPONSE_COVERSTATE,
   ],
   serialized_options=None,
   is_extendable=False,
@@ -1120,43 +1650,1194 @@ _COVERSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1726,
-  serialized_end=1842,
+  serialized_start=3207,
+  serialized_end=3614,
 )
 
 
-_FANSTATERESPONSE = _descriptor.Descriptor(
-  name='FanStateResponse',
-  full_name='FanStateResponse',
+_LIGHTSTATERESPONSE = _descriptor.Descriptor(
+  name='LightStateResponse',
+  full_name='LightStateResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='FanStateResponse.key', index=0,
+      name='key', full_name='LightStateResponse.key', index=0,
       number=1, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='FanStateResponse.state', index=1,
+      name='state', full_name='LightStateResponse.state', index=1,
       number=2, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='oscillating', full_name='FanStateResponse.oscillating', index=2,
-      number=3, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='brightness', full_name='LightStateResponse.brightness', index=2,
+      number=3, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='red', full_name='LightStateResponse.red', index=3,
+      number=4, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='green', full_name='LightStateResponse.green', index=4,
+      number=5, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='blue', full_name='LightStateResponse.blue', index=5,
+      number=6, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='white', full_name='LightStateResponse.white', index=6,
+      number=7, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='color_temperature', full_name='LightStateResponse.color_temperature', index=7,
+      number=8, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='effect', full_name='LightStateResponse.effect', index=8,
+      number=9, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=3617,
+  serialized_end=3860,
+)
+
+
+_LIGHTCOMMANDREQUEST = _descriptor.Descriptor(
+  name='LightCommandRequest',
+  full_name='LightCommandRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='LightCommandRequest.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_state', full_name='LightCommandRequest.has_state', index=1,
+      number=2, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='LightCommandRequest.state', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_brightness', full_name='LightCommandRequest.has_brightness', index=3,
+      number=4, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='brightness', full_name='LightCommandRequest.brightness', index=4,
+      number=5, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_rgb', full_name='LightCommandRequest.has_rgb', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='red', full_name='LightCommandRequest.red', index=6,
+      number=7, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='green', full_name='LightCommandRequest.green', index=7,
+      number=8, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='blue', full_name='LightCommandRequest.blue', index=8,
+      number=9, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_white', full_name='LightCommandRequest.has_white', index=9,
+      number=10, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='white', full_name='LightCommandRequest.white', index=10,
+      number=11, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_color_temperature', full_name='LightCommandRequest.has_color_temperature', index=11,
+      number=12, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='color_temperature', full_name='LightCommandRequest.color_temperature', index=12,
+      number=13, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_transition_length', full_name='LightCommandRequest.has_transition_length', index=13,
+      number=14, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='transition_length', full_name='LightCommandRequest.transition_length', index=14,
+      number=15, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_flash_length', full_name='LightCommandRequest.has_flash_length', index=15,
+      number=16, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='flash_length', full_name='LightCommandRequest.flash_length', index=16,
+      number=17, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_effect', full_name='LightCommandRequest.has_effect', index=17,
+      number=18, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='effect', full_name='LightCommandRequest.effect', index=18,
+      number=19, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=3863,
+  serialized_end=4486,
+)
+
+
+_LISTENTITIESSENSORRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesSensorResponse',
+  full_name='ListEntitiesSensorResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='object_id', full_name='ListEntitiesSensorResponse.object_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='key', full_name='ListEntitiesSensorResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ListEntitiesSensorResponse.name', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='unique_id', full_name='ListEntitiesSensorResponse.unique_id', index=3,
+      number=4, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='icon', full_name='ListEntitiesSensorResponse.icon', index=4,
+      number=5, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='unit_of_measurement', full_name='ListEntitiesSensorResponse.unit_of_measurement', index=5,
+      number=6, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='accuracy_decimals', full_name='ListEntitiesSensorResponse.accuracy_decimals', index=6,
+      number=7, type=5, cpp_type=1, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='force_update', full_name='ListEntitiesSensorResponse.force_update', index=7,
+      number=8, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='device_class', full_name='ListEntitiesSensorResponse.device_class', index=8,
+      number=9, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=4489,
+  serialized_end=4796,
+)
+
+
+_SENSORSTATERESPONSE = _descriptor.Descriptor(
+  name='SensorStateResponse',
+  full_name='SensorStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='SensorStateResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='SensorStateResponse.state', index=1,
+      number=2, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='missing_state', full_name='SensorStateResponse.missing_state', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=4798,
+  serialized_end=4896,
+)
+
+
+_LISTENTITIESSWITCHRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesSwitchResponse',
+  full_name='ListEntitiesSwitchResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='object_id', full_name='ListEntitiesSwitchResponse.object_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='key', full_name='ListEntitiesSwitchResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ListEntitiesSwitchResponse.name', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='unique_id', full_name='ListEntitiesSwitchResponse.unique_id', index=3,
+      number=4, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='icon', full_name='ListEntitiesSwitchResponse.icon', index=4,
+      number=5, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='assumed_state', full_name='ListEntitiesSwitchResponse.assumed_state', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=4899,
+  serialized_end=5080,
+)
+
+
+_SWITCHSTATERESPONSE = _descriptor.Descriptor(
+  name='SwitchStateResponse',
+  full_name='SwitchStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='SwitchStateResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='SwitchStateResponse.state', index=1,
+      number=2, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5082,
+  serialized_end=5143,
+)
+
+
+_SWITCHCOMMANDREQUEST = _descriptor.Descriptor(
+  name='SwitchCommandRequest',
+  full_name='SwitchCommandRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='SwitchCommandRequest.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='SwitchCommandRequest.state', index=1,
+      number=2, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5145,
+  serialized_end=5207,
+)
+
+
+_LISTENTITIESTEXTSENSORRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesTextSensorResponse',
+  full_name='ListEntitiesTextSensorResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='object_id', full_name='ListEntitiesTextSensorResponse.object_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='key', full_name='ListEntitiesTextSensorResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ListEntitiesTextSensorResponse.name', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='unique_id', full_name='ListEntitiesTextSensorResponse.unique_id', index=3,
+      number=4, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='icon', full_name='ListEntitiesTextSensorResponse.icon', index=4,
+      number=5, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5210,
+  serialized_end=5358,
+)
+
+
+_TEXTSENSORSTATERESPONSE = _descriptor.Descriptor(
+  name='TextSensorStateResponse',
+  full_name='TextSensorStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='TextSensorStateResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='TextSensorStateResponse.state', index=1,
+      number=2, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='missing_state', full_name='TextSensorStateResponse.missing_state', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5360,
+  serialized_end=5462,
+)
+
+
+_SUBSCRIBELOGSREQUEST = _descriptor.Descriptor(
+  name='SubscribeLogsRequest',
+  full_name='SubscribeLogsRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='level', full_name='SubscribeLogsRequest.level', index=0,
+      number=1, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='dump_config', full_name='SubscribeLogsRequest.dump_config', index=1,
+      number=2, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='binary', full_name='SubscribeLogsRequest.binary', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5464,
+  serialized_end=5576,
+)
+
+
+_SUBSCRIBELOGSRESPONSE = _descriptor.Descriptor(
+  name='SubscribeLogsResponse',
+  full_name='SubscribeLogsResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='level', full_name='SubscribeLogsResponse.level', index=0,
+      number=1, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='tag', full_name='SubscribeLogsResponse.tag', index=1,
+      number=2, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='message', full_name='SubscribeLogsResponse.message', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='send_failed', full_name='SubscribeLogsResponse.send_failed', index=3,
+      number=4, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5579,
+  serialized_end=5712,
+)
+
+
+_BINARYLOGRESPONSE = _descriptor.Descriptor(
+  name='BinaryLogResponse',
+  full_name='BinaryLogResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='level', full_name='BinaryLogResponse.level', index=0,
+      number=1, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='tag', full_name='BinaryLogResponse.tag', index=1,
+      number=2, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='line', full_name='BinaryLogResponse.line', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='format_id', full_name='BinaryLogResponse.format_id', index=3,
+      number=4, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='args', full_name='BinaryLogResponse.args', index=4,
+      number=5, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5715,
+  serialized_end=5854,
+)
+
+
+_SUBSCRIBEHOMEASSISTANTSERVICESREQUEST = _descriptor.Descriptor(
+  name='SubscribeHomeassistantServicesRequest',
+  full_name='SubscribeHomeassistantServicesRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5856,
+  serialized_end=5895,
+)
+
+
+_HOMEASSISTANTSERVICEMAP = _descriptor.Descriptor(
+  name='HomeassistantServiceMap',
+  full_name='HomeassistantServiceMap',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='HomeassistantServiceMap.key', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='value', full_name='HomeassistantServiceMap.value', index=1,
+      number=2, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5897,
+  serialized_end=5962,
+)
+
+
+_HOMEASSISTANTSERVICERESPONSE = _descriptor.Descriptor(
+  name='HomeassistantServiceResponse',
+  full_name='HomeassistantServiceResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='service', full_name='HomeassistantServiceResponse.service', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='data', full_name='HomeassistantServiceResponse.data', index=1,
+      number=2, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='data_template', full_name='HomeassistantServiceResponse.data_template', index=2,
+      number=3, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='variables', full_name='HomeassistantServiceResponse.variables', index=3,
+      number=4, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='is_event', full_name='HomeassistantServiceResponse.is_event', index=4,
+      number=5, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=5965,
+  serialized_end=6213,
+)
+
+
+_SUBSCRIBEHOMEASSISTANTSTATESREQUEST = _descriptor.Descriptor(
+  name='SubscribeHomeAssistantStatesRequest',
+  full_name='SubscribeHomeAssistantStatesRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='compact', full_name='SubscribeHomeAssistantStatesRequest.compact', index=0,
+      number=1, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=6215,
+  serialized_end=6278,
+)
+
+
+_SUBSCRIBEHOMEASSISTANTSTATERESPONSE = _descriptor.Descriptor(
+  name='SubscribeHomeAssistantStateResponse',
+  full_name='SubscribeHomeAssistantStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='entity_id', full_name='SubscribeHomeAssistantStateResponse.entity_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='handle', full_name='SubscribeHomeAssistantStateResponse.handle', index=1,
+      number=2, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='numeric', full_name='SubscribeHomeAssistantStateResponse.numeric', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=6280,
+  serialized_end=6396,
+)
+
+
+_HOMEASSISTANTSTATERESPONSE = _descriptor.Descriptor(
+  name='HomeAssistantStateResponse',
+  full_name='HomeAssistantStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='entity_id', full_name='HomeAssistantStateResponse.entity_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='HomeAssistantStateResponse.state', index=1,
+      number=2, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=6398,
+  serialized_end=6477,
+)
+
+
+_HOMEASSISTANTCOMPACTSTATERESPONSE = _descriptor.Descriptor(
+  name='HomeAssistantCompactStateResponse',
+  full_name='HomeAssistantCompactStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='handle', full_name='HomeAssistantCompactStateResponse.handle', index=0,
+      number=1, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='state', full_name='HomeAssistantCompactStateResponse.state', index=1,
+      number=2, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_numeric_state', full_name='HomeAssistantCompactStateResponse.has_numeric_state', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='numeric_state', full_name='HomeAssistantCompactStateResponse.numeric_state', index=3,
+      number=4, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=6480,
+  serialized_end=6642,
+)
+
+
+_GETTIMEREQUEST = _descriptor.Descriptor(
+  name='GetTimeRequest',
+  full_name='GetTimeRequest',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=6644,
+  serialized_end=6660,
+)
+
+
+_GETTIMERESPONSE = _descriptor.Descriptor(
+  name='GetTimeResponse',
+  full_name='GetTimeResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='epoch_seconds', full_name='GetTimeResponse.epoch_seconds', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=6662,
+  serialized_end=6716,
+)
+
+
+_LISTENTITIESSERVICESARGUMENT = _descriptor.Descriptor(
+  name='ListEntitiesServicesArgument',
+  full_name='ListEntitiesServicesArgument',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ListEntitiesServicesArgument.name', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='type', full_name='ListEntitiesServicesArgument.type', index=1,
+      number=2, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=6718,
+  serialized_end=6805,
+)
+
+
+_LISTENTITIESSERVICESRESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesServicesResponse',
+  full_name='ListEntitiesServicesResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='name', full_name='ListEntitiesServicesResponse.name', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='key', full_name='ListEntitiesServicesResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='speed', full_name='FanStateResponse.speed', index=3,
-      number=4, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
+      name='args', full_name='ListEntitiesServicesResponse.args', index=2,
+      number=3, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1172,78 +2853,78 @@ _FANSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1844,
-  serialized_end=1937,
+  serialized_start=6807,
+  serialized_end=6926,
 )
 
 
-_LIGHTSTATERESPONSE = _descriptor.Descriptor(
-  name='LightStateResponse',
-  full_name='LightStateResponse',
+_EXECUTESERVICEARGUMENT = _descriptor.Descriptor(
+  name='ExecuteServiceArgument',
+  full_name='ExecuteServiceArgument',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='LightStateResponse.key', index=0,
-      number=1, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
+      name='bool_', full_name='ExecuteServiceArgument.bool_', index=0,
+      number=1, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='LightStateResponse.state', index=1,
-      number=2, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='legacy_int', full_name='ExecuteServiceArgument.legacy_int', index=1,
+      number=2, type=5, cpp_type=1, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='brightness', full_name='LightStateResponse.brightness', index=2,
+      name='float_', full_name='ExecuteServiceArgument.float_', index=2,
       number=3, type=2, cpp_type=6, label=1,
       has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='red', full_name='LightStateResponse.red', index=3,
-      number=4, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='string_', full_name='ExecuteServiceArgument.string_', index=3,
+      number=4, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='green', full_name='LightStateResponse.green', index=4,
-      number=5, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='int_', full_name='ExecuteServiceArgument.int_', index=4,
+      number=5, type=17, cpp_type=1, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='blue', full_name='LightStateResponse.blue', index=5,
-      number=6, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='bool_array', full_name='ExecuteServiceArgument.bool_array', index=5,
+      number=6, type=8, cpp_type=7, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\000'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='white', full_name='LightStateResponse.white', index=6,
-      number=7, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='int_array', full_name='ExecuteServiceArgument.int_array', index=6,
+      number=7, type=17, cpp_type=1, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\000'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='color_temperature', full_name='LightStateResponse.color_temperature', index=7,
-      number=8, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='float_array', full_name='ExecuteServiceArgument.float_array', index=7,
+      number=8, type=2, cpp_type=6, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
+      serialized_options=_b('\020\000'), file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='effect', full_name='LightStateResponse.effect', index=8,
-      number=9, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='string_array', full_name='ExecuteServiceArgument.string_array', index=8,
+      number=9, type=9, cpp_type=9, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1259,29 +2940,29 @@ _LIGHTSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=1940,
-  serialized_end=2108,
+  serialized_start=6929,
+  serialized_end=7212,
 )
 
 
-_SENSORSTATERESPONSE = _descriptor.Descriptor(
-  name='SensorStateResponse',
-  full_name='SensorStateResponse',
+_EXECUTESERVICEREQUEST = _descriptor.Descriptor(
+  name='ExecuteServiceRequest',
+  full_name='ExecuteServiceRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='SensorStateResponse.key', index=0,
+      name='key', full_name='ExecuteServiceRequest.key', index=0,
       number=1, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='SensorStateResponse.state', index=1,
-      number=2, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='args', full_name='ExecuteServiceRequest.args', index=1,
+      number=2, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1297,66 +2978,42 @@ _SENSORSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2110,
-  serialized_end=2159,
+  serialized_start=7214,
+  serialized_end=7300,
 )
 
 
-_SWITCHSTATERESPONSE = _descriptor.Descriptor(
-  name='SwitchStateResponse',
-  full_name='SwitchStateResponse',
+_LISTENTITIESCAMERARESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesCameraResponse',
+  full_name='ListEntitiesCameraResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='SwitchStateResponse.key', index=0,
-      number=1, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
+      name='object_id', full_name='ListEntitiesCameraResponse.object_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='SwitchStateResponse.state', index=1,
-      number=2, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='key', full_name='ListEntitiesCameraResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2161,
-  serialized_end=2210,
-)
-
-
-_TEXTSENSORSTATERESPONSE = _descriptor.Descriptor(
-  name='TextSensorStateResponse',
-  full_name='TextSensorStateResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='TextSensorStateResponse.key', index=0,
-      number=1, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
+      name='name', full_name='ListEntitiesCameraResponse.name', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='TextSensorStateResponse.state', index=1,
-      number=2, type=9, cpp_type=9, label=1,
+      name='unique_id', full_name='ListEntitiesCameraResponse.unique_id', index=3,
+      number=4, type=9, cpp_type=9, label=1,
       has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
@@ -1373,36 +3030,43 @@ _TEXTSENSORSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2212,
-  serialized_end=2265,
+  serialized_start=7302,
+  serialized_end=7426,
 )
 
 
-_COVERCOMMANDREQUEST = _descriptor.Descriptor(
-  name='CoverCommandRequest',
-  full_name='CoverCommandRequest',
+_CAMERAIMAGERESPONSE = _descriptor.Descriptor(
+  name='CameraImageResponse',
+  full_name='CameraImageResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='CoverCommandRequest.key', index=0,
+      name='key', full_name='CameraImageResponse.key', index=0,
       number=1, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_state', full_name='CoverCommandRequest.has_state', index=1,
-      number=2, type=8, cpp_type=7, label=1,
+      name='data', full_name='CameraImageResponse.data', index=1,
+      number=2, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='done', full_name='CameraImageResponse.done', index=2,
+      number=3, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='command', full_name='CoverCommandRequest.command', index=2,
-      number=3, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
+      name='framerate', full_name='CameraImageResponse.framerate', index=3,
+      number=4, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1411,7 +3075,6 @@ _COVERCOMMANDREQUEST = _descriptor.Descriptor(
   ],
   nested_types=[],
   enum_types=[
-    _COVERCOMMANDREQUEST_COVERCOMMAND,
   ],
   serialized_options=None,
   is_extendable=False,
@@ -1419,64 +3082,50 @@ _COVERCOMMANDREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2268,
-  serialized_end=2420,
+  serialized_start=7428,
+  serialized_end=7537,
 )
 
 
-_FANCOMMANDREQUEST = _descriptor.Descriptor(
-  name='FanCommandRequest',
-  full_name='FanCommandRequest',
+_CAMERAIMAGEREQUEST = _descriptor.Descriptor(
+  name='CameraImageRequest',
+  full_name='CameraImageRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='FanCommandRequest.key', index=0,
-      number=1, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='has_state', full_name='FanCommandRequest.has_state', index=1,
-      number=2, type=8, cpp_type=7, label=1,
+      name='single', full_name='CameraImageRequest.single', index=0,
+      number=1, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='FanCommandRequest.state', index=2,
-      number=3, type=8, cpp_type=7, label=1,
+      name='stream', full_name='CameraImageRequest.stream', index=1,
+      number=2, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_speed', full_name='FanCommandRequest.has_speed', index=3,
-      number=4, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='max_framerate', full_name='CameraImageRequest.max_framerate', index=2,
+      number=3, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='speed', full_name='FanCommandRequest.speed', index=4,
-      number=5, type=14, cpp_type=8, label=1,
+      name='max_width', full_name='CameraImageRequest.max_width', index=3,
+      number=4, type=13, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_oscillating', full_name='FanCommandRequest.has_oscillating', index=5,
-      number=6, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='oscillating', full_name='FanCommandRequest.oscillating', index=6,
-      number=7, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='max_height', full_name='CameraImageRequest.max_height', index=4,
+      number=5, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1492,148 +3141,207 @@ _FANCOMMANDREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2423,
-  serialized_end=2580,
+  serialized_start=7540,
+  serialized_end=7705,
 )
 
 
-_LIGHTCOMMANDREQUEST = _descriptor.Descriptor(
-  name='LightCommandRequest',
-  full_name='LightCommandRequest',
+_LISTENTITIESCLIMATERESPONSE = _descriptor.Descriptor(
+  name='ListEntitiesClimateResponse',
+  full_name='ListEntitiesClimateResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='LightCommandRequest.key', index=0,
-      number=1, type=7, cpp_type=3, label=1,
-      has_default_value=False, default_value=0,
+      name='object_id', full_name='ListEntitiesClimateResponse.object_id', index=0,
+      number=1, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_state', full_name='LightCommandRequest.has_state', index=1,
-      number=2, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='key', full_name='ListEntitiesClimateResponse.key', index=1,
+      number=2, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='LightCommandRequest.state', index=2,
-      number=3, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='name', full_name='ListEntitiesClimateResponse.name', index=2,
+      number=3, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_brightness', full_name='LightCommandRequest.has_brightness', index=3,
-      number=4, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='unique_id', full_name='ListEntitiesClimateResponse.unique_id', index=3,
+      number=4, type=9, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b("").decode('utf-8'),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='brightness', full_name='LightCommandRequest.brightness', index=4,
-      number=5, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='supports_current_temperature', full_name='ListEntitiesClimateResponse.supports_current_temperature', index=4,
+      number=5, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_rgb', full_name='LightCommandRequest.has_rgb', index=5,
+      name='supports_two_point_target_temperature', full_name='ListEntitiesClimateResponse.supports_two_point_target_temperature', index=5,
       number=6, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='red', full_name='LightCommandRequest.red', index=6,
-      number=7, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='supported_modes', full_name='ListEntitiesClimateResponse.supported_modes', index=6,
+      number=7, type=14, cpp_type=8, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='green', full_name='LightCommandRequest.green', index=7,
+      name='visual_min_temperature', full_name='ListEntitiesClimateResponse.visual_min_temperature', index=7,
       number=8, type=2, cpp_type=6, label=1,
       has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='blue', full_name='LightCommandRequest.blue', index=8,
+      name='visual_max_temperature', full_name='ListEntitiesClimateResponse.visual_max_temperature', index=8,
       number=9, type=2, cpp_type=6, label=1,
       has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_white', full_name='LightCommandRequest.has_white', index=9,
-      number=10, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='visual_temperature_step', full_name='ListEntitiesClimateResponse.visual_temperature_step', index=9,
+      number=10, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='white', full_name='LightCommandRequest.white', index=10,
-      number=11, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='supports_away', full_name='ListEntitiesClimateResponse.supports_away', index=10,
+      number=11, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_color_temperature', full_name='LightCommandRequest.has_color_temperature', index=11,
+      name='supports_action', full_name='ListEntitiesClimateResponse.supports_action', index=11,
       number=12, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='color_temperature', full_name='LightCommandRequest.color_temperature', index=12,
-      number=13, type=2, cpp_type=6, label=1,
-      has_default_value=False, default_value=float(0),
+      name='supported_fan_modes', full_name='ListEntitiesClimateResponse.supported_fan_modes', index=12,
+      number=13, type=14, cpp_type=8, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_transition_length', full_name='LightCommandRequest.has_transition_length', index=13,
-      number=14, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='supported_swing_modes', full_name='ListEntitiesClimateResponse.supported_swing_modes', index=13,
+      number=14, type=14, cpp_type=8, label=3,
+      has_default_value=False, default_value=[],
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+  ],
+  extensions=[
+  ],
+  nested_types=[],
+  enum_types=[
+  ],
+  serialized_options=None,
+  is_extendable=False,
+  syntax='proto3',
+  extension_ranges=[],
+  oneofs=[
+  ],
+  serialized_start=7708,
+  serialized_end=8414,
+)
+
+
+_CLIMATESTATERESPONSE = _descriptor.Descriptor(
+  name='ClimateStateResponse',
+  full_name='ClimateStateResponse',
+  filename=None,
+  file=DESCRIPTOR,
+  containing_type=None,
+  fields=[
+    _descriptor.FieldDescriptor(
+      name='key', full_name='ClimateStateResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='transition_length', full_name='LightCommandRequest.transition_length', index=14,
-      number=15, type=13, cpp_type=3, label=1,
+      name='mode', full_name='ClimateStateResponse.mode', index=1,
+      number=2, type=14, cpp_type=8, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_flash_length', full_name='LightCommandRequest.has_flash_length', index=15,
-      number=16, type=8, cpp_type=7, label=1,
+      name='current_temperature', full_name='ClimateStateResponse.current_temperature', index=2,
+      number=3, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='target_temperature', full_name='ClimateStateResponse.target_temperature', index=3,
+      number=4, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='target_temperature_low', full_name='ClimateStateResponse.target_temperature_low', index=4,
+      number=5, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='target_temperature_high', full_name='ClimateStateResponse.target_temperature_high', index=5,
+      number=6, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='away', full_name='ClimateStateResponse.away', index=6,
+      number=7, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='flash_length', full_name='LightCommandRequest.flash_length', index=16,
-      number=17, type=13, cpp_type=3, label=1,
+      name='action', full_name='ClimateStateResponse.action', index=7,
+      number=8, type=14, cpp_type=8, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='has_effect', full_name='LightCommandRequest.has_effect', index=17,
-      number=18, type=8, cpp_type=7, label=1,
-      has_default_value=False, default_value=False,
+      name='fan_mode', full_name='ClimateStateResponse.fan_mode', index=8,
+      number=9, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='effect', full_name='LightCommandRequest.effect', index=18,
-      number=19, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='swing_mode', full_name='ClimateStateResponse.swing_mode', index=9,
+      number=10, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1649,218 +3357,120 @@ _LIGHTCOMMANDREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=2583,
-  serialized_end=2988,
+  serialized_start=8417,
+  serialized_end=8851,
 )
 
 
-_SWITCHCOMMANDREQUEST = _descriptor.Descriptor(
-  name='SwitchCommandRequest',
-  full_name='SwitchCommandRequest',
+_CLIMATECOMMANDREQUEST = _descriptor.Descriptor(
+  name='ClimateCommandRequest',
+  full_name='ClimateCommandRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='SwitchCommandRequest.key', index=0,
+      name='key', full_name='ClimateCommandRequest.key', index=0,
       number=1, type=7, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='state', full_name='SwitchCommandRequest.state', index=1,
+      name='has_mode', full_name='ClimateCommandRequest.has_mode', index=1,
       number=2, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=2990,
-  serialized_end=3040,
-)
-
-
-_SUBSCRIBELOGSREQUEST = _descriptor.Descriptor(
-  name='SubscribeLogsRequest',
-  full_name='SubscribeLogsRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  fields=[
     _descriptor.FieldDescriptor(
-      name='level', full_name='SubscribeLogsRequest.level', index=0,
-      number=1, type=14, cpp_type=8, label=1,
+      name='mode', full_name='ClimateCommandRequest.mode', index=2,
+      number=3, type=14, cpp_type=8, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='dump_config', full_name='SubscribeLogsRequest.dump_config', index=1,
-      number=2, type=8, cpp_type=7, label=1,
+      name='has_target_temperature', full_name='ClimateCommandRequest.has_target_temperature', index=3,
+      number=4, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=3042,
-  serialized_end=3111,
-)
-
-
-_SUBSCRIBELOGSRESPONSE = _descriptor.Descriptor(
-  name='SubscribeLogsResponse',
-  full_name='SubscribeLogsResponse',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  fields=[
     _descriptor.FieldDescriptor(
-      name='level', full_name='SubscribeLogsResponse.level', index=0,
-      number=1, type=14, cpp_type=8, label=1,
-      has_default_value=False, default_value=0,
+      name='target_temperature', full_name='ClimateCommandRequest.target_temperature', index=4,
+      number=5, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='tag', full_name='SubscribeLogsResponse.tag', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='has_target_temperature_low', full_name='ClimateCommandRequest.has_target_temperature_low', index=5,
+      number=6, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='message', full_name='SubscribeLogsResponse.message', index=2,
-      number=3, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='target_temperature_low', full_name='ClimateCommandRequest.target_temperature_low', index=6,
+      number=7, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='send_failed', full_name='SubscribeLogsResponse.send_failed', index=3,
-      number=4, type=8, cpp_type=7, label=1,
+      name='has_target_temperature_high', full_name='ClimateCommandRequest.has_target_temperature_high', index=7,
+      number=8, type=8, cpp_type=7, label=1,
       has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=3113,
-  serialized_end=3213,
-)
-
-
-_SUBSCRIBESERVICECALLSREQUEST = _descriptor.Descriptor(
-  name='SubscribeServiceCallsRequest',
-  full_name='SubscribeServiceCallsRequest',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  fields=[
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=None,
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=3215,
-  serialized_end=3245,
-)
-
-
-_SERVICECALLRESPONSE_DATAENTRY = _descriptor.Descriptor(
-  name='DataEntry',
-  full_name='ServiceCallResponse.DataEntry',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='ServiceCallResponse.DataEntry.key', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='target_temperature_high', full_name='ClimateCommandRequest.target_temperature_high', index=8,
+      number=9, type=2, cpp_type=6, label=1,
+      has_default_value=False, default_value=float(0),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='value', full_name='ServiceCallResponse.DataEntry.value', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='has_away', full_name='ClimateCommandRequest.has_away', index=9,
+      number=10, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
-  ],
-  extensions=[
-  ],
-  nested_types=[],
-  enum_types=[
-  ],
-  serialized_options=_b('8\001'),
-  is_extendable=False,
-  syntax='proto3',
-  extension_ranges=[],
-  oneofs=[
-  ],
-  serialized_start=3453,
-  serialized_end=3496,
-)
-
-_SERVICECALLRESPONSE_DATATEMPLATEENTRY = _descriptor.Descriptor(
-  name='DataTemplateEntry',
-  full_name='ServiceCallResponse.DataTemplateEntry',
-  filename=None,
-  file=DESCRIPTOR,
-  containing_type=None,
-  fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='ServiceCallResponse.DataTemplateEntry.key', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='away', full_name='ClimateCommandRequest.away', index=10,
+      number=11, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='value', full_name='ServiceCallResponse.DataTemplateEntry.value', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='has_fan_mode', full_name='ClimateCommandRequest.has_fan_mode', index=11,
+      number=12, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='fan_mode', full_name='ClimateCommandRequest.fan_mode', index=12,
+      number=13, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='has_swing_mode', full_name='ClimateCommandRequest.has_swing_mode', index=13,
+      number=14, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='swing_mode', full_name='ClimateCommandRequest.swing_mode', index=14,
+      number=15, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1870,34 +3480,42 @@ _SERVICECALLRESPONSE_DATATEMPLATEENTRY = _descriptor.Descriptor(
   nested_types=[],
   enum_types=[
   ],
-  serialized_options=_b('8\001'),
+  serialized_options=None,
   is_extendable=False,
   syntax='proto3',
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3498,
-  serialized_end=3549,
+  serialized_start=8854,
+  serialized_end=9504,
 )
 
-_SERVICECALLRESPONSE_VARIABLESENTRY = _descriptor.Descriptor(
-  name='VariablesEntry',
-  full_name='ServiceCallResponse.VariablesEntry',
+
+_HISTORYREQUEST = _descriptor.Descriptor(
+  name='HistoryRequest',
+  full_name='HistoryRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='key', full_name='ServiceCallResponse.VariablesEntry.key', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='key', full_name='HistoryRequest.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='value', full_name='ServiceCallResponse.VariablesEntry.value', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='resolution', full_name='HistoryRequest.resolution', index=1,
+      number=2, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='since', full_name='HistoryRequest.since', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -1907,55 +3525,63 @@ _SERVICECALLRESPONSE_VARIABLESENTRY = _descriptor.Descriptor(
   nested_types=[],
   enum_types=[
   ],
-  serialized_options=_b('8\001'),
+  serialized_options=None,
   is_extendable=False,
   syntax='proto3',
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3551,
-  serialized_end=3599,
+  serialized_start=9506,
+  serialized_end=9614,
 )
 
-_SERVICECALLRESPONSE = _descriptor.Descriptor(
-  name='ServiceCallResponse',
-  full_name='ServiceCallResponse',
+
+_HISTORYRESPONSE = _descriptor.Descriptor(
+  name='HistoryResponse',
+  full_name='HistoryResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='service', full_name='ServiceCallResponse.service', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='key', full_name='HistoryResponse.key', index=0,
+      number=1, type=7, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='data', full_name='ServiceCallResponse.data', index=1,
-      number=2, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
+      name='resolution', full_name='HistoryResponse.resolution', index=1,
+      number=2, type=14, cpp_type=8, label=1,
+      has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='data_template', full_name='ServiceCallResponse.data_template', index=2,
-      number=3, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
+      name='utc', full_name='HistoryResponse.utc', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
     _descriptor.FieldDescriptor(
-      name='variables', full_name='ServiceCallResponse.variables', index=3,
-      number=4, type=11, cpp_type=10, label=3,
-      has_default_value=False, default_value=[],
+      name='points', full_name='HistoryResponse.points', index=3,
+      number=4, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='done', full_name='HistoryResponse.done', index=4,
+      number=5, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
-  nested_types=[_SERVICECALLRESPONSE_DATAENTRY, _SERVICECALLRESPONSE_DATATEMPLATEENTRY, _SERVICECALLRESPONSE_VARIABLESENTRY, ],
+  nested_types=[],
   enum_types=[
   ],
   serialized_options=None,
@@ -1964,14 +3590,14 @@ _SERVICECALLRESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3248,
-  serialized_end=3599,
+  serialized_start=9617,
+  serialized_end=9766,
 )
 
 
-_SUBSCRIBEHOMEASSISTANTSTATESREQUEST = _descriptor.Descriptor(
-  name='SubscribeHomeAssistantStatesRequest',
-  full_name='SubscribeHomeAssistantStatesRequest',
+_SUBSCRIBEBLUETOOTHLEADVERTISEMENTSREQUEST = _descriptor.Descriptor(
+  name='SubscribeBluetoothLEAdvertisementsRequest',
+  full_name='SubscribeBluetoothLEAdvertisementsRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
@@ -1988,22 +3614,43 @@ _SUBSCRIBEHOMEASSISTANTSTATESREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3601,
-  serialized_end=3638,
+  serialized_start=9768,
+  serialized_end=9811,
 )
 
 
-_SUBSCRIBEHOMEASSISTANTSTATERESPONSE = _descriptor.Descriptor(
-  name='SubscribeHomeAssistantStateResponse',
-  full_name='SubscribeHomeAssistantStateResponse',
+_BLUETOOTHLERAWADVERTISEMENT = _descriptor.Descriptor(
+  name='BluetoothLERawAdvertisement',
+  full_name='BluetoothLERawAdvertisement',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='entity_id', full_name='SubscribeHomeAssistantStateResponse.entity_id', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='address', full_name='BluetoothLERawAdvertisement.address', index=0,
+      number=1, type=4, cpp_type=4, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='rssi', full_name='BluetoothLERawAdvertisement.rssi', index=1,
+      number=2, type=17, cpp_type=1, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='address_type', full_name='BluetoothLERawAdvertisement.address_type', index=2,
+      number=3, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='data', full_name='BluetoothLERawAdvertisement.data', index=3,
+      number=4, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -2019,29 +3666,22 @@ _SUBSCRIBEHOMEASSISTANTSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3640,
-  serialized_end=3696,
+  serialized_start=9814,
+  serialized_end=9944,
 )
 
 
-_HOMEASSISTANTSTATERESPONSE = _descriptor.Descriptor(
-  name='HomeAssistantStateResponse',
-  full_name='HomeAssistantStateResponse',
+_BLUETOOTHLERAWADVERTISEMENTSRESPONSE = _descriptor.Descriptor(
+  name='BluetoothLERawAdvertisementsResponse',
+  full_name='BluetoothLERawAdvertisementsResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='entity_id', full_name='HomeAssistantStateResponse.entity_id', index=0,
-      number=1, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
-      message_type=None, enum_type=None, containing_type=None,
-      is_extension=False, extension_scope=None,
-      serialized_options=None, file=DESCRIPTOR),
-    _descriptor.FieldDescriptor(
-      name='state', full_name='HomeAssistantStateResponse.state', index=1,
-      number=2, type=9, cpp_type=9, label=1,
-      has_default_value=False, default_value=_b("").decode('utf-8'),
+      name='advertisements', full_name='BluetoothLERawAdvertisementsResponse.advertisements', index=0,
+      number=1, type=11, cpp_type=10, label=3,
+      has_default_value=False, default_value=[],
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
@@ -2057,18 +3697,25 @@ _HOMEASSISTANTSTATERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3698,
-  serialized_end=3760,
+  serialized_start=9946,
+  serialized_end=10054,
 )
-
-
-_GETTIMEREQUEST = _descriptor.Descriptor(
-  name='GetTimeRequest',
-  full_name='GetTimeRequest',
+
+
+_STOREDLOGSREQUEST = _descriptor.Descriptor(
+  name='StoredLogsRequest',
+  full_name='StoredLogsRequest',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
+    _descriptor.FieldDescriptor(
+      name='position', full_name='StoredLogsRequest.position', index=0,
+      number=1, type=13, cpp_type=3, label=1,
+      has_default_value=False, default_value=0,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -2081,25 +3728,39 @@ _GETTIMEREQUEST = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3762,
-  serialized_end=3778,
+  serialized_start=10056,
+  serialized_end=10103,
 )
 
 
-_GETTIMERESPONSE = _descriptor.Descriptor(
-  name='GetTimeResponse',
-  full_name='GetTimeResponse',
+_STOREDLOGSRESPONSE = _descriptor.Descriptor(
+  name='StoredLogsResponse',
+  full_name='StoredLogsResponse',
   filename=None,
   file=DESCRIPTOR,
   containing_type=None,
   fields=[
     _descriptor.FieldDescriptor(
-      name='epoch_seconds', full_name='GetTimeResponse.epoch_seconds', index=0,
-      number=1, type=7, cpp_type=3, label=1,
+      name='records', full_name='StoredLogsResponse.records', index=0,
+      number=1, type=12, cpp_type=9, label=1,
+      has_default_value=False, default_value=_b(""),
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='next_position', full_name='StoredLogsResponse.next_position', index=1,
+      number=2, type=13, cpp_type=3, label=1,
       has_default_value=False, default_value=0,
       message_type=None, enum_type=None, containing_type=None,
       is_extension=False, extension_scope=None,
       serialized_options=None, file=DESCRIPTOR),
+    _descriptor.FieldDescriptor(
+      name='done', full_name='StoredLogsResponse.done', index=2,
+      number=3, type=8, cpp_type=7, label=1,
+      has_default_value=False, default_value=False,
+      message_type=None, enum_type=None, containing_type=None,
+      is_extension=False, extension_scope=None,
+      serialized_options=None, file=DESCRIPTOR),
   ],
   extensions=[
   ],
@@ -2112,24 +3773,40 @@ _GETTIMERESPONSE = _descriptor.Descriptor(
   extension_ranges=[],
   oneofs=[
   ],
-  serialized_start=3780,
-  serialized_end=3820,
+  serialized_start=10105,
+  serialized_end=10208,
 )
 
-_COVERSTATERESPONSE.fields_by_name['state'].enum_type = _COVERSTATERESPONSE_COVERSTATE
-_COVERSTATERESPONSE_COVERSTATE.containing_type = _COVERSTATERESPONSE
+_STATESSNAPSHOTRESPONSE.fields_by_name['cover_current_operations'].enum_type = _COVEROPERATION
+_COVERSTATERESPONSE.fields_by_name['legacy_state'].enum_type = _LEGACYCOVERSTATE
+_COVERSTATERESPONSE.fields_by_name['current_operation'].enum_type = _COVEROPERATION
+_COVERCOMMANDREQUEST.fields_by_name['legacy_command'].enum_type = _LEGACYCOVERCOMMAND
 _FANSTATERESPONSE.fields_by_name['speed'].enum_type = _FANSPEED
-_COVERCOMMANDREQUEST.fields_by_name['command'].enum_type = _COVERCOMMANDREQUEST_COVERCOMMAND
-_COVERCOMMANDREQUEST_COVERCOMMAND.containing_type = _COVERCOMMANDREQUEST
+_FANSTATERESPONSE.fields_by_name['direction'].enum_type = _FANDIRECTION
 _FANCOMMANDREQUEST.fields_by_name['speed'].enum_type = _FANSPEED
+_FANCOMMANDREQUEST.fields_by_name['direction'].enum_type = _FANDIRECTION
 _SUBSCRIBELOGSREQUEST.fields_by_name['level'].enum_type = _LOGLEVEL
 _SUBSCRIBELOGSRESPONSE.fields_by_name['level'].enum_type = _LOGLEVEL
-_SERVICECALLRESPONSE_DATAENTRY.containing_type = _SERVICECALLRESPONSE
-_SERVICECALLRESPONSE_DATATEMPLATEENTRY.containing_type = _SERVICECALLRESPONSE
-_SERVICECALLRESPONSE_VARIABLESENTRY.containing_type = _SERVICECALLRESPONSE
-_SERVICECALLRESPONSE.fields_by_name['data'].message_type = _SERVICECALLRESPONSE_DATAENTRY
-_SERVICECALLRESPONSE.fields_by_name['data_template'].message_type = _SERVICECALLRESPONSE_DATATEMPLATEENTRY
-_SERVICECALLRESPONSE.fields_by_name['variables'].message_type = _SERVICECALLRESPONSE_VARIABLESENTRY
+_BINARYLOGRESPONSE.fields_by_name['level'].enum_type = _LOGLEVEL
+_HOMEASSISTANTSERVICERESPONSE.fields_by_name['data'].message_type = _HOMEASSISTANTSERVICEMAP
+_HOMEASSISTANTSERVICERESPONSE.fields_by_name['data_template'].message_type = _HOMEASSISTANTSERVICEMAP
+_HOMEASSISTANTSERVICERESPONSE.fields_by_name['variables'].message_type = _HOMEASSISTANTSERVICEMAP
+_LISTENTITIESSERVICESARGUMENT.fields_by_name['type'].enum_type = _SERVICEARGTYPE
+_LISTENTITIESSERVICESRESPONSE.fields_by_name['args'].message_type = _LISTENTITIESSERVICESARGUMENT
+_EXECUTESERVICEREQUEST.fields_by_name['args'].message_type = _EXECUTESERVICEARGUMENT
+_LISTENTITIESCLIMATERESPONSE.fields_by_name['supported_modes'].enum_type = _CLIMATEMODE
+_LISTENTITIESCLIMATERESPONSE.fields_by_name['supported_fan_modes'].enum_type = _CLIMATEFANMODE
+_LISTENTITIESCLIMATERESPONSE.fields_by_name['supported_swing_modes'].enum_type = _CLIMATESWINGMODE
+_CLIMATESTATERESPONSE.fields_by_name['mode'].enum_type = _CLIMATEMODE
+_CLIMATESTATERESPONSE.fields_by_name['action'].enum_type = _CLIMATEACTION
+_CLIMATESTATERESPONSE.fields_by_name['fan_mode'].enum_type = _CLIMATEFANMODE
+_CLIMATESTATERESPONSE.fields_by_name['swing_mode'].enum_type = _CLIMATESWINGMODE
+_CLIMATECOMMANDREQUEST.fields_by_name['mode'].enum_type = _CLIMATEMODE
+_CLIMATECOMMANDREQUEST.fields_by_name['fan_mode'].enum_type = _CLIMATEFANMODE
+_CLIMATECOMMANDREQUEST.fields_by_name['swing_mode'].enum_type = _CLIMATESWINGMODE
+_HISTORYREQUEST.fields_by_name['resolution'].enum_type = _HISTORYRESOLUTION
+_HISTORYRESPONSE.fields_by_name['resolution'].enum_type = _HISTORYRESOLUTION
+_BLUETOOTHLERAWADVERTISEMENTSRESPONSE.fields_by_name['advertisements'].message_type = _BLUETOOTHLERAWADVERTISEMENT
 DESCRIPTOR.message_types_by_name['HelloRequest'] = _HELLOREQUEST
 DESCRIPTOR.message_types_by_name['HelloResponse'] = _HELLORESPONSE
 DESCRIPTOR.message_types_by_name['ConnectRequest'] = _CONNECTREQUEST
@@ -2141,37 +3818,68 @@ DESCRIPTOR.message_types_by_name['PingResponse'] = _PINGRESPONSE
 DESCRIPTOR.message_types_by_name['DeviceInfoRequest'] = _DEVICEINFOREQUEST
 DESCRIPTOR.message_types_by_name['DeviceInfoResponse'] = _DEVICEINFORESPONSE
 DESCRIPTOR.message_types_by_name['ListEntitiesRequest'] = _LISTENTITIESREQUEST
-DESCRIPTOR.message_types_by_name['ListEntitiesBinarySensorResponse'] = _LISTENTITIESBINARYSENSORRESPONSE
-DESCRIPTOR.message_types_by_name['ListEntitiesCoverResponse'] = _LISTENTITIESCOVERRESPONSE
-DESCRIPTOR.message_types_by_name['ListEntitiesFanResponse'] = _LISTENTITIESFANRESPONSE
-DESCRIPTOR.message_types_by_name['ListEntitiesLightResponse'] = _LISTENTITIESLIGHTRESPONSE
-DESCRIPTOR.message_types_by_name['ListEntitiesSensorResponse'] = _LISTENTITIESSENSORRESPONSE
-DESCRIPTOR.message_types_by_name['ListEntitiesSwitchResponse'] = _LISTENTITIESSWITCHRESPONSE
-DESCRIPTOR.message_types_by_name['ListEntitiesTextSensorResponse'] = _LISTENTITIESTEXTSENSORRESPONSE
 DESCRIPTOR.message_types_by_name['ListEntitiesDoneResponse'] = _LISTENTITIESDONERESPONSE
 DESCRIPTOR.message_types_by_name['SubscribeStatesRequest'] = _SUBSCRIBESTATESREQUEST
+DESCRIPTOR.message_types_by_name['StatesSnapshotResponse'] = _STATESSNAPSHOTRESPONSE
+DESCRIPTOR.message_types_by_name['ListEntitiesBinarySensorResponse'] = _LISTENTITIESBINARYSENSORRESPONSE
 DESCRIPTOR.message_types_by_name['BinarySensorStateResponse'] = _BINARYSENSORSTATERESPONSE
+DESCRIPTOR.message_types_by_name['ListEntitiesCoverResponse'] = _LISTENTITIESCOVERRESPONSE
 DESCRIPTOR.message_types_by_name['CoverStateResponse'] = _COVERSTATERESPONSE
+DESCRIPTOR.message_types_by_name['CoverCommandRequest'] = _COVERCOMMANDREQUEST
+DESCRIPTOR.message_types_by_name['ListEntitiesFanResponse'] = _LISTENTITIESFANRESPONSE
 DESCRIPTOR.message_types_by_name['FanStateResponse'] = _FANSTATERESPONSE
+DESCRIPTOR.message_types_by_name['FanCommandRequest'] = _FANCOMMANDREQUEST
+DESCRIPTOR.message_types_by_name['ListEntitiesLightResponse'] = _LISTENTITIESLIGHTRESPONSE
 DESCRIPTOR.message_types_by_name['LightStateResponse'] = _LIGHTSTATERESPONSE
+DESCRIPTOR.message_types_by_name['LightCommandRequest'] = _LIGHTCOMMANDREQUEST
+DESCRIPTOR.message_types_by_name['ListEntitiesSensorResponse'] = _LISTENTITIESSENSORRESPONSE
 DESCRIPTOR.message_types_by_name['SensorStateResponse'] = _SENSORSTATERESPONSE
+DESCRIPTOR.message_types_by_name['ListEntitiesSwitchResponse'] = _LISTENTITIESSWITCHRESPONSE
 DESCRIPTOR.message_types_by_name['SwitchStateResponse'] = _SWITCHSTATERESPONSE
-DESCRIPTOR.message_types_by_name['TextSensorStateResponse'] = _TEXTSENSORSTATERESPONSE
-DESCRIPTOR.message_types_by_name['CoverCommandRequest'] = _COVERCOMMANDREQUEST
-DESCRIPTOR.message_types_by_name['FanCommandRequest'] = _FANCOMMANDREQUEST
-DESCRIPTOR.message_types_by_name['LightCommandRequest'] = _LIGHTCOMMANDREQUEST
 DESCRIPTOR.message_types_by_name['SwitchCommandRequest'] = _SWITCHCOMMANDREQUEST
+DESCRIPTOR.message_types_by_name['ListEntitiesTextSensorResponse'] = _LISTENTITIESTEXTSENSORRESPONSE
+DESCRIPTOR.message_types_by_name['TextSensorStateResponse'] = _TEXTSENSORSTATERESPONSE
 DESCRIPTOR.message_types_by_name['SubscribeLogsRequest'] = _SUBSCRIBELOGSREQUEST
 DESCRIPTOR.message_types_by_name['SubscribeLogsResponse'] = _SUBSCRIBELOGSRESPONSE
-DESCRIPTOR.message_types_by_name['SubscribeServiceCallsRequest'] = _SUBSCRIBESERVICECALLSREQUEST
-DESCRIPTOR.message_types_by_name['ServiceCallResponse'] = _SERVICECALLRESPONSE
+DESCRIPTOR.message_types_by_name['BinaryLogResponse'] = _BINARYLOGRESPONSE
+DESCRIPTOR.message_types_by_name['SubscribeHomeassistantServicesRequest'] = _SUBSCRIBEHOMEASSISTANTSERVICESREQUEST
+DESCRIPTOR.message_types_by_name['HomeassistantServiceMap'] = _HOMEASSISTANTSERVICEMAP
+DESCRIPTOR.message_types_by_name['HomeassistantServiceResponse'] = _HOMEASSISTANTSERVICERESPONSE
 DESCRIPTOR.message_types_by_name['SubscribeHomeAssistantStatesRequest'] = _SUBSCRIBEHOMEASSISTANTSTATESREQUEST
 DESCRIPTOR.message_types_by_name['SubscribeHomeAssistantStateResponse'] = _SUBSCRIBEHOMEASSISTANTSTATERESPONSE
 DESCRIPTOR.message_types_by_name['HomeAssistantStateResponse'] = _HOMEASSISTANTSTATERESPONSE
+DESCRIPTOR.message_types_by_name['HomeAssistantCompactStateResponse'] = _HOMEASSISTANTCOMPACTSTATERESPONSE
 DESCRIPTOR.message_types_by_name['GetTimeRequest'] = _GETTIMEREQUEST
 DESCRIPTOR.message_types_by_name['GetTimeResponse'] = _GETTIMERESPONSE
+DESCRIPTOR.message_types_by_name['ListEntitiesServicesArgument'] = _LISTENTITIESSERVICESARGUMENT
+DESCRIPTOR.message_types_by_name['ListEntitiesServicesResponse'] = _LISTENTITIESSERVICESRESPONSE
+DESCRIPTOR.message_types_by_name['ExecuteServiceArgument'] = _EXECUTESERVICEARGUMENT
+DESCRIPTOR.message_types_by_name['ExecuteServiceRequest'] = _EXECUTESERVICEREQUEST
+DESCRIPTOR.message_types_by_name['ListEntitiesCameraResponse'] = _LISTENTITIESCAMERARESPONSE
+DESCRIPTOR.message_types_by_name['CameraImageResponse'] = _CAMERAIMAGERESPONSE
+DESCRIPTOR.message_types_by_name['CameraImageRequest'] = _CAMERAIMAGEREQUEST
+DESCRIPTOR.message_types_by_name['ListEntitiesClimateResponse'] = _LISTENTITIESCLIMATERESPONSE
+DESCRIPTOR.message_types_by_name['ClimateStateResponse'] = _CLIMATESTATERESPONSE
+DESCRIPTOR.message_types_by_name['ClimateCommandRequest'] = _CLIMATECOMMANDREQUEST
+DESCRIPTOR.message_types_by_name['HistoryRequest'] = _HISTORYREQUEST
+DESCRIPTOR.message_types_by_name['HistoryResponse'] = _HISTORYRESPONSE
+DESCRIPTOR.message_types_by_name['SubscribeBluetoothLEAdvertisementsRequest'] = _SUBSCRIBEBLUETOOTHLEADVERTISEMENTSREQUEST
+DESCRIPTOR.message_types_by_name['BluetoothLERawAdvertisement'] = _BLUETOOTHLERAWADVERTISEMENT
+DESCRIPTOR.message_types_by_name['BluetoothLERawAdvertisementsResponse'] = _BLUETOOTHLERAWADVERTISEMENTSRESPONSE
+DESCRIPTOR.message_types_by_name['StoredLogsRequest'] = _STOREDLOGSREQUEST
+DESCRIPTOR.message_types_by_name['StoredLogsResponse'] = _STOREDLOGSRESPONSE
+DESCRIPTOR.enum_types_by_name['LegacyCoverState'] = _LEGACYCOVERSTATE
+DESCRIPTOR.enum_types_by_name['CoverOperation'] = _COVEROPERATION
+DESCRIPTOR.enum_types_by_name['LegacyCoverCommand'] = _LEGACYCOVERCOMMAND
 DESCRIPTOR.enum_types_by_name['FanSpeed'] = _FANSPEED
+DESCRIPTOR.enum_types_by_name['FanDirection'] = _FANDIRECTION
 DESCRIPTOR.enum_types_by_name['LogLevel'] = _LOGLEVEL
+DESCRIPTOR.enum_types_by_name['ServiceArgType'] = _SERVICEARGTYPE
+DESCRIPTOR.enum_types_by_name['ClimateMode'] = _CLIMATEMODE
+DESCRIPTOR.enum_types_by_name['ClimateFanMode'] = _CLIMATEFANMODE
+DESCRIPTOR.enum_types_by_name['ClimateSwingMode'] = _CLIMATESWINGMODE
+DESCRIPTOR.enum_types_by_name['ClimateAction'] = _CLIMATEACTION
+DESCRIPTOR.enum_types_by_name['HistoryResolution'] = _HISTORYRESOLUTION
 _sym_db.RegisterFileDescriptor(DESCRIPTOR)
 
 HelloRequest = _reflection.GeneratedProtocolMessageType('HelloRequest', (_message.Message,), dict(
@@ -2251,89 +3959,89 @@ ListEntitiesRequest = _reflection.GeneratedProtocolMessageType('ListEntitiesRequ
   ))
 _sym_db.RegisterMessage(ListEntitiesRequest)
 
-ListEntitiesBinarySensorResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesBinarySensorResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESBINARYSENSORRESPONSE,
+ListEntitiesDoneResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesDoneResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESDONERESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesBinarySensorResponse)
+  # @@protoc_insertion_point(class_scope:ListEntitiesDoneResponse)
   ))
-_sym_db.RegisterMessage(ListEntitiesBinarySensorResponse)
+_sym_db.RegisterMessage(ListEntitiesDoneResponse)
 
-ListEntitiesCoverResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesCoverResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESCOVERRESPONSE,
+SubscribeStatesRequest = _reflection.GeneratedProtocolMessageType('SubscribeStatesRequest', (_message.Message,), dict(
+  DESCRIPTOR = _SUBSCRIBESTATESREQUEST,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesCoverResponse)
+  # @@protoc_insertion_point(class_scope:SubscribeStatesRequest)
   ))
-_sym_db.RegisterMessage(ListEntitiesCoverResponse)
+_sym_db.RegisterMessage(SubscribeStatesRequest)
 
-ListEntitiesFanResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesFanResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESFANRESPONSE,
+StatesSnapshotResponse = _reflection.GeneratedProtocolMessageType('StatesSnapshotResponse', (_message.Message,), dict(
+  DESCRIPTOR = _STATESSNAPSHOTRESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesFanResponse)
+  # @@protoc_insertion_point(class_scope:StatesSnapshotResponse)
   ))
-_sym_db.RegisterMessage(ListEntitiesFanResponse)
+_sym_db.RegisterMessage(StatesSnapshotResponse)
 
-ListEntitiesLightResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesLightResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESLIGHTRESPONSE,
+ListEntitiesBinarySensorResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesBinarySensorResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESBINARYSENSORRESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesLightResponse)
+  # @@protoc_insertion_point(class_scope:ListEntitiesBinarySensorResponse)
   ))
-_sym_db.RegisterMessage(ListEntitiesLightResponse)
+_sym_db.RegisterMessage(ListEntitiesBinarySensorResponse)
 
-ListEntitiesSensorResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesSensorResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESSENSORRESPONSE,
+BinarySensorStateResponse = _reflection.GeneratedProtocolMessageType('BinarySensorStateResponse', (_message.Message,), dict(
+  DESCRIPTOR = _BINARYSENSORSTATERESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesSensorResponse)
+  # @@protoc_insertion_point(class_scope:BinarySensorStateResponse)
   ))
-_sym_db.RegisterMessage(ListEntitiesSensorResponse)
+_sym_db.RegisterMessage(BinarySensorStateResponse)
 
-ListEntitiesSwitchResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesSwitchResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESSWITCHRESPONSE,
+ListEntitiesCoverResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesCoverResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESCOVERRESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesSwitchResponse)
+  # @@protoc_insertion_point(class_scope:ListEntitiesCoverResponse)
   ))
-_sym_db.RegisterMessage(ListEntitiesSwitchResponse)
+_sym_db.RegisterMessage(ListEntitiesCoverResponse)
 
-ListEntitiesTextSensorResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesTextSensorResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESTEXTSENSORRESPONSE,
+CoverStateResponse = _reflection.GeneratedProtocolMessageType('CoverStateResponse', (_message.Message,), dict(
+  DESCRIPTOR = _COVERSTATERESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesTextSensorResponse)
+  # @@protoc_insertion_point(class_scope:CoverStateResponse)
   ))
-_sym_db.RegisterMessage(ListEntitiesTextSensorResponse)
+_sym_db.RegisterMessage(CoverStateResponse)
 
-ListEntitiesDoneResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesDoneResponse', (_message.Message,), dict(
-  DESCRIPTOR = _LISTENTITIESDONERESPONSE,
+CoverCommandRequest = _reflection.GeneratedProtocolMessageType('CoverCommandRequest', (_message.Message,), dict(
+  DESCRIPTOR = _COVERCOMMANDREQUEST,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ListEntitiesDoneResponse)
+  # @@protoc_insertion_point(class_scope:CoverCommandRequest)
   ))
-_sym_db.RegisterMessage(ListEntitiesDoneResponse)
+_sym_db.RegisterMessage(CoverCommandRequest)
 
-SubscribeStatesRequest = _reflection.GeneratedProtocolMessageType('SubscribeStatesRequest', (_message.Message,), dict(
-  DESCRIPTOR = _SUBSCRIBESTATESREQUEST,
+ListEntitiesFanResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesFanResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESFANRESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:SubscribeStatesRequest)
+  # @@protoc_insertion_point(class_scope:ListEntitiesFanResponse)
   ))
-_sym_db.RegisterMessage(SubscribeStatesRequest)
+_sym_db.RegisterMessage(ListEntitiesFanResponse)
 
-BinarySensorStateResponse = _reflection.GeneratedProtocolMessageType('BinarySensorStateResponse', (_message.Message,), dict(
-  DESCRIPTOR = _BINARYSENSORSTATERESPONSE,
+FanStateResponse = _reflection.GeneratedProtocolMessageType('FanStateResponse', (_message.Message,), dict(
+  DESCRIPTOR = _FANSTATERESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:BinarySensorStateResponse)
+  # @@protoc_insertion_point(class_scope:FanStateResponse)
   ))
-_sym_db.RegisterMessage(BinarySensorStateResponse)
+_sym_db.RegisterMessage(FanStateResponse)
 
-CoverStateResponse = _reflection.GeneratedProtocolMessageType('CoverStateResponse', (_message.Message,), dict(
-  DESCRIPTOR = _COVERSTATERESPONSE,
+FanCommandRequest = _reflection.GeneratedProtocolMessageType('FanCommandRequest', (_message.Message,), dict(
+  DESCRIPTOR = _FANCOMMANDREQUEST,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:CoverStateResponse)
+  # @@protoc_insertion_point(class_scope:FanCommandRequest)
   ))
-_sym_db.RegisterMessage(CoverStateResponse)
+_sym_db.RegisterMessage(FanCommandRequest)
 
-FanStateResponse = _reflection.GeneratedProtocolMessageType('FanStateResponse', (_message.Message,), dict(
-  DESCRIPTOR = _FANSTATERESPONSE,
+ListEntitiesLightResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesLightResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESLIGHTRESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:FanStateResponse)
+  # @@protoc_insertion_point(class_scope:ListEntitiesLightResponse)
   ))
-_sym_db.RegisterMessage(FanStateResponse)
+_sym_db.RegisterMessage(ListEntitiesLightResponse)
 
 LightStateResponse = _reflection.GeneratedProtocolMessageType('LightStateResponse', (_message.Message,), dict(
   DESCRIPTOR = _LIGHTSTATERESPONSE,
@@ -2342,6 +4050,20 @@ LightStateResponse = _reflection.GeneratedProtocolMessageType('LightStateRespons
   ))
 _sym_db.RegisterMessage(LightStateResponse)
 
+LightCommandRequest = _reflection.GeneratedProtocolMessageType('LightCommandRequest', (_message.Message,), dict(
+  DESCRIPTOR = _LIGHTCOMMANDREQUEST,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:LightCommandRequest)
+  ))
+_sym_db.RegisterMessage(LightCommandRequest)
+
+ListEntitiesSensorResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesSensorResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESSENSORRESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ListEntitiesSensorResponse)
+  ))
+_sym_db.RegisterMessage(ListEntitiesSensorResponse)
+
 SensorStateResponse = _reflection.GeneratedProtocolMessageType('SensorStateResponse', (_message.Message,), dict(
   DESCRIPTOR = _SENSORSTATERESPONSE,
   __module__ = 'api_pb2'
@@ -2349,6 +4071,13 @@ SensorStateResponse = _reflection.GeneratedProtocolMessageType('SensorStateRespo
   ))
 _sym_db.RegisterMessage(SensorStateResponse)
 
+ListEntitiesSwitchResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesSwitchResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESSWITCHRESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ListEntitiesSwitchResponse)
+  ))
+_sym_db.RegisterMessage(ListEntitiesSwitchResponse)
+
 SwitchStateResponse = _reflection.GeneratedProtocolMessageType('SwitchStateResponse', (_message.Message,), dict(
   DESCRIPTOR = _SWITCHSTATERESPONSE,
   __module__ = 'api_pb2'
@@ -2356,40 +4085,26 @@ SwitchStateResponse = _reflection.GeneratedProtocolMessageType('SwitchStateRespo
   ))
 _sym_db.RegisterMessage(SwitchStateResponse)
 
-TextSensorStateResponse = _reflection.GeneratedProtocolMessageType('TextSensorStateResponse', (_message.Message,), dict(
-  DESCRIPTOR = _TEXTSENSORSTATERESPONSE,
-  __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:TextSensorStateResponse)
-  ))
-_sym_db.RegisterMessage(TextSensorStateResponse)
-
-CoverCommandRequest = _reflection.GeneratedProtocolMessageType('CoverCommandRequest', (_message.Message,), dict(
-  DESCRIPTOR = _COVERCOMMANDREQUEST,
-  __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:CoverCommandRequest)
-  ))
-_sym_db.RegisterMessage(CoverCommandRequest)
-
-FanCommandRequest = _reflection.GeneratedProtocolMessageType('FanCommandRequest', (_message.Message,), dict(
-  DESCRIPTOR = _FANCOMMANDREQUEST,
+SwitchCommandRequest = _reflection.GeneratedProtocolMessageType('SwitchCommandRequest', (_message.Message,), dict(
+  DESCRIPTOR = _SWITCHCOMMANDREQUEST,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:FanCommandRequest)
+  # @@protoc_insertion_point(class_scope:SwitchCommandRequest)
   ))
-_sym_db.RegisterMessage(FanCommandRequest)
+_sym_db.RegisterMessage(SwitchCommandRequest)
 
-LightCommandRequest = _reflection.GeneratedProtocolMessageType('LightCommandRequest', (_message.Message,), dict(
-  DESCRIPTOR = _LIGHTCOMMANDREQUEST,
+ListEntitiesTextSensorResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesTextSensorResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESTEXTSENSORRESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:LightCommandRequest)
+  # @@protoc_insertion_point(class_scope:ListEntitiesTextSensorResponse)
   ))
-_sym_db.RegisterMessage(LightCommandRequest)
+_sym_db.RegisterMessage(ListEntitiesTextSensorResponse)
 
-SwitchCommandRequest = _reflection.GeneratedProtocolMessageType('SwitchCommandRequest', (_message.Message,), dict(
-  DESCRIPTOR = _SWITCHCOMMANDREQUEST,
+TextSensorStateResponse = _reflection.GeneratedProtocolMessageType('TextSensorStateResponse', (_message.Message,), dict(
+  DESCRIPTOR = _TEXTSENSORSTATERESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:SwitchCommandRequest)
+  # @@protoc_insertion_point(class_scope:TextSensorStateResponse)
   ))
-_sym_db.RegisterMessage(SwitchCommandRequest)
+_sym_db.RegisterMessage(TextSensorStateResponse)
 
 SubscribeLogsRequest = _reflection.GeneratedProtocolMessageType('SubscribeLogsRequest', (_message.Message,), dict(
   DESCRIPTOR = _SUBSCRIBELOGSREQUEST,
@@ -2405,43 +4120,33 @@ SubscribeLogsResponse = _reflection.GeneratedProtocolMessageType('SubscribeLogsR
   ))
 _sym_db.RegisterMessage(SubscribeLogsResponse)
 
-SubscribeServiceCallsRequest = _reflection.GeneratedProtocolMessageType('SubscribeServiceCallsRequest', (_message.Message,), dict(
-  DESCRIPTOR = _SUBSCRIBESERVICECALLSREQUEST,
+BinaryLogResponse = _reflection.GeneratedProtocolMessageType('BinaryLogResponse', (_message.Message,), dict(
+  DESCRIPTOR = _BINARYLOGRESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:BinaryLogResponse)
+  ))
+_sym_db.RegisterMessage(BinaryLogResponse)
+
+SubscribeHomeassistantServicesRequest = _reflection.GeneratedProtocolMessageType('SubscribeHomeassistantServicesRequest', (_message.Message,), dict(
+  DESCRIPTOR = _SUBSCRIBEHOMEASSISTANTSERVICESREQUEST,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:SubscribeServiceCallsRequest)
+  # @@protoc_insertion_point(class_scope:SubscribeHomeassistantServicesRequest)
   ))
-_sym_db.RegisterMessage(SubscribeServiceCallsRequest)
-
-ServiceCallResponse = _reflection.GeneratedProtocolMessageType('ServiceCallResponse', (_message.Message,), dict(
-
-  DataEntry = _reflection.GeneratedProtocolMessageType('DataEntry', (_message.Message,), dict(
-    DESCRIPTOR = _SERVICECALLRESPONSE_DATAENTRY,
-    __module__ = 'api_pb2'
-    # @@protoc_insertion_point(class_scope:ServiceCallResponse.DataEntry)
-    ))
-  ,
-
-  DataTemplateEntry = _reflection.GeneratedProtocolMessageType('DataTemplateEntry', (_message.Message,), dict(
-    DESCRIPTOR = _SERVICECALLRESPONSE_DATATEMPLATEENTRY,
-    __module__ = 'api_pb2'
-    # @@protoc_insertion_point(class_scope:ServiceCallResponse.DataTemplateEntry)
-    ))
-  ,
-
-  VariablesEntry = _reflection.GeneratedProtocolMessageType('VariablesEntry', (_message.Message,), dict(
-    DESCRIPTOR = _SERVICECALLRESPONSE_VARIABLESENTRY,
-    __module__ = 'api_pb2'
-    # @@protoc_insertion_point(class_scope:ServiceCallResponse.VariablesEntry)
-    ))
-  ,
-  DESCRIPTOR = _SERVICECALLRESPONSE,
+_sym_db.RegisterMessage(SubscribeHomeassistantServicesRequest)
+
+HomeassistantServiceMap = _reflection.GeneratedProtocolMessageType('HomeassistantServiceMap', (_message.Message,), dict(
+  DESCRIPTOR = _HOMEASSISTANTSERVICEMAP,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:HomeassistantServiceMap)
+  ))
+_sym_db.RegisterMessage(HomeassistantServiceMap)
+
+HomeassistantServiceResponse = _reflection.GeneratedProtocolMessageType('HomeassistantServiceResponse', (_message.Message,), dict(
+  DESCRIPTOR = _HOMEASSISTANTSERVICERESPONSE,
   __module__ = 'api_pb2'
-  # @@protoc_insertion_point(class_scope:ServiceCallResponse)
+  # @@protoc_insertion_point(class_scope:HomeassistantServiceResponse)
   ))
-_sym_db.RegisterMessage(ServiceCallResponse)
-_sym_db.RegisterMessage(ServiceCallResponse.DataEntry)
-_sym_db.RegisterMessage(ServiceCallResponse.DataTemplateEntry)
-_sym_db.RegisterMessage(ServiceCallResponse.VariablesEntry)
+_sym_db.RegisterMessage(HomeassistantServiceResponse)
 
 SubscribeHomeAssistantStatesRequest = _reflection.GeneratedProtocolMessageType('SubscribeHomeAssistantStatesRequest', (_message.Message,), dict(
   DESCRIPTOR = _SUBSCRIBEHOMEASSISTANTSTATESREQUEST,
@@ -2464,6 +4169,13 @@ HomeAssistantStateResponse = _reflection.GeneratedProtocolMessageType('HomeAssis
   ))
 _sym_db.RegisterMessage(HomeAssistantStateResponse)
 
+HomeAssistantCompactStateResponse = _reflection.GeneratedProtocolMessageType('HomeAssistantCompactStateResponse', (_message.Message,), dict(
+  DESCRIPTOR = _HOMEASSISTANTCOMPACTSTATERESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:HomeAssistantCompactStateResponse)
+  ))
+_sym_db.RegisterMessage(HomeAssistantCompactStateResponse)
+
 GetTimeRequest = _reflection.GeneratedProtocolMessageType('GetTimeRequest', (_message.Message,), dict(
   DESCRIPTOR = _GETTIMEREQUEST,
   __module__ = 'api_pb2'
@@ -2478,8 +4190,138 @@ GetTimeResponse = _reflection.GeneratedProtocolMessageType('GetTimeResponse', (_
   ))
 _sym_db.RegisterMessage(GetTimeResponse)
 
+ListEntitiesServicesArgument = _reflection.GeneratedProtocolMessageType('ListEntitiesServicesArgument', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESSERVICESARGUMENT,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ListEntitiesServicesArgument)
+  ))
+_sym_db.RegisterMessage(ListEntitiesServicesArgument)
+
+ListEntitiesServicesResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesServicesResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESSERVICESRESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ListEntitiesServicesResponse)
+  ))
+_sym_db.RegisterMessage(ListEntitiesServicesResponse)
+
+ExecuteServiceArgument = _reflection.GeneratedProtocolMessageType('ExecuteServiceArgument', (_message.Message,), dict(
+  DESCRIPTOR = _EXECUTESERVICEARGUMENT,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ExecuteServiceArgument)
+  ))
+_sym_db.RegisterMessage(ExecuteServiceArgument)
+
+ExecuteServiceRequest = _reflection.GeneratedProtocolMessageType('ExecuteServiceRequest', (_message.Message,), dict(
+  DESCRIPTOR = _EXECUTESERVICEREQUEST,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ExecuteServiceRequest)
+  ))
+_sym_db.RegisterMessage(ExecuteServiceRequest)
+
+ListEntitiesCameraResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesCameraResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESCAMERARESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ListEntitiesCameraResponse)
+  ))
+_sym_db.RegisterMessage(ListEntitiesCameraResponse)
+
+CameraImageResponse = _reflection.GeneratedProtocolMessageType('CameraImageResponse', (_message.Message,), dict(
+  DESCRIPTOR = _CAMERAIMAGERESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:CameraImageResponse)
+  ))
+_sym_db.RegisterMessage(CameraImageResponse)
+
+CameraImageRequest = _reflection.GeneratedProtocolMessageType('CameraImageRequest', (_message.Message,), dict(
+  DESCRIPTOR = _CAMERAIMAGEREQUEST,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:CameraImageRequest)
+  ))
+_sym_db.RegisterMessage(CameraImageRequest)
+
+ListEntitiesClimateResponse = _reflection.GeneratedProtocolMessageType('ListEntitiesClimateResponse', (_message.Message,), dict(
+  DESCRIPTOR = _LISTENTITIESCLIMATERESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ListEntitiesClimateResponse)
+  ))
+_sym_db.RegisterMessage(ListEntitiesClimateResponse)
+
+ClimateStateResponse = _reflection.GeneratedProtocolMessageType('ClimateStateResponse', (_message.Message,), dict(
+  DESCRIPTOR = _CLIMATESTATERESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ClimateStateResponse)
+  ))
+_sym_db.RegisterMessage(ClimateStateResponse)
+
+ClimateCommandRequest = _reflection.GeneratedProtocolMessageType('ClimateCommandRequest', (_message.Message,), dict(
+  DESCRIPTOR = _CLIMATECOMMANDREQUEST,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:ClimateCommandRequest)
+  ))
+_sym_db.RegisterMessage(ClimateCommandRequest)
+
+HistoryRequest = _reflection.GeneratedProtocolMessageType('HistoryRequest', (_message.Message,), dict(
+  DESCRIPTOR = _HISTORYREQUEST,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:HistoryRequest)
+  ))
+_sym_db.RegisterMessage(HistoryRequest)
+
+HistoryResponse = _reflection.GeneratedProtocolMessageType('HistoryResponse', (_message.Message,), dict(
+  DESCRIPTOR = _HISTORYRESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:HistoryResponse)
+  ))
+_sym_db.RegisterMessage(HistoryResponse)
+
+SubscribeBluetoothLEAdvertisementsRequest = _reflection.GeneratedProtocolMessageType('SubscribeBluetoothLEAdvertisementsRequest', (_message.Message,), dict(
+  DESCRIPTOR = _SUBSCRIBEBLUETOOTHLEADVERTISEMENTSREQUEST,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:SubscribeBluetoothLEAdvertisementsRequest)
+  ))
+_sym_db.RegisterMessage(SubscribeBluetoothLEAdvertisementsRequest)
+
+BluetoothLERawAdvertisement = _reflection.GeneratedProtocolMessageType('BluetoothLERawAdvertisement', (_message.Message,), dict(
+  DESCRIPTOR = _BLUETOOTHLERAWADVERTISEMENT,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:BluetoothLERawAdvertisement)
+  ))
+_sym_db.RegisterMessage(BluetoothLERawAdvertisement)
 
-_SERVICECALLRESPONSE_DATAENTRY._options = None
-_SERVICECALLRESPONSE_DATATEMPLATEENTRY._options = None
-_SERVICECALLRESPONSE_VARIABLESENTRY._options = None
+BluetoothLERawAdvertisementsResponse = _reflection.GeneratedProtocolMessageType('BluetoothLERawAdvertisementsResponse', (_message.Message,), dict(
+  DESCRIPTOR = _BLUETOOTHLERAWADVERTISEMENTSRESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:BluetoothLERawAdvertisementsResponse)
+  ))
+_sym_db.RegisterMessage(BluetoothLERawAdvertisementsResponse)
+
+StoredLogsRequest = _reflection.GeneratedProtocolMessageType('StoredLogsRequest', (_message.Message,), dict(
+  DESCRIPTOR = _STOREDLOGSREQUEST,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:StoredLogsRequest)
+  ))
+_sym_db.RegisterMessage(StoredLogsRequest)
+
+StoredLogsResponse = _reflection.GeneratedProtocolMessageType('StoredLogsResponse', (_message.Message,), dict(
+  DESCRIPTOR = _STOREDLOGSRESPONSE,
+  __module__ = 'api_pb2'
+  # @@protoc_insertion_point(class_scope:StoredLogsResponse)
+  ))
+_sym_db.RegisterMessage(StoredLogsResponse)
+
+
+_STATESSNAPSHOTRESPONSE.fields_by_name['binary_sensor_keys']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['binary_sensor_states']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['cover_keys']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['cover_positions']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['cover_tilts']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['cover_current_operations']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['sensor_keys']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['sensor_states']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['switch_keys']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['switch_states']._options = None
+_STATESSNAPSHOTRESPONSE.fields_by_name['missing_state_keys']._options = None
+_EXECUTESERVICEARGUMENT.fields_by_name['bool_array']._options = None
+_EXECUTESERVICEARGUMENT.fields_by_name['int_array']._options = None
+_EXECUTESERVICEARGUMENT.fields_by_name['float_array']._options = None
 # @@protoc_insertion_point(module_scope)
@@ -0,0 +1,217 @@
+"""Helpers for the binary log transport of the native API (BinaryLogResponse).
+
+The device only sends an id of the format string together with the encoded printf arguments,
+the format strings themselves are extracted from the sources at compile time.
+"""
+import codecs
+from collections import namedtuple
+import json
+import logging
+import os
+import re
+import struct
+
+_LOGGER = logging.getLogger(__name__)
+
+LOG_FORMATS_FILE = 'log_formats.json'
+
+# Level colors and letters, see esphome/components/logger/logger.cpp
+LOG_LEVEL_COLORS = {
+    1: '\033[1;31m',
+    2: '\033[0;33m',
+    3: '\033[0;32m',
+    4: '\033[0;35m',
+    5: '\033[0;36m',
+    6: '\033[0;37m',
+    7: '\033[0;38m',
+}
+LOG_LEVEL_LETTERS = {1: 'E', 2: 'W', 3: 'I', 4: 'C', 5: 'D', 6: 'V', 7: 'VV'}
+LOG_RESET_COLOR = '\033[0m'
+
+LOG_CALL_RE = re.compile(r'\bESP_LOG(?:E|W|I|D|V|VV|CONFIG)\s*\(\s*[^,()]+,\s*'
+                         r'((?:"(?:[^"\\\n]|\\.)*"\s*)+)[,)]')
+STRING_LITERAL_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+FORMAT_SPEC_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|z|j|t|L)?([diuxXoceEfFgGaAspn%])')
+
+
+def log_format_id(format_):
+    """The id of a format string, must match log_format_id() in esphome/components/api/binary_log.cpp."""
+    if isinstance(format_, str):
+        format_ = format_.encode('utf-8')
+    hash_ = 2166136261
+    for byte in format_:
+        hash_ = (hash_ * 16777619) & 0xFFFFFFFF
+        hash_ ^= byte
+    return hash_
+
+
+def extract_log_formats(text):
+    """Find the format strings of all log calls in C++ source text."""
+    formats = []
+    for match in LOG_CALL_RE.finditer(text):
+        literal = ''.join(STRING_LITERAL_RE.findall(match.group(1)))
+        formats.append(codecs.escape_decode(literal.encode('utf-8'))[0])
+    return formats
+
+
+def build_log_format_table(paths, extra_sources=()):
+    table = {}
+    sources = list(extra_sources)
+    for path in paths:
+        if os.path.splitext(path)[1] not in ('.h', '.hpp', '.cpp', '.tcc', '.c'):
+            continue
+        with open(path, encoding='utf-8', errors='replace') as f_handle:
+            sources.append(f_handle.read())
+    for source in sources:
+        for format_ in extract_log_formats(source):
+            table[str(log_format_id(format_))] = format_.decode('utf-8', errors='replace')
+    return table
+
+
+def write_log_format_table(path, table):
+    with open(path, 'w', encoding='utf-8') as f_handle:
+        json.dump(table, f_handle, indent=1, sort_keys=True)
+
+
+def load_log_format_table(path):
+    if not os.path.isfile(path):
+        return None
+    try:
+        with open(path, encoding='utf-8') as f_handle:
+            return {int(key): value for key, value in json.load(f_handle).items()}
+    except (OSError, ValueError) as err:
+        _LOGGER.warning("Could not load log format table %s: %s", path, err)
+        return None
+
+
+def _read_varint(data, pos):
+    result = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("Truncated varint")
+        byte = data[pos]
+        pos += 1
+        result |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return result, pos
+
+
+def _read_signed(data, pos):
+    value, pos = _read_varint(data, pos)
+    return (value >> 1) ^ -(value & 1), pos
+
+
+def format_log_args(format_, args):
+    """Apply the arguments encoded by encode_log_args() on the device to the format string."""
+    pos = 0
+
+    def replace(match):
+        nonlocal pos
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        if width == '*':
+            width, pos = _read_signed(args, pos)
+            width = str(width)
+        if precision == '*':
+            precision, pos = _read_signed(args, pos)
+            precision = str(precision)
+        spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+        if conv in 'di':
+            value, pos = _read_signed(args, pos)
+            return (spec + 'd') % value
+        if conv in 'uxXo':
+            value, pos = _read_varint(args, pos)
+            return (spec + ('d' if conv == 'u' else conv)) % value
+        if conv == 'c':
+            value, pos = _read_signed(args, pos)
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv in 'eEfFgGaA':
+            value = struct.unpack('<d', args[pos:pos + 8])[0]
+            pos += 8
+            if conv in 'aA':
+                return value.hex()
+            return (spec + conv) % value
+        if conv == 's':
+            length, pos = _read_varint(args, pos)
+            value = args[pos:pos + length].decode('utf-8', errors='replace')
+            pos += length
+            return (spec + 's') % value
+        if conv == 'p':
+            value, pos = _read_varint(args, pos)
+            return '0x%x' % value
+        # %n
+        return ''
+
+    try:
+        return FORMAT_SPEC_RE.sub(replace, format_)
+    except (ValueError, TypeError, struct.error, OverflowError) as err:
+        return f'{format_} <invalid arguments: {err}>'
+
+
+def format_binary_log(msg, table):
+    """Render a BinaryLogResponse (or a StoredLogRecord) the same way the device would format it."""
+    level = msg.level
+    format_ = None if table is None else table.get(msg.format_id)
+    if format_ is None:
+        text = f"<unknown format 0x{msg.format_id:08x}>"
+    else:
+        text = format_log_args(format_, msg.args)
+    return '{}[{}][{}:{:03}]: {}{}'.format(LOG_LEVEL_COLORS.get(level, ''), LOG_LEVEL_LETTERS.get(level, '?'),
+                                           msg.tag, msg.line, text, LOG_RESET_COLOR)
+
+
+# rtc_get_reset_reason() of the ESP32, carried by the boot markers of the persistent log
+RESET_REASONS = {
+    1: 'Power On Reset',
+    3: 'Software Reset Digital Core',
+    4: 'Watch Dog Reset Digital Core',
+    5: 'Deep Sleep Reset Digital Core',
+    6: 'SLC Module Reset Digital Core',
+    7: 'Timer Group 0 Watch Dog Reset Digital Core',
+    8: 'Timer Group 1 Watch Dog Reset Digital Core',
+    9: 'RTC Watch Dog Reset Digital Core',
+    10: 'Intrusion Reset CPU',
+    11: 'Timer Group Reset CPU',
+    12: 'Software Reset CPU',
+    13: 'RTC Watch Dog Reset CPU',
+    14: 'External CPU Reset',
+    15: 'Voltage Unstable Reset',
+    16: 'RTC Watch Dog Reset Digital Core And RTC Module',
+}
+STORED_RECORD_HEADER = struct.Struct('<HBBIIH')
+
+StoredLogRecord = namedtuple('StoredLogRecord', ['time', 'level', 'tag', 'line', 'format_id', 'args'])
+StoredBootRecord = namedtuple('StoredBootRecord', ['time', 'reset_reason'])
+
+
+def decode_stored_records(data):
+    """Split the records of the persistent log, see esphome/components/persistent_log/persistent_log.h.
+
+    Log records are decoded like a BinaryLogResponse plus their uptime, boot markers only have
+    the uptime and the reset reason.
+    """
+    records = []
+    pos = 0
+    while pos + STORED_RECORD_HEADER.size <= len(data):
+        size, level, tag_length, time_, format_id, line = STORED_RECORD_HEADER.unpack_from(data, pos)
+        if size < STORED_RECORD_HEADER.size or pos + size > len(data):
+            raise ValueError(f"Invalid record size {size}")
+        body = data[pos + STORED_RECORD_HEADER.size:pos + size]
+        pos += size
+        if level == 0:
+            records.append(StoredBootRecord(time_, line))
+            continue
+        records.append(StoredLogRecord(time_, level, body[:tag_length].decode('utf-8', errors='replace'), line,
+                                       format_id, body[tag_length:]))
+    return records
+
+
+def format_stored_record(record, table):
+    time_ = '[+{:.3f}s]'.format(record.time / 1000)
+    if isinstance(record, StoredBootRecord):
+        reason = RESET_REASONS.get(record.reset_reason, f"Unknown Reset Reason {record.reset_reason}")
+        return f'{time_} ===== Boot: {reason} ====='
+    return time_ + format_binary_log(record, table)
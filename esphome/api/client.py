@@ -1,7 +1,9 @@
+import base64
 from datetime import datetime
 import functools
 import logging
 import socket
+import struct
 import threading
 import time
 
@@ -11,8 +13,11 @@ from google.protobuf import message  # noqa
 
 from esphome import const
 import esphome.api.api_pb2 as pb
+from esphome.api.binary_log import LOG_FORMATS_FILE, decode_stored_records, format_binary_log, \
+    format_stored_record, load_log_format_table
+from esphome.api import crypto
 from esphome.const import CONF_PASSWORD, CONF_PORT
-from esphome.core import EsphomeError
+from esphome.core import CORE, EsphomeError
 from esphome.helpers import resolve_ip_address, indent, color
 from esphome.util import safe_print
 
@@ -57,10 +62,30 @@ MESSAGE_TYPE_TO_PROTO = {
     31: pb.FanCommandRequest,
     32: pb.LightCommandRequest,
     33: pb.SwitchCommandRequest,
-    34: pb.SubscribeServiceCallsRequest,
-    35: pb.ServiceCallResponse,
+    34: pb.SubscribeHomeassistantServicesRequest,
+    35: pb.HomeassistantServiceResponse,
     36: pb.GetTimeRequest,
     37: pb.GetTimeResponse,
+    38: pb.SubscribeHomeAssistantStatesRequest,
+    39: pb.SubscribeHomeAssistantStateResponse,
+    40: pb.HomeAssistantStateResponse,
+    41: pb.ListEntitiesServicesResponse,
+    42: pb.ExecuteServiceRequest,
+    43: pb.ListEntitiesCameraResponse,
+    44: pb.CameraImageResponse,
+    45: pb.CameraImageRequest,
+    46: pb.ListEntitiesClimateResponse,
+    47: pb.ClimateStateResponse,
+    48: pb.ClimateCommandRequest,
+    49: pb.BinaryLogResponse,
+    50: pb.HistoryRequest,
+    51: pb.HistoryResponse,
+    52: pb.HomeAssistantCompactStateResponse,
+    53: pb.StatesSnapshotResponse,
+    54: pb.SubscribeBluetoothLEAdvertisementsRequest,
+    55: pb.BluetoothLERawAdvertisementsResponse,
+    56: pb.StoredLogsRequest,
+    57: pb.StoredLogsResponse,
 }
 
 
@@ -93,11 +118,14 @@ def _bytes_to_varuint(value):
 
 # pylint: disable=too-many-instance-attributes,not-callable
 class APIClient(threading.Thread):
-    def __init__(self, address, port, password):
+    def __init__(self, address, port, password, encryption_key=None):
         threading.Thread.__init__(self)
         self._address = address  # type: str
         self._port = port  # type: int
         self._password = password  # type: Optional[str]
+        self._encryption_key = encryption_key  # type: Optional[bytes]
+        self._cipher = None  # type: Optional[crypto.APICipher]
+        self._plaintext = bytearray()
         self._socket = None  # type: Optional[socket.socket]
         self._socket_open_event = threading.Event()
         self._socket_write_lock = threading.Lock()
@@ -151,6 +179,8 @@ class APIClient(threading.Thread):
         self._connected = False
         self._authenticated = False
         self._message_handlers = []
+        self._cipher = None
+        self._plaintext = bytearray()
 
     def stop(self, force=False):
         if self.stopped:
@@ -193,6 +223,13 @@ class APIClient(threading.Thread):
             err = APIConnectionError(f"Error connecting to {ip}: {err}")
             self._fatal_error(err)
             raise err
+        if self._encryption_key is not None:
+            try:
+                self._handshake()
+            except (OSError, ValueError) as err:
+                err = APIConnectionError(f"Error during the encryption handshake: {err}")
+                self._fatal_error(err)
+                raise err
         self._socket.settimeout(0.1)
 
         self._socket_open_event.set()
@@ -211,6 +248,19 @@ class APIClient(threading.Thread):
         if self.on_connect is not None:
             self.on_connect()
 
+    def _handshake(self):
+        client_nonce, handshake = crypto.make_handshake()
+        self._socket.sendall(handshake)
+        response = bytes()
+        while len(response) < 1 + crypto.HANDSHAKE_NONCE_SIZE:
+            val = self._socket.recv(1 + crypto.HANDSHAKE_NONCE_SIZE - len(response))
+            if not val:
+                raise ValueError("Connection closed, is encryption enabled on the device?")
+            response += val
+        if response[0] != crypto.ENCRYPTED_PREAMBLE:
+            raise ValueError("Invalid handshake response")
+        self._cipher = crypto.APICipher(self._encryption_key, client_nonce, response[1:])
+
     def _check_connected(self):
         if not self._connected:
             err = APIConnectionError("Must be connected!")
@@ -247,6 +297,8 @@ class APIClient(threading.Thread):
 
         # _LOGGER.debug("Write: %s", format_bytes(data))
         with self._socket_write_lock:
+            if self._cipher is not None:
+                data = self._cipher.encrypt(data)
             try:
                 self._socket.sendall(data)
             except OSError as err:
@@ -322,19 +374,62 @@ class APIClient(threading.Thread):
         if not self._authenticated:
             raise APIConnectionError("Must login first!")
 
-    def subscribe_logs(self, on_log, log_level=7, dump_config=False):
+    def subscribe_logs(self, on_log, log_level=7, dump_config=False, binary=False):
+        """Subscribe to the logs, with binary=True log messages arrive as BinaryLogResponse."""
         self._check_authenticated()
 
         def on_msg(msg):
-            if isinstance(msg, pb.SubscribeLogsResponse):
+            if isinstance(msg, (pb.SubscribeLogsResponse, pb.BinaryLogResponse)):
                 on_log(msg)
 
         self._message_handlers.append(on_msg)
-        req = pb.SubscribeLogsRequest(dump_config=dump_config)
+        req = pb.SubscribeLogsRequest(dump_config=dump_config, binary=binary)
         req.level = log_level
         self._send_message(req)
 
+    def stored_logs(self, timeout=10):
+        """Download the raw records of the persistent log, see esphome.api.binary_log.decode_stored_records."""
+        self._check_authenticated()
+        records = b''
+        position = 0
+        while True:
+            event = threading.Event()
+            responses = []
+
+            def on_msg(msg):
+                if isinstance(msg, pb.StoredLogsResponse):
+                    responses.append(msg)
+                    event.set()
+
+            self._message_handlers.append(on_msg)
+            self._send_message(pb.StoredLogsRequest(position=position))
+            ret = event.wait(timeout)
+            self._message_handlers.remove(on_msg)
+            if not ret:
+                raise APIConnectionError("Timeout while waiting for the stored logs!")
+            records += responses[0].records
+            if responses[0].done:
+                return records
+            position = responses[0].next_position
+
     def _recv(self, amount):
+        if self._cipher is None:
+            return self._recv_raw(amount)
+        while len(self._plaintext) < amount:
+            header = self._recv_raw(crypto.RECORD_HEADER_SIZE)
+            if header[0] != crypto.ENCRYPTED_PREAMBLE:
+                raise APIConnectionError("Invalid preamble")
+            payload = self._recv_raw((header[1] << 8) | header[2])
+            try:
+                self._plaintext += self._cipher.decrypt(header, payload)
+            except Exception as err:  # pylint: disable=broad-except
+                raise APIConnectionError("Couldn't decrypt a message, wrong encryption key?") \
+                    from err
+        ret = bytes(self._plaintext[:amount])
+        del self._plaintext[:amount]
+        return ret
+
+    def _recv_raw(self, amount):
         ret = bytes()
         if amount == 0:
             return ret
@@ -418,9 +513,18 @@ def run_logs(config, address):
     conf = config['api']
     port = conf[CONF_PORT]
     password = conf[CONF_PASSWORD]
+    encryption_key = None
+    if 'encryption' in conf:
+        encryption_key = base64.b64decode(conf['encryption']['key'])
     _LOGGER.info("Starting log output from %s using esphome API", address)
 
-    cli = APIClient(address, port, password)
+    cli = APIClient(address, port, password, encryption_key)
+    log_formats = None
+    if conf.get('binary_logs', False):
+        log_formats = load_log_format_table(CORE.relative_build_path(LOG_FORMATS_FILE))
+        if log_formats is None:
+            _LOGGER.warning("No log format table found, compile the firmware first. "
+                            "Falling back to text logs.")
     stopping = False
     retry_timer = []
 
@@ -461,6 +565,9 @@ def run_logs(config, address):
 
     def on_log(msg):
         time_ = datetime.now().time().strftime('[%H:%M:%S]')
+        if isinstance(msg, pb.BinaryLogResponse):
+            safe_print(time_ + format_binary_log(msg, log_formats))
+            return
         text = msg.message
         if msg.send_failed:
             text = color('white', '(Message skipped because it was too big to fit in '
@@ -469,7 +576,7 @@ def run_logs(config, address):
 
     def on_login():
         try:
-            cli.subscribe_logs(on_log, dump_config=not has_connects)
+            cli.subscribe_logs(on_log, dump_config=not has_connects, binary=log_formats is not None)
             has_connects.append(True)
         except APIConnectionError:
             cli.disconnect()
@@ -488,3 +595,35 @@ def run_logs(config, address):
         while retry_timer:
             retry_timer.pop(0).cancel()
     return 0
+
+
+def run_stored_logs(config, address):
+    """Print the log messages the persistent_log component kept on the device."""
+    if 'persistent_log' not in config:
+        raise EsphomeError("persistent_log is not configured!")
+    conf = config['api']
+    encryption_key = None
+    if 'encryption' in conf:
+        encryption_key = base64.b64decode(conf['encryption']['key'])
+    log_formats = load_log_format_table(CORE.relative_build_path(LOG_FORMATS_FILE))
+    if log_formats is None:
+        _LOGGER.warning("No log format table found, compile the firmware first. "
+                        "Messages are shown without their text.")
+    _LOGGER.info("Downloading the stored logs from %s using esphome API", address)
+
+    cli = APIClient(address, conf[CONF_PORT], conf[CONF_PASSWORD], encryption_key)
+    cli.start()
+    try:
+        cli.connect()
+        cli.login()
+        data = cli.stored_logs()
+    finally:
+        cli.stop()
+    try:
+        records = decode_stored_records(data)
+    except (ValueError, struct.error) as err:
+        raise EsphomeError(f"Invalid stored logs: {err}") from err
+    for record in records:
+        safe_print(format_stored_record(record, log_formats))
+    _LOGGER.info("Got %s stored records", len(records))
+    return 0
@@ -0,0 +1,58 @@
+"""Record layer of encrypted native API connections, see esphome/components/api/api_crypto.h.
+
+Needs the cryptography package for AES-GCM, which is only imported when a connection is encrypted.
+"""
+import hashlib
+import hmac
+import os
+import struct
+
+ENCRYPTED_PREAMBLE = 0x01
+HANDSHAKE_NONCE_SIZE = 16
+RECORD_HEADER_SIZE = 3
+RECORD_TAG_SIZE = 16
+RECORD_MAX_PAYLOAD = 0xFFFF - RECORD_TAG_SIZE
+KEY_LABEL = b'esphome-api'
+
+
+def make_handshake():
+    """Return the client nonce and the handshake message carrying it."""
+    nonce = os.urandom(HANDSHAKE_NONCE_SIZE)
+    return nonce, bytes([ENCRYPTED_PREAMBLE]) + nonce
+
+
+def _derive_key(psk, client_nonce, server_nonce, direction):
+    return hmac.new(psk, KEY_LABEL + client_nonce + server_nonce + direction, hashlib.sha256).digest()
+
+
+def _make_iv(counter):
+    return b'\x00' * 4 + struct.pack('>Q', counter)
+
+
+class APICipher:
+    def __init__(self, psk, client_nonce, server_nonce):
+        try:
+            from cryptography.hazmat.primitives.ciphers.aead import AESGCM
+        except ImportError as err:
+            raise ValueError("Encrypted API connections need the cryptography package "
+                             "(pip install cryptography)") from err
+        self._tx = AESGCM(_derive_key(psk, client_nonce, server_nonce, b'c'))
+        self._rx = AESGCM(_derive_key(psk, client_nonce, server_nonce, b's'))
+        self._tx_counter = 0
+        self._rx_counter = 0
+
+    def encrypt(self, data):
+        """Return the records holding data."""
+        ret = bytearray()
+        for start in range(0, len(data), RECORD_MAX_PAYLOAD):
+            chunk = data[start:start + RECORD_MAX_PAYLOAD]
+            header = struct.pack('>BH', ENCRYPTED_PREAMBLE, len(chunk) + RECORD_TAG_SIZE)
+            ret += header + self._tx.encrypt(_make_iv(self._tx_counter), bytes(chunk), header)
+            self._tx_counter += 1
+        return bytes(ret)
+
+    def decrypt(self, header, payload):
+        """Return the plaintext of a record, raises cryptography.exceptions.InvalidTag if it isn't authentic."""
+        plaintext = self._rx.decrypt(_make_iv(self._rx_counter), payload, header)
+        self._rx_counter += 1
+        return plaintext
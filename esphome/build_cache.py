@@ -0,0 +1,126 @@
+"""A content-addressed cache of object files shared by all nodes.
+
+If ESPHOME_BUILD_CACHE points to a directory, the generated platformio.ini runs every compiler call
+through ``python -m esphome.build_cache <cache dir> <build dir> <compiler> <args>``. The key of an
+object file is the hash of the compiler, its arguments and the preprocessed source, with the build
+directory of the node replaced by a placeholder. The preprocessed source contains the component
+sources with all their headers, defines.h included, so nodes with the same components, platform
+and build flags share their objects no matter how they are named. Everything else, like linking,
+is passed straight to the compiler.
+
+The cache is never cleaned up automatically, it can be deleted at any time.
+"""
+import hashlib
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+# Change when the format of the key or of the entries changes
+CACHE_VERSION = b'1'
+CACHED_SOURCE_EXTENSIONS = ('.c', '.cc', '.cpp', '.cxx', '.S')
+BUILD_DIR_PLACEHOLDER = '@ESPHOME_BUILD_DIR@'
+
+
+def parse_compile_args(args):
+    """Return the indices of the output and the source file of a single compile, None for anything else."""
+    if '-c' not in args or '-o' not in args or any(arg.startswith('@') for arg in args):
+        return None
+    output = args.index('-o') + 1
+    sources = [i for i, arg in enumerate(args)
+               if i != output and os.path.splitext(arg)[1] in CACHED_SOURCE_EXTENSIONS]
+    if output >= len(args) or len(sources) != 1:
+        return None
+    return output, sources[0]
+
+
+def compute_key(compiler, args, output, build_dir):
+    """Return the cache key of a compile, None if the source can't be preprocessed."""
+    key = hashlib.sha256(CACHE_VERSION)
+
+    compiler_path = shutil.which(compiler) or compiler
+    stat = os.stat(compiler_path)
+    key.update(f'{compiler_path}\0{stat.st_size}\0{stat.st_mtime_ns}\0'.encode())
+
+    # The output path doesn't change the object, the build dir only its debug info
+    key_args = [arg.replace(build_dir, BUILD_DIR_PLACEHOLDER)
+                for i, arg in enumerate(args) if i not in (output - 1, output)]
+    key.update('\0'.join(key_args).encode())
+
+    preprocess_args = [arg for i, arg in enumerate(args)
+                       if i not in (output - 1, output) and arg != '-c']
+    proc = subprocess.run([compiler] + preprocess_args + ['-E'],
+                          stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, check=False)
+    if proc.returncode != 0:
+        return None
+    key.update(proc.stdout.replace(build_dir.encode(), BUILD_DIR_PLACEHOLDER.encode()))
+    return key.hexdigest()
+
+
+def store(path, data):
+    """Write data to path atomically, so that concurrent builds never see partial entries."""
+    fd, tmp = tempfile.mkstemp(dir=os.path.dirname(path))
+    with os.fdopen(fd, 'wb') as f:
+        f.write(data)
+    os.replace(tmp, path)
+
+
+def cached_compile(cache_dir, build_dir, compiler, args):
+    parsed = parse_compile_args(args)
+    if parsed is None:
+        return subprocess.call([compiler] + args)
+    output, _ = parsed
+
+    key = compute_key(compiler, args, output, build_dir)
+    if key is None:
+        # let the compiler report the error
+        return subprocess.call([compiler] + args)
+
+    entry = os.path.join(cache_dir, key[:2], key)
+    if os.path.isfile(entry + '.o'):
+        shutil.copyfile(entry + '.o', args[output])
+        if os.path.isfile(entry + '.stderr'):
+            with open(entry + '.stderr', 'rb') as f:
+                sys.stderr.buffer.write(f.read())
+        return 0
+
+    proc = subprocess.run([compiler] + args, stderr=subprocess.PIPE, check=False)
+    sys.stderr.buffer.write(proc.stderr)
+    if proc.returncode != 0:
+        return proc.returncode
+
+    os.makedirs(os.path.dirname(entry), exist_ok=True)
+    if proc.stderr:
+        store(entry + '.stderr', proc.stderr)
+    with open(args[output], 'rb') as f:
+        store(entry + '.o', f.read())
+    return 0
+
+
+BUILD_CACHE_SCRIPT = """\
+# Auto generated by esphome, compiles through the object cache in {cache_dir}
+Import("env")
+
+for key in ("CC", "CXX"):
+    env.Replace(**{{key: '"{python}" -m esphome.build_cache "{cache_dir}" "{build_dir}" ' + env[key]}})
+"""
+
+
+def get_build_cache_script(cache_dir, build_dir):
+    """The PlatformIO extra script that routes the compiler calls of a node through the cache."""
+    return BUILD_CACHE_SCRIPT.format(python=sys.executable, cache_dir=os.path.abspath(cache_dir),
+                                     build_dir=os.path.abspath(build_dir))
+
+
+def main():
+    if len(sys.argv) < 4:
+        print("Usage: python -m esphome.build_cache <cache dir> <build dir> <compiler> [args...]",
+              file=sys.stderr)
+        return 1
+    cache_dir, build_dir, compiler = sys.argv[1:4]
+    return cached_compile(cache_dir, build_dir, compiler, sys.argv[4:])
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -16,6 +16,11 @@ void A4988::setup() {
   this->step_pin_->digital_write(false);
   this->dir_pin_->setup();
   this->dir_pin_->digital_write(false);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->use_timer_ && !this->setup_step_timer_(this->step_pin_->to_isr(), this->dir_pin_->to_isr())) {
+    ESP_LOGW(TAG, "Too many steppers use the step timer, stepping from the main loop.");
+  }
+#endif
 }
 void A4988::dump_config() {
   ESP_LOGCONFIG(TAG, "A4988:");
@@ -23,18 +28,29 @@ void A4988::dump_config() {
   LOG_PIN("  Dir Pin: ", this->dir_pin_);
   LOG_PIN("  Sleep Pin: ", this->sleep_pin_);
   LOG_STEPPER(this);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->step_channel_ != nullptr)
+    ESP_LOGCONFIG(TAG, "  Using Step Timer");
+#endif
 }
 void A4988::loop() {
   bool at_target = this->has_reached_target();
   if (this->sleep_pin_ != nullptr) {
     this->sleep_pin_->digital_write(!at_target);
   }
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->step_channel_ != nullptr) {
+    this->loop_step_timer_();
+    return;
+  }
+#endif
   if (at_target) {
     this->high_freq_.stop();
   } else {
     this->high_freq_.start();
   }
 
+  this->measure_step_rate_();
   int32_t dir = this->should_step_();
   if (dir == 0)
     return;
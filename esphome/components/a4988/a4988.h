@@ -12,6 +12,8 @@ class A4988 : public stepper::Stepper, public Component {
   void set_step_pin(GPIOPin *step_pin) { step_pin_ = step_pin; }
   void set_dir_pin(GPIOPin *dir_pin) { dir_pin_ = dir_pin; }
   void set_sleep_pin(GPIOPin *sleep_pin) { this->sleep_pin_ = sleep_pin; }
+  /// Generate the steps from a hardware timer interrupt instead of the main loop (ESP32 only).
+  void set_use_timer(bool use_timer) { this->use_timer_ = use_timer; }
   void setup() override;
   void dump_config() override;
   void loop() override;
@@ -21,6 +23,7 @@ class A4988 : public stepper::Stepper, public Component {
   GPIOPin *step_pin_;
   GPIOPin *dir_pin_;
   GPIOPin *sleep_pin_{nullptr};
+  bool use_timer_{false};
   HighFrequencyLoopRequester high_freq_;
 };
 
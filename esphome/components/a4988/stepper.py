@@ -3,17 +3,34 @@ from esphome.components import stepper
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import CONF_DIR_PIN, CONF_ID, CONF_SLEEP_PIN, CONF_STEP_PIN
+from esphome.core import CORE
+
+CONF_TIMER = 'timer'
 
 
 a4988_ns = cg.esphome_ns.namespace('a4988')
 A4988 = a4988_ns.class_('A4988', stepper.Stepper, cg.Component)
 
-CONFIG_SCHEMA = stepper.STEPPER_SCHEMA.extend({
+
+
+def validate_timer(config):
+    if not config[CONF_TIMER]:
+        return config
+    if not CORE.is_esp32:
+        raise cv.Invalid("timer is only supported on the ESP32")
+    for key in (CONF_STEP_PIN, CONF_DIR_PIN):
+        if any(schema in config[key] for schema in pins.PIN_SCHEMA_REGISTRY):
+            raise cv.Invalid(f"timer is only supported with internal pins for {key}")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(stepper.STEPPER_SCHEMA.extend({
     cv.Required(CONF_ID): cv.declare_id(A4988),
     cv.Required(CONF_STEP_PIN): pins.gpio_output_pin_schema,
     cv.Required(CONF_DIR_PIN): pins.gpio_output_pin_schema,
     cv.Optional(CONF_SLEEP_PIN): pins.gpio_output_pin_schema,
-}).extend(cv.COMPONENT_SCHEMA)
+    cv.Optional(CONF_TIMER, default=False): cv.boolean,
+}).extend(cv.COMPONENT_SCHEMA), validate_timer)
 
 
 def to_code(config):
@@ -29,3 +46,5 @@ def to_code(config):
     if CONF_SLEEP_PIN in config:
         sleep_pin = yield cg.gpio_pin_expression(config[CONF_SLEEP_PIN])
         cg.add(var.set_sleep_pin(sleep_pin))
+    if config[CONF_TIMER]:
+        cg.add(var.set_use_timer(True))
@@ -17,10 +17,14 @@ void AdalightLightEffect::start() {
   last_ack_ = 0;
   last_byte_ = 0;
   last_reset_ = 0;
+  received_frames_ = 0;
+  rendered_frames_ = 0;
 }
 
 void AdalightLightEffect::stop() {
   frame_.resize(0);
+  frame_size_ = 0;
+  pending_.resize(0);
 
   AddressableLightEffect::stop();
 }
@@ -38,12 +42,11 @@ void AdalightLightEffect::reset_frame_(light::AddressableLight &it) {
 
   frame_.clear();
   frame_.reserve(buffer_capacity);
+  frame_size_ = 0;
 }
 
 void AdalightLightEffect::blank_all_leds_(light::AddressableLight &it) {
-  for (int led = it.size(); led-- > 0;) {
-    it[led].set(light::ESPColor::BLACK);
-  }
+  it.fill_range(0, it.size(), light::ESPColor::BLACK);
 }
 
 void AdalightLightEffect::apply(light::AddressableLight &it, const light::ESPColor &current_color) {
@@ -72,14 +75,18 @@ void AdalightLightEffect::apply(light::AddressableLight &it, const light::ESPCol
     ESP_LOGV(TAG, "Frame: Available (size=%d).", this->available());
   }
 
-  while (this->available() != 0) {
-    uint8_t data;
-    if (!this->read_byte(&data))
+  while (true) {
+    // the header is read byte by byte, the LED data of the frame at once
+    const size_t old_size = this->frame_.size();
+    const size_t wanted = this->frame_size_ != 0 ? this->frame_size_ - old_size : 1;
+    this->frame_.resize(old_size + wanted);
+    const size_t len = this->read_available(&this->frame_[old_size], wanted);
+    this->frame_.resize(old_size + len);
+    if (len == 0)
       break;
-    this->frame_.push_back(data);
     this->last_byte_ = now;
 
-    switch (this->parse_frame_(it)) {
+    switch (this->parse_frame_()) {
       case INVALID:
         ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=%d).", this->frame_.size(), this->frame_[0]);
         reset_frame_(it);
@@ -90,13 +97,22 @@ void AdalightLightEffect::apply(light::AddressableLight &it, const light::ESPCol
 
       case CONSUMED:
         ESP_LOGV(TAG, "Frame: Consumed (size=%zu).", this->frame_.size());
+        this->received_frames_++;
+        // when several frames were queued, only the newest one is rendered
+        std::swap(this->frame_, this->pending_);
         reset_frame_(it);
         break;
     }
   }
+
+  if (!this->pending_.empty()) {
+    this->render_frame_(it, this->pending_);
+    this->pending_.clear();
+    this->rendered_frames_++;
+  }
 }
 
-AdalightLightEffect::Frame AdalightLightEffect::parse_frame_(light::AddressableLight &it) {
+AdalightLightEffect::Frame AdalightLightEffect::parse_frame_() {
   if (frame_.empty())
     return INVALID;
 
@@ -119,21 +135,34 @@ AdalightLightEffect::Frame AdalightLightEffect::parse_frame_(light::AddressableL
 
   // Check if we received the full frame
   uint16_t led_count = (frame_[3] << 8) + frame_[4] + 1;
-  auto buffer_size = get_frame_size_(led_count);
-  if (frame_.size() < buffer_size)
+  frame_size_ = get_frame_size_(led_count);
+  if (frame_.size() < frame_size_)
     return PARTIAL;
 
-  // Apply lights
-  auto accepted_led_count = std::min<int>(led_count, it.size());
-  uint8_t *led_data = &frame_[6];
+  return CONSUMED;
+}
 
-  for (int led = 0; led < accepted_led_count; led++, led_data += 3) {
-    auto white = std::min(std::min(led_data[0], led_data[1]), led_data[2]);
+void AdalightLightEffect::render_frame_(light::AddressableLight &it, const std::vector<uint8_t> &frame) {
+  // the LED data is converted to RGBW in chunks on the stack and written to the light as spans
+  static const int CHUNK_LEDS = 32;
+  uint8_t rgbw[CHUNK_LEDS * 4];
 
-    it[led].set(light::ESPColor(led_data[0], led_data[1], led_data[2], white));
+  uint16_t led_count = (frame[3] << 8) + frame[4] + 1;
+  auto accepted_led_count = std::min<int>(led_count, it.size());
+  const uint8_t *led_data = &frame[6];
+
+  for (int led = 0; led < accepted_led_count;) {
+    const int chunk = std::min(accepted_led_count - led, CHUNK_LEDS);
+    uint8_t *dst = rgbw;
+    for (int i = 0; i < chunk; i++, led_data += 3, dst += 4) {
+      dst[0] = led_data[0];
+      dst[1] = led_data[1];
+      dst[2] = led_data[2];
+      dst[3] = std::min(std::min(led_data[0], led_data[1]), led_data[2]);
+    }
+    it.write_rgbw_span(rgbw, chunk, led);
+    led += chunk;
   }
-
-  return CONSUMED;
 }
 
 }  // namespace adalight
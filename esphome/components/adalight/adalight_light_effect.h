@@ -17,6 +17,10 @@ class AdalightLightEffect : public light::AddressableLightEffect, public uart::U
   void start() override;
   void stop() override;
   void apply(light::AddressableLight &it, const light::ESPColor &current_color) override;
+  /// The number of complete frames received since the effect was started.
+  uint32_t get_received_frames() const { return this->received_frames_; }
+  /// The number of frames that were applied to the LEDs, the others were replaced by a newer frame.
+  uint32_t get_rendered_frames() const { return this->rendered_frames_; }
 
  protected:
   enum Frame {
@@ -28,13 +32,21 @@ class AdalightLightEffect : public light::AddressableLightEffect, public uart::U
   int get_frame_size_(int led_count) const;
   void reset_frame_(light::AddressableLight &it);
   void blank_all_leds_(light::AddressableLight &it);
-  Frame parse_frame_(light::AddressableLight &it);
+  Frame parse_frame_();
+  void render_frame_(light::AddressableLight &it, const std::vector<uint8_t> &frame);
 
  protected:
   uint32_t last_ack_{0};
   uint32_t last_byte_{0};
   uint32_t last_reset_{0};
+  /// The frame being received.
   std::vector<uint8_t> frame_;
+  /// The size of the frame being received once its header is complete, 0 before.
+  size_t frame_size_{0};
+  /// The newest complete frame that wasn't rendered yet, empty if none.
+  std::vector<uint8_t> pending_;
+  uint32_t received_frames_{0};
+  uint32_t rendered_frames_{0};
 };
 
 }  // namespace adalight
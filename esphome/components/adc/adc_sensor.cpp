@@ -11,6 +11,13 @@ namespace adc {
 static const char *TAG = "adc";
 
 #ifdef ARDUINO_ARCH_ESP32
+/// The voltage of a full scale reading without calibration, indexed by adc_attenuation_t.
+static const float ADC_FULL_SCALE[] = {1.1f, 1.5f, 2.2f, 3.9f};
+/// The upper end of the range in which each attenuation is accurate, indexed by adc_attenuation_t.
+static const float ADC_ACCURATE_MAX[] = {0.95f, 1.25f, 1.75f, 2.45f};
+/// The reference voltage of chips without one in their eFuse.
+static const uint32_t ADC_DEFAULT_VREF = 1100;
+
 void ADCSensor::set_attenuation(adc_attenuation_t attenuation) { this->attenuation_ = attenuation; }
 #endif
 
@@ -20,6 +27,15 @@ void ADCSensor::setup() {
 
 #ifdef ARDUINO_ARCH_ESP32
   analogSetPinAttenuation(this->pin_, this->attenuation_);
+  this->pin_attenuation_ = this->attenuation_;
+  if (this->calibrate_) {
+    // GPIO32 to GPIO39 are ADC1, the other analog pins ADC2
+    const adc_unit_t unit = this->pin_ >= 32 ? ADC_UNIT_1 : ADC_UNIT_2;
+    for (int i = ADC_0db; i <= ADC_11db; i++) {
+      this->calibration_source_ =
+          esp_adc_cal_characterize(unit, adc_atten_t(i), ADC_WIDTH_BIT_12, ADC_DEFAULT_VREF, &this->calibration_[i]);
+    }
+  }
 #endif
 }
 void ADCSensor::dump_config() {
@@ -33,21 +49,40 @@ void ADCSensor::dump_config() {
 #endif
 #ifdef ARDUINO_ARCH_ESP32
   ESP_LOGCONFIG(TAG, "  Pin: %u", this->pin_);
-  switch (this->attenuation_) {
-    case ADC_0db:
-      ESP_LOGCONFIG(TAG, " Attenuation: 0db (max 1.1V)");
-      break;
-    case ADC_2_5db:
-      ESP_LOGCONFIG(TAG, " Attenuation: 2.5db (max 1.5V)");
-      break;
-    case ADC_6db:
-      ESP_LOGCONFIG(TAG, " Attenuation: 6db (max 2.2V)");
-      break;
-    case ADC_11db:
-      ESP_LOGCONFIG(TAG, " Attenuation: 11db (max 3.9V)");
-      break;
+  if (this->auto_attenuation_) {
+    ESP_LOGCONFIG(TAG, " Attenuation: auto");
+  } else {
+    switch (this->attenuation_) {
+      case ADC_0db:
+        ESP_LOGCONFIG(TAG, " Attenuation: 0db (max 1.1V)");
+        break;
+      case ADC_2_5db:
+        ESP_LOGCONFIG(TAG, " Attenuation: 2.5db (max 1.5V)");
+        break;
+      case ADC_6db:
+        ESP_LOGCONFIG(TAG, " Attenuation: 6db (max 2.2V)");
+        break;
+      case ADC_11db:
+        ESP_LOGCONFIG(TAG, " Attenuation: 11db (max 3.9V)");
+        break;
+    }
+  }
+  if (this->calibrate_) {
+    switch (this->calibration_source_) {
+      case ESP_ADC_CAL_VAL_EFUSE_VREF:
+        ESP_LOGCONFIG(TAG, "  Calibration: eFuse Vref");
+        break;
+      case ESP_ADC_CAL_VAL_EFUSE_TP:
+        ESP_LOGCONFIG(TAG, "  Calibration: eFuse Two Point");
+        break;
+      default:
+        ESP_LOGCONFIG(TAG, "  Calibration: Default Vref");
+        break;
+    }
   }
 #endif
+  if (this->samples_ > 1)
+    ESP_LOGCONFIG(TAG, "  Samples: %u", this->samples_);
   LOG_UPDATE_INTERVAL(this);
 }
 float ADCSensor::get_setup_priority() const { return setup_priority::DATA; }
@@ -58,32 +93,51 @@ void ADCSensor::update() {
 }
 float ADCSensor::sample() {
 #ifdef ARDUINO_ARCH_ESP32
-  float value_v = analogRead(this->pin_) / 4095.0f;  // NOLINT
-  switch (this->attenuation_) {
-    case ADC_0db:
-      value_v *= 1.1;
-      break;
-    case ADC_2_5db:
-      value_v *= 1.5;
-      break;
-    case ADC_6db:
-      value_v *= 2.2;
-      break;
-    case ADC_11db:
-      value_v *= 3.9;
+  if (!this->auto_attenuation_)
+    return this->read_voltage_(this->attenuation_, this->samples_);
+
+  // a rough reading with the full range picks the attenuation with the best resolution for the voltage
+  const float rough = this->read_voltage_(ADC_11db, 1);
+  adc_attenuation_t attenuation = ADC_11db;
+  for (int i = ADC_0db; i < ADC_11db; i++) {
+    if (rough < ADC_ACCURATE_MAX[i]) {
+      attenuation = adc_attenuation_t(i);
       break;
+    }
   }
-  return value_v;
+  return this->read_voltage_(attenuation, this->samples_);
 #endif
 
 #ifdef ARDUINO_ARCH_ESP8266
+  uint32_t sum = 0;
+  for (uint16_t i = 0; i < this->samples_; i++) {
 #ifdef USE_ADC_SENSOR_VCC
-  return ESP.getVcc() / 1024.0f;
+    sum += ESP.getVcc();
 #else
-  return analogRead(this->pin_) / 1024.0f;  // NOLINT
+    sum += analogRead(this->pin_);  // NOLINT
 #endif
+  }
+  return sum / float(this->samples_) / 1024.0f;
 #endif
 }
+#ifdef ARDUINO_ARCH_ESP32
+float ADCSensor::read_voltage_(adc_attenuation_t attenuation, uint16_t samples) {
+  if (attenuation != this->pin_attenuation_) {
+    analogSetPinAttenuation(this->pin_, attenuation);
+    this->pin_attenuation_ = attenuation;
+  }
+  uint32_t sum = 0;
+  for (uint16_t i = 0; i < samples; i++) {
+    const uint32_t raw = analogRead(this->pin_);  // NOLINT
+    // the calibration curve isn't linear, so each conversion is calibrated on its own
+    sum += this->calibrate_ ? esp_adc_cal_raw_to_voltage(raw, &this->calibration_[attenuation]) : raw;
+  }
+  const float average = sum / float(samples);
+  if (this->calibrate_)
+    return average / 1000.0f;
+  return average / 4095.0f * ADC_FULL_SCALE[attenuation];
+}
+#endif
 #ifdef ARDUINO_ARCH_ESP8266
 std::string ADCSensor::unique_id() { return get_mac_address() + "-adc"; }
 #endif
@@ -6,6 +6,10 @@
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/voltage_sampler/voltage_sampler.h"
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_adc_cal.h>
+#endif
+
 namespace esphome {
 namespace adc {
 
@@ -14,7 +18,13 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
 #ifdef ARDUINO_ARCH_ESP32
   /// Set the attenuation for this pin. Only available on the ESP32.
   void set_attenuation(adc_attenuation_t attenuation);
+  /// Pick the lowest attenuation that fits the voltage on each update, for the best resolution.
+  void set_auto_attenuation(bool auto_attenuation) { this->auto_attenuation_ = auto_attenuation; }
+  /// Convert readings with the calibration of the chip (eFuse) instead of a fixed scale. Only available on the ESP32.
+  void set_calibrate(bool calibrate) { this->calibrate_ = calibrate; }
 #endif
+  /// Average this many conversions for each sample, they are taken back to back.
+  void set_samples(uint16_t samples) { this->samples_ = samples; }
 
   /// Update adc values.
   void update() override;
@@ -32,9 +42,20 @@ class ADCSensor : public sensor::Sensor, public PollingComponent, public voltage
 
  protected:
   uint8_t pin_;
+  uint16_t samples_{1};
 
 #ifdef ARDUINO_ARCH_ESP32
+  /// The average voltage of a number of conversions with the attenuation.
+  float read_voltage_(adc_attenuation_t attenuation, uint16_t samples);
+
   adc_attenuation_t attenuation_{ADC_0db};
+  bool auto_attenuation_{false};
+  bool calibrate_{false};
+  /// The attenuation the pin is configured with.
+  adc_attenuation_t pin_attenuation_{ADC_0db};
+  /// The calibration of each attenuation, indexed by adc_attenuation_t.
+  esp_adc_cal_characteristics_t calibration_[4];
+  esp_adc_cal_value_t calibration_source_;
 #endif
 };
 
@@ -7,6 +7,10 @@ from esphome.const import CONF_ATTENUATION, CONF_ID, CONF_PIN, ICON_FLASH, UNIT_
 
 AUTO_LOAD = ['voltage_sampler']
 
+CONF_AUTO = 'auto'
+CONF_CALIBRATE = 'calibrate'
+CONF_SAMPLES = 'samples'
+
 ATTENUATION_MODES = {
     '0db': cg.global_ns.ADC_0db,
     '2.5db': cg.global_ns.ADC_2_5db,
@@ -22,6 +26,12 @@ def validate_adc_pin(value):
     return pins.analog_pin(value)
 
 
+def validate_attenuation(value):
+    if isinstance(value, str) and value.lower() == CONF_AUTO:
+        return CONF_AUTO
+    return cv.enum(ATTENUATION_MODES, lower=True)(value)
+
+
 adc_ns = cg.esphome_ns.namespace('adc')
 ADCSensor = adc_ns.class_('ADCSensor', sensor.Sensor, cg.PollingComponent,
                           voltage_sampler.VoltageSampler)
@@ -29,8 +39,9 @@ ADCSensor = adc_ns.class_('ADCSensor', sensor.Sensor, cg.PollingComponent,
 CONFIG_SCHEMA = sensor.sensor_schema(UNIT_VOLT, ICON_FLASH, 2).extend({
     cv.GenerateID(): cv.declare_id(ADCSensor),
     cv.Required(CONF_PIN): validate_adc_pin,
-    cv.SplitDefault(CONF_ATTENUATION, esp32='0db'):
-        cv.All(cv.only_on_esp32, cv.enum(ATTENUATION_MODES, lower=True)),
+    cv.SplitDefault(CONF_ATTENUATION, esp32='0db'): cv.All(cv.only_on_esp32, validate_attenuation),
+    cv.SplitDefault(CONF_CALIBRATE, esp32=True): cv.All(cv.only_on_esp32, cv.boolean),
+    cv.Optional(CONF_SAMPLES, default=1): cv.int_range(min=1, max=1024),
 }).extend(cv.polling_component_schema('60s'))
 
 
@@ -45,4 +56,10 @@ def to_code(config):
         cg.add(var.set_pin(config[CONF_PIN]))
 
     if CONF_ATTENUATION in config:
-        cg.add(var.set_attenuation(config[CONF_ATTENUATION]))
+        if config[CONF_ATTENUATION] == CONF_AUTO:
+            cg.add(var.set_auto_attenuation(True))
+        else:
+            cg.add(var.set_attenuation(config[CONF_ATTENUATION]))
+    if CONF_CALIBRATE in config:
+        cg.add(var.set_calibrate(config[CONF_CALIBRATE]))
+    cg.add(var.set_samples(config[CONF_SAMPLES]))
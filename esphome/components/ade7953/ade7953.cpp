@@ -13,34 +13,39 @@ void ADE7953::dump_config() {
   }
   LOG_I2C_DEVICE(this);
   LOG_UPDATE_INTERVAL(this);
-  LOG_SENSOR("  ", "Voltage Sensor", this->voltage_sensor_);
-  LOG_SENSOR("  ", "Current A Sensor", this->current_a_sensor_);
-  LOG_SENSOR("  ", "Current B Sensor", this->current_b_sensor_);
-  LOG_SENSOR("  ", "Active Power A Sensor", this->active_power_a_sensor_);
-  LOG_SENSOR("  ", "Active Power B Sensor", this->active_power_b_sensor_);
+  LOG_SENSOR("  ", "Voltage Sensor", this->meter_a_.get_voltage_sensor());
+  LOG_SENSOR("  ", "Current A Sensor", this->meter_a_.get_current_sensor());
+  LOG_SENSOR("  ", "Current B Sensor", this->meter_b_.get_current_sensor());
+  LOG_SENSOR("  ", "Active Power A Sensor", this->meter_a_.get_power_sensor());
+  LOG_SENSOR("  ", "Active Power B Sensor", this->meter_b_.get_power_sensor());
+  LOG_SENSOR("  ", "Energy A Sensor", this->meter_a_.get_energy_sensor());
+  LOG_SENSOR("  ", "Energy B Sensor", this->meter_b_.get_energy_sensor());
+  LOG_SENSOR("  ", "Power Factor A Sensor", this->meter_a_.get_power_factor_sensor());
+  LOG_SENSOR("  ", "Power Factor B Sensor", this->meter_b_.get_power_factor_sensor());
 }
 
-#define ADE_PUBLISH_(name, factor) \
-  if (name && this->name##_sensor_) { \
-    float value = *name / factor; \
-    this->name##_sensor_->publish_state(value); \
-  }
-#define ADE_PUBLISH(name, factor) ADE_PUBLISH_(name, factor)
+#define ADE_ADD(meter, quantity, value, factor) \
+  if (value) \
+    this->meter.add_##quantity(*value / factor);
 
 void ADE7953::update() {
   if (!this->is_setup_)
     return;
 
   auto active_power_a = this->ade_read_<int32_t>(0x0312);
-  ADE_PUBLISH(active_power_a, 154.0f);
+  ADE_ADD(meter_a_, power, active_power_a, 154.0f);
   auto active_power_b = this->ade_read_<int32_t>(0x0313);
-  ADE_PUBLISH(active_power_b, 154.0f);
+  ADE_ADD(meter_b_, power, active_power_b, 154.0f);
   auto current_a = this->ade_read_<uint32_t>(0x031A);
-  ADE_PUBLISH(current_a, 100000.0f);
+  ADE_ADD(meter_a_, current, current_a, 100000.0f);
   auto current_b = this->ade_read_<uint32_t>(0x031B);
-  ADE_PUBLISH(current_b, 100000.0f);
+  ADE_ADD(meter_b_, current, current_b, 100000.0f);
   auto voltage = this->ade_read_<uint32_t>(0x031C);
-  ADE_PUBLISH(voltage, 26000.0f);
+  ADE_ADD(meter_a_, voltage, voltage, 26000.0f);
+  ADE_ADD(meter_b_, voltage, voltage, 26000.0f);
+  // the energy is integrated from the power
+  this->meter_a_.publish();
+  this->meter_b_.publish();
 
   //    auto apparent_power_a = this->ade_read_<int32_t>(0x0310);
   //    auto apparent_power_b = this->ade_read_<int32_t>(0x0311);
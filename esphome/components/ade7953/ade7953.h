@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/sensor/sensor.h"
+#include "esphome/components/energy_meter/energy_meter.h"
 
 namespace esphome {
 namespace ade7953 {
@@ -13,20 +14,28 @@ class ADE7953 : public i2c::I2CDevice, public PollingComponent {
     has_irq_ = true;
     irq_pin_number_ = irq_pin;
   }
-  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { voltage_sensor_ = voltage_sensor; }
-  void set_current_a_sensor(sensor::Sensor *current_a_sensor) { current_a_sensor_ = current_a_sensor; }
-  void set_current_b_sensor(sensor::Sensor *current_b_sensor) { current_b_sensor_ = current_b_sensor; }
+  // both channels measure the same voltage, channel A publishes it
+  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { meter_a_.set_voltage_sensor(voltage_sensor); }
+  void set_current_a_sensor(sensor::Sensor *current_a_sensor) { meter_a_.set_current_sensor(current_a_sensor); }
+  void set_current_b_sensor(sensor::Sensor *current_b_sensor) { meter_b_.set_current_sensor(current_b_sensor); }
   void set_active_power_a_sensor(sensor::Sensor *active_power_a_sensor) {
-    active_power_a_sensor_ = active_power_a_sensor;
+    meter_a_.set_power_sensor(active_power_a_sensor);
   }
   void set_active_power_b_sensor(sensor::Sensor *active_power_b_sensor) {
-    active_power_b_sensor_ = active_power_b_sensor;
+    meter_b_.set_power_sensor(active_power_b_sensor);
+  }
+  void set_energy_a_sensor(sensor::Sensor *energy_a_sensor) { meter_a_.set_energy_sensor(energy_a_sensor); }
+  void set_energy_b_sensor(sensor::Sensor *energy_b_sensor) { meter_b_.set_energy_sensor(energy_b_sensor); }
+  void set_power_factor_a_sensor(sensor::Sensor *power_factor_a_sensor) {
+    meter_a_.set_power_factor_sensor(power_factor_a_sensor);
+  }
+  void set_power_factor_b_sensor(sensor::Sensor *power_factor_b_sensor) {
+    meter_b_.set_power_factor_sensor(power_factor_b_sensor);
   }
 
   void setup() override {
     if (this->has_irq_) {
-      auto pin = GPIOPin(this->irq_pin_number_, INPUT);
-      this->irq_pin_ = &pin;
+      this->irq_pin_ = new GPIOPin(this->irq_pin_number_, INPUT);
       this->irq_pin_->setup();
     }
     this->set_timeout(100, [this]() {
@@ -68,11 +77,8 @@ class ADE7953 : public i2c::I2CDevice, public PollingComponent {
   uint8_t irq_pin_number_;
   GPIOPin *irq_pin_{nullptr};
   bool is_setup_{false};
-  sensor::Sensor *voltage_sensor_{nullptr};
-  sensor::Sensor *current_a_sensor_{nullptr};
-  sensor::Sensor *current_b_sensor_{nullptr};
-  sensor::Sensor *active_power_a_sensor_{nullptr};
-  sensor::Sensor *active_power_b_sensor_{nullptr};
+  energy_meter::EnergyMeter meter_a_;
+  energy_meter::EnergyMeter meter_b_;
 };
 
 }  // namespace ade7953
@@ -2,19 +2,23 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, i2c
 from esphome import pins
-from esphome.const import CONF_ID, CONF_VOLTAGE, \
-    UNIT_VOLT, ICON_FLASH, UNIT_AMPERE, UNIT_WATT
+from esphome.const import CONF_ID, CONF_VOLTAGE, CONF_IRQ_PIN, \
+    UNIT_VOLT, ICON_FLASH, UNIT_AMPERE, UNIT_EMPTY, UNIT_WATT, UNIT_WATT_HOURS
 
 DEPENDENCIES = ['i2c']
+AUTO_LOAD = ['energy_meter']
 
 ade7953_ns = cg.esphome_ns.namespace('ade7953')
 ADE7953 = ade7953_ns.class_('ADE7953', cg.PollingComponent, i2c.I2CDevice)
 
-CONF_IRQ_PIN = 'irq_pin'
 CONF_CURRENT_A = 'current_a'
 CONF_CURRENT_B = 'current_b'
 CONF_ACTIVE_POWER_A = 'active_power_a'
 CONF_ACTIVE_POWER_B = 'active_power_b'
+CONF_ENERGY_A = 'energy_a'
+CONF_ENERGY_B = 'energy_b'
+CONF_POWER_FACTOR_A = 'power_factor_a'
+CONF_POWER_FACTOR_B = 'power_factor_b'
 
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(ADE7953),
@@ -24,6 +28,10 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_CURRENT_B): sensor.sensor_schema(UNIT_AMPERE, ICON_FLASH, 2),
     cv.Optional(CONF_ACTIVE_POWER_A): sensor.sensor_schema(UNIT_WATT, ICON_FLASH, 1),
     cv.Optional(CONF_ACTIVE_POWER_B): sensor.sensor_schema(UNIT_WATT, ICON_FLASH, 1),
+    cv.Optional(CONF_ENERGY_A): sensor.sensor_schema(UNIT_WATT_HOURS, ICON_FLASH, 1),
+    cv.Optional(CONF_ENERGY_B): sensor.sensor_schema(UNIT_WATT_HOURS, ICON_FLASH, 1),
+    cv.Optional(CONF_POWER_FACTOR_A): sensor.sensor_schema(UNIT_EMPTY, ICON_FLASH, 2),
+    cv.Optional(CONF_POWER_FACTOR_B): sensor.sensor_schema(UNIT_EMPTY, ICON_FLASH, 2),
 }).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x38))
 
 
@@ -36,7 +44,8 @@ def to_code(config):
         cg.add(var.set_irq_pin(config[CONF_IRQ_PIN]))
 
     for key in [CONF_VOLTAGE, CONF_CURRENT_A, CONF_CURRENT_B, CONF_ACTIVE_POWER_A,
-                CONF_ACTIVE_POWER_B]:
+                CONF_ACTIVE_POWER_B, CONF_ENERGY_A, CONF_ENERGY_B, CONF_POWER_FACTOR_A,
+                CONF_POWER_FACTOR_B]:
         if key not in config:
             continue
         conf = config[key]
@@ -1,5 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome import pins
 from esphome.components import i2c
 from esphome.const import CONF_ID
 
@@ -11,9 +12,12 @@ ads1115_ns = cg.esphome_ns.namespace('ads1115')
 ADS1115Component = ads1115_ns.class_('ADS1115Component', cg.Component, i2c.I2CDevice)
 
 CONF_CONTINUOUS_MODE = 'continuous_mode'
+CONF_ALERT_RDY_PIN = 'alert_rdy_pin'
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(ADS1115Component),
     cv.Optional(CONF_CONTINUOUS_MODE, default=False): cv.boolean,
+    cv.Optional(CONF_ALERT_RDY_PIN): cv.All(pins.internal_gpio_input_pin_schema,
+                                            pins.validate_has_interrupt),
 }).extend(cv.COMPONENT_SCHEMA).extend(i2c.i2c_device_schema(None))
 
 
@@ -23,3 +27,6 @@ def to_code(config):
     yield i2c.register_i2c_device(var, config)
 
     cg.add(var.set_continuous_mode(config[CONF_CONTINUOUS_MODE]))
+    if CONF_ALERT_RDY_PIN in config:
+        pin = yield cg.gpio_pin_expression(config[CONF_ALERT_RDY_PIN])
+        cg.add(var.set_alert_rdy_pin(pin))
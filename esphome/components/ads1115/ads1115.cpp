@@ -1,5 +1,6 @@
 #include "ads1115.h"
 #include "esphome/core/log.h"
+#include "esphome/core/application.h"
 
 namespace esphome {
 namespace ads1115 {
@@ -7,8 +8,12 @@ namespace ads1115 {
 static const char *TAG = "ads1115";
 static const uint8_t ADS1115_REGISTER_CONVERSION = 0x00;
 static const uint8_t ADS1115_REGISTER_CONFIG = 0x01;
+static const uint8_t ADS1115_REGISTER_LO_THRESH = 0x02;
+static const uint8_t ADS1115_REGISTER_HI_THRESH = 0x03;
 
 static const uint8_t ADS1115_DATA_RATE_860_SPS = 0b111;
+/// Samples kept per sensor for read_samples(), about 75 ms of conversions at 860 samples per second.
+static const size_t ADS1115_SAMPLE_RING_SIZE = 64;
 
 void ADS1115Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ADS1115...");
@@ -29,7 +34,9 @@ void ADS1115Component::setup() {
   //        0bxxxx000xxxxxxxxx
   config |= ADS1115_GAIN_6P144 << 9;
 
-  if (this->continuous_mode_) {
+  // with more than one channel, each conversion is started on its own so the result belongs to the channel
+  const bool continuous = this->is_sampling() ? this->sensors_.size() == 1 : this->continuous_mode_;
+  if (continuous) {
     // Set continuous mode
     //        0bxxxxxxx0xxxxxxxx
     config |= 0b0000000000000000;
@@ -55,9 +62,20 @@ void ADS1115Component::setup() {
   //        0bxxxxxxxxxxxxx0xx
   config |= 0b0000000000000000;
 
-  // Set comparator que mode - disabled
-  //        0bxxxxxxxxxxxxxx11
-  config |= 0b0000000000000011;
+  if (this->is_sampling()) {
+    // Set comparator que mode - assert after one conversion, with the thresholds below ALERT/RDY signals ready
+    //        0bxxxxxxxxxxxxxx00
+    config |= 0b0000000000000000;
+    if (!this->write_byte_16(ADS1115_REGISTER_LO_THRESH, 0x0000) ||
+        !this->write_byte_16(ADS1115_REGISTER_HI_THRESH, 0x8000)) {
+      this->mark_failed();
+      return;
+    }
+  } else {
+    // Set comparator que mode - disabled
+    //        0bxxxxxxxxxxxxxx11
+    config |= 0b0000000000000011;
+  }
 
   if (!this->write_byte_16(ADS1115_REGISTER_CONFIG, config)) {
     this->mark_failed();
@@ -65,6 +83,15 @@ void ADS1115Component::setup() {
   }
   this->prev_config_ = config;
 
+  if (this->is_sampling()) {
+    this->continuous_mode_ = continuous;
+    this->alert_rdy_pin_->setup();
+    this->alert_rdy_pin_->attach_interrupt(ADS1115Component::gpio_intr, this, FALLING);
+    if (!this->sensors_.empty() && !this->start_conversion_(this->sensors_[0]))
+      this->mark_failed();
+    return;
+  }
+
   for (auto *sensor : this->sensors_) {
     this->set_interval(sensor->get_name(), sensor->update_interval(),
                        [this, sensor] { this->request_measurement(sensor); });
@@ -73,6 +100,7 @@ void ADS1115Component::setup() {
 void ADS1115Component::dump_config() {
   ESP_LOGCONFIG(TAG, "Setting up ADS1115...");
   LOG_I2C_DEVICE(this);
+  LOG_PIN("  ALERT/RDY Pin: ", this->alert_rdy_pin_);
   if (this->is_failed()) {
     ESP_LOGE(TAG, "Communication with ADS1115 failed!");
   }
@@ -83,7 +111,28 @@ void ADS1115Component::dump_config() {
     ESP_LOGCONFIG(TAG, "    Gain: %u", sensor->get_gain());
   }
 }
-float ADS1115Component::request_measurement(ADS1115Sensor *sensor) {
+void ICACHE_RAM_ATTR ADS1115Component::gpio_intr(ADS1115Component *arg) {
+  arg->data_ready_ = true;
+  App.wake_loop_isr();
+}
+bool ADS1115Component::is_loop_idle() { return !this->data_ready_; }
+void ADS1115Component::loop() {
+  if (!this->data_ready_)
+    return;
+  this->data_ready_ = false;
+
+  ADS1115Sensor *sensor = this->sensors_[this->current_sensor_];
+  auto value = this->read_conversion_(sensor);
+  if (value.has_value())
+    sensor->add_sample(*value);
+
+  if (this->sensors_.size() > 1) {
+    // next channel, round-robin
+    this->current_sensor_ = (this->current_sensor_ + 1) % this->sensors_.size();
+    this->start_conversion_(this->sensors_[this->current_sensor_]);
+  }
+}
+uint16_t ADS1115Component::config_for_(ADS1115Sensor *sensor) const {
   uint16_t config = this->prev_config_;
   // Multiplexer
   //        0bxBBBxxxxxxxxxxxx
@@ -99,13 +148,28 @@ float ADS1115Component::request_measurement(ADS1115Sensor *sensor) {
     // Start conversion
     config |= 0b1000000000000000;
   }
+  return config;
+}
+bool ADS1115Component::start_conversion_(ADS1115Sensor *sensor) {
+  const uint16_t config = this->config_for_(sensor);
+  if (this->continuous_mode_ && this->prev_config_ == config)
+    return true;
+  if (!this->write_byte_16(ADS1115_REGISTER_CONFIG, config)) {
+    this->status_set_warning();
+    return false;
+  }
+  this->prev_config_ = config;
+  return true;
+}
+float ADS1115Component::request_measurement(ADS1115Sensor *sensor) {
+  if (this->is_sampling())
+    // the conversions run on their own
+    return sensor->sample();
 
+  uint16_t config = this->config_for_(sensor);
   if (!this->continuous_mode_ || this->prev_config_ != config) {
-    if (!this->write_byte_16(ADS1115_REGISTER_CONFIG, config)) {
-      this->status_set_warning();
+    if (!this->start_conversion_(sensor))
       return NAN;
-    }
-    this->prev_config_ = config;
 
     // about 1.6 ms with 860 samples per second
     delay(2);
@@ -121,10 +185,13 @@ float ADS1115Component::request_measurement(ADS1115Sensor *sensor) {
     }
   }
 
+  return this->read_conversion_(sensor).value_or(NAN);
+}
+optional<float> ADS1115Component::read_conversion_(ADS1115Sensor *sensor) {
   uint16_t raw_conversion;
   if (!this->read_byte_16(ADS1115_REGISTER_CONVERSION, &raw_conversion)) {
     this->status_set_warning();
-    return NAN;
+    return {};
   }
   auto signed_conversion = static_cast<int16_t>(raw_conversion);
 
@@ -156,8 +223,51 @@ float ADS1115Component::request_measurement(ADS1115Sensor *sensor) {
   return millivolts / 1e3f;
 }
 
-float ADS1115Sensor::sample() { return this->parent_->request_measurement(this); }
+float ADS1115Sensor::sample() {
+  if (this->parent_->is_sampling())
+    return this->last_sample_;
+  return this->parent_->request_measurement(this);
+}
+void ADS1115Sensor::add_sample(float value) {
+  this->last_sample_ = value;
+  this->sample_sum_ += value;
+  this->sample_count_++;
+
+  // the ring only exists once a VoltageSampler user like ct_clamp reads the samples
+  if (this->sample_ring_.empty())
+    return;
+  const size_t size = this->sample_ring_.size();
+  this->sample_ring_[(this->ring_read_at_ + this->ring_count_) % size] = value;
+  if (this->ring_count_ == size) {
+    this->ring_read_at_ = (this->ring_read_at_ + 1) % size;
+  } else {
+    this->ring_count_++;
+  }
+}
+size_t ADS1115Sensor::read_samples(float *samples, size_t max_count) {
+  if (this->sample_ring_.empty())
+    this->sample_ring_.resize(ADS1115_SAMPLE_RING_SIZE);
+  size_t count = 0;
+  while (count < max_count && this->ring_count_ > 0) {
+    samples[count++] = this->sample_ring_[this->ring_read_at_];
+    this->ring_read_at_ = (this->ring_read_at_ + 1) % this->sample_ring_.size();
+    this->ring_count_--;
+  }
+  return count;
+}
 void ADS1115Sensor::update() {
+  if (this->parent_->is_sampling()) {
+    if (this->sample_count_ == 0)
+      return;
+    // the mean of all conversions since the last update goes through the filters as one value
+    const float v = this->sample_sum_ / this->sample_count_;
+    ESP_LOGD(TAG, "'%s': Got Voltage=%fV (mean of %u)", this->get_name().c_str(), v, this->sample_count_);
+    this->sample_sum_ = 0.0f;
+    this->sample_count_ = 0;
+    this->publish_state(v);
+    return;
+  }
+
   float v = this->parent_->request_measurement(this);
   if (!isnan(v)) {
     ESP_LOGD(TAG, "'%s': Got Voltage=%fV", this->get_name().c_str(), v);
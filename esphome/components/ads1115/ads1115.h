@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/esphal.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/voltage_sampler/voltage_sampler.h"
@@ -39,14 +40,35 @@ class ADS1115Component : public Component, public i2c::I2CDevice {
   /// HARDWARE_LATE setup priority
   float get_setup_priority() const override { return setup_priority::DATA; }
   void set_continuous_mode(bool continuous_mode) { continuous_mode_ = continuous_mode; }
+  /** Convert continuously and read each result when the ALERT/RDY pin signals it.
+   *
+   * The channels of the sensors are converted round-robin, each sensor publishes the mean of its samples, kept as a
+   * running sum. VoltageSampler users that need every sample get them from ADS1115Sensor::read_samples().
+   */
+  void set_alert_rdy_pin(GPIOPin *alert_rdy_pin) { alert_rdy_pin_ = alert_rdy_pin; }
+  bool is_sampling() const { return this->alert_rdy_pin_ != nullptr; }
+
+  void loop() override;
+  bool is_loop_idle() override;
 
   /// Helper method to request a measurement from a sensor.
   float request_measurement(ADS1115Sensor *sensor);
 
  protected:
+  static void gpio_intr(ADS1115Component *arg);
+
+  /// Write the configuration for the channel of a sensor, the conversion starts with it.
+  bool start_conversion_(ADS1115Sensor *sensor);
+  uint16_t config_for_(ADS1115Sensor *sensor) const;
+  optional<float> read_conversion_(ADS1115Sensor *sensor);
+
   std::vector<ADS1115Sensor *> sensors_;
   uint16_t prev_config_{0};
   bool continuous_mode_;
+  GPIOPin *alert_rdy_pin_{nullptr};
+  volatile bool data_ready_{false};
+  /// The sensor whose channel is being converted.
+  size_t current_sensor_{0};
 };
 
 /// Internal holder class that is in instance of Sensor so that the hub can create individual sensors.
@@ -58,13 +80,28 @@ class ADS1115Sensor : public sensor::Sensor, public PollingComponent, public vol
   void set_gain(ADS1115Gain gain) { gain_ = gain; }
 
   float sample() override;
+  /// With an ALERT/RDY pin the hub converts continuously, the samples are kept for read_samples().
+  bool is_continuous() override { return this->parent_->is_sampling(); }
+  /// The first call allocates the ring of samples, it returns the samples converted after that call.
+  size_t read_samples(float *samples, size_t max_count) override;
   uint8_t get_multiplexer() const { return multiplexer_; }
   uint8_t get_gain() const { return gain_; }
 
+  /// Add a conversion read by the hub.
+  void add_sample(float value);
+
  protected:
   ADS1115Component *parent_;
   ADS1115Multiplexer multiplexer_;
   ADS1115Gain gain_;
+  float last_sample_{NAN};
+  float sample_sum_{0.0f};
+  uint32_t sample_count_{0};
+  /// The samples not fetched with read_samples() yet, the oldest ones are dropped once it's full. Empty until the
+  /// first read_samples(), sensors that only publish their mean don't need it.
+  std::vector<float> sample_ring_;
+  size_t ring_read_at_{0};
+  size_t ring_count_{0};
 };
 
 }  // namespace ads1115
@@ -22,6 +22,7 @@ ANIMATION_SCHEMA = cv.Schema({
     cv.Required(CONF_FILE): cv.file_,
     cv.Optional(CONF_RESIZE): cv.dimensions,
     cv.Optional(CONF_TYPE, default='BINARY'): cv.enum(espImage.IMAGE_TYPE, upper=True),
+    cv.Optional(espImage.CONF_COMPRESSION, default='NONE'): cv.one_of(*espImage.COMPRESSION_TYPES, upper=True),
     cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
 })
 
@@ -88,7 +89,19 @@ def to_code(config):
                     pos = x + y * width8 + (height * width8 * frameIndex)
                     data[pos // 8] |= 0x80 >> (pos % 8)
 
+    compressed = config[espImage.CONF_COMPRESSION] == 'RLE'
+    if compressed:
+        mode = {'GRAYSCALE': 'L', 'RGB24': 'RGB', 'BINARY': '1'}[config[CONF_TYPE]]
+        rows = []
+        for frameIndex in range(frames):
+            image.seek(frameIndex)
+            frame = image.convert(mode, dither=Image.NONE)
+            rows.append(espImage.frame_rows(frame, config[CONF_TYPE]))
+        data = espImage.rle_encode_frames(rows, config[CONF_TYPE])
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
-    cg.new_Pvariable(config[CONF_ID], prog_arr, width, height, frames,
-                     espImage.IMAGE_TYPE[config[CONF_TYPE]])
+    var = cg.new_Pvariable(config[CONF_ID], prog_arr, width, height, frames,
+                           espImage.IMAGE_TYPE[config[CONF_TYPE]])
+    if compressed:
+        cg.add(var.set_compressed(True))
@@ -1,11 +1,20 @@
+import base64
+import binascii
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.automation import Condition
 from esphome.const import CONF_DATA, CONF_DATA_TEMPLATE, CONF_ID, CONF_PASSWORD, CONF_PORT, \
     CONF_REBOOT_TIMEOUT, CONF_SERVICE, CONF_VARIABLES, CONF_SERVICES, CONF_TRIGGER_ID, CONF_EVENT, \
-    CONF_TAG
-from esphome.core import coroutine_with_priority
+    CONF_TAG, CONF_KEY
+from esphome.core import CORE, coroutine_with_priority, TimePeriod
+
+CONF_BINARY_LOGS = 'binary_logs'
+CONF_COALESCE_WINDOW = 'coalesce_window'
+CONF_COALESCE_WRITES = 'coalesce_writes'
+CONF_ENCRYPTION = 'encryption'
+CONF_ENTITY_BURST = 'entity_burst'
 
 DEPENDENCIES = ['network']
 AUTO_LOAD = ['async_tcp']
@@ -29,11 +38,32 @@ SERVICE_ARG_NATIVE_TYPES = {
     'string[]': cg.std_vector.template(cg.std_string),
 }
 
+
+def validate_encryption_key(value):
+    value = cv.string_strict(value)
+    try:
+        key = base64.b64decode(value, validate=True)
+    except binascii.Error as err:
+        raise cv.Invalid("Encryption key must be base64 encoded") from err
+    if len(key) != 32:
+        raise cv.Invalid("Encryption key must be 32 bytes long (base64 encoded, for example from "
+                         "'openssl rand -base64 32')")
+    return value
+
+
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(APIServer),
     cv.Optional(CONF_PORT, default=6053): cv.port,
     cv.Optional(CONF_PASSWORD, default=''): cv.string_strict,
     cv.Optional(CONF_REBOOT_TIMEOUT, default='15min'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_COALESCE_WRITES, default=False): cv.boolean,
+    cv.Optional(CONF_COALESCE_WINDOW, default='0ms'): cv.All(cv.positive_time_period_milliseconds,
+                                                             cv.Range(max=TimePeriod(seconds=10))),
+    cv.Optional(CONF_BINARY_LOGS, default=False): cv.boolean,
+    cv.Optional(CONF_ENTITY_BURST, default=16): cv.int_range(min=1, max=255),
+    cv.Optional(CONF_ENCRYPTION): cv.Schema({
+        cv.Required(CONF_KEY): validate_encryption_key,
+    }),
     cv.Optional(CONF_SERVICES): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(UserServiceTrigger),
         cv.Required(CONF_SERVICE): cv.valid_name,
@@ -44,6 +74,31 @@ CONFIG_SCHEMA = cv.Schema({
 }).extend(cv.COMPONENT_SCHEMA)
 
 
+@coroutine_with_priority(-1000.0)
+def _write_log_format_table():
+    # Runs after all other components so that all lambdas have been added to the main section.
+    from esphome.api.binary_log import LOG_FORMATS_FILE, build_log_format_table, \
+        write_log_format_table
+    from esphome.config import iter_components
+    from esphome.helpers import mkdir_p
+
+    paths = set()
+    for _, component, _ in iter_components(CORE.config):
+        paths.update(component.source_files.values())
+    table = build_log_format_table(sorted(paths), [CORE.cpp_global_section, CORE.cpp_main_section])
+    mkdir_p(CORE.build_path)
+    write_log_format_table(CORE.relative_build_path(LOG_FORMATS_FILE), table)
+
+
+def enable_binary_logs():
+    """Compile in the encoding of unformatted log messages, used by the API and the persistent log."""
+    if CORE.data.get(CONF_BINARY_LOGS, False):
+        return
+    CORE.data[CONF_BINARY_LOGS] = True
+    cg.add_define('USE_API_BINARY_LOGS')
+    CORE.add_job(_write_log_format_table)
+
+
 @coroutine_with_priority(40.0)
 def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
@@ -52,6 +107,9 @@ def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_coalesce_writes(config[CONF_COALESCE_WRITES]))
+    cg.add(var.set_coalesce_window(config[CONF_COALESCE_WINDOW]))
+    cg.add(var.set_entity_burst(config[CONF_ENTITY_BURST]))
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
@@ -68,6 +126,14 @@ def to_code(config):
         cg.add(var.register_user_service(trigger))
         yield automation.build_automation(trigger, func_args, conf)
 
+    if CONF_ENCRYPTION in config:
+        key = base64.b64decode(config[CONF_ENCRYPTION][CONF_KEY])
+        cg.add(var.set_encryption_key([cg.RawExpression(f'0x{byte:02X}') for byte in key]))
+        cg.add_define('USE_API_ENCRYPTION')
+
+    if config[CONF_BINARY_LOGS]:
+        enable_binary_logs()
+
     cg.add_define('USE_API')
     cg.add_global(api_ns.using)
 
@@ -1,7 +1,9 @@
 #include "api_connection.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/version.h"
+#include "lwip/tcp.h"
 
 #ifdef USE_DEEP_SLEEP
 #include "esphome/components/deep_sleep/deep_sleep_component.h"
@@ -14,6 +16,12 @@ namespace esphome {
 namespace api {
 
 static const char *TAG = "api.connection";
+/// A client with more queued frames than this isn't reading anymore and is disconnected.
+static const size_t API_MAX_SEND_QUEUE_BYTES = 4096;
+/// The longest the iterators send entities in one loop iteration, in µs.
+static const uint32_t API_ITERATOR_BUDGET_US = 5000;
+/// Don't try to send another entity with less free space in the TCP buffer than this, it would most likely not fit.
+static const size_t API_ITERATOR_MIN_SPACE = 64;
 
 APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
     : client_(client), parent_(parent), initial_state_iterator_(parent, this), list_entities_iterator_(parent, this) {
@@ -24,60 +32,162 @@ APIConnection::APIConnection(AsyncClient *client, APIServer *parent)
   this->client_->onData([](void *s, AsyncClient *c, void *buf,
                            size_t len) { ((APIConnection *) s)->on_data_(reinterpret_cast<uint8_t *>(buf), len); },
                         this);
+#ifdef USE_ESP32_CAMERA
+  this->client_->onAck(
+      [](void *s, AsyncClient *c, size_t len, uint32_t time) { ((APIConnection *) s)->acked_bytes_ += len; }, this);
+#endif
 
   this->send_buffer_.reserve(64);
-  this->recv_buffer_.reserve(32);
+  // the received data is only acknowledged once it has been parsed, so the TCP window never lets more arrive than fits
+  this->recv_ring_.init(TCP_WND);
+#ifdef USE_API_ENCRYPTION
+  this->plaintext_ring_.init(API_PLAINTEXT_RING_SIZE);
+  this->cipher_buffer_.reserve(256);
+#endif
   this->client_info_ = this->client_->remoteIP().toString().c_str();
   this->last_traffic_ = millis();
+  this->connected_at_ = this->last_traffic_;
 }
 APIConnection::~APIConnection() { delete this->client_; }
-void APIConnection::on_error_(int8_t error) { this->remove_ = true; }
-void APIConnection::on_disconnect_() { this->remove_ = true; }
+void APIConnection::on_error_(int8_t error) {
+  this->remove_ = true;
+  App.wake_loop();
+}
+void APIConnection::on_disconnect_() {
+  this->remove_ = true;
+  App.wake_loop();
+}
 void APIConnection::on_timeout_(uint32_t time) { this->on_fatal_error(); }
 void APIConnection::on_data_(uint8_t *buf, size_t len) {
   if (len == 0 || buf == nullptr)
     return;
-  this->recv_buffer_.insert(this->recv_buffer_.end(), buf, buf + len);
+  this->client_->ackLater();
+  if (!this->recv_ring_.push(buf, len)) {
+    // only possible if the TCP window is larger than the ring
+    this->remove_ = true;
+  }
+  App.wake_loop();
 }
-void APIConnection::parse_recv_buffer_() {
-  if (this->recv_buffer_.empty() || this->remove_)
-    return;
+#ifdef USE_API_ENCRYPTION
+bool APIConnection::read_records_() {
+  bool progress = false;
+  while (!this->remove_) {
+    const size_t size = this->recv_ring_.available();
+    if (size == 0)
+      break;
+    if (this->recv_ring_.at(0) != API_ENCRYPTED_PREAMBLE) {
+      ESP_LOGW(TAG, "'%s' didn't use encryption, disconnecting", this->client_info_.c_str());
+      this->on_fatal_error();
+      break;
+    }
+
+    if (!this->handshake_done_) {
+      if (size < 1 + API_HANDSHAKE_NONCE_SIZE)
+        break;
+      uint8_t client_nonce[API_HANDSHAKE_NONCE_SIZE];
+      this->recv_ring_.copy(1, client_nonce, sizeof(client_nonce));
+      uint8_t response[1 + API_HANDSHAKE_NONCE_SIZE];
+      response[0] = API_ENCRYPTED_PREAMBLE;
+      for (uint8_t i = 0; i < API_HANDSHAKE_NONCE_SIZE; i += 4) {
+        const uint32_t random = random_uint32();
+        memcpy(response + 1 + i, &random, 4);
+      }
+      this->cipher_.init(this->parent_->get_encryption_key(), client_nonce, response + 1);
+      this->client_->add(reinterpret_cast<char *>(response), sizeof(response), ASYNC_WRITE_FLAG_COPY);
+      this->client_->send();
+      this->handshake_done_ = true;
+      this->recv_ring_.consume(1 + API_HANDSHAKE_NONCE_SIZE);
+      this->client_->ack(1 + API_HANDSHAKE_NONCE_SIZE);
+      continue;
+    }
 
-  while (!this->recv_buffer_.empty()) {
-    if (this->recv_buffer_[0] != 0x00) {
+    if (size < API_RECORD_HEADER_SIZE)
+      break;
+    const size_t record_size = (uint16_t(this->recv_ring_.at(1)) << 8) | this->recv_ring_.at(2);
+    if (record_size < API_RECORD_TAG_SIZE || API_RECORD_HEADER_SIZE + record_size > this->recv_ring_.capacity() ||
+        record_size - API_RECORD_TAG_SIZE > this->plaintext_ring_.capacity()) {
+      ESP_LOGW(TAG, "'%s' sent a record of %u bytes, which doesn't fit into the receive buffer",
+               this->client_info_.c_str(), record_size);
+      this->on_fatal_error();
+      break;
+    }
+    if (size < API_RECORD_HEADER_SIZE + record_size)
+      // record not fully received
+      break;
+    const size_t plaintext_size = record_size - API_RECORD_TAG_SIZE;
+    if (plaintext_size > this->plaintext_ring_.capacity() - this->plaintext_ring_.available())
+      // the frames decrypted so far have to be parsed first
+      break;
+    uint8_t *record = this->recv_ring_.peek(0, API_RECORD_HEADER_SIZE + record_size, this->recv_scratch_);
+    if (!this->cipher_.decrypt(record, record_size)) {
+      ESP_LOGW(TAG, "Couldn't decrypt a message from '%s', wrong encryption key?", this->client_info_.c_str());
+      this->on_fatal_error();
+      break;
+    }
+    this->plaintext_ring_.push(record + API_RECORD_HEADER_SIZE, plaintext_size);
+    this->recv_ring_.consume(API_RECORD_HEADER_SIZE + record_size);
+    this->client_->ack(API_RECORD_HEADER_SIZE + record_size);
+    progress = true;
+  }
+  return progress;
+}
+#endif
+void APIConnection::parse_recv_buffer_() {
+#ifdef USE_API_ENCRYPTION
+  // the plaintext ring can fill up with frames before all records are decrypted
+  while (this->read_records_())
+    this->parse_frames_(this->plaintext_ring_);
+#else
+  this->parse_frames_(this->recv_ring_);
+#endif
+}
+void APIConnection::parse_frames_(APIRecvRing &ring) {
+  while (!this->remove_ && ring.available() != 0) {
+    if (ring.at(0) != 0x00) {
       ESP_LOGW(TAG, "Invalid preamble from %s", this->client_info_.c_str());
       this->on_fatal_error();
       return;
     }
+    uint8_t header[API_HEADER_PADDING];
+    const uint32_t size = std::min<size_t>(ring.available(), sizeof(header));
+    ring.copy(0, header, size);
     uint32_t i = 1;
-    const uint32_t size = this->recv_buffer_.size();
     uint32_t consumed;
-    auto msg_size_varint = ProtoVarInt::parse(&this->recv_buffer_[i], size - i, &consumed);
+    auto msg_size_varint = ProtoVarInt::parse(&header[i], size - i, &consumed);
     if (!msg_size_varint.has_value())
       // not enough data there yet
       return;
     i += consumed;
     uint32_t msg_size = msg_size_varint->as_uint32();
 
-    auto msg_type_varint = ProtoVarInt::parse(&this->recv_buffer_[i], size - i, &consumed);
+    auto msg_type_varint = ProtoVarInt::parse(&header[i], size - i, &consumed);
     if (!msg_type_varint.has_value())
       // not enough data there yet
       return;
     i += consumed;
     uint32_t msg_type = msg_type_varint->as_uint32();
 
-    if (size - i < msg_size)
+    if (i + msg_size > ring.capacity()) {
+      // it could never be received completely
+      ESP_LOGW(TAG, "'%s' sent a message of %u bytes, more than fits into the receive buffer",
+               this->client_info_.c_str(), msg_size);
+      this->on_fatal_error();
+      return;
+    }
+    if (ring.available() - i < msg_size)
       // message body not fully received
       return;
 
-    uint8_t *msg = &this->recv_buffer_[i];
+    uint8_t *msg = ring.peek(i, msg_size, this->recv_scratch_);
     this->read_message(msg_size, msg_type, msg);
     if (this->remove_)
       return;
-    // pop front
-    uint32_t total = i + msg_size;
-    this->recv_buffer_.erase(this->recv_buffer_.begin(), this->recv_buffer_.begin() + total);
+    ring.consume(i + msg_size);
+#ifndef USE_API_ENCRYPTION
+    this->client_->ack(i + msg_size);
+#endif
     this->last_traffic_ = millis();
+    network_mark_activity();
   }
 }
 
@@ -86,6 +196,35 @@ void APIConnection::disconnect_client() {
   this->remove_ = true;
 }
 
+bool APIConnection::is_idle() const {
+  if (this->remove_ || this->next_close_ || this->send_pending_ || this->recv_ring_.available() != 0)
+    return false;
+#ifdef USE_API_ENCRYPTION
+  if (this->plaintext_ring_.available() != 0)
+    return false;
+#endif
+  if (!this->send_queue_.empty())
+    return false;
+  if (this->list_entities_iterator_.is_running() || this->initial_state_iterator_.is_running())
+    return false;
+#ifdef USE_DUAL_CORE
+  if (this->pending_initial_states_ != nullptr)
+    return false;
+#endif
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available() || !this->unacked_images_.empty())
+    return false;
+#endif
+  return true;
+}
+
+bool APIConnection::states_delivered() const {
+  if (!this->state_subscription_ || !this->is_idle())
+    return false;
+  // lwIP only frees the send buffer when the data is acknowledged
+  return this->client_->space() >= TCP_SND_BUF;
+}
+
 void APIConnection::loop() {
   if (this->remove_)
     return;
@@ -108,8 +247,8 @@ void APIConnection::loop() {
   }
   this->parse_recv_buffer_();
 
-  this->list_entities_iterator_.advance();
-  this->initial_state_iterator_.advance();
+  this->advance_iterators_();
+  this->flush_send_queue_();
 
   const uint32_t keepalive = 60000;
   if (this->sent_ping_) {
@@ -120,50 +259,101 @@ void APIConnection::loop() {
     }
   } else if (millis() - this->last_traffic_ > keepalive) {
     this->sent_ping_ = true;
+    this->ping_sent_at_ = millis();
     this->send_ping_request(PingRequest());
   }
 
 #ifdef USE_ESP32_CAMERA
-  if (this->image_reader_.available()) {
-    uint32_t space = this->client_->space();
-    // reserve 15 bytes for metadata, and at least 64 bytes of data
-    if (space >= 15 + 64) {
-      uint32_t to_send = std::min(space - 15, this->image_reader_.available());
-      auto buffer = this->create_buffer();
-      // fixed32 key = 1;
-      buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
-      // bytes data = 2;
-      buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
-      // bool done = 3;
-      bool done = this->image_reader_.available() == to_send;
-      buffer.encode_bool(3, done);
-      bool success = this->send_buffer(buffer, 44);
-
-      if (success) {
-        this->image_reader_.consume_data(to_send);
-      }
-      if (success && done) {
-        this->image_reader_.return_image();
-      }
-    }
+  this->release_camera_images_();
+  this->send_camera_chunk_();
+#endif
+
+  if (this->send_pending_) {
+    this->send_pending_ = false;
+    this->client_->send();
+    network_mark_activity();
   }
+}
+
+void APIConnection::on_ping_response(const PingResponse &value) {
+  // we initiated ping
+  this->sent_ping_ = false;
+  network_report_round_trip_time(millis() - this->ping_sent_at_);
+}
+
+void APIConnection::subscribe_states(const SubscribeStatesRequest &msg) {
+  this->state_subscription_ = true;
+  this->states_snapshot_ = msg.states_snapshot;
+#ifdef USE_DUAL_CORE
+  // the loop task reads the entities, the states keep the capture alive if this connection closes meanwhile
+  auto states = std::make_shared<InitialStates>();
+  this->pending_initial_states_ = states;
+  App.run_in_loop([states]() {
+    states->capture();
+    App.wake_network_task();
+  });
+#else
+  this->initial_state_iterator_.begin();
+#endif
+}
+
+void APIConnection::advance_iterators_() {
+#ifdef USE_DUAL_CORE
+  if (this->pending_initial_states_ != nullptr && this->pending_initial_states_->ready.load(std::memory_order_acquire))
+    this->initial_state_iterator_.begin(std::move(this->pending_initial_states_));
 #endif
+  const bool sending_states = this->initial_state_iterator_.is_running();
+  const uint32_t start = micros();
+  const uint8_t burst = this->parent_->get_entity_burst();
+  for (uint8_t i = 0; i < burst; i++) {
+    // an entity that can't be sent stops the burst, the iterator continues with it in the next loop iteration
+    bool sent;
+    if (this->list_entities_iterator_.is_running()) {
+      sent = this->list_entities_iterator_.advance();
+    } else {
+      sent = this->initial_state_iterator_.advance();
+    }
+    if (!sent || this->remove_ || micros() - start > API_ITERATOR_BUDGET_US ||
+        this->client_->space() < API_ITERATOR_MIN_SPACE)
+      break;
+  }
+
+  if (sending_states && !this->initial_state_iterator_.is_running() && !this->ready_latency_.has_value()) {
+    this->ready_latency_ = millis() - this->connected_at_;
+    ESP_LOGD(TAG, "'%s' got all entities and states %u ms after connecting", this->client_info_.c_str(),
+             *this->ready_latency_);
+  }
 }
 
-std::string get_default_unique_id(const std::string &component_type, Nameable *nameable) {
-  return App.get_name() + component_type + nameable->get_object_id();
+std::string get_default_unique_id(const char *component_type, Nameable *nameable) {
+  const std::string &app_name = App.get_name();
+  const size_t type_len = strlen(component_type);
+  const StringRef object_id = nameable->get_object_id();
+  std::string unique_id;
+  unique_id.reserve(app_name.size() + type_len + object_id.size());
+  unique_id.append(app_name).append(component_type, type_len).append(object_id.c_str(), object_id.size());
+  return unique_id;
 }
 
 #ifdef USE_BINARY_SENSOR
 bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_binary_sensor_state_response(make_binary_sensor_state(binary_sensor, state));
+}
+BinarySensorStateResponse APIConnection::make_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor,
+                                                                  bool state) {
   BinarySensorStateResponse resp;
   resp.key = binary_sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !binary_sensor->has_state();
-  return this->send_binary_sensor_state_response(resp);
+  return resp;
+}
+void APIConnection::add_binary_sensor_state(StatesSnapshotResponse &snapshot, const BinarySensorStateResponse &state) {
+  snapshot.binary_sensor_keys.push_back(state.key);
+  snapshot.binary_sensor_states.push_back(state.state);
+  if (state.missing_state)
+    snapshot.missing_state_keys.push_back(state.key);
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
@@ -181,7 +371,9 @@ bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_
 bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_cover_state_response(make_cover_state(cover));
+}
+CoverStateResponse APIConnection::make_cover_state(cover::Cover *cover) {
   auto traits = cover->get_traits();
   CoverStateResponse resp{};
   resp.key = cover->get_object_id_hash();
@@ -191,7 +383,13 @@ bool APIConnection::send_cover_state(cover::Cover *cover) {
   if (traits.get_supports_tilt())
     resp.tilt = cover->tilt;
   resp.current_operation = static_cast<enums::CoverOperation>(cover->current_operation);
-  return this->send_cover_state_response(resp);
+  return resp;
+}
+void APIConnection::add_cover_state(StatesSnapshotResponse &snapshot, const CoverStateResponse &state) {
+  snapshot.cover_keys.push_back(state.key);
+  snapshot.cover_positions.push_back(state.position);
+  snapshot.cover_tilts.push_back(state.tilt);
+  snapshot.cover_current_operations.push_back(state.current_operation);
 }
 bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
@@ -231,7 +429,7 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
     call.set_tilt(msg.tilt);
   if (msg.stop)
     call.set_command_stop();
-  call.perform();
+  App.run_in_loop([call]() mutable { call.perform(); });
 }
 #endif
 
@@ -239,7 +437,9 @@ void APIConnection::cover_command(const CoverCommandRequest &msg) {
 bool APIConnection::send_fan_state(fan::FanState *fan) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_fan_state_response(make_fan_state(fan));
+}
+FanStateResponse APIConnection::make_fan_state(fan::FanState *fan) {
   auto traits = fan->get_traits();
   FanStateResponse resp{};
   resp.key = fan->get_object_id_hash();
@@ -250,7 +450,7 @@ bool APIConnection::send_fan_state(fan::FanState *fan) {
     resp.speed = static_cast<enums::FanSpeed>(fan->speed);
   if (traits.supports_direction())
     resp.direction = static_cast<enums::FanDirection>(fan->direction);
-  return this->send_fan_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_fan_info(fan::FanState *fan) {
   auto traits = fan->get_traits();
@@ -278,7 +478,7 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
     call.set_speed(static_cast<fan::FanSpeed>(msg.speed));
   if (msg.has_direction)
     call.set_direction(static_cast<fan::FanDirection>(msg.direction));
-  call.perform();
+  App.run_in_loop([call]() mutable { call.perform(); });
 }
 #endif
 
@@ -286,7 +486,9 @@ void APIConnection::fan_command(const FanCommandRequest &msg) {
 bool APIConnection::send_light_state(light::LightState *light) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_light_state_response(make_light_state(light));
+}
+LightStateResponse APIConnection::make_light_state(light::LightState *light) {
   auto traits = light->get_traits();
   auto values = light->remote_values;
   LightStateResponse resp{};
@@ -306,7 +508,7 @@ bool APIConnection::send_light_state(light::LightState *light) {
     resp.color_temperature = values.get_color_temperature();
   if (light->supports_effects())
     resp.effect = light->get_effect_name();
-  return this->send_light_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
@@ -354,8 +556,8 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
   if (msg.has_flash_length)
     call.set_flash_length(msg.flash_length);
   if (msg.has_effect)
-    call.set_effect(msg.effect);
-  call.perform();
+    call.set_effect(msg.effect.str());
+  App.run_in_loop([call]() mutable { call.perform(); });
 }
 #endif
 
@@ -363,12 +565,20 @@ void APIConnection::light_command(const LightCommandRequest &msg) {
 bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_sensor_state_response(make_sensor_state(sensor, state));
+}
+SensorStateResponse APIConnection::make_sensor_state(sensor::Sensor *sensor, float state) {
   SensorStateResponse resp{};
   resp.key = sensor->get_object_id_hash();
   resp.state = state;
   resp.missing_state = !sensor->has_state();
-  return this->send_sensor_state_response(resp);
+  return resp;
+}
+void APIConnection::add_sensor_state(StatesSnapshotResponse &snapshot, const SensorStateResponse &state) {
+  snapshot.sensor_keys.push_back(state.key);
+  snapshot.sensor_states.push_back(state.state);
+  if (state.missing_state)
+    snapshot.missing_state_keys.push_back(state.key);
 }
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
@@ -391,11 +601,17 @@ bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
 bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_switch_state_response(make_switch_state(a_switch, state));
+}
+SwitchStateResponse APIConnection::make_switch_state(switch_::Switch *a_switch, bool state) {
   SwitchStateResponse resp{};
   resp.key = a_switch->get_object_id_hash();
   resp.state = state;
-  return this->send_switch_state_response(resp);
+  return resp;
+}
+void APIConnection::add_switch_state(StatesSnapshotResponse &snapshot, const SwitchStateResponse &state) {
+  snapshot.switch_keys.push_back(state.key);
+  snapshot.switch_states.push_back(state.state);
 }
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
@@ -412,23 +628,29 @@ void APIConnection::switch_command(const SwitchCommandRequest &msg) {
   if (a_switch == nullptr)
     return;
 
-  if (msg.state)
-    a_switch->turn_on();
-  else
-    a_switch->turn_off();
+  const bool state = msg.state;
+  App.run_in_loop([a_switch, state]() {
+    if (state)
+      a_switch->turn_on();
+    else
+      a_switch->turn_off();
+  });
 }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state) {
+bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_text_sensor_state_response(make_text_sensor_state(text_sensor, state));
+}
+TextSensorStateResponse APIConnection::make_text_sensor_state(text_sensor::TextSensor *text_sensor,
+                                                              const std::string &state) {
   TextSensorStateResponse resp{};
   resp.key = text_sensor->get_object_id_hash();
-  resp.state = std::move(state);
+  resp.state = state;
   resp.missing_state = !text_sensor->has_state();
-  return this->send_text_sensor_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
@@ -447,7 +669,9 @@ bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor)
 bool APIConnection::send_climate_state(climate::Climate *climate) {
   if (!this->state_subscription_)
     return false;
-
+  return this->send_climate_state_response(make_climate_state(climate));
+}
+ClimateStateResponse APIConnection::make_climate_state(climate::Climate *climate) {
   auto traits = climate->get_traits();
   ClimateStateResponse resp{};
   resp.key = climate->get_object_id_hash();
@@ -467,7 +691,7 @@ bool APIConnection::send_climate_state(climate::Climate *climate) {
     resp.fan_mode = static_cast<enums::ClimateFanMode>(climate->fan_mode);
   if (traits.get_supports_swing_modes())
     resp.swing_mode = static_cast<enums::ClimateSwingMode>(climate->swing_mode);
-  return this->send_climate_state_response(resp);
+  return resp;
 }
 bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
@@ -521,7 +745,70 @@ void APIConnection::climate_command(const ClimateCommandRequest &msg) {
     call.set_fan_mode(static_cast<climate::ClimateFanMode>(msg.fan_mode));
   if (msg.has_swing_mode)
     call.set_swing_mode(static_cast<climate::ClimateSwingMode>(msg.swing_mode));
-  call.perform();
+  App.run_in_loop([call]() mutable { call.perform(); });
+}
+#endif
+
+#ifdef USE_HISTORY
+/// The most points sent in one HistoryResponse, so that it fits in the TCP buffer.
+static const size_t HISTORY_MAX_POINTS = 128;
+
+void APIConnection::history(const HistoryRequest &msg) {
+  auto *history = history::global_history->get_history(msg.key);
+  HistoryResponse resp;
+  resp.key = msg.key;
+  resp.resolution = msg.resolution;
+  resp.done = true;
+  if (history == nullptr) {
+    this->send_history_response(resp);
+    return;
+  }
+
+  const auto resolution = static_cast<history::HistoryResolution>(msg.resolution);
+  int64_t offset;
+  resp.utc = history::global_history->get_time_offset(offset);
+  const int64_t since = int64_t(msg.since) - offset;
+  const size_t start = history->find(resolution, since > 0 ? since : 0);
+  const size_t end = std::min(history->size(resolution), start + HISTORY_MAX_POINTS);
+  resp.done = end == history->size(resolution);
+
+  const bool raw = resolution == history::HISTORY_RESOLUTION_RAW;
+  resp.points.reserve((end - start) * (raw ? 8 : 16));
+  auto append = [&resp](uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++)
+      resp.points.push_back(char(value >> (i * 8)));
+  };
+  auto append_float = [&append](float value) {
+    uint32_t raw_value;
+    memcpy(&raw_value, &value, sizeof(raw_value));
+    append(raw_value);
+  };
+  for (size_t i = start; i < end; i++) {
+    const history::HistoryPoint point = history->at(resolution, i);
+    append(point.time + offset);
+    if (raw) {
+      append_float(point.mean);
+    } else {
+      append_float(point.min);
+      append_float(point.mean);
+      append_float(point.max);
+    }
+  }
+  this->send_history_response(resp);
+}
+#endif
+
+#ifdef USE_PERSISTENT_LOG
+/// The most record bytes sent in one StoredLogsResponse, so that it fits in the TCP buffer.
+static const size_t STORED_LOGS_MAX_BYTES = 1024;
+
+void APIConnection::stored_logs(const StoredLogsRequest &msg) {
+  StoredLogsResponse resp;
+  uint32_t position = msg.position;
+  resp.records.reserve(STORED_LOGS_MAX_BYTES);
+  resp.done = persistent_log::global_persistent_log->read(position, resp.records, STORED_LOGS_MAX_BYTES);
+  resp.next_position = position;
+  this->send_stored_logs_response(resp);
 }
 #endif
 
@@ -531,8 +818,104 @@ void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage>
     return;
   if (this->image_reader_.available())
     return;
+  const uint32_t now = millis();
+  const uint32_t interval = now - this->last_camera_image_;
+  // skip images the client doesn't want, allow them to come in a bit early for the camera's jitter
+  if (!this->camera_single_requested_ && interval + this->camera_update_interval_ / 8 < this->camera_update_interval_)
+    return;
+  this->camera_single_requested_ = false;
+  if (this->last_camera_image_ != 0 && interval < 5000) {
+    this->camera_frame_interval_ =
+        this->camera_frame_interval_ == 0.0f ? interval : this->camera_frame_interval_ * 0.8f + interval * 0.2f;
+  }
+  this->last_camera_image_ = now;
   this->image_reader_.set_image(image);
 }
+void APIConnection::send_camera_chunk_() {
+  if (!this->image_reader_.available())
+    return;
+  // the image must not overtake the frames queued before it
+  if (!this->flush_send_queue_())
+    return;
+  const uint32_t space = this->client_->space();
+  // reserve 21 bytes for the header and metadata, and at least 64 bytes of data
+  uint32_t overhead = 21;
+#ifdef USE_API_ENCRYPTION
+  // the metadata and the data are encrypted as two records
+  overhead += 2 * (API_RECORD_HEADER_SIZE + API_RECORD_TAG_SIZE);
+#endif
+  if (space < overhead + 64)
+    return;
+  const uint32_t to_send = std::min<uint32_t>(space - overhead, this->image_reader_.available());
+  const bool done = this->image_reader_.available() == to_send;
+
+  // The metadata goes in front of the data so that the data can be queued straight from the frame buffer
+  uint8_t buffer[API_HEADER_PADDING + 16];
+  uint8_t *metadata = buffer + API_HEADER_PADDING;
+  uint8_t len = 0;
+  // fixed32 key = 1;
+  const uint32_t key = esp32_camera::global_esp32_camera->get_object_id_hash();
+  metadata[len++] = (1 << 3) | 5;
+  for (uint8_t i = 0; i < 4; i++)
+    metadata[len++] = key >> (i * 8);
+  // bool done = 3;
+  metadata[len++] = (3 << 3) | 0;
+  metadata[len++] = done;
+  if (done) {
+    // float framerate = 4;
+    const float framerate = this->camera_frame_interval_ == 0.0f ? 0.0f : 1000.0f / this->camera_frame_interval_;
+    uint32_t raw;
+    memcpy(&raw, &framerate, 4);
+    metadata[len++] = (4 << 3) | 5;
+    for (uint8_t i = 0; i < 4; i++)
+      metadata[len++] = raw >> (i * 8);
+  }
+  // bytes data = 2;
+  metadata[len++] = (2 << 3) | 2;
+  len += ProtoVarInt(to_send).encode_to_buffer_unchecked(metadata + len);
+  // CameraImageResponse
+  const uint8_t header_size = encode_frame_header(buffer, len + to_send, 44);
+
+  const uint8_t flags = this->parent_->is_coalesce_writes() ? ASYNC_WRITE_FLAG_MORE : 0;
+#ifdef USE_API_ENCRYPTION
+  // the data can't be sent from the frame buffer, it is copied with the encrypted records
+  this->cipher_buffer_.clear();
+  this->cipher_.encrypt(buffer + API_HEADER_PADDING - header_size, header_size + len, this->cipher_buffer_);
+  this->cipher_.encrypt(this->image_reader_.peek_data_buffer(), to_send, this->cipher_buffer_);
+  this->client_->add(reinterpret_cast<char *>(this->cipher_buffer_.data()), this->cipher_buffer_.size(),
+                     ASYNC_WRITE_FLAG_COPY | flags);
+  this->sent_bytes_ += this->cipher_buffer_.size();
+#else
+  this->client_->add(reinterpret_cast<char *>(buffer + API_HEADER_PADDING - header_size), header_size + len,
+                     ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
+  // not copied, lwIP references the frame buffer until the data is acknowledged
+  this->client_->add(reinterpret_cast<char *>(this->image_reader_.peek_data_buffer()), to_send, flags);
+  this->sent_bytes_ += header_size + len + to_send;
+#endif
+  if (this->parent_->is_coalesce_writes()) {
+    this->send_pending_ = true;
+  } else {
+    this->send_pending_ = false;
+    this->client_->send();
+  }
+
+  this->image_reader_.consume_data(to_send);
+  if (done) {
+    this->unacked_images_.push_back(
+        UnackedCameraImage{this->sent_bytes_, this->last_camera_image_, this->image_reader_.get_image()});
+    this->image_reader_.return_image();
+  }
+}
+void APIConnection::release_camera_images_() {
+  while (!this->unacked_images_.empty() &&
+         int32_t(this->acked_bytes_ - this->unacked_images_.front().sent_bytes) >= 0) {
+    // the camera adapts its quality to how long the images take to reach the client
+    const size_t length = this->unacked_images_.front().image->get_data_length();
+    const uint32_t duration = millis() - this->unacked_images_.front().started;
+    App.run_in_loop([length, duration]() { esp32_camera::global_esp32_camera->report_delivery(length, duration); });
+    this->unacked_images_.pop_front();
+  }
+}
 bool APIConnection::send_camera_info(esp32_camera::ESP32Camera *camera) {
   ListEntitiesCameraResponse msg;
   msg.key = camera->get_object_id_hash();
@@ -545,17 +928,25 @@ void APIConnection::camera_image(const CameraImageRequest &msg) {
   if (esp32_camera::global_esp32_camera == nullptr)
     return;
 
-  if (msg.single)
+  if (msg.single) {
+    this->camera_single_requested_ = true;
     esp32_camera::global_esp32_camera->request_image();
-  if (msg.stream)
-    esp32_camera::global_esp32_camera->request_stream();
+  }
+  if (msg.stream) {
+    this->camera_update_interval_ = msg.max_framerate > 0.0f ? uint32_t(1000.0f / msg.max_framerate) : 0;
+    esp32_camera::global_esp32_camera->request_stream(this->camera_update_interval_);
+    // the sensor takes the images for all clients, the last request decides
+    esp32_camera::global_esp32_camera->request_frame_size(msg.max_width, msg.max_height);
+  }
 }
 #endif
 
 #ifdef USE_HOMEASSISTANT_TIME
 void APIConnection::on_get_time_response(const GetTimeResponse &value) {
-  if (homeassistant::global_homeassistant_time != nullptr)
-    homeassistant::global_homeassistant_time->set_epoch_time(value.epoch_seconds);
+  if (homeassistant::global_homeassistant_time == nullptr)
+    return;
+  const uint32_t epoch = value.epoch_seconds;
+  App.run_in_loop([epoch]() { homeassistant::global_homeassistant_time->set_epoch_time(epoch); });
 }
 #endif
 
@@ -583,6 +974,25 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
   }
 }
 
+#ifdef USE_API_BINARY_LOGS
+bool APIConnection::send_binary_log_message(int level, const char *tag, int line, uint32_t format_id,
+                                            const std::vector<uint8_t> &args) {
+  auto buffer = this->create_buffer(args.size() + strlen(tag) + 16);
+  // LogLevel level = 1;
+  buffer.encode_uint32(1, static_cast<uint32_t>(level));
+  // string tag = 2;
+  buffer.encode_string(2, tag, strlen(tag));
+  // uint32 line = 3;
+  buffer.encode_uint32(3, static_cast<uint32_t>(line));
+  // fixed32 format_id = 4;
+  buffer.encode_fixed32(4, format_id);
+  // bytes args = 5;
+  buffer.encode_string(5, reinterpret_cast<const char *>(args.data()), args.size());
+  // BinaryLogResponse - 49
+  return this->send_buffer(buffer, 49);
+}
+#endif
+
 HelloResponse APIConnection::hello(const HelloRequest &msg) {
   this->client_info_ = msg.client_info + " (" + this->client_->remoteIP().toString().c_str();
   this->client_info_ += ")";
@@ -592,6 +1002,7 @@ HelloResponse APIConnection::hello(const HelloRequest &msg) {
   resp.api_version_major = 1;
   resp.api_version_minor = 3;
   resp.server_info = App.get_name() + " (esphome v" ESPHOME_VERSION ")";
+  resp.supports_states_snapshot = true;
   this->connection_state_ = ConnectionState::CONNECTED;
   return resp;
 }
@@ -629,9 +1040,25 @@ DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
   return resp;
 }
 void APIConnection::on_home_assistant_state_response(const HomeAssistantStateResponse &msg) {
-  for (auto &it : this->parent_->get_state_subs())
-    if (it.entity_id == msg.entity_id)
-      it.callback(msg.state);
+  // the message points into the receive buffer, take copies before handing over to the loop task
+  APIServer *parent = this->parent_;
+  std::string entity_id(msg.entity_id.data(), msg.entity_id.size());
+  std::string state(msg.state.data(), msg.state.size());
+  App.run_in_loop([parent, entity_id, state]() { parent->on_home_assistant_state(entity_id, state); });
+}
+void APIConnection::on_home_assistant_compact_state_response(const HomeAssistantCompactStateResponse &msg) {
+  APIServer *parent = this->parent_;
+  uint32_t handle = msg.handle;
+  bool has_numeric_state = msg.has_numeric_state;
+  float numeric_state = msg.numeric_state;
+  std::string state(msg.state.data(), msg.state.size());
+  App.run_in_loop([parent, handle, has_numeric_state, numeric_state, state]() {
+    if (has_numeric_state) {
+      parent->on_home_assistant_numeric_state(handle, numeric_state);
+    } else {
+      parent->on_home_assistant_state(handle, state);
+    }
+  });
 }
 void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
   bool found = false;
@@ -645,9 +1072,15 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
   }
 }
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
+  uint32_t handle = 0;
   for (auto &it : this->parent_->get_state_subs()) {
+    handle++;
     SubscribeHomeAssistantStateResponse resp;
     resp.entity_id = it.entity_id;
+    if (msg.compact) {
+      resp.handle = handle;
+      resp.numeric = it.callbacks.empty();
+    }
     if (!this->send_subscribe_home_assistant_state_response(resp)) {
       this->on_fatal_error();
       return;
@@ -658,31 +1091,91 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
   if (this->remove_)
     return false;
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(buffer.get_buffer()->size()).encode(header);
-  ProtoVarInt(message_type).encode(header);
+  std::vector<uint8_t> *raw = buffer.get_buffer();
+  const uint32_t payload_size = raw->size() - API_HEADER_PADDING;
+  // Write the header right in front of the payload so that the frame can be queued with a single add()
+  const uint8_t header_size = encode_frame_header(raw->data(), payload_size, message_type);
+  if (header_size == 0) {
+    ESP_LOGW(TAG, "Message of type %u too large to send (%u bytes)", message_type, payload_size);
+    return false;
+  }
 
-  size_t needed_space = buffer.get_buffer()->size() + header.size();
+  // the message must not overtake the frames queued before it
+  if (!this->flush_send_queue_() ||
+      !this->write_frame_(raw->data() + API_HEADER_PADDING - header_size, header_size + payload_size)) {
+    // SubscribeLogsResponse, BinaryLogResponse
+    if (message_type != 29 && message_type != 49) {
+      ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
+    }
+    return false;
+  }
+  return true;
+}
+bool APIConnection::send_frame(const std::shared_ptr<APIFrame> &frame) {
+  if (this->remove_)
+    return false;
+  if (this->send_queue_.empty() && this->write_frame_(frame->data(), frame->size()))
+    return true;
 
-  if (needed_space > this->client_->space()) {
+  if (this->send_queue_bytes_ + frame->size() > API_MAX_SEND_QUEUE_BYTES) {
+    // don't let a stalled client hold on to more and more frames
+    ESP_LOGW(TAG, "'%s' is not reading the data sent to it. Disconnecting...", this->client_info_.c_str());
+    this->on_fatal_error();
+    return false;
+  }
+  this->send_queue_.push_back(frame);
+  this->send_queue_bytes_ += frame->size();
+  return true;
+}
+bool APIConnection::write_frame_(const uint8_t *data, size_t len) {
+#ifdef USE_API_ENCRYPTION
+  const size_t wire_size = APICipher::encrypted_size(len);
+#else
+  const size_t wire_size = len;
+#endif
+  if (wire_size > this->client_->space()) {
+    if (this->send_pending_) {
+      // push out what has been coalesced so far to free up space
+      this->client_->send();
+      this->send_pending_ = false;
+    }
     delay(0);
-    if (needed_space > this->client_->space()) {
-      // SubscribeLogsResponse
-      if (message_type != 29) {
-        ESP_LOGV(TAG, "Cannot send message because of TCP buffer space");
-      }
+    if (wire_size > this->client_->space()) {
       delay(0);
       return false;
     }
   }
 
-  this->client_->add(reinterpret_cast<char *>(header.data()), header.size(),
-                     ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
-  this->client_->add(reinterpret_cast<char *>(buffer.get_buffer()->data()), buffer.get_buffer()->size(),
-                     ASYNC_WRITE_FLAG_COPY);
-  bool ret = this->client_->send();
-  return ret;
+#ifdef USE_API_ENCRYPTION
+  this->cipher_buffer_.clear();
+  this->cipher_.encrypt(data, len, this->cipher_buffer_);
+  data = this->cipher_buffer_.data();
+  len = this->cipher_buffer_.size();
+#endif
+  const char *frame = reinterpret_cast<const char *>(data);
+#ifdef USE_ESP32_CAMERA
+  this->sent_bytes_ += len;
+#endif
+  if (this->parent_->is_coalesce_writes()) {
+    // only queue the frame, loop() sends everything queued during this loop iteration in one go
+    this->client_->add(frame, len, ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
+    this->send_pending_ = true;
+    return true;
+  }
+
+  this->client_->add(frame, len, ASYNC_WRITE_FLAG_COPY);
+  this->send_pending_ = false;
+  return this->client_->send();
+}
+bool APIConnection::flush_send_queue_() {
+  while (!this->send_queue_.empty()) {
+    const std::shared_ptr<APIFrame> &frame = this->send_queue_.front();
+    if (!this->write_frame_(frame->data(), frame->size()))
+      return false;
+    this->send_queue_bytes_ -= frame->size();
+    this->send_queue_.pop_front();
+  }
+  return true;
 }
 void APIConnection::on_unauthenticated_access() {
   ESP_LOGD(TAG, "'%s' tried to access without authentication.", this->client_info_.c_str());
@@ -5,6 +5,9 @@
 #include "api_pb2.h"
 #include "api_pb2_service.h"
 #include "api_server.h"
+#include "api_frame.h"
+#include "api_crypto.h"
+#include <deque>
 
 namespace esphome {
 namespace api {
@@ -16,6 +19,23 @@ class APIConnection : public APIServerConnection {
 
   void disconnect_client();
   void loop();
+  /// Whether this connection has no pending work for the main loop.
+  bool is_idle() const;
+  /// Whether the client subscribed to states and acknowledged all data sent to it so far.
+  bool states_delivered() const;
+  /** Send a frame that may be shared with other connections.
+   *
+   * Frames that don't fit into the TCP buffer are queued and sent from loop(). A client that can't keep up with
+   * API_MAX_SEND_QUEUE_BYTES of queued frames is disconnected.
+   */
+  bool send_frame(const std::shared_ptr<APIFrame> &frame);
+  /// ms from the connection to the end of the first pass of the initial states, empty until then.
+  optional<uint32_t> get_ready_latency() const { return this->ready_latency_; }
+  size_t get_send_queue_frames() const { return this->send_queue_.size(); }
+  size_t get_send_queue_bytes() const { return this->send_queue_bytes_; }
+  const std::string &get_client_info() const { return this->client_info_; }
+  /// Whether the client gets the states of binary sensors, covers, sensors and switches as StatesSnapshotResponse.
+  bool is_states_snapshot() const { return this->states_snapshot_; }
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
@@ -23,34 +43,45 @@ class APIConnection : public APIServerConnection {
   }
 #ifdef USE_BINARY_SENSOR
   bool send_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
+  static BinarySensorStateResponse make_binary_sensor_state(binary_sensor::BinarySensor *binary_sensor, bool state);
+  static void add_binary_sensor_state(StatesSnapshotResponse &snapshot, const BinarySensorStateResponse &state);
   bool send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor);
 #endif
 #ifdef USE_COVER
   bool send_cover_state(cover::Cover *cover);
+  static CoverStateResponse make_cover_state(cover::Cover *cover);
+  static void add_cover_state(StatesSnapshotResponse &snapshot, const CoverStateResponse &state);
   bool send_cover_info(cover::Cover *cover);
   void cover_command(const CoverCommandRequest &msg) override;
 #endif
 #ifdef USE_FAN
   bool send_fan_state(fan::FanState *fan);
+  static FanStateResponse make_fan_state(fan::FanState *fan);
   bool send_fan_info(fan::FanState *fan);
   void fan_command(const FanCommandRequest &msg) override;
 #endif
 #ifdef USE_LIGHT
   bool send_light_state(light::LightState *light);
+  static LightStateResponse make_light_state(light::LightState *light);
   bool send_light_info(light::LightState *light);
   void light_command(const LightCommandRequest &msg) override;
 #endif
 #ifdef USE_SENSOR
   bool send_sensor_state(sensor::Sensor *sensor, float state);
+  static SensorStateResponse make_sensor_state(sensor::Sensor *sensor, float state);
+  static void add_sensor_state(StatesSnapshotResponse &snapshot, const SensorStateResponse &state);
   bool send_sensor_info(sensor::Sensor *sensor);
 #endif
 #ifdef USE_SWITCH
   bool send_switch_state(switch_::Switch *a_switch, bool state);
+  static SwitchStateResponse make_switch_state(switch_::Switch *a_switch, bool state);
+  static void add_switch_state(StatesSnapshotResponse &snapshot, const SwitchStateResponse &state);
   bool send_switch_info(switch_::Switch *a_switch);
   void switch_command(const SwitchCommandRequest &msg) override;
 #endif
 #ifdef USE_TEXT_SENSOR
-  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, std::string state);
+  bool send_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state);
+  static TextSensorStateResponse make_text_sensor_state(text_sensor::TextSensor *text_sensor, const std::string &state);
   bool send_text_sensor_info(text_sensor::TextSensor *text_sensor);
 #endif
 #ifdef USE_ESP32_CAMERA
@@ -60,10 +91,31 @@ class APIConnection : public APIServerConnection {
 #endif
 #ifdef USE_CLIMATE
   bool send_climate_state(climate::Climate *climate);
+  static ClimateStateResponse make_climate_state(climate::Climate *climate);
   bool send_climate_info(climate::Climate *climate);
   void climate_command(const ClimateCommandRequest &msg) override;
+#endif
+#ifdef USE_HISTORY
+  void history(const HistoryRequest &msg) override;
+#endif
+#ifdef USE_PERSISTENT_LOG
+  void stored_logs(const StoredLogsRequest &msg) override;
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+  void subscribe_bluetooth_le_advertisements(const SubscribeBluetoothLEAdvertisementsRequest &msg) override {
+    this->bluetooth_le_advertisements_subscription_ = true;
+  }
+  bool is_bluetooth_le_advertisements_subscribed() const { return this->bluetooth_le_advertisements_subscription_; }
 #endif
   bool send_log_message(int level, const char *tag, const char *line);
+  bool is_log_subscribed(int level) const { return this->log_subscription_ >= level; }
+#ifdef USE_API_BINARY_LOGS
+  bool send_binary_log_message(int level, const char *tag, int line, uint32_t format_id,
+                               const std::vector<uint8_t> &args);
+  bool is_log_binary() const { return this->log_binary_; }
+#else
+  bool is_log_binary() const { return false; }
+#endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
     if (!this->service_call_subscription_)
       return;
@@ -80,11 +132,9 @@ class APIConnection : public APIServerConnection {
     // we initiated disconnect_client
     this->next_close_ = true;
   }
-  void on_ping_response(const PingResponse &value) override {
-    // we initiated ping
-    this->sent_ping_ = false;
-  }
+  void on_ping_response(const PingResponse &value) override;
   void on_home_assistant_state_response(const HomeAssistantStateResponse &msg) override;
+  void on_home_assistant_compact_state_response(const HomeAssistantCompactStateResponse &msg) override;
 #ifdef USE_HOMEASSISTANT_TIME
   void on_get_time_response(const GetTimeResponse &value) override;
 #endif
@@ -99,12 +149,12 @@ class APIConnection : public APIServerConnection {
   PingResponse ping(const PingRequest &msg) override { return {}; }
   DeviceInfoResponse device_info(const DeviceInfoRequest &msg) override;
   void list_entities(const ListEntitiesRequest &msg) override { this->list_entities_iterator_.begin(); }
-  void subscribe_states(const SubscribeStatesRequest &msg) override {
-    this->state_subscription_ = true;
-    this->initial_state_iterator_.begin();
-  }
+  void subscribe_states(const SubscribeStatesRequest &msg) override;
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
+#ifdef USE_API_BINARY_LOGS
+    this->log_binary_ = msg.binary;
+#endif
     if (msg.dump_config)
       App.schedule_dump_config();
   }
@@ -124,8 +174,11 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size = 0) override {
+    // leave room in front for the frame header, send_buffer() fills it in place
     this->send_buffer_.clear();
+    this->send_buffer_.reserve(API_HEADER_PADDING + reserve_size);
+    this->send_buffer_.resize(API_HEADER_PADDING);
     return {&this->send_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -138,6 +191,24 @@ class APIConnection : public APIServerConnection {
   void on_timeout_(uint32_t time);
   void on_data_(uint8_t *buf, size_t len);
   void parse_recv_buffer_();
+  /// Decode the complete messages in the ring.
+  void parse_frames_(APIRecvRing &ring);
+#ifdef USE_API_ENCRYPTION
+  /// Answer the handshake and decrypt the complete records of recv_ring_ into plaintext_ring_, true if any were.
+  bool read_records_();
+#endif
+  /// Queue a complete frame with the TCP client, false if there isn't enough space in the TCP buffer.
+  bool write_frame_(const uint8_t *data, size_t len);
+  /// Send as many queued frames as fit, true if the queue is empty afterwards.
+  bool flush_send_queue_();
+  /// Send the entities of the running iterators, as many as the TCP buffer, the burst size and the time budget allow.
+  void advance_iterators_();
+#ifdef USE_ESP32_CAMERA
+  /// Send the next chunk of the current image straight from the frame buffer.
+  void send_camera_chunk_();
+  /// Release the images of which all data has been acknowledged by the client.
+  void release_camera_images_();
+#endif
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -148,23 +219,73 @@ class APIConnection : public APIServerConnection {
   bool remove_{false};
 
   std::vector<uint8_t> send_buffer_;
-  std::vector<uint8_t> recv_buffer_;
+  /// The data received from the client that hasn't been parsed yet.
+  APIRecvRing recv_ring_;
+  /// Messages that wrap around the end of a ring are copied here to decode them.
+  std::vector<uint8_t> recv_scratch_;
+#ifdef USE_API_ENCRYPTION
+  APICipher cipher_;
+  bool handshake_done_{false};
+  /// The decrypted frames, recv_ring_ holds the records.
+  APIRecvRing plaintext_ring_;
+  /// The records of the last write, kept to not allocate again for every frame.
+  std::vector<uint8_t> cipher_buffer_;
+#endif
 
   std::string client_info_;
+  /// Frames that didn't fit into the TCP buffer yet, in the order they have to be sent.
+  std::deque<std::shared_ptr<APIFrame>> send_queue_;
+  size_t send_queue_bytes_{0};
 #ifdef USE_ESP32_CAMERA
   esp32_camera::CameraImageReader image_reader_;
+  /// An image that has been sent without copying, lwIP references its data until it is acknowledged.
+  struct UnackedCameraImage {
+    uint32_t sent_bytes;
+    /// When the image was handed to this connection, to measure how long its delivery took.
+    uint32_t started;
+    std::shared_ptr<esp32_camera::CameraImage> image;
+  };
+  std::deque<UnackedCameraImage> unacked_images_;
+  /// Bytes queued with and acknowledged by the TCP client in total, both wrap around.
+  uint32_t sent_bytes_{0};
+  volatile uint32_t acked_bytes_{0};
+  /// The interval the client wants to stream images at (0 = as fast as the camera takes them).
+  uint32_t camera_update_interval_{0};
+  bool camera_single_requested_{false};
+  uint32_t last_camera_image_{0};
+  /// Moving average of the time between two images sent to this client in ms.
+  float camera_frame_interval_{0.0f};
 #endif
 
   bool state_subscription_{false};
+  bool states_snapshot_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
+#ifdef USE_API_BINARY_LOGS
+  /// Whether log messages are sent as BinaryLogResponse (format id and encoded arguments) to this client.
+  bool log_binary_{false};
+#endif
   uint32_t last_traffic_;
+  /// millis() when the client connected.
+  uint32_t connected_at_;
+  optional<uint32_t> ready_latency_{};
   bool sent_ping_{false};
+  /// millis() when the last ping request was sent.
+  uint32_t ping_sent_at_{0};
   bool service_call_subscription_{false};
+#ifdef USE_BLUETOOTH_PROXY
+  bool bluetooth_le_advertisements_subscription_{false};
+#endif
   bool current_nodelay_{false};
   bool next_close_{false};
+  /// Whether frames have been queued with the client that still need to be pushed out with send().
+  bool send_pending_{false};
   AsyncClient *client_;
   APIServer *parent_;
   InitialStateIterator initial_state_iterator_;
+#ifdef USE_DUAL_CORE
+  /// The states the loop task is capturing for initial_state_iterator_, shared with it until they are ready.
+  std::shared_ptr<InitialStates> pending_initial_states_;
+#endif
   ListEntitiesIterator list_entities_iterator_;
 };
 
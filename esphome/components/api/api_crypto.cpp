@@ -0,0 +1,145 @@
+#include "api_crypto.h"
+
+#ifdef USE_API_ENCRYPTION
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include "mbedtls/md.h"
+#endif
+
+namespace esphome {
+namespace api {
+
+static const char API_KEY_LABEL[] = "esphome-api";
+
+static void derive_key(const APIEncryptionKey &psk, const uint8_t *client_nonce, const uint8_t *server_nonce,
+                       char direction, uint8_t *key) {
+  uint8_t info[sizeof(API_KEY_LABEL) - 1 + 2 * API_HANDSHAKE_NONCE_SIZE + 1];
+  uint8_t *at = info;
+  memcpy(at, API_KEY_LABEL, sizeof(API_KEY_LABEL) - 1);
+  at += sizeof(API_KEY_LABEL) - 1;
+  memcpy(at, client_nonce, API_HANDSHAKE_NONCE_SIZE);
+  at += API_HANDSHAKE_NONCE_SIZE;
+  memcpy(at, server_nonce, API_HANDSHAKE_NONCE_SIZE);
+  at += API_HANDSHAKE_NONCE_SIZE;
+  *at = direction;
+#ifdef ARDUINO_ARCH_ESP32
+  mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), psk.data(), psk.size(), info, sizeof(info), key);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  br_hmac_key_context key_ctx;
+  br_hmac_key_init(&key_ctx, &br_sha256_vtable, psk.data(), psk.size());
+  br_hmac_context ctx;
+  br_hmac_init(&ctx, &key_ctx, 0);
+  br_hmac_update(&ctx, info, sizeof(info));
+  br_hmac_out(&ctx, key);
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+APICipher::APICipher() {
+  mbedtls_gcm_init(&this->tx_);
+  mbedtls_gcm_init(&this->rx_);
+}
+APICipher::~APICipher() {
+  mbedtls_gcm_free(&this->tx_);
+  mbedtls_gcm_free(&this->rx_);
+}
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+APICipher::APICipher() = default;
+APICipher::~APICipher() = default;
+#endif
+
+void APICipher::init(const APIEncryptionKey &psk, const uint8_t *client_nonce, const uint8_t *server_nonce) {
+  uint8_t tx_key[32];
+  uint8_t rx_key[32];
+  derive_key(psk, client_nonce, server_nonce, 's', tx_key);
+  derive_key(psk, client_nonce, server_nonce, 'c', rx_key);
+#ifdef ARDUINO_ARCH_ESP32
+  mbedtls_gcm_setkey(&this->tx_, MBEDTLS_CIPHER_ID_AES, tx_key, 256);
+  mbedtls_gcm_setkey(&this->rx_, MBEDTLS_CIPHER_ID_AES, rx_key, 256);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  br_aes_ct_ctr_init(&this->tx_aes_, tx_key, sizeof(tx_key));
+  br_aes_ct_ctr_init(&this->rx_aes_, rx_key, sizeof(rx_key));
+  br_gcm_init(&this->tx_, &this->tx_aes_.vtable, br_ghash_ctmul32);
+  br_gcm_init(&this->rx_, &this->rx_aes_.vtable, br_ghash_ctmul32);
+#endif
+  memset(tx_key, 0, sizeof(tx_key));
+  memset(rx_key, 0, sizeof(rx_key));
+  this->tx_counter_ = 0;
+  this->rx_counter_ = 0;
+}
+
+void APICipher::make_iv_(uint64_t counter, uint8_t *iv) {
+  memset(iv, 0, 4);
+  for (uint8_t i = 0; i < 8; i++)
+    iv[4 + i] = counter >> (56 - i * 8);
+}
+
+size_t APICipher::encrypted_size(size_t len) {
+  const size_t records = (len + API_RECORD_MAX_PAYLOAD - 1) / API_RECORD_MAX_PAYLOAD;
+  return len + records * (API_RECORD_HEADER_SIZE + API_RECORD_TAG_SIZE);
+}
+
+void APICipher::encrypt(const uint8_t *data, size_t len, std::vector<uint8_t> &out) {
+  while (len != 0) {
+    const size_t chunk = std::min<size_t>(len, API_RECORD_MAX_PAYLOAD);
+    const size_t size = chunk + API_RECORD_TAG_SIZE;
+    const size_t start = out.size();
+    out.resize(start + API_RECORD_HEADER_SIZE + size);
+    uint8_t *record = out.data() + start;
+    record[0] = API_ENCRYPTED_PREAMBLE;
+    record[1] = size >> 8;
+    record[2] = size;
+    uint8_t *payload = record + API_RECORD_HEADER_SIZE;
+    uint8_t iv[12];
+    make_iv_(this->tx_counter_++, iv);
+#ifdef ARDUINO_ARCH_ESP32
+    mbedtls_gcm_crypt_and_tag(&this->tx_, MBEDTLS_GCM_ENCRYPT, chunk, iv, sizeof(iv), record, API_RECORD_HEADER_SIZE,
+                              data, payload, API_RECORD_TAG_SIZE, payload + chunk);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+    memcpy(payload, data, chunk);
+    br_gcm_reset(&this->tx_, iv, sizeof(iv));
+    br_gcm_aad_inject(&this->tx_, record, API_RECORD_HEADER_SIZE);
+    br_gcm_flip(&this->tx_);
+    br_gcm_run(&this->tx_, 1, payload, chunk);
+    br_gcm_get_tag(&this->tx_, payload + chunk);
+#endif
+    data += chunk;
+    len -= chunk;
+  }
+}
+
+bool APICipher::decrypt(uint8_t *record, size_t size) {
+  if (size < API_RECORD_TAG_SIZE)
+    return false;
+  const size_t len = size - API_RECORD_TAG_SIZE;
+  uint8_t *payload = record + API_RECORD_HEADER_SIZE;
+  uint8_t iv[12];
+  make_iv_(this->rx_counter_, iv);
+#ifdef ARDUINO_ARCH_ESP32
+  if (mbedtls_gcm_auth_decrypt(&this->rx_, len, iv, sizeof(iv), record, API_RECORD_HEADER_SIZE, payload + len,
+                               API_RECORD_TAG_SIZE, payload, payload) != 0)
+    return false;
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  br_gcm_reset(&this->rx_, iv, sizeof(iv));
+  br_gcm_aad_inject(&this->rx_, record, API_RECORD_HEADER_SIZE);
+  br_gcm_flip(&this->rx_);
+  br_gcm_run(&this->rx_, 0, payload, len);
+  if (!br_gcm_check_tag(&this->rx_, payload + len))
+    return false;
+#endif
+  this->rx_counter_++;
+  return true;
+}
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_ENCRYPTION
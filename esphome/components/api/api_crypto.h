@@ -0,0 +1,95 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_API_ENCRYPTION
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include "mbedtls/gcm.h"
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+#include <bearssl/bearssl.h>
+#endif
+
+namespace esphome {
+namespace api {
+
+using APIEncryptionKey = std::array<uint8_t, 32>;
+
+/// The first byte of the handshake and of every record of an encrypted connection (plaintext frames start with 0).
+static const uint8_t API_ENCRYPTED_PREAMBLE = 0x01;
+/// Size of the random nonces exchanged in the handshake.
+static const uint8_t API_HANDSHAKE_NONCE_SIZE = 16;
+/// Preamble and big endian length of the ciphertext + tag.
+static const uint8_t API_RECORD_HEADER_SIZE = 3;
+static const uint8_t API_RECORD_TAG_SIZE = 16;
+static const uint16_t API_RECORD_MAX_PAYLOAD = 0xFFFF - API_RECORD_TAG_SIZE;
+/// Capacity of the ring that holds decrypted frames until they are parsed, the largest message a client can send
+/// over an encrypted connection. The records are buffered up to the TCP window before that.
+static const uint16_t API_PLAINTEXT_RING_SIZE = 2048;
+
+/** The AES-256-GCM record layer of an encrypted API connection.
+ *
+ * Encryption sits below the frames: the bytes of the plaintext protocol (preambles and headers included) are cut into
+ * records, so it doesn't matter how the frames are split up or joined. The handshake only exchanges a random nonce in
+ * each direction:
+ *
+ * - client: 0x01, client nonce (16 bytes)
+ * - server: 0x01, server nonce (16 bytes)
+ *
+ * The key of each direction is HMAC-SHA256(psk, "esphome-api" || client nonce || server nonce || direction) with
+ * direction 'c' for client to server and 's' for server to client. Every record afterwards is 0x01, the 16 bit big
+ * endian length of the rest, the ciphertext and the tag. The 3 byte header is the additional authenticated data, the
+ * IV is a 64 bit big endian counter of the records sent in that direction, padded in front with 4 zero bytes. A client
+ * with a different key fails to authenticate its first record and is disconnected.
+ *
+ * The cipher contexts live in the object with the expanded keys, so no memory is allocated per record. mbedtls uses
+ * the AES and SHA accelerators of the ESP32, the ESP8266 uses the constant time AES of BearSSL.
+ */
+class APICipher {
+ public:
+  APICipher();
+  APICipher(const APICipher &) = delete;
+  APICipher &operator=(const APICipher &) = delete;
+  ~APICipher();
+
+  /// Derive the keys of both directions from the handshake.
+  void init(const APIEncryptionKey &psk, const uint8_t *client_nonce, const uint8_t *server_nonce);
+  /// Append the records holding len bytes of data to out.
+  void encrypt(const uint8_t *data, size_t len, std::vector<uint8_t> &out);
+  /** Decrypt the record (header included) in place, its plaintext then starts at record + API_RECORD_HEADER_SIZE.
+   *
+   * @param size The size of the ciphertext and the tag.
+   * @return false if the record isn't authentic.
+   */
+  bool decrypt(uint8_t *record, size_t size);
+
+  /// The size of the records for len bytes of data.
+  static size_t encrypted_size(size_t len);
+
+ protected:
+  static void make_iv_(uint64_t counter, uint8_t *iv);
+
+#ifdef ARDUINO_ARCH_ESP32
+  mbedtls_gcm_context tx_;
+  mbedtls_gcm_context rx_;
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  br_aes_ct_ctr_keys tx_aes_;
+  br_aes_ct_ctr_keys rx_aes_;
+  br_gcm_context tx_;
+  br_gcm_context rx_;
+#endif
+  uint64_t tx_counter_{0};
+  uint64_t rx_counter_{0};
+};
+
+}  // namespace api
+}  // namespace esphome
+
+#endif  // USE_API_ENCRYPTION
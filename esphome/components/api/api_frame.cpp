@@ -0,0 +1,81 @@
+#include "api_frame.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace api {
+
+static const char *TAG = "api.frame";
+
+uint8_t encode_frame_header(uint8_t *raw, uint32_t payload_size, uint32_t message_type) {
+  const uint8_t header_size = 1 + ProtoSize::varint(payload_size) + ProtoSize::varint(message_type);
+  if (header_size > API_HEADER_PADDING)
+    return 0;
+  uint8_t *frame = raw + API_HEADER_PADDING - header_size;
+  uint8_t i = 0;
+  frame[i++] = 0x00;
+  i += ProtoVarInt(payload_size).encode_to_buffer_unchecked(frame + i);
+  ProtoVarInt(message_type).encode_to_buffer_unchecked(frame + i);
+  return header_size;
+}
+
+void APIRecvRing::init(size_t capacity) {
+  // a power of two, so that the positions stay continuous when the counters wrap around
+  size_t size = 1;
+  while (size < capacity)
+    size <<= 1;
+  capacity = size;
+  this->data_.reset(new uint8_t[capacity]);  // NOLINT(cppcoreguidelines-owning-memory)
+  this->capacity_ = capacity;
+  this->head_ = 0;
+  this->tail_ = 0;
+}
+bool APIRecvRing::push(const uint8_t *data, size_t len) {
+  if (len > this->capacity_ - this->available())
+    return false;
+  const size_t start = this->head_ % this->capacity_;
+  const size_t first = std::min(len, this->capacity_ - start);
+  memcpy(this->data_.get() + start, data, first);
+  memcpy(this->data_.get(), data + first, len - first);
+  // only publish the bytes once they are written
+  this->head_ += len;
+  return true;
+}
+void APIRecvRing::copy(size_t offset, uint8_t *out, size_t len) const {
+  const size_t start = (this->tail_ + offset) % this->capacity_;
+  const size_t first = std::min(len, this->capacity_ - start);
+  memcpy(out, this->data_.get() + start, first);
+  memcpy(out + first, this->data_.get(), len - first);
+}
+uint8_t *APIRecvRing::peek(size_t offset, size_t len, std::vector<uint8_t> &scratch) {
+  const size_t start = (this->tail_ + offset) % this->capacity_;
+  if (start + len <= this->capacity_)
+    return this->data_.get() + start;
+  scratch.resize(len);
+  this->copy(offset, scratch.data(), len);
+  return scratch.data();
+}
+
+ProtoWriteBuffer APIFrameEncoder::create_buffer(uint32_t reserve_size) {
+  // the buffer is moved into the frame, every message starts with a new one
+  this->buffer_ = std::vector<uint8_t>();
+  this->buffer_.reserve(API_HEADER_PADDING + reserve_size);
+  this->buffer_.resize(API_HEADER_PADDING);
+  return {&this->buffer_};
+}
+bool APIFrameEncoder::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
+  std::vector<uint8_t> *raw = buffer.get_buffer();
+  const uint32_t payload_size = raw->size() - API_HEADER_PADDING;
+  const uint8_t header_size = encode_frame_header(raw->data(), payload_size, message_type);
+  if (header_size == 0) {
+    ESP_LOGW(TAG, "Message of type %u too large to send (%u bytes)", message_type, payload_size);
+    this->frame_ = nullptr;
+    return false;
+  }
+  this->frame_ = std::make_shared<APIFrame>(std::move(*raw), API_HEADER_PADDING - header_size);
+  return true;
+}
+
+}  // namespace api
+}  // namespace esphome
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "api_pb2_service.h"
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+/// Room in front of every message for the preamble, the message size (up to 2 MiB, 3 bytes) and type (2 bytes) varints.
+static const uint8_t API_HEADER_PADDING = 6;
+
+/** Write the frame header right in front of a payload of payload_size bytes that starts at raw + API_HEADER_PADDING.
+ *
+ * @return The size of the header, the frame starts at raw + API_HEADER_PADDING - header size. 0 if the message is
+ *   too large.
+ */
+uint8_t encode_frame_header(uint8_t *raw, uint32_t payload_size, uint32_t message_type);
+
+/** A fixed-size byte ring for the data received from a client, written by the TCP task and read by the main loop.
+ *
+ * Messages are decoded right in the ring, only the ones that wrap around its end are copied first.
+ */
+class APIRecvRing {
+ public:
+  /// Allocate the ring, the capacity is rounded up to a power of two.
+  void init(size_t capacity);
+  size_t capacity() const { return this->capacity_; }
+  /// The bytes that haven't been consumed yet.
+  size_t available() const { return this->head_ - this->tail_; }
+  /// Append data, false if it doesn't fit. Only called by the producer.
+  bool push(const uint8_t *data, size_t len);
+  uint8_t at(size_t offset) const { return this->data_[(this->tail_ + offset) % this->capacity_]; }
+  /// Copy len bytes starting at offset from the read position to out.
+  void copy(size_t offset, uint8_t *out, size_t len) const;
+  /** The len bytes at offset from the read position as one block.
+   *
+   * @return A pointer into the ring if the bytes don't wrap around, otherwise into scratch which they are copied to.
+   */
+  uint8_t *peek(size_t offset, size_t len, std::vector<uint8_t> &scratch);
+  /// Release len bytes at the read position. Only called by the consumer.
+  void consume(size_t len) { this->tail_ += len; }
+
+ protected:
+  std::unique_ptr<uint8_t[]> data_;
+  size_t capacity_{0};
+  /// Bytes written and read in total, they wrap around together.
+  volatile uint32_t head_{0};
+  volatile uint32_t tail_{0};
+};
+
+/// A message encoded once, including its header, that can be queued with any number of connections.
+class APIFrame {
+ public:
+  APIFrame(std::vector<uint8_t> &&buffer, uint8_t offset) : buffer_(std::move(buffer)), offset_(offset) {}
+
+  const uint8_t *data() const { return this->buffer_.data() + this->offset_; }
+  size_t size() const { return this->buffer_.size() - this->offset_; }
+
+ protected:
+  std::vector<uint8_t> buffer_;
+  uint8_t offset_;
+};
+
+/** Encodes messages into shared frames instead of sending them.
+ *
+ * Calling one of the send_*() methods encodes the message, take_frame() hands out the result.
+ */
+class APIFrameEncoder : public APIServerConnectionBase {
+ public:
+  /// The frame of the last message passed to a send_*() method, nullptr if it could not be encoded.
+  std::shared_ptr<APIFrame> take_frame() { return std::move(this->frame_); }
+
+ protected:
+  bool is_authenticated() override { return true; }
+  bool is_connection_setup() override { return true; }
+  void on_fatal_error() override {}
+  void on_unauthenticated_access() override {}
+  void on_no_setup_connection() override {}
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size = 0) override;
+  bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
+
+  std::vector<uint8_t> buffer_;
+  std::shared_ptr<APIFrame> frame_;
+};
+
+}  // namespace api
+}  // namespace esphome
@@ -40,6 +40,10 @@ bool APIServerConnectionBase::send_list_entities_done_response(const ListEntitie
   ESP_LOGVV(TAG, "send_list_entities_done_response: %s", msg.dump().c_str());
   return this->send_message_<ListEntitiesDoneResponse>(msg, 19);
 }
+bool APIServerConnectionBase::send_states_snapshot_response(const StatesSnapshotResponse &msg) {
+  ESP_LOGVV(TAG, "send_states_snapshot_response: %s", msg.dump().c_str());
+  return this->send_message_<StatesSnapshotResponse>(msg, 53);
+}
 #ifdef USE_BINARY_SENSOR
 bool APIServerConnectionBase::send_list_entities_binary_sensor_response(const ListEntitiesBinarySensorResponse &msg) {
   ESP_LOGVV(TAG, "send_list_entities_binary_sensor_response: %s", msg.dump().c_str());
@@ -135,6 +139,11 @@ bool APIServerConnectionBase::send_text_sensor_state_response(const TextSensorSt
 bool APIServerConnectionBase::send_subscribe_logs_response(const SubscribeLogsResponse &msg) {
   return this->send_message_<SubscribeLogsResponse>(msg, 29);
 }
+#ifdef USE_API_BINARY_LOGS
+bool APIServerConnectionBase::send_binary_log_response(const BinaryLogResponse &msg) {
+  return this->send_message_<BinaryLogResponse>(msg, 49);
+}
+#endif
 bool APIServerConnectionBase::send_homeassistant_service_response(const HomeassistantServiceResponse &msg) {
   ESP_LOGVV(TAG, "send_homeassistant_service_response: %s", msg.dump().c_str());
   return this->send_message_<HomeassistantServiceResponse>(msg, 35);
@@ -184,6 +193,31 @@ bool APIServerConnectionBase::send_climate_state_response(const ClimateStateResp
 #endif
 #ifdef USE_CLIMATE
 #endif
+#ifdef USE_HISTORY
+#endif
+#ifdef USE_HISTORY
+bool APIServerConnectionBase::send_history_response(const HistoryResponse &msg) {
+  ESP_LOGVV(TAG, "send_history_response: %s", msg.dump().c_str());
+  return this->send_message_<HistoryResponse>(msg, 51);
+}
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+bool APIServerConnectionBase::send_bluetooth_le_raw_advertisements_response(
+    const BluetoothLERawAdvertisementsResponse &msg) {
+  ESP_LOGVV(TAG, "send_bluetooth_le_raw_advertisements_response: %s", msg.dump().c_str());
+  return this->send_message_<BluetoothLERawAdvertisementsResponse>(msg, 55);
+}
+#endif
+#ifdef USE_PERSISTENT_LOG
+#endif
+#ifdef USE_PERSISTENT_LOG
+bool APIServerConnectionBase::send_stored_logs_response(const StoredLogsResponse &msg) {
+  ESP_LOGVV(TAG, "send_stored_logs_response: %s", msg.dump().c_str());
+  return this->send_message_<StoredLogsResponse>(msg, 57);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -349,6 +383,40 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       msg.decode(msg_data, msg_size);
       ESP_LOGVV(TAG, "on_climate_command_request: %s", msg.dump().c_str());
       this->on_climate_command_request(msg);
+#endif
+      break;
+    }
+    case 50: {
+#ifdef USE_HISTORY
+      HistoryRequest msg;
+      msg.decode(msg_data, msg_size);
+      ESP_LOGVV(TAG, "on_history_request: %s", msg.dump().c_str());
+      this->on_history_request(msg);
+#endif
+      break;
+    }
+    case 52: {
+      HomeAssistantCompactStateResponse msg;
+      msg.decode(msg_data, msg_size);
+      ESP_LOGVV(TAG, "on_home_assistant_compact_state_response: %s", msg.dump().c_str());
+      this->on_home_assistant_compact_state_response(msg);
+      break;
+    }
+    case 54: {
+#ifdef USE_BLUETOOTH_PROXY
+      SubscribeBluetoothLEAdvertisementsRequest msg;
+      msg.decode(msg_data, msg_size);
+      ESP_LOGVV(TAG, "on_subscribe_bluetooth_le_advertisements_request: %s", msg.dump().c_str());
+      this->on_subscribe_bluetooth_le_advertisements_request(msg);
+#endif
+      break;
+    }
+    case 56: {
+#ifdef USE_PERSISTENT_LOG
+      StoredLogsRequest msg;
+      msg.decode(msg_data, msg_size);
+      ESP_LOGVV(TAG, "on_stored_logs_request: %s", msg.dump().c_str());
+      this->on_stored_logs_request(msg);
 #endif
       break;
     }
@@ -547,6 +615,46 @@ void APIServerConnection::on_climate_command_request(const ClimateCommandRequest
   this->climate_command(msg);
 }
 #endif
+#ifdef USE_HISTORY
+void APIServerConnection::on_history_request(const HistoryRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->history(msg);
+}
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+void APIServerConnection::on_subscribe_bluetooth_le_advertisements_request(
+    const SubscribeBluetoothLEAdvertisementsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->subscribe_bluetooth_le_advertisements(msg);
+}
+#endif
+#ifdef USE_PERSISTENT_LOG
+void APIServerConnection::on_stored_logs_request(const StoredLogsRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  this->stored_logs(msg);
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -27,6 +27,7 @@ class APIServerConnectionBase : public ProtoService {
   virtual void on_list_entities_request(const ListEntitiesRequest &value){};
   bool send_list_entities_done_response(const ListEntitiesDoneResponse &msg);
   virtual void on_subscribe_states_request(const SubscribeStatesRequest &value){};
+  bool send_states_snapshot_response(const StatesSnapshotResponse &msg);
 #ifdef USE_BINARY_SENSOR
   bool send_list_entities_binary_sensor_response(const ListEntitiesBinarySensorResponse &msg);
 #endif
@@ -83,11 +84,15 @@ class APIServerConnectionBase : public ProtoService {
 #endif
   virtual void on_subscribe_logs_request(const SubscribeLogsRequest &value){};
   bool send_subscribe_logs_response(const SubscribeLogsResponse &msg);
+#ifdef USE_API_BINARY_LOGS
+  bool send_binary_log_response(const BinaryLogResponse &msg);
+#endif
   virtual void on_subscribe_homeassistant_services_request(const SubscribeHomeassistantServicesRequest &value){};
   bool send_homeassistant_service_response(const HomeassistantServiceResponse &msg);
   virtual void on_subscribe_home_assistant_states_request(const SubscribeHomeAssistantStatesRequest &value){};
   bool send_subscribe_home_assistant_state_response(const SubscribeHomeAssistantStateResponse &msg);
   virtual void on_home_assistant_state_response(const HomeAssistantStateResponse &value){};
+  virtual void on_home_assistant_compact_state_response(const HomeAssistantCompactStateResponse &value){};
   bool send_get_time_request(const GetTimeRequest &msg);
   virtual void on_get_time_request(const GetTimeRequest &value){};
   bool send_get_time_response(const GetTimeResponse &msg);
@@ -111,6 +116,25 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_CLIMATE
   virtual void on_climate_command_request(const ClimateCommandRequest &value){};
+#endif
+#ifdef USE_HISTORY
+  virtual void on_history_request(const HistoryRequest &value){};
+#endif
+#ifdef USE_HISTORY
+  bool send_history_response(const HistoryResponse &msg);
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+  virtual void on_subscribe_bluetooth_le_advertisements_request(
+      const SubscribeBluetoothLEAdvertisementsRequest &value){};
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+  bool send_bluetooth_le_raw_advertisements_response(const BluetoothLERawAdvertisementsResponse &msg);
+#endif
+#ifdef USE_PERSISTENT_LOG
+  virtual void on_stored_logs_request(const StoredLogsRequest &value){};
+#endif
+#ifdef USE_PERSISTENT_LOG
+  bool send_stored_logs_response(const StoredLogsResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -147,6 +171,15 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_CLIMATE
   virtual void climate_command(const ClimateCommandRequest &msg) = 0;
+#endif
+#ifdef USE_HISTORY
+  virtual void history(const HistoryRequest &msg) = 0;
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+  virtual void subscribe_bluetooth_le_advertisements(const SubscribeBluetoothLEAdvertisementsRequest &msg) = 0;
+#endif
+#ifdef USE_PERSISTENT_LOG
+  virtual void stored_logs(const StoredLogsRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -179,6 +212,15 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_CLIMATE
   void on_climate_command_request(const ClimateCommandRequest &msg) override;
 #endif
+#ifdef USE_HISTORY
+  void on_history_request(const HistoryRequest &msg) override;
+#endif
+#ifdef USE_BLUETOOTH_PROXY
+  void on_subscribe_bluetooth_le_advertisements_request(const SubscribeBluetoothLEAdvertisementsRequest &msg) override;
+#endif
+#ifdef USE_PERSISTENT_LOG
+  void on_stored_logs_request(const StoredLogsRequest &msg) override;
+#endif
 };
 
 }  // namespace api
@@ -1,8 +1,10 @@
 #include "api_server.h"
 #include "api_connection.h"
+#include "binary_log.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include "esphome/core/util.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/version.h"
 
@@ -11,6 +13,7 @@
 #endif
 
 #include <algorithm>
+#include <cstring>
 
 namespace esphome {
 namespace api {
@@ -22,7 +25,12 @@ void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Home Assistant API server...");
   this->setup_controller();
   this->server_ = AsyncServer(this->port_);
+#ifdef USE_TCP_NODELAY
+  // send every message right away instead of letting Nagle's algorithm combine small ones
+  this->server_.setNoDelay(true);
+#else
   this->server_.setNoDelay(false);
+#endif
   this->server_.begin();
   this->server_.onClient(
       [](void *s, AsyncClient *client) {
@@ -33,16 +41,36 @@ void APIServer::setup() {
         // ESP_LOGD(TAG, "New client connected from %s", client->remoteIP().toString().c_str());
         auto *a_this = (APIServer *) s;
         a_this->clients_.push_back(new APIConnection(client, a_this));
+        App.wake_loop();
       },
       this);
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
       for (auto *c : this->clients_) {
-        if (!c->remove_)
+        if (!c->remove_ && !c->is_log_binary())
           c->send_log_message(level, tag, message);
       }
     });
+#ifdef USE_API_BINARY_LOGS
+    logger::global_logger->add_raw_log_callback(
+        [this](int level, const char *tag, int line, const char *format, va_list args) {
+          bool encoded = false;
+          uint32_t format_id = 0;
+          for (auto *c : this->clients_) {
+            if (c->remove_ || !c->is_log_binary() || !c->is_log_subscribed(level))
+              continue;
+            if (!encoded) {
+              // arguments can only be consumed once, encode them for all clients together
+              this->log_args_.clear();
+              encode_log_args(this->log_args_, format, args);
+              format_id = log_format_id(format);
+              encoded = true;
+            }
+            c->send_binary_log_message(level, tag, line, format_id, this->log_args_);
+          }
+        });
+#endif
   }
 #endif
 
@@ -51,9 +79,11 @@ void APIServer::setup() {
 #ifdef USE_ESP32_CAMERA
   if (esp32_camera::global_esp32_camera != nullptr) {
     esp32_camera::global_esp32_camera->add_image_callback([this](std::shared_ptr<esp32_camera::CameraImage> image) {
-      for (auto *c : this->clients_)
-        if (!c->remove_)
-          c->send_camera_state(image);
+      App.run_in_network([this, image]() {
+        for (auto *c : this->clients_)
+          if (!c->remove_)
+            c->send_camera_state(image);
+      });
     });
   }
 #endif
@@ -73,6 +103,9 @@ void APIServer::loop() {
   // resize vector
   this->clients_.erase(new_end, this->clients_.end());
 
+#ifdef USE_SENSOR
+  this->flush_sensor_states_();
+#endif
   for (auto *client : this->clients_) {
     client->loop();
   }
@@ -91,9 +124,23 @@ void APIServer::loop() {
     }
   }
 }
+bool APIServer::is_loop_idle() {
+#ifdef USE_SENSOR
+  if (!this->pending_sensor_states_.empty())
+    return false;
+#endif
+  for (auto *client : this->clients_) {
+    if (!client->is_idle())
+      return false;
+  }
+  return true;
+}
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network_get_address().c_str(), this->port_);
+#ifdef USE_API_ENCRYPTION
+  ESP_LOGCONFIG(TAG, "  Encryption: AES-256-GCM with a pre-shared key");
+#endif
 }
 bool APIServer::uses_password() const { return !this->password_.empty(); }
 bool APIServer::check_password(const std::string &password) const {
@@ -125,94 +172,335 @@ bool APIServer::check_password(const std::string &password) const {
   return result == 0;
 }
 void APIServer::handle_disconnect(APIConnection *conn) {}
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
 void APIServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscribers_())
     return;
-  for (auto *c : this->clients_)
-    c->send_binary_sensor_state(obj, state);
+  this->frame_encoder_.send_binary_sensor_state_response(APIConnection::make_binary_sensor_state(obj, state));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
 }
 #endif
 
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
 void APIServer::on_cover_update(cover::Cover *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscribers_())
     return;
-  for (auto *c : this->clients_)
-    c->send_cover_state(obj);
+  this->frame_encoder_.send_cover_state_response(APIConnection::make_cover_state(obj));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
 }
 #endif
 
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
 void APIServer::on_fan_update(fan::FanState *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscribers_())
     return;
-  for (auto *c : this->clients_)
-    c->send_fan_state(obj);
+  this->frame_encoder_.send_fan_state_response(APIConnection::make_fan_state(obj));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
 }
 #endif
 
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
 void APIServer::on_light_update(light::LightState *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscribers_())
     return;
-  for (auto *c : this->clients_)
-    c->send_light_state(obj);
+  this->frame_encoder_.send_light_state_response(APIConnection::make_light_state(obj));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
 }
 #endif
 
 #ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
 void APIServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscribers_())
+    return;
+#ifdef USE_STATE_TRACE
+  global_state_tracer.record_current(STATE_TRACE_CONTROLLER);
+#endif
+
+  if (this->coalesce_window_ != 0) {
+    // Only the last value within the window is sent, see flush_sensor_states_()
+    for (auto &pending : this->pending_sensor_states_) {
+      if (pending.sensor == obj) {
+        pending.state = state;
+#ifdef USE_STATE_TRACE
+        pending.trace = global_state_tracer.get_current();
+#endif
+        return;
+      }
+    }
+    if (this->pending_sensor_states_.empty())
+      this->pending_sensor_states_since_ = millis();
+#ifdef USE_STATE_TRACE
+    this->pending_sensor_states_.push_back(PendingSensorState{obj, state, global_state_tracer.get_current()});
+#else
+    this->pending_sensor_states_.push_back(PendingSensorState{obj, state});
+#endif
+    return;
+  }
+
+  this->send_sensor_state_(obj, state);
+#ifdef USE_STATE_TRACE
+  global_state_tracer.record_current(STATE_TRACE_SENT);
+#endif
+}
+#endif
+void APIServer::send_sensor_state_(sensor::Sensor *obj, float state) {
+  this->frame_encoder_.send_sensor_state_response(APIConnection::make_sensor_state(obj, state));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
+}
+void APIServer::flush_sensor_states_() {
+  if (this->pending_sensor_states_.empty())
+    return;
+  if (millis() - this->pending_sensor_states_since_ < this->coalesce_window_)
     return;
-  for (auto *c : this->clients_)
-    c->send_sensor_state(obj, state);
+
+  // clients that can't take the states right away queue them
+  if (this->has_state_subscribers_(StateSubscribers::SNAPSHOT)) {
+    StatesSnapshotResponse snapshot;
+    for (size_t i = 0; i < this->pending_sensor_states_.size(); i++) {
+      auto &pending = this->pending_sensor_states_[i];
+      APIConnection::add_sensor_state(snapshot, APIConnection::make_sensor_state(pending.sensor, pending.state));
+      if (snapshot.sensor_keys.size() == API_SNAPSHOT_MAX_ENTITIES || i + 1 == this->pending_sensor_states_.size()) {
+        this->frame_encoder_.send_states_snapshot_response(snapshot);
+        this->broadcast_state_(this->frame_encoder_.take_frame(), StateSubscribers::SNAPSHOT);
+        snapshot = StatesSnapshotResponse();
+      }
+    }
+  }
+  if (this->has_state_subscribers_(StateSubscribers::SINGLE)) {
+    for (auto &pending : this->pending_sensor_states_) {
+      this->frame_encoder_.send_sensor_state_response(APIConnection::make_sensor_state(pending.sensor, pending.state));
+      this->broadcast_state_(this->frame_encoder_.take_frame(), StateSubscribers::SINGLE);
+    }
+  }
+#ifdef USE_STATE_TRACE
+  for (auto &pending : this->pending_sensor_states_)
+    global_state_tracer.record(STATE_TRACE_SENT, pending.trace);
+#endif
+  this->pending_sensor_states_.clear();
 }
 #endif
 
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
 void APIServer::on_switch_update(switch_::Switch *obj, bool state) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscribers_())
     return;
-  for (auto *c : this->clients_)
-    c->send_switch_state(obj, state);
+  this->frame_encoder_.send_switch_state_response(APIConnection::make_switch_state(obj, state));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
 }
 #endif
 
-#ifdef USE_TEXT_SENSOR
-void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, std::string state) {
-  if (obj->is_internal())
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+void APIServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
+  if (obj->is_internal() || !this->has_state_subscribers_())
     return;
-  for (auto *c : this->clients_)
-    c->send_text_sensor_state(obj, state);
+  this->frame_encoder_.send_text_sensor_state_response(APIConnection::make_text_sensor_state(obj, state));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
 }
 #endif
 
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
 void APIServer::on_climate_update(climate::Climate *obj) {
-  if (obj->is_internal())
+  if (obj->is_internal() || !this->has_state_subscribers_())
     return;
-  for (auto *c : this->clients_)
-    c->send_climate_state(obj);
+  this->frame_encoder_.send_climate_state_response(APIConnection::make_climate_state(obj));
+  this->broadcast_state_(this->frame_encoder_.take_frame());
 }
 #endif
 
+#ifdef USE_DUAL_CORE
+std::function<void()> APIServer::snapshot_state_(Application::EntityType type, Nameable *obj) {
+  if (obj->is_internal())
+    return nullptr;
+  // the message is built here in the loop task, the network task only encodes it
+  switch (type) {
+#ifdef USE_CONTROLLER_COVER
+    case Application::ENTITY_COVER: {
+      CoverStateResponse msg = APIConnection::make_cover_state(static_cast<cover::Cover *>(obj));
+      return [this, msg]() {
+        if (!this->has_state_subscribers_())
+          return;
+        this->frame_encoder_.send_cover_state_response(msg);
+        this->broadcast_state_(this->frame_encoder_.take_frame());
+      };
+    }
+#endif
+#ifdef USE_CONTROLLER_FAN
+    case Application::ENTITY_FAN: {
+      FanStateResponse msg = APIConnection::make_fan_state(static_cast<fan::FanState *>(obj));
+      return [this, msg]() {
+        if (!this->has_state_subscribers_())
+          return;
+        this->frame_encoder_.send_fan_state_response(msg);
+        this->broadcast_state_(this->frame_encoder_.take_frame());
+      };
+    }
+#endif
+#ifdef USE_CONTROLLER_LIGHT
+    case Application::ENTITY_LIGHT: {
+      LightStateResponse msg = APIConnection::make_light_state(static_cast<light::LightState *>(obj));
+      return [this, msg]() {
+        if (!this->has_state_subscribers_())
+          return;
+        this->frame_encoder_.send_light_state_response(msg);
+        this->broadcast_state_(this->frame_encoder_.take_frame());
+      };
+    }
+#endif
+#ifdef USE_CONTROLLER_CLIMATE
+    case Application::ENTITY_CLIMATE: {
+      ClimateStateResponse msg = APIConnection::make_climate_state(static_cast<climate::Climate *>(obj));
+      return [this, msg]() {
+        if (!this->has_state_subscribers_())
+          return;
+        this->frame_encoder_.send_climate_state_response(msg);
+        this->broadcast_state_(this->frame_encoder_.take_frame());
+      };
+    }
+#endif
+    default:
+      return nullptr;
+  }
+}
+#endif
+
+bool APIServer::is_state_subscriber_(APIConnection *client, StateSubscribers subscribers) {
+  if (!client->state_subscription_)
+    return false;
+  switch (subscribers) {
+    case StateSubscribers::SINGLE:
+      return !client->states_snapshot_;
+    case StateSubscribers::SNAPSHOT:
+      return client->states_snapshot_;
+    default:
+      return true;
+  }
+}
+bool APIServer::has_state_subscribers_(StateSubscribers subscribers) const {
+  for (auto *client : this->clients_) {
+    if (!client->remove_ && this->is_state_subscriber_(client, subscribers))
+      return true;
+  }
+  return false;
+}
+void APIServer::broadcast_state_(const std::shared_ptr<APIFrame> &frame, StateSubscribers subscribers) {
+  if (frame == nullptr)
+    return;
+  for (auto *client : this->clients_) {
+    if (this->is_state_subscriber_(client, subscribers))
+      client->send_frame(frame);
+  }
+}
+
 float APIServer::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
 void APIServer::set_port(uint16_t port) { this->port_ = port; }
 APIServer *global_api_server = nullptr;
 
 void APIServer::set_password(const std::string &password) { this->password_ = password; }
 void APIServer::send_homeassistant_service_call(const HomeassistantServiceResponse &call) {
+  // called by automations in the loop task
+  App.run_in_network([this, call]() {
+    for (auto *client : this->clients_) {
+      client->send_homeassistant_service_call(call);
+    }
+  });
+}
+#ifdef USE_BLUETOOTH_PROXY
+bool APIServer::has_bluetooth_le_advertisements_subscribers() const {
   for (auto *client : this->clients_) {
-    client->send_homeassistant_service_call(call);
+    if (client->is_bluetooth_le_advertisements_subscribed())
+      return true;
   }
+  return false;
 }
+void APIServer::send_bluetooth_le_advertisements(const BluetoothLERawAdvertisementsResponse &msg) {
+#ifdef USE_DUAL_CORE
+  if (App.is_network_task_running() && App.is_loop_task()) {
+    App.run_in_network([this, msg]() { this->send_bluetooth_le_advertisements(msg); });
+    return;
+  }
+#endif
+  this->frame_encoder_.send_bluetooth_le_raw_advertisements_response(msg);
+  auto frame = this->frame_encoder_.take_frame();
+  if (frame == nullptr)
+    return;
+  for (auto *client : this->clients_) {
+    if (client->is_bluetooth_le_advertisements_subscribed() && client->get_send_queue_frames() == 0)
+      client->send_frame(frame);
+  }
+}
+#endif
 APIServer::APIServer() { global_api_server = this; }
-void APIServer::subscribe_home_assistant_state(std::string entity_id, std::function<void(std::string)> f) {
-  this->state_subs_.push_back(HomeAssistantStateSubscription{
-      .entity_id = std::move(entity_id),
-      .callback = std::move(f),
-  });
+APIServer::HomeAssistantStateSubscription &APIServer::get_state_sub_(std::string entity_id) {
+  const uint32_t hash = fnv1_hash(entity_id);
+  auto it = std::lower_bound(this->state_subs_by_hash_.begin(), this->state_subs_by_hash_.end(), hash,
+                             [this](uint16_t index, uint32_t hash) { return this->state_subs_[index].hash < hash; });
+  for (auto sub = it; sub != this->state_subs_by_hash_.end() && this->state_subs_[*sub].hash == hash; sub++) {
+    if (this->state_subs_[*sub].entity_id == entity_id)
+      return this->state_subs_[*sub];
+  }
+  // new subscriptions are appended, so that the handles of the existing ones stay the same
+  this->state_subs_by_hash_.insert(it, this->state_subs_.size());
+  HomeAssistantStateSubscription sub{};
+  sub.entity_id = std::move(entity_id);
+  sub.hash = hash;
+  this->state_subs_.push_back(std::move(sub));
+  return this->state_subs_.back();
+}
+void APIServer::subscribe_home_assistant_state(std::string entity_id, std::function<void(StringRef)> f) {
+  this->get_state_sub_(std::move(entity_id)).callbacks.push_back(std::move(f));
+}
+void APIServer::subscribe_home_assistant_numeric_state(std::string entity_id, std::function<void(float)> f) {
+  this->get_state_sub_(std::move(entity_id)).numeric_callbacks.push_back(std::move(f));
+}
+void APIServer::dispatch_state_(HomeAssistantStateSubscription &sub, StringRef state) {
+  if (!sub.callbacks.empty()) {
+    // the state is a view of the receive buffer, the callbacks get a null-terminated copy
+    const std::string copy = state.str();
+    for (auto &callback : sub.callbacks)
+      callback(StringRef(copy));
+  }
+  if (sub.numeric_callbacks.empty())
+    return;
+  float value = NAN;
+  char buffer[32];
+  if (state.size() < sizeof(buffer)) {
+    memcpy(buffer, state.data(), state.size());
+    buffer[state.size()] = '\0';
+    value = parse_float(buffer, state.size()).value_or(NAN);
+  }
+  for (auto &callback : sub.numeric_callbacks)
+    callback(value);
+}
+void APIServer::on_home_assistant_state(StringRef entity_id, StringRef state) {
+  const uint32_t hash = fnv1_hash(entity_id.data(), entity_id.size());
+  auto it = std::lower_bound(this->state_subs_by_hash_.begin(), this->state_subs_by_hash_.end(), hash,
+                             [this](uint16_t index, uint32_t hash) { return this->state_subs_[index].hash < hash; });
+  for (; it != this->state_subs_by_hash_.end() && this->state_subs_[*it].hash == hash; it++) {
+    if (this->state_subs_[*it].entity_id != entity_id)
+      continue;
+    this->dispatch_state_(this->state_subs_[*it], state);
+    return;
+  }
+}
+void APIServer::on_home_assistant_state(uint32_t handle, StringRef state) {
+  if (handle == 0 || handle > this->state_subs_.size())
+    return;
+  this->dispatch_state_(this->state_subs_[handle - 1], state);
+}
+void APIServer::on_home_assistant_numeric_state(uint32_t handle, float state) {
+  if (handle == 0 || handle > this->state_subs_.size())
+    return;
+  auto &sub = this->state_subs_[handle - 1];
+  if (!sub.callbacks.empty()) {
+    // the client was told to only send numbers for entities without text subscribers, but don't rely on it
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%g", state);
+    for (auto &callback : sub.callbacks)
+      callback(StringRef(buffer));
+  }
+  for (auto &callback : sub.numeric_callbacks)
+    callback(state);
 }
 const std::vector<APIServer::HomeAssistantStateSubscription> &APIServer::get_state_subs() const {
   return this->state_subs_;
@@ -221,13 +509,26 @@ uint16_t APIServer::get_port() const { return this->port_; }
 void APIServer::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
 #ifdef USE_HOMEASSISTANT_TIME
 void APIServer::request_time() {
-  for (auto *client : this->clients_) {
-    if (!client->remove_ && client->connection_state_ == APIConnection::ConnectionState::CONNECTED)
-      client->send_time_request();
-  }
+  App.run_in_network([this]() {
+    for (auto *client : this->clients_) {
+      if (!client->remove_ && client->connection_state_ == APIConnection::ConnectionState::CONNECTED)
+        client->send_time_request();
+    }
+  });
 }
 #endif
 bool APIServer::is_connected() const { return !this->clients_.empty(); }
+bool APIServer::states_delivered() const {
+#ifdef USE_SENSOR
+  if (!this->pending_sensor_states_.empty())
+    return false;
+#endif
+  for (auto *client : this->clients_) {
+    if (client->states_delivered())
+      return true;
+  }
+  return false;
+}
 void APIServer::on_shutdown() {
   for (auto *c : this->clients_) {
     c->send_disconnect_request(DisconnectRequest());
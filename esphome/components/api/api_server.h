@@ -6,6 +6,8 @@
 #include "esphome/core/log.h"
 #include "api_pb2.h"
 #include "api_pb2_service.h"
+#include "api_frame.h"
+#include "api_crypto.h"
 #include "util.h"
 #include "list_entities.h"
 #include "subscribe_state.h"
@@ -29,36 +31,52 @@ class APIServer : public Component, public Controller {
   uint16_t get_port() const;
   float get_setup_priority() const override;
   void loop() override;
+  bool is_loop_idle() override;
+  ComponentAffinity get_affinity() const override { return COMPONENT_AFFINITY_NETWORK; }
   void dump_config() override;
   void on_shutdown() override;
   bool check_password(const std::string &password) const;
   bool uses_password() const;
   void set_port(uint16_t port);
   void set_password(const std::string &password);
+#ifdef USE_API_ENCRYPTION
+  /// The pre-shared key all connections are encrypted with, plaintext clients are disconnected.
+  void set_encryption_key(const APIEncryptionKey &key) { this->encryption_key_ = key; }
+  const APIEncryptionKey &get_encryption_key() const { return this->encryption_key_; }
+#endif
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Queue outgoing messages and send them as one TCP segment per loop iteration instead of one per message.
+  void set_coalesce_writes(bool coalesce_writes) { this->coalesce_writes_ = coalesce_writes; }
+  bool is_coalesce_writes() const { return this->coalesce_writes_; }
+  /// Hold back sensor state updates for this many ms and only send the latest value of each sensor (0 = disabled).
+  void set_coalesce_window(uint32_t coalesce_window) { this->coalesce_window_ = coalesce_window; }
+  uint32_t get_coalesce_window() const { return this->coalesce_window_; }
+  /// Send up to this many entities per loop iteration while listing entities or sending the initial states.
+  void set_entity_burst(uint8_t entity_burst) { this->entity_burst_ = entity_burst; }
+  uint8_t get_entity_burst() const { return this->entity_burst_; }
   void handle_disconnect(APIConnection *conn);
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
   void on_cover_update(cover::Cover *obj) override;
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
   void on_fan_update(fan::FanState *obj) override;
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
   void on_light_update(light::LightState *obj) override;
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
   void on_sensor_update(sensor::Sensor *obj, float state) override;
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
   void on_switch_update(switch_::Switch *obj, bool state) override;
 #endif
-#ifdef USE_TEXT_SENSOR
-  void on_text_sensor_update(text_sensor::TextSensor *obj, std::string state) override;
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+  void on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) override;
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
   void on_climate_update(climate::Climate *obj) override;
 #endif
   void send_homeassistant_service_call(const HomeassistantServiceResponse &call);
@@ -66,27 +84,109 @@ class APIServer : public Component, public Controller {
 #ifdef USE_HOMEASSISTANT_TIME
   void request_time();
 #endif
+#ifdef USE_BLUETOOTH_PROXY
+  /// Whether any client subscribed to the raw BLE advertisements.
+  bool has_bluetooth_le_advertisements_subscribers() const;
+  /** Encode a batch of advertisements once and queue it with every client that subscribed to them.
+   *
+   * Advertisements are lossy, clients that still have frames waiting to be sent skip the batch instead of having it
+   * queued, so a slow client is never disconnected for them.
+   */
+  void send_bluetooth_le_advertisements(const BluetoothLERawAdvertisementsResponse &msg);
+#endif
 
   bool is_connected() const;
+  const std::vector<APIConnection *> &get_clients() const { return this->clients_; }
+  /// Whether a client received all states, see APIConnection::states_delivered().
+  bool states_delivered() const;
 
+  /// All subscribers of one entity. Compact clients refer to it by its handle, its index in get_state_subs() + 1.
   struct HomeAssistantStateSubscription {
     std::string entity_id;
-    std::function<void(std::string)> callback;
+    uint32_t hash;
+    std::vector<std::function<void(StringRef)>> callbacks;
+    /// Subscribers that only use the state as a number, they get NAN for states that aren't one.
+    std::vector<std::function<void(float)>> numeric_callbacks;
   };
 
-  void subscribe_home_assistant_state(std::string entity_id, std::function<void(std::string)> f);
+  /// Call f with every new state of the entity. The state is only valid during the call, callbacks taking a
+  /// std::string get a copy.
+  void subscribe_home_assistant_state(std::string entity_id, std::function<void(StringRef)> f);
+  /// Call f with every new state of the entity parsed as a number. If the entity has no other subscribers, compact
+  /// clients send the state as a float, so it isn't parsed on the device.
+  void subscribe_home_assistant_numeric_state(std::string entity_id, std::function<void(float)> f);
+  /// One subscription per entity, even if several components subscribed to it, in the order they were added.
   const std::vector<HomeAssistantStateSubscription> &get_state_subs() const;
+  /** Pass a state received from Home Assistant to the subscribers of the entity.
+   *
+   * Both strings may be views of the receive buffer that aren't null-terminated, the state is only copied if the
+   * entity has text subscribers.
+   */
+  void on_home_assistant_state(StringRef entity_id, StringRef state);
+  /// Pass a state received from a compact client to the subscribers of the entity with the handle.
+  void on_home_assistant_state(uint32_t handle, StringRef state);
+  void on_home_assistant_numeric_state(uint32_t handle, float state);
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
 
  protected:
+  /// Find the subscription of the entity, adding it if there is none.
+  HomeAssistantStateSubscription &get_state_sub_(std::string entity_id);
+  void dispatch_state_(HomeAssistantStateSubscription &sub, StringRef state);
+  /// Which of the clients that subscribed to state updates a frame is for.
+  enum class StateSubscribers {
+    ALL,
+    /// Clients that get one *StateResponse per entity.
+    SINGLE,
+    /// Clients that subscribed with states_snapshot.
+    SNAPSHOT,
+  };
+  static bool is_state_subscriber_(APIConnection *client, StateSubscribers subscribers);
+  /// Whether any client subscribed to state updates.
+  bool has_state_subscribers_(StateSubscribers subscribers = StateSubscribers::ALL) const;
+  /// Queue the frame with every client that subscribed to state updates.
+  void broadcast_state_(const std::shared_ptr<APIFrame> &frame, StateSubscribers subscribers = StateSubscribers::ALL);
+#ifdef USE_DUAL_CORE
+  std::function<void()> snapshot_state_(Application::EntityType type, Nameable *obj) override;
+#endif
+#ifdef USE_SENSOR
+  void send_sensor_state_(sensor::Sensor *obj, float state);
+  void flush_sensor_states_();
+#endif
+
   AsyncServer server_{0};
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
   uint32_t last_connected_{0};
+  bool coalesce_writes_{false};
+  uint32_t coalesce_window_{0};
+  uint8_t entity_burst_{16};
   std::vector<APIConnection *> clients_;
+  /// Encodes every state update once for all clients.
+  APIFrameEncoder frame_encoder_;
+#ifdef USE_SENSOR
+  /// Sensor states held back during the coalescing window, at most one per sensor.
+  struct PendingSensorState {
+    sensor::Sensor *sensor;
+    float state;
+#ifdef USE_STATE_TRACE
+    StateTrace trace;
+#endif
+  };
+  std::vector<PendingSensorState> pending_sensor_states_;
+  uint32_t pending_sensor_states_since_{0};
+#endif
   std::string password_;
+#ifdef USE_API_ENCRYPTION
+  APIEncryptionKey encryption_key_;
+#endif
   std::vector<HomeAssistantStateSubscription> state_subs_;
+  /// The indices of state_subs_ sorted by the FNV-1 hash of the entity_id, for the lookup of incoming states.
+  std::vector<uint16_t> state_subs_by_hash_;
   std::vector<UserServiceDescriptor *> user_services_;
+#ifdef USE_API_BINARY_LOGS
+  /// Scratch buffer for the encoded arguments of a binary log message, shared by all clients.
+  std::vector<uint8_t> log_args_;
+#endif
 };
 
 extern APIServer *global_api_server;
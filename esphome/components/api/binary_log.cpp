@@ -0,0 +1,199 @@
+#include "binary_log.h"
+
+#ifdef USE_API_BINARY_LOGS
+
+#include <cstddef>
+#include <cstring>
+
+namespace esphome {
+namespace api {
+
+uint32_t log_format_id(const char *format) {
+  // FNV-1 over the raw bytes
+  uint32_t hash = 2166136261UL;
+  for (const char *p = format; *p != '\0'; p++) {
+    hash *= 16777619UL;
+    hash ^= uint8_t(*p);
+  }
+  return hash;
+}
+
+static void encode_varint(std::vector<uint8_t> &out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(uint8_t(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(uint8_t(value));
+}
+static void encode_signed(std::vector<uint8_t> &out, int64_t value) {
+  // zigzag, so that small negative numbers stay short
+  encode_varint(out, (uint64_t(value) << 1) ^ uint64_t(value >> 63));
+}
+static void encode_double(std::vector<uint8_t> &out, double value) {
+  uint64_t raw;
+  memcpy(&raw, &value, sizeof(raw));
+  for (uint8_t i = 0; i < 8; i++)
+    out.push_back(uint8_t(raw >> (i * 8)));
+}
+
+void encode_log_args(std::vector<uint8_t> &out, const char *format, va_list args) {
+  enum class Length { DEFAULT, LONG, LONG_LONG, SIZE, MAX, PTRDIFF, LONG_DOUBLE };
+
+  const char *p = format;
+  while (*p != '\0') {
+    if (*p++ != '%')
+      continue;
+    if (*p == '%') {
+      p++;
+      continue;
+    }
+
+    // flags
+    while (*p != '\0' && strchr("-+ #0", *p) != nullptr)
+      p++;
+    // width
+    if (*p == '*') {
+      encode_signed(out, va_arg(args, int));
+      p++;
+    } else {
+      while (*p >= '0' && *p <= '9')
+        p++;
+    }
+    // precision
+    if (*p == '.') {
+      p++;
+      if (*p == '*') {
+        encode_signed(out, va_arg(args, int));
+        p++;
+      } else {
+        while (*p >= '0' && *p <= '9')
+          p++;
+      }
+    }
+    // length, char and short arguments are promoted to int
+    Length length = Length::DEFAULT;
+    switch (*p) {
+      case 'h':
+        p++;
+        if (*p == 'h')
+          p++;
+        break;
+      case 'l':
+        p++;
+        length = Length::LONG;
+        if (*p == 'l') {
+          p++;
+          length = Length::LONG_LONG;
+        }
+        break;
+      case 'z':
+        p++;
+        length = Length::SIZE;
+        break;
+      case 'j':
+        p++;
+        length = Length::MAX;
+        break;
+      case 't':
+        p++;
+        length = Length::PTRDIFF;
+        break;
+      case 'L':
+        p++;
+        length = Length::LONG_DOUBLE;
+        break;
+      default:
+        break;
+    }
+
+    switch (*p) {
+      case 'd':
+      case 'i':
+        switch (length) {
+          case Length::LONG:
+            encode_signed(out, va_arg(args, long));
+            break;
+          case Length::LONG_LONG:
+            encode_signed(out, va_arg(args, long long));
+            break;
+          case Length::SIZE:
+          case Length::PTRDIFF:
+            encode_signed(out, va_arg(args, ptrdiff_t));
+            break;
+          case Length::MAX:
+            encode_signed(out, va_arg(args, intmax_t));
+            break;
+          default:
+            encode_signed(out, va_arg(args, int));
+            break;
+        }
+        break;
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+        switch (length) {
+          case Length::LONG:
+            encode_varint(out, va_arg(args, unsigned long));
+            break;
+          case Length::LONG_LONG:
+            encode_varint(out, va_arg(args, unsigned long long));
+            break;
+          case Length::SIZE:
+          case Length::PTRDIFF:
+            encode_varint(out, va_arg(args, size_t));
+            break;
+          case Length::MAX:
+            encode_varint(out, va_arg(args, uintmax_t));
+            break;
+          default:
+            encode_varint(out, va_arg(args, unsigned int));
+            break;
+        }
+        break;
+      case 'c':
+        encode_signed(out, va_arg(args, int));
+        break;
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        if (length == Length::LONG_DOUBLE) {
+          encode_double(out, double(va_arg(args, long double)));
+        } else {
+          encode_double(out, va_arg(args, double));
+        }
+        break;
+      case 's': {
+        const char *str = va_arg(args, const char *);
+        if (str == nullptr)
+          str = "(null)";
+        const size_t len = strlen(str);
+        encode_varint(out, len);
+        out.insert(out.end(), str, str + len);
+        break;
+      }
+      case 'p':
+        encode_varint(out, reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        break;
+      case 'n':
+        va_arg(args, void *);
+        break;
+      case '\0':
+        return;
+      default:
+        // unknown conversion, the client renders it literally
+        break;
+    }
+    p++;
+  }
+}
+
+}  // namespace api
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_API_BINARY_LOGS
+
+#include <cstdarg>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace api {
+
+/// The id of a log format string, must match log_format_id() in esphome/api/binary_log.py.
+uint32_t log_format_id(const char *format);
+
+/** Encode the printf arguments consumed by format as described in BinaryLogResponse.
+ *
+ * Only the conversion specifiers are interpreted, so this is a lot cheaper than formatting the line.
+ * The client parses the format string the same way to decode the arguments again.
+ */
+void encode_log_args(std::vector<uint8_t> &out, const char *format, va_list args);
+
+}  // namespace api
+}  // namespace esphome
+
+#endif
@@ -7,27 +7,27 @@
 namespace esphome {
 namespace api {
 
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
 bool ListEntitiesIterator::on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
   return this->client_->send_binary_sensor_info(binary_sensor);
 }
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
 bool ListEntitiesIterator::on_cover(cover::Cover *cover) { return this->client_->send_cover_info(cover); }
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
 bool ListEntitiesIterator::on_fan(fan::FanState *fan) { return this->client_->send_fan_info(fan); }
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
 bool ListEntitiesIterator::on_light(light::LightState *light) { return this->client_->send_light_info(light); }
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
 bool ListEntitiesIterator::on_sensor(sensor::Sensor *sensor) { return this->client_->send_sensor_info(sensor); }
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
 bool ListEntitiesIterator::on_switch(switch_::Switch *a_switch) { return this->client_->send_switch_info(a_switch); }
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
 bool ListEntitiesIterator::on_text_sensor(text_sensor::TextSensor *text_sensor) {
   return this->client_->send_text_sensor_info(text_sensor);
 }
@@ -47,7 +47,7 @@ bool ListEntitiesIterator::on_camera(esp32_camera::ESP32Camera *camera) {
 }
 #endif
 
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
 bool ListEntitiesIterator::on_climate(climate::Climate *climate) { return this->client_->send_climate_info(climate); }
 #endif
 
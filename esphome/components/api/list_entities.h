@@ -12,32 +12,32 @@ class APIConnection;
 class ListEntitiesIterator : public ComponentIterator {
  public:
   ListEntitiesIterator(APIServer *server, APIConnection *client);
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
   bool on_cover(cover::Cover *cover) override;
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
   bool on_fan(fan::FanState *fan) override;
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
   bool on_light(light::LightState *light) override;
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
   bool on_sensor(sensor::Sensor *sensor) override;
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
   bool on_switch(switch_::Switch *a_switch) override;
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
   bool on_text_sensor(text_sensor::TextSensor *text_sensor) override;
 #endif
   bool on_service(UserServiceDescriptor *service) override;
 #ifdef USE_ESP32_CAMERA
   bool on_camera(esp32_camera::ESP32Camera *camera) override;
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
   bool on_climate(climate::Climate *climate) override;
 #endif
   bool on_end() override;
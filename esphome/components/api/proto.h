@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
 namespace esphome {
 namespace api {
@@ -62,8 +63,19 @@ class ProtoVarInt {
     else
       return static_cast<int64_t>(this->value_ >> 1);
   }
+  /// Encode into a buffer of at least ProtoSize::varint() bytes, returns the number of bytes written.
+  uint8_t encode_to_buffer_unchecked(uint8_t *buffer) const {
+    uint64_t val = this->value_;
+    uint8_t i = 0;
+    while (val >= 0x80) {
+      buffer[i++] = uint8_t(val | 0x80);
+      val >>= 7;
+    }
+    buffer[i++] = uint8_t(val);
+    return i;
+  }
   void encode(std::vector<uint8_t> &out) {
-    uint32_t val = this->value_;
+    uint64_t val = this->value_;
     if (val <= 0x7F) {
       out.push_back(val);
       return;
@@ -87,6 +99,12 @@ class ProtoLengthDelimited {
  public:
   explicit ProtoLengthDelimited(const uint8_t *value, size_t length) : value_(value), length_(length) {}
   std::string as_string() const { return std::string(reinterpret_cast<const char *>(this->value_), this->length_); }
+  /** A view of the string in the receive buffer, for messages with the zero_copy option.
+   *
+   * Only valid while the message is handled and, unlike other StringRefs, not null-terminated: use data() and size()
+   * or copy it with str().
+   */
+  StringRef as_string_ref() const { return StringRef(reinterpret_cast<const char *>(this->value_), this->length_); }
   template<class C> C as_message() const {
     auto msg = C();
     msg.decode(this->value_, this->length_);
@@ -138,6 +156,7 @@ class ProtoWriteBuffer {
  public:
   ProtoWriteBuffer(std::vector<uint8_t> *buffer) : buffer_(buffer) {}
   void write(uint8_t value) { this->buffer_->push_back(value); }
+  void write(const uint8_t *data, size_t len) { this->buffer_->insert(this->buffer_->end(), data, data + len); }
   void encode_varint_raw(ProtoVarInt value) { value.encode(*this->buffer_); }
   void encode_varint_raw(uint32_t value) { this->encode_varint_raw(ProtoVarInt(value)); }
   void encode_field_raw(uint32_t field_id, uint32_t type) {
@@ -150,12 +169,13 @@ class ProtoWriteBuffer {
 
     this->encode_field_raw(field_id, 2);
     this->encode_varint_raw(len);
-    auto *data = reinterpret_cast<const uint8_t *>(string);
-    for (size_t i = 0; i < len; i++)
-      this->write(data[i]);
+    this->write(reinterpret_cast<const uint8_t *>(string), len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
+  }
+  void encode_string(uint32_t field_id, const StringRef &value, bool force = false) {
+    this->encode_string(field_id, value.data(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -183,10 +203,16 @@ class ProtoWriteBuffer {
       return;
 
     this->encode_field_raw(field_id, 5);
-    this->write((value >> 0) & 0xFF);
-    this->write((value >> 8) & 0xFF);
-    this->write((value >> 16) & 0xFF);
-    this->write((value >> 24) & 0xFF);
+    this->encode_fixed32_raw(value);
+  }
+  void encode_fixed32_raw(uint32_t value) {
+    const uint8_t data[4] = {
+        uint8_t((value >> 0) & 0xFF),
+        uint8_t((value >> 8) & 0xFF),
+        uint8_t((value >> 16) & 0xFF),
+        uint8_t((value >> 24) & 0xFF),
+    };
+    this->write(data, sizeof(data));
   }
   template<typename T> void encode_enum(uint32_t field_id, T value, bool force = false) {
     this->encode_uint32(field_id, static_cast<uint32_t>(value), force);
@@ -200,7 +226,7 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, force);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -221,17 +247,60 @@ class ProtoWriteBuffer {
       uvalue = value << 1;
     this->encode_uint32(field_id, uvalue, force);
   }
+  /// Packed repeated fields: one tag and length for all values instead of a tag per value.
+  void encode_packed_fixed32(uint32_t field_id, const std::vector<uint32_t> &values) {
+    if (values.empty())
+      return;
+    this->encode_field_raw(field_id, 2);
+    this->encode_varint_raw(values.size() * 4);
+    for (uint32_t value : values)
+      this->encode_fixed32_raw(value);
+  }
+  void encode_packed_float(uint32_t field_id, const std::vector<float> &values) {
+    if (values.empty())
+      return;
+    this->encode_field_raw(field_id, 2);
+    this->encode_varint_raw(values.size() * 4);
+    for (float value : values) {
+      union {
+        float value;
+        uint32_t raw;
+      } val{};
+      val.value = value;
+      this->encode_fixed32_raw(val.raw);
+    }
+  }
+  void encode_packed_bool(uint32_t field_id, const std::vector<bool> &values) {
+    if (values.empty())
+      return;
+    this->encode_field_raw(field_id, 2);
+    this->encode_varint_raw(values.size());
+    for (bool value : values)
+      this->write(value ? 0x01 : 0x00);
+  }
+  template<typename T> void encode_packed_enum(uint32_t field_id, const std::vector<T> &values) {
+    if (values.empty())
+      return;
+    uint32_t len = 0;
+    for (T value : values) {
+      auto raw = static_cast<uint32_t>(value);
+      do {
+        len++;
+        raw >>= 7;
+      } while (raw != 0);
+    }
+    this->encode_field_raw(field_id, 2);
+    this->encode_varint_raw(len);
+    for (T value : values)
+      this->encode_varint_raw(static_cast<uint32_t>(value));
+  }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // the nested length is known up front, so the message can be encoded in place
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -239,9 +308,121 @@ class ProtoWriteBuffer {
   std::vector<uint8_t> *buffer_;
 };
 
+/** Helpers to calculate the exact encoded size of a message, mirroring the encode_* methods of ProtoWriteBuffer.
+ *
+ * The generated calculate_size() of every message uses these so that the encoder can reserve the
+ * buffer once and write the length of nested messages before their content.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint32_t value) {
+    if (value < (1UL << 7))
+      return 1;
+    if (value < (1UL << 14))
+      return 2;
+    if (value < (1UL << 21))
+      return 3;
+    if (value < (1UL << 28))
+      return 4;
+    return 5;
+  }
+  static uint32_t varint(uint64_t value) {
+    uint32_t size = 1;
+    while (value >= 0x80) {
+      value >>= 7;
+      size++;
+    }
+    return size;
+  }
+  static uint32_t field(uint32_t field_id, uint32_t type) { return varint((field_id << 3) | (type & 0b111)); }
+
+  static void add_string_field(uint32_t &total_size, uint32_t field_id, size_t len, bool force = false) {
+    if (len == 0 && !force)
+      return;
+    total_size += field(field_id, 2) + varint(uint32_t(len)) + len;
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id, const std::string &value, bool force = false) {
+    add_string_field(total_size, field_id, value.size(), force);
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id, const StringRef &value, bool force = false) {
+    add_string_field(total_size, field_id, value.size(), force);
+  }
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field(field_id, 0) + 1;
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  template<typename T>
+  static void add_enum_field(uint32_t &total_size, uint32_t field_id, T value, bool force = false) {
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_packed_fixed32_field(uint32_t &total_size, uint32_t field_id, const std::vector<uint32_t> &values) {
+    add_string_field(total_size, field_id, values.size() * 4);
+  }
+  static void add_packed_float_field(uint32_t &total_size, uint32_t field_id, const std::vector<float> &values) {
+    add_string_field(total_size, field_id, values.size() * 4);
+  }
+  static void add_packed_bool_field(uint32_t &total_size, uint32_t field_id, const std::vector<bool> &values) {
+    add_string_field(total_size, field_id, values.size());
+  }
+  template<typename T>
+  static void add_packed_enum_field(uint32_t &total_size, uint32_t field_id, const std::vector<T> &values) {
+    uint32_t len = 0;
+    for (T value : values)
+      len += varint(static_cast<uint32_t>(value));
+    add_string_field(total_size, field_id, len);
+  }
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    if (value < 0) {
+      add_int64_field(total_size, field_id, value, force);
+      return;
+    }
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    uint32_t uvalue;
+    if (value < 0)
+      uvalue = ~(value << 1);
+    else
+      uvalue = value << 1;
+    add_uint32_field(total_size, field_id, uvalue, force);
+  }
+  template<class C>
+  static void add_message_field(uint32_t &total_size, uint32_t field_id, const C &value, bool force = false) {
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    total_size += field(field_id, 2) + varint(nested_length) + nested_length;
+  }
+};
+
 class ProtoMessage {
  public:
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the encoded size of this message to total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
   std::string dump() const;
   virtual void dump_to(std::string &out) const = 0;
@@ -263,12 +444,14 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size = 0) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -5,37 +5,174 @@
 namespace esphome {
 namespace api {
 
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_DUAL_CORE
+void InitialStates::capture() {
+#ifdef USE_CONTROLLER_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors())
+    this->binary_sensors.push_back(obj->is_internal() ? BinarySensorStateResponse()
+                                                      : APIConnection::make_binary_sensor_state(obj, obj->state));
+#endif
+#ifdef USE_CONTROLLER_COVER
+  for (auto *obj : App.get_covers())
+    this->covers.push_back(obj->is_internal() ? CoverStateResponse() : APIConnection::make_cover_state(obj));
+#endif
+#ifdef USE_CONTROLLER_FAN
+  for (auto *obj : App.get_fans())
+    this->fans.push_back(obj->is_internal() ? FanStateResponse() : APIConnection::make_fan_state(obj));
+#endif
+#ifdef USE_CONTROLLER_LIGHT
+  for (auto *obj : App.get_lights())
+    this->lights.push_back(obj->is_internal() ? LightStateResponse() : APIConnection::make_light_state(obj));
+#endif
+#ifdef USE_CONTROLLER_SENSOR
+  for (auto *obj : App.get_sensors())
+    this->sensors.push_back(obj->is_internal() ? SensorStateResponse()
+                                               : APIConnection::make_sensor_state(obj, obj->state));
+#endif
+#ifdef USE_CONTROLLER_SWITCH
+  for (auto *obj : App.get_switches())
+    this->switches.push_back(obj->is_internal() ? SwitchStateResponse()
+                                                : APIConnection::make_switch_state(obj, obj->state));
+#endif
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+  for (auto *obj : App.get_text_sensors())
+    this->text_sensors.push_back(obj->is_internal() ? TextSensorStateResponse()
+                                                    : APIConnection::make_text_sensor_state(obj, obj->state));
+#endif
+#ifdef USE_CONTROLLER_CLIMATE
+  for (auto *obj : App.get_climates())
+    this->climates.push_back(obj->is_internal() ? ClimateStateResponse() : APIConnection::make_climate_state(obj));
+#endif
+  this->ready.store(true, std::memory_order_release);
+}
+
+void InitialStateIterator::begin(std::shared_ptr<InitialStates> states) {
+  this->states_ = std::move(states);
+  ComponentIterator::begin();
+}
+#endif
+
+bool InitialStateIterator::on_begin() {
+  this->snapshot_ = StatesSnapshotResponse();
+  this->snapshot_entities_ = 0;
+  return true;
+}
+bool InitialStateIterator::add_to_snapshot_() {
+  if (this->snapshot_entities_ == API_SNAPSHOT_MAX_ENTITIES) {
+    if (!this->client_->send_states_snapshot_response(this->snapshot_))
+      return false;
+    this->on_begin();
+  }
+  this->snapshot_entities_++;
+  return true;
+}
+bool InitialStateIterator::on_end() {
+  if (this->snapshot_entities_ != 0) {
+    if (!this->client_->send_states_snapshot_response(this->snapshot_))
+      return false;
+    this->on_begin();
+  }
+#ifdef USE_DUAL_CORE
+  this->states_ = nullptr;
+#endif
+  return true;
+}
+// With dual_core the states come from the capture of the loop task, at_ is the index of the entity in App.
+#ifdef USE_CONTROLLER_BINARY_SENSOR
 bool InitialStateIterator::on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
-  return this->client_->send_binary_sensor_state(binary_sensor, binary_sensor->state);
+#ifdef USE_DUAL_CORE
+  const BinarySensorStateResponse &state = this->states_->binary_sensors[this->at_];
+#else
+  const BinarySensorStateResponse state = APIConnection::make_binary_sensor_state(binary_sensor, binary_sensor->state);
+#endif
+  if (!this->client_->is_states_snapshot())
+    return this->client_->send_binary_sensor_state_response(state);
+  if (!this->add_to_snapshot_())
+    return false;
+  APIConnection::add_binary_sensor_state(this->snapshot_, state);
+  return true;
 }
 #endif
-#ifdef USE_COVER
-bool InitialStateIterator::on_cover(cover::Cover *cover) { return this->client_->send_cover_state(cover); }
+#ifdef USE_CONTROLLER_COVER
+bool InitialStateIterator::on_cover(cover::Cover *cover) {
+#ifdef USE_DUAL_CORE
+  const CoverStateResponse &state = this->states_->covers[this->at_];
+#else
+  const CoverStateResponse state = APIConnection::make_cover_state(cover);
+#endif
+  if (!this->client_->is_states_snapshot())
+    return this->client_->send_cover_state_response(state);
+  if (!this->add_to_snapshot_())
+    return false;
+  APIConnection::add_cover_state(this->snapshot_, state);
+  return true;
+}
+#endif
+#ifdef USE_CONTROLLER_FAN
+bool InitialStateIterator::on_fan(fan::FanState *fan) {
+#ifdef USE_DUAL_CORE
+  return this->client_->send_fan_state_response(this->states_->fans[this->at_]);
+#else
+  return this->client_->send_fan_state(fan);
+#endif
+}
 #endif
-#ifdef USE_FAN
-bool InitialStateIterator::on_fan(fan::FanState *fan) { return this->client_->send_fan_state(fan); }
+#ifdef USE_CONTROLLER_LIGHT
+bool InitialStateIterator::on_light(light::LightState *light) {
+#ifdef USE_DUAL_CORE
+  return this->client_->send_light_state_response(this->states_->lights[this->at_]);
+#else
+  return this->client_->send_light_state(light);
 #endif
-#ifdef USE_LIGHT
-bool InitialStateIterator::on_light(light::LightState *light) { return this->client_->send_light_state(light); }
+}
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
 bool InitialStateIterator::on_sensor(sensor::Sensor *sensor) {
-  return this->client_->send_sensor_state(sensor, sensor->state);
+#ifdef USE_DUAL_CORE
+  const SensorStateResponse &state = this->states_->sensors[this->at_];
+#else
+  const SensorStateResponse state = APIConnection::make_sensor_state(sensor, sensor->state);
+#endif
+  if (!this->client_->is_states_snapshot())
+    return this->client_->send_sensor_state_response(state);
+  if (!this->add_to_snapshot_())
+    return false;
+  APIConnection::add_sensor_state(this->snapshot_, state);
+  return true;
 }
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
 bool InitialStateIterator::on_switch(switch_::Switch *a_switch) {
-  return this->client_->send_switch_state(a_switch, a_switch->state);
+#ifdef USE_DUAL_CORE
+  const SwitchStateResponse &state = this->states_->switches[this->at_];
+#else
+  const SwitchStateResponse state = APIConnection::make_switch_state(a_switch, a_switch->state);
+#endif
+  if (!this->client_->is_states_snapshot())
+    return this->client_->send_switch_state_response(state);
+  if (!this->add_to_snapshot_())
+    return false;
+  APIConnection::add_switch_state(this->snapshot_, state);
+  return true;
 }
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
 bool InitialStateIterator::on_text_sensor(text_sensor::TextSensor *text_sensor) {
+#ifdef USE_DUAL_CORE
+  return this->client_->send_text_sensor_state_response(this->states_->text_sensors[this->at_]);
+#else
   return this->client_->send_text_sensor_state(text_sensor, text_sensor->state);
+#endif
 }
 #endif
-#ifdef USE_CLIMATE
-bool InitialStateIterator::on_climate(climate::Climate *climate) { return this->client_->send_climate_state(climate); }
+#ifdef USE_CONTROLLER_CLIMATE
+bool InitialStateIterator::on_climate(climate::Climate *climate) {
+#ifdef USE_DUAL_CORE
+  return this->client_->send_climate_state_response(this->states_->climates[this->at_]);
+#else
+  return this->client_->send_climate_state(climate);
+#endif
+}
 #endif
 InitialStateIterator::InitialStateIterator(APIServer *server, APIConnection *client)
     : ComponentIterator(server), client_(client) {}
@@ -3,42 +3,105 @@
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/defines.h"
+#include "api_pb2.h"
 #include "util.h"
+#ifdef USE_DUAL_CORE
+#include <atomic>
+#include <memory>
+#include <vector>
+#endif
 
 namespace esphome {
 namespace api {
 
 class APIConnection;
 
+/// Entities per StatesSnapshotResponse, so that a snapshot always fits into the TCP send buffer.
+static const uint8_t API_SNAPSHOT_MAX_ENTITIES = 64;
+
+#ifdef USE_DUAL_CORE
+/** The states of all entities, captured in the loop task for an InitialStateIterator running in the network task.
+ *
+ * The loop task keeps changing the entities (text sensor strings, light values, ...) so the network task must not
+ * read them. The states are indexed like the entities in App, internal entities get an empty message.
+ */
+struct InitialStates {
+  /// Read the states of all entities, called in the loop task. Sets ready once done.
+  void capture();
+
+  std::atomic<bool> ready{false};
+#ifdef USE_CONTROLLER_BINARY_SENSOR
+  std::vector<BinarySensorStateResponse> binary_sensors;
+#endif
+#ifdef USE_CONTROLLER_COVER
+  std::vector<CoverStateResponse> covers;
+#endif
+#ifdef USE_CONTROLLER_FAN
+  std::vector<FanStateResponse> fans;
+#endif
+#ifdef USE_CONTROLLER_LIGHT
+  std::vector<LightStateResponse> lights;
+#endif
+#ifdef USE_CONTROLLER_SENSOR
+  std::vector<SensorStateResponse> sensors;
+#endif
+#ifdef USE_CONTROLLER_SWITCH
+  std::vector<SwitchStateResponse> switches;
+#endif
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+  std::vector<TextSensorStateResponse> text_sensors;
+#endif
+#ifdef USE_CONTROLLER_CLIMATE
+  std::vector<ClimateStateResponse> climates;
+#endif
+};
+#endif
+
 class InitialStateIterator : public ComponentIterator {
  public:
   InitialStateIterator(APIServer *server, APIConnection *client);
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_DUAL_CORE
+  /// Start a pass over the states captured by the loop task.
+  void begin(std::shared_ptr<InitialStates> states);
+#endif
+  bool on_begin() override;
+#ifdef USE_CONTROLLER_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
   bool on_cover(cover::Cover *cover) override;
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
   bool on_fan(fan::FanState *fan) override;
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
   bool on_light(light::LightState *light) override;
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
   bool on_sensor(sensor::Sensor *sensor) override;
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
   bool on_switch(switch_::Switch *a_switch) override;
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
   bool on_text_sensor(text_sensor::TextSensor *text_sensor) override;
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
   bool on_climate(climate::Climate *climate) override;
 #endif
+  bool on_end() override;
+
  protected:
+  /// Make room for one more entity in the snapshot, sending it if it is full. False if that failed.
+  bool add_to_snapshot_();
+
   APIConnection *client_;
+  /// The states collected for clients that subscribed with states_snapshot.
+  StatesSnapshotResponse snapshot_;
+  uint8_t snapshot_entities_{0};
+#ifdef USE_DUAL_CORE
+  std::shared_ptr<InitialStates> states_;
+#endif
 };
 
 }  // namespace api
@@ -11,7 +11,9 @@ template<> int get_execute_arg_value<int>(const ExecuteServiceArgument &arg) {
   return arg.int_;
 }
 template<> float get_execute_arg_value<float>(const ExecuteServiceArgument &arg) { return arg.float_; }
-template<> std::string get_execute_arg_value<std::string>(const ExecuteServiceArgument &arg) { return arg.string_; }
+template<> std::string get_execute_arg_value<std::string>(const ExecuteServiceArgument &arg) {
+  return arg.string_.str();
+}
 template<> std::vector<bool> get_execute_arg_value<std::vector<bool>>(const ExecuteServiceArgument &arg) {
   return arg.bool_array;
 }
@@ -22,7 +24,7 @@ template<> std::vector<float> get_execute_arg_value<std::vector<float>>(const Ex
   return arg.float_array;
 }
 template<> std::vector<std::string> get_execute_arg_value<std::vector<std::string>>(const ExecuteServiceArgument &arg) {
-  return arg.string_array;
+  return std::vector<std::string>(arg.string_array.begin(), arg.string_array.end());
 }
 
 template<> enums::ServiceArgType to_service_arg_type<bool>() { return enums::SERVICE_ARG_TYPE_BOOL; }
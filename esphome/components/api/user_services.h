@@ -2,8 +2,11 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/application.h"
 #include "api_pb2.h"
 
+#include <tuple>
+
 namespace esphome {
 namespace api {
 
@@ -50,8 +53,10 @@ template<typename... Ts> class UserServiceBase : public UserServiceDescriptor {
 
  protected:
   virtual void execute(Ts... x) = 0;
-  template<int... S> void execute_(std::vector<ExecuteServiceArgument> args, seq<S...>) {
-    this->execute((get_execute_arg_value<Ts>(args[S]))...);
+  template<int... S> void execute_(const std::vector<ExecuteServiceArgument> &args, seq<S...>) {
+    // convert here, string arguments point into the received message
+    auto values = std::make_tuple(get_execute_arg_value<Ts>(args[S])...);
+    App.run_in_loop([this, values]() { this->execute(std::get<S>(values)...); });
   }
 
   std::string name_;
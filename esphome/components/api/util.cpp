@@ -12,21 +12,21 @@ void ComponentIterator::begin() {
   this->state_ = IteratorState::BEGIN;
   this->at_ = 0;
 }
-void ComponentIterator::advance() {
+bool ComponentIterator::advance() {
   bool advance_platform = false;
   bool success = true;
   switch (this->state_) {
     case IteratorState::NONE:
       // not started
-      return;
+      return false;
     case IteratorState::BEGIN:
       if (this->on_begin()) {
         advance_platform = true;
       } else {
-        return;
+        return false;
       }
       break;
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
     case IteratorState::BINARY_SENSOR:
       if (this->at_ >= App.get_binary_sensors().size()) {
         advance_platform = true;
@@ -41,7 +41,7 @@ void ComponentIterator::advance() {
       }
       break;
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
     case IteratorState::COVER:
       if (this->at_ >= App.get_covers().size()) {
         advance_platform = true;
@@ -56,7 +56,7 @@ void ComponentIterator::advance() {
       }
       break;
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
     case IteratorState::FAN:
       if (this->at_ >= App.get_fans().size()) {
         advance_platform = true;
@@ -71,7 +71,7 @@ void ComponentIterator::advance() {
       }
       break;
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
     case IteratorState::LIGHT:
       if (this->at_ >= App.get_lights().size()) {
         advance_platform = true;
@@ -86,7 +86,7 @@ void ComponentIterator::advance() {
       }
       break;
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
     case IteratorState::SENSOR:
       if (this->at_ >= App.get_sensors().size()) {
         advance_platform = true;
@@ -101,7 +101,7 @@ void ComponentIterator::advance() {
       }
       break;
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
     case IteratorState::SWITCH:
       if (this->at_ >= App.get_switches().size()) {
         advance_platform = true;
@@ -116,7 +116,7 @@ void ComponentIterator::advance() {
       }
       break;
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
     case IteratorState::TEXT_SENSOR:
       if (this->at_ >= App.get_text_sensors().size()) {
         advance_platform = true;
@@ -153,7 +153,7 @@ void ComponentIterator::advance() {
       }
       break;
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
     case IteratorState::CLIMATE:
       if (this->at_ >= App.get_climates().size()) {
         advance_platform = true;
@@ -169,10 +169,10 @@ void ComponentIterator::advance() {
       break;
 #endif
     case IteratorState::MAX:
-      if (this->on_end()) {
-        this->state_ = IteratorState::NONE;
-      }
-      return;
+      if (!this->on_end())
+        return false;
+      this->state_ = IteratorState::NONE;
+      return true;
   }
 
   if (advance_platform) {
@@ -181,6 +181,7 @@ void ComponentIterator::advance() {
   } else if (success) {
     this->at_++;
   }
+  return advance_platform || success;
 }
 bool ComponentIterator::on_end() { return true; }
 bool ComponentIterator::on_begin() { return true; }
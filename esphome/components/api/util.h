@@ -6,6 +6,12 @@
 #ifdef USE_ESP32_CAMERA
 #include "esphome/components/esp32_camera/esp32_camera.h"
 #endif
+#ifdef USE_HISTORY
+#include "esphome/components/history/history.h"
+#endif
+#ifdef USE_PERSISTENT_LOG
+#include "esphome/components/persistent_log/persistent_log.h"
+#endif
 
 namespace esphome {
 namespace api {
@@ -18,34 +24,38 @@ class ComponentIterator {
   ComponentIterator(APIServer *server);
 
   void begin();
-  void advance();
+  /// Handle the current entity. Returns false if it has to be tried again (the send failed) or there was nothing to
+  /// do, the position is kept so that the next call continues with the same entity.
+  bool advance();
+  /// Whether the iterator is currently in the middle of a pass over the entities.
+  bool is_running() const { return this->state_ != IteratorState::NONE; }
   virtual bool on_begin();
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
   virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
   virtual bool on_cover(cover::Cover *cover) = 0;
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
   virtual bool on_fan(fan::FanState *fan) = 0;
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
   virtual bool on_light(light::LightState *light) = 0;
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
   virtual bool on_sensor(sensor::Sensor *sensor) = 0;
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
   virtual bool on_switch(switch_::Switch *a_switch) = 0;
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
   virtual bool on_text_sensor(text_sensor::TextSensor *text_sensor) = 0;
 #endif
   virtual bool on_service(UserServiceDescriptor *service);
 #ifdef USE_ESP32_CAMERA
   virtual bool on_camera(esp32_camera::ESP32Camera *camera);
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
   virtual bool on_climate(climate::Climate *climate) = 0;
 #endif
   virtual bool on_end();
@@ -54,32 +64,32 @@ class ComponentIterator {
   enum class IteratorState {
     NONE = 0,
     BEGIN,
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
     BINARY_SENSOR,
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
     COVER,
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
     FAN,
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
     LIGHT,
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
     SENSOR,
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
     SWITCH,
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
     TEXT_SENSOR,
 #endif
     SERVICE,
 #ifdef USE_ESP32_CAMERA
     CAMERA,
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
     CLIMATE,
 #endif
     MAX,
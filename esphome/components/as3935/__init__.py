@@ -3,7 +3,7 @@ import esphome.config_validation as cv
 from esphome import pins
 from esphome.const import CONF_INDOOR, CONF_WATCHDOG_THRESHOLD, \
     CONF_NOISE_LEVEL, CONF_SPIKE_REJECTION, CONF_LIGHTNING_THRESHOLD, \
-    CONF_MASK_DISTURBER, CONF_DIV_RATIO, CONF_CAPACITANCE
+    CONF_MASK_DISTURBER, CONF_DIV_RATIO, CONF_CAPACITANCE, CONF_IRQ_PIN
 from esphome.core import coroutine
 
 AUTO_LOAD = ['sensor', 'binary_sensor']
@@ -14,7 +14,6 @@ CONF_AS3935_ID = 'as3935_id'
 as3935_ns = cg.esphome_ns.namespace('as3935')
 AS3935 = as3935_ns.class_('AS3935Component', cg.Component)
 
-CONF_IRQ_PIN = 'irq_pin'
 AS3935_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(AS3935),
     cv.Required(CONF_IRQ_PIN): pins.gpio_input_pin_schema,
@@ -0,0 +1,7 @@
+import esphome.codegen as cg
+
+CODEOWNERS = ['@esphome/core']
+DEPENDENCIES = ['uart']
+
+at_command_ns = cg.esphome_ns.namespace('at_command')
+ATDevice = at_command_ns.class_('ATDevice')
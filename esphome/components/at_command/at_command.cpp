@@ -0,0 +1,168 @@
+#include "at_command.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace at_command {
+
+static const char *TAG = "at_command";
+
+static const uint8_t ASCII_CTRL_Z = 0x1A;
+/// The prompt for a payload has no line ending, it is received once the modem has been quiet for this long.
+static const uint32_t AT_PROMPT_TIMEOUT = 50;
+
+ATLine ATLine::field(uint8_t index) const {
+  // the fields start after "+CMD: "
+  size_t pos = 0;
+  const char *colon = static_cast<const char *>(memchr(this->data, ':', this->size));
+  if (colon != nullptr)
+    pos = colon - this->data + 1;
+  while (pos < this->size && this->data[pos] == ' ')
+    pos++;
+
+  for (uint8_t i = 0; pos <= this->size; i++) {
+    // commas within quotes, like in timestamps, don't separate fields
+    bool quoted = false;
+    size_t end = pos;
+    while (end < this->size && (quoted || this->data[end] != ',')) {
+      if (this->data[end] == '"')
+        quoted = !quoted;
+      end++;
+    }
+    if (i == index) {
+      if (end - pos >= 2 && this->data[pos] == '"' && this->data[end - 1] == '"')
+        return ATLine{this->data + pos + 1, end - pos - 2};
+      return ATLine{this->data + pos, end - pos};
+    }
+    pos = end + 1;
+  }
+  return ATLine{this->data + this->size, 0};
+}
+
+int32_t ATLine::field_int(uint8_t index, int32_t default_value) const {
+  ATLine field = this->field(index);
+  size_t pos = 0;
+  bool negative = field.size > 0 && field.data[0] == '-';
+  if (negative)
+    pos++;
+  if (pos == field.size)
+    return default_value;
+  int32_t value = 0;
+  for (; pos < field.size; pos++) {
+    if (field.data[pos] < '0' || field.data[pos] > '9')
+      return default_value;
+    value = value * 10 + (field.data[pos] - '0');
+  }
+  return negative ? -value : value;
+}
+
+void ATDevice::at_setup_() {
+  this->on_frame([this](const uint8_t *data, size_t len) { this->on_frame_(data, len); }, AT_PROMPT_TIMEOUT, '\n');
+}
+
+void ATDevice::at_loop_() {
+  if (!this->sent_)
+    return;
+  ATCommand &command = this->queue_.front();
+  if (millis() - this->sent_at_ < command.timeout)
+    return;
+  ESP_LOGW(TAG, "'%s' timed out", command.command.c_str());
+  if (!command.payload.empty()) {
+    // leave the prompt, if the modem is still waiting for the payload
+    this->write_byte(ASCII_CTRL_Z);
+  }
+  this->complete_(AT_RESULT_TIMEOUT);
+}
+
+void ATDevice::send_command(ATCommand &&command) {
+  this->queue_.push(std::move(command));
+  this->send_next_();
+}
+
+void ATDevice::clear_commands() {
+  while (!this->queue_.empty())
+    this->queue_.pop();
+  this->sent_ = false;
+}
+
+void ATDevice::send_next_() {
+  if (this->sent_ || this->queue_.empty())
+    return;
+  const ATCommand &command = this->queue_.front();
+  ESP_LOGV(TAG, "S: %s", command.command.c_str());
+  this->write_str(command.command.c_str());
+  this->write_byte('\r');
+  this->sent_ = true;
+  this->payload_sent_ = false;
+  this->sent_at_ = millis();
+}
+
+void ATDevice::complete_(ATResult result) {
+  ATCommand command = std::move(this->queue_.front());
+  this->queue_.pop();
+  this->sent_ = false;
+  if (command.on_done)
+    command.on_done(result);
+  this->send_next_();
+}
+
+void ATDevice::on_frame_(const uint8_t *data, size_t len) {
+  ATLine line{reinterpret_cast<const char *>(data), len};
+  while (line.size > 0 && (line.data[line.size - 1] == '\n' || line.data[line.size - 1] == '\r'))
+    line.size--;
+  while (line.size > 0 && line.data[0] == '\r') {
+    line.data++;
+    line.size--;
+  }
+  if (line.size == 0)
+    return;
+  this->on_line_(line);
+}
+
+void ATDevice::on_line_(const ATLine &line) {
+  ESP_LOGV(TAG, "R: %.*s", int(line.size), line.data);
+
+  ATCommand *running = this->sent_ ? &this->queue_.front() : nullptr;
+  if (running != nullptr) {
+    if (line.equals("OK")) {
+      this->complete_(AT_RESULT_OK);
+      return;
+    }
+    if (line.equals("ERROR") || line.starts_with("+CME ERROR:") || line.starts_with("+CMS ERROR:")) {
+      ESP_LOGW(TAG, "'%s' failed: %.*s", running->command.c_str(), int(line.size), line.data);
+      this->complete_(AT_RESULT_ERROR);
+      return;
+    }
+    if (!running->payload.empty() && !this->payload_sent_ && line.starts_with(">")) {
+      this->write_str(running->payload.c_str());
+      this->write_byte(ASCII_CTRL_Z);
+      this->payload_sent_ = true;
+      return;
+    }
+    if (line.equals(running->command.c_str())) {
+      // echo
+      return;
+    }
+    if (running->response_prefix != nullptr && line.starts_with(running->response_prefix)) {
+      if (running->on_line)
+        running->on_line(line);
+      return;
+    }
+  }
+
+  for (auto &handler : this->urc_handlers_) {
+    if (line.starts_with(handler.first)) {
+      handler.second(line);
+      return;
+    }
+  }
+
+  if (running != nullptr) {
+    if (running->on_line)
+      running->on_line(line);
+    return;
+  }
+  ESP_LOGV(TAG, "Unhandled: %.*s", int(line.size), line.data);
+}
+
+}  // namespace at_command
+}  // namespace esphome
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include "esphome/components/uart/uart.h"
+#include <cstring>
+#include <queue>
+
+namespace esphome {
+namespace at_command {
+
+enum ATResult : uint8_t {
+  AT_RESULT_OK = 0,
+  AT_RESULT_ERROR,
+  AT_RESULT_TIMEOUT,
+};
+
+/// A line from the modem without the line ending, it points into the receive buffer and is only valid in the callback.
+struct ATLine {
+  const char *data;
+  size_t size;
+
+  bool equals(const char *str) const { return strlen(str) == this->size && memcmp(this->data, str, this->size) == 0; }
+  bool starts_with(const char *prefix) const {
+    const size_t len = strlen(prefix);
+    return len <= this->size && memcmp(this->data, prefix, len) == 0;
+  }
+  /** The field at index of a comma separated response after its prefix, without quotes.
+   *
+   * For example field 1 of `+CREG: 0,1` is `1` and field 2 of `+CMGL: 1,"REC UNREAD","+31600000000"` is the number.
+   * Returns an empty line if there is no such field.
+   */
+  ATLine field(uint8_t index) const;
+  /// The field as a number, or the default if it isn't one.
+  int32_t field_int(uint8_t index, int32_t default_value = -1) const;
+  /// Copy the line, when it needs to outlive the callback.
+  std::string str() const { return std::string(this->data, this->size); }
+};
+
+/// Called with the information response lines of a command, or with an unsolicited result code.
+using ATLineCallback = std::function<void(const ATLine &line)>;
+/// Called once the command has completed with OK or ERROR or has timed out.
+using ATDoneCallback = std::function<void(ATResult result)>;
+
+struct ATCommand {
+  std::string command;
+  /// Sent after the `>` prompt and terminated with Ctrl-Z, like the text of AT+CMGS.
+  std::string payload;
+  /// The response lines start with this, so they aren't mistaken for an unsolicited result code with the same prefix.
+  const char *response_prefix;
+  uint32_t timeout;
+  ATLineCallback on_line;
+  ATDoneCallback on_done;
+};
+
+/** A modem that is driven with AT commands over UART.
+ *
+ * Commands are queued and sent one after the other as soon as the previous one has completed, so nothing waits for an
+ * update interval. The lines of the modem are received with the frame API of the UART bus and parsed in place in its
+ * buffer: OK and ERROR complete the running command, lines with a registered prefix are unsolicited result codes that
+ * go to their handler, and all other lines belong to the running command. Each command has its own timeout.
+ *
+ * Components call at_setup_() from setup() and at_loop_() from loop().
+ */
+class ATDevice : public uart::UARTDevice {
+ public:
+  /// Queue a command, it is sent once all commands before it have completed.
+  void send_command(ATCommand &&command);
+  void send_command(const std::string &command, ATDoneCallback &&on_done = nullptr,
+                    ATLineCallback &&on_line = nullptr, const char *response_prefix = nullptr,
+                    uint32_t timeout = 1000) {
+    this->send_command(ATCommand{command, "", response_prefix, timeout, std::move(on_line), std::move(on_done)});
+  }
+  /// Call the callback with every unsolicited result code that starts with prefix, like "+CMTI:".
+  void add_urc_handler(const char *prefix, ATLineCallback &&callback) {
+    this->urc_handlers_.emplace_back(prefix, std::move(callback));
+  }
+  /// Whether no command is running or queued.
+  bool is_at_idle() const { return this->queue_.empty(); }
+  /// Drop all queued commands, without calling their callbacks.
+  void clear_commands();
+
+ protected:
+  void at_setup_();
+  void at_loop_();
+  void on_frame_(const uint8_t *data, size_t len);
+  void on_line_(const ATLine &line);
+  void send_next_();
+  void complete_(ATResult result);
+
+  /// The front command is the running one once it has been sent.
+  std::queue<ATCommand> queue_;
+  bool sent_{false};
+  bool payload_sent_{false};
+  uint32_t sent_at_{0};
+  std::vector<std::pair<const char *, ATLineCallback>> urc_handlers_;
+};
+
+}  // namespace at_command
+}  // namespace esphome
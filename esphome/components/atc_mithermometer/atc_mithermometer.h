@@ -22,6 +22,9 @@ class ATCMiThermometer : public Component, public esp32_ble_tracker::ESPBTDevice
  public:
   void set_address(uint64_t address) { address_ = address; };
 
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    filter.addresses.push_back(this->address_);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -0,0 +1,94 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import automation
+from esphome.components import display, font, light
+from esphome.const import CONF_ID
+
+CODEOWNERS = ['@esphome/core']
+AUTO_LOAD = ['sensor']
+
+CONF_BENCHMARK_ID = 'benchmark_id'
+CONF_RUN_ON_BOOT = 'run_on_boot'
+CONF_BOOT_DELAY = 'boot_delay'
+CONF_SCHEDULER_TIMEOUTS = 'scheduler_timeouts'
+CONF_SENSOR_PUBLISHES = 'sensor_publishes'
+CONF_API_MESSAGES = 'api_messages'
+CONF_DISPLAY_FRAMES = 'display_frames'
+CONF_LIGHT_FRAMES = 'light_frames'
+CONF_DISPLAY_ID = 'display_id'
+CONF_FONT_ID = 'font_id'
+CONF_LIGHT_ID = 'light_id'
+
+benchmark_ns = cg.esphome_ns.namespace('benchmark')
+BenchmarkComponent = benchmark_ns.class_('BenchmarkComponent', cg.Component)
+Workload = benchmark_ns.enum('Workload')
+RunAction = benchmark_ns.class_('RunAction', automation.Action)
+IsRunningCondition = benchmark_ns.class_('IsRunningCondition', automation.Condition)
+
+# The option with the number of operations of each workload, in the order they run
+WORKLOADS = {
+    CONF_SCHEDULER_TIMEOUTS: Workload.WORKLOAD_SCHEDULER,
+    CONF_SENSOR_PUBLISHES: Workload.WORKLOAD_SENSOR,
+    CONF_API_MESSAGES: Workload.WORKLOAD_API,
+    CONF_DISPLAY_FRAMES: Workload.WORKLOAD_DISPLAY,
+    CONF_LIGHT_FRAMES: Workload.WORKLOAD_LIGHT,
+}
+# Every operation keeps a latency sample until the workload is done
+MAX_OPERATIONS = 5000
+
+validate_operations = cv.int_range(min=0, max=MAX_OPERATIONS)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(BenchmarkComponent),
+    cv.Optional(CONF_RUN_ON_BOOT, default=True): cv.boolean,
+    cv.Optional(CONF_BOOT_DELAY, default='30s'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_SCHEDULER_TIMEOUTS, default=1000): validate_operations,
+    cv.Optional(CONF_SENSOR_PUBLISHES, default=1000): validate_operations,
+    cv.Optional(CONF_API_MESSAGES, default=1000): validate_operations,
+    cv.Optional(CONF_DISPLAY_FRAMES, default=20): validate_operations,
+    cv.Optional(CONF_LIGHT_FRAMES, default=100): validate_operations,
+    cv.Optional(CONF_DISPLAY_ID): cv.use_id(display.DisplayBuffer),
+    cv.Optional(CONF_FONT_ID): cv.use_id(font.Font),
+    cv.Optional(CONF_LIGHT_ID): cv.use_id(light.AddressableLightState),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    if config[CONF_RUN_ON_BOOT]:
+        cg.add(var.set_boot_delay(config[CONF_BOOT_DELAY]))
+    for key, workload in WORKLOADS.items():
+        cg.add(var.set_operations(workload, config[key]))
+
+    if CONF_DISPLAY_ID in config:
+        cg.add_define('USE_BENCHMARK_DISPLAY')
+        disp = yield cg.get_variable(config[CONF_DISPLAY_ID])
+        cg.add(var.set_display(disp))
+        if CONF_FONT_ID in config:
+            font = yield cg.get_variable(config[CONF_FONT_ID])
+            cg.add(var.set_font(font))
+    if CONF_LIGHT_ID in config:
+        cg.add_define('USE_BENCHMARK_LIGHT')
+        light_ = yield cg.get_variable(config[CONF_LIGHT_ID])
+        cg.add(var.set_light(light_))
+
+
+BENCHMARK_ACTION_SCHEMA = automation.maybe_simple_id({
+    cv.GenerateID(): cv.use_id(BenchmarkComponent),
+})
+
+
+@automation.register_action('benchmark.run', RunAction, BENCHMARK_ACTION_SCHEMA)
+def benchmark_run_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    yield cg.register_parented(var, config[CONF_ID])
+    yield var
+
+
+@automation.register_condition('benchmark.is_running', IsRunningCondition, BENCHMARK_ACTION_SCHEMA)
+def benchmark_is_running_to_code(config, condition_id, template_arg, args):
+    var = cg.new_Pvariable(condition_id, template_arg)
+    yield cg.register_parented(var, config[CONF_ID])
+    yield var
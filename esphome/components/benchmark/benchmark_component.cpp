@@ -0,0 +1,235 @@
+#include "benchmark_component.h"
+#include "esphome/core/log.h"
+#include "esphome/core/application.h"
+#include <algorithm>
+
+#ifdef USE_API
+#include "esphome/components/api/api_pb2.h"
+#endif
+
+namespace esphome {
+namespace benchmark {
+
+static const char *TAG = "benchmark";
+
+static const char *const WORKLOAD_NAMES[WORKLOAD_COUNT] = {"Scheduler", "Sensor", "API", "Display", "Light"};
+
+void BenchmarkComponent::setup() {
+  if (this->boot_delay_.has_value())
+    this->set_timeout("boot", *this->boot_delay_, [this]() { this->run(); });
+}
+
+void BenchmarkComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Benchmark:");
+  if (this->boot_delay_.has_value())
+    ESP_LOGCONFIG(TAG, "  Runs %u ms after boot", *this->boot_delay_);
+  for (uint8_t i = 0; i < WORKLOAD_COUNT; i++) {
+    if (this->operations_[i] != 0)
+      ESP_LOGCONFIG(TAG, "  %s: %u operations", WORKLOAD_NAMES[i], this->operations_[i]);
+  }
+}
+
+float BenchmarkComponent::get_setup_priority() const { return setup_priority::LATE; }
+
+void BenchmarkComponent::run() {
+  if (this->is_running()) {
+    ESP_LOGW(TAG, "A benchmark is already running!");
+    return;
+  }
+  ESP_LOGI(TAG, "Starting benchmark, the main loop is blocked while the workloads run...");
+  this->current_ = WORKLOAD_SCHEDULER;
+  this->start_next_();
+}
+
+void BenchmarkComponent::loop() {
+  if (this->current_ != WORKLOAD_SCHEDULER || this->scheduler_fired_ != this->operations_[WORKLOAD_SCHEDULER])
+    return;
+  this->report_(WORKLOAD_SCHEDULER, this->scheduler_last_us_ - this->start_us_);
+  this->current_ = WORKLOAD_SENSOR;
+  this->start_next_();
+}
+
+void BenchmarkComponent::start_next_() {
+  for (; this->current_ != WORKLOAD_COUNT; this->current_ = Workload(this->current_ + 1)) {
+    const uint32_t operations = this->operations_[this->current_];
+    if (operations == 0)
+      continue;
+    this->samples_.clear();
+    this->samples_.reserve(operations);
+
+    if (this->current_ == WORKLOAD_SCHEDULER) {
+      // all timeouts are due right away, the latency is how long the loop takes to get to each of them
+      this->scheduler_fired_ = 0;
+      this->start_us_ = micros();
+      for (uint32_t i = 0; i < operations; i++) {
+        const uint32_t scheduled_us = micros();
+        this->set_timeout("", 0, [this, scheduled_us]() {
+          this->scheduler_last_us_ = micros();
+          this->samples_.push_back(this->scheduler_last_us_ - scheduled_us);
+          this->scheduler_fired_++;
+        });
+      }
+      // continued in loop() once all of them ran
+      return;
+    }
+
+    this->start_us_ = micros();
+    if (this->run_workload_(this->current_))
+      this->report_(this->current_, micros() - this->start_us_);
+  }
+  this->samples_.clear();
+  this->samples_.shrink_to_fit();
+  ESP_LOGI(TAG, "Benchmark finished");
+}
+
+bool BenchmarkComponent::run_workload_(Workload workload) {
+  switch (workload) {
+    case WORKLOAD_SENSOR:
+      this->run_sensor_();
+      return true;
+#ifdef USE_API
+    case WORKLOAD_API:
+      this->run_api_();
+      return true;
+#endif
+#ifdef USE_BENCHMARK_DISPLAY
+    case WORKLOAD_DISPLAY:
+      if (this->display_ == nullptr)
+        return false;
+      this->run_display_();
+      return true;
+#endif
+#ifdef USE_BENCHMARK_LIGHT
+    case WORKLOAD_LIGHT:
+      if (this->light_ == nullptr)
+        return false;
+      this->run_light_();
+      return true;
+#endif
+    default:
+      ESP_LOGW(TAG, "%s workload isn't available in this build, skipping it", WORKLOAD_NAMES[workload]);
+      return false;
+  }
+}
+
+void BenchmarkComponent::run_sensor_() {
+  // a typical chain: calibrate, drop outliers, average and only pass on changes
+  sensor::Sensor sens;
+  sens.set_internal(true);
+  sensor::CalibrateLinearFilter calibrate(1.02f, -0.5f);
+  sensor::FilterOutValueFilter filter_out(0.0f);
+  sensor::SlidingWindowMovingAverageFilter average(5, 1, 1);
+  sensor::DeltaFilter delta(0.05f);
+  sens.add_filters({&calibrate, &filter_out, &average, &delta});
+
+  for (uint32_t i = 0; i < this->operations_[WORKLOAD_SENSOR]; i++) {
+    const float value = 20.0f + (i % 64) * 0.1f;
+    const uint32_t start = micros();
+    sens.publish_state(value);
+    this->samples_.push_back(micros() - start);
+    App.feed_wdt();
+  }
+  // the filters are destroyed with this scope
+  sens.clear_filters();
+}
+
+#ifdef USE_API
+void BenchmarkComponent::run_api_() {
+  // encode a state message with its frame header like a connection sends it, then parse it back like the client
+  static const uint32_t SENSOR_STATE_RESPONSE = 25;
+  std::vector<uint8_t> payload;
+  std::vector<uint8_t> frame;
+  payload.reserve(32);
+  frame.reserve(32);
+  api::SensorStateResponse msg;
+  msg.key = 0x12345678;
+
+  for (uint32_t i = 0; i < this->operations_[WORKLOAD_API]; i++) {
+    const uint32_t start = micros();
+    msg.state = i * 0.5f;
+    payload.clear();
+    msg.encode(api::ProtoWriteBuffer(&payload));
+    frame.clear();
+    frame.push_back(0x00);
+    api::ProtoVarInt(payload.size()).encode(frame);
+    api::ProtoVarInt(SENSOR_STATE_RESPONSE).encode(frame);
+    frame.insert(frame.end(), payload.begin(), payload.end());
+
+    uint32_t consumed;
+    uint32_t pos = 1;
+    auto size = api::ProtoVarInt::parse(&frame[pos], frame.size() - pos, &consumed);
+    pos += consumed;
+    auto type = api::ProtoVarInt::parse(&frame[pos], frame.size() - pos, &consumed);
+    pos += consumed;
+    if (size.has_value() && type.has_value() && type->as_uint32() == SENSOR_STATE_RESPONSE) {
+      api::SensorStateResponse decoded;
+      decoded.decode(&frame[pos], size->as_uint32());
+    }
+    this->samples_.push_back(micros() - start);
+    App.feed_wdt();
+  }
+}
+#endif
+
+#ifdef USE_BENCHMARK_DISPLAY
+void BenchmarkComponent::run_display_() {
+  // renders into the buffer only, sending it to the display is left to the display's own update
+  for (uint32_t i = 0; i < this->operations_[WORKLOAD_DISPLAY]; i++) {
+    const uint32_t start = micros();
+    this->display_->fill(display::COLOR_OFF);
+    if (this->font_ != nullptr) {
+      this->display_->printf(0, 0, this->font_, "Frame %u", i);
+      this->display_->print(0, this->display_->get_height() / 2, this->font_, "ESPHome benchmark");
+    } else {
+      this->display_->filled_rectangle(0, 0, this->display_->get_width() / 2, this->display_->get_height() / 2);
+      this->display_->circle(this->display_->get_width() / 2, this->display_->get_height() / 2,
+                             this->display_->get_height() / 4);
+    }
+    this->samples_.push_back(micros() - start);
+    App.feed_wdt();
+  }
+}
+#endif
+
+#ifdef USE_BENCHMARK_LIGHT
+void BenchmarkComponent::run_light_() {
+  // a moving rainbow written to the LEDs and shown, like a rainbow effect frame
+  auto *light = static_cast<light::AddressableLight *>(this->light_->get_output());
+  std::vector<light::ESPHSVColor> frame(light->size());
+  for (uint32_t i = 0; i < this->operations_[WORKLOAD_LIGHT]; i++) {
+    const uint32_t start = micros();
+    for (size_t led = 0; led < frame.size(); led++)
+      frame[led] = light::ESPHSVColor(uint8_t(i + led * 4), 240, 255);
+    light->write_hsv_span(frame.data(), frame.size());
+    light->schedule_show();
+    light->write_state(this->light_);
+    this->samples_.push_back(micros() - start);
+    App.feed_wdt();
+  }
+}
+#endif
+
+void BenchmarkComponent::report_(Workload workload, uint32_t elapsed_us) {
+  std::vector<uint32_t> &samples = this->samples_;
+  if (samples.empty())
+    return;
+  std::sort(samples.begin(), samples.end());
+  const uint32_t count = samples.size();
+  const uint32_t p50 = samples[count * 50 / 100];
+  const uint32_t p90 = samples[count * 90 / 100];
+  const uint32_t p99 = samples[count * 99 / 100];
+  const float throughput = elapsed_us == 0 ? NAN : count * 1e6f / elapsed_us;
+
+  ESP_LOGI(TAG, "%s: %u ops in %.1f ms, %.0f ops/s, latency p50=%u us, p90=%u us, p99=%u us, max=%u us",
+           WORKLOAD_NAMES[workload], count, elapsed_us / 1000.0f, throughput, p50, p90, p99, samples.back());
+
+  if (this->throughput_sensors_[workload] != nullptr)
+    this->throughput_sensors_[workload]->publish_state(throughput);
+  if (this->latency_p50_sensors_[workload] != nullptr)
+    this->latency_p50_sensors_[workload]->publish_state(p50);
+  if (this->latency_p99_sensors_[workload] != nullptr)
+    this->latency_p99_sensors_[workload]->publish_state(p99);
+}
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/automation.h"
+#include "esphome/components/sensor/sensor.h"
+
+#ifdef USE_BENCHMARK_DISPLAY
+#include "esphome/components/display/display_buffer.h"
+#endif
+#ifdef USE_BENCHMARK_LIGHT
+#include "esphome/components/light/addressable_light.h"
+#endif
+
+#include <vector>
+
+namespace esphome {
+namespace benchmark {
+
+enum Workload : uint8_t {
+  WORKLOAD_SCHEDULER = 0,
+  WORKLOAD_SENSOR,
+  WORKLOAD_API,
+  WORKLOAD_DISPLAY,
+  WORKLOAD_LIGHT,
+  WORKLOAD_COUNT,
+};
+
+/** Runs synthetic workloads on the device and reports their throughput and latency percentiles.
+ *
+ * The workloads run one after the other from the main loop. All but the scheduler one run synchronously and block the
+ * loop while they run, the scheduler workload schedules its timeouts at once and measures how long it takes the loop
+ * to run each of them. Workloads with 0 operations, or without the component they exercise, are skipped.
+ */
+class BenchmarkComponent : public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+  /// Start a run, ignored while one is in progress.
+  void run();
+  bool is_running() const { return this->current_ != WORKLOAD_COUNT; }
+
+  void set_boot_delay(optional<uint32_t> boot_delay) { this->boot_delay_ = boot_delay; }
+  void set_operations(Workload workload, uint32_t operations) { this->operations_[workload] = operations; }
+  void set_throughput_sensor(Workload workload, sensor::Sensor *sensor) {
+    this->throughput_sensors_[workload] = sensor;
+  }
+  void set_latency_p50_sensor(Workload workload, sensor::Sensor *sensor) {
+    this->latency_p50_sensors_[workload] = sensor;
+  }
+  void set_latency_p99_sensor(Workload workload, sensor::Sensor *sensor) {
+    this->latency_p99_sensors_[workload] = sensor;
+  }
+#ifdef USE_BENCHMARK_DISPLAY
+  void set_display(display::DisplayBuffer *display) { this->display_ = display; }
+  void set_font(display::Font *font) { this->font_ = font; }
+#endif
+#ifdef USE_BENCHMARK_LIGHT
+  void set_light(light::LightState *light) { this->light_ = light; }
+#endif
+
+ protected:
+  /// Start the next workload that can run, or finish the run.
+  void start_next_();
+  /// Run the synchronous workload, recording the duration of every operation.
+  bool run_workload_(Workload workload);
+  /// Log and publish the results of the current workload.
+  void report_(Workload workload, uint32_t elapsed_us);
+
+  void run_sensor_();
+#ifdef USE_API
+  void run_api_();
+#endif
+#ifdef USE_BENCHMARK_DISPLAY
+  void run_display_();
+#endif
+#ifdef USE_BENCHMARK_LIGHT
+  void run_light_();
+#endif
+
+  optional<uint32_t> boot_delay_{};
+  uint32_t operations_[WORKLOAD_COUNT]{};
+  sensor::Sensor *throughput_sensors_[WORKLOAD_COUNT]{};
+  sensor::Sensor *latency_p50_sensors_[WORKLOAD_COUNT]{};
+  sensor::Sensor *latency_p99_sensors_[WORKLOAD_COUNT]{};
+#ifdef USE_BENCHMARK_DISPLAY
+  display::DisplayBuffer *display_{nullptr};
+  display::Font *font_{nullptr};
+#endif
+#ifdef USE_BENCHMARK_LIGHT
+  light::LightState *light_{nullptr};
+#endif
+
+  Workload current_{WORKLOAD_COUNT};
+  /// The duration of every operation of the current workload, in µs.
+  std::vector<uint32_t> samples_;
+  uint32_t start_us_{0};
+  uint32_t scheduler_fired_{0};
+  uint32_t scheduler_last_us_{0};
+};
+
+template<typename... Ts> class RunAction : public Action<Ts...>, public Parented<BenchmarkComponent> {
+ public:
+  void play(Ts... x) override { this->parent_->run(); }
+};
+
+template<typename... Ts> class IsRunningCondition : public Condition<Ts...>, public Parented<BenchmarkComponent> {
+ public:
+  bool check(Ts... x) override { return this->parent_->is_running(); }
+};
+
+}  // namespace benchmark
+}  // namespace esphome
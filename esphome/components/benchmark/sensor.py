@@ -0,0 +1,49 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import ICON_GAUGE, ICON_TIMER
+from . import BenchmarkComponent, CONF_BENCHMARK_ID, Workload
+
+DEPENDENCIES = ['benchmark']
+
+CONF_THROUGHPUT = 'throughput'
+CONF_LATENCY_P50 = 'latency_p50'
+CONF_LATENCY_P99 = 'latency_p99'
+
+UNIT_OPERATIONS_PER_SECOND = 'ops/s'
+UNIT_MICROSECOND = 'µs'
+
+WORKLOAD_SENSORS = {
+    'scheduler': Workload.WORKLOAD_SCHEDULER,
+    'sensor': Workload.WORKLOAD_SENSOR,
+    'api': Workload.WORKLOAD_API,
+    'display': Workload.WORKLOAD_DISPLAY,
+    'light': Workload.WORKLOAD_LIGHT,
+}
+
+WORKLOAD_SENSORS_SCHEMA = cv.Schema({
+    cv.Optional(CONF_THROUGHPUT): sensor.sensor_schema(UNIT_OPERATIONS_PER_SECOND, ICON_GAUGE, 0),
+    cv.Optional(CONF_LATENCY_P50): sensor.sensor_schema(UNIT_MICROSECOND, ICON_TIMER, 0),
+    cv.Optional(CONF_LATENCY_P99): sensor.sensor_schema(UNIT_MICROSECOND, ICON_TIMER, 0),
+})
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(CONF_BENCHMARK_ID): cv.use_id(BenchmarkComponent),
+    **{cv.Optional(key): WORKLOAD_SENSORS_SCHEMA for key in WORKLOAD_SENSORS},
+})
+
+
+def to_code(config):
+    hub = yield cg.get_variable(config[CONF_BENCHMARK_ID])
+
+    for key, workload in WORKLOAD_SENSORS.items():
+        conf = config.get(key, {})
+        if CONF_THROUGHPUT in conf:
+            sens = yield sensor.new_sensor(conf[CONF_THROUGHPUT])
+            cg.add(hub.set_throughput_sensor(workload, sens))
+        if CONF_LATENCY_P50 in conf:
+            sens = yield sensor.new_sensor(conf[CONF_LATENCY_P50])
+            cg.add(hub.set_latency_p50_sensor(workload, sens))
+        if CONF_LATENCY_P99 in conf:
+            sens = yield sensor.new_sensor(conf[CONF_LATENCY_P99])
+            cg.add(hub.set_latency_p99_sensor(workload, sens))
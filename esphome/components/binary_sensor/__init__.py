@@ -42,9 +42,10 @@ BinarySensorCondition = binary_sensor_ns.class_('BinarySensorCondition', Conditi
 
 # Filters
 Filter = binary_sensor_ns.class_('Filter')
-DelayedOnOffFilter = binary_sensor_ns.class_('DelayedOnOffFilter', Filter, cg.Component)
-DelayedOnFilter = binary_sensor_ns.class_('DelayedOnFilter', Filter, cg.Component)
-DelayedOffFilter = binary_sensor_ns.class_('DelayedOffFilter', Filter, cg.Component)
+DelayedFilter = binary_sensor_ns.class_('DelayedFilter', Filter, cg.Component)
+DelayedOnOffFilter = binary_sensor_ns.class_('DelayedOnOffFilter', DelayedFilter)
+DelayedOnFilter = binary_sensor_ns.class_('DelayedOnFilter', DelayedFilter)
+DelayedOffFilter = binary_sensor_ns.class_('DelayedOffFilter', DelayedFilter)
 InvertFilter = binary_sensor_ns.class_('InvertFilter', Filter)
 LambdaFilter = binary_sensor_ns.class_('LambdaFilter', Filter)
 
@@ -224,9 +225,11 @@ BINARY_SENSOR_SCHEMA = cv.MQTT_COMPONENT_SCHEMA.extend({
 
 @coroutine
 def setup_binary_sensor_core_(var, config):
-    cg.add(var.set_name(config[CONF_NAME]))
+    cg.setup_entity_name(var, config[CONF_NAME])
     if CONF_INTERNAL in config:
         cg.add(var.set_internal(config[CONF_INTERNAL]))
+    if not config.get(CONF_INTERNAL, False):
+        cg.add_define('USE_CONTROLLER_BINARY_SENSOR')
     if CONF_DEVICE_CLASS in config:
         cg.add(var.set_device_class(config[CONF_DEVICE_CLASS]))
     if CONF_INVERTED in config:
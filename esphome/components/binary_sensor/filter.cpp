@@ -24,44 +24,47 @@ void Filter::input(bool value, bool is_initial) {
   }
 }
 
-DelayedOnOffFilter::DelayedOnOffFilter(uint32_t delay) : delay_(delay) {}
+void DelayedFilter::schedule_(bool value, bool is_initial) {
+  this->pending_ = true;
+  this->pending_value_ = value;
+  this->pending_is_initial_ = is_initial;
+  this->pending_since_ = millis();
+}
+
+void DelayedFilter::loop() {
+  if (!this->pending_ || millis() - this->pending_since_ < this->delay_)
+    return;
+  this->pending_ = false;
+  this->output(this->pending_value_, this->pending_is_initial_);
+}
+
+float DelayedFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
+
 optional<bool> DelayedOnOffFilter::new_value(bool value, bool is_initial) {
-  if (value) {
-    this->set_timeout("ON_OFF", this->delay_, [this, is_initial]() { this->output(true, is_initial); });
-  } else {
-    this->set_timeout("ON_OFF", this->delay_, [this, is_initial]() { this->output(false, is_initial); });
-  }
+  this->schedule_(value, is_initial);
   return {};
 }
 
-float DelayedOnOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
-
-DelayedOnFilter::DelayedOnFilter(uint32_t delay) : delay_(delay) {}
 optional<bool> DelayedOnFilter::new_value(bool value, bool is_initial) {
   if (value) {
-    this->set_timeout("ON", this->delay_, [this, is_initial]() { this->output(true, is_initial); });
+    this->schedule_(true, is_initial);
     return {};
   } else {
-    this->cancel_timeout("ON");
+    this->cancel_();
     return false;
   }
 }
 
-float DelayedOnFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
-
-DelayedOffFilter::DelayedOffFilter(uint32_t delay) : delay_(delay) {}
 optional<bool> DelayedOffFilter::new_value(bool value, bool is_initial) {
   if (!value) {
-    this->set_timeout("OFF", this->delay_, [this, is_initial]() { this->output(false, is_initial); });
+    this->schedule_(false, is_initial);
     return {};
   } else {
-    this->cancel_timeout("OFF");
+    this->cancel_();
     return true;
   }
 }
 
-float DelayedOffFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
-
 optional<bool> InvertFilter::new_value(bool value, bool is_initial) { return !value; }
 
 LambdaFilter::LambdaFilter(const std::function<optional<bool>(bool)> &f) : f_(f) {}
@@ -25,40 +25,50 @@ class Filter {
   Deduplicator<bool> dedup_;
 };
 
-class DelayedOnOffFilter : public Filter, public Component {
+/** Base of the filters that pass a value on after it has been stable for a delay.
+ *
+ * The pending value is only timestamped when it arrives and checked in loop(), so bouncing inputs don't
+ * allocate scheduler items or search them by name to cancel them.
+ */
+class DelayedFilter : public Filter, public Component {
  public:
-  explicit DelayedOnOffFilter(uint32_t delay);
-
-  optional<bool> new_value(bool value, bool is_initial) override;
+  explicit DelayedFilter(uint32_t delay) : delay_(delay) {}
 
+  void loop() override;
+  bool is_loop_idle() override { return !this->pending_; }
   float get_setup_priority() const override;
 
  protected:
+  /// Output the value once the delay has passed, replacing the value waiting before.
+  void schedule_(bool value, bool is_initial);
+  void cancel_() { this->pending_ = false; }
+
   uint32_t delay_;
+  uint32_t pending_since_{0};
+  bool pending_{false};
+  bool pending_value_{false};
+  bool pending_is_initial_{false};
 };
 
-class DelayedOnFilter : public Filter, public Component {
+class DelayedOnOffFilter : public DelayedFilter {
  public:
-  explicit DelayedOnFilter(uint32_t delay);
+  explicit DelayedOnOffFilter(uint32_t delay) : DelayedFilter(delay) {}
 
   optional<bool> new_value(bool value, bool is_initial) override;
-
-  float get_setup_priority() const override;
-
- protected:
-  uint32_t delay_;
 };
 
-class DelayedOffFilter : public Filter, public Component {
+class DelayedOnFilter : public DelayedFilter {
  public:
-  explicit DelayedOffFilter(uint32_t delay);
+  explicit DelayedOnFilter(uint32_t delay) : DelayedFilter(delay) {}
 
   optional<bool> new_value(bool value, bool is_initial) override;
+};
 
-  float get_setup_priority() const override;
+class DelayedOffFilter : public DelayedFilter {
+ public:
+  explicit DelayedOffFilter(uint32_t delay) : DelayedFilter(delay) {}
 
- protected:
-  uint32_t delay_;
+  optional<bool> new_value(bool value, bool is_initial) override;
 };
 
 class InvertFilter : public Filter {
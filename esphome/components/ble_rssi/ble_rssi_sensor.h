@@ -32,6 +32,10 @@ class BLERSSISensor : public sensor::Sensor, public esp32_ble_tracker::ESPBTDevi
       this->publish_state(NAN);
     this->found_ = false;
   }
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    if (this->by_address_)
+      filter.addresses.push_back(this->address_);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override {
     if (this->by_address_) {
       if (device.address_uint64() == this->address_) {
@@ -0,0 +1,39 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import esp32_ble_tracker
+from esphome.const import CONF_ID, CONF_MIN_INTERVAL, ESP_PLATFORM_ESP32
+
+ESP_PLATFORMS = [ESP_PLATFORM_ESP32]
+DEPENDENCIES = ['api', 'esp32_ble_tracker']
+
+CONF_BATCH_INTERVAL = 'batch_interval'
+CONF_BATCH_SIZE = 'batch_size'
+CONF_DUPLICATE_INTERVAL = 'duplicate_interval'
+CONF_MAX_DEVICES = 'max_devices'
+
+bluetooth_proxy_ns = cg.esphome_ns.namespace('bluetooth_proxy')
+BluetoothProxy = bluetooth_proxy_ns.class_('BluetoothProxy', cg.Component,
+                                           esp32_ble_tracker.ESPBTDeviceListener)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(BluetoothProxy),
+    cv.Optional(CONF_BATCH_INTERVAL, default='100ms'): cv.All(
+        cv.positive_time_period_milliseconds, cv.Range(min=cv.TimePeriod(milliseconds=10))),
+    cv.Optional(CONF_BATCH_SIZE, default=16): cv.int_range(min=1, max=64),
+    cv.Optional(CONF_MIN_INTERVAL, default='1s'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_DUPLICATE_INTERVAL, default='10s'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_MAX_DEVICES, default=64): cv.int_range(min=1, max=1024),
+}).extend(esp32_ble_tracker.ESP_BLE_DEVICE_SCHEMA).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    cg.add_define('USE_BLUETOOTH_PROXY')
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+    yield esp32_ble_tracker.register_ble_device(var, config)
+
+    cg.add(var.set_batch_interval(config[CONF_BATCH_INTERVAL]))
+    cg.add(var.set_batch_size(config[CONF_BATCH_SIZE]))
+    cg.add(var.set_min_interval(config[CONF_MIN_INTERVAL]))
+    cg.add(var.set_duplicate_interval(config[CONF_DUPLICATE_INTERVAL]))
+    cg.add(var.set_max_devices(config[CONF_MAX_DEVICES]))
@@ -0,0 +1,98 @@
+#include "bluetooth_proxy.h"
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/api/api_server.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace esphome {
+namespace bluetooth_proxy {
+
+static const char *TAG = "bluetooth_proxy";
+
+void BluetoothProxy::setup() {
+  this->devices_.reserve(this->max_devices_);
+  this->batch_.advertisements.reserve(this->batch_size_);
+  this->set_interval("batch", this->batch_interval_, [this]() { this->flush_(); });
+}
+
+void BluetoothProxy::dump_config() {
+  ESP_LOGCONFIG(TAG, "Bluetooth Proxy:");
+  ESP_LOGCONFIG(TAG, "  Batch Interval: %u ms", this->batch_interval_);
+  ESP_LOGCONFIG(TAG, "  Batch Size: %u", this->batch_size_);
+  ESP_LOGCONFIG(TAG, "  Min Interval: %u ms", this->min_interval_);
+  ESP_LOGCONFIG(TAG, "  Duplicate Interval: %u ms", this->duplicate_interval_);
+  ESP_LOGCONFIG(TAG, "  Max Devices: %u", this->max_devices_);
+}
+
+BluetoothProxy::ProxyDevice &BluetoothProxy::find_device_(uint64_t address, uint32_t now, bool &is_new) {
+  is_new = false;
+  ProxyDevice *oldest = nullptr;
+  for (auto &device : this->devices_) {
+    if (device.address == address)
+      return device;
+    if (oldest == nullptr || now - device.last_sent > now - oldest->last_sent)
+      oldest = &device;
+  }
+  is_new = true;
+  if (this->devices_.size() < this->max_devices_) {
+    this->devices_.push_back({address, 0, 0});
+    return this->devices_.back();
+  }
+  oldest->address = address;
+  return *oldest;
+}
+
+bool BluetoothProxy::accepts_advertisement(const esp32_ble_tracker::ESPBTRawAdvertisement &adv) {
+  if (!api::global_api_server->has_bluetooth_le_advertisements_subscribers())
+    return false;
+
+  const uint32_t now = millis();
+  const uint8_t len = adv.adv_data_len + adv.scan_rsp_len;
+  const uint32_t data_hash = fnv1_hash(reinterpret_cast<const char *>(adv.data), len);
+  bool is_new;
+  ProxyDevice &device = this->find_device_(adv.address, now, is_new);
+  if (!is_new) {
+    const uint32_t since = now - device.last_sent;
+    if (since < this->min_interval_ || (device.data_hash == data_hash && since < this->duplicate_interval_)) {
+      this->suppressed_++;
+      return false;
+    }
+  }
+  device.data_hash = data_hash;
+  device.last_sent = now;
+
+  this->batch_.advertisements.emplace_back();
+  api::BluetoothLERawAdvertisement &out = this->batch_.advertisements.back();
+  out.address = adv.address;
+  out.rssi = adv.rssi;
+  out.address_type = adv.address_type;
+  if (!this->spare_buffers_.empty()) {
+    out.data = std::move(this->spare_buffers_.back());
+    this->spare_buffers_.pop_back();
+  }
+  out.data.assign(reinterpret_cast<const char *>(adv.data), len);
+  if (this->batch_.advertisements.size() >= this->batch_size_)
+    this->flush_();
+
+  // the advertisement is only forwarded, it doesn't need to be parsed for this listener
+  return false;
+}
+
+void BluetoothProxy::flush_() {
+  auto &advertisements = this->batch_.advertisements;
+  if (advertisements.empty())
+    return;
+  api::global_api_server->send_bluetooth_le_advertisements(this->batch_);
+  this->forwarded_ += advertisements.size();
+  ESP_LOGV(TAG, "Forwarded %u advertisements (%u in total, %u suppressed)", advertisements.size(), this->forwarded_,
+           this->suppressed_);
+  for (auto &advertisement : advertisements)
+    this->spare_buffers_.push_back(std::move(advertisement.data));
+  advertisements.clear();
+}
+
+}  // namespace bluetooth_proxy
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/components/esp32_ble_tracker/esp32_ble_tracker.h"
+#include "esphome/components/api/api_pb2.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace esphome {
+namespace bluetooth_proxy {
+
+/** Forwards the raw advertisements seen by the tracker to API clients, which decode them centrally.
+ *
+ * Advertisements are only looked at in accepts_advertisement(), before the tracker parses them, and only while a
+ * client is subscribed. They are collected into batches that are sent every batch_interval, or as soon as batch_size
+ * advertisements are waiting. Each device is sent at most once per min_interval, and an advertisement with the same
+ * data as the last one sent for it only after duplicate_interval, which keeps its RSSI fresh on the client.
+ */
+class BluetoothProxy : public Component, public esp32_ble_tracker::ESPBTDeviceListener {
+ public:
+  void set_batch_interval(uint32_t batch_interval) { this->batch_interval_ = batch_interval; }
+  void set_batch_size(uint8_t batch_size) { this->batch_size_ = batch_size; }
+  void set_min_interval(uint32_t min_interval) { this->min_interval_ = min_interval; }
+  void set_duplicate_interval(uint32_t duplicate_interval) { this->duplicate_interval_ = duplicate_interval; }
+  /// The number of devices whose last advertisement is remembered for rate limiting and deduplication.
+  void set_max_devices(uint16_t max_devices) { this->max_devices_ = max_devices; }
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  bool accepts_advertisement(const esp32_ble_tracker::ESPBTRawAdvertisement &adv) override;
+  bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override { return false; }
+
+ protected:
+  struct ProxyDevice {
+    uint64_t address;
+    /// FNV-1 hash of the last data sent.
+    uint32_t data_hash;
+    /// millis() when the last advertisement was sent.
+    uint32_t last_sent;
+  };
+
+  /// The entry of the device. If it isn't known yet, the entry sent to the longest ago is taken over and is_new set.
+  ProxyDevice &find_device_(uint64_t address, uint32_t now, bool &is_new);
+  void flush_();
+
+  uint32_t batch_interval_;
+  uint8_t batch_size_;
+  uint32_t min_interval_;
+  uint32_t duplicate_interval_;
+  uint16_t max_devices_;
+  std::vector<ProxyDevice> devices_;
+  api::BluetoothLERawAdvertisementsResponse batch_;
+  /// The data buffers of advertisements already sent, reused for the next ones.
+  std::vector<std::string> spare_buffers_;
+  uint32_t forwarded_{0};
+  uint32_t suppressed_{0};
+};
+
+}  // namespace bluetooth_proxy
+}  // namespace esphome
+
+#endif
@@ -6,26 +6,8 @@ namespace bme280 {
 
 static const char *TAG = "bme280.sensor";
 
-static const uint8_t BME280_REGISTER_DIG_T1 = 0x88;
-static const uint8_t BME280_REGISTER_DIG_T2 = 0x8A;
-static const uint8_t BME280_REGISTER_DIG_T3 = 0x8C;
-
-static const uint8_t BME280_REGISTER_DIG_P1 = 0x8E;
-static const uint8_t BME280_REGISTER_DIG_P2 = 0x90;
-static const uint8_t BME280_REGISTER_DIG_P3 = 0x92;
-static const uint8_t BME280_REGISTER_DIG_P4 = 0x94;
-static const uint8_t BME280_REGISTER_DIG_P5 = 0x96;
-static const uint8_t BME280_REGISTER_DIG_P6 = 0x98;
-static const uint8_t BME280_REGISTER_DIG_P7 = 0x9A;
-static const uint8_t BME280_REGISTER_DIG_P8 = 0x9C;
-static const uint8_t BME280_REGISTER_DIG_P9 = 0x9E;
-
-static const uint8_t BME280_REGISTER_DIG_H1 = 0xA1;
-static const uint8_t BME280_REGISTER_DIG_H2 = 0xE1;
-static const uint8_t BME280_REGISTER_DIG_H3 = 0xE3;
-static const uint8_t BME280_REGISTER_DIG_H4 = 0xE4;
-static const uint8_t BME280_REGISTER_DIG_H5 = 0xE5;
-static const uint8_t BME280_REGISTER_DIG_H6 = 0xE7;
+static const uint8_t BME280_REGISTER_CALIBRATION1 = 0x88;
+static const uint8_t BME280_REGISTER_CALIBRATION2 = 0xE1;
 
 static const uint8_t BME280_REGISTER_CHIPID = 0xD0;
 
@@ -34,10 +16,9 @@ static const uint8_t BME280_REGISTER_STATUS = 0xF3;
 static const uint8_t BME280_REGISTER_CONTROL = 0xF4;
 static const uint8_t BME280_REGISTER_CONFIG = 0xF5;
 static const uint8_t BME280_REGISTER_PRESSUREDATA = 0xF7;
-static const uint8_t BME280_REGISTER_TEMPDATA = 0xFA;
-static const uint8_t BME280_REGISTER_HUMIDDATA = 0xFD;
 
 static const uint8_t BME280_MODE_FORCED = 0b01;
+static const uint8_t BME280_MODE_NORMAL = 0b11;
 
 inline uint16_t combine_bytes(uint8_t msb, uint8_t lsb) { return ((msb & 0xFF) << 8) | (lsb & 0xFF); }
 
@@ -60,6 +41,29 @@ static const char *oversampling_to_str(BME280Oversampling oversampling) {
   }
 }
 
+static const char *standby_time_to_str(BME280StandbyTime standby_time) {
+  switch (standby_time) {
+    case BME280_STANDBY_TIME_0_5MS:
+      return "0.5ms";
+    case BME280_STANDBY_TIME_62_5MS:
+      return "62.5ms";
+    case BME280_STANDBY_TIME_125MS:
+      return "125ms";
+    case BME280_STANDBY_TIME_250MS:
+      return "250ms";
+    case BME280_STANDBY_TIME_500MS:
+      return "500ms";
+    case BME280_STANDBY_TIME_1000MS:
+      return "1000ms";
+    case BME280_STANDBY_TIME_10MS:
+      return "10ms";
+    case BME280_STANDBY_TIME_20MS:
+      return "20ms";
+    default:
+      return "UNKNOWN";
+  }
+}
+
 static const char *iir_filter_to_str(BME280IIRFilter filter) {
   switch (filter) {
     case BME280_IIR_FILTER_OFF:
@@ -91,27 +95,35 @@ void BME280Component::setup() {
     return;
   }
 
-  // Read calibration
-  this->calibration_.t1 = read_u16_le_(BME280_REGISTER_DIG_T1);
-  this->calibration_.t2 = read_s16_le_(BME280_REGISTER_DIG_T2);
-  this->calibration_.t3 = read_s16_le_(BME280_REGISTER_DIG_T3);
-
-  this->calibration_.p1 = read_u16_le_(BME280_REGISTER_DIG_P1);
-  this->calibration_.p2 = read_s16_le_(BME280_REGISTER_DIG_P2);
-  this->calibration_.p3 = read_s16_le_(BME280_REGISTER_DIG_P3);
-  this->calibration_.p4 = read_s16_le_(BME280_REGISTER_DIG_P4);
-  this->calibration_.p5 = read_s16_le_(BME280_REGISTER_DIG_P5);
-  this->calibration_.p6 = read_s16_le_(BME280_REGISTER_DIG_P6);
-  this->calibration_.p7 = read_s16_le_(BME280_REGISTER_DIG_P7);
-  this->calibration_.p8 = read_s16_le_(BME280_REGISTER_DIG_P8);
-  this->calibration_.p9 = read_s16_le_(BME280_REGISTER_DIG_P9);
-
-  this->calibration_.h1 = read_u8_(BME280_REGISTER_DIG_H1);
-  this->calibration_.h2 = read_s16_le_(BME280_REGISTER_DIG_H2);
-  this->calibration_.h3 = read_u8_(BME280_REGISTER_DIG_H3);
-  this->calibration_.h4 = read_u8_(BME280_REGISTER_DIG_H4) << 4 | (read_u8_(BME280_REGISTER_DIG_H4 + 1) & 0x0F);
-  this->calibration_.h5 = read_u8_(BME280_REGISTER_DIG_H5 + 1) << 4 | (read_u8_(BME280_REGISTER_DIG_H5) >> 4);
-  this->calibration_.h6 = read_u8_(BME280_REGISTER_DIG_H6);
+  // Read calibration, in two blocks instead of one transaction per value
+  uint8_t cal1[26];
+  uint8_t cal2[7];
+  if (!this->read_bytes(BME280_REGISTER_CALIBRATION1, cal1, 26) ||
+      !this->read_bytes(BME280_REGISTER_CALIBRATION2, cal2, 7)) {
+    this->error_code_ = COMMUNICATION_FAILED;
+    this->mark_failed();
+    return;
+  }
+  this->calibration_.t1 = combine_bytes(cal1[1], cal1[0]);
+  this->calibration_.t2 = combine_bytes(cal1[3], cal1[2]);
+  this->calibration_.t3 = combine_bytes(cal1[5], cal1[4]);
+
+  this->calibration_.p1 = combine_bytes(cal1[7], cal1[6]);
+  this->calibration_.p2 = combine_bytes(cal1[9], cal1[8]);
+  this->calibration_.p3 = combine_bytes(cal1[11], cal1[10]);
+  this->calibration_.p4 = combine_bytes(cal1[13], cal1[12]);
+  this->calibration_.p5 = combine_bytes(cal1[15], cal1[14]);
+  this->calibration_.p6 = combine_bytes(cal1[17], cal1[16]);
+  this->calibration_.p7 = combine_bytes(cal1[19], cal1[18]);
+  this->calibration_.p8 = combine_bytes(cal1[21], cal1[20]);
+  this->calibration_.p9 = combine_bytes(cal1[23], cal1[22]);
+
+  this->calibration_.h1 = cal1[25];
+  this->calibration_.h2 = combine_bytes(cal2[1], cal2[0]);
+  this->calibration_.h3 = cal2[2];
+  this->calibration_.h4 = int16_t(int8_t(cal2[3])) * 16 | (cal2[4] & 0x0F);
+  this->calibration_.h5 = int16_t(int8_t(cal2[5])) * 16 | (cal2[4] >> 4);
+  this->calibration_.h6 = cal2[6];
 
   uint8_t humid_register = 0;
   if (!this->read_byte(BME280_REGISTER_CONTROLHUMID, &humid_register)) {
@@ -131,12 +143,24 @@ void BME280Component::setup() {
     return;
   }
   config_register &= ~0b11111100;
-  config_register |= 0b000 << 5;  // 0.5 ms standby time
+  config_register |= (this->standby_time_ & 0b111) << 5;
   config_register |= (this->iir_filter_ & 0b111) << 2;
   if (!this->write_byte(BME280_REGISTER_CONFIG, config_register)) {
     this->mark_failed();
     return;
   }
+
+  if (this->normal_mode_) {
+    // the config register is only written reliably in sleep mode, so start measuring after it
+    uint8_t meas_register = 0;
+    meas_register |= (this->temperature_oversampling_ & 0b111) << 5;
+    meas_register |= (this->pressure_oversampling_ & 0b111) << 2;
+    meas_register |= BME280_MODE_NORMAL;
+    if (!this->write_byte(BME280_REGISTER_CONTROL, meas_register)) {
+      this->mark_failed();
+      return;
+    }
+  }
 }
 void BME280Component::dump_config() {
   ESP_LOGCONFIG(TAG, "BME280:");
@@ -153,6 +177,11 @@ void BME280Component::dump_config() {
       break;
   }
   ESP_LOGCONFIG(TAG, "  IIR Filter: %s", iir_filter_to_str(this->iir_filter_));
+  if (this->normal_mode_) {
+    ESP_LOGCONFIG(TAG, "  Mode: Normal (standby time %s)", standby_time_to_str(this->standby_time_));
+  } else {
+    ESP_LOGCONFIG(TAG, "  Mode: Forced");
+  }
   LOG_UPDATE_INTERVAL(this);
 
   LOG_SENSOR("  ", "Temperature", this->temperature_sensor_);
@@ -167,6 +196,12 @@ float BME280Component::get_setup_priority() const { return setup_priority::DATA;
 inline uint8_t oversampling_to_time(BME280Oversampling over_sampling) { return (1 << uint8_t(over_sampling)) >> 1; }
 
 void BME280Component::update() {
+  if (this->normal_mode_) {
+    // the sensor measures on its own, the data registers always hold the last complete measurement
+    this->read_data_();
+    return;
+  }
+
   // Enable sensor
   ESP_LOGV(TAG, "Sending conversion request...");
   uint8_t meas_register = 0;
@@ -183,33 +218,39 @@ void BME280Component::update() {
   meas_time += 2.3f * oversampling_to_time(this->pressure_oversampling_) + 0.575f;
   meas_time += 2.3f * oversampling_to_time(this->humidity_oversampling_) + 0.575f;
 
-  this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() {
-    int32_t t_fine = 0;
-    float temperature = this->read_temperature_(&t_fine);
-    if (isnan(temperature)) {
-      ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
-      this->status_set_warning();
-      return;
-    }
-    float pressure = this->read_pressure_(t_fine);
-    float humidity = this->read_humidity_(t_fine);
-
-    ESP_LOGD(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
-    if (this->temperature_sensor_ != nullptr)
-      this->temperature_sensor_->publish_state(temperature);
-    if (this->pressure_sensor_ != nullptr)
-      this->pressure_sensor_->publish_state(pressure);
-    if (this->humidity_sensor_ != nullptr)
-      this->humidity_sensor_->publish_state(humidity);
-    this->status_clear_warning();
-  });
+  this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() { this->read_data_(); });
 }
-float BME280Component::read_temperature_(int32_t *t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BME280_REGISTER_TEMPDATA, data, 3))
-    return NAN;
-  int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
-  adc >>= 4;
+void BME280Component::read_data_() {
+  // pressure, temperature and humidity in one burst, the sensor keeps them from the same measurement while it's read
+  uint8_t data[8];
+  if (!this->read_bytes(BME280_REGISTER_PRESSUREDATA, data, 8)) {
+    this->status_set_warning();
+    return;
+  }
+  const int32_t adc_pressure = (int32_t(data[0]) << 12) | (int32_t(data[1]) << 4) | (data[2] >> 4);
+  const int32_t adc_temperature = (int32_t(data[3]) << 12) | (int32_t(data[4]) << 4) | (data[5] >> 4);
+  const int32_t adc_humidity = (int32_t(data[6]) << 8) | data[7];
+
+  int32_t t_fine = 0;
+  float temperature = this->compensate_temperature_(adc_temperature, &t_fine);
+  if (isnan(temperature)) {
+    ESP_LOGW(TAG, "Invalid temperature, cannot read pressure & humidity values.");
+    this->status_set_warning();
+    return;
+  }
+  float pressure = this->compensate_pressure_(adc_pressure, t_fine);
+  float humidity = this->compensate_humidity_(adc_humidity, t_fine);
+
+  ESP_LOGD(TAG, "Got temperature=%.1f°C pressure=%.1fhPa humidity=%.1f%%", temperature, pressure, humidity);
+  if (this->temperature_sensor_ != nullptr)
+    this->temperature_sensor_->publish_state(temperature);
+  if (this->pressure_sensor_ != nullptr)
+    this->pressure_sensor_->publish_state(pressure);
+  if (this->humidity_sensor_ != nullptr)
+    this->humidity_sensor_->publish_state(humidity);
+  this->status_clear_warning();
+}
+float BME280Component::compensate_temperature_(int32_t adc, int32_t *t_fine) {
   if (adc == 0x80000)
     // temperature was disabled
     return NAN;
@@ -226,15 +267,46 @@ float BME280Component::read_temperature_(int32_t *t_fine) {
   return temperature / 100.0f;
 }
 
-float BME280Component::read_pressure_(int32_t t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BME280_REGISTER_PRESSUREDATA, data, 3))
-    return NAN;
-  int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
-  adc >>= 4;
+float BME280Component::compensate_pressure_(int32_t adc, int32_t t_fine) {
   if (adc == 0x80000)
     // pressure was disabled
     return NAN;
+#ifdef ARDUINO_ARCH_ESP8266
+  // The 32 bit formula of the datasheet, within a few Pa of the 64 bit one. The ESP8266 has to emulate every 64 bit
+  // multiplication and division in software.
+  const int32_t p1 = this->calibration_.p1;
+  const int32_t p2 = this->calibration_.p2;
+  const int32_t p3 = this->calibration_.p3;
+  const int32_t p4 = this->calibration_.p4;
+  const int32_t p5 = this->calibration_.p5;
+  const int32_t p6 = this->calibration_.p6;
+  const int32_t p7 = this->calibration_.p7;
+  const int32_t p8 = this->calibration_.p8;
+  const int32_t p9 = this->calibration_.p9;
+
+  int32_t var1, var2;
+  uint32_t p;
+  var1 = (t_fine >> 1) - 64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * p6;
+  var2 = var2 + ((var1 * p5) << 1);
+  var2 = (var2 >> 2) + (p4 << 16);
+  var1 = (((p3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((p2 * var1) >> 1)) >> 18;
+  var1 = ((32768 + var1) * p1) >> 15;
+
+  if (var1 == 0)
+    return NAN;
+
+  p = (uint32_t(1048576 - adc) - (var2 >> 12)) * 3125;
+  if (p < 0x80000000)
+    p = (p << 1) / uint32_t(var1);
+  else
+    p = (p / uint32_t(var1)) * 2;
+  var1 = (p9 * int32_t(((p >> 3) * (p >> 3)) >> 13)) >> 12;
+  var2 = (int32_t(p >> 2) * p8) >> 13;
+
+  p = uint32_t(int32_t(p) + ((var1 + var2 + p7) >> 4));
+  return p / 100.0f;
+#else
   const int64_t p1 = this->calibration_.p1;
   const int64_t p2 = this->calibration_.p2;
   const int64_t p3 = this->calibration_.p3;
@@ -263,15 +335,14 @@ float BME280Component::read_pressure_(int32_t t_fine) {
 
   p = ((p + var1 + var2) >> 8) + (p7 << 4);
   return (p / 256.0f) / 100.0f;
+#endif
 }
 
-float BME280Component::read_humidity_(int32_t t_fine) {
-  uint16_t raw_adc;
-  if (!this->read_byte_16(BME280_REGISTER_HUMIDDATA, &raw_adc) || raw_adc == 0x8000)
+float BME280Component::compensate_humidity_(int32_t adc, int32_t t_fine) {
+  if (adc == 0x8000)
+    // humidity was disabled
     return NAN;
 
-  int32_t adc = raw_adc;
-
   const int32_t h1 = this->calibration_.h1;
   const int32_t h2 = this->calibration_.h2;
   const int32_t h3 = this->calibration_.h3;
@@ -302,17 +373,10 @@ void BME280Component::set_humidity_oversampling(BME280Oversampling humidity_over
   this->humidity_oversampling_ = humidity_over_sampling;
 }
 void BME280Component::set_iir_filter(BME280IIRFilter iir_filter) { this->iir_filter_ = iir_filter; }
-uint8_t BME280Component::read_u8_(uint8_t a_register) {
-  uint8_t data = 0;
-  this->read_byte(a_register, &data);
-  return data;
-}
-uint16_t BME280Component::read_u16_le_(uint8_t a_register) {
-  uint16_t data = 0;
-  this->read_byte_16(a_register, &data);
-  return (data >> 8) | (data << 8);
+void BME280Component::set_standby_time(BME280StandbyTime standby_time) {
+  this->standby_time_ = standby_time;
+  this->normal_mode_ = true;
 }
-int16_t BME280Component::read_s16_le_(uint8_t a_register) { return this->read_u16_le_(a_register); }
 
 }  // namespace bme280
 }  // namespace esphome
@@ -57,6 +57,21 @@ enum BME280IIRFilter {
   BME280_IIR_FILTER_16X = 0b100,
 };
 
+/** Enum listing all standby times between two measurements in normal mode for the BME280.
+ *
+ * In normal mode the sensor measures continuously on its own, so an update only has to read the latest result.
+ */
+enum BME280StandbyTime {
+  BME280_STANDBY_TIME_0_5MS = 0b000,
+  BME280_STANDBY_TIME_62_5MS = 0b001,
+  BME280_STANDBY_TIME_125MS = 0b010,
+  BME280_STANDBY_TIME_250MS = 0b011,
+  BME280_STANDBY_TIME_500MS = 0b100,
+  BME280_STANDBY_TIME_1000MS = 0b101,
+  BME280_STANDBY_TIME_10MS = 0b110,
+  BME280_STANDBY_TIME_20MS = 0b111,
+};
+
 /// This class implements support for the BME280 Temperature+Pressure+Humidity i2c sensor.
 class BME280Component : public PollingComponent, public i2c::I2CDevice {
  public:
@@ -72,6 +87,8 @@ class BME280Component : public PollingComponent, public i2c::I2CDevice {
   void set_humidity_oversampling(BME280Oversampling humidity_over_sampling);
   /// Set the IIR Filter used to increase accuracy, defaults to no IIR Filter.
   void set_iir_filter(BME280IIRFilter iir_filter);
+  /// Measure continuously in normal mode with this standby time, instead of a forced measurement on every update.
+  void set_standby_time(BME280StandbyTime standby_time);
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -81,21 +98,22 @@ class BME280Component : public PollingComponent, public i2c::I2CDevice {
   void update() override;
 
  protected:
-  /// Read the temperature value and store the calculated ambient temperature in t_fine.
-  float read_temperature_(int32_t *t_fine);
-  /// Read the pressure value in hPa using the provided t_fine value.
-  float read_pressure_(int32_t t_fine);
-  /// Read the humidity value in % using the provided t_fine value.
-  float read_humidity_(int32_t t_fine);
-  uint8_t read_u8_(uint8_t a_register);
-  uint16_t read_u16_le_(uint8_t a_register);
-  int16_t read_s16_le_(uint8_t a_register);
+  /// Read all data registers in one transaction and publish the results.
+  void read_data_();
+  /// Calculate the temperature in °C from the raw ADC value and store the calculated ambient temperature in t_fine.
+  float compensate_temperature_(int32_t adc, int32_t *t_fine);
+  /// Calculate the pressure in hPa from the raw ADC value using the provided t_fine value.
+  float compensate_pressure_(int32_t adc, int32_t t_fine);
+  /// Calculate the humidity in % from the raw ADC value using the provided t_fine value.
+  float compensate_humidity_(int32_t adc, int32_t t_fine);
 
   BME280CalibrationData calibration_;
   BME280Oversampling temperature_oversampling_{BME280_OVERSAMPLING_16X};
   BME280Oversampling pressure_oversampling_{BME280_OVERSAMPLING_16X};
   BME280Oversampling humidity_oversampling_{BME280_OVERSAMPLING_16X};
   BME280IIRFilter iir_filter_{BME280_IIR_FILTER_OFF};
+  BME280StandbyTime standby_time_{BME280_STANDBY_TIME_0_5MS};
+  bool normal_mode_{false};
   sensor::Sensor *temperature_sensor_;
   sensor::Sensor *pressure_sensor_;
   sensor::Sensor *humidity_sensor_;
@@ -7,6 +7,8 @@ from esphome.const import CONF_HUMIDITY, CONF_ID, CONF_IIR_FILTER, CONF_OVERSAMP
 
 DEPENDENCIES = ['i2c']
 
+CONF_STANDBY_TIME = 'standby_time'
+
 bme280_ns = cg.esphome_ns.namespace('bme280')
 BME280Oversampling = bme280_ns.enum('BME280Oversampling')
 OVERSAMPLING_OPTIONS = {
@@ -27,6 +29,27 @@ IIR_FILTER_OPTIONS = {
     '16X': BME280IIRFilter.BME280_IIR_FILTER_16X,
 }
 
+BME280StandbyTime = bme280_ns.enum('BME280StandbyTime')
+STANDBY_TIME_OPTIONS = {
+    500: BME280StandbyTime.BME280_STANDBY_TIME_0_5MS,
+    62500: BME280StandbyTime.BME280_STANDBY_TIME_62_5MS,
+    125000: BME280StandbyTime.BME280_STANDBY_TIME_125MS,
+    250000: BME280StandbyTime.BME280_STANDBY_TIME_250MS,
+    500000: BME280StandbyTime.BME280_STANDBY_TIME_500MS,
+    1000000: BME280StandbyTime.BME280_STANDBY_TIME_1000MS,
+    10000: BME280StandbyTime.BME280_STANDBY_TIME_10MS,
+    20000: BME280StandbyTime.BME280_STANDBY_TIME_20MS,
+}
+
+
+def validate_standby_time(value):
+    value = cv.positive_time_period_microseconds(value)
+    if value.total_microseconds not in STANDBY_TIME_OPTIONS:
+        raise cv.Invalid(u"Standby time must be one of {}".format(
+            ', '.join('{:g}ms'.format(us / 1000.0) for us in sorted(STANDBY_TIME_OPTIONS))))
+    return STANDBY_TIME_OPTIONS[value.total_microseconds]
+
+
 BME280Component = bme280_ns.class_('BME280Component', cg.PollingComponent, i2c.I2CDevice)
 
 CONFIG_SCHEMA = cv.Schema({
@@ -47,6 +70,7 @@ CONFIG_SCHEMA = cv.Schema({
                 cv.enum(OVERSAMPLING_OPTIONS, upper=True),
         }),
     cv.Optional(CONF_IIR_FILTER, default='OFF'): cv.enum(IIR_FILTER_OPTIONS, upper=True),
+    cv.Optional(CONF_STANDBY_TIME): validate_standby_time,
 }).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x77))
 
 
@@ -74,3 +98,6 @@ def to_code(config):
         cg.add(var.set_humidity_oversampling(conf[CONF_OVERSAMPLING]))
 
     cg.add(var.set_iir_filter(config[CONF_IIR_FILTER]))
+
+    if CONF_STANDBY_TIME in config:
+        cg.add(var.set_standby_time(config[CONF_STANDBY_TIME]))
@@ -8,6 +8,7 @@ static const char *TAG = "bme680.sensor";
 
 static const uint8_t BME680_REGISTER_COEFF1 = 0x89;
 static const uint8_t BME680_REGISTER_COEFF2 = 0xE1;
+static const uint8_t BME680_REGISTER_RES_HEAT_VAL = 0x00;
 
 static const uint8_t BME680_REGISTER_CONFIG = 0x75;
 static const uint8_t BME680_REGISTER_CONTROL_MEAS = 0x74;
@@ -21,11 +22,21 @@ static const uint8_t BME680_REGISTER_CHIPID = 0xD0;
 
 static const uint8_t BME680_REGISTER_FIELD0 = 0x1D;
 
+#ifdef ARDUINO_ARCH_ESP8266
+const uint32_t BME680_GAS_LOOKUP_TABLE_1[16] PROGMEM = {
+    2147483647UL, 2147483647UL, 2147483647UL, 2147483647UL, 2147483647UL, 2126008810UL, 2147483647UL, 2130303777UL,
+    2147483647UL, 2147483647UL, 2143188679UL, 2136746228UL, 2147483647UL, 2126008810UL, 2147483647UL, 2147483647UL};
+
+const uint32_t BME680_GAS_LOOKUP_TABLE_2[16] PROGMEM = {
+    4096000000UL, 2048000000UL, 1024000000UL, 512000000UL, 255744255UL, 127110228UL, 64000000UL, 32258064UL,
+    16016016UL,   8000000UL,    4000000UL,    2000000UL,   1000000UL,   500000UL,    250000UL,   125000UL};
+#else
 const float BME680_GAS_LOOKUP_TABLE_1[16] PROGMEM = {0.0, 0.0, 0.0,  0.0,  0.0, -1.0, 0.0, -0.8,
                                                      0.0, 0.0, -0.2, -0.5, 0.0, -1.0, 0.0, 0.0};
 
 const float BME680_GAS_LOOKUP_TABLE_2[16] PROGMEM = {0.0,  0.0, 0.0, 0.0, 0.1, 0.7, 0.0, -0.8,
                                                      -0.1, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+#endif
 
 static const char *oversampling_to_str(BME680Oversampling oversampling) {
   switch (oversampling) {
@@ -94,7 +105,7 @@ void BME680Component::setup() {
   this->calibration_.t3 = cal1[3];
 
   this->calibration_.h1 = cal2[2] << 4 | (cal2[1] & 0x0F);
-  this->calibration_.h2 = cal2[0] << 4 | cal2[1];
+  this->calibration_.h2 = cal2[0] << 4 | (cal2[1] >> 4);
   this->calibration_.h3 = cal2[3];
   this->calibration_.h4 = cal2[4];
   this->calibration_.h5 = cal2[5];
@@ -116,18 +127,15 @@ void BME680Component::setup() {
   this->calibration_.gh2 = cal2[12] << 8 | cal2[13];
   this->calibration_.gh3 = cal2[15];
 
-  if (!this->read_byte(0x02, &this->calibration_.res_heat_range)) {
-    this->mark_failed();
-    return;
-  }
-  if (!this->read_byte(0x00, &this->calibration_.res_heat_val)) {
-    this->mark_failed();
-    return;
-  }
-  if (!this->read_byte(0x04, &this->calibration_.range_sw_err)) {
+  // res_heat_val, res_heat_range and range_sw_err are spread over the first five registers
+  uint8_t heat[5];
+  if (!this->read_bytes(BME680_REGISTER_RES_HEAT_VAL, heat, 5)) {
     this->mark_failed();
     return;
   }
+  this->calibration_.res_heat_val = heat[0];
+  this->calibration_.res_heat_range = (heat[2] >> 4) & 0b11;
+  this->calibration_.range_sw_err = int8_t(heat[4]) >> 4;
 
   this->calibration_.ambient_temperature = 25;  // prime ambient temperature
 
@@ -253,7 +261,7 @@ uint8_t BME680Component::calc_heater_resistance_(uint16_t temperature) {
   const int16_t gh2 = this->calibration_.gh2;
   const int8_t gh3 = this->calibration_.gh3;
   const uint8_t res_heat_range = this->calibration_.res_heat_range;
-  const uint8_t res_heat_val = this->calibration_.res_heat_val;
+  const int8_t res_heat_val = this->calibration_.res_heat_val;
 
   uint8_t heatr_res;
   int32_t var1;
@@ -299,7 +307,7 @@ void BME680Component::read_data_() {
   uint32_t raw_temperature = (uint32_t(data[5]) << 12) | (uint32_t(data[6]) << 4) | (uint32_t(data[7]) >> 4);
   uint32_t raw_pressure = (uint32_t(data[2]) << 12) | (uint32_t(data[3]) << 4) | (uint32_t(data[4]) >> 4);
   uint32_t raw_humidity = (uint32_t(data[8]) << 8) | uint32_t(data[9]);
-  uint16_t raw_gas = (uint16_t(data[13]) << 2) | (uint16_t(14) >> 6);
+  uint16_t raw_gas = (uint16_t(data[13]) << 2) | (uint16_t(data[14]) >> 6);
   uint8_t gas_range = data[14] & 0x0F;
 
   float temperature = this->calc_temperature_(raw_temperature);
@@ -323,6 +331,99 @@ void BME680Component::read_data_() {
   this->status_clear_warning();
 }
 
+#ifdef ARDUINO_ARCH_ESP8266
+// The integer formulas of Bosch's reference driver, the ESP8266 has no FPU and emulates every float operation.
+float BME680Component::calc_temperature_(uint32_t raw_temperature) {
+  const int32_t t1 = this->calibration_.t1;
+  const int32_t t2 = this->calibration_.t2;
+  const int32_t t3 = this->calibration_.t3;
+
+  int32_t var1 = (int32_t(raw_temperature) >> 3) - (t1 << 1);
+  int32_t var2 = (var1 * t2) >> 11;
+  int32_t var3 = ((var1 >> 1) * (var1 >> 1)) >> 12;
+  var3 = (var3 * (t3 << 4)) >> 14;
+  this->calibration_.tfine = var2 + var3;
+
+  const int32_t calc_temp = (this->calibration_.tfine * 5 + 128) >> 8;
+  return calc_temp / 100.0f;
+}
+float BME680Component::calc_pressure_(uint32_t raw_pressure) {
+  const int32_t p1 = this->calibration_.p1;
+  const int32_t p2 = this->calibration_.p2;
+  const int32_t p3 = this->calibration_.p3;
+  const int32_t p4 = this->calibration_.p4;
+  const int32_t p5 = this->calibration_.p5;
+  const int32_t p6 = this->calibration_.p6;
+  const int32_t p7 = this->calibration_.p7;
+  const int32_t p8 = this->calibration_.p8;
+  const int32_t p9 = this->calibration_.p9;
+  const int32_t p10 = this->calibration_.p10;
+
+  int32_t var1 = (this->calibration_.tfine >> 1) - 64000;
+  int32_t var2 = ((((var1 >> 2) * (var1 >> 2)) >> 11) * p6) >> 2;
+  var2 = var2 + ((var1 * p5) << 1);
+  var2 = (var2 >> 2) + (p4 << 16);
+  var1 = (((((var1 >> 2) * (var1 >> 2)) >> 13) * (p3 << 5)) >> 3) + ((p2 * var1) >> 1);
+  var1 = var1 >> 18;
+  var1 = ((32768 + var1) * p1) >> 15;
+
+  /* Avoid exception caused by division by zero */
+  if (var1 == 0)
+    return 0;
+
+  int32_t calc_pres = 1048576 - int32_t(raw_pressure);
+  calc_pres = int32_t((calc_pres - (var2 >> 12)) * uint32_t(3125));
+  if (calc_pres >= 0x40000000)
+    calc_pres = (calc_pres / var1) << 1;
+  else
+    calc_pres = (calc_pres << 1) / var1;
+  var1 = (p9 * int32_t(((calc_pres >> 3) * (calc_pres >> 3)) >> 13)) >> 12;
+  var2 = (int32_t(calc_pres >> 2) * p8) >> 13;
+  int32_t var3 = (int32_t(calc_pres >> 8) * int32_t(calc_pres >> 8) * int32_t(calc_pres >> 8) * p10) >> 17;
+  calc_pres = calc_pres + ((var1 + var2 + var3 + (p7 << 7)) >> 4);
+
+  return calc_pres / 100.0f;
+}
+float BME680Component::calc_humidity_(uint16_t raw_humidity) {
+  const int32_t h1 = this->calibration_.h1;
+  const int32_t h2 = this->calibration_.h2;
+  const int32_t h3 = this->calibration_.h3;
+  const int32_t h4 = this->calibration_.h4;
+  const int32_t h5 = this->calibration_.h5;
+  const int32_t h6 = this->calibration_.h6;
+  const int32_t h7 = this->calibration_.h7;
+
+  /* compensated temperature data in 0.01 °C */
+  const int32_t temp_scaled = (this->calibration_.tfine * 5 + 128) >> 8;
+
+  int32_t var1 = int32_t(raw_humidity) - h1 * 16 - (((temp_scaled * h3) / 100) >> 1);
+  int32_t var2 =
+      (h2 * (((temp_scaled * h4) / 100) + (((temp_scaled * ((temp_scaled * h5) / 100)) >> 6) / 100) + (1 << 14))) >> 10;
+  int32_t var3 = var1 * var2;
+  int32_t var4 = ((h6 << 7) + ((temp_scaled * h7) / 100)) >> 4;
+  int32_t var5 = ((var3 >> 14) * (var3 >> 14)) >> 10;
+  int32_t var6 = (var4 * var5) >> 1;
+  int32_t calc_hum = (((var3 + var6) >> 10) * 1000) >> 12;
+
+  if (calc_hum > 100000)
+    calc_hum = 100000;
+  else if (calc_hum < 0)
+    calc_hum = 0;
+
+  return calc_hum / 1000.0f;
+}
+uint32_t BME680Component::calc_gas_resistance_(uint16_t raw_gas, uint8_t range) {
+  const int64_t range_sw_err = this->calibration_.range_sw_err;
+  const int64_t lookup1 = BME680_GAS_LOOKUP_TABLE_1[range];
+  const int64_t lookup2 = BME680_GAS_LOOKUP_TABLE_2[range];
+
+  const int64_t var1 = ((1340 + 5 * range_sw_err) * lookup1) >> 16;
+  const int64_t var2 = (int64_t(raw_gas) << 15) - 16777216 + var1;
+  const int64_t var3 = (lookup2 * var1) >> 9;
+
+  return uint32_t((var3 + (var2 >> 1)) / var2);
+}
+#else
 float BME680Component::calc_temperature_(uint32_t raw_temperature) {
   float var1 = 0;
   float var2 = 0;
@@ -441,6 +542,7 @@ uint32_t BME680Component::calc_gas_resistance_(uint16_t raw_gas, uint8_t range)
 
   return static_cast<uint32_t>(calc_gas_res);
 }
+#endif
 uint32_t BME680Component::calc_meas_duration_() {
   uint32_t tph_dur;  // Calculate in us
   uint32_t meas_cycles;
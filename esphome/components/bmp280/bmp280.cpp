@@ -6,13 +6,17 @@ namespace bmp280 {
 
 static const char *TAG = "bmp280.sensor";
 
+static const uint8_t BMP280_REGISTER_CALIBRATION = 0x88;
+
+static const uint8_t BMP280_REGISTER_CHIPID = 0xD0;
+
 static const uint8_t BMP280_REGISTER_STATUS = 0xF3;
 static const uint8_t BMP280_REGISTER_CONTROL = 0xF4;
 static const uint8_t BMP280_REGISTER_CONFIG = 0xF5;
 static const uint8_t BMP280_REGISTER_PRESSUREDATA = 0xF7;
-static const uint8_t BMP280_REGISTER_TEMPDATA = 0xFA;
 
 static const uint8_t BMP280_MODE_FORCED = 0b01;
+static const uint8_t BMP280_MODE_NORMAL = 0b11;
 
 inline uint16_t combine_bytes(uint8_t msb, uint8_t lsb) { return ((msb & 0xFF) << 8) | (lsb & 0xFF); }
 
@@ -35,6 +39,29 @@ static const char *oversampling_to_str(BMP280Oversampling oversampling) {
   }
 }
 
+static const char *standby_time_to_str(BMP280StandbyTime standby_time) {
+  switch (standby_time) {
+    case BMP280_STANDBY_TIME_0_5MS:
+      return "0.5ms";
+    case BMP280_STANDBY_TIME_62_5MS:
+      return "62.5ms";
+    case BMP280_STANDBY_TIME_125MS:
+      return "125ms";
+    case BMP280_STANDBY_TIME_250MS:
+      return "250ms";
+    case BMP280_STANDBY_TIME_500MS:
+      return "500ms";
+    case BMP280_STANDBY_TIME_1000MS:
+      return "1000ms";
+    case BMP280_STANDBY_TIME_2000MS:
+      return "2000ms";
+    case BMP280_STANDBY_TIME_4000MS:
+      return "4000ms";
+    default:
+      return "UNKNOWN";
+  }
+}
+
 static const char *iir_filter_to_str(BMP280IIRFilter filter) {
   switch (filter) {
     case BMP280_IIR_FILTER_OFF:
@@ -55,7 +82,7 @@ static const char *iir_filter_to_str(BMP280IIRFilter filter) {
 void BMP280Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up BMP280...");
   uint8_t chip_id = 0;
-  if (!this->read_byte(0xD0, &chip_id)) {
+  if (!this->read_byte(BMP280_REGISTER_CHIPID, &chip_id)) {
     this->error_code_ = COMMUNICATION_FAILED;
     this->mark_failed();
     return;
@@ -66,20 +93,26 @@ void BMP280Component::setup() {
     return;
   }
 
-  // Read calibration
-  this->calibration_.t1 = this->read_u16_le_(0x88);
-  this->calibration_.t2 = this->read_s16_le_(0x8A);
-  this->calibration_.t3 = this->read_s16_le_(0x8C);
-
-  this->calibration_.p1 = this->read_u16_le_(0x8E);
-  this->calibration_.p2 = this->read_s16_le_(0x90);
-  this->calibration_.p3 = this->read_s16_le_(0x92);
-  this->calibration_.p4 = this->read_s16_le_(0x94);
-  this->calibration_.p5 = this->read_s16_le_(0x96);
-  this->calibration_.p6 = this->read_s16_le_(0x98);
-  this->calibration_.p7 = this->read_s16_le_(0x9A);
-  this->calibration_.p8 = this->read_s16_le_(0x9C);
-  this->calibration_.p9 = this->read_s16_le_(0x9E);
+  // Read calibration in one transaction instead of one per value
+  uint8_t cal[24];
+  if (!this->read_bytes(BMP280_REGISTER_CALIBRATION, cal, 24)) {
+    this->error_code_ = COMMUNICATION_FAILED;
+    this->mark_failed();
+    return;
+  }
+  this->calibration_.t1 = combine_bytes(cal[1], cal[0]);
+  this->calibration_.t2 = combine_bytes(cal[3], cal[2]);
+  this->calibration_.t3 = combine_bytes(cal[5], cal[4]);
+
+  this->calibration_.p1 = combine_bytes(cal[7], cal[6]);
+  this->calibration_.p2 = combine_bytes(cal[9], cal[8]);
+  this->calibration_.p3 = combine_bytes(cal[11], cal[10]);
+  this->calibration_.p4 = combine_bytes(cal[13], cal[12]);
+  this->calibration_.p5 = combine_bytes(cal[15], cal[14]);
+  this->calibration_.p6 = combine_bytes(cal[17], cal[16]);
+  this->calibration_.p7 = combine_bytes(cal[19], cal[18]);
+  this->calibration_.p8 = combine_bytes(cal[21], cal[20]);
+  this->calibration_.p9 = combine_bytes(cal[23], cal[22]);
 
   uint8_t config_register = 0;
   if (!this->read_byte(BMP280_REGISTER_CONFIG, &config_register)) {
@@ -87,12 +120,24 @@ void BMP280Component::setup() {
     return;
   }
   config_register &= ~0b11111100;
-  config_register |= 0b000 << 5;  // 0.5 ms standby time
+  config_register |= (this->standby_time_ & 0b111) << 5;
   config_register |= (this->iir_filter_ & 0b111) << 2;
   if (!this->write_byte(BMP280_REGISTER_CONFIG, config_register)) {
     this->mark_failed();
     return;
   }
+
+  if (this->normal_mode_) {
+    // the config register is only written reliably in sleep mode, so start measuring after it
+    uint8_t meas_register = 0;
+    meas_register |= (this->temperature_oversampling_ & 0b111) << 5;
+    meas_register |= (this->pressure_oversampling_ & 0b111) << 2;
+    meas_register |= BMP280_MODE_NORMAL;
+    if (!this->write_byte(BMP280_REGISTER_CONTROL, meas_register)) {
+      this->mark_failed();
+      return;
+    }
+  }
 }
 void BMP280Component::dump_config() {
   ESP_LOGCONFIG(TAG, "BMP280:");
@@ -109,6 +154,11 @@ void BMP280Component::dump_config() {
       break;
   }
   ESP_LOGCONFIG(TAG, "  IIR Filter: %s", iir_filter_to_str(this->iir_filter_));
+  if (this->normal_mode_) {
+    ESP_LOGCONFIG(TAG, "  Mode: Normal (standby time %s)", standby_time_to_str(this->standby_time_));
+  } else {
+    ESP_LOGCONFIG(TAG, "  Mode: Forced");
+  }
   LOG_UPDATE_INTERVAL(this);
 
   LOG_SENSOR("  ", "Temperature", this->temperature_sensor_);
@@ -121,12 +171,18 @@ float BMP280Component::get_setup_priority() const { return setup_priority::DATA;
 inline uint8_t oversampling_to_time(BMP280Oversampling over_sampling) { return (1 << uint8_t(over_sampling)) >> 1; }
 
 void BMP280Component::update() {
+  if (this->normal_mode_) {
+    // the sensor measures on its own, the data registers always hold the last complete measurement
+    this->read_data_();
+    return;
+  }
+
   // Enable sensor
   ESP_LOGV(TAG, "Sending conversion request...");
   uint8_t meas_register = 0;
   meas_register |= (this->temperature_oversampling_ & 0b111) << 5;
   meas_register |= (this->pressure_oversampling_ & 0b111) << 2;
-  meas_register |= 0b01;  // Forced mode
+  meas_register |= BMP280_MODE_FORCED;
   if (!this->write_byte(BMP280_REGISTER_CONTROL, meas_register)) {
     this->status_set_warning();
     return;
@@ -136,31 +192,35 @@ void BMP280Component::update() {
   meas_time += 2.3f * oversampling_to_time(this->temperature_oversampling_);
   meas_time += 2.3f * oversampling_to_time(this->pressure_oversampling_) + 0.575f;
 
-  this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() {
-    int32_t t_fine = 0;
-    float temperature = this->read_temperature_(&t_fine);
-    if (isnan(temperature)) {
-      ESP_LOGW(TAG, "Invalid temperature, cannot read pressure values.");
-      this->status_set_warning();
-      return;
-    }
-    float pressure = this->read_pressure_(t_fine);
-
-    ESP_LOGD(TAG, "Got temperature=%.1f°C pressure=%.1fhPa", temperature, pressure);
-    if (this->temperature_sensor_ != nullptr)
-      this->temperature_sensor_->publish_state(temperature);
-    if (this->pressure_sensor_ != nullptr)
-      this->pressure_sensor_->publish_state(pressure);
-    this->status_clear_warning();
-  });
+  this->set_timeout("data", uint32_t(ceilf(meas_time)), [this]() { this->read_data_(); });
 }
+void BMP280Component::read_data_() {
+  // pressure and temperature in one burst, the sensor keeps them from the same measurement while it's read
+  uint8_t data[6];
+  if (!this->read_bytes(BMP280_REGISTER_PRESSUREDATA, data, 6)) {
+    this->status_set_warning();
+    return;
+  }
+  const int32_t adc_pressure = (int32_t(data[0]) << 12) | (int32_t(data[1]) << 4) | (data[2] >> 4);
+  const int32_t adc_temperature = (int32_t(data[3]) << 12) | (int32_t(data[4]) << 4) | (data[5] >> 4);
 
-float BMP280Component::read_temperature_(int32_t *t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BMP280_REGISTER_TEMPDATA, data, 3))
-    return NAN;
-  int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
-  adc >>= 4;
+  int32_t t_fine = 0;
+  float temperature = this->compensate_temperature_(adc_temperature, &t_fine);
+  if (isnan(temperature)) {
+    ESP_LOGW(TAG, "Invalid temperature, cannot read pressure values.");
+    this->status_set_warning();
+    return;
+  }
+  float pressure = this->compensate_pressure_(adc_pressure, t_fine);
+
+  ESP_LOGD(TAG, "Got temperature=%.1f°C pressure=%.1fhPa", temperature, pressure);
+  if (this->temperature_sensor_ != nullptr)
+    this->temperature_sensor_->publish_state(temperature);
+  if (this->pressure_sensor_ != nullptr)
+    this->pressure_sensor_->publish_state(pressure);
+  this->status_clear_warning();
+}
+float BMP280Component::compensate_temperature_(int32_t adc, int32_t *t_fine) {
   if (adc == 0x80000)
     // temperature was disabled
     return NAN;
@@ -177,15 +237,46 @@ float BMP280Component::read_temperature_(int32_t *t_fine) {
   return temperature / 100.0f;
 }
 
-float BMP280Component::read_pressure_(int32_t t_fine) {
-  uint8_t data[3];
-  if (!this->read_bytes(BMP280_REGISTER_PRESSUREDATA, data, 3))
-    return NAN;
-  int32_t adc = ((data[0] & 0xFF) << 16) | ((data[1] & 0xFF) << 8) | (data[2] & 0xFF);
-  adc >>= 4;
+float BMP280Component::compensate_pressure_(int32_t adc, int32_t t_fine) {
   if (adc == 0x80000)
     // pressure was disabled
     return NAN;
+#ifdef ARDUINO_ARCH_ESP8266
+  // The 32 bit formula of the datasheet, within a few Pa of the 64 bit one. The ESP8266 has to emulate every 64 bit
+  // multiplication and division in software.
+  const int32_t p1 = this->calibration_.p1;
+  const int32_t p2 = this->calibration_.p2;
+  const int32_t p3 = this->calibration_.p3;
+  const int32_t p4 = this->calibration_.p4;
+  const int32_t p5 = this->calibration_.p5;
+  const int32_t p6 = this->calibration_.p6;
+  const int32_t p7 = this->calibration_.p7;
+  const int32_t p8 = this->calibration_.p8;
+  const int32_t p9 = this->calibration_.p9;
+
+  int32_t var1, var2;
+  uint32_t p;
+  var1 = (t_fine >> 1) - 64000;
+  var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * p6;
+  var2 = var2 + ((var1 * p5) << 1);
+  var2 = (var2 >> 2) + (p4 << 16);
+  var1 = (((p3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((p2 * var1) >> 1)) >> 18;
+  var1 = ((32768 + var1) * p1) >> 15;
+
+  if (var1 == 0)
+    return NAN;
+
+  p = (uint32_t(1048576 - adc) - (var2 >> 12)) * 3125;
+  if (p < 0x80000000)
+    p = (p << 1) / uint32_t(var1);
+  else
+    p = (p / uint32_t(var1)) * 2;
+  var1 = (p9 * int32_t(((p >> 3) * (p >> 3)) >> 13)) >> 12;
+  var2 = (int32_t(p >> 2) * p8) >> 13;
+
+  p = uint32_t(int32_t(p) + ((var1 + var2 + p7) >> 4));
+  return p / 100.0f;
+#else
   const int64_t p1 = this->calibration_.p1;
   const int64_t p2 = this->calibration_.p2;
   const int64_t p3 = this->calibration_.p3;
@@ -214,6 +305,7 @@ float BMP280Component::read_pressure_(int32_t t_fine) {
 
   p = ((p + var1 + var2) >> 8) + (p7 << 4);
   return (p / 256.0f) / 100.0f;
+#endif
 }
 void BMP280Component::set_temperature_oversampling(BMP280Oversampling temperature_over_sampling) {
   this->temperature_oversampling_ = temperature_over_sampling;
@@ -222,17 +314,10 @@ void BMP280Component::set_pressure_oversampling(BMP280Oversampling pressure_over
   this->pressure_oversampling_ = pressure_over_sampling;
 }
 void BMP280Component::set_iir_filter(BMP280IIRFilter iir_filter) { this->iir_filter_ = iir_filter; }
-uint8_t BMP280Component::read_u8_(uint8_t a_register) {
-  uint8_t data = 0;
-  this->read_byte(a_register, &data);
-  return data;
-}
-uint16_t BMP280Component::read_u16_le_(uint8_t a_register) {
-  uint16_t data = 0;
-  this->read_byte_16(a_register, &data);
-  return (data >> 8) | (data << 8);
+void BMP280Component::set_standby_time(BMP280StandbyTime standby_time) {
+  this->standby_time_ = standby_time;
+  this->normal_mode_ = true;
 }
-int16_t BMP280Component::read_s16_le_(uint8_t a_register) { return this->read_u16_le_(a_register); }
 
 }  // namespace bmp280
 }  // namespace esphome
@@ -50,6 +50,21 @@ enum BMP280IIRFilter {
   BMP280_IIR_FILTER_16X = 0b100,
 };
 
+/** Enum listing all standby times between two measurements in normal mode for the BMP280.
+ *
+ * In normal mode the sensor measures continuously on its own, so an update only has to read the latest result.
+ */
+enum BMP280StandbyTime {
+  BMP280_STANDBY_TIME_0_5MS = 0b000,
+  BMP280_STANDBY_TIME_62_5MS = 0b001,
+  BMP280_STANDBY_TIME_125MS = 0b010,
+  BMP280_STANDBY_TIME_250MS = 0b011,
+  BMP280_STANDBY_TIME_500MS = 0b100,
+  BMP280_STANDBY_TIME_1000MS = 0b101,
+  BMP280_STANDBY_TIME_2000MS = 0b110,
+  BMP280_STANDBY_TIME_4000MS = 0b111,
+};
+
 /// This class implements support for the BMP280 Temperature+Pressure i2c sensor.
 class BMP280Component : public PollingComponent, public i2c::I2CDevice {
  public:
@@ -62,6 +77,8 @@ class BMP280Component : public PollingComponent, public i2c::I2CDevice {
   void set_pressure_oversampling(BMP280Oversampling pressure_over_sampling);
   /// Set the IIR Filter used to increase accuracy, defaults to no IIR Filter.
   void set_iir_filter(BMP280IIRFilter iir_filter);
+  /// Measure continuously in normal mode with this standby time, instead of a forced measurement on every update.
+  void set_standby_time(BMP280StandbyTime standby_time);
 
   void setup() override;
   void dump_config() override;
@@ -69,18 +86,19 @@ class BMP280Component : public PollingComponent, public i2c::I2CDevice {
   void update() override;
 
  protected:
-  /// Read the temperature value and store the calculated ambient temperature in t_fine.
-  float read_temperature_(int32_t *t_fine);
-  /// Read the pressure value in hPa using the provided t_fine value.
-  float read_pressure_(int32_t t_fine);
-  uint8_t read_u8_(uint8_t a_register);
-  uint16_t read_u16_le_(uint8_t a_register);
-  int16_t read_s16_le_(uint8_t a_register);
+  /// Read all data registers in one transaction and publish the results.
+  void read_data_();
+  /// Calculate the temperature in °C from the raw ADC value and store the calculated ambient temperature in t_fine.
+  float compensate_temperature_(int32_t adc, int32_t *t_fine);
+  /// Calculate the pressure in hPa from the raw ADC value using the provided t_fine value.
+  float compensate_pressure_(int32_t adc, int32_t t_fine);
 
   BMP280CalibrationData calibration_;
   BMP280Oversampling temperature_oversampling_{BMP280_OVERSAMPLING_16X};
   BMP280Oversampling pressure_oversampling_{BMP280_OVERSAMPLING_16X};
   BMP280IIRFilter iir_filter_{BMP280_IIR_FILTER_OFF};
+  BMP280StandbyTime standby_time_{BMP280_STANDBY_TIME_0_5MS};
+  bool normal_mode_{false};
   sensor::Sensor *temperature_sensor_;
   sensor::Sensor *pressure_sensor_;
   enum ErrorCode {
@@ -7,6 +7,8 @@ from esphome.const import CONF_ID, CONF_PRESSURE, CONF_TEMPERATURE, \
 
 DEPENDENCIES = ['i2c']
 
+CONF_STANDBY_TIME = 'standby_time'
+
 bmp280_ns = cg.esphome_ns.namespace('bmp280')
 BMP280Oversampling = bmp280_ns.enum('BMP280Oversampling')
 OVERSAMPLING_OPTIONS = {
@@ -27,6 +29,27 @@ IIR_FILTER_OPTIONS = {
     '16X': BMP280IIRFilter.BMP280_IIR_FILTER_16X,
 }
 
+BMP280StandbyTime = bmp280_ns.enum('BMP280StandbyTime')
+STANDBY_TIME_OPTIONS = {
+    500: BMP280StandbyTime.BMP280_STANDBY_TIME_0_5MS,
+    62500: BMP280StandbyTime.BMP280_STANDBY_TIME_62_5MS,
+    125000: BMP280StandbyTime.BMP280_STANDBY_TIME_125MS,
+    250000: BMP280StandbyTime.BMP280_STANDBY_TIME_250MS,
+    500000: BMP280StandbyTime.BMP280_STANDBY_TIME_500MS,
+    1000000: BMP280StandbyTime.BMP280_STANDBY_TIME_1000MS,
+    2000000: BMP280StandbyTime.BMP280_STANDBY_TIME_2000MS,
+    4000000: BMP280StandbyTime.BMP280_STANDBY_TIME_4000MS,
+}
+
+
+def validate_standby_time(value):
+    value = cv.positive_time_period_microseconds(value)
+    if value.total_microseconds not in STANDBY_TIME_OPTIONS:
+        raise cv.Invalid(u"Standby time must be one of {}".format(
+            ', '.join('{:g}ms'.format(us / 1000.0) for us in sorted(STANDBY_TIME_OPTIONS))))
+    return STANDBY_TIME_OPTIONS[value.total_microseconds]
+
+
 BMP280Component = bmp280_ns.class_('BMP280Component', cg.PollingComponent, i2c.I2CDevice)
 
 CONFIG_SCHEMA = cv.Schema({
@@ -38,6 +61,7 @@ CONFIG_SCHEMA = cv.Schema({
         cv.Optional(CONF_OVERSAMPLING, default='16X'): cv.enum(OVERSAMPLING_OPTIONS, upper=True),
     }),
     cv.Optional(CONF_IIR_FILTER, default='OFF'): cv.enum(IIR_FILTER_OPTIONS, upper=True),
+    cv.Optional(CONF_STANDBY_TIME): validate_standby_time,
 }).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x77))
 
 
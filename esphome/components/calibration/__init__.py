@@ -0,0 +1,39 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+from esphome.core import coroutine
+from esphome.cpp_helpers import fnv1_hash
+
+CODEOWNERS = ['@esphome/core']
+
+CONF_CALIBRATION_ID = 'calibration_id'
+CONF_COMMIT_INTERVAL = 'commit_interval'
+
+calibration_ns = cg.esphome_ns.namespace('calibration')
+CalibrationStore = calibration_ns.class_('CalibrationStore', cg.Component)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(CalibrationStore),
+    cv.Optional(CONF_COMMIT_INTERVAL, default='1h'): cv.positive_time_period_milliseconds,
+}).extend(cv.COMPONENT_SCHEMA)
+
+# Components with a calibration state extend their schema with this, they use the store once it is configured.
+CALIBRATION_SCHEMA = cv.Schema({
+    cv.OnlyWith(CONF_CALIBRATION_ID, 'calibration'): cv.use_id(CalibrationStore),
+})
+
+
+@coroutine
+def register_calibration(var, config):
+    """Pass the store to the component with set_calibration_store(store, key), the key is the hash of its ID."""
+    if CONF_CALIBRATION_ID not in config:
+        return
+    store = yield cg.get_variable(config[CONF_CALIBRATION_ID])
+    cg.add(var.set_calibration_store(store, fnv1_hash(config[CONF_ID].id)))
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+    cg.add(var.set_commit_interval(config[CONF_COMMIT_INTERVAL]))
+    cg.add_define('USE_CALIBRATION')
@@ -0,0 +1,116 @@
+#include "calibration_store.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace calibration {
+
+static const char *TAG = "calibration";
+
+/// Increased whenever the layout of the record changes, older records are discarded.
+static const uint32_t CALIBRATION_RECORD_VERSION = 1;
+/// The version and the number of entries.
+static const size_t CALIBRATION_RECORD_HEADER = 2;
+
+void CalibrationEntry::save_words_(const uint32_t *words) {
+  if (this->valid_ && memcmp(this->data_.data(), words, this->data_.size() * 4) == 0)
+    return;
+  memcpy(this->data_.data(), words, this->data_.size() * 4);
+  this->valid_ = true;
+  this->store_->mark_dirty_();
+}
+
+CalibrationEntry *CalibrationStore::add_entry_(uint32_t key, size_t length_words) {
+  auto *entry = new CalibrationEntry();  // NOLINT(cppcoreguidelines-owning-memory)
+  entry->store_ = this;
+  entry->key_ = key;
+  entry->data_.resize(length_words);
+  this->entries_.push_back(entry);
+  return entry;
+}
+
+size_t CalibrationStore::record_length_() const {
+  size_t length = CALIBRATION_RECORD_HEADER;
+  for (auto *entry : this->entries_)
+    length += 2 + entry->data_.size();
+  return length;
+}
+
+void CalibrationStore::setup() {
+  const size_t length = this->record_length_();
+  this->rtc_ = global_preferences.make_preference(length, fnv1_hash("calibration"));
+  this->last_commit_ = millis();
+
+  std::vector<uint32_t> record(length);
+  if (!this->rtc_.load_words(record.data())) {
+    ESP_LOGD(TAG, "No calibration record stored");
+    return;
+  }
+  if (record[0] != CALIBRATION_RECORD_VERSION) {
+    ESP_LOGW(TAG, "Discarding calibration record of version %u", record[0]);
+    return;
+  }
+
+  // the entries are looked up by their key, so states survive when other components are added or removed
+  const uint32_t count = record[1];
+  size_t pos = CALIBRATION_RECORD_HEADER;
+  for (uint32_t i = 0; i < count && pos + 2 <= length; i++) {
+    const uint32_t key = record[pos];
+    const uint32_t words = record[pos + 1];
+    pos += 2;
+    if (pos + words > length)
+      break;
+    for (auto *entry : this->entries_) {
+      if (entry->key_ != key || entry->data_.size() != words)
+        continue;
+      memcpy(entry->data_.data(), &record[pos], words * 4);
+      entry->valid_ = true;
+      this->restored_++;
+    }
+    pos += words;
+  }
+}
+
+void CalibrationStore::dump_config() {
+  ESP_LOGCONFIG(TAG, "Calibration Store:");
+  ESP_LOGCONFIG(TAG, "  Entries: %zu (%u restored)", this->entries_.size(), this->restored_);
+  ESP_LOGCONFIG(TAG, "  Commit Interval: %u s", this->commit_interval_ / 1000);
+}
+
+void CalibrationStore::mark_dirty_() {
+  if (this->dirty_)
+    return;
+  this->dirty_ = true;
+  // batch the saves until a commit interval has passed since the last commit
+  const uint32_t since_commit = millis() - this->last_commit_;
+  const uint32_t delay = since_commit < this->commit_interval_ ? this->commit_interval_ - since_commit : 0;
+  this->set_timeout("commit", delay, [this]() { this->commit(); });
+}
+
+void CalibrationStore::commit() {
+  this->cancel_timeout("commit");
+  if (!this->dirty_)
+    return;
+  this->dirty_ = false;
+  this->last_commit_ = millis();
+
+  std::vector<uint32_t> record;
+  record.reserve(this->record_length_());
+  record.push_back(CALIBRATION_RECORD_VERSION);
+  record.push_back(this->entries_.size());
+  for (auto *entry : this->entries_) {
+    record.push_back(entry->key_);
+    record.push_back(entry->data_.size());
+    record.insert(record.end(), entry->data_.begin(), entry->data_.end());
+  }
+  if (this->rtc_.save_words(record.data())) {
+    ESP_LOGD(TAG, "Committed the calibration of %zu components", this->entries_.size());
+  } else {
+    ESP_LOGW(TAG, "Committing the calibration failed");
+  }
+}
+
+void CalibrationStore::on_shutdown() { this->commit(); }
+
+}  // namespace calibration
+}  // namespace esphome
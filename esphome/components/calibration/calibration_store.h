@@ -0,0 +1,84 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
+#include <cstring>
+#include <vector>
+
+namespace esphome {
+namespace calibration {
+
+class CalibrationStore;
+
+/// The calibration state of one component, like the baselines of a gas sensor, that survives reboots.
+class CalibrationEntry {
+ public:
+  /// Whether a state was restored at boot or has been saved since.
+  bool has_state() const { return this->valid_; }
+
+  template<typename T> bool load(T *dest) const {
+    if (!this->valid_)
+      return false;
+    memcpy(dest, this->data_.data(), sizeof(T));
+    return true;
+  }
+
+  /// Save the state, it is committed together with the states of the other components. Saving the same state again
+  /// costs nothing.
+  template<typename T> void save(const T &src) {
+    uint32_t words[(sizeof(T) + 3) / 4] = {};
+    memcpy(words, &src, sizeof(T));
+    this->save_words_(words);
+  }
+
+ protected:
+  friend CalibrationStore;
+
+  void save_words_(const uint32_t *words);
+
+  CalibrationStore *store_;
+  uint32_t key_;
+  std::vector<uint32_t> data_;
+  bool valid_{false};
+};
+
+/** Persists the calibration states of all components together in one versioned preference record.
+ *
+ * The record is read once at boot, before the components that registered with the store are set up. Saved states
+ * are only kept in memory until the next commit, which writes all states that have changed since the last one
+ * together, at most once per commit interval and once more before shutdown. So the flash isn't worn by every sensor
+ * writing its own preference whenever its baseline drifts a little.
+ *
+ * Record layout: version, number of entries, then the key, the length in words and the words of each entry.
+ */
+class CalibrationStore : public Component {
+ public:
+  /// Register the calibration state of a component before setup(), the key identifies it across reboots.
+  template<typename T> CalibrationEntry *add_entry(uint32_t key) { return this->add_entry_(key, (sizeof(T) + 3) / 4); }
+  void set_commit_interval(uint32_t commit_interval) { this->commit_interval_ = commit_interval; }
+
+  /// Write the states that have changed now.
+  void commit();
+
+  void setup() override;
+  void dump_config() override;
+  void on_shutdown() override;
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+ protected:
+  friend CalibrationEntry;
+
+  CalibrationEntry *add_entry_(uint32_t key, size_t length_words);
+  void mark_dirty_();
+  size_t record_length_() const;
+
+  std::vector<CalibrationEntry *> entries_;
+  ESPPreferenceObject rtc_;
+  uint32_t commit_interval_{3600000};
+  uint32_t last_commit_{0};
+  bool dirty_{false};
+  uint8_t restored_{0};
+};
+
+}  // namespace calibration
+}  // namespace esphome
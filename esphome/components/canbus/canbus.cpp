@@ -42,7 +42,14 @@ void Canbus::send_data(uint32_t can_id, bool use_extended_id, const std::vector<
     ESP_LOGVV(TAG, "  data[%d]=%02x", i, can_message.data[i]);
   }
 
-  this->send_message(&can_message);
+  // frames are sent in order, so a new one has to wait behind the queued ones
+  if (this->tx_queue_.empty() && this->send_message(&can_message) != canbus::ERROR_ALLTXBUSY)
+    return;
+  if (this->tx_queue_.size() >= CAN_TX_QUEUE_SIZE) {
+    ESP_LOGW(TAG, "Transmit queue full, dropping frame with id=0x%x", can_id);
+    return;
+  }
+  this->tx_queue_.push_back(can_message);
 }
 
 void Canbus::add_trigger(CanbusTrigger *trigger) {
@@ -51,13 +58,33 @@ void Canbus::add_trigger(CanbusTrigger *trigger) {
   } else {
     ESP_LOGVV(TAG, "add trigger for std canid=0x%03x", trigger->can_id_);
   }
-  this->triggers_.push_back(trigger);
+  this->triggers_[trigger_key_(trigger->can_id_, trigger->use_extended_id_)].push_back(trigger);
+  this->filters_dirty_ = true;
 };
 
 void Canbus::loop() {
+  if (this->filters_dirty_) {
+    // the triggers are set up after the bus, they are all registered by the first loop
+    this->filters_dirty_ = false;
+    std::vector<uint32_t> standard_ids;
+    std::vector<uint32_t> extended_ids;
+    for (const auto &it : this->triggers_) {
+      const CanbusTrigger *trigger = it.second.front();
+      if (trigger->use_extended_id_) {
+        extended_ids.push_back(trigger->can_id_);
+      } else {
+        standard_ids.push_back(trigger->can_id_);
+      }
+    }
+    this->setup_filters(standard_ids, extended_ids);
+  }
+
+  while (!this->tx_queue_.empty() && this->send_message(&this->tx_queue_.front()) != canbus::ERROR_ALLTXBUSY)
+    this->tx_queue_.pop_front();
+
   struct CanFrame can_message;
-  // readmessage
-  if (this->read_message(&can_message) == canbus::ERROR_OK) {
+  // drain the receive buffers of the controller, but not forever on a busy bus
+  for (uint8_t i = 0; i < 8 && this->read_message(&can_message) == canbus::ERROR_OK; i++) {
     if (can_message.use_extended_id) {
       ESP_LOGD(TAG, "received can message extended can_id=0x%x size=%d", can_message.can_id,
                can_message.can_data_length_code);
@@ -66,20 +93,19 @@ void Canbus::loop() {
                can_message.can_data_length_code);
     }
 
-    std::vector<uint8_t> data;
+    auto it = this->triggers_.find(trigger_key_(can_message.can_id, can_message.use_extended_id));
+    if (it == this->triggers_.end())
+      continue;
 
+    std::vector<uint8_t> data(can_message.data, can_message.data + can_message.can_data_length_code);
     // show data received
-    for (int i = 0; i < can_message.can_data_length_code; i++) {
-      ESP_LOGV(TAG, "  can_message.data[%d]=%02x", i, can_message.data[i]);
-      data.push_back(can_message.data[i]);
+    for (int j = 0; j < can_message.can_data_length_code; j++) {
+      ESP_LOGV(TAG, "  can_message.data[%d]=%02x", j, can_message.data[j]);
     }
 
     // fire all triggers
-    for (auto trigger : this->triggers_) {
-      if ((trigger->can_id_ == can_message.can_id) && (trigger->use_extended_id_ == can_message.use_extended_id)) {
-        trigger->trigger(data);
-      }
-    }
+    for (auto trigger : it->second)
+      trigger->trigger(data);
   }
 }
 
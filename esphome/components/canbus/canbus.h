@@ -3,6 +3,8 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/optional.h"
+#include <deque>
+#include <unordered_map>
 
 namespace esphome {
 namespace canbus {
@@ -40,6 +42,8 @@ template<typename... Ts> class CanbusSendAction;
 
 /* CAN payload length definitions according to ISO 11898-1 */
 static const uint8_t CAN_MAX_DATA_LENGTH = 8;
+/// The most frames waiting for a free transmit buffer of the controller.
+static const uint8_t CAN_TX_QUEUE_SIZE = 16;
 
 /*
 Can Frame describes a normative CAN Frame
@@ -71,14 +75,25 @@ class Canbus : public Component {
 
  protected:
   template<typename... Ts> friend class CanbusSendAction;
-  std::vector<CanbusTrigger *> triggers_{};
+  static uint32_t trigger_key_(uint32_t can_id, bool use_extended_id) {
+    return use_extended_id ? (can_id | 0x80000000UL) : can_id;
+  }
+
+  /// The triggers of each CAN ID, the extended IDs have their highest bit set.
+  std::unordered_map<uint32_t, std::vector<CanbusTrigger *>> triggers_{};
+  bool filters_dirty_{false};
+  std::deque<CanFrame> tx_queue_{};
   uint32_t can_id_;
   bool use_extended_id_;
   CanSpeed bit_rate_;
 
   virtual bool setup_internal();
+  /// Send a frame, ERROR_ALLTXBUSY queues it until a transmit buffer is free.
   virtual Error send_message(struct CanFrame *frame);
+  /// Read one received frame, ERROR_NOMSG if there is none.
   virtual Error read_message(struct CanFrame *frame);
+  /// Let the controller only receive the IDs of the triggers, called once all triggers are registered.
+  virtual void setup_filters(const std::vector<uint32_t> &standard_ids, const std::vector<uint32_t> &extended_ids) {}
 };
 
 template<typename... Ts> class CanbusSendAction : public Action<Ts...>, public Parented<Canbus> {
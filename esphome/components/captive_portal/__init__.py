@@ -1,9 +1,11 @@
+import os
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import web_server_base
-from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID, gzip_asset
 from esphome.const import CONF_ID
-from esphome.core import coroutine_with_priority
+from esphome.core import ID, coroutine_with_priority
 
 AUTO_LOAD = ['web_server_base']
 DEPENDENCIES = ['wifi']
@@ -17,6 +19,16 @@ CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(web_server_base.WebServerBase),
 }).extend(cv.COMPONENT_SCHEMA)
 
+# The files of the portal next to this file, served gzip-compressed under their name
+ASSETS = [
+    ('stylesheet.css', 'text/css'),
+    ('lock.svg', 'image/svg+xml'),
+    ('wifi-strength-1.svg', 'image/svg+xml'),
+    ('wifi-strength-2.svg', 'image/svg+xml'),
+    ('wifi-strength-3.svg', 'image/svg+xml'),
+    ('wifi-strength-4.svg', 'image/svg+xml'),
+]
+
 
 @coroutine_with_priority(64.0)
 def to_code(config):
@@ -24,4 +36,9 @@ def to_code(config):
 
     var = cg.new_Pvariable(config[CONF_ID], paren)
     yield cg.register_component(var, config)
+
+    for i, (name, content_type) in enumerate(ASSETS):
+        data_id = ID('captive_portal_asset_{}'.format(i), is_declaration=True, type=cg.uint8)
+        path = os.path.join(os.path.dirname(__file__), name)
+        cg.add(var.add_asset('/' + name, content_type, *gzip_asset(data_id, path)))
     cg.add_define('USE_CAPTIVE_PORTAL')
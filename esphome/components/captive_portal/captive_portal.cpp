@@ -2,61 +2,114 @@
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include "esphome/components/wifi/wifi_component.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 namespace esphome {
 namespace captive_portal {
 
 static const char *TAG = "captive_portal";
 
-void CaptivePortal::handle_index(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/html");
-  stream->print(F("<!DOCTYPE html><html lang=\"en\"><head><meta charset=\"UTF-8\"><meta name=\"viewport\" "
-                  "content=\"width=device-width,initial-scale=1,user-scalable=no\"/><title>"));
-  stream->print(App.get_name().c_str());
-  stream->print(F("</title><link rel=\"stylesheet\" href=\"/stylesheet.css\">"));
-  stream->print(F("<script>function c(l){document.getElementById('ssid').value=l.innerText||l.textContent; "
-                  "document.getElementById('psk').focus();}</script>"));
-  stream->print(F("</head>"));
-  stream->print(F("<body><div class=\"main\"><h1>WiFi Networks</h1>"));
-
-  if (request->hasArg("save")) {
-    stream->print(F("<div class=\"info\">The ESP will now try to connect to the network...<br/>Please give it some "
-                    "time to connect.<br/>Note: Copy the changed network to your YAML file - the next OTA update will "
-                    "overwrite these settings.</div>"));
+/// Requests of operating systems checking for a captive portal, answered with a redirect to it right away.
+static const char *const CAPTIVE_DETECTION_URLS[] = {
+    // Android
+    "/generate_204",
+    "/gen_204",
+    // Apple
+    "/hotspot-detect.html",
+    "/library/test/success.html",
+    // Windows
+    "/connecttest.txt",
+    "/ncsi.txt",
+    "/redirect",
+    // Firefox
+    "/canonical.html",
+    "/success.txt",
+};
+
+void CaptivePortal::render_index_(String &out, bool saved) {
+  out += F("<!DOCTYPE html><html lang=\"en\"><head><meta charset=\"UTF-8\"><meta name=\"viewport\" "
+           "content=\"width=device-width,initial-scale=1,user-scalable=no\"/><title>");
+  out += App.get_name().c_str();
+  out += F("</title><link rel=\"stylesheet\" href=\"/stylesheet.css\">");
+  out += F("<script>function c(l){document.getElementById('ssid').value=l.innerText||l.textContent; "
+           "document.getElementById('psk').focus();}</script>");
+  out += F("</head>");
+  out += F("<body><div class=\"main\"><h1>WiFi Networks</h1>");
+
+  if (saved) {
+    out += F("<div class=\"info\">The ESP will now try to connect to the network...<br/>Please give it some "
+             "time to connect.<br/>Note: Copy the changed network to your YAML file - the next OTA update will "
+             "overwrite these settings.</div>");
   }
 
   for (auto &scan : wifi::global_wifi_component->get_scan_result()) {
     if (scan.get_is_hidden())
       continue;
 
-    stream->print(F("<div class=\"network\" onclick=\"c(this)\"><a href=\"#\" class=\"network-left\">"));
+    out += F("<div class=\"network\" onclick=\"c(this)\"><a href=\"#\" class=\"network-left\">");
 
     if (scan.get_rssi() >= -50) {
-      stream->print(F("<img src=\"/wifi-strength-4.svg\">"));
+      out += F("<img src=\"/wifi-strength-4.svg\">");
     } else if (scan.get_rssi() >= -65) {
-      stream->print(F("<img src=\"/wifi-strength-3.svg\">"));
+      out += F("<img src=\"/wifi-strength-3.svg\">");
     } else if (scan.get_rssi() >= -85) {
-      stream->print(F("<img src=\"/wifi-strength-2.svg\">"));
+      out += F("<img src=\"/wifi-strength-2.svg\">");
     } else {
-      stream->print(F("<img src=\"/wifi-strength-1.svg\">"));
+      out += F("<img src=\"/wifi-strength-1.svg\">");
     }
 
-    stream->print(F("<span class=\"network-ssid\">"));
-    stream->print(scan.get_ssid().c_str());
-    stream->print(F("</span></a>"));
+    out += F("<span class=\"network-ssid\">");
+    out += scan.get_ssid().c_str();
+    out += F("</span></a>");
     if (scan.get_with_auth()) {
-      stream->print(F("<img src=\"/lock.svg\">"));
+      out += F("<img src=\"/lock.svg\">");
     }
-    stream->print(F("</div>"));
+    out += F("</div>");
+  }
+
+  out += F("<h3>WiFi Settings</h3><form method=\"GET\" action=\"/wifisave\"><input id=\"ssid\" name=\"ssid\" "
+           "length=32 placeholder=\"SSID\"><br/><input id=\"psk\" name=\"psk\" length=64 type=\"password\" "
+           "placeholder=\"Password\"><br/><br/><button type=\"submit\">Save</button></form><br><hr><br>");
+  out += F("<h1>OTA Update</h1><form method=\"POST\" action=\"/update\" enctype=\"multipart/form-data\"><input "
+           "type=\"file\" name=\"update\"><button type=\"submit\">Update</button></form>");
+  out += F("</div></body></html>");
+}
+void CaptivePortal::handle_index(AsyncWebServerRequest *request) {
+  if (request->hasArg("save")) {
+    // only shown once after saving the network, not worth caching
+    String page;
+    this->render_index_(page, true);
+    request->send(200, "text/html", page);
+    return;
+  }
+
+  // phones request the page again and again, it only changes with the scan result
+  const uint32_t generation = wifi::global_wifi_component->get_scan_generation();
+  if (this->index_html_ == nullptr || generation != this->index_generation_) {
+    // responses that are still being sent keep the previous page
+    auto page = std::make_shared<String>();
+    this->render_index_(*page, false);
+    sprintf(this->index_etag_, "\"%08x\"", fnv1_hash(page->c_str(), page->length()));
+    this->index_html_ = page;
+    this->index_generation_ = generation;
+  }
+  if (web_server_base::etag_matches(request, this->index_etag_)) {
+    web_server_base::send_not_modified(request, this->index_etag_);
+    return;
   }
 
-  stream->print(F("<h3>WiFi Settings</h3><form method=\"GET\" action=\"/wifisave\"><input id=\"ssid\" name=\"ssid\" "
-                  "length=32 placeholder=\"SSID\"><br/><input id=\"psk\" name=\"psk\" length=64 type=\"password\" "
-                  "placeholder=\"Password\"><br/><br/><button type=\"submit\">Save</button></form><br><hr><br>"));
-  stream->print(F("<h1>OTA Update</h1><form method=\"POST\" action=\"/update\" enctype=\"multipart/form-data\"><input "
-                  "type=\"file\" name=\"update\"><button type=\"submit\">Update</button></form>"));
-  stream->print(F("</div></body></html>"));
-  request->send(stream);
+  std::shared_ptr<String> page = this->index_html_;
+  AsyncWebServerResponse *response = request->beginResponse(
+      "text/html", page->length(), [page](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        const size_t len = std::min(max_len, page->length() - index);
+        memcpy(buffer, page->c_str() + index, len);
+        return len;
+      });
+  response->addHeader("ETag", this->index_etag_);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
 }
 void CaptivePortal::handle_wifisave(AsyncWebServerRequest *request) {
   std::string ssid = request->arg("ssid").c_str();
@@ -97,16 +150,15 @@ void CaptivePortal::start() {
     this->base_->add_ota_handler();
   }
 
-  this->dns_server_ = new DNSServer();
-  this->dns_server_->setErrorReplyCode(DNSReplyCode::NoError);
   IPAddress ip = wifi::global_wifi_component->wifi_soft_ap_ip();
-  this->dns_server_->start(53, "*", ip);
+  this->dns_.start(ip);
+  this->portal_url_ = "http://" + ip.toString();
 
   this->base_->get_server()->onNotFound([this](AsyncWebServerRequest *req) {
     bool not_found = false;
     if (!this->active_) {
       not_found = true;
-    } else if (req->host() == wifi::global_wifi_component->wifi_soft_ap_ip().toString()) {
+    } else if (req->host() == this->portal_url_.substring(7)) {
       not_found = true;
     }
 
@@ -115,51 +167,51 @@ void CaptivePortal::start() {
       return;
     }
 
-    auto url = "http://" + wifi::global_wifi_component->wifi_soft_ap_ip().toString();
-    req->redirect(url);
+    req->redirect(this->portal_url_);
   });
 
   this->initialized_ = true;
   this->active_ = true;
 }
 
-const char STYLESHEET_CSS[] PROGMEM =
-    R"(*{box-sizing:inherit}div,input{padding:5px;font-size:1em}input{width:95%}body{text-align:center;font-family:sans-serif}button{border:0;border-radius:.3rem;background-color:#1fa3ec;color:#fff;line-height:2.4rem;font-size:1.2rem;width:100%;padding:0}.main{text-align:left;display:inline-block;min-width:260px}.network{display:flex;justify-content:space-between;align-items:center}.network-left{display:flex;align-items:center}.network-ssid{margin-bottom:-7px;margin-left:10px}.info{border:1px solid;margin:10px 0;padding:15px 10px;color:#4f8a10;background-color:#dff2bf})";
-const char LOCK_SVG[] PROGMEM =
-    R"(<svg xmlns="http://www.w3.org/2000/svg" width="16" height="16" viewBox="0 0 24 24"><path d="M12 17a2 2 0 0 0 2-2 2 2 0 0 0-2-2 2 2 0 0 0-2 2 2 2 0 0 0 2 2m6-9a2 2 0 0 1 2 2v10a2 2 0 0 1-2 2H6a2 2 0 0 1-2-2V10a2 2 0 0 1 2-2h1V6a5 5 0 0 1 5-5 5 5 0 0 1 5 5v2h1m-6-5a3 3 0 0 0-3 3v2h6V6a3 3 0 0 0-3-3z"/></svg>)";
+bool CaptivePortal::canHandle(AsyncWebServerRequest *request) {
+  if (!this->active_ || request->method() != HTTP_GET)
+    return false;
+
+  const String &url = request->url();
+  if (url == "/" || url == "/wifisave" || this->find_asset_(url) != nullptr)
+    return true;
+  for (const char *detection_url : CAPTIVE_DETECTION_URLS) {
+    if (url == detection_url)
+      return true;
+  }
+  return false;
+}
+const CaptivePortalAsset *CaptivePortal::find_asset_(const String &url) const {
+  for (auto &asset : this->assets_) {
+    if (url == asset.url)
+      return &asset;
+  }
+  return nullptr;
+}
 
 void CaptivePortal::handleRequest(AsyncWebServerRequest *req) {
-  if (req->url() == "/") {
+  const String &url = req->url();
+  if (url == "/") {
     this->handle_index(req);
     return;
-  } else if (req->url() == "/wifisave") {
+  } else if (url == "/wifisave") {
     this->handle_wifisave(req);
     return;
-  } else if (req->url() == "/stylesheet.css") {
-    req->send_P(200, "text/css", STYLESHEET_CSS);
-    return;
-  } else if (req->url() == "/lock.svg") {
-    req->send_P(200, "image/svg+xml", LOCK_SVG);
-    return;
   }
 
-  AsyncResponseStream *stream = req->beginResponseStream("image/svg+xml");
-  stream->print(F("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"24\" height=\"24\"><path d=\"M12 3A18.9 18.9 0 0 "
-                  "0 .38 7C4.41 12.06 7.89 16.37 12 21.5L23.65 7C20.32 4.41 16.22 3 12 "));
-  if (req->url() == "/wifi-strength-4.svg") {
-    stream->print(F("3z"));
-  } else {
-    if (req->url() == "/wifi-strength-1.svg") {
-      stream->print(F("3m0 2c3.07 0 6.09.86 8.71 2.45l-5.1 6.36a8.43 8.43 0 0 0-7.22-.01L3.27 7.4"));
-    } else if (req->url() == "/wifi-strength-2.svg") {
-      stream->print(F("3m0 2c3.07 0 6.09.86 8.71 2.45l-3.21 3.98a11.32 11.32 0 0 0-11 0L3.27 7.4"));
-    } else if (req->url() == "/wifi-strength-3.svg") {
-      stream->print(F("3m0 2c3.07 0 6.09.86 8.71 2.45l-1.94 2.43A13.6 13.6 0 0 0 12 8C9 8 6.68 9 5.21 9.84l-1.94-2."));
-    }
-    stream->print(F("4A16.94 16.94 0 0 1 12 5z"));
+  const CaptivePortalAsset *asset = this->find_asset_(url);
+  if (asset != nullptr) {
+    web_server_base::send_gzip_asset(req, asset->content_type, asset->data, asset->size, asset->etag);
+    return;
   }
-  stream->print(F("\"/></svg>"));
-  req->send(stream);
+  // a captive portal detection, a redirect makes the operating system open the portal
+  req->redirect(this->portal_url_);
 }
 CaptivePortal::CaptivePortal(web_server_base::WebServerBase *base) : base_(base) { global_captive_portal = this; }
 float CaptivePortal::get_setup_priority() const {
@@ -1,10 +1,12 @@
 #pragma once
 
-#include <DNSServer.h>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
 #include "esphome/components/web_server_base/web_server_base.h"
+#include "dns_responder.h"
+#include <memory>
+#include <vector>
 
 namespace esphome {
 
@@ -15,51 +17,35 @@ struct CaptivePortalSettings {
   char password[65];
 } PACKED;  // NOLINT
 
+/// A file of the portal, gzip-compressed at build time.
+struct CaptivePortalAsset {
+  const char *url;
+  const char *content_type;
+  const uint8_t *data;
+  size_t size;
+  const char *etag;
+};
+
 class CaptivePortal : public AsyncWebHandler, public Component {
  public:
   CaptivePortal(web_server_base::WebServerBase *base);
   void setup() override;
   void dump_config() override;
-  void loop() override {
-    if (this->dns_server_ != nullptr)
-      this->dns_server_->processNextRequest();
-  }
+  void loop() override { this->dns_.process(); }
   float get_setup_priority() const override;
   void start();
   bool is_active() const { return this->active_; }
   void end() {
     this->active_ = false;
     this->base_->deinit();
-    this->dns_server_->stop();
-    delete this->dns_server_;
+    this->dns_.stop();
   }
-
-  bool canHandle(AsyncWebServerRequest *request) override {
-    if (!this->active_)
-      return false;
-
-    if (request->method() == HTTP_GET) {
-      if (request->url() == "/")
-        return true;
-      if (request->url() == "/stylesheet.css")
-        return true;
-      if (request->url() == "/wifi-strength-1.svg")
-        return true;
-      if (request->url() == "/wifi-strength-2.svg")
-        return true;
-      if (request->url() == "/wifi-strength-3.svg")
-        return true;
-      if (request->url() == "/wifi-strength-4.svg")
-        return true;
-      if (request->url() == "/lock.svg")
-        return true;
-      if (request->url() == "/wifisave")
-        return true;
-    }
-
-    return false;
+  void add_asset(const char *url, const char *content_type, const uint8_t *data, size_t size, const char *etag) {
+    this->assets_.push_back({url, content_type, data, size, etag});
   }
 
+  bool canHandle(AsyncWebServerRequest *request) override;
+
   void handle_index(AsyncWebServerRequest *request);
 
   void handle_wifisave(AsyncWebServerRequest *request);
@@ -68,12 +54,21 @@ class CaptivePortal : public AsyncWebHandler, public Component {
 
  protected:
   void override_sta_(const std::string &ssid, const std::string &password);
+  const CaptivePortalAsset *find_asset_(const String &url) const;
+  void render_index_(String &out, bool saved);
 
   web_server_base::WebServerBase *base_;
   bool initialized_{false};
   bool active_{false};
   ESPPreferenceObject pref_;
-  DNSServer *dns_server_{nullptr};
+  DNSResponder dns_;
+  std::vector<CaptivePortalAsset> assets_;
+  /// The URL clients are redirected to, the root of the access point.
+  String portal_url_;
+  /// The index page for the scan result of index_generation_, rendered once for all requests.
+  std::shared_ptr<String> index_html_;
+  uint32_t index_generation_{0};
+  char index_etag_[11];
 };
 
 extern CaptivePortal *global_captive_portal;
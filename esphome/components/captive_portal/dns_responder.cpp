@@ -0,0 +1,89 @@
+#include "dns_responder.h"
+#include "esphome/core/log.h"
+#include <cstring>
+
+namespace esphome {
+namespace captive_portal {
+
+static const char *TAG = "captive_portal.dns";
+
+static const uint16_t DNS_PORT = 53;
+/// The header of a DNS message, the question follows it.
+static const size_t DNS_HEADER_SIZE = 12;
+/// A flood of queries doesn't block the loop for longer than this many answers.
+static const uint8_t DNS_MAX_QUERIES_PER_LOOP = 16;
+/// The answer record up to its data: a pointer to the name in the question, type A, class IN, a TTL of 60 s and the
+/// length of the IP.
+static const uint8_t DNS_A_RECORD[] = {0xC0, 0x0C, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x3C, 0x00, 0x04};
+
+void DNSResponder::start(const IPAddress &ip) {
+  this->ip_ = ip;
+  this->started_ = this->udp_.begin(DNS_PORT) != 0;
+  if (!this->started_)
+    ESP_LOGW(TAG, "Listening on port %u failed", DNS_PORT);
+}
+
+void DNSResponder::stop() {
+  this->udp_.stop();
+  this->started_ = false;
+}
+
+void DNSResponder::process() {
+  if (!this->started_)
+    return;
+  for (uint8_t i = 0; i < DNS_MAX_QUERIES_PER_LOOP; i++) {
+    const int size = this->udp_.parsePacket();
+    if (size <= 0)
+      return;
+    // larger messages aren't queries of a client looking for the portal, the next parsePacket() drops them
+    if (size > static_cast<int>(sizeof(this->buffer_)))
+      continue;
+    this->udp_.read(this->buffer_, size);
+    const size_t answer_size = this->build_answer_(size);
+    if (answer_size == 0)
+      continue;
+    this->udp_.beginPacket(this->udp_.remoteIP(), this->udp_.remotePort());
+    this->udp_.write(this->buffer_, answer_size);
+    this->udp_.endPacket();
+  }
+}
+
+size_t DNSResponder::build_answer_(size_t size) {
+  uint8_t *msg = this->buffer_;
+  // only standard queries with a single question
+  if (size < DNS_HEADER_SIZE || (msg[2] & 0xF8) != 0 || msg[4] != 0 || msg[5] != 1)
+    return 0;
+
+  // the name is a sequence of labels up to an empty one, questions don't use compression
+  size_t pos = DNS_HEADER_SIZE;
+  while (pos < size && msg[pos] != 0) {
+    if ((msg[pos] & 0xC0) != 0)
+      return 0;
+    pos += msg[pos] + 1;
+  }
+  // the empty label, type and class
+  pos += 5;
+  if (pos > size)
+    return 0;
+  const uint16_t type = (msg[pos - 4] << 8) | msg[pos - 3];
+  const uint16_t klass = ((msg[pos - 2] << 8) | msg[pos - 1]) & 0x7FFF;
+
+  // a response without error from an authoritative server, the records after the question are dropped
+  msg[2] = 0x84 | (msg[2] & 0x01);
+  msg[3] = 0x00;
+  memset(&msg[6], 0, 6);
+  if (type != 1 || klass != 1)
+    return pos;
+  if (pos + sizeof(DNS_A_RECORD) + 4 > sizeof(this->buffer_))
+    return 0;
+
+  msg[7] = 1;
+  memcpy(&msg[pos], DNS_A_RECORD, sizeof(DNS_A_RECORD));
+  pos += sizeof(DNS_A_RECORD);
+  for (uint8_t i = 0; i < 4; i++)
+    msg[pos++] = this->ip_[i];
+  return pos;
+}
+
+}  // namespace captive_portal
+}  // namespace esphome
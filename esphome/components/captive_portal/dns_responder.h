@@ -0,0 +1,32 @@
+#pragma once
+
+#include <IPAddress.h>
+#include <WiFiUdp.h>
+
+namespace esphome {
+namespace captive_portal {
+
+/** Answers every DNS query of the clients of the access point with its own IP.
+ *
+ * While a phone checks for a captive portal it fires bursts of queries, and DNSServer answers one per loop iteration.
+ * This answers all queries that are pending, A queries with the IP and all other types without records.
+ */
+class DNSResponder {
+ public:
+  void start(const IPAddress &ip);
+  void stop();
+  /// Answer the pending queries.
+  void process();
+
+ protected:
+  /// Turn the query in buffer_ into the answer, returns its size or 0 if it isn't answered.
+  size_t build_answer_(size_t size);
+
+  WiFiUDP udp_;
+  IPAddress ip_;
+  uint8_t buffer_[512];
+  bool started_{false};
+};
+
+}  // namespace captive_portal
+}  // namespace esphome
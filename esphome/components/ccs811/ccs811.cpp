@@ -18,6 +18,11 @@ static const char *TAG = "ccs811";
 
 #define CHECKED_IO(f) CHECK_TRUE(f, COMMUNICAITON_FAILED)
 
+#ifdef USE_CALIBRATION
+/// The baseline the sensor learned is only saved once it has run this long (20 minutes per the datasheet).
+static const uint32_t CCS811_BASELINE_WARM_UP = 20 * 60 * 1000;
+#endif
+
 void CCS811Component::setup() {
   // page 9 programming guide - hwid is always 0x81
   uint8_t hw_id;
@@ -47,6 +52,14 @@ void CCS811Component::setup() {
 
   CHECKED_IO(this->write_byte(0x01, meas_mode))
 
+#ifdef USE_CALIBRATION
+  uint16_t restored_baseline;
+  if (!this->baseline_.has_value() && this->calibration_ != nullptr && this->calibration_->load(&restored_baseline)) {
+    ESP_LOGD(TAG, "Restored baseline 0x%04X", restored_baseline);
+    this->baseline_ = restored_baseline;
+  }
+#endif
+
   if (this->baseline_.has_value()) {
     // baseline available, write to sensor
     this->write_bytes(0x11, decode_uint16(*this->baseline_));
@@ -75,6 +88,10 @@ void CCS811Component::update() {
   }
 
   ESP_LOGD(TAG, "Got co2=%u ppm, tvoc=%u ppb, baseline=0x%04X", co2, tvoc, baseline);
+#ifdef USE_CALIBRATION
+  if (this->calibration_ != nullptr && baseline_data.has_value() && millis() > CCS811_BASELINE_WARM_UP)
+    this->calibration_->save(baseline);
+#endif
 
   if (this->co2_ != nullptr)
     this->co2_->publish_state(co2);
@@ -4,6 +4,11 @@
 #include "esphome/core/preferences.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/core/defines.h"
+
+#ifdef USE_CALIBRATION
+#include "esphome/components/calibration/calibration_store.h"
+#endif
 
 namespace esphome {
 namespace ccs811 {
@@ -15,6 +20,12 @@ class CCS811Component : public PollingComponent, public i2c::I2CDevice {
   void set_baseline(uint16_t baseline) { baseline_ = baseline; }
   void set_humidity(sensor::Sensor *humidity) { humidity_ = humidity; }
   void set_temperature(sensor::Sensor *temperature) { temperature_ = temperature; }
+#ifdef USE_CALIBRATION
+  /// Keep the baseline the sensor learned across reboots, when no baseline is configured.
+  void set_calibration_store(calibration::CalibrationStore *store, uint32_t key) {
+    this->calibration_ = store->add_entry<uint16_t>(key);
+  }
+#endif
 
   /// Setup the sensor and test for a connection.
   void setup() override;
@@ -44,6 +55,9 @@ class CCS811Component : public PollingComponent, public i2c::I2CDevice {
   sensor::Sensor *co2_{nullptr};
   sensor::Sensor *tvoc_{nullptr};
   optional<uint16_t> baseline_{};
+#ifdef USE_CALIBRATION
+  calibration::CalibrationEntry *calibration_{nullptr};
+#endif
   /// Input sensor for humidity reading.
   sensor::Sensor *humidity_{nullptr};
   /// Input sensor for temperature reading.
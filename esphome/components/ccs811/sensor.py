@@ -1,6 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import i2c, sensor
+from esphome.components import calibration, i2c, sensor
 from esphome.const import CONF_ID, ICON_RADIATOR, UNIT_PARTS_PER_MILLION, \
     UNIT_PARTS_PER_BILLION, CONF_TEMPERATURE, CONF_HUMIDITY, ICON_MOLECULE_CO2
 
@@ -22,13 +22,15 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_BASELINE): cv.hex_uint16_t,
     cv.Optional(CONF_TEMPERATURE): cv.use_id(sensor.Sensor),
     cv.Optional(CONF_HUMIDITY): cv.use_id(sensor.Sensor),
-}).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x5A))
+}).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x5A)).extend(
+    calibration.CALIBRATION_SCHEMA)
 
 
 def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
     yield i2c.register_i2c_device(var, config)
+    yield calibration.register_calibration(var, config)
 
     sens = yield sensor.new_sensor(config[CONF_ECO2])
     cg.add(var.set_co2(sens))
@@ -70,9 +70,11 @@ CLIMATE_SCHEMA = cv.MQTT_COMMAND_COMPONENT_SCHEMA.extend({
 
 @coroutine
 def setup_climate_core_(var, config):
-    cg.add(var.set_name(config[CONF_NAME]))
+    cg.setup_entity_name(var, config[CONF_NAME])
     if CONF_INTERNAL in config:
         cg.add(var.set_internal(config[CONF_INTERNAL]))
+    if not config.get(CONF_INTERNAL, False):
+        cg.add_define('USE_CONTROLLER_CLIMATE')
     visual = config[CONF_VISUAL]
     if CONF_MIN_TEMPERATURE in visual:
         cg.add(var.set_visual_min_temperature_override(visual[CONF_MIN_TEMPERATURE]))
@@ -231,6 +231,8 @@ optional<ClimateDeviceRestoreState> Climate::restore_state_() {
   ClimateDeviceRestoreState recovered{};
   if (!this->rtc_.load(&recovered))
     return {};
+  this->saved_state_ = recovered;
+  this->has_saved_state_ = true;
   return recovered;
 }
 void Climate::save_state_() {
@@ -256,7 +258,12 @@ void Climate::save_state_() {
     state.swing_mode = this->swing_mode;
   }
 
-  this->rtc_.save(&state);
+  if (this->has_saved_state_ && memcmp(&state, &this->saved_state_, sizeof(ClimateDeviceRestoreState)) == 0)
+    return;
+  if (this->rtc_.save(&state)) {
+    this->saved_state_ = state;
+    this->has_saved_state_ = true;
+  }
 }
 void Climate::publish_state() {
   ESP_LOGD(TAG, "'%s' - Sending state:", this->name_.c_str());
@@ -227,7 +227,7 @@ class Climate : public Nameable {
   /// Restore the state of the climate device, call this from your setup() method.
   optional<ClimateDeviceRestoreState> restore_state_();
   /** Internal method to save the state of the climate device to recover memory. This is automatically
-   * called from publish_state()
+   * called from publish_state(), the state is only written if it differs from the last saved one.
    */
   void save_state_();
 
@@ -235,6 +235,9 @@ class Climate : public Nameable {
 
   CallbackManager<void()> state_callback_{};
   ESPPreferenceObject rtc_;
+  /// The state last restored or saved, publishing only the current temperature or action doesn't write it again.
+  ClimateDeviceRestoreState saved_state_{};
+  bool has_saved_state_{false};
   optional<float> visual_min_temperature_override_{};
   optional<float> visual_max_temperature_override_{};
   optional<float> visual_temperature_step_override_{};
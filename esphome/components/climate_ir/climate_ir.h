@@ -4,6 +4,7 @@
 #include "esphome/components/remote_base/remote_base.h"
 #include "esphome/components/remote_transmitter/remote_transmitter.h"
 #include "esphome/components/sensor/sensor.h"
+#include "ir_frame.h"
 
 namespace esphome {
 namespace climate_ir {
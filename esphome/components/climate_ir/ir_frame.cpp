@@ -0,0 +1,27 @@
+#include "ir_frame.h"
+
+namespace esphome {
+namespace climate_ir {
+
+void encode_ir_bytes(remote_base::RemoteTransmitData *data, const IRFrameTiming &timing, const uint8_t *bytes,
+                     size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    const uint8_t byte = bytes[i];
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      const uint8_t mask = timing.msb_first ? 0x80 >> bit : 1 << bit;
+      data->item(timing.bit_mark, (byte & mask) ? timing.one_space : timing.zero_space);
+    }
+  }
+}
+
+void encode_ir_frame(remote_base::RemoteTransmitData *data, const IRFrameTiming &timing, const uint8_t *bytes,
+                     size_t len, uint32_t gap) {
+  data->item(timing.header_mark, timing.header_space);
+  encode_ir_bytes(data, timing, bytes, len);
+  data->mark(timing.bit_mark);
+  if (gap != 0)
+    data->space(gap);
+}
+
+}  // namespace climate_ir
+}  // namespace esphome
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esphome/components/remote_base/remote_base.h"
+
+namespace esphome {
+namespace climate_ir {
+
+/** The bit timings of the pulse distance protocols used by most air conditioners.
+ *
+ * A frame is a header mark and space, every bit as a mark followed by a space whose length encodes the bit, and a
+ * trailing mark. Implementations keep their timings in a constant and only build the bytes of the state.
+ */
+struct IRFrameTiming {
+  uint32_t header_mark;
+  uint32_t header_space;
+  uint32_t bit_mark;
+  uint32_t one_space;
+  uint32_t zero_space;
+  /// Send the bits of each byte starting with the most significant one.
+  bool msb_first;
+};
+
+/// The number of marks and spaces of a frame of len bytes, the space after its trailing mark included.
+inline size_t ir_frame_length(size_t len) { return 2 + len * 16 + 2; }
+
+/// Append the marks and spaces of len bytes to data, without header or trailing mark.
+void encode_ir_bytes(remote_base::RemoteTransmitData *data, const IRFrameTiming &timing, const uint8_t *bytes,
+                     size_t len);
+
+/** Append a frame of len bytes to data.
+ *
+ * @param gap The space after the trailing mark, 0 to end the transmission with the mark.
+ */
+void encode_ir_frame(remote_base::RemoteTransmitData *data, const IRFrameTiming &timing, const uint8_t *bytes,
+                     size_t len, uint32_t gap);
+
+}  // namespace climate_ir
+}  // namespace esphome
@@ -55,9 +55,11 @@ COVER_SCHEMA = cv.MQTT_COMMAND_COMPONENT_SCHEMA.extend({
 
 @coroutine
 def setup_cover_core_(var, config):
-    cg.add(var.set_name(config[CONF_NAME]))
+    cg.setup_entity_name(var, config[CONF_NAME])
     if CONF_INTERNAL in config:
         cg.add(var.set_internal(config[CONF_INTERNAL]))
+    if not config.get(CONF_INTERNAL, False):
+        cg.add_define('USE_CONTROLLER_COVER')
     if CONF_DEVICE_CLASS in config:
         cg.add(var.set_device_class(config[CONF_DEVICE_CLASS]))
 
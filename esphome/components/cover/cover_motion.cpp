@@ -0,0 +1,48 @@
+#include "cover_motion.h"
+
+namespace esphome {
+namespace cover {
+
+void CoverMotion::recompute(Cover *cover, uint32_t now) {
+  float dir;
+  float action_dur;
+  switch (cover->current_operation) {
+    case COVER_OPERATION_OPENING:
+      dir = 1.0f;
+      action_dur = this->open_duration_;
+      break;
+    case COVER_OPERATION_CLOSING:
+      dir = -1.0f;
+      action_dur = this->close_duration_;
+      break;
+    default:
+      return;
+  }
+
+  cover->position += dir * (now - this->last_recompute_) / action_dur;
+  cover->position = clamp(cover->position, 0.0f, 1.0f);
+
+  this->last_recompute_ = now;
+}
+void CoverMotion::publish(Cover *cover, uint32_t now) {
+  if (cover->current_operation == COVER_OPERATION_IDLE) {
+    this->pending_ = false;
+    this->last_publish_ = now;
+    cover->publish_state();
+    return;
+  }
+  if (now - this->last_publish_ < this->min_publish_interval_) {
+    this->pending_ = true;
+    return;
+  }
+  this->pending_ = false;
+  this->last_publish_ = now;
+  cover->publish_state(false);
+}
+void CoverMotion::loop(Cover *cover, uint32_t now) {
+  if (this->pending_)
+    this->publish(cover, now);
+}
+
+}  // namespace cover
+}  // namespace esphome
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include "cover.h"
+
+namespace esphome {
+namespace cover {
+
+/** The motion model shared by covers that track their own position.
+ *
+ * The position is dead reckoned from the time the cover moves at a constant speed in its current operation. While
+ * the cover moves its state is published at most every min publish interval and not saved, so many covers moving at
+ * once don't flood the frontends or wear the flash. The state is published and saved right away once it stops.
+ */
+class CoverMotion {
+ public:
+  void set_open_duration(uint32_t open_duration) { this->open_duration_ = open_duration; }
+  void set_close_duration(uint32_t close_duration) { this->close_duration_ = close_duration; }
+  void set_min_publish_interval(uint32_t min_publish_interval) { this->min_publish_interval_ = min_publish_interval; }
+  uint32_t get_open_duration() const { return this->open_duration_; }
+  uint32_t get_close_duration() const { return this->close_duration_; }
+  uint32_t get_min_publish_interval() const { return this->min_publish_interval_; }
+
+  /// Restart the dead reckoning at now, call whenever the operation of the cover changes.
+  void reset(uint32_t now) { this->last_recompute_ = now; }
+  /// Move the position of cover on by the time since the last call, at the speed of its current operation.
+  void recompute(Cover *cover, uint32_t now);
+  /// Publish the state of cover, throttled and not saved while it moves.
+  void publish(Cover *cover, uint32_t now);
+  /// Publish a change that was held back by the throttling once the interval passed.
+  void loop(Cover *cover, uint32_t now);
+
+ protected:
+  uint32_t open_duration_{0};
+  uint32_t close_duration_{0};
+  uint32_t min_publish_interval_{0};
+  uint32_t last_recompute_{0};
+  uint32_t last_publish_{0};
+  bool pending_{false};
+};
+
+}  // namespace cover
+}  // namespace esphome
@@ -13,23 +13,24 @@ void CSE7766Component::loop() {
     this->raw_data_index_ = 0;
   }
 
-  if (this->available() == 0)
-    return;
-
-  this->last_transmission_ = now;
-  while (this->available() != 0) {
-    this->read_byte(&this->raw_data_[this->raw_data_index_]);
-    if (!this->check_byte_()) {
-      this->raw_data_index_ = 0;
-      this->status_set_warning();
-    }
-
-    if (this->raw_data_index_ == 23) {
-      this->parse_data_();
-      this->status_clear_warning();
+  uint8_t buffer[24];
+  size_t len;
+  while ((len = this->read_available(buffer, sizeof(buffer))) != 0) {
+    this->last_transmission_ = now;
+    for (size_t i = 0; i < len; i++) {
+      this->raw_data_[this->raw_data_index_] = buffer[i];
+      if (!this->check_byte_()) {
+        this->raw_data_index_ = 0;
+        this->status_set_warning();
+      }
+
+      if (this->raw_data_index_ == 23) {
+        this->parse_data_();
+        this->status_clear_warning();
+      }
+
+      this->raw_data_index_ = (this->raw_data_index_ + 1) % 24;
     }
-
-    this->raw_data_index_ = (this->raw_data_index_ + 1) % 24;
   }
 }
 float CSE7766Component::get_setup_priority() const { return setup_priority::DATA; }
@@ -117,48 +118,39 @@ void CSE7766Component::parse_data_() {
 
   if ((adj & 0x40) == 0x40 && voltage_ok && current_ok) {
     // voltage cycle of serial port outputted is a complete cycle;
-    this->voltage_acc_ += voltage_calib / float(voltage_cycle);
-    this->voltage_counts_ += 1;
+    this->meter_.add_voltage(voltage_calib / float(voltage_cycle));
   }
 
   float power = 0;
   if ((adj & 0x10) == 0x10 && voltage_ok && current_ok && power_ok) {
     // power cycle of serial port outputted is a complete cycle;
     power = power_calib / float(power_cycle);
-    this->power_acc_ += power;
-    this->power_counts_ += 1;
+    this->meter_.add_power(power);
   }
 
   if ((adj & 0x20) == 0x20 && current_ok && voltage_ok && power != 0.0) {
     // indicates current cycle of serial port outputted is a complete cycle;
-    this->current_acc_ += current_calib / float(current_cycle);
-    this->current_counts_ += 1;
+    this->meter_.add_current(current_calib / float(current_cycle));
+  }
+
+  // the chip counts the CF pulses itself, each is power_calib / 3600 µWh
+  const uint16_t cf_pulses = (uint16_t(this->raw_data_[21]) << 8) | this->raw_data_[22];
+  if (this->has_cf_pulses_) {
+    const uint16_t pulses = cf_pulses - this->cf_pulses_;
+    this->meter_.add_energy(pulses * float(power_calib) / 1000000.0f / 3600.0f);
   }
+  this->cf_pulses_ = cf_pulses;
+  this->has_cf_pulses_ = true;
 }
 void CSE7766Component::update() {
-  float voltage = this->voltage_counts_ > 0 ? this->voltage_acc_ / this->voltage_counts_ : 0.0;
-  float current = this->current_counts_ > 0 ? this->current_acc_ / this->current_counts_ : 0.0;
-  float power = this->power_counts_ > 0 ? this->power_acc_ / this->power_counts_ : 0.0;
-
-  ESP_LOGV(TAG, "Got voltage_acc=%.2f current_acc=%.2f power_acc=%.2f", this->voltage_acc_, this->current_acc_,
-           this->power_acc_);
-  ESP_LOGV(TAG, "Got voltage_counts=%d current_counts=%d power_counts=%d", this->voltage_counts_, this->current_counts_,
-           this->power_counts_);
-  ESP_LOGD(TAG, "Got voltage=%.1fV current=%.1fA power=%.1fW", voltage, current, power);
-
-  if (this->voltage_sensor_ != nullptr)
-    this->voltage_sensor_->publish_state(voltage);
-  if (this->current_sensor_ != nullptr)
-    this->current_sensor_->publish_state(current);
-  if (this->power_sensor_ != nullptr)
-    this->power_sensor_->publish_state(power);
-
-  this->voltage_acc_ = 0.0f;
-  this->current_acc_ = 0.0f;
-  this->power_acc_ = 0.0f;
-  this->voltage_counts_ = 0;
-  this->power_counts_ = 0;
-  this->current_counts_ = 0;
+  if (!this->meter_.has_power()) {
+    // the power cycle is longer than the window, there is (almost) no load
+    this->meter_.add_power(0.0f);
+    this->meter_.add_current(0.0f);
+  }
+  this->meter_.publish();
+  ESP_LOGD(TAG, "Got voltage=%.1fV current=%.1fA power=%.1fW energy=%.2fWh", this->meter_.get_voltage(),
+           this->meter_.get_current(), this->meter_.get_power(), this->meter_.get_energy());
 }
 
 uint32_t CSE7766Component::get_24_bit_uint_(uint8_t start_index) {
@@ -169,9 +161,11 @@ uint32_t CSE7766Component::get_24_bit_uint_(uint8_t start_index) {
 void CSE7766Component::dump_config() {
   ESP_LOGCONFIG(TAG, "CSE7766:");
   LOG_UPDATE_INTERVAL(this);
-  LOG_SENSOR("  ", "Voltage", this->voltage_sensor_);
-  LOG_SENSOR("  ", "Current", this->current_sensor_);
-  LOG_SENSOR("  ", "Power", this->power_sensor_);
+  LOG_SENSOR("  ", "Voltage", this->meter_.get_voltage_sensor());
+  LOG_SENSOR("  ", "Current", this->meter_.get_current_sensor());
+  LOG_SENSOR("  ", "Power", this->meter_.get_power_sensor());
+  LOG_SENSOR("  ", "Energy", this->meter_.get_energy_sensor());
+  LOG_SENSOR("  ", "Power Factor", this->meter_.get_power_factor_sensor());
   this->check_uart_settings(4800);
 }
 
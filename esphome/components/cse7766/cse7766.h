@@ -3,15 +3,20 @@
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/uart/uart.h"
+#include "esphome/components/energy_meter/energy_meter.h"
 
 namespace esphome {
 namespace cse7766 {
 
 class CSE7766Component : public PollingComponent, public uart::UARTDevice {
  public:
-  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { voltage_sensor_ = voltage_sensor; }
-  void set_current_sensor(sensor::Sensor *current_sensor) { current_sensor_ = current_sensor; }
-  void set_power_sensor(sensor::Sensor *power_sensor) { power_sensor_ = power_sensor; }
+  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { meter_.set_voltage_sensor(voltage_sensor); }
+  void set_current_sensor(sensor::Sensor *current_sensor) { meter_.set_current_sensor(current_sensor); }
+  void set_power_sensor(sensor::Sensor *power_sensor) { meter_.set_power_sensor(power_sensor); }
+  void set_energy_sensor(sensor::Sensor *energy_sensor) { meter_.set_energy_sensor(energy_sensor); }
+  void set_power_factor_sensor(sensor::Sensor *power_factor_sensor) {
+    meter_.set_power_factor_sensor(power_factor_sensor);
+  }
 
   void loop() override;
   float get_setup_priority() const override;
@@ -26,15 +31,10 @@ class CSE7766Component : public PollingComponent, public uart::UARTDevice {
   uint8_t raw_data_[24];
   uint8_t raw_data_index_{0};
   uint32_t last_transmission_{0};
-  sensor::Sensor *voltage_sensor_{nullptr};
-  sensor::Sensor *current_sensor_{nullptr};
-  sensor::Sensor *power_sensor_{nullptr};
-  float voltage_acc_{0.0f};
-  float current_acc_{0.0f};
-  float power_acc_{0.0f};
-  uint32_t voltage_counts_{0};
-  uint32_t current_counts_{0};
-  uint32_t power_counts_{0};
+  energy_meter::EnergyMeter meter_;
+  /// The CF pulse count of the last frame, it wraps around at 16 bits.
+  uint16_t cf_pulses_{0};
+  bool has_cf_pulses_{false};
 };
 
 }  // namespace cse7766
@@ -7,12 +7,14 @@ namespace esphome {
 namespace ct_clamp {
 
 static const char *TAG = "ct_clamp";
+/// Number of samples fetched at once from continuous samplers.
+static const size_t CT_CLAMP_BLOCK_SIZE = 64;
 
 void CTClampSensor::setup() {
   this->is_calibrating_offset_ = true;
-  this->high_freq_.start();
+  this->start_sampling_();
   this->set_timeout("calibrate_offset", this->sample_duration_, [this]() {
-    this->high_freq_.stop();
+    this->stop_sampling_();
     this->is_calibrating_offset_ = false;
     if (this->num_samples_ != 0) {
       this->offset_ = this->sample_sum_ / this->num_samples_;
@@ -31,14 +33,12 @@ void CTClampSensor::update() {
     return;
 
   // Update only starts the sampling phase, in loop() the actual sampling is happening.
-
-  // Request a high loop() execution interval during sampling phase.
-  this->high_freq_.start();
+  this->start_sampling_();
 
   // Set timeout for ending sampling phase
   this->set_timeout("read", this->sample_duration_, [this]() {
+    this->stop_sampling_();
     this->is_sampling_ = false;
-    this->high_freq_.stop();
 
     if (this->num_samples_ == 0) {
       // Shouldn't happen, but let's not crash if it does.
@@ -58,32 +58,79 @@ void CTClampSensor::update() {
   this->sample_sum_ = 0.0f;
 }
 
+void CTClampSensor::start_sampling_() {
+  if (this->source_->is_continuous()) {
+    // throw away what has been sampled before this phase
+    float block[CT_CLAMP_BLOCK_SIZE];
+    while (this->source_->read_samples(block, CT_CLAMP_BLOCK_SIZE) == CT_CLAMP_BLOCK_SIZE) {
+    }
+  } else {
+    // Request a high loop() execution interval during sampling phase.
+    this->high_freq_.start();
+  }
+}
+
+void CTClampSensor::stop_sampling_() {
+  if (this->source_->is_continuous()) {
+    // take the samples that arrived since the last loop()
+    this->loop();
+  } else {
+    this->high_freq_.stop();
+  }
+}
+
 void CTClampSensor::loop() {
   if (!this->is_sampling_ && !this->is_calibrating_offset_)
     return;
 
-  // Perform a single sample
-  float value = this->source_->sample();
-  if (isnan(value))
+  if (!this->source_->is_continuous()) {
+    // Perform a single sample
+    float value = this->source_->sample();
+    this->process_samples_(&value, 1);
     return;
+  }
+
+  // Consume everything the sampler has buffered, the sample rate does not depend on the loop() interval.
+  float block[CT_CLAMP_BLOCK_SIZE];
+  size_t count;
+  do {
+    count = this->source_->read_samples(block, CT_CLAMP_BLOCK_SIZE);
+    this->process_samples_(block, count);
+  } while (count == CT_CLAMP_BLOCK_SIZE);
+}
 
+void CTClampSensor::process_samples_(const float *values, size_t count) {
   if (this->is_calibrating_offset_) {
-    this->sample_sum_ += value;
-    this->num_samples_++;
+    for (size_t i = 0; i < count; i++) {
+      if (isnan(values[i]))
+        continue;
+      this->sample_sum_ += values[i];
+      this->num_samples_++;
+    }
     return;
   }
 
   // Adjust DC offset via low pass filter (exponential moving average)
   const float alpha = 0.001f;
-  this->offset_ = this->offset_ * (1 - alpha) + value * alpha;
-
-  // Filtered value centered around the mid-point (0V)
-  float filtered = value - this->offset_;
-
-  // IRMS is sqrt(∑v_i²)
-  float sq = filtered * filtered;
-  this->sample_sum_ += sq;
-  this->num_samples_++;
+  float offset = this->offset_;
+  float sum = 0.0f;
+  uint32_t num_samples = 0;
+  for (size_t i = 0; i < count; i++) {
+    const float value = values[i];
+    if (isnan(value))
+      continue;
+    offset = offset * (1 - alpha) + value * alpha;
+
+    // Filtered value centered around the mid-point (0V)
+    const float filtered = value - offset;
+
+    // IRMS is sqrt(∑v_i²)
+    sum += filtered * filtered;
+    num_samples++;
+  }
+  this->offset_ = offset;
+  this->sample_sum_ += sum;
+  this->num_samples_ += num_samples;
 }
 
 }  // namespace ct_clamp
@@ -23,7 +23,12 @@ class CTClampSensor : public sensor::Sensor, public PollingComponent {
   void set_source(voltage_sampler::VoltageSampler *source) { source_ = source; }
 
  protected:
-  /// High Frequency loop() requester used during sampling phase.
+  void start_sampling_();
+  void stop_sampling_();
+  /// Accumulate a block of samples for the offset calibration or the RMS value.
+  void process_samples_(const float *values, size_t count);
+
+  /// High Frequency loop() requester used during sampling phase, not needed with continuous samplers.
   HighFrequencyLoopRequester high_freq_;
 
   /// Duration in ms of the sampling phase.
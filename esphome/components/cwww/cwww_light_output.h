@@ -27,9 +27,18 @@ class CWWWLightOutput : public light::LightOutput {
   void write_state(light::LightState *state) override {
     float cwhite, wwhite;
     state->current_values_as_cwww(&cwhite, &wwhite, this->constant_brightness_);
+    output::LatchGuard guard;
     this->cold_white_->set_level(cwhite);
     this->warm_white_->set_level(wwhite);
   }
+  bool supports_fade() override { return this->cold_white_->supports_fade() && this->warm_white_->supports_fade(); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
+    float cwhite, wwhite;
+    state->current_values_as_cwww(&cwhite, &wwhite, this->constant_brightness_);
+    output::LatchGuard guard;
+    this->cold_white_->set_level_fade(cwhite, length);
+    this->warm_white_->set_level_fade(wwhite, length);
+  }
 
  protected:
   output::FloatOutput *cold_white_;
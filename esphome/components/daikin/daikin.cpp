@@ -6,6 +6,9 @@ namespace daikin {
 
 static const char *TAG = "daikin.climate";
 
+static const climate_ir::IRFrameTiming DAIKIN_TIMING = {DAIKIN_HEADER_MARK, DAIKIN_HEADER_SPACE, DAIKIN_BIT_MARK,
+                                                        DAIKIN_ONE_SPACE,   DAIKIN_ZERO_SPACE,   false};
+
 void DaikinClimate::transmit_state() {
   uint8_t remote_state[35] = {0x11, 0xDA, 0x27, 0x00, 0xC5, 0x00, 0x00, 0xD7, 0x11, 0xDA, 0x27, 0x00,
                               0x42, 0x49, 0x05, 0xA2, 0x11, 0xDA, 0x27, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -25,42 +28,10 @@ void DaikinClimate::transmit_state() {
   auto transmit = this->transmitter_->transmit();
   auto data = transmit.get_data();
   data->set_carrier_frequency(DAIKIN_IR_FREQUENCY);
-
-  data->mark(DAIKIN_HEADER_MARK);
-  data->space(DAIKIN_HEADER_SPACE);
-  for (int i = 0; i < 8; i++) {
-    for (uint8_t mask = 1; mask > 0; mask <<= 1) {  // iterate through bit mask
-      data->mark(DAIKIN_BIT_MARK);
-      bool bit = remote_state[i] & mask;
-      data->space(bit ? DAIKIN_ONE_SPACE : DAIKIN_ZERO_SPACE);
-    }
-  }
-  data->mark(DAIKIN_BIT_MARK);
-  data->space(DAIKIN_MESSAGE_SPACE);
-  data->mark(DAIKIN_HEADER_MARK);
-  data->space(DAIKIN_HEADER_SPACE);
-
-  for (int i = 8; i < 16; i++) {
-    for (uint8_t mask = 1; mask > 0; mask <<= 1) {  // iterate through bit mask
-      data->mark(DAIKIN_BIT_MARK);
-      bool bit = remote_state[i] & mask;
-      data->space(bit ? DAIKIN_ONE_SPACE : DAIKIN_ZERO_SPACE);
-    }
-  }
-  data->mark(DAIKIN_BIT_MARK);
-  data->space(DAIKIN_MESSAGE_SPACE);
-  data->mark(DAIKIN_HEADER_MARK);
-  data->space(DAIKIN_HEADER_SPACE);
-
-  for (int i = 16; i < 35; i++) {
-    for (uint8_t mask = 1; mask > 0; mask <<= 1) {  // iterate through bit mask
-      data->mark(DAIKIN_BIT_MARK);
-      bool bit = remote_state[i] & mask;
-      data->space(bit ? DAIKIN_ONE_SPACE : DAIKIN_ZERO_SPACE);
-    }
-  }
-  data->mark(DAIKIN_BIT_MARK);
-  data->space(0);
+  data->reserve(climate_ir::ir_frame_length(8) * 2 + climate_ir::ir_frame_length(DAIKIN_STATE_FRAME_SIZE));
+  climate_ir::encode_ir_frame(data, DAIKIN_TIMING, remote_state, 8, DAIKIN_MESSAGE_SPACE);
+  climate_ir::encode_ir_frame(data, DAIKIN_TIMING, remote_state + 8, 8, DAIKIN_MESSAGE_SPACE);
+  climate_ir::encode_ir_frame(data, DAIKIN_TIMING, remote_state + 16, DAIKIN_STATE_FRAME_SIZE, 0);
 
   transmit.perform();
 }
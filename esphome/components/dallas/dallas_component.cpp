@@ -1,5 +1,6 @@
 #include "dallas_component.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace dallas {
@@ -32,11 +33,9 @@ void DallasComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up DallasComponent...");
 
   yield();
-  std::vector<uint64_t> raw_sensors;
-  {
-    InterruptLock lock;
-    raw_sensors = this->one_wire_->search_vec();
-  }
+  std::vector<uint64_t> raw_sensors = this->one_wire_->search_vec();
+  // with a single device on the bus, reads don't have to send its address first
+  this->single_device_ = raw_sensors.size() == 1;
 
   for (auto &address : raw_sensors) {
     std::string s = uint64_to_string(address);
@@ -108,52 +107,53 @@ DallasTemperatureSensor *DallasComponent::get_sensor_by_index(uint8_t index, uin
   return s;
 }
 void DallasComponent::update() {
-  this->status_clear_warning();
-
-  bool result;
-  {
-    InterruptLock lock;
-    if (!this->one_wire_->reset()) {
-      result = false;
-    } else {
-      result = true;
-      this->one_wire_->skip();
-      this->one_wire_->write8(DALLAS_COMMAND_START_CONVERSION);
-    }
+  if (this->converting_ || this->read_index_ < this->sensors_.size()) {
+    ESP_LOGW(TAG, "Last conversion not finished yet, skipping update");
+    return;
   }
+  this->status_clear_warning();
 
-  if (!result) {
+  // all devices start their conversion at once
+  if (!this->one_wire_->reset()) {
     ESP_LOGE(TAG, "Requesting conversion failed");
     this->status_set_warning();
     return;
   }
+  this->one_wire_->skip();
+  this->one_wire_->write8(DALLAS_COMMAND_START_CONVERSION);
 
-  for (auto *sensor : this->sensors_) {
-    this->set_timeout(sensor->get_address_name(), sensor->millis_to_wait_for_conversion(), [this, sensor] {
-      bool res;
-      {
-        InterruptLock lock;
-        res = sensor->read_scratch_pad();
-      }
-
-      if (!res) {
-        ESP_LOGW(TAG, "'%s' - Reseting bus for read failed!", sensor->get_name().c_str());
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
-      if (!sensor->check_scratch_pad()) {
-        ESP_LOGW(TAG, "'%s' - Scratch pad checksum invalid!", sensor->get_name().c_str());
-        sensor->publish_state(NAN);
-        this->status_set_warning();
-        return;
-      }
+  uint16_t wait = 0;
+  for (auto *sensor : this->sensors_)
+    wait = std::max(wait, sensor->millis_to_wait_for_conversion());
+  this->converting_ = true;
+  this->set_timeout("read", wait, [this] {
+    this->converting_ = false;
+    this->read_index_ = 0;
+  });
+}
+bool DallasComponent::is_loop_idle() { return this->read_index_ >= this->sensors_.size(); }
+void DallasComponent::loop() {
+  if (this->read_index_ >= this->sensors_.size())
+    return;
 
-      float tempc = sensor->get_temp_c();
-      ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
-      sensor->publish_state(tempc);
-    });
+  // one scratch pad per loop iteration, so other components get to run in between
+  auto *sensor = this->sensors_[this->read_index_++];
+  if (!sensor->read_scratch_pad()) {
+    ESP_LOGW(TAG, "'%s' - Reseting bus for read failed!", sensor->get_name().c_str());
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
+  }
+  if (!sensor->check_scratch_pad()) {
+    ESP_LOGW(TAG, "'%s' - Scratch pad checksum invalid!", sensor->get_name().c_str());
+    sensor->publish_state(NAN);
+    this->status_set_warning();
+    return;
   }
+
+  float tempc = sensor->get_temp_c();
+  ESP_LOGD(TAG, "'%s': Got Temperature=%.1f°C", sensor->get_name().c_str(), tempc);
+  sensor->publish_state(tempc);
 }
 DallasComponent::DallasComponent(ESPOneWire *one_wire) : one_wire_(one_wire) {}
 
@@ -181,7 +181,11 @@ bool ICACHE_RAM_ATTR DallasTemperatureSensor::read_scratch_pad() {
     return false;
   }
 
-  wire->select(this->address_);
+  if (this->parent_->single_device_) {
+    wire->skip();
+  } else {
+    wire->select(this->address_);
+  }
   wire->write8(DALLAS_COMMAND_READ_SCRATCH_PAD);
 
   for (unsigned char &i : this->scratch_pad_) {
@@ -190,13 +194,7 @@ bool ICACHE_RAM_ATTR DallasTemperatureSensor::read_scratch_pad() {
   return true;
 }
 bool DallasTemperatureSensor::setup_sensor() {
-  bool r;
-  {
-    InterruptLock lock;
-    r = this->read_scratch_pad();
-  }
-
-  if (!r) {
+  if (!this->read_scratch_pad()) {
     ESP_LOGE(TAG, "Reading scratchpad failed: reset");
     return false;
   }
@@ -229,20 +227,17 @@ bool DallasTemperatureSensor::setup_sensor() {
   }
 
   ESPOneWire *wire = this->parent_->one_wire_;
-  {
-    InterruptLock lock;
-    if (wire->reset()) {
-      wire->select(this->address_);
-      wire->write8(DALLAS_COMMAND_WRITE_SCRATCH_PAD);
-      wire->write8(this->scratch_pad_[2]);  // high alarm temp
-      wire->write8(this->scratch_pad_[3]);  // low alarm temp
-      wire->write8(this->scratch_pad_[4]);  // resolution
-      wire->reset();
+  if (wire->reset()) {
+    wire->select(this->address_);
+    wire->write8(DALLAS_COMMAND_WRITE_SCRATCH_PAD);
+    wire->write8(this->scratch_pad_[2]);  // high alarm temp
+    wire->write8(this->scratch_pad_[3]);  // low alarm temp
+    wire->write8(this->scratch_pad_[4]);  // resolution
+    wire->reset();
 
-      // write value to EEPROM
-      wire->select(this->address_);
-      wire->write8(0x48);
-    }
+    // write value to EEPROM
+    wire->select(this->address_);
+    wire->write8(0x48);
   }
 
   delay(20);  // allow it to finish operation
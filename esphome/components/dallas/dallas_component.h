@@ -20,7 +20,10 @@ class DallasComponent : public PollingComponent {
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
+  /// Start the conversion of all sensors, they are read from loop() once the slowest one is done.
   void update() override;
+  void loop() override;
+  bool is_loop_idle() override;
 
  protected:
   friend DallasTemperatureSensor;
@@ -28,6 +31,10 @@ class DallasComponent : public PollingComponent {
   ESPOneWire *one_wire_;
   std::vector<DallasTemperatureSensor *> sensors_;
   std::vector<uint64_t> found_sensors_;
+  bool single_device_{false};
+  bool converting_{false};
+  /// The next sensor to read, no read is pending once it reaches the number of sensors.
+  size_t read_index_{SIZE_MAX};
 };
 
 /// Internal class that helps us create multiple sensors for one Dallas hub.
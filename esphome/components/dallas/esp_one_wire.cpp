@@ -23,54 +23,70 @@ bool HOT ICACHE_RAM_ATTR ESPOneWire::reset() {
     delayMicroseconds(2);
   } while (!this->pin_->digital_read());
 
-  // Send 480µs LOW TX reset pulse
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
-  delayMicroseconds(480);
-
-  // Switch into RX mode, letting the pin float
-  this->pin_->pin_mode(INPUT_PULLUP);
-  // after 15µs-60µs wait time, responder pulls low for 60µs-240µs
-  // let's have 70µs just in case
-  delayMicroseconds(70);
-
-  bool r = !this->pin_->digital_read();
+  bool r;
+  {
+    // only the time from the end of the reset pulse to the presence sample is critical
+    // Send 480µs LOW TX reset pulse
+    this->pin_->pin_mode(OUTPUT);
+    this->pin_->digital_write(false);
+    delayMicroseconds(480);
+
+    InterruptLock lock;
+    // Switch into RX mode, letting the pin float
+    this->pin_->pin_mode(INPUT_PULLUP);
+    // after 15µs-60µs wait time, responder pulls low for 60µs-240µs
+    // let's have 70µs just in case
+    delayMicroseconds(70);
+
+    r = !this->pin_->digital_read();
+  }
   delayMicroseconds(410);
   return r;
 }
 
 void HOT ICACHE_RAM_ATTR ESPOneWire::write_bit(bool bit) {
-  // Initiate write/read by pulling low.
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
-
-  // bus sampled within 15µs and 60µs after pulling LOW.
+  // The devices wait as long as needed between time slots, interrupts are only disabled during one.
+  {
+    InterruptLock lock;
+    // Initiate write/read by pulling low.
+    this->pin_->pin_mode(OUTPUT);
+    this->pin_->digital_write(false);
+
+    // bus sampled within 15µs and 60µs after pulling LOW.
+    if (bit) {
+      // pull high/release within 15µs
+      delayMicroseconds(10);
+      this->pin_->digital_write(true);
+    } else {
+      // continue pulling LOW for at least 60µs
+      delayMicroseconds(65);
+      this->pin_->digital_write(true);
+    }
+  }
   if (bit) {
-    // pull high/release within 15µs
-    delayMicroseconds(10);
-    this->pin_->digital_write(true);
     // in total minimum of 60µs long
     delayMicroseconds(55);
   } else {
-    // continue pulling LOW for at least 60µs
-    delayMicroseconds(65);
-    this->pin_->digital_write(true);
     // grace period, 1µs recovery time
     delayMicroseconds(5);
   }
 }
 
 bool HOT ICACHE_RAM_ATTR ESPOneWire::read_bit() {
-  // Initiate read slot by pulling LOW for at least 1µs
-  this->pin_->pin_mode(OUTPUT);
-  this->pin_->digital_write(false);
-  delayMicroseconds(3);
-
-  // release bus, we have to sample within 15µs of pulling low
-  this->pin_->pin_mode(INPUT_PULLUP);
-  delayMicroseconds(10);
+  bool r;
+  {
+    InterruptLock lock;
+    // Initiate read slot by pulling LOW for at least 1µs
+    this->pin_->pin_mode(OUTPUT);
+    this->pin_->digital_write(false);
+    delayMicroseconds(3);
+
+    // release bus, we have to sample within 15µs of pulling low
+    this->pin_->pin_mode(INPUT_PULLUP);
+    delayMicroseconds(10);
 
-  bool r = this->pin_->digital_read();
+    r = this->pin_->digital_read();
+  }
   // read time slot at least 60µs long + 1µs recovery time between slots
   delayMicroseconds(53);
   return r;
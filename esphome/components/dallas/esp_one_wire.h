@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/esphal.h"
+#include <vector>
 
 namespace esphome {
 namespace dallas {
@@ -9,6 +10,10 @@ namespace dallas {
 extern const uint8_t ONE_WIRE_ROM_SELECT;
 extern const int ONE_WIRE_ROM_SEARCH;
 
+/** Bit-banged 1-Wire master.
+ *
+ * Interrupts are disabled for the timing critical part of a single time slot only, the bus is idle in between.
+ */
 class ESPOneWire {
  public:
   explicit ESPOneWire(GPIOPin *pin);
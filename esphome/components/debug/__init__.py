@@ -1,17 +1,86 @@
 import esphome.config_validation as cv
 import esphome.codegen as cg
-from esphome.const import CONF_ID
+from esphome.const import CONF_ID, ESP_PLATFORM_ESP32
+from esphome.core import CORE, coroutine_with_priority
 
 CODEOWNERS = ['@OttoWinter']
 DEPENDENCIES = ['logger']
 
+CONF_DEBUG_ID = 'debug_id'
+CONF_PROFILER = 'profiler'
+CONF_TRACK_ALLOCATIONS = 'track_allocations'
+CONF_TRACE_STATE_LATENCY = 'trace_state_latency'
+CONF_TASKS = 'tasks'
+CONF_STARVATION_THRESHOLD = 'starvation_threshold'
+
 debug_ns = cg.esphome_ns.namespace('debug')
-DebugComponent = debug_ns.class_('DebugComponent', cg.Component)
+DebugComponent = debug_ns.class_('DebugComponent', cg.PollingComponent)
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(DebugComponent),
-}).extend(cv.COMPONENT_SCHEMA)
+    cv.Optional(CONF_PROFILER, default=False): cv.boolean,
+    cv.Optional(CONF_TRACK_ALLOCATIONS, default=False): cv.boolean,
+    cv.Optional(CONF_TRACE_STATE_LATENCY, default=False): cv.boolean,
+    cv.Optional(CONF_TASKS): cv.All(cv.only_on_esp32, cv.boolean),
+    cv.Optional(CONF_STARVATION_THRESHOLD, default='100ms'): cv.positive_time_period_milliseconds,
+}).extend(cv.polling_component_schema('60s'))
+
+
+@coroutine_with_priority(-1000.0)
+def _add_profiler_component_names():
+    # Runs after all other components so that every component variable has been declared.
+    for id_, var in CORE.variables.items():
+        if id_.type is not None and id_.type.inherits_from(cg.Component):
+            cg.add(cg.esphome_ns.global_profiler.set_component_name(var, str(id_)))
+
+
+def enable_profiler():
+    """Enable the per-component profiler in the core, used by all code paths that need its data."""
+    if CORE.data.get(CONF_PROFILER, False):
+        return
+    CORE.data[CONF_PROFILER] = True
+    cg.add_define('USE_PROFILER')
+    CORE.add_job(_add_profiler_component_names)
+
+
+def enable_allocation_tracking():
+    """Count the heap allocations of every component, this wraps malloc() at link time."""
+    if CORE.data.get(CONF_TRACK_ALLOCATIONS, False):
+        return
+    CORE.data[CONF_TRACK_ALLOCATIONS] = True
+    enable_profiler()
+    cg.add_define('USE_PROFILER_ALLOCATIONS')
+    for func in ('malloc', 'calloc', 'realloc'):
+        cg.add_build_flag(f'-Wl,--wrap={func}')
+
+
+def enable_state_trace():
+    """Trace sensor states from publish_state() to the network, the histograms are kept by the profiler."""
+    if CORE.data.get(CONF_TRACE_STATE_LATENCY, False):
+        return
+    CORE.data[CONF_TRACE_STATE_LATENCY] = True
+    enable_profiler()
+    cg.add_define('USE_STATE_TRACE')
+
+
+def enable_task_monitor():
+    """Sample the FreeRTOS tasks on every tick, only available on the ESP32."""
+    if CORE.data.get(CONF_TASKS, False):
+        return
+    CORE.data[CONF_TASKS] = True
+    cg.add_define('USE_DEBUG_TASKS')
 
 
 def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
+
+    if config[CONF_PROFILER]:
+        enable_profiler()
+    if config[CONF_TRACK_ALLOCATIONS]:
+        enable_allocation_tracking()
+    if config[CONF_TRACE_STATE_LATENCY]:
+        enable_state_trace()
+    if config.get(CONF_TASKS, False):
+        enable_task_monitor()
+    if CORE.esp_platform == ESP_PLATFORM_ESP32:
+        cg.add(var.set_starvation_threshold(config[CONF_STARVATION_THRESHOLD]))
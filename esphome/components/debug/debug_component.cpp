@@ -3,9 +3,20 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/version.h"
+#include "esphome/core/profiler.h"
+#include "esphome/core/state_trace.h"
+#include <algorithm>
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <rom/rtc.h>
+#include <esp_heap_caps.h>
+#endif
+
+// ESP.getMaxFreeBlockSize() was added in 2.5.0
+#if defined(ARDUINO_ARCH_ESP8266) && !defined(ARDUINO_ESP8266_RELEASE_2_3_0) && \
+    !defined(ARDUINO_ESP8266_RELEASE_2_4_0) && !defined(ARDUINO_ESP8266_RELEASE_2_4_1) && \
+    !defined(ARDUINO_ESP8266_RELEASE_2_4_2)
+#define DEBUG_HAS_MAX_FREE_BLOCK
 #endif
 
 namespace esphome {
@@ -23,6 +34,9 @@ void DebugComponent::dump_config() {
   ESP_LOGD(TAG, "ESPHome version %s", ESPHOME_VERSION);
   this->free_heap_ = ESP.getFreeHeap();
   ESP_LOGD(TAG, "Free Heap Size: %u bytes", this->free_heap_);
+#if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+  ESP_LOGD(TAG, "PSRAM Size: %u bytes", ESP.getPsramSize());
+#endif
 
   const char *flash_mode;
   switch (ESP.getFlashChipMode()) {
@@ -197,14 +211,233 @@ void DebugComponent::dump_config() {
   ESP_LOGD(TAG, "Reset Info: %s", ESP.getResetInfo().c_str());
 #endif
 }
+#ifdef USE_DEBUG_TASKS
+void DebugComponent::setup() { this->task_monitor_.setup(); }
+#endif
 void DebugComponent::loop() {
+#ifdef USE_DEBUG_TASKS
+  const uint32_t starvation = this->task_monitor_.take_max_starvation();
+  if (starvation > this->max_starvation_)
+    this->max_starvation_ = starvation;
+  if (starvation >= this->starvation_threshold_) {
+    ESP_LOGW(TAG, "Other tasks kept the loop task from running for %u ms", starvation);
+    this->status_momentary_warning("starvation", 1000);
+  }
+#endif
   uint32_t new_free_heap = ESP.getFreeHeap();
+#ifdef ARDUINO_ARCH_ESP8266
+  if (new_free_heap < this->min_free_heap_)
+    this->min_free_heap_ = new_free_heap;
+#endif
   if (new_free_heap < this->free_heap_ / 2) {
     this->free_heap_ = new_free_heap;
     ESP_LOGD(TAG, "Free Heap Size: %u bytes", this->free_heap_);
     this->status_momentary_warning("heap", 1000);
   }
 }
+uint32_t DebugComponent::get_max_free_block() {
+#if defined(ARDUINO_ARCH_ESP32)
+  return heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+#elif defined(DEBUG_HAS_MAX_FREE_BLOCK)
+  return ESP.getMaxFreeBlockSize();
+#else
+  return 0;
+#endif
+}
+uint32_t DebugComponent::get_min_free_heap() const {
+#ifdef ARDUINO_ARCH_ESP32
+  return heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  return this->min_free_heap_;
+#endif
+}
+void DebugComponent::update() {
+  const uint32_t free_heap = ESP.getFreeHeap();
+  const uint32_t max_block = get_max_free_block();
+  // the share of the free heap that is lost to fragmentation, for requests larger than the largest block
+  const float fragmentation = max_block == 0 || free_heap == 0 ? NAN : 100.0f - max_block * 100.0f / free_heap;
+  const uint32_t min_free_heap = this->get_min_free_heap();
+  ESP_LOGD(TAG, "Heap: free=%u bytes, largest block=%u bytes, fragmentation=%.0f%%, min free=%u bytes", free_heap,
+           max_block, fragmentation, min_free_heap);
+  ESP_LOGD(TAG, "Large buffers: internal=%u bytes, PSRAM=%u bytes", get_large_buffer_bytes(false),
+           get_large_buffer_bytes(true));
+#if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+  ESP_LOGD(TAG, "PSRAM: free=%u bytes, largest block=%u bytes", heap_caps_get_free_size(MALLOC_CAP_SPIRAM),
+           heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM));
+#endif
+#ifdef USE_SENSOR
+  if (this->heap_free_sensor_ != nullptr)
+    this->heap_free_sensor_->publish_state(free_heap);
+  if (this->heap_max_block_sensor_ != nullptr)
+    this->heap_max_block_sensor_->publish_state(max_block == 0 ? NAN : max_block);
+  if (this->heap_fragmentation_sensor_ != nullptr)
+    this->heap_fragmentation_sensor_->publish_state(fragmentation);
+  if (this->heap_min_free_sensor_ != nullptr)
+    this->heap_min_free_sensor_->publish_state(min_free_heap);
+#endif
+
+#ifdef USE_DEBUG_TASKS
+  this->task_monitor_.update();
+  const uint32_t loop_stack_free = this->task_monitor_.get_loop_stack_free();
+  ESP_LOGD(TAG, "Loop task: stack free=%u bytes, longest starvation=%u ms", loop_stack_free, this->max_starvation_);
+#ifdef USE_SENSOR
+  for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+    if (this->core_load_sensors_[core] != nullptr)
+      this->core_load_sensors_[core]->publish_state(this->task_monitor_.get_core_load(core));
+  }
+  if (this->loop_stack_free_sensor_ != nullptr)
+    this->loop_stack_free_sensor_->publish_state(loop_stack_free);
+  if (this->loop_starvation_sensor_ != nullptr)
+    this->loop_starvation_sensor_->publish_state(this->max_starvation_);
+#endif
+  this->max_starvation_ = 0;
+#endif
+
+#ifdef USE_PROFILER_ALLOCATIONS
+  const float allocation_rate = this->log_allocations_();
+#ifdef USE_SENSOR
+  if (this->allocation_rate_sensor_ != nullptr)
+    this->allocation_rate_sensor_->publish_state(allocation_rate);
+#endif
+#endif
+
+#ifdef USE_PROFILER
+  ProfilerStats &loop = global_profiler.get_loop();
+  ProfilerStats &jitter = global_profiler.get_loop_jitter();
+
+  // Averages over the last update interval
+  const uint32_t loop_count = loop.count - this->last_loop_count_;
+  const float loop_time = loop_count == 0 ? NAN : (loop.total_us - this->last_loop_total_us_) / 1e3f / loop_count;
+  const float loop_time_max = loop.take_window_max() / 1e3f;
+  const uint32_t jitter_count = jitter.count - this->last_jitter_count_;
+  const float loop_jitter =
+      jitter_count == 0 ? NAN : (jitter.total_us - this->last_jitter_total_us_) / 1e3f / jitter_count;
+  this->last_loop_count_ = loop.count;
+  this->last_loop_total_us_ = loop.total_us;
+  this->last_jitter_count_ = jitter.count;
+  this->last_jitter_total_us_ = jitter.total_us;
+
+  ESP_LOGD(TAG, "Loop: %u iterations, mean=%.2fms max=%.2fms jitter=%.2fms", loop_count, loop_time, loop_time_max,
+           loop_jitter);
+  this->log_profiler_();
+
+#ifdef USE_SENSOR
+  if (this->loop_time_sensor_ != nullptr)
+    this->loop_time_sensor_->publish_state(loop_time);
+  if (this->loop_time_max_sensor_ != nullptr)
+    this->loop_time_max_sensor_->publish_state(loop_time_max);
+  if (this->loop_jitter_sensor_ != nullptr)
+    this->loop_jitter_sensor_->publish_state(loop_jitter);
+#endif
+#endif
+
+#ifdef USE_STATE_TRACE
+  const float state_latency_max = this->log_state_trace_();
+#ifdef USE_SENSOR
+  if (this->state_latency_max_sensor_ != nullptr)
+    this->state_latency_max_sensor_->publish_state(state_latency_max);
+#endif
+#endif
+}
+
+#ifdef USE_PROFILER
+static const uint8_t PROFILER_LOG_TOP = 5;
+
+void DebugComponent::log_profiler_() {
+  std::vector<ComponentProfile *> components = global_profiler.get_components();
+  std::sort(components.begin(), components.end(), [](const ComponentProfile *a, const ComponentProfile *b) {
+    return a->loop.total_us > b->loop.total_us;
+  });
+  ESP_LOGD(TAG, "Components with the most time spent in loop():");
+  for (size_t i = 0; i < components.size() && i < PROFILER_LOG_TOP; i++) {
+    const ProfilerStats &stats = components[i]->loop;
+    if (stats.count == 0)
+      break;
+    ESP_LOGD(TAG, "  %s: calls=%u total=%.1fms mean=%.0fus min=%uus max=%uus (setup %uus)",
+             components[i]->name != nullptr ? components[i]->name : "unknown", stats.count, stats.total_us / 1e3f,
+             stats.mean_us(), stats.min_us, stats.max_us, components[i]->setup_us);
+  }
+
+  std::vector<SchedulerProfile *> scheduler = global_profiler.get_scheduler();
+  std::sort(scheduler.begin(), scheduler.end(), [](const SchedulerProfile *a, const SchedulerProfile *b) {
+    return a->stats.total_us > b->stats.total_us;
+  });
+  ESP_LOGD(TAG, "Scheduler callbacks with the most time spent:");
+  for (size_t i = 0; i < scheduler.size() && i < PROFILER_LOG_TOP; i++) {
+    const ProfilerStats &stats = scheduler[i]->stats;
+    ESP_LOGD(TAG, "  '%s': calls=%u total=%.1fms mean=%.0fus max=%uus", scheduler[i]->name.c_str(), stats.count,
+             stats.total_us / 1e3f, stats.mean_us(), stats.max_us);
+  }
+}
+#endif
+
+#ifdef USE_STATE_TRACE
+float DebugComponent::log_state_trace_() {
+  ESP_LOGD(TAG, "Sensor state latency since publish_state() (since boot):");
+  for (uint8_t i = 0; i < STATE_TRACE_STAGE_COUNT; i++) {
+    const auto stage = StateTraceStage(i);
+    const ProfilerStats &stats = global_state_tracer.get_stage(stage);
+    if (stats.count == 0)
+      continue;
+    // the histogram only gives an upper limit for the percentile
+    const uint32_t p99_count = stats.count - stats.count / 100;
+    uint32_t cumulative = 0;
+    uint32_t p99_limit = UINT32_MAX;
+    for (uint8_t bucket = 0; bucket < PROFILER_BUCKETS; bucket++) {
+      cumulative += stats.buckets[bucket];
+      if (cumulative >= p99_count) {
+        p99_limit = ProfilerStats::bucket_limit(bucket);
+        break;
+      }
+    }
+    if (p99_limit == UINT32_MAX) {
+      ESP_LOGD(TAG, "  %s: count=%u mean=%.0fus max=%uus p99>%uus", StateTracer::get_stage_name(stage), stats.count,
+               stats.mean_us(), stats.max_us, ProfilerStats::bucket_limit(PROFILER_BUCKETS - 1));
+    } else {
+      ESP_LOGD(TAG, "  %s: count=%u mean=%.0fus max=%uus p99<=%uus", StateTracer::get_stage_name(stage), stats.count,
+               stats.mean_us(), stats.max_us, p99_limit);
+    }
+  }
+  ProfilerStats &sent = global_state_tracer.get_stage(STATE_TRACE_SENT);
+  return sent.count == 0 ? NAN : sent.take_window_max() / 1e3f;
+}
+#endif
+
+#ifdef USE_PROFILER_ALLOCATIONS
+float DebugComponent::log_allocations_() {
+  const uint32_t now = millis();
+  const uint32_t count = global_profiler.get_alloc_count();
+  const float rate =
+      this->last_alloc_time_ == 0 ? NAN : (count - this->last_alloc_count_) * 1e3f / (now - this->last_alloc_time_);
+  this->last_alloc_count_ = count;
+  this->last_alloc_time_ = now;
+
+  // components are only ever appended, so the n-th entry stays the same component
+  const std::vector<ComponentProfile *> &components = global_profiler.get_components();
+  this->last_component_allocs_.resize(components.size(), 0);
+  std::vector<std::pair<uint32_t, ComponentProfile *>> churn;
+  for (size_t i = 0; i < components.size(); i++) {
+    const uint32_t delta = components[i]->alloc_count - this->last_component_allocs_[i];
+    this->last_component_allocs_[i] = components[i]->alloc_count;
+    if (delta != 0)
+      churn.emplace_back(delta, components[i]);
+  }
+  std::sort(churn.begin(), churn.end(),
+            [](const std::pair<uint32_t, ComponentProfile *> &a, const std::pair<uint32_t, ComponentProfile *> &b) {
+              return a.first > b.first;
+            });
+
+  ESP_LOGD(TAG, "Heap allocations: %.1f/s, components with the most since the last update:", rate);
+  for (size_t i = 0; i < churn.size() && i < PROFILER_LOG_TOP; i++) {
+    const ComponentProfile *profile = churn[i].second;
+    ESP_LOGD(TAG, "  %s: %u allocations (%u in total, %.1fkB)", profile->name != nullptr ? profile->name : "unknown",
+             churn[i].first, profile->alloc_count, profile->alloc_bytes / 1024.0f);
+  }
+  return rate;
+}
+#endif
+
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
 
 }  // namespace debug
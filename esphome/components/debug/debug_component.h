@@ -1,18 +1,135 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_DEBUG_TASKS
+#include "task_monitor.h"
+#endif
 
 namespace esphome {
 namespace debug {
 
-class DebugComponent : public Component {
+class DebugComponent : public PollingComponent {
  public:
+#ifdef USE_DEBUG_TASKS
+  void setup() override;
+#endif
+  /// Warn when other tasks keep the loop task from running for at least this long, in ms (ESP32 only).
+  void set_starvation_threshold(uint32_t starvation_threshold) { this->starvation_threshold_ = starvation_threshold; }
   void loop() override;
+  void update() override;
   float get_setup_priority() const override;
   void dump_config() override;
 
+#ifdef USE_SENSOR
+  void set_heap_free_sensor(sensor::Sensor *heap_free_sensor) { this->heap_free_sensor_ = heap_free_sensor; }
+  void set_heap_max_block_sensor(sensor::Sensor *heap_max_block_sensor) {
+    this->heap_max_block_sensor_ = heap_max_block_sensor;
+  }
+  void set_heap_fragmentation_sensor(sensor::Sensor *heap_fragmentation_sensor) {
+    this->heap_fragmentation_sensor_ = heap_fragmentation_sensor;
+  }
+  void set_heap_min_free_sensor(sensor::Sensor *heap_min_free_sensor) {
+    this->heap_min_free_sensor_ = heap_min_free_sensor;
+  }
+#endif
+#if defined(USE_PROFILER) && defined(USE_SENSOR)
+  void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { this->loop_time_sensor_ = loop_time_sensor; }
+  void set_loop_time_max_sensor(sensor::Sensor *loop_time_max_sensor) {
+    this->loop_time_max_sensor_ = loop_time_max_sensor;
+  }
+  void set_loop_jitter_sensor(sensor::Sensor *loop_jitter_sensor) { this->loop_jitter_sensor_ = loop_jitter_sensor; }
+#endif
+#if defined(USE_STATE_TRACE) && defined(USE_SENSOR)
+  void set_state_latency_max_sensor(sensor::Sensor *state_latency_max_sensor) {
+    this->state_latency_max_sensor_ = state_latency_max_sensor;
+  }
+#endif
+#if defined(USE_DEBUG_TASKS) && defined(USE_SENSOR)
+  void set_core_load_sensor(uint8_t core, sensor::Sensor *core_load_sensor) {
+    this->core_load_sensors_[core] = core_load_sensor;
+  }
+  void set_loop_stack_free_sensor(sensor::Sensor *loop_stack_free_sensor) {
+    this->loop_stack_free_sensor_ = loop_stack_free_sensor;
+  }
+  void set_loop_starvation_sensor(sensor::Sensor *loop_starvation_sensor) {
+    this->loop_starvation_sensor_ = loop_starvation_sensor;
+  }
+#endif
+#if defined(USE_PROFILER_ALLOCATIONS) && defined(USE_SENSOR)
+  void set_allocation_rate_sensor(sensor::Sensor *allocation_rate_sensor) {
+    this->allocation_rate_sensor_ = allocation_rate_sensor;
+  }
+#endif
+
+  /// The size of the largest block that can be allocated, in bytes. 0 if the framework can't tell.
+  static uint32_t get_max_free_block();
+  /// The lowest free heap seen since boot, in bytes.
+  uint32_t get_min_free_heap() const;
+
  protected:
+#ifdef USE_PROFILER
+  /// Log the components and scheduler callbacks that used the most time since boot.
+  void log_profiler_();
+#endif
+#ifdef USE_STATE_TRACE
+  /// Log the per-stage latency of sensor states and return the longest one sent since the last update, in ms.
+  float log_state_trace_();
+#endif
+#ifdef USE_PROFILER_ALLOCATIONS
+  /// Log the components that allocated the most since the last update and return the allocations per second.
+  float log_allocations_();
+#endif
+
   uint32_t free_heap_{};
+  uint32_t starvation_threshold_{100};
+#ifdef ARDUINO_ARCH_ESP8266
+  /// The ESP8266 doesn't keep track of it, it is sampled every loop().
+  uint32_t min_free_heap_{UINT32_MAX};
+#endif
+#ifdef USE_SENSOR
+  sensor::Sensor *heap_free_sensor_{nullptr};
+  sensor::Sensor *heap_max_block_sensor_{nullptr};
+  sensor::Sensor *heap_fragmentation_sensor_{nullptr};
+  sensor::Sensor *heap_min_free_sensor_{nullptr};
+#endif
+#ifdef USE_PROFILER
+  uint32_t last_loop_count_{0};
+  uint64_t last_loop_total_us_{0};
+  uint32_t last_jitter_count_{0};
+  uint64_t last_jitter_total_us_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *loop_time_sensor_{nullptr};
+  sensor::Sensor *loop_time_max_sensor_{nullptr};
+  sensor::Sensor *loop_jitter_sensor_{nullptr};
+#endif
+#endif
+#if defined(USE_STATE_TRACE) && defined(USE_SENSOR)
+  sensor::Sensor *state_latency_max_sensor_{nullptr};
+#endif
+#ifdef USE_DEBUG_TASKS
+  TaskMonitor task_monitor_;
+  /// The longest starvation of the loop task since the last update, in ms.
+  uint32_t max_starvation_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *core_load_sensors_[portNUM_PROCESSORS]{};
+  sensor::Sensor *loop_stack_free_sensor_{nullptr};
+  sensor::Sensor *loop_starvation_sensor_{nullptr};
+#endif
+#endif
+#ifdef USE_PROFILER_ALLOCATIONS
+  uint32_t last_alloc_count_{0};
+  uint32_t last_alloc_time_{0};
+  /// alloc_count of every component at the last update, in the order of Profiler::get_components().
+  std::vector<uint32_t> last_component_allocs_;
+#ifdef USE_SENSOR
+  sensor::Sensor *allocation_rate_sensor_{nullptr};
+#endif
+#endif
 };
 
 }  // namespace debug
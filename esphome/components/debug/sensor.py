@@ -0,0 +1,100 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import UNIT_MILLISECOND, ICON_TIMER, UNIT_PERCENT, ICON_COUNTER, ICON_GAUGE
+from . import DebugComponent, CONF_DEBUG_ID, enable_profiler, enable_allocation_tracking, \
+    enable_task_monitor, enable_state_trace
+
+DEPENDENCIES = ['debug']
+
+CONF_LOOP_TIME = 'loop_time'
+CONF_LOOP_TIME_MAX = 'loop_time_max'
+CONF_LOOP_JITTER = 'loop_jitter'
+CONF_HEAP_FREE = 'heap_free'
+CONF_HEAP_MAX_BLOCK = 'heap_max_block'
+CONF_HEAP_FRAGMENTATION = 'heap_fragmentation'
+CONF_HEAP_MIN_FREE = 'heap_min_free'
+CONF_ALLOCATION_RATE = 'allocation_rate'
+CONF_CORE0_LOAD = 'core0_load'
+CONF_CORE1_LOAD = 'core1_load'
+CONF_LOOP_STACK_FREE = 'loop_stack_free'
+CONF_LOOP_STARVATION = 'loop_starvation'
+CONF_STATE_LATENCY_MAX = 'state_latency_max'
+
+UNIT_BYTES = 'B'
+UNIT_ALLOCATIONS_PER_SECOND = 'allocs/s'
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
+    cv.Optional(CONF_LOOP_TIME): sensor.sensor_schema(UNIT_MILLISECOND, ICON_TIMER, 2),
+    cv.Optional(CONF_LOOP_TIME_MAX): sensor.sensor_schema(UNIT_MILLISECOND, ICON_TIMER, 2),
+    cv.Optional(CONF_LOOP_JITTER): sensor.sensor_schema(UNIT_MILLISECOND, ICON_TIMER, 2),
+    cv.Optional(CONF_HEAP_FREE): sensor.sensor_schema(UNIT_BYTES, ICON_GAUGE, 0),
+    cv.Optional(CONF_HEAP_MAX_BLOCK): sensor.sensor_schema(UNIT_BYTES, ICON_GAUGE, 0),
+    cv.Optional(CONF_HEAP_FRAGMENTATION): sensor.sensor_schema(UNIT_PERCENT, ICON_GAUGE, 0),
+    cv.Optional(CONF_HEAP_MIN_FREE): sensor.sensor_schema(UNIT_BYTES, ICON_GAUGE, 0),
+    cv.Optional(CONF_ALLOCATION_RATE): sensor.sensor_schema(UNIT_ALLOCATIONS_PER_SECOND, ICON_COUNTER, 1),
+    cv.Optional(CONF_STATE_LATENCY_MAX): sensor.sensor_schema(UNIT_MILLISECOND, ICON_TIMER, 2),
+    cv.Optional(CONF_CORE0_LOAD): cv.All(cv.only_on_esp32,
+                                         sensor.sensor_schema(UNIT_PERCENT, ICON_GAUGE, 1)),
+    cv.Optional(CONF_CORE1_LOAD): cv.All(cv.only_on_esp32,
+                                         sensor.sensor_schema(UNIT_PERCENT, ICON_GAUGE, 1)),
+    cv.Optional(CONF_LOOP_STACK_FREE): cv.All(cv.only_on_esp32,
+                                              sensor.sensor_schema(UNIT_BYTES, ICON_GAUGE, 0)),
+    cv.Optional(CONF_LOOP_STARVATION): cv.All(cv.only_on_esp32,
+                                              sensor.sensor_schema(UNIT_MILLISECOND, ICON_TIMER, 0)),
+})
+
+
+def to_code(config):
+    hub = yield cg.get_variable(config[CONF_DEBUG_ID])
+
+    if CONF_HEAP_FREE in config:
+        sens = yield sensor.new_sensor(config[CONF_HEAP_FREE])
+        cg.add(hub.set_heap_free_sensor(sens))
+    if CONF_HEAP_MAX_BLOCK in config:
+        sens = yield sensor.new_sensor(config[CONF_HEAP_MAX_BLOCK])
+        cg.add(hub.set_heap_max_block_sensor(sens))
+    if CONF_HEAP_FRAGMENTATION in config:
+        sens = yield sensor.new_sensor(config[CONF_HEAP_FRAGMENTATION])
+        cg.add(hub.set_heap_fragmentation_sensor(sens))
+    if CONF_HEAP_MIN_FREE in config:
+        sens = yield sensor.new_sensor(config[CONF_HEAP_MIN_FREE])
+        cg.add(hub.set_heap_min_free_sensor(sens))
+
+    # The loop sensors are calculated from the profiler data
+    if CONF_LOOP_TIME in config:
+        enable_profiler()
+        sens = yield sensor.new_sensor(config[CONF_LOOP_TIME])
+        cg.add(hub.set_loop_time_sensor(sens))
+    if CONF_LOOP_TIME_MAX in config:
+        enable_profiler()
+        sens = yield sensor.new_sensor(config[CONF_LOOP_TIME_MAX])
+        cg.add(hub.set_loop_time_max_sensor(sens))
+    if CONF_LOOP_JITTER in config:
+        enable_profiler()
+        sens = yield sensor.new_sensor(config[CONF_LOOP_JITTER])
+        cg.add(hub.set_loop_jitter_sensor(sens))
+    if CONF_ALLOCATION_RATE in config:
+        enable_allocation_tracking()
+        sens = yield sensor.new_sensor(config[CONF_ALLOCATION_RATE])
+        cg.add(hub.set_allocation_rate_sensor(sens))
+    if CONF_STATE_LATENCY_MAX in config:
+        enable_state_trace()
+        sens = yield sensor.new_sensor(config[CONF_STATE_LATENCY_MAX])
+        cg.add(hub.set_state_latency_max_sensor(sens))
+
+    # The task sensors are sampled by the tick hooks of the task monitor
+    for core, key in enumerate((CONF_CORE0_LOAD, CONF_CORE1_LOAD)):
+        if key in config:
+            enable_task_monitor()
+            sens = yield sensor.new_sensor(config[key])
+            cg.add(hub.set_core_load_sensor(core, sens))
+    if CONF_LOOP_STACK_FREE in config:
+        enable_task_monitor()
+        sens = yield sensor.new_sensor(config[CONF_LOOP_STACK_FREE])
+        cg.add(hub.set_loop_stack_free_sensor(sens))
+    if CONF_LOOP_STARVATION in config:
+        enable_task_monitor()
+        sens = yield sensor.new_sensor(config[CONF_LOOP_STARVATION])
+        cg.add(hub.set_loop_starvation_sensor(sens))
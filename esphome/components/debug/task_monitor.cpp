@@ -0,0 +1,134 @@
+#include "task_monitor.h"
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <esp_freertos_hooks.h>
+
+namespace esphome {
+namespace debug {
+
+static const char *TAG = "debug.tasks";
+
+struct TaskTicks {
+  TaskHandle_t handle;
+  uint32_t ticks;
+};
+
+/// Written by the tick hook of the core only, read by the main loop.
+struct CoreTicks {
+  TaskTicks tasks[TASK_MONITOR_MAX_TASKS];
+  uint32_t total;
+  uint32_t idle;
+  /// Ticks of tasks that didn't fit into tasks.
+  uint32_t other;
+};
+
+static volatile CoreTicks core_ticks[portNUM_PROCESSORS];  // NOLINT
+static TaskHandle_t idle_tasks[portNUM_PROCESSORS];         // NOLINT
+static TaskHandle_t loop_task = nullptr;                    // NOLINT
+static BaseType_t loop_core = 0;                            // NOLINT
+static volatile uint32_t starvation_streak = 0;             // NOLINT
+static volatile uint32_t starvation_max = 0;                // NOLINT
+
+// Runs in the tick interrupt, also while the flash cache is disabled
+static void ICACHE_RAM_ATTR record_tick() {
+  const BaseType_t core = xPortGetCoreID();
+  const TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  volatile CoreTicks &ticks = core_ticks[core];
+  ticks.total++;
+  const bool idle = current == idle_tasks[core];
+  if (idle) {
+    ticks.idle++;
+  } else {
+    uint8_t i = 0;
+    while (i < TASK_MONITOR_MAX_TASKS && ticks.tasks[i].handle != current && ticks.tasks[i].handle != nullptr)
+      i++;
+    if (i == TASK_MONITOR_MAX_TASKS) {
+      ticks.other++;
+    } else {
+      ticks.tasks[i].handle = current;
+      ticks.tasks[i].ticks++;
+    }
+  }
+
+  if (core == loop_core) {
+    if (idle || current == loop_task) {
+      starvation_streak = 0;
+    } else if (++starvation_streak > starvation_max) {
+      starvation_max = starvation_streak;
+    }
+  }
+}
+
+void TaskMonitor::setup() {
+  loop_task = xTaskGetCurrentTaskHandle();
+  loop_core = xPortGetCoreID();
+  for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+    idle_tasks[core] = xTaskGetIdleTaskHandleForCPU(core);
+    esp_register_freertos_tick_hook_for_cpu(record_tick, core);
+  }
+}
+
+uint32_t TaskMonitor::get_loop_stack_free() const { return uxTaskGetStackHighWaterMark(loop_task); }
+
+uint32_t TaskMonitor::take_max_starvation() {
+  const uint32_t ret = starvation_max;
+  starvation_max = 0;
+  return ret * portTICK_PERIOD_MS;
+}
+
+bool TaskMonitor::is_task_alive_(TaskHandle_t handle, bool ran) {
+#if configUSE_TRACE_FACILITY == 1
+  for (auto &status : this->status_) {
+    if (status.xHandle == handle)
+      return true;
+  }
+  return false;
+#else
+  return ran;
+#endif
+}
+
+void TaskMonitor::update() {
+#if configUSE_TRACE_FACILITY == 1
+  this->status_.resize(uxTaskGetNumberOfTasks() + 4);
+  this->status_.resize(uxTaskGetSystemState(this->status_.data(), this->status_.size(), nullptr));
+#endif
+
+  for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+    volatile CoreTicks &ticks = core_ticks[core];
+    const uint32_t total = ticks.total - this->last_total_[core];
+    const uint32_t idle = ticks.idle - this->last_idle_[core];
+    const uint32_t other = ticks.other - this->last_other_[core];
+    this->last_total_[core] += total;
+    this->last_idle_[core] += idle;
+    this->last_other_[core] += other;
+    if (total == 0) {
+      this->core_load_[core] = NAN;
+      continue;
+    }
+    this->core_load_[core] = 100.0f - idle * 100.0f / total;
+    ESP_LOGD(TAG, "Core %d: load=%.1f%%", core, this->core_load_[core]);
+
+    for (uint8_t i = 0; i < TASK_MONITOR_MAX_TASKS; i++) {
+      const TaskHandle_t handle = ticks.tasks[i].handle;
+      if (handle == nullptr)
+        break;
+      const uint32_t task_ticks = ticks.tasks[i].ticks - this->last_ticks_[core][i];
+      this->last_ticks_[core][i] += task_ticks;
+      if (!this->is_task_alive_(handle, task_ticks != 0))
+        continue;
+      ESP_LOGD(TAG, "  %-16s cpu=%5.1f%% stack free=%u bytes%s", pcTaskGetTaskName(handle), task_ticks * 100.0f / total,
+               uxTaskGetStackHighWaterMark(handle), handle == loop_task ? " (loop task)" : "");
+    }
+    if (other != 0)
+      ESP_LOGD(TAG, "  %-16s cpu=%5.1f%%", "(other)", other * 100.0f / total);
+  }
+}
+
+}  // namespace debug
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <vector>
+
+namespace esphome {
+namespace debug {
+
+/// The most tasks per core whose CPU time is sampled, ticks of any further ones are only counted as other.
+static const uint8_t TASK_MONITOR_MAX_TASKS = 16;
+
+/** Samples which task runs on each core at every FreeRTOS tick.
+ *
+ * The tick hooks only increment counters, update() takes the differences since the last call to get the load of each
+ * core and the CPU share of each task. The hook of the core the loop task runs on also measures for how many ticks in
+ * a row other tasks kept the core busy without the loop task or the idle task getting to run, the longest of these
+ * streaks is the starvation of the loop task.
+ */
+class TaskMonitor {
+ public:
+  /// Register the tick hooks, must be called from the loop task.
+  void setup();
+  /// Log the CPU load of the cores and the CPU share and stack high water mark of every task.
+  void update();
+
+  /// The share of the ticks since the last update() in which the core wasn't idle, in percent.
+  float get_core_load(uint8_t core) const { return this->core_load_[core]; }
+  /// The least free stack the loop task ever had, in bytes.
+  uint32_t get_loop_stack_free() const;
+  /// The longest time the loop task was kept from running since the last call, in ms.
+  uint32_t take_max_starvation();
+
+ protected:
+  /** Whether the task still exists, so that its name and stack can be read.
+   *
+   * Without the FreeRTOS trace facility the tasks can't be listed, tasks that ran since the last update are assumed to.
+   */
+  bool is_task_alive_(TaskHandle_t handle, bool ran);
+
+  uint32_t last_total_[portNUM_PROCESSORS]{};
+  uint32_t last_idle_[portNUM_PROCESSORS]{};
+  uint32_t last_other_[portNUM_PROCESSORS]{};
+  uint32_t last_ticks_[portNUM_PROCESSORS][TASK_MONITOR_MAX_TASKS]{};
+  float core_load_[portNUM_PROCESSORS]{};
+#if configUSE_TRACE_FACILITY == 1
+  /// The tasks that exist at the time of update().
+  std::vector<TaskStatus_t> status_;
+#endif
+};
+
+}  // namespace debug
+}  // namespace esphome
+
+#endif
@@ -1,8 +1,8 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins, automation
-from esphome.const import CONF_ID, CONF_MODE, CONF_NUMBER, CONF_PINS, CONF_RUN_CYCLES, \
-    CONF_RUN_DURATION, CONF_SLEEP_DURATION, CONF_WAKEUP_PIN
+from esphome.const import CONF_ATTENUATION, CONF_ID, CONF_MODE, CONF_NUMBER, CONF_PIN, CONF_PINS, \
+    CONF_RUN_CYCLES, CONF_RUN_DURATION, CONF_SLEEP_DURATION, CONF_WAKEUP_PIN
 
 
 def validate_pin_number(value):
@@ -32,12 +32,64 @@ EXT1_WAKEUP_MODES = {
     'ANY_HIGH': esp_sleep_ext1_wakeup_mode_t.ESP_EXT1_WAKEUP_ANY_HIGH,
 }
 
+adc_atten_t = cg.global_ns.enum('adc_atten_t')
+adc1_channel_t = cg.global_ns.enum('adc1_channel_t')
+UlpAdcConfig = deep_sleep_ns.struct('UlpAdcConfig')
+ULP_ATTENUATION_MODES = {
+    '0db': adc_atten_t.ADC_ATTEN_DB_0,
+    '2.5db': adc_atten_t.ADC_ATTEN_DB_2_5,
+    '6db': adc_atten_t.ADC_ATTEN_DB_6,
+    '11db': adc_atten_t.ADC_ATTEN_DB_11,
+}
+# The ULP can only read ADC1
+ADC1_CHANNELS = {36: 0, 37: 1, 38: 2, 39: 3, 32: 4, 33: 5, 34: 6, 35: 7}
+
 CONF_WAKEUP_PIN_MODE = 'wakeup_pin_mode'
 CONF_ESP32_EXT1_WAKEUP = 'esp32_ext1_wakeup'
+CONF_SLEEP_WHEN_PUBLISHED = 'sleep_when_published'
+CONF_ULP = 'ulp'
+CONF_SAMPLE_INTERVAL = 'sample_interval'
+CONF_BATCH_SIZE = 'batch_size'
+CONF_WAKE_ABOVE = 'wake_above'
+CONF_WAKE_BELOW = 'wake_below'
+
+
+def validate_sleep_when_published(config):
+    if config[CONF_SLEEP_WHEN_PUBLISHED] and CONF_RUN_DURATION not in config:
+        raise cv.Invalid("sleep_when_published requires a run_duration to sleep after when the states can't be "
+                         "published.")
+    return config
+
+
+def validate_ulp_pin(value):
+    if value not in ADC1_CHANNELS:
+        raise cv.Invalid("The ULP can only sample pins {}"
+                         "".format(', '.join(str(x) for x in sorted(ADC1_CHANNELS))))
+    return value
 
-CONFIG_SCHEMA = cv.Schema({
+
+def validate_ulp_thresholds(config):
+    if CONF_WAKE_ABOVE in config and CONF_WAKE_BELOW in config and \
+            config[CONF_WAKE_BELOW] >= config[CONF_WAKE_ABOVE]:
+        raise cv.Invalid("wake_below must be lower than wake_above.")
+    return config
+
+
+ULP_SCHEMA = cv.All(cv.Schema({
+    cv.Required(CONF_PIN): cv.All(pins.analog_pin, validate_ulp_pin),
+    cv.Optional(CONF_ATTENUATION, default='0db'): cv.enum(ULP_ATTENUATION_MODES, lower=True),
+    cv.Optional(CONF_SAMPLE_INTERVAL, default='1s'): cv.All(cv.positive_time_period_milliseconds,
+                                                            cv.Range(min=cv.TimePeriod(milliseconds=1),
+                                                                     max=cv.TimePeriod(hours=1))),
+    cv.Optional(CONF_BATCH_SIZE, default=64): cv.int_range(min=1, max=64),
+    cv.Optional(CONF_WAKE_ABOVE): cv.int_range(min=1, max=4095),
+    cv.Optional(CONF_WAKE_BELOW): cv.int_range(min=1, max=4095),
+}), validate_ulp_thresholds)
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(DeepSleepComponent),
     cv.Optional(CONF_RUN_DURATION): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_SLEEP_WHEN_PUBLISHED, default=False): cv.boolean,
 
     cv.Optional(CONF_SLEEP_DURATION): cv.positive_time_period_milliseconds,
     cv.Optional(CONF_WAKEUP_PIN): cv.All(cv.only_on_esp32, pins.internal_gpio_input_pin_schema,
@@ -48,11 +100,12 @@ CONFIG_SCHEMA = cv.Schema({
         cv.Required(CONF_PINS): cv.ensure_list(pins.shorthand_input_pin, validate_pin_number),
         cv.Required(CONF_MODE): cv.enum(EXT1_WAKEUP_MODES, upper=True),
     })),
+    cv.Optional(CONF_ULP): cv.All(cv.only_on_esp32, ULP_SCHEMA),
 
     cv.Optional(CONF_RUN_CYCLES): cv.invalid("The run_cycles option has been removed in 1.11.0 as "
                                              "it was essentially the same as a run_duration of 0s."
                                              "Please use run_duration now.")
-}).extend(cv.COMPONENT_SCHEMA)
+}).extend(cv.COMPONENT_SCHEMA), validate_sleep_when_published)
 
 
 def to_code(config):
@@ -68,6 +121,7 @@ def to_code(config):
         cg.add(var.set_wakeup_pin_mode(config[CONF_WAKEUP_PIN_MODE]))
     if CONF_RUN_DURATION in config:
         cg.add(var.set_run_duration(config[CONF_RUN_DURATION]))
+    cg.add(var.set_sleep_when_published(config[CONF_SLEEP_WHEN_PUBLISHED]))
 
     if CONF_ESP32_EXT1_WAKEUP in config:
         conf = config[CONF_ESP32_EXT1_WAKEUP]
@@ -81,6 +135,22 @@ def to_code(config):
         )
         cg.add(var.set_ext1_wakeup(struct))
 
+    if CONF_ULP in config:
+        conf = config[CONF_ULP]
+        channel = ADC1_CHANNELS[conf[CONF_PIN]]
+        struct = cg.StructInitializer(
+            UlpAdcConfig,
+            ('channel', getattr(adc1_channel_t, 'ADC1_CHANNEL_{}'.format(channel))),
+            ('attenuation', conf[CONF_ATTENUATION]),
+            ('sample_interval', conf[CONF_SAMPLE_INTERVAL]),
+            ('batch_size', conf[CONF_BATCH_SIZE]),
+            # no sample is above 4095 or below 0
+            ('wake_above', conf.get(CONF_WAKE_ABOVE, 0xFFFF)),
+            ('wake_below', conf.get(CONF_WAKE_BELOW, 0)),
+        )
+        cg.add(var.set_ulp_adc(struct))
+        cg.add_define('USE_DEEP_SLEEP_ULP')
+
     cg.add_define('USE_DEEP_SLEEP')
 
 
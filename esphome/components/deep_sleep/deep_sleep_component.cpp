@@ -1,6 +1,20 @@
 #include "deep_sleep_component.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
+#include "esphome/core/util.h"
+
+#ifdef USE_MQTT
+#include "esphome/components/mqtt/mqtt_client.h"
+#endif
+#ifdef USE_API
+#include "esphome/components/api/api_server.h"
+#endif
+#ifdef USE_DEEP_SLEEP_ULP
+#include <algorithm>
+#include <esp32/ulp.h>
+#include <esp_sleep.h>
+#include <soc/rtc_cntl_reg.h>
+#endif
 
 namespace esphome {
 namespace deep_sleep {
@@ -9,10 +23,35 @@ static const char *TAG = "deep_sleep";
 
 bool global_has_deep_sleep = false;
 
+#ifdef ARDUINO_ARCH_ESP32
+// RTC slow memory keeps its contents during deep sleep and is initialized on power-on
+static RTC_DATA_ATTR DeepSleepWakeTimes rtc_wake_times;
+#endif
+
+#ifdef USE_DEEP_SLEEP_ULP
+// The ULP program is loaded at the start of the RTC slow memory reserved for the ULP (512 bytes), its data follows.
+// The ULP only reads and writes the lower 16 bits of each word.
+static const uint32_t ULP_DATA = 32;
+// Offsets into the data: whether a threshold may wake, the number of samples, the last sample, then the samples.
+static const uint32_t ULP_ARMED = 0;
+static const uint32_t ULP_COUNT = 1;
+static const uint32_t ULP_LAST = 2;
+static const uint32_t ULP_SAMPLES = 3;
+
+enum UlpLabel { LABEL_OUTSIDE, LABEL_BATCH, LABEL_WAKE, LABEL_HALT };
+#endif
+
 void DeepSleepComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Deep Sleep...");
   global_has_deep_sleep = true;
 
+  if (this->sleep_when_published_)
+    this->load_wake_times_();
+#ifdef USE_DEEP_SLEEP_ULP
+  if (this->ulp_adc_.batch_size != 0)
+    this->read_ulp_samples_();
+#endif
+
   if (this->run_duration_.has_value())
     this->set_timeout(*this->run_duration_, [this]() { this->begin_sleep(); });
 }
@@ -25,16 +64,184 @@ void DeepSleepComponent::dump_config() {
   if (this->run_duration_.has_value()) {
     ESP_LOGCONFIG(TAG, "  Run Duration: %u ms", *this->run_duration_);
   }
+  ESP_LOGCONFIG(TAG, "  Sleep When Published: %s", YESNO(this->sleep_when_published_));
 #ifdef ARDUINO_ARCH_ESP32
   if (this->wakeup_pin_.has_value()) {
     LOG_PIN("  Wakeup Pin: ", *this->wakeup_pin_);
   }
 #endif
+#ifdef USE_DEEP_SLEEP_ULP
+  if (this->ulp_adc_.batch_size != 0) {
+    ESP_LOGCONFIG(TAG, "  ULP: ADC1 channel %d every %u ms, batches of %u", this->ulp_adc_.channel,
+                  this->ulp_adc_.sample_interval, this->ulp_adc_.batch_size);
+    ESP_LOGCONFIG(TAG, "  ULP Wake Thresholds: below %u, above %u", this->ulp_adc_.wake_below,
+                  this->ulp_adc_.wake_above);
+  }
+#endif
 }
 void DeepSleepComponent::loop() {
+  if (this->sleep_when_published_ && this->wake_times_.published == 0)
+    this->check_published_();
   if (this->next_enter_deep_sleep_)
     this->begin_sleep();
 }
+void DeepSleepComponent::check_published_() {
+  const uint32_t now = millis();
+  if (this->wake_times_.sampled == 0) {
+    bool sampled = true;
+#ifdef USE_SENSOR
+    for (auto *obj : App.get_sensors()) {
+      if (!obj->has_state()) {
+        sampled = false;
+        break;
+      }
+    }
+#endif
+    if (sampled)
+      this->wake_times_.sampled = now;
+  }
+  if (this->wake_times_.network == 0 && network_is_connected())
+    this->wake_times_.network = now;
+
+  bool connected = false;
+  bool delivered = true;
+#ifdef USE_API
+  if (api::global_api_server != nullptr) {
+    connected = api::global_api_server->is_connected();
+    delivered = api::global_api_server->states_delivered();
+  }
+#endif
+#ifdef USE_MQTT
+  // with MQTT, API clients are usually not connected to sleeping nodes
+  if (mqtt::global_mqtt_client != nullptr) {
+    connected = mqtt::global_mqtt_client->is_connected();
+    delivered = connected && this->wake_times_.sampled != 0 && mqtt::global_mqtt_client->states_delivered();
+  }
+#endif
+  if (this->wake_times_.connected == 0 && connected)
+    this->wake_times_.connected = now;
+
+  // states published before the last sensor was sampled don't count
+  if (this->wake_times_.sampled == 0 || !delivered)
+    return;
+  this->wake_times_.published = now;
+  ESP_LOGD(TAG, "States published %u ms after boot", now);
+  this->begin_sleep();
+}
+void DeepSleepComponent::load_wake_times_() {
+  DeepSleepWakeTimes last{};
+#ifdef ARDUINO_ARCH_ESP32
+  last = rtc_wake_times;
+  rtc_wake_times = {};
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  // RTC memory, saving every wake would wear out the flash
+  this->wake_times_pref_ =
+      global_preferences.make_preference<DeepSleepWakeTimes>(fnv1_hash("deep_sleep_wake_times"), false);
+  if (!this->wake_times_pref_.load(&last))
+    last = {};
+  DeepSleepWakeTimes none{};
+  this->wake_times_pref_.save(&none);
+#endif
+  if (last.awake == 0)
+    return;
+  ESP_LOGI(TAG, "Last wake (ms after boot): sampled %u, network %u, connected %u, published %u, asleep %u",
+           last.sampled, last.network, last.connected, last.published, last.awake);
+}
+void DeepSleepComponent::save_wake_times_() {
+  this->wake_times_.awake = millis();
+#ifdef ARDUINO_ARCH_ESP32
+  rtc_wake_times = this->wake_times_;
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  this->wake_times_pref_.save(&this->wake_times_);
+#endif
+}
+#ifdef USE_DEEP_SLEEP_ULP
+void DeepSleepComponent::read_ulp_samples_() {
+  // stop sampling while the main cores run, the program is started again before sleeping
+  CLEAR_PERI_REG_MASK(RTC_CNTL_STATE0_REG, RTC_CNTL_ULP_CP_SLP_TIMER_EN);
+  const esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  if (cause == ESP_SLEEP_WAKEUP_UNDEFINED) {
+    // not a wake from deep sleep, the RTC memory holds garbage
+    RTC_SLOW_MEM[ULP_DATA + ULP_ARMED] = 1;
+    RTC_SLOW_MEM[ULP_DATA + ULP_COUNT] = 0;
+    return;
+  }
+  if (cause == ESP_SLEEP_WAKEUP_ULP)
+    ESP_LOGI(TAG, "Woken up by the ULP");
+
+  const uint8_t count = std::min<uint32_t>(RTC_SLOW_MEM[ULP_DATA + ULP_COUNT] & 0xFFFF, this->ulp_adc_.batch_size);
+  RTC_SLOW_MEM[ULP_DATA + ULP_COUNT] = 0;
+  if (count == 0)
+    return;
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < count; i++)
+    sum += RTC_SLOW_MEM[ULP_DATA + ULP_SAMPLES + i] & 0xFFFF;
+  const float average = float(sum) / count;
+  const uint16_t last = RTC_SLOW_MEM[ULP_DATA + ULP_LAST] & 0xFFFF;
+  ESP_LOGD(TAG, "ULP took %u samples, average %.1f, last %u", count, average, last);
+#ifdef USE_SENSOR
+  if (this->ulp_average_sensor_ != nullptr)
+    this->ulp_average_sensor_->publish_state(average);
+  if (this->ulp_last_sensor_ != nullptr)
+    this->ulp_last_sensor_->publish_state(last);
+  if (this->ulp_samples_sensor_ != nullptr)
+    this->ulp_samples_sensor_->publish_state(count);
+#endif
+}
+bool DeepSleepComponent::start_ulp_() {
+  const uint32_t channel = this->ulp_adc_.channel;
+  const uint32_t batch_size = this->ulp_adc_.batch_size;
+  const uint32_t wake_above = this->ulp_adc_.wake_above;
+  const uint32_t wake_below = this->ulp_adc_.wake_below;
+  const ulp_insn_t program[] = {
+      I_MOVI(R3, ULP_DATA),
+      I_LD(R1, R3, ULP_COUNT),
+      // the batch is full, the main cores haven't read it yet
+      I_MOVR(R0, R1),
+      M_BGE(LABEL_HALT, batch_size),
+      I_ADC(R0, 0, channel),
+      I_ST(R0, R3, ULP_LAST),
+      I_ADDR(R2, R1, R3),
+      I_ST(R0, R2, ULP_SAMPLES),
+      I_ADDI(R1, R1, 1),
+      I_ST(R1, R3, ULP_COUNT),
+      // inside of the thresholds, a threshold may wake again
+      M_BGE(LABEL_OUTSIDE, wake_above),
+      M_BL(LABEL_OUTSIDE, wake_below),
+      I_MOVI(R2, 1),
+      I_ST(R2, R3, ULP_ARMED),
+      M_BX(LABEL_BATCH),
+      // outside of them, wake once
+      M_LABEL(LABEL_OUTSIDE),
+      I_LD(R0, R3, ULP_ARMED),
+      M_BL(LABEL_BATCH, 1),
+      I_MOVI(R2, 0),
+      I_ST(R2, R3, ULP_ARMED),
+      M_BX(LABEL_WAKE),
+      M_LABEL(LABEL_BATCH),
+      I_MOVR(R0, R1),
+      M_BGE(LABEL_WAKE, batch_size),
+      I_HALT(),
+      M_LABEL(LABEL_WAKE),
+      I_WAKE(),
+      M_LABEL(LABEL_HALT),
+      I_HALT(),
+  };
+  size_t size = sizeof(program) / sizeof(ulp_insn_t);
+  if (ulp_process_macros_and_load(0, program, &size) != ESP_OK || size > ULP_DATA) {
+    ESP_LOGE(TAG, "Loading the ULP program failed");
+    return false;
+  }
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  adc1_config_channel_atten(this->ulp_adc_.channel, this->ulp_adc_.attenuation);
+  adc1_ulp_enable();
+  ulp_set_wakeup_period(0, this->ulp_adc_.sample_interval * 1000);
+  esp_sleep_enable_ulp_wakeup();
+  return ulp_run(0) == ESP_OK;
+}
+#endif
 float DeepSleepComponent::get_loop_priority() const {
   return -100.0f;  // run after everything else is ready
 }
@@ -65,6 +272,8 @@ void DeepSleepComponent::begin_sleep(bool manual) {
 #endif
 
   ESP_LOGI(TAG, "Beginning Deep Sleep");
+  if (this->sleep_when_published_)
+    this->save_wake_times_();
 
   App.run_safe_shutdown_hooks();
 
@@ -80,6 +289,10 @@ void DeepSleepComponent::begin_sleep(bool manual) {
   if (this->ext1_wakeup_.has_value()) {
     esp_sleep_enable_ext1_wakeup(this->ext1_wakeup_->mask, this->ext1_wakeup_->wakeup_mode);
   }
+#ifdef USE_DEEP_SLEEP_ULP
+  if (this->ulp_adc_.batch_size != 0 && !this->start_ulp_())
+    ESP_LOGE(TAG, "Starting the ULP failed, sleeping without it");
+#endif
   esp_deep_sleep_start();
 #endif
 
@@ -87,7 +300,10 @@ void DeepSleepComponent::begin_sleep(bool manual) {
   ESP.deepSleep(*this->sleep_duration_);
 #endif
 }
-float DeepSleepComponent::get_setup_priority() const { return setup_priority::LATE; }
+float DeepSleepComponent::get_setup_priority() const {
+  // before WiFi, so that loop() runs while setup() waits for the connection
+  return this->sleep_when_published_ ? setup_priority::DATA : setup_priority::LATE;
+}
 void DeepSleepComponent::prevent_deep_sleep() { this->prevent_ = true; }
 
 }  // namespace deep_sleep
@@ -3,6 +3,14 @@
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/preferences.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_DEEP_SLEEP_ULP
+#include <driver/adc.h>
+#endif
 
 namespace esphome {
 namespace deep_sleep {
@@ -27,8 +35,37 @@ struct Ext1Wakeup {
   esp_sleep_ext1_wakeup_mode_t wakeup_mode;
 };
 
+#ifdef USE_DEEP_SLEEP_ULP
+/// What the ULP coprocessor samples while the main cores sleep.
+struct UlpAdcConfig {
+  adc1_channel_t channel;
+  adc_atten_t attenuation;
+  /// The time between two samples in ms.
+  uint32_t sample_interval;
+  /// Wake the main cores when this many samples were taken, at most 64.
+  uint8_t batch_size;
+  /// Wake the main cores when a raw sample (0-4095) crosses above/below these, 0xFFFF/0 to disable.
+  uint16_t wake_above;
+  uint16_t wake_below;
+};
 #endif
 
+#endif
+
+/// When the stages of a wake were reached in ms after boot, 0 if a stage wasn't reached.
+struct DeepSleepWakeTimes {
+  /// All sensors had a state.
+  uint32_t sampled;
+  /// The network was connected.
+  uint32_t network;
+  /// An MQTT broker or API client was connected.
+  uint32_t connected;
+  /// The states arrived at the broker or client.
+  uint32_t published;
+  /// Deep sleep was entered.
+  uint32_t awake;
+};
+
 template<typename... Ts> class EnterDeepSleepAction;
 
 template<typename... Ts> class PreventDeepSleepAction;
@@ -52,9 +89,30 @@ class DeepSleepComponent : public Component {
   void set_wakeup_pin_mode(WakeupPinMode wakeup_pin_mode);
 
   void set_ext1_wakeup(Ext1Wakeup ext1_wakeup);
+#endif
+#ifdef USE_DEEP_SLEEP_ULP
+  /** Sample an ADC1 channel with the ULP coprocessor during deep sleep.
+   *
+   * The samples are stored in RTC memory, the main cores only boot when the batch is full or a sample crosses a
+   * threshold (or the sleep duration elapsed). A threshold wakes once when it is crossed, and again only after a
+   * sample was back inside of the thresholds. The samples are published to the ULP sensors on the next wake.
+   */
+  void set_ulp_adc(UlpAdcConfig ulp_adc) { this->ulp_adc_ = ulp_adc; }
+#ifdef USE_SENSOR
+  void set_ulp_average_sensor(sensor::Sensor *ulp_average_sensor) { this->ulp_average_sensor_ = ulp_average_sensor; }
+  void set_ulp_last_sensor(sensor::Sensor *ulp_last_sensor) { this->ulp_last_sensor_ = ulp_last_sensor; }
+  void set_ulp_samples_sensor(sensor::Sensor *ulp_samples_sensor) { this->ulp_samples_sensor_ = ulp_samples_sensor; }
+#endif
 #endif
   /// Set a duration in ms for how long the code should run before entering deep sleep mode.
   void set_run_duration(uint32_t time_ms);
+  /** Enter deep sleep as soon as all sensors have a state and the states arrived at the MQTT broker (or an API
+   * client if there's no MQTT), run_duration is only the upper bound then.
+   *
+   * The component is set up early so that it can follow the other components while they are set up, the times of
+   * the stages are logged on the next wake.
+   */
+  void set_sleep_when_published(bool sleep_when_published) { this->sleep_when_published_ = sleep_when_published; }
 
   void setup() override;
   void dump_config() override;
@@ -68,6 +126,14 @@ class DeepSleepComponent : public Component {
   void prevent_deep_sleep();
 
  protected:
+  void check_published_();
+  void load_wake_times_();
+  void save_wake_times_();
+#ifdef USE_DEEP_SLEEP_ULP
+  void read_ulp_samples_();
+  bool start_ulp_();
+#endif
+
   optional<uint64_t> sleep_duration_;
 #ifdef ARDUINO_ARCH_ESP32
   optional<GPIOPin *> wakeup_pin_;
@@ -77,6 +143,19 @@ class DeepSleepComponent : public Component {
   optional<uint32_t> run_duration_;
   bool next_enter_deep_sleep_{false};
   bool prevent_{false};
+  bool sleep_when_published_{false};
+  DeepSleepWakeTimes wake_times_{};
+#ifdef ARDUINO_ARCH_ESP8266
+  ESPPreferenceObject wake_times_pref_;
+#endif
+#ifdef USE_DEEP_SLEEP_ULP
+  UlpAdcConfig ulp_adc_{};
+#ifdef USE_SENSOR
+  sensor::Sensor *ulp_average_sensor_{nullptr};
+  sensor::Sensor *ulp_last_sensor_{nullptr};
+  sensor::Sensor *ulp_samples_sensor_{nullptr};
+#endif
+#endif
 };
 
 extern bool global_has_deep_sleep;
@@ -0,0 +1,37 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_TYPE, ICON_COUNTER, ICON_FLASH, UNIT_EMPTY
+from . import DeepSleepComponent
+
+DEPENDENCIES = ['deep_sleep']
+
+CONF_DEEP_SLEEP_ID = 'deep_sleep_id'
+
+# The raw values (0-4095) the ULP sampled during the last deep sleep, needs the ulp option
+TYPE_ULP_AVERAGE = 'ulp_average'
+TYPE_ULP_LAST = 'ulp_last'
+TYPE_ULP_SAMPLES = 'ulp_samples'
+
+SETTERS = {
+    TYPE_ULP_AVERAGE: 'set_ulp_average_sensor',
+    TYPE_ULP_LAST: 'set_ulp_last_sensor',
+    TYPE_ULP_SAMPLES: 'set_ulp_samples_sensor',
+}
+
+BASE_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(sensor.Sensor),
+    cv.GenerateID(CONF_DEEP_SLEEP_ID): cv.use_id(DeepSleepComponent),
+})
+
+CONFIG_SCHEMA = cv.All(cv.only_on_esp32, cv.typed_schema({
+    TYPE_ULP_AVERAGE: sensor.sensor_schema(UNIT_EMPTY, ICON_FLASH, 1).extend(BASE_SCHEMA),
+    TYPE_ULP_LAST: sensor.sensor_schema(UNIT_EMPTY, ICON_FLASH, 0).extend(BASE_SCHEMA),
+    TYPE_ULP_SAMPLES: sensor.sensor_schema(UNIT_EMPTY, ICON_COUNTER, 0).extend(BASE_SCHEMA),
+}, lower=True))
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_DEEP_SLEEP_ID])
+    var = yield sensor.new_sensor(config)
+    cg.add(getattr(parent, SETTERS[config[CONF_TYPE]])(var))
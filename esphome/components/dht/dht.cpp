@@ -7,11 +7,21 @@ namespace dht {
 
 static const char *TAG = "dht";
 
+void ICACHE_RAM_ATTR DHTStore::gpio_intr(DHTStore *arg) {
+  const uint8_t count = arg->count;
+  if (count >= MAX_EDGES)
+    return;
+  arg->edges[count] = (micros() & ~1u) | arg->pin->digital_read();
+  arg->count = count + 1;
+}
+
 void DHT::setup() {
   ESP_LOGCONFIG(TAG, "Setting up DHT...");
   this->pin_->digital_write(true);
   this->pin_->setup();
   this->pin_->digital_write(true);
+  if (this->use_interrupt_)
+    this->store_.pin = this->pin_->to_isr();
 }
 void DHT::dump_config() {
   ESP_LOGCONFIG(TAG, "DHT:");
@@ -24,6 +34,8 @@ void DHT::dump_config() {
     ESP_LOGCONFIG(TAG, "  Model: DHT22 (or equivalent)");
   }
 
+  if (this->use_interrupt_)
+    ESP_LOGCONFIG(TAG, "  Using Interrupt");
   LOG_UPDATE_INTERVAL(this);
 
   LOG_SENSOR("  ", "Temperature", this->temperature_sensor_);
@@ -31,6 +43,11 @@ void DHT::dump_config() {
 }
 
 void DHT::update() {
+  if (this->use_interrupt_) {
+    this->start_read_();
+    return;
+  }
+
   float temperature, humidity;
   bool success;
   if (this->model_ == DHT_MODEL_AUTO_DETECT) {
@@ -43,7 +60,10 @@ void DHT::update() {
   } else {
     success = this->read_sensor_(&temperature, &humidity, true);
   }
+  this->publish_(success, temperature, humidity);
+}
 
+void DHT::publish_(bool success, float temperature, float humidity) {
   if (success) {
     ESP_LOGD(TAG, "Got Temperature=%.1f°C Humidity=%.1f%%", temperature, humidity);
 
@@ -175,6 +195,98 @@ bool HOT ICACHE_RAM_ATTR DHT::read_sensor_(float *temperature, float *humidity,
             BYTE_TO_BINARY(data[0]), BYTE_TO_BINARY(data[1]), BYTE_TO_BINARY(data[2]), BYTE_TO_BINARY(data[3]),
             BYTE_TO_BINARY(data[4]));
 
+  return this->decode_data_(data, temperature, humidity, report_errors);
+}
+
+void DHT::start_read_() {
+  if (this->model_ == DHT_MODEL_AUTO_DETECT) {
+    this->model_ = DHT_MODEL_DHT22;
+    this->detecting_ = true;
+  }
+
+  this->pin_->digital_write(false);
+  this->pin_->pin_mode(OUTPUT);
+  this->pin_->digital_write(false);
+  if (this->model_ == DHT_MODEL_DHT11) {
+    this->set_timeout("start", 18, [this]() { this->release_line_(); });
+    return;
+  }
+  // the other start signals are too short for the scheduler, but they don't need the interrupts disabled
+  if (this->model_ == DHT_MODEL_SI7021) {
+    delayMicroseconds(500);
+    this->pin_->digital_write(true);
+    delayMicroseconds(40);
+  } else if (this->model_ == DHT_MODEL_DHT22_TYPE2) {
+    delayMicroseconds(2000);
+  } else {
+    delayMicroseconds(800);
+  }
+  this->release_line_();
+}
+
+void DHT::release_line_() {
+  this->store_.count = 0;
+  this->pin_->attach_interrupt(DHTStore::gpio_intr, &this->store_, CHANGE);
+  this->pin_->pin_mode(INPUT_PULLUP);
+  // the response and the 40 bits take less than 5ms
+  this->set_timeout("read", 10, [this]() { this->finish_read_(); });
+}
+
+void DHT::finish_read_() {
+  this->pin_->detach_interrupt();
+  const bool report_errors = !this->detecting_;
+  float temperature = NAN, humidity = NAN;
+  uint8_t data[5] = {0, 0, 0, 0, 0};
+  const bool success = this->decode_edges_(data, report_errors) &&
+                       this->decode_data_(data, &temperature, &humidity, report_errors);
+  if (this->detecting_) {
+    this->detecting_ = false;
+    if (!success) {
+      this->model_ = DHT_MODEL_DHT11;
+      return;
+    }
+  }
+  this->publish_(success, temperature, humidity);
+}
+
+bool DHT::decode_edges_(uint8_t *data, bool report_errors) {
+  const uint8_t count = this->store_.count;
+  const uint32_t *edges = this->store_.edges;
+  // the data bits are the last 40 high pulses, the ones before are the release of the line and the response
+  uint8_t pulses = 0;
+  for (uint8_t i = 1; i < count; i++) {
+    if ((edges[i - 1] & 1) && !(edges[i] & 1))
+      pulses++;
+  }
+  if (pulses < 40) {
+    if (report_errors)
+      ESP_LOGW(TAG, "Received only %u pulses, expected at least 40!", pulses);
+    return false;
+  }
+
+  uint8_t skip = pulses - 40;
+  uint8_t bit = 0;
+  for (uint8_t i = 1; i < count; i++) {
+    if (!(edges[i - 1] & 1) || (edges[i] & 1))
+      continue;
+    if (skip != 0) {
+      skip--;
+      continue;
+    }
+    if ((edges[i] | 1) - (edges[i - 1] | 1) >= 40)
+      data[bit / 8] |= 0x80 >> (bit % 8);
+    bit++;
+  }
+
+  ESP_LOGVV(TAG,
+            "Data: Hum=0b" BYTE_TO_BINARY_PATTERN BYTE_TO_BINARY_PATTERN
+            ", Temp=0b" BYTE_TO_BINARY_PATTERN BYTE_TO_BINARY_PATTERN ", Checksum=0b" BYTE_TO_BINARY_PATTERN,
+            BYTE_TO_BINARY(data[0]), BYTE_TO_BINARY(data[1]), BYTE_TO_BINARY(data[2]), BYTE_TO_BINARY(data[3]),
+            BYTE_TO_BINARY(data[4]));
+  return true;
+}
+
+bool DHT::decode_data_(const uint8_t *data, float *temperature, float *humidity, bool report_errors) {
   uint8_t checksum_a = data[0] + data[1] + data[2] + data[3];
   // On the DHT11, two algorithms for the checksum seem to be used, either the one from the DHT22,
   // or just using bytes 0 and 2
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/esphal.h"
 #include "esphome/components/sensor/sensor.h"
 
 namespace esphome {
@@ -16,6 +17,19 @@ enum DHTModel {
   DHT_MODEL_DHT22_TYPE2
 };
 
+/// The edges of the waveform of a reading, captured by the interrupt handler.
+struct DHTStore {
+  /// The release of the line, the response and 40 bits take 86 edges.
+  static const uint8_t MAX_EDGES = 90;
+
+  ISRInternalGPIOPin *pin;
+  /// micros() at each edge, with the level after the edge in the lowest bit.
+  uint32_t edges[MAX_EDGES];
+  volatile uint8_t count{0};
+
+  static void gpio_intr(DHTStore *arg);
+};
+
 /// Component for reading temperature/humidity measurements from DHT11/DHT22 sensors.
 class DHT : public PollingComponent {
  public:
@@ -39,6 +53,11 @@ class DHT : public PollingComponent {
   void set_model(DHTModel model) { model_ = model; }
   void set_temperature_sensor(sensor::Sensor *temperature_sensor) { temperature_sensor_ = temperature_sensor; }
   void set_humidity_sensor(sensor::Sensor *humidity_sensor) { humidity_sensor_ = humidity_sensor; }
+  /** Capture the waveform with an interrupt handler and decode it afterwards.
+   *
+   * Otherwise the bits are timed in a busy loop with the interrupts disabled for about 5ms, which disturbs WiFi.
+   */
+  void set_use_interrupt(bool use_interrupt) { use_interrupt_ = use_interrupt; }
 
   /// Set up the pins and check connection.
   void setup() override;
@@ -50,12 +69,24 @@ class DHT : public PollingComponent {
 
  protected:
   bool read_sensor_(float *temperature, float *humidity, bool report_errors);
+  /// Pull the line low for the start signal, the reading is finished in finish_read_().
+  void start_read_();
+  void release_line_();
+  void finish_read_();
+  /// Convert the high pulses of the captured waveform to the 5 bytes of data.
+  bool decode_edges_(uint8_t *data, bool report_errors);
+  bool decode_data_(const uint8_t *data, float *temperature, float *humidity, bool report_errors);
+  void publish_(bool success, float temperature, float humidity);
 
   GPIOPin *pin_;
   DHTModel model_{DHT_MODEL_AUTO_DETECT};
   bool is_auto_detect_{false};
   sensor::Sensor *temperature_sensor_{nullptr};
   sensor::Sensor *humidity_sensor_{nullptr};
+  bool use_interrupt_{false};
+  /// Whether the running reading tries the DHT22 while auto detecting the model.
+  bool detecting_{false};
+  DHTStore store_{};
 };
 
 }  // namespace dht
@@ -6,6 +6,8 @@ from esphome.const import CONF_HUMIDITY, CONF_ID, CONF_MODEL, CONF_PIN, CONF_TEM
     ICON_THERMOMETER, UNIT_CELSIUS, ICON_WATER_PERCENT, UNIT_PERCENT
 from esphome.cpp_helpers import gpio_pin_expression
 
+CONF_INTERRUPT = 'interrupt'
+
 dht_ns = cg.esphome_ns.namespace('dht')
 DHTModel = dht_ns.enum('DHTModel')
 DHT_MODELS = {
@@ -19,13 +21,22 @@ DHT_MODELS = {
 }
 DHT = dht_ns.class_('DHT', cg.PollingComponent)
 
-CONFIG_SCHEMA = cv.Schema({
+
+
+def validate_interrupt(config):
+    if config[CONF_INTERRUPT] and any(key in config[CONF_PIN] for key in pins.PIN_SCHEMA_REGISTRY):
+        raise cv.Invalid("interrupt is only supported for the internal pins of the ESP")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(DHT),
     cv.Required(CONF_PIN): pins.gpio_input_pin_schema,
     cv.Optional(CONF_TEMPERATURE): sensor.sensor_schema(UNIT_CELSIUS, ICON_THERMOMETER, 1),
     cv.Optional(CONF_HUMIDITY): sensor.sensor_schema(UNIT_PERCENT, ICON_WATER_PERCENT, 0),
     cv.Optional(CONF_MODEL, default='auto detect'): cv.enum(DHT_MODELS, upper=True, space='_'),
-}).extend(cv.polling_component_schema('60s'))
+    cv.Optional(CONF_INTERRUPT, default=False): cv.boolean,
+}).extend(cv.polling_component_schema('60s')), validate_interrupt)
 
 
 def to_code(config):
@@ -43,3 +54,5 @@ def to_code(config):
         cg.add(var.set_humidity_sensor(sens))
 
     cg.add(var.set_dht_model(config[CONF_MODEL]))
+    if config[CONF_INTERRUPT]:
+        cg.add(var.set_use_interrupt(True))
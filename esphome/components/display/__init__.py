@@ -2,7 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import core, automation
 from esphome.automation import maybe_simple_id
-from esphome.const import CONF_ID, CONF_LAMBDA, CONF_PAGES, CONF_ROTATION
+from esphome.const import CONF_ID, CONF_LAMBDA, CONF_PAGES, CONF_ROTATION, CONF_PSRAM
 from esphome.core import coroutine, coroutine_with_priority
 
 IS_PLATFORM_COMPONENT = True
@@ -41,6 +41,13 @@ FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend({
         cv.GenerateID(): cv.declare_id(DisplayPage),
         cv.Required(CONF_LAMBDA): cv.lambda_,
     }), cv.Length(min=1)),
+    cv.Optional(CONF_PSRAM): cv.All(cv.only_on_esp32, cv.boolean),
+})
+
+CONF_RENDER_TASK = 'render_task'
+# For the drivers that can send a frame while the next one is drawn
+RENDER_TASK_SCHEMA = cv.Schema({
+    cv.Optional(CONF_RENDER_TASK): cv.All(cv.only_on_esp32, cv.boolean),
 })
 
 
@@ -48,6 +55,10 @@ FULL_DISPLAY_SCHEMA = BASIC_DISPLAY_SCHEMA.extend({
 def setup_display_core_(var, config):
     if CONF_ROTATION in config:
         cg.add(var.set_rotation(DISPLAY_ROTATIONS[config[CONF_ROTATION]]))
+    if CONF_PSRAM in config:
+        cg.add(var.set_buffer_location(cg.buffer_location(config[CONF_PSRAM])))
+    if config.get(CONF_RENDER_TASK, False):
+        cg.add(var.set_render_task(True))
     if CONF_PAGES in config:
         pages = []
         for conf in config[CONF_PAGES]:
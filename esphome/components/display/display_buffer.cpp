@@ -12,12 +12,154 @@ const Color COLOR_OFF(0, 0, 0, 0);
 const Color COLOR_ON(1, 1, 1, 1);
 
 void DisplayBuffer::init_internal_(uint32_t buffer_length) {
-  this->buffer_ = new uint8_t[buffer_length];
+  this->buffer_ = alloc_large<uint8_t>(buffer_length, this->buffer_location_);
   if (this->buffer_ == nullptr) {
     ESP_LOGE(TAG, "Could not allocate buffer for display!");
     return;
   }
   this->clear();
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->render_task_)
+    this->start_render_task_();
+#endif
+}
+void DisplayBuffer::init_second_buffer_(uint32_t buffer_length) {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->render_task_handle_ == nullptr)
+    return;
+  this->second_buffer_ = alloc_large<uint8_t>(buffer_length, this->buffer_location_);
+  if (this->second_buffer_ == nullptr)
+    ESP_LOGW(TAG, "Could not allocate a second buffer for the display, frames are drawn and sent one after another");
+#endif
+}
+bool DisplayBuffer::render_() {
+  if (this->is_rendering_())
+    return false;
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->render_task_handle_ != nullptr) {
+    this->rendering_.store(true, std::memory_order_relaxed);
+    xTaskNotifyGive(this->render_task_handle_);
+    return true;
+  }
+#endif
+  const uint32_t start = micros();
+  this->do_update_();
+  this->render_time_ = micros() - start;
+  return true;
+}
+#ifdef ARDUINO_ARCH_ESP32
+void DisplayBuffer::start_render_task_() {
+  // the other core than the main loop, with the priority of the loop task
+  BaseType_t res = xTaskCreatePinnedToCore(&DisplayBuffer::render_task_loop_,
+                                           "display_render",            // name
+                                           4096,                        // stack size
+                                           this,                        // task pv params
+                                           1,                           // priority
+                                           &this->render_task_handle_,  // handle
+                                           0                            // core
+  );
+  if (res != pdPASS) {
+    ESP_LOGE(TAG, "Could not create render task, drawing frames in the main loop");
+    this->render_task_handle_ = nullptr;
+  }
+}
+void DisplayBuffer::render_task_loop_(void *arg) {
+  auto *self = reinterpret_cast<DisplayBuffer *>(arg);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const uint32_t start = micros();
+    self->do_update_();
+    self->render_time_ = micros() - start;
+    self->rendering_.store(false, std::memory_order_release);
+    App.wake_loop();
+  }
+}
+#endif
+/// The size of the tiles in which the buffer is compared for damage tracking.
+static const int DAMAGE_TILE_WIDTH = 16;
+static const int DAMAGE_TILE_HEIGHT = 8;
+
+void DisplayBuffer::init_packed_damage_tracking_(uint8_t bits_per_pixel) {
+  const int cols = (this->get_width_internal() + DAMAGE_TILE_WIDTH - 1) / DAMAGE_TILE_WIDTH;
+  const int rows = (this->get_height_internal() + DAMAGE_TILE_HEIGHT - 1) / DAMAGE_TILE_HEIGHT;
+  this->damage_hashes_.assign(cols * rows, 0);
+  this->damage_bits_per_pixel_ = bits_per_pixel;
+  this->damage_valid_ = false;
+}
+void DisplayBuffer::flush_damage_() {
+  const int width = this->get_width_internal();
+  const int height = this->get_height_internal();
+  if (this->buffer_ == nullptr)
+    return;
+  if (this->damage_hashes_.empty()) {
+    this->write_region_(0, 0, width, height);
+    return;
+  }
+
+  const int cols = (width + DAMAGE_TILE_WIDTH - 1) / DAMAGE_TILE_WIDTH;
+  const int rows = (height + DAMAGE_TILE_HEIGHT - 1) / DAMAGE_TILE_HEIGHT;
+  // a monochrome buffer stores a page of 8 rows per line of bytes, so a tile is a single line of it
+  const bool paged = this->damage_bits_per_pixel_ == 1;
+  const size_t stride = paged ? width : size_t(width) * this->damage_bits_per_pixel_ / 8;
+  const bool all = !this->damage_valid_;
+  this->damage_valid_ = true;
+
+  // the damaged rectangle being built, in tiles
+  int rect_col1 = -1, rect_col2 = 0, rect_row1 = 0;
+  auto emit = [this, width, height, &rect_col1, &rect_col2, &rect_row1](int rect_row2) {
+    const int x = rect_col1 * DAMAGE_TILE_WIDTH;
+    const int y = rect_row1 * DAMAGE_TILE_HEIGHT;
+    const int x2 = std::min((rect_col2 + 1) * DAMAGE_TILE_WIDTH, width);
+    const int y2 = std::min((rect_row2 + 1) * DAMAGE_TILE_HEIGHT, height);
+    ESP_LOGVV(TAG, "Writing damaged region x=%d y=%d w=%d h=%d", x, y, x2 - x, y2 - y);
+    this->write_region_(x, y, x2 - x, y2 - y);
+    rect_col1 = -1;
+  };
+
+  for (int row = 0; row < rows; row++) {
+    const int tile_y = row * DAMAGE_TILE_HEIGHT;
+    const int tile_lines = paged ? 1 : std::min(DAMAGE_TILE_HEIGHT, height - tile_y);
+    const size_t line_offset = (paged ? row : tile_y) * stride;
+    int dirty_col1 = -1, dirty_col2 = 0;
+    for (int col = 0; col < cols; col++) {
+      const int tile_x = col * DAMAGE_TILE_WIDTH;
+      const int tile_width = std::min(DAMAGE_TILE_WIDTH, width - tile_x);
+      const size_t tile_bytes = paged ? tile_width : (size_t(tile_width) * this->damage_bits_per_pixel_ + 7) / 8;
+      // FNV-1a over all bytes of the tile
+      uint32_t hash = 2166136261UL;
+      const uint8_t *line = this->buffer_ + line_offset + (paged ? tile_x : tile_x * this->damage_bits_per_pixel_ / 8);
+      for (int y = 0; y < tile_lines; y++, line += stride) {
+        for (size_t i = 0; i < tile_bytes; i++) {
+          hash ^= line[i];
+          hash *= 16777619UL;
+        }
+      }
+
+      uint32_t &stored = this->damage_hashes_[row * cols + col];
+      if (all || hash != stored) {
+        if (dirty_col1 < 0)
+          dirty_col1 = col;
+        dirty_col2 = col;
+      }
+      stored = hash;
+    }
+
+    if (dirty_col1 < 0) {
+      if (rect_col1 >= 0)
+        emit(row - 1);
+      continue;
+    }
+    if (rect_col1 < 0) {
+      rect_col1 = dirty_col1;
+      rect_col2 = dirty_col2;
+      rect_row1 = row;
+    } else {
+      rect_col1 = std::min(rect_col1, dirty_col1);
+      rect_col2 = std::max(rect_col2, dirty_col2);
+    }
+  }
+  if (rect_col1 >= 0)
+    emit(rows - 1);
 }
 void DisplayBuffer::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
 void DisplayBuffer::clear() { this->fill(COLOR_OFF); }
@@ -85,14 +227,10 @@ void HOT DisplayBuffer::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT DisplayBuffer::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->fill_rect_(x, y, width, 1, color);
 }
 void HOT DisplayBuffer::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->fill_rect_(x, y, 1, height, color);
 }
 void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -101,9 +239,62 @@ void DisplayBuffer::rectangle(int x1, int y1, int width, int height, Color color
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void DisplayBuffer::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+  this->fill_rect_(x1, y1, width, height, color);
+}
+void HOT DisplayBuffer::fill_rect_(int x, int y, int width, int height, Color color) {
+  if (width <= 0 || height <= 0)
+    return;
+  // a rectangle stays a rectangle in all rotations, see draw_pixel_at()
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      x = this->get_width_internal() - x - width;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = this->get_width_internal() - x - width;
+      y = this->get_height_internal() - y - height;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      y = this->get_height_internal() - y - height;
+      break;
+  }
+
+  const int x2 = std::min(x + width, this->get_width_internal());
+  const int y2 = std::min(y + height, this->get_height_internal());
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (x >= x2 || y >= y2)
+    return;
+  this->fill_rect_internal(x, y, x2 - x, y2 - y, color);
+  App.feed_wdt();
+}
+void HOT DisplayBuffer::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  for (int i = y; i < y + height; i++) {
+    for (int j = x; j < x + width; j++)
+      this->draw_absolute_pixel_internal(j, i, color);
+  }
+}
+void HOT DisplayBuffer::blit_internal(int x, int y, Image *image, int src_x, int src_y, int width, int height,
+                                      Color color_on, Color color_off) {
+  for (int img_y = src_y; img_y < src_y + height; img_y++, y++) {
+    for (int img_x = src_x, dst_x = x; img_x < src_x + width; img_x++, dst_x++) {
+      switch (image->get_type()) {
+        case IMAGE_TYPE_BINARY:
+          this->draw_absolute_pixel_internal(dst_x, y, image->get_pixel(img_x, img_y) ? color_on : color_off);
+          break;
+        case IMAGE_TYPE_GRAYSCALE:
+          this->draw_absolute_pixel_internal(dst_x, y, image->get_grayscale_pixel(img_x, img_y));
+          break;
+        case IMAGE_TYPE_RGB24:
+          this->draw_absolute_pixel_internal(dst_x, y, image->get_color_pixel(img_x, img_y));
+          break;
+      }
+    }
   }
 }
 void HOT DisplayBuffer::circle(int center_x, int center_xy, int radius, Color color) {
@@ -156,6 +347,34 @@ void DisplayBuffer::filled_circle(int center_x, int center_y, int radius, Color
   } while (dx <= 0);
 }
 
+void HOT DisplayBuffer::draw_glyph_(int x, int y, const Glyph &glyph, Color color) {
+  x += glyph.offset_x_;
+  y += glyph.offset_y_;
+  const uint8_t *data = glyph.data_;
+  if (glyph.rle_) {
+    for (int row = 0; row < glyph.height_; row++) {
+      const uint8_t runs = pgm_read_byte(data++);
+      for (uint8_t i = 0; i < runs; i++, data += 2)
+        this->fill_rect_(x + pgm_read_byte(data), y + row, pgm_read_byte(data + 1), 1, color);
+    }
+    return;
+  }
+
+  // find the runs in the bitmap rows
+  const uint32_t row_bytes = (glyph.width_ + 7u) / 8u;
+  for (int row = 0; row < glyph.height_; row++, data += row_bytes) {
+    int run_start = -1;
+    for (int col = 0; col <= glyph.width_; col++) {
+      const bool set = col < glyph.width_ && (pgm_read_byte(data + col / 8) & (0x80 >> (col % 8)));
+      if (set && run_start < 0) {
+        run_start = col;
+      } else if (!set && run_start >= 0) {
+        this->fill_rect_(x + run_start, y + row, col - run_start, 1, color);
+        run_start = -1;
+      }
+    }
+  }
+}
 void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align, const char *text) {
   int x_start, y_start;
   int width, height;
@@ -171,9 +390,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
       if (!font->get_glyphs().empty()) {
         uint8_t glyph_width = font->get_glyphs()[0].width_;
-        for (int glyph_x = 0; glyph_x < glyph_width; glyph_x++)
-          for (int glyph_y = 0; glyph_y < height; glyph_y++)
-            this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
+        this->fill_rect_(x_at, y_start, glyph_width, height, color);
         x_at += glyph_width;
       }
 
@@ -182,16 +399,7 @@ void DisplayBuffer::print(int x, int y, Font *font, Color color, TextAlign align
     }
 
     const Glyph &glyph = font->get_glyphs()[glyph_n];
-    int scan_x1, scan_y1, scan_width, scan_height;
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    for (int glyph_x = scan_x1; glyph_x < scan_x1 + scan_width; glyph_x++) {
-      for (int glyph_y = scan_y1; glyph_y < scan_y1 + scan_height; glyph_y++) {
-        if (glyph.get_pixel(glyph_x, glyph_y)) {
-          this->draw_pixel_at(glyph_x + x_at, glyph_y + y_start, color);
-        }
-      }
-    }
+    this->draw_glyph_(x_at, y_start, glyph, color);
 
     x_at += glyph.width_ + glyph.offset_x_;
 
@@ -206,6 +414,29 @@ void DisplayBuffer::vprintf_(int x, int y, Font *font, Color color, TextAlign al
 }
 
 void DisplayBuffer::image(int x, int y, Image *image, Color color_on, Color color_off) {
+  if (image->is_compressed()) {
+    // runs are rectangles in every rotation, stream them into the driver
+    ImageDecoder decoder(image, color_on, color_off);
+    int run_x, run_y, length;
+    Color color;
+    while (decoder.next_run(&run_x, &run_y, &length, &color))
+      this->fill_rect_(x + run_x, y + run_y, length, 1, color);
+    return;
+  }
+
+  if (this->rotation_ == DISPLAY_ROTATION_0_DEGREES) {
+    // without rotation the image rows map to buffer rows, let the driver copy them
+    const int src_x = std::max(0, -x);
+    const int src_y = std::max(0, -y);
+    const int width = std::min(image->get_width(), this->get_width_internal() - x) - src_x;
+    const int height = std::min(image->get_height(), this->get_height_internal() - y) - src_y;
+    if (width > 0 && height > 0) {
+      this->blit_internal(x + src_x, y + src_y, image, src_x, src_y, width, height, color_on, color_off);
+      App.feed_wdt();
+    }
+    return;
+  }
+
   switch (image->get_type()) {
     case IMAGE_TYPE_BINARY:
       for (int img_x = 0; img_x < image->get_width(); img_x++) {
@@ -346,18 +577,32 @@ void DisplayBuffer::strftime(int x, int y, Font *font, const char *format, time:
 #endif
 
 Glyph::Glyph(const char *a_char, const uint8_t *data_start, uint32_t offset, int offset_x, int offset_y, int width,
-             int height)
+             int height, bool rle)
     : char_(a_char),
       data_(data_start + offset),
       offset_x_(offset_x),
       offset_y_(offset_y),
       width_(width),
-      height_(height) {}
+      height_(height),
+      rle_(rle) {}
 bool Glyph::get_pixel(int x, int y) const {
   const int x_data = x - this->offset_x_;
   const int y_data = y - this->offset_y_;
   if (x_data < 0 || x_data >= this->width_ || y_data < 0 || y_data >= this->height_)
     return false;
+  if (this->rle_) {
+    // skip the runs of all rows above
+    const uint8_t *data = this->data_;
+    for (int row = 0; row < y_data; row++)
+      data += 1 + 2 * pgm_read_byte(data);
+    const uint8_t runs = pgm_read_byte(data++);
+    for (uint8_t i = 0; i < runs; i++, data += 2) {
+      const int start = pgm_read_byte(data);
+      if (x_data >= start && x_data < start + pgm_read_byte(data + 1))
+        return true;
+    }
+    return false;
+  }
   const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
   const uint32_t pos = x_data + y_data * width_8;
   return pgm_read_byte(this->data_ + (pos / 8u)) & (0x80 >> (pos % 8u));
@@ -413,6 +658,23 @@ int Font::match_next_glyph(const char *str, int *match_length) {
 void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
   *baseline = this->baseline_;
   *height = this->bottom_;
+
+  // FNV-1a of the string, 0 marks an unused cache entry
+  uint32_t hash = 2166136261UL;
+  for (const char *p = str; *p != '\0'; p++) {
+    hash ^= uint8_t(*p);
+    hash *= 16777619UL;
+  }
+  if (hash == 0)
+    hash = 1;
+  for (auto &entry : this->measure_cache_) {
+    if (entry.hash == hash) {
+      *width = entry.width;
+      *x_offset = entry.x_offset;
+      return;
+    }
+  }
+
   int i = 0;
   int min_x = 0;
   bool has_char = false;
@@ -440,6 +702,12 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   }
   *x_offset = min_x;
   *width = x - min_x;
+
+  MeasureCacheEntry &entry = this->measure_cache_[this->measure_cache_next_];
+  entry.hash = hash;
+  entry.width = *width;
+  entry.x_offset = *x_offset;
+  this->measure_cache_next_ = (this->measure_cache_next_ + 1) % 4;
 }
 const std::vector<Glyph> &Font::get_glyphs() const { return this->glyphs_; }
 Font::Font(std::vector<Glyph> &&glyphs, int baseline, int bottom)
@@ -448,6 +716,8 @@ Font::Font(std::vector<Glyph> &&glyphs, int baseline, int bottom)
 bool Image::get_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return false;
+  if (this->compressed_)
+    return this->get_compressed_pixel_(x, y, COLOR_ON, COLOR_OFF).is_on();
   const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
   const uint32_t pos = x + y * width_8;
   return pgm_read_byte(this->data_start_ + (pos / 8u)) & (0x80 >> (pos % 8u));
@@ -455,6 +725,8 @@ bool Image::get_pixel(int x, int y) const {
 Color Image::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return 0;
+  if (this->compressed_)
+    return this->get_compressed_pixel_(x, y, COLOR_ON, COLOR_OFF);
   const uint32_t pos = (x + y * this->width_) * 3;
   const uint32_t color32 = (pgm_read_byte(this->data_start_ + pos + 2) << 0) |
                            (pgm_read_byte(this->data_start_ + pos + 1) << 8) |
@@ -464,6 +736,8 @@ Color Image::get_color_pixel(int x, int y) const {
 Color Image::get_grayscale_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return 0;
+  if (this->compressed_)
+    return this->get_compressed_pixel_(x, y, COLOR_ON, COLOR_OFF);
   const uint32_t pos = (x + y * this->width_);
   const uint8_t gray = pgm_read_byte(this->data_start_ + pos);
   return Color(gray | gray << 8 | gray << 16 | gray << 24);
@@ -471,12 +745,35 @@ Color Image::get_grayscale_pixel(int x, int y) const {
 int Image::get_width() const { return this->width_; }
 int Image::get_height() const { return this->height_; }
 ImageType Image::get_type() const { return this->type_; }
+const uint8_t *Image::get_frame_data() const {
+  if (this->compressed_)
+    return this->get_compressed_frame_(0);
+  return this->data_start_;
+}
+const uint8_t *Image::get_compressed_frame_(int frame) const {
+  const uint8_t *entry = this->data_start_ + frame * 4;
+  const uint32_t offset = uint32_t(pgm_read_byte(entry)) | (uint32_t(pgm_read_byte(entry + 1)) << 8) |
+                          (uint32_t(pgm_read_byte(entry + 2)) << 16) | (uint32_t(pgm_read_byte(entry + 3)) << 24);
+  return this->data_start_ + offset;
+}
+Color Image::get_compressed_pixel_(int x, int y, Color color_on, Color color_off) const {
+  ImageDecoder decoder(this, color_on, color_off);
+  int run_x, run_y, length;
+  Color color;
+  while (decoder.next_run(&run_x, &run_y, &length, &color)) {
+    if (run_y == y && x >= run_x && x < run_x + length)
+      return color;
+  }
+  return color_off;
+}
 Image::Image(const uint8_t *data_start, int width, int height, ImageType type)
     : width_(width), height_(height), type_(type), data_start_(data_start) {}
 
 bool Animation::get_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return false;
+  if (this->compressed_)
+    return this->get_compressed_pixel_(x, y, COLOR_ON, COLOR_OFF).is_on();
   const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
   const uint32_t frame_index = this->height_ * width_8 * this->current_frame_;
   if (frame_index >= this->width_ * this->height_ * this->animation_frame_count_)
@@ -487,6 +784,8 @@ bool Animation::get_pixel(int x, int y) const {
 Color Animation::get_color_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return 0;
+  if (this->compressed_)
+    return this->get_compressed_pixel_(x, y, COLOR_ON, COLOR_OFF);
   const uint32_t frame_index = this->width_ * this->height_ * this->current_frame_;
   if (frame_index >= this->width_ * this->height_ * this->animation_frame_count_)
     return 0;
@@ -499,6 +798,8 @@ Color Animation::get_color_pixel(int x, int y) const {
 Color Animation::get_grayscale_pixel(int x, int y) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return 0;
+  if (this->compressed_)
+    return this->get_compressed_pixel_(x, y, COLOR_ON, COLOR_OFF);
   const uint32_t frame_index = this->width_ * this->height_ * this->current_frame_;
   if (frame_index >= this->width_ * this->height_ * this->animation_frame_count_)
     return 0;
@@ -506,6 +807,19 @@ Color Animation::get_grayscale_pixel(int x, int y) const {
   const uint8_t gray = pgm_read_byte(this->data_start_ + pos);
   return Color(gray | gray << 8 | gray << 16 | gray << 24);
 }
+const uint8_t *Animation::get_frame_data() const {
+  if (this->compressed_)
+    return this->get_compressed_frame_(this->current_frame_);
+  switch (this->type_) {
+    case IMAGE_TYPE_BINARY:
+      return this->data_start_ + this->current_frame_ * this->height_ * ((this->width_ + 7u) / 8u);
+    case IMAGE_TYPE_GRAYSCALE:
+      return this->data_start_ + this->current_frame_ * this->width_ * this->height_;
+    case IMAGE_TYPE_RGB24:
+    default:
+      return this->data_start_ + this->current_frame_ * this->width_ * this->height_ * 3;
+  }
+}
 Animation::Animation(const uint8_t *data_start, int width, int height, uint32_t animation_frame_count, ImageType type)
     : Image(data_start, width, height, type), animation_frame_count_(animation_frame_count) {
   current_frame_ = 0;
@@ -519,6 +833,50 @@ void Animation::next_frame() {
   }
 }
 
+ImageDecoder::ImageDecoder(const Image *image, Color color_on, Color color_off)
+    : image_(image), data_(image->get_frame_data()), color_on_(color_on), color_off_(color_off) {}
+bool HOT ImageDecoder::next_run(int *x, int *y, int *length, Color *color) {
+  if (this->y_ >= this->image_->get_height())
+    return false;
+  *x = this->x_;
+  *y = this->y_;
+  if (this->image_->get_type() == IMAGE_TYPE_BINARY) {
+    const uint8_t run = pgm_read_byte(this->data_++);
+    *length = (run & 0x7F) + 1;
+    *color = (run & 0x80) ? this->color_on_ : this->color_off_;
+  } else if (this->literals_left_ > 0) {
+    this->literals_left_--;
+    *length = 1;
+    *color = this->read_pixel_();
+  } else {
+    const uint8_t header = pgm_read_byte(this->data_++);
+    if (header & 0x80) {
+      *length = (header & 0x7F) + 1;
+    } else {
+      this->literals_left_ = header;
+      *length = 1;
+    }
+    *color = this->read_pixel_();
+  }
+
+  this->x_ += *length;
+  if (this->x_ >= this->image_->get_width()) {
+    this->x_ = 0;
+    this->y_++;
+  }
+  return true;
+}
+Color ImageDecoder::read_pixel_() {
+  if (this->image_->get_type() == IMAGE_TYPE_GRAYSCALE) {
+    const uint8_t gray = pgm_read_byte(this->data_++);
+    return Color(gray | gray << 8 | gray << 16 | gray << 24);
+  }
+  const uint32_t color32 = (pgm_read_byte(this->data_ + 2) << 0) | (pgm_read_byte(this->data_ + 1) << 8) |
+                           (pgm_read_byte(this->data_ + 0) << 16);
+  this->data_ += 3;
+  return Color(color32);
+}
+
 DisplayPage::DisplayPage(const display_writer_t &writer) : writer_(writer) {}
 void DisplayPage::show() { this->parent_->show_page(this); }
 void DisplayPage::show_next() { this->next_->show(); }
@@ -4,11 +4,18 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/color.h"
+#include "esphome/core/helpers.h"
 
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
 #endif
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 namespace display {
 
@@ -78,6 +85,7 @@ enum DisplayRotation {
 };
 
 class Font;
+class Glyph;
 class Image;
 class DisplayBuffer;
 class DisplayPage;
@@ -298,12 +306,45 @@ class DisplayBuffer {
 
   /// Internal method to set the display rotation with.
   void set_rotation(DisplayRotation rotation);
+  /// Where the buffer is allocated, by default in PSRAM if available. Must be called before setup().
+  void set_buffer_location(BufferLocation buffer_location) { this->buffer_location_ = buffer_location; }
+#ifdef ARDUINO_ARCH_ESP32
+  /** Draw the frames in a task of their own, only used by drivers that draw with render_(). Must be called before
+   * setup().
+   *
+   * The writer lambda then runs outside of the main loop, while the other components keep running.
+   */
+  void set_render_task(bool render_task) { this->render_task_ = render_task; }
+#endif
+
+  /// How long drawing the last frame took, in µs.
+  uint32_t get_render_time() const { return this->render_time_; }
+  /// How long sending the last frame to the display took, in µs, for drivers that send it from the loop.
+  uint32_t get_flush_time() const { return this->flush_time_; }
 
  protected:
   void vprintf_(int x, int y, Font *font, Color color, TextAlign align, const char *format, va_list arg);
 
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
+  /** Fill a rectangle in internal (unrotated) coordinates, the rectangle is already clipped to the display.
+   *
+   * Drivers override this to fill whole bytes or rows of their buffer at once, the default draws every pixel with
+   * draw_absolute_pixel_internal().
+   */
+  virtual void fill_rect_internal(int x, int y, int width, int height, Color color);
+  /** Draw the part of image starting at [src_x,src_y] at [x,y], in internal coordinates and already clipped.
+   *
+   * Only used without rotation. Drivers override this to convert the image data directly into their buffer, the
+   * default draws every pixel with draw_absolute_pixel_internal().
+   */
+  virtual void blit_internal(int x, int y, Image *image, int src_x, int src_y, int width, int height, Color color_on,
+                             Color color_off);
+  /// Fill a rectangle given in rotated coordinates through fill_rect_internal().
+  void fill_rect_(int x, int y, int width, int height, Color color);
+  /// Draw the set pixels of glyph with its top left corner at [x,y], as one filled rectangle per run of pixels.
+  void draw_glyph_(int x, int y, const Glyph &glyph, Color color);
+
   virtual int get_height_internal() = 0;
 
   virtual int get_width_internal() = 0;
@@ -312,10 +353,76 @@ class DisplayBuffer {
 
   void do_update_();
 
+  /** Draw the next frame like do_update_(), in the render task if it is enabled.
+   *
+   * With the render task this returns right away and the frame is done once is_rendering_() returns false. Returns
+   * false without drawing if the last frame isn't done yet.
+   */
+  bool render_();
+#ifdef ARDUINO_ARCH_ESP32
+  bool is_rendering_() const { return this->rendering_.load(std::memory_order_acquire); }
+#else
+  bool is_rendering_() const { return false; }
+#endif
+  /** Allocate a second buffer for drivers that send the buffer in the background, after init_internal_().
+   *
+   * Only allocated with the render task: the next frame can then be drawn while the last one is still being sent.
+   */
+  void init_second_buffer_(uint32_t buffer_length);
+  /// Whether render_() draws into the other buffer after swap_buffers_(), so the first one can still be sent.
+  bool has_second_buffer_() const { return this->second_buffer_ != nullptr; }
+  /// Draw the next frames into the other buffer, called after the transfer of the current one was started.
+  void swap_buffers_() {
+    if (this->second_buffer_ != nullptr)
+      std::swap(this->buffer_, this->second_buffer_);
+  }
+
+  /** Track which parts of the buffer changed between two updates, for drivers that can write a window of the display.
+   *
+   * The buffer must store the pixels row by row (without rotation) with bytes_per_pixel bytes each. The buffer is
+   * hashed in tiles after every update, so that flush_damage_() can find the damaged tiles even though do_update_()
+   * clears and redraws the whole buffer.
+   */
+  void init_damage_tracking_(uint8_t bytes_per_pixel) { this->init_packed_damage_tracking_(bytes_per_pixel * 8); }
+  /** Like init_damage_tracking_(), for buffers with less than a byte per pixel.
+   *
+   * With 2 or 4 bits per pixel the pixels of a row are packed into bytes. With 1 bit per pixel the buffer is expected
+   * in pages like the SSD1306 stores it: each byte holds 8 vertical pixels and each page 8 rows.
+   */
+  void init_packed_damage_tracking_(uint8_t bits_per_pixel);
+  /// Mark the whole display as damaged, for example when the display memory was written without the buffer.
+  void invalidate_damage_() { this->damage_valid_ = false; }
+  /** Call write_region_() for every region of the buffer that changed since the last flush.
+   *
+   * Damaged tiles in consecutive tile rows are merged into one rectangle to keep the number of windows low. Writes the
+   * whole display as one region if damage tracking isn't enabled.
+   */
+  void flush_damage_();
+  /// Write the given window of the buffer to the display, called by flush_damage_().
+  virtual void write_region_(int x, int y, int width, int height) {}
+
   uint8_t *buffer_{nullptr};
+  /// The buffer the render task doesn't draw into, nullptr without the render task.
+  uint8_t *second_buffer_{nullptr};
+  BufferLocation buffer_location_{BUFFER_LOCATION_PREFER_EXTERNAL};
   DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
   optional<display_writer_t> writer_{};
   DisplayPage *page_{nullptr};
+  /// The hashes of all tiles of the buffer at the last flush, empty if damage tracking isn't enabled.
+  std::vector<uint32_t> damage_hashes_{};
+  uint8_t damage_bits_per_pixel_{0};
+  /// Whether damage_hashes_ match what the display shows.
+  bool damage_valid_{false};
+  uint32_t render_time_{0};
+  uint32_t flush_time_{0};
+#ifdef ARDUINO_ARCH_ESP32
+  void start_render_task_();
+  static void render_task_loop_(void *arg);
+
+  bool render_task_{false};
+  TaskHandle_t render_task_handle_{nullptr};
+  std::atomic<bool> rendering_{false};
+#endif
 };
 
 class DisplayPage {
@@ -338,8 +445,13 @@ class DisplayPage {
 
 class Glyph {
  public:
+  /** Construct a glyph.
+   *
+   * The data is either a bitmap with the rows padded to full bytes, or if rle is true, for every row the number of
+   * runs of set pixels followed by the start and length of each run.
+   */
   Glyph(const char *a_char, const uint8_t *data_start, uint32_t offset, int offset_x, int offset_y, int width,
-        int height);
+        int height, bool rle = false);
 
   bool get_pixel(int x, int y) const;
 
@@ -361,6 +473,7 @@ class Glyph {
   int offset_y_;
   int width_;
   int height_;
+  bool rle_;
 };
 
 class Font {
@@ -380,9 +493,18 @@ class Font {
   const std::vector<Glyph> &get_glyphs() const;
 
  protected:
+  /// Strings measured recently, status and clock screens print the same strings on every update.
+  struct MeasureCacheEntry {
+    uint32_t hash;
+    int width;
+    int x_offset;
+  };
+
   std::vector<Glyph> glyphs_;
   int baseline_;
   int bottom_;
+  MeasureCacheEntry measure_cache_[4]{};
+  uint8_t measure_cache_next_{0};
 };
 
 class Image {
@@ -394,12 +516,53 @@ class Image {
   int get_width() const;
   int get_height() const;
   ImageType get_type() const;
+  /// The raw (PROGMEM) data of the image, for animations the data of the current frame.
+  virtual const uint8_t *get_frame_data() const;
+
+  /** Mark the data as run-length compressed, see ImageDecoder for the format.
+   *
+   * The data then starts with a table of the little endian uint32 offsets of all frames.
+   */
+  void set_compressed(bool compressed) { this->compressed_ = compressed; }
+  bool is_compressed() const { return this->compressed_; }
 
  protected:
+  /// Start of the compressed data of frame.
+  const uint8_t *get_compressed_frame_(int frame) const;
+  /// Decode the compressed current frame up to [x,y], slow but only needed by direct pixel access.
+  Color get_compressed_pixel_(int x, int y, Color color_on, Color color_off) const;
+
   int width_;
   int height_;
   ImageType type_;
   const uint8_t *data_start_;
+  bool compressed_{false};
+};
+
+/** Streams the current frame of a compressed image row by row as runs of equally colored pixels.
+ *
+ * Every row is encoded on its own. Binary images use one byte per run, the top bit is the pixel value and the
+ * lower 7 bits the run length minus one. Grayscale and RGB24 images use packets with a header byte:
+ * with the top bit set a run of (header & 0x7F) + 1 copies of the following pixel, otherwise header + 1
+ * literal pixels follow.
+ */
+class ImageDecoder {
+ public:
+  ImageDecoder(const Image *image, Color color_on, Color color_off);
+
+  /// Decode the next run, returns false at the end of the frame. Runs never cross rows.
+  bool next_run(int *x, int *y, int *length, Color *color);
+
+ protected:
+  Color read_pixel_();
+
+  const Image *image_;
+  const uint8_t *data_;
+  Color color_on_;
+  Color color_off_;
+  int x_{0};
+  int y_{0};
+  uint8_t literals_left_{0};
 };
 
 class Animation : public Image {
@@ -408,6 +571,7 @@ class Animation : public Image {
   bool get_pixel(int x, int y) const override;
   Color get_color_pixel(int x, int y) const override;
   Color get_grayscale_pixel(int x, int y) const override;
+  const uint8_t *get_frame_data() const override;
 
   int get_animation_frame_count() const;
   int get_current_frame() const;
@@ -0,0 +1,84 @@
+#include "epaper_refresh.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace display {
+
+static const char *TAG = "display.epaper_refresh";
+
+/// The size of the tiles in which frames are compared, in bytes and rows.
+static const uint32_t TILE_WIDTH = 8;
+static const uint32_t TILE_HEIGHT = 8;
+
+void EPaperRefreshPlanner::init(uint32_t stride, uint32_t rows) {
+  this->stride_ = stride;
+  this->rows_ = rows;
+  this->tile_cols_ = (stride + TILE_WIDTH - 1) / TILE_WIDTH;
+  this->tile_rows_ = (rows + TILE_HEIGHT - 1) / TILE_HEIGHT;
+  this->hashes_.assign(this->tile_cols_ * this->tile_rows_, 0);
+  this->partial_refreshes_.assign(this->tile_cols_ * this->tile_rows_, 0);
+  this->full_requested_ = true;
+}
+EPaperRefresh EPaperRefreshPlanner::plan(const uint8_t *buffer) {
+  EPaperRefresh refresh{EPAPER_REFRESH_FULL, 0, 0, this->stride_, this->rows_};
+  if (buffer == nullptr || this->hashes_.empty())
+    return refresh;
+
+  // the changed window in tiles, and whether a changed tile is out of partial refreshes
+  uint32_t col1 = UINT32_MAX, col2 = 0, row1 = UINT32_MAX, row2 = 0;
+  bool over_budget = this->max_partial_refreshes_ == 0;
+  const uint32_t budget = std::min<uint32_t>(this->max_partial_refreshes_, 255);
+  for (uint32_t row = 0; row < this->tile_rows_; row++) {
+    const uint32_t y = row * TILE_HEIGHT;
+    const uint32_t height = std::min(TILE_HEIGHT, this->rows_ - y);
+    for (uint32_t col = 0; col < this->tile_cols_; col++) {
+      const uint32_t x = col * TILE_WIDTH;
+      const uint32_t width = std::min(TILE_WIDTH, this->stride_ - x);
+      // FNV-1a over all bytes of the tile
+      uint32_t hash = 2166136261UL;
+      const uint8_t *line = buffer + y * this->stride_ + x;
+      for (uint32_t i = 0; i < height; i++, line += this->stride_) {
+        for (uint32_t j = 0; j < width; j++) {
+          hash ^= line[j];
+          hash *= 16777619UL;
+        }
+      }
+
+      const uint32_t index = row * this->tile_cols_ + col;
+      if (hash == this->hashes_[index])
+        continue;
+      this->hashes_[index] = hash;
+      col1 = std::min(col1, col);
+      col2 = std::max(col2, col);
+      row1 = std::min(row1, row);
+      row2 = row;
+      uint8_t &count = this->partial_refreshes_[index];
+      if (this->max_partial_refreshes_ != UNLIMITED && count >= budget)
+        over_budget = true;
+      if (count < 255)
+        count++;
+    }
+  }
+
+  if (this->full_requested_ || (col1 != UINT32_MAX && over_budget)) {
+    this->full_requested_ = false;
+    std::fill(this->partial_refreshes_.begin(), this->partial_refreshes_.end(), 0);
+    ESP_LOGV(TAG, "Planned full refresh");
+    return refresh;
+  }
+  if (col1 == UINT32_MAX) {
+    refresh.mode = EPAPER_REFRESH_NONE;
+    return refresh;
+  }
+
+  refresh.mode = EPAPER_REFRESH_PARTIAL;
+  refresh.x = col1 * TILE_WIDTH;
+  refresh.y = row1 * TILE_HEIGHT;
+  refresh.width = std::min((col2 + 1) * TILE_WIDTH, this->stride_) - refresh.x;
+  refresh.height = std::min((row2 + 1) * TILE_HEIGHT, this->rows_) - refresh.y;
+  ESP_LOGV(TAG, "Planned partial refresh x=%u y=%u w=%u h=%u", refresh.x, refresh.y, refresh.width, refresh.height);
+  return refresh;
+}
+
+}  // namespace display
+}  // namespace esphome
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace display {
+
+enum EPaperRefreshMode {
+  /// Nothing changed since the last refresh.
+  EPAPER_REFRESH_NONE = 0,
+  /// Only refresh the changed window with the fast waveform.
+  EPAPER_REFRESH_PARTIAL,
+  /// Refresh the whole panel with the full waveform to clear ghosting.
+  EPAPER_REFRESH_FULL,
+};
+
+struct EPaperRefresh {
+  EPaperRefreshMode mode;
+  /// The window to refresh, x and width in bytes of a buffer row, y and height in rows.
+  uint32_t x;
+  uint32_t y;
+  uint32_t width;
+  uint32_t height;
+};
+
+/** Decides how e-paper panels have to be refreshed.
+ *
+ * Every new frame buffer is compared to the last displayed one in tiles of 8 bytes by 8 rows. Only the window of
+ * changed tiles has to be refreshed, and nothing at all if the frame didn't change. Partial refreshes leave ghosting
+ * behind, so the planner counts them for every tile and schedules a full refresh once a changed tile is out of budget.
+ */
+class EPaperRefreshPlanner {
+ public:
+  /// Set the layout of the frame buffer, stride is the number of bytes per row.
+  void init(uint32_t stride, uint32_t rows);
+  /// How many partial refreshes a tile may take before a full refresh, 0 for only full refreshes.
+  void set_max_partial_refreshes(uint32_t max_partial_refreshes) {
+    this->max_partial_refreshes_ = max_partial_refreshes;
+  }
+
+  /// Compare buffer with the last displayed frame and plan the refresh, buffer is then the last displayed frame.
+  EPaperRefresh plan(const uint8_t *buffer);
+  /// The next refresh has to be a full one, for example because the planned one could not be done.
+  void request_full() { this->full_requested_ = true; }
+
+  static const uint32_t UNLIMITED = UINT32_MAX;
+
+ protected:
+  uint32_t stride_{0};
+  uint32_t rows_{0};
+  uint32_t tile_cols_{0};
+  uint32_t tile_rows_{0};
+  uint32_t max_partial_refreshes_{0};
+  /// The hashes of all tiles of the last displayed frame.
+  std::vector<uint32_t> hashes_{};
+  /// The partial refreshes of every tile since the last full refresh, saturating.
+  std::vector<uint8_t> partial_refreshes_{};
+  bool full_requested_{true};
+};
+
+}  // namespace display
+}  // namespace esphome
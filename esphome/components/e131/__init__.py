@@ -19,12 +19,14 @@ CHANNELS = {
     'RGBW': e131_ns.E131_RGBW
 }
 
+CONF_ARTNET = 'artnet'
 CONF_UNIVERSE = 'universe'
 CONF_E131_ID = 'e131_id'
 
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(E131Component),
     cv.Optional(CONF_METHOD, default='MULTICAST'): cv.one_of(*METHODS, upper=True),
+    cv.Optional(CONF_ARTNET, default=False): cv.boolean,
 })
 
 
@@ -32,6 +34,7 @@ def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
     cg.add(var.set_method(METHODS[config[CONF_METHOD]]))
+    cg.add(var.set_artnet(config[CONF_ARTNET]))
 
 
 @register_addressable_effect('e131', E131AddressableLightEffect, "E1.31", {
@@ -16,6 +16,9 @@ namespace e131 {
 
 static const char *TAG = "e131";
 static const int PORT = 5568;
+static const int ARTNET_PORT = 6454;
+/// Art-Net receivers fall back to applying data right away when ArtSync packets stop for this long.
+static const uint32_t ARTNET_SYNC_TIMEOUT = 4000;
 
 E131Component::E131Component() {}
 
@@ -23,6 +26,9 @@ E131Component::~E131Component() {
   if (udp_) {
     udp_->stop();
   }
+  if (artnet_udp_) {
+    artnet_udp_->stop();
+  }
 }
 
 void E131Component::setup() {
@@ -34,23 +40,77 @@ void E131Component::setup() {
     return;
   }
 
+  if (artnet_) {
+    artnet_udp_.reset(new WiFiUDP());
+    if (!artnet_udp_->begin(ARTNET_PORT)) {
+      ESP_LOGE(TAG, "Cannot bind Art-Net to %d.", ARTNET_PORT);
+      artnet_udp_.reset();
+    }
+  }
+
   join_igmp_groups_();
 }
 
 void E131Component::loop() {
-  std::vector<uint8_t> payload;
+  receive_(udp_.get(), false);
+  if (artnet_udp_) {
+    receive_(artnet_udp_.get(), true);
+  }
+
+  if (artnet_synced_ && millis() - last_artnet_sync_ > ARTNET_SYNC_TIMEOUT) {
+    ESP_LOGD(TAG, "No ArtSync received for %us, applying Art-Net data right away.", ARTNET_SYNC_TIMEOUT / 1000);
+    artnet_synced_ = false;
+    release_();
+  }
+}
+
+void E131Component::receive_(UDP *udp, bool artnet) {
   E131Packet packet;
   int universe = 0;
+  uint16_t sync_address = 0;
+
+  while (int packet_size = udp->parsePacket()) {
+    if (packet_size > int(sizeof(buffer_))) {
+      ESP_LOGV(TAG, "Ignored packet of size %d.", packet_size);
+      udp->flush();
+      continue;
+    }
+    int size = udp->read(buffer_, packet_size);
+    if (size <= 0) {
+      continue;
+    }
 
-  while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    PacketType type;
+    if (artnet) {
+      type = artnet_packet_(buffer_, size, universe, packet);
+      sync_address = 0;
+    } else {
+      type = packet_(buffer_, size, universe, sync_address, packet);
+    }
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (type == PACKET_INVALID) {
+      ESP_LOGV(TAG, "Invalid packet recevied of size %d.", size);
       continue;
     }
 
-    if (!packet_(payload, universe, packet)) {
-      ESP_LOGV(TAG, "Invalid packet recevied of size %zu.", payload.size());
+    if (type == PACKET_SYNC) {
+      if (artnet) {
+        artnet_synced_ = true;
+        last_artnet_sync_ = millis();
+        release_();
+      } else if (sync_address == pending_sync_address_) {
+        release_();
+      }
+      continue;
+    }
+
+    if (sync_address != 0 || (artnet && artnet_synced_)) {
+      if (sync_address != pending_sync_address_) {
+        // a new synchronization address, drop what waited for the old one
+        pending_universes_.clear();
+        pending_sync_address_ = sync_address;
+      }
+      hold_(universe, packet);
       continue;
     }
 
@@ -60,6 +120,31 @@ void E131Component::loop() {
   }
 }
 
+void E131Component::hold_(int universe, const E131Packet &packet) {
+  E131PendingUniverse *pending = nullptr;
+  for (auto &candidate : pending_universes_) {
+    if (candidate.universe == universe) {
+      pending = &candidate;
+      break;
+    }
+  }
+  if (pending == nullptr) {
+    pending_universes_.emplace_back();
+    pending = &pending_universes_.back();
+    pending->universe = universe;
+  }
+  pending->count = packet.count;
+  memcpy(pending->values, packet.values, packet.count);
+}
+
+void E131Component::release_() {
+  for (auto &pending : pending_universes_) {
+    E131Packet packet{pending.count, pending.values};
+    process_(pending.universe, packet);
+  }
+  pending_universes_.clear();
+}
+
 void E131Component::add_effect(E131AddressableLightEffect *light_effect) {
   if (light_effects_.count(light_effect)) {
     return;
@@ -4,7 +4,7 @@
 
 #include <memory>
 #include <set>
-#include <map>
+#include <vector>
 
 class UDP;
 
@@ -16,10 +16,20 @@ class E131AddressableLightEffect;
 enum E131ListenMethod { E131_MULTICAST, E131_UNICAST };
 
 const int E131_MAX_PROPERTY_VALUES_COUNT = 513;
+/// The number of DMX slots in a universe, the property values without the start code.
+const int E131_MAX_SLOTS = E131_MAX_PROPERTY_VALUES_COUNT - 1;
 
+/// The DMX data of a universe, points into the receive buffer.
 struct E131Packet {
+  uint16_t count;  ///< The number of DMX slots, without the start code.
+  const uint8_t *values;
+};
+
+/// The data of a universe that waits for a synchronization packet.
+struct E131PendingUniverse {
+  int universe;
   uint16_t count;
-  uint8_t values[E131_MAX_PROPERTY_VALUES_COUNT];
+  uint8_t values[E131_MAX_SLOTS];
 };
 
 class E131Component : public esphome::Component {
@@ -37,20 +47,47 @@ class E131Component : public esphome::Component {
 
  public:
   void set_method(E131ListenMethod listen_method) { this->listen_method_ = listen_method; }
+  /// Also listen for Art-Net ArtDmx packets, the Art-Net port address is used as universe.
+  void set_artnet(bool artnet) { this->artnet_ = artnet; }
 
  protected:
-  bool packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet);
+  enum PacketType { PACKET_INVALID, PACKET_DATA, PACKET_SYNC };
+
+  /// Read and handle all packets waiting on the socket.
+  void receive_(UDP *udp, bool artnet);
+  /** Parse an E1.31 packet in place, packet points into data afterwards.
+   *
+   * @param sync_address The synchronization address of a data packet (0 if it isn't synchronized), or the address
+   *                     of a synchronization packet.
+   */
+  PacketType packet_(const uint8_t *data, size_t size, int &universe, uint16_t &sync_address, E131Packet &packet);
+  /// Parse an Art-Net packet in place, ArtSync packets are returned as PACKET_SYNC.
+  PacketType artnet_packet_(const uint8_t *data, size_t size, int &universe, E131Packet &packet);
   bool process_(int universe, const E131Packet &packet);
+  /// Keep the data of a synchronized universe until the synchronization packet arrives.
+  void hold_(int universe, const E131Packet &packet);
+  /// Apply the data of all universes that waited for a synchronization packet.
+  void release_();
   bool join_igmp_groups_();
   void join_(int universe);
   void leave_(int universe);
 
  protected:
   E131ListenMethod listen_method_{E131_MULTICAST};
+  bool artnet_{false};
   std::unique_ptr<UDP> udp_;
+  std::unique_ptr<UDP> artnet_udp_;
   std::set<E131AddressableLightEffect *> light_effects_;
-  std::map<int, int> universe_consumers_;
-  std::map<int, E131Packet> universe_packets_;
+  /// The number of effects using each universe, indexed by universe.
+  std::vector<uint16_t> universe_consumers_;
+  std::vector<E131PendingUniverse> pending_universes_;
+  /// The E1.31 synchronization address the pending universes wait for.
+  uint16_t pending_sync_address_{0};
+  /// Art-Net senders that use ArtSync send it for every frame, data is held until then.
+  uint32_t last_artnet_sync_{0};
+  bool artnet_synced_{false};
+  /// Packets are parsed in place in this buffer, large enough for the largest E1.31 packet.
+  uint8_t buffer_[638];
 };
 
 }  // namespace e131
@@ -6,7 +6,7 @@ namespace esphome {
 namespace e131 {
 
 static const char *TAG = "e131_addressable_light_effect";
-static const int MAX_DATA_SIZE = (sizeof(E131Packet::values) - 1);
+static const int MAX_DATA_SIZE = E131_MAX_SLOTS;
 
 E131AddressableLightEffect::E131AddressableLightEffect(const std::string &name) : AddressableLightEffect(name) {}
 
@@ -53,12 +53,21 @@ bool E131AddressableLightEffect::process_(int universe, const E131Packet &packet
 
   int output_offset = (universe - first_universe_) * get_lights_per_universe();
   // limit amount of lights per universe and received
-  int output_end = std::min(it->size(), std::min(output_offset + get_lights_per_universe(), packet.count - 1));
-  auto input_data = packet.values + 1;
+  int output_end = std::min(it->size(), output_offset + std::min(get_lights_per_universe(), packet.count / channels_));
+  auto input_data = packet.values;
 
   ESP_LOGV(TAG, "Applying data for '%s' on %d universe, for %d-%d.", get_name().c_str(), universe, output_offset,
            output_end);
 
+  if (output_end <= output_offset)
+    return true;
+
+  if (channels_ == E131_RGB && !it->get_traits().get_supports_rgb_white_value()) {
+    // without a white channel the DMX slots can be written to the LEDs as they are
+    it->write_rgb_span(input_data, output_end - output_offset, output_offset);
+    return true;
+  }
+
   switch (channels_) {
     case E131_MONO:
       for (; output_offset < output_end; output_offset++, input_data++) {
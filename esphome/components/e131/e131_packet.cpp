@@ -5,6 +5,8 @@
 #include <lwip/ip_addr.h>
 #include <lwip/igmp.h>
 
+#include <cstddef>
+
 namespace esphome {
 namespace e131 {
 
@@ -12,8 +14,15 @@ static const char *TAG = "e131";
 
 static const uint8_t ACN_ID[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
 static const uint32_t VECTOR_ROOT = 4;
+static const uint32_t VECTOR_ROOT_EXTENDED = 8;
 static const uint32_t VECTOR_FRAME = 2;
+static const uint32_t VECTOR_FRAME_SYNCHRONIZATION = 1;
 static const uint8_t VECTOR_DMP = 2;
+static const uint8_t OPTION_PREVIEW_DATA = 0x80;
+
+static const uint8_t ARTNET_ID[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0x00};
+static const uint16_t ARTNET_OP_DMX = 0x5000;
+static const uint16_t ARTNET_OP_SYNC = 0x5200;
 
 // E1.31 Packet Structure
 union E131RawPacket {
@@ -31,7 +40,7 @@ union E131RawPacket {
     uint32_t frame_vector;
     uint8_t source_name[64];
     uint8_t priority;
-    uint16_t reserved;
+    uint16_t sync_address;
     uint8_t sequence_number;
     uint8_t options;
     uint16_t universe;
@@ -53,23 +62,56 @@ union E131RawPacket {
 // Get the offset of `property_values[1]`
 const long E131_MIN_PACKET_SIZE = reinterpret_cast<long>(&((E131RawPacket *) nullptr)->property_values[1]);
 
+// E1.31 Synchronization Packet Structure
+struct E131RawSyncPacket {
+  // Root Layer
+  uint16_t preamble_size;
+  uint16_t postamble_size;
+  uint8_t acn_id[12];
+  uint16_t root_flength;
+  uint32_t root_vector;
+  uint8_t cid[16];
+
+  // Synchronization Frame Layer
+  uint16_t frame_flength;
+  uint32_t frame_vector;
+  uint8_t sequence_number;
+  uint16_t sync_address;
+  uint16_t reserved;
+} __attribute__((packed));
+
+// Art-Net ArtDmx Packet Structure, ArtSync packets only have the header
+struct ArtNetRawPacket {
+  uint8_t id[8];
+  uint16_t opcode;  // little endian
+  uint16_t protocol_version;
+  uint8_t sequence;
+  uint8_t physical;
+  uint16_t port_address;  // little endian, sub-net and universe in the low byte, net in the high byte
+  uint16_t length;
+  uint8_t data[512];
+} __attribute__((packed));
+
+static const size_t ARTNET_HEADER_SIZE = 12;
+static const size_t ARTNET_DMX_HEADER_SIZE = 18;
+
 bool E131Component::join_igmp_groups_() {
   if (listen_method_ != E131_MULTICAST)
     return false;
   if (!udp_)
     return false;
 
-  for (auto universe : universe_consumers_) {
-    if (!universe.second)
+  for (int universe = 0; universe < int(universe_consumers_.size()); universe++) {
+    if (!universe_consumers_[universe])
       continue;
 
     ip4_addr_t multicast_addr = {
-        static_cast<uint32_t>(IPAddress(239, 255, ((universe.first >> 8) & 0xff), ((universe.first >> 0) & 0xff)))};
+        static_cast<uint32_t>(IPAddress(239, 255, ((universe >> 8) & 0xff), ((universe >> 0) & 0xff)))};
 
     auto err = igmp_joingroup(IP4_ADDR_ANY4, &multicast_addr);
 
     if (err) {
-      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe.first);
+      ESP_LOGW(TAG, "IGMP join for %d universe of E1.31 failed. Multicast might not work.", universe);
     }
   }
 
@@ -77,7 +119,8 @@ bool E131Component::join_igmp_groups_() {
 }
 
 void E131Component::join_(int universe) {
-  // store only latest received packet for the given universe
+  if (universe >= int(universe_consumers_.size()))
+    universe_consumers_.resize(universe + 1);
   auto consumers = ++universe_consumers_[universe];
 
   if (consumers > 1) {
@@ -90,6 +133,8 @@ void E131Component::join_(int universe) {
 }
 
 void E131Component::leave_(int universe) {
+  if (universe >= int(universe_consumers_.size()) || universe_consumers_[universe] == 0)
+    return;
   auto consumers = --universe_consumers_[universe];
 
   if (consumers > 0) {
@@ -106,30 +151,74 @@ void E131Component::leave_(int universe) {
   ESP_LOGD(TAG, "Left %d universe for E1.31.", universe);
 }
 
-bool E131Component::packet_(const std::vector<uint8_t> &data, int &universe, E131Packet &packet) {
-  if (data.size() < E131_MIN_PACKET_SIZE)
-    return false;
+E131Component::PacketType E131Component::packet_(const uint8_t *data, size_t size, int &universe,
+                                                 uint16_t &sync_address, E131Packet &packet) {
+  if (size < sizeof(E131RawSyncPacket))
+    return PACKET_INVALID;
 
-  auto sbuff = reinterpret_cast<const E131RawPacket *>(&data[0]);
+  auto sbuff = reinterpret_cast<const E131RawPacket *>(data);
 
   if (memcmp(sbuff->acn_id, ACN_ID, sizeof(sbuff->acn_id)) != 0)
-    return false;
+    return PACKET_INVALID;
+
+  if (htonl(sbuff->root_vector) == VECTOR_ROOT_EXTENDED) {
+    auto sync = reinterpret_cast<const E131RawSyncPacket *>(data);
+    if (htonl(sync->frame_vector) != VECTOR_FRAME_SYNCHRONIZATION)
+      return PACKET_INVALID;
+    sync_address = htons(sync->sync_address);
+    return PACKET_SYNC;
+  }
+
+  if (size < E131_MIN_PACKET_SIZE)
+    return PACKET_INVALID;
   if (htonl(sbuff->root_vector) != VECTOR_ROOT)
-    return false;
+    return PACKET_INVALID;
   if (htonl(sbuff->frame_vector) != VECTOR_FRAME)
-    return false;
+    return PACKET_INVALID;
   if (sbuff->dmp_vector != VECTOR_DMP)
-    return false;
+    return PACKET_INVALID;
   if (sbuff->property_values[0] != 0)
-    return false;
+    return PACKET_INVALID;
+  // preview data is meant for visualizers, not for the actual lights
+  if (sbuff->options & OPTION_PREVIEW_DATA)
+    return PACKET_INVALID;
+
+  uint16_t count = htons(sbuff->property_value_count);
+  if (count > E131_MAX_PROPERTY_VALUES_COUNT || count > size - offsetof(E131RawPacket, property_values))
+    return PACKET_INVALID;
 
   universe = htons(sbuff->universe);
-  packet.count = htons(sbuff->property_value_count);
-  if (packet.count > E131_MAX_PROPERTY_VALUES_COUNT)
-    return false;
+  sync_address = htons(sbuff->sync_address);
+  packet.count = count - 1;
+  packet.values = sbuff->property_values + 1;
+  return PACKET_DATA;
+}
 
-  memcpy(packet.values, sbuff->property_values, packet.count);
-  return true;
+E131Component::PacketType E131Component::artnet_packet_(const uint8_t *data, size_t size, int &universe,
+                                                        E131Packet &packet) {
+  if (size < ARTNET_HEADER_SIZE)
+    return PACKET_INVALID;
+
+  auto sbuff = reinterpret_cast<const ArtNetRawPacket *>(data);
+
+  if (memcmp(sbuff->id, ARTNET_ID, sizeof(sbuff->id)) != 0)
+    return PACKET_INVALID;
+
+  // Art-Net is little endian, except for the protocol version and length
+  const uint16_t opcode = data[8] | (data[9] << 8);
+  if (opcode == ARTNET_OP_SYNC)
+    return PACKET_SYNC;
+  if (opcode != ARTNET_OP_DMX || size < ARTNET_DMX_HEADER_SIZE)
+    return PACKET_INVALID;
+
+  uint16_t length = htons(sbuff->length);
+  if (length > sizeof(sbuff->data) || length > size - ARTNET_DMX_HEADER_SIZE)
+    return PACKET_INVALID;
+
+  universe = data[14] | ((data[15] & 0x7f) << 8);
+  packet.count = length;
+  packet.values = sbuff->data;
+  return PACKET_DATA;
 }
 
 }  // namespace e131
@@ -4,7 +4,7 @@ from esphome import automation
 from esphome.components import binary_sensor, cover
 from esphome.const import CONF_CLOSE_ACTION, CONF_CLOSE_DURATION, \
     CONF_CLOSE_ENDSTOP, CONF_ID, CONF_OPEN_ACTION, CONF_OPEN_DURATION, \
-    CONF_OPEN_ENDSTOP, CONF_STOP_ACTION, CONF_MAX_DURATION
+    CONF_OPEN_ENDSTOP, CONF_STOP_ACTION, CONF_MAX_DURATION, CONF_MIN_PUBLISH_INTERVAL
 
 endstop_ns = cg.esphome_ns.namespace('endstop')
 EndstopCover = endstop_ns.class_('EndstopCover', cover.Cover, cg.Component)
@@ -22,6 +22,7 @@ CONFIG_SCHEMA = cover.COVER_SCHEMA.extend({
     cv.Required(CONF_CLOSE_DURATION): cv.positive_time_period_milliseconds,
 
     cv.Optional(CONF_MAX_DURATION): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_MIN_PUBLISH_INTERVAL, default='1s'): cv.positive_time_period_milliseconds,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -44,3 +45,4 @@ def to_code(config):
 
     if CONF_MAX_DURATION in config:
         cg.add(var.set_max_duration(config[CONF_MAX_DURATION]))
+    cg.add(var.set_min_publish_interval(config[CONF_MIN_PUBLISH_INTERVAL]))
@@ -56,40 +56,33 @@ void EndstopCover::loop() {
 
     this->start_direction_(COVER_OPERATION_IDLE);
     this->position = COVER_OPEN;
-    this->publish_state();
   } else if (this->current_operation == COVER_OPERATION_CLOSING && this->is_closed_()) {
     float dur = (now - this->start_dir_time_) / 1e3f;
     ESP_LOGD(TAG, "'%s' - Close endstop reached. Took %.1fs.", this->name_.c_str(), dur);
 
     this->start_direction_(COVER_OPERATION_IDLE);
     this->position = COVER_CLOSED;
-    this->publish_state();
   } else if (now - this->start_dir_time_ > this->max_duration_) {
     ESP_LOGD(TAG, "'%s' - Max duration reached. Stopping cover.", this->name_.c_str());
     this->start_direction_(COVER_OPERATION_IDLE);
-    this->publish_state();
   }
 
   // Recompute position every loop cycle
   this->recompute_position_();
 
-  if (this->current_operation != COVER_OPERATION_IDLE && this->is_at_target_()) {
+  if (this->current_operation != COVER_OPERATION_IDLE && this->is_at_target_())
     this->start_direction_(COVER_OPERATION_IDLE);
-    this->publish_state();
-  }
 
-  // Send current position every second
-  if (this->current_operation != COVER_OPERATION_IDLE && now - this->last_publish_time_ > 1000) {
-    this->publish_state(false);
-    this->last_publish_time_ = now;
-  }
+  // throttled while moving, saved once stopped
+  this->motion_.publish(this, now);
 }
 void EndstopCover::dump_config() {
   LOG_COVER("", "Endstop Cover", this);
   LOG_BINARY_SENSOR("  ", "Open Endstop", this->open_endstop_);
-  ESP_LOGCONFIG(TAG, "  Open Duration: %.1fs", this->open_duration_ / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Open Duration: %.1fs", this->motion_.get_open_duration() / 1e3f);
   LOG_BINARY_SENSOR("  ", "Close Endstop", this->close_endstop_);
-  ESP_LOGCONFIG(TAG, "  Close Duration: %.1fs", this->close_duration_ / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Close Duration: %.1fs", this->motion_.get_close_duration() / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Min Publish Interval: %.1fs", this->motion_.get_min_publish_interval() / 1e3f);
 }
 float EndstopCover::get_setup_priority() const { return setup_priority::DATA; }
 void EndstopCover::stop_prev_trigger_() {
@@ -141,33 +134,9 @@ void EndstopCover::start_direction_(CoverOperation dir) {
 
   const uint32_t now = millis();
   this->start_dir_time_ = now;
-  this->last_recompute_time_ = now;
-}
-void EndstopCover::recompute_position_() {
-  if (this->current_operation == COVER_OPERATION_IDLE)
-    return;
-
-  float dir;
-  float action_dur;
-  switch (this->current_operation) {
-    case COVER_OPERATION_OPENING:
-      dir = 1.0f;
-      action_dur = this->open_duration_;
-      break;
-    case COVER_OPERATION_CLOSING:
-      dir = -1.0f;
-      action_dur = this->close_duration_;
-      break;
-    default:
-      return;
-  }
-
-  const uint32_t now = millis();
-  this->position += dir * (now - this->last_recompute_time_) / action_dur;
-  this->position = clamp(this->position, 0.0f, 1.0f);
-
-  this->last_recompute_time_ = now;
+  this->motion_.reset(now);
 }
+void EndstopCover::recompute_position_() { this->motion_.recompute(this, millis()); }
 
 }  // namespace endstop
 }  // namespace esphome
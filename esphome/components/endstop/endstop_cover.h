@@ -4,6 +4,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #include "esphome/components/cover/cover.h"
+#include "esphome/components/cover/cover_motion.h"
 
 namespace esphome {
 namespace endstop {
@@ -20,8 +21,11 @@ class EndstopCover : public cover::Cover, public Component {
   Trigger<> *get_stop_trigger() const { return this->stop_trigger_; }
   void set_open_endstop(binary_sensor::BinarySensor *open_endstop) { this->open_endstop_ = open_endstop; }
   void set_close_endstop(binary_sensor::BinarySensor *close_endstop) { this->close_endstop_ = close_endstop; }
-  void set_open_duration(uint32_t open_duration) { this->open_duration_ = open_duration; }
-  void set_close_duration(uint32_t close_duration) { this->close_duration_ = close_duration; }
+  void set_open_duration(uint32_t open_duration) { this->motion_.set_open_duration(open_duration); }
+  void set_close_duration(uint32_t close_duration) { this->motion_.set_close_duration(close_duration); }
+  void set_min_publish_interval(uint32_t min_publish_interval) {
+    this->motion_.set_min_publish_interval(min_publish_interval);
+  }
   void set_max_duration(uint32_t max_duration) { this->max_duration_ = max_duration; }
 
   cover::CoverTraits get_traits() override;
@@ -40,16 +44,13 @@ class EndstopCover : public cover::Cover, public Component {
   binary_sensor::BinarySensor *open_endstop_;
   binary_sensor::BinarySensor *close_endstop_;
   Trigger<> *open_trigger_{new Trigger<>()};
-  uint32_t open_duration_;
   Trigger<> *close_trigger_{new Trigger<>()};
-  uint32_t close_duration_;
   Trigger<> *stop_trigger_{new Trigger<>()};
   uint32_t max_duration_{UINT32_MAX};
+  cover::CoverMotion motion_;
 
   Trigger<> *prev_command_trigger_{nullptr};
-  uint32_t last_recompute_time_{0};
   uint32_t start_dir_time_{0};
-  uint32_t last_publish_time_{0};
   float target_position_{0};
 };
 
@@ -0,0 +1,4 @@
+import esphome.codegen as cg
+
+energy_meter_ns = cg.esphome_ns.namespace('energy_meter')
+EnergyMeter = energy_meter_ns.class_('EnergyMeter')
@@ -0,0 +1,55 @@
+#include "energy_meter.h"
+
+namespace esphome {
+namespace energy_meter {
+
+bool EnergyMeter::Mean::finish() {
+  if (this->count == 0)
+    return false;
+  this->last = this->sum / this->count;
+  this->sum = 0.0f;
+  this->count = 0;
+  return true;
+}
+
+void EnergyMeter::add_power(float power) {
+  this->power_.add(power);
+  const uint32_t now = millis();
+  if (this->energy_from_power_ && this->has_last_power_) {
+    // the power is held until the next reading
+    this->energy_ += double(this->last_power_) * (now - this->last_power_at_) / 3600000.0;
+  }
+  this->last_power_ = power;
+  this->last_power_at_ = now;
+  this->has_last_power_ = true;
+}
+void EnergyMeter::add_energy(float energy) {
+  this->energy_from_power_ = false;
+  this->energy_ += energy;
+}
+
+void EnergyMeter::publish() {
+  if (this->voltage_.finish() && this->voltage_.sensor != nullptr)
+    this->voltage_.sensor->publish_state(this->voltage_.last);
+  if (this->current_.finish() && this->current_.sensor != nullptr)
+    this->current_.sensor->publish_state(this->current_.last);
+  const bool has_power = this->power_.finish();
+  if (has_power && this->power_.sensor != nullptr)
+    this->power_.sensor->publish_state(this->power_.last);
+
+  if (this->power_factor_.finish()) {
+    if (this->power_factor_.sensor != nullptr)
+      this->power_factor_.sensor->publish_state(this->power_factor_.last);
+  } else if (this->power_factor_.sensor != nullptr && has_power) {
+    // the voltage and current may be from an earlier window, if the chip measures them alternately
+    const float apparent_power = this->voltage_.last * this->current_.last;
+    if (apparent_power > 0.0f)
+      this->power_factor_.sensor->publish_state(clamp(this->power_.last / apparent_power, -1.0f, 1.0f));
+  }
+
+  if (this->energy_sensor_ != nullptr)
+    this->energy_sensor_->publish_state(this->energy_);
+}
+
+}  // namespace energy_meter
+}  // namespace esphome
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include "esphome/components/sensor/sensor.h"
+
+namespace esphome {
+namespace energy_meter {
+
+/** Accumulates the readings of one metered circuit over an integration window.
+ *
+ * Drivers add every reading they get (a UART frame, a register read, a pulse period) as it arrives and call
+ * publish() at the end of each window, usually from update(). The sensors then get the means of the window, so the
+ * window length and not the rate of the chip decides how often values are published. The energy is either metered
+ * by the chip (add_energy()) or integrated from the power readings.
+ */
+class EnergyMeter {
+ public:
+  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { voltage_.sensor = voltage_sensor; }
+  void set_current_sensor(sensor::Sensor *current_sensor) { current_.sensor = current_sensor; }
+  void set_power_sensor(sensor::Sensor *power_sensor) { power_.sensor = power_sensor; }
+  void set_power_factor_sensor(sensor::Sensor *power_factor_sensor) { power_factor_.sensor = power_factor_sensor; }
+  void set_energy_sensor(sensor::Sensor *energy_sensor) { energy_sensor_ = energy_sensor; }
+  sensor::Sensor *get_voltage_sensor() const { return voltage_.sensor; }
+  sensor::Sensor *get_current_sensor() const { return current_.sensor; }
+  sensor::Sensor *get_power_sensor() const { return power_.sensor; }
+  sensor::Sensor *get_power_factor_sensor() const { return power_factor_.sensor; }
+  sensor::Sensor *get_energy_sensor() const { return energy_sensor_; }
+
+  /// Add a voltage reading in V.
+  void add_voltage(float voltage) { this->voltage_.add(voltage); }
+  /// Add a current reading in A.
+  void add_current(float current) { this->current_.add(current); }
+  /// Add a power reading in W, it is integrated into the energy until the next one unless add_energy() is used.
+  void add_power(float power);
+  /// Add a power factor reading, without any the power factor is computed from the means of the window.
+  void add_power_factor(float power_factor) { this->power_factor_.add(power_factor); }
+  /// Add the energy in Wh the chip metered since the last call.
+  void add_energy(float energy);
+  /// Whether there was a power reading in the current window.
+  bool has_power() const { return this->power_.count != 0; }
+
+  /// Publish the means of the current window and start a new one, quantities without a reading aren't published.
+  void publish();
+
+  /// The means of the last window that had a reading, NAN before the first one.
+  float get_voltage() const { return this->voltage_.last; }
+  float get_current() const { return this->current_.last; }
+  float get_power() const { return this->power_.last; }
+  /// The total energy in Wh.
+  float get_energy() const { return this->energy_; }
+
+ protected:
+  struct Mean {
+    sensor::Sensor *sensor{nullptr};
+    float sum{0.0f};
+    uint32_t count{0};
+    float last{NAN};
+
+    void add(float value) {
+      this->sum += value;
+      this->count++;
+    }
+    /// Compute the mean of the window into last and start a new one, false if the window had no reading.
+    bool finish();
+  };
+
+  Mean voltage_;
+  Mean current_;
+  Mean power_;
+  Mean power_factor_;
+  sensor::Sensor *energy_sensor_{nullptr};
+  /// A double, so small increments aren't lost once the total is large.
+  double energy_{0.0};
+  bool energy_from_power_{true};
+  float last_power_{0.0f};
+  uint32_t last_power_at_{0};
+  bool has_last_power_{false};
+};
+
+}  // namespace energy_meter
+}  // namespace esphome
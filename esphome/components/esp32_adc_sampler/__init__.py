@@ -0,0 +1,31 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import pins
+from esphome.components import voltage_sampler
+from esphome.components.adc.sensor import ATTENUATION_MODES
+from esphome.const import CONF_ATTENUATION, CONF_ID, CONF_PIN, ESP_PLATFORM_ESP32
+
+ESP_PLATFORMS = [ESP_PLATFORM_ESP32]
+AUTO_LOAD = ['voltage_sampler']
+
+CONF_SAMPLE_RATE = 'sample_rate'
+
+esp32_adc_sampler_ns = cg.esphome_ns.namespace('esp32_adc_sampler')
+ESP32ADCSampler = esp32_adc_sampler_ns.class_('ESP32ADCSampler', cg.Component,
+                                              voltage_sampler.VoltageSampler)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(ESP32ADCSampler),
+    cv.Required(CONF_PIN): pins.analog_pin,
+    cv.Optional(CONF_ATTENUATION, default='0db'): cv.enum(ATTENUATION_MODES, lower=True),
+    cv.Optional(CONF_SAMPLE_RATE, default='10kHz'): cv.All(cv.frequency, cv.Range(min=1000, max=100000)),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_pin(config[CONF_PIN]))
+    cg.add(var.set_attenuation(config[CONF_ATTENUATION]))
+    cg.add(var.set_sample_rate(int(config[CONF_SAMPLE_RATE])))
@@ -0,0 +1,149 @@
+#include "esp32_adc_sampler.h"
+#include "esphome/core/log.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <algorithm>
+#include <driver/i2s.h>
+
+namespace esphome {
+namespace esp32_adc_sampler {
+
+static const char *TAG = "esp32_adc_sampler";
+
+static const i2s_port_t ADC_SAMPLER_I2S_PORT = I2S_NUM_0;
+static const int ADC_SAMPLER_DMA_BUFFER_COUNT = 8;
+static const int ADC_SAMPLER_DMA_BUFFER_LENGTH = 256;
+/// Samples are fetched from the DMA buffers in chunks of this size.
+static const size_t ADC_SAMPLER_READ_CHUNK = 64;
+
+static bool pin_to_adc1_channel(uint8_t pin, adc1_channel_t *channel) {
+  switch (pin) {
+    case 36:
+      *channel = ADC1_CHANNEL_0;
+      return true;
+    case 37:
+      *channel = ADC1_CHANNEL_1;
+      return true;
+    case 38:
+      *channel = ADC1_CHANNEL_2;
+      return true;
+    case 39:
+      *channel = ADC1_CHANNEL_3;
+      return true;
+    case 32:
+      *channel = ADC1_CHANNEL_4;
+      return true;
+    case 33:
+      *channel = ADC1_CHANNEL_5;
+      return true;
+    case 34:
+      *channel = ADC1_CHANNEL_6;
+      return true;
+    case 35:
+      *channel = ADC1_CHANNEL_7;
+      return true;
+    default:
+      return false;
+  }
+}
+
+void ESP32ADCSampler::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up ESP32 ADC Sampler...");
+  if (!pin_to_adc1_channel(this->pin_, &this->channel_)) {
+    ESP_LOGE(TAG, "GPIO%u is not an ADC1 pin!", this->pin_);
+    this->mark_failed();
+    return;
+  }
+
+  i2s_config_t config = {};
+  config.mode = i2s_mode_t(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+  config.sample_rate = this->sample_rate_;
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  config.channel_format = I2S_CHANNEL_FMT_ONLY_LEFT;
+  config.communication_format = I2S_COMM_FORMAT_I2S_MSB;
+  config.intr_alloc_flags = 0;
+  config.dma_buf_count = ADC_SAMPLER_DMA_BUFFER_COUNT;
+  config.dma_buf_len = ADC_SAMPLER_DMA_BUFFER_LENGTH;
+  config.use_apll = false;
+
+  esp_err_t err = i2s_driver_install(ADC_SAMPLER_I2S_PORT, &config, 0, nullptr);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Installing the I2S driver failed: %d", err);
+    this->mark_failed();
+    return;
+  }
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  adc1_config_channel_atten(this->channel_, adc_atten_t(this->attenuation_));
+  err = i2s_set_adc_mode(ADC_UNIT_1, this->channel_);
+  if (err == ESP_OK)
+    err = i2s_adc_enable(ADC_SAMPLER_I2S_PORT);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Enabling the I2S ADC mode failed: %d", err);
+    i2s_driver_uninstall(ADC_SAMPLER_I2S_PORT);
+    this->mark_failed();
+    return;
+  }
+}
+void ESP32ADCSampler::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP32 ADC Sampler:");
+  ESP_LOGCONFIG(TAG, "  Pin: GPIO%u", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Sample Rate: %u Hz", this->sample_rate_);
+  ESP_LOGCONFIG(TAG, "  Buffered: %.0f ms",
+                ADC_SAMPLER_DMA_BUFFER_COUNT * ADC_SAMPLER_DMA_BUFFER_LENGTH * 1000.0f / this->sample_rate_);
+  if (this->is_failed()) {
+    ESP_LOGE(TAG, "Setting up the I2S ADC mode failed!");
+  }
+}
+float ESP32ADCSampler::to_voltage_(uint16_t raw) const {
+  // the upper 4 bits contain the channel
+  float value_v = (raw & 0x0FFF) / 4095.0f;
+  switch (this->attenuation_) {
+    case ADC_0db:
+      value_v *= 1.1f;
+      break;
+    case ADC_2_5db:
+      value_v *= 1.5f;
+      break;
+    case ADC_6db:
+      value_v *= 2.2f;
+      break;
+    case ADC_11db:
+      value_v *= 3.9f;
+      break;
+  }
+  return value_v;
+}
+size_t ESP32ADCSampler::read_samples(float *samples, size_t max_count) {
+  if (this->is_failed())
+    return 0;
+
+  uint16_t raw[ADC_SAMPLER_READ_CHUNK];
+  size_t count = 0;
+  while (count < max_count) {
+    const size_t chunk = std::min(max_count - count, ADC_SAMPLER_READ_CHUNK);
+    size_t bytes_read = 0;
+    // never block, only take what the DMA has already written
+    if (i2s_read(ADC_SAMPLER_I2S_PORT, raw, chunk * sizeof(uint16_t), &bytes_read, 0) != ESP_OK)
+      break;
+    const size_t read = bytes_read / sizeof(uint16_t);
+    for (size_t i = 0; i < read; i++)
+      samples[count++] = this->to_voltage_(raw[i]);
+    if (read < chunk)
+      break;
+  }
+  if (count != 0)
+    this->last_sample_ = samples[count - 1];
+  return count;
+}
+float ESP32ADCSampler::sample() {
+  float samples[ADC_SAMPLER_READ_CHUNK];
+  while (this->read_samples(samples, ADC_SAMPLER_READ_CHUNK) == ADC_SAMPLER_READ_CHUNK) {
+  }
+  return this->last_sample_;
+}
+
+}  // namespace esp32_adc_sampler
+}  // namespace esphome
+
+#endif
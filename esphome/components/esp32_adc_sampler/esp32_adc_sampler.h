@@ -0,0 +1,48 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/voltage_sampler/voltage_sampler.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <driver/adc.h>
+#include <esp32-hal-adc.h>
+
+namespace esphome {
+namespace esp32_adc_sampler {
+
+/** Continuous sampling of an ADC1 pin at a fixed rate, using the I2S peripheral in built-in ADC mode.
+ *
+ * The I2S DMA writes the samples into a ring of buffers without any CPU involvement, consumers
+ * fetch them in blocks with read_samples(). Only one instance is possible, it occupies I2S0.
+ */
+class ESP32ADCSampler : public Component, public voltage_sampler::VoltageSampler {
+ public:
+  void set_pin(uint8_t pin) { this->pin_ = pin; }
+  void set_attenuation(adc_attenuation_t attenuation) { this->attenuation_ = attenuation; }
+  void set_sample_rate(uint32_t sample_rate) { this->sample_rate_ = sample_rate; }
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  /// The most recent sample, this discards all older buffered samples.
+  float sample() override;
+  bool is_continuous() override { return true; }
+  size_t read_samples(float *samples, size_t max_count) override;
+  uint32_t get_sample_rate() override { return this->sample_rate_; }
+
+ protected:
+  float to_voltage_(uint16_t raw) const;
+
+  uint8_t pin_;
+  adc1_channel_t channel_;
+  adc_attenuation_t attenuation_{ADC_0db};
+  uint32_t sample_rate_;
+  float last_sample_{NAN};
+};
+
+}  // namespace esp32_adc_sampler
+}  // namespace esphome
+
+#endif
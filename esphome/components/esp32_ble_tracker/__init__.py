@@ -15,6 +15,9 @@ CONF_ESP32_BLE_ID = 'esp32_ble_id'
 CONF_SCAN_PARAMETERS = 'scan_parameters'
 CONF_WINDOW = 'window'
 CONF_ACTIVE = 'active'
+CONF_ADAPTIVE = 'adaptive'
+CONF_MAX_IDLE = 'max_idle'
+CONF_SCAN_RESULT_QUEUE_SIZE = 'scan_result_queue_size'
 esp32_ble_tracker_ns = cg.esphome_ns.namespace('esp32_ble_tracker')
 ESP32BLETracker = esp32_ble_tracker_ns.class_('ESP32BLETracker', cg.Component)
 ESPBTDeviceListener = esp32_ble_tracker_ns.class_('ESPBTDeviceListener')
@@ -98,7 +101,10 @@ CONFIG_SCHEMA = cv.Schema({
         cv.Optional(CONF_INTERVAL, default='320ms'): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_WINDOW, default='30ms'): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_ACTIVE, default=True): cv.boolean,
+        cv.Optional(CONF_ADAPTIVE, default=False): cv.boolean,
+        cv.Optional(CONF_MAX_IDLE, default='60s'): cv.positive_time_period_milliseconds,
     }), validate_scan_parameters),
+    cv.Optional(CONF_SCAN_RESULT_QUEUE_SIZE, default=32): cv.int_range(min=4, max=1024),
     cv.Optional(CONF_ON_BLE_ADVERTISE): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(ESPBTAdvertiseTrigger),
         cv.Optional(CONF_MAC_ADDRESS): cv.mac_address,
@@ -131,6 +137,9 @@ def to_code(config):
     cg.add(var.set_scan_interval(int(params[CONF_INTERVAL].total_milliseconds / 0.625)))
     cg.add(var.set_scan_window(int(params[CONF_WINDOW].total_milliseconds / 0.625)))
     cg.add(var.set_scan_active(params[CONF_ACTIVE]))
+    cg.add(var.set_adaptive(params[CONF_ADAPTIVE]))
+    cg.add(var.set_max_idle(params[CONF_MAX_IDLE]))
+    cg.add(var.set_scan_result_queue_size(config[CONF_SCAN_RESULT_QUEUE_SIZE]))
     for conf in config.get(CONF_ON_BLE_ADVERTISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         if CONF_MAC_ADDRESS in conf:
@@ -11,6 +11,10 @@ class ESPBTAdvertiseTrigger : public Trigger<const ESPBTDevice &>, public ESPBTD
  public:
   explicit ESPBTAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
   void set_address(uint64_t address) { this->address_ = address; }
+  void get_advertisement_filter(ESPBTAdvertisementFilter &filter) override {
+    if (this->address_)
+      filter.addresses.push_back(this->address_);
+  }
 
   bool parse_device(const ESPBTDevice &device) override {
     if (this->address_ && device.address_uint64() != this->address_) {
@@ -28,6 +32,13 @@ class BLEServiceDataAdvertiseTrigger : public Trigger<const adv_data_t &>, publi
  public:
   explicit BLEServiceDataAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
   void set_address(uint64_t address) { this->address_ = address; }
+  void get_advertisement_filter(ESPBTAdvertisementFilter &filter) override {
+    if (this->address_) {
+      filter.addresses.push_back(this->address_);
+    } else if (this->uuid_.get_uuid().len == ESP_UUID_LEN_16) {
+      filter.service_data_uuids.push_back(this->uuid_.get_uuid().uuid.uuid16);
+    }
+  }
   void set_service_uuid16(uint16_t uuid) { this->uuid_ = ESPBTUUID::from_uint16(uuid); }
   void set_service_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_service_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
@@ -54,6 +65,13 @@ class BLEManufacturerDataAdvertiseTrigger : public Trigger<const adv_data_t &>,
  public:
   explicit BLEManufacturerDataAdvertiseTrigger(ESP32BLETracker *parent) { parent->register_listener(this); }
   void set_address(uint64_t address) { this->address_ = address; }
+  void get_advertisement_filter(ESPBTAdvertisementFilter &filter) override {
+    if (this->address_) {
+      filter.addresses.push_back(this->address_);
+    } else if (this->uuid_.get_uuid().len == ESP_UUID_LEN_16) {
+      filter.manufacturer_ids.push_back(this->uuid_.get_uuid().uuid.uuid16);
+    }
+  }
   void set_manufacturer_uuid16(uint16_t uuid) { this->uuid_ = ESPBTUUID::from_uint16(uuid); }
   void set_manufacturer_uuid32(uint32_t uuid) { this->uuid_ = ESPBTUUID::from_uint32(uuid); }
   void set_manufacturer_uuid128(uint8_t *uuid) { this->uuid_ = ESPBTUUID::from_raw(uuid); }
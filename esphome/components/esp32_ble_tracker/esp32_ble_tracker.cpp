@@ -12,6 +12,7 @@
 #include <freertos/task.h>
 #include <esp_gap_ble_api.h>
 #include <esp_bt_defs.h>
+#include <algorithm>
 
 // bt_trace.h
 #undef TAG
@@ -34,50 +35,48 @@ uint64_t ble_addr_to_uint64(const esp_bd_addr_t address) {
   return u;
 }
 
+void ESP32BLETracker::set_scan_result_queue_size(uint32_t size) {
+  uint32_t rounded = 1;
+  while (rounded < size)
+    rounded <<= 1;
+  this->scan_result_queue_size_ = rounded;
+}
+
 void ESP32BLETracker::setup() {
   global_esp32_ble_tracker = this;
-  this->scan_result_lock_ = xSemaphoreCreateMutex();
   this->scan_end_lock_ = xSemaphoreCreateMutex();
+  this->scan_results_.resize(this->scan_result_queue_size_);
+  this->build_listener_index_();
 
   if (!ESP32BLETracker::ble_setup()) {
     this->mark_failed();
     return;
   }
 
-  global_esp32_ble_tracker->start_scan(true);
+  global_esp32_ble_tracker->start_scan();
 }
 
 void ESP32BLETracker::loop() {
   if (xSemaphoreTake(this->scan_end_lock_, 0L)) {
     xSemaphoreGive(this->scan_end_lock_);
-    global_esp32_ble_tracker->start_scan(false);
+    if (this->scanning_)
+      this->end_scan_();
+    if (millis() - this->scan_ended_ >= this->idle_gap_)
+      this->start_scan();
   }
 
-  if (xSemaphoreTake(this->scan_result_lock_, 5L / portTICK_PERIOD_MS)) {
-    uint32_t index = this->scan_result_index_;
-    xSemaphoreGive(this->scan_result_lock_);
-
-    if (index >= 16) {
-      ESP_LOGW(TAG, "Too many BLE events to process. Some devices may not show up.");
-    }
-    for (size_t i = 0; i < index; i++) {
-      ESPBTDevice device;
-      device.parse_scan_rst(this->scan_result_buffer_[i]);
-
-      bool found = false;
-      for (auto *listener : this->listeners_)
-        if (listener->parse_device(device))
-          found = true;
-
-      if (!found) {
-        this->print_bt_device_info(device);
-      }
-    }
-
-    if (xSemaphoreTake(this->scan_result_lock_, 10L / portTICK_PERIOD_MS)) {
-      this->scan_result_index_ = 0;
-      xSemaphoreGive(this->scan_result_lock_);
-    }
+  const uint32_t dropped = this->scan_results_dropped_.load(std::memory_order_relaxed);
+  if (dropped != this->scan_results_dropped_reported_) {
+    ESP_LOGW(TAG, "Too many BLE events to process, dropped %u. Some devices may not show up.",
+             dropped - this->scan_results_dropped_reported_);
+    this->scan_results_dropped_reported_ = dropped;
+  }
+  const uint32_t head = this->scan_result_head_.load(std::memory_order_acquire);
+  const uint32_t mask = this->scan_results_.size() - 1;
+  for (uint32_t tail = this->scan_result_tail_.load(std::memory_order_relaxed); tail != head; tail++) {
+    this->process_scan_result_(this->scan_results_[tail & mask]);
+    // only now the Bluetooth task may reuse the slot
+    this->scan_result_tail_.store(tail + 1, std::memory_order_release);
   }
 
   if (this->scan_set_param_failed_) {
@@ -91,6 +90,108 @@ void ESP32BLETracker::loop() {
   }
 }
 
+void ESP32BLETracker::process_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
+  const ESPBTRawAdvertisement adv{ble_addr_to_uint64(param.bda), param.ble_addr_type, param.rssi,
+                                  param.ble_adv,                 param.adv_data_len,  param.scan_rsp_len};
+  this->match_listeners_(adv);
+  if (this->matched_listeners_.empty()) {
+    // only parse it if it would be printed as a new device
+    for (auto &disc : this->already_discovered_) {
+      if (disc == adv.address)
+        return;
+    }
+  }
+
+  ESPBTDevice &device = this->device_;
+  device.parse_scan_rst(param);
+
+  bool found = false;
+  for (uint16_t index : this->matched_listeners_) {
+    if (this->listeners_[index]->parse_device(device)) {
+      this->listener_seen_[index] = true;
+      found = true;
+    }
+  }
+
+  if (!found) {
+    this->print_bt_device_info(device);
+  }
+}
+
+void ESP32BLETracker::build_listener_index_() {
+  this->unfiltered_listeners_.clear();
+  this->address_listeners_.clear();
+  this->service_data_listeners_.clear();
+  this->manufacturer_listeners_.clear();
+  this->expected_listeners_.clear();
+  this->listener_seen_.assign(this->listeners_.size(), false);
+  for (uint16_t i = 0; i < this->listeners_.size(); i++) {
+    ESPBTAdvertisementFilter filter;
+    this->listeners_[i]->get_advertisement_filter(filter);
+    if (filter.addresses.empty() && filter.service_data_uuids.empty() && filter.manufacturer_ids.empty()) {
+      this->unfiltered_listeners_.push_back(i);
+      continue;
+    }
+    if (!filter.addresses.empty())
+      this->expected_listeners_.push_back(i);
+    for (uint64_t address : filter.addresses)
+      this->address_listeners_[address].push_back(i);
+    for (uint16_t uuid : filter.service_data_uuids)
+      this->service_data_listeners_[uuid].push_back(i);
+    for (uint16_t id : filter.manufacturer_ids)
+      this->manufacturer_listeners_[id].push_back(i);
+  }
+  this->listener_index_dirty_ = false;
+  ESP_LOGV(TAG, "Indexed %u listeners, %u without filter", this->listeners_.size(),
+           this->unfiltered_listeners_.size());
+}
+
+void ESP32BLETracker::match_listeners_(const ESPBTRawAdvertisement &adv) {
+  if (this->listener_index_dirty_)
+    this->build_listener_index_();
+
+  auto &matched = this->matched_listeners_;
+  matched = this->unfiltered_listeners_;
+  auto add = [&matched](const std::vector<uint16_t> &indices) {
+    matched.insert(matched.end(), indices.begin(), indices.end());
+  };
+
+  auto it = this->address_listeners_.find(adv.address);
+  if (it != this->address_listeners_.end())
+    add(it->second);
+
+  if (!this->service_data_listeners_.empty() || !this->manufacturer_listeners_.empty()) {
+    // walk the records the same way ESPBTDevice::parse_adv_() does, only looking at the first two data bytes
+    const uint8_t len = adv.adv_data_len + adv.scan_rsp_len;
+    size_t offset = 0;
+    while (offset + 2 < len) {
+      const uint8_t field_length = adv.data[offset];
+      if (field_length == 0)
+        break;
+      const uint8_t record_type = adv.data[offset + 1];
+      if (field_length >= 3 && offset + 1 + field_length <= len) {
+        const uint16_t id = adv.data[offset + 2] | (uint16_t(adv.data[offset + 3]) << 8);
+        if (record_type == ESP_BLE_AD_TYPE_SERVICE_DATA) {
+          auto found = this->service_data_listeners_.find(id);
+          if (found != this->service_data_listeners_.end())
+            add(found->second);
+        } else if (record_type == ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE) {
+          auto found = this->manufacturer_listeners_.find(id);
+          if (found != this->manufacturer_listeners_.end())
+            add(found->second);
+        }
+      }
+      offset += field_length + 1;
+    }
+  }
+
+  // keep the registration order and call every listener only once
+  std::sort(matched.begin(), matched.end());
+  matched.erase(std::unique(matched.begin(), matched.end()), matched.end());
+  auto rejects = [this, &adv](uint16_t index) { return !this->listeners_[index]->accepts_advertisement(adv); };
+  matched.erase(std::remove_if(matched.begin(), matched.end(), rejects), matched.end());
+}
+
 bool ESP32BLETracker::ble_setup() {
   // Initialize non-volatile storage for the bluetooth controller
   esp_err_t err = nvs_flash_init();
@@ -139,18 +240,20 @@ bool ESP32BLETracker::ble_setup() {
   return true;
 }
 
-void ESP32BLETracker::start_scan(bool first) {
+void ESP32BLETracker::start_scan() {
   if (!xSemaphoreTake(this->scan_end_lock_, 0L)) {
     ESP_LOGW(TAG, "Cannot start scan!");
     return;
   }
 
   ESP_LOGD(TAG, "Starting scan...");
-  if (!first) {
-    for (auto *listener : this->listeners_)
-      listener->on_scan_end();
-  }
+  const uint32_t now = millis();
+  if (this->scan_ended_ != 0)
+    this->idle_time_ += now - this->scan_ended_;
+  this->scan_started_ = now;
+  this->scanning_ = true;
   this->already_discovered_.clear();
+  std::fill(this->listener_seen_.begin(), this->listener_seen_.end(), false);
   this->scan_params_.scan_type = this->scan_active_ ? BLE_SCAN_TYPE_ACTIVE : BLE_SCAN_TYPE_PASSIVE;
   this->scan_params_.own_addr_type = BLE_ADDR_TYPE_PUBLIC;
   this->scan_params_.scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL;
@@ -182,6 +285,52 @@ void ESP32BLETracker::gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_ga
   }
 }
 
+void ESP32BLETracker::end_scan_() {
+  this->scanning_ = false;
+  this->scan_ended_ = millis();
+  this->scan_time_ += this->scan_ended_ - this->scan_started_;
+  this->cancel_timeout("scan");
+
+  for (auto *listener : this->listeners_)
+    listener->on_scan_end();
+
+  if (!this->adaptive_)
+    return;
+
+  bool stale = this->expected_listeners_.empty();
+  for (uint16_t index : this->expected_listeners_) {
+    if (!this->listener_seen_[index])
+      stale = true;
+  }
+  if (stale) {
+    if (!this->expected_listeners_.empty())
+      this->stale_scans_++;
+    this->idle_gap_ = 0;
+  } else if (this->idle_gap_ == 0) {
+    this->idle_gap_ = std::min(this->scan_duration_ * 1000, this->max_idle_);
+  } else {
+    this->idle_gap_ = std::min(this->idle_gap_ * 2, this->max_idle_);
+  }
+  ESP_LOGD(TAG, "Scan finished, pausing for %u ms (duty cycle %.1f%%)", this->idle_gap_,
+           this->get_scan_duty_cycle());
+}
+
+float ESP32BLETracker::get_scan_duty_cycle() const {
+  uint32_t scan_time = this->scan_time_;
+  uint32_t idle_time = this->idle_time_;
+  const uint32_t now = millis();
+  if (this->scanning_) {
+    scan_time += now - this->scan_started_;
+  } else if (this->scan_ended_ != 0) {
+    idle_time += now - this->scan_ended_;
+  }
+  if (scan_time + idle_time == 0)
+    return 0.0f;
+  // the radio only listens for the scan window out of every scan interval
+  const float window = float(this->scan_window_) / float(this->scan_interval_);
+  return window * scan_time * 100.0f / float(scan_time + idle_time);
+}
+
 void ESP32BLETracker::gap_scan_set_param_complete(const esp_ble_gap_cb_param_t::ble_scan_param_cmpl_evt_param &param) {
   this->scan_set_param_failed_ = param.status;
 }
@@ -192,12 +341,32 @@ void ESP32BLETracker::gap_scan_start_complete(const esp_ble_gap_cb_param_t::ble_
 
 void ESP32BLETracker::gap_scan_result(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
   if (param.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) {
-    if (xSemaphoreTake(this->scan_result_lock_, 0L)) {
-      if (this->scan_result_index_ < 16) {
-        this->scan_result_buffer_[this->scan_result_index_++] = param;
-      }
-      xSemaphoreGive(this->scan_result_lock_);
+    const uint32_t head = this->scan_result_head_.load(std::memory_order_relaxed);
+    const uint32_t tail = this->scan_result_tail_.load(std::memory_order_acquire);
+
+    // FNV-1a over the address and the data, the RSSI doesn't matter
+    uint32_t hash = 2166136261UL;
+    for (uint8_t byte : param.bda) {
+      hash ^= byte;
+      hash *= 16777619UL;
+    }
+    for (uint16_t i = 0; i < uint16_t(param.adv_data_len) + param.scan_rsp_len; i++) {
+      hash ^= param.ble_adv[i];
+      hash *= 16777619UL;
+    }
+    // beacons repeat the same advertisement many times a second, drop it if an identical one is still queued
+    RecentScanResult &recent = this->recent_scan_results_[(param.bda[3] ^ param.bda[4] ^ param.bda[5]) & 63];
+    if (recent.hash == hash && recent.index - tail < head - tail)
+      return;
+
+    if (head - tail >= this->scan_results_.size()) {
+      this->scan_results_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
     }
+    this->scan_results_[head & (this->scan_results_.size() - 1)] = param;
+    recent.hash = hash;
+    recent.index = head;
+    this->scan_result_head_.store(head + 1, std::memory_order_release);
   } else if (param.search_evt == ESP_GAP_SEARCH_INQ_CMPL_EVT) {
     xSemaphoreGive(this->scan_end_lock_);
   }
@@ -320,9 +489,12 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
     this->address_[i] = param.bda[i];
   this->address_type_ = param.ble_addr_type;
   this->rssi_ = param.rssi;
-  this->parse_adv_(param);
+  this->adv_len_ = std::min<size_t>(param.adv_data_len + param.scan_rsp_len, sizeof(this->adv_));
+  memcpy(this->adv_, param.ble_adv, this->adv_len_);
+  this->decoded_ = 0;
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+  this->decode_(FIELD_ALL);
   ESP_LOGVV(TAG, "Parse Result:");
   const char *address_type = "";
   switch (this->address_type_) {
@@ -368,10 +540,43 @@ void ESPBTDevice::parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_e
   ESP_LOGVV(TAG, "Adv data: %s", hexencode(param.ble_adv, param.adv_data_len + param.scan_rsp_len).c_str());
 #endif
 }
-void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param) {
+void ESPBTDevice::recycle_service_datas_(std::vector<ServiceData> &datas) const {
+  for (auto &data : datas)
+    this->spare_buffers_.push_back(std::move(data.data));
+  datas.clear();
+}
+void ESPBTDevice::add_service_data_(std::vector<ServiceData> &datas, const ESPBTUUID &uuid, const uint8_t *data,
+                                    const uint8_t *end) const {
+  datas.emplace_back();
+  ServiceData &service_data = datas.back();
+  service_data.uuid = uuid;
+  if (!this->spare_buffers_.empty()) {
+    service_data.data = std::move(this->spare_buffers_.back());
+    this->spare_buffers_.pop_back();
+  }
+  service_data.data.assign(data, end);
+}
+void ESPBTDevice::parse_adv_(uint8_t fields) const {
+  // reset the fields to decode, keeping the memory of their vectors
+  if (fields & FIELD_NAME)
+    this->name_.clear();
+  if (fields & FIELD_TX_POWER)
+    this->tx_powers_.clear();
+  if (fields & FIELD_APPEARANCE)
+    this->appearance_.reset();
+  if (fields & FIELD_AD_FLAG)
+    this->ad_flag_.reset();
+  if (fields & FIELD_SERVICE_UUIDS)
+    this->service_uuids_.clear();
+  if (fields & FIELD_MANUFACTURER_DATAS)
+    this->recycle_service_datas_(this->manufacturer_datas_);
+  if (fields & FIELD_SERVICE_DATAS)
+    this->recycle_service_datas_(this->service_datas_);
+  this->decoded_ |= fields;
+
   size_t offset = 0;
-  const uint8_t *payload = param.ble_adv;
-  uint8_t len = param.adv_data_len + param.scan_rsp_len;
+  const uint8_t *payload = this->adv_;
+  const uint8_t len = this->adv_len_;
 
   while (offset + 2 < len) {
     const uint8_t field_length = payload[offset++];  // First byte is length of adv record
@@ -383,6 +588,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
     const uint8_t *record = &payload[offset];
     const uint8_t record_length = field_length - 1;
     offset += record_length;
+    if (offset > len)
+      break;
 
     // See also Generic Access Profile Assigned Numbers:
     // https://www.bluetooth.com/specifications/assigned-numbers/generic-access-profile/ See also ADVERTISING AND SCAN
@@ -392,20 +599,26 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
 
     switch (record_type) {
       case ESP_BLE_AD_TYPE_NAME_CMPL: {
+        if (!(fields & FIELD_NAME))
+          break;
         // CSS 1.2 LOCAL NAME
         // "The Local Name data type shall be the same as, or a shortened version of, the local name assigned to the
         // device." CSS 1: Optional in this context; shall not appear more than once in a block.
-        this->name_ = std::string(reinterpret_cast<const char *>(record), record_length);
+        this->name_.assign(reinterpret_cast<const char *>(record), record_length);
         break;
       }
       case ESP_BLE_AD_TYPE_TX_PWR: {
+        if (!(fields & FIELD_TX_POWER))
+          break;
         // CSS 1.5 TX POWER LEVEL
         // "The TX Power Level data type indicates the transmitted power level of the packet containing the data type."
         // CSS 1: Optional in this context (may appear more than once in a block).
-        this->tx_powers_.push_back(*payload);
+        this->tx_powers_.push_back(*record);
         break;
       }
       case ESP_BLE_AD_TYPE_APPEARANCE: {
+        if (!(fields & FIELD_APPEARANCE))
+          break;
         // CSS 1.12 APPEARANCE
         // "The Appearance data type defines the external appearance of the device."
         // See also https://www.bluetooth.com/specifications/gatt/characteristics/
@@ -415,6 +628,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
         break;
       }
       case ESP_BLE_AD_TYPE_FLAG: {
+        if (!(fields & FIELD_AD_FLAG))
+          break;
         // CSS 1.3 FLAGS
         // "The Flags data type contains one bit Boolean flags. The Flags data type shall be included when any of the
         // Flag bits are non-zero and the advertising packet is connectable, otherwise the Flags data type may be
@@ -429,6 +644,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
       // CSS 1: Optional in this context (may appear more than once in a block).
       case ESP_BLE_AD_TYPE_16SRV_CMPL:
       case ESP_BLE_AD_TYPE_16SRV_PART: {
+        if (!(fields & FIELD_SERVICE_UUIDS))
+          break;
         // • 16-bit Bluetooth Service UUIDs
         for (uint8_t i = 0; i < record_length / 2; i++) {
           this->service_uuids_.push_back(ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record + 2 * i)));
@@ -437,6 +654,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
       }
       case ESP_BLE_AD_TYPE_32SRV_CMPL:
       case ESP_BLE_AD_TYPE_32SRV_PART: {
+        if (!(fields & FIELD_SERVICE_UUIDS))
+          break;
         // • 32-bit Bluetooth Service UUIDs
         for (uint8_t i = 0; i < record_length / 4; i++) {
           this->service_uuids_.push_back(ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record + 4 * i)));
@@ -445,11 +664,15 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
       }
       case ESP_BLE_AD_TYPE_128SRV_CMPL:
       case ESP_BLE_AD_TYPE_128SRV_PART: {
+        if (!(fields & FIELD_SERVICE_UUIDS))
+          break;
         // • Global 128-bit Service UUIDs
         this->service_uuids_.push_back(ESPBTUUID::from_raw(record));
         break;
       }
       case ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE: {
+        if (!(fields & FIELD_MANUFACTURER_DATAS))
+          break;
         // CSS 1.4 MANUFACTURER SPECIFIC DATA
         // "The Manufacturer Specific data type is used for manufacturer specific data. The first two data octets shall
         // contain a company identifier from Assigned Numbers. The interpretation of any other octets within the data
@@ -459,10 +682,9 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
           ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE");
           break;
         }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->manufacturer_datas_.push_back(data);
+        this->add_service_data_(this->manufacturer_datas_,
+                                ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record)), record + 2UL,
+                                record + record_length);
         break;
       }
 
@@ -470,6 +692,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
       // "The Service Data data type consists of a service UUID with the data associated with that service."
       // CSS 1: Optional in this context (may appear more than once in a block).
       case ESP_BLE_AD_TYPE_SERVICE_DATA: {
+        if (!(fields & FIELD_SERVICE_DATAS))
+          break;
         // «Service Data - 16 bit UUID»
         // Size: 2 or more octets
         // The first 2 octets contain the 16 bit Service UUID fol- lowed by additional service data
@@ -477,13 +701,14 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
           ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_SERVICE_DATA");
           break;
         }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record));
-        data.data.assign(record + 2UL, record + record_length);
-        this->service_datas_.push_back(data);
+        this->add_service_data_(this->service_datas_,
+                                ESPBTUUID::from_uint16(*reinterpret_cast<const uint16_t *>(record)), record + 2UL,
+                                record + record_length);
         break;
       }
       case ESP_BLE_AD_TYPE_32SERVICE_DATA: {
+        if (!(fields & FIELD_SERVICE_DATAS))
+          break;
         // «Service Data - 32 bit UUID»
         // Size: 4 or more octets
         // The first 4 octets contain the 32 bit Service UUID fol- lowed by additional service data
@@ -491,13 +716,14 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
           ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_32SERVICE_DATA");
           break;
         }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record));
-        data.data.assign(record + 4UL, record + record_length);
-        this->service_datas_.push_back(data);
+        this->add_service_data_(this->service_datas_,
+                                ESPBTUUID::from_uint32(*reinterpret_cast<const uint32_t *>(record)), record + 4UL,
+                                record + record_length);
         break;
       }
       case ESP_BLE_AD_TYPE_128SERVICE_DATA: {
+        if (!(fields & FIELD_SERVICE_DATAS))
+          break;
         // «Service Data - 128 bit UUID»
         // Size: 16 or more octets
         // The first 16 octets contain the 128 bit Service UUID followed by additional service data
@@ -505,10 +731,8 @@ void ESPBTDevice::parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_p
           ESP_LOGV(TAG, "Record length too small for ESP_BLE_AD_TYPE_128SERVICE_DATA");
           break;
         }
-        ServiceData data{};
-        data.uuid = ESPBTUUID::from_raw(record);
-        data.data.assign(record + 16UL, record + record_length);
-        this->service_datas_.push_back(data);
+        this->add_service_data_(this->service_datas_, ESPBTUUID::from_raw(record), record + 16UL,
+                                record + record_length);
         break;
       }
       default: {
@@ -532,6 +756,10 @@ void ESP32BLETracker::dump_config() {
   ESP_LOGCONFIG(TAG, "  Scan Interval: %.1f ms", this->scan_interval_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Window: %.1f ms", this->scan_window_ * 0.625f);
   ESP_LOGCONFIG(TAG, "  Scan Type: %s", this->scan_active_ ? "ACTIVE" : "PASSIVE");
+  if (this->adaptive_) {
+    ESP_LOGCONFIG(TAG, "  Adaptive: YES (max idle %u s, %u listeners bound to an address)", this->max_idle_ / 1000,
+                  this->expected_listeners_.size());
+  }
 }
 void ESP32BLETracker::print_bt_device_info(const ESPBTDevice &device) {
   const uint64_t address = device.address_uint64();
@@ -5,8 +5,10 @@
 
 #ifdef ARDUINO_ARCH_ESP32
 
+#include <atomic>
 #include <string>
 #include <array>
+#include <unordered_map>
 #include <esp_gap_ble_api.h>
 #include <esp_bt_defs.h>
 
@@ -67,6 +69,12 @@ class ESPBLEiBeacon {
   } PACKED beacon_data_;
 };
 
+/** A device as seen in an advertisement.
+ *
+ * The tracker reuses one object for all advertisements: parse_scan_rst() only copies the raw data, each field is
+ * decoded the first time it is queried, and the vectors (including the data of the service datas) keep their memory
+ * for the next advertisement, so parsing doesn't allocate once the buffers have grown.
+ */
 class ESPBTDevice {
  public:
   void parse_scan_rst(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
@@ -79,26 +87,48 @@ class ESPBTDevice {
 
   esp_ble_addr_type_t get_address_type() const { return this->address_type_; }
   int get_rssi() const { return rssi_; }
-  const std::string &get_name() const { return this->name_; }
+  const std::string &get_name() const {
+    this->decode_(FIELD_NAME);
+    return this->name_;
+  }
 
   ESPDEPRECATED("Use get_tx_powers() instead")
   optional<int8_t> get_tx_power() const {
+    this->decode_(FIELD_TX_POWER);
     if (this->tx_powers_.empty())
       return {};
     return this->tx_powers_[0];
   }
-  const std::vector<int8_t> &get_tx_powers() const { return tx_powers_; }
+  const std::vector<int8_t> &get_tx_powers() const {
+    this->decode_(FIELD_TX_POWER);
+    return tx_powers_;
+  }
 
-  const optional<uint16_t> &get_appearance() const { return appearance_; }
-  const optional<uint8_t> &get_ad_flag() const { return ad_flag_; }
-  const std::vector<ESPBTUUID> &get_service_uuids() const { return service_uuids_; }
+  const optional<uint16_t> &get_appearance() const {
+    this->decode_(FIELD_APPEARANCE);
+    return appearance_;
+  }
+  const optional<uint8_t> &get_ad_flag() const {
+    this->decode_(FIELD_AD_FLAG);
+    return ad_flag_;
+  }
+  const std::vector<ESPBTUUID> &get_service_uuids() const {
+    this->decode_(FIELD_SERVICE_UUIDS);
+    return service_uuids_;
+  }
 
-  const std::vector<ServiceData> &get_manufacturer_datas() const { return manufacturer_datas_; }
+  const std::vector<ServiceData> &get_manufacturer_datas() const {
+    this->decode_(FIELD_MANUFACTURER_DATAS);
+    return manufacturer_datas_;
+  }
 
-  const std::vector<ServiceData> &get_service_datas() const { return service_datas_; }
+  const std::vector<ServiceData> &get_service_datas() const {
+    this->decode_(FIELD_SERVICE_DATAS);
+    return service_datas_;
+  }
 
   optional<ESPBLEiBeacon> get_ibeacon() const {
-    for (auto &it : this->manufacturer_datas_) {
+    for (auto &it : this->get_manufacturer_datas()) {
       auto res = ESPBLEiBeacon::from_manufacturer_data(it);
       if (res.has_value())
         return *res;
@@ -107,20 +137,67 @@ class ESPBTDevice {
   }
 
  protected:
-  void parse_adv_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  /// The fields that are decoded separately, as a bit mask.
+  enum Field : uint8_t {
+    FIELD_NAME = 1 << 0,
+    FIELD_TX_POWER = 1 << 1,
+    FIELD_APPEARANCE = 1 << 2,
+    FIELD_AD_FLAG = 1 << 3,
+    FIELD_SERVICE_UUIDS = 1 << 4,
+    FIELD_MANUFACTURER_DATAS = 1 << 5,
+    FIELD_SERVICE_DATAS = 1 << 6,
+    FIELD_ALL = 0x7F,
+  };
+
+  void decode_(uint8_t fields) const {
+    if ((this->decoded_ & fields) != fields)
+      this->parse_adv_(fields & ~this->decoded_);
+  }
+  /// Decode the records of the given fields.
+  void parse_adv_(uint8_t fields) const;
+  /// Clear datas, keeping the buffers of their data for add_service_data_().
+  void recycle_service_datas_(std::vector<ServiceData> &datas) const;
+  void add_service_data_(std::vector<ServiceData> &datas, const ESPBTUUID &uuid, const uint8_t *data,
+                         const uint8_t *end) const;
 
   esp_bd_addr_t address_{
       0,
   };
   esp_ble_addr_type_t address_type_{BLE_ADDR_TYPE_PUBLIC};
   int rssi_{0};
-  std::string name_{};
-  std::vector<int8_t> tx_powers_{};
-  optional<uint16_t> appearance_{};
-  optional<uint8_t> ad_flag_{};
-  std::vector<ESPBTUUID> service_uuids_;
-  std::vector<ServiceData> manufacturer_datas_{};
-  std::vector<ServiceData> service_datas_{};
+  /// The advertisement data followed by the scan response data.
+  uint8_t adv_[ESP_BLE_ADV_DATA_LEN_MAX + ESP_BLE_SCAN_RSP_DATA_LEN_MAX];
+  uint8_t adv_len_{0};
+  mutable uint8_t decoded_{0};
+  mutable std::string name_{};
+  mutable std::vector<int8_t> tx_powers_{};
+  mutable optional<uint16_t> appearance_{};
+  mutable optional<uint8_t> ad_flag_{};
+  mutable std::vector<ESPBTUUID> service_uuids_;
+  mutable std::vector<ServiceData> manufacturer_datas_{};
+  mutable std::vector<ServiceData> service_datas_{};
+  /// Data buffers of earlier service datas, waiting to be reused.
+  mutable std::vector<adv_data_t> spare_buffers_{};
+};
+
+/// An advertisement as received from the controller, before it is parsed into an ESPBTDevice.
+struct ESPBTRawAdvertisement {
+  uint64_t address;
+  esp_ble_addr_type_t address_type;
+  int rssi;
+  /// The advertisement data followed by the scan response data.
+  const uint8_t *data;
+  uint8_t adv_data_len;
+  uint8_t scan_rsp_len;
+};
+
+/// The advertisements a listener is interested in, see ESPBTDeviceListener::get_advertisement_filter().
+struct ESPBTAdvertisementFilter {
+  std::vector<uint64_t> addresses;
+  /// 16 bit UUIDs of service data records.
+  std::vector<uint16_t> service_data_uuids;
+  /// 16 bit company identifiers of manufacturer data records.
+  std::vector<uint16_t> manufacturer_ids;
 };
 
 class ESP32BLETracker;
@@ -128,6 +205,16 @@ class ESP32BLETracker;
 class ESPBTDeviceListener {
  public:
   virtual void on_scan_end() {}
+  /** Describe the advertisements this listener wants, the tracker builds its dispatch index from it.
+   *
+   * Advertisements matching any of the entries are passed on, a listener that leaves the filter empty gets all of them.
+   */
+  virtual void get_advertisement_filter(ESPBTAdvertisementFilter &filter) {}
+  /** Quick check of an advertisement before it is parsed.
+   *
+   * Return false if parse_device() would not use it, advertisements no listener accepts are not parsed at all.
+   */
+  virtual bool accepts_advertisement(const ESPBTRawAdvertisement &adv) { return true; }
   virtual bool parse_device(const ESPBTDevice &device) = 0;
   void set_parent(ESP32BLETracker *parent) { parent_ = parent; }
 
@@ -141,6 +228,22 @@ class ESP32BLETracker : public Component {
   void set_scan_interval(uint32_t scan_interval) { scan_interval_ = scan_interval; }
   void set_scan_window(uint32_t scan_window) { scan_window_ = scan_window; }
   void set_scan_active(bool scan_active) { scan_active_ = scan_active; }
+  /// Set how many scan results may wait for loop(), rounded up to a power of two.
+  void set_scan_result_queue_size(uint32_t size);
+  /** Pause between scans while every listener bound to an address found its device.
+   *
+   * The pause doubles after each scan in which all of them were found, up to max_idle (in ms), and drops back to
+   * continuous scanning as soon as one of them was missed.
+   */
+  void set_adaptive(bool adaptive) { adaptive_ = adaptive; }
+  void set_max_idle(uint32_t max_idle) { max_idle_ = max_idle; }
+
+  /// The share of the time the radio spent receiving advertisements since boot, in percent.
+  float get_scan_duty_cycle() const;
+  /// The current pause between two scans in ms, only non-zero in adaptive mode.
+  uint32_t get_idle_gap() const { return this->idle_gap_; }
+  /// The number of scans in which at least one listener bound to an address missed its device.
+  uint32_t get_stale_scans() const { return this->stale_scans_; }
 
   /// Setup the FreeRTOS task and the Bluetooth stack.
   void setup() override;
@@ -151,6 +254,7 @@ class ESP32BLETracker : public Component {
   void register_listener(ESPBTDeviceListener *listener) {
     listener->set_parent(this);
     this->listeners_.push_back(listener);
+    this->listener_index_dirty_ = true;
   }
 
   void print_bt_device_info(const ESPBTDevice &device);
@@ -159,7 +263,9 @@ class ESP32BLETracker : public Component {
   /// The FreeRTOS task managing the bluetooth interface.
   static bool ble_setup();
   /// Start a single scan by setting up the parameters and doing some esp-idf calls.
-  void start_scan(bool first);
+  void start_scan();
+  /// Called from loop() once the Bluetooth task reported the end of a scan.
+  void end_scan_();
   /// Callback that will handle all GAP events and redistribute them to other callbacks.
   static void gap_event_handler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t *param);
   /// Called when a `ESP_GAP_BLE_SCAN_RESULT_EVT` event is received.
@@ -168,10 +274,29 @@ class ESP32BLETracker : public Component {
   void gap_scan_set_param_complete(const esp_ble_gap_cb_param_t::ble_scan_param_cmpl_evt_param &param);
   /// Called when a `ESP_GAP_BLE_SCAN_START_COMPLETE_EVT` event is received.
   void gap_scan_start_complete(const esp_ble_gap_cb_param_t::ble_scan_start_cmpl_evt_param &param);
+  /// Hand a scan result from the ring to the listeners.
+  void process_scan_result_(const esp_ble_gap_cb_param_t::ble_scan_result_evt_param &param);
+  /// Collect the advertisement filters of all listeners into the dispatch index.
+  void build_listener_index_();
+  /// Find the listeners of an advertisement in the index, sorted by registration order.
+  void match_listeners_(const ESPBTRawAdvertisement &adv);
 
   /// Vector of addresses that have already been printed in print_bt_device_info
   std::vector<uint64_t> already_discovered_;
   std::vector<ESPBTDeviceListener *> listeners_;
+  /// Indices into listeners_ by what their advertisement filter contains.
+  std::vector<uint16_t> unfiltered_listeners_;
+  std::unordered_map<uint64_t, std::vector<uint16_t>> address_listeners_;
+  std::unordered_map<uint16_t, std::vector<uint16_t>> service_data_listeners_;
+  std::unordered_map<uint16_t, std::vector<uint16_t>> manufacturer_listeners_;
+  bool listener_index_dirty_{true};
+  /// The listeners bound to an address and whether they got an advertisement during the current scan.
+  std::vector<uint16_t> expected_listeners_;
+  std::vector<bool> listener_seen_;
+  /// The listeners of the advertisement being processed.
+  std::vector<uint16_t> matched_listeners_;
+  /// Reused for every advertisement, so its buffers are only allocated once.
+  ESPBTDevice device_;
   /// A structure holding the ESP BLE scan parameters.
   esp_ble_scan_params_t scan_params_;
   /// The interval in seconds to perform scans.
@@ -179,10 +304,33 @@ class ESP32BLETracker : public Component {
   uint32_t scan_interval_;
   uint32_t scan_window_;
   bool scan_active_;
-  SemaphoreHandle_t scan_result_lock_;
+  bool adaptive_{false};
+  uint32_t max_idle_{60000};
+  bool scanning_{false};
+  uint32_t scan_started_{0};
+  uint32_t scan_ended_{0};
+  uint32_t idle_gap_{0};
+  uint32_t stale_scans_{0};
+  /// Total time spent scanning and pausing, in ms.
+  uint32_t scan_time_{0};
+  uint32_t idle_time_{0};
   SemaphoreHandle_t scan_end_lock_;
-  size_t scan_result_index_{0};
-  esp_ble_gap_cb_param_t::ble_scan_result_evt_param scan_result_buffer_[16];
+
+  /** Single producer single consumer ring of the scan results, written by the Bluetooth task and read by loop().
+   *
+   * head and tail count up forever, the slot of an index is index & (size - 1).
+   */
+  std::vector<esp_ble_gap_cb_param_t::ble_scan_result_evt_param> scan_results_;
+  uint32_t scan_result_queue_size_{32};
+  std::atomic<uint32_t> scan_result_head_{0};
+  std::atomic<uint32_t> scan_result_tail_{0};
+  /// The last queued advertisement by bucket of the address, only used by the Bluetooth task.
+  struct RecentScanResult {
+    uint32_t hash;
+    uint32_t index;
+  } recent_scan_results_[64]{};
+  std::atomic<uint32_t> scan_results_dropped_{0};
+  uint32_t scan_results_dropped_reported_{0};
   esp_bt_status_t scan_start_failed_{ESP_BT_STATUS_SUCCESS};
   esp_bt_status_t scan_set_param_failed_{ESP_BT_STATUS_SUCCESS};
 };
@@ -3,7 +3,7 @@ import esphome.config_validation as cv
 from esphome import pins
 from esphome.const import CONF_FREQUENCY, CONF_ID, CONF_NAME, CONF_PIN, CONF_SCL, CONF_SDA, \
     ESP_PLATFORM_ESP32, CONF_DATA_PINS, CONF_RESET_PIN, CONF_RESOLUTION, CONF_BRIGHTNESS, \
-    CONF_CONTRAST
+    CONF_CONTRAST, CONF_THRESHOLD
 
 ESP_PLATFORMS = [ESP_PLATFORM_ESP32]
 DEPENDENCIES = ['api']
@@ -50,10 +50,27 @@ CONF_VERTICAL_FLIP = 'vertical_flip'
 CONF_HORIZONTAL_MIRROR = 'horizontal_mirror'
 CONF_SATURATION = 'saturation'
 CONF_TEST_PATTERN = 'test_pattern'
+CONF_FRAME_BUFFER_COUNT = 'frame_buffer_count'
+CONF_MOTION_DETECTION = 'motion_detection'
+CONF_BLOCK_THRESHOLD = 'block_threshold'
+CONF_KEYFRAME_INTERVAL = 'keyframe_interval'
+CONF_ADAPTIVE_QUALITY = 'adaptive_quality'
+CONF_TARGET_FRAMERATE = 'target_framerate'
+CONF_MAX_JPEG_QUALITY = 'max_jpeg_quality'
+CONF_MIN_RESOLUTION = 'min_resolution'
+CONF_ESP32_CAMERA_ID = 'esp32_camera_id'
 
 camera_range_param = cv.int_range(min=-2, max=2)
 
-CONFIG_SCHEMA = cv.Schema({
+def validate_adaptive_quality(config):
+    if CONF_ADAPTIVE_QUALITY in config and \
+            config[CONF_ADAPTIVE_QUALITY][CONF_MAX_JPEG_QUALITY] < config[CONF_JPEG_QUALITY]:
+        raise cv.Invalid("max_jpeg_quality must not be lower than jpeg_quality",
+                         path=[CONF_ADAPTIVE_QUALITY, CONF_MAX_JPEG_QUALITY])
+    return config
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(ESP32Camera),
     cv.Required(CONF_NAME): cv.string,
     cv.Required(CONF_DATA_PINS): cv.All([pins.input_pin], cv.Length(min=8, max=8)),
@@ -84,7 +101,26 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_VERTICAL_FLIP, default=True): cv.boolean,
     cv.Optional(CONF_HORIZONTAL_MIRROR, default=True): cv.boolean,
     cv.Optional(CONF_TEST_PATTERN, default=False): cv.boolean,
-}).extend(cv.COMPONENT_SCHEMA)
+    # More than one frame buffer requires PSRAM
+    cv.Optional(CONF_FRAME_BUFFER_COUNT, default=1): cv.int_range(min=1, max=3),
+    # Streams only send images while something moves, and one every keyframe_interval otherwise
+    cv.Optional(CONF_MOTION_DETECTION): cv.Schema({
+        # the share of the image that has to change
+        cv.Optional(CONF_THRESHOLD, default='2%'): cv.percentage,
+        # how much the brightness of a part of the image has to change
+        cv.Optional(CONF_BLOCK_THRESHOLD, default=15): cv.int_range(min=1, max=255),
+        cv.Optional(CONF_KEYFRAME_INTERVAL, default='10s'): cv.positive_time_period_milliseconds,
+    }),
+    # Lowers the JPEG quality of streams (between jpeg_quality and max_jpeg_quality, higher is worse) while the
+    # images take too long to reach the clients for the target framerate, then the resolution down to min_resolution
+    cv.Optional(CONF_ADAPTIVE_QUALITY): cv.Schema({
+        cv.Optional(CONF_TARGET_FRAMERATE, default='5 fps'): cv.All(cv.framerate,
+                                                                    cv.Range(min=0, min_included=False,
+                                                                             max=60)),
+        cv.Optional(CONF_MAX_JPEG_QUALITY, default=40): cv.int_range(min=10, max=63),
+        cv.Optional(CONF_MIN_RESOLUTION): cv.enum(FRAME_SIZES, upper=True),
+    }),
+}).extend(cv.COMPONENT_SCHEMA), validate_adaptive_quality)
 
 SETTERS = {
     CONF_DATA_PINS: 'set_data_pins',
@@ -100,11 +136,13 @@ SETTERS = {
     CONF_BRIGHTNESS: 'set_brightness',
     CONF_SATURATION: 'set_saturation',
     CONF_TEST_PATTERN: 'set_test_pattern',
+    CONF_FRAME_BUFFER_COUNT: 'set_frame_buffer_count',
 }
 
 
 def to_code(config):
-    var = cg.new_Pvariable(config[CONF_ID], config[CONF_NAME])
+    var = cg.new_Pvariable(config[CONF_ID], '')
+    cg.setup_entity_name(var, config[CONF_NAME])
     yield cg.register_component(var, config)
 
     for key, setter in SETTERS.items():
@@ -121,6 +159,15 @@ def to_code(config):
     else:
         cg.add(var.set_idle_update_interval(1000 / config[CONF_IDLE_FRAMERATE]))
     cg.add(var.set_frame_size(config[CONF_RESOLUTION]))
+    if CONF_MOTION_DETECTION in config:
+        conf = config[CONF_MOTION_DETECTION]
+        cg.add(var.set_motion_detection(conf[CONF_THRESHOLD] * 100, conf[CONF_BLOCK_THRESHOLD],
+                                        conf[CONF_KEYFRAME_INTERVAL]))
+    if CONF_ADAPTIVE_QUALITY in config:
+        conf = config[CONF_ADAPTIVE_QUALITY]
+        cg.add(var.set_adaptive_quality(conf[CONF_TARGET_FRAMERATE], conf[CONF_MAX_JPEG_QUALITY]))
+        if CONF_MIN_RESOLUTION in conf:
+            cg.add(var.set_min_frame_size(conf[CONF_MIN_RESOLUTION]))
 
     cg.add_define('USE_ESP32_CAMERA')
     cg.add_build_flag('-DBOARD_HAS_PSRAM')
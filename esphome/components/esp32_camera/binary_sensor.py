@@ -0,0 +1,18 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import binary_sensor
+from . import ESP32Camera, CONF_ESP32_CAMERA_ID
+
+DEPENDENCIES = ['esp32_camera']
+
+# Whether the motion score is above the threshold, needs motion_detection
+CONFIG_SCHEMA = binary_sensor.BINARY_SENSOR_SCHEMA.extend({
+    cv.GenerateID(): cv.declare_id(binary_sensor.BinarySensor),
+    cv.GenerateID(CONF_ESP32_CAMERA_ID): cv.use_id(ESP32Camera),
+})
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_ESP32_CAMERA_ID])
+    var = yield binary_sensor.new_binary_sensor(config)
+    cg.add(parent.set_motion_binary_sensor(var))
@@ -1,13 +1,29 @@
 #include "esp32_camera.h"
 #include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
 
 #ifdef ARDUINO_ARCH_ESP32
 
+#include <esp_jpg_decode.h>
+
 namespace esphome {
 namespace esp32_camera {
 
 static const char *TAG = "esp32_camera";
 
+struct FrameSizeDimensions {
+  framesize_t frame_size;
+  uint16_t width;
+  uint16_t height;
+};
+static const FrameSizeDimensions FRAME_SIZE_DIMENSIONS[] = {
+    {FRAMESIZE_QQVGA, 160, 120}, {FRAMESIZE_QQVGA2, 128, 160}, {FRAMESIZE_QCIF, 176, 144},
+    {FRAMESIZE_HQVGA, 240, 176}, {FRAMESIZE_QVGA, 320, 240},   {FRAMESIZE_CIF, 400, 296},
+    {FRAMESIZE_VGA, 640, 480},   {FRAMESIZE_SVGA, 800, 600},   {FRAMESIZE_XGA, 1024, 768},
+    {FRAMESIZE_SXGA, 1280, 1024}, {FRAMESIZE_UXGA, 1600, 1200},
+};
+
 void ESP32Camera::setup() {
   global_esp32_camera = this;
 
@@ -27,11 +43,18 @@ void ESP32Camera::setup() {
   s->set_brightness(s, this->brightness_);
   s->set_saturation(s, this->saturation_);
   s->set_colorbar(s, this->test_pattern_);
-  this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->frame_size_ = this->config_.frame_size;
+  this->jpeg_quality_ = this->config_.jpeg_quality;
+  for (uint8_t i = 0; i < sizeof(FRAME_SIZE_DIMENSIONS) / sizeof(FRAME_SIZE_DIMENSIONS[0]); i++) {
+    if (FRAME_SIZE_DIMENSIONS[i].frame_size == this->config_.frame_size)
+      this->requested_frame_size_index_ = this->adaptive_frame_size_index_ = i;
+  }
+  this->framebuffer_get_queue_ = xQueueCreate(this->config_.fb_count, sizeof(CapturedFrame));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
-                          1024,                // stack size
+                          // the JPEG decoder of the motion detection needs a larger stack
+                          this->motion_detection_ ? 4096 : 1024,  // stack size
                           nullptr,             // task pv params
                           0,                   // priority
                           nullptr,             // handle
@@ -97,7 +120,7 @@ void ESP32Camera::dump_config() {
   sensor_t *s = esp_camera_sensor_get();
   auto st = s->status;
   ESP_LOGCONFIG(TAG, "  JPEG Quality: %u", st.quality);
-  // ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
+  ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
   ESP_LOGCONFIG(TAG, "  Contrast: %d", st.contrast);
   ESP_LOGCONFIG(TAG, "  Brightness: %d", st.brightness);
   ESP_LOGCONFIG(TAG, "  Saturation: %d", st.saturation);
@@ -120,54 +143,204 @@ void ESP32Camera::dump_config() {
   // ESP_LOGCONFIG(TAG, "  Lens Correction: %u", st.lenc);
   // ESP_LOGCONFIG(TAG, "  DCW: %u", st.dcw);
   ESP_LOGCONFIG(TAG, "  Test Pattern: %s", YESNO(st.colorbar));
+  if (this->motion_detection_) {
+    ESP_LOGCONFIG(TAG, "  Motion Threshold: %.1f%%", this->motion_threshold_);
+    ESP_LOGCONFIG(TAG, "  Keyframe Interval: %u ms", this->keyframe_interval_);
+  } else {
+    bool has_motion_sensor = false;
+#ifdef USE_SENSOR
+    has_motion_sensor |= this->motion_score_sensor_ != nullptr;
+#endif
+#ifdef USE_BINARY_SENSOR
+    has_motion_sensor |= this->motion_binary_sensor_ != nullptr;
+#endif
+    if (has_motion_sensor)
+      ESP_LOGW(TAG, "  The motion sensors need motion_detection to be configured!");
+  }
+  if (this->adaptive_quality_) {
+    ESP_LOGCONFIG(TAG, "  Adaptive Quality: target %.1f fps, JPEG quality up to %u",
+                  1000.0f / this->target_frame_interval_, this->max_jpeg_quality_);
+    if (this->min_frame_size_index_ < this->adaptive_frame_size_index_) {
+      const auto &min_size = FRAME_SIZE_DIMENSIONS[this->min_frame_size_index_];
+      ESP_LOGCONFIG(TAG, "  Adaptive Frame Size: down to %ux%u", min_size.width, min_size.height);
+    }
+  }
 }
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
-  }
+  this->return_images_();
 
-  // Check if we should fetch a new image
-  if (!this->has_requested_image_())
+  const uint32_t now = millis();
+  const bool streaming = now - this->last_stream_request_ < 5000;
+  if (!streaming && this->frame_size_ != this->config_.frame_size)
+    this->set_sensor_frame_size_(this->config_.frame_size);
+  if (streaming)
+    this->adapt_quality_(now);
+
+  // Check if we should fetch a new image, the motion detection analyzes images even if nobody wants them
+  const bool requested = this->has_requested_image_();
+  if (!requested && !this->motion_detection_)
     return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
+  if (this->images_.size() >= this->config_.fb_count) {
+    // all frame buffers are still in use
     return;
   }
-  const uint32_t now = millis();
-  if (now - this->last_update_ <= this->max_update_interval_)
+  uint32_t update_interval = this->max_update_interval_;
+  if (streaming && !this->single_requester_)
+    update_interval = std::max(update_interval, this->stream_update_interval_);
+  if (now - this->last_frame_ <= update_interval)
     return;
 
   // request new image
-  camera_fb_t *fb;
-  if (xQueueReceive(this->framebuffer_get_queue_, &fb, 0L) != pdTRUE) {
+  CapturedFrame frame;
+  if (xQueueReceive(this->framebuffer_get_queue_, &frame, 0L) != pdTRUE) {
     // no frame ready
     ESP_LOGVV(TAG, "No frame ready");
     return;
   }
+  camera_fb_t *fb = frame.buffer;
+  this->last_frame_ = now;
 
   if (fb == nullptr) {
     ESP_LOGW(TAG, "Got invalid frame from camera!");
     xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
     return;
   }
-  this->current_image_ = std::make_shared<CameraImage>(fb);
+  if (this->motion_detection_)
+    this->update_motion_(frame.motion_score, now);
+  if (!requested || (streaming && !this->single_requester_ && this->skip_stream_frame_(now))) {
+    ESP_LOGVV(TAG, "Skipping image without motion");
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    return;
+  }
 
-  ESP_LOGD(TAG, "Got Image: len=%u", fb->len);
-  this->new_image_callback_.call(this->current_image_);
+  auto image = std::make_shared<CameraImage>(fb);
+  this->images_.push_back(image);
+  const float interval = now - this->last_update_;
+  this->frame_interval_ = this->frame_interval_ == 0.0f ? interval : this->frame_interval_ * 0.8f + interval * 0.2f;
+
+  ESP_LOGD(TAG, "Got Image: len=%u (%.1f fps)", fb->len, this->get_framerate());
+  this->new_image_callback_.call(image);
   this->last_update_ = now;
   this->single_requester_ = false;
 }
+void ESP32Camera::update_motion_(float motion_score, uint32_t now) {
+  if (std::isnan(motion_score))
+    return;
+  this->motion_score_ = motion_score;
+  this->previous_motion_ = this->motion_;
+  this->motion_ = motion_score > this->motion_threshold_;
+
+#ifdef USE_BINARY_SENSOR
+  if (this->motion_binary_sensor_ != nullptr &&
+      (this->motion_ != this->previous_motion_ || !this->motion_binary_sensor_->has_state()))
+    this->motion_binary_sensor_->publish_state(this->motion_);
+#endif
+#ifdef USE_SENSOR
+  // images are analyzed at up to the max framerate, the score is only published once per second
+  if (this->motion_score_sensor_ != nullptr && now - this->last_motion_publish_ >= 1000) {
+    this->motion_score_sensor_->publish_state(motion_score);
+    this->last_motion_publish_ = now;
+  }
+#endif
+}
+void ESP32Camera::report_delivery(size_t bytes, uint32_t duration) {
+  duration = std::max<uint32_t>(duration, 1);
+  const float bitrate = bytes * 1000.0f / duration;
+  this->bitrate_ = this->bitrate_ == 0.0f ? bitrate : this->bitrate_ * 0.7f + bitrate * 0.3f;
+  this->delivery_time_ = this->delivery_time_ == 0.0f ? duration : this->delivery_time_ * 0.7f + duration * 0.3f;
+  this->deliveries_++;
+}
+void ESP32Camera::adapt_quality_(uint32_t now) {
+  if (now - this->last_adaptation_ < 1000 || this->deliveries_ == 0)
+    return;
+  this->last_adaptation_ = now;
+  this->deliveries_ = 0;
+#ifdef USE_SENSOR
+  if (this->bitrate_sensor_ != nullptr)
+    this->bitrate_sensor_->publish_state(this->bitrate_ / 1000.0f);
+#endif
+  if (!this->adaptive_quality_)
+    return;
+
+  // clients that want fewer images leave more time for each
+  const float target = std::max(this->target_frame_interval_, float(this->stream_update_interval_));
+  const uint8_t frame_size_index = std::min(this->adaptive_frame_size_index_, this->requested_frame_size_index_);
+  bool changed = false;
+  if (this->delivery_time_ > target) {
+    if (this->jpeg_quality_ < this->max_jpeg_quality_) {
+      // larger steps the further behind the images are
+      const int step = std::min(8, 1 + int((this->delivery_time_ / target - 1.0f) * 10.0f));
+      this->set_sensor_jpeg_quality_(std::min<int>(this->max_jpeg_quality_, this->jpeg_quality_ + step));
+      changed = true;
+    } else if (frame_size_index > this->min_frame_size_index_) {
+      this->adaptive_frame_size_index_ = frame_size_index - 1;
+      this->apply_frame_size_();
+      changed = true;
+    }
+  } else if (this->delivery_time_ < target * 0.6f) {
+    // the next frame size about doubles the size of the images, it needs more headroom
+    if (this->adaptive_frame_size_index_ < this->requested_frame_size_index_ && this->delivery_time_ < target * 0.4f) {
+      this->adaptive_frame_size_index_++;
+      this->apply_frame_size_();
+      changed = true;
+    } else if (this->jpeg_quality_ > this->config_.jpeg_quality) {
+      this->set_sensor_jpeg_quality_(this->jpeg_quality_ - 1);
+      changed = true;
+    }
+  }
+  // images of the old settings may still be reported, start over with the new ones
+  if (changed)
+    this->delivery_time_ = 0.0f;
+}
+void ESP32Camera::set_sensor_jpeg_quality_(uint8_t jpeg_quality) {
+  sensor_t *s = esp_camera_sensor_get();
+  if (s->set_quality(s, jpeg_quality) != 0) {
+    ESP_LOGW(TAG, "Setting JPEG quality %u failed!", jpeg_quality);
+    return;
+  }
+  ESP_LOGD(TAG, "JPEG quality set to %u", jpeg_quality);
+  this->jpeg_quality_ = jpeg_quality;
+#ifdef USE_SENSOR
+  if (this->jpeg_quality_sensor_ != nullptr)
+    this->jpeg_quality_sensor_->publish_state(jpeg_quality);
+#endif
+}
+bool ESP32Camera::skip_stream_frame_(uint32_t now) const {
+  if (!this->motion_detection_ || this->motion_ || this->previous_motion_)
+    return false;
+  return now - this->last_update_ < this->keyframe_interval_;
+}
+void ESP32Camera::return_images_() {
+  for (auto it = this->images_.begin(); it != this->images_.end();) {
+    if (it->use_count() != 1) {
+      // image is still in use
+      ++it;
+      continue;
+    }
+    auto *fb = (*it)->get_raw_buffer();
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    it = this->images_.erase(it);
+  }
+}
 void ESP32Camera::framebuffer_task(void *pv) {
+  const uint8_t fb_count = global_esp32_camera->config_.fb_count;
+  uint8_t in_use = 0;
   while (true) {
-    camera_fb_t *framebuffer = esp_camera_fb_get();
-    xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
-    // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
+    camera_fb_t *framebuffer;
+    // hand the released frame buffers back to the driver, wait for one if all of them are in use
+    while (xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer,
+                         in_use < fb_count ? 0 : portMAX_DELAY) == pdTRUE) {
+      // return is no-op for config with 1 fb
+      if (framebuffer != nullptr)
+        esp_camera_fb_return(framebuffer);
+      in_use--;
+    }
+    // the driver captures into the other frame buffers while this one is sent
+    CapturedFrame frame{esp_camera_fb_get(), NAN};
+    in_use++;
+    if (frame.buffer != nullptr && global_esp32_camera->motion_detection_)
+      frame.motion_score = global_esp32_camera->motion_detector_.analyze(frame.buffer);
+    xQueueSend(global_esp32_camera->framebuffer_get_queue_, &frame, portMAX_DELAY);
   }
 }
 ESP32Camera::ESP32Camera(const std::string &name) : Nameable(name) {
@@ -255,7 +428,57 @@ void ESP32Camera::set_saturation(int saturation) { this->saturation_ = saturatio
 float ESP32Camera::get_setup_priority() const { return setup_priority::DATA; }
 uint32_t ESP32Camera::hash_base() { return 3010542557UL; }
 void ESP32Camera::request_image() { this->single_requester_ = true; }
-void ESP32Camera::request_stream() { this->last_stream_request_ = millis(); }
+void ESP32Camera::request_stream(uint32_t update_interval) {
+  const uint32_t now = millis();
+  // a new stream, or a requester that wants images more often
+  if (now - this->last_stream_request_ >= 5000 || update_interval < this->stream_update_interval_)
+    this->stream_update_interval_ = update_interval;
+  this->last_stream_request_ = now;
+}
+void ESP32Camera::request_frame_size(uint16_t max_width, uint16_t max_height) {
+  if (this->is_failed())
+    return;
+  const FrameSizeDimensions *configured = nullptr;
+  for (const auto &dimensions : FRAME_SIZE_DIMENSIONS) {
+    if (dimensions.frame_size == this->config_.frame_size)
+      configured = &dimensions;
+  }
+  if (configured == nullptr)
+    return;
+
+  // the frame buffers are allocated for the configured frame size, only smaller ones are possible
+  uint8_t index = 0;
+  uint32_t best_area = 0;
+  for (uint8_t i = 0; i < sizeof(FRAME_SIZE_DIMENSIONS) / sizeof(FRAME_SIZE_DIMENSIONS[0]); i++) {
+    const auto &dimensions = FRAME_SIZE_DIMENSIONS[i];
+    if (dimensions.width > configured->width || dimensions.height > configured->height)
+      continue;
+    if ((max_width != 0 && dimensions.width > max_width) || (max_height != 0 && dimensions.height > max_height))
+      continue;
+    const uint32_t area = uint32_t(dimensions.width) * dimensions.height;
+    if (area > best_area) {
+      index = i;
+      best_area = area;
+    }
+  }
+  this->requested_frame_size_index_ = index;
+  this->apply_frame_size_();
+}
+void ESP32Camera::apply_frame_size_() {
+  const uint8_t index = std::min(this->requested_frame_size_index_, this->adaptive_frame_size_index_);
+  const framesize_t frame_size = FRAME_SIZE_DIMENSIONS[index].frame_size;
+  if (frame_size != this->frame_size_)
+    this->set_sensor_frame_size_(frame_size);
+}
+void ESP32Camera::set_sensor_frame_size_(framesize_t frame_size) {
+  sensor_t *s = esp_camera_sensor_get();
+  if (s->set_framesize(s, frame_size) != 0) {
+    ESP_LOGW(TAG, "Setting frame size %d failed!", frame_size);
+    return;
+  }
+  ESP_LOGD(TAG, "Frame size set to %d", frame_size);
+  this->frame_size_ = frame_size;
+}
 bool ESP32Camera::has_requested_image_() const {
   if (this->single_requester_)
     // single request
@@ -272,7 +495,6 @@ bool ESP32Camera::has_requested_image_() const {
 
   return false;
 }
-bool ESP32Camera::can_return_image_() const { return this->current_image_.use_count() == 1; }
 void ESP32Camera::set_max_update_interval(uint32_t max_update_interval) {
   this->max_update_interval_ = max_update_interval;
 }
@@ -280,6 +502,17 @@ void ESP32Camera::set_idle_update_interval(uint32_t idle_update_interval) {
   this->idle_update_interval_ = idle_update_interval;
 }
 void ESP32Camera::set_test_pattern(bool test_pattern) { this->test_pattern_ = test_pattern; }
+void ESP32Camera::set_adaptive_quality(float target_framerate, uint8_t max_jpeg_quality) {
+  this->adaptive_quality_ = true;
+  this->target_frame_interval_ = 1000.0f / target_framerate;
+  this->max_jpeg_quality_ = max_jpeg_quality;
+}
+void ESP32Camera::set_motion_detection(float threshold, uint8_t block_threshold, uint32_t keyframe_interval) {
+  this->motion_detection_ = true;
+  this->motion_threshold_ = threshold;
+  this->motion_detector_.set_block_threshold(block_threshold);
+  this->keyframe_interval_ = keyframe_interval;
+}
 
 ESP32Camera *global_esp32_camera;
 
@@ -302,6 +535,64 @@ uint8_t *CameraImage::get_data_buffer() { return this->buffer_->buf; }
 size_t CameraImage::get_data_length() { return this->buffer_->len; }
 CameraImage::CameraImage(camera_fb_t *buffer) : buffer_(buffer) {}
 
+float MotionDetector::analyze(camera_fb_t *fb) {
+  this->fb_ = fb;
+  this->width_ = 0;
+  this->height_ = 0;
+  memset(this->sums_, 0, sizeof(this->sums_));
+  memset(this->counts_, 0, sizeof(this->counts_));
+  if (esp_jpg_decode(fb->len, JPG_SCALE_8X, &MotionDetector::read_jpeg, &MotionDetector::write_pixels, this) != ESP_OK)
+    return NAN;
+
+  const size_t blocks = MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT;
+  size_t changed = 0;
+  for (size_t i = 0; i < blocks; i++) {
+    const uint8_t brightness = this->counts_[i] == 0 ? 0 : this->sums_[i] / this->counts_[i];
+    if (this->has_previous_ && abs(int(brightness) - int(this->previous_[i])) > this->block_threshold_)
+      changed++;
+    this->previous_[i] = brightness;
+  }
+  if (!this->has_previous_) {
+    this->has_previous_ = true;
+    return NAN;
+  }
+  return changed * 100.0f / blocks;
+}
+uint32_t MotionDetector::read_jpeg(void *arg, size_t index, uint8_t *buf, size_t len) {
+  auto *detector = reinterpret_cast<MotionDetector *>(arg);
+  if (index >= detector->fb_->len)
+    return 0;
+  len = std::min(len, detector->fb_->len - index);
+  // a null buffer skips the data
+  if (buf != nullptr)
+    memcpy(buf, detector->fb_->buf + index, len);
+  return len;
+}
+bool MotionDetector::write_pixels(void *arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t *data) {
+  auto *detector = reinterpret_cast<MotionDetector *>(arg);
+  if (data == nullptr) {
+    // called without data at the start with the size of the image, and at the end
+    if (x == 0 && y == 0) {
+      detector->width_ = w;
+      detector->height_ = h;
+    }
+    return true;
+  }
+  if (detector->width_ == 0 || detector->height_ == 0)
+    return false;
+
+  for (uint16_t row = y; row < y + h; row++) {
+    const size_t block_row = size_t(row) * MOTION_GRID_HEIGHT / detector->height_ * MOTION_GRID_WIDTH;
+    for (uint16_t col = x; col < x + w; col++, data += 3) {
+      const size_t block = block_row + size_t(col) * MOTION_GRID_WIDTH / detector->width_;
+      // the order of red and blue doesn't matter for this approximation of the luma
+      detector->sums_[block] += (data[0] + 2 * data[1] + data[2]) >> 2;
+      detector->counts_[block]++;
+    }
+  }
+  return true;
+}
+
 }  // namespace esp32_camera
 }  // namespace esphome
 
@@ -3,8 +3,18 @@
 #ifdef ARDUINO_ARCH_ESP32
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include <esp_camera.h>
+#include <cmath>
+#include <vector>
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
 
 namespace esphome {
 namespace esp32_camera {
@@ -25,6 +35,7 @@ class CameraImage {
 class CameraImageReader {
  public:
   void set_image(std::shared_ptr<CameraImage> image);
+  const std::shared_ptr<CameraImage> &get_image() const { return this->image_; }
   size_t available() const;
   uint8_t *peek_data_buffer();
   void consume_data(size_t consumed);
@@ -35,6 +46,36 @@ class CameraImageReader {
   size_t offset_{0};
 };
 
+/// The grid the image is divided into for motion detection.
+static const uint8_t MOTION_GRID_WIDTH = 16;
+static const uint8_t MOTION_GRID_HEIGHT = 12;
+
+/** Compares the brightness of the blocks of a grid over the image to the previous image.
+ *
+ * The JPEG is decoded at 1/8 scale, which only needs the DC coefficients of most blocks and takes a fraction of the
+ * time of a full decode. Only runs in the frame buffer task.
+ */
+class MotionDetector {
+ public:
+  void set_block_threshold(uint8_t block_threshold) { this->block_threshold_ = block_threshold; }
+  /// The share of blocks whose brightness changed by more than the block threshold in percent, NAN if there is no
+  /// previous image to compare to or decoding failed.
+  float analyze(camera_fb_t *fb);
+
+ protected:
+  static uint32_t read_jpeg(void *arg, size_t index, uint8_t *buf, size_t len);
+  static bool write_pixels(void *arg, uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t *data);
+
+  uint8_t block_threshold_{15};
+  camera_fb_t *fb_{nullptr};
+  uint16_t width_{0};
+  uint16_t height_{0};
+  uint32_t sums_[MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT];
+  uint16_t counts_[MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT];
+  uint8_t previous_[MOTION_GRID_WIDTH * MOTION_GRID_HEIGHT];
+  bool has_previous_{false};
+};
+
 enum ESP32CameraFrameSize {
   ESP32_CAMERA_SIZE_160X120,    // QQVGA
   ESP32_CAMERA_SIZE_128X160,    // QQVGA2
@@ -70,18 +111,85 @@ class ESP32Camera : public Component, public Nameable {
   void set_max_update_interval(uint32_t max_update_interval);
   void set_idle_update_interval(uint32_t idle_update_interval);
   void set_test_pattern(bool test_pattern);
+  /// Capture into this many frame buffers, so that the next image is taken while the last one is still being sent.
+  void set_frame_buffer_count(uint8_t frame_buffer_count) { this->config_.fb_count = frame_buffer_count; }
   void setup() override;
   void loop() override;
   void dump_config() override;
   void add_image_callback(std::function<void(std::shared_ptr<CameraImage>)> &&f);
   float get_setup_priority() const override;
-  void request_stream();
+  /** Request images for the next 5 seconds.
+   *
+   * @param update_interval The interval the requester wants images at, images are taken at the shortest interval
+   *   of all requesters but not faster than the max framerate. 0 to stream at the max framerate.
+   */
+  void request_stream(uint32_t update_interval = 0);
   void request_image();
+  /// Stream in the largest resolution up to the configured one that fits into width x height (0 = configured).
+  void request_frame_size(uint16_t max_width, uint16_t max_height);
+  /// The rate at which new images are taken in fps.
+  float get_framerate() const { return this->frame_interval_ == 0.0f ? 0.0f : 1000.0f / this->frame_interval_; }
+  /** Analyze every image for motion, and only stream images while there is motion.
+   *
+   * @param threshold The share of changed blocks in percent above which there is motion.
+   * @param block_threshold The change in brightness of a block (0-255) above which it changed.
+   * @param keyframe_interval Stream an image at least this often in ms without motion.
+   */
+  void set_motion_detection(float threshold, uint8_t block_threshold, uint32_t keyframe_interval);
+#ifdef USE_SENSOR
+  void set_motion_score_sensor(sensor::Sensor *motion_score_sensor) {
+    this->motion_score_sensor_ = motion_score_sensor;
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  void set_motion_binary_sensor(binary_sensor::BinarySensor *motion_binary_sensor) {
+    this->motion_binary_sensor_ = motion_binary_sensor;
+  }
+#endif
+  /** Adapt the JPEG quality of streams to the throughput of the links to the clients.
+   *
+   * The API connections report how long each image took until the client acknowledged it. Once per second, the
+   * quality is lowered while images take longer than the interval of the target framerate, and raised while they
+   * take less than 60% of it. Below the configured JPEG quality (the best one) and up to max_jpeg_quality (the worst
+   * one, higher is worse). Frame sizes are only lowered with set_min_frame_size().
+   */
+  void set_adaptive_quality(float target_framerate, uint8_t max_jpeg_quality);
+  /// Lower the frame size down to this one when the quality can't be lowered any further.
+  void set_min_frame_size(ESP32CameraFrameSize size) { this->min_frame_size_index_ = size; }
+  /// Called by the API connections when a client acknowledged an image.
+  void report_delivery(size_t bytes, uint32_t duration);
+  /// The JPEG quality of the sensor, lower is better.
+  uint8_t get_jpeg_quality() const { return this->jpeg_quality_; }
+  /// Moving average of the throughput of the image deliveries in bytes/s.
+  float get_bitrate() const { return this->bitrate_; }
+#ifdef USE_SENSOR
+  void set_jpeg_quality_sensor(sensor::Sensor *jpeg_quality_sensor) {
+    this->jpeg_quality_sensor_ = jpeg_quality_sensor;
+  }
+  void set_bitrate_sensor(sensor::Sensor *bitrate_sensor) { this->bitrate_sensor_ = bitrate_sensor; }
+#endif
+  /// The share of changed blocks of the last analyzed image in percent.
+  float get_motion_score() const { return this->motion_score_; }
+  bool has_motion() const { return this->motion_; }
 
  protected:
   uint32_t hash_base() override;
   bool has_requested_image_() const;
-  bool can_return_image_() const;
+  void return_images_();
+  void set_sensor_frame_size_(framesize_t frame_size);
+  /// Set the frame size the client asked for, or the one the link allows if that is smaller.
+  void apply_frame_size_();
+  void adapt_quality_(uint32_t now);
+  void set_sensor_jpeg_quality_(uint8_t jpeg_quality);
+  void update_motion_(float motion_score, uint32_t now);
+  /// Whether a frame of a stream is skipped because nothing moved.
+  bool skip_stream_frame_(uint32_t now) const;
+
+  /// A captured frame buffer with the motion score of its image.
+  struct CapturedFrame {
+    camera_fb_t *buffer;
+    float motion_score;
+  };
 
   static void framebuffer_task(void *pv);
 
@@ -94,8 +202,14 @@ class ESP32Camera : public Component, public Nameable {
   bool test_pattern_{false};
 
   esp_err_t init_error_{ESP_OK};
-  std::shared_ptr<CameraImage> current_image_;
+  /// Images handed out to the image callbacks, until nobody uses them anymore.
+  std::vector<std::shared_ptr<CameraImage>> images_;
   uint32_t last_stream_request_{0};
+  uint32_t stream_update_interval_{0};
+  /// The frame size of the sensor, smaller than the configured one while a requester asked for it.
+  framesize_t frame_size_;
+  /// Moving average of the time between two images in ms.
+  float frame_interval_{0.0f};
   bool single_requester_{false};
   QueueHandle_t framebuffer_get_queue_;
   QueueHandle_t framebuffer_return_queue_;
@@ -103,6 +217,41 @@ class ESP32Camera : public Component, public Nameable {
   uint32_t max_update_interval_{1000};
   uint32_t idle_update_interval_{15000};
   uint32_t last_update_{0};
+  /// When the last frame buffer was taken from the driver, sent or only analyzed.
+  uint32_t last_frame_{0};
+
+  bool motion_detection_{false};
+  MotionDetector motion_detector_;
+  float motion_threshold_{2.0f};
+  uint32_t keyframe_interval_{10000};
+  float motion_score_{NAN};
+  bool motion_{false};
+  /// Whether the previous image had motion, so the image after the motion ended is streamed too.
+  bool previous_motion_{false};
+  uint32_t last_motion_publish_{0};
+
+  bool adaptive_quality_{false};
+  float target_frame_interval_{0.0f};
+  uint8_t max_jpeg_quality_{63};
+  /// The current JPEG quality of the sensor.
+  uint8_t jpeg_quality_;
+  /// Indices into the frame sizes from small to large, see ESP32CameraFrameSize.
+  uint8_t min_frame_size_index_{ESP32_CAMERA_SIZE_1600X1200 + 1};
+  uint8_t requested_frame_size_index_{0};
+  uint8_t adaptive_frame_size_index_{ESP32_CAMERA_SIZE_1600X1200};
+  /// Moving averages of the image deliveries reported since the last adjustment.
+  float bitrate_{0.0f};
+  float delivery_time_{0.0f};
+  uint32_t deliveries_{0};
+  uint32_t last_adaptation_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *motion_score_sensor_{nullptr};
+  sensor::Sensor *jpeg_quality_sensor_{nullptr};
+  sensor::Sensor *bitrate_sensor_{nullptr};
+#endif
+#ifdef USE_BINARY_SENSOR
+  binary_sensor::BinarySensor *motion_binary_sensor_{nullptr};
+#endif
 };
 
 extern ESP32Camera *global_esp32_camera;
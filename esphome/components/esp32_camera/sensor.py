@@ -0,0 +1,40 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_TYPE, ICON_EMPTY, ICON_MOTION_SENSOR, UNIT_EMPTY, UNIT_PERCENT
+from . import ESP32Camera, CONF_ESP32_CAMERA_ID
+
+DEPENDENCIES = ['esp32_camera']
+
+# The share of the image that changed since the previous image, needs motion_detection
+TYPE_MOTION_SCORE = 'motion_score'
+# The current JPEG quality, lower is better
+TYPE_JPEG_QUALITY = 'jpeg_quality'
+# The throughput of the images to the API clients
+TYPE_BITRATE = 'bitrate'
+
+UNIT_KILOBYTES_PER_SECOND = 'kB/s'
+ICON_SPEEDOMETER = 'mdi:speedometer'
+
+SETTERS = {
+    TYPE_MOTION_SCORE: 'set_motion_score_sensor',
+    TYPE_JPEG_QUALITY: 'set_jpeg_quality_sensor',
+    TYPE_BITRATE: 'set_bitrate_sensor',
+}
+
+BASE_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(sensor.Sensor),
+    cv.GenerateID(CONF_ESP32_CAMERA_ID): cv.use_id(ESP32Camera),
+})
+
+CONFIG_SCHEMA = cv.typed_schema({
+    TYPE_MOTION_SCORE: sensor.sensor_schema(UNIT_PERCENT, ICON_MOTION_SENSOR, 1).extend(BASE_SCHEMA),
+    TYPE_JPEG_QUALITY: sensor.sensor_schema(UNIT_EMPTY, ICON_EMPTY, 0).extend(BASE_SCHEMA),
+    TYPE_BITRATE: sensor.sensor_schema(UNIT_KILOBYTES_PER_SECOND, ICON_SPEEDOMETER, 1).extend(BASE_SCHEMA),
+}, lower=True)
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_ESP32_CAMERA_ID])
+    var = yield sensor.new_sensor(config)
+    cg.add(getattr(parent, SETTERS[config[CONF_TYPE]])(var))
@@ -0,0 +1,28 @@
+import esphome.config_validation as cv
+import esphome.codegen as cg
+from esphome.const import CONF_ID, ESP_PLATFORM_ESP32
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
+from esphome.components import web_server_base
+
+ESP_PLATFORMS = [ESP_PLATFORM_ESP32]
+DEPENDENCIES = ['esp32_camera']
+AUTO_LOAD = ['web_server_base']
+
+esp32_camera_web_server_ns = cg.esphome_ns.namespace('esp32_camera_web_server')
+CameraWebServer = esp32_camera_web_server_ns.class_('CameraWebServer', cg.Component)
+
+CONF_MAX_STREAMS = 'max_streams'
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(CameraWebServer),
+    cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(web_server_base.WebServerBase),
+    cv.Optional(CONF_MAX_STREAMS, default=4): cv.int_range(min=1, max=8),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    paren = yield cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
+
+    var = cg.new_Pvariable(config[CONF_ID], paren)
+    yield cg.register_component(var, config)
+    cg.add(var.set_max_streams(config[CONF_MAX_STREAMS]))
@@ -0,0 +1,159 @@
+#include "camera_web_server.h"
+#include "esphome/core/log.h"
+#include "esphome/core/util.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace esphome {
+namespace esp32_camera_web_server {
+
+static const char *TAG = "esp32_camera_web_server";
+
+#define PART_BOUNDARY "esphomeframe"
+static const char *STREAM_HEADER = "HTTP/1.1 200 OK\r\n"
+                                   "Content-Type: multipart/x-mixed-replace;boundary=" PART_BOUNDARY "\r\n"
+                                   "Access-Control-Allow-Origin: *\r\n"
+                                   "Cache-Control: no-cache\r\n"
+                                   "Connection: close\r\n"
+                                   "\r\n";
+// the line break in front of the boundary ends the previous part
+static const char *PART_HEADER = "\r\n--" PART_BOUNDARY "\r\n"
+                                 "Content-Type: image/jpeg\r\n"
+                                 "Content-Length: %u\r\n"
+                                 "\r\n";
+
+CameraStream::CameraStream(AsyncWebServerRequest *request) : client_(request->client()) {
+  this->remote_ = this->client_->remoteIP().toString().c_str();
+  // the request doesn't get a response, so neither it nor its handlers need the acks
+  this->client_->onAck(
+      [](void *s, AsyncClient *c, size_t len, uint32_t time) { ((CameraStream *) s)->acked_bytes_ += len; }, this);
+  request->onDisconnect([this]() { this->disconnected_ = true; });
+}
+void CameraStream::loop(CameraWebServer *parent) {
+  this->release_images_();
+
+  if (this->image_ == nullptr) {
+    const uint32_t last_sequence = this->sequence_;
+    this->image_ = parent->take_image(this->sequence_);
+    if (this->image_ == nullptr)
+      return;
+    if (last_sequence != 0)
+      this->skipped_frames_ += this->sequence_ - last_sequence - 1;
+    char buffer[96];
+    snprintf(buffer, sizeof(buffer), PART_HEADER, this->image_->get_data_length());
+    this->part_header_ = buffer;
+    this->header_offset_ = 0;
+    this->data_offset_ = 0;
+  }
+
+  size_t space = this->client_->space();
+  bool added = false;
+  if (space != 0 && this->header_offset_ < this->part_header_.size()) {
+    const size_t len = std::min(space, this->part_header_.size() - this->header_offset_);
+    this->client_->add(this->part_header_.data() + this->header_offset_, len,
+                       ASYNC_WRITE_FLAG_COPY | ASYNC_WRITE_FLAG_MORE);
+    this->header_offset_ += len;
+    this->sent_bytes_ += len;
+    space -= len;
+    added = true;
+  }
+  const size_t data_length = this->image_->get_data_length();
+  if (space != 0 && this->header_offset_ == this->part_header_.size() && this->data_offset_ < data_length) {
+    const size_t len = std::min(space, data_length - this->data_offset_);
+    // not copied, lwIP references the frame buffer until the data is acknowledged
+    this->client_->add(reinterpret_cast<const char *>(this->image_->get_data_buffer() + this->data_offset_), len, 0);
+    this->data_offset_ += len;
+    this->sent_bytes_ += len;
+    added = true;
+  }
+  if (added)
+    this->client_->send();
+
+  if (this->data_offset_ == data_length) {
+    this->unacked_images_.push_back(UnackedImage{this->sent_bytes_, std::move(this->image_)});
+    this->frames_++;
+  }
+}
+void CameraStream::release_images_() {
+  while (!this->unacked_images_.empty() && int32_t(this->acked_bytes_ - this->unacked_images_.front().sent_bytes) >= 0)
+    this->unacked_images_.pop_front();
+}
+
+void CameraWebServer::setup() {
+  this->new_streams_lock_ = xSemaphoreCreateMutex();
+  this->base_->init();
+  this->base_->add_handler(this);
+  esp32_camera::global_esp32_camera->add_image_callback([this](std::shared_ptr<esp32_camera::CameraImage> image) {
+    if (this->streams_.empty())
+      return;
+    this->image_ = std::move(image);
+    this->sequence_++;
+  });
+}
+void CameraWebServer::handleRequest(AsyncWebServerRequest *request) {
+  // called in the async_tcp task, the main loop picks the stream up
+  xSemaphoreTake(this->new_streams_lock_, portMAX_DELAY);
+  const bool full = this->stream_count_ + this->new_streams_.size() >= this->max_streams_;
+  if (!full) {
+    auto *stream = new CameraStream(request);
+    // the stream takes over the connection, the request never gets a response
+    request->client()->write(STREAM_HEADER);
+    this->new_streams_.push_back(stream);
+  }
+  xSemaphoreGive(this->new_streams_lock_);
+
+  if (full)
+    request->send(503, "text/plain", "Too many streams");
+}
+void CameraWebServer::loop() {
+  xSemaphoreTake(this->new_streams_lock_, portMAX_DELAY);
+  for (auto *stream : this->new_streams_) {
+    ESP_LOGD(TAG, "Streaming to %s", stream->get_remote().c_str());
+    this->streams_.push_back(stream);
+  }
+  this->new_streams_.clear();
+  auto new_end = std::partition(this->streams_.begin(), this->streams_.end(),
+                                [](CameraStream *stream) { return !stream->is_disconnected(); });
+  for (auto it = new_end; it != this->streams_.end(); ++it) {
+    ESP_LOGD(TAG, "Stream to %s closed after %u images (%u skipped)", (*it)->get_remote().c_str(),
+             (*it)->get_frames(), (*it)->get_skipped_frames());
+    delete *it;
+  }
+  this->streams_.erase(new_end, this->streams_.end());
+  this->stream_count_ = this->streams_.size();
+  xSemaphoreGive(this->new_streams_lock_);
+
+  if (this->streams_.empty()) {
+    this->image_.reset();
+    return;
+  }
+
+  esp32_camera::global_esp32_camera->request_stream();
+  for (auto *stream : this->streams_)
+    stream->loop(this);
+
+  // every stream took the image, the streams hold it as long as they need it
+  bool taken = true;
+  for (auto *stream : this->streams_) {
+    if (stream->get_sequence() != this->sequence_)
+      taken = false;
+  }
+  if (taken)
+    this->image_.reset();
+}
+void CameraWebServer::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP32 Camera Web Server:");
+  ESP_LOGCONFIG(TAG, "  Address: %s:%u/stream", network_get_address().c_str(), this->base_->get_port());
+  ESP_LOGCONFIG(TAG, "  Max Streams: %u", this->max_streams_);
+}
+std::shared_ptr<esp32_camera::CameraImage> CameraWebServer::take_image(uint32_t &sequence) {
+  if (this->image_ == nullptr || sequence == this->sequence_)
+    return nullptr;
+  sequence = this->sequence_;
+  return this->image_;
+}
+
+}  // namespace esp32_camera_web_server
+}  // namespace esphome
+
+#endif
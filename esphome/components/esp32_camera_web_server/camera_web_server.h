@@ -0,0 +1,112 @@
+#pragma once
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include "esphome/components/web_server_base/web_server_base.h"
+#include "esphome/components/esp32_camera/esp32_camera.h"
+#include "esphome/core/component.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace esp32_camera_web_server {
+
+class CameraWebServer;
+
+/** One client of the MJPEG stream.
+ *
+ * The stream takes over the TCP connection of the HTTP request and is fed from the main loop. The image data is
+ * queued straight from the camera frame buffer, the image is held until the client acknowledged it.
+ */
+class CameraStream {
+ public:
+  CameraStream(AsyncWebServerRequest *request);
+
+  /// Queue as much of the current image as fits, starting with the newest image once the last one is done.
+  void loop(CameraWebServer *parent);
+  /// Whether the client disconnected, the stream must not touch the client anymore then.
+  bool is_disconnected() const { return this->disconnected_; }
+  uint32_t get_sequence() const { return this->sequence_; }
+  const std::string &get_remote() const { return this->remote_; }
+  uint32_t get_frames() const { return this->frames_; }
+  uint32_t get_skipped_frames() const { return this->skipped_frames_; }
+
+ protected:
+  /// Release the images of which all data has been acknowledged by the client.
+  void release_images_();
+
+  AsyncClient *client_;
+  std::string remote_;
+  volatile bool disconnected_{false};
+  std::shared_ptr<esp32_camera::CameraImage> image_;
+  /// The part header of the current image, it's sent before the data.
+  std::string part_header_;
+  size_t header_offset_{0};
+  size_t data_offset_{0};
+  /// The sequence number of the last image taken by this stream.
+  uint32_t sequence_{0};
+  uint32_t frames_{0};
+  uint32_t skipped_frames_{0};
+
+  struct UnackedImage {
+    uint32_t sent_bytes;
+    std::shared_ptr<esp32_camera::CameraImage> image;
+  };
+  std::deque<UnackedImage> unacked_images_;
+  /// Bytes queued with and acknowledged by the TCP client in total, both wrap around.
+  uint32_t sent_bytes_{0};
+  volatile uint32_t acked_bytes_{0};
+};
+
+/** Serves the camera images as an MJPEG stream under '/stream'.
+ *
+ * All clients share the same images, a client that can't keep up skips images and starts with the newest one once
+ * it's done with the last one.
+ */
+class CameraWebServer : public AsyncWebHandler, public Component {
+ public:
+  CameraWebServer(web_server_base::WebServerBase *base) : base_(base) {}
+
+  void set_max_streams(uint8_t max_streams) { this->max_streams_ = max_streams; }
+
+  bool canHandle(AsyncWebServerRequest *request) override {
+    return request->method() == HTTP_GET && request->url() == "/stream";
+  }
+  void handleRequest(AsyncWebServerRequest *request) override;
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override {
+    // After WiFi
+    return setup_priority::WIFI - 1.0f;
+  }
+
+  /// The newest image if it's newer than the one with the given sequence number, which is updated.
+  std::shared_ptr<esp32_camera::CameraImage> take_image(uint32_t &sequence);
+  uint32_t get_sequence() const { return this->sequence_; }
+
+ protected:
+  web_server_base::WebServerBase *base_;
+  uint8_t max_streams_{4};
+  /// Held until every stream took it, so that slow streams don't keep more than one frame buffer each.
+  std::shared_ptr<esp32_camera::CameraImage> image_;
+  uint32_t sequence_{0};
+  std::vector<CameraStream *> streams_;
+  /// Streams accepted in the async_tcp task that the main loop didn't pick up yet.
+  std::vector<CameraStream *> new_streams_;
+  /// The number of streams in streams_, for the async_tcp task.
+  volatile size_t stream_count_{0};
+  SemaphoreHandle_t new_streams_lock_;
+};
+
+}  // namespace esp32_camera_web_server
+}  // namespace esphome
+
+#endif
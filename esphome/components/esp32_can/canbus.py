@@ -0,0 +1,39 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import pins
+from esphome.components import canbus
+from esphome.const import CONF_ID, CONF_RX_PIN, CONF_TX_PIN, ESP_PLATFORM_ESP32
+from esphome.components.canbus import CanbusComponent, CONF_BIT_RATE
+
+ESP_PLATFORMS = [ESP_PLATFORM_ESP32]
+
+CONF_RX_QUEUE_LEN = 'rx_queue_len'
+
+esp32_can_ns = cg.esphome_ns.namespace('esp32_can')
+ESP32Can = esp32_can_ns.class_('ESP32Can', CanbusComponent)
+
+# The bit rates the driver has timings for
+BIT_RATES = ['50KBPS', '100KBPS', '125KBPS', '250KBPS', '500KBPS', '1000KBPS']
+
+
+def validate_bit_rate(config):
+    if config[CONF_BIT_RATE] not in BIT_RATES:
+        raise cv.Invalid("The ESP32 CAN controller only supports the bit rates {}".format(
+            ', '.join(BIT_RATES)), path=[CONF_BIT_RATE])
+    return config
+
+
+CONFIG_SCHEMA = cv.All(canbus.CONFIG_SCHEMA.extend({
+    cv.GenerateID(): cv.declare_id(ESP32Can),
+    cv.Required(CONF_RX_PIN): pins.input_pin,
+    cv.Required(CONF_TX_PIN): pins.output_pin,
+    cv.Optional(CONF_RX_QUEUE_LEN, default=32): cv.int_range(min=1, max=255),
+}), validate_bit_rate)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield canbus.register_canbus(var, config)
+    cg.add(var.set_rx(config[CONF_RX_PIN]))
+    cg.add(var.set_tx(config[CONF_TX_PIN]))
+    cg.add(var.set_rx_queue_len(config[CONF_RX_QUEUE_LEN]))
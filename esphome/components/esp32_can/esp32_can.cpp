@@ -0,0 +1,183 @@
+#include "esp32_can.h"
+#include "esphome/core/log.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace esp32_can {
+
+static const char *TAG = "esp32_can";
+
+/// How often the error counters of the driver are checked, in ms.
+static const uint32_t STATUS_INTERVAL = 1000;
+
+static bool get_timing(canbus::CanSpeed bit_rate, can_timing_config_t *timing) {
+  switch (bit_rate) {
+    case canbus::CAN_50KBPS:
+      *timing = (can_timing_config_t) CAN_TIMING_CONFIG_50KBITS();
+      return true;
+    case canbus::CAN_100KBPS:
+      *timing = (can_timing_config_t) CAN_TIMING_CONFIG_100KBITS();
+      return true;
+    case canbus::CAN_125KBPS:
+      *timing = (can_timing_config_t) CAN_TIMING_CONFIG_125KBITS();
+      return true;
+    case canbus::CAN_250KBPS:
+      *timing = (can_timing_config_t) CAN_TIMING_CONFIG_250KBITS();
+      return true;
+    case canbus::CAN_500KBPS:
+      *timing = (can_timing_config_t) CAN_TIMING_CONFIG_500KBITS();
+      return true;
+    case canbus::CAN_1000KBPS:
+      *timing = (can_timing_config_t) CAN_TIMING_CONFIG_1MBITS();
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ESP32Can::setup_internal() {
+  // without triggers every frame is received, setup_filters() narrows this down once they are registered
+  const can_filter_config_t filter = CAN_FILTER_CONFIG_ACCEPT_ALL();
+  if (!this->start_driver_(filter))
+    return false;
+  this->set_interval("status", STATUS_INTERVAL, [this]() { this->check_status_(); });
+  return true;
+}
+
+bool ESP32Can::start_driver_(const can_filter_config_t &filter) {
+  can_timing_config_t timing;
+  if (!get_timing(this->bit_rate_, &timing)) {
+    ESP_LOGE(TAG, "Bit rate not supported by the controller");
+    return false;
+  }
+  can_general_config_t general =
+      CAN_GENERAL_CONFIG_DEFAULT((gpio_num_t) this->tx_, (gpio_num_t) this->rx_, CAN_MODE_NORMAL);
+  general.rx_queue_len = this->rx_queue_len_;
+  general.tx_queue_len = canbus::CAN_TX_QUEUE_SIZE;
+
+  esp_err_t err = can_driver_install(&general, &timing, &filter);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Installing the driver failed: %d", err);
+    return false;
+  }
+  err = can_start();
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Starting the driver failed: %d", err);
+    can_driver_uninstall();
+    return false;
+  }
+  return true;
+}
+
+void ESP32Can::setup_filters(const std::vector<uint32_t> &standard_ids, const std::vector<uint32_t> &extended_ids) {
+  // A single filter compares either the 11 bit ID of standard frames or the 29 bit ID of extended frames. With both
+  // kinds, all frames are accepted and only the trigger lookup filters them.
+  if (standard_ids.empty() == extended_ids.empty())
+    return;
+
+  const bool extended = !extended_ids.empty();
+  const std::vector<uint32_t> &ids = extended ? extended_ids : standard_ids;
+  // only compare the bits all IDs have in common, set bits of the mask are ignored
+  uint32_t ignored = 0;
+  for (uint32_t id : ids)
+    ignored |= id ^ ids[0];
+
+  can_filter_config_t filter;
+  filter.single_filter = true;
+  if (extended) {
+    // ID in bits 31-3, then RTR
+    filter.acceptance_code = ids[0] << 3;
+    filter.acceptance_mask = (ignored << 3) | 0x7;
+  } else {
+    // ID in bits 31-21, then RTR and the first two data bytes
+    filter.acceptance_code = ids[0] << 21;
+    filter.acceptance_mask = (ignored << 21) | 0x1FFFFF;
+  }
+  ESP_LOGD(TAG, "Filter: %s code=0x%08x mask=0x%08x for %u IDs", extended ? "extended" : "standard",
+           filter.acceptance_code, filter.acceptance_mask, ids.size());
+
+  // the filter can only be changed while the driver is uninstalled
+  can_stop();
+  can_driver_uninstall();
+  if (!this->start_driver_(filter)) {
+    this->mark_failed();
+  }
+}
+
+canbus::Error ESP32Can::send_message(struct canbus::CanFrame *frame) {
+  if (frame->can_data_length_code > canbus::CAN_MAX_DATA_LENGTH)
+    return canbus::ERROR_FAILTX;
+
+  can_message_t message;
+  message.flags = CAN_MSG_FLAG_NONE;
+  if (frame->use_extended_id)
+    message.flags |= CAN_MSG_FLAG_EXTD;
+  if (frame->remote_transmission_request)
+    message.flags |= CAN_MSG_FLAG_RTR;
+  message.identifier = frame->can_id;
+  message.data_length_code = frame->can_data_length_code;
+  memcpy(message.data, frame->data, frame->can_data_length_code);
+
+  // don't wait, Canbus queues the frame until the driver has room for it
+  switch (can_transmit(&message, 0)) {
+    case ESP_OK:
+      return canbus::ERROR_OK;
+    case ESP_ERR_TIMEOUT:
+      return canbus::ERROR_ALLTXBUSY;
+    default:
+      return canbus::ERROR_FAILTX;
+  }
+}
+
+canbus::Error ESP32Can::read_message(struct canbus::CanFrame *frame) {
+  can_message_t message;
+  if (can_receive(&message, 0) != ESP_OK)
+    return canbus::ERROR_NOMSG;
+
+  frame->can_id = message.identifier;
+  frame->use_extended_id = message.flags & CAN_MSG_FLAG_EXTD;
+  frame->remote_transmission_request = message.flags & CAN_MSG_FLAG_RTR;
+  frame->can_data_length_code = std::min<uint8_t>(message.data_length_code, canbus::CAN_MAX_DATA_LENGTH);
+  if (!frame->remote_transmission_request)
+    memcpy(frame->data, message.data, frame->can_data_length_code);
+  return canbus::ERROR_OK;
+}
+
+void ESP32Can::check_status_() {
+  can_status_info_t status;
+  if (can_get_status_info(&status) != ESP_OK)
+    return;
+
+  // the driver counts from its installation, which only happens before the first frames
+  if (status.rx_missed_count > this->rx_missed_) {
+    ESP_LOGW(TAG, "Receive queue full, %u frames lost so far", status.rx_missed_count);
+    this->rx_missed_ = status.rx_missed_count;
+  }
+  this->bus_errors_ = status.bus_error_count;
+  this->tx_failed_ = status.tx_failed_count;
+
+  if (status.state == CAN_STATE_BUS_OFF) {
+    ESP_LOGW(TAG, "Bus off, recovering...");
+    can_initiate_recovery();
+  } else if (status.state == CAN_STATE_STOPPED) {
+    // recovery is done
+    can_start();
+  }
+}
+
+void ESP32Can::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP32 CAN:");
+  ESP_LOGCONFIG(TAG, "  RX Pin: %u", this->rx_);
+  ESP_LOGCONFIG(TAG, "  TX Pin: %u", this->tx_);
+  ESP_LOGCONFIG(TAG, "  RX Queue Length: %u", this->rx_queue_len_);
+  canbus::Canbus::dump_config();
+}
+
+}  // namespace esp32_can
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "esphome/components/canbus/canbus.h"
+#include "esphome/core/component.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+#include <driver/can.h>
+
+namespace esphome {
+namespace esp32_can {
+
+/** The CAN (TWAI) controller built into the ESP32.
+ *
+ * The IDF driver receives and sends frames from its interrupt into queues, so frames aren't lost while the loop is
+ * busy and reading or sending one is a queue operation instead of SPI transfers. The acceptance filter of the
+ * controller is set up from the IDs of the triggers.
+ */
+class ESP32Can : public canbus::Canbus {
+ public:
+  void set_rx(uint8_t rx) { this->rx_ = rx; }
+  void set_tx(uint8_t tx) { this->tx_ = tx; }
+  /// Set how many received frames the driver buffers until the loop reads them.
+  void set_rx_queue_len(uint32_t rx_queue_len) { this->rx_queue_len_ = rx_queue_len; }
+
+  void dump_config() override;
+
+  /// The number of frames lost because the receive queue or the receive FIFO of the controller was full.
+  uint32_t get_rx_missed() const { return this->rx_missed_; }
+  /// The number of errors detected on the bus.
+  uint32_t get_bus_errors() const { return this->bus_errors_; }
+  /// The number of frames that couldn't be sent.
+  uint32_t get_tx_failed() const { return this->tx_failed_; }
+
+ protected:
+  bool setup_internal() override;
+  canbus::Error send_message(struct canbus::CanFrame *frame) override;
+  canbus::Error read_message(struct canbus::CanFrame *frame) override;
+  void setup_filters(const std::vector<uint32_t> &standard_ids, const std::vector<uint32_t> &extended_ids) override;
+
+  /// Install the driver with the filter and start it.
+  bool start_driver_(const can_filter_config_t &filter);
+  /// Update the statistics and recover from bus off.
+  void check_status_();
+
+  uint8_t rx_{0};
+  uint8_t tx_{0};
+  uint32_t rx_queue_len_{32};
+  uint32_t rx_missed_{0};
+  uint32_t bus_errors_{0};
+  uint32_t tx_failed_{0};
+};
+
+}  // namespace esp32_can
+}  // namespace esphome
+
+#endif
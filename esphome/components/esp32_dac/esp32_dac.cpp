@@ -5,12 +5,20 @@
 #ifdef ARDUINO_ARCH_ESP32
 
 #include <esp32-hal-dac.h>
+#include <driver/i2s.h>
 
 namespace esphome {
 namespace esp32_dac {
 
 static const char *TAG = "esp32_dac";
 
+/// Only I2S0 has the built-in DAC mode.
+static const i2s_port_t DAC_I2S_PORT = I2S_NUM_0;
+static const int DAC_DMA_BUFFER_COUNT = 8;
+static const int DAC_DMA_BUFFER_LENGTH = 256;
+/// Frames are rendered in chunks of this size, each with a 16 bit sample for the left and right channel.
+static const size_t DAC_CHUNK_FRAMES = 64;
+
 void ESP32DAC::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 DAC Output...");
   this->pin_->setup();
@@ -20,6 +28,9 @@ void ESP32DAC::setup() {
 void ESP32DAC::dump_config() {
   ESP_LOGCONFIG(TAG, "ESP32 DAC:");
   LOG_PIN("  Pin: ", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Sample Rate: %u Hz", this->sample_rate_);
+  ESP_LOGCONFIG(TAG, "  Buffered: %.0f ms",
+                DAC_DMA_BUFFER_COUNT * DAC_DMA_BUFFER_LENGTH * 1000.0f / this->sample_rate_);
   LOG_FLOAT_OUTPUT(this);
 }
 
@@ -27,8 +38,150 @@ void ESP32DAC::write_state(float state) {
   if (this->pin_->is_inverted())
     state = 1.0f - state;
 
+  // a static level ends playback
+  this->stop_playback();
   state = state * 255;
-  dacWrite(this->pin_->get_pin(), state);
+  this->value_ = state;
+  dacWrite(this->pin_->get_pin(), this->value_);
+}
+
+bool ESP32DAC::start_i2s_() {
+  if (this->i2s_running_)
+    return true;
+
+  i2s_config_t config = {};
+  config.mode = i2s_mode_t(I2S_MODE_MASTER | I2S_MODE_TX | I2S_MODE_DAC_BUILT_IN);
+  config.sample_rate = this->sample_rate_;
+  config.bits_per_sample = I2S_BITS_PER_SAMPLE_16BIT;
+  config.channel_format = I2S_CHANNEL_FMT_RIGHT_LEFT;
+  config.communication_format = I2S_COMM_FORMAT_I2S_MSB;
+  config.intr_alloc_flags = 0;
+  config.dma_buf_count = DAC_DMA_BUFFER_COUNT;
+  config.dma_buf_len = DAC_DMA_BUFFER_LENGTH;
+  config.use_apll = false;
+
+  esp_err_t err = i2s_driver_install(DAC_I2S_PORT, &config, 0, nullptr);
+  if (err != ESP_OK) {
+    ESP_LOGE(TAG, "Installing the I2S driver failed: %d", err);
+    return false;
+  }
+  // GPIO25 is the right and GPIO26 the left channel
+  i2s_set_dac_mode(this->pin_->get_pin() == 25 ? I2S_DAC_CHANNEL_RIGHT_EN : I2S_DAC_CHANNEL_LEFT_EN);
+  if (!this->chunk_)
+    this->chunk_.reset(new uint16_t[2 * DAC_CHUNK_FRAMES]);
+  this->i2s_running_ = true;
+  return true;
+}
+
+void ESP32DAC::play_samples(const uint8_t *samples, size_t length) {
+  if (!this->start_i2s_())
+    return;
+  this->samples_ = samples;
+  this->samples_length_ = length;
+  this->samples_pos_ = 0;
+  this->source_ = SOURCE_SAMPLES;
+  this->chunk_pos_ = this->chunk_size_ = 0;
+}
+
+void ESP32DAC::play_tones(std::vector<Tone> tones, float volume) {
+  if (!this->start_i2s_())
+    return;
+  this->tones_ = std::move(tones);
+  this->tone_index_ = 0;
+  this->high_ = clamp(volume, 0.0f, 1.0f) * 255;
+  this->source_ = SOURCE_TONES;
+  this->chunk_pos_ = this->chunk_size_ = 0;
+  this->start_tone_();
+}
+
+void ESP32DAC::start_tone_() {
+  if (this->tone_index_ == this->tones_.size()) {
+    this->tones_.clear();
+    this->source_ = SOURCE_FLUSH;
+    this->flush_left_ = DAC_DMA_BUFFER_COUNT * DAC_DMA_BUFFER_LENGTH;
+    return;
+  }
+  const Tone &tone = this->tones_[this->tone_index_++];
+  this->tone_samples_left_ = uint32_t(tone.duration) * this->sample_rate_ / 1000;
+  // the phase wraps at 2^32 once per period
+  this->phase_step_ = (uint64_t(tone.frequency) << 32) / this->sample_rate_;
+  this->phase_ = 0;
+}
+
+void ESP32DAC::stop_playback() {
+  if (!this->i2s_running_)
+    return;
+  this->source_ = SOURCE_NONE;
+  this->tones_.clear();
+  i2s_driver_uninstall(DAC_I2S_PORT);
+  this->i2s_running_ = false;
+  dacWrite(this->pin_->get_pin(), this->value_);
+}
+
+uint8_t ESP32DAC::next_sample_() {
+  switch (this->source_) {
+    case SOURCE_SAMPLES:
+      if (this->samples_pos_ < this->samples_length_)
+        return this->samples_[this->samples_pos_++];
+      this->source_ = SOURCE_FLUSH;
+      this->flush_left_ = DAC_DMA_BUFFER_COUNT * DAC_DMA_BUFFER_LENGTH;
+      return 0;
+    case SOURCE_TONES: {
+      while (this->tone_samples_left_ == 0) {
+        this->start_tone_();
+        if (this->source_ != SOURCE_TONES)
+          return 0;
+      }
+      this->tone_samples_left_--;
+      const bool high = this->phase_step_ != 0 && this->phase_ < 0x80000000UL;
+      this->phase_ += this->phase_step_;
+      return high ? this->high_ : 0;
+    }
+    case SOURCE_FLUSH:
+      if (this->flush_left_ != 0)
+        this->flush_left_--;
+      return 0;
+    default:
+      return 0;
+  }
+}
+
+size_t ESP32DAC::render_(uint16_t *frames, size_t count) {
+  size_t i = 0;
+  for (; i < count; i++) {
+    if (this->source_ == SOURCE_FLUSH && this->flush_left_ == 0)
+      break;
+    // the DAC takes the upper 8 bits of each sample
+    const uint16_t sample = uint16_t(this->next_sample_()) << 8;
+    frames[2 * i] = sample;
+    frames[2 * i + 1] = sample;
+  }
+  return i;
+}
+
+void ESP32DAC::loop() {
+  if (!this->is_playing())
+    return;
+
+  while (true) {
+    if (this->chunk_pos_ == this->chunk_size_) {
+      const size_t frames = this->render_(this->chunk_.get(), DAC_CHUNK_FRAMES);
+      if (frames == 0) {
+        // the DMA buffers only contain silence, everything has been played
+        this->stop_playback();
+        return;
+      }
+      this->chunk_pos_ = 0;
+      this->chunk_size_ = frames * 2 * sizeof(uint16_t);
+    }
+    size_t written = 0;
+    // never block, only fill the DMA buffers that have been played
+    i2s_write(DAC_I2S_PORT, reinterpret_cast<uint8_t *>(this->chunk_.get()) + this->chunk_pos_,
+              this->chunk_size_ - this->chunk_pos_, &written, 0);
+    this->chunk_pos_ += written;
+    if (this->chunk_pos_ != this->chunk_size_)
+      return;
+  }
 }
 
 }  // namespace esp32_dac
@@ -10,20 +10,80 @@
 namespace esphome {
 namespace esp32_dac {
 
+struct Tone {
+  /// The frequency in Hz, 0 for silence.
+  uint16_t frequency;
+  /// The duration in ms.
+  uint16_t duration;
+};
+
+/** An output of the built-in DAC, either a static level or waveforms played with I2S DMA.
+ *
+ * For waveforms the I2S peripheral runs in built-in DAC mode: the DMA feeds the DAC from a ring of buffers at the
+ * sample rate, loop() only renders the next samples into the free buffers. The buffers hold more than a loop
+ * interval, so the timing doesn't depend on the loop and busy Wi-Fi doesn't cause glitches. While playing the DAC
+ * occupies I2S0, so only one DAC can play at a time and not together with the esp32_adc_sampler.
+ */
 class ESP32DAC : public output::FloatOutput, public Component {
  public:
   void set_pin(GPIOPin *pin) { pin_ = pin; }
+  void set_sample_rate(uint32_t sample_rate) { sample_rate_ = sample_rate; }
 
   /// Initialize pin
   void setup() override;
   void dump_config() override;
+  void loop() override;
+  bool is_loop_idle() override { return !this->is_playing(); }
   /// HARDWARE setup_priority
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
+  /// Play 8 bit unsigned samples at the sample rate, they aren't copied and must stay valid while playing.
+  void play_samples(const uint8_t *samples, size_t length);
+  /// Play square wave tones one after the other, volume is the level of the high half of the wave.
+  void play_tones(std::vector<Tone> tones, float volume = 1.0f);
+  /// Stop playing and return to the static level.
+  void stop_playback();
+  bool is_playing() const { return this->source_ != SOURCE_NONE; }
+
  protected:
+  enum Source : uint8_t {
+    SOURCE_NONE = 0,
+    SOURCE_SAMPLES,
+    SOURCE_TONES,
+    /// Silence until the DMA buffers contain nothing else, then playback stops.
+    SOURCE_FLUSH,
+  };
+
   void write_state(float state) override;
+  bool start_i2s_();
+  void start_tone_();
+  /// Render up to count frames of the current source, returns how many it rendered.
+  size_t render_(uint16_t *frames, size_t count);
+  /// The next sample of the current source, switches to the next source once it has ended.
+  uint8_t next_sample_();
 
   GPIOPin *pin_;
+  uint32_t sample_rate_{16000};
+  /// The static level, the DAC returns to it after playing.
+  uint8_t value_{0};
+  bool i2s_running_{false};
+
+  Source source_{SOURCE_NONE};
+  const uint8_t *samples_{nullptr};
+  size_t samples_length_{0};
+  size_t samples_pos_{0};
+  std::vector<Tone> tones_;
+  size_t tone_index_{0};
+  uint32_t tone_samples_left_{0};
+  uint32_t phase_{0};
+  uint32_t phase_step_{0};
+  uint8_t high_{255};
+  uint32_t flush_left_{0};
+
+  /// Rendered frames that didn't fit into the DMA buffers yet, left and right 16 bit samples.
+  std::unique_ptr<uint16_t[]> chunk_;
+  size_t chunk_pos_{0};
+  size_t chunk_size_{0};
 };
 
 }  // namespace esp32_dac
@@ -6,6 +6,8 @@ from esphome.const import CONF_ID, CONF_NUMBER, CONF_PIN, ESP_PLATFORM_ESP32
 
 ESP_PLATFORMS = [ESP_PLATFORM_ESP32]
 
+CONF_SAMPLE_RATE = 'sample_rate'
+
 
 def valid_dac_pin(value):
     num = value[CONF_NUMBER]
@@ -19,6 +21,7 @@ ESP32DAC = esp32_dac_ns.class_('ESP32DAC', output.FloatOutput, cg.Component)
 CONFIG_SCHEMA = output.FLOAT_OUTPUT_SCHEMA.extend({
     cv.Required(CONF_ID): cv.declare_id(ESP32DAC),
     cv.Required(CONF_PIN): cv.All(pins.internal_gpio_output_pin_schema, valid_dac_pin),
+    cv.Optional(CONF_SAMPLE_RATE, default='16kHz'): cv.All(cv.frequency, cv.Range(min=8000, max=48000)),
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -29,3 +32,5 @@ def to_code(config):
 
     pin = yield cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+    cg.add(var.set_sample_rate(int(config[CONF_SAMPLE_RATE])))
+    cg.add_define('USE_ESP32_DAC')
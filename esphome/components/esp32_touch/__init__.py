@@ -8,6 +8,9 @@ from esphome.core import TimePeriod
 AUTO_LOAD = ['binary_sensor']
 ESP_PLATFORMS = [ESP_PLATFORM_ESP32]
 
+CONF_INTERRUPT = 'interrupt'
+CONF_BASELINE_TRACKING = 'baseline_tracking'
+
 esp32_touch_ns = cg.esphome_ns.namespace('esp32_touch')
 ESP32TouchComponent = esp32_touch_ns.class_('ESP32TouchComponent', cg.Component)
 
@@ -56,6 +59,8 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_HIGH_VOLTAGE_REFERENCE, default='2.7V'):
         validate_voltage(HIGH_VOLTAGE_REFERENCE),
     cv.Optional(CONF_VOLTAGE_ATTENUATION, default='0V'): validate_voltage(VOLTAGE_ATTENUATION),
+    cv.Optional(CONF_INTERRUPT, default=False): cv.boolean,
+    cv.Optional(CONF_BASELINE_TRACKING, default=False): cv.boolean,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -78,3 +83,5 @@ def to_code(config):
     cg.add(touch.set_high_voltage_reference(
         HIGH_VOLTAGE_REFERENCE[config[CONF_HIGH_VOLTAGE_REFERENCE]]))
     cg.add(touch.set_voltage_attenuation(VOLTAGE_ATTENUATION[config[CONF_VOLTAGE_ATTENUATION]]))
+    cg.add(touch.set_use_interrupt(config[CONF_INTERRUPT]))
+    cg.add(touch.set_baseline_tracking(config[CONF_BASELINE_TRACKING]))
@@ -1,5 +1,8 @@
 #include "esp32_touch.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
+#include <algorithm>
+#include <cmath>
 
 #ifdef ARDUINO_ARCH_ESP32
 
@@ -8,6 +11,22 @@ namespace esp32_touch {
 
 static const char *TAG = "esp32_touch";
 
+/// How often the baselines are updated, in ms.
+static const uint32_t BASELINE_INTERVAL = 1000;
+/// The baseline moves 1/BASELINE_FILTER of the way to the current value every update, about a minute to follow a
+/// change in humidity or temperature, while a touch is much faster.
+static const float BASELINE_FILTER = 64.0f;
+
+void ESP32TouchStore::touch_intr(void *arg) {
+  auto *store = reinterpret_cast<ESP32TouchStore *>(arg);
+  const uint32_t status = touch_pad_get_status();
+  touch_pad_clear_status();
+  portENTER_CRITICAL_ISR(&store->mux);
+  store->status |= status;
+  portEXIT_CRITICAL_ISR(&store->mux);
+  Application::wake_loop_isr();
+}
+
 void ESP32TouchComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 Touch Hub...");
   touch_pad_init();
@@ -19,10 +38,26 @@ void ESP32TouchComponent::setup() {
   touch_pad_set_meas_time(this->sleep_cycle_, this->meas_cycle_);
   touch_pad_set_voltage(this->high_voltage_reference_, this->low_voltage_reference_, this->voltage_attenuation_);
 
-  for (auto *child : this->children_) {
-    // Disable interrupt threshold
-    touch_pad_config(child->get_touch_pad(), 0);
+  if (!this->use_interrupt_) {
+    for (auto *child : this->children_) {
+      // Disable interrupt threshold
+      touch_pad_config(child->get_touch_pad(), 0);
+    }
+  } else {
+    for (auto *child : this->children_) {
+      touch_pad_config(child->get_touch_pad(), child->get_threshold());
+      child->publish_initial_state(false);
+    }
+    // while touched, the interrupt fires after every measurement, a pad is released when it missed a few of them
+    const uint32_t period = this->sleep_cycle_ / 150 + this->meas_cycle_ / 8000;
+    this->release_timeout_ = std::max<uint32_t>(3 * period, 50);
+    touch_pad_set_trigger_mode(TOUCH_TRIGGER_BELOW);
+    touch_pad_isr_register(ESP32TouchStore::touch_intr, &this->store_);
+    touch_pad_intr_enable();
   }
+
+  if (this->baseline_tracking_)
+    this->set_interval("baseline", BASELINE_INTERVAL, [this]() { this->update_baselines_(); });
 }
 
 void ESP32TouchComponent::dump_config() {
@@ -99,6 +134,12 @@ void ESP32TouchComponent::dump_config() {
   if (this->setup_mode_) {
     ESP_LOGCONFIG(TAG, "  Setup Mode ENABLED!");
   }
+  if (this->use_interrupt_) {
+    ESP_LOGCONFIG(TAG, "  Using Interrupt (release after %ums)", this->release_timeout_);
+  }
+  if (this->baseline_tracking_) {
+    ESP_LOGCONFIG(TAG, "  Baseline Tracking ENABLED");
+  }
 
   for (auto *child : this->children_) {
     LOG_BINARY_SENSOR("  ", "Touch Pad", child);
@@ -107,18 +148,79 @@ void ESP32TouchComponent::dump_config() {
   }
 }
 
-void ESP32TouchComponent::loop() {
+uint16_t ESP32TouchComponent::read_pad_(ESP32TouchBinarySensor *child) {
+  uint16_t value;
+  if (this->iir_filter_enabled_()) {
+    touch_pad_read_filtered(child->get_touch_pad(), &value);
+  } else {
+    touch_pad_read(child->get_touch_pad(), &value);
+  }
+  child->value_ = value;
+  return value;
+}
+
+void ESP32TouchComponent::update_baselines_() {
+  for (auto *child : this->children_) {
+    const uint16_t value = this->read_pad_(child);
+    if (value == 0 || value < child->get_threshold())
+      // not measured yet or touched, a touch must not pull the baseline down
+      continue;
+    if (child->baseline_ == 0.0f) {
+      child->baseline_ = value;
+      child->threshold_ratio_ = child->get_threshold() / child->baseline_;
+      continue;
+    }
+    child->baseline_ += (value - child->baseline_) / BASELINE_FILTER;
+    const auto threshold = static_cast<uint16_t>(roundf(child->baseline_ * child->threshold_ratio_));
+    if (threshold == child->get_threshold())
+      continue;
+    child->set_threshold(threshold);
+    if (this->use_interrupt_)
+      touch_pad_set_thresh(child->get_touch_pad(), threshold);
+  }
+}
+
+bool ESP32TouchComponent::is_loop_idle() {
+  if (!this->use_interrupt_ || this->setup_mode_ || this->store_.status != 0)
+    return false;
+  for (auto *child : this->children_) {
+    if (child->touched_)
+      return false;
+  }
+  return true;
+}
+
+void ESP32TouchComponent::loop_interrupt_() {
+  portENTER_CRITICAL(&this->store_.mux);
+  const uint32_t status = this->store_.status;
+  this->store_.status = 0;
+  portEXIT_CRITICAL(&this->store_.mux);
+
   const uint32_t now = millis();
-  bool should_print = this->setup_mode_ && now - this->setup_mode_last_log_print_ > 250;
   for (auto *child : this->children_) {
-    uint16_t value;
-    if (this->iir_filter_enabled_()) {
-      touch_pad_read_filtered(child->get_touch_pad(), &value);
-    } else {
-      touch_pad_read(child->get_touch_pad(), &value);
+    if (status & (1 << child->get_touch_pad())) {
+      child->last_touch_ = now;
+      if (!child->touched_) {
+        child->touched_ = true;
+        child->publish_state(true);
+      }
+    } else if (child->touched_ && now - child->last_touch_ > this->release_timeout_) {
+      child->touched_ = false;
+      child->publish_state(false);
     }
+  }
+}
+
+void ESP32TouchComponent::loop() {
+  if (this->use_interrupt_ && !this->setup_mode_) {
+    this->loop_interrupt_();
+    return;
+  }
 
-    child->value_ = value;
+  const uint32_t now = millis();
+  bool should_print = this->setup_mode_ && now - this->setup_mode_last_log_print_ > 250;
+  for (auto *child : this->children_) {
+    const uint16_t value = this->read_pad_(child);
     child->publish_state(value < child->get_threshold());
 
     if (should_print) {
@@ -133,6 +235,8 @@ void ESP32TouchComponent::loop() {
 }
 
 void ESP32TouchComponent::on_shutdown() {
+  if (this->use_interrupt_)
+    touch_pad_intr_disable();
   if (this->iir_filter_enabled_()) {
     touch_pad_filter_stop();
     touch_pad_filter_delete();
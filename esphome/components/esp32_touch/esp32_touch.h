@@ -10,6 +10,14 @@ namespace esp32_touch {
 
 class ESP32TouchBinarySensor;
 
+/// The pads that were below their threshold since the main loop last looked, set by the touch interrupt.
+struct ESP32TouchStore {
+  volatile uint32_t status{0};
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+  static void touch_intr(void *arg);
+};
+
 class ESP32TouchComponent : public Component {
  public:
   void register_touch_pad(ESP32TouchBinarySensor *pad) { children_.push_back(pad); }
@@ -32,14 +40,26 @@ class ESP32TouchComponent : public Component {
 
   void set_voltage_attenuation(touch_volt_atten_t voltage_attenuation) { voltage_attenuation_ = voltage_attenuation; }
 
+  /// Let the touch threshold interrupt report touched pads instead of reading all pads every loop.
+  void set_use_interrupt(bool use_interrupt) { use_interrupt_ = use_interrupt; }
+
+  /// Follow slow changes of the untouched pad values and move the thresholds with them.
+  void set_baseline_tracking(bool baseline_tracking) { baseline_tracking_ = baseline_tracking; }
+
   void setup() override;
   void dump_config() override;
   void loop() override;
+  bool is_loop_idle() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void on_shutdown() override;
 
  protected:
+  void loop_interrupt_();
+  uint16_t read_pad_(ESP32TouchBinarySensor *child);
+  /// Move the baselines of the untouched pads towards their current values and update the thresholds.
+  void update_baselines_();
+
   /// Is the IIR filter enabled?
   bool iir_filter_enabled_() const { return iir_filter_ > 0; }
 
@@ -52,6 +72,11 @@ class ESP32TouchComponent : public Component {
   bool setup_mode_{false};
   uint32_t setup_mode_last_log_print_{};
   uint32_t iir_filter_{0};
+  bool use_interrupt_{false};
+  bool baseline_tracking_{false};
+  /// A pad is released when the interrupt didn't report it for this long, in ms.
+  uint32_t release_timeout_{0};
+  ESP32TouchStore store_{};
 };
 
 /// Simple helper class to expose a touch pad value as a binary sensor.
@@ -70,6 +95,11 @@ class ESP32TouchBinarySensor : public binary_sensor::BinarySensor {
   touch_pad_t touch_pad_;
   uint16_t threshold_;
   uint16_t value_;
+  /// The slowly filtered value while untouched, and the configured threshold relative to its first value.
+  float baseline_{0.0f};
+  float threshold_ratio_{0.0f};
+  bool touched_{false};
+  uint32_t last_touch_{0};
 };
 
 }  // namespace esp32_touch
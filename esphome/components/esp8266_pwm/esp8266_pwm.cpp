@@ -1,4 +1,5 @@
 #include "esp8266_pwm.h"
+#include "soft_pwm.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
@@ -16,17 +17,34 @@ static const char *TAG = "esp8266_pwm";
 void ESP8266PWM::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP8266 PWM Output...");
   this->pin_->setup();
+  if (this->soft_pwm_) {
+    this->channel_ = SoftPWM::add_channel(this->pin_->get_pin(), this->pin_->is_inverted());
+    if (this->channel_ < 0)
+      ESP_LOGE(TAG, "All %u soft PWM channels are in use, using a waveform instead", SOFT_PWM_MAX_CHANNELS);
+  }
   this->turn_off();
 }
 void ESP8266PWM::dump_config() {
   ESP_LOGCONFIG(TAG, "ESP8266 PWM:");
   LOG_PIN("  Pin: ", this->pin_);
   ESP_LOGCONFIG(TAG, "  Frequency: %.1f Hz", this->frequency_);
+  if (this->channel_ >= 0) {
+    ESP_LOGCONFIG(TAG, "  Soft PWM channel: %d", this->channel_);
+    if (SoftPWM::get_frequency() != this->frequency_)
+      ESP_LOGW(TAG, "  Soft PWM outputs share one frequency, using %.1f Hz", SoftPWM::get_frequency());
+  }
   LOG_FLOAT_OUTPUT(this);
 }
 void HOT ESP8266PWM::write_state(float state) {
   this->last_output_ = state;
 
+  if (this->channel_ >= 0) {
+    // SoftPWM handles the inversion itself
+    SoftPWM::set_frequency(this->frequency_);
+    SoftPWM::set_duty(this->channel_, state);
+    return;
+  }
+
   // Also check pin inversion
   if (this->pin_->is_inverted()) {
     state = 1.0f - state;
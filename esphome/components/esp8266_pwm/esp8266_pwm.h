@@ -12,6 +12,9 @@ class ESP8266PWM : public output::FloatOutput, public Component {
  public:
   void set_pin(GPIOPin *pin) { pin_ = pin; }
   void set_frequency(float frequency) { this->frequency_ = frequency; }
+  /// Drive the pin from the shared SoftPWM engine instead of its own waveform. All soft PWM outputs share one
+  /// frequency, the one set last.
+  void set_soft_pwm(bool soft_pwm) { this->soft_pwm_ = soft_pwm; }
   /// Dynamically update frequency
   void update_frequency(float frequency) override {
     this->set_frequency(frequency);
@@ -29,6 +32,9 @@ class ESP8266PWM : public output::FloatOutput, public Component {
 
   GPIOPin *pin_;
   float frequency_{1000.0};
+  bool soft_pwm_{false};
+  /// The SoftPWM channel, -1 if not used.
+  int8_t channel_{-1};
   /// Cache last output level for dynamic frequency updating
   float last_output_{0.0};
 };
@@ -2,7 +2,9 @@ from esphome import pins, automation
 from esphome.components import output
 import esphome.config_validation as cv
 import esphome.codegen as cg
-from esphome.const import CONF_FREQUENCY, CONF_ID, CONF_NUMBER, CONF_PIN, ESP_PLATFORM_ESP8266
+from esphome.const import CONF_FREQUENCY, CONF_ID, CONF_NUMBER, CONF_PIN, CONF_PLATFORM, \
+    ESP_PLATFORM_ESP8266
+from esphome.core import CORE, EsphomeError
 
 ESP_PLATFORMS = [ESP_PLATFORM_ESP8266]
 
@@ -13,16 +15,26 @@ def valid_pwm_pin(value):
     return value
 
 
+CONF_SOFT_PWM = 'soft_pwm'
+
+
+def validate_soft_pwm(config):
+    if config[CONF_SOFT_PWM] and config[CONF_PIN][CONF_NUMBER] == 16:
+        raise cv.Invalid("GPIO16 can't be used with soft_pwm")
+    return config
+
+
 esp8266_pwm_ns = cg.esphome_ns.namespace('esp8266_pwm')
 ESP8266PWM = esp8266_pwm_ns.class_('ESP8266PWM', output.FloatOutput, cg.Component)
 SetFrequencyAction = esp8266_pwm_ns.class_('SetFrequencyAction', automation.Action)
 validate_frequency = cv.All(cv.frequency, cv.Range(min=1.0e-6))
 
-CONFIG_SCHEMA = output.FLOAT_OUTPUT_SCHEMA.extend({
+CONFIG_SCHEMA = cv.All(output.FLOAT_OUTPUT_SCHEMA.extend({
     cv.Required(CONF_ID): cv.declare_id(ESP8266PWM),
     cv.Required(CONF_PIN): cv.All(pins.internal_gpio_output_pin_schema, valid_pwm_pin),
     cv.Optional(CONF_FREQUENCY, default='1kHz'): validate_frequency,
-}).extend(cv.COMPONENT_SCHEMA)
+    cv.Optional(CONF_SOFT_PWM, default=False): cv.boolean,
+}).extend(cv.COMPONENT_SCHEMA), validate_soft_pwm)
 
 
 def to_code(config):
@@ -34,6 +46,11 @@ def to_code(config):
     cg.add(var.set_pin(pin))
 
     cg.add(var.set_frequency(config[CONF_FREQUENCY]))
+    if config[CONF_SOFT_PWM]:
+        if any(conf[CONF_PLATFORM] == 'ac_dimmer' for conf in CORE.config.get('output', [])):
+            raise EsphomeError("soft_pwm and the AC dimmer both use the timer1 callback and can't "
+                               "be used together")
+        cg.add(var.set_soft_pwm(True))
 
 
 @automation.register_action('output.esp8266_pwm.set_frequency', SetFrequencyAction, cv.Schema({
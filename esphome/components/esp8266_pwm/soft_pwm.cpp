@@ -0,0 +1,148 @@
+#include "soft_pwm.h"
+#include "esphome/core/helpers.h"
+
+#ifdef ARDUINO_ARCH_ESP8266
+
+#include <core_esp8266_waveform.h>
+
+namespace esphome {
+namespace esp8266_pwm {
+
+/// Edges closer than this are waited for in the interrupt instead of scheduling another one, in µs.
+static const uint32_t SOFT_PWM_BUSY_WAIT_US = 4;
+
+struct SoftPWMChannel {
+  uint16_t mask;
+  bool inverted;
+  /// The duty cycle in CPU cycles of the period.
+  uint32_t duty;
+};
+
+static SoftPWMChannel soft_pwm_channels[SOFT_PWM_MAX_CHANNELS];  // NOLINT
+static uint8_t soft_pwm_channel_count = 0;                        // NOLINT
+static SoftPWMTable soft_pwm_tables[2];                           // NOLINT
+/// The table used by the interrupt, only changed by the interrupt.
+static volatile uint8_t soft_pwm_active = 0;  // NOLINT
+/// Set by the main loop once the other table is complete, cleared while it is written.
+static volatile bool soft_pwm_pending = false;  // NOLINT
+static uint32_t soft_pwm_period_start = 0;      // NOLINT
+static uint8_t soft_pwm_edge = 0;               // NOLINT
+
+float SoftPWM::frequency_ = 1000.0f;  // NOLINT
+
+uint32_t ICACHE_RAM_ATTR HOT SoftPWM::timer_callback_() {
+  const SoftPWMTable *table = &soft_pwm_tables[soft_pwm_active];
+  while (true) {
+    if (soft_pwm_edge == table->count) {
+      // start of the next period, the only time a new table is used
+      soft_pwm_period_start += table->period;
+      soft_pwm_edge = 0;
+      if (soft_pwm_pending) {
+        soft_pwm_active ^= 1;
+        soft_pwm_pending = false;
+        table = &soft_pwm_tables[soft_pwm_active];
+      }
+    }
+
+    const SoftPWMEdge &edge = table->edges[soft_pwm_edge];
+    const uint32_t at = soft_pwm_period_start + edge.time;
+    const auto wait = int32_t(at - ESP.getCycleCount());
+    if (wait > int32_t(SOFT_PWM_BUSY_WAIT_US * clockCyclesPerMicrosecond()))
+      return wait / clockCyclesPerMicrosecond() - SOFT_PWM_BUSY_WAIT_US / 2;
+    if (wait < -int32_t(table->period)) {
+      // fell behind by more than a period (flash writes disable the interrupt), start over from now
+      soft_pwm_period_start = ESP.getCycleCount() - edge.time;
+    } else {
+      while (int32_t(at - ESP.getCycleCount()) > 0) {
+      }
+    }
+    GPOS = edge.set;
+    GPOC = edge.clear;
+    soft_pwm_edge++;
+  }
+}
+
+int8_t SoftPWM::add_channel(uint8_t pin, bool inverted) {
+  if (soft_pwm_channel_count == SOFT_PWM_MAX_CHANNELS || pin > 15)
+    return -1;
+  const int8_t channel = soft_pwm_channel_count;
+  soft_pwm_channels[channel].mask = 1 << pin;
+  soft_pwm_channels[channel].inverted = inverted;
+  soft_pwm_channels[channel].duty = 0;
+  soft_pwm_channel_count++;
+  build_table_();
+  if (channel == 0) {
+    // the table was built into the inactive table, make it the active one before the interrupt starts
+    soft_pwm_active ^= 1;
+    soft_pwm_pending = false;
+    soft_pwm_period_start = ESP.getCycleCount();
+    setTimer1Callback(&SoftPWM::timer_callback_);
+  }
+  return channel;
+}
+
+void SoftPWM::set_frequency(float frequency) {
+  if (frequency == frequency_)
+    return;
+  const uint32_t old_period = soft_pwm_tables[soft_pwm_active].period;
+  frequency_ = frequency;
+  // keep the duty cycles when the period changes
+  const uint32_t new_period = F_CPU / frequency_;
+  for (uint8_t i = 0; i < soft_pwm_channel_count; i++) {
+    if (old_period != 0)
+      soft_pwm_channels[i].duty = uint64_t(soft_pwm_channels[i].duty) * new_period / old_period;
+  }
+  build_table_();
+}
+
+void SoftPWM::set_duty(int8_t channel, float duty) {
+  const auto period = static_cast<uint32_t>(F_CPU / frequency_);
+  soft_pwm_channels[channel].duty = static_cast<uint32_t>(roundf(clamp(duty, 0.0f, 1.0f) * period));
+  build_table_();
+}
+
+void SoftPWM::build_table_() {
+  // the interrupt doesn't switch tables while pending is cleared, so the inactive table can be written
+  soft_pwm_pending = false;
+  SoftPWMTable &table = soft_pwm_tables[soft_pwm_active ^ 1];
+  table.period = F_CPU / frequency_;
+  table.count = 1;
+  table.edges[0] = {0, 0, 0};
+
+  auto add_edge = [&table](uint32_t time, uint16_t set, uint16_t clear) {
+    uint8_t i = 0;
+    while (i < table.count && table.edges[i].time < time)
+      i++;
+    if (i < table.count && table.edges[i].time == time) {
+      table.edges[i].set |= set;
+      table.edges[i].clear |= clear;
+      return;
+    }
+    for (uint8_t j = table.count; j > i; j--)
+      table.edges[j] = table.edges[j - 1];
+    table.edges[i] = {time, set, clear};
+    table.count++;
+  };
+
+  for (uint8_t i = 0; i < soft_pwm_channel_count; i++) {
+    const SoftPWMChannel &channel = soft_pwm_channels[i];
+    const uint16_t on_set = channel.inverted ? 0 : channel.mask;
+    const uint16_t on_clear = channel.inverted ? channel.mask : 0;
+    if (channel.duty == 0) {
+      add_edge(0, on_clear, on_set);
+    } else if (channel.duty >= table.period) {
+      add_edge(0, on_set, on_clear);
+    } else {
+      // spread the rising edges of the channels over the period
+      const uint32_t on = table.period / soft_pwm_channel_count * i;
+      add_edge(on, on_set, on_clear);
+      add_edge((on + channel.duty) % table.period, on_clear, on_set);
+    }
+  }
+  soft_pwm_pending = true;
+}
+
+}  // namespace esp8266_pwm
+}  // namespace esphome
+
+#endif
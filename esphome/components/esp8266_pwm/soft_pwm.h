@@ -0,0 +1,56 @@
+#pragma once
+
+#include "esphome/core/esphal.h"
+
+#ifdef ARDUINO_ARCH_ESP8266
+
+namespace esphome {
+namespace esp8266_pwm {
+
+static const uint8_t SOFT_PWM_MAX_CHANNELS = 8;
+
+/// The GPIOs to set and clear at a time of the period.
+struct SoftPWMEdge {
+  /// CPU cycles since the start of the period.
+  uint32_t time;
+  uint16_t set;
+  uint16_t clear;
+};
+
+/// The edges of all channels in one period, sorted by time. The first edge is always at time 0.
+struct SoftPWMTable {
+  uint32_t period;
+  uint8_t count;
+  SoftPWMEdge edges[2 * SOFT_PWM_MAX_CHANNELS + 1];
+};
+
+/** A software PWM driving all its channels from the timer1 interrupt of the ESP8266 waveform generator.
+ *
+ * All channels share one frequency. Their pulses start at evenly spread phases, so that they don't all switch at
+ * the same time, and their edges are timed in CPU cycles instead of µs. The main loop computes a table of the edges
+ * of a period and the interrupt only walks through it, a new table is swapped in at the start of a period, so a new
+ * duty cycle never produces a shortened or doubled pulse.
+ *
+ * Uses setTimer1Callback(), so it can't be used together with the AC dimmer.
+ */
+class SoftPWM {
+ public:
+  /// Add a channel for the pin (GPIO0-15), returns -1 if all channels are in use.
+  static int8_t add_channel(uint8_t pin, bool inverted);
+  static void set_frequency(float frequency);
+  static float get_frequency() { return frequency_; }
+  /// Set the duty cycle (0.0-1.0) of the channel, it is applied at the start of the next period.
+  static void set_duty(int8_t channel, float duty);
+
+ protected:
+  static uint32_t timer_callback_();
+  /// Compute the edges for the current duty cycles into the table that isn't used by the interrupt.
+  static void build_table_();
+
+  static float frequency_;  // NOLINT
+};
+
+}  // namespace esp8266_pwm
+}  // namespace esphome
+
+#endif
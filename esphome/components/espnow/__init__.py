@@ -0,0 +1,38 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_CHANNEL, CONF_GATEWAY, CONF_ID, CONF_SENSORS
+
+AUTO_LOAD = ['sensor']
+
+espnow_ns = cg.esphome_ns.namespace('espnow')
+ESPNowComponent = espnow_ns.class_('ESPNowComponent', cg.Component)
+
+CONF_ESPNOW_ID = 'espnow_id'
+
+
+def validate_gateway(config):
+    if config[CONF_SENSORS] and CONF_GATEWAY not in config:
+        raise cv.Invalid("A gateway is required to send sensor states to", path=[CONF_GATEWAY])
+    return config
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
+    cv.GenerateID(): cv.declare_id(ESPNowComponent),
+    # only used without a wifi component, which uses the channel of its network
+    cv.Optional(CONF_CHANNEL, default=1): cv.int_range(min=1, max=14),
+    cv.Optional(CONF_GATEWAY): cv.mac_address,
+    cv.Optional(CONF_SENSORS, default=[]): cv.ensure_list(cv.use_id(sensor.Sensor)),
+}).extend(cv.COMPONENT_SCHEMA), validate_gateway)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_channel(config[CONF_CHANNEL]))
+    if CONF_GATEWAY in config:
+        cg.add(var.set_gateway(config[CONF_GATEWAY].as_hex))
+    for sensor_id in config[CONF_SENSORS]:
+        sens = yield cg.get_variable(sensor_id)
+        cg.add(var.add_sensor(sens))
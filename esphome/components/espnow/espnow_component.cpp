@@ -0,0 +1,222 @@
+#include "espnow_component.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+#include <ESP8266WiFi.h>
+#include <espnow.h>
+#endif
+
+namespace esphome {
+namespace espnow {
+
+static const char *TAG = "espnow";
+
+static const uint8_t FRAME_MAGIC = 'E';
+static const size_t FRAME_HEADER_SIZE = 2;
+static const size_t FRAME_VALUE_SIZE = 8;
+/// The most values in one frame.
+static const size_t FRAME_MAX_VALUES = (ESPNOW_MAX_PAYLOAD - FRAME_HEADER_SIZE) / FRAME_VALUE_SIZE;
+
+ESPNowComponent *global_espnow = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+#ifdef ARDUINO_ARCH_ESP32
+static void on_receive_cb(const uint8_t *mac, const uint8_t *data, int len) {
+  global_espnow->on_receive(mac, data, len);
+}
+static void on_sent_cb(const uint8_t *mac, esp_now_send_status_t status) {
+  global_espnow->on_sent(status == ESP_NOW_SEND_SUCCESS);
+}
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+static void on_receive_cb(uint8_t *mac, uint8_t *data, uint8_t len) { global_espnow->on_receive(mac, data, len); }
+static void on_sent_cb(uint8_t *mac, uint8_t status) { global_espnow->on_sent(status == 0); }
+#endif
+
+ESPNowComponent::ESPNowComponent() { global_espnow = this; }
+
+void ESPNowComponent::set_gateway(uint64_t mac) {
+  for (int i = 0; i < 6; i++)
+    this->gateway_[i] = (mac >> (40 - i * 8)) & 0xFF;
+  this->has_gateway_ = true;
+}
+
+void ESPNowComponent::add_sensor(sensor::Sensor *sensor) {
+  const uint32_t key = sensor->get_object_id_hash();
+  sensor->add_on_state_callback([this, key](float state) { this->pending_.push_back(Value{key, state}); });
+}
+
+void ESPNowComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up ESP-NOW...");
+  if (!this->init_radio_())
+    this->mark_failed();
+}
+
+bool ESPNowComponent::init_radio_() {
+#ifndef USE_WIFI
+  // without a network, ESP-NOW only needs the radio in station mode on the agreed channel
+  WiFi.persistent(false);
+  WiFi.mode(WIFI_STA);
+#ifdef ARDUINO_ARCH_ESP32
+  esp_wifi_set_channel(this->channel_, WIFI_SECOND_CHAN_NONE);
+#else
+  wifi_set_channel(this->channel_);
+#endif
+#endif
+
+#ifdef ARDUINO_ARCH_ESP32
+  if (esp_now_init() != ESP_OK) {
+    ESP_LOGE(TAG, "Initializing ESP-NOW failed");
+    return false;
+  }
+  esp_now_register_recv_cb(on_receive_cb);
+  esp_now_register_send_cb(on_sent_cb);
+  if (this->has_gateway_) {
+    esp_now_peer_info_t peer{};
+    memcpy(peer.peer_addr, this->gateway_, 6);
+    // the current channel
+    peer.channel = 0;
+    peer.ifidx = WIFI_IF_STA;
+    if (esp_now_add_peer(&peer) != ESP_OK) {
+      ESP_LOGE(TAG, "Adding the gateway failed");
+      return false;
+    }
+  }
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  if (esp_now_init() != 0) {
+    ESP_LOGE(TAG, "Initializing ESP-NOW failed");
+    return false;
+  }
+  esp_now_set_self_role(ESP_NOW_ROLE_COMBO);
+  esp_now_register_recv_cb(on_receive_cb);
+  esp_now_register_send_cb(on_sent_cb);
+  if (this->has_gateway_ && esp_now_add_peer(this->gateway_, ESP_NOW_ROLE_COMBO, 0, nullptr, 0) != 0) {
+    ESP_LOGE(TAG, "Adding the gateway failed");
+    return false;
+  }
+#endif
+  return true;
+}
+
+void ESPNowComponent::loop() {
+  const Frame *frame;
+  while ((frame = this->rx_frames_.front()) != nullptr) {
+    this->handle_frame_(*frame);
+    this->rx_frames_.pop();
+  }
+  const uint32_t dropped = this->rx_dropped_.exchange(0);
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %u frames because the loop fell behind", dropped);
+
+  if (!this->pending_.empty() && !this->sending_)
+    this->send_pending_();
+}
+
+void ESPNowComponent::send_pending_() {
+  if (!this->has_gateway_) {
+    this->pending_.clear();
+    return;
+  }
+
+  uint8_t frame[ESPNOW_MAX_PAYLOAD];
+  const size_t count = std::min(this->pending_.size(), FRAME_MAX_VALUES);
+  frame[0] = FRAME_MAGIC;
+  frame[1] = count;
+  uint8_t *dst = frame + FRAME_HEADER_SIZE;
+  for (size_t i = 0; i < count; i++, dst += FRAME_VALUE_SIZE) {
+    memcpy(dst, &this->pending_[i].key, 4);
+    memcpy(dst + 4, &this->pending_[i].value, 4);
+  }
+  // the rest goes out with the next frame, once this one is sent
+  this->pending_.erase(this->pending_.begin(), this->pending_.begin() + count);
+
+  const size_t len = FRAME_HEADER_SIZE + count * FRAME_VALUE_SIZE;
+  ESP_LOGV(TAG, "Sending %u values", count);
+  this->sending_ = true;
+#ifdef ARDUINO_ARCH_ESP32
+  const bool ok = esp_now_send(this->gateway_, frame, len) == ESP_OK;
+#else
+  const bool ok = esp_now_send(this->gateway_, frame, len) == 0;
+#endif
+  if (!ok) {
+    this->sending_ = false;
+    this->failed_frames_++;
+    ESP_LOGW(TAG, "Sending a frame failed");
+  }
+}
+
+void ESPNowComponent::handle_frame_(const Frame &frame) {
+  if (frame.len < FRAME_HEADER_SIZE || frame.data[0] != FRAME_MAGIC ||
+      frame.len != FRAME_HEADER_SIZE + frame.data[1] * FRAME_VALUE_SIZE) {
+    ESP_LOGV(TAG, "Ignoring a frame of %u bytes", frame.len);
+    return;
+  }
+  uint64_t mac = 0;
+  for (uint8_t byte : frame.mac)
+    mac = (mac << 8) | byte;
+  this->received_frames_++;
+
+  const uint8_t *src = frame.data + FRAME_HEADER_SIZE;
+  for (uint8_t i = 0; i < frame.data[1]; i++, src += FRAME_VALUE_SIZE) {
+    uint32_t key;
+    float value;
+    memcpy(&key, src, 4);
+    memcpy(&value, src + 4, 4);
+    auto it = this->sensors_.find(std::make_pair(mac, key));
+    if (it == this->sensors_.end()) {
+      ESP_LOGV(TAG, "No sensor for key 0x%08X from %02X:%02X:%02X:%02X:%02X:%02X", key, frame.mac[0], frame.mac[1],
+               frame.mac[2], frame.mac[3], frame.mac[4], frame.mac[5]);
+      continue;
+    }
+    it->second->publish_state(value);
+  }
+}
+
+void ESPNowComponent::on_receive(const uint8_t *mac, const uint8_t *data, size_t len) {
+  Frame *frame = this->rx_frames_.slot_to_push();
+  if (frame == nullptr || len > ESPNOW_MAX_PAYLOAD) {
+    this->rx_dropped_++;
+    return;
+  }
+  memcpy(frame->mac, mac, 6);
+  frame->len = len;
+  memcpy(frame->data, data, len);
+  this->rx_frames_.push();
+  App.wake_loop();
+}
+
+void ESPNowComponent::on_sent(bool success) {
+  if (success) {
+    this->sent_frames_++;
+  } else {
+    this->failed_frames_++;
+  }
+  this->sending_ = false;
+  App.wake_loop();
+}
+
+void ESPNowComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP-NOW:");
+#ifndef USE_WIFI
+  ESP_LOGCONFIG(TAG, "  Channel: %u", this->channel_);
+#endif
+  if (this->has_gateway_) {
+    ESP_LOGCONFIG(TAG, "  Gateway: %02X:%02X:%02X:%02X:%02X:%02X", this->gateway_[0], this->gateway_[1],
+                  this->gateway_[2], this->gateway_[3], this->gateway_[4], this->gateway_[5]);
+  }
+  ESP_LOGCONFIG(TAG, "  Received Sensors: %u", this->sensors_.size());
+}
+
+// after Wi-Fi has connected, so that the channel of its network is used
+float ESPNowComponent::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
+
+}  // namespace espnow
+}  // namespace esphome
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/spsc_queue.h"
+#include "esphome/components/sensor/sensor.h"
+#include <atomic>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace esphome {
+namespace espnow {
+
+/// The largest payload of an ESP-NOW frame.
+static const uint8_t ESPNOW_MAX_PAYLOAD = 250;
+/// How many received frames wait for the loop, they are received in the Wi-Fi task.
+static const uint8_t ESPNOW_RX_QUEUE_SIZE = 8;
+
+/** Sends sensor values to a gateway node with ESP-NOW, and publishes the values received from other nodes.
+ *
+ * A node with a gateway sends the states of its sensors without joining a network: no association, DHCP or TCP
+ * connection is needed, a frame is on its way a few ms after the radio is started. All states published in the same
+ * loop iteration are batched into one frame. Each value is keyed by the object id hash of its sensor, the gateway
+ * publishes it to the sensor registered with the MAC address of the sending node and that key, frames of other nodes
+ * are ignored. The gateway stays connected to its network as usual, the other nodes must use the channel of that
+ * network.
+ *
+ * Frame layout: the magic byte 'E', the number of values, then for every value its key (uint32_t) and value (float),
+ * little endian.
+ */
+class ESPNowComponent : public Component {
+ public:
+  ESPNowComponent();
+
+  /// Set the Wi-Fi channel to use, only if there is no Wi-Fi component that picks the channel of its network.
+  void set_channel(uint8_t channel) { this->channel_ = channel; }
+  /// Set the MAC address of the node the sensor states are sent to.
+  void set_gateway(uint64_t mac);
+  /// Send the states of a sensor to the gateway.
+  void add_sensor(sensor::Sensor *sensor);
+  /// Publish the values received from the node with the MAC address and with the key to a sensor.
+  void register_sensor(uint64_t mac, uint32_t key, sensor::Sensor *sensor) {
+    this->sensors_[std::make_pair(mac, key)] = sensor;
+  }
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+  /// Whether all sensor states have been sent, for example before going to deep sleep.
+  bool is_idle() const { return this->pending_.empty() && !this->sending_; }
+  uint32_t get_sent_frames() const { return this->sent_frames_; }
+  uint32_t get_failed_frames() const { return this->failed_frames_; }
+  uint32_t get_received_frames() const { return this->received_frames_; }
+
+  /// Called from the Wi-Fi task.
+  void on_receive(const uint8_t *mac, const uint8_t *data, size_t len);
+  /// Called from the Wi-Fi task.
+  void on_sent(bool success);
+
+ protected:
+  struct Value {
+    uint32_t key;
+    float value;
+  };
+  struct Frame {
+    uint8_t mac[6];
+    uint8_t len;
+    uint8_t data[ESPNOW_MAX_PAYLOAD];
+  };
+
+  bool init_radio_();
+  void send_pending_();
+  void handle_frame_(const Frame &frame);
+
+  uint8_t channel_{1};
+  bool has_gateway_{false};
+  uint8_t gateway_[6]{};
+  std::vector<Value> pending_;
+  /// By the MAC address of the sending node and the key of the value.
+  std::map<std::pair<uint64_t, uint32_t>, sensor::Sensor *> sensors_;
+
+  /// Filled by on_receive() in the Wi-Fi task, emptied by the loop. One slot always stays empty.
+  SPSCQueue<Frame, ESPNOW_RX_QUEUE_SIZE + 1> rx_frames_;
+  std::atomic<uint32_t> rx_dropped_{0};
+  std::atomic<bool> sending_{false};
+  std::atomic<uint32_t> sent_frames_{0};
+  std::atomic<uint32_t> failed_frames_{0};
+  uint32_t received_frames_{0};
+};
+
+extern ESPNowComponent *global_espnow;
+
+}  // namespace espnow
+}  // namespace esphome
@@ -0,0 +1,27 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_MAC_ADDRESS, CONF_NAME, ICON_EMPTY, UNIT_EMPTY
+from esphome.cpp_helpers import entity_object_id, fnv1_hash
+from . import ESPNowComponent, CONF_ESPNOW_ID
+
+DEPENDENCIES = ['espnow']
+
+CONF_REMOTE_NAME = 'remote_name'
+
+CONFIG_SCHEMA = sensor.sensor_schema(UNIT_EMPTY, ICON_EMPTY, 1).extend({
+    cv.GenerateID(): cv.declare_id(sensor.Sensor),
+    cv.GenerateID(CONF_ESPNOW_ID): cv.use_id(ESPNowComponent),
+    # the node that sends the sensor, values of other nodes with the same sensor name are ignored
+    cv.Required(CONF_MAC_ADDRESS): cv.mac_address,
+    # the name of the sensor on the node that sends it, by default the same name
+    cv.Optional(CONF_REMOTE_NAME): cv.string,
+})
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_ESPNOW_ID])
+    var = yield sensor.new_sensor(config)
+
+    remote_name = config.get(CONF_REMOTE_NAME, config[CONF_NAME])
+    cg.add(parent.register_sensor(config[CONF_MAC_ADDRESS].as_hex, fnv1_hash(entity_object_id(remote_name)), var))
@@ -37,6 +37,7 @@ void EthernetComponent::setup() {
 }
 void EthernetComponent::loop() {
   const uint32_t now = millis();
+  network_tick_mdns();
   if (!this->connected_ && !this->last_connected_ && now - this->connect_begin_ > 15000) {
     ESP_LOGW(TAG, "Connecting via ethernet failed! Re-connecting...");
     this->start_connect_();
@@ -59,8 +60,6 @@ void EthernetComponent::loop() {
   }
 
   this->last_connected_ = this->connected_;
-
-  network_tick_mdns();
 }
 void EthernetComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Ethernet:");
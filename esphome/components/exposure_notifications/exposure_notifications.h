@@ -20,6 +20,9 @@ struct ExposureNotification {
 class ExposureNotificationTrigger : public Trigger<ExposureNotification>,
                                     public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    filter.service_data_uuids.push_back(0xFD6F);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
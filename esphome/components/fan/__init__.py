@@ -43,9 +43,11 @@ FAN_SCHEMA = cv.MQTT_COMMAND_COMPONENT_SCHEMA.extend({
 
 @coroutine
 def setup_fan_core_(var, config):
-    cg.add(var.set_name(config[CONF_NAME]))
+    cg.setup_entity_name(var, config[CONF_NAME])
     if CONF_INTERNAL in config:
         cg.add(var.set_internal(config[CONF_INTERNAL]))
+    if not config.get(CONF_INTERNAL, False):
+        cg.add_define('USE_CONTROLLER_FAN')
 
     if CONF_MQTT_ID in config:
         mqtt_ = cg.new_Pvariable(config[CONF_MQTT_ID], var)
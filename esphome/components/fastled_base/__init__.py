@@ -1,7 +1,8 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import light
-from esphome.const import CONF_OUTPUT_ID, CONF_NUM_LEDS, CONF_RGB_ORDER, CONF_MAX_REFRESH_RATE
+from esphome.const import CONF_OUTPUT_ID, CONF_NUM_LEDS, CONF_RGB_ORDER, CONF_MAX_REFRESH_RATE, \
+    CONF_DOUBLE_BUFFERED, CONF_FRAME_RATE, CONF_OUTPUT_GROUP
 from esphome.core import coroutine
 
 CODEOWNERS = ['@OttoWinter']
@@ -23,6 +24,9 @@ BASE_SCHEMA = light.ADDRESSABLE_LIGHT_SCHEMA.extend({
     cv.Required(CONF_NUM_LEDS): cv.positive_not_null_int,
     cv.Optional(CONF_RGB_ORDER): cv.one_of(*RGB_ORDERS, upper=True),
     cv.Optional(CONF_MAX_REFRESH_RATE): cv.positive_time_period_microseconds,
+    cv.Optional(CONF_FRAME_RATE): cv.int_range(min=1, max=1000),
+    cv.Optional(CONF_DOUBLE_BUFFERED): cv.All(cv.only_on_esp32, cv.boolean),
+    cv.Optional(CONF_OUTPUT_GROUP): cv.use_id(light.AddressableOutputGroup),
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -33,6 +37,13 @@ def new_fastled_light(config):
 
     if CONF_MAX_REFRESH_RATE in config:
         cg.add(var.set_max_refresh_rate(config[CONF_MAX_REFRESH_RATE]))
+    if CONF_FRAME_RATE in config:
+        cg.add(var.set_frame_rate(config[CONF_FRAME_RATE]))
+    if CONF_DOUBLE_BUFFERED in config:
+        cg.add(var.set_double_buffered(config[CONF_DOUBLE_BUFFERED]))
+    if CONF_OUTPUT_GROUP in config:
+        group = yield cg.get_variable(config[CONF_OUTPUT_GROUP])
+        cg.add(var.set_output_group(group))
 
     yield light.register_light(var, config)
     # https://github.com/FastLED/FastLED/blob/master/library.json
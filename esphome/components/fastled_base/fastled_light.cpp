@@ -10,15 +10,26 @@ void FastLEDLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up FastLED light...");
   this->controller_->init();
   this->controller_->setLeds(this->leds_, this->num_leds_);
-  this->effect_data_ = new uint8_t[this->num_leds_];
+  this->effect_data_ = alloc_large<uint8_t>(this->num_leds_, this->buffer_location_);
   if (!this->max_refresh_rate_.has_value()) {
     this->set_max_refresh_rate(this->controller_->getMaxRefreshRate());
   }
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->double_buffered_) {
+    this->back_leds_ = alloc_large<CRGB>(this->num_leds_, this->buffer_location_);
+    for (int i = 0; i < this->num_leds_; i++)
+      this->back_leds_[i] = CRGB::Black;
+    this->output_task_.start([this]() { this->controller_->showLeds(); });
+  }
+#endif
 }
 void FastLEDLightOutput::dump_config() {
   ESP_LOGCONFIG(TAG, "FastLED light:");
   ESP_LOGCONFIG(TAG, "  Num LEDs: %u", this->num_leds_);
   ESP_LOGCONFIG(TAG, "  Max refresh rate: %u", *this->max_refresh_rate_);
+#ifdef ARDUINO_ARCH_ESP32
+  ESP_LOGCONFIG(TAG, "  Double buffered: %s", YESNO(this->double_buffered_));
+#endif
 }
 void FastLEDLightOutput::loop() {
   if (!this->should_show_())
@@ -29,9 +40,33 @@ void FastLEDLightOutput::loop() {
   if (*this->max_refresh_rate_ != 0 && (now - this->last_refresh_) < *this->max_refresh_rate_) {
     return;
   }
+  if (!this->frame_pacer_.frame_due(now, this->renders_every_loop_()))
+    return;
+
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->back_leds_ != nullptr) {
+    if (this->output_task_.is_busy()) {
+      // the previous frame is still being sent, try again with the next frame
+      this->frame_pacer_.frame_dropped();
+      return;
+    }
+    this->last_refresh_ = now;
+    this->mark_shown_();
+    memcpy(this->leds_, this->back_leds_, this->num_leds_ * sizeof(CRGB));
+    ESP_LOGVV(TAG, "Sending RGB values to output task...");
+    this->output_task_.send_frame();
+    return;
+  }
+#endif
+
   this->last_refresh_ = now;
   this->mark_shown_();
 
+  if (this->output_group_ != nullptr) {
+    this->output_group_->frame_ready();
+    return;
+  }
+
   ESP_LOGVV(TAG, "Writing RGB values to bus...");
   this->controller_->showLeds();
 }
@@ -26,6 +26,16 @@ class FastLEDLightOutput : public light::AddressableLight {
   /// Set a maximum refresh rate in µs as some lights do not like being updated too often.
   void set_max_refresh_rate(uint32_t interval_us) { this->max_refresh_rate_ = interval_us; }
 
+#ifdef ARDUINO_ARCH_ESP32
+  /// Render into a back buffer and send frames from a separate task, so that the main loop doesn't wait for the LEDs.
+  void set_double_buffered(bool double_buffered) { this->double_buffered_ = double_buffered; }
+#endif
+  /// Send frames together with the other lights of the group instead of on its own.
+  void set_output_group(light::AddressableOutputGroup *output_group) {
+    this->output_group_ = output_group;
+    output_group->add_member([this]() { this->controller_->showLeds(); });
+  }
+
   /// Add some LEDS, can only be called once.
   CLEDController &add_leds(CLEDController *controller, int num_leds) {
     this->controller_ = controller;
@@ -223,17 +233,35 @@ class FastLEDLightOutput : public light::AddressableLight {
   }
 
  protected:
+  /// The LEDs effects render into, the back buffer if double buffered.
+  CRGB *render_leds_() const { return this->back_leds_ != nullptr ? this->back_leds_ : this->leds_; }
+
   light::ESPColorView get_view_internal(int32_t index) const override {
-    return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
-            &this->effect_data_[index], &this->correction_};
+    CRGB *leds = this->render_leds_();
+    return {&leds[index].r, &leds[index].g, &leds[index].b, nullptr, &this->effect_data_[index], &this->correction_};
+  }
+  bool get_raw_pixels_(RawPixels *raw) const override {
+    raw->data = &this->render_leds_()[0].r;
+    raw->stride = sizeof(CRGB);
+    raw->red = offsetof(CRGB, r);
+    raw->green = offsetof(CRGB, g);
+    raw->blue = offsetof(CRGB, b);
+    raw->white = -1;
+    return true;
   }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
+  CRGB *back_leds_{nullptr};
   uint8_t *effect_data_{nullptr};
   int num_leds_{0};
   uint32_t last_refresh_{0};
   optional<uint32_t> max_refresh_rate_{};
+  light::AddressableOutputGroup *output_group_{nullptr};
+#ifdef ARDUINO_ARCH_ESP32
+  bool double_buffered_{false};
+  light::AddressableOutputTask output_task_;
+#endif
 };
 
 }  // namespace fastled_base
@@ -2,7 +2,8 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import fastled_base
-from esphome.const import CONF_CHIPSET, CONF_NUM_LEDS, CONF_PIN, CONF_RGB_ORDER
+from esphome.const import CONF_CHIPSET, CONF_NUM_LEDS, CONF_PIN, CONF_RGB_ORDER, \
+    CONF_DOUBLE_BUFFERED, CONF_OUTPUT_GROUP
 
 AUTO_LOAD = ['fastled_base']
 
@@ -43,7 +44,7 @@ def validate(value):
 CONFIG_SCHEMA = cv.All(fastled_base.BASE_SCHEMA.extend({
     cv.Required(CONF_CHIPSET): cv.one_of(*CHIPSETS, upper=True),
     cv.Required(CONF_PIN): pins.output_pin,
-}), validate)
+}), validate, cv.has_at_most_one_key(CONF_DOUBLE_BUFFERED, CONF_OUTPUT_GROUP))
 
 
 def to_code(config):
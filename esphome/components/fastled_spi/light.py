@@ -3,7 +3,7 @@ import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import fastled_base
 from esphome.const import CONF_CHIPSET, CONF_CLOCK_PIN, CONF_DATA_PIN, CONF_DATA_RATE, \
-        CONF_NUM_LEDS, CONF_RGB_ORDER
+        CONF_NUM_LEDS, CONF_RGB_ORDER, CONF_DOUBLE_BUFFERED, CONF_OUTPUT_GROUP
 
 AUTO_LOAD = ['fastled_base']
 
@@ -18,12 +18,12 @@ CHIPSETS = [
     'DOTSTAR',
 ]
 
-CONFIG_SCHEMA = fastled_base.BASE_SCHEMA.extend({
+CONFIG_SCHEMA = cv.All(fastled_base.BASE_SCHEMA.extend({
     cv.Required(CONF_CHIPSET): cv.one_of(*CHIPSETS, upper=True),
     cv.Required(CONF_DATA_PIN): pins.output_pin,
     cv.Required(CONF_CLOCK_PIN): pins.output_pin,
     cv.Optional(CONF_DATA_RATE): cv.frequency,
-})
+}), cv.has_at_most_one_key(CONF_DOUBLE_BUFFERED, CONF_OUTPUT_GROUP))
 
 
 def to_code(config):
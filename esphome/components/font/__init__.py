@@ -96,14 +96,26 @@ def to_code(config):
         width, height = mask.size
         width8 = ((width + 7) // 8) * 8
         glyph_data = [0 for _ in range(height * width8 // 8)]  # noqa: F812
+        rle_data = []
         for y in range(height):
+            runs = []
             for x in range(width):
                 if not mask.getpixel((x, y)):
                     continue
                 pos = x + y * width8
                 glyph_data[pos // 8] |= 0x80 >> (pos % 8)
-        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
-        data += glyph_data
+                if runs and runs[-1][0] + runs[-1][1] == x:
+                    runs[-1][1] += 1
+                else:
+                    runs.append([x, 1])
+            rle_data.append(len(runs))
+            for start, length in runs:
+                rle_data += [start, length]
+        # Store the runs of set pixels of every row instead of the bitmap when that is not larger,
+        # print() then draws them as spans instead of testing every pixel.
+        rle = width <= 255 and len(rle_data) <= len(glyph_data)
+        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height, rle)
+        data += rle_data if rle else glyph_data
 
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
@@ -1,22 +1,48 @@
 import hashlib
+import logging
 
 from esphome import config_validation as cv, automation
 from esphome import codegen as cg
-from esphome.const import CONF_ID, CONF_INITIAL_VALUE, CONF_RESTORE_VALUE, CONF_TYPE, CONF_VALUE
-from esphome.core import coroutine_with_priority
+from esphome.const import CONF_ID, CONF_INITIAL_VALUE, CONF_RESTORE_VALUE, CONF_SETUP_PRIORITY, \
+    CONF_TYPE, CONF_VALUE
+from esphome.core import coroutine, coroutine_with_priority, CORE, ID
+
+_LOGGER = logging.getLogger(__name__)
 
 CODEOWNERS = ['@esphome/core']
 globals_ns = cg.esphome_ns.namespace('globals')
-GlobalsComponent = globals_ns.class_('GlobalsComponent', cg.Component)
+GlobalsComponent = globals_ns.class_('GlobalsComponent')
+GlobalsStore = globals_ns.class_('GlobalsStore', cg.Component)
 GlobalVarSetAction = globals_ns.class_('GlobalVarSetAction', automation.Action)
 
+
+def setup_priority_unused(value):
+    _LOGGER.warning("Globals aren't components anymore, their 'setup_priority' has no effect. "
+                    "Please remove it from your configuration.")
+    return value
+
+
 MULTI_CONF = True
 CONFIG_SCHEMA = cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(GlobalsComponent),
     cv.Required(CONF_TYPE): cv.string_strict,
     cv.Optional(CONF_INITIAL_VALUE): cv.string_strict,
     cv.Optional(CONF_RESTORE_VALUE, default=False): cv.boolean,
-}).extend(cv.COMPONENT_SCHEMA)
+    # Kept so that configurations from when globals were components still validate
+    cv.Optional(CONF_SETUP_PRIORITY): cv.All(cv.float_, setup_priority_unused),
+})
+
+
+@coroutine
+def globals_store():
+    # one component saves the changes of all globals with restore_value
+    if 'globals_store' in CORE.data:
+        yield CORE.data['globals_store']
+        return
+    store = cg.new_Pvariable(ID('globals_store', is_declaration=True, type=GlobalsStore))
+    CORE.data['globals_store'] = store
+    yield cg.register_component(store, {})
+    yield store
 
 
 # Run with low priority so that namespaces are registered first
@@ -32,14 +58,14 @@ def to_code(config):
 
     rhs = GlobalsComponent.new(template_args, initial_value)
     glob = cg.Pvariable(config[CONF_ID], rhs, res_type)
-    yield cg.register_component(glob, config)
 
     if config[CONF_RESTORE_VALUE]:
         value = config[CONF_ID].id
         if isinstance(value, str):
             value = value.encode()
         hash_ = int(hashlib.md5(value).hexdigest()[:8], 16)
-        cg.add(glob.set_restore_value(hash_))
+        store = yield globals_store()
+        cg.add(glob.set_restore_value(store, hash_))
 
 
 @automation.register_action('globals.set', GlobalVarSetAction, cv.Schema({
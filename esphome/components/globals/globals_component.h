@@ -3,11 +3,47 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
 
 namespace esphome {
 namespace globals {
 
-template<typename T> class GlobalsComponent : public Component {
+/// A global with restore_value, saved by the GlobalsStore when it changed.
+class RestoringGlobal {
+ public:
+  /// Save the value if it differs from the one saved last.
+  virtual void save_if_changed() = 0;
+};
+
+/** Saves the changed globals with restore_value, checking all of them from a single component.
+ *
+ * The values are only compared once a second instead of every loop, so a global changed at a high rate causes at
+ * most one save per second. With the preferences component the saves are further batched into one flash
+ * commit per flash_write_interval.
+ */
+class GlobalsStore : public Component {
+ public:
+  void add(RestoringGlobal *global) { this->globals_.push_back(global); }
+
+  void setup() override {
+    this->set_interval(1000, [this]() { this->save_changed_(); });
+  }
+  void on_shutdown() override {
+    this->save_changed_();
+    global_preferences.sync();
+  }
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+
+ protected:
+  void save_changed_() {
+    for (auto *global : this->globals_)
+      global->save_if_changed();
+  }
+
+  std::vector<RestoringGlobal *> globals_;
+};
+
+template<typename T> class GlobalsComponent : public RestoringGlobal {
  public:
   using value_type = T;
   explicit GlobalsComponent() = default;
@@ -18,36 +54,24 @@ template<typename T> class GlobalsComponent : public Component {
 
   T &value() { return this->value_; }
 
-  void setup() override {
-    if (this->restore_value_) {
-      this->rtc_ = global_preferences.make_preference<T>(1944399030U ^ this->name_hash_);
-      this->rtc_.load(&this->value_);
-    }
+  /// Restore the saved value and let the store save the changes from now on.
+  void set_restore_value(GlobalsStore *store, uint32_t name_hash) {
+    this->rtc_ = global_preferences.make_preference<T>(1944399030U ^ name_hash);
+    this->rtc_.load(&this->value_);
     memcpy(&this->prev_value_, &this->value_, sizeof(T));
+    store->add(this);
   }
 
-  float get_setup_priority() const override { return setup_priority::HARDWARE; }
-
-  void loop() override {
-    if (this->restore_value_) {
-      int diff = memcmp(&this->value_, &this->prev_value_, sizeof(T));
-      if (diff != 0) {
-        this->rtc_.save(&this->value_);
-        memcpy(&this->prev_value_, &this->value_, sizeof(T));
-      }
+  void save_if_changed() override {
+    if (memcmp(&this->value_, &this->prev_value_, sizeof(T)) != 0) {
+      this->rtc_.save(&this->value_);
+      memcpy(&this->prev_value_, &this->value_, sizeof(T));
     }
   }
 
-  void set_restore_value(uint32_t name_hash) {
-    this->restore_value_ = true;
-    this->name_hash_ = name_hash;
-  }
-
  protected:
   T value_{};
   T prev_value_{};
-  bool restore_value_{false};
-  uint32_t name_hash_{};
   ESPPreferenceObject rtc_;
 };
 
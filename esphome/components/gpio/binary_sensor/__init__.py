@@ -5,12 +5,25 @@ from esphome.components import binary_sensor
 from esphome.const import CONF_ID, CONF_PIN
 from .. import gpio_ns
 
+CONF_DEBOUNCE = 'debounce'
+CONF_INTERRUPT = 'interrupt'
+
 GPIOBinarySensor = gpio_ns.class_('GPIOBinarySensor', binary_sensor.BinarySensor, cg.Component)
 
-CONFIG_SCHEMA = binary_sensor.BINARY_SENSOR_SCHEMA.extend({
+
+
+def validate_interrupt(config):
+    if config[CONF_INTERRUPT] and any(key in config[CONF_PIN] for key in pins.PIN_SCHEMA_REGISTRY):
+        raise cv.Invalid("interrupt is only supported for the internal pins of the ESP")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(binary_sensor.BINARY_SENSOR_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(GPIOBinarySensor),
-    cv.Required(CONF_PIN): pins.gpio_input_pin_schema
-}).extend(cv.COMPONENT_SCHEMA)
+    cv.Required(CONF_PIN): pins.gpio_input_pin_schema,
+    cv.Optional(CONF_DEBOUNCE): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_INTERRUPT, default=False): cv.boolean,
+}).extend(cv.COMPONENT_SCHEMA), validate_interrupt)
 
 
 def to_code(config):
@@ -20,3 +33,7 @@ def to_code(config):
 
     pin = yield cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+    if CONF_DEBOUNCE in config:
+        cg.add(var.set_debounce(config[CONF_DEBOUNCE]))
+    if config[CONF_INTERRUPT]:
+        cg.add(var.set_use_interrupt(True))
@@ -1,4 +1,5 @@
 #include "gpio_binary_sensor.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -6,17 +7,104 @@ namespace gpio {
 
 static const char *TAG = "gpio.binary_sensor";
 
+void ICACHE_RAM_ATTR GPIOBinarySensorStore::gpio_intr(GPIOBinarySensorStore *arg) {
+  const uint32_t now = micros();
+  const bool level = arg->pin->digital_read();
+  if (arg->debounce != 0 && now - arg->last_edge < arg->debounce) {
+    // a bounce of the last edge, the level it settles at is read once the debounce time has passed
+    arg->resync = true;
+    return;
+  }
+  arg->last_edge = now;
+
+  const uint8_t head = arg->head;
+  const uint8_t next = (head + 1) % QUEUE_SIZE;
+  if (next == arg->tail) {
+    arg->resync = true;
+  } else {
+    arg->edges[head].level = level;
+    arg->edges[head].time = now;
+    arg->head = next;
+  }
+  Application::wake_loop_isr();
+}
+
 void GPIOBinarySensor::setup() {
   this->pin_->setup();
-  this->publish_initial_state(this->pin_->digital_read());
+  this->last_level_ = this->pin_->digital_read();
+  this->publish_initial_state(this->last_level_);
+
+  if (this->use_interrupt_) {
+    this->store_.pin = this->pin_->to_isr();
+    this->store_.debounce = this->debounce_ * 1000;
+    this->pin_->attach_interrupt(GPIOBinarySensorStore::gpio_intr, &this->store_, CHANGE);
+  }
 }
 
 void GPIOBinarySensor::dump_config() {
   LOG_BINARY_SENSOR("", "GPIO Binary Sensor", this);
   LOG_PIN("  Pin: ", this->pin_);
+  if (this->debounce_ != 0)
+    ESP_LOGCONFIG(TAG, "  Debounce: %u ms", this->debounce_);
+  if (this->use_interrupt_)
+    ESP_LOGCONFIG(TAG, "  Using Interrupt");
+}
+
+void GPIOBinarySensor::loop() {
+  if (this->use_interrupt_) {
+    this->loop_interrupt_();
+    return;
+  }
+
+  const bool level = this->pin_->digital_read();
+  const uint32_t now = millis();
+  if (this->debounce_ == 0) {
+    if (level != this->last_level_) {
+      this->last_level_ = level;
+      this->last_edge_time_ = now;
+    }
+    this->publish_state(level);
+    return;
+  }
+
+  if (level != this->last_level_) {
+    this->last_level_ = level;
+    this->last_change_ = now;
+  } else if (now - this->last_change_ >= this->debounce_) {
+    this->last_edge_time_ = this->last_change_;
+    this->publish_state(level);
+  }
+}
+
+void GPIOBinarySensor::loop_interrupt_() {
+  GPIOBinarySensorStore &store = this->store_;
+  while (store.tail != store.head) {
+    const GPIOBinarySensorStore::Edge edge = store.edges[store.tail];
+    store.tail = (store.tail + 1) % GPIOBinarySensorStore::QUEUE_SIZE;
+    this->last_level_ = edge.level;
+    this->last_edge_time_ = millis() - (micros() - edge.time) / 1000;
+    this->publish_state(edge.level);
+  }
+
+  if (!store.resync)
+    return;
+  // wait for the bouncing to end before reading the level it settled at
+  if (store.debounce != 0 && micros() - store.last_edge < store.debounce)
+    return;
+  store.resync = false;
+  const bool level = this->pin_->digital_read();
+  if (level != this->last_level_) {
+    this->last_level_ = level;
+    this->last_edge_time_ = millis();
+  }
+  this->publish_state(level);
 }
 
-void GPIOBinarySensor::loop() { this->publish_state(this->pin_->digital_read()); }
+bool GPIOBinarySensor::is_loop_idle() {
+  if (!this->use_interrupt_)
+    return false;
+  return this->store_.tail == this->store_.head && !this->store_.resync;
+}
 
 float GPIOBinarySensor::get_setup_priority() const { return setup_priority::HARDWARE; }
 
@@ -1,14 +1,44 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/esphal.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 
 namespace esphome {
 namespace gpio {
 
+/// The edges latched by the interrupt handler, a single producer/single consumer ring shared with the main loop.
+struct GPIOBinarySensorStore {
+  static const uint8_t QUEUE_SIZE = 16;
+  struct Edge {
+    bool level;
+    /// micros() when the edge happened.
+    uint32_t time;
+  };
+
+  ISRInternalGPIOPin *pin;
+  /// Edges closer than this to the last accepted one are ignored (0 = no debouncing), in microseconds.
+  uint32_t debounce{0};
+  uint32_t last_edge{0};
+  Edge edges[QUEUE_SIZE];
+  /// Written by the interrupt handler only.
+  volatile uint8_t head{0};
+  /// Written by the main loop only.
+  volatile uint8_t tail{0};
+  /// Set when edges were dropped or ignored, the main loop then reads the pin once they settled.
+  volatile bool resync{false};
+
+  static void gpio_intr(GPIOBinarySensorStore *arg);
+};
+
 class GPIOBinarySensor : public binary_sensor::BinarySensor, public Component {
  public:
   void set_pin(GPIOPin *pin) { pin_ = pin; }
+  void set_debounce(uint32_t debounce) { debounce_ = debounce; }
+  /// Latch the edges in an interrupt handler instead of reading the pin every loop, only for internal pins.
+  void set_use_interrupt(bool use_interrupt) { use_interrupt_ = use_interrupt; }
+  /// millis() at the edge of the last published state, which can be earlier than the time it was published.
+  uint32_t get_last_edge_time() const { return last_edge_time_; }
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Setup pin
@@ -18,9 +48,21 @@ class GPIOBinarySensor : public binary_sensor::BinarySensor, public Component {
   float get_setup_priority() const override;
   /// Check sensor
   void loop() override;
+  bool is_loop_idle() override;
 
  protected:
+  void loop_interrupt_();
+
   GPIOPin *pin_;
+  /// The time the pin has to keep a new level before it is published (0 = publish every change).
+  uint32_t debounce_{0};
+  /// The level read last and when it was first read, to tell when it has been stable for the debounce time.
+  /// With the interrupt it is the level of the last edge.
+  bool last_level_{false};
+  uint32_t last_change_{0};
+  uint32_t last_edge_time_{0};
+  bool use_interrupt_{false};
+  GPIOBinarySensorStore store_{};
 };
 
 }  // namespace gpio
@@ -10,9 +10,12 @@ GPS = gps_ns.class_('GPS', cg.Component, uart.UARTDevice)
 GPSListener = gps_ns.class_('GPSListener')
 
 CONF_GPS_ID = 'gps_id'
+CONF_UBLOX = 'ublox'
 MULTI_CONF = True
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(GPS),
+    # Turn off the NMEA sentences that aren't decoded with UBX commands
+    cv.Optional(CONF_UBLOX, default=False): cv.boolean,
 }).extend(cv.COMPONENT_SCHEMA).extend(uart.UART_DEVICE_SCHEMA)
 
 
@@ -20,6 +23,7 @@ def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
     yield uart.register_uart_device(var, config)
+    cg.add(var.set_ublox(config[CONF_UBLOX]))
 
     # https://platformio.org/lib/show/1655/TinyGPSPlus
     cg.add_library('1655', '1.0.2')  # TinyGPSPlus, has name conflict
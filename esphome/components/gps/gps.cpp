@@ -1,47 +1,159 @@
 #include "gps.h"
 #include "esphome/core/log.h"
+#include <cstring>
 
 namespace esphome {
 namespace gps {
 
 static const char *TAG = "gps";
 
+static const uint8_t UBX_CLASS_CFG = 0x06;
+static const uint8_t UBX_CFG_MSG = 0x01;
+static const uint8_t UBX_CLASS_NMEA = 0xF0;
+/// The UBX message ids of the NMEA sentences that are never decoded: GLL, GSA, GSV and VTG.
+static const uint8_t UBX_NMEA_UNUSED[] = {0x01, 0x02, 0x03, 0x05};
+static const uint8_t UBX_NMEA_GGA = 0x00;
+
 TinyGPSPlus &GPSListener::get_tiny_gps() { return this->parent_->get_tiny_gps(); }
 
+void GPS::setup() {
+  if (!this->ublox_)
+    return;
+  // set the rate of the sentences on the port we're connected to to 0
+  for (uint8_t msg_id : UBX_NMEA_UNUSED) {
+    const uint8_t payload[] = {UBX_CLASS_NMEA, msg_id, 0};
+    this->send_ubx_(UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload));
+  }
+  if ((this->sentences_ & GPS_SENTENCE_GGA) == 0) {
+    const uint8_t payload[] = {UBX_CLASS_NMEA, UBX_NMEA_GGA, 0};
+    this->send_ubx_(UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload));
+  }
+}
+
+void GPS::dump_config() {
+  ESP_LOGCONFIG(TAG, "GPS:");
+  ESP_LOGCONFIG(TAG, "  Decoded sentences:%s%s", this->sentences_ & GPS_SENTENCE_RMC ? " RMC" : "",
+                this->sentences_ & GPS_SENTENCE_GGA ? " GGA" : "");
+  ESP_LOGCONFIG(TAG, "  u-blox: %s", YESNO(this->ublox_));
+}
+
 void GPS::loop() {
-  while (this->available() && !this->has_time_) {
-    if (this->tiny_gps_.encode(this->read())) {
-      if (tiny_gps_.location.isUpdated()) {
-        ESP_LOGD(TAG, "Location:");
-        ESP_LOGD(TAG, "  Lat: %f", tiny_gps_.location.lat());
-        ESP_LOGD(TAG, "  Lon: %f", tiny_gps_.location.lng());
-      }
-
-      if (tiny_gps_.speed.isUpdated()) {
-        ESP_LOGD(TAG, "Speed:");
-        ESP_LOGD(TAG, "  %f km/h", tiny_gps_.speed.kmph());
-      }
-      if (tiny_gps_.course.isUpdated()) {
-        ESP_LOGD(TAG, "Course:");
-        ESP_LOGD(TAG, "  %f °", tiny_gps_.course.deg());
-      }
-      if (tiny_gps_.altitude.isUpdated()) {
-        ESP_LOGD(TAG, "Altitude:");
-        ESP_LOGD(TAG, "  %f m", tiny_gps_.altitude.meters());
-      }
-      if (tiny_gps_.satellites.isUpdated()) {
-        ESP_LOGD(TAG, "Satellites:");
-        ESP_LOGD(TAG, "  %d", tiny_gps_.satellites.value());
-      }
-      if (tiny_gps_.satellites.isUpdated()) {
-        ESP_LOGD(TAG, "HDOP:");
-        ESP_LOGD(TAG, "  %.2f", tiny_gps_.hdop.hdop());
-      }
-
-      for (auto *listener : this->listeners_)
-        listener->on_update(this->tiny_gps_);
+  uint8_t buffer[64];
+  size_t len;
+  while (!this->has_time_ && (len = this->read_available(buffer, sizeof(buffer))) != 0)
+    this->parse_(buffer, len);
+}
+
+optional<uint32_t> GPS::get_fix_age() const {
+  if (!this->last_fix_.has_value())
+    return {};
+  return millis() - *this->last_fix_;
+}
+
+void GPS::parse_(const uint8_t *data, size_t len) {
+  const uint8_t *end = data + len;
+  while (data != end) {
+    if (this->sentence_len_ == 0) {
+      // skip everything up to the start of the next sentence, including the sentences that aren't needed
+      const auto *start = static_cast<const uint8_t *>(memchr(data, '$', end - data));
+      if (start == nullptr)
+        return;
+      this->sentence_[0] = '$';
+      this->sentence_len_ = 1;
+      this->sentence_start_ = millis();
+      data = start + 1;
+      continue;
     }
+
+    const uint8_t byte = *data++;
+    if (byte == '$') {
+      // the previous sentence was cut off
+      this->sentence_len_ = 1;
+      this->sentence_start_ = millis();
+    } else if (byte == '\r' || byte == '\n') {
+      this->decode_sentence_();
+      this->sentence_len_ = 0;
+    } else if (this->sentence_len_ == sizeof(this->sentence_)) {
+      this->sentence_len_ = 0;
+    } else {
+      this->sentence_[this->sentence_len_++] = byte;
+      // "$GPRMC": the talker doesn't matter, just the type
+      if (this->sentence_len_ == 6 && !this->is_wanted_sentence_())
+        this->sentence_len_ = 0;
+    }
+  }
+}
+
+bool GPS::is_wanted_sentence_() const {
+  const char *type = this->sentence_ + 3;
+  if ((this->sentences_ & GPS_SENTENCE_RMC) && memcmp(type, "RMC", 3) == 0)
+    return true;
+  if ((this->sentences_ & GPS_SENTENCE_GGA) && memcmp(type, "GGA", 3) == 0)
+    return true;
+  return false;
+}
+
+void GPS::decode_sentence_() {
+  if (this->sentence_len_ < 6)
+    return;
+  bool valid = false;
+  for (uint8_t i = 0; i < this->sentence_len_; i++)
+    valid |= this->tiny_gps_.encode(this->sentence_[i]);
+  valid |= this->tiny_gps_.encode('\r');
+  valid |= this->tiny_gps_.encode('\n');
+  if (!valid)
+    return;
+  this->latency_ = millis() - this->sentence_start_;
+
+  if (tiny_gps_.location.isUpdated()) {
+    if (tiny_gps_.location.isValid())
+      this->last_fix_ = millis();
+    ESP_LOGD(TAG, "Location:");
+    ESP_LOGD(TAG, "  Lat: %f", tiny_gps_.location.lat());
+    ESP_LOGD(TAG, "  Lon: %f", tiny_gps_.location.lng());
+  }
+
+  if (tiny_gps_.speed.isUpdated()) {
+    ESP_LOGD(TAG, "Speed:");
+    ESP_LOGD(TAG, "  %f km/h", tiny_gps_.speed.kmph());
+  }
+  if (tiny_gps_.course.isUpdated()) {
+    ESP_LOGD(TAG, "Course:");
+    ESP_LOGD(TAG, "  %f °", tiny_gps_.course.deg());
+  }
+  if (tiny_gps_.altitude.isUpdated()) {
+    ESP_LOGD(TAG, "Altitude:");
+    ESP_LOGD(TAG, "  %f m", tiny_gps_.altitude.meters());
+  }
+  if (tiny_gps_.satellites.isUpdated()) {
+    ESP_LOGD(TAG, "Satellites:");
+    ESP_LOGD(TAG, "  %d", tiny_gps_.satellites.value());
+  }
+  if (tiny_gps_.satellites.isUpdated()) {
+    ESP_LOGD(TAG, "HDOP:");
+    ESP_LOGD(TAG, "  %.2f", tiny_gps_.hdop.hdop());
+  }
+
+  for (auto *listener : this->listeners_)
+    listener->on_update(this->tiny_gps_);
+}
+
+void GPS::send_ubx_(uint8_t msg_class, uint8_t msg_id, const uint8_t *payload, uint16_t len) {
+  const uint8_t header[] = {0xB5, 0x62, msg_class, msg_id, uint8_t(len), uint8_t(len >> 8)};
+  // 8 bit Fletcher checksum of everything after the sync chars
+  uint8_t ck_a = 0, ck_b = 0;
+  for (uint8_t i = 2; i < sizeof(header); i++) {
+    ck_a += header[i];
+    ck_b += ck_a;
+  }
+  for (uint16_t i = 0; i < len; i++) {
+    ck_a += payload[i];
+    ck_b += ck_a;
   }
+  this->write_array(header, sizeof(header));
+  this->write_array(payload, len);
+  this->write_byte(ck_a);
+  this->write_byte(ck_b);
 }
 
 }  // namespace gps
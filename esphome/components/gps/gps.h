@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/uart/uart.h"
 #include <TinyGPS++.h>
 
@@ -9,9 +10,19 @@ namespace gps {
 
 class GPS;
 
+/// The NMEA sentences TinyGPSPlus decodes, all others are skipped.
+enum GPSSentence : uint8_t {
+  /// Time, date, position, speed and course.
+  GPS_SENTENCE_RMC = 1 << 0,
+  /// Time, position, altitude, satellites and HDOP.
+  GPS_SENTENCE_GGA = 1 << 1,
+};
+
 class GPSListener {
  public:
   virtual void on_update(TinyGPSPlus &tiny_gps) = 0;
+  /// The sentences this listener needs decoded, a mask of GPSSentence.
+  virtual uint8_t get_sentences() const { return GPS_SENTENCE_RMC | GPS_SENTENCE_GGA; }
   TinyGPSPlus &get_tiny_gps();
 
  protected:
@@ -20,18 +31,47 @@ class GPSListener {
   GPS *parent_;
 };
 
+/** Reads NMEA sentences from a GPS module.
+ *
+ * The UART is read in blocks and a sentence is only fed to TinyGPSPlus once it is complete and of a type that is
+ * needed, the many satellite sentences a module sends are dropped after their first six characters. u-blox modules
+ * can be told with UBX commands to not send the unneeded sentences at all.
+ */
 class GPS : public Component, public uart::UARTDevice {
  public:
   void register_listener(GPSListener *listener) {
     listener->parent_ = this;
     this->listeners_.push_back(listener);
+    this->sentences_ |= listener->get_sentences();
   }
+  void set_ublox(bool ublox) { this->ublox_ = ublox; }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
+  void setup() override;
+  void dump_config() override;
   void loop() override;
   TinyGPSPlus &get_tiny_gps() { return this->tiny_gps_; }
 
+  /// Milliseconds since the last valid position, empty if there was none yet.
+  optional<uint32_t> get_fix_age() const;
+  /// Milliseconds from reading the start of the last decoded sentence until it was decoded.
+  uint32_t get_latency() const { return this->latency_; }
+
  protected:
+  void parse_(const uint8_t *data, size_t len);
+  bool is_wanted_sentence_() const;
+  void decode_sentence_();
+  void send_ubx_(uint8_t msg_class, uint8_t msg_id, const uint8_t *payload, uint16_t len);
+
   bool has_time_{false};
+  bool ublox_{false};
+  /// The position, speed and course are logged, so RMC is always decoded.
+  uint8_t sentences_{GPS_SENTENCE_RMC};
+  /// The sentence being received, starting at the '$'. Empty while waiting for the next one.
+  char sentence_[96];
+  uint8_t sentence_len_{0};
+  uint32_t sentence_start_{0};
+  uint32_t latency_{0};
+  optional<uint32_t> last_fix_{};
   TinyGPSPlus tiny_gps_;
   std::vector<GPSListener *> listeners_{};
 };
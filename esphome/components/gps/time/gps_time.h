@@ -14,6 +14,7 @@ class GPSTime : public time::RealTimeClock, public GPSListener {
     if (!this->has_time_)
       this->from_tiny_gps_(tiny_gps);
   }
+  uint8_t get_sentences() const override { return GPS_SENTENCE_RMC; }
 
  protected:
   void from_tiny_gps_(TinyGPSPlus &tiny_gps);
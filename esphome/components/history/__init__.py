@@ -0,0 +1,43 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, time, web_server_base
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
+from esphome.const import CONF_ID, CONF_SENSORS, CONF_TIME_ID
+
+CONF_RAW_SIZE = 'raw_size'
+CONF_MINUTE_SIZE = 'minute_size'
+CONF_QUARTER_SIZE = 'quarter_size'
+
+history_ns = cg.esphome_ns.namespace('history')
+HistoryComponent = history_ns.class_('HistoryComponent', cg.Component)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(HistoryComponent),
+    cv.Required(CONF_SENSORS): cv.All(cv.ensure_list(cv.use_id(sensor.Sensor)), cv.Length(min=1)),
+    cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+    cv.OnlyWith(CONF_WEB_SERVER_BASE_ID, 'web_server'): cv.use_id(web_server_base.WebServerBase),
+    cv.Optional(CONF_RAW_SIZE, default=60): cv.int_range(min=0, max=4096),
+    cv.Optional(CONF_MINUTE_SIZE, default=60): cv.int_range(min=0, max=4096),
+    cv.Optional(CONF_QUARTER_SIZE, default=96): cv.int_range(min=0, max=4096),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    cg.add_define('USE_HISTORY')
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    # the sizes are used when the sensors are added
+    cg.add(var.set_raw_size(config[CONF_RAW_SIZE]))
+    cg.add(var.set_minute_size(config[CONF_MINUTE_SIZE]))
+    cg.add(var.set_quarter_size(config[CONF_QUARTER_SIZE]))
+    for sensor_id in config[CONF_SENSORS]:
+        sens = yield cg.get_variable(sensor_id)
+        cg.add(var.add_sensor(sens))
+    if CONF_TIME_ID in config:
+        time_ = yield cg.get_variable(config[CONF_TIME_ID])
+        cg.add(var.set_time(time_))
+    if CONF_WEB_SERVER_BASE_ID in config:
+        cg.add_define('USE_HISTORY_WEB')
+        base = yield cg.get_variable(config[CONF_WEB_SERVER_BASE_ID])
+        cg.add(var.set_web_server(base))
@@ -0,0 +1,244 @@
+#include "history.h"
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace history {
+
+static const char *TAG = "history";
+
+static const uint32_t HISTORY_MINUTE = 60;
+static const uint32_t HISTORY_QUARTER = 15 * 60;
+
+HistoryComponent *global_history = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+const char *history_resolution_to_string(HistoryResolution resolution) {
+  switch (resolution) {
+    case HISTORY_RESOLUTION_RAW:
+      return "raw";
+    case HISTORY_RESOLUTION_1MIN:
+      return "1min";
+    case HISTORY_RESOLUTION_15MIN:
+      return "15min";
+    default:
+      return "unknown";
+  }
+}
+
+void HistoryBucket::add(uint32_t time, float min, float max, float sum, uint32_t count) {
+  if (this->count == 0) {
+    this->start = time;
+    this->min = min;
+    this->max = max;
+    this->sum = sum;
+    this->count = count;
+    return;
+  }
+  this->min = std::min(this->min, min);
+  this->max = std::max(this->max, max);
+  this->sum += sum;
+  this->count += count;
+}
+
+SensorHistory::SensorHistory(sensor::Sensor *sensor, size_t raw_size, size_t minute_size, size_t quarter_size)
+    : sensor_(sensor) {
+  this->raw_.init(raw_size);
+  this->minutes_.init(minute_size);
+  this->quarters_.init(quarter_size);
+}
+
+void SensorHistory::add(uint32_t time, float value) {
+  this->raw_.push({time, value});
+  this->flush(time);
+  // the buckets start at the first sample, not at the full minute, so they cover whole intervals from boot
+  this->minute_.add(time, value, value, value, 1);
+}
+
+void SensorHistory::flush(uint32_t time) {
+  if (this->minute_.count != 0 && time - this->minute_.start >= HISTORY_MINUTE)
+    this->close_minute_();
+  if (this->quarter_.count != 0 && time - this->quarter_.start >= HISTORY_QUARTER)
+    this->close_quarter_();
+}
+
+void SensorHistory::close_minute_() {
+  const HistoryPoint point = this->minute_.to_point();
+  this->minutes_.push(point);
+  this->quarter_.add(point.time, this->minute_.min, this->minute_.max, this->minute_.sum, this->minute_.count);
+  this->minute_.count = 0;
+}
+
+void SensorHistory::close_quarter_() {
+  this->quarters_.push(this->quarter_.to_point());
+  this->quarter_.count = 0;
+}
+
+size_t SensorHistory::size(HistoryResolution resolution) const {
+  switch (resolution) {
+    case HISTORY_RESOLUTION_RAW:
+      return this->raw_.size();
+    case HISTORY_RESOLUTION_1MIN:
+      return this->minutes_.size();
+    case HISTORY_RESOLUTION_15MIN:
+      return this->quarters_.size();
+    default:
+      return 0;
+  }
+}
+
+HistoryPoint SensorHistory::at(HistoryResolution resolution, size_t i) const {
+  switch (resolution) {
+    case HISTORY_RESOLUTION_RAW: {
+      const HistorySample &sample = this->raw_.at(i);
+      return {sample.time, sample.value, sample.value, sample.value};
+    }
+    case HISTORY_RESOLUTION_1MIN:
+      return this->minutes_.at(i);
+    default:
+      return this->quarters_.at(i);
+  }
+}
+
+size_t SensorHistory::find(HistoryResolution resolution, uint32_t time) const {
+  // the points are sorted by time, so binary search the oldest one that isn't too old
+  size_t low = 0, high = this->size(resolution);
+  while (low < high) {
+    const size_t mid = (low + high) / 2;
+    if (this->at(resolution, mid).time < time) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+HistoryComponent::HistoryComponent() { global_history = this; }
+
+void HistoryComponent::add_sensor(sensor::Sensor *sensor) {
+  auto *history = new SensorHistory(sensor, this->raw_size_, this->minute_size_, this->quarter_size_);
+  this->histories_.push_back(history);
+  sensor->add_on_state_callback([this, history](float state) {
+    if (!std::isnan(state))
+      history->add(this->uptime(), state);
+  });
+}
+
+void HistoryComponent::setup() {
+  // close the intervals of sensors that stopped publishing, so that they show up in the history
+  this->set_interval("flush", HISTORY_MINUTE * 1000, [this]() {
+    const uint32_t now = this->uptime();
+    for (auto *history : this->histories_)
+      history->flush(now);
+  });
+#ifdef USE_HISTORY_WEB
+  if (this->base_ != nullptr) {
+    this->base_->init();
+    this->base_->add_handler(new HistoryWebHandler(this));
+  }
+#endif
+}
+
+void HistoryComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "History:");
+  ESP_LOGCONFIG(TAG, "  Raw Size: %u", this->raw_size_);
+  ESP_LOGCONFIG(TAG, "  1 Minute Size: %u", this->minute_size_);
+  ESP_LOGCONFIG(TAG, "  15 Minutes Size: %u", this->quarter_size_);
+  for (auto *history : this->histories_)
+    ESP_LOGCONFIG(TAG, "  Sensor '%s'", history->get_sensor()->get_name().c_str());
+}
+
+SensorHistory *HistoryComponent::get_history(uint32_t key) {
+  for (auto *history : this->histories_) {
+    if (history->get_sensor()->get_object_id_hash() == key)
+      return history;
+  }
+  return nullptr;
+}
+
+SensorHistory *HistoryComponent::get_history(const std::string &object_id) {
+  for (auto *history : this->histories_) {
+    if (history->get_sensor()->get_object_id() == object_id)
+      return history;
+  }
+  return nullptr;
+}
+
+bool HistoryComponent::get_time_offset(int64_t &offset) {
+  offset = 0;
+#ifdef USE_TIME
+  if (this->time_ != nullptr) {
+    auto now = this->time_->utcnow();
+    if (now.is_valid()) {
+      offset = int64_t(now.timestamp) - this->uptime();
+      return true;
+    }
+  }
+#endif
+  return false;
+}
+
+uint32_t HistoryComponent::uptime() {
+  const uint32_t now = millis();
+  if (now < this->last_millis_)
+    this->millis_major_++;
+  this->last_millis_ = now;
+  return ((uint64_t(this->millis_major_) << 32) | now) / 1000;
+}
+
+#ifdef USE_HISTORY_WEB
+void HistoryWebHandler::handleRequest(AsyncWebServerRequest *request) {
+  const std::string object_id = request->url().substring(9).c_str();
+  SensorHistory *history = this->parent_->get_history(object_id);
+  if (history == nullptr) {
+    request->send(404);
+    return;
+  }
+
+  HistoryResolution resolution = HISTORY_RESOLUTION_RAW;
+  if (request->hasParam("resolution")) {
+    const String value = request->getParam("resolution")->value();
+    if (value == "1min") {
+      resolution = HISTORY_RESOLUTION_1MIN;
+    } else if (value == "15min") {
+      resolution = HISTORY_RESOLUTION_15MIN;
+    } else if (value != "raw") {
+      request->send(400);
+      return;
+    }
+  }
+
+  int64_t offset;
+  const bool utc = this->parent_->get_time_offset(offset);
+  size_t start = 0;
+  if (request->hasParam("since")) {
+    const int64_t since = request->getParam("since")->value().toInt() - offset;
+    start = history->find(resolution, since > 0 ? since : 0);
+  }
+
+  const int8_t accuracy = history->get_sensor()->get_accuracy_decimals();
+  AsyncResponseStream *stream = request->beginResponseStream("application/json");
+  stream->printf("{\"id\":\"sensor-%s\",\"resolution\":\"%s\",\"utc\":%s,\"points\":[", object_id.c_str(),
+                 history_resolution_to_string(resolution), utc ? "true" : "false");
+  const size_t size = history->size(resolution);
+  for (size_t i = start; i < size; i++) {
+    const HistoryPoint point = history->at(resolution, i);
+    const uint32_t time = point.time + offset;
+    const char *separator = i == start ? "" : ",";
+    if (resolution == HISTORY_RESOLUTION_RAW) {
+      stream->printf("%s[%u,%s]", separator, time, value_accuracy_to_string(point.mean, accuracy).c_str());
+    } else {
+      stream->printf("%s[%u,%s,%s,%s]", separator, time, value_accuracy_to_string(point.min, accuracy).c_str(),
+                     value_accuracy_to_string(point.mean, accuracy).c_str(),
+                     value_accuracy_to_string(point.max, accuracy).c_str());
+    }
+  }
+  stream->print("]}");
+  request->send(stream);
+}
+#endif
+
+}  // namespace history
+}  // namespace esphome
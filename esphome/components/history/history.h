@@ -0,0 +1,185 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/components/sensor/sensor.h"
+#include <string>
+#include <vector>
+
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
+#ifdef USE_HISTORY_WEB
+#include "esphome/components/web_server_base/web_server_base.h"
+#endif
+
+namespace esphome {
+namespace history {
+
+enum HistoryResolution : uint8_t {
+  HISTORY_RESOLUTION_RAW = 0,
+  HISTORY_RESOLUTION_1MIN = 1,
+  HISTORY_RESOLUTION_15MIN = 2,
+};
+
+const char *history_resolution_to_string(HistoryResolution resolution);
+
+/// One entry of a history. Raw samples have the same min, mean and max.
+struct HistoryPoint {
+  /// Seconds of uptime at the sample, or at the start of the aggregated interval.
+  uint32_t time;
+  float min;
+  float mean;
+  float max;
+};
+
+/// A fixed-size ring of points, the oldest one is overwritten once it is full.
+template<typename T> class HistoryRing {
+ public:
+  void init(size_t capacity) {
+    this->items_.resize(capacity);
+    this->head_ = 0;
+    this->count_ = 0;
+  }
+  void push(const T &item) {
+    if (this->items_.empty())
+      return;
+    this->items_[this->head_] = item;
+    this->head_ = (this->head_ + 1) % this->items_.size();
+    if (this->count_ < this->items_.size())
+      this->count_++;
+  }
+  size_t size() const { return this->count_; }
+  /// The i-th oldest item.
+  const T &at(size_t i) const {
+    return this->items_[(this->head_ + this->items_.size() - this->count_ + i) % this->items_.size()];
+  }
+
+ protected:
+  std::vector<T> items_;
+  /// Index the next item is written to.
+  size_t head_{0};
+  size_t count_{0};
+};
+
+/// A raw sample, stored without the aggregates to halve the memory it needs.
+struct HistorySample {
+  uint32_t time;
+  float value;
+};
+
+/// The min, max and sum of the samples of one interval that is still open.
+struct HistoryBucket {
+  uint32_t start;
+  float min;
+  float max;
+  float sum;
+  uint32_t count{0};
+
+  void add(uint32_t time, float min, float max, float sum, uint32_t count);
+  HistoryPoint to_point() const { return {this->start, this->min, this->sum / this->count, this->max}; }
+};
+
+/// The histories of one sensor at all resolutions.
+class SensorHistory {
+ public:
+  SensorHistory(sensor::Sensor *sensor, size_t raw_size, size_t minute_size, size_t quarter_size);
+
+  void add(uint32_t time, float value);
+  /// Close the intervals that ended before time, even if no sample arrived since.
+  void flush(uint32_t time);
+
+  sensor::Sensor *get_sensor() const { return this->sensor_; }
+  /// The number of points in the history of the resolution.
+  size_t size(HistoryResolution resolution) const;
+  /// The i-th oldest point of the history of the resolution.
+  HistoryPoint at(HistoryResolution resolution, size_t i) const;
+  /// Index of the oldest point at or after time, size() if there is none.
+  size_t find(HistoryResolution resolution, uint32_t time) const;
+
+ protected:
+  void close_minute_();
+  void close_quarter_();
+
+  sensor::Sensor *sensor_;
+  HistoryRing<HistorySample> raw_;
+  HistoryRing<HistoryPoint> minutes_;
+  HistoryRing<HistoryPoint> quarters_;
+  HistoryBucket minute_;
+  /// Aggregates the closed minutes, not the raw samples.
+  HistoryBucket quarter_;
+};
+
+/** Keeps the recent states of sensors in memory at several resolutions.
+ *
+ * Every state is kept as a raw sample, and aggregated into the min, mean and max of each minute and of each
+ * 15 minutes. Each resolution is a ring of fixed size, so the memory use doesn't grow. The histories are served at
+ * /history/<object_id> by the web server and with HistoryRequest over the native API, so that clients can fill
+ * the gap after a reconnect.
+ */
+class HistoryComponent : public Component {
+ public:
+  HistoryComponent();
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void set_raw_size(uint16_t raw_size) { this->raw_size_ = raw_size; }
+  void set_minute_size(uint16_t minute_size) { this->minute_size_ = minute_size; }
+  void set_quarter_size(uint16_t quarter_size) { this->quarter_size_ = quarter_size; }
+  void add_sensor(sensor::Sensor *sensor);
+#ifdef USE_TIME
+  void set_time(time::RealTimeClock *time) { this->time_ = time; }
+#endif
+#ifdef USE_HISTORY_WEB
+  void set_web_server(web_server_base::WebServerBase *base) { this->base_ = base; }
+#endif
+
+  /// The history of the sensor with the object id hash, nullptr if it isn't recorded.
+  SensorHistory *get_history(uint32_t key);
+  /// The history of the sensor with the object id, nullptr if it isn't recorded.
+  SensorHistory *get_history(const std::string &object_id);
+  /** The offset from the times of the points to UTC timestamps.
+   *
+   * @return Whether the time is known, if not the times stay seconds of uptime.
+   */
+  bool get_time_offset(int64_t &offset);
+  /// Seconds since boot, also past the millis() overflow.
+  uint32_t uptime();
+
+ protected:
+  std::vector<SensorHistory *> histories_;
+  uint16_t raw_size_{60};
+  uint16_t minute_size_{60};
+  uint16_t quarter_size_{96};
+  uint32_t last_millis_{0};
+  uint32_t millis_major_{0};
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
+#ifdef USE_HISTORY_WEB
+  web_server_base::WebServerBase *base_{nullptr};
+#endif
+};
+
+#ifdef USE_HISTORY_WEB
+/// Serves the histories as JSON at /history/<object_id>?resolution=raw|1min|15min&since=<time>.
+class HistoryWebHandler : public AsyncWebHandler {
+ public:
+  HistoryWebHandler(HistoryComponent *parent) : parent_(parent) {}
+
+  bool canHandle(AsyncWebServerRequest *request) override {
+    return request->method() == HTTP_GET && request->url().startsWith("/history/");
+  }
+  void handleRequest(AsyncWebServerRequest *request) override;
+
+ protected:
+  HistoryComponent *parent_;
+};
+#endif
+
+extern HistoryComponent *global_history;
+
+}  // namespace history
+}  // namespace esphome
@@ -8,12 +8,16 @@ static const char *TAG = "hlw8012";
 
 static const uint32_t HLW8012_CLOCK_FREQUENCY = 3579000;
 static const float HLW8012_REFERENCE_VOLTAGE = 2.43f;
+/// Without a CF pulse for this long the power is 0, it is below 0.2 W then.
+static const uint32_t HLW8012_CF_TIMEOUT_US = 60000000;
 
 void HLW8012Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up HLW8012...");
   this->sel_pin_->setup();
   this->sel_pin_->digital_write(this->current_mode_);
+  this->cf_store_.set_period_samples(2);
   this->cf_store_.pulse_counter_setup(this->cf_pin_);
+  this->last_update_at_ = millis();
   this->cf1_store_.pulse_counter_setup(this->cf1_pin_);
 }
 void HLW8012Component::dump_config() {
@@ -25,21 +29,40 @@ void HLW8012Component::dump_config() {
   ESP_LOGCONFIG(TAG, "  Current resistor: %.1f mΩ", this->current_resistor_ * 1000.0f);
   ESP_LOGCONFIG(TAG, "  Voltage Divider: %.1f", this->voltage_divider_);
   LOG_UPDATE_INTERVAL(this)
-  LOG_SENSOR("  ", "Voltage", this->voltage_sensor_)
-  LOG_SENSOR("  ", "Current", this->current_sensor_)
-  LOG_SENSOR("  ", "Power", this->power_sensor_)
+  LOG_SENSOR("  ", "Voltage", this->meter_.get_voltage_sensor())
+  LOG_SENSOR("  ", "Current", this->meter_.get_current_sensor())
+  LOG_SENSOR("  ", "Power", this->meter_.get_power_sensor())
+  LOG_SENSOR("  ", "Energy", this->meter_.get_energy_sensor())
+  LOG_SENSOR("  ", "Power Factor", this->meter_.get_power_factor_sensor())
 }
 float HLW8012Component::get_setup_priority() const { return setup_priority::DATA; }
+float HLW8012Component::cf_frequency_(uint32_t now) {
+  uint32_t edges, edge_at;
+  if (!this->cf_store_.read_last_edge(&edges, &edge_at))
+    return 0.0f;
+  if (edges != this->cf_edges_) {
+    // the first pulse has no period yet
+    if (this->cf_edges_ != 0)
+      this->cf_hz_ = (edges - this->cf_edges_) * 1000000.0f / float(edge_at - this->cf_edge_at_);
+    this->cf_edges_ = edges;
+    this->cf_edge_at_ = edge_at;
+  } else if (now - this->cf_edge_at_ > HLW8012_CF_TIMEOUT_US) {
+    this->cf_hz_ = 0.0f;
+  } else {
+    // no pulse since the last update, the next one can't come sooner than now
+    this->cf_hz_ = std::min(this->cf_hz_, 1000000.0f / float(now - this->cf_edge_at_));
+  }
+  return this->cf_hz_;
+}
 void HLW8012Component::update() {
   // HLW8012 has 50% duty cycle
+  const uint32_t now = millis();
+  const float window = (now - this->last_update_at_) / 1000.0f;
+  this->last_update_at_ = now;
   pulse_counter::pulse_counter_t raw_cf = this->cf_store_.read_raw_value();
   pulse_counter::pulse_counter_t raw_cf1 = this->cf1_store_.read_raw_value();
-  float cf_hz = raw_cf / (this->get_update_interval() / 1000.0f);
-  if (raw_cf <= 1) {
-    // don't count single pulse as power
-    cf_hz = 0.0f;
-  }
-  float cf1_hz = raw_cf1 / (this->get_update_interval() / 1000.0f);
+  float cf_hz = this->cf_frequency_(micros());
+  float cf1_hz = raw_cf1 / window;
   if (raw_cf1 <= 1) {
     // don't count single pulse as anything
     cf1_hz = 0.0f;
@@ -61,29 +84,20 @@ void HLW8012Component::update() {
           512000000.0f * HLW8012_REFERENCE_VOLTAGE / this->current_resistor_ / 24.0f / HLW8012_CLOCK_FREQUENCY;
       float current = cf1_hz * current_multiplier_micros / 1000000.0f;
       ESP_LOGD(TAG, "Got power=%.1fW, current=%.1fA", power, current);
-      if (this->current_sensor_ != nullptr) {
-        this->current_sensor_->publish_state(current);
-      }
+      this->meter_.add_current(current);
     } else {
       const float voltage_multiplier_micros =
           256000000.0f * HLW8012_REFERENCE_VOLTAGE * this->voltage_divider_ / HLW8012_CLOCK_FREQUENCY;
       float voltage = cf1_hz * voltage_multiplier_micros / 1000000.0f;
       ESP_LOGD(TAG, "Got power=%.1fW, voltage=%.1fV", power, voltage);
-      if (this->voltage_sensor_ != nullptr) {
-        this->voltage_sensor_->publish_state(voltage);
-      }
+      this->meter_.add_voltage(voltage);
     }
   }
 
-  if (this->power_sensor_ != nullptr) {
-    this->power_sensor_->publish_state(power);
-  }
-
-  if (this->energy_sensor_ != nullptr) {
-    cf_total_pulses_ += raw_cf;
-    float energy = cf_total_pulses_ * power_multiplier_micros / 3600 / 1000000.0f;
-    this->energy_sensor_->publish_state(energy);
-  }
+  this->meter_.add_power(power);
+  // every CF pulse is the same amount of energy
+  this->meter_.add_energy(raw_cf * power_multiplier_micros / 3600 / 1000000.0f);
+  this->meter_.publish();
 
   if (this->change_mode_at_++ == this->change_mode_every_) {
     this->current_mode_ = !this->current_mode_;
@@ -4,6 +4,7 @@
 #include "esphome/core/esphal.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/pulse_counter/pulse_counter_sensor.h"
+#include "esphome/components/energy_meter/energy_meter.h"
 
 namespace esphome {
 namespace hlw8012 {
@@ -26,28 +27,34 @@ class HLW8012Component : public PollingComponent {
   void set_sel_pin(GPIOPin *sel_pin) { sel_pin_ = sel_pin; }
   void set_cf_pin(GPIOPin *cf_pin) { cf_pin_ = cf_pin; }
   void set_cf1_pin(GPIOPin *cf1_pin) { cf1_pin_ = cf1_pin; }
-  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { voltage_sensor_ = voltage_sensor; }
-  void set_current_sensor(sensor::Sensor *current_sensor) { current_sensor_ = current_sensor; }
-  void set_power_sensor(sensor::Sensor *power_sensor) { power_sensor_ = power_sensor; }
-  void set_energy_sensor(sensor::Sensor *energy_sensor) { energy_sensor_ = energy_sensor; }
+  void set_voltage_sensor(sensor::Sensor *voltage_sensor) { meter_.set_voltage_sensor(voltage_sensor); }
+  void set_current_sensor(sensor::Sensor *current_sensor) { meter_.set_current_sensor(current_sensor); }
+  void set_power_sensor(sensor::Sensor *power_sensor) { meter_.set_power_sensor(power_sensor); }
+  void set_energy_sensor(sensor::Sensor *energy_sensor) { meter_.set_energy_sensor(energy_sensor); }
+  void set_power_factor_sensor(sensor::Sensor *power_factor_sensor) {
+    meter_.set_power_factor_sensor(power_factor_sensor);
+  }
 
  protected:
+  /// The CF frequency from the period between its last pulses, which is precise even with few pulses per update.
+  float cf_frequency_(uint32_t now);
+
   uint32_t nth_value_{0};
   bool current_mode_{false};
   uint32_t change_mode_at_{0};
   uint32_t change_mode_every_{8};
   float current_resistor_{0.001};
   float voltage_divider_{2351};
-  uint64_t cf_total_pulses_{0};
+  uint32_t last_update_at_{0};
+  uint32_t cf_edges_{0};
+  uint32_t cf_edge_at_{0};
+  float cf_hz_{0.0f};
   GPIOPin *sel_pin_;
   GPIOPin *cf_pin_;
   pulse_counter::PulseCounterStorage cf_store_;
   GPIOPin *cf1_pin_;
   pulse_counter::PulseCounterStorage cf1_store_;
-  sensor::Sensor *voltage_sensor_{nullptr};
-  sensor::Sensor *current_sensor_{nullptr};
-  sensor::Sensor *power_sensor_{nullptr};
-  sensor::Sensor *energy_sensor_{nullptr};
+  energy_meter::EnergyMeter meter_;
 };
 
 }  // namespace hlw8012
@@ -8,16 +8,13 @@ namespace homeassistant {
 static const char *TAG = "homeassistant.sensor";
 
 void HomeassistantSensor::setup() {
-  api::global_api_server->subscribe_home_assistant_state(this->entity_id_, [this](std::string state) {
-    auto val = parse_float(state);
-    if (!val.has_value()) {
-      ESP_LOGW(TAG, "Can't convert '%s' to number!", state.c_str());
-      this->publish_state(NAN);
-      return;
+  api::global_api_server->subscribe_home_assistant_numeric_state(this->entity_id_, [this](float state) {
+    if (isnan(state)) {
+      ESP_LOGW(TAG, "'%s': Got a state that isn't a number!", this->entity_id_.c_str());
+    } else {
+      ESP_LOGD(TAG, "'%s': Got state %.2f", this->entity_id_.c_str(), state);
     }
-
-    ESP_LOGD(TAG, "'%s': Got state %.2f", this->entity_id_.c_str(), *val);
-    this->publish_state(*val);
+    this->publish_state(state);
   });
 }
 void HomeassistantSensor::dump_config() {
@@ -12,7 +12,7 @@ void HomeassistantTextSensor::dump_config() {
   ESP_LOGCONFIG(TAG, "  Entity ID: '%s'", this->entity_id_.c_str());
 }
 void HomeassistantTextSensor::setup() {
-  api::global_api_server->subscribe_home_assistant_state(this->entity_id_, [this](std::string state) {
+  api::global_api_server->subscribe_home_assistant_state(this->entity_id_, [this](StringRef state) {
     ESP_LOGD(TAG, "'%s': Got state '%s'", this->entity_id_.c_str(), state.c_str());
     this->publish_state(state);
   });
@@ -4,22 +4,29 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.const import CONF_ID, CONF_TIMEOUT, CONF_ESPHOME, CONF_METHOD, \
-    CONF_ARDUINO_VERSION, ARDUINO_VERSION_ESP8266, CONF_URL
+    CONF_ARDUINO_VERSION, ARDUINO_VERSION_ESP8266, CONF_URL, CONF_TRIGGER_ID
 from esphome.core import CORE, Lambda
 from esphome.core_config import PLATFORMIO_ESP8266_LUT
 
 DEPENDENCIES = ['network']
 AUTO_LOAD = ['json']
 
+size_t = cg.global_ns.namespace('size_t')
 http_request_ns = cg.esphome_ns.namespace('http_request')
 HttpRequestComponent = http_request_ns.class_('HttpRequestComponent', cg.Component)
 HttpRequestSendAction = http_request_ns.class_('HttpRequestSendAction', automation.Action)
+HttpRequestResponseTrigger = http_request_ns.class_('HttpRequestResponseTrigger',
+                                                    automation.Trigger.template(cg.int_))
 
 CONF_HEADERS = 'headers'
 CONF_USERAGENT = 'useragent'
 CONF_BODY = 'body'
 CONF_JSON = 'json'
 CONF_VERIFY_SSL = 'verify_ssl'
+CONF_MAX_CONNECTIONS = 'max_connections'
+CONF_ASYNC = 'async'
+CONF_ON_RESPONSE = 'on_response'
+CONF_ON_BODY = 'on_body'
 
 
 def validate_framework(config):
@@ -67,17 +74,31 @@ def validate_secure_url(config):
     return config
 
 
+def validate_async(config):
+    if not config[CONF_ASYNC]:
+        return config
+    if not CORE.is_esp32:
+        raise cv.Invalid('Sending requests asynchronously is only supported on the ESP32.')
+    if CONF_ON_BODY in config:
+        raise cv.Invalid('on_body can\'t be used with asynchronous requests, it would be called '
+                         'from the task sending them.')
+    return config
+
+
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(HttpRequestComponent),
     cv.Optional(CONF_USERAGENT, 'ESPHome'): cv.string,
     cv.Optional(CONF_TIMEOUT, default='5s'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_MAX_CONNECTIONS, default=2): cv.int_range(min=1, max=8),
 }).add_extra(validate_framework).extend(cv.COMPONENT_SCHEMA)
 
 
 def to_code(config):
+    cg.add_define('USE_HTTP_REQUEST')
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_timeout(config[CONF_TIMEOUT]))
     cg.add(var.set_useragent(config[CONF_USERAGENT]))
+    cg.add(var.set_max_connections(config[CONF_MAX_CONNECTIONS]))
     yield cg.register_component(var, config)
 
 
@@ -86,7 +107,12 @@ HTTP_REQUEST_ACTION_SCHEMA = cv.Schema({
     cv.Required(CONF_URL): cv.templatable(validate_url),
     cv.Optional(CONF_HEADERS): cv.All(cv.Schema({cv.string: cv.templatable(cv.string)})),
     cv.Optional(CONF_VERIFY_SSL, default=True): cv.boolean,
-}).add_extra(validate_secure_url)
+    cv.Optional(CONF_ASYNC, default=False): cv.boolean,
+    cv.Optional(CONF_ON_RESPONSE): automation.validate_automation({
+        cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(HttpRequestResponseTrigger),
+    }),
+    cv.Optional(CONF_ON_BODY): cv.lambda_,
+}).add_extra(validate_secure_url).add_extra(validate_async)
 HTTP_REQUEST_GET_ACTION_SCHEMA = automation.maybe_conf(
     CONF_URL, HTTP_REQUEST_ACTION_SCHEMA.extend({
         cv.Optional(CONF_METHOD, default='GET'): cv.one_of('GET', upper=True),
@@ -139,5 +165,15 @@ def http_request_action_to_code(config, action_id, template_arg, args):
     for key in config.get(CONF_HEADERS, []):
         template_ = yield cg.templatable(config[CONF_HEADERS][key], args, cg.const_char_ptr)
         cg.add(var.add_header(key, template_))
+    if CONF_ON_BODY in config:
+        args_ = args + [(cg.uint8.operator('ptr').operator('const'), 'data'), (size_t, 'len')]
+        lambda_ = yield cg.process_lambda(config[CONF_ON_BODY], args_, return_type=cg.void)
+        cg.add(var.set_body_func(lambda_))
+    if config[CONF_ASYNC]:
+        cg.add(var.set_async(True))
+    for conf in config.get(CONF_ON_RESPONSE, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID])
+        cg.add(var.register_response_trigger(trigger))
+        yield automation.build_automation(trigger, [(cg.int_, 'status_code')], conf)
 
     yield var
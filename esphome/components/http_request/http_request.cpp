@@ -1,103 +1,257 @@
 #include "http_request.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace http_request {
 
 static const char *TAG = "http_request";
 
+/// The status of a request whose URL begin() didn't accept, not one of the HTTPClient error codes.
+static const int HTTP_REQUEST_BEGIN_FAILED = -100;
+/// The status of an asynchronous request that was dropped because too many were waiting.
+static const int HTTP_REQUEST_QUEUE_FULL = -101;
+
+#ifdef ARDUINO_ARCH_ESP32
+/// The requests that can wait for the task, the ones sent while it is full are dropped.
+static const uint8_t HTTP_REQUEST_ASYNC_QUEUE_SIZE = 4;
+#endif
+
+/// Passes the response body to a callback as it is received.
+class BodyCallbackStream : public Stream {
+ public:
+  explicit BodyCallbackStream(std::function<void(const uint8_t *data, size_t len)> &callback) : callback_(callback) {}
+  size_t write(const uint8_t *data, size_t len) override {
+    this->callback_(data, len);
+    return len;
+  }
+  size_t write(uint8_t data) override { return this->write(&data, 1); }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  void flush() override {}
+
+ protected:
+  std::function<void(const uint8_t *data, size_t len)> &callback_;
+};
+
+/// The scheme, host and port of the URL.
+static std::string url_host(const std::string &url) {
+  const size_t start = url.find("//");
+  if (start == std::string::npos)
+    return url;
+  return url.substr(0, url.find('/', start + 2));
+}
+
+HttpConnection *HttpConnectionPool::get(const std::string &url) {
+  const std::string host = url_host(url);
+  for (auto &connection : this->connections_) {
+    if (connection->host == host) {
+      connection->last_used = millis();
+      return connection.get();
+    }
+  }
+
+  if (this->connections_.size() >= this->max_connections_) {
+    auto oldest = std::min_element(this->connections_.begin(), this->connections_.end(),
+                                   [](const std::unique_ptr<HttpConnection> &a, const std::unique_ptr<HttpConnection> &b) {
+                                     return a->last_used < b->last_used;
+                                   });
+    this->close(oldest->get());
+  }
+
+  auto *connection = new HttpConnection();
+  connection->host = host;
+  connection->last_used = millis();
+  connection->client.setReuse(true);
+#ifdef ARDUINO_ARCH_ESP8266
+  if (host.compare(0, 6, "https:") == 0) {
+    auto *secure = new BearSSL::WiFiClientSecure();
+    secure->setInsecure();
+    secure->setBufferSizes(512, 512);
+    secure->setSession(&connection->session);
+    connection->wifi_client.reset(secure);
+  } else {
+    connection->wifi_client.reset(new WiFiClient());
+  }
+#endif
+  this->connections_.emplace_back(connection);
+  return connection;
+}
+
+void HttpConnectionPool::close(HttpConnection *connection) {
+  connection->client.setReuse(false);
+  connection->client.end();
+  this->connections_.erase(
+      std::remove_if(this->connections_.begin(), this->connections_.end(),
+                     [connection](const std::unique_ptr<HttpConnection> &it) { return it.get() == connection; }),
+      this->connections_.end());
+}
+
 void HttpRequestComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "HTTP Request:");
-  ESP_LOGCONFIG(TAG, "  Timeout: %ums", this->timeout_);
-  ESP_LOGCONFIG(TAG, "  User-Agent: %s", this->useragent_);
+  ESP_LOGCONFIG(TAG, "  Timeout: %ums", this->request_.timeout);
+  ESP_LOGCONFIG(TAG, "  User-Agent: %s", this->request_.useragent);
 }
 
-void HttpRequestComponent::set_url(std::string url) {
-  this->url_ = url;
-  this->secure_ = url.compare(0, 6, "https:") == 0;
+void HttpRequestComponent::set_headers(std::list<Header> headers) {
+  this->request_.headers.clear();
+  for (const auto &header : headers)
+    this->request_.headers.emplace_back(header.name, header.value);
+}
 
-  if (!this->last_url_.empty() && this->url_ != this->last_url_) {
-    // Close connection if url has been changed
-    this->client_.setReuse(false);
-    this->client_.end();
-  }
-  this->client_.setReuse(true);
+void HttpRequestComponent::set_max_connections(uint8_t max_connections) {
+  this->pool_.set_max_connections(max_connections);
+#ifdef ARDUINO_ARCH_ESP32
+  this->async_pool_.set_max_connections(max_connections);
+#endif
 }
 
-void HttpRequestComponent::send() {
+HttpConnection *HttpRequestComponent::perform_(HttpConnectionPool &pool, HttpRequest &request) {
+  HttpConnection *connection = pool.get(request.url);
+  HTTPClient &client = connection->client;
   bool begin_status = false;
-  const String url = this->url_.c_str();
+  const String url = request.url.c_str();
 #ifdef ARDUINO_ARCH_ESP32
-  begin_status = this->client_.begin(url);
+  begin_status = client.begin(url);
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
 #ifndef CLANG_TIDY
-  this->client_.setFollowRedirects(true);
-  this->client_.setRedirectLimit(3);
-  begin_status = this->client_.begin(*this->get_wifi_client_(), url);
+  client.setFollowRedirects(true);
+  client.setRedirectLimit(3);
+  begin_status = client.begin(*connection->wifi_client, url);
 #endif
 #endif
 
   if (!begin_status) {
-    this->client_.end();
-    this->status_set_warning();
-    ESP_LOGW(TAG, "HTTP Request failed at the begin phase. Please check the configuration");
-    return;
+    pool.close(connection);
+    request.status_code = HTTP_REQUEST_BEGIN_FAILED;
+    return nullptr;
   }
 
-  this->client_.setTimeout(this->timeout_);
-  if (this->useragent_ != nullptr) {
-    this->client_.setUserAgent(this->useragent_);
+  client.setTimeout(request.timeout);
+  if (request.useragent != nullptr) {
+    client.setUserAgent(request.useragent);
   }
-  for (const auto &header : this->headers_) {
-    this->client_.addHeader(header.name, header.value, false, true);
+  for (const auto &header : request.headers) {
+    client.addHeader(header.first.c_str(), header.second.c_str(), false, true);
   }
 
-  int http_code = this->client_.sendRequest(this->method_, this->body_.c_str());
-  if (http_code < 0) {
-    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Error: %s", this->url_.c_str(),
-             HTTPClient::errorToString(http_code).c_str());
-    this->status_set_warning();
-    return;
+  request.status_code = client.sendRequest(request.method, (uint8_t *) request.body.data(), request.body.size());
+  if (request.status_code < 0) {
+    // the connection is in an unknown state
+    pool.close(connection);
+    return nullptr;
+  }
+  if (request.body_callback != nullptr) {
+    BodyCallbackStream stream(request.body_callback);
+    client.writeToStream(&stream);
   }
+  return connection;
+}
 
-  if (http_code < 200 || http_code >= 300) {
-    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Code: %d", this->url_.c_str(), http_code);
+void HttpRequestComponent::finish_(HttpRequest &request) {
+  const int http_code = request.status_code;
+  if (http_code == HTTP_REQUEST_BEGIN_FAILED) {
+    ESP_LOGW(TAG, "HTTP Request failed at the begin phase. Please check the configuration");
     this->status_set_warning();
-    return;
+  } else if (http_code == HTTP_REQUEST_QUEUE_FULL) {
+    ESP_LOGW(TAG, "Too many HTTP requests waiting, dropped the one to %s", request.url.c_str());
+    this->status_set_warning();
+  } else if (http_code < 0) {
+    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Error: %s", request.url.c_str(),
+             HTTPClient::errorToString(http_code).c_str());
+    this->status_set_warning();
+  } else if (http_code < 200 || http_code >= 300) {
+    ESP_LOGW(TAG, "HTTP Request failed; URL: %s; Code: %d", request.url.c_str(), http_code);
+    this->status_set_warning();
+  } else {
+    this->status_clear_warning();
+    ESP_LOGD(TAG, "HTTP Request completed; URL: %s; Code: %d", request.url.c_str(), http_code);
   }
 
-  this->status_clear_warning();
-  ESP_LOGD(TAG, "HTTP Request completed; URL: %s; Code: %d", this->url_.c_str(), http_code);
+  if (request.response_callback != nullptr)
+    request.response_callback(http_code);
 }
 
-#ifdef ARDUINO_ARCH_ESP8266
-WiFiClient *HttpRequestComponent::get_wifi_client_() {
-  if (this->secure_) {
-    if (this->wifi_client_secure_ == nullptr) {
-      this->wifi_client_secure_ = new BearSSL::WiFiClientSecure();
-      this->wifi_client_secure_->setInsecure();
-      this->wifi_client_secure_->setBufferSizes(512, 512);
-    }
-    return this->wifi_client_secure_;
-  }
+void HttpRequestComponent::reset_request_() {
+  this->request_.body.clear();
+  this->request_.headers.clear();
+  this->request_.body_callback = nullptr;
+  this->request_.response_callback = nullptr;
+}
 
-  if (this->wifi_client_ == nullptr) {
-    this->wifi_client_ = new WiFiClient();
-  }
-  return this->wifi_client_;
+void HttpRequestComponent::send() {
+  if (this->connection_ != nullptr)
+    this->close();
+  this->connection_ = perform_(this->pool_, this->request_);
+  this->finish_(this->request_);
+  this->reset_request_();
 }
-#endif
 
 void HttpRequestComponent::close() {
-  this->last_url_ = this->url_;
-  this->client_.end();
+  if (this->connection_ == nullptr)
+    return;
+  // with reuse the connection is kept open for the next request to the same host
+  this->connection_->client.end();
+  this->connection_ = nullptr;
 }
 
 const char *HttpRequestComponent::get_string() {
-  static const String STR = this->client_.getString();
+  if (this->connection_ == nullptr)
+    return "";
+  static const String STR = this->connection_->client.getString();
   return STR.c_str();
 }
 
+#ifdef ARDUINO_ARCH_ESP32
+void HttpRequestComponent::send_async() {
+  if (this->async_requests_ == nullptr) {
+    this->async_requests_ = xQueueCreate(HTTP_REQUEST_ASYNC_QUEUE_SIZE, sizeof(HttpRequest *));
+    this->async_results_ = xQueueCreate(HTTP_REQUEST_ASYNC_QUEUE_SIZE, sizeof(HttpRequest *));
+    xTaskCreatePinnedToCore(&HttpRequestComponent::async_task,
+                            "http_request",  // name
+                            8192,            // stack size, enough for a TLS handshake
+                            this,            // task pv params
+                            1,               // priority
+                            nullptr,         // handle
+                            0                // core
+    );
+  }
+
+  auto *request = new HttpRequest(this->request_);
+  this->reset_request_();
+  if (xQueueSend(this->async_requests_, &request, 0) != pdTRUE) {
+    request->status_code = HTTP_REQUEST_QUEUE_FULL;
+    this->finish_(*request);
+    delete request;
+  }
+}
+
+void HttpRequestComponent::async_task(void *params) {
+  auto *parent = reinterpret_cast<HttpRequestComponent *>(params);
+  while (true) {
+    HttpRequest *request;
+    if (xQueueReceive(parent->async_requests_, &request, portMAX_DELAY) != pdTRUE)
+      continue;
+    HttpConnection *connection = perform_(parent->async_pool_, *request);
+    if (connection != nullptr)
+      connection->client.end();
+    // the results are reported from the main loop, wait until it picked up the earlier ones
+    xQueueSend(parent->async_results_, &request, portMAX_DELAY);
+  }
+}
+
+void HttpRequestComponent::loop() {
+  if (this->async_results_ == nullptr)
+    return;
+  HttpRequest *request;
+  while (xQueueReceive(this->async_results_, &request, 0) == pdTRUE) {
+    this->finish_(*request);
+    delete request;
+  }
+}
+#endif
+
 }  // namespace http_request
 }  // namespace esphome
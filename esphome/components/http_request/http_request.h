@@ -2,12 +2,17 @@
 
 #include <list>
 #include <map>
+#include <memory>
+#include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/json/json_util.h"
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <HTTPClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
 #include <ESP8266HTTPClient.h>
@@ -22,38 +27,103 @@ struct Header {
   const char *value;
 };
 
+/// A request with all of its parts copied, so it can be sent later from another task.
+struct HttpRequest {
+  std::string url;
+  const char *method;
+  std::string body;
+  std::vector<std::pair<std::string, std::string>> headers;
+  const char *useragent;
+  uint16_t timeout;
+  /// Called with the parts of the response body as they are received, instead of buffering it. With send_async() it
+  /// is called from the task sending the request.
+  std::function<void(const uint8_t *data, size_t len)> body_callback;
+  /// Called from the main loop with the status code, negative if the request failed before getting a response.
+  std::function<void(int status_code)> response_callback;
+  int status_code;
+};
+
+/// A keep-alive connection to one host.
+struct HttpConnection {
+  /// Scheme, host and port of the URLs using this connection.
+  std::string host;
+  uint32_t last_used;
+#ifdef ARDUINO_ARCH_ESP8266
+  /// The TLS session of the last handshake, resumed when the connection has to be reopened.
+  BearSSL::Session session;
+  // declared before the client, which still uses it when it is destroyed
+  std::unique_ptr<WiFiClient> wifi_client;
+#endif
+  HTTPClient client;
+};
+
+/// The open connections, one per host. The least recently used one is closed when another host needs one.
+class HttpConnectionPool {
+ public:
+  void set_max_connections(uint8_t max_connections) { this->max_connections_ = max_connections; }
+  HttpConnection *get(const std::string &url);
+  /// Close the connection, after an error it can't be reused.
+  void close(HttpConnection *connection);
+
+ protected:
+  std::vector<std::unique_ptr<HttpConnection>> connections_;
+  uint8_t max_connections_{2};
+};
+
 class HttpRequestComponent : public Component {
  public:
   void dump_config() override;
+#ifdef ARDUINO_ARCH_ESP32
+  void loop() override;
+#endif
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
-  void set_url(std::string url);
-  void set_method(const char *method) { this->method_ = method; }
-  void set_useragent(const char *useragent) { this->useragent_ = useragent; }
-  void set_timeout(uint16_t timeout) { this->timeout_ = timeout; }
-  void set_body(std::string body) { this->body_ = body; }
-  void set_headers(std::list<Header> headers) { this->headers_ = headers; }
+  void set_url(std::string url) { this->request_.url = std::move(url); }
+  void set_method(const char *method) { this->request_.method = method; }
+  void set_useragent(const char *useragent) { this->request_.useragent = useragent; }
+  void set_timeout(uint16_t timeout) { this->request_.timeout = timeout; }
+  void set_body(std::string body) { this->request_.body = std::move(body); }
+  void set_headers(std::list<Header> headers);
+  void set_body_callback(std::function<void(const uint8_t *data, size_t len)> &&callback) {
+    this->request_.body_callback = std::move(callback);
+  }
+  void set_response_callback(std::function<void(int status_code)> &&callback) {
+    this->request_.response_callback = std::move(callback);
+  }
+  void set_max_connections(uint8_t max_connections);
+  /// Send the request composed by the setters and wait for the response.
   void send();
+#ifdef ARDUINO_ARCH_ESP32
+  /// Send the request composed by the setters from a separate task, the response callback is called once it is done.
+  void send_async();
+#endif
   void close();
   const char *get_string();
 
  protected:
-  HTTPClient client_{};
-  std::string url_;
-  std::string last_url_;
-  const char *method_;
-  const char *useragent_{nullptr};
-  bool secure_;
-  uint16_t timeout_{5000};
-  std::string body_;
-  std::list<Header> headers_;
-#ifdef ARDUINO_ARCH_ESP8266
-  WiFiClient *wifi_client_{nullptr};
-  BearSSL::WiFiClientSecure *wifi_client_secure_{nullptr};
-  WiFiClient *get_wifi_client_();
+  /// Send the request over a connection of the pool, the connection is left open to read the response.
+  static HttpConnection *perform_(HttpConnectionPool &pool, HttpRequest &request);
+  /// Report the outcome of a request in the main loop.
+  void finish_(HttpRequest &request);
+  /// Clear the parts that only apply to one request, the others are kept for calls that don't set them.
+  void reset_request_();
+
+  HttpRequest request_{};
+  HttpConnectionPool pool_;
+  HttpConnection *connection_{nullptr};
+#ifdef ARDUINO_ARCH_ESP32
+  static void async_task(void *params);
+
+  /// Only used by the task, so it doesn't share connections with the main loop.
+  HttpConnectionPool async_pool_;
+  QueueHandle_t async_requests_{nullptr};
+  QueueHandle_t async_results_{nullptr};
 #endif
 };
 
+/// Fired with the status code once a request is done, negative if it failed before getting a response.
+class HttpRequestResponseTrigger : public Trigger<int> {};
+
 template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
  public:
   HttpRequestSendAction(HttpRequestComponent *parent) : parent_(parent) {}
@@ -69,6 +139,10 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
 
   void set_json(std::function<void(Ts..., JsonObject &)> json_func) { this->json_func_ = json_func; }
 
+  void set_body_func(std::function<void(Ts..., const uint8_t *, size_t)> body_func) { this->body_func_ = body_func; }
+  void register_response_trigger(Trigger<int> *trigger) { this->response_triggers_.push_back(trigger); }
+  void set_async(bool async) { this->async_ = async; }
+
   void play(Ts... x) override {
     this->parent_->set_url(this->url_.value(x...));
     this->parent_->set_method(this->method_.value(x...));
@@ -100,6 +174,22 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
       }
       this->parent_->set_headers(headers);
     }
+    if (this->body_func_ != nullptr) {
+      this->parent_->set_body_callback(
+          [this, x...](const uint8_t *data, size_t len) { this->body_func_(x..., data, len); });
+    }
+    if (!this->response_triggers_.empty()) {
+      this->parent_->set_response_callback([this](int status_code) {
+        for (auto *trigger : this->response_triggers_)
+          trigger->trigger(status_code);
+      });
+    }
+#ifdef ARDUINO_ARCH_ESP32
+    if (this->async_) {
+      this->parent_->send_async();
+      return;
+    }
+#endif
     this->parent_->send();
     this->parent_->close();
   }
@@ -116,6 +206,9 @@ template<typename... Ts> class HttpRequestSendAction : public Action<Ts...> {
   std::map<const char *, TemplatableValue<const char *, Ts...>> headers_{};
   std::map<const char *, TemplatableValue<std::string, Ts...>> json_{};
   std::function<void(Ts..., JsonObject &)> json_func_{nullptr};
+  std::function<void(Ts..., const uint8_t *, size_t)> body_func_{nullptr};
+  std::vector<Trigger<int> *> response_triggers_;
+  bool async_{false};
 };
 
 }  // namespace http_request
@@ -34,28 +34,31 @@ void HTU21DComponent::dump_config() {
   LOG_SENSOR("  ", "Humidity", this->humidity_);
 }
 void HTU21DComponent::update() {
-  uint16_t raw_temperature;
-  if (!this->read_byte_16(HTU21D_REGISTER_TEMPERATURE, &raw_temperature, 50)) {
-    this->status_set_warning();
-    return;
-  }
-
-  float temperature = (float(raw_temperature & 0xFFFC)) * 175.72f / 65536.0f - 46.85f;
-
-  uint16_t raw_humidity;
-  if (!this->read_byte_16(HTU21D_REGISTER_HUMIDITY, &raw_humidity, 50)) {
-    this->status_set_warning();
-    return;
-  }
+  this->read_bytes_async(HTU21D_REGISTER_TEMPERATURE, 2, 50, [this](bool success, const uint8_t *data, uint8_t len) {
+    if (!success) {
+      this->status_set_warning();
+      return;
+    }
+    const uint16_t raw_temperature = encode_uint16(data[0], data[1]);
+    const float temperature = (float(raw_temperature & 0xFFFC)) * 175.72f / 65536.0f - 46.85f;
 
-  float humidity = (float(raw_humidity & 0xFFFC)) * 125.0f / 65536.0f - 6.0f;
-  ESP_LOGD(TAG, "Got Temperature=%.1f°C Humidity=%.1f%%", temperature, humidity);
+    this->read_bytes_async(HTU21D_REGISTER_HUMIDITY, 2, 50,
+                           [this, temperature](bool success, const uint8_t *data, uint8_t len) {
+                             if (!success) {
+                               this->status_set_warning();
+                               return;
+                             }
+                             const uint16_t raw_humidity = encode_uint16(data[0], data[1]);
+                             const float humidity = (float(raw_humidity & 0xFFFC)) * 125.0f / 65536.0f - 6.0f;
+                             ESP_LOGD(TAG, "Got Temperature=%.1f°C Humidity=%.1f%%", temperature, humidity);
 
-  if (this->temperature_ != nullptr)
-    this->temperature_->publish_state(temperature);
-  if (this->humidity_ != nullptr)
-    this->humidity_->publish_state(humidity);
-  this->status_clear_warning();
+                             if (this->temperature_ != nullptr)
+                               this->temperature_->publish_state(temperature);
+                             if (this->humidity_ != nullptr)
+                               this->humidity_->publish_state(humidity);
+                             this->status_clear_warning();
+                           });
+  });
 }
 float HTU21DComponent::get_setup_priority() const { return setup_priority::DATA; }
 
@@ -1,6 +1,7 @@
 #include "hx711.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/application.h"
 
 namespace esphome {
 namespace hx711 {
@@ -15,16 +16,54 @@ void HX711Sensor::setup() {
 
   // Read sensor once without publishing to set the gain
   this->read_sensor_(nullptr);
+
+  if (this->continuous_mode_) {
+    // DOUT goes low once a conversion is ready
+    this->dout_pin_->attach_interrupt(HX711Sensor::gpio_intr, this, FALLING);
+  }
+}
+void ICACHE_RAM_ATTR HX711Sensor::gpio_intr(HX711Sensor *arg) {
+  arg->data_ready_ = true;
+  App.wake_loop_isr();
 }
 
 void HX711Sensor::dump_config() {
   LOG_SENSOR("", "HX711", this);
   LOG_PIN("  DOUT Pin: ", this->dout_pin_);
   LOG_PIN("  SCK Pin: ", this->sck_pin_);
+  ESP_LOGCONFIG(TAG, "  Continuous Mode: %s", YESNO(this->continuous_mode_));
   LOG_UPDATE_INTERVAL(this);
 }
 float HX711Sensor::get_setup_priority() const { return setup_priority::DATA; }
+bool HX711Sensor::is_loop_idle() { return !this->data_ready_; }
+void HX711Sensor::loop() {
+  if (!this->data_ready_ || this->dout_pin_->digital_read())
+    return;
+
+  uint32_t result;
+  if (this->read_sensor_(&result)) {
+    this->sample_sum_ += static_cast<int32_t>(result);
+    this->sample_count_++;
+  }
+  // DOUT also changes while the data is shifted out, those edges don't mean a new conversion
+  this->data_ready_ = false;
+}
 void HX711Sensor::update() {
+  if (this->continuous_mode_) {
+    if (this->sample_count_ == 0) {
+      ESP_LOGW(TAG, "'%s': No conversion since the last update!", this->name_.c_str());
+      this->status_set_warning();
+      return;
+    }
+    // the mean of all conversions since the last update goes through the filters as one value
+    const float value = float(this->sample_sum_) / this->sample_count_;
+    ESP_LOGD(TAG, "'%s': Got value %.1f (mean of %u)", this->name_.c_str(), value, this->sample_count_);
+    this->sample_sum_ = 0;
+    this->sample_count_ = 0;
+    this->publish_state(value);
+    return;
+  }
+
   uint32_t result;
   if (this->read_sensor_(&result)) {
     int32_t value = static_cast<int32_t>(result);
@@ -18,18 +18,31 @@ class HX711Sensor : public sensor::Sensor, public PollingComponent {
   void set_dout_pin(GPIOPin *dout_pin) { dout_pin_ = dout_pin; }
   void set_sck_pin(GPIOPin *sck_pin) { sck_pin_ = sck_pin; }
   void set_gain(HX711Gain gain) { gain_ = gain; }
+  /** Read every conversion when DOUT signals that it's ready, instead of one per update.
+   *
+   * The samples are averaged and their mean is published with each update.
+   */
+  void set_continuous_mode(bool continuous_mode) { continuous_mode_ = continuous_mode; }
 
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override;
+  void loop() override;
+  bool is_loop_idle() override;
   void update() override;
 
  protected:
+  static void gpio_intr(HX711Sensor *arg);
+
   bool read_sensor_(uint32_t *result);
 
   GPIOPin *dout_pin_;
   GPIOPin *sck_pin_;
   HX711Gain gain_{HX711_GAIN_128};
+  bool continuous_mode_{false};
+  volatile bool data_ready_{false};
+  int64_t sample_sum_{0};
+  uint32_t sample_count_{0};
 };
 
 }  // namespace hx711
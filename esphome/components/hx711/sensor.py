@@ -8,6 +8,7 @@ hx711_ns = cg.esphome_ns.namespace('hx711')
 HX711Sensor = hx711_ns.class_('HX711Sensor', sensor.Sensor, cg.PollingComponent)
 
 CONF_DOUT_PIN = 'dout_pin'
+CONF_CONTINUOUS_MODE = 'continuous_mode'
 
 HX711Gain = hx711_ns.enum('HX711Gain')
 GAINS = {
@@ -21,6 +22,7 @@ CONFIG_SCHEMA = sensor.sensor_schema('', ICON_SCALE, 0).extend({
     cv.Required(CONF_DOUT_PIN): pins.gpio_input_pin_schema,
     cv.Required(CONF_CLK_PIN): pins.gpio_output_pin_schema,
     cv.Optional(CONF_GAIN, default=128): cv.enum(GAINS, int=True),
+    cv.Optional(CONF_CONTINUOUS_MODE, default=False): cv.boolean,
 }).extend(cv.polling_component_schema('60s'))
 
 
@@ -34,3 +36,4 @@ def to_code(config):
     sck_pin = yield cg.gpio_pin_expression(config[CONF_CLK_PIN])
     cg.add(var.set_sck_pin(sck_pin))
     cg.add(var.set_gain(config[CONF_GAIN]))
+    cg.add(var.set_continuous_mode(config[CONF_CONTINUOUS_MODE]))
@@ -2,7 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
 from esphome.const import CONF_FREQUENCY, CONF_ID, CONF_SCAN, CONF_SCL, CONF_SDA, CONF_ADDRESS, \
-    CONF_I2C_ID
+    CONF_I2C_ID, CONF_UPDATE_INTERVAL
 from esphome.core import coroutine, coroutine_with_priority
 
 CODEOWNERS = ['@esphome/core']
@@ -10,6 +10,8 @@ i2c_ns = cg.esphome_ns.namespace('i2c')
 I2CComponent = i2c_ns.class_('I2CComponent', cg.Component)
 I2CDevice = i2c_ns.class_('I2CDevice')
 
+CONF_BATCH_UPDATES = 'batch_updates'
+
 MULTI_CONF = True
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(I2CComponent),
@@ -18,6 +20,7 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_FREQUENCY, default='50kHz'):
         cv.All(cv.frequency, cv.Range(min=0, min_included=False)),
     cv.Optional(CONF_SCAN, default=True): cv.boolean,
+    cv.Optional(CONF_BATCH_UPDATES, default=False): cv.boolean,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -31,6 +34,7 @@ def to_code(config):
     cg.add(var.set_scl_pin(config[CONF_SCL]))
     cg.add(var.set_frequency(int(config[CONF_FREQUENCY])))
     cg.add(var.set_scan(config[CONF_SCAN]))
+    cg.add(var.set_batch_updates(config[CONF_BATCH_UPDATES]))
     cg.add_library('Wire', None)
 
 
@@ -55,10 +59,13 @@ def i2c_device_schema(default_address):
 def register_i2c_device(var, config):
     """Register an i2c device with the given config.
 
-    Sets the i2c bus to use and the i2c address.
+    Sets the i2c bus to use and the i2c address. Polling devices are also registered with the bus,
+    so it can batch their updates.
 
     This is a coroutine, you need to await it with a 'yield' expression!
     """
     parent = yield cg.get_variable(config[CONF_I2C_ID])
     cg.add(var.set_i2c_parent(parent))
     cg.add(var.set_i2c_address(config[CONF_ADDRESS]))
+    if CONF_UPDATE_INTERVAL in config:
+        cg.add(parent.register_polling_device(var))
@@ -2,12 +2,19 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
+#include <map>
+#ifdef ARDUINO_ARCH_ESP8266
+#include <twi.h>
+#endif
 
 namespace esphome {
 namespace i2c {
 
 static const char *TAG = "i2c";
 
+/// The largest transaction of a long write, including the register.
+static const size_t I2C_LONG_WRITE_SIZE = 256;
+
 I2CComponent::I2CComponent() {
 #ifdef ARDUINO_ARCH_ESP32
   if (next_i2c_bus_num_ == 0)
@@ -23,12 +30,22 @@ I2CComponent::I2CComponent() {
 void I2CComponent::setup() {
   this->wire_->begin(this->sda_pin_, this->scl_pin_);
   this->wire_->setClock(this->frequency_);
+
+  this->set_interval("statistics", 60000, [this]() {
+    this->bus_utilization_ = this->busy_time_ / 600000.0f;
+    this->busy_time_ = 0;
+    ESP_LOGV(TAG, "Bus utilization %.2f%%, %u NACKs, %u errors", this->bus_utilization_, this->nack_count_,
+             this->error_count_);
+  });
 }
 void I2CComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "I2C Bus:");
   ESP_LOGCONFIG(TAG, "  SDA Pin: GPIO%u", this->sda_pin_);
   ESP_LOGCONFIG(TAG, "  SCL Pin: GPIO%u", this->scl_pin_);
   ESP_LOGCONFIG(TAG, "  Frequency: %u Hz", this->frequency_);
+  if (this->batch_updates_) {
+    ESP_LOGCONFIG(TAG, "  Batching updates of %u polling devices", this->polling_devices_.size());
+  }
   if (this->scan_) {
     ESP_LOGI(TAG, "Scanning i2c bus for active devices...");
     uint8_t found = 0;
@@ -52,13 +69,111 @@ void I2CComponent::dump_config() {
 }
 float I2CComponent::get_setup_priority() const { return setup_priority::BUS; }
 
+void I2CComponent::queue_transaction(uint8_t address, std::vector<uint8_t> write, uint8_t read_len,
+                                     uint32_t conversion, I2CCallback &&callback) {
+  Transaction transaction{};
+  transaction.address = address;
+  transaction.read_len = read_len;
+  transaction.conversion = conversion;
+  transaction.data = std::move(write);
+  transaction.callback = std::move(callback);
+  this->transactions_.push_back(std::move(transaction));
+}
+
+bool I2CComponent::is_loop_idle() { return this->transactions_.empty() && (!this->batch_updates_ || this->batched_); }
+
+void I2CComponent::batch_polling_devices_() {
+  for (auto *device : this->polling_devices_) {
+    const uint32_t state = device->get_component_state() & COMPONENT_STATE_MASK;
+    if (state == COMPONENT_STATE_CONSTRUCTION || state == COMPONENT_STATE_SETUP)
+      return;
+  }
+  this->batched_ = true;
+
+  std::map<uint32_t, std::vector<PollingComponent *>> groups;
+  for (auto *device : this->polling_devices_) {
+    // 'never' stays never
+    if (!device->is_failed() && device->get_update_interval() != 4294967295UL)
+      groups[device->get_update_interval()].push_back(device);
+  }
+  for (auto &group : groups) {
+    if (group.second.size() < 2)
+      continue;
+    ESP_LOGD(TAG, "Updating %u devices together every %u ms", group.second.size(), group.first);
+    for (auto *device : group.second)
+      App.scheduler.cancel_interval(device, "update");
+    std::vector<PollingComponent *> devices = std::move(group.second);
+    this->set_interval(group.first, [devices]() {
+      for (auto *device : devices) {
+        if (!device->is_failed())
+          device->update();
+      }
+    });
+  }
+}
+
+void I2CComponent::loop() {
+  if (this->batch_updates_ && !this->batched_)
+    this->batch_polling_devices_();
+  if (this->transactions_.empty())
+    return;
+
+  // callbacks run after the loop below, they may queue the next transaction
+  std::vector<Transaction> finished;
+  for (auto it = this->transactions_.begin(); it != this->transactions_.end();) {
+    if (!it->started) {
+      bool busy = false;
+      for (auto prev = this->transactions_.begin(); prev != it; prev++) {
+        if (prev->address == it->address) {
+          busy = true;
+          break;
+        }
+      }
+      if (busy) {
+        it++;
+        continue;
+      }
+
+      it->started = true;
+      it->started_at = millis();
+      it->success = it->data.empty() || this->write_bytes_raw(it->address, it->data.data(), it->data.size());
+    }
+    // no need to wait for the answer of a device that didn't take the request
+    if (it->success && millis() - it->started_at < it->conversion) {
+      it++;
+      continue;
+    }
+
+    it->data.resize(it->read_len);
+    if (it->success && it->read_len > 0)
+      it->success = this->raw_receive(it->address, it->data.data(), it->read_len);
+    finished.push_back(std::move(*it));
+    it = this->transactions_.erase(it);
+  }
+
+  for (auto &transaction : finished) {
+    if (transaction.callback)
+      transaction.callback(transaction.success, transaction.data.data(), transaction.data.size());
+  }
+}
+
 void I2CComponent::raw_begin_transmission(uint8_t address) {
   ESP_LOGVV(TAG, "Beginning Transmission to 0x%02X:", address);
   this->wire_->beginTransmission(address);
 }
 bool I2CComponent::raw_end_transmission(uint8_t address, bool send_stop) {
+  const uint32_t start = micros();
   uint8_t status = this->wire_->endTransmission(send_stop);
+  this->busy_time_ += micros() - start;
   ESP_LOGVV(TAG, "    Transmission ended. Status code: 0x%02X", status);
+  return this->check_transmission_status_(address, status);
+}
+bool I2CComponent::check_transmission_status_(uint8_t address, uint8_t status) {
+  if (status == 2 || status == 3) {
+    this->nack_count_++;
+  } else if (status != 0) {
+    this->error_count_++;
+  }
 
   switch (status) {
     case 0:
@@ -81,8 +196,12 @@ bool I2CComponent::raw_end_transmission(uint8_t address, bool send_stop) {
 }
 bool I2CComponent::raw_request_from(uint8_t address, uint8_t len) {
   ESP_LOGVV(TAG, "Requesting %u bytes from 0x%02X:", len, address);
+  const uint32_t start = micros();
   uint8_t ret = this->wire_->requestFrom(address, len);
+  this->busy_time_ += micros() - start;
   if (ret != len) {
+    // Wire doesn't tell a NACK of the address apart from a timeout here
+    this->error_count_++;
     ESP_LOGW(TAG, "Requesting %u bytes from 0x%02X failed!", len, address);
     return false;
   }
@@ -164,6 +283,34 @@ bool I2CComponent::write_bytes_raw(uint8_t address, const uint8_t *data, uint8_t
   this->raw_write(address, data, len);
   return this->raw_end_transmission(address);
 }
+bool HOT I2CComponent::write_bytes_long(uint8_t address, uint8_t a_register, const uint8_t *data, size_t len) {
+  // the register has to lead every transaction, so the data is copied behind it
+  if (this->long_write_buffer_.empty())
+    this->long_write_buffer_.resize(I2C_LONG_WRITE_SIZE);
+  uint8_t *buffer = this->long_write_buffer_.data();
+  buffer[0] = a_register;
+
+  for (size_t pos = 0; pos < len;) {
+    const size_t chunk = std::min(len - pos, I2C_LONG_WRITE_SIZE - 1);
+    memcpy(buffer + 1, data + pos, chunk);
+    pos += chunk;
+
+    ESP_LOGVV(TAG, "Writing %zu bytes to 0x%02X", chunk + 1, address);
+    const uint32_t start = micros();
+#ifdef ARDUINO_ARCH_ESP32
+    // hands the buffer to the HAL's command queue directly, endTransmission() does the same with Wire's buffer
+    uint8_t status = this->wire_->writeTransmission(address, buffer, chunk + 1);
+#else
+    // what endTransmission() calls with Wire's buffer, the ESP8266 has a single (software) bus
+    uint8_t status = twi_writeTo(address, buffer, chunk + 1, true);
+#endif
+    this->busy_time_ += micros() - start;
+    App.feed_wdt();
+    if (!this->check_transmission_status_(address, status))
+      return false;
+  }
+  return true;
+}
 bool I2CComponent::write_bytes_16(uint8_t address, uint8_t a_register, const uint16_t *data, uint8_t len) {
   this->raw_begin_transmission(address);
   this->raw_write(address, &a_register, 1);
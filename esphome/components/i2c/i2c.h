@@ -1,6 +1,9 @@
 #pragma once
 
 #include <Wire.h>
+#include <deque>
+#include <functional>
+#include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
@@ -9,6 +12,9 @@ namespace i2c {
 
 #define LOG_I2C_DEVICE(this) ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
 
+/// Called when an asynchronous transaction finished with the bytes read, success is false if the device didn't ack.
+using I2CCallback = std::function<void(bool success, const uint8_t *data, uint8_t len)>;
+
 /** The I2CComponent is the base of ESPHome's i2c communication.
  *
  * It handles setting up the bus (with pins, clock frequency) and provides nice helper functions to
@@ -30,6 +36,19 @@ class I2CComponent : public Component {
   void set_scl_pin(uint8_t scl_pin) { scl_pin_ = scl_pin; }
   void set_frequency(uint32_t frequency) { frequency_ = frequency; }
   void set_scan(bool scan) { scan_ = scan; }
+  /** Run the update() of the polling devices on this bus that share an update interval together.
+   *
+   * Their conversions then overlap (see queue_transaction()) and the bus is woken up once per interval.
+   */
+  void set_batch_updates(bool batch_updates) { batch_updates_ = batch_updates; }
+  void register_polling_device(PollingComponent *device) { this->polling_devices_.push_back(device); }
+
+  /// The share of the time spent transferring on the bus during the last minute, in percent.
+  float get_bus_utilization() const { return this->bus_utilization_; }
+  /// The number of transfers the addressed device didn't acknowledge.
+  uint32_t get_nack_count() const { return this->nack_count_; }
+  /// The number of transfers that failed otherwise, for example with a timeout.
+  uint32_t get_error_count() const { return this->error_count_; }
 
   /** Read len amount of bytes from a register into data. Optionally with a conversion time after
    * writing the register value to the bus.
@@ -72,6 +91,13 @@ class I2CComponent : public Component {
   bool write_bytes(uint8_t address, uint8_t a_register, const uint8_t *data, uint8_t len);
   bool write_bytes_raw(uint8_t address, const uint8_t *data, uint8_t len);
 
+  /** Write len bytes to the specified register for address in as few transactions as possible.
+   *
+   * Bypasses the 128 byte buffer of Wire, so bulk data like the framebuffer of a display goes out in transactions of
+   * up to 255 bytes, each starting with a_register, instead of in many small writes.
+   */
+  bool write_bytes_long(uint8_t address, uint8_t a_register, const uint8_t *data, size_t len);
+
   /** Write len amount of 16-bit words (MSB first) to the specified register for address.
    *
    * @param address The address to use for the transmission.
@@ -88,6 +114,20 @@ class I2CComponent : public Component {
   /// Write a single 16-bit word of data into the specified register of address. Return true if successful.
   bool write_byte_16(uint8_t address, uint8_t a_register, uint16_t data);
 
+  /** Queue a transaction that writes data, waits for the conversion time and then reads read_len bytes.
+   *
+   * Unlike the blocking methods above, the conversion time is spent in loop() without delaying other components.
+   * Transactions of different addresses run interleaved, those of the same address in the order they were queued.
+   *
+   * @param address The address of the device.
+   * @param write The bytes to write first, usually the register. Can be empty.
+   * @param read_len The amount of bytes to read afterwards. Can be 0.
+   * @param conversion The time in ms between writing and reading.
+   * @param callback Called from loop() when the transaction has finished.
+   */
+  void queue_transaction(uint8_t address, std::vector<uint8_t> write, uint8_t read_len, uint32_t conversion,
+                         I2CCallback &&callback);
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Begin a write transmission to an address.
@@ -119,15 +159,47 @@ class I2CComponent : public Component {
   /// Setup the i2c. bus
   void setup() override;
   void dump_config() override;
+  /// Advance the queued transactions.
+  void loop() override;
+  bool is_loop_idle() override;
   /// Set a very high setup priority to make sure it's loaded before all other hardware.
   float get_setup_priority() const override;
 
  protected:
+  struct Transaction {
+    uint8_t address;
+    bool started;
+    bool success;
+    uint8_t read_len;
+    uint32_t conversion;
+    uint32_t started_at;
+    /// The bytes to write, reused for the bytes read.
+    std::vector<uint8_t> data;
+    I2CCallback callback;
+  };
+
+  /// Log and count the status of a write, as returned by Wire's endTransmission(). Returns true if successful.
+  bool check_transmission_status_(uint8_t address, uint8_t status);
+
   TwoWire *wire_;
+  /// The register and data of a long write, allocated on the first one.
+  std::vector<uint8_t> long_write_buffer_;
   uint8_t sda_pin_;
   uint8_t scl_pin_;
   uint32_t frequency_;
   bool scan_;
+  std::deque<Transaction> transactions_;
+
+  /// Replace the update intervals of the polling devices with one interval per group, once all are set up.
+  void batch_polling_devices_();
+  bool batch_updates_{false};
+  bool batched_{false};
+  std::vector<PollingComponent *> polling_devices_;
+
+  uint32_t busy_time_{0};
+  float bus_utilization_{0.0f};
+  uint32_t nack_count_{0};
+  uint32_t error_count_{0};
 };
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -257,6 +329,11 @@ class I2CDevice {
   }
   bool write_bytes_raw(const std::vector<uint8_t> &data) { return this->write_bytes_raw(data.data(), data.size()); }
 
+  /// Write len bytes to the specified register, see I2CComponent::write_bytes_long().
+  bool write_bytes_long(uint8_t a_register, const uint8_t *data, size_t len) {
+    return this->parent_->write_bytes_long(this->address_, a_register, data, len);
+  }
+
   template<size_t N> bool write_bytes(uint8_t a_register, const std::array<uint8_t, N> &data) {
     return this->write_bytes(a_register, data.data(), data.size());
   }
@@ -279,6 +356,20 @@ class I2CDevice {
   /// Write a single 16-bit word of data into the specified register. Return true if successful.
   bool write_byte_16(uint8_t a_register, uint16_t data);
 
+  /// Like read_bytes(), but the conversion time doesn't block, see I2CComponent::queue_transaction().
+  void read_bytes_async(uint8_t a_register, uint8_t len, uint32_t conversion, I2CCallback &&callback) {
+    this->parent_->queue_transaction(this->address_, {a_register}, len, conversion, std::move(callback));
+  }
+  void read_bytes_raw_async(uint8_t len, I2CCallback &&callback) {
+    this->parent_->queue_transaction(this->address_, {}, len, 0, std::move(callback));
+  }
+  /// Like write_bytes(), the callback gets no data.
+  void write_bytes_async(uint8_t a_register, const uint8_t *data, uint8_t len, I2CCallback &&callback) {
+    std::vector<uint8_t> write{a_register};
+    write.insert(write.end(), data, data + len);
+    this->parent_->queue_transaction(this->address_, std::move(write), 0, 0, std::move(callback));
+  }
+
  protected:
   uint8_t address_{0x00};
   I2CComponent *parent_{nullptr};
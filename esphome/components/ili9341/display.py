@@ -30,7 +30,7 @@ CONFIG_SCHEMA = cv.All(display.FULL_DISPLAY_SCHEMA.extend({
     cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
     cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
     cv.Optional(CONF_LED_PIN): pins.gpio_output_pin_schema,
-}).extend(cv.polling_component_schema('1s')).extend(spi.spi_device_schema()),
+}).extend(display.RENDER_TASK_SCHEMA).extend(cv.polling_component_schema('1s')).extend(spi.spi_device_schema()),
                        cv.has_at_most_one_key(CONF_PAGES, CONF_LAMBDA))
 
 
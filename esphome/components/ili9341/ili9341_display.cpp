@@ -79,34 +79,46 @@ uint8_t ILI9341Display::read_command(uint8_t command_byte, uint8_t index) {
 }
 
 void ILI9341Display::update() {
-  this->do_update_();
-  this->display_();
+  if (!this->render_()) {
+    ESP_LOGV(TAG, "Still drawing the last frame, skipping update");
+    return;
+  }
+  if (!this->is_rendering_()) {
+    this->flush_frame_();
+    return;
+  }
+  // the render task draws the frame, send it once it is done
+  this->run_steps("flush", 0, [this]() {
+    if (this->is_rendering_())
+      return false;
+    this->flush_frame_();
+    return true;
+  });
 }
 
-void ILI9341Display::display_() {
-  // we will only update the changed window to the display
-  int w = this->x_high_ - this->x_low_ + 1;
-  int h = this->y_high_ - this->y_low_ + 1;
+void ILI9341Display::flush_frame_() {
+  const uint32_t start = micros();
+  // only the damaged windows are sent to the display
+  this->flush_damage_();
+  this->flush_time_ = micros() - start;
+  ESP_LOGV(TAG, "Frame drawn in %u us, sent in %u us", this->render_time_, this->flush_time_);
+}
 
-  set_addr_window_(this->x_low_, this->y_low_, w, h);
+void ILI9341Display::write_region_(int x, int y, int width, int height) {
+  this->set_addr_window_(x, y, width, height);
   this->start_data_();
-  uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
-  for (uint16_t row = 0; row < h; row++) {
-    for (uint16_t col = 0; col < w; col++) {
-      uint32_t pos = start_pos + (row * width_) + col;
-
-      uint16_t color = convert_to_16bit_color_(buffer_[pos]);
-      this->write_byte(color >> 8);
-      this->write_byte(color);
+  // one transfer per line instead of a transfer per byte
+  std::vector<uint8_t> line(width * 2);
+  for (int row = y; row < y + height; row++) {
+    const uint8_t *pos = this->buffer_ + row * this->width_ + x;
+    for (int col = 0; col < width; col++) {
+      uint16_t color = convert_to_16bit_color_(*pos++);
+      line[col * 2] = color >> 8;
+      line[col * 2 + 1] = color;
     }
+    this->write_array(line.data(), line.size());
   }
   this->end_data_();
-
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
 uint16_t ILI9341Display::convert_to_16bit_color_(uint8_t color_8bit) {
@@ -132,10 +144,6 @@ uint8_t ILI9341Display::convert_to_8bit_color_(uint16_t color_16bit) {
 void ILI9341Display::fill(Color color) {
   auto color565 = color.to_rgb_565();
   memset(this->buffer_, convert_to_8bit_color_(color565), this->get_buffer_length_());
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
 }
 
 void ILI9341Display::fill_internal_(Color color) {
@@ -149,23 +157,44 @@ void ILI9341Display::fill_internal_(Color color) {
     buffer_[i] = 0;
   }
   this->end_data_();
+  this->invalidate_damage_();
 }
 
 void HOT ILI9341Display::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0)
     return;
 
-  // low and high watermark may speed up drawing from buffer
-  this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-  this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-  this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-  this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-
   uint32_t pos = (y * width_) + x;
   auto color565 = color.to_rgb_565();
   buffer_[pos] = convert_to_8bit_color_(color565);
 }
 
+void HOT ILI9341Display::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  const uint8_t value = convert_to_8bit_color_(color.to_rgb_565());
+  for (int row = y; row < y + height; row++)
+    memset(this->buffer_ + row * this->width_ + x, value, width);
+}
+
+void HOT ILI9341Display::blit_internal(int x, int y, display::Image *image, int src_x, int src_y, int width,
+                                       int height, Color color_on, Color color_off) {
+  const uint8_t value_on = convert_to_8bit_color_(color_on.to_rgb_565());
+  const uint8_t value_off = convert_to_8bit_color_(color_off.to_rgb_565());
+  const display::ImageType type = image->get_type();
+  for (int row = 0; row < height; row++) {
+    uint8_t *pos = this->buffer_ + (y + row) * this->width_ + x;
+    const int img_y = src_y + row;
+    for (int img_x = src_x; img_x < src_x + width; img_x++) {
+      if (type == display::IMAGE_TYPE_BINARY) {
+        *pos++ = image->get_pixel(img_x, img_y) ? value_on : value_off;
+      } else {
+        const Color color = type == display::IMAGE_TYPE_GRAYSCALE ? image->get_grayscale_pixel(img_x, img_y)
+                                                                   : image->get_color_pixel(img_x, img_y);
+        *pos++ = convert_to_8bit_color_(color.to_rgb_565());
+      }
+    }
+  }
+}
+
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
 // values per bit is huge
 uint32_t ILI9341Display::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal(); }
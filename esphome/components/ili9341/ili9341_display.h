@@ -39,10 +39,14 @@ class ILI9341Display : public PollingComponent,
   void setup() override {
     this->setup_pins_();
     this->initialize();
+    this->init_damage_tracking_(1);
   }
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
+  void blit_internal(int x, int y, display::Image *image, int src_x, int src_y, int width, int height, Color color_on,
+                     Color color_off) override;
   void setup_pins_();
 
   void init_lcd_(const uint8_t *init_cmd);
@@ -50,17 +54,14 @@ class ILI9341Display : public PollingComponent,
   void invert_display_(bool invert);
   void reset_();
   void fill_internal_(Color color);
-  void display_();
+  void flush_frame_();
+  void write_region_(int x, int y, int width, int height) override;
   uint16_t convert_to_16bit_color_(uint8_t color_8bit);
   uint8_t convert_to_8bit_color_(uint16_t color_16bit);
 
   ILI9341Model model_;
   int16_t width_{320};   ///< Display width as modified by current rotation
   int16_t height_{240};  ///< Display height as modified by current rotation
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
 
   uint32_t get_buffer_length_();
   int get_width_internal() override;
@@ -22,6 +22,75 @@ IMAGE_TYPE = {
 Image_ = display.display_ns.class_('Image')
 
 CONF_RAW_DATA_ID = 'raw_data_id'
+CONF_COMPRESSION = 'compression'
+COMPRESSION_TYPES = ['NONE', 'RLE']
+
+
+def rle_encode_rows(rows, type_):
+    """Run-length encode the rows of one frame, must match ImageDecoder in display_buffer.cpp.
+
+    The pixels are bools for BINARY images, the gray value for GRAYSCALE and (r, g, b) tuples for RGB24.
+    """
+    data = []
+    for row in rows:
+        runs = []
+        for pix in row:
+            if runs and runs[-1][0] == pix and runs[-1][1] < 128:
+                runs[-1][1] += 1
+            else:
+                runs.append([pix, 1])
+
+        if type_ == 'BINARY':
+            for pix, length in runs:
+                data.append((0x80 if pix else 0x00) | (length - 1))
+            continue
+
+        def pixel_bytes(pix):
+            return [pix] if type_ == 'GRAYSCALE' else list(pix)
+
+        literals = []
+
+        def flush_literals():
+            if literals:
+                data.append(len(literals) - 1)
+                for lit in literals:
+                    data.extend(pixel_bytes(lit))
+                del literals[:]
+
+        for pix, length in runs:
+            if length == 1:
+                literals.append(pix)
+                if len(literals) == 128:
+                    flush_literals()
+                continue
+            flush_literals()
+            data.append(0x80 | (length - 1))
+            data.extend(pixel_bytes(pix))
+        flush_literals()
+    return data
+
+
+def rle_encode_frames(frames, type_):
+    """Encode all frames and prepend the table of their little endian uint32 offsets."""
+    encoded = [rle_encode_rows(rows, type_) for rows in frames]
+    data = []
+    offset = 4 * len(encoded)
+    for frame in encoded:
+        data += [(offset >> shift) & 0xFF for shift in (0, 8, 16, 24)]
+        offset += len(frame)
+    for frame in encoded:
+        data += frame
+    return data
+
+
+def frame_rows(image, type_):
+    """The rows of an image already converted to the mode of type_, in the pixel format of rle_encode_rows()."""
+    width, height = image.size
+    if type_ == 'BINARY':
+        # black pixels are set
+        return [[not image.getpixel((x, y)) for x in range(width)] for y in range(height)]
+    return [[image.getpixel((x, y)) for x in range(width)] for y in range(height)]
+
 
 IMAGE_SCHEMA = cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(Image_),
@@ -29,6 +98,7 @@ IMAGE_SCHEMA = cv.Schema({
     cv.Optional(CONF_RESIZE): cv.dimensions,
     cv.Optional(CONF_TYPE, default='BINARY'): cv.enum(IMAGE_TYPE, upper=True),
     cv.Optional(CONF_DITHER, default='NONE'): cv.one_of("NONE", "FLOYDSTEINBERG", upper=True),
+    cv.Optional(CONF_COMPRESSION, default='NONE'): cv.one_of(*COMPRESSION_TYPES, upper=True),
     cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
 })
 
@@ -88,7 +158,13 @@ def to_code(config):
                 pos = x + y * width8
                 data[pos // 8] |= 0x80 >> (pos % 8)
 
+    compressed = config[CONF_COMPRESSION] == 'RLE'
+    if compressed:
+        data = rle_encode_frames([frame_rows(image, config[CONF_TYPE])], config[CONF_TYPE])
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
-    cg.new_Pvariable(config[CONF_ID], prog_arr, width, height,
-                     IMAGE_TYPE[config[CONF_TYPE]])
+    var = cg.new_Pvariable(config[CONF_ID], prog_arr, width, height,
+                           IMAGE_TYPE[config[CONF_TYPE]])
+    if compressed:
+        cg.add(var.set_compressed(True))
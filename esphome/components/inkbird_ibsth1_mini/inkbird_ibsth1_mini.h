@@ -13,6 +13,9 @@ class InkbirdIBSTH1_MINI : public Component, public esp32_ble_tracker::ESPBTDevi
  public:
   void set_address(uint64_t address) { address_ = address; }
 
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    filter.addresses.push_back(this->address_);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 
   void dump_config() override;
@@ -35,37 +35,59 @@ void Inkplate6::setup() {
   this->display_data_5_pin_->setup();
   this->display_data_6_pin_->setup();
   this->display_data_7_pin_->setup();
+  this->setup_data_pins_();
 
   this->clean();
+  this->refresh_ = this->refresh_planner_.plan(this->greyscale_ ? this->buffer_ : this->partial_buffer_);
   this->display();
 }
+void Inkplate6::setup_data_pins_() {
+  const uint32_t pins[8] = {
+      1u << this->display_data_0_pin_->get_pin(), 1u << this->display_data_1_pin_->get_pin(),
+      1u << this->display_data_2_pin_->get_pin(), 1u << this->display_data_3_pin_->get_pin(),
+      1u << this->display_data_4_pin_->get_pin(), 1u << this->display_data_5_pin_->get_pin(),
+      1u << this->display_data_6_pin_->get_pin(), 1u << this->display_data_7_pin_->get_pin(),
+  };
+  this->data_mask_ = 0;
+  for (uint32_t pin : pins)
+    this->data_mask_ |= pin;
+  for (uint16_t data = 0; data < 256; data++) {
+    uint32_t bits = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+      if (data & (1 << i))
+        bits |= pins[i];
+    }
+    this->data_pin_lut_[data] = bits;
+  }
+  this->cl_mask_ = 1u << this->cl_pin_->get_pin();
+}
 void Inkplate6::initialize_() {
   uint32_t buffer_size = this->get_buffer_length_();
 
   if (this->partial_buffer_ != nullptr) {
-    free(this->partial_buffer_);  // NOLINT
+    free_large(this->partial_buffer_);
   }
   if (this->partial_buffer_2_ != nullptr) {
-    free(this->partial_buffer_2_);  // NOLINT
+    free_large(this->partial_buffer_2_);
   }
   if (this->buffer_ != nullptr) {
-    free(this->buffer_);  // NOLINT
+    free_large(this->buffer_);
   }
 
-  this->buffer_ = (uint8_t *) ps_malloc(buffer_size);
+  this->buffer_ = alloc_large<uint8_t>(buffer_size, BUFFER_LOCATION_PREFER_EXTERNAL);
   if (this->buffer_ == nullptr) {
     ESP_LOGE(TAG, "Could not allocate buffer for display!");
     this->mark_failed();
     return;
   }
   if (!this->greyscale_) {
-    this->partial_buffer_ = (uint8_t *) ps_malloc(buffer_size);
+    this->partial_buffer_ = alloc_large<uint8_t>(buffer_size, BUFFER_LOCATION_PREFER_EXTERNAL);
     if (this->partial_buffer_ == nullptr) {
       ESP_LOGE(TAG, "Could not allocate partial buffer for display!");
       this->mark_failed();
       return;
     }
-    this->partial_buffer_2_ = (uint8_t *) ps_malloc(buffer_size * 2);
+    this->partial_buffer_2_ = alloc_large<uint8_t>(buffer_size * 2, BUFFER_LOCATION_PREFER_EXTERNAL);
     if (this->partial_buffer_2_ == nullptr) {
       ESP_LOGE(TAG, "Could not allocate partial buffer 2 for display!");
       this->mark_failed();
@@ -76,6 +98,9 @@ void Inkplate6::initialize_() {
   }
 
   memset(this->buffer_, 0, buffer_size);
+
+  const uint32_t stride = this->get_width_internal() / (this->greyscale_ ? 2u : 8u);
+  this->refresh_planner_.init(stride, this->get_height_internal());
 }
 float Inkplate6::get_setup_priority() const { return setup_priority::PROCESSOR; }
 size_t Inkplate6::get_buffer_length_() {
@@ -88,7 +113,19 @@ size_t Inkplate6::get_buffer_length_() {
 void Inkplate6::update() {
   this->do_update_();
 
-  if (this->full_update_every_ > 0 && this->partial_updates_ >= this->full_update_every_) {
+  if (this->greyscale_ || !this->partial_updating_) {
+    this->refresh_planner_.set_max_partial_refreshes(0);
+  } else if (this->full_update_every_ == 0) {
+    this->refresh_planner_.set_max_partial_refreshes(display::EPaperRefreshPlanner::UNLIMITED);
+  } else {
+    this->refresh_planner_.set_max_partial_refreshes(this->full_update_every_);
+  }
+  this->refresh_ = this->refresh_planner_.plan(this->greyscale_ ? this->buffer_ : this->partial_buffer_);
+  if (this->refresh_.mode == display::EPAPER_REFRESH_NONE) {
+    ESP_LOGV(TAG, "Nothing changed, skipping refresh");
+    return;
+  }
+  if (this->refresh_.mode == display::EPAPER_REFRESH_FULL) {
     this->block_partial_ = true;
   }
 
@@ -157,7 +194,7 @@ void Inkplate6::eink_off_() {
   this->gmod_pin_->digital_write(false);
   this->oe_pin_->digital_write(false);
 
-  GPIO.out &= ~(get_data_pin_mask_() | (1 << this->cl_pin_->get_pin()) | (1 << this->le_pin_->get_pin()));
+  GPIO.out &= ~(this->data_mask_ | this->cl_mask_ | (1 << this->le_pin_->get_pin()));
 
   this->sph_pin_->digital_write(false);
   this->spv_pin_->digital_write(false);
@@ -238,10 +275,7 @@ void Inkplate6::display1b_() {
     this->buffer_[i] |= this->partial_buffer_[i];
   }
 
-  uint16_t pos;
-  uint32_t send;
-  uint8_t data;
-  uint8_t buffer_value;
+  uint32_t pos;
   eink_on_();
   clean_fast_(0, 1);
   clean_fast_(1, 5);
@@ -257,34 +291,7 @@ void Inkplate6::display1b_() {
     pos = this->get_buffer_length_() - 1;
     vscan_start_();
     for (int i = 0; i < this->get_height_internal(); i++) {
-      buffer_value = this->buffer_[pos];
-      data = LUTB[(buffer_value >> 4) & 0x0F];
-      send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-             (((data & B11100000) >> 5) << 25);
-      hscan_start_(send);
-      data = LUTB[buffer_value & 0x0F];
-      send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-             (((data & B11100000) >> 5) << 25);
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-      pos--;
-
-      for (int j = 0; j < (this->get_width_internal() / 8) - 1; j++) {
-        buffer_value = this->buffer_[pos];
-        data = LUTB[(buffer_value >> 4) & 0x0F];
-        send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-               (((data & B11100000) >> 5) << 25);
-        GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-        data = LUTB[buffer_value & 0x0F];
-        send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-               (((data & B11100000) >> 5) << 25);
-        GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-        pos--;
-      }
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+      this->write_row_1b_(pos, LUTB);
       vscan_end_();
     }
     delayMicroseconds(230);
@@ -294,33 +301,7 @@ void Inkplate6::display1b_() {
   pos = this->get_buffer_length_() - 1;
   vscan_start_();
   for (int i = 0; i < this->get_height_internal(); i++) {
-    buffer_value = this->buffer_[pos];
-    data = LUT2[(buffer_value >> 4) & 0x0F];
-    send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-           (((data & B11100000) >> 5) << 25);
-    hscan_start_(send);
-    data = LUT2[buffer_value & 0x0F];
-    send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-           (((data & B11100000) >> 5) << 25);
-    GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-    GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-    pos--;
-    for (int j = 0; j < (this->get_width_internal() / 8) - 1; j++) {
-      buffer_value = this->buffer_[pos];
-      data = LUT2[(buffer_value >> 4) & 0x0F];
-      send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-             (((data & B11100000) >> 5) << 25);
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-      data = LUT2[buffer_value & 0x0F];
-      send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-             (((data & B11100000) >> 5) << 25);
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-      pos--;
-    }
-    GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-    GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+    this->write_row_1b_(pos, LUT2);
     vscan_end_();
   }
   delayMicroseconds(230);
@@ -328,21 +309,13 @@ void Inkplate6::display1b_() {
 
   vscan_start_();
   for (int i = 0; i < this->get_height_internal(); i++) {
-    buffer_value = this->buffer_[pos];
-    data = 0b00000000;
-    send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-           (((data & B11100000) >> 5) << 25);
-    hscan_start_(send);
-    GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-    GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+    hscan_start_(0);
+    this->clock_byte_(0);
     for (int j = 0; j < (this->get_width_internal() / 8) - 1; j++) {
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+      this->clock_byte_(0);
+      this->clock_byte_(0);
     }
-    GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-    GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+    this->clock_byte_(0);
     vscan_end_();
   }
   delayMicroseconds(230);
@@ -351,7 +324,6 @@ void Inkplate6::display1b_() {
   vscan_start_();
   eink_off_();
   this->block_partial_ = false;
-  this->partial_updates_ = 0;
   ESP_LOGV(TAG, "Display1b finished (%lums)", millis() - start_time);
 }
 void Inkplate6::display3b_() {
@@ -370,7 +342,6 @@ void Inkplate6::display3b_() {
 
   for (int k = 0; k < 8; k++) {
     uint32_t pos = this->get_buffer_length_() - 1;
-    uint32_t send;
     uint8_t pix1;
     uint8_t pix2;
     uint8_t pix3;
@@ -380,24 +351,7 @@ void Inkplate6::display3b_() {
 
     vscan_start_();
     for (int i = 0; i < this->get_height_internal(); i++) {
-      pix1 = this->buffer_[pos--];
-      pix2 = this->buffer_[pos--];
-      pix3 = this->buffer_[pos--];
-      pix4 = this->buffer_[pos--];
-      pixel = (waveform3Bit[pix1 & 0x07][k] << 6) | (waveform3Bit[(pix1 >> 4) & 0x07][k] << 4) |
-              (waveform3Bit[pix2 & 0x07][k] << 2) | (waveform3Bit[(pix2 >> 4) & 0x07][k] << 0);
-      pixel2 = (waveform3Bit[pix3 & 0x07][k] << 6) | (waveform3Bit[(pix3 >> 4) & 0x07][k] << 4) |
-               (waveform3Bit[pix4 & 0x07][k] << 2) | (waveform3Bit[(pix4 >> 4) & 0x07][k] << 0);
-
-      send = ((pixel & B00000011) << 4) | (((pixel & B00001100) >> 2) << 18) | (((pixel & B00010000) >> 4) << 23) |
-             (((pixel & B11100000) >> 5) << 25);
-      hscan_start_(send);
-      send = ((pixel2 & B00000011) << 4) | (((pixel2 & B00001100) >> 2) << 18) | (((pixel2 & B00010000) >> 4) << 23) |
-             (((pixel2 & B11100000) >> 5) << 25);
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-
-      for (int j = 0; j < (this->get_width_internal() / 8) - 1; j++) {
+      for (int j = 0; j < (this->get_width_internal() / 8); j++) {
         pix1 = this->buffer_[pos--];
         pix2 = this->buffer_[pos--];
         pix3 = this->buffer_[pos--];
@@ -406,19 +360,14 @@ void Inkplate6::display3b_() {
                 (waveform3Bit[pix2 & 0x07][k] << 2) | (waveform3Bit[(pix2 >> 4) & 0x07][k] << 0);
         pixel2 = (waveform3Bit[pix3 & 0x07][k] << 6) | (waveform3Bit[(pix3 >> 4) & 0x07][k] << 4) |
                  (waveform3Bit[pix4 & 0x07][k] << 2) | (waveform3Bit[(pix4 >> 4) & 0x07][k] << 0);
-
-        send = ((pixel & B00000011) << 4) | (((pixel & B00001100) >> 2) << 18) | (((pixel & B00010000) >> 4) << 23) |
-               (((pixel & B11100000) >> 5) << 25);
-        GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-
-        send = ((pixel2 & B00000011) << 4) | (((pixel2 & B00001100) >> 2) << 18) | (((pixel2 & B00010000) >> 4) << 23) |
-               (((pixel2 & B11100000) >> 5) << 25);
-        GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+        if (j == 0) {
+          hscan_start_(pixel);
+        } else {
+          this->clock_byte_(pixel);
+        }
+        this->clock_byte_(pixel2);
       }
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+      this->clock_byte_(pixel2);
       vscan_end_();
     }
     delayMicroseconds(230);
@@ -437,16 +386,17 @@ bool Inkplate6::partial_update_() {
   if (this->block_partial_)
     return false;
 
-  this->partial_updates_++;
-
-  uint16_t pos = this->get_buffer_length_() - 1;
-  uint32_t send;
-  uint8_t data;
+  // the rows are sent bottom to top, only the changed ones have to be driven
+  const int stride = this->get_width_internal() / 8;
+  const int height = this->get_height_internal();
+  const int first_row = height - int(this->refresh_.y + this->refresh_.height);
+  const int last_row = height - 1 - int(this->refresh_.y);
   uint8_t diffw, diffb;
-  uint32_t n = (this->get_buffer_length_() * 2) - 1;
 
-  for (int i = 0; i < this->get_height_internal(); i++) {
-    for (int j = 0; j < (this->get_width_internal() / 8); j++) {
+  for (int i = first_row; i <= last_row; i++) {
+    uint32_t pos = (height - i) * stride - 1;
+    uint32_t n = (this->get_buffer_length_() * 2) - 1 - i * stride * 2;
+    for (int j = 0; j < stride; j++) {
       diffw = (this->buffer_[pos] ^ this->partial_buffer_[pos]) & ~(this->partial_buffer_[pos]);
       diffb = (this->buffer_[pos] ^ this->partial_buffer_[pos]) & this->partial_buffer_[pos];
       pos--;
@@ -454,26 +404,35 @@ bool Inkplate6::partial_update_() {
       this->partial_buffer_2_[n--] = LUTW[diffw & 0x0F] & LUTB[diffb & 0x0F];
     }
   }
-  ESP_LOGV(TAG, "Partial update buffer built after (%lums)", millis() - start_time);
+  ESP_LOGV(TAG, "Partial update buffer built for rows %d-%d after (%lums)", first_row, last_row,
+           millis() - start_time);
 
   eink_on_();
   for (int k = 0; k < 5; k++) {
     vscan_start_();
-    n = (this->get_buffer_length_() * 2) - 1;
-    for (int i = 0; i < this->get_height_internal(); i++) {
-      data = this->partial_buffer_2_[n--];
-      send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-             (((data & B11100000) >> 5) << 25);
-      hscan_start_(send);
-      for (int j = 0; j < (this->get_width_internal() / 4) - 1; j++) {
+    // the source driver keeps the last row it was sent, after one row of "no change" data the rows outside of
+    // the window only need to be latched
+    bool skip_loaded = false;
+    for (int i = 0; i < height; i++) {
+      if (i < first_row || i > last_row) {
+        if (!skip_loaded) {
+          hscan_start_(0xFF);
+          for (int j = 0; j < stride * 2; j++)
+            this->clock_byte_(0xFF);
+          skip_loaded = true;
+        }
+        vscan_end_();
+        continue;
+      }
+      skip_loaded = false;
+      uint32_t n = (this->get_buffer_length_() * 2) - 1 - i * stride * 2;
+      uint8_t data = this->partial_buffer_2_[n--];
+      hscan_start_(data);
+      for (int j = 0; j < stride * 2 - 1; j++) {
         data = this->partial_buffer_2_[n--];
-        send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-               (((data & B11100000) >> 5) << 25);
-        GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+        this->clock_byte_(data);
       }
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+      this->clock_byte_(data);
       vscan_end_();
     }
     delayMicroseconds(230);
@@ -524,12 +483,26 @@ void Inkplate6::vscan_write_() {
   this->sph_pin_->digital_write(true);
   this->ckv_pin_->digital_write(true);
 }
-void Inkplate6::hscan_start_(uint32_t d) {
+void Inkplate6::hscan_start_(uint8_t data) {
   this->sph_pin_->digital_write(false);
-  GPIO.out_w1ts = (d) | (1 << this->cl_pin_->get_pin());
-  GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+  this->clock_byte_(data);
   this->sph_pin_->digital_write(true);
 }
+void HOT Inkplate6::write_row_1b_(uint32_t &pos, const uint8_t *lut) {
+  uint8_t data = 0;
+  for (int j = 0; j < this->get_width_internal() / 8; j++) {
+    const uint8_t buffer_value = this->buffer_[pos--];
+    data = lut[(buffer_value >> 4) & 0x0F];
+    if (j == 0) {
+      hscan_start_(data);
+    } else {
+      this->clock_byte_(data);
+    }
+    data = lut[buffer_value & 0x0F];
+    this->clock_byte_(data);
+  }
+  this->clock_byte_(data);
+}
 void Inkplate6::vscan_end_() {
   this->ckv_pin_->digital_write(false);
   this->le_pin_->digital_write(true);
@@ -565,23 +538,16 @@ void Inkplate6::clean_fast_(uint8_t c, uint8_t rep) {
   else if (c == 3)  // Skip
     data = B11111111;
 
-  uint32_t send = ((data & B00000011) << 4) | (((data & B00001100) >> 2) << 18) | (((data & B00010000) >> 4) << 23) |
-                  (((data & B11100000) >> 5) << 25);
-
   for (int k = 0; k < rep; k++) {
     vscan_start_();
     for (int i = 0; i < this->get_height_internal(); i++) {
-      hscan_start_(send);
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+      hscan_start_(data);
+      this->clock_byte_(data);
       for (int j = 0; j < this->get_width_internal() / 8; j++) {
-        GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-        GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+        this->clock_byte_(data);
+        this->clock_byte_(data);
       }
-      GPIO.out_w1ts = (send) | (1 << this->cl_pin_->get_pin());
-      GPIO.out_w1tc = get_data_pin_mask_() | (1 << this->cl_pin_->get_pin());
+      this->clock_byte_(data);
       vscan_end_();
     }
     delayMicroseconds(230);
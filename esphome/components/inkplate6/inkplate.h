@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/epaper_refresh.h"
 
 #ifdef ARDUINO_ARCH_ESP32
 
@@ -85,7 +86,17 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
   bool partial_update_();
   void clean_fast_(uint8_t c, uint8_t rep);
 
-  void hscan_start_(uint32_t d);
+  /// Build the tables of the GPIO bits for the data and clock lines.
+  void setup_data_pins_();
+  /// Clock out one byte on the data lines, the first store sets the data lines and CL, the second clears them.
+  inline void clock_byte_(uint8_t data) ALWAYS_INLINE {
+    GPIO.out_w1ts = this->data_pin_lut_[data] | this->cl_mask_;
+    GPIO.out_w1tc = this->data_mask_ | this->cl_mask_;
+  }
+  /// Clock out a row of the 1 bit buffer ending at pos (rows are sent backwards) through the waveform lut.
+  void write_row_1b_(uint32_t &pos, const uint8_t *lut);
+
+  void hscan_start_(uint8_t data);
   void vscan_end_();
   void vscan_start_();
   void vscan_write_();
@@ -103,27 +114,22 @@ class Inkplate6 : public PollingComponent, public display::DisplayBuffer, public
 
   size_t get_buffer_length_();
 
-  int get_data_pin_mask_() {
-    int data = 0;
-    data |= (1 << this->display_data_0_pin_->get_pin());
-    data |= (1 << this->display_data_1_pin_->get_pin());
-    data |= (1 << this->display_data_2_pin_->get_pin());
-    data |= (1 << this->display_data_3_pin_->get_pin());
-    data |= (1 << this->display_data_4_pin_->get_pin());
-    data |= (1 << this->display_data_5_pin_->get_pin());
-    data |= (1 << this->display_data_6_pin_->get_pin());
-    data |= (1 << this->display_data_7_pin_->get_pin());
-    return data;
-  }
-
   uint8_t panel_on_ = 0;
   uint8_t temperature_;
 
   uint8_t *partial_buffer_{nullptr};
   uint8_t *partial_buffer_2_{nullptr};
 
+  /// The GPIO bits of the data lines for every data byte.
+  uint32_t data_pin_lut_[256];
+  uint32_t data_mask_{0};
+  uint32_t cl_mask_{0};
+
+  display::EPaperRefreshPlanner refresh_planner_;
+  /// The window of rows that changed since the last refresh.
+  display::EPaperRefresh refresh_{display::EPAPER_REFRESH_FULL, 0, 0, 0, 0};
+
   uint32_t full_update_every_;
-  uint32_t partial_updates_{0};
 
   bool block_partial_;
   bool greyscale_;
@@ -12,14 +12,34 @@ void IntegrationSensor::setup() {
     this->rtc_ = global_preferences.make_preference<float>(this->get_object_id_hash());
     float preference_value = 0;
     this->rtc_.load(&preference_value);
-    this->result_ = preference_value;
+    this->result_.reset(preference_value);
   }
 
   this->last_update_ = millis();
-  this->publish_and_save_(this->result_);
+  this->publish_now_();
   this->sensor_->add_on_state_callback([this](float state) { this->process_sensor_value_(state); });
+  if (this->integration_interval_ != 0) {
+    this->set_interval("integrate", this->integration_interval_, [this]() {
+      // like a sample of the last value, which doesn't change the area for any of the methods
+      this->integrate_(this->last_value_);
+      this->publish_throttled_();
+    });
+  }
+}
+void IntegrationSensor::dump_config() {
+  LOG_SENSOR("", "Integration Sensor", this);
+  if (this->integration_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Integration Interval: %u ms", this->integration_interval_);
+  if (this->min_publish_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Min Publish Interval: %u ms", this->min_publish_interval_);
+}
+void IntegrationSensor::on_safe_shutdown() {
+  // checkpoint the latest result, the preferences are committed after this
+  if (this->restore_) {
+    float result_f = this->result_.get();
+    this->rtc_.save(&result_f);
+  }
 }
-void IntegrationSensor::dump_config() { LOG_SENSOR("", "Integration Sensor", this); }
 std::string IntegrationSensor::unit_of_measurement() {
   std::string suffix;
   switch (this->time_) {
@@ -46,12 +66,18 @@ std::string IntegrationSensor::unit_of_measurement() {
   return base + suffix;
 }
 void IntegrationSensor::process_sensor_value_(float value) {
+  if (isnan(value))
+    return;
+  this->integrate_(value);
+  this->publish_throttled_();
+}
+void IntegrationSensor::integrate_(float value) {
   const uint32_t now = millis();
   const double old_value = this->last_value_;
   const double new_value = value;
   const uint32_t dt_ms = now - this->last_update_;
   const double dt = dt_ms * this->get_time_factor_();
-  double area = 0.0f;
+  double area = 0.0;
   switch (this->method_) {
     case INTEGRATION_METHOD_TRAPEZOID:
       area = dt * (old_value + new_value) / 2.0;
@@ -65,7 +91,24 @@ void IntegrationSensor::process_sensor_value_(float value) {
   }
   this->last_value_ = new_value;
   this->last_update_ = now;
-  this->publish_and_save_(this->result_ + area);
+  this->result_.add(area);
+}
+void IntegrationSensor::publish_now_() {
+  this->cancel_timeout("publish");
+  this->last_publish_ = millis();
+  const double result = this->result_.get();
+  this->publish_state(result);
+  float result_f = result;
+  this->rtc_.save(&result_f);
+}
+void IntegrationSensor::publish_throttled_() {
+  const uint32_t elapsed = millis() - this->last_publish_;
+  if (elapsed >= this->min_publish_interval_) {
+    this->publish_now_();
+    return;
+  }
+  // replaces a pending publish, which then sends the latest result
+  this->set_timeout("publish", this->min_publish_interval_ - elapsed, [this]() { this->publish_now_(); });
 }
 
 }  // namespace integration
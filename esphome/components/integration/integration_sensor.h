@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/sensor/sensor.h"
 
 namespace esphome {
@@ -26,37 +27,43 @@ class IntegrationSensor : public sensor::Sensor, public Component {
  public:
   void setup() override;
   void dump_config() override;
+  void on_safe_shutdown() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   void set_sensor(Sensor *sensor) { sensor_ = sensor; }
   void set_time(IntegrationSensorTime time) { time_ = time; }
   void set_method(IntegrationMethod method) { method_ = method; }
   void set_restore(bool restore) { restore_ = restore; }
-  void reset() { this->publish_and_save_(0.0f); }
+  /// Also integrate the last value at this interval, so the result advances while the input doesn't publish.
+  void set_integration_interval(uint32_t integration_interval) { integration_interval_ = integration_interval; }
+  /// Publish (and save) the result at most this often, the integration itself isn't affected.
+  void set_min_publish_interval(uint32_t min_publish_interval) { min_publish_interval_ = min_publish_interval; }
+  void reset() {
+    this->result_.reset();
+    this->publish_now_();
+  }
 
  protected:
   void process_sensor_value_(float value);
-  float get_time_factor_() {
+  /// Add the area up to now, ending with value.
+  void integrate_(float value);
+  void publish_now_();
+  void publish_throttled_();
+  double get_time_factor_() {
     switch (this->time_) {
       case INTEGRATION_SENSOR_TIME_MILLISECOND:
-        return 1.0f;
+        return 1.0;
       case INTEGRATION_SENSOR_TIME_SECOND:
-        return 1.0f / 1000.0f;
+        return 1.0 / 1000.0;
       case INTEGRATION_SENSOR_TIME_MINUTE:
-        return 1.0f / 60000.0f;
+        return 1.0 / 60000.0;
       case INTEGRATION_SENSOR_TIME_HOUR:
-        return 1.0f / 3600000.0f;
+        return 1.0 / 3600000.0;
       case INTEGRATION_SENSOR_TIME_DAY:
-        return 1.0f / 86400000.0f;
+        return 1.0 / 86400000.0;
       default:
-        return 0.0f;
+        return 0.0;
     }
   }
-  void publish_and_save_(double result) {
-    this->result_ = result;
-    this->publish_state(result);
-    float result_f = result;
-    this->rtc_.save(&result_f);
-  }
   std::string unit_of_measurement() override;
   std::string icon() override { return this->sensor_->get_icon(); }
   int8_t accuracy_decimals() override { return this->sensor_->get_accuracy_decimals() + 2; }
@@ -67,8 +74,12 @@ class IntegrationSensor : public sensor::Sensor, public Component {
   bool restore_;
   ESPPreferenceObject rtc_;
 
+  uint32_t integration_interval_{0};
+  uint32_t min_publish_interval_{0};
+
   uint32_t last_update_;
-  double result_{0.0f};
+  uint32_t last_publish_{0};
+  CompensatedSum result_;
   float last_value_{0.0f};
 };
 
@@ -2,7 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.components import sensor
-from esphome.const import CONF_ID, CONF_SENSOR, CONF_RESTORE
+from esphome.const import CONF_ID, CONF_SENSOR, CONF_RESTORE, CONF_MIN_PUBLISH_INTERVAL
 
 integration_ns = cg.esphome_ns.namespace('integration')
 IntegrationSensor = integration_ns.class_('IntegrationSensor', sensor.Sensor, cg.Component)
@@ -25,6 +25,7 @@ INTEGRATION_METHODS = {
 
 CONF_TIME_UNIT = 'time_unit'
 CONF_INTEGRATION_METHOD = 'integration_method'
+CONF_INTEGRATION_INTERVAL = 'integration_interval'
 
 CONFIG_SCHEMA = sensor.SENSOR_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(IntegrationSensor),
@@ -33,6 +34,9 @@ CONFIG_SCHEMA = sensor.SENSOR_SCHEMA.extend({
     cv.Optional(CONF_INTEGRATION_METHOD, default='trapezoid'):
         cv.enum(INTEGRATION_METHODS, lower=True),
     cv.Optional(CONF_RESTORE, default=False): cv.boolean,
+    cv.Optional(CONF_INTEGRATION_INTERVAL): cv.All(cv.positive_time_period_milliseconds,
+                                                   cv.Range(min=cv.TimePeriod(milliseconds=100))),
+    cv.Optional(CONF_MIN_PUBLISH_INTERVAL, default='0s'): cv.positive_time_period_milliseconds,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -47,6 +51,9 @@ def to_code(config):
     cg.add(var.set_time(config[CONF_TIME_UNIT]))
     cg.add(var.set_method(config[CONF_INTEGRATION_METHOD]))
     cg.add(var.set_restore(config[CONF_RESTORE]))
+    if CONF_INTEGRATION_INTERVAL in config:
+        cg.add(var.set_integration_interval(config[CONF_INTEGRATION_INTERVAL]))
+    cg.add(var.set_min_publish_interval(config[CONF_MIN_PUBLISH_INTERVAL]))
 
 
 @automation.register_action('sensor.integration.reset', ResetAction, automation.maybe_simple_id({
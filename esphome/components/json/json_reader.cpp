@@ -0,0 +1,249 @@
+#include "json_reader.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+/// The longest number that is parsed, longer ones don't fit a float anyway.
+static const size_t JSON_MAX_NUMBER_LENGTH = 32;
+/// The nesting that first_member_ can track.
+static const uint8_t JSON_MAX_DEPTH = 32;
+
+static bool is_number_char(char c) {
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+/// Parse a float from a string that isn't null-terminated, the whole string has to be the number.
+static bool parse_float(const char *str, size_t len, float *value) {
+  if (len == 0 || len >= JSON_MAX_NUMBER_LENGTH)
+    return false;
+  char buffer[JSON_MAX_NUMBER_LENGTH];
+  memcpy(buffer, str, len);
+  buffer[len] = '\0';
+  char *end;
+  *value = strtof(buffer, &end);
+  return end == buffer + len;
+}
+
+/// Append the code point as UTF-8, as far as it fits.
+static size_t encode_utf8(uint16_t code, char *out, size_t space) {
+  char utf8[3];
+  size_t len;
+  if (code < 0x80) {
+    utf8[0] = code;
+    len = 1;
+  } else if (code < 0x800) {
+    utf8[0] = 0xC0 | (code >> 6);
+    utf8[1] = 0x80 | (code & 0x3F);
+    len = 2;
+  } else {
+    utf8[0] = 0xE0 | (code >> 12);
+    utf8[1] = 0x80 | ((code >> 6) & 0x3F);
+    utf8[2] = 0x80 | (code & 0x3F);
+    len = 3;
+  }
+  if (len > space)
+    return 0;
+  memcpy(out, utf8, len);
+  return len;
+}
+
+char JsonReader::peek_() {
+  while (this->pos_ < this->end_) {
+    const char c = *this->pos_;
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+      return c;
+    this->pos_++;
+  }
+  return '\0';
+}
+
+bool JsonReader::expect_(char c) {
+  if (this->error_ || this->peek_() != c)
+    return this->fail_();
+  this->pos_++;
+  return true;
+}
+
+bool JsonReader::fail_() {
+  this->error_ = true;
+  return false;
+}
+
+bool JsonReader::begin_object() {
+  if (this->depth_ >= JSON_MAX_DEPTH || !this->expect_('{'))
+    return this->fail_();
+  this->first_member_ |= 1UL << this->depth_;
+  this->depth_++;
+  return true;
+}
+
+bool JsonReader::next_key(StringRef *key) {
+  if (this->error_ || this->depth_ == 0)
+    return false;
+  const uint32_t first_bit = 1UL << (this->depth_ - 1);
+  const char c = this->peek_();
+  if (c == '}') {
+    this->pos_++;
+    this->depth_--;
+    this->first_member_ &= ~first_bit;
+    return false;
+  }
+  if ((this->first_member_ & first_bit) == 0 && !this->expect_(','))
+    return false;
+  this->first_member_ &= ~first_bit;
+  return this->read_raw_string_(key) && this->expect_(':');
+}
+
+bool JsonReader::read_raw_string_(StringRef *str) {
+  if (!this->expect_('"'))
+    return false;
+  const char *start = this->pos_;
+  while (this->pos_ < this->end_) {
+    const char c = *this->pos_;
+    if (c == '"') {
+      *str = StringRef(start, this->pos_ - start);
+      this->pos_++;
+      return true;
+    }
+    if (static_cast<uint8_t>(c) < 0x20)
+      return this->fail_();
+    // the escaped character can't end the string
+    this->pos_ += c == '\\' ? 2 : 1;
+  }
+  return this->fail_();
+}
+
+bool JsonReader::skip_literal_() {
+  const char *start = this->pos_;
+  while (this->pos_ < this->end_ && (is_number_char(*this->pos_) || (*this->pos_ >= 'a' && *this->pos_ <= 'z')))
+    this->pos_++;
+  const StringRef literal(start, this->pos_ - start);
+  if (literal.empty())
+    return this->fail_();
+  if (start[0] >= 'a' && start[0] <= 'z' && literal != "true" && literal != "false" && literal != "null")
+    return this->fail_();
+  return true;
+}
+
+bool JsonReader::skip_value() {
+  if (this->error_)
+    return false;
+  const char c = this->peek_();
+  if (c == '"') {
+    StringRef str;
+    return this->read_raw_string_(&str);
+  }
+  if (c != '{' && c != '[')
+    return this->skip_literal_();
+
+  // the contents aren't validated, only the nesting is tracked to find the end
+  uint16_t nesting = 0;
+  while (this->pos_ < this->end_) {
+    const char ch = *this->pos_;
+    if (ch == '"') {
+      StringRef str;
+      if (!this->read_raw_string_(&str))
+        return false;
+      continue;
+    }
+    this->pos_++;
+    if (ch == '{' || ch == '[') {
+      nesting++;
+    } else if (ch == '}' || ch == ']') {
+      if (--nesting == 0)
+        return true;
+    }
+  }
+  return this->fail_();
+}
+
+bool JsonReader::read_float(float *value) {
+  if (this->error_)
+    return false;
+  const char c = this->peek_();
+  if (c == '"') {
+    StringRef str;
+    return this->read_raw_string_(&str) && parse_float(str.data(), str.size(), value);
+  }
+  if (c != '-' && (c < '0' || c > '9')) {
+    // like true or an object, valid but not a number
+    this->skip_value();
+    return false;
+  }
+
+  const char *start = this->pos_;
+  while (this->pos_ < this->end_ && is_number_char(*this->pos_))
+    this->pos_++;
+  if (!parse_float(start, this->pos_ - start, value))
+    return this->fail_();
+  return true;
+}
+
+bool JsonReader::read_string(char *buffer, size_t size) {
+  StringRef raw;
+  if (this->error_)
+    return false;
+  if (this->peek_() != '"') {
+    this->skip_value();
+    return false;
+  }
+  if (!this->read_raw_string_(&raw))
+    return false;
+
+  size_t len = 0;
+  for (size_t i = 0; i < raw.size() && len + 1 < size; i++) {
+    char c = raw[i];
+    if (c != '\\') {
+      buffer[len++] = c;
+      continue;
+    }
+    c = raw[++i];
+    switch (c) {
+      case 'b':
+        buffer[len++] = '\b';
+        break;
+      case 'f':
+        buffer[len++] = '\f';
+        break;
+      case 'n':
+        buffer[len++] = '\n';
+        break;
+      case 'r':
+        buffer[len++] = '\r';
+        break;
+      case 't':
+        buffer[len++] = '\t';
+        break;
+      case 'u': {
+        if (i + 4 >= raw.size())
+          return this->fail_();
+        char hex[5] = {raw[i + 1], raw[i + 2], raw[i + 3], raw[i + 4], '\0'};
+        char *end;
+        const uint16_t code = strtoul(hex, &end, 16);
+        if (end != hex + 4)
+          return this->fail_();
+        // surrogate pairs aren't combined, they don't occur in the names of commands
+        len += encode_utf8(code, &buffer[len], size - 1 - len);
+        i += 4;
+        break;
+      }
+      default:
+        // \" \\ \/ stand for themselves
+        buffer[len++] = c;
+        break;
+    }
+  }
+  buffer[len] = '\0';
+  return true;
+}
+
+bool JsonReader::finish() {
+  if (this->error_ || this->depth_ != 0)
+    return false;
+  return this->peek_() == '\0' || this->fail_();
+}
+
+}  // namespace json
+}  // namespace esphome
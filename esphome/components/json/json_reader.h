@@ -0,0 +1,76 @@
+#pragma once
+
+#include "esphome/core/string_ref.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace json {
+
+/** A minimal pull parser that reads JSON straight from a buffer, without building a document or allocating.
+ *
+ * The counterpart of JsonWriter for commands with a known schema: the caller walks the members of an object and
+ * reads the values it knows, skipping all others. Once a syntax error is found every call fails, so a command is
+ * only applied when finish() confirms that the whole payload was valid.
+ *
+ * Example:
+ *
+ * ```cpp
+ * json::JsonReader reader(payload, len);
+ * StringRef key;
+ * if (!reader.begin_object())
+ *   return false;
+ * while (reader.next_key(&key)) {
+ *   if (key == "brightness")
+ *     reader.read_float(&brightness);
+ *   else
+ *     reader.skip_value();
+ * }
+ * return reader.finish();
+ * ```
+ */
+class JsonReader {
+ public:
+  JsonReader(const char *data, size_t len) : pos_(data), end_(data + len) {}
+
+  /// Enter the object that starts at the current position.
+  bool begin_object();
+  /** Read the key of the next member of the object that was entered last, its value has to be read or skipped next.
+   *
+   * Returns false once the end of the object is reached, which leaves it, or on a syntax error. Keys containing escape
+   * sequences are returned as written, so they don't match the plain names of a schema.
+   */
+  bool next_key(StringRef *key);
+
+  /// Read a number, or a string containing one, which ArduinoJson accepts as well.
+  bool read_float(float *value);
+  /// Read a string, truncated to fit into size bytes including the terminator.
+  bool read_string(char *buffer, size_t size);
+  /// Skip the value at the current position, including all objects and arrays in it.
+  bool skip_value();
+
+  /// Whether the document was valid and nothing but whitespace follows it, after all objects were left.
+  bool finish();
+  bool has_error() const { return this->error_; }
+
+ protected:
+  /// The next character that isn't whitespace, 0 at the end.
+  char peek_();
+  bool expect_(char c);
+  bool fail_();
+  /// Move past the literal word at the current position, like true or null.
+  bool skip_literal_();
+  /// Read the string at the current position, the raw contents between the quotes.
+  bool read_raw_string_(StringRef *str);
+
+  const char *pos_;
+  const char *end_;
+  /// The nesting depth of objects entered with begin_object().
+  uint8_t depth_{0};
+  /// Bit n is set while the object at depth n + 1 has had no member yet.
+  uint32_t first_member_{0};
+  bool error_{false};
+};
+
+}  // namespace json
+}  // namespace esphome
@@ -63,6 +63,20 @@ std::string build_json(const json_build_t &f) {
   return std::string(c_str, len);
 }
 
+#ifdef USE_DUAL_CORE
+std::string build_json_unshared(const json_build_t &f) {
+  DynamicJsonBuffer buffer;
+  JsonObject &root = buffer.createObject();
+
+  f(root);
+
+  std::string out;
+  out.resize(root.measureLength() + 1);
+  out.resize(root.printTo(&out[0], out.size()));
+  return out;
+}
+#endif
+
 VectorJsonBuffer::String::String(VectorJsonBuffer *parent) : parent_(parent), start_(parent->size_) {}
 void VectorJsonBuffer::String::append(char c) const {
   char *last = static_cast<char *>(this->parent_->do_alloc(1));
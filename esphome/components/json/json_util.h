@@ -1,5 +1,6 @@
 #pragma once
 
+#include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include <ArduinoJson.h>
 
@@ -17,6 +18,11 @@ const char *build_json(const json_build_t &f, size_t *length);
 
 std::string build_json(const json_build_t &f);
 
+#ifdef USE_DUAL_CORE
+/// Build a JSON string with a JSON buffer of its own, for the loop task while the network task uses the global one.
+std::string build_json_unshared(const json_build_t &f);
+#endif
+
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
 
@@ -0,0 +1,91 @@
+#include "json_writer.h"
+#include <cmath>
+#include <cstdio>
+
+namespace esphome {
+namespace json {
+
+void JsonWriter::begin_object() {
+  this->out_ += '{';
+  this->need_comma_ = false;
+}
+void JsonWriter::end_object() {
+  this->out_ += '}';
+  this->need_comma_ = true;
+}
+JsonWriter &JsonWriter::key(const char *key) {
+  if (this->need_comma_)
+    this->out_ += ',';
+  this->write_string_(key, strlen(key));
+  this->out_ += ':';
+  this->need_comma_ = false;
+  return *this;
+}
+void JsonWriter::value(const char *value) { this->value(StringRef(value)); }
+void JsonWriter::value(const StringRef &value) {
+  this->write_string_(value.c_str(), value.size());
+  this->need_comma_ = true;
+}
+void JsonWriter::value(const StringRef &first, const StringRef &second) {
+  this->out_ += '"';
+  this->write_escaped_(first.c_str(), first.size());
+  this->write_escaped_(second.c_str(), second.size());
+  this->out_ += '"';
+  this->need_comma_ = true;
+}
+void JsonWriter::value(bool value) {
+  this->out_ += value ? "true" : "false";
+  this->need_comma_ = true;
+}
+void JsonWriter::value(float value) {
+  if (std::isnan(value)) {
+    this->out_ += "NaN";
+  } else if (std::isinf(value)) {
+    this->out_ += value > 0 ? "Infinity" : "-Infinity";
+  } else {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%.7g", value);
+    this->out_ += buffer;
+  }
+  this->need_comma_ = true;
+}
+void JsonWriter::write_string_(const char *str, size_t len) {
+  this->out_ += '"';
+  this->write_escaped_(str, len);
+  this->out_ += '"';
+}
+void JsonWriter::write_escaped_(const char *str, size_t len) {
+  static const char *const HEX_DIGITS = "0123456789abcdef";
+  for (size_t i = 0; i < len; i++) {
+    const char c = str[i];
+    switch (c) {
+      case '"':
+        this->out_ += "\\\"";
+        break;
+      case '\\':
+        this->out_ += "\\\\";
+        break;
+      case '\n':
+        this->out_ += "\\n";
+        break;
+      case '\r':
+        this->out_ += "\\r";
+        break;
+      case '\t':
+        this->out_ += "\\t";
+        break;
+      default:
+        if (uint8_t(c) < 0x20) {
+          this->out_ += "\\u00";
+          this->out_ += HEX_DIGITS[uint8_t(c) >> 4];
+          this->out_ += HEX_DIGITS[uint8_t(c) & 0x0F];
+        } else {
+          this->out_ += c;
+        }
+        break;
+    }
+  }
+}
+
+}  // namespace json
+}  // namespace esphome
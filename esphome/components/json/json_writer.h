@@ -0,0 +1,53 @@
+#pragma once
+
+#include "esphome/core/string_ref.h"
+#include <string>
+
+namespace esphome {
+namespace json {
+
+/** A minimal streaming JSON writer that appends to an existing string.
+ *
+ * Unlike build_json() this does not build a document in memory first, the only allocation is growing the output
+ * string, which keeps its capacity when it's cleared and reused. Commas between members are inserted
+ * automatically, the nesting is not validated.
+ *
+ * Example:
+ *
+ * ```cpp
+ * json::JsonWriter writer(out);
+ * writer.begin_object();
+ * writer.key("id").value("sensor-temperature");
+ * writer.key("value").value(21.5f);
+ * writer.end_object();
+ * ```
+ */
+class JsonWriter {
+ public:
+  /// Start writing at the end of out, call out.clear() before to reuse a buffer.
+  explicit JsonWriter(std::string &out) : out_(out) {}
+
+  void begin_object();
+  void end_object();
+
+  /// Write the key of the next object member.
+  JsonWriter &key(const char *key);
+
+  void value(const char *value);
+  void value(const StringRef &value);
+  /// Write the concatenation of two strings, for example a prefix and an object id.
+  void value(const StringRef &first, const StringRef &second);
+  void value(bool value);
+  /// Write a float the same way ArduinoJson does, including "NaN" for NAN.
+  void value(float value);
+
+ protected:
+  void write_string_(const char *str, size_t len);
+  void write_escaped_(const char *str, size_t len);
+
+  std::string &out_;
+  bool need_comma_{false};
+};
+
+}  // namespace json
+}  // namespace esphome
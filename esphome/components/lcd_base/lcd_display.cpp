@@ -30,6 +30,7 @@ static const uint8_t LCD_DISPLAY_FUNCTION_5X10_DOTS = 0x04;
 
 void LCDDisplay::setup() {
   this->buffer_ = new uint8_t[this->rows_ * this->columns_];
+  this->sent_ = new uint8_t[this->rows_ * this->columns_];
   for (uint8_t i = 0; i < this->rows_ * this->columns_; i++)
     this->buffer_[i] = ' ';
 
@@ -81,27 +82,28 @@ void LCDDisplay::setup() {
 
 float LCDDisplay::get_setup_priority() const { return setup_priority::PROCESSOR; }
 void HOT LCDDisplay::display() {
-  this->command_(LCD_DISPLAY_COMMAND_SET_DDRAM_ADDR | 0);
-
-  for (uint8_t i = 0; i < this->columns_; i++)
-    this->send(this->buffer_[i], true);
-
-  if (this->rows_ >= 3) {
-    for (uint8_t i = 0; i < this->columns_; i++)
-      this->send(this->buffer_[this->columns_ * 2 + i], true);
-  }
-
-  if (this->rows_ >= 1) {
-    this->command_(LCD_DISPLAY_COMMAND_SET_DDRAM_ADDR | 0x40);
-
-    for (uint8_t i = 0; i < this->columns_; i++)
-      this->send(this->buffer_[this->columns_ + i], true);
-
-    if (this->rows_ >= 4) {
-      for (uint8_t i = 0; i < this->columns_; i++)
-        this->send(this->buffer_[this->columns_ * 3 + i], true);
+  // only the cells that changed since they were last sent are written
+  for (uint8_t row = 0; row < this->rows_; row++) {
+    // rows 2 and 3 continue the DDRAM lines of rows 0 and 1
+    const uint8_t row_address = (row % 2 == 0 ? 0x00 : 0x40) + (row >= 2 ? this->columns_ : 0);
+    const uint8_t *cells = &this->buffer_[row * this->columns_];
+    uint8_t *sent = &this->sent_[row * this->columns_];
+    bool address_valid = false;
+    for (uint8_t col = 0; col < this->columns_; col++) {
+      if (!this->resend_ && cells[col] == sent[col]) {
+        address_valid = false;
+        continue;
+      }
+      // the address increments after each character, so a run of changed cells needs only one address command
+      if (!address_valid) {
+        this->command_(LCD_DISPLAY_COMMAND_SET_DDRAM_ADDR | (row_address + col));
+        address_valid = true;
+      }
+      this->send(cells[col], true);
+      sent[col] = cells[col];
     }
   }
+  this->resend_ = false;
 }
 void LCDDisplay::update() {
   for (uint8_t i = 0; i < this->rows_ * this->columns_; i++)
@@ -152,6 +154,8 @@ void LCDDisplay::clear() {
   // clear display, also sets DDRAM address to 0 (home)
   this->command_(LCD_DISPLAY_COMMAND_CLEAR_DISPLAY);
   delay(2);
+  for (uint8_t i = 0; i < this->rows_ * this->columns_; i++)
+    this->sent_[i] = ' ';
 }
 #ifdef USE_TIME
 void LCDDisplay::strftime(uint8_t column, uint8_t row, const char *format, time::ESPTime time) {
@@ -58,6 +58,10 @@ class LCDDisplay : public PollingComponent {
   uint8_t columns_;
   uint8_t rows_;
   uint8_t *buffer_{nullptr};
+  /// The characters as last written to the display.
+  uint8_t *sent_{nullptr};
+  /// Write all cells on the next display(), not only the changed ones.
+  bool resend_{true};
 };
 
 }  // namespace lcd_base
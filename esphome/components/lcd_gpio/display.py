@@ -34,6 +34,8 @@ def to_code(config):
     for conf in config[CONF_DATA_PINS]:
         pins_.append((yield cg.gpio_pin_expression(conf)))
     cg.add(var.set_data_pins(*pins_))
+    if not any(key in conf for conf in config[CONF_DATA_PINS] for key in pins.PIN_SCHEMA_REGISTRY):
+        cg.add(var.set_data_pins_internal(True))
     enable = yield cg.gpio_pin_expression(config[CONF_ENABLE_PIN])
     cg.add(var.set_enable_pin(enable))
 
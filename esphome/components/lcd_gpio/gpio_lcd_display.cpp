@@ -22,6 +22,8 @@ void GPIOLCDDisplay::setup() {
     this->data_pins_[i]->digital_write(false);
   }
   LCDDisplay::setup();
+  // the busy flag can only be read once the interface width is set
+  this->use_busy_flag_ = this->rw_pin_ != nullptr;
 }
 void GPIOLCDDisplay::dump_config() {
   ESP_LOGCONFIG(TAG, "GPIO LCD Display:");
@@ -29,6 +31,7 @@ void GPIOLCDDisplay::dump_config() {
   LOG_PIN("  RS Pin: ", this->rs_pin_);
   LOG_PIN("  RW Pin: ", this->rw_pin_);
   LOG_PIN("  Enable Pin: ", this->enable_pin_);
+  ESP_LOGCONFIG(TAG, "  Busy Flag Polling: %s", YESNO(this->rw_pin_ != nullptr));
 
   for (uint8_t i = 0; i < (this->is_four_bit_mode() ? 4 : 8); i++) {
     ESP_LOGCONFIG(TAG, "  Data Pin %u" LOG_PIN_PATTERN, i, LOG_PIN_ARGS(this->data_pins_[i]));
@@ -36,15 +39,54 @@ void GPIOLCDDisplay::dump_config() {
   LOG_UPDATE_INTERVAL(this);
 }
 void GPIOLCDDisplay::write_n_bits(uint8_t value, uint8_t n) {
-  for (uint8_t i = 0; i < n; i++)
-    this->data_pins_[i]->digital_write(value & (1 << i));
+  if (this->data_pins_internal_) {
+    for (uint8_t i = 0; i < n; i++)
+      this->port_writer_.write(this->data_pins_[i], value & (1 << i));
+    this->port_writer_.apply();
+  } else {
+    for (uint8_t i = 0; i < n; i++)
+      this->data_pins_[i]->digital_write(value & (1 << i));
+  }
 
   this->enable_pin_->digital_write(true);
   delayMicroseconds(1);  // >450ns
   this->enable_pin_->digital_write(false);
-  delayMicroseconds(40);  // >37us
+  if (!this->use_busy_flag_)
+    delayMicroseconds(40);  // >37us
+}
+void GPIOLCDDisplay::wait_busy_() {
+  const uint8_t n = this->is_four_bit_mode() ? 4 : 8;
+  for (uint8_t i = 0; i < n; i++)
+    this->data_pins_[i]->pin_mode(INPUT);
+  this->rs_pin_->digital_write(false);
+  this->rw_pin_->digital_write(true);
+
+  // the busy flag is D7, read as the highest bit of the first nibble in 4-bit mode
+  const uint32_t start = micros();
+  bool busy = true;
+  while (busy && micros() - start < 2000) {
+    this->enable_pin_->digital_write(true);
+    delayMicroseconds(1);  // >360ns data delay
+    busy = this->data_pins_[n - 1]->digital_read();
+    this->enable_pin_->digital_write(false);
+    if (n == 4) {
+      // clock out the second nibble
+      delayMicroseconds(1);
+      this->enable_pin_->digital_write(true);
+      delayMicroseconds(1);
+      this->enable_pin_->digital_write(false);
+    }
+    delayMicroseconds(1);
+  }
+
+  this->rw_pin_->digital_write(false);
+  for (uint8_t i = 0; i < n; i++)
+    this->data_pins_[i]->pin_mode(OUTPUT);
 }
 void GPIOLCDDisplay::send(uint8_t value, bool rs) {
+  // poll until the last instruction finished instead of waiting for the longest one
+  if (this->use_busy_flag_)
+    this->wait_busy_();
   this->rs_pin_->digital_write(rs);
 
   if (this->is_four_bit_mode()) {
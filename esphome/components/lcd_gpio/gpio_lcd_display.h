@@ -30,12 +30,16 @@ class GPIOLCDDisplay : public lcd_base::LCDDisplay {
   void set_enable_pin(GPIOPin *enable) { this->enable_pin_ = enable; }
   void set_rs_pin(GPIOPin *rs) { this->rs_pin_ = rs; }
   void set_rw_pin(GPIOPin *rw) { this->rw_pin_ = rw; }
+  /// All data pins are internal GPIOs and can be written at once through a GPIOPortWriter. Set by codegen.
+  void set_data_pins_internal(bool data_pins_internal) { this->data_pins_internal_ = data_pins_internal; }
   void dump_config() override;
 
  protected:
   bool is_four_bit_mode() override { return this->data_pins_[4] == nullptr; }
   void write_n_bits(uint8_t value, uint8_t n) override;
   void send(uint8_t value, bool rs) override;
+  /// Poll the busy flag until the display can take the next instruction, needs the RW pin.
+  void wait_busy_();
 
   void call_writer() override { this->writer_(*this); }
 
@@ -43,6 +47,10 @@ class GPIOLCDDisplay : public lcd_base::LCDDisplay {
   GPIOPin *rw_pin_{nullptr};
   GPIOPin *enable_pin_{nullptr};
   GPIOPin *data_pins_[8]{nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+  bool data_pins_internal_{false};
+  /// Poll the busy flag instead of waiting a fixed time after each write, enabled after setup if RW is connected.
+  bool use_busy_flag_{false};
+  GPIOPortWriter port_writer_;
   std::function<void(GPIOLCDDisplay &)> writer_;
 };
 
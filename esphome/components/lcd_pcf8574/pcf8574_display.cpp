@@ -8,6 +8,7 @@ static const char *TAG = "lcd_pcf8574";
 
 static const uint8_t LCD_DISPLAY_BACKLIGHT_ON = 0x08;
 static const uint8_t LCD_DISPLAY_BACKLIGHT_OFF = 0x00;
+static const uint8_t LCD_DISPLAY_ENABLE = 0x04;
 
 void PCF8574LCDDisplay::setup() {
   ESP_LOGCONFIG(TAG, "Setting up PCF8574 LCD Display...");
@@ -34,16 +35,18 @@ void PCF8574LCDDisplay::write_n_bits(uint8_t value, uint8_t n) {
     value <<= 4;
   }
   uint8_t data = value | this->backlight_value_;  // Set backlight state
-  this->write_bytes(data, nullptr, 0);
-  // Pulse ENABLE
-  this->write_bytes(data | 0x04, nullptr, 0);
-  delayMicroseconds(1);  // >450ns
-  this->write_bytes(data, nullptr, 0);
+  // Pulse ENABLE, each byte takes longer than the >450ns pulse width
+  const uint8_t pulse[2] = {uint8_t(data | LCD_DISPLAY_ENABLE), data};
+  this->write_bytes(data, pulse, 2);
   delayMicroseconds(100);  // >37us
 }
 void PCF8574LCDDisplay::send(uint8_t value, bool rs) {
-  this->write_n_bits((value & 0xF0) | rs, 0);
-  this->write_n_bits(((value << 4) & 0xF0) | rs, 0);
+  // both nibbles with their ENABLE pulses in a single transaction, the start of the next transaction takes longer
+  // than the >37us the display needs to process the byte
+  const uint8_t high = (value & 0xF0) | rs | this->backlight_value_;
+  const uint8_t low = ((value << 4) & 0xF0) | rs | this->backlight_value_;
+  const uint8_t data[5] = {uint8_t(high | LCD_DISPLAY_ENABLE), high, low, uint8_t(low | LCD_DISPLAY_ENABLE), low};
+  this->write_bytes(high, data, 5);
 }
 void PCF8574LCDDisplay::backlight() {
   this->backlight_value_ = LCD_DISPLAY_BACKLIGHT_ON;
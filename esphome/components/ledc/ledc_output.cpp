@@ -4,13 +4,34 @@
 #ifdef ARDUINO_ARCH_ESP32
 
 #include <esp32-hal-ledc.h>
+#include <driver/ledc.h>
 
 namespace esphome {
 namespace ledc {
 
 static const char *TAG = "ledc.output";
 
-void LEDCOutput::write_state(float state) {
+static bool fade_func_installed = false;  // NOLINT
+
+// The Arduino core puts channels 0-7 into the high speed group and 8-15 into the low speed group.
+static ledc_mode_t ledc_speed_mode(uint8_t channel) { return static_cast<ledc_mode_t>(channel / 8); }
+static ledc_channel_t ledc_channel(uint8_t channel) { return static_cast<ledc_channel_t>(channel % 8); }
+
+void LEDCOutput::write_state(float state) { this->write_duty_(state, 0); }
+
+void LEDCOutput::write_state_fade(float state, uint32_t length) { this->write_duty_(state, length); }
+
+void LEDCOutput::write_duty_(float state, uint32_t fade_length) {
+  const uint32_t now = millis();
+  if (int32_t(this->fade_end_ - now) > 0) {
+    this->pending_state_ = state;
+    this->pending_fade_length_ = fade_length;
+    this->set_timeout("fade", this->fade_end_ - now,
+                      [this]() { this->write_duty_(this->pending_state_, this->pending_fade_length_); });
+    return;
+  }
+  this->cancel_timeout("fade");
+
   if (this->pin_->is_inverted())
     state = 1.0f - state;
 
@@ -18,10 +39,34 @@ void LEDCOutput::write_state(float state) {
   const uint32_t max_duty = (uint32_t(1) << this->bit_depth_) - 1;
   const float duty_rounded = roundf(state * max_duty);
   auto duty = static_cast<uint32_t>(duty_rounded);
-  ledcWrite(this->channel_, duty);
+  const ledc_mode_t speed_mode = ledc_speed_mode(this->channel_);
+  const ledc_channel_t channel = ledc_channel(this->channel_);
+  this->fade_ = fade_length != 0;
+  if (this->fade_) {
+    ledc_set_fade_with_time(speed_mode, channel, duty, fade_length);
+    // the fade driver's interrupt ends the fade shortly after the last step
+    this->fade_end_ = now + fade_length + 1;
+  } else {
+    ledc_set_duty(speed_mode, channel, duty);
+  }
+  this->request_latch_();
+}
+
+void LEDCOutput::latch_() {
+  const ledc_mode_t speed_mode = ledc_speed_mode(this->channel_);
+  const ledc_channel_t channel = ledc_channel(this->channel_);
+  if (this->fade_) {
+    ledc_fade_start(speed_mode, channel, LEDC_FADE_NO_WAIT);
+  } else {
+    ledc_update_duty(speed_mode, channel);
+  }
 }
 
 void LEDCOutput::setup() {
+  if (!fade_func_installed) {
+    ledc_fade_func_install(0);
+    fade_func_installed = true;
+  }
   this->update_frequency(this->frequency_);
   this->turn_off();
   // Attach pin after setting default value
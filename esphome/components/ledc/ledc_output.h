@@ -29,13 +29,28 @@ class LEDCOutput : public output::FloatOutput, public Component {
 
   /// Override FloatOutput's write_state.
   void write_state(float state) override;
+  /// The LEDC peripheral fades by itself, see write_state_fade().
+  bool supports_fade() const override { return true; }
 
  protected:
+  /// Start a hardware fade to state with the LEDC fade driver.
+  void write_state_fade(float state, uint32_t length) override;
+  /// Start the fade or apply the duty written last, all channels of a light together within a LatchGuard.
+  void latch_() override;
+  /// Write the duty, fading within fade_length ms unless it is 0.
+  void write_duty_(float state, uint32_t fade_length);
+
   GPIOPin *pin_;
   uint8_t channel_{};
   uint8_t bit_depth_{};
   float frequency_{};
   float duty_{0.0f};
+  /// Whether the duty written last is a fade that latch_() starts.
+  bool fade_{false};
+  /// The fade driver blocks writes to a channel until its fade has ended, so they are held back until then.
+  uint32_t fade_end_{0};
+  float pending_state_{0.0f};
+  uint32_t pending_fade_length_{0};
 };
 
 template<typename... Ts> class SetFrequencyAction : public Action<Ts...> {
@@ -5,18 +5,21 @@ from esphome.components import mqtt, power_supply
 from esphome.const import CONF_COLOR_CORRECT, \
     CONF_DEFAULT_TRANSITION_LENGTH, CONF_EFFECTS, CONF_GAMMA_CORRECT, CONF_ID, \
     CONF_INTERNAL, CONF_NAME, CONF_MQTT_ID, CONF_POWER_SUPPLY, CONF_RESTORE_MODE, \
-    CONF_ON_TURN_OFF, CONF_ON_TURN_ON, CONF_TRIGGER_ID
+    CONF_ON_TURN_OFF, CONF_ON_TURN_ON, CONF_TRIGGER_ID, CONF_PSRAM
 from esphome.core import coroutine, coroutine_with_priority
 from .automation import light_control_to_code  # noqa
 from .effects import validate_effects, BINARY_EFFECTS, \
     MONOCHROMATIC_EFFECTS, RGB_EFFECTS, ADDRESSABLE_EFFECTS, EFFECTS_REGISTRY
 from .types import (  # noqa
     LightState, AddressableLightState, light_ns, LightOutput, AddressableLight, \
-    LightTurnOnTrigger, LightTurnOffTrigger)
+    AddressableOutputGroup, LightTurnOnTrigger, LightTurnOffTrigger)
 
 CODEOWNERS = ['@esphome/core']
 IS_PLATFORM_COMPONENT = True
 
+CONF_EFFECT_MAX_LEDS_PER_PASS = 'effect_max_leds_per_pass'
+CONF_EFFECT_UPDATE_INTERVAL = 'effect_update_interval'
+
 LightRestoreMode = light_ns.enum('LightRestoreMode')
 RESTORE_MODES = {
     'RESTORE_DEFAULT_OFF': LightRestoreMode.LIGHT_RESTORE_DEFAULT_OFF,
@@ -57,6 +60,9 @@ ADDRESSABLE_LIGHT_SCHEMA = RGB_LIGHT_SCHEMA.extend({
     cv.Optional(CONF_EFFECTS): validate_effects(ADDRESSABLE_EFFECTS),
     cv.Optional(CONF_COLOR_CORRECT): cv.All([cv.percentage], cv.Length(min=3, max=4)),
     cv.Optional(CONF_POWER_SUPPLY): cv.use_id(power_supply.PowerSupply),
+    cv.Optional(CONF_EFFECT_UPDATE_INTERVAL): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_EFFECT_MAX_LEDS_PER_PASS): cv.int_range(min=0, max=65535),
+    cv.Optional(CONF_PSRAM): cv.All(cv.only_on_esp32, cv.boolean),
 })
 
 
@@ -65,6 +71,8 @@ def setup_light_core_(light_var, output_var, config):
     cg.add(light_var.set_restore_mode(config[CONF_RESTORE_MODE]))
     if CONF_INTERNAL in config:
         cg.add(light_var.set_internal(config[CONF_INTERNAL]))
+    if not config.get(CONF_INTERNAL, False):
+        cg.add_define('USE_CONTROLLER_LIGHT')
     if CONF_DEFAULT_TRANSITION_LENGTH in config:
         cg.add(light_var.set_default_transition_length(config[CONF_DEFAULT_TRANSITION_LENGTH]))
     if CONF_GAMMA_CORRECT in config:
@@ -86,6 +94,13 @@ def setup_light_core_(light_var, output_var, config):
         var_ = yield cg.get_variable(config[CONF_POWER_SUPPLY])
         cg.add(output_var.set_power_supply(var_))
 
+    if CONF_EFFECT_UPDATE_INTERVAL in config:
+        cg.add(output_var.set_effect_update_interval(config[CONF_EFFECT_UPDATE_INTERVAL]))
+    if CONF_EFFECT_MAX_LEDS_PER_PASS in config:
+        cg.add(output_var.set_effect_max_leds_per_pass(config[CONF_EFFECT_MAX_LEDS_PER_PASS]))
+    if CONF_PSRAM in config:
+        cg.add(output_var.set_buffer_location(cg.buffer_location(config[CONF_PSRAM])))
+
     if CONF_MQTT_ID in config:
         mqtt_ = cg.new_Pvariable(config[CONF_MQTT_ID], light_var)
         yield mqtt.register_mqtt_component(mqtt_, config)
@@ -93,7 +108,8 @@ def setup_light_core_(light_var, output_var, config):
 
 @coroutine
 def register_light(output_var, config):
-    light_var = cg.new_Pvariable(config[CONF_ID], config[CONF_NAME], output_var)
+    light_var = cg.new_Pvariable(config[CONF_ID], '', output_var)
+    cg.setup_entity_name(light_var, config[CONF_NAME])
     cg.add(cg.App.register_light(light_var))
     yield cg.register_component(light_var, config)
     yield setup_light_core_(light_var, output_var, config)
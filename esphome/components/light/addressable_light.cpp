@@ -1,5 +1,6 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace light {
@@ -76,11 +77,24 @@ ESPColor ESPHSVColor::to_rgb() const {
   return rgb;
 }
 
-void ESPRangeView::set(const ESPColor &color) {
-  for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
+void HOT hsv_to_rgb_span(const ESPHSVColor *hsv, size_t count, uint8_t *rgb) {
+  for (size_t i = 0; i < count; i++, rgb += 3) {
+    const ESPColor color = hsv[i].to_rgb();
+    rgb[0] = color.red;
+    rgb[1] = color.green;
+    rgb[2] = color.blue;
   }
 }
+
+void ESPColorPalette::set_rainbow(uint8_t saturation, uint8_t value) {
+  ESPHSVColor hsv(0, saturation, value);
+  for (uint16_t hue = 0; hue < 256; hue++) {
+    hsv.hue = hue;
+    this->set(hue, hsv.to_rgb());
+  }
+}
+
+void ESPRangeView::set(const ESPColor &color) { this->parent_->fill_range(this->begin_, this->end_, color); }
 ESPColorView ESPRangeView::operator[](int32_t index) const {
   index = interpret_index(index, this->size()) + this->begin_;
   return (*this->parent_)[index];
@@ -111,10 +125,7 @@ void ESPRangeView::fade_to_white(uint8_t amnt) {
   for (auto c : *this)
     c.fade_to_white(amnt);
 }
-void ESPRangeView::fade_to_black(uint8_t amnt) {
-  for (auto c : *this)
-    c.fade_to_black(amnt);
-}
+void ESPRangeView::fade_to_black(uint8_t amnt) { this->parent_->scale_range(this->begin_, this->end_, amnt); }
 void ESPRangeView::lighten(uint8_t delta) {
   for (auto c : *this)
     c.lighten(delta);
@@ -179,6 +190,188 @@ void AddressableLight::call_setup() {
 #endif
 }
 
+/// Spans with at least this many LEDs map each channel through a table instead of correcting every LED.
+static const size_t SPAN_TABLE_MIN_LENGTH = 256;
+
+static int32_t clamp_index(int32_t index, int32_t min, int32_t max) { return std::max(min, std::min(index, max)); }
+
+/// Write f(*src) to *dst for count LEDs, dst and src may point to the same channel.
+template<typename F>
+static void HOT map_channel(uint8_t *dst, uint8_t dst_stride, const uint8_t *src, uint8_t src_stride, size_t count,
+                            F f) {
+  if (count >= SPAN_TABLE_MIN_LENGTH) {
+    // evaluate every possible value once instead of once per LED
+    uint8_t table[256];
+    for (uint16_t value = 0; value < 256; value++)
+      table[value] = f(value);
+    for (size_t i = 0; i < count; i++, dst += dst_stride, src += src_stride)
+      *dst = table[*src];
+  } else {
+    for (size_t i = 0; i < count; i++, dst += dst_stride, src += src_stride)
+      *dst = f(*src);
+  }
+}
+
+void HOT AddressableLight::fill_range(int32_t from, int32_t to, const ESPColor &color) {
+  from = clamp_index(interpret_index(from, this->size()), 0, this->size());
+  to = clamp_index(interpret_index(to, this->size()), from, this->size());
+  this->fill_range_internal(from, to, color, this->correction_);
+}
+void HOT AddressableLight::fill_range_internal(int32_t from, int32_t to, const ESPColor &color,
+                                               const ESPColorCorrection &correction) {
+  RawPixels raw;
+  if (!this->get_raw_pixels_(&raw)) {
+    for (int32_t i = from; i < to; i++) {
+      ESPColorView view = this->get_view_internal(i);
+      view.raw_set_color_correction(&correction);
+      view.set(color);
+    }
+    return;
+  }
+
+  // all LEDs get the same color, so it only has to be corrected once
+  const ESPColor corrected = correction.color_correct(color);
+  uint8_t *data = raw.data + from * raw.stride;
+  for (int32_t i = from; i < to; i++, data += raw.stride) {
+    data[raw.red] = corrected.red;
+    data[raw.green] = corrected.green;
+    data[raw.blue] = corrected.blue;
+  }
+  if (raw.white >= 0) {
+    data = raw.data + from * raw.stride;
+    for (int32_t i = from; i < to; i++, data += raw.stride)
+      data[raw.white] = corrected.white;
+  }
+}
+
+void HOT AddressableLight::write_rgb_span(const uint8_t *data, size_t count, int32_t offset) {
+  offset = clamp_index(interpret_index(offset, this->size()), 0, this->size());
+  count = std::min(count, size_t(this->size() - offset));
+  this->write_rgb_span_internal(data, count, offset, this->correction_);
+}
+void HOT AddressableLight::write_rgb_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                                                   const ESPColorCorrection &correction) {
+  RawPixels raw;
+  if (!this->get_raw_pixels_(&raw)) {
+    for (size_t i = 0; i < count; i++, data += 3) {
+      ESPColorView view = this->get_view_internal(offset + i);
+      view.raw_set_color_correction(&correction);
+      view.set_rgb(data[0], data[1], data[2]);
+    }
+    return;
+  }
+
+  uint8_t *base = raw.data + offset * raw.stride;
+  map_channel(base + raw.red, raw.stride, data + 0, 3, count,
+              [&correction](uint8_t value) { return correction.color_correct_red(value); });
+  map_channel(base + raw.green, raw.stride, data + 1, 3, count,
+              [&correction](uint8_t value) { return correction.color_correct_green(value); });
+  map_channel(base + raw.blue, raw.stride, data + 2, 3, count,
+              [&correction](uint8_t value) { return correction.color_correct_blue(value); });
+}
+
+void HOT AddressableLight::write_rgbw_span(const uint8_t *data, size_t count, int32_t offset) {
+  offset = clamp_index(interpret_index(offset, this->size()), 0, this->size());
+  count = std::min(count, size_t(this->size() - offset));
+  this->write_rgbw_span_internal(data, count, offset, this->correction_);
+}
+void HOT AddressableLight::write_rgbw_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                                                    const ESPColorCorrection &correction) {
+  RawPixels raw;
+  if (!this->get_raw_pixels_(&raw)) {
+    for (size_t i = 0; i < count; i++, data += 4) {
+      ESPColorView view = this->get_view_internal(offset + i);
+      view.raw_set_color_correction(&correction);
+      view.set(ESPColor(data[0], data[1], data[2], data[3]));
+    }
+    return;
+  }
+
+  uint8_t *base = raw.data + offset * raw.stride;
+  map_channel(base + raw.red, raw.stride, data + 0, 4, count,
+              [&correction](uint8_t value) { return correction.color_correct_red(value); });
+  map_channel(base + raw.green, raw.stride, data + 1, 4, count,
+              [&correction](uint8_t value) { return correction.color_correct_green(value); });
+  map_channel(base + raw.blue, raw.stride, data + 2, 4, count,
+              [&correction](uint8_t value) { return correction.color_correct_blue(value); });
+  if (raw.white >= 0) {
+    map_channel(base + raw.white, raw.stride, data + 3, 4, count,
+                [&correction](uint8_t value) { return correction.color_correct_white(value); });
+  }
+}
+
+/// The number of LEDs converted at once by the HSV and palette writes, on the stack.
+static const size_t SPAN_CHUNK_LEDS = 32;
+
+void HOT AddressableLight::write_hsv_span(const ESPHSVColor *hsv, size_t count, int32_t offset) {
+  offset = clamp_index(interpret_index(offset, this->size()), 0, this->size());
+  count = std::min(count, size_t(this->size() - offset));
+  uint8_t rgb[SPAN_CHUNK_LEDS * 3];
+  while (count != 0) {
+    const size_t chunk = std::min(count, SPAN_CHUNK_LEDS);
+    hsv_to_rgb_span(hsv, chunk, rgb);
+    this->write_rgb_span_internal(rgb, chunk, offset, this->correction_);
+    hsv += chunk;
+    offset += chunk;
+    count -= chunk;
+  }
+}
+void HOT AddressableLight::write_palette_gradient(const ESPColorPalette &palette, int32_t from, int32_t to,
+                                                  uint16_t index, uint16_t step) {
+  from = clamp_index(interpret_index(from, this->size()), 0, this->size());
+  to = clamp_index(interpret_index(to, this->size()), from, this->size());
+  uint8_t rgb[SPAN_CHUNK_LEDS * 3];
+  while (from < to) {
+    const size_t chunk = std::min(size_t(to - from), SPAN_CHUNK_LEDS);
+    uint8_t *dst = rgb;
+    for (size_t i = 0; i < chunk; i++, dst += 3, index += step) {
+      const uint8_t *src = palette.get_rgb(index >> 8);
+      dst[0] = src[0];
+      dst[1] = src[1];
+      dst[2] = src[2];
+    }
+    this->write_rgb_span_internal(rgb, chunk, from, this->correction_);
+    from += chunk;
+  }
+}
+
+void HOT AddressableLight::scale_range(int32_t from, int32_t to, uint8_t scale) {
+  from = clamp_index(interpret_index(from, this->size()), 0, this->size());
+  to = clamp_index(interpret_index(to, this->size()), from, this->size());
+  this->scale_range_internal(from, to, scale, this->correction_);
+}
+void HOT AddressableLight::scale_range_internal(int32_t from, int32_t to, uint8_t scale,
+                                                const ESPColorCorrection &correction) {
+  RawPixels raw;
+  if (!this->get_raw_pixels_(&raw)) {
+    for (int32_t i = from; i < to; i++) {
+      ESPColorView view = this->get_view_internal(i);
+      view.raw_set_color_correction(&correction);
+      view.fade_to_black(scale);
+    }
+    return;
+  }
+
+  // scale the uncorrected value, like ESPColorView::fade_to_black()
+  const size_t count = to - from;
+  uint8_t *base = raw.data + from * raw.stride;
+  map_channel(base + raw.red, raw.stride, base + raw.red, raw.stride, count, [&correction, scale](uint8_t value) {
+    return correction.color_correct_red(esp_scale8(correction.color_uncorrect_red(value), scale));
+  });
+  map_channel(base + raw.green, raw.stride, base + raw.green, raw.stride, count, [&correction, scale](uint8_t value) {
+    return correction.color_correct_green(esp_scale8(correction.color_uncorrect_green(value), scale));
+  });
+  map_channel(base + raw.blue, raw.stride, base + raw.blue, raw.stride, count, [&correction, scale](uint8_t value) {
+    return correction.color_correct_blue(esp_scale8(correction.color_uncorrect_blue(value), scale));
+  });
+  if (raw.white >= 0) {
+    map_channel(base + raw.white, raw.stride, base + raw.white, raw.stride, count,
+                [&correction, scale](uint8_t value) {
+                  return correction.color_correct_white(esp_scale8(correction.color_uncorrect_white(value), scale));
+                });
+  }
+}
+
 ESPColor esp_color_from_light_color_values(LightColorValues val) {
   auto r = static_cast<uint8_t>(roundf(val.get_red() * 255.0f));
   auto g = static_cast<uint8_t>(roundf(val.get_green() * 255.0f));
@@ -2,8 +2,10 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
 #include "light_output.h"
 #include "light_state.h"
+#include "addressable_output.h"
 
 #ifdef USE_POWER_SUPPLY
 #include "esphome/components/power_supply/power_supply.h"
@@ -184,6 +186,34 @@ struct ESPHSVColor {
   ESPColor to_rgb() const;
 };
 
+/// Convert count HSV colors to RGB triplets (3 bytes per color) at rgb.
+void hsv_to_rgb_span(const ESPHSVColor *hsv, size_t count, uint8_t *rgb);
+
+/** 256 RGB colors looked up by a byte, for effects that map a position or phase to a color.
+ *
+ * Filled once, a lookup per LED then replaces the color conversion. Takes 768 bytes, so effects with a fixed
+ * palette should share one.
+ */
+class ESPColorPalette {
+ public:
+  /// Fill with the hue wheel at the given saturation and value, the index is the hue.
+  void set_rainbow(uint8_t saturation, uint8_t value);
+  void set(uint8_t index, const ESPColor &color) {
+    uint8_t *rgb = &this->rgb_[index * 3];
+    rgb[0] = color.red;
+    rgb[1] = color.green;
+    rgb[2] = color.blue;
+  }
+  ESPColor get(uint8_t index) const {
+    const uint8_t *rgb = this->get_rgb(index);
+    return ESPColor(rgb[0], rgb[1], rgb[2]);
+  }
+  const uint8_t *get_rgb(uint8_t index) const { return &this->rgb_[index * 3]; }
+
+ protected:
+  uint8_t rgb_[256 * 3];
+};
+
 class ESPColorCorrection {
  public:
   ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
@@ -450,6 +480,36 @@ class AddressableLight : public LightOutput, public Component {
       amnt = this->size();
     this->range(amnt, this->size()) = this->range(0, -amnt);
   }
+  /// Set all LEDs from `from` up to (not including) `to` to color, indices are interpreted like in range().
+  void fill_range(int32_t from, int32_t to, const ESPColor &color);
+  /** Set count LEDs starting at offset to the RGB triplets in data, the white channel is not changed.
+   *
+   * For long strips this is much faster than setting every LED through its view.
+   */
+  void write_rgb_span(const uint8_t *data, size_t count, int32_t offset = 0);
+  /// Set count LEDs starting at offset to the RGBW quadruplets in data, the white byte is ignored by RGB lights.
+  void write_rgbw_span(const uint8_t *data, size_t count, int32_t offset = 0);
+  /// Set count LEDs starting at offset to the HSV colors at hsv, the white channel is not changed.
+  void write_hsv_span(const ESPHSVColor *hsv, size_t count, int32_t offset = 0);
+  /** Set the LEDs from `from` up to (not including) `to` to the palette colors at index, index + step, ...
+   *
+   * index and step are 8.8 fixed point, the upper byte selects the color. The white channel is not changed.
+   */
+  void write_palette_gradient(const ESPColorPalette &palette, int32_t from, int32_t to, uint16_t index,
+                              uint16_t step);
+  /// Scale the color of all LEDs from `from` up to (not including) `to`, same as fade_to_black(scale) on each LED.
+  void scale_range(int32_t from, int32_t to, uint8_t scale);
+  /** The span operations above with the color correction to apply, indices must be within the light.
+   *
+   * Partitions override these to forward their spans to the underlying lights with their own correction.
+   */
+  virtual void fill_range_internal(int32_t from, int32_t to, const ESPColor &color,
+                                   const ESPColorCorrection &correction);
+  virtual void write_rgb_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                                       const ESPColorCorrection &correction);
+  virtual void write_rgbw_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                                        const ESPColorCorrection &correction);
+  virtual void scale_range_internal(int32_t from, int32_t to, uint8_t scale, const ESPColorCorrection &correction);
   bool is_effect_active() const { return this->effect_active_; }
   void set_effect_active(bool effect_active) { this->effect_active_ = effect_active; }
   void write_state(LightState *state) override;
@@ -462,6 +522,27 @@ class AddressableLight : public LightOutput, public Component {
     this->state_parent_ = state;
   }
   void schedule_show() { this->next_show_ = true; }
+  /// Set the targeted number of frames per second, 0 (the default) refreshes the LEDs as fast as possible.
+  void set_frame_rate(uint32_t frame_rate) { this->frame_pacer_.set_frame_rate(frame_rate); }
+  /// The number of frames that couldn't be sent at the configured frame rate.
+  uint32_t get_dropped_frames() const { return this->frame_pacer_.get_dropped_frames(); }
+  /// Set the interval between two effect frames in ms, 0 (the default) renders a frame on every loop iteration.
+  void set_effect_update_interval(uint32_t update_interval) {
+    this->render_scheduler_.set_update_interval(update_interval);
+  }
+  /// Set the maximum number of LEDs an effect renders per loop iteration, for effects that support partial frames.
+  void set_effect_max_leds_per_pass(uint32_t max_leds_per_pass) {
+    this->render_scheduler_.set_max_leds_per_pass(max_leds_per_pass);
+  }
+  EffectRenderScheduler &get_render_scheduler() { return this->render_scheduler_; }
+  /// The number of effect frames rendered per second.
+  float get_effect_fps() const { return this->render_scheduler_.get_fps(); }
+  /// The time in µs it took to render the last effect frame.
+  uint32_t get_effect_render_time() const { return this->render_scheduler_.get_render_time(); }
+  /** Where the effect data and back buffer are allocated, by default in PSRAM if available. Must be called before
+   * setup(). The buffer the LED driver sends from always stays in internal RAM, it's read from interrupts.
+   */
+  void set_buffer_location(BufferLocation buffer_location) { this->buffer_location_ = buffer_location; }
 
 #ifdef USE_POWER_SUPPLY
   void set_power_supply(power_supply::PowerSupply *power_supply) { this->power_.set_parent(power_supply); }
@@ -470,7 +551,14 @@ class AddressableLight : public LightOutput, public Component {
   void call_setup() override;
 
  protected:
-  bool should_show_() const { return this->effect_active_ || this->next_show_; }
+  bool should_show_() const {
+    // don't show partially rendered frames, paced effects schedule a show for every frame
+    if (this->render_scheduler_.is_frame_in_progress())
+      return false;
+    return this->next_show_ || this->renders_every_loop_();
+  }
+  /// Whether an effect renders a new frame on every loop iteration.
+  bool renders_every_loop_() const { return this->effect_active_ && !this->render_scheduler_.is_paced(); }
   void mark_shown_() {
     this->next_show_ = false;
 #ifdef USE_POWER_SUPPLY
@@ -485,9 +573,28 @@ class AddressableLight : public LightOutput, public Component {
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
 
+  /// The layout of a contiguous pixel buffer with a fixed number of bytes per LED.
+  struct RawPixels {
+    uint8_t *data;  ///< The first byte of the first LED.
+    uint8_t stride;  ///< The number of bytes per LED.
+    uint8_t red;  ///< The offset of the red channel within a LED, same for green and blue.
+    uint8_t green;
+    uint8_t blue;
+    int8_t white;  ///< The offset of the white channel, -1 if the LEDs have no white channel.
+  };
+  /** Backends with a contiguous pixel buffer describe it here so that fill_range(), write_rgb_span() and
+   * scale_range() can operate on it directly instead of going through get_view_internal() for every LED.
+   *
+   * @return false if the pixels can only be accessed through views.
+   */
+  virtual bool get_raw_pixels_(RawPixels *raw) const { return false; }
+
   bool effect_active_{false};
   bool next_show_{true};
   ESPColorCorrection correction_{};
+  FramePacer frame_pacer_{};
+  EffectRenderScheduler render_scheduler_{};
+  BufferLocation buffer_location_{BUFFER_LOCATION_PREFER_EXTERNAL};
 #ifdef USE_POWER_SUPPLY
   power_supply::PowerSupplyRequester power_;
 #endif
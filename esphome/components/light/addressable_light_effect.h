@@ -31,21 +31,53 @@ class AddressableLightEffect : public LightEffect {
   void start_internal() override {
     this->get_addressable_()->set_effect_active(true);
     this->get_addressable_()->clear_effect_data();
+    this->get_addressable_()->get_render_scheduler().reset();
+    this->random_.seed(random_uint32());
     this->start();
   }
-  void stop() override { this->get_addressable_()->set_effect_active(false); }
+  void stop() override {
+    this->get_addressable_()->set_effect_active(false);
+    this->get_addressable_()->get_render_scheduler().reset();
+  }
   virtual void apply(AddressableLight &it, const ESPColor &current_color) = 0;
+  /// Whether this effect can render a frame in several passes, see apply_range().
+  virtual bool supports_partial_render() const { return false; }
+  /** Render the LEDs from `from` up to (not including) `to` of the current frame.
+   *
+   * Only called if supports_partial_render() returns true. A frame always starts with from = 0, the
+   * LEDs are refreshed once all passes of the frame are done.
+   */
+  virtual void apply_range(AddressableLight &it, const ESPColor &current_color, int32_t from, int32_t to) {}
   void apply() override {
+    AddressableLight *it = this->get_addressable_();
+    EffectRenderScheduler &scheduler = it->get_render_scheduler();
+    if (!scheduler.render_due(millis()))
+      return;
+
     LightColorValues color = this->state_->remote_values;
     // not using any color correction etc. that will be handled by the addressable layer
     ESPColor current_color =
         ESPColor(static_cast<uint8_t>(color.get_red() * 255), static_cast<uint8_t>(color.get_green() * 255),
                  static_cast<uint8_t>(color.get_blue() * 255), static_cast<uint8_t>(color.get_white() * 255));
-    this->apply(*this->get_addressable_(), current_color);
+    const uint32_t start = micros();
+    int32_t from = 0;
+    int32_t to = it->size();
+    if (this->supports_partial_render()) {
+      scheduler.next_pass(it->size(), &from, &to);
+      this->apply_range(*it, current_color, from, to);
+    } else {
+      this->apply(*it, current_color);
+    }
+    scheduler.pass_done(millis(), micros() - start, to, it->size());
+    if (scheduler.is_paced() && !scheduler.is_frame_in_progress())
+      it->schedule_show();
   }
 
  protected:
   AddressableLight *get_addressable_() const { return (AddressableLight *) this->state_->get_output(); }
+
+  /// Random numbers for the frames of the effect, seeded when it starts.
+  FastRandom random_;
 };
 
 class AddressableLambdaLightEffect : public AddressableLightEffect {
@@ -75,23 +107,33 @@ class AddressableRainbowLightEffect : public AddressableLightEffect {
  public:
   explicit AddressableRainbowLightEffect(const std::string &name) : AddressableLightEffect(name) {}
   void apply(AddressableLight &it, const ESPColor &current_color) override {
-    ESPHSVColor hsv;
-    hsv.value = 255;
-    hsv.saturation = 240;
-    uint16_t hue = (millis() * this->speed_) % 0xFFFF;
+    this->apply_range(it, current_color, 0, it.size());
+  }
+  bool supports_partial_render() const override { return true; }
+  void apply_range(AddressableLight &it, const ESPColor &current_color, int32_t from, int32_t to) override {
+    if (from == 0)
+      this->frame_hue_ = (millis() * this->speed_) % 0xFFFF;
     const uint16_t add = 0xFFFF / this->width_;
-    for (auto var : it) {
-      hsv.hue = hue >> 8;
-      var = hsv;
-      hue += add;
-    }
+    const uint16_t hue = this->frame_hue_ + uint16_t(from) * add;
+    it.write_palette_gradient(get_palette_(), from, to, hue, add);
   }
   void set_speed(uint32_t speed) { this->speed_ = speed; }
   void set_width(uint16_t width) { this->width_ = width; }
 
  protected:
+  /// The colors of the rainbow, shared by all rainbow effects and only allocated once one is used.
+  static const ESPColorPalette &get_palette_() {
+    static ESPColorPalette *palette = nullptr;  // NOLINT
+    if (palette == nullptr) {
+      palette = new ESPColorPalette();  // NOLINT
+      palette->set_rainbow(240, 255);
+    }
+    return *palette;
+  }
+
   uint32_t speed_{10};
   uint16_t width_{50};
+  uint16_t frame_hue_{0};
 };
 
 struct AddressableColorWipeEffectColor {
@@ -202,8 +244,8 @@ class AddressableTwinkleEffect : public AddressableLightEffect {
         view = ESPColor::BLACK;
       }
     }
-    while (random_float() < this->twinkle_probability_) {
-      const size_t pos = random_uint32() % addressable.size();
+    while (this->random_.next_float() < this->twinkle_probability_) {
+      const size_t pos = this->random_.next_below(addressable.size());
       if (addressable[pos].get_effect_data() != 0)
         continue;
       addressable[pos].set_effect_data(1);
@@ -248,11 +290,11 @@ class AddressableRandomTwinkleEffect : public AddressableLightEffect {
         view = ESPColor(0, 0, 0, 0);
       }
     }
-    while (random_float() < this->twinkle_probability_) {
-      const size_t pos = random_uint32() % it.size();
+    while (this->random_.next_float() < this->twinkle_probability_) {
+      const size_t pos = this->random_.next_below(it.size());
       if (it[pos].get_effect_data() != 0)
         continue;
-      const uint8_t color = random_uint32() & 0b111;
+      const uint8_t color = this->random_.next_8() & 0b111;
       it[pos].set_effect_data(0b1000 | color);
     }
   }
@@ -291,8 +333,8 @@ class AddressableFireworksEffect : public AddressableLightEffect {
       it[i] = (it[i - 1].get() * 64) + it[i].get() + (it[i + 1].get() * 64);
     }
     it[last] = it[last].get() + (it[last - 1].get() * 128);
-    if (random_float() < this->spark_probability_) {
-      const size_t pos = random_uint32() % it.size();
+    if (this->random_.next_float() < this->spark_probability_) {
+      const size_t pos = this->random_.next_below(it.size());
       if (this->use_random_color_) {
         it[pos] = ESPColor::random_color();
       } else {
@@ -324,9 +366,8 @@ class AddressableFlickerEffect : public AddressableLightEffect {
       return;
 
     this->last_update_ = now;
-    fast_random_set_seed(random_uint32());
     for (auto var : it) {
-      const uint8_t flicker = fast_random_8() % intensity;
+      const uint8_t flicker = this->random_.next_8() % intensity;
       // scale down by random factor
       var = var.get() * (255 - flicker);
 
@@ -0,0 +1,29 @@
+#include "addressable_light_render_sensor.h"
+
+#ifdef USE_SENSOR
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace light {
+
+static const char *TAG = "light.render_sensor";
+
+void AddressableLightRenderSensor::update() {
+  auto *it = this->get_addressable_();
+  if (this->fps_sensor_ != nullptr)
+    this->fps_sensor_->publish_state(it->is_effect_active() ? it->get_effect_fps() : 0.0f);
+  if (this->render_time_sensor_ != nullptr)
+    this->render_time_sensor_->publish_state(it->get_effect_render_time());
+}
+void AddressableLightRenderSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Addressable Light Render Sensor '%s':", this->state_->get_name().c_str());
+  LOG_SENSOR("  ", "FPS", this->fps_sensor_);
+  LOG_SENSOR("  ", "Render Time", this->render_time_sensor_);
+}
+float AddressableLightRenderSensor::get_setup_priority() const { return setup_priority::DATA; }
+
+}  // namespace light
+}  // namespace esphome
+
+#endif
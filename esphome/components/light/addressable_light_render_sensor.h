@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SENSOR
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "light_state.h"
+#include "addressable_light.h"
+
+namespace esphome {
+namespace light {
+
+/// Reports how fast the effects of an addressable light render, useful to tune effect_update_interval.
+class AddressableLightRenderSensor : public PollingComponent {
+ public:
+  explicit AddressableLightRenderSensor(LightState *state) : state_(state) {}
+
+  void set_fps_sensor(sensor::Sensor *fps_sensor) { fps_sensor_ = fps_sensor; }
+  void set_render_time_sensor(sensor::Sensor *render_time_sensor) { render_time_sensor_ = render_time_sensor; }
+
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+ protected:
+  AddressableLight *get_addressable_() const { return (AddressableLight *) this->state_->get_output(); }
+
+  LightState *state_;
+  sensor::Sensor *fps_sensor_{nullptr};
+  sensor::Sensor *render_time_sensor_{nullptr};
+};
+
+}  // namespace light
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,124 @@
+#include "addressable_output.h"
+#include "esphome/core/log.h"
+#include "esphome/core/esphal.h"
+
+namespace esphome {
+namespace light {
+
+static const char *TAG = "light.addressable_output";
+
+bool FramePacer::frame_due(uint32_t now, bool continuous) {
+  const bool was_continuous = this->last_continuous_;
+  this->last_continuous_ = continuous;
+  if (this->frame_interval_ == 0)
+    return true;
+
+  const uint32_t elapsed = now - this->last_frame_;
+  if (elapsed < this->frame_interval_)
+    return false;
+  if (continuous && was_continuous)
+    this->dropped_frames_ += elapsed / this->frame_interval_ - 1;
+  // keep a steady frame rate, but don't try to catch up when more than a whole frame late
+  if (elapsed < 2 * this->frame_interval_) {
+    this->last_frame_ += this->frame_interval_;
+  } else {
+    this->last_frame_ = now;
+  }
+  return true;
+}
+
+bool EffectRenderScheduler::render_due(uint32_t now) {
+  if (this->is_frame_in_progress())
+    return true;
+  if (this->update_interval_ != 0 && now - this->last_frame_ < this->update_interval_)
+    return false;
+  this->last_frame_ = now;
+  return true;
+}
+void EffectRenderScheduler::next_pass(int32_t size, int32_t *from, int32_t *to) const {
+  *from = this->next_led_;
+  *to = size;
+  if (this->max_leds_per_pass_ != 0 && size - this->next_led_ > int32_t(this->max_leds_per_pass_))
+    *to = this->next_led_ + this->max_leds_per_pass_;
+}
+void EffectRenderScheduler::pass_done(uint32_t now, uint32_t render_time, int32_t to, int32_t size) {
+  this->frame_render_time_ += render_time;
+  if (to < size) {
+    this->next_led_ = to;
+    return;
+  }
+
+  this->next_led_ = 0;
+  this->render_time_ = this->frame_render_time_;
+  this->frame_render_time_ = 0;
+  this->fps_frames_++;
+  const uint32_t window = now - this->fps_window_start_;
+  if (window >= 1000) {
+    this->fps_ = this->fps_frames_ * 1000.0f / window;
+    this->fps_frames_ = 0;
+    this->fps_window_start_ = now;
+  }
+}
+void EffectRenderScheduler::reset() {
+  this->next_led_ = 0;
+  this->last_frame_ = 0;
+  this->frame_render_time_ = 0;
+  this->render_time_ = 0;
+  this->fps_frames_ = 0;
+  this->fps_window_start_ = millis();
+  this->fps_ = 0.0f;
+}
+
+void AddressableOutputGroup::loop() {
+  if (!this->frame_ready_)
+    return;
+  this->frame_ready_ = false;
+
+  ESP_LOGVV(TAG, "Sending a frame to %u lights...", this->members_.size());
+  for (auto &send : this->members_)
+    send();
+}
+void AddressableOutputGroup::dump_config() {
+  ESP_LOGCONFIG(TAG, "Addressable Output Group:");
+  ESP_LOGCONFIG(TAG, "  Members: %u", this->members_.size());
+}
+// after the lights, so that the frames they marked ready are sent in the same loop iteration
+float AddressableOutputGroup::get_setup_priority() const { return setup_priority::DATA; }
+
+#ifdef ARDUINO_ARCH_ESP32
+void AddressableOutputTask::start(std::function<void()> &&send) {
+  this->send_ = std::move(send);
+  // same core as the main loop, a higher priority only matters while a frame is being sent
+  BaseType_t res = xTaskCreatePinnedToCore(&AddressableOutputTask::task_,
+                                           "addressable_output",  // name
+                                           2048,                  // stack size
+                                           this,                  // task pv params
+                                           2,                     // priority
+                                           &this->handle_,        // handle
+                                           1                      // core
+  );
+  if (res != pdPASS) {
+    ESP_LOGE(TAG, "Could not create output task, sending frames from the main loop");
+    this->handle_ = nullptr;
+  }
+}
+void AddressableOutputTask::send_frame() {
+  if (this->handle_ == nullptr) {
+    this->send_();
+    return;
+  }
+  this->busy_ = true;
+  xTaskNotifyGive(this->handle_);
+}
+void AddressableOutputTask::task_(void *arg) {
+  auto *self = reinterpret_cast<AddressableOutputTask *>(arg);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->send_();
+    self->busy_ = false;
+  }
+}
+#endif
+
+}  // namespace light
+}  // namespace esphome
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include <functional>
+#include <vector>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace light {
+
+/// Limits how often an addressable light sends a frame to the LEDs and counts the frames that weren't sent in time.
+class FramePacer {
+ public:
+  /// Set the targeted number of frames per second, 0 sends frames as fast as possible.
+  void set_frame_rate(uint32_t frame_rate) { this->frame_interval_ = frame_rate == 0 ? 0 : 1000000UL / frame_rate; }
+  /** Check if the next frame may be sent now.
+   *
+   * @param now The current time in µs.
+   * @param continuous Whether an effect renders every frame. If so, frame slots that passed without sending a frame
+   *                   are counted as dropped.
+   */
+  bool frame_due(uint32_t now, bool continuous);
+  /// Count a frame that was due but couldn't be sent, for example because the previous one is still being sent.
+  void frame_dropped() { this->dropped_frames_++; }
+  uint32_t get_dropped_frames() const { return this->dropped_frames_; }
+
+ protected:
+  uint32_t frame_interval_{0};
+  uint32_t last_frame_{0};
+  uint32_t dropped_frames_{0};
+  bool last_continuous_{false};
+};
+
+/** Runs the effect of an addressable light at a fixed update interval and measures how long rendering takes.
+ *
+ * Effects that support it render a frame in passes of at most max_leds_per_pass LEDs, one pass per loop
+ * iteration, so that very long strips don't block the loop (and Wi-Fi) for a whole frame. The LEDs aren't
+ * refreshed while a frame is only partially rendered.
+ */
+class EffectRenderScheduler {
+ public:
+  /// Set the interval between two effect frames in ms, 0 (the default) renders a frame on every loop iteration.
+  void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+  /// Set the maximum number of LEDs rendered per loop iteration, 0 (the default) renders the whole frame at once.
+  void set_max_leds_per_pass(uint32_t max_leds_per_pass) { this->max_leds_per_pass_ = max_leds_per_pass; }
+  /// Whether frames are rendered at a fixed interval instead of on every loop iteration.
+  bool is_paced() const { return this->update_interval_ != 0; }
+  /// Whether a frame was started but not all LEDs have been rendered yet.
+  bool is_frame_in_progress() const { return this->next_led_ != 0; }
+
+  /// Check if the effect should render now, either to continue the current frame or because the next one is due.
+  bool render_due(uint32_t now);
+  /// The range of LEDs (from up to, not including, to) to render in this pass of the current frame.
+  void next_pass(int32_t size, int32_t *from, int32_t *to) const;
+  /** Record a finished pass.
+   *
+   * @param now The current time in ms.
+   * @param render_time How long the pass took in µs.
+   * @param to The end of the rendered range, the frame is complete once it reaches size.
+   * @param size The number of LEDs of the light.
+   */
+  void pass_done(uint32_t now, uint32_t render_time, int32_t to, int32_t size);
+  /// Forget the current frame and the statistics, called when an effect is started or stopped.
+  void reset();
+
+  /// The number of completed frames per second, measured over the last second.
+  float get_fps() const { return this->fps_; }
+  /// The time in µs it took to render the last complete frame, summed over all passes.
+  uint32_t get_render_time() const { return this->render_time_; }
+
+ protected:
+  uint32_t update_interval_{0};
+  uint32_t max_leds_per_pass_{0};
+  uint32_t last_frame_{0};
+  int32_t next_led_{0};
+  uint32_t frame_render_time_{0};
+  uint32_t render_time_{0};
+  uint32_t fps_window_start_{0};
+  uint32_t fps_frames_{0};
+  float fps_{0.0f};
+};
+
+/** Sends the frames of several addressable lights together, for installations made of many strips.
+ *
+ * Members don't refresh their LEDs themselves, they only mark that a new frame is ready. Once per loop iteration, after
+ * the members had their turn, the group starts the transfers of all members back to back if any of them has a new
+ * frame, so all strips latch the same frame. The RMT and I2S methods of NeoPixelBus send in the background and the RMT
+ * driver of FastLED sends all of its strips at once when the last one is shown, so the strips are driven in parallel
+ * and a frame takes about as long as the longest strip instead of the sum of all of them.
+ */
+class AddressableOutputGroup : public Component {
+ public:
+  /// Add a light to the group, send starts the transfer of its LEDs.
+  void add_member(std::function<void()> &&send) { this->members_.push_back(std::move(send)); }
+  /// Mark that a member has a new frame, it's sent together with the frames of the other members.
+  void frame_ready() { this->frame_ready_ = true; }
+
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+ protected:
+  std::vector<std::function<void()>> members_;
+  bool frame_ready_{false};
+};
+
+#ifdef ARDUINO_ARCH_ESP32
+/** Sends frames to the LEDs from a separate task, so that the main loop doesn't wait for the transfer.
+ *
+ * Used for double buffering: effects render into a back buffer while the task sends the front buffer.
+ */
+class AddressableOutputTask {
+ public:
+  /// Start the task, send is called from it for every frame.
+  void start(std::function<void()> &&send);
+  /// Whether the previous frame is still being sent, the front buffer must not be changed until it's done.
+  bool is_busy() const { return this->busy_; }
+  /// Let the task send the front buffer.
+  void send_frame();
+
+ protected:
+  static void task_(void *arg);
+
+  std::function<void()> send_;
+  TaskHandle_t handle_{nullptr};
+  volatile bool busy_{false};
+};
+#endif
+
+}  // namespace light
+}  // namespace esphome
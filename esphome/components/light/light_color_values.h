@@ -11,6 +11,53 @@
 namespace esphome {
 namespace light {
 
+/** A gamma correction curve, precomputed as a table of Q16 values (0xFFFF = full brightness).
+ *
+ * Lights write their outputs on every loop iteration while a transition is running, the table
+ * replaces a powf() call per channel and write with a lookup and a linear interpolation between
+ * the two closest of 65 points. The interpolation error is well below the resolution of PWM outputs.
+ */
+class LightGammaTable {
+ public:
+  /// Recalculate the table for the given gamma correction factor, values of 0 or 1 disable the correction.
+  void calculate(float gamma) {
+    this->linear_ = gamma <= 0.0f || gamma == 1.0f;
+    if (this->linear_)
+      return;
+    for (uint8_t i = 0; i <= SEGMENTS; i++)
+      this->table_[i] = static_cast<uint16_t>(roundf(65535.0f * gamma_correct(i / float(SEGMENTS), gamma)));
+  }
+
+  /// Apply the gamma correction to a Q16 value.
+  uint16_t apply_q16(uint16_t value) const {
+    if (this->linear_ || value == 0xFFFF)
+      return value;
+    const uint32_t pos = uint32_t(value) * SEGMENTS;
+    const uint32_t index = pos >> 16;
+    const uint32_t fraction = pos & 0xFFFF;
+    const uint32_t low = this->table_[index];
+    const uint32_t high = this->table_[index + 1];
+    return low + (((high - low) * fraction) >> 16);
+  }
+
+  /// Apply the gamma correction to a value in range 0.0 to 1.0.
+  float apply(float value) const {
+    if (this->linear_)
+      return value;
+    if (value <= 0.0f)
+      return 0.0f;
+    if (value >= 1.0f)
+      return 1.0f;
+    return this->apply_q16(static_cast<uint16_t>(value * 65535.0f + 0.5f)) * (1.0f / 65535.0f);
+  }
+
+ protected:
+  static const uint8_t SEGMENTS = 64;
+
+  bool linear_{true};
+  uint16_t table_[SEGMENTS + 1];
+};
+
 /** This class represents the color state for a light object.
  *
  * All values in this class are represented using floats in the range from 0.0 (off) to 1.0 (on).
@@ -175,59 +222,56 @@ class LightColorValues {
 
   /// Convert these light color values to a brightness-only representation and write them to brightness.
   void as_brightness(float *brightness, float gamma = 0) const {
-    *brightness = gamma_correct(this->state_ * this->brightness_, gamma);
+    this->as_brightness_(brightness, GammaFunction{gamma});
   }
+  /// Same as above, applying the gamma correction from a precomputed table.
+  void as_brightness(float *brightness, const LightGammaTable &gamma) const { this->as_brightness_(brightness, gamma); }
 
   /// Convert these light color values to an RGB representation and write them to red, green, blue.
   void as_rgb(float *red, float *green, float *blue, float gamma = 0, bool color_interlock = false) const {
-    float brightness = this->state_ * this->brightness_;
-    if (color_interlock) {
-      brightness = brightness * (1.0f - this->white_);
-    }
-    *red = gamma_correct(brightness * this->red_, gamma);
-    *green = gamma_correct(brightness * this->green_, gamma);
-    *blue = gamma_correct(brightness * this->blue_, gamma);
+    this->as_rgb_(red, green, blue, GammaFunction{gamma}, color_interlock);
+  }
+  /// Same as above, applying the gamma correction from a precomputed table.
+  void as_rgb(float *red, float *green, float *blue, const LightGammaTable &gamma, bool color_interlock = false) const {
+    this->as_rgb_(red, green, blue, gamma, color_interlock);
   }
 
   /// Convert these light color values to an RGBW representation and write them to red, green, blue, white.
   void as_rgbw(float *red, float *green, float *blue, float *white, float gamma = 0,
                bool color_interlock = false) const {
-    this->as_rgb(red, green, blue, gamma, color_interlock);
-    *white = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+    this->as_rgbw_(red, green, blue, white, GammaFunction{gamma}, color_interlock);
+  }
+  /// Same as above, applying the gamma correction from a precomputed table.
+  void as_rgbw(float *red, float *green, float *blue, float *white, const LightGammaTable &gamma,
+               bool color_interlock = false) const {
+    this->as_rgbw_(red, green, blue, white, gamma, color_interlock);
   }
 
   /// Convert these light color values to an RGBWW representation with the given parameters.
   void as_rgbww(float color_temperature_cw, float color_temperature_ww, float *red, float *green, float *blue,
                 float *cold_white, float *warm_white, float gamma = 0, bool constant_brightness = false,
                 bool color_interlock = false) const {
-    this->as_rgb(red, green, blue, gamma, color_interlock);
-    const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
-    const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
-    const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
-    *cold_white = white_level * cw_fraction;
-    *warm_white = white_level * ww_fraction;
-    if (!constant_brightness) {
-      const float max_cw_ww = std::max(ww_fraction, cw_fraction);
-      *cold_white /= max_cw_ww;
-      *warm_white /= max_cw_ww;
-    }
+    this->as_rgbww_(color_temperature_cw, color_temperature_ww, red, green, blue, cold_white, warm_white,
+                    GammaFunction{gamma}, constant_brightness, color_interlock);
+  }
+  /// Same as above, applying the gamma correction from a precomputed table.
+  void as_rgbww(float color_temperature_cw, float color_temperature_ww, float *red, float *green, float *blue,
+                float *cold_white, float *warm_white, const LightGammaTable &gamma, bool constant_brightness = false,
+                bool color_interlock = false) const {
+    this->as_rgbww_(color_temperature_cw, color_temperature_ww, red, green, blue, cold_white, warm_white, gamma,
+                    constant_brightness, color_interlock);
   }
 
   /// Convert these light color values to an CWWW representation with the given parameters.
   void as_cwww(float color_temperature_cw, float color_temperature_ww, float *cold_white, float *warm_white,
                float gamma = 0, bool constant_brightness = false) const {
-    const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
-    const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
-    const float cw_fraction = 1.0f - ww_fraction;
-    const float white_level = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
-    *cold_white = white_level * cw_fraction;
-    *warm_white = white_level * ww_fraction;
-    if (!constant_brightness) {
-      const float max_cw_ww = std::max(ww_fraction, cw_fraction);
-      *cold_white /= max_cw_ww;
-      *warm_white /= max_cw_ww;
-    }
+    this->as_cwww_(color_temperature_cw, color_temperature_ww, cold_white, warm_white, GammaFunction{gamma},
+                   constant_brightness);
+  }
+  /// Same as above, applying the gamma correction from a precomputed table.
+  void as_cwww(float color_temperature_cw, float color_temperature_ww, float *cold_white, float *warm_white,
+               const LightGammaTable &gamma, bool constant_brightness = false) const {
+    this->as_cwww_(color_temperature_cw, color_temperature_ww, cold_white, warm_white, gamma, constant_brightness);
   }
 
   /// Compare this LightColorValues to rhs, return true if and only if all attributes match.
@@ -279,6 +323,53 @@ class LightColorValues {
   }
 
  protected:
+  /// Gamma correction computed with powf() on every call, for callers without a LightGammaTable.
+  struct GammaFunction {
+    float gamma;
+    float apply(float value) const { return gamma_correct(value, this->gamma); }
+  };
+
+  template<typename G> void as_brightness_(float *brightness, const G &gamma) const {
+    *brightness = gamma.apply(this->state_ * this->brightness_);
+  }
+  template<typename G>
+  void as_rgb_(float *red, float *green, float *blue, const G &gamma, bool color_interlock) const {
+    float brightness = this->state_ * this->brightness_;
+    if (color_interlock) {
+      brightness = brightness * (1.0f - this->white_);
+    }
+    *red = gamma.apply(brightness * this->red_);
+    *green = gamma.apply(brightness * this->green_);
+    *blue = gamma.apply(brightness * this->blue_);
+  }
+  template<typename G>
+  void as_rgbw_(float *red, float *green, float *blue, float *white, const G &gamma, bool color_interlock) const {
+    this->as_rgb_(red, green, blue, gamma, color_interlock);
+    *white = gamma.apply(this->state_ * this->brightness_ * this->white_);
+  }
+  template<typename G>
+  void as_rgbww_(float color_temperature_cw, float color_temperature_ww, float *red, float *green, float *blue,
+                 float *cold_white, float *warm_white, const G &gamma, bool constant_brightness,
+                 bool color_interlock) const {
+    this->as_rgb_(red, green, blue, gamma, color_interlock);
+    this->as_cwww_(color_temperature_cw, color_temperature_ww, cold_white, warm_white, gamma, constant_brightness);
+  }
+  template<typename G>
+  void as_cwww_(float color_temperature_cw, float color_temperature_ww, float *cold_white, float *warm_white,
+                const G &gamma, bool constant_brightness) const {
+    const float color_temp = clamp(this->color_temperature_, color_temperature_cw, color_temperature_ww);
+    const float ww_fraction = (color_temp - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
+    const float cw_fraction = 1.0f - ww_fraction;
+    const float white_level = gamma.apply(this->state_ * this->brightness_ * this->white_);
+    *cold_white = white_level * cw_fraction;
+    *warm_white = white_level * ww_fraction;
+    if (!constant_brightness) {
+      const float max_cw_ww = std::max(ww_fraction, cw_fraction);
+      *cold_white /= max_cw_ww;
+      *warm_white /= max_cw_ww;
+    }
+  }
+
   float state_;  ///< ON / OFF, float for transition
   float brightness_;
   float red_;
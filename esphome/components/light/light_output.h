@@ -18,6 +18,15 @@ class LightOutput {
   virtual void setup_state(LightState *state) {}
 
   virtual void write_state(LightState *state) = 0;
+
+  /// Whether all outputs of this light fade in hardware, so transitions can be handed to write_state_fade().
+  virtual bool supports_fade() { return false; }
+
+  /** Fade the outputs linearly from their current levels to the current values of the state within length ms.
+   *
+   * Only called if supports_fade() returns true.
+   */
+  virtual void write_state_fade(LightState *state, uint32_t length) { this->write_state(state); }
 };
 
 }  // namespace light
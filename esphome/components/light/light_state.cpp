@@ -2,14 +2,23 @@
 #include "light_output.h"
 #include "esphome/core/log.h"
 
+#ifdef USE_JSON
+#include "esphome/components/json/json_reader.h"
+#endif
+
 namespace esphome {
 namespace light {
 
 static const char *TAG = "light";
 
+/// Transitions are handed to outputs that fade in hardware as linear segments of at most this length. This bounds both
+/// the error from the smoothed transition and how long a running fade delays a new value.
+static const uint32_t LIGHT_FADE_SEGMENT_LENGTH = 100;
+
 void LightState::start_transition_(const LightColorValues &target, uint32_t length) {
   this->transformer_ = make_unique<LightTransitionTransformer>(millis(), length, this->current_values, target);
   this->remote_values = this->transformer_->get_remote_values();
+  this->fading_ = false;
 }
 
 void LightState::start_flash_(const LightColorValues &target, uint32_t length) {
@@ -20,12 +29,14 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length) {
     end_colors = this->transformer_->get_end_values();
   this->transformer_ = make_unique<LightFlashTransformer>(millis(), length, end_colors, target);
   this->remote_values = this->transformer_->get_remote_values();
+  this->fading_ = false;
 }
 
 LightState::LightState(const std::string &name, LightOutput *output) : Nameable(name), output_(output) {}
 
 void LightState::set_immediately_(const LightColorValues &target, bool set_remote_values) {
   this->transformer_ = nullptr;
+  this->fading_ = false;
   this->current_values = target;
   if (set_remote_values) {
     this->remote_values = target;
@@ -62,6 +73,7 @@ void LightState::start_effect_(uint32_t effect_index) {
 bool LightState::supports_effects() { return !this->effects_.empty(); }
 void LightState::set_transformer_(std::unique_ptr<LightTransformer> transformer) {
   this->transformer_ = std::move(transformer);
+  this->fading_ = false;
 }
 void LightState::stop_effect_() {
   auto *effect = this->get_active_effect_();
@@ -142,13 +154,28 @@ void LightState::loop() {
   }
 
   // Apply transformer (if any)
-  if (this->transformer_ != nullptr) {
+  const uint32_t now = millis();
+  if (this->fading_ && int32_t(now - this->fade_end_) < 0) {
+    // the output fades the current segment in hardware
+  } else if (this->transformer_ != nullptr) {
+    this->fading_ = false;
     if (this->transformer_->is_finished()) {
       this->remote_values = this->current_values = this->transformer_->get_end_values();
       this->target_state_reached_callback_.call();
       if (this->transformer_->publish_at_end())
         this->publish_state();
       this->transformer_ = nullptr;
+    } else if (effect == nullptr && this->transformer_->is_transition() && this->output_->supports_fade()) {
+      auto *transition = static_cast<LightTransitionTransformer *>(this->transformer_.get());
+      const uint32_t length = transition->next_segment(now, LIGHT_FADE_SEGMENT_LENGTH, &this->current_values);
+      this->remote_values = this->transformer_->get_remote_values();
+      this->output_->write_state_fade(this, length);
+      this->fading_ = true;
+      this->fade_end_ = now + length;
+      // wakes the loop for the next segment
+      this->set_timeout("fade", length, []() {});
+      this->next_write_ = false;
+      return;
     } else {
       this->current_values = this->transformer_->get_values();
       this->remote_values = this->transformer_->get_remote_values();
@@ -161,6 +188,11 @@ void LightState::loop() {
     this->next_write_ = false;
   }
 }
+bool LightState::is_loop_idle() {
+  if (this->next_write_ || this->get_active_effect_() != nullptr)
+    return false;
+  return this->transformer_ == nullptr || this->fading_;
+}
 LightTraits LightState::get_traits() { return this->output_->get_traits(); }
 const std::vector<LightEffect *> &LightState::get_effects() const { return this->effects_; }
 void LightState::add_effects(const std::vector<LightEffect *> effects) {
@@ -256,6 +288,72 @@ LightCall &LightCall::parse_json(JsonObject &root) {
 
   return *this;
 }
+bool LightCall::parse_json(const char *payload, size_t len) {
+  json::JsonReader reader(payload, len);
+  StringRef key;
+  float value;
+  char text[64];
+  if (!reader.begin_object())
+    return false;
+
+  while (reader.next_key(&key)) {
+    if (key == "state") {
+      if (!reader.read_string(text, sizeof(text)))
+        continue;
+      switch (parse_on_off(text)) {
+        case PARSE_ON:
+          this->set_state(true);
+          break;
+        case PARSE_OFF:
+          this->set_state(false);
+          break;
+        case PARSE_TOGGLE:
+          this->set_state(!this->parent_->remote_values.is_on());
+          break;
+        case PARSE_NONE:
+          break;
+      }
+    } else if (key == "brightness") {
+      if (reader.read_float(&value))
+        this->set_brightness(value / 255.0f);
+    } else if (key == "color") {
+      if (!reader.begin_object())
+        return false;
+      while (reader.next_key(&key)) {
+        if (key == "r") {
+          if (reader.read_float(&value))
+            this->set_red(value / 255.0f);
+        } else if (key == "g") {
+          if (reader.read_float(&value))
+            this->set_green(value / 255.0f);
+        } else if (key == "b") {
+          if (reader.read_float(&value))
+            this->set_blue(value / 255.0f);
+        } else {
+          reader.skip_value();
+        }
+      }
+    } else if (key == "white_value") {
+      if (reader.read_float(&value))
+        this->set_white(value / 255.0f);
+    } else if (key == "color_temp") {
+      if (reader.read_float(&value))
+        this->set_color_temperature(value);
+    } else if (key == "flash") {
+      if (reader.read_float(&value))
+        this->set_flash_length(uint32_t(value * 1000));
+    } else if (key == "transition") {
+      if (reader.read_float(&value))
+        this->set_transition_length(uint32_t(value * 1000));
+    } else if (key == "effect") {
+      if (reader.read_string(text, sizeof(text)))
+        this->set_effect(std::string(text));
+    } else {
+      reader.skip_value();
+    }
+  }
+  return reader.finish();
+}
 #endif
 
 void LightCall::perform() {
@@ -730,30 +828,33 @@ LightCall &LightCall::set_rgbw(float red, float green, float blue, float white)
 
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
 LightOutput *LightState::get_output() const { return this->output_; }
-void LightState::set_gamma_correct(float gamma_correct) { this->gamma_correct_ = gamma_correct; }
+void LightState::set_gamma_correct(float gamma_correct) {
+  this->gamma_correct_ = gamma_correct;
+  this->gamma_table_.calculate(gamma_correct);
+}
 void LightState::current_values_as_binary(bool *binary) { this->current_values.as_binary(binary); }
 void LightState::current_values_as_brightness(float *brightness) {
-  this->current_values.as_brightness(brightness, this->gamma_correct_);
+  this->current_values.as_brightness(brightness, this->gamma_table_);
 }
 void LightState::current_values_as_rgb(float *red, float *green, float *blue, bool color_interlock) {
   auto traits = this->get_traits();
-  this->current_values.as_rgb(red, green, blue, this->gamma_correct_, traits.get_supports_color_interlock());
+  this->current_values.as_rgb(red, green, blue, this->gamma_table_, traits.get_supports_color_interlock());
 }
 void LightState::current_values_as_rgbw(float *red, float *green, float *blue, float *white, bool color_interlock) {
   auto traits = this->get_traits();
-  this->current_values.as_rgbw(red, green, blue, white, this->gamma_correct_, traits.get_supports_color_interlock());
+  this->current_values.as_rgbw(red, green, blue, white, this->gamma_table_, traits.get_supports_color_interlock());
 }
 void LightState::current_values_as_rgbww(float *red, float *green, float *blue, float *cold_white, float *warm_white,
                                          bool constant_brightness, bool color_interlock) {
   auto traits = this->get_traits();
   this->current_values.as_rgbww(traits.get_min_mireds(), traits.get_max_mireds(), red, green, blue, cold_white,
-                                warm_white, this->gamma_correct_, constant_brightness,
+                                warm_white, this->gamma_table_, constant_brightness,
                                 traits.get_supports_color_interlock());
 }
 void LightState::current_values_as_cwww(float *cold_white, float *warm_white, bool constant_brightness) {
   auto traits = this->get_traits();
   this->current_values.as_cwww(traits.get_min_mireds(), traits.get_max_mireds(), cold_white, warm_white,
-                               this->gamma_correct_, constant_brightness);
+                               this->gamma_table_, constant_brightness);
 }
 void LightState::add_new_remote_values_callback(std::function<void()> &&send_callback) {
   this->remote_values_callback_.add(std::move(send_callback));
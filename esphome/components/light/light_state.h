@@ -132,6 +132,11 @@ class LightCall {
 #ifdef USE_JSON
   LightCall &parse_color_json(JsonObject &root);
   LightCall &parse_json(JsonObject &root);
+  /** Parse a JSON command like the one above straight from the payload, without building a document.
+   *
+   * @return Whether the payload was valid JSON, the call must not be performed otherwise.
+   */
+  bool parse_json(const char *payload, size_t len);
 #endif
   LightCall &from_light_color_values(const LightColorValues &values);
 
@@ -189,6 +194,7 @@ class LightState : public Nameable, public Component {
   void setup() override;
   void dump_config() override;
   void loop() override;
+  bool is_loop_idle() override;
   /// Shortly after HARDWARE.
   float get_setup_priority() const override;
 
@@ -334,8 +340,13 @@ class LightState : public Nameable, public Component {
   LightOutput *output_;  ///< Store the output to allow effects to have more access.
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
+  /// Whether the output is fading a segment of the transition in hardware, until fade_end_.
+  bool fading_{false};
+  uint32_t fade_end_{0};
   /// Gamma correction factor for the light.
   float gamma_correct_{};
+  /// Gamma correction curve precomputed from gamma_correct_, used when writing the outputs.
+  LightGammaTable gamma_table_;
   /// List of effects for this light.
   std::vector<LightEffect *> effects_;
 };
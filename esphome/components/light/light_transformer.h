@@ -68,6 +68,24 @@ class LightTransitionTransformer : public LightTransformer {
   bool publish_at_end() override { return false; }
   bool is_transition() override { return true; }
 
+  /** The next linear segment of the transition, for outputs that fade in hardware.
+   *
+   * The smoothed transition is approximated by segments of at most max_length ms, the output fades linearly from the
+   * values at now to the values at the end of the segment.
+   *
+   * @param now The start of the segment.
+   * @param max_length The maximum length of the segment in ms.
+   * @param values Set to the values at the end of the segment.
+   * @return The length of the segment in ms.
+   */
+  uint32_t next_segment(uint32_t now, uint32_t max_length, LightColorValues *values) {
+    const uint32_t elapsed = std::min(now - this->start_time_, this->length_);
+    const uint32_t length = std::min(max_length, this->length_ - elapsed);
+    float v = LightTransitionTransformer::smoothed_progress((elapsed + length) / float(this->length_));
+    *values = LightColorValues::lerp(this->get_start_values_(), this->get_target_values_(), v);
+    return length;
+  }
+
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
 };
 
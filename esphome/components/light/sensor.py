@@ -0,0 +1,35 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID, ICON_TIMER
+from .types import AddressableLightState, light_ns
+
+DEPENDENCIES = ['light']
+
+CONF_FPS = 'fps'
+CONF_LIGHT_ID = 'light_id'
+CONF_RENDER_TIME = 'render_time'
+UNIT_FRAMES_PER_SECOND = 'fps'
+UNIT_MICROSECOND = 'µs'
+
+AddressableLightRenderSensor = light_ns.class_('AddressableLightRenderSensor', cg.PollingComponent)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(AddressableLightRenderSensor),
+    cv.Required(CONF_LIGHT_ID): cv.use_id(AddressableLightState),
+    cv.Optional(CONF_FPS): sensor.sensor_schema(UNIT_FRAMES_PER_SECOND, ICON_TIMER, 1),
+    cv.Optional(CONF_RENDER_TIME): sensor.sensor_schema(UNIT_MICROSECOND, ICON_TIMER, 0),
+}).extend(cv.polling_component_schema('60s'))
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_LIGHT_ID])
+    var = cg.new_Pvariable(config[CONF_ID], parent)
+    yield cg.register_component(var, config)
+
+    if CONF_FPS in config:
+        sens = yield sensor.new_sensor(config[CONF_FPS])
+        cg.add(var.set_fps_sensor(sens))
+    if CONF_RENDER_TIME in config:
+        sens = yield sensor.new_sensor(config[CONF_RENDER_TIME])
+        cg.add(var.set_render_time_sensor(sens))
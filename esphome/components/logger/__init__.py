@@ -5,7 +5,8 @@ import esphome.config_validation as cv
 from esphome import automation
 from esphome.automation import LambdaAction
 from esphome.const import CONF_ARGS, CONF_BAUD_RATE, CONF_FORMAT, CONF_HARDWARE_UART, CONF_ID, \
-    CONF_LEVEL, CONF_LOGS, CONF_ON_MESSAGE, CONF_TAG, CONF_TRIGGER_ID, CONF_TX_BUFFER_SIZE
+    CONF_LEVEL, CONF_LOGS, CONF_ON_MESSAGE, CONF_TAG, CONF_TRIGGER_ID, CONF_TX_BUFFER_SIZE, \
+    CONF_ESPHOME, CONF_DUAL_CORE
 from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
 
 CODEOWNERS = ['@esphome/core']
@@ -75,10 +76,23 @@ LoggerMessageTrigger = logger_ns.class_('LoggerMessageTrigger',
                                                                     cg.const_char_ptr))
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = 'esp8266_store_log_strings_in_flash'
+CONF_ASYNC_BUFFER_SIZE = 'async_buffer_size'
+
+
+def validate_async_buffer_size(value):
+    size = value[CONF_ASYNC_BUFFER_SIZE]
+    if size != 0 and size < 2 * value[CONF_TX_BUFFER_SIZE] + 64:
+        raise cv.Invalid("The async buffer must be at least twice the size of the tx_buffer_size "
+                         "plus 64 bytes ({} bytes)".format(2 * value[CONF_TX_BUFFER_SIZE] + 64),
+                         [CONF_ASYNC_BUFFER_SIZE])
+    return value
+
+
 CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(Logger),
     cv.Optional(CONF_BAUD_RATE, default=115200): cv.positive_int,
     cv.Optional(CONF_TX_BUFFER_SIZE, default=512): cv.validate_bytes,
+    cv.Optional(CONF_ASYNC_BUFFER_SIZE, default=0): cv.validate_bytes,
     cv.Optional(CONF_HARDWARE_UART, default='UART0'): uart_selection,
     cv.Optional(CONF_LEVEL, default='DEBUG'): is_log_level,
     cv.Optional(CONF_LOGS, default={}): cv.Schema({
@@ -91,7 +105,7 @@ CONFIG_SCHEMA = cv.All(cv.Schema({
 
     cv.SplitDefault(CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True):
         cv.All(cv.only_on_esp8266, cv.boolean),
-}).extend(cv.COMPONENT_SCHEMA), validate_local_no_higher_than_global)
+}).extend(cv.COMPONENT_SCHEMA), validate_local_no_higher_than_global, validate_async_buffer_size)
 
 
 @coroutine_with_priority(90.0)
@@ -101,8 +115,18 @@ def to_code(config):
                      config[CONF_TX_BUFFER_SIZE],
                      HARDWARE_UART_TO_UART_SELECTION[config[CONF_HARDWARE_UART]])
     log = cg.Pvariable(config[CONF_ID], rhs)
+    async_buffer_size = config[CONF_ASYNC_BUFFER_SIZE]
+    if async_buffer_size == 0 and CORE.config[CONF_ESPHOME].get(CONF_DUAL_CORE, False):
+        # The log callbacks (API) run in the network task, the loop task has to queue its lines
+        async_buffer_size = 4 * config[CONF_TX_BUFFER_SIZE]
+    if async_buffer_size != 0:
+        cg.add_define('USE_LOGGER_ASYNC')
+        cg.add(log.set_async_buffer_size(async_buffer_size))
     cg.add(log.pre_setup())
 
+    if config[CONF_LOGS]:
+        # Without overrides all tags have the global level, known at compile time
+        cg.add_define('USE_LOGGER_TAG_LEVELS')
     for tag, level in config[CONF_LOGS].items():
         cg.add(log.set_log_level(tag, LOG_LEVELS[level]))
 
@@ -0,0 +1,156 @@
+#include "log_buffer.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include "esphome/core/helpers.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+static const uint32_t ENTRY_ALIGN = alignof(LogRingBuffer::Entry);
+
+LogRingBuffer::LogRingBuffer(size_t size) {
+  // positions are free running counters, so the size has to be a power of two for them to wrap correctly
+  uint32_t rounded = 64;
+  while (rounded < size)
+    rounded <<= 1;
+  this->size_ = rounded;
+  this->mask_ = rounded - 1;
+  // free space must read as ENTRY_FREE, which alloc_large() guarantees by value-initializing the bytes
+  this->buffer_ = alloc_large<uint8_t>(rounded, BUFFER_LOCATION_PREFER_EXTERNAL);
+}
+
+static uint32_t entry_size(size_t length) {
+  return (sizeof(LogRingBuffer::Entry) + length + 1 + ENTRY_ALIGN - 1) & ~(ENTRY_ALIGN - 1);
+}
+
+LogRingBuffer::Entry *LogRingBuffer::reserve(size_t length) {
+  const uint32_t needed = entry_size(length);
+  if (needed > this->size_ / 2 || needed > UINT16_MAX)
+    return nullptr;
+
+  uint32_t head;
+  uint32_t skip;
+#ifdef ARDUINO_ARCH_ESP8266
+  {
+    // No compare-and-swap on the ESP8266. The only other producers there are interrupts, so a short
+    // interrupt lock is enough.
+    InterruptLock lock;
+    head = this->head_.load(std::memory_order_relaxed);
+    const uint32_t offset = head & this->mask_;
+    skip = this->size_ - offset < needed ? this->size_ - offset : 0;
+    if (head + skip + needed - this->tail_.load(std::memory_order_acquire) > this->size_)
+      return nullptr;
+    this->head_.store(head + skip + needed, std::memory_order_relaxed);
+  }
+#else
+  head = this->head_.load(std::memory_order_relaxed);
+  do {
+    const uint32_t offset = head & this->mask_;
+    skip = this->size_ - offset < needed ? this->size_ - offset : 0;
+    if (head + skip + needed - this->tail_.load(std::memory_order_acquire) > this->size_)
+      return nullptr;
+  } while (!this->head_.compare_exchange_weak(head, head + skip + needed, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+#endif
+
+  if (skip >= sizeof(Entry)) {
+    // The consumer skips remainders too small for a header on its own, larger ones need a padding entry
+    Entry *padding = this->at_(head);
+    padding->size = skip;
+    padding->length = 0;
+    padding->tag = nullptr;
+    __atomic_store_n(&padding->state, ENTRY_PADDING, __ATOMIC_RELEASE);
+  }
+
+  Entry *entry = this->at_(head + skip);
+  entry->size = needed;
+  return entry;
+}
+void LogRingBuffer::commit(Entry *entry) {
+  const uint32_t needed = entry_size(entry->length);
+  if (needed < entry->size) {
+    // Only the last reserved entry can shrink, it ends at head_. The bytes given back were never written and still
+    // read as ENTRY_FREE.
+    const uint32_t offset = reinterpret_cast<uint8_t *>(entry) - this->buffer_;
+    const uint32_t unused = entry->size - needed;
+#ifdef ARDUINO_ARCH_ESP8266
+    InterruptLock lock;
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (((head - entry->size) & this->mask_) == offset) {
+      this->head_.store(head - unused, std::memory_order_relaxed);
+      entry->size = needed;
+    }
+#else
+    uint32_t head = this->head_.load(std::memory_order_relaxed);
+    if (((head - entry->size) & this->mask_) == offset &&
+        this->head_.compare_exchange_strong(head, head - unused, std::memory_order_acq_rel, std::memory_order_relaxed))
+      entry->size = needed;
+#endif
+  }
+  __atomic_store_n(&entry->state, ENTRY_COMMITTED, __ATOMIC_RELEASE);
+}
+size_t LogRingBuffer::max_length() const {
+  const uint32_t limit = std::min<uint32_t>(this->size_ / 2, UINT16_MAX) & ~(ENTRY_ALIGN - 1);
+  return limit - sizeof(Entry) - 1;
+}
+
+LogRingBuffer::Entry *LogRingBuffer::peek() {
+  while (true) {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return nullptr;
+
+    const uint32_t offset = tail & this->mask_;
+    if (this->size_ - offset < sizeof(Entry)) {
+      this->tail_.store(tail + this->size_ - offset, std::memory_order_release);
+      continue;
+    }
+
+    Entry *entry = this->at_(tail);
+    switch (__atomic_load_n(&entry->state, __ATOMIC_ACQUIRE)) {
+      case ENTRY_COMMITTED:
+        return entry;
+      case ENTRY_PADDING:
+        this->pop();
+        continue;
+      default:
+        // reserved, but the producer is still writing it
+        return nullptr;
+    }
+  }
+}
+void LogRingBuffer::pop() {
+  const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+  Entry *entry = this->at_(tail);
+  const uint32_t size = entry->size;
+  // clear the whole entry so that no stale data is mistaken for a header later on
+  memset(entry, 0, size);
+  this->tail_.store(tail + size, std::memory_order_release);
+}
+
+void LogRingBuffer::add_dropped() {
+#ifdef ARDUINO_ARCH_ESP8266
+  InterruptLock lock;
+  this->dropped_.store(this->dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#else
+  this->dropped_.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+uint32_t LogRingBuffer::take_dropped() {
+#ifdef ARDUINO_ARCH_ESP8266
+  InterruptLock lock;
+  uint32_t dropped = this->dropped_.load(std::memory_order_relaxed);
+  this->dropped_.store(0, std::memory_order_relaxed);
+  return dropped;
+#else
+  return this->dropped_.exchange(0, std::memory_order_relaxed);
+#endif
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif
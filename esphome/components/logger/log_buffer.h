@@ -0,0 +1,78 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_ASYNC
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace logger {
+
+/** Ring buffer holding formatted log lines until the logger loop delivers them.
+ *
+ * Any number of tasks may reserve() and commit() entries concurrently without taking a lock, while
+ * the main loop is the only consumer (peek() and pop()). Entries are stored contiguously; when an
+ * entry does not fit at the end of the buffer the remaining bytes are skipped.
+ */
+class LogRingBuffer {
+ public:
+  struct Entry {
+    /// Total size of the entry in the buffer, including this header.
+    uint16_t size;
+    /// Length of the text, excluding the null terminator.
+    uint16_t length;
+    uint8_t level;
+    uint8_t state;
+    const char *tag;
+
+    char *text() { return reinterpret_cast<char *>(this) + sizeof(Entry); }
+  };
+
+  explicit LogRingBuffer(size_t size);
+
+  /// Reserve an entry for a line of up to length characters (plus null terminator), nullptr if it doesn't fit.
+  Entry *reserve(size_t length);
+  /** Make an entry returned by reserve() visible to the consumer.
+   *
+   * The space past entry->length is given back to the buffer if no other entry has been reserved since.
+   */
+  void commit(Entry *entry);
+  /// The longest line reserve() accepts.
+  size_t max_length() const;
+
+  /// The oldest committed entry, or nullptr if there is none (yet).
+  Entry *peek();
+  /// Release the entry returned by peek().
+  void pop();
+
+  bool empty() const { return this->head_.load(std::memory_order_acquire) == this->tail_; }
+
+  void add_dropped();
+  /// Number of lines that didn't fit since the last call.
+  uint32_t take_dropped();
+
+ protected:
+  enum EntryState : uint8_t {
+    ENTRY_FREE = 0,
+    ENTRY_COMMITTED,
+    ENTRY_PADDING,
+  };
+
+  Entry *at_(uint32_t position) { return reinterpret_cast<Entry *>(this->buffer_ + (position & this->mask_)); }
+
+  uint8_t *buffer_;
+  uint32_t size_;
+  uint32_t mask_;
+  /// Free running byte counters, the producers advance head_ and the consumer advances tail_.
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif
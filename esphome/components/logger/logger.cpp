@@ -4,12 +4,22 @@
 #include <esp_log.h>
 #endif
 #include <HardwareSerial.h>
+#include <algorithm>
+#include <memory>
+#ifdef USE_LOGGER_ASYNC
+#include "esphome/core/application.h"
+#endif
 
 namespace esphome {
 namespace logger {
 
 static const char *TAG = "logger";
 
+#ifdef USE_STORE_LOG_STR_IN_FLASH
+/// Format strings from flash up to this length are copied to the stack, longer ones to the heap.
+static const size_t FLASH_FORMAT_STACK_SIZE = 128;
+#endif
+
 static const char *LOG_LEVEL_COLORS[] = {
     "",                                            // NONE
     ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED),       // ERROR
@@ -46,6 +56,16 @@ void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *
   if (level > this->level_for(tag))
     return;
 
+  if (!this->raw_log_callbacks_.empty())
+    this->call_raw_log_callbacks_(level, tag, line, format, args);
+
+#ifdef USE_LOGGER_ASYNC
+  if (this->async_buffer_ != nullptr) {
+    this->log_async_(level, tag, line, format, args);
+    return;
+  }
+#endif
+
   this->reset_buffer_();
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
@@ -58,40 +78,22 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
   if (level > this->level_for(tag))
     return;
 
-  this->reset_buffer_();
-  // copy format string
-  const char *format_pgm_p = (PGM_P) format;
-  size_t len = 0;
-  char ch = '.';
-  while (!this->is_buffer_full_() && ch != '\0') {
-    this->tx_buffer_[this->tx_buffer_at_++] = ch = pgm_read_byte(format_pgm_p++);
+  // copy the format out of flash, not into tx_buffer_: the callbacks may log themselves and overwrite it
+  PGM_P format_pgm_p = reinterpret_cast<PGM_P>(format);
+  const size_t len = strlen_P(format_pgm_p);
+  char stack_format[FLASH_FORMAT_STACK_SIZE];
+  std::unique_ptr<char[]> heap_format;
+  char *format_copy = stack_format;
+  if (len >= sizeof(stack_format)) {
+    heap_format.reset(new char[len + 1]);
+    format_copy = heap_format.get();
   }
-  // Buffer full form copying format
-  if (this->is_buffer_full_())
-    return;
+  memcpy_P(format_copy, format_pgm_p, len + 1);
 
-  // length of format string, includes null terminator
-  uint32_t offset = this->tx_buffer_at_;
-
-  // now apply vsnprintf
-  this->write_header_(level, tag, line);
-  this->vprintf_to_buffer_(this->tx_buffer_, args);
-  this->write_footer_();
-  this->log_message_(level, tag, offset);
+  this->log_vprintf_(level, tag, line, format_copy, args);
 }
 #endif
 
-int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
-  for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
-      return it.level;
-    }
-  }
-  return ESPHOME_LOG_LEVEL;
-}
 void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // remove trailing newline
   if (this->tx_buffer_[this->tx_buffer_at_ - 1] == '\n') {
@@ -100,7 +102,22 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // make sure null terminator is present
   this->set_null_terminator_();
 
-  const char *msg = this->tx_buffer_ + offset;
+  this->deliver_message_(level, tag, this->tx_buffer_ + offset);
+}
+void Logger::call_raw_log_callbacks_(int level, const char *tag, int line, const char *format, va_list args) {
+#ifdef USE_LOGGER_ASYNC
+  // the consumers are not thread-safe
+  if (this->async_buffer_ != nullptr && !this->is_loop_task_())
+    return;
+#endif
+  for (auto &callback : this->raw_log_callbacks_) {
+    va_list copy;
+    va_copy(copy, args);
+    callback(level, tag, line, format, copy);
+    va_end(copy);
+  }
+}
+void HOT Logger::deliver_message_(int level, const char *tag, const char *msg) {
   if (this->baud_rate_ > 0)
     this->hw_serial_->println(msg);
 #ifdef ARDUINO_ARCH_ESP32
@@ -116,6 +133,102 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
 #endif
 }
 
+#ifdef USE_LOGGER_ASYNC
+void HOT Logger::log_async_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  if (level < 0)
+    level = 0;
+  if (level > 7)
+    level = 7;
+  const char *color = LOG_LEVEL_COLORS[level];
+  const char *letter = LOG_LEVEL_LETTERS[level];
+  const size_t footer_len = strlen(ESPHOME_LOG_RESET_COLOR);
+
+  // Reserve room for the longest line and format it in place, commit() gives back what is left over
+  size_t capacity = std::min<size_t>(this->tx_buffer_size_, this->async_buffer_->max_length());
+  auto *entry = this->async_buffer_->reserve(capacity);
+  if (entry == nullptr && !this->draining_ && this->is_loop_task_()) {
+    // Full, most likely because a lot is logged before the first loop(). Make room synchronously.
+    this->drain_async_(false);
+    entry = this->async_buffer_->reserve(capacity);
+  }
+  if (entry == nullptr) {
+    // No room for the longest line, measure this one to see if it fits. Only this case formats twice.
+    int header_len = snprintf(nullptr, 0, "%s[%s][%s:%03u]: ", color, letter, tag, line);
+    va_list measure;
+    va_copy(measure, args);
+    int body_len = vsnprintf(nullptr, 0, format, measure);
+    va_end(measure);
+    if (header_len >= 0 && body_len >= 0) {
+      capacity = std::min<size_t>(header_len + body_len + footer_len, capacity);
+      entry = this->async_buffer_->reserve(capacity);
+    }
+  }
+  if (entry == nullptr) {
+    this->async_buffer_->add_dropped();
+    return;
+  }
+
+  char *text = entry->text();
+  size_t at = std::min<size_t>(snprintf(text, capacity + 1, "%s[%s][%s:%03u]: ", color, letter, tag, line), capacity);
+  if (at < capacity) {
+    int ret = vsnprintf(text + at, capacity + 1 - at, format, args);
+    if (ret > 0)
+      at = std::min<size_t>(at + ret, capacity);
+  }
+  // remove trailing newline
+  if (at > 0 && text[at - 1] == '\n')
+    at--;
+  const size_t footer = std::min(footer_len, capacity - at);
+  memcpy(text + at, ESPHOME_LOG_RESET_COLOR, footer);
+  at += footer;
+  text[at] = '\0';
+
+  entry->length = at;
+  entry->level = level;
+  entry->tag = tag;
+  this->async_buffer_->commit(entry);
+  App.wake_loop();
+}
+void Logger::drain_async_(bool limit_uart) {
+  LogRingBuffer::Entry *entry;
+  bool delivered = false;
+  // log callbacks may log themselves, which must not drain the entry that is being delivered again
+  this->draining_ = true;
+  while ((entry = this->async_buffer_->peek()) != nullptr) {
+    // Always make progress, but don't block on a full UART once something has been written
+    if (limit_uart && delivered && this->baud_rate_ > 0 &&
+        this->hw_serial_->availableForWrite() < int(entry->length) + 2)
+      break;
+    this->deliver_message_(entry->level, entry->tag, entry->text());
+    this->async_buffer_->pop();
+    delivered = true;
+  }
+  this->draining_ = false;
+}
+bool Logger::is_loop_task_() const {
+#ifdef ARDUINO_ARCH_ESP32
+  return xTaskGetCurrentTaskHandle() == this->loop_task_;
+#else
+  // everything but interrupts runs on the same stack on the ESP8266
+  return true;
+#endif
+}
+void Logger::set_async_buffer_size(size_t size) { this->async_buffer_ = new LogRingBuffer(size); }
+void Logger::loop() {
+  if (this->async_buffer_ == nullptr)
+    return;
+#ifdef USE_DUAL_CORE
+  // from now on the task that delivers the lines also logs synchronously, the others queue their lines
+  this->loop_task_ = xTaskGetCurrentTaskHandle();
+#endif
+  uint32_t dropped = this->async_buffer_->take_dropped();
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %u log messages because the log buffer was full", dropped);
+  this->drain_async_(true);
+}
+bool Logger::is_loop_idle() { return this->async_buffer_ == nullptr || this->async_buffer_->empty(); }
+#endif
+
 Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size, UARTSelection uart)
     : baud_rate_(baud_rate), tx_buffer_size_(tx_buffer_size), uart_(uart) {
   // add 1 to buffer size for null terminator
@@ -156,6 +269,9 @@ void Logger::pre_setup() {
 #endif
 
   global_logger = this;
+#if defined(USE_LOGGER_ASYNC) && defined(ARDUINO_ARCH_ESP32)
+  this->loop_task_ = xTaskGetCurrentTaskHandle();
+#endif
 #ifdef ARDUINO_ARCH_ESP32
   esp_log_set_vprintf(esp_idf_log_vprintf_);
   if (ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE) {
@@ -166,13 +282,16 @@ void Logger::pre_setup() {
   ESP_LOGI(TAG, "Log initialized");
 }
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
-void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
-}
+#ifdef USE_LOGGER_TAG_LEVELS
+void Logger::set_log_level(const std::string &tag, int log_level) { this->tag_levels_.set(tag, log_level); }
+#endif
 UARTSelection Logger::get_uart() const { return this->uart_; }
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
   this->log_callback_.add(std::move(callback));
 }
+void Logger::add_raw_log_callback(std::function<void(int, const char *, int, const char *, va_list)> &&callback) {
+  this->raw_log_callbacks_.push_back(std::move(callback));
+}
 float Logger::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
 const char *LOG_LEVELS[] = {"NONE", "ERROR", "WARN", "INFO", "CONFIG", "DEBUG", "VERBOSE", "VERY_VERBOSE"};
 #ifdef ARDUINO_ARCH_ESP32
@@ -186,9 +305,11 @@ void Logger::dump_config() {
   ESP_LOGCONFIG(TAG, "  Level: %s", LOG_LEVELS[ESPHOME_LOG_LEVEL]);
   ESP_LOGCONFIG(TAG, "  Log Baud Rate: %u", this->baud_rate_);
   ESP_LOGCONFIG(TAG, "  Hardware UART: %s", UART_SELECTIONS[this->uart_]);
-  for (auto &it : this->log_levels_) {
+#ifdef USE_LOGGER_TAG_LEVELS
+  for (auto &it : this->tag_levels_.get_overrides()) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
+#endif
 }
 void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
 
@@ -5,6 +5,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/defines.h"
+#include "log_buffer.h"
+#include "tag_levels.h"
 
 namespace esphome {
 
@@ -37,8 +39,25 @@ class Logger : public Component {
   /// Get the UART used by the logger.
   UARTSelection get_uart() const;
 
+#ifdef USE_LOGGER_TAG_LEVELS
   /// Set the log level of the specified tag.
   void set_log_level(const std::string &tag, int log_level);
+#endif
+
+#ifdef USE_LOGGER_ASYNC
+  /** Queue log lines in a ring buffer of the given size and deliver them from loop().
+   *
+   * Must be called before pre_setup(). Logging then no longer writes to the UART or the log callbacks
+   * in the context of the caller, which also makes it safe to log from other tasks.
+   */
+  void set_async_buffer_size(size_t size);
+  void loop() override;
+  bool is_loop_idle() override;
+#ifdef USE_DUAL_CORE
+  /// The queued lines are delivered in the network task, next to the API that consumes them.
+  ComponentAffinity get_affinity() const override { return COMPONENT_AFFINITY_NETWORK; }
+#endif
+#endif
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -46,11 +65,22 @@ class Logger : public Component {
   void pre_setup();
   void dump_config() override;
 
-  int level_for(const char *tag);
+#ifdef USE_LOGGER_TAG_LEVELS
+  int level_for(const char *tag) { return this->tag_levels_.get(tag, ESPHOME_LOG_LEVEL); }
+#else
+  int level_for(const char *tag) { return ESPHOME_LOG_LEVEL; }
+#endif
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
 
+  /** Add a callback that receives every log message before it is formatted: level, tag, line, format, args.
+   *
+   * args may only be consumed once by each callback. With an async buffer only messages logged from the main loop
+   * are passed on.
+   */
+  void add_raw_log_callback(std::function<void(int, const char *, int, const char *, va_list)> &&callback);
+
   float get_setup_priority() const override;
 
   void log_vprintf_(int level, const char *tag, int line, const char *format, va_list args);  // NOLINT
@@ -62,6 +92,14 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  void deliver_message_(int level, const char *tag, const char *msg);
+  void call_raw_log_callbacks_(int level, const char *tag, int line, const char *format, va_list args);
+#ifdef USE_LOGGER_ASYNC
+  void log_async_(int level, const char *tag, int line, const char *format, va_list args);
+  /// Deliver queued lines, if limit_uart is set stop when the UART TX buffer can't take the next one.
+  void drain_async_(bool limit_uart);
+  bool is_loop_task_() const;
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -107,12 +145,18 @@ class Logger : public Component {
   int tx_buffer_size_{0};
   UARTSelection uart_{UART_SELECTION_UART0};
   HardwareSerial *hw_serial_{nullptr};
-  struct LogLevelOverride {
-    std::string tag;
-    int level;
-  };
-  std::vector<LogLevelOverride> log_levels_;
+#ifdef USE_LOGGER_TAG_LEVELS
+  TagLevels tag_levels_;
+#endif
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
+  std::vector<std::function<void(int, const char *, int, const char *, va_list)>> raw_log_callbacks_;
+#ifdef USE_LOGGER_ASYNC
+  LogRingBuffer *async_buffer_{nullptr};
+  bool draining_{false};
+#ifdef ARDUINO_ARCH_ESP32
+  TaskHandle_t loop_task_{nullptr};
+#endif
+#endif
 };
 
 extern Logger *global_logger;
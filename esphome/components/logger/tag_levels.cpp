@@ -0,0 +1,61 @@
+#include "tag_levels.h"
+
+#ifdef USE_LOGGER_TAG_LEVELS
+
+#include "esphome/core/helpers.h"
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+/// Marks a slot that is being written, its address is never a tag.
+static const char CLAIMED_MARKER = 0;
+static const char *const CLAIMED = &CLAIMED_MARKER;
+
+void TagLevels::set(const std::string &tag, int level) {
+  for (auto &it : this->overrides_) {
+    if (it.tag == tag) {
+      it.level = level;
+      return;
+    }
+  }
+  this->overrides_.push_back(Override{tag, level});
+}
+
+int TagLevels::find_(const char *tag, int default_level) const {
+  for (auto &it : this->overrides_) {
+    if (strcmp(it.tag.c_str(), tag) == 0)
+      return it.level;
+  }
+  return default_level;
+}
+
+int HOT TagLevels::get(const char *tag, int default_level) {
+  // tags are byte aligned, mix in the higher bits too
+  const auto address = reinterpret_cast<uintptr_t>(tag);
+  size_t index = (address ^ (address >> 6)) & (CACHE_SIZE - 1);
+  for (size_t i = 0; i < MAX_PROBES; i++, index = (index + 1) & (CACHE_SIZE - 1)) {
+    const char *cached = this->cache_tags_[index].load(std::memory_order_acquire);
+    if (cached == tag)
+      return this->cache_levels_[index];
+    if (cached != nullptr)
+      continue;
+
+    const int level = this->find_(tag, default_level);
+    const char *expected = nullptr;
+    if (this->cache_tags_[index].compare_exchange_strong(expected, CLAIMED, std::memory_order_acquire,
+                                                         std::memory_order_relaxed)) {
+      this->cache_levels_[index] = level;
+      this->cache_tags_[index].store(tag, std::memory_order_release);
+    }
+    return level;
+  }
+  // the neighborhood of the tag is full
+  return this->find_(tag, default_level);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif
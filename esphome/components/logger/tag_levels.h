@@ -0,0 +1,51 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_TAG_LEVELS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace logger {
+
+/** The log levels of the tags that have an entry in the logs option.
+ *
+ * Every log call looks up the level of its tag. Instead of comparing the tag to each entry on each call, the result is
+ * cached by the address of the tag: tags are static strings, so later calls with the same tag only compare a pointer.
+ * A cache slot is written once and never changes after that, so any task may log without taking a lock.
+ */
+class TagLevels {
+ public:
+  struct Override {
+    std::string tag;
+    int level;
+  };
+
+  /// Set the level of a tag, must be called before the first get().
+  void set(const std::string &tag, int level);
+  /// The level of the tag, default_level if it has none.
+  int get(const char *tag, int default_level);
+  const std::vector<Override> &get_overrides() const { return this->overrides_; }
+
+ protected:
+  static const size_t CACHE_SIZE = 64;
+  /// How many slots after the home slot of a tag are tried before giving up on caching it.
+  static const size_t MAX_PROBES = 8;
+
+  int find_(const char *tag, int default_level) const;
+
+  std::vector<Override> overrides_;
+  /// A slot is claimed by replacing nullptr with CLAIMED, then level is written, then the tag is published.
+  std::atomic<const char *> cache_tags_[CACHE_SIZE]{};
+  int8_t cache_levels_[CACHE_SIZE]{};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif
@@ -118,6 +118,7 @@ void MAX7219Component::setup() {
   ESP_LOGCONFIG(TAG, "Setting up MAX7219...");
   this->spi_setup();
   this->buffer_ = new uint8_t[this->num_chips_ * 8];
+  this->sent_ = new uint8_t[this->num_chips_ * 8];
   for (uint8_t i = 0; i < this->num_chips_ * 8; i++)
     this->buffer_[i] = 0;
 
@@ -141,14 +142,30 @@ void MAX7219Component::dump_config() {
 
 void MAX7219Component::display() {
   for (uint8_t i = 0; i < 8; i++) {
+    // only shift out the digits that changed, the other chips in the chain get a no-op
+    bool changed = this->resend_;
+    for (uint8_t j = 0; j < this->num_chips_ && !changed; j++)
+      changed = this->sent_[j * 8 + i] != this->digit_(j, i);
+    if (!changed)
+      continue;
     this->enable();
-    for (uint8_t j = 0; j < this->num_chips_; j++)
-      if (reverse_)
-        this->send_byte_(8 - i, buffer_[(num_chips_ - j - 1) * 8 + i]);
-      else
-        this->send_byte_(8 - i, buffer_[j * 8 + i]);
+    for (uint8_t j = 0; j < this->num_chips_; j++) {
+      const uint8_t data = this->digit_(j, i);
+      if (this->resend_ || this->sent_[j * 8 + i] != data) {
+        this->send_byte_(8 - i, data);
+        this->sent_[j * 8 + i] = data;
+      } else {
+        this->send_byte_(MAX7219_REGISTER_NOOP, 0);
+      }
+    }
     this->disable();
   }
+  this->resend_ = false;
+}
+uint8_t MAX7219Component::digit_(uint8_t chip, uint8_t digit) {
+  if (this->reverse_)
+    return this->buffer_[(this->num_chips_ - chip - 1) * 8 + digit];
+  return this->buffer_[chip * 8 + digit];
 }
 void MAX7219Component::send_byte_(uint8_t a_register, uint8_t data) {
   this->write_byte(a_register);
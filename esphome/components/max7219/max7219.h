@@ -57,10 +57,16 @@ class MAX7219Component : public PollingComponent,
  protected:
   void send_byte_(uint8_t a_register, uint8_t data);
   void send_to_all_(uint8_t a_register, uint8_t data);
+  /// The buffer value of the digit register of the chip at the given position in the chain.
+  uint8_t digit_(uint8_t chip, uint8_t digit);
 
   uint8_t intensity_{15};  /// Intensity of the display from 0 to 15 (most)
   uint8_t num_chips_{1};
   uint8_t *buffer_;
+  /// The digit registers as last written to the chips, by position in the chain.
+  uint8_t *sent_;
+  /// Write all digits on the next display(), not only the changed ones.
+  bool resend_{true};
   bool reverse_{false};
   optional<max7219_writer_t> writer_{};
 };
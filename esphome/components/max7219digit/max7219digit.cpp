@@ -28,6 +28,8 @@ void MAX7219Component::setup() {
   this->max_displaybuffer_.reserve(500);  // Create base space to write buffer
   // Initialize buffer with 0 for display so all non written pixels are blank
   this->max_displaybuffer_.resize(this->num_chips_ * 8, 0);
+  this->frame_.resize(this->num_chips_ * 8, 0);
+  this->sent_.resize(this->num_chips_ * 8, 0);
   // let's assume the user has all 8 digits connected, only important in daisy chained setups anyway
   this->send_to_all_(MAX7219_REGISTER_SCAN_LIMIT, 7);
   // let's use our own ASCII -> led pattern encoding
@@ -114,8 +116,33 @@ void MAX7219Component::display() {
         pixels[j] = this->max_displaybuffer_[i * 8 + j];
       }
     }
-    this->send64pixels(i, pixels);
+    for (uint8_t col = 0; col < 8; col++)
+      this->frame_[i * 8 + col] = this->column_byte_(pixels, col);
   }
+  this->write_frame_();
+}
+
+void MAX7219Component::write_frame_() {
+  for (uint8_t col = 0; col < 8; col++) {
+    // only shift out the columns that changed, the other chips in the chain get a no-op
+    bool changed = this->resend_;
+    for (uint8_t chip = 0; chip < this->num_chips_ && !changed; chip++)
+      changed = this->sent_[chip * 8 + col] != this->frame_[chip * 8 + col];
+    if (!changed)
+      continue;
+    this->enable();
+    for (uint8_t chip = 0; chip < this->num_chips_; chip++) {
+      const uint8_t b = this->frame_[chip * 8 + col];
+      if (this->resend_ || this->sent_[chip * 8 + col] != b) {
+        this->send_byte_(col + 1, b);
+        this->sent_[chip * 8 + col] = b;
+      } else {
+        this->send_byte_(MAX7219_REGISTER_NOOP, MAX7219_REGISTER_NOOP);
+      }
+    }
+    this->disable();
+  }
+  this->resend_ = false;
 }
 
 int MAX7219Component::get_height_internal() {
@@ -218,37 +245,29 @@ void MAX7219Component::send_char(uint8_t chip, uint8_t data) {
 // send one character (data) to position (chip)
 
 void MAX7219Component::send64pixels(uint8_t chip, const uint8_t pixels[8]) {
-  for (uint8_t col = 0; col < 8; col++) {  // RUN THIS LOOP 8 times until column is 7
-    this->enable();                        // start sending by enabling SPI
-    for (uint8_t i = 0; i < chip; i++)     // send extra NOPs to push the pixels out to extra displays
-      this->send_byte_(MAX7219_REGISTER_NOOP,
-                       MAX7219_REGISTER_NOOP);  // run this loop unit the matching chip is reached
-    uint8_t b = 0;                              // rotate pixels 90 degrees -- set byte to 0
-    if (this->orientation_ == 0) {
-      for (uint8_t i = 0; i < 8; i++) {
-        // run this loop 8 times for all the pixels[8] received
-        b |= ((pixels[i] >> col) & 1) << (7 - i);  // change the column bits into row bits
-      }
-    } else if (this->orientation_ == 1) {
-      b = pixels[col];
-    } else if (this->orientation_ == 2) {
-      for (uint8_t i = 0; i < 8; i++) {
-        b |= ((pixels[i] >> (7 - col)) & 1) << i;
-      }
-    } else {
-      b = pixels[7 - col];
+  for (uint8_t col = 0; col < 8; col++)
+    this->frame_[chip * 8 + col] = this->column_byte_(pixels, col);
+  this->write_frame_();
+}  // end of send64pixels
+
+uint8_t MAX7219Component::column_byte_(const uint8_t pixels[8], uint8_t col) {
+  uint8_t b = 0;  // rotate pixels 90 degrees -- set byte to 0
+  if (this->orientation_ == 0) {
+    for (uint8_t i = 0; i < 8; i++) {
+      // run this loop 8 times for all the pixels[8] received
+      b |= ((pixels[i] >> col) & 1) << (7 - i);  // change the column bits into row bits
     }
-    // send this byte to dispay at selected chip
-    if (this->invert_) {
-      this->send_byte_(col + 1, ~b);
-    } else {
-      this->send_byte_(col + 1, b);
+  } else if (this->orientation_ == 1) {
+    b = pixels[col];
+  } else if (this->orientation_ == 2) {
+    for (uint8_t i = 0; i < 8; i++) {
+      b |= ((pixels[i] >> (7 - col)) & 1) << i;
     }
-    for (int i = 0; i < this->num_chips_ - chip - 1; i++)  // end with enough NOPs so later chips don't update
-      this->send_byte_(MAX7219_REGISTER_NOOP, MAX7219_REGISTER_NOOP);
-    this->disable();  // all done disable SPI
-  }                   // end of for each column
-}  // end of send64pixels
+  } else {
+    b = pixels[7 - col];
+  }
+  return this->invert_ ? ~b : b;
+}
 
 uint8_t MAX7219Component::printdigit(const char *str) { return this->printdigit(0, str); }
 
@@ -84,6 +84,10 @@ class MAX7219Component : public PollingComponent,
  protected:
   void send_byte_(uint8_t a_register, uint8_t data);
   void send_to_all_(uint8_t a_register, uint8_t data);
+  /// The register value of the column of a chip showing pixels, with the orientation and inversion applied.
+  uint8_t column_byte_(const uint8_t pixels[8], uint8_t col);
+  /// Write the columns of frame_ that differ from what the chips show.
+  void write_frame_();
 
   uint8_t intensity_;  /// Intensity of the display from 0 to 15 (most)
   uint8_t num_chips_;
@@ -99,6 +103,11 @@ class MAX7219Component : public PollingComponent,
   uint8_t orientation_;
   uint8_t bckgrnd_ = 0x0;
   std::vector<uint8_t> max_displaybuffer_;
+  /// The column registers to show and as last written to the chips, by position in the chain.
+  std::vector<uint8_t> frame_;
+  std::vector<uint8_t> sent_;
+  /// Write all columns on the next display(), not only the changed ones.
+  bool resend_{true};
   unsigned long last_scroll_ = 0;
   uint16_t stepsleft_;
   size_t get_buffer_length_();
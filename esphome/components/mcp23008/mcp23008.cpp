@@ -1,4 +1,5 @@
 #include "mcp23008.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -18,21 +19,63 @@ void MCP23008::setup() {
     // enable open-drain interrupt pins, 3.3V-safe
     this->write_reg_(MCP23008_IOCON, 0x04);
   }
+
+  if (this->interrupt_pin_ != nullptr) {
+    this->interrupt_pin_->setup();
+    this->interrupt_pin_->attach_interrupt(MCP23008::gpio_intr, this, FALLING);
+  }
+}
+void ICACHE_RAM_ATTR MCP23008::gpio_intr(MCP23008 *arg) {
+  arg->interrupt_ = true;
+  Application::wake_loop_isr();
+}
+void MCP23008::loop() {
+  if (this->interrupt_pin_ == nullptr) {
+    this->gpio_valid_ = false;
+  } else if (this->interrupt_) {
+    this->interrupt_ = false;
+    this->gpio_valid_ = false;
+  }
 }
+bool MCP23008::is_loop_idle() { return !this->cache_ || (this->interrupt_pin_ != nullptr && !this->interrupt_); }
 bool MCP23008::digital_read(uint8_t pin) {
   uint8_t bit = pin % 8;
+  if (this->cache_) {
+    // reading GPIO also clears the interrupt
+    if (!this->gpio_valid_)
+      this->gpio_valid_ = this->read_reg_(MCP23008_GPIO, &this->gpio_);
+    return this->gpio_ & (1 << bit);
+  }
   uint8_t reg_addr = MCP23008_GPIO;
   uint8_t value = 0;
   this->read_reg_(reg_addr, &value);
   return value & (1 << bit);
 }
 void MCP23008::digital_write(uint8_t pin, bool value) {
+  if (this->cache_) {
+    if (value)
+      this->olat_ |= 1 << (pin % 8);
+    else
+      this->olat_ &= ~(1 << (pin % 8));
+    if (!this->olat_dirty_) {
+      this->olat_dirty_ = true;
+      this->defer([this]() {
+        this->olat_dirty_ = false;
+        this->write_reg_(MCP23008_OLAT, this->olat_);
+      });
+    }
+    return;
+  }
   uint8_t reg_addr = MCP23008_OLAT;
   this->update_reg_(pin, value, reg_addr);
 }
 void MCP23008::pin_mode(uint8_t pin, uint8_t mode) {
   uint8_t iodir = MCP23008_IODIR;
   uint8_t gppu = MCP23008_GPPU;
+  if (this->interrupt_pin_ != nullptr && mode != MCP23008_OUTPUT) {
+    // interrupt on every change of the input
+    this->update_reg_(pin, true, MCP23008_GPINTEN);
+  }
   switch (mode) {
     case MCP23008_INPUT:
       this->update_reg_(pin, true, iodir);
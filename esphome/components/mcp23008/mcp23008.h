@@ -34,12 +34,24 @@ class MCP23008 : public Component, public i2c::I2CDevice {
   MCP23008() = default;
 
   void setup() override;
+  void loop() override;
+  bool is_loop_idle() override;
 
   bool digital_read(uint8_t pin);
   void digital_write(uint8_t pin, bool value);
   void pin_mode(uint8_t pin, uint8_t mode);
 
   void set_open_drain_ints(const bool value) { open_drain_ints_ = value; }
+  /** Read the port at most once per loop and combine the writes of a loop into one.
+   *
+   * The inputs are read again in the first digital_read() after the next loop(), with an interrupt pin only
+   * once the MCP23008 signaled a change on it. The outputs are written in the next scheduler call.
+   */
+  void set_cache(bool cache) { cache_ = cache; }
+  /// The ESP pin the INT output is connected to. Only used with the cache.
+  void set_interrupt_pin(GPIOPin *interrupt_pin) { interrupt_pin_ = interrupt_pin; }
+
+  static void gpio_intr(MCP23008 *arg);
 
   float get_setup_priority() const override;
 
@@ -53,6 +65,13 @@ class MCP23008 : public Component, public i2c::I2CDevice {
 
   uint8_t olat_{0x00};
   bool open_drain_ints_;
+  bool cache_{false};
+  GPIOPin *interrupt_pin_{nullptr};
+  /// GPIO as read last, valid until the next loop or interrupt.
+  uint8_t gpio_{0x00};
+  bool gpio_valid_{false};
+  bool olat_dirty_{false};
+  volatile bool interrupt_{false};
 };
 
 class MCP23008GPIOPin : public GPIOPin {
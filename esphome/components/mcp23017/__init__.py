@@ -2,11 +2,14 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import i2c
-from esphome.const import CONF_ID, CONF_NUMBER, CONF_MODE, CONF_INVERTED, CONF_OPEN_DRAIN_INTERRUPT
+from esphome.const import CONF_ID, CONF_NUMBER, CONF_MODE, CONF_INVERTED, CONF_OPEN_DRAIN_INTERRUPT, \
+    CONF_INTERRUPT_PIN
 
 DEPENDENCIES = ['i2c']
 MULTI_CONF = True
 
+CONF_CACHE = 'cache'
+
 mcp23017_ns = cg.esphome_ns.namespace('mcp23017')
 MCP23017GPIOMode = mcp23017_ns.enum('MCP23017GPIOMode')
 MCP23017_GPIO_MODES = {
@@ -21,6 +24,8 @@ MCP23017GPIOPin = mcp23017_ns.class_('MCP23017GPIOPin', cg.GPIOPin)
 CONFIG_SCHEMA = cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(MCP23017),
     cv.Optional(CONF_OPEN_DRAIN_INTERRUPT, default=False): cv.boolean,
+    cv.Optional(CONF_CACHE, default=False): cv.boolean,
+    cv.Optional(CONF_INTERRUPT_PIN): pins.internal_gpio_input_pin_schema,
 }).extend(cv.COMPONENT_SCHEMA).extend(i2c.i2c_device_schema(0x20))
 
 
@@ -29,6 +34,12 @@ def to_code(config):
     yield cg.register_component(var, config)
     yield i2c.register_i2c_device(var, config)
     cg.add(var.set_open_drain_ints(config[CONF_OPEN_DRAIN_INTERRUPT]))
+    # the interrupt only tells when the cached inputs are outdated
+    if config[CONF_CACHE] or CONF_INTERRUPT_PIN in config:
+        cg.add(var.set_cache(True))
+    if CONF_INTERRUPT_PIN in config:
+        pin = yield cg.gpio_pin_expression(config[CONF_INTERRUPT_PIN])
+        cg.add(var.set_interrupt_pin(pin))
 
 
 CONF_MCP23017 = 'mcp23017'
@@ -1,4 +1,5 @@
 #include "mcp23017.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -14,26 +15,87 @@ void MCP23017::setup() {
     return;
   }
 
+  iocon = 0;
   if (this->open_drain_ints_) {
     // enable open-drain interrupt pins, 3.3V-safe
-    this->write_reg_(MCP23017_IOCONA, 0x04);
-    this->write_reg_(MCP23017_IOCONB, 0x04);
+    iocon |= 0x04;
+  }
+  if (this->interrupt_pin_ != nullptr) {
+    // mirror INTB to INTA, so that one pin signals the changes of both ports
+    iocon |= 0x40;
+  }
+  if (iocon != 0) {
+    this->write_reg_(MCP23017_IOCONA, iocon);
+    this->write_reg_(MCP23017_IOCONB, iocon);
+  }
+
+  if (this->interrupt_pin_ != nullptr) {
+    this->interrupt_pin_->setup();
+    this->interrupt_pin_->attach_interrupt(MCP23017::gpio_intr, this, FALLING);
   }
 }
+void ICACHE_RAM_ATTR MCP23017::gpio_intr(MCP23017 *arg) {
+  arg->interrupt_ = true;
+  Application::wake_loop_isr();
+}
+void MCP23017::loop() {
+  if (this->interrupt_pin_ == nullptr) {
+    this->gpio_valid_ = false;
+  } else if (this->interrupt_) {
+    this->interrupt_ = false;
+    this->gpio_valid_ = false;
+  }
+}
+bool MCP23017::is_loop_idle() { return !this->cache_ || (this->interrupt_pin_ != nullptr && !this->interrupt_); }
 bool MCP23017::digital_read(uint8_t pin) {
   uint8_t bit = pin % 8;
+  if (this->cache_) {
+    // GPIOB follows GPIOA, read both in one transaction (this also clears the interrupt)
+    if (!this->gpio_valid_ && !this->is_failed())
+      this->gpio_valid_ = this->read_bytes(MCP23017_GPIOA, this->gpio_, 2);
+    return this->gpio_[pin < 8 ? 0 : 1] & (1 << bit);
+  }
   uint8_t reg_addr = pin < 8 ? MCP23017_GPIOA : MCP23017_GPIOB;
   uint8_t value = 0;
   this->read_reg_(reg_addr, &value);
   return value & (1 << bit);
 }
 void MCP23017::digital_write(uint8_t pin, bool value) {
+  if (this->cache_) {
+    uint8_t &olat = pin < 8 ? this->olat_a_ : this->olat_b_;
+    if (value)
+      olat |= 1 << (pin % 8);
+    else
+      olat &= ~(1 << (pin % 8));
+    if (this->olat_dirty_ == 0)
+      this->defer([this]() { this->flush_(); });
+    this->olat_dirty_ |= pin < 8 ? 1 : 2;
+    return;
+  }
   uint8_t reg_addr = pin < 8 ? MCP23017_OLATA : MCP23017_OLATB;
   this->update_reg_(pin, value, reg_addr);
 }
+void MCP23017::flush_() {
+  if (this->is_failed())
+    return;
+  if (this->olat_dirty_ == 3) {
+    // OLATB follows OLATA
+    uint8_t data[2] = {this->olat_a_, this->olat_b_};
+    this->write_bytes(MCP23017_OLATA, data, 2);
+  } else if (this->olat_dirty_ == 1) {
+    this->write_reg_(MCP23017_OLATA, this->olat_a_);
+  } else if (this->olat_dirty_ == 2) {
+    this->write_reg_(MCP23017_OLATB, this->olat_b_);
+  }
+  this->olat_dirty_ = 0;
+}
 void MCP23017::pin_mode(uint8_t pin, uint8_t mode) {
   uint8_t iodir = pin < 8 ? MCP23017_IODIRA : MCP23017_IODIRB;
   uint8_t gppu = pin < 8 ? MCP23017_GPPUA : MCP23017_GPPUB;
+  if (this->interrupt_pin_ != nullptr && mode != MCP23017_OUTPUT) {
+    // interrupt on every change of the input
+    this->update_reg_(pin, true, pin < 8 ? MCP23017_GPINTENA : MCP23017_GPINTENB);
+  }
   switch (mode) {
     case MCP23017_INPUT:
       this->update_reg_(pin, true, iodir);
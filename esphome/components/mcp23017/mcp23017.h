@@ -46,12 +46,24 @@ class MCP23017 : public Component, public i2c::I2CDevice {
   MCP23017() = default;
 
   void setup() override;
+  void loop() override;
+  bool is_loop_idle() override;
 
   bool digital_read(uint8_t pin);
   void digital_write(uint8_t pin, bool value);
   void pin_mode(uint8_t pin, uint8_t mode);
 
   void set_open_drain_ints(const bool value) { open_drain_ints_ = value; }
+  /** Read both ports at most once per loop and combine the writes of a loop into one.
+   *
+   * The inputs are read again in the first digital_read() after the next loop(), with an interrupt pin only
+   * once the MCP23017 signaled a change on it. The outputs are written in the next scheduler call.
+   */
+  void set_cache(bool cache) { cache_ = cache; }
+  /// The ESP pin the INTA output is connected to, INTB is mirrored to it. Only used with the cache.
+  void set_interrupt_pin(GPIOPin *interrupt_pin) { interrupt_pin_ = interrupt_pin; }
+
+  static void gpio_intr(MCP23017 *arg);
 
   float get_setup_priority() const override;
 
@@ -63,9 +75,20 @@ class MCP23017 : public Component, public i2c::I2CDevice {
   // update registers with given pin value.
   void update_reg_(uint8_t pin, bool pin_value, uint8_t reg_a);
 
+  /// Write the output latches changed since the last flush.
+  void flush_();
+
   uint8_t olat_a_{0x00};
   uint8_t olat_b_{0x00};
   bool open_drain_ints_;
+  bool cache_{false};
+  GPIOPin *interrupt_pin_{nullptr};
+  /// GPIOA and GPIOB as read last, valid until the next loop or interrupt.
+  uint8_t gpio_[2]{};
+  bool gpio_valid_{false};
+  /// Bit 0 for OLATA, bit 1 for OLATB.
+  uint8_t olat_dirty_{0};
+  volatile bool interrupt_{false};
 };
 
 class MCP23017GPIOPin : public GPIOPin {
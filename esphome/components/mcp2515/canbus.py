@@ -1,7 +1,8 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome import pins
 from esphome.components import spi, canbus
-from esphome.const import CONF_ID, CONF_MODE
+from esphome.const import CONF_ID, CONF_MODE, CONF_INTERRUPT_PIN
 from esphome.components.canbus import CanbusComponent
 
 CODEOWNERS = ['@mvturnho', '@danielschramm']
@@ -30,6 +31,7 @@ CONFIG_SCHEMA = canbus.CONFIG_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(mcp2515),
     cv.Optional(CONF_CLOCK, default='8MHZ'): cv.enum(CAN_CLOCK, upper=True),
     cv.Optional(CONF_MODE, default='NORMAL'): cv.enum(MCP_MODE, upper=True),
+    cv.Optional(CONF_INTERRUPT_PIN): pins.gpio_input_pin_schema,
 }).extend(spi.spi_device_schema(True))
 
 
@@ -43,5 +45,8 @@ def to_code(config):
     if CONF_MODE in config:
         mode = MCP_MODE[config[CONF_MODE]]
         cg.add(var.set_mcp_mode(mode))
+    if CONF_INTERRUPT_PIN in config:
+        interrupt_pin = yield cg.gpio_pin_expression(config[CONF_INTERRUPT_PIN])
+        cg.add(var.set_interrupt_pin(interrupt_pin))
 
     yield spi.register_spi_device(var, config)
@@ -1,5 +1,6 @@
 #include "mcp2515.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace mcp2515 {
@@ -15,6 +16,8 @@ const struct MCP2515::RxBnRegs MCP2515::RXB[N_RXBUFFERS] = {{MCP_RXB0CTRL, MCP_R
 
 bool MCP2515::setup_internal() {
   this->spi_setup();
+  if (this->interrupt_pin_ != nullptr)
+    this->interrupt_pin_->setup();
 
   if (this->reset_() == canbus::ERROR_FAIL)
     return false;
@@ -233,6 +236,59 @@ canbus::Error MCP2515::set_filter_(const RXF num, const bool extended, const uin
   return canbus::ERROR_OK;
 }
 
+void MCP2515::setup_filters(const std::vector<uint32_t> &standard_ids, const std::vector<uint32_t> &extended_ids) {
+  // without triggers every frame is received, like before
+  if (standard_ids.empty() && extended_ids.empty())
+    return;
+
+  // RXB0 is matched with mask 0 and filters 0-1, RXB1 with mask 1 and filters 2-5. A mask for extended IDs would
+  // compare the first data bytes of standard frames, so if both kinds are used each gets its own buffer.
+  static const RXF RXB0_FILTERS[] = {RXF0, RXF1};
+  static const RXF RXB1_FILTERS[] = {RXF2, RXF3, RXF4, RXF5};
+  if (!standard_ids.empty() && !extended_ids.empty()) {
+    const bool extended_first = extended_ids.size() < standard_ids.size();
+    this->set_acceptance_(MASK0, RXB0_FILTERS, 2, extended_first, extended_first ? extended_ids : standard_ids);
+    this->set_acceptance_(MASK1, RXB1_FILTERS, 4, !extended_first, extended_first ? standard_ids : extended_ids);
+  } else {
+    const bool extended = !extended_ids.empty();
+    const std::vector<uint32_t> &ids = extended ? extended_ids : standard_ids;
+    if (ids.size() > 2 && ids.size() <= 6) {
+      this->set_acceptance_(MASK0, RXB0_FILTERS, 2, extended, std::vector<uint32_t>(ids.begin(), ids.begin() + 2));
+      this->set_acceptance_(MASK1, RXB1_FILTERS, 4, extended, std::vector<uint32_t>(ids.begin() + 2, ids.end()));
+    } else {
+      this->set_acceptance_(MASK0, RXB0_FILTERS, 2, extended, ids);
+      this->set_acceptance_(MASK1, RXB1_FILTERS, 4, extended, ids);
+    }
+  }
+  this->set_mode_(this->mcp_mode_);
+}
+
+void MCP2515::set_acceptance_(MASK mask, const RXF *filters, uint8_t n_filters, bool extended,
+                              const std::vector<uint32_t> &ids) {
+  const uint32_t all_bits = extended ? 0x1FFFFFFF : 0x7FF;
+  uint32_t mask_bits = all_bits;
+  if (ids.size() > n_filters) {
+    // not enough filters for exact matches, only compare the bits all IDs have in common
+    for (uint32_t id : ids)
+      mask_bits &= ~(id ^ ids[0]);
+  }
+  ESP_LOGD(TAG, "Mask %d: %s mask=0x%08x for %u IDs", mask, extended ? "extended" : "standard", mask_bits,
+           ids.size());
+  this->set_filter_mask_(mask, extended, mask_bits);
+  for (uint8_t i = 0; i < n_filters; i++)
+    this->set_filter_(filters[i], extended, i < ids.size() && mask_bits == all_bits ? ids[i] : ids[0]);
+}
+
+void MCP2515::check_overflow_() {
+  const uint8_t eflg = this->get_error_flags_();
+  if (eflg & (EFLG_RX0OVR | EFLG_RX1OVR)) {
+    this->rx_overflows_++;
+    ESP_LOGW(TAG, "Receive buffer overflow, %u frames lost so far", this->rx_overflows_);
+    this->clear_rx_n_ovr_flags_();
+  }
+  this->modify_register_(MCP_CANINTF, CANINTF_ERRIF | CANINTF_MERRF, 0);
+}
+
 canbus::Error MCP2515::send_message_(TXBn txbn, struct canbus::CanFrame *frame) {
   const struct TxBnRegs *txbuf = &TXB[txbn];
 
@@ -242,6 +298,7 @@ canbus::Error MCP2515::send_message_(TXBn txbn, struct canbus::CanFrame *frame)
   data[MCP_DLC] =
       frame->remote_transmission_request ? (frame->can_data_length_code | RTR_MASK) : frame->can_data_length_code;
   memcpy(&data[MCP_DATA], frame->data, frame->can_data_length_code);
+  set_register_(txbuf->CTRL, this->tx_priority_[txbn]);
   set_registers_(txbuf->SIDH, data, 5 + frame->can_data_length_code);
   modify_register_(txbuf->CTRL, TXB_TXREQ, TXB_TXREQ);
 
@@ -254,15 +311,22 @@ canbus::Error MCP2515::send_message(struct canbus::CanFrame *frame) {
   }
   TXBn tx_buffers[N_TXBUFFERS] = {TXB0, TXB1, TXB2};
 
-  for (auto &tx_buffer : tx_buffers) {
-    const struct TxBnRegs *txbuf = &TXB[tx_buffer];
-    uint8_t ctrlval = read_register_(txbuf->CTRL);
-    if ((ctrlval & TXB_TXREQ) == 0) {
-      return send_message_(tx_buffer, frame);
+  // READ STATUS has the TXREQ bits of the buffers at bit 2, 4 and 6
+  const uint8_t status = get_status_();
+  int free_buffer = -1;
+  uint8_t lowest_priority = TXB_TXP + 1;
+  for (int i = 0; i < N_TXBUFFERS; i++) {
+    if (status & (0x04 << (2 * i))) {
+      lowest_priority = std::min(lowest_priority, this->tx_priority_[i]);
+    } else if (free_buffer == -1) {
+      free_buffer = i;
     }
   }
-
-  return canbus::ERROR_FAILTX;
+  // the pending buffer with the highest priority is sent first, a new frame has to go after all pending ones
+  if (free_buffer == -1 || lowest_priority == 0)
+    return canbus::ERROR_ALLTXBUSY;
+  this->tx_priority_[free_buffer] = lowest_priority - 1;
+  return send_message_(tx_buffers[free_buffer], frame);
 }
 
 canbus::Error MCP2515::read_message_(RXBn rxbn, struct canbus::CanFrame *frame) {
@@ -308,6 +372,10 @@ canbus::Error MCP2515::read_message_(RXBn rxbn, struct canbus::CanFrame *frame)
 }
 
 canbus::Error MCP2515::read_message(struct canbus::CanFrame *frame) {
+  // INT is high while no interrupt flag is set
+  if (this->interrupt_pin_ != nullptr && this->interrupt_pin_->digital_read())
+    return canbus::ERROR_NOMSG;
+
   canbus::Error rc;
   uint8_t stat = get_status_();
 
@@ -316,6 +384,9 @@ canbus::Error MCP2515::read_message(struct canbus::CanFrame *frame) {
   } else if (stat & STAT_RX1IF) {
     rc = read_message_(RXB1, frame);
   } else {
+    // an error flag keeps INT low
+    if (this->interrupt_pin_ != nullptr)
+      this->check_overflow_();
     rc = canbus::ERROR_NOMSG;
   }
 
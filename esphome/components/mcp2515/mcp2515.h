@@ -59,6 +59,9 @@ class MCP2515 : public canbus::Canbus,
   MCP2515(){};
   void set_mcp_clock(CanClock clock) { this->mcp_clock_ = clock; };
   void set_mcp_mode(const CanctrlReqopMode mode) { this->mcp_mode_ = mode; }
+  /// The INT pin of the controller, it is low while a frame is waiting, so idle loops need no SPI transfer.
+  void set_interrupt_pin(GPIOPin *interrupt_pin) { this->interrupt_pin_ = interrupt_pin; }
+  uint32_t get_rx_overflows() const { return this->rx_overflows_; }
   static const struct TxBnRegs {
     REGISTER CTRL;
     REGISTER SIDH;
@@ -75,7 +78,15 @@ class MCP2515 : public canbus::Canbus,
  protected:
   CanClock mcp_clock_{MCP_8MHZ};
   CanctrlReqopMode mcp_mode_ = CANCTRL_REQOP_NORMAL;
+  GPIOPin *interrupt_pin_{nullptr};
+  /// The TXP priority each transmit buffer was loaded with.
+  uint8_t tx_priority_[N_TXBUFFERS]{};
+  uint32_t rx_overflows_{0};
   bool setup_internal() override;
+  void setup_filters(const std::vector<uint32_t> &standard_ids, const std::vector<uint32_t> &extended_ids) override;
+  void set_acceptance_(MASK mask, const RXF *filters, uint8_t n_filters, bool extended,
+                       const std::vector<uint32_t> &ids);
+  void check_overflow_();
   canbus::Error set_mode_(CanctrlReqopMode mode);
 
   uint8_t read_register_(REGISTER reg);
@@ -23,7 +23,8 @@ CONFIG_SCHEMA = sensor.SENSOR_SCHEMA.extend({
 
 def to_code(config):
     parent = yield cg.get_variable(config[CONF_MCP3008_ID])
-    var = cg.new_Pvariable(config[CONF_ID], parent, config[CONF_NAME],
+    var = cg.new_Pvariable(config[CONF_ID], parent, '',
                            config[CONF_NUMBER], config[CONF_REFERENCE_VOLTAGE])
+    cg.setup_entity_name(var, config[CONF_NAME])
     yield cg.register_component(var, config)
     yield sensor.register_sensor(var, config)
@@ -22,9 +22,13 @@ const uint16_t MITSUBISHI_HEADER_MARK = 3500;
 const uint16_t MITSUBISHI_HEADER_SPACE = 1700;
 const uint16_t MITSUBISHI_MIN_GAP = 17500;
 
+static const climate_ir::IRFrameTiming MITSUBISHI_TIMING = {MITSUBISHI_HEADER_MARK, MITSUBISHI_HEADER_SPACE,
+                                                            MITSUBISHI_BIT_MARK,    MITSUBISHI_ONE_SPACE,
+                                                            MITSUBISHI_ZERO_SPACE,  false};
+
 void MitsubishiClimate::transmit_state() {
-  uint32_t remote_state[18] = {0x23, 0xCB, 0x26, 0x01, 0x00, 0x20, 0x48, 0x00, 0x30,
-                               0x58, 0x61, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x00};
+  uint8_t remote_state[18] = {0x23, 0xCB, 0x26, 0x01, 0x00, 0x20, 0x48, 0x00, 0x30,
+                              0x58, 0x61, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x00};
 
   switch (this->mode) {
     case climate::CLIMATE_MODE_COOL:
@@ -57,25 +61,10 @@ void MitsubishiClimate::transmit_state() {
   auto data = transmit.get_data();
 
   data->set_carrier_frequency(38000);
+  data->reserve(climate_ir::ir_frame_length(sizeof(remote_state)) * 2);
   // repeat twice
-  for (uint16_t r = 0; r < 2; r++) {
-    // Header
-    data->mark(MITSUBISHI_HEADER_MARK);
-    data->space(MITSUBISHI_HEADER_SPACE);
-    // Data
-    for (uint8_t i : remote_state)
-      for (uint8_t j = 0; j < 8; j++) {
-        data->mark(MITSUBISHI_BIT_MARK);
-        bool bit = i & (1 << j);
-        data->space(bit ? MITSUBISHI_ONE_SPACE : MITSUBISHI_ZERO_SPACE);
-      }
-    // Footer
-    if (r == 0) {
-      data->mark(MITSUBISHI_BIT_MARK);
-      data->space(MITSUBISHI_MIN_GAP);  // Pause before repeating
-    }
-  }
-  data->mark(MITSUBISHI_BIT_MARK);
+  climate_ir::encode_ir_frame(data, MITSUBISHI_TIMING, remote_state, sizeof(remote_state), MITSUBISHI_MIN_GAP);
+  climate_ir::encode_ir_frame(data, MITSUBISHI_TIMING, remote_state, sizeof(remote_state), 0);
 
   transmit.perform();
 }
@@ -12,8 +12,10 @@ ModbusDevice = modbus_ns.class_('ModbusDevice')
 MULTI_CONF = True
 
 CONF_MODBUS_ID = 'modbus_id'
+CONF_RESPONSE_TIMEOUT = 'response_timeout'
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(Modbus),
+    cv.Optional(CONF_RESPONSE_TIMEOUT, default='100ms'): cv.positive_time_period_milliseconds,
 }).extend(cv.COMPONENT_SCHEMA).extend(uart.UART_DEVICE_SCHEMA)
 
 
@@ -23,6 +25,7 @@ def to_code(config):
     yield cg.register_component(var, config)
 
     yield uart.register_uart_device(var, config)
+    cg.add(var.set_response_timeout(config[CONF_RESPONSE_TIMEOUT]))
 
 
 def modbus_device_schema(default_address):
@@ -1,119 +1,220 @@
 #include "modbus.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace modbus {
 
 static const char *TAG = "modbus";
 
+static const uint8_t MODBUS_READ_HOLDING_REGISTERS = 0x03;
+static const uint8_t MODBUS_READ_INPUT_REGISTERS = 0x04;
+/// The most registers one read request may return.
+static const uint16_t MODBUS_MAX_REGISTER_COUNT = 125;
+
+// CRC-16/MODBUS (reflected polynomial 0xA001) of every byte value
+static const uint16_t PROGMEM CRC16_TABLE[256] = {
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+};
+
+uint16_t crc16(const uint8_t *data, uint16_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--)
+    crc = (crc >> 8) ^ pgm_read_word(&CRC16_TABLE[(crc ^ *data++) & 0xFF]);
+  return crc;
+}
+
+void Modbus::setup() {
+  // frames are separated by at least 3.5 characters of silence
+  this->on_frame([this](const uint8_t *data, size_t len) { this->on_frame_(data, len); }, this->char_time_(4));
+}
+
+uint32_t Modbus::char_time_(uint32_t chars) const {
+  // 11 bits per character, at least 1 ms
+  const uint32_t baud_rate = this->parent_->get_baud_rate();
+  return std::max<uint32_t>(1, (chars * 11000 + baud_rate - 1) / baud_rate);
+}
+
 void Modbus::loop() {
   const uint32_t now = millis();
-  if (now - this->last_modbus_byte_ > 50) {
-    this->rx_buffer_.clear();
-    this->last_modbus_byte_ = now;
+  if (this->waiting_ && now - this->sent_at_ > this->timeout_) {
+    const Request &request = this->requests_.front();
+    ModbusStats &stats = this->stats_[request.address];
+    stats.timeouts++;
+    ESP_LOGW(TAG, "Request to 0x%02X timed out (%u of %u requests)", request.address, stats.timeouts, stats.requests);
+    this->requests_.pop_front();
+    this->waiting_ = false;
+    this->last_activity_ = now;
   }
 
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
-    } else {
-      this->rx_buffer_.clear();
-    }
-  }
+  if (!this->waiting_ && !this->requests_.empty() && now - this->last_activity_ >= this->char_time_(4))
+    this->send_next_();
 }
 
-uint16_t crc16(const uint8_t *data, uint8_t len) {
-  uint16_t crc = 0xFFFF;
-  while (len--) {
-    crc ^= *data++;
-    for (uint8_t i = 0; i < 8; i++) {
-      if ((crc & 0x01) != 0) {
-        crc >>= 1;
-        crc ^= 0xA001;
-      } else {
-        crc >>= 1;
+void Modbus::send(ModbusDevice *device, uint8_t function, uint16_t start_address, uint16_t register_count) {
+  const Part part{device, start_address, register_count};
+  const uint32_t part_end = uint32_t(start_address) + register_count;
+  if (function == MODBUS_READ_HOLDING_REGISTERS || function == MODBUS_READ_INPUT_REGISTERS) {
+    // the request in flight can't be changed anymore
+    for (size_t i = this->waiting_ ? 1 : 0; i < this->requests_.size(); i++) {
+      Request &request = this->requests_[i];
+      if (request.address != device->address_ || request.function != function)
+        continue;
+      const uint32_t request_end = uint32_t(request.start_address) + request.register_count;
+      // only overlapping or adjacent ranges are merged
+      if (start_address > request_end || request.start_address > part_end)
+        continue;
+      const uint16_t start = std::min(request.start_address, start_address);
+      const uint32_t end = std::max(request_end, part_end);
+      if (end - start > MODBUS_MAX_REGISTER_COUNT)
+        continue;
+
+      bool duplicate = false;
+      for (const auto &other : request.parts) {
+        if (other.device == device && other.start_address == start_address && other.register_count == register_count)
+          duplicate = true;
       }
+      if (!duplicate)
+        request.parts.push_back(part);
+      request.start_address = start;
+      request.register_count = end - start;
+      return;
     }
   }
-  return crc;
+
+  Request request{};
+  request.address = device->address_;
+  request.function = function;
+  request.start_address = start_address;
+  request.register_count = register_count;
+  request.parts.push_back(part);
+  this->requests_.push_back(std::move(request));
 }
 
-bool Modbus::parse_modbus_byte_(uint8_t byte) {
-  size_t at = this->rx_buffer_.size();
-  this->rx_buffer_.push_back(byte);
-  const uint8_t *raw = &this->rx_buffer_[0];
+void Modbus::send_next_() {
+  const Request &request = this->requests_.front();
+  uint8_t frame[8];
+  frame[0] = request.address;
+  frame[1] = request.function;
+  frame[2] = request.start_address >> 8;
+  frame[3] = request.start_address >> 0;
+  frame[4] = request.register_count >> 8;
+  frame[5] = request.register_count >> 0;
+  auto crc = crc16(frame, 6);
+  frame[6] = crc >> 0;
+  frame[7] = crc >> 8;
 
-  // Byte 0: modbus address (match all)
-  if (at == 0)
-    return true;
-  uint8_t address = raw[0];
+  this->write_array(frame, 8);
+  this->stats_[request.address].requests++;
+  this->waiting_ = true;
+  this->sent_at_ = millis();
+  // the request and the longest response have to be transmitted, plus the time the slave needs to answer
+  this->timeout_ = this->char_time_(8 + 5 + 2 * request.register_count) + this->response_timeout_;
+}
 
-  // Byte 1: Function (msb indicates error)
-  if (at == 1)
-    return (byte & 0x80) != 0x80;
+void Modbus::on_frame_(const uint8_t *data, size_t len) {
+  const uint32_t now = millis();
+  this->last_activity_ = now;
 
-  // Byte 2: Size (with modbus rtu function code 4/3)
+  // Byte 0: modbus address, Byte 1: function (msb indicates error), Byte 2: size (with modbus rtu function code 4/3)
   // See also https://en.wikipedia.org/wiki/Modbus
-  if (at == 2)
-    return true;
-
-  uint8_t data_len = raw[2];
-  // Byte 3..3+data_len-1: Data
-  if (at < 3 + data_len)
-    return true;
-
-  // Byte 3+data_len: CRC_LO (over all bytes)
-  if (at == 3 + data_len)
-    return true;
-  // Byte 3+len+1: CRC_HI (over all bytes)
-  uint16_t computed_crc = crc16(raw, 3 + data_len);
-  uint16_t remote_crc = uint16_t(raw[3 + data_len]) | (uint16_t(raw[3 + data_len + 1]) << 8);
+  if (len < 5) {
+    ESP_LOGW(TAG, "Got Modbus frame of only %u bytes!", len);
+    return;
+  }
+  const uint8_t address = data[0];
+  const uint8_t function = data[1];
+  const bool is_exception = (function & 0x80) != 0;
+  const size_t data_len = is_exception ? 0 : data[2];
+  const size_t frame_len = is_exception ? 5 : 5 + data_len;
+  if (len < frame_len) {
+    ESP_LOGW(TAG, "Got incomplete Modbus frame from 0x%02X!", address);
+    return;
+  }
+
+  ModbusStats &stats = this->stats_[address];
+  uint16_t computed_crc = crc16(data, frame_len - 2);
+  uint16_t remote_crc = uint16_t(data[frame_len - 2]) | (uint16_t(data[frame_len - 1]) << 8);
   if (computed_crc != remote_crc) {
     ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
-    return false;
+    stats.errors++;
+    return;
+  }
+  if (!this->waiting_ || this->requests_.front().address != address) {
+    ESP_LOGW(TAG, "Got Modbus frame from unexpected address 0x%02X!", address);
+    return;
   }
 
-  std::vector<uint8_t> data(this->rx_buffer_.begin() + 3, this->rx_buffer_.begin() + 3 + data_len);
+  Request request = std::move(this->requests_.front());
+  this->requests_.pop_front();
+  this->waiting_ = false;
+  stats.responses++;
+  const float latency = now - this->sent_at_;
+  stats.latency = stats.responses == 1 ? latency : stats.latency * 0.9f + latency * 0.1f;
+
+  if (is_exception) {
+    stats.errors++;
+    ESP_LOGW(TAG, "Modbus exception 0x%02X from 0x%02X for function 0x%02X!", data[2], address, function & 0x7F);
+    return;
+  }
 
-  bool found = false;
-  for (auto *device : this->devices_) {
-    if (device->address_ == address) {
-      device->on_modbus_data(data);
-      found = true;
+  const uint8_t *payload = data + 3;
+  for (const auto &part : request.parts) {
+    const size_t offset = size_t(part.start_address - request.start_address) * 2;
+    const size_t part_len = size_t(part.register_count) * 2;
+    if (request.parts.size() == 1 || offset + part_len > data_len) {
+      // not a merged read, the device gets all of the data
+      part.device->on_modbus_data(std::vector<uint8_t>(payload, payload + data_len));
+    } else {
+      part.device->on_modbus_data(std::vector<uint8_t>(payload + offset, payload + offset + part_len));
     }
   }
-  if (!found) {
-    ESP_LOGW(TAG, "Got Modbus frame from unknown address 0x%02X!", address);
-  }
-
-  // return false to reset buffer
-  return false;
 }
 
 void Modbus::dump_config() {
   ESP_LOGCONFIG(TAG, "Modbus:");
+  ESP_LOGCONFIG(TAG, "  Response Timeout: %u ms", this->response_timeout_);
+  for (const auto &it : this->stats_) {
+    ESP_LOGCONFIG(TAG, "  Slave 0x%02X: %u requests, %u timeouts, %u errors, latency %.0f ms", it.first,
+                  it.second.requests, it.second.timeouts, it.second.errors, it.second.latency);
+  }
   this->check_uart_settings(9600, 2);
 }
 float Modbus::get_setup_priority() const {
   // After UART bus
   return setup_priority::BUS - 1.0f;
 }
-void Modbus::send(uint8_t address, uint8_t function, uint16_t start_address, uint16_t register_count) {
-  uint8_t frame[8];
-  frame[0] = address;
-  frame[1] = function;
-  frame[2] = start_address >> 8;
-  frame[3] = start_address >> 0;
-  frame[4] = register_count >> 8;
-  frame[5] = register_count >> 0;
-  auto crc = crc16(frame, 6);
-  frame[6] = crc >> 0;
-  frame[7] = crc >> 8;
-
-  this->write_array(frame, 8);
-}
 
 }  // namespace modbus
 }  // namespace esphome
@@ -2,16 +2,30 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/uart/uart.h"
+#include <deque>
+#include <map>
 
 namespace esphome {
 namespace modbus {
 
 class ModbusDevice;
 
+/// Request and response statistics of one slave.
+struct ModbusStats {
+  uint32_t requests{0};
+  uint32_t responses{0};
+  uint32_t timeouts{0};
+  /// CRC failures and exception responses.
+  uint32_t errors{0};
+  /// Moving average of the time between sending a request and receiving its response in ms.
+  float latency{0.0f};
+};
+
 class Modbus : public uart::UARTDevice, public Component {
  public:
   Modbus() = default;
 
+  void setup() override;
   void loop() override;
 
   void dump_config() override;
@@ -20,14 +34,43 @@ class Modbus : public uart::UARTDevice, public Component {
 
   float get_setup_priority() const override;
 
-  void send(uint8_t address, uint8_t function, uint16_t start_address, uint16_t register_count);
+  /** Queue a register read, requests are sent one after another.
+   *
+   * A read of the same slave and function that overlaps or is adjacent to an already queued one is merged into it,
+   * each device gets the data of the registers it requested.
+   */
+  void send(ModbusDevice *device, uint8_t function, uint16_t start_address, uint16_t register_count);
+  /// The time a slave has to start its response in ms, on top of the transmission time of request and response.
+  void set_response_timeout(uint32_t response_timeout) { this->response_timeout_ = response_timeout; }
+  const std::map<uint8_t, ModbusStats> &get_stats() const { return this->stats_; }
 
  protected:
-  bool parse_modbus_byte_(uint8_t byte);
+  struct Part {
+    ModbusDevice *device;
+    uint16_t start_address;
+    uint16_t register_count;
+  };
+  struct Request {
+    uint8_t address;
+    uint8_t function;
+    uint16_t start_address;
+    uint16_t register_count;
+    std::vector<Part> parts;
+  };
+
+  void send_next_();
+  void on_frame_(const uint8_t *data, size_t len);
+  /// The transmission time of the given number of characters in ms, rounded up.
+  uint32_t char_time_(uint32_t chars) const;
 
-  std::vector<uint8_t> rx_buffer_;
-  uint32_t last_modbus_byte_{0};
   std::vector<ModbusDevice *> devices_;
+  std::deque<Request> requests_;
+  std::map<uint8_t, ModbusStats> stats_;
+  bool waiting_{false};
+  uint32_t sent_at_{0};
+  uint32_t timeout_{0};
+  uint32_t last_activity_{0};
+  uint32_t response_timeout_{100};
 };
 
 class ModbusDevice {
@@ -37,7 +80,7 @@ class ModbusDevice {
   virtual void on_modbus_data(const std::vector<uint8_t> &data) = 0;
 
   void send(uint8_t function, uint16_t start_address, uint16_t register_count) {
-    this->parent_->send(this->address_, function, start_address, register_count);
+    this->parent_->send(this, function, start_address, register_count);
   }
 
  protected:
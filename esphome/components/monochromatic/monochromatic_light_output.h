@@ -20,6 +20,12 @@ class MonochromaticLightOutput : public light::LightOutput {
     state->current_values_as_brightness(&bright);
     this->output_->set_level(bright);
   }
+  bool supports_fade() override { return this->output_->supports_fade(); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
+    float bright;
+    state->current_values_as_brightness(&bright);
+    this->output_->set_level_fade(bright, length);
+  }
 
  protected:
   output::FloatOutput *output_;
@@ -1,5 +1,8 @@
 #include "mpu6050.h"
 #include "esphome/core/log.h"
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/spectrum/fft.h"
 
 namespace esphome {
 namespace mpu6050 {
@@ -11,6 +14,31 @@ const uint8_t MPU6050_REGISTER_POWER_MANAGEMENT_1 = 0x6B;
 const uint8_t MPU6050_REGISTER_GYRO_CONFIG = 0x1B;
 const uint8_t MPU6050_REGISTER_ACCEL_CONFIG = 0x1C;
 const uint8_t MPU6050_REGISTER_ACCEL_XOUT_H = 0x3B;
+const uint8_t MPU6050_REGISTER_TEMP_OUT_H = 0x41;
+const uint8_t MPU6050_REGISTER_SMPLRT_DIV = 0x19;
+const uint8_t MPU6050_REGISTER_CONFIG = 0x1A;
+const uint8_t MPU6050_REGISTER_FIFO_EN = 0x23;
+const uint8_t MPU6050_REGISTER_INT_ENABLE = 0x38;
+const uint8_t MPU6050_REGISTER_INT_STATUS = 0x3A;
+const uint8_t MPU6050_REGISTER_USER_CTRL = 0x6A;
+const uint8_t MPU6050_REGISTER_FIFO_COUNT_H = 0x72;
+const uint8_t MPU6050_REGISTER_FIFO_R_W = 0x74;
+/// Accelerometer and gyroscope X, Y and Z, the temperature isn't written to the FIFO.
+const uint8_t MPU6050_FIFO_EN_ACCEL_GYRO = 0x78;
+const uint8_t MPU6050_USER_CTRL_FIFO_EN = 0x40;
+const uint8_t MPU6050_USER_CTRL_FIFO_RESET = 0x04;
+const uint8_t MPU6050_INT_DATA_RDY_EN = 0x01;
+const uint8_t MPU6050_INT_STATUS_FIFO_OFLOW = 0x10;
+const uint16_t MPU6050_FIFO_SIZE = 1024;
+const uint8_t MPU6050_FIFO_SAMPLE_SIZE = 12;
+/// The gyroscope output rate with the digital low pass filter enabled, divided by SMPLRT_DIV + 1.
+const uint16_t MPU6050_GYRO_OUTPUT_RATE = 1000;
+// Bytes per I2C read, whole samples that fit the Wire buffer
+#ifdef ARDUINO_ARCH_ESP32
+const uint8_t MPU6050_FIFO_READ_CHUNK = 120;
+#else
+const uint8_t MPU6050_FIFO_READ_CHUNK = 24;
+#endif
 const uint8_t MPU6050_CLOCK_SOURCE_X_GYRO = 0b001;
 const uint8_t MPU6050_SCALE_2000_DPS = 0b11;
 const float MPU6050_SCALE_DPS_PER_DIGIT_2000 = 0.060975f;
@@ -80,6 +108,58 @@ void MPU6050Component::setup() {
     this->mark_failed();
     return;
   }
+
+  if (this->sample_rate_ != 0 && !this->setup_fifo_()) {
+    this->mark_failed();
+    return;
+  }
+}
+bool MPU6050Component::setup_fifo_() {
+  ESP_LOGV(TAG, "  Setting up FIFO...");
+  this->window_ = alloc_large<float>(this->window_size_, BUFFER_LOCATION_PREFER_EXTERNAL);
+  if (this->window_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate the sample window!");
+    return false;
+  }
+
+  // the low pass filter keeps the bandwidth below half the sample rate
+  uint8_t dlpf;
+  if (this->sample_rate_ >= 500) {
+    dlpf = 1;  // 184 Hz
+  } else if (this->sample_rate_ >= 200) {
+    dlpf = 2;  // 94 Hz
+  } else if (this->sample_rate_ >= 100) {
+    dlpf = 3;  // 44 Hz
+  } else if (this->sample_rate_ >= 50) {
+    dlpf = 4;  // 21 Hz
+  } else {
+    dlpf = 5;  // 10 Hz
+  }
+  const uint8_t divider = MPU6050_GYRO_OUTPUT_RATE / this->sample_rate_ - 1;
+  this->sample_rate_ = MPU6050_GYRO_OUTPUT_RATE / (divider + 1);
+  if (!this->write_byte(MPU6050_REGISTER_CONFIG, dlpf) || !this->write_byte(MPU6050_REGISTER_SMPLRT_DIV, divider))
+    return false;
+
+  if (this->interrupt_pin_ != nullptr) {
+    // the MPU6050 has no FIFO watermark interrupt, the samples signalled by data ready are counted instead
+    if (!this->write_byte(MPU6050_REGISTER_INT_ENABLE, MPU6050_INT_DATA_RDY_EN))
+      return false;
+    this->interrupt_pin_->setup();
+    this->interrupt_pin_->attach_interrupt(MPU6050Component::gpio_intr, this, RISING);
+  }
+  return this->write_byte(MPU6050_REGISTER_FIFO_EN, MPU6050_FIFO_EN_ACCEL_GYRO) && this->reset_fifo_();
+}
+bool MPU6050Component::reset_fifo_() {
+  this->window_count_ = 0;
+  memset(this->axis_sums_, 0, sizeof(this->axis_sums_));
+  this->pending_samples_ = 0;
+  this->last_fifo_read_ = millis();
+  return this->write_byte(MPU6050_REGISTER_USER_CTRL, MPU6050_USER_CTRL_FIFO_RESET) &&
+         this->write_byte(MPU6050_REGISTER_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN);
+}
+void ICACHE_RAM_ATTR MPU6050Component::gpio_intr(MPU6050Component *arg) {
+  if (++arg->pending_samples_ == arg->watermark_)
+    Application::wake_loop_isr();
 }
 void MPU6050Component::dump_config() {
   ESP_LOGCONFIG(TAG, "MPU6050:");
@@ -88,6 +168,11 @@ void MPU6050Component::dump_config() {
     ESP_LOGE(TAG, "Communication with MPU6050 failed!");
   }
   LOG_UPDATE_INTERVAL(this);
+  if (this->sample_rate_ != 0) {
+    ESP_LOGCONFIG(TAG, "  FIFO: %u Hz, window of %u samples, read every %u samples", this->sample_rate_,
+                  this->window_size_, this->watermark_);
+    LOG_PIN("  Interrupt Pin: ", this->interrupt_pin_);
+  }
   LOG_SENSOR("  ", "Acceleration X", this->accel_x_sensor_);
   LOG_SENSOR("  ", "Acceleration Y", this->accel_y_sensor_);
   LOG_SENSOR("  ", "Acceleration Z", this->accel_z_sensor_);
@@ -95,10 +180,28 @@ void MPU6050Component::dump_config() {
   LOG_SENSOR("  ", "Gyro Y", this->gyro_y_sensor_);
   LOG_SENSOR("  ", "Gyro Z", this->gyro_z_sensor_);
   LOG_SENSOR("  ", "Temperature", this->temperature_sensor_);
+  LOG_SENSOR("  ", "Vibration RMS", this->vibration_rms_sensor_);
+  LOG_SENSOR("  ", "Vibration Peak", this->vibration_peak_sensor_);
+  for (auto &band : this->vibration_bands_) {
+    ESP_LOGCONFIG(TAG, "  Band %.1f-%.1f Hz:", band.from_hz, band.to_hz);
+    LOG_SENSOR("    ", "Vibration RMS", band.sensor);
+  }
 }
 
 void MPU6050Component::update() {
   ESP_LOGV(TAG, "    Updating MPU6050...");
+  if (this->sample_rate_ != 0) {
+    // the other sensors are published with every window
+    if (this->temperature_sensor_ == nullptr)
+      return;
+    uint16_t raw_temperature;
+    if (!this->read_byte_16(MPU6050_REGISTER_TEMP_OUT_H, &raw_temperature)) {
+      this->status_set_warning();
+      return;
+    }
+    this->temperature_sensor_->publish_state(int16_t(raw_temperature) / 340.0f + 36.53f);
+    return;
+  }
   uint16_t raw_data[7];
   if (!this->read_bytes_16(MPU6050_REGISTER_ACCEL_XOUT_H, raw_data, 7)) {
     this->status_set_warning();
@@ -140,6 +243,124 @@ void MPU6050Component::update() {
 
   this->status_clear_warning();
 }
+
+void MPU6050Component::loop() {
+  if (this->sample_rate_ == 0 || this->is_failed())
+    return;
+  if (this->interrupt_pin_ != nullptr) {
+    if (this->pending_samples_ < this->watermark_)
+      return;
+  } else if (millis() - this->last_fifo_read_ < this->watermark_ * 1000u / this->sample_rate_) {
+    return;
+  }
+  this->read_fifo_();
+}
+bool MPU6050Component::is_loop_idle() {
+  return this->sample_rate_ == 0 || (this->interrupt_pin_ != nullptr && this->pending_samples_ < this->watermark_);
+}
+
+void MPU6050Component::read_fifo_() {
+  this->pending_samples_ = 0;
+  this->last_fifo_read_ = millis();
+
+  uint8_t int_status;
+  uint16_t count;
+  if (!this->read_byte(MPU6050_REGISTER_INT_STATUS, &int_status) ||
+      !this->read_byte_16(MPU6050_REGISTER_FIFO_COUNT_H, &count)) {
+    this->status_set_warning();
+    return;
+  }
+  if ((int_status & MPU6050_INT_STATUS_FIFO_OFLOW) || count >= MPU6050_FIFO_SIZE) {
+    // samples were lost, the window isn't continuous anymore
+    ESP_LOGW(TAG, "FIFO overflow, the loop couldn't keep up with %u Hz. Resetting the FIFO...", this->sample_rate_);
+    if (!this->reset_fifo_())
+      this->status_set_warning();
+    return;
+  }
+
+  // burst read whole samples, the FIFO register doesn't auto-increment
+  uint8_t buffer[MPU6050_FIFO_READ_CHUNK];
+  uint16_t remaining = count - count % MPU6050_FIFO_SAMPLE_SIZE;
+  while (remaining != 0) {
+    const uint8_t len = std::min<uint16_t>(remaining, MPU6050_FIFO_READ_CHUNK);
+    if (!this->read_bytes(MPU6050_REGISTER_FIFO_R_W, buffer, len)) {
+      this->status_set_warning();
+      this->reset_fifo_();
+      return;
+    }
+    for (uint8_t i = 0; i < len; i += MPU6050_FIFO_SAMPLE_SIZE)
+      this->add_sample_(buffer + i);
+    remaining -= len;
+  }
+  this->status_clear_warning();
+}
+
+void MPU6050Component::add_sample_(const uint8_t *data) {
+  int16_t raw[6];
+  for (uint8_t i = 0; i < 6; i++) {
+    raw[i] = int16_t(encode_uint16(data[i * 2], data[i * 2 + 1]));
+    this->axis_sums_[i] += raw[i];
+  }
+  const float x = raw[0];
+  const float y = raw[1];
+  const float z = raw[2];
+  this->window_[this->window_count_++] = sqrtf(x * x + y * y + z * z) * MPU6050_RANGE_PER_DIGIT_2G * GRAVITY_EARTH;
+  if (this->window_count_ == this->window_size_)
+    this->publish_window_();
+}
+
+void MPU6050Component::publish_window_() {
+  const uint16_t n = this->window_size_;
+  float *data = this->window_;
+
+  // the mean is gravity and the orientation, the vibration is what's left
+  float mean = 0.0f;
+  for (uint16_t i = 0; i < n; i++)
+    mean += data[i];
+  mean /= n;
+  float sum_squares = 0.0f;
+  float peak = 0.0f;
+  for (uint16_t i = 0; i < n; i++) {
+    data[i] -= mean;
+    sum_squares += data[i] * data[i];
+    peak = std::max(peak, fabsf(data[i]));
+  }
+  const float rms = sqrtf(sum_squares / n);
+
+  float accel[3];
+  float gyro[3];
+  for (uint8_t i = 0; i < 3; i++) {
+    accel[i] = float(this->axis_sums_[i]) / n * MPU6050_RANGE_PER_DIGIT_2G * GRAVITY_EARTH;
+    gyro[i] = float(this->axis_sums_[i + 3]) / n * MPU6050_SCALE_DPS_PER_DIGIT_2000;
+  }
+  memset(this->axis_sums_, 0, sizeof(this->axis_sums_));
+  this->window_count_ = 0;
+
+  if (!this->vibration_bands_.empty()) {
+    spectrum::apply_hann_window(data, n);
+    spectrum::real_fft(data, n);
+    const float bin_hz = float(this->sample_rate_) / n;
+    for (auto &band : this->vibration_bands_)
+      band.sensor->publish_state(spectrum::band_rms(data, n, bin_hz, band.from_hz, band.to_hz));
+  }
+
+  ESP_LOGD(TAG, "Window of %u samples: accel={x=%.3f, y=%.3f, z=%.3f} m/s², gyro={x=%.3f, y=%.3f, z=%.3f} °/s, "
+           "vibration rms=%.3f peak=%.3f m/s²",
+           n, accel[0], accel[1], accel[2], gyro[0], gyro[1], gyro[2], rms, peak);
+  sensor::Sensor *accel_sensors[3] = {this->accel_x_sensor_, this->accel_y_sensor_, this->accel_z_sensor_};
+  sensor::Sensor *gyro_sensors[3] = {this->gyro_x_sensor_, this->gyro_y_sensor_, this->gyro_z_sensor_};
+  for (uint8_t i = 0; i < 3; i++) {
+    if (accel_sensors[i] != nullptr)
+      accel_sensors[i]->publish_state(accel[i]);
+    if (gyro_sensors[i] != nullptr)
+      gyro_sensors[i]->publish_state(gyro[i]);
+  }
+  if (this->vibration_rms_sensor_ != nullptr)
+    this->vibration_rms_sensor_->publish_state(rms);
+  if (this->vibration_peak_sensor_ != nullptr)
+    this->vibration_peak_sensor_->publish_state(peak);
+}
+
 float MPU6050Component::get_setup_priority() const { return setup_priority::DATA; }
 
 }  // namespace mpu6050
@@ -1,18 +1,35 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/esphal.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/i2c/i2c.h"
 
 namespace esphome {
 namespace mpu6050 {
 
+/// The RMS of the vibration within a frequency band, from the FFT of every window.
+struct VibrationBand {
+  float from_hz;
+  float to_hz;
+  sensor::Sensor *sensor;
+};
+
+/** Reads the MPU6050 accelerometer, gyroscope and thermometer.
+ *
+ * By default one sample is read per update interval. In FIFO mode the chip samples at a fixed rate into its FIFO,
+ * which is read in bursts, and the samples are aggregated over windows: the accelerometer and gyroscope sensors get
+ * the mean of every window, and the vibration sensors the RMS, peak and band statistics of the acceleration
+ * magnitude (without its mean, so without gravity). All of them are published together at the end of a window.
+ */
 class MPU6050Component : public PollingComponent, public i2c::I2CDevice {
  public:
   void setup() override;
   void dump_config() override;
 
   void update() override;
+  void loop() override;
+  bool is_loop_idle() override;
 
   float get_setup_priority() const override;
 
@@ -24,7 +41,38 @@ class MPU6050Component : public PollingComponent, public i2c::I2CDevice {
   void set_gyro_y_sensor(sensor::Sensor *gyro_y_sensor) { gyro_y_sensor_ = gyro_y_sensor; }
   void set_gyro_z_sensor(sensor::Sensor *gyro_z_sensor) { gyro_z_sensor_ = gyro_z_sensor; }
 
+  /** Enable FIFO mode.
+   *
+   * @param sample_rate The sample rate in Hz, 4 to 1000 (rounded to 1000 / n).
+   * @param window_size The number of samples that are aggregated, a power of two for the FFT.
+   * @param watermark The number of samples to collect in the FIFO before it is read.
+   */
+  void set_fifo(uint16_t sample_rate, uint16_t window_size, uint8_t watermark) {
+    this->sample_rate_ = sample_rate;
+    this->window_size_ = window_size;
+    this->watermark_ = watermark;
+  }
+  /// The INT pin, signals every new sample so that the FIFO isn't polled.
+  void set_interrupt_pin(GPIOPin *interrupt_pin) { this->interrupt_pin_ = interrupt_pin; }
+  void set_vibration_rms_sensor(sensor::Sensor *vibration_rms_sensor) {
+    this->vibration_rms_sensor_ = vibration_rms_sensor;
+  }
+  void set_vibration_peak_sensor(sensor::Sensor *vibration_peak_sensor) {
+    this->vibration_peak_sensor_ = vibration_peak_sensor;
+  }
+  void add_vibration_band(float from_hz, float to_hz, sensor::Sensor *sensor) {
+    this->vibration_bands_.push_back(VibrationBand{from_hz, to_hz, sensor});
+  }
+
  protected:
+  bool setup_fifo_();
+  bool reset_fifo_();
+  /// Read all complete samples from the FIFO.
+  void read_fifo_();
+  void add_sample_(const uint8_t *data);
+  void publish_window_();
+  static void gpio_intr(MPU6050Component *arg);
+
   sensor::Sensor *accel_x_sensor_{nullptr};
   sensor::Sensor *accel_y_sensor_{nullptr};
   sensor::Sensor *accel_z_sensor_{nullptr};
@@ -32,8 +80,25 @@ class MPU6050Component : public PollingComponent, public i2c::I2CDevice {
   sensor::Sensor *gyro_x_sensor_{nullptr};
   sensor::Sensor *gyro_y_sensor_{nullptr};
   sensor::Sensor *gyro_z_sensor_{nullptr};
+
+  /// 0 if FIFO mode is disabled.
+  uint16_t sample_rate_{0};
+  uint16_t window_size_{0};
+  uint8_t watermark_{0};
+  GPIOPin *interrupt_pin_{nullptr};
+  sensor::Sensor *vibration_rms_sensor_{nullptr};
+  sensor::Sensor *vibration_peak_sensor_{nullptr};
+  std::vector<VibrationBand> vibration_bands_;
+
+  /// Samples signalled by the interrupt since the FIFO was last read.
+  volatile uint16_t pending_samples_{0};
+  uint32_t last_fifo_read_{0};
+  /// The acceleration magnitude of the samples in the window, transformed in place for the bands.
+  float *window_{nullptr};
+  uint16_t window_count_{0};
+  /// Sums of accel x/y/z and gyro x/y/z over the window, in raw digits.
+  int32_t axis_sums_[6]{};
 };
-;
 
 }  // namespace mpu6050
 }  // namespace esphome
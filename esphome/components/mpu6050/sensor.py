@@ -1,11 +1,13 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome import pins
 from esphome.components import i2c, sensor
-from esphome.const import CONF_ID, CONF_TEMPERATURE, \
-    ICON_BRIEFCASE_DOWNLOAD, UNIT_METER_PER_SECOND_SQUARED, \
+from esphome.const import CONF_ID, CONF_TEMPERATURE, CONF_WINDOW_SIZE, CONF_INTERRUPT_PIN, CONF_FROM, \
+    CONF_TO, ICON_BRIEFCASE_DOWNLOAD, UNIT_METER_PER_SECOND_SQUARED, ICON_PULSE, \
     ICON_SCREEN_ROTATION, UNIT_DEGREE_PER_SECOND, ICON_THERMOMETER, UNIT_CELSIUS
 
 DEPENDENCIES = ['i2c']
+AUTO_LOAD = ['spectrum']
 
 CONF_ACCEL_X = 'accel_x'
 CONF_ACCEL_Y = 'accel_y'
@@ -13,6 +15,16 @@ CONF_ACCEL_Z = 'accel_z'
 CONF_GYRO_X = 'gyro_x'
 CONF_GYRO_Y = 'gyro_y'
 CONF_GYRO_Z = 'gyro_z'
+CONF_FIFO = 'fifo'
+CONF_SAMPLE_RATE = 'sample_rate'
+CONF_WATERMARK = 'watermark'
+CONF_VIBRATION_RMS = 'vibration_rms'
+CONF_VIBRATION_PEAK = 'vibration_peak'
+CONF_VIBRATION_BANDS = 'vibration_bands'
+
+# Bytes, the FIFO holds 1024 and is read before it's full
+FIFO_READ_LIMIT = 960
+FIFO_SAMPLE_SIZE = 12
 
 mpu6050_ns = cg.esphome_ns.namespace('mpu6050')
 MPU6050Component = mpu6050_ns.class_('MPU6050Component', cg.PollingComponent, i2c.I2CDevice)
@@ -20,6 +32,39 @@ MPU6050Component = mpu6050_ns.class_('MPU6050Component', cg.PollingComponent, i2
 accel_schema = sensor.sensor_schema(UNIT_METER_PER_SECOND_SQUARED, ICON_BRIEFCASE_DOWNLOAD, 2)
 gyro_schema = sensor.sensor_schema(UNIT_DEGREE_PER_SECOND, ICON_SCREEN_ROTATION, 2)
 temperature_schema = sensor.sensor_schema(UNIT_CELSIUS, ICON_THERMOMETER, 1)
+vibration_schema = sensor.sensor_schema(UNIT_METER_PER_SECOND_SQUARED, ICON_PULSE, 3)
+
+
+def validate_window_size(value):
+    value = cv.int_range(min=32, max=1024)(value)
+    if value & (value - 1) != 0:
+        raise cv.Invalid("window_size must be a power of two for the FFT")
+    return value
+
+
+def validate_fifo(config):
+    nyquist = config[CONF_SAMPLE_RATE] / 2
+    for band in config[CONF_VIBRATION_BANDS]:
+        if band[CONF_FROM] >= band[CONF_TO]:
+            raise cv.Invalid("The band must start below where it ends")
+        if band[CONF_TO] > nyquist:
+            raise cv.Invalid(f"The band must end at {nyquist}Hz at most, half the sample rate")
+    return config
+
+
+FIFO_SCHEMA = cv.All(cv.Schema({
+    cv.Optional(CONF_SAMPLE_RATE, default='500Hz'): cv.All(cv.frequency, cv.Range(min=4, max=1000)),
+    cv.Optional(CONF_WINDOW_SIZE, default=256): validate_window_size,
+    cv.Optional(CONF_WATERMARK, default=40):
+        cv.int_range(min=1, max=FIFO_READ_LIMIT // FIFO_SAMPLE_SIZE),
+    cv.Optional(CONF_INTERRUPT_PIN): pins.gpio_input_pin_schema,
+    cv.Optional(CONF_VIBRATION_RMS): vibration_schema,
+    cv.Optional(CONF_VIBRATION_PEAK): vibration_schema,
+    cv.Optional(CONF_VIBRATION_BANDS, default=[]): cv.ensure_list(vibration_schema.extend({
+        cv.Required(CONF_FROM): cv.frequency,
+        cv.Required(CONF_TO): cv.frequency,
+    })),
+}), validate_fifo)
 
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(MPU6050Component),
@@ -30,6 +75,7 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_GYRO_Y): gyro_schema,
     cv.Optional(CONF_GYRO_Z): gyro_schema,
     cv.Optional(CONF_TEMPERATURE): temperature_schema,
+    cv.Optional(CONF_FIFO): FIFO_SCHEMA,
 }).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x68))
 
 
@@ -51,3 +97,19 @@ def to_code(config):
     if CONF_TEMPERATURE in config:
         sens = yield sensor.new_sensor(config[CONF_TEMPERATURE])
         cg.add(var.set_temperature_sensor(sens))
+
+    if CONF_FIFO in config:
+        fifo = config[CONF_FIFO]
+        cg.add(var.set_fifo(int(fifo[CONF_SAMPLE_RATE]), fifo[CONF_WINDOW_SIZE], fifo[CONF_WATERMARK]))
+        if CONF_INTERRUPT_PIN in fifo:
+            pin = yield cg.gpio_pin_expression(fifo[CONF_INTERRUPT_PIN])
+            cg.add(var.set_interrupt_pin(pin))
+        if CONF_VIBRATION_RMS in fifo:
+            sens = yield sensor.new_sensor(fifo[CONF_VIBRATION_RMS])
+            cg.add(var.set_vibration_rms_sensor(sens))
+        if CONF_VIBRATION_PEAK in fifo:
+            sens = yield sensor.new_sensor(fifo[CONF_VIBRATION_PEAK])
+            cg.add(var.set_vibration_peak_sensor(sens))
+        for band in fifo[CONF_VIBRATION_BANDS]:
+            sens = yield sensor.new_sensor(band)
+            cg.add(var.add_vibration_band(band[CONF_FROM], band[CONF_TO], sens))
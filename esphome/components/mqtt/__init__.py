@@ -15,6 +15,10 @@ from esphome.const import CONF_AVAILABILITY, CONF_BIRTH_MESSAGE, CONF_BROKER, CO
 from esphome.core import coroutine_with_priority, coroutine, CORE
 
 DEPENDENCIES = ['network']
+CONF_DISCOVERY_BATCH_SIZE = 'discovery_batch_size'
+CONF_DISCOVERY_INTERVAL = 'discovery_interval'
+CONF_DISCOVERY_SKIP_UNCHANGED = 'discovery_skip_unchanged'
+CONF_PUBLISH_QUEUE_SIZE = 'publish_queue_size'
 AUTO_LOAD = ['json', 'async_tcp']
 
 
@@ -108,6 +112,9 @@ CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.Optional(CONF_CLIENT_ID): cv.string,
     cv.Optional(CONF_DISCOVERY, default=True): cv.Any(cv.boolean, cv.one_of("CLEAN", upper=True)),
     cv.Optional(CONF_DISCOVERY_RETAIN, default=True): cv.boolean,
+    cv.Optional(CONF_DISCOVERY_INTERVAL, default='50ms'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_DISCOVERY_BATCH_SIZE, default=1): cv.int_range(min=1, max=255),
+    cv.Optional(CONF_DISCOVERY_SKIP_UNCHANGED, default=True): cv.boolean,
     cv.Optional(CONF_DISCOVERY_PREFIX, default="homeassistant"): cv.publish_topic,
 
     cv.Optional(CONF_BIRTH_MESSAGE): MQTT_MESSAGE_SCHEMA,
@@ -122,6 +129,7 @@ CONFIG_SCHEMA = cv.All(cv.Schema({
                                                cv.ensure_list(validate_fingerprint)),
     cv.Optional(CONF_KEEPALIVE, default='15s'): cv.positive_time_period_seconds,
     cv.Optional(CONF_REBOOT_TIMEOUT, default='15min'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_PUBLISH_QUEUE_SIZE, default=16): cv.int_range(min=0, max=255),
     cv.Optional(CONF_ON_MESSAGE): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(MQTTMessageTrigger),
         cv.Required(CONF_TOPIC): cv.subscribe_topic,
@@ -213,6 +221,9 @@ def to_code(config):
     cg.add(var.set_keep_alive(config[CONF_KEEPALIVE]))
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_publish_queue_size(config[CONF_PUBLISH_QUEUE_SIZE]))
+    cg.add(var.set_discovery_pacing(config[CONF_DISCOVERY_INTERVAL], config[CONF_DISCOVERY_BATCH_SIZE]))
+    cg.add(var.set_discovery_skip_unchanged(config[CONF_DISCOVERY_SKIP_UNCHANGED]))
 
     for conf in config.get(CONF_ON_MESSAGE, []):
         trig = cg.new_Pvariable(conf[CONF_TRIGGER_ID], conf[CONF_TOPIC])
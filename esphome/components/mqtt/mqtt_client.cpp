@@ -3,6 +3,9 @@
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/util.h"
+#include "esphome/core/state_trace.h"
+#include <algorithm>
+#include <cstring>
 #ifdef USE_LOGGER
 #include "esphome/components/logger/logger.h"
 #endif
@@ -33,6 +36,10 @@ void MQTTClientComponent::setup() {
     this->state_ = MQTT_CLIENT_DISCONNECTED;
     this->disconnect_reason_ = reason;
   });
+  this->mqtt_client_.onPublish([this](uint16_t packet_id) {
+    if (packet_id == this->delivery_packet_id_)
+      this->delivery_acked_ = true;
+  });
 #ifdef USE_LOGGER
   if (this->is_log_message_enabled() && logger::global_logger != nullptr) {
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
@@ -44,6 +51,8 @@ void MQTTClientComponent::setup() {
   }
 #endif
 
+  this->discovery_pref_ = global_preferences.make_preference<uint32_t>(fnv1_hash("mqtt_discovery"));
+
   this->last_connected_ = millis();
   this->start_dnslookup_();
 }
@@ -198,15 +207,17 @@ void MQTTClientComponent::check_connected() {
 
   this->state_ = MQTT_CLIENT_CONNECTED;
   this->sent_birth_message_ = false;
+  this->delivery_packet_id_ = 0;
+  this->delivery_acked_ = false;
+  // messages queued for the old connection are outdated, all components publish their state again below
+  this->publish_queue_.clear();
   this->status_clear_warning();
   ESP_LOGI(TAG, "MQTT Connected!");
   // MQTT Client needs some time to be fully set up.
   delay(100);  // NOLINT
 
   this->resubscribe_subscriptions_();
-
-  for (MQTTComponent *component : this->children_)
-    component->schedule_resend_state();
+  this->start_discovery_();
 }
 
 void MQTTClientComponent::loop() {
@@ -274,6 +285,8 @@ void MQTTClientComponent::loop() {
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
+        this->drain_publish_queue_();
+        this->process_discovery_();
       }
       break;
   }
@@ -329,6 +342,7 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
       .resubscribe_timeout = 0,
   };
   this->resubscribe_subscription_(&subscription);
+  this->subscription_trie_.add(topic, this->subscriptions_.size());
   this->subscriptions_.push_back(subscription);
 }
 
@@ -344,6 +358,7 @@ void MQTTClientComponent::subscribe_json(const std::string &topic, mqtt_json_cal
       .resubscribe_timeout = 0,
   };
   this->resubscribe_subscription_(&subscription);
+  this->subscription_trie_.add(topic, this->subscriptions_.size());
   this->subscriptions_.push_back(subscription);
 }
 
@@ -358,9 +373,37 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
     // critical components will re-transmit their messages
     return false;
   }
+#ifdef USE_DUAL_CORE
+  if (App.is_network_task_running() && App.is_loop_task()) {
+    // the publish queue belongs to the network task
+    std::string topic_copy = topic;
+    std::string payload_copy(payload, payload_length);
+#ifdef USE_STATE_TRACE
+    const StateTrace trace = global_state_tracer.get_current();
+    App.run_in_network([this, topic_copy, payload_copy, qos, retain, trace]() {
+      const StateTrace previous = global_state_tracer.set_current(trace);
+      this->publish(topic_copy, payload_copy, qos, retain);
+      global_state_tracer.set_current(previous);
+    });
+#else
+    App.run_in_network([this, topic_copy, payload_copy, qos, retain]() {
+      this->publish(topic_copy, payload_copy, qos, retain);
+    });
+#endif
+    return true;
+  }
+#endif
   bool logging_topic = topic == this->log_message_.topic;
+  if (!logging_topic && !this->publish_queue_.empty()) {
+    // keep the order of messages, this one has to wait until the queue is drained
+    return this->enqueue_publish_(topic, payload, payload_length, qos, retain);
+  }
   uint16_t ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
   delay(0);
+  if (ret == 0 && !logging_topic && this->publish_queue_size_ != 0) {
+    // the TCP send buffer is full, loop() sends the message once there's space again
+    return this->enqueue_publish_(topic, payload, payload_length, qos, retain);
+  }
   if (ret == 0 && !logging_topic && this->is_connected()) {
     delay(0);
     ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
@@ -370,6 +413,10 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
   if (!logging_topic) {
     if (ret != 0) {
       ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", topic.c_str(), payload, retain);
+      network_mark_activity();
+#ifdef USE_STATE_TRACE
+      global_state_tracer.record_current(STATE_TRACE_SENT);
+#endif
     } else {
       ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", topic.c_str(),
                payload_length);  // NOLINT
@@ -379,82 +426,261 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
   return ret != 0;
 }
 
-bool MQTTClientComponent::publish(const MQTTMessage &message) {
-  return this->publish(message.topic, message.payload, message.qos, message.retain);
-}
-bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
-                                       bool retain) {
-  size_t len;
-  const char *message = json::build_json(f, &len);
-  return this->publish(topic, message, len, qos, retain);
-}
+bool MQTTClientComponent::enqueue_publish_(const std::string &topic, const char *payload, size_t payload_length,
+                                           uint8_t qos, bool retain) {
+  if (qos == 0) {
+    // only the latest state matters for QoS 0 messages, replace the payload of a queued one
+    for (auto &queued : this->publish_queue_) {
+      if (queued.qos == 0 && queued.retain == retain && queued.topic == topic) {
+        queued.payload.assign(payload, payload_length);
+        ESP_LOGV(TAG, "Coalesced queued publish for topic='%s'", topic.c_str());
+        return true;
+      }
+    }
+  }
 
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
+  if (this->publish_queue_.size() >= this->publish_queue_size_) {
+    // make room by dropping the oldest QoS 0 message, QoS 1 and 2 messages are never dropped for newer ones
+    auto it = std::find_if(this->publish_queue_.begin(), this->publish_queue_.end(),
+                           [](const MQTTMessage &queued) { return queued.qos == 0; });
+    this->publish_queue_drops_++;
+    this->status_momentary_warning("publish", 1000);
+    if (it == this->publish_queue_.end()) {
+      ESP_LOGW(TAG, "Publish queue full, dropping message for topic='%s'", topic.c_str());
+      return false;
+    }
+    ESP_LOGW(TAG, "Publish queue full, dropping message for topic='%s'", it->topic.c_str());
+    this->publish_queue_.erase(it);
+  }
 
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
+  MQTTMessage message;
+  message.topic = topic;
+  message.payload.assign(payload, payload_length);
+  message.qos = qos;
+  message.retain = retain;
+  this->publish_queue_.push_back(std::move(message));
+  ESP_LOGV(TAG, "Queued publish for topic='%s' (%u queued)", topic.c_str(),
+           static_cast<unsigned>(this->publish_queue_.size()));
+  return true;
+}
+void MQTTClientComponent::drain_publish_queue_() {
+  size_t sent = 0;
+  for (const auto &message : this->publish_queue_) {
+    uint16_t ret = this->mqtt_client_.publish(message.topic.c_str(), message.qos, message.retain,
+                                              message.payload.data(), message.payload.size());
+    if (ret == 0)
+      // still no space in the TCP send buffer, try again in the next loop()
+      break;
+    ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d) from queue", message.topic.c_str(),
+             message.payload.c_str(), message.retain);
+    sent++;
+  }
+  if (sent != 0)
+    this->publish_queue_.erase(this->publish_queue_.begin(), this->publish_queue_.begin() + sent);
+}
+
+void MQTTClientComponent::start_discovery_() {
+  const bool skip_possible = this->discovery_skip_unchanged_ && this->is_discovery_enabled() &&
+                             this->discovery_info_.retain && !this->discovery_info_.clean;
+  this->discovery_phase_ = skip_possible ? DiscoveryPhase::HASH : DiscoveryPhase::PUBLISH;
+  this->discovery_index_ = 0;
+  // a hash of 0 means the payloads weren't hashed and makes sure that discovery is sent again the next time
+  this->discovery_hash_ = skip_possible ? 2166136261UL : 0;
+  // start with the first batch right away
+  this->last_discovery_ = millis() - this->discovery_interval_;
+}
+void MQTTClientComponent::process_discovery_() {
+  if (this->discovery_phase_ == DiscoveryPhase::IDLE)
+    return;
+  const uint32_t now = millis();
+  if (now - this->last_discovery_ < this->discovery_interval_)
+    return;
+  this->last_discovery_ = now;
 
-  bool do_wildcards = is_normal || past_separator;
+  for (uint8_t i = 0; i < this->discovery_batch_size_; i++) {
+    if (!this->publish_queue_.empty())
+      // the TCP send buffer is full, wait for the queue to drain first
+      return;
 
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
+    if (this->discovery_index_ >= this->children_.size()) {
+      this->discovery_index_ = 0;
+      uint32_t saved_hash;
+      if (this->discovery_phase_ == DiscoveryPhase::HASH) {
+        if (this->discovery_pref_.load(&saved_hash) && saved_hash == this->discovery_hash_) {
+          ESP_LOGD(TAG, "Discovery messages are unchanged, only sending states");
+          this->discovery_phase_ = DiscoveryPhase::STATES;
+        } else {
+          this->discovery_phase_ = DiscoveryPhase::PUBLISH;
+        }
+        continue;
+      }
+      if (this->discovery_phase_ == DiscoveryPhase::PUBLISH && this->discovery_skip_unchanged_ &&
+          (!this->discovery_pref_.load(&saved_hash) || saved_hash != this->discovery_hash_))
+        this->discovery_pref_.save(&this->discovery_hash_);
+      ESP_LOGV(TAG, "Discovery and initial states sent");
+      this->discovery_phase_ = DiscoveryPhase::IDLE;
+      return;
     }
-    // after this, both pointers will point to a '/' or to the end of the string
 
-    return topic_match(message, subscription, is_normal, true);
+    MQTTComponent *component = this->children_[this->discovery_index_];
+    if (this->discovery_phase_ == DiscoveryPhase::HASH) {
+      if (component->is_discovery_enabled())
+        this->discovery_hash_ = (this->discovery_hash_ * 16777619UL) ^ component->get_discovery_hash_();
+    } else {
+      if (this->discovery_phase_ == DiscoveryPhase::PUBLISH && component->is_discovery_enabled() &&
+          !component->send_discovery_())
+        // try again with the next batch
+        return;
+#ifdef USE_DUAL_CORE
+      // the states are read in the loop task, which keeps changing them
+      this->pending_initial_states_++;
+      App.run_in_loop([this, component]() {
+        if (!component->send_initial_state())
+          component->schedule_resend_state();
+        this->pending_initial_states_--;
+      });
+#else
+      if (!component->send_initial_state())
+        component->schedule_resend_state();
+#endif
+    }
+    this->discovery_index_++;
   }
+}
 
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
+bool MQTTClientComponent::states_delivered() {
+  if (!this->is_connected() || this->discovery_phase_ != DiscoveryPhase::IDLE || !this->publish_queue_.empty())
+    return false;
+#ifdef USE_DUAL_CORE
+  if (this->pending_initial_states_ != 0)
+    return false;
+#endif
+  for (auto *component : this->children_) {
+    if (component->resend_state_)
+      return false;
   }
+  if (this->birth_message_.topic.empty())
+    return true;
 
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
+  if (this->delivery_packet_id_ == 0) {
+    // TCP keeps the order, the PUBACK of this message means that everything sent before it arrived too
+    const MQTTMessage &message = this->birth_message_;
+    this->delivery_packet_id_ = this->mqtt_client_.publish(message.topic.c_str(), 1, message.retain,
+                                                           message.payload.data(), message.payload.size());
     return false;
+  }
+  return this->delivery_acked_;
+}
 
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
+bool MQTTClientComponent::publish(const MQTTMessage &message) {
+  return this->publish(message.topic, message.payload, message.qos, message.retain);
+}
+bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
+                                       bool retain) {
+#ifdef USE_DUAL_CORE
+  if (App.is_network_task_running() && App.is_loop_task()) {
+    // f reads the entity, which only the loop task may do; the global JSON buffer belongs to the network task
+    return this->publish(topic, json::build_json_unshared(f), qos, retain);
+  }
+#endif
+  size_t len;
+  const char *message = json::build_json(f, &len);
+  return this->publish(topic, message, len, qos, retain);
+}
 
-  return topic_match(message, subscription, is_normal, past_separator);
+static bool level_less(const std::string &level, const char *other, size_t other_length) {
+  const int cmp = memcmp(level.data(), other, std::min(level.size(), other_length));
+  return cmp < 0 || (cmp == 0 && level.size() < other_length);
 }
 
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+MQTTSubscriptionTrie::Node *MQTTSubscriptionTrie::Node::find_child(const char *level, size_t length) const {
+  auto it = std::lower_bound(this->children.begin(), this->children.end(), length,
+                             [level](const std::unique_ptr<Node> &child, size_t other_length) {
+                               return level_less(child->level, level, other_length);
+                             });
+  if (it == this->children.end() || (*it)->level.size() != length || memcmp((*it)->level.data(), level, length) != 0)
+    return nullptr;
+  return it->get();
+}
+MQTTSubscriptionTrie::Node *MQTTSubscriptionTrie::Node::get_or_add_child(const std::string &level) {
+  if (level == "+") {
+    if (!this->single_level)
+      this->single_level.reset(new Node());
+    return this->single_level.get();
+  }
+  Node *child = this->find_child(level.data(), level.size());
+  if (child != nullptr)
+    return child;
+  auto it = std::lower_bound(this->children.begin(), this->children.end(), level,
+                             [](const std::unique_ptr<Node> &child, const std::string &other) {
+                               return level_less(child->level, other.data(), other.size());
+                             });
+  child = new Node();
+  child->level = level;
+  this->children.insert(it, std::unique_ptr<Node>(child));
+  return child;
+}
+
+void MQTTSubscriptionTrie::add(const std::string &topic, size_t index) {
+  Node *node = &this->root_;
+  size_t start = 0;
+  while (true) {
+    size_t end = topic.find('/', start);
+    std::string level = topic.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    if (level == "#") {
+      // MQTT mandates that this must be the last level
+      node->multi_level.push_back(index);
+      return;
+    }
+    node = node->get_or_add_child(level);
+    if (end == std::string::npos)
+      break;
+    start = end + 1;
+  }
+  node->subscriptions.push_back(index);
+}
+
+void MQTTSubscriptionTrie::find(const std::string &topic, std::vector<size_t> &matches) const {
+  this->find_(&this->root_, topic.c_str(), true, matches);
+}
+
+void MQTTSubscriptionTrie::find_(const Node *node, const char *level, bool first_level,
+                                 std::vector<size_t> &matches) const {
+  // wildcards at the first level don't match topics beginning with a '$', like $SYS/...
+  const bool wildcards = !first_level || *level != '$';
+  if (wildcards)
+    matches.insert(matches.end(), node->multi_level.begin(), node->multi_level.end());
+
+  const char *end = strchr(level, '/');
+  const size_t length = end == nullptr ? strlen(level) : end - level;
+  const Node *candidates[2] = {node->find_child(level, length), wildcards ? node->single_level.get() : nullptr};
+  for (const Node *child : candidates) {
+    if (child == nullptr)
+      continue;
+    if (end == nullptr) {
+      matches.insert(matches.end(), child->subscriptions.begin(), child->subscriptions.end());
+      // "a/#" also matches "a"
+      matches.insert(matches.end(), child->multi_level.begin(), child->multi_level.end());
+    } else {
+      this->find_(child, end + 1, false, matches);
+    }
+  }
 }
 
 void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
+  network_mark_activity();
 #ifdef ARDUINO_ARCH_ESP8266
   // on ESP8266, this is called in LWiP thread; some components do not like running
   // in an ISR.
   this->defer([this, topic, payload]() {
 #endif
-    for (auto &subscription : this->subscriptions_)
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
+    std::vector<size_t> matches;
+    this->subscription_trie_.find(topic, matches);
+    // keep calling the callbacks in the order they were subscribed
+    std::sort(matches.begin(), matches.end());
+    // callbacks may subscribe to new topics, so don't hold references into subscriptions_
+    for (size_t index : matches)
+      this->subscriptions_[index].callback(topic, payload);
 #ifdef ARDUINO_ARCH_ESP8266
   });
 #endif
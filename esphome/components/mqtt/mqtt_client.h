@@ -4,8 +4,13 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/json/json_util.h"
 #include <AsyncMqttClient.h>
+#include <memory>
+#ifdef USE_DUAL_CORE
+#include <atomic>
+#endif
 #include "lwip/ip_addr.h"
 
 namespace esphome {
@@ -22,7 +27,7 @@ using mqtt_json_callback_t = std::function<void(const std::string &, JsonObject
 struct MQTTMessage {
   std::string topic;
   std::string payload;
-  uint8_t qos;  ///< QoS. Only for last will testaments.
+  uint8_t qos;
   bool retain;
 };
 
@@ -35,6 +40,39 @@ struct MQTTSubscription {
   uint32_t resubscribe_timeout;
 };
 
+/** Internal prefix tree of the subscription topics, one level per node.
+ *
+ * Finding the subscriptions that match a message topic only walks the levels of the topic instead of matching it
+ * against every subscription.
+ */
+class MQTTSubscriptionTrie {
+ public:
+  /// Add the subscription with the given index, the topic may contain '+' and '#' wildcards.
+  void add(const std::string &topic, size_t index);
+  /// Append the indices of all subscriptions matching the message topic to matches, in no particular order.
+  void find(const std::string &topic, std::vector<size_t> &matches) const;
+
+ protected:
+  struct Node {
+    std::string level;
+    /// The children for normal levels, sorted by level.
+    std::vector<std::unique_ptr<Node>> children;
+    /// The child for the '+' single level wildcard.
+    std::unique_ptr<Node> single_level;
+    /// Subscriptions ending with a '#' multi level wildcard below this node.
+    std::vector<size_t> multi_level;
+    /// Subscriptions ending at this node.
+    std::vector<size_t> subscriptions;
+
+    Node *find_child(const char *level, size_t length) const;
+    Node *get_or_add_child(const std::string &level);
+  };
+
+  void find_(const Node *node, const char *level, bool first_level, std::vector<size_t> &matches) const;
+
+  Node root_;
+};
+
 /// internal struct for MQTT credentials.
 struct MQTTCredentials {
   std::string address;  ///< The address of the server without port number
@@ -102,6 +140,19 @@ class MQTTClientComponent : public Component {
   /// Globally disable Home Assistant discovery.
   void disable_discovery();
   bool is_discovery_enabled() const;
+  /** Set how fast discovery messages and initial states are sent after connecting.
+   *
+   * @param discovery_interval The time between two batches in ms.
+   * @param discovery_batch_size The number of components handled per batch.
+   */
+  void set_discovery_pacing(uint32_t discovery_interval, uint8_t discovery_batch_size) {
+    this->discovery_interval_ = discovery_interval;
+    this->discovery_batch_size_ = discovery_batch_size;
+  }
+  /// Skip publishing retained discovery messages if they didn't change since they were last sent.
+  void set_discovery_skip_unchanged(bool discovery_skip_unchanged) {
+    this->discovery_skip_unchanged_ = discovery_skip_unchanged;
+  }
 
 #if ASYNC_TCP_SSL_ENABLED
   /** Add a SSL fingerprint to use for TCP SSL connections to the MQTT broker.
@@ -191,6 +242,7 @@ class MQTTClientComponent : public Component {
   void loop() override;
   /// MQTT client setup priority
   float get_setup_priority() const override;
+  ComponentAffinity get_affinity() const override { return COMPONENT_AFFINITY_NETWORK; }
 
   void on_message(const std::string &topic, const std::string &payload);
 
@@ -200,8 +252,26 @@ class MQTTClientComponent : public Component {
 
   void set_reboot_timeout(uint32_t reboot_timeout);
 
+  /** Set how many messages are queued when the TCP send buffer is full, 0 disables the queue.
+   *
+   * Queued QoS 0 messages to the same topic are coalesced, only the latest payload is sent.
+   */
+  void set_publish_queue_size(uint8_t publish_queue_size) { this->publish_queue_size_ = publish_queue_size; }
+  /// The number of messages waiting in the publish queue.
+  size_t get_publish_queue_depth() const { return this->publish_queue_.size(); }
+  /// The number of messages that were dropped because the publish queue was full.
+  uint32_t get_publish_queue_drops() const { return this->publish_queue_drops_; }
+
   void register_mqtt_component(MQTTComponent *component);
 
+  /** Whether all states published so far have arrived at the broker.
+   *
+   * Once discovery and all states are handed to the TCP stack, the birth message is published again with QoS 1,
+   * its PUBACK confirms that everything before it was received. Without a birth message, this only waits until
+   * nothing is queued anymore.
+   */
+  bool states_delivered();
+
   bool is_connected();
 
   void on_shutdown() override;
@@ -226,6 +296,17 @@ class MQTTClientComponent : public Component {
   /// Re-calculate the availability property.
   void recalculate_availability_();
 
+  /// Queue a message that couldn't be sent right away.
+  bool enqueue_publish_(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
+                        bool retain);
+  /// Send queued messages until the TCP send buffer is full again.
+  void drain_publish_queue_();
+
+  /// Restart sending discovery messages and initial states of all components.
+  void start_discovery_();
+  /// Handle the next batch of components for discovery, called from loop() while connected.
+  void process_discovery_();
+
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
@@ -253,6 +334,7 @@ class MQTTClientComponent : public Component {
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  MQTTSubscriptionTrie subscription_trie_;
   AsyncMqttClient mqtt_client_;
   MQTTClientState state_{MQTT_CLIENT_DISCONNECTED};
   IPAddress ip_;
@@ -263,6 +345,37 @@ class MQTTClientComponent : public Component {
   uint32_t connect_begin_;
   uint32_t last_connected_{0};
   optional<AsyncMqttClientDisconnectReason> disconnect_reason_{};
+  /// Messages waiting for space in the TCP send buffer, oldest first.
+  std::vector<MQTTMessage> publish_queue_;
+  uint8_t publish_queue_size_{16};
+  uint32_t publish_queue_drops_{0};
+
+  /** Discovery is sent one batch of components at a time so that reconnecting doesn't block the loop.
+   *
+   * With discovery_skip_unchanged_ the payloads are first only hashed, if the hash matches the one saved after the
+   * last complete publish the retained discovery messages on the broker are still up to date and only the states are
+   * sent.
+   */
+  enum class DiscoveryPhase {
+    IDLE,
+    HASH,
+    PUBLISH,
+    STATES,
+  } discovery_phase_{DiscoveryPhase::IDLE};
+  size_t discovery_index_{0};
+  uint32_t discovery_hash_{0};
+  uint32_t last_discovery_{0};
+  uint32_t discovery_interval_{50};
+  uint8_t discovery_batch_size_{1};
+  bool discovery_skip_unchanged_{true};
+#ifdef USE_DUAL_CORE
+  /// Initial states handed to the loop task that haven't been published yet.
+  std::atomic<uint32_t> pending_initial_states_{0};
+#endif
+  ESPPreferenceObject discovery_pref_;
+  /// Packet id of the QoS 1 message sent by states_delivered(), 0 if none is in flight.
+  uint16_t delivery_packet_id_{0};
+  bool delivery_acked_{false};
 };
 
 extern MQTTClientComponent *global_mqtt_client;
@@ -22,16 +22,20 @@ std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) con
          "/" + suffix;
 }
 
-const std::string MQTTComponent::get_state_topic_() const {
-  if (this->custom_state_topic_.empty())
-    return this->get_default_topic_for_("state");
-  return this->custom_state_topic_;
+const std::string &MQTTComponent::get_state_topic_() const {
+  if (!this->custom_state_topic_.empty())
+    return this->custom_state_topic_;
+  if (this->default_state_topic_.empty())
+    this->default_state_topic_ = this->get_default_topic_for_("state");
+  return this->default_state_topic_;
 }
 
-const std::string MQTTComponent::get_command_topic_() const {
-  if (this->custom_command_topic_.empty())
-    return this->get_default_topic_for_("command");
-  return this->custom_command_topic_;
+const std::string &MQTTComponent::get_command_topic_() const {
+  if (!this->custom_command_topic_.empty())
+    return this->custom_command_topic_;
+  if (this->default_command_topic_.empty())
+    this->default_command_topic_ = this->get_default_topic_for_("command");
+  return this->default_command_topic_;
 }
 
 bool MQTTComponent::publish(const std::string &topic, const std::string &payload) {
@@ -57,57 +61,64 @@ bool MQTTComponent::send_discovery_() {
   ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
 
   return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
-      [this](JsonObject &root) {
-        SendDiscoveryConfig config;
-        config.state_topic = true;
-        config.command_topic = true;
-
-        this->send_discovery(root, config);
-
-        std::string name = this->friendly_name();
-        root["name"] = name;
-        if (config.state_topic)
-          root["state_topic"] = this->get_state_topic_();
-        if (config.command_topic)
-          root["command_topic"] = this->get_command_topic_();
-
-        if (this->availability_ == nullptr) {
-          if (!global_mqtt_client->get_availability().topic.empty()) {
-            root["availability_topic"] = global_mqtt_client->get_availability().topic;
-            if (global_mqtt_client->get_availability().payload_available != "online")
-              root["payload_available"] = global_mqtt_client->get_availability().payload_available;
-            if (global_mqtt_client->get_availability().payload_not_available != "offline")
-              root["payload_not_available"] = global_mqtt_client->get_availability().payload_not_available;
-          }
-        } else if (!this->availability_->topic.empty()) {
-          root["availability_topic"] = this->availability_->topic;
-          if (this->availability_->payload_available != "online")
-            root["payload_available"] = this->availability_->payload_available;
-          if (this->availability_->payload_not_available != "offline")
-            root["payload_not_available"] = this->availability_->payload_not_available;
-        }
-
-        const std::string &node_name = App.get_name();
-        std::string unique_id = this->unique_id();
-        if (!unique_id.empty()) {
-          root["unique_id"] = unique_id;
-        } else {
-          // default to almost-unique ID. It's a hack but the only way to get that
-          // gorgeous device registry view.
-          root["unique_id"] = "ESP" + this->component_type() + this->get_default_object_id_();
-        }
-
-        JsonObject &device_info = root.createNestedObject("device");
-        device_info["identifiers"] = get_mac_address();
-        device_info["name"] = node_name;
-        device_info["sw_version"] = "esphome v" ESPHOME_VERSION " " + App.get_compilation_time();
+      this->get_discovery_topic_(discovery_info), [this](JsonObject &root) { this->build_discovery_(root); }, 0,
+      discovery_info.retain);
+}
+
+uint32_t MQTTComponent::get_discovery_hash_() {
+  const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
+  std::string payload = json::build_json([this](JsonObject &root) { this->build_discovery_(root); });
+  return fnv1_hash(this->get_discovery_topic_(discovery_info) + payload);
+}
+
+void MQTTComponent::build_discovery_(JsonObject &root) {
+  SendDiscoveryConfig config;
+  config.state_topic = true;
+  config.command_topic = true;
+
+  this->send_discovery(root, config);
+
+  std::string name = this->friendly_name();
+  root["name"] = name;
+  if (config.state_topic)
+    root["state_topic"] = this->get_state_topic_();
+  if (config.command_topic)
+    root["command_topic"] = this->get_command_topic_();
+
+  if (this->availability_ == nullptr) {
+    if (!global_mqtt_client->get_availability().topic.empty()) {
+      root["availability_topic"] = global_mqtt_client->get_availability().topic;
+      if (global_mqtt_client->get_availability().payload_available != "online")
+        root["payload_available"] = global_mqtt_client->get_availability().payload_available;
+      if (global_mqtt_client->get_availability().payload_not_available != "offline")
+        root["payload_not_available"] = global_mqtt_client->get_availability().payload_not_available;
+    }
+  } else if (!this->availability_->topic.empty()) {
+    root["availability_topic"] = this->availability_->topic;
+    if (this->availability_->payload_available != "online")
+      root["payload_available"] = this->availability_->payload_available;
+    if (this->availability_->payload_not_available != "offline")
+      root["payload_not_available"] = this->availability_->payload_not_available;
+  }
+
+  const std::string &node_name = App.get_name();
+  std::string unique_id = this->unique_id();
+  if (!unique_id.empty()) {
+    root["unique_id"] = unique_id;
+  } else {
+    // default to almost-unique ID. It's a hack but the only way to get that
+    // gorgeous device registry view.
+    root["unique_id"] = "ESP" + this->component_type() + this->get_default_object_id_();
+  }
+
+  JsonObject &device_info = root.createNestedObject("device");
+  device_info["identifiers"] = get_mac_address();
+  device_info["name"] = node_name;
+  device_info["sw_version"] = "esphome v" ESPHOME_VERSION " " + App.get_compilation_time();
 #ifdef ARDUINO_BOARD
-        device_info["model"] = ARDUINO_BOARD;
+  device_info["model"] = ARDUINO_BOARD;
 #endif
-        device_info["manufacturer"] = "espressif";
-      },
-      0, discovery_info.retain);
+  device_info["manufacturer"] = "espressif";
 }
 
 bool MQTTComponent::get_retain() const { return this->retain_; }
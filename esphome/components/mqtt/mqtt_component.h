@@ -130,6 +130,8 @@ class MQTTComponent : public Component {
   void subscribe_json(const std::string &topic, mqtt_json_callback_t callback, uint8_t qos = 0);
 
  protected:
+  friend class MQTTClientComponent;
+
   /// Helper method to get the discovery topic for this component.
   std::string get_discovery_topic_(const MQTTDiscoveryInfo &discovery_info) const;
 
@@ -151,24 +153,33 @@ class MQTTComponent : public Component {
   virtual std::string unique_id();
 
   /// Get the MQTT topic that new states will be shared to.
-  const std::string get_state_topic_() const;
+  const std::string &get_state_topic_() const;
 
   /// Get the MQTT topic for listening to commands.
-  const std::string get_command_topic_() const;
+  const std::string &get_command_topic_() const;
 
   bool is_connected_() const;
 
   /// Internal method to start sending discovery info, this will call send_discovery().
   bool send_discovery_();
 
+  /// Internal method to get a hash of the discovery topic and payload, to detect if it changed since the last publish.
+  uint32_t get_discovery_hash_();
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Generate the Home Assistant MQTT discovery object id by automatically transforming the friendly name.
   std::string get_default_object_id_() const;
 
  protected:
+  /// Fill the discovery payload, shared by send_discovery_() and get_discovery_hash_().
+  void build_discovery_(JsonObject &root);
+
   std::string custom_state_topic_{};
   std::string custom_command_topic_{};
+  /// The default topics are built on first use, publishing a state shouldn't allocate a new topic every time.
+  mutable std::string default_state_topic_{};
+  mutable std::string default_command_topic_{};
   bool retain_{true};
   bool discovery_enabled_{true};
   Availability *availability_{nullptr};
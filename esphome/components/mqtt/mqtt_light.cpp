@@ -13,8 +13,14 @@ using namespace esphome::light;
 std::string MQTTJSONLightComponent::component_type() const { return "light"; }
 
 void MQTTJSONLightComponent::setup() {
-  this->subscribe_json(this->get_command_topic_(), [this](const std::string &topic, JsonObject &root) {
-    this->state_->make_call().parse_json(root).perform();
+  // commands are read straight from the payload, scenes can set many lights at once
+  this->subscribe(this->get_command_topic_(), [this](const std::string &topic, const std::string &payload) {
+    auto call = this->state_->make_call();
+    if (call.parse_json(payload.data(), payload.size())) {
+      call.perform();
+    } else {
+      ESP_LOGW(TAG, "Invalid JSON command '%s'", payload.c_str());
+    }
   });
 
   auto f = std::bind(&MQTTJSONLightComponent::publish_state_, this);
@@ -0,0 +1,28 @@
+#include "mqtt_queue_sensor.h"
+
+#ifdef USE_SENSOR
+
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace mqtt {
+
+static const char *TAG = "mqtt.queue_sensor";
+
+void MQTTQueueSensor::update() {
+  if (this->publish_queue_depth_sensor_ != nullptr)
+    this->publish_queue_depth_sensor_->publish_state(this->parent_->get_publish_queue_depth());
+  if (this->publish_queue_drops_sensor_ != nullptr)
+    this->publish_queue_drops_sensor_->publish_state(this->parent_->get_publish_queue_drops());
+}
+void MQTTQueueSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "MQTT Queue Sensor:");
+  LOG_SENSOR("  ", "Publish Queue Depth", this->publish_queue_depth_sensor_);
+  LOG_SENSOR("  ", "Publish Queue Drops", this->publish_queue_drops_sensor_);
+}
+float MQTTQueueSensor::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SENSOR
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "mqtt_client.h"
+
+namespace esphome {
+namespace mqtt {
+
+/// Reports the state of the MQTT publish queue, useful to tune publish_queue_size.
+class MQTTQueueSensor : public PollingComponent {
+ public:
+  explicit MQTTQueueSensor(MQTTClientComponent *parent) : parent_(parent) {}
+
+  void set_publish_queue_depth_sensor(sensor::Sensor *publish_queue_depth_sensor) {
+    publish_queue_depth_sensor_ = publish_queue_depth_sensor;
+  }
+  void set_publish_queue_drops_sensor(sensor::Sensor *publish_queue_drops_sensor) {
+    publish_queue_drops_sensor_ = publish_queue_drops_sensor;
+  }
+
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+ protected:
+  MQTTClientComponent *parent_;
+  sensor::Sensor *publish_queue_depth_sensor_{nullptr};
+  sensor::Sensor *publish_queue_drops_sensor_{nullptr};
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif
@@ -17,7 +17,14 @@ using namespace esphome::sensor;
 MQTTSensorComponent::MQTTSensorComponent(Sensor *sensor) : MQTTComponent(), sensor_(sensor) {}
 
 void MQTTSensorComponent::setup() {
-  this->sensor_->add_on_state_callback([this](float state) { this->publish_state(state); });
+#ifdef USE_STATE_TRACE
+  this->sensor_->add_on_report_callback([this](float state) {
+    global_state_tracer.record_current(STATE_TRACE_CONTROLLER);
+    this->publish_state(state);
+  });
+#else
+  this->sensor_->add_on_report_callback([this](float state) { this->publish_state(state); });
+#endif
 }
 
 void MQTTSensorComponent::dump_config() {
@@ -39,6 +46,10 @@ uint32_t MQTTSensorComponent::get_expire_after() const {
       return 0;
     }
 #endif
+    if (this->sensor_->get_report_policy() != nullptr) {
+      // states within the deadbands are only sent again with max_interval
+      return this->sensor_->get_report_policy()->get_max_interval() * 5;
+    }
     return this->sensor_->calculate_expected_filter_update_interval() * 5;
   }
 }
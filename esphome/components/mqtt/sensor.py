@@ -0,0 +1,33 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID, ICON_COUNTER, UNIT_EMPTY
+from . import MQTTClientComponent, mqtt_ns
+
+DEPENDENCIES = ['mqtt']
+
+CONF_MQTT_ID = 'mqtt_id'
+CONF_PUBLISH_QUEUE_DEPTH = 'publish_queue_depth'
+CONF_PUBLISH_QUEUE_DROPS = 'publish_queue_drops'
+
+MQTTQueueSensor = mqtt_ns.class_('MQTTQueueSensor', cg.PollingComponent)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(MQTTQueueSensor),
+    cv.GenerateID(CONF_MQTT_ID): cv.use_id(MQTTClientComponent),
+    cv.Optional(CONF_PUBLISH_QUEUE_DEPTH): sensor.sensor_schema(UNIT_EMPTY, ICON_COUNTER, 0),
+    cv.Optional(CONF_PUBLISH_QUEUE_DROPS): sensor.sensor_schema(UNIT_EMPTY, ICON_COUNTER, 0),
+}).extend(cv.polling_component_schema('60s'))
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_MQTT_ID])
+    var = cg.new_Pvariable(config[CONF_ID], parent)
+    yield cg.register_component(var, config)
+
+    if CONF_PUBLISH_QUEUE_DEPTH in config:
+        sens = yield sensor.new_sensor(config[CONF_PUBLISH_QUEUE_DEPTH])
+        cg.add(var.set_publish_queue_depth_sensor(sens))
+    if CONF_PUBLISH_QUEUE_DROPS in config:
+        sens = yield sensor.new_sensor(config[CONF_PUBLISH_QUEUE_DROPS])
+        cg.add(var.set_publish_queue_drops_sensor(sens))
@@ -3,7 +3,8 @@ import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import light
 from esphome.const import CONF_CLOCK_PIN, CONF_DATA_PIN, CONF_METHOD, CONF_NUM_LEDS, CONF_PIN, \
-    CONF_TYPE, CONF_VARIANT, CONF_OUTPUT_ID, CONF_INVERT
+    CONF_TYPE, CONF_VARIANT, CONF_OUTPUT_ID, CONF_INVERT, CONF_DOUBLE_BUFFERED, CONF_FRAME_RATE, \
+    CONF_OUTPUT_GROUP
 from esphome.core import CORE
 
 neopixelbus_ns = cg.esphome_ns.namespace('neopixelbus')
@@ -158,7 +159,11 @@ CONFIG_SCHEMA = cv.All(light.ADDRESSABLE_LIGHT_SCHEMA.extend({
     cv.Optional(CONF_DATA_PIN): pins.output_pin,
 
     cv.Required(CONF_NUM_LEDS): cv.positive_not_null_int,
-}).extend(cv.COMPONENT_SCHEMA), validate, validate_method_pin)
+    cv.Optional(CONF_FRAME_RATE): cv.int_range(min=1, max=1000),
+    cv.Optional(CONF_DOUBLE_BUFFERED): cv.All(cv.only_on_esp32, cv.boolean),
+    cv.Optional(CONF_OUTPUT_GROUP): cv.use_id(light.AddressableOutputGroup),
+}).extend(cv.COMPONENT_SCHEMA), validate, validate_method_pin,
+                       cv.has_at_most_one_key(CONF_DOUBLE_BUFFERED, CONF_OUTPUT_GROUP))
 
 
 def to_code(config):
@@ -179,6 +184,13 @@ def to_code(config):
         cg.add(var.add_leds(config[CONF_NUM_LEDS], config[CONF_CLOCK_PIN], config[CONF_DATA_PIN]))
 
     cg.add(var.set_pixel_order(getattr(ESPNeoPixelOrder, config[CONF_TYPE])))
+    if CONF_FRAME_RATE in config:
+        cg.add(var.set_frame_rate(config[CONF_FRAME_RATE]))
+    if CONF_DOUBLE_BUFFERED in config:
+        cg.add(var.set_double_buffered(config[CONF_DOUBLE_BUFFERED]))
+    if CONF_OUTPUT_GROUP in config:
+        group = yield cg.get_variable(config[CONF_OUTPUT_GROUP])
+        cg.add(var.set_output_group(group))
 
     # https://github.com/Makuna/NeoPixelBus/blob/master/library.json
     cg.add_library('NeoPixelBus-esphome', '2.5.7')
@@ -70,23 +70,61 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
     this->controller_->Begin();
   }
 
+#ifdef ARDUINO_ARCH_ESP32
+  /// Render into a back buffer and send frames from a separate task, so that the main loop doesn't wait for Show().
+  void set_double_buffered(bool double_buffered) { this->double_buffered_ = double_buffered; }
+#endif
+  /// Send frames together with the other lights of the group instead of on its own.
+  void set_output_group(light::AddressableOutputGroup *output_group) {
+    this->output_group_ = output_group;
+    // Show() skips lights that aren't dirty, those without a new frame aren't sent again
+    output_group->add_member([this]() { this->controller_->Show(); });
+  }
+
   // ========== INTERNAL METHODS ==========
   void setup() override {
+#ifdef ARDUINO_ARCH_ESP32
+    if (this->double_buffered_) {
+      this->back_buffer_ = alloc_large<uint8_t>(this->controller_->PixelsSize(), this->buffer_location_);
+      this->output_task_.start([this]() { this->controller_->Show(); });
+    }
+#endif
     for (int i = 0; i < this->size(); i++) {
       (*this)[i] = light::ESPColor(0, 0, 0, 0);
     }
 
-    this->effect_data_ = new uint8_t[this->size()];
+    this->effect_data_ = alloc_large<uint8_t>(this->size(), this->buffer_location_);
     this->controller_->Begin();
   }
 
   void loop() override {
     if (!this->should_show_())
       return;
+    if (!this->frame_pacer_.frame_due(micros(), this->renders_every_loop_()))
+      return;
+
+#ifdef ARDUINO_ARCH_ESP32
+    if (this->back_buffer_ != nullptr) {
+      if (this->output_task_.is_busy()) {
+        // the previous frame is still being sent, try again with the next frame
+        this->frame_pacer_.frame_dropped();
+        return;
+      }
+      this->mark_shown_();
+      memcpy(this->controller_->Pixels(), this->back_buffer_, this->controller_->PixelsSize());
+      this->controller_->Dirty();
+      this->output_task_.send_frame();
+      return;
+    }
+#endif
 
     this->mark_shown_();
     this->controller_->Dirty();
 
+    if (this->output_group_ != nullptr) {
+      this->output_group_->frame_ready();
+      return;
+    }
     this->controller_->Show();
   }
 
@@ -103,8 +141,17 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
   }
 
  protected:
+  /// The buffer effects render into, the back buffer if double buffered.
+  uint8_t *pixels_() const { return this->back_buffer_ != nullptr ? this->back_buffer_ : this->controller_->Pixels(); }
+
   NeoPixelBus<T_COLOR_FEATURE, T_METHOD> *controller_{nullptr};
   uint8_t *effect_data_{nullptr};
+  uint8_t *back_buffer_{nullptr};
+  light::AddressableOutputGroup *output_group_{nullptr};
+#ifdef ARDUINO_ARCH_ESP32
+  bool double_buffered_{false};
+  light::AddressableOutputTask output_task_;
+#endif
   uint8_t rgb_offsets_[4]{0, 1, 2, 3};
 };
 
@@ -120,10 +167,19 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {  // NOLINT
-    uint8_t *base = this->controller_->Pixels() + 3ULL * index;
+    uint8_t *base = this->pixels_() + 3ULL * index;
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  bool get_raw_pixels_(light::AddressableLight::RawPixels *raw) const override {  // NOLINT
+    raw->data = this->pixels_();
+    raw->stride = 3;
+    raw->red = this->rgb_offsets_[0];
+    raw->green = this->rgb_offsets_[1];
+    raw->blue = this->rgb_offsets_[2];
+    raw->white = -1;
+    return true;
+  }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -139,10 +195,19 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override {  // NOLINT
-    uint8_t *base = this->controller_->Pixels() + 4ULL * index;
+    uint8_t *base = this->pixels_() + 4ULL * index;
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  bool get_raw_pixels_(light::AddressableLight::RawPixels *raw) const override {  // NOLINT
+    raw->data = this->pixels_();
+    raw->stride = 4;
+    raw->red = this->rgb_offsets_[0];
+    raw->green = this->rgb_offsets_[1];
+    raw->blue = this->rgb_offsets_[2];
+    raw->white = this->rgb_offsets_[3];
+    return true;
+  }
 };
 
 }  // namespace neopixelbus
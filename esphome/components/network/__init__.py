@@ -1,2 +1,33 @@
-# Dummy package to allow components to depend on network
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_PROFILE
+from esphome.core import CORE
+
 CODEOWNERS = ['@esphome/core']
+
+PROFILE_LOW_MEMORY = 'low_memory'
+PROFILE_THROUGHPUT = 'throughput'
+PROFILE_LOW_LATENCY = 'low_latency'
+
+# The lwIP build of the ESP8266 core for each profile. The low memory build uses an MSS of 536 bytes,
+# which also shrinks the TCP send buffer and window (multiples of the MSS). The TCP settings of the
+# ESP32 are compiled into its SDK, so there only the socket options change.
+ESP8266_LWIP_VARIANTS = {
+    PROFILE_LOW_MEMORY: '-DPIO_FRAMEWORK_ARDUINO_LWIP2_LOW_MEMORY_LOW_FLASH',
+    PROFILE_THROUGHPUT: '-DPIO_FRAMEWORK_ARDUINO_LWIP2_HIGHER_BANDWIDTH_LOW_FLASH',
+    PROFILE_LOW_LATENCY: '-DPIO_FRAMEWORK_ARDUINO_LWIP2_HIGHER_BANDWIDTH_LOW_FLASH',
+}
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.Optional(CONF_PROFILE, default=PROFILE_THROUGHPUT): cv.one_of(*ESP8266_LWIP_VARIANTS, lower=True,
+                                                                     space='_'),
+})
+
+
+def to_code(config):
+    profile = config[CONF_PROFILE]
+    if CORE.is_esp8266:
+        cg.add_build_flag(ESP8266_LWIP_VARIANTS[profile])
+    if profile == PROFILE_LOW_LATENCY:
+        # disable Nagle's algorithm on the API connections
+        cg.add_define('USE_TCP_NODELAY')
@@ -6,9 +6,25 @@ namespace nextion {
 
 static const char *TAG = "nextion";
 
+/// The number of commands that may wait for their acknowledgement at the same time.
+static const uint8_t MAX_ACKS_PENDING = 4;
+/// The number of commands that may be queued before new ones are dropped.
+static const size_t MAX_QUEUED_COMMANDS = 64;
+static const uint32_t ACK_TIMEOUT = 100;
+
+static uint32_t fnv1a_hash(const char *begin, const char *end) {
+  uint32_t hash = 2166136261UL;
+  for (const char *p = begin; p != end; p++) {
+    hash ^= uint8_t(*p);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
 void Nextion::setup() {
   this->send_command_no_ack("");
-  this->send_command_printf("bkcmd=3");
+  // the display only answers with ACKs after this command
+  this->send_command_no_ack("bkcmd=3");
   this->set_backlight_brightness(static_cast<uint8_t>(brightness_ * 100));
   this->goto_page("0");
 }
@@ -17,58 +33,98 @@ void Nextion::update() {
   if (this->writer_.has_value()) {
     (*this->writer_)(*this);
   }
+  if (this->commands_suppressed_ != this->last_logged_suppressed_) {
+    ESP_LOGV(TAG, "Commands sent: %u, suppressed: %u", this->commands_sent_, this->commands_suppressed_);
+    this->last_logged_suppressed_ = this->commands_suppressed_;
+  }
+}
+void Nextion::send_command_no_ack(const char *command) { this->enqueue_command_(command, false); }
+bool Nextion::enqueue_command_(const char *command, bool ack) {
+  if (this->queue_.size() >= MAX_QUEUED_COMMANDS) {
+    ESP_LOGW(TAG, "Command queue full, dropping '%s'", command);
+    // the cached values may describe dropped commands now
+    this->clear_property_cache_();
+    return false;
+  }
+  this->queue_.push_back(QueuedCommand{command, ack && this->wait_for_ack_});
+  return true;
 }
-void Nextion::send_command_no_ack(const char *command) {
-  // Flush RX...
-  this->loop();
+void Nextion::process_queue_() {
+  if (this->acks_pending_ > 0 && millis() - this->last_sent_ > ACK_TIMEOUT) {
+    ESP_LOGW(TAG, "Waiting for ACK timed out!");
+    this->acks_pending_ = 0;
+  }
 
-  this->write_str(command);
-  const uint8_t data[3] = {0xFF, 0xFF, 0xFF};
-  this->write_array(data, sizeof(data));
+  const uint8_t terminator[3] = {0xFF, 0xFF, 0xFF};
+  while (!this->queue_.empty() && this->acks_pending_ < MAX_ACKS_PENDING) {
+    const QueuedCommand &command = this->queue_.front();
+    this->write_str(command.command.c_str());
+    this->write_array(terminator, sizeof(terminator));
+    if (command.ack)
+      this->acks_pending_++;
+    this->last_sent_ = millis();
+    this->commands_sent_++;
+    this->queue_.pop_front();
+  }
 }
+bool Nextion::send_cached_command_printf_(const char *format, ...) {
+  char buffer[256];
+  va_list arg;
+  va_start(arg, format);
+  int ret = vsnprintf(buffer, sizeof(buffer), format, arg);
+  va_end(arg);
+  if (ret <= 0) {
+    ESP_LOGW(TAG, "Building command for format '%s' failed!", format);
+    return false;
+  }
 
-bool Nextion::ack_() {
-  if (!this->wait_for_ack_)
+  const char *end = buffer + strlen(buffer);
+  const char *separator = buffer + strcspn(buffer, "=,");
+  const uint32_t property = fnv1a_hash(buffer, separator);
+  const uint32_t value = fnv1a_hash(separator, end);
+  auto it = this->property_cache_.find(property);
+  if (it != this->property_cache_.end() && it->second == value) {
+    this->commands_suppressed_++;
     return true;
-
-  uint32_t start = millis();
-  while (!this->read_until_ack_()) {
-    if (millis() - start > 100) {
-      ESP_LOGW(TAG, "Waiting for ACK timed out!");
-      return false;
-    }
   }
+  if (!this->enqueue_command_(buffer, true))
+    return false;
+  this->property_cache_[property] = value;
   return true;
 }
 void Nextion::set_component_text(const char *component, const char *text) {
-  this->send_command_printf("%s.txt=\"%s\"", component, text);
+  this->send_cached_command_printf_("%s.txt=\"%s\"", component, text);
 }
 void Nextion::set_component_value(const char *component, int value) {
-  this->send_command_printf("%s.val=%d", component, value);
+  this->send_cached_command_printf_("%s.val=%d", component, value);
 }
 void Nextion::display_picture(int picture_id, int x_start, int y_start) {
   this->send_command_printf("pic %d %d %d", x_start, y_start, picture_id);
 }
 void Nextion::set_component_background_color(const char *component, const char *color) {
-  this->send_command_printf("%s.bco=\"%s\"", component, color);
+  this->send_cached_command_printf_("%s.bco=\"%s\"", component, color);
 }
 void Nextion::set_component_pressed_background_color(const char *component, const char *color) {
-  this->send_command_printf("%s.bco2=\"%s\"", component, color);
+  this->send_cached_command_printf_("%s.bco2=\"%s\"", component, color);
 }
 void Nextion::set_component_font_color(const char *component, const char *color) {
-  this->send_command_printf("%s.pco=\"%s\"", component, color);
+  this->send_cached_command_printf_("%s.pco=\"%s\"", component, color);
 }
 void Nextion::set_component_pressed_font_color(const char *component, const char *color) {
-  this->send_command_printf("%s.pco2=\"%s\"", component, color);
+  this->send_cached_command_printf_("%s.pco2=\"%s\"", component, color);
 }
 void Nextion::set_component_coordinates(const char *component, int x, int y) {
-  this->send_command_printf("%s.xcen=%d", component, x);
-  this->send_command_printf("%s.ycen=%d", component, y);
+  this->send_cached_command_printf_("%s.xcen=%d", component, x);
+  this->send_cached_command_printf_("%s.ycen=%d", component, y);
 }
 void Nextion::set_component_font(const char *component, uint8_t font_id) {
-  this->send_command_printf("%s.font=%d", component, font_id);
+  this->send_cached_command_printf_("%s.font=%d", component, font_id);
+}
+void Nextion::goto_page(const char *page) {
+  // the display resets the components of the new page to their initial values
+  this->clear_property_cache_();
+  this->send_command_printf("page %s", page);
 }
-void Nextion::goto_page(const char *page) { this->send_command_printf("page %s", page); }
 bool Nextion::send_command_printf(const char *format, ...) {
   char buffer[256];
   va_list arg;
@@ -79,18 +135,16 @@ bool Nextion::send_command_printf(const char *format, ...) {
     ESP_LOGW(TAG, "Building command for format '%s' failed!", format);
     return false;
   }
-  this->send_command_no_ack(buffer);
-  if (!this->ack_()) {
-    ESP_LOGW(TAG, "Sending command '%s' failed because no ACK was received", buffer);
-    return false;
-  }
-
-  return true;
+  return this->enqueue_command_(buffer, true);
+}
+void Nextion::hide_component(const char *component) { this->send_cached_command_printf_("vis %s,0", component); }
+void Nextion::show_component(const char *component) { this->send_cached_command_printf_("vis %s,1", component); }
+void Nextion::enable_component_touch(const char *component) {
+  this->send_cached_command_printf_("tsw %s,1", component);
+}
+void Nextion::disable_component_touch(const char *component) {
+  this->send_cached_command_printf_("tsw %s,0", component);
 }
-void Nextion::hide_component(const char *component) { this->send_command_printf("vis %s,0", component); }
-void Nextion::show_component(const char *component) { this->send_command_printf("vis %s,1", component); }
-void Nextion::enable_component_touch(const char *component) { this->send_command_printf("tsw %s,1", component); }
-void Nextion::disable_component_touch(const char *component) { this->send_command_printf("tsw %s,0", component); }
 void Nextion::add_waveform_data(int component_id, uint8_t channel_number, uint8_t value) {
   this->send_command_printf("add %d,%u,%u", component_id, channel_number, value);
 }
@@ -148,6 +202,14 @@ bool Nextion::read_until_ack_() {
 
     data_length -= 3;  // remove filler bytes
 
+    // every command is answered with either an ACK or an error
+    if (event <= 0x23 && this->acks_pending_ > 0)
+      this->acks_pending_--;
+    if (event != 0x01 && event <= 0x23) {
+      // a failed command may have been one of the cached ones
+      this->clear_property_cache_();
+    }
+
     bool invalid_data_length = false;
     switch (event) {
       case 0x01:  // successful execution of instruction (ACK)
@@ -207,6 +269,8 @@ bool Nextion::read_until_ack_() {
         uint8_t touch_event = data[2];  // 0 -> release, 1 -> press
         ESP_LOGD(TAG, "Got touch page=%u component=%u type=%s", page_id, component_id,
                  touch_event ? "PRESS" : "RELEASE");
+        // touch events of the HMI may have switched the page or changed component values
+        this->clear_property_cache_();
         for (auto *touch : this->touch_) {
           touch->process(page_id, component_id, touch_event);
         }
@@ -225,11 +289,14 @@ bool Nextion::read_until_ack_() {
         break;
       }
       case 0x66:  // sendme page id
+      case 0x88:  // system successful start up
+        // the page changed or the display was reset, the components show their initial values again
+        this->clear_property_cache_();
+        break;
       case 0x70:  // string variable data return
       case 0x71:  // numeric variable data return
       case 0x86:  // device automatically enters into sleep mode
       case 0x87:  // device automatically wakes up
-      case 0x88:  // system successful start up
       case 0x89:  // start SD card upgrade
       case 0xFD:  // data transparent transmit finished
       case 0xFE:  // data transparent transmit ready
@@ -249,6 +316,7 @@ void Nextion::loop() {
   while (this->available() >= 4) {
     this->read_until_ack_();
   }
+  this->process_queue_();
 }
 #ifdef USE_TIME
 void Nextion::set_nextion_rtc_time(time::ESPTime time) {
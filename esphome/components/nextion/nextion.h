@@ -5,6 +5,9 @@
 #include "esphome/components/uart/uart.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 
+#include <deque>
+#include <map>
+
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
 #endif
@@ -74,7 +77,7 @@ class Nextion : public PollingComponent, public uart::UARTDevice {
    * This will change the image of the component `pic` to the image with ID `4`.
    */
   void set_component_picture(const char *component, const char *picture) {
-    this->send_command_printf("%s.val=%s", component, picture);
+    this->send_cached_command_printf_("%s.val=%s", component, picture);
   }
   /**
    * Set the background color of a component.
@@ -378,22 +381,52 @@ class Nextion : public PollingComponent, public uart::UARTDevice {
   void send_command_no_ack(const char *command);
   /**
    * Manually send a raw formatted command to the display.
+   *
+   * Commands are queued and sent from loop(), raw commands are never suppressed by the property cache.
    * @param format The printf-style command format, like "vis %s,0"
    * @param ... The format arguments
-   * @return Whether the send was successful.
+   * @return Whether the command could be queued.
    */
   bool send_command_printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
 
   void set_wait_for_ack(bool wait_for_ack);
 
+  /// The number of commands written to the display.
+  uint32_t get_commands_sent() const { return this->commands_sent_; }
+  /// The number of component property writes that were dropped because the display already shows the value.
+  uint32_t get_commands_suppressed() const { return this->commands_suppressed_; }
+
  protected:
-  bool ack_();
+  struct QueuedCommand {
+    std::string command;
+    bool ack;
+  };
+
   bool read_until_ack_();
+  /// Queue a command, it is sent from loop() once the display acknowledged enough of the previous ones.
+  bool enqueue_command_(const char *command, bool ack);
+  /// Write queued commands while not too many acknowledgements are outstanding.
+  void process_queue_();
+  /** Like send_command_printf(), but drop the command if the last one for the same property had the same value.
+   *
+   * The property is everything up to the first '=' or ',' of the command, like "text.txt" or "vis button".
+   */
+  bool send_cached_command_printf_(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  /// Forget all cached property values, for example because the page changed and the display reset them.
+  void clear_property_cache_() { this->property_cache_.clear(); }
 
   std::vector<NextionTouchComponent *> touch_;
   optional<nextion_writer_t> writer_;
   bool wait_for_ack_{true};
   float brightness_{1.0};
+  std::deque<QueuedCommand> queue_;
+  /// The hash of the last value written to every property, by hash of the property.
+  std::map<uint32_t, uint32_t> property_cache_;
+  uint8_t acks_pending_{0};
+  uint32_t last_sent_{0};
+  uint32_t commands_sent_{0};
+  uint32_t commands_suppressed_{0};
+  uint32_t last_logged_suppressed_{0};
 };
 
 class NextionTouchComponent : public binary_sensor::BinarySensorInitiallyOff {
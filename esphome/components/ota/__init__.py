@@ -2,7 +2,7 @@ from esphome.cpp_generator import RawExpression
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.const import (
-    CONF_ID, CONF_NUM_ATTEMPTS, CONF_PASSWORD,
+    ARDUINO_VERSION_ESP8266, CONF_ID, CONF_NUM_ATTEMPTS, CONF_PASSWORD,
     CONF_PORT, CONF_REBOOT_TIMEOUT, CONF_SAFE_MODE
 )
 from esphome.core import CORE, coroutine_with_priority
@@ -23,6 +23,16 @@ CONFIG_SCHEMA = cv.Schema({
 }).extend(cv.COMPONENT_SCHEMA)
 
 
+def supports_compression():
+    # The ESP8266 updater takes gzip compressed images since arduino 2.7.0, newer platform versions aren't in the table
+    if not CORE.is_esp8266:
+        return False
+    for version, platform in ARDUINO_VERSION_ESP8266.items():
+        if platform == CORE.arduino_version and version != 'dev':
+            return tuple(int(x) for x in version.split('.')) >= (2, 7, 0)
+    return True
+
+
 @coroutine_with_priority(50.0)
 def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
@@ -36,6 +46,9 @@ def to_code(config):
                                                config[CONF_REBOOT_TIMEOUT])
         cg.add(RawExpression(f"if ({condition}) return"))
 
+    if supports_compression():
+        cg.add_define('USE_OTA_COMPRESSION')
+
     if CORE.is_esp8266:
         cg.add_library('Update', None)
     elif CORE.is_esp32:
@@ -1,5 +1,6 @@
 #include "ota_component.h"
 
+#include "esphome/core/defines.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
@@ -9,6 +10,8 @@
 #include <MD5Builder.h>
 #ifdef ARDUINO_ARCH_ESP32
 #include <Update.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
 #endif
 #include <StreamString.h>
 
@@ -18,6 +21,14 @@ namespace ota {
 static const char *TAG = "ota";
 
 uint8_t OTA_VERSION_1_0 = 1;
+/** The firmware is received in chunks of this size.
+ *
+ * A chunk drains everything lwIP has buffered for the connection, so its receive window is open again while the
+ * chunk is written to flash. This matches the flash sector size both updaters buffer before writing.
+ */
+static const size_t OTA_BUFFER_SIZE = 4096;
+/// The chunk size COPY commands of a delta patch are read from the running image with.
+static const size_t OTA_PATCH_COPY_SIZE = 1024;
 
 void OTAComponent::setup() {
   this->server_ = new WiFiServer(this->port_);
@@ -47,17 +58,25 @@ void OTAComponent::loop() {
     this->clean_rtc();
   }
 }
+bool OTAComponent::is_loop_idle() {
+  // New connections are picked up within max_loop_sleep, the upload itself runs synchronously in handle_().
+  return !this->has_safe_mode_;
+}
 
 void OTAComponent::handle_() {
   OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UNKNOWN;
   bool update_started = false;
   uint32_t total = 0;
   uint32_t last_progress = 0;
-  uint8_t buf[1024];
+  uint32_t start_time = 0;
+  uint8_t buf[128];
   char *sbuf = reinterpret_cast<char *>(buf);
+  std::unique_ptr<uint8_t[]> data;
   uint32_t ota_size;
   uint8_t ota_features;
-  (void) ota_features;
+  uint8_t accepted_features = 0;
+  bool compressed = false;
+  bool delta = false;
 
   if (!this->client_.connected()) {
     this->client_ = this->server_->available();
@@ -95,9 +114,20 @@ void OTAComponent::handle_() {
   }
   ota_features = buf[0];  // NOLINT
   ESP_LOGV(TAG, "OTA features is 0x%02X", ota_features);
+#ifdef USE_OTA_COMPRESSION
+  // the ESP8266 updater stores a gzip compressed image as it is, the bootloader unpacks it while installing it
+  accepted_features |= ota_features & OTA_FEATURE_SUPPORTS_COMPRESSION;
+#endif
+  accepted_features |= ota_features & OTA_FEATURE_SUPPORTS_DELTA;
+  compressed = (accepted_features & OTA_FEATURE_SUPPORTS_COMPRESSION) != 0;
 
-  // Acknowledge header - 1 byte
-  this->client_.write(OTA_RESPONSE_HEADER_OK);
+  // Acknowledge header - 1 byte, a client that knows about delta updates also gets the accepted features
+  if (ota_features & OTA_FEATURE_SUPPORTS_DELTA) {
+    this->client_.write(OTA_RESPONSE_FEATURES);
+    this->client_.write(accepted_features);
+  } else {
+    this->client_.write(compressed ? OTA_RESPONSE_SUPPORTS_COMPRESSION : OTA_RESPONSE_HEADER_OK);
+  }
 
   if (!this->password_.empty()) {
     this->client_.write(OTA_RESPONSE_REQUEST_AUTH);
@@ -158,6 +188,34 @@ void OTAComponent::handle_() {
   // Acknowledge auth OK - 1 byte
   this->client_.write(OTA_RESPONSE_AUTH_OK);
 
+  data.reset(new uint8_t[OTA_BUFFER_SIZE]);
+  this->patch_base_size_ = 0;
+  if (accepted_features & OTA_FEATURE_SUPPORTS_DELTA) {
+    // Read size and MD5 of the image the patch is for, 4 bytes MSB first and 32 bytes hex MD5
+    if (!this->wait_receive_(buf, 36)) {
+      ESP_LOGW(TAG, "Reading delta base failed!");
+      goto error;
+    }
+    uint32_t base_size = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+      base_size <<= 8;
+      base_size |= buf[i];
+    }
+    sbuf[36] = '\0';
+    delta = this->check_running_md5_(base_size, sbuf + 4, data.get());
+    if (delta) {
+      this->patch_base_size_ = base_size;
+      this->patch_header_len_ = 0;
+      this->patch_insert_remaining_ = 0;
+      this->patch_copy_buf_.reset(new uint8_t[OTA_PATCH_COPY_SIZE]);
+      compressed = false;
+    } else if (base_size != 0) {
+      // a size of 0 means the client declined the delta update
+      ESP_LOGW(TAG, "Running image isn't the base of the delta update, falling back to a full image");
+    }
+    this->client_.write(delta ? OTA_RESPONSE_DELTA_BASE_OK : OTA_RESPONSE_DELTA_BASE_MISMATCH);
+  }
+
   // Read size, 4 bytes MSB first
   if (!this->wait_receive_(buf, 4)) {
     ESP_LOGW(TAG, "Reading size failed!");
@@ -168,7 +226,7 @@ void OTAComponent::handle_() {
     ota_size <<= 8;
     ota_size |= buf[i];
   }
-  ESP_LOGV(TAG, "OTA size is %u bytes", ota_size);
+  ESP_LOGV(TAG, "OTA size is %u bytes%s", ota_size, compressed ? " (compressed)" : delta ? " (delta)" : "");
 
 #ifdef ARDUINO_ARCH_ESP8266
   global_preferences.prevent_write(true);
@@ -222,25 +280,34 @@ void OTAComponent::handle_() {
   // Acknowledge MD5 OK - 1 byte
   this->client_.write(OTA_RESPONSE_BIN_MD5_OK);
 
+  start_time = millis();
+  last_progress = start_time;
   while (!Update.isFinished()) {
-    size_t available = this->wait_receive_(buf, 0);
+    size_t available = this->wait_receive_(data.get(), 0);
     if (!available) {
       goto error;
     }
 
-    uint32_t written = Update.write(buf, available);
-    if (written != available) {
-      ESP_LOGW(TAG, "Error writing binary data to flash: %u != %u!", written, available);  // NOLINT
-      error_code = OTA_RESPONSE_ERROR_WRITING_FLASH;
-      goto error;
+    if (delta) {
+      if (!this->write_patch_(data.get(), available)) {
+        error_code = OTA_RESPONSE_ERROR_INVALID_PATCH;
+        goto error;
+      }
+    } else {
+      uint32_t written = Update.write(data.get(), available);
+      if (written != available) {
+        ESP_LOGW(TAG, "Error writing binary data to flash: %u != %u!", written, available);  // NOLINT
+        error_code = OTA_RESPONSE_ERROR_WRITING_FLASH;
+        goto error;
+      }
     }
-    total += written;
+    total += available;
 
     uint32_t now = millis();
     if (now - last_progress > 1000) {
       last_progress = now;
-      float percentage = (total * 100.0f) / ota_size;
-      ESP_LOGD(TAG, "OTA in progress: %0.1f%%", percentage);
+      float percentage = (Update.progress() * 100.0f) / ota_size;
+      ESP_LOGD(TAG, "OTA in progress: %0.1f%% (%.1f kB/s)", percentage, total / float(now - start_time));
       // slow down OTA update to avoid getting killed by task watchdog (task_wdt)
       delay(10);
     }
@@ -248,6 +315,12 @@ void OTAComponent::handle_() {
 
   // Acknowledge receive OK - 1 byte
   this->client_.write(OTA_RESPONSE_RECEIVE_OK);
+  data.reset();
+  this->patch_copy_buf_.reset();
+  {
+    const uint32_t duration = std::max<uint32_t>(millis() - start_time, 1);
+    ESP_LOGI(TAG, "Received %u bytes in %.1f s (%.1f kB/s)", total, duration / 1000.0f, total / float(duration));
+  }
 
   if (!Update.end()) {
     error_code = OTA_RESPONSE_ERROR_UPDATE_END;
@@ -282,6 +355,7 @@ error:
     this->client_.flush();
   }
   this->client_.stop();
+  this->patch_copy_buf_.reset();
 
 #ifdef ARDUINO_ARCH_ESP32
   if (update_started) {
@@ -326,7 +400,7 @@ size_t OTAComponent::wait_receive_(uint8_t *buf, size_t bytes, bool check_discon
   } while (bytes == 0 ? available == 0 : available < bytes);
 
   if (bytes == 0)
-    bytes = std::min(available, size_t(1024));
+    bytes = std::min(available, OTA_BUFFER_SIZE);
 
   bool success = false;
   for (uint32_t i = 0; !success && i < 100; i++) {
@@ -350,6 +424,107 @@ size_t OTAComponent::wait_receive_(uint8_t *buf, size_t bytes, bool check_discon
   return bytes;
 }
 
+bool OTAComponent::read_running_(uint32_t offset, uint8_t *data, size_t len) {
+#ifdef ARDUINO_ARCH_ESP8266
+  // the sketch is at the start of the flash, flashRead() needs 4 byte aligned addresses and lengths
+  uint32_t words[64];
+  while (len != 0) {
+    const uint32_t aligned = offset & ~3u;
+    const size_t skip = offset - aligned;
+    const size_t chunk = std::min(len, sizeof(words) - skip);
+    if (!ESP.flashRead(aligned, words, (skip + chunk + 3) & ~3u))
+      return false;
+    memcpy(data, reinterpret_cast<uint8_t *>(words) + skip, chunk);
+    offset += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+  return true;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  return running != nullptr && esp_partition_read(running, offset, data, len) == ESP_OK;
+#endif
+}
+bool OTAComponent::check_running_md5_(uint32_t size, const char *md5, uint8_t *buf) {
+#ifdef ARDUINO_ARCH_ESP8266
+  const uint32_t max_size = ESP.getSketchSize();
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  const uint32_t max_size = running != nullptr ? running->size : 0;
+#endif
+  if (size == 0 || size > max_size)
+    return false;
+
+  MD5Builder md5_builder{};
+  md5_builder.begin();
+  for (uint32_t offset = 0; offset < size; offset += OTA_BUFFER_SIZE) {
+    const size_t chunk = std::min<uint32_t>(size - offset, OTA_BUFFER_SIZE);
+    if (!this->read_running_(offset, buf, chunk))
+      return false;
+    md5_builder.add(buf, chunk);
+    App.feed_wdt();
+  }
+  md5_builder.calculate();
+  char result[33];
+  md5_builder.getChars(result);
+  return strncmp(result, md5, 32) == 0;
+}
+bool OTAComponent::write_patch_(uint8_t *data, size_t len) {
+  while (len != 0) {
+    if (this->patch_insert_remaining_ != 0) {
+      const size_t chunk = std::min<uint32_t>(len, this->patch_insert_remaining_);
+      if (Update.write(data, chunk) != chunk) {
+        ESP_LOGW(TAG, "Error writing inserted data to flash!");
+        return false;
+      }
+      this->patch_insert_remaining_ -= chunk;
+      data += chunk;
+      len -= chunk;
+      continue;
+    }
+
+    // collect the header of the next command, it may arrive in pieces
+    this->patch_header_[this->patch_header_len_++] = *data++;
+    len--;
+    const uint8_t command = this->patch_header_[0];
+    if (command != OTA_PATCH_COPY && command != OTA_PATCH_INSERT) {
+      ESP_LOGW(TAG, "Invalid patch command 0x%02X!", command);
+      return false;
+    }
+    const uint8_t header_len = command == OTA_PATCH_COPY ? 9 : 5;
+    if (this->patch_header_len_ < header_len)
+      continue;
+    this->patch_header_len_ = 0;
+    const uint8_t *header = this->patch_header_ + 1;
+    const uint32_t first = encode_uint32(header[0], header[1], header[2], header[3]);
+    if (command == OTA_PATCH_INSERT) {
+      this->patch_insert_remaining_ = first;
+      continue;
+    }
+
+    uint32_t offset = first;
+    uint32_t remaining = encode_uint32(header[4], header[5], header[6], header[7]);
+    if (offset > this->patch_base_size_ || remaining > this->patch_base_size_ - offset) {
+      ESP_LOGW(TAG, "Patch copies outside of the running image!");
+      return false;
+    }
+    while (remaining != 0) {
+      const size_t chunk = std::min<uint32_t>(remaining, OTA_PATCH_COPY_SIZE);
+      if (!this->read_running_(offset, this->patch_copy_buf_.get(), chunk) ||
+          Update.write(this->patch_copy_buf_.get(), chunk) != chunk) {
+        ESP_LOGW(TAG, "Error copying from the running image to flash!");
+        return false;
+      }
+      offset += chunk;
+      remaining -= chunk;
+      App.feed_wdt();
+    }
+  }
+  return true;
+}
+
 void OTAComponent::set_auth_password(const std::string &password) { this->password_ = password; }
 
 float OTAComponent::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
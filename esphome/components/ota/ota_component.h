@@ -4,6 +4,7 @@
 #include "esphome/core/preferences.h"
 #include <WiFiServer.h>
 #include <WiFiClient.h>
+#include <memory>
 
 namespace esphome {
 namespace ota {
@@ -18,6 +19,12 @@ enum OTAResponseTypes {
   OTA_RESPONSE_BIN_MD5_OK = 67,
   OTA_RESPONSE_RECEIVE_OK = 68,
   OTA_RESPONSE_UPDATE_END_OK = 69,
+  OTA_RESPONSE_SUPPORTS_COMPRESSION = 70,
+  /// Followed by a byte with the accepted OTAFeatures, sent if the client asked for a delta update.
+  OTA_RESPONSE_FEATURES = 71,
+  OTA_RESPONSE_DELTA_BASE_OK = 72,
+  /// The running image isn't the base of the delta, the client continues with a full image.
+  OTA_RESPONSE_DELTA_BASE_MISMATCH = 73,
 
   OTA_RESPONSE_ERROR_MAGIC = 128,
   OTA_RESPONSE_ERROR_UPDATE_PREPARE = 129,
@@ -29,9 +36,28 @@ enum OTAResponseTypes {
   OTA_RESPONSE_ERROR_WRONG_NEW_FLASH_CONFIG = 135,
   OTA_RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136,
   OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137,
+  OTA_RESPONSE_ERROR_INVALID_PATCH = 138,
   OTA_RESPONSE_ERROR_UNKNOWN = 255,
 };
 
+/// Bits of the features byte the client sends after the magic bytes.
+enum OTAFeatures {
+  /// The client can send a gzip compressed image, if answered with OTA_RESPONSE_SUPPORTS_COMPRESSION.
+  OTA_FEATURE_SUPPORTS_COMPRESSION = 0x01,
+  /// The client can send a patch against the running image instead of the image itself.
+  OTA_FEATURE_SUPPORTS_DELTA = 0x02,
+};
+
+/** The commands of a delta patch, the image is built by running them in order.
+ *
+ * COPY is followed by the offset in the running image and the length, INSERT by the length and the data. All
+ * numbers have 4 bytes, MSB first.
+ */
+enum OTAPatchCommand {
+  OTA_PATCH_COPY = 0x01,
+  OTA_PATCH_INSERT = 0x02,
+};
+
 /// OTAComponent provides a simple way to integrate Over-the-Air updates into your app using ArduinoOTA.
 class OTAComponent : public Component {
  public:
@@ -55,6 +81,7 @@ class OTAComponent : public Component {
   void dump_config() override;
   float get_setup_priority() const override;
   void loop() override;
+  bool is_loop_idle() override;
 
   uint16_t get_port() const;
 
@@ -67,7 +94,14 @@ class OTAComponent : public Component {
   uint32_t read_rtc_();
 
   void handle_();
+  /// Receive bytes bytes into buf, or with 0 whatever is available but at least one byte and at most OTA_BUFFER_SIZE.
   size_t wait_receive_(uint8_t *buf, size_t bytes, bool check_disconnected = true);
+  /// Read from the image that is running now.
+  bool read_running_(uint32_t offset, uint8_t *data, size_t len);
+  /// Whether the first size bytes of the running image have the given MD5, buf needs OTA_BUFFER_SIZE bytes.
+  bool check_running_md5_(uint32_t size, const char *md5, uint8_t *buf);
+  /// Run the commands of a delta patch in data, they may be split across calls.
+  bool write_patch_(uint8_t *data, size_t len);
 
   std::string password_;
 
@@ -76,6 +110,14 @@ class OTAComponent : public Component {
   WiFiServer *server_{nullptr};
   WiFiClient client_{};
 
+  /// Size of the running image a delta patch may copy from, 0 for a full image.
+  uint32_t patch_base_size_{0};
+  uint8_t patch_header_[9];
+  uint8_t patch_header_len_{0};
+  /// Bytes left of the INSERT command that is being received.
+  uint32_t patch_insert_remaining_{0};
+  std::unique_ptr<uint8_t[]> patch_copy_buf_;
+
   bool has_safe_mode_{false};              ///< stores whether safe mode can be enabled.
   uint32_t safe_mode_start_time_;          ///< stores when safe mode was enabled.
   uint32_t safe_mode_enable_time_{60000};  ///< The time safe mode should be on for.
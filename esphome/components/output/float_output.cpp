@@ -7,6 +7,18 @@ namespace output {
 
 static const char *TAG = "output.float";
 
+static uint8_t latch_guard_depth = 0;               // NOLINT
+static std::vector<FloatOutput *> pending_latches;  // NOLINT
+
+LatchGuard::LatchGuard() { latch_guard_depth++; }
+LatchGuard::~LatchGuard() {
+  if (--latch_guard_depth != 0)
+    return;
+  for (auto *output : pending_latches)
+    output->latch_();
+  pending_latches.clear();
+}
+
 void FloatOutput::set_max_power(float max_power) {
   this->max_power_ = clamp(max_power, this->min_power_, 1.0f);  // Clamp to MIN>=MAX>=1.0
 }
@@ -19,7 +31,25 @@ void FloatOutput::set_min_power(float min_power) {
 
 float FloatOutput::get_min_power() const { return this->min_power_; }
 
-void FloatOutput::set_level(float state) {
+void FloatOutput::set_level(float state) { this->write_state(this->adjust_level_(state)); }
+
+void FloatOutput::set_level_fade(float state, uint32_t length) {
+  this->write_state_fade(this->adjust_level_(state), length);
+}
+
+void FloatOutput::request_latch_() {
+  if (latch_guard_depth == 0) {
+    this->latch_();
+    return;
+  }
+  for (auto *output : pending_latches) {
+    if (output == this)
+      return;
+  }
+  pending_latches.push_back(this);
+}
+
+float FloatOutput::adjust_level_(float state) {
   state = clamp(state, 0.0f, 1.0f);
 
 #ifdef USE_POWER_SUPPLY
@@ -31,8 +61,7 @@ void FloatOutput::set_level(float state) {
 #endif
   if (this->is_inverted())
     state = 1.0f - state;
-  float adjusted_value = (state * (this->max_power_ - this->min_power_)) + this->min_power_;
-  this->write_state(adjusted_value);
+  return (state * (this->max_power_ - this->min_power_)) + this->min_power_;
 }
 
 void FloatOutput::write_state(bool state) { this->set_level(state != this->inverted_ ? 1.0f : 0.0f); }
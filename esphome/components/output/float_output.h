@@ -15,6 +15,17 @@ namespace output {
     ESP_LOGCONFIG(TAG, "  Min Power: %.1f%%", this->min_power_ * 100.0f); \
   }
 
+/** Holds back the levels written to outputs that write and latch them separately, like LEDC, while it exists.
+ *
+ * They are all latched together once the outermost guard is destroyed, so the channels of a light change at the same
+ * time instead of one after the other.
+ */
+class LatchGuard {
+ public:
+  LatchGuard();
+  ~LatchGuard();
+};
+
 /** Base class for all output components that can output a variable level, like PWM.
  *
  * Floating Point Outputs always use output values in the range from 0.0 to 1.0 (inclusive), where 0.0 means off
@@ -52,6 +63,18 @@ class FloatOutput : public BinaryOutput {
    */
   void set_level(float state);
 
+  /** Fade linearly from the current level to state within length ms, without any further calls.
+   *
+   * Only outputs that fade in hardware support this, see supports_fade(). The others are set to state immediately.
+   *
+   * @param state The new state.
+   * @param length The length of the fade in ms.
+   */
+  void set_level_fade(float state, uint32_t length);
+
+  /// Whether this output fades in hardware with set_level_fade().
+  virtual bool supports_fade() const { return false; }
+
   /** Set the frequency of the output for PWM outputs.
    *
    * Implemented only by components which can set the output PWM frequency.
@@ -70,9 +93,19 @@ class FloatOutput : public BinaryOutput {
   float get_min_power() const;
 
  protected:
+  friend LatchGuard;
+
   /// Implement BinarySensor's write_enabled; this should never be called.
   void write_state(bool state) override;
   virtual void write_state(float state) = 0;
+  /// Override to fade to state in hardware, called with the adjusted state like write_state().
+  virtual void write_state_fade(float state, uint32_t length) { this->write_state(state); }
+  /// Latch the level written last, for outputs that write and latch separately, see request_latch_().
+  virtual void latch_() {}
+  /// Latch now, or together with the other outputs once the current LatchGuard is destroyed.
+  void request_latch_();
+  /// Clamp state and apply the power supply, inversion and the min and max power.
+  float adjust_level_(float state);
 
   float max_power_{1.0f};
   float min_power_{0.0f};
@@ -0,0 +1,161 @@
+#include "motion_profile.h"
+#include "esphome/core/application.h"
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace output {
+
+/// A move ends once it is this close to its target, the last steps of the braking are rounded to it.
+static const float MOTION_PROFILE_TOLERANCE = 0.001f;
+/// After the loop was blocked, the move continues with this step at most instead of jumping ahead.
+static const uint32_t MOTION_TIMER_MAX_STEP = 100;
+
+static std::vector<MotionProfile *> motion_profiles;  // NOLINT
+static SchedulerHandle motion_timer_handle = 0;      // NOLINT
+static uint32_t motion_timer_last_tick = 0;          // NOLINT
+
+void MotionProfile::move_to(float target) {
+  this->target_ = target;
+  if (!this->is_limited_()) {
+    this->finish_();
+    return;
+  }
+  // the moving average over acceleration / jerk turns the acceleration steps into ramps with that jerk
+  size_t window = 0;
+  if (this->max_acceleration_ > 0.0f && this->jerk_ > 0.0f)
+    window = std::max(1L, lroundf(this->max_acceleration_ / this->jerk_ * 1000.0f / MotionTimer::INTERVAL));
+  if (this->history_.size() != window) {
+    this->history_.assign(window, this->reference_);
+    this->history_index_ = 0;
+  }
+  if (target == this->position_ && !this->moving_) {
+    this->finish_();
+    return;
+  }
+  this->reference_moving_ = true;
+  this->moving_ = true;
+  MotionTimer::start(this);
+}
+
+void MotionProfile::reset(float position) {
+  this->position_ = position;
+  this->reference_ = position;
+  this->target_ = position;
+  this->velocity_ = 0.0f;
+  this->reference_moving_ = false;
+  this->moving_ = false;
+  std::fill(this->history_.begin(), this->history_.end(), position);
+}
+
+void MotionProfile::stop() {
+  if (!this->moving_)
+    return;
+  float distance = 0.0f;
+  if (this->max_acceleration_ > 0.0f)
+    distance = this->velocity_ * this->velocity_ / (2.0f * this->max_acceleration_);
+  this->move_to(this->reference_ + (this->velocity_ < 0.0f ? -distance : distance));
+}
+
+bool MotionProfile::step_reference_(float dt) {
+  const float distance = this->target_ - this->reference_;
+  const float direction = distance < 0.0f ? -1.0f : 1.0f;
+  const float a = this->max_acceleration_;
+
+  // the velocity from which the distance that is left after this step can just be braked
+  float brake_velocity;
+  if (a <= 0.0f) {
+    brake_velocity = fabsf(distance) / dt;
+  } else {
+    const float remaining = std::max(fabsf(distance) - fabsf(this->velocity_) * dt, 0.0f);
+    brake_velocity = sqrtf(2.0f * a * remaining);
+  }
+  float target_velocity = direction * brake_velocity;
+  if (this->max_velocity_ > 0.0f)
+    target_velocity = clamp(target_velocity, -this->max_velocity_, this->max_velocity_);
+  if (a <= 0.0f)
+    this->velocity_ = target_velocity;
+  else
+    this->velocity_ += clamp(target_velocity - this->velocity_, -a * dt, a * dt);
+  this->reference_ += this->velocity_ * dt;
+
+  // arrived, or passed the target in the last step of the braking
+  const float left = (this->target_ - this->reference_) * direction;
+  if (left <= 0.0f || (left <= MOTION_PROFILE_TOLERANCE && fabsf(this->velocity_) * dt <= MOTION_PROFILE_TOLERANCE)) {
+    this->reference_ = this->target_;
+    this->velocity_ = 0.0f;
+    return false;
+  }
+  return true;
+}
+
+bool MotionProfile::step_(float dt) {
+  if (this->reference_moving_)
+    this->reference_moving_ = this->step_reference_(dt);
+  if (this->history_.empty()) {
+    this->position_ = this->reference_;
+  } else {
+    this->history_[this->history_index_] = this->reference_;
+    this->history_index_ = (this->history_index_ + 1) % this->history_.size();
+    float sum = 0.0f;
+    for (float level : this->history_)
+      sum += level;
+    this->position_ = sum / this->history_.size();
+  }
+
+  if (!this->reference_moving_ && fabsf(this->target_ - this->position_) <= MOTION_PROFILE_TOLERANCE) {
+    this->finish_();
+    return false;
+  }
+  if (this->write_callback_)
+    this->write_callback_(this->position_);
+  return true;
+}
+
+void MotionProfile::finish_() {
+  this->reset(this->target_);
+  if (this->write_callback_)
+    this->write_callback_(this->position_);
+}
+
+void MotionTimer::start(MotionProfile *profile) {
+  if (!profile->scheduled_) {
+    profile->scheduled_ = true;
+    motion_profiles.push_back(profile);
+  }
+  if (motion_timer_handle == 0) {
+    motion_timer_last_tick = millis();
+    motion_timer_handle = App.scheduler.set_interval(nullptr, "motion", INTERVAL, &MotionTimer::tick_);
+  }
+}
+
+void MotionTimer::tick_() {
+  const uint32_t now = millis();
+  const float dt = std::min(now - motion_timer_last_tick, MOTION_TIMER_MAX_STEP) / 1000.0f;
+  motion_timer_last_tick = now;
+  if (dt <= 0.0f)
+    return;
+
+  // write callbacks may start other profiles, which are appended and stepped in this tick as well
+  for (size_t i = 0; i < motion_profiles.size(); i++) {
+    MotionProfile *profile = motion_profiles[i];
+    if (profile->moving_)
+      profile->step_(dt);
+  }
+  // a profile that was finished and started again in its write callback keeps moving
+  auto end = std::remove_if(motion_profiles.begin(), motion_profiles.end(), [](MotionProfile *profile) {
+    if (profile->moving_)
+      return false;
+    profile->scheduled_ = false;
+    return true;
+  });
+  motion_profiles.erase(end, motion_profiles.end());
+
+  if (motion_profiles.empty()) {
+    App.scheduler.cancel(motion_timer_handle);
+    motion_timer_handle = 0;
+  }
+}
+
+}  // namespace output
+}  // namespace esphome
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include <functional>
+#include <vector>
+
+namespace esphome {
+namespace output {
+
+/** Moves a level towards a target with limited velocity, acceleration and jerk (an S-curve).
+ *
+ * The move isn't planned ahead: every tick of the MotionTimer computes the velocity from which the remaining distance
+ * can just be braked and accelerates towards it, so a new target can be set at any time and the move continues from
+ * the current velocity. This trapezoidal profile is smoothed with a moving average over acceleration / jerk seconds,
+ * which turns each step of the acceleration into a ramp without ever passing the target.
+ *
+ * A limit of 0 means unlimited, without any limits the level jumps to the target.
+ */
+class MotionProfile {
+ public:
+  /// The maximum velocity in level units per second.
+  void set_max_velocity(float max_velocity) { this->max_velocity_ = max_velocity; }
+  /// The maximum acceleration and deceleration in level units per second squared.
+  void set_max_acceleration(float max_acceleration) { this->max_acceleration_ = max_acceleration; }
+  /// The maximum change of the acceleration in level units per second cubed, this rounds the corners of the ramp.
+  void set_jerk(float jerk) { this->jerk_ = jerk; }
+  /// Called with every new level, from the MotionTimer or directly when the level jumps.
+  void set_write_callback(std::function<void(float)> &&callback) { this->write_callback_ = std::move(callback); }
+
+  /// Move to the target, starting from the current level and velocity.
+  void move_to(float target);
+  /// Set the level without a move and without writing it, like when it is restored.
+  void reset(float position);
+  /// Stop as fast as the limits allow.
+  void stop();
+
+  bool is_moving() const { return this->moving_; }
+  float get_position() const { return this->position_; }
+  float get_velocity() const { return this->velocity_; }
+  float get_target() const { return this->target_; }
+
+ protected:
+  friend class MotionTimer;
+
+  bool is_limited_() const { return this->max_velocity_ > 0.0f || this->max_acceleration_ > 0.0f; }
+  /// Advance the move by dt seconds and write the new level, returns whether it is still moving.
+  bool step_(float dt);
+  /// Advance the trapezoidal profile, returns whether it is still moving.
+  bool step_reference_(float dt);
+  void finish_();
+
+  float max_velocity_{0.0f};
+  float max_acceleration_{0.0f};
+  float jerk_{0.0f};
+  std::function<void(float)> write_callback_;
+
+  /// The smoothed level that is written.
+  float position_{0.0f};
+  /// The level and velocity of the trapezoidal profile.
+  float reference_{0.0f};
+  float velocity_{0.0f};
+  bool reference_moving_{false};
+  /// The last levels of the trapezoidal profile for the moving average, empty without a jerk limit.
+  std::vector<float> history_;
+  size_t history_index_{0};
+  float target_{0.0f};
+  bool moving_{false};
+  bool scheduled_{false};
+};
+
+/** Advances all moving MotionProfiles from a single interval.
+ *
+ * The interval only exists while something moves, so many servos and motors moving in parallel cost one scheduler
+ * item and no allocations per step. It runs in the main loop, because the outputs the profiles write to (like
+ * PCA9685 channels on the I2C bus) aren't safe to write from an interrupt.
+ */
+class MotionTimer {
+ public:
+  /// The tick in ms, half the period of a servo's PWM.
+  static const uint32_t INTERVAL = 10;
+
+  static void start(MotionProfile *profile);
+
+ protected:
+  static void tick_();
+};
+
+}  // namespace output
+}  // namespace esphome
@@ -1,10 +1,91 @@
 #include "light_partition.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace partition {
 
 static const char *TAG = "partition.light";
 
+PartitionLightOutput::PartitionLightOutput(std::vector<AddressableSegment> segments) {
+  int32_t off = 0;
+  for (auto &seg : segments) {
+    if (!this->segments_.empty() && this->segments_.back().is_continued_by(seg)) {
+      this->segments_.back().extend(seg.get_size());
+    } else {
+      seg.set_dst_offset(off);
+      this->segments_.push_back(seg);
+    }
+    off += seg.get_size();
+
+    if (std::find(this->sources_.begin(), this->sources_.end(), seg.get_src()) == this->sources_.end())
+      this->sources_.push_back(seg.get_src());
+  }
+}
+
+void PartitionLightOutput::loop() {
+  if (this->should_show_()) {
+    // several segments may be part of the same light, it only has to be shown once
+    for (auto *src : this->sources_) {
+      src->schedule_show();
+    }
+    this->mark_shown_();
+  }
+}
+
+size_t PartitionLightOutput::find_segment_(int32_t index) const {
+  const AddressableSegment &last = this->segments_[this->last_segment_];
+  if (index >= last.get_dst_offset() && index < last.get_dst_offset() + last.get_size())
+    return this->last_segment_;
+
+  uint32_t lo = 0;
+  uint32_t hi = this->segments_.size() - 1;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    int32_t begin = this->segments_[mid].get_dst_offset();
+    int32_t end = begin + this->segments_[mid].get_size();
+    if (index < begin) {
+      hi = mid - 1;
+    } else if (index >= end) {
+      lo = mid + 1;
+    } else {
+      lo = hi = mid;
+    }
+  }
+  this->last_segment_ = lo;
+  return lo;
+}
+
+void PartitionLightOutput::fill_range_internal(int32_t from, int32_t to, const light::ESPColor &color,
+                                               const light::ESPColorCorrection &correction) {
+  this->for_each_run_(from, to, [&color, &correction](const AddressableSegment &seg, int32_t src_from,
+                                                      int32_t count, int32_t dst_from) {
+    seg.get_src()->fill_range_internal(src_from, src_from + count, color, correction);
+  });
+}
+void PartitionLightOutput::write_rgb_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                                                   const light::ESPColorCorrection &correction) {
+  this->for_each_run_(offset, offset + count, [data, offset, &correction](const AddressableSegment &seg,
+                                                                          int32_t src_from, int32_t run_count,
+                                                                          int32_t dst_from) {
+    seg.get_src()->write_rgb_span_internal(data + (dst_from - offset) * 3, run_count, src_from, correction);
+  });
+}
+void PartitionLightOutput::write_rgbw_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                                                    const light::ESPColorCorrection &correction) {
+  this->for_each_run_(offset, offset + count, [data, offset, &correction](const AddressableSegment &seg,
+                                                                          int32_t src_from, int32_t run_count,
+                                                                          int32_t dst_from) {
+    seg.get_src()->write_rgbw_span_internal(data + (dst_from - offset) * 4, run_count, src_from, correction);
+  });
+}
+void PartitionLightOutput::scale_range_internal(int32_t from, int32_t to, uint8_t scale,
+                                                const light::ESPColorCorrection &correction) {
+  this->for_each_run_(from, to, [scale, &correction](const AddressableSegment &seg, int32_t src_from,
+                                                     int32_t count, int32_t dst_from) {
+    seg.get_src()->scale_range_internal(src_from, src_from + count, scale, correction);
+  });
+}
+
 }  // namespace partition
 }  // namespace esphome
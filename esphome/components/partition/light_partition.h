@@ -16,6 +16,11 @@ class AddressableSegment {
   int32_t get_size() const { return this->size_; }
   int32_t get_dst_offset() const { return this->dst_offset_; }
   void set_dst_offset(int32_t dst_offset) { this->dst_offset_ = dst_offset; }
+  /// Whether other directly continues this segment in the same light, so both can be treated as one run.
+  bool is_continued_by(const AddressableSegment &other) const {
+    return other.src_ == this->src_ && other.src_offset_ == this->src_offset_ + this->size_;
+  }
+  void extend(int32_t size) { this->size_ += size; }
 
  protected:
   light::AddressableLight *src_;
@@ -26,13 +31,7 @@ class AddressableSegment {
 
 class PartitionLightOutput : public light::AddressableLight {
  public:
-  explicit PartitionLightOutput(std::vector<AddressableSegment> segments) : segments_(segments) {
-    int32_t off = 0;
-    for (auto &seg : this->segments_) {
-      seg.set_dst_offset(off);
-      off += seg.get_size();
-    }
-  }
+  explicit PartitionLightOutput(std::vector<AddressableSegment> segments);
   int32_t size() const override {
     auto &last_seg = this->segments_[this->segments_.size() - 1];
     return last_seg.get_dst_offset() + last_seg.get_size();
@@ -43,32 +42,38 @@ class PartitionLightOutput : public light::AddressableLight {
     }
   }
   light::LightTraits get_traits() override { return this->segments_[0].get_src()->get_traits(); }
-  void loop() override {
-    if (this->should_show_()) {
-      for (auto seg : this->segments_) {
-        seg.get_src()->schedule_show();
-      }
-      this->mark_shown_();
+  void loop() override;
+
+  void fill_range_internal(int32_t from, int32_t to, const light::ESPColor &color,
+                           const light::ESPColorCorrection &correction) override;
+  void write_rgb_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                               const light::ESPColorCorrection &correction) override;
+  void write_rgbw_span_internal(const uint8_t *data, size_t count, int32_t offset,
+                                const light::ESPColorCorrection &correction) override;
+  void scale_range_internal(int32_t from, int32_t to, uint8_t scale,
+                            const light::ESPColorCorrection &correction) override;
+
+ protected:
+  /// The index of the segment containing the LED at index, index must be within the partition.
+  size_t find_segment_(int32_t index) const;
+  /** Call f(segment, src_from, count, dst_from) for every run of LEDs from `from` up to (not including) `to`.
+   *
+   * Bulk operations on the partition become one span operation per segment on the underlying lights.
+   */
+  template<typename F> void for_each_run_(int32_t from, int32_t to, F f) const {
+    if (from >= to)
+      return;
+    for (size_t i = this->find_segment_(from); i < this->segments_.size() && from < to; i++) {
+      const AddressableSegment &seg = this->segments_[i];
+      const int32_t seg_end = seg.get_dst_offset() + seg.get_size();
+      const int32_t run_end = std::min(to, seg_end);
+      f(seg, seg.get_src_offset() + (from - seg.get_dst_offset()), run_end - from, from);
+      from = run_end;
     }
   }
 
- protected:
   light::ESPColorView get_view_internal(int32_t index) const override {
-    uint32_t lo = 0;
-    uint32_t hi = this->segments_.size() - 1;
-    while (lo < hi) {
-      uint32_t mid = (lo + hi) / 2;
-      int32_t begin = this->segments_[mid].get_dst_offset();
-      int32_t end = begin + this->segments_[mid].get_size();
-      if (index < begin) {
-        hi = mid - 1;
-      } else if (index >= end) {
-        lo = mid + 1;
-      } else {
-        lo = hi = mid;
-      }
-    }
-    auto &seg = this->segments_[lo];
+    auto &seg = this->segments_[this->find_segment_(index)];
     // offset within the segment
     int32_t seg_off = index - seg.get_dst_offset();
     // offset within the src
@@ -78,7 +83,12 @@ class PartitionLightOutput : public light::AddressableLight {
     return view;
   }
 
+  /// The segments with adjacent runs of the same light merged.
   std::vector<AddressableSegment> segments_;
+  /// The distinct lights the segments are part of, each is shown once per frame.
+  std::vector<light::AddressableLight *> sources_;
+  /// The segment of the last lookup, effects usually access the LEDs in order.
+  mutable size_t last_segment_{0};
 };
 
 }  // namespace partition
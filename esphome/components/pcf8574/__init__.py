@@ -2,7 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import i2c
-from esphome.const import CONF_ID, CONF_NUMBER, CONF_MODE, CONF_INVERTED
+from esphome.const import CONF_ID, CONF_NUMBER, CONF_MODE, CONF_INVERTED, CONF_INTERRUPT_PIN
 
 DEPENDENCIES = ['i2c']
 MULTI_CONF = True
@@ -19,9 +19,12 @@ PCF8574GPIOPin = pcf8574_ns.class_('PCF8574GPIOPin', cg.GPIOPin)
 
 CONF_PCF8574 = 'pcf8574'
 CONF_PCF8575 = 'pcf8575'
+CONF_CACHE = 'cache'
 CONFIG_SCHEMA = cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(PCF8574Component),
     cv.Optional(CONF_PCF8575, default=False): cv.boolean,
+    cv.Optional(CONF_CACHE, default=False): cv.boolean,
+    cv.Optional(CONF_INTERRUPT_PIN): pins.internal_gpio_input_pin_schema,
 }).extend(cv.COMPONENT_SCHEMA).extend(i2c.i2c_device_schema(0x21))
 
 
@@ -30,6 +33,12 @@ def to_code(config):
     yield cg.register_component(var, config)
     yield i2c.register_i2c_device(var, config)
     cg.add(var.set_pcf8575(config[CONF_PCF8575]))
+    # the interrupt only tells when the cached inputs are outdated
+    if config[CONF_CACHE] or CONF_INTERRUPT_PIN in config:
+        cg.add(var.set_cache(True))
+    if CONF_INTERRUPT_PIN in config:
+        pin = yield cg.gpio_pin_expression(config[CONF_INTERRUPT_PIN])
+        cg.add(var.set_interrupt_pin(pin))
 
 
 def validate_pcf8574_gpio_mode(value):
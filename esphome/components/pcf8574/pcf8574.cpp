@@ -1,4 +1,5 @@
 #include "pcf8574.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -16,6 +17,26 @@ void PCF8574Component::setup() {
 
   this->write_gpio_();
   this->read_gpio_();
+
+  if (this->interrupt_pin_ != nullptr) {
+    this->interrupt_pin_->setup();
+    this->interrupt_pin_->attach_interrupt(PCF8574Component::gpio_intr, this, FALLING);
+  }
+}
+void ICACHE_RAM_ATTR PCF8574Component::gpio_intr(PCF8574Component *arg) {
+  arg->interrupt_ = true;
+  Application::wake_loop_isr();
+}
+void PCF8574Component::loop() {
+  if (this->interrupt_pin_ == nullptr) {
+    this->input_valid_ = false;
+  } else if (this->interrupt_) {
+    this->interrupt_ = false;
+    this->input_valid_ = false;
+  }
+}
+bool PCF8574Component::is_loop_idle() {
+  return !this->cache_ || (this->interrupt_pin_ != nullptr && !this->interrupt_);
 }
 void PCF8574Component::dump_config() {
   ESP_LOGCONFIG(TAG, "PCF8574:");
@@ -26,7 +47,12 @@ void PCF8574Component::dump_config() {
   }
 }
 bool PCF8574Component::digital_read(uint8_t pin) {
-  this->read_gpio_();
+  if (!this->cache_) {
+    this->read_gpio_();
+  } else if (!this->input_valid_) {
+    // reading the port also clears the interrupt
+    this->input_valid_ = this->read_gpio_();
+  }
   return this->input_mask_ & (1 << pin);
 }
 void PCF8574Component::digital_write(uint8_t pin, bool value) {
@@ -36,6 +62,16 @@ void PCF8574Component::digital_write(uint8_t pin, bool value) {
     this->output_mask_ &= ~(1 << pin);
   }
 
+  if (this->cache_) {
+    if (!this->output_dirty_) {
+      this->output_dirty_ = true;
+      this->defer([this]() {
+        this->output_dirty_ = false;
+        this->write_gpio_();
+      });
+    }
+    return;
+  }
   this->write_gpio_();
 }
 void PCF8574Component::pin_mode(uint8_t pin, uint8_t mode) {
@@ -18,9 +18,21 @@ class PCF8574Component : public Component, public i2c::I2CDevice {
   PCF8574Component() = default;
 
   void set_pcf8575(bool pcf8575) { pcf8575_ = pcf8575; }
+  /** Read the port at most once per loop and combine the writes of a loop into one.
+   *
+   * The inputs are read again in the first digital_read() after the next loop(), with an interrupt pin only
+   * once the PCF8574 signaled a change on it. The outputs are written in the next scheduler call.
+   */
+  void set_cache(bool cache) { cache_ = cache; }
+  /// The ESP pin the INT output is connected to. Only used with the cache.
+  void set_interrupt_pin(GPIOPin *interrupt_pin) { interrupt_pin_ = interrupt_pin; }
+
+  static void gpio_intr(PCF8574Component *arg);
 
   /// Check i2c availability and setup masks
   void setup() override;
+  void loop() override;
+  bool is_loop_idle() override;
   /// Helper function to read the value of a pin.
   bool digital_read(uint8_t pin);
   /// Helper function to write the value of a pin.
@@ -44,6 +56,12 @@ class PCF8574Component : public Component, public i2c::I2CDevice {
   /// The state read in read_gpio_ - 1 means HIGH, 0 means LOW
   uint16_t input_mask_{0x00};
   bool pcf8575_;  ///< TRUE->16-channel PCF8575, FALSE->8-channel PCF8574
+  bool cache_{false};
+  GPIOPin *interrupt_pin_{nullptr};
+  /// Whether input_mask_ is still valid, until the next loop or interrupt.
+  bool input_valid_{false};
+  bool output_dirty_{false};
+  volatile bool interrupt_{false};
 };
 
 /// Helper class to expose a PCF8574 pin as an internal input GPIO pin.
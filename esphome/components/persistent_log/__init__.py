@@ -0,0 +1,45 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import api
+from esphome.components.logger import LOG_LEVELS, is_log_level
+from esphome.const import CONF_ID, CONF_LEVEL, CONF_SIZE
+from esphome.core import CORE
+from esphome.writer import ESP32_LOG_PARTITION_MAX_SIZE, KEY_ESP32_LOG_PARTITION_SIZE
+
+DEPENDENCIES = ['logger', 'api']
+
+persistent_log_ns = cg.esphome_ns.namespace('persistent_log')
+PersistentLogComponent = persistent_log_ns.class_('PersistentLogComponent', cg.Component)
+
+CONF_FLUSH_INTERVAL = 'flush_interval'
+SECTOR_SIZE = 4096
+
+
+def validate_size(value):
+    value = cv.validate_bytes(value)
+    # the partition is erased in whole sectors
+    value = (value + SECTOR_SIZE - 1) // SECTOR_SIZE * SECTOR_SIZE
+    if not 2 * SECTOR_SIZE <= value <= ESP32_LOG_PARTITION_MAX_SIZE:
+        raise cv.Invalid("The size must be between {} and {} bytes".format(2 * SECTOR_SIZE,
+                                                                          ESP32_LOG_PARTITION_MAX_SIZE))
+    return value
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
+    cv.GenerateID(): cv.declare_id(PersistentLogComponent),
+    cv.Optional(CONF_SIZE, default='64kB'): validate_size,
+    cv.Optional(CONF_LEVEL, default='INFO'): is_log_level,
+    cv.Optional(CONF_FLUSH_INTERVAL, default='60s'): cv.positive_time_period_milliseconds,
+}).extend(cv.COMPONENT_SCHEMA), cv.only_on_esp32)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_level(LOG_LEVELS[config[CONF_LEVEL]]))
+    cg.add(var.set_flush_interval(config[CONF_FLUSH_INTERVAL]))
+    # the records are encoded like the binary logs of the API, decoded with the same format table
+    api.enable_binary_logs()
+    CORE.data[KEY_ESP32_LOG_PARTITION_SIZE] = config[CONF_SIZE]
+    cg.add_define('USE_PERSISTENT_LOG')
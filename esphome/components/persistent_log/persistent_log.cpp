@@ -0,0 +1,314 @@
+#include "persistent_log.h"
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/components/api/binary_log.h"
+#include "esphome/components/logger/logger.h"
+#include <algorithm>
+#include <cstring>
+
+#include <esp_attr.h>
+#include <rom/rtc.h>
+
+namespace esphome {
+namespace persistent_log {
+
+static const char *TAG = "persistent_log";
+
+/// Must match the partition written by esphome/writer.py.
+static const char *PARTITION_LABEL = "logs";
+static const esp_partition_subtype_t PARTITION_SUBTYPE = static_cast<esp_partition_subtype_t>(0x9A);
+
+static const uint32_t SECTOR_MAGIC = 0x474F4C50;  // "PLOG"
+static const uint32_t SECTOR_HEADER_SIZE = 8;
+static const uint32_t RECORD_HEADER_SIZE = 14;
+static const size_t MAX_TAG_LENGTH = 32;
+static const uint16_t RECORD_END = 0xFFFF;
+
+struct PendingRecords {
+  uint32_t magic;
+  uint32_t size;
+  /// The inverted size, garbage after a power-on doesn't match it.
+  uint32_t check;
+  uint8_t data[PERSISTENT_LOG_PENDING_SIZE];
+};
+static RTC_NOINIT_ATTR PendingRecords rtc_pending;
+
+static void set_pending_size(uint32_t size) {
+  rtc_pending.magic = SECTOR_MAGIC;
+  rtc_pending.size = size;
+  rtc_pending.check = ~size;
+}
+static uint16_t record_size(const uint8_t *record) { return record[0] | (uint16_t(record[1]) << 8); }
+static void write_record_header(uint8_t *record, uint16_t size, uint8_t level, uint8_t tag_length, uint32_t time,
+                                uint32_t format_id, uint16_t line) {
+  record[0] = size;
+  record[1] = size >> 8;
+  record[2] = level;
+  record[3] = tag_length;
+  memcpy(record + 4, &time, 4);
+  memcpy(record + 8, &format_id, 4);
+  memcpy(record + 12, &line, 2);
+}
+
+PersistentLogComponent::PersistentLogComponent() { global_persistent_log = this; }
+
+void PersistentLogComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up persistent log...");
+  this->partition_ = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, PARTITION_SUBTYPE, PARTITION_LABEL);
+  if (this->partition_ == nullptr) {
+    ESP_LOGE(TAG, "The '%s' partition is missing, was the device flashed over USB after enabling it?",
+             PARTITION_LABEL);
+    this->mark_failed();
+    return;
+  }
+  this->sectors_ = this->partition_->size / PERSISTENT_LOG_SECTOR_SIZE;
+  this->lock_ = xSemaphoreCreateMutex();
+  this->load_();
+
+  // the records logged before a crash are still in RTC memory, they go before the boot marker
+  if (rtc_pending.magic != SECTOR_MAGIC || rtc_pending.check != ~rtc_pending.size ||
+      rtc_pending.size > PERSISTENT_LOG_PENDING_SIZE)
+    set_pending_size(0);
+  uint8_t marker[RECORD_HEADER_SIZE];
+  write_record_header(marker, RECORD_HEADER_SIZE, 0, 0, millis(), 0, rtc_get_reset_reason(0));
+  this->append_(marker, sizeof(marker));
+  this->last_flush_ = millis();
+
+  logger::global_logger->add_raw_log_callback(
+      [this](int level, const char *tag, int line, const char *format, va_list args) {
+        this->log_(level, tag, line, format, args);
+      });
+}
+
+void PersistentLogComponent::load_() {
+  // sector i holds the sequence numbers i, i + sectors_, ...; the oldest sector is erased for the next one
+  bool found = false;
+  for (uint32_t i = 0; i < this->sectors_; i++) {
+    uint32_t header[2];
+    if (esp_partition_read(this->partition_, i * PERSISTENT_LOG_SECTOR_SIZE, header, sizeof(header)) != ESP_OK)
+      continue;
+    if (header[0] != SECTOR_MAGIC || header[1] == 0 || header[1] % this->sectors_ != i)
+      continue;
+    if (!found || header[1] > this->sequence_)
+      this->sequence_ = header[1];
+    if (!found || header[1] < this->oldest_)
+      this->oldest_ = header[1];
+    found = true;
+  }
+  if (!found) {
+    // the first flush starts sector 1
+    this->sequence_ = 0;
+    this->oldest_ = 1;
+    this->used_ = PERSISTENT_LOG_SECTOR_SIZE;
+    return;
+  }
+
+  // continue after the last record of the newest sector
+  const uint32_t address = this->sector_address_(this->sequence_);
+  uint32_t offset = SECTOR_HEADER_SIZE;
+  while (offset + RECORD_HEADER_SIZE <= PERSISTENT_LOG_SECTOR_SIZE) {
+    uint8_t size_bytes[2];
+    if (esp_partition_read(this->partition_, address + offset, size_bytes, sizeof(size_bytes)) != ESP_OK)
+      break;
+    const uint16_t size = record_size(size_bytes);
+    if (size == RECORD_END)
+      break;
+    if (size < RECORD_HEADER_SIZE || offset + size > PERSISTENT_LOG_SECTOR_SIZE) {
+      // broken by a power loss during a write, don't append to it
+      offset = PERSISTENT_LOG_SECTOR_SIZE;
+      break;
+    }
+    offset += size;
+  }
+  this->used_ = offset;
+}
+
+uint32_t PersistentLogComponent::sector_address_(uint32_t sequence) const {
+  return (sequence % this->sectors_) * PERSISTENT_LOG_SECTOR_SIZE;
+}
+
+void HOT PersistentLogComponent::log_(int level, const char *tag, int line, const char *format, va_list args) {
+  if (level > this->level_)
+    return;
+  // flash operations may log, their lines can't be added while the pending records are written
+  if (xSemaphoreGetMutexHolder(this->lock_) == xTaskGetCurrentTaskHandle()) {
+    this->dropped_++;
+    return;
+  }
+
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  this->args_.clear();
+  api::encode_log_args(this->args_, format, args);
+  const uint32_t format_id = api::log_format_id(format);
+
+  uint8_t record[PERSISTENT_LOG_MAX_RECORD];
+  const size_t tag_length = std::min(strlen(tag), MAX_TAG_LENGTH);
+  // cut off arguments don't decode, the client shows the format with an error then
+  const size_t args_length = std::min(this->args_.size(), sizeof(record) - RECORD_HEADER_SIZE - tag_length);
+  const size_t size = RECORD_HEADER_SIZE + tag_length + args_length;
+  write_record_header(record, size, level, tag_length, millis(), format_id, line);
+  memcpy(record + RECORD_HEADER_SIZE, tag, tag_length);
+  memcpy(record + RECORD_HEADER_SIZE + tag_length, this->args_.data(), args_length);
+  const bool was_empty = rtc_pending.size == 0;
+  this->append_(record, size);
+  xSemaphoreGive(this->lock_);
+
+  if (was_empty)
+    App.wake_loop();
+}
+
+void PersistentLogComponent::append_(const uint8_t *record, size_t size) {
+  if (rtc_pending.size + size > PERSISTENT_LOG_PENDING_SIZE) {
+    this->dropped_++;
+    return;
+  }
+  memcpy(rtc_pending.data + rtc_pending.size, record, size);
+  set_pending_size(rtc_pending.size + size);
+}
+
+bool PersistentLogComponent::next_sector_() {
+  const uint32_t sequence = this->sequence_ + 1;
+  const uint32_t address = this->sector_address_(sequence);
+  if (esp_partition_erase_range(this->partition_, address, PERSISTENT_LOG_SECTOR_SIZE) != ESP_OK)
+    return false;
+  const uint32_t header[2] = {SECTOR_MAGIC, sequence};
+  if (esp_partition_write(this->partition_, address, header, sizeof(header)) != ESP_OK)
+    return false;
+  this->sequence_ = sequence;
+  this->used_ = SECTOR_HEADER_SIZE;
+  if (this->sequence_ - this->oldest_ >= this->sectors_)
+    this->oldest_ = this->sequence_ - this->sectors_ + 1;
+  return true;
+}
+
+bool PersistentLogComponent::flush_() {
+  const uint32_t pending = rtc_pending.size;
+  uint32_t at = 0;
+  bool ok = true;
+  while (at < pending) {
+    // the records that still fit into the current sector are written at once
+    uint32_t run = 0;
+    while (at + run < pending) {
+      const uint16_t size = record_size(rtc_pending.data + at + run);
+      if (size < RECORD_HEADER_SIZE || at + run + size > pending) {
+        // garbage, most likely from a reset during an append
+        ok = false;
+        break;
+      }
+      if (this->used_ + run + size > PERSISTENT_LOG_SECTOR_SIZE)
+        break;
+      run += size;
+    }
+    if (run == 0) {
+      if (!ok || !this->next_sector_()) {
+        ok = false;
+        break;
+      }
+      continue;
+    }
+    if (esp_partition_write(this->partition_, this->sector_address_(this->sequence_) + this->used_,
+                            rtc_pending.data + at, run) != ESP_OK) {
+      // the flash of this sector is in an unknown state now
+      this->used_ = PERSISTENT_LOG_SECTOR_SIZE;
+      ok = false;
+      break;
+    }
+    this->used_ += run;
+    at += run;
+    if (!ok)
+      break;
+  }
+  // failed records are dropped, they would fail again
+  set_pending_size(0);
+  this->last_flush_ = millis();
+  if (!ok)
+    this->flush_errors_++;
+  return ok;
+}
+
+void PersistentLogComponent::loop() {
+  const uint32_t pending = rtc_pending.size;
+  if (pending == 0)
+    return;
+  if (pending < PERSISTENT_LOG_PENDING_SIZE * 3 / 4 && millis() - this->last_flush_ < this->flush_interval_)
+    return;
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  const bool ok = this->flush_();
+  xSemaphoreGive(this->lock_);
+  if (!ok)
+    ESP_LOGW(TAG, "Writing the log records to flash failed");
+}
+
+bool PersistentLogComponent::is_loop_idle() {
+  // waiting for flush_interval needs polling, new records wake the loop
+  return this->is_failed() || rtc_pending.size == 0;
+}
+
+bool PersistentLogComponent::read(uint32_t &position, std::string &out, size_t max) {
+  if (this->lock_ == nullptr)
+    return true;
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  if (rtc_pending.size != 0)
+    this->flush_();
+
+  bool done = false;
+  while (true) {
+    if (position < this->oldest_ * PERSISTENT_LOG_SECTOR_SIZE + SECTOR_HEADER_SIZE)
+      position = this->oldest_ * PERSISTENT_LOG_SECTOR_SIZE + SECTOR_HEADER_SIZE;
+    const uint32_t sequence = position / PERSISTENT_LOG_SECTOR_SIZE;
+    const uint32_t offset = position % PERSISTENT_LOG_SECTOR_SIZE;
+    if (sequence > this->sequence_ || (sequence == this->sequence_ && offset >= this->used_)) {
+      done = true;
+      break;
+    }
+
+    const uint32_t next_sector = (sequence + 1) * PERSISTENT_LOG_SECTOR_SIZE + SECTOR_HEADER_SIZE;
+    const uint32_t end = sequence == this->sequence_ ? this->used_ : PERSISTENT_LOG_SECTOR_SIZE;
+    uint8_t size_bytes[2];
+    if (offset + RECORD_HEADER_SIZE > end ||
+        esp_partition_read(this->partition_, this->sector_address_(sequence) + offset, size_bytes,
+                           sizeof(size_bytes)) != ESP_OK) {
+      position = next_sector;
+      continue;
+    }
+    const uint16_t size = record_size(size_bytes);
+    if (size == RECORD_END || size < RECORD_HEADER_SIZE || offset + size > end) {
+      position = next_sector;
+      continue;
+    }
+    if (out.size() + size > max)
+      break;
+    const size_t at = out.size();
+    out.resize(at + size);
+    if (esp_partition_read(this->partition_, this->sector_address_(sequence) + offset, &out[at], size) != ESP_OK) {
+      out.resize(at);
+      position = next_sector;
+      continue;
+    }
+    position += size;
+  }
+  xSemaphoreGive(this->lock_);
+  return done;
+}
+
+void PersistentLogComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Persistent Log:");
+  if (this->partition_ == nullptr) {
+    ESP_LOGCONFIG(TAG, "  Partition '%s' not found!", PARTITION_LABEL);
+    return;
+  }
+  ESP_LOGCONFIG(TAG, "  Partition: 0x%06X, %u sectors", this->partition_->address, this->sectors_);
+  ESP_LOGCONFIG(TAG, "  Level: %d", this->level_);
+  ESP_LOGCONFIG(TAG, "  Flush Interval: %u ms", this->flush_interval_);
+  ESP_LOGCONFIG(TAG, "  Stored Sectors: %u", this->sequence_ + 1 - this->oldest_);
+  if (this->dropped_ != 0 || this->flush_errors_ != 0)
+    ESP_LOGCONFIG(TAG, "  Dropped Records: %u, Failed Writes: %u", this->dropped_, this->flush_errors_);
+}
+
+float PersistentLogComponent::get_setup_priority() const { return setup_priority::BUS; }
+
+PersistentLogComponent *global_persistent_log = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace persistent_log
+}  // namespace esphome
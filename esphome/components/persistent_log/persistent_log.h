@@ -0,0 +1,90 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include <cstdarg>
+#include <string>
+#include <vector>
+
+#include <esp_partition.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+namespace esphome {
+namespace persistent_log {
+
+/// The flash is erased in sectors, each one holds a header and whole records.
+static const uint32_t PERSISTENT_LOG_SECTOR_SIZE = 4096;
+/// Records waiting for the next flash write, kept in RTC memory so that they survive a crash.
+static const size_t PERSISTENT_LOG_PENDING_SIZE = 2048;
+/// The largest record, longer arguments are cut off.
+static const size_t PERSISTENT_LOG_MAX_RECORD = 256;
+
+/** Keeps the log messages in a ring of flash sectors, so that they can be read after a reset.
+ *
+ * Messages are stored unformatted like the binary logs of the API: the format string id and the encoded arguments.
+ * They are collected in RTC memory and written in batches. RTC memory keeps them through resets and deep sleep, so
+ * the records logged right before a crash are written at the next boot. Each boot starts with a marker record that
+ * carries the reset reason.
+ *
+ * Sector layout, little endian: the magic (uint32_t) and the sequence number of the sector (uint32_t), then the
+ * records. Each record has its size (uint16_t, including this header), the level, the length of the tag, the uptime
+ * in ms (uint32_t), the format id (uint32_t) and the line (uint16_t), followed by the tag and the arguments. Boot
+ * markers have level 0 and the reset reason as line. Unwritten flash reads as 0xFF, which ends a sector.
+ */
+class PersistentLogComponent : public Component {
+ public:
+  PersistentLogComponent();
+
+  void set_level(int level) { this->level_ = level; }
+  /// Set the longest time records wait in RTC memory before they are written.
+  void set_flush_interval(uint32_t flush_interval) { this->flush_interval_ = flush_interval; }
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+  bool is_loop_idle() override;
+
+  /** Copy whole records to out, starting at position, until max bytes are reached.
+   *
+   * Positions count the bytes of all sectors ever written, 0 starts at the oldest record that is still stored.
+   * Pending records are written first. Returns true if the newest record has been read, otherwise position is the
+   * start of the next record. May be called from any task.
+   */
+  bool read(uint32_t &position, std::string &out, size_t max);
+
+  uint32_t get_dropped() const { return this->dropped_; }
+
+ protected:
+  void log_(int level, const char *tag, int line, const char *format, va_list args);
+  void append_(const uint8_t *record, size_t size);
+  /// Write the pending records to flash, the lock must be held.
+  bool flush_();
+  /// Start the next sector, erasing its oldest records.
+  bool next_sector_();
+  /// Find the newest sector and its end.
+  void load_();
+  uint32_t sector_address_(uint32_t sequence) const;
+
+  const esp_partition_t *partition_{nullptr};
+  SemaphoreHandle_t lock_{nullptr};
+  int level_;
+  uint32_t flush_interval_;
+  uint32_t sectors_{0};
+  /// The sequence number of the sector records are written to, and of the oldest one still stored.
+  uint32_t sequence_{0};
+  uint32_t oldest_{0};
+  /// The bytes written to the current sector, including its header.
+  uint32_t used_{0};
+  uint32_t last_flush_{0};
+  uint32_t dropped_{0};
+  uint32_t flush_errors_{0};
+  /// Reused for the encoded arguments of each message.
+  std::vector<uint8_t> args_;
+};
+
+extern PersistentLogComponent *global_persistent_log;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace persistent_log
+}  // namespace esphome
@@ -23,6 +23,8 @@ CONF_POSITIVE_OUTPUT = 'positive_output'
 CONF_NEGATIVE_OUTPUT = 'negative_output'
 CONF_MIN_INTEGRAL = 'min_integral'
 CONF_MAX_INTEGRAL = 'max_integral'
+CONF_DERIVATIVE_FILTER = 'derivative_filter'
+CONF_CONTROL_INTERVAL = 'control_interval'
 
 CONFIG_SCHEMA = cv.All(climate.CLIMATE_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(PIDClimate),
@@ -36,7 +38,10 @@ CONFIG_SCHEMA = cv.All(climate.CLIMATE_SCHEMA.extend({
         cv.Optional(CONF_KD, default=0.0): cv.float_,
         cv.Optional(CONF_MIN_INTEGRAL, default=-1): cv.float_,
         cv.Optional(CONF_MAX_INTEGRAL, default=1): cv.float_,
+        cv.Optional(CONF_DERIVATIVE_FILTER): cv.positive_time_period_milliseconds,
     }),
+    cv.Optional(CONF_CONTROL_INTERVAL): cv.All(cv.positive_time_period_milliseconds,
+                                               cv.Range(min=cv.TimePeriod(milliseconds=100))),
 }), cv.has_at_least_one_key(CONF_COOL_OUTPUT, CONF_HEAT_OUTPUT))
 
 
@@ -62,6 +67,10 @@ def to_code(config):
         cg.add(var.set_min_integral(params[CONF_MIN_INTEGRAL]))
     if CONF_MAX_INTEGRAL in params:
         cg.add(var.set_max_integral(params[CONF_MAX_INTEGRAL]))
+    if CONF_DERIVATIVE_FILTER in params:
+        cg.add(var.set_derivative_filter(params[CONF_DERIVATIVE_FILTER]))
+    if CONF_CONTROL_INTERVAL in config:
+        cg.add(var.set_control_interval(config[CONF_CONTROL_INTERVAL]))
 
     cg.add(var.set_default_target_temperature(config[CONF_DEFAULT_TARGET_TEMPERATURE]))
 
@@ -9,11 +9,18 @@ static const char *TAG = "pid.climate";
 void PIDClimate::setup() {
   this->sensor_->add_on_state_callback([this](float state) {
     // only publish if state/current temperature has changed in two digits of precision
-    this->do_publish_ = roundf(state * 100) != roundf(this->current_temperature * 100);
+    this->do_publish_ |= roundf(state * 100) != roundf(this->current_temperature * 100);
     this->current_temperature = state;
-    this->update_pid_();
+    // with a fixed control interval only the latest value is sampled by the control loop
+    if (this->control_interval_ == 0)
+      this->update_pid_(NAN);
   });
   this->current_temperature = this->sensor_->state;
+  // the integral doesn't wind up past what the outputs can do
+  this->controller_.min_output = this->supports_cool_() ? -1.0f : 0.0f;
+  this->controller_.max_output = this->supports_heat_() ? 1.0f : 0.0f;
+  if (this->control_interval_ != 0)
+    this->set_interval("control", this->control_interval_, [this]() { this->control_tick_(); });
   // restore set points
   auto restore = this->restore_state_();
   if (restore.has_value()) {
@@ -50,6 +57,12 @@ void PIDClimate::dump_config() {
   LOG_CLIMATE("", "PID Climate", this);
   ESP_LOGCONFIG(TAG, "  Control Parameters:");
   ESP_LOGCONFIG(TAG, "    kp: %.5f, ki: %.5f, kd: %.5f", controller_.kp, controller_.ki, controller_.kd);
+  if (this->controller_.derivative_filter > 0.0f)
+    ESP_LOGCONFIG(TAG, "    Derivative Filter: %.1fs", this->controller_.derivative_filter);
+  if (this->control_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Control Interval: %ums", this->control_interval_);
+    ESP_LOGCONFIG(TAG, "  Max Control Jitter: %dms", this->max_control_jitter_);
+  }
 
   if (this->autotuner_ != nullptr) {
     this->autotuner_->dump_config();
@@ -101,7 +114,21 @@ void PIDClimate::handle_non_auto_mode_() {
     assert(false);
   }
 }
-void PIDClimate::update_pid_() {
+void PIDClimate::control_tick_() {
+  const uint32_t now = millis();
+  float dt = 0.0f;
+  if (this->last_control_ != 0) {
+    // the scheduler keeps the phase of intervals, so any deviation is the main loop running late
+    const uint32_t elapsed = now - this->last_control_;
+    this->control_jitter_ = int32_t(elapsed - this->control_interval_);
+    this->max_control_jitter_ = std::max(this->max_control_jitter_, this->control_jitter_);
+    // integrate over the time that really passed
+    dt = elapsed / 1000.0f;
+  }
+  this->last_control_ = now;
+  this->update_pid_(dt);
+}
+void PIDClimate::update_pid_(float dt) {
   float value;
   if (isnan(this->current_temperature) || isnan(this->target_temperature)) {
     // if any control parameters are nan, turn off all outputs
@@ -109,7 +136,11 @@ void PIDClimate::update_pid_() {
   } else {
     // Update PID controller irrespective of current mode, to not mess up D/I terms
     // In non-auto mode, we just discard the output value
-    value = this->controller_.update(this->target_temperature, this->current_temperature);
+    if (isnan(dt)) {
+      value = this->controller_.update(this->target_temperature, this->current_temperature);
+    } else {
+      value = this->controller_.update(this->target_temperature, this->current_temperature, dt);
+    }
 
     // Check autotuner
     if (this->autotuner_ != nullptr && !this->autotuner_->is_finished()) {
@@ -134,8 +165,10 @@ void PIDClimate::update_pid_() {
     this->write_output_(value);
   }
 
-  if (this->do_publish_)
+  if (this->do_publish_) {
+    this->do_publish_ = false;
     this->publish_state();
+  }
 }
 void PIDClimate::start_autotune(std::unique_ptr<PIDAutotuner> &&autotune) {
   this->autotuner_ = std::move(autotune);
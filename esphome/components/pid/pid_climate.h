@@ -26,6 +26,9 @@ class PIDClimate : public climate::Climate, public Component {
   void set_kd(float kd) { controller_.kd = kd; }
   void set_min_integral(float min_integral) { controller_.min_integral = min_integral; }
   void set_max_integral(float max_integral) { controller_.max_integral = max_integral; }
+  void set_derivative_filter(uint32_t derivative_filter) { controller_.derivative_filter = derivative_filter / 1000.0f; }
+  /// Run the controller at this fixed interval in ms instead of on every sensor update, 0 to disable.
+  void set_control_interval(uint32_t control_interval) { control_interval_ = control_interval; }
 
   float get_output_value() const { return output_value_; }
   float get_error_value() const { return controller_.error; }
@@ -35,6 +38,8 @@ class PIDClimate : public climate::Climate, public Component {
   float get_proportional_term() const { return controller_.proportional_term; }
   float get_integral_term() const { return controller_.integral_term; }
   float get_derivative_term() const { return controller_.derivative_term; }
+  /// How much later than the control interval the last fixed-rate update ran, in ms.
+  int32_t get_control_jitter() const { return control_jitter_; }
   void add_on_pid_computed_callback(std::function<void()> &&callback) {
     pid_computed_callback_.add(std::move(callback));
   }
@@ -50,7 +55,13 @@ class PIDClimate : public climate::Climate, public Component {
   /// Return the traits of this controller.
   climate::ClimateTraits traits() override;
 
-  void update_pid_();
+  /** Run the controller on the latest temperature and write the outputs.
+   *
+   * @param dt The time since the previous update in seconds, NAN to let the controller measure it.
+   */
+  void update_pid_(float dt);
+  /// The update of the fixed-rate control loop.
+  void control_tick_();
 
   bool supports_cool_() const { return this->cool_output_ != nullptr; }
   bool supports_heat_() const { return this->heat_output_ != nullptr; }
@@ -69,6 +80,10 @@ class PIDClimate : public climate::Climate, public Component {
   float default_target_temperature_;
   std::unique_ptr<PIDAutotuner> autotuner_;
   bool do_publish_ = false;
+  uint32_t control_interval_ = 0;
+  uint32_t last_control_ = 0;
+  int32_t control_jitter_ = 0;
+  int32_t max_control_jitter_ = 0;
 };
 
 template<typename... Ts> class PIDAutotuneAction : public Action<Ts...> {
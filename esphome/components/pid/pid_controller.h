@@ -7,13 +7,16 @@ namespace pid {
 
 struct PIDController {
   float update(float setpoint, float process_value) {
+    return this->update(setpoint, process_value, calculate_relative_time_());
+  }
+
+  /// Run the controller with the given time since the previous update in seconds, for fixed-rate control loops.
+  float update(float setpoint, float process_value, float dt) {
     // e(t) ... error at timestamp t
     // r(t) ... setpoint
     // y(t) ... process value (sensor reading)
     // u(t) ... output value
 
-    float dt = calculate_relative_time_();
-
     // e(t) := r(t) - y(t)
     error = setpoint - process_value;
 
@@ -21,21 +24,32 @@ struct PIDController {
     proportional_term = kp * error;
 
     // i(t) := K_i * \int_{0}^{t} e(t) dt
-    accumulated_integral_ += error * dt * ki;
+    float integral = accumulated_integral_ + error * dt * ki;
     // constrain accumulated integral value
-    if (!isnan(min_integral) && accumulated_integral_ < min_integral)
-      accumulated_integral_ = min_integral;
-    if (!isnan(max_integral) && accumulated_integral_ > max_integral)
-      accumulated_integral_ = max_integral;
-    integral_term = accumulated_integral_;
+    if (!isnan(min_integral) && integral < min_integral)
+      integral = min_integral;
+    if (!isnan(max_integral) && integral > max_integral)
+      integral = max_integral;
 
     // d(t) := K_d * de(t)/dt
     float derivative = 0.0f;
     if (dt != 0.0f)
       derivative = (error - previous_error_) / dt;
     previous_error_ = error;
+    // first order low-pass, the difference of noisy readings is amplified by 1/dt
+    if (derivative_filter > 0.0f)
+      derivative = filtered_derivative_ + (derivative - filtered_derivative_) * dt / (derivative_filter + dt);
+    filtered_derivative_ = derivative;
     derivative_term = kd * derivative;
 
+    // anti-windup: while the output is saturated, don't integrate further in the direction of the saturation
+    const float output = proportional_term + integral + derivative_term;
+    const bool saturated_high = !isnan(max_output) && output > max_output && integral > accumulated_integral_;
+    const bool saturated_low = !isnan(min_output) && output < min_output && integral < accumulated_integral_;
+    if (!saturated_high && !saturated_low)
+      accumulated_integral_ = integral;
+    integral_term = accumulated_integral_;
+
     // u(t) := p(t) + i(t) + d(t)
     return proportional_term + integral_term + derivative_term;
   }
@@ -51,6 +65,11 @@ struct PIDController {
 
   float min_integral = NAN;
   float max_integral = NAN;
+  /// The range of the output the integral is wound up to at most, NAN for no limit.
+  float min_output = NAN;
+  float max_output = NAN;
+  /// Time constant of the low-pass filter on the derivative in seconds, 0 for no filtering.
+  float derivative_filter = 0;
 
   // Store computed values in struct so that values can be monitored through sensors
   float error;
@@ -74,6 +93,8 @@ struct PIDController {
   float previous_error_ = 0;
   /// Accumulated integral value
   float accumulated_integral_ = 0;
+  /// Derivative after the low-pass filter from the previous update
+  float filtered_derivative_ = 0;
   uint32_t last_time_ = 0;
 };
 
@@ -18,6 +18,7 @@ PID_CLIMATE_SENSOR_TYPES = {
     'KP': PIDClimateSensorType.PID_SENSOR_TYPE_KP,
     'KI': PIDClimateSensorType.PID_SENSOR_TYPE_KI,
     'KD': PIDClimateSensorType.PID_SENSOR_TYPE_KD,
+    'CONTROL_JITTER': PIDClimateSensorType.PID_SENSOR_TYPE_CONTROL_JITTER,
 }
 
 CONF_CLIMATE_ID = 'climate_id'
@@ -47,6 +47,9 @@ void PIDClimateSensor::update_from_parent_() {
       value = this->parent_->get_kd();
       this->publish_state(value);
       return;
+    case PID_SENSOR_TYPE_CONTROL_JITTER:
+      this->publish_state(this->parent_->get_control_jitter());
+      return;
     default:
       value = NAN;
       break;
@@ -17,6 +17,7 @@ enum PIDClimateSensorType {
   PID_SENSOR_TYPE_KP,
   PID_SENSOR_TYPE_KI,
   PID_SENSOR_TYPE_KD,
+  PID_SENSOR_TYPE_CONTROL_JITTER,
 };
 
 class PIDClimateSensor : public sensor::Sensor, public Component {
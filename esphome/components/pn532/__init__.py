@@ -1,8 +1,8 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome import automation
+from esphome import automation, pins
 from esphome.components import nfc
-from esphome.const import CONF_ID, CONF_ON_TAG, CONF_TRIGGER_ID
+from esphome.const import CONF_ID, CONF_ON_TAG, CONF_TRIGGER_ID, CONF_IRQ_PIN
 from esphome.core import coroutine
 
 CODEOWNERS = ['@OttoWinter', '@jesserockz']
@@ -11,6 +11,7 @@ MULTI_CONF = True
 
 CONF_PN532_ID = 'pn532_id'
 CONF_ON_FINISHED_WRITE = 'on_finished_write'
+CONF_AUTO_POLL = 'auto_poll'
 
 pn532_ns = cg.esphome_ns.namespace('pn532')
 PN532 = pn532_ns.class_('PN532', cg.PollingComponent)
@@ -22,8 +23,18 @@ PN532OnFinishedWriteTrigger = pn532_ns.class_('PN532OnFinishedWriteTrigger',
 
 PN532IsWritingCondition = pn532_ns.class_('PN532IsWritingCondition', automation.Condition)
 
+
+def validate_auto_poll(config):
+    # The PN532 only responds once it has found a tag, which isn't polled for over the bus
+    if config[CONF_AUTO_POLL] and CONF_IRQ_PIN not in config:
+        raise cv.Invalid("auto_poll requires the irq_pin")
+    return config
+
+
 PN532_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(PN532),
+    cv.Optional(CONF_IRQ_PIN): pins.gpio_input_pin_schema,
+    cv.Optional(CONF_AUTO_POLL, default=False): cv.boolean,
     cv.Optional(CONF_ON_TAG): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(PN532OnTagTrigger),
     }),
@@ -43,6 +54,11 @@ def CONFIG_SCHEMA(conf):
 def setup_pn532(var, config):
     yield cg.register_component(var, config)
 
+    if CONF_IRQ_PIN in config:
+        pin = yield cg.gpio_pin_expression(config[CONF_IRQ_PIN])
+        cg.add(var.set_irq_pin(pin))
+    cg.add(var.set_auto_poll(config[CONF_AUTO_POLL]))
+
     for conf in config.get(CONF_ON_TAG, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID])
         cg.add(var.register_trigger(trigger))
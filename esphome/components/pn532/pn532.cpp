@@ -1,5 +1,6 @@
 #include "pn532.h"
 #include "esphome/core/log.h"
+#include "esphome/core/application.h"
 
 // Based on:
 // - https://cdn-shop.adafruit.com/datasheets/PN532C106_Application+Note_v1.2.pdf
@@ -72,56 +73,112 @@ void PN532::setup() {
     return;
   }
 
+  if (this->irq_pin_ != nullptr) {
+    this->irq_pin_->setup();
+    this->irq_pin_->attach_interrupt(PN532::gpio_intr, this, FALLING);
+  }
+
+  if (this->auto_poll_) {
+    if (!this->start_scan_())
+      ESP_LOGW(TAG, "Starting to poll for tags failed!");
+    return;
+  }
   this->turn_off_rf_();
 }
 
+void ICACHE_RAM_ATTR PN532::gpio_intr(PN532 *arg) { Application::wake_loop_isr(); }
+
 void PN532::update() {
   for (auto *obj : this->binary_sensors_)
     obj->on_scan_end();
+  if (!this->tag_seen_) {
+    // the tag has left the field, process it again when it comes back
+    this->current_uid_.clear();
+  }
+  this->tag_seen_ = false;
 
-  if (!this->write_command_({
-          PN532_COMMAND_INLISTPASSIVETARGET,
-          0x01,  // max 1 card
-          0x00,  // baud rate ISO14443A (106 kbit/s)
-      })) {
+  if (this->auto_poll_ && this->requested_read_) {
+    // the PN532 is still polling
+    return;
+  }
+  if (!this->start_scan_()) {
     ESP_LOGW(TAG, "Requesting tag read failed!");
     this->status_set_warning();
     return;
   }
   this->status_clear_warning();
-  this->requested_read_ = true;
+}
+
+bool PN532::start_scan_() {
+  bool success;
+  if (this->auto_poll_) {
+    const uint8_t command[] = {
+        PN532_COMMAND_INAUTOPOLL,
+        0xFF,  // poll until a tag is found
+        0x01,  // 150ms between the polls
+        0x10,  // Mifare cards (ISO14443A, 106 kbit/s)
+    };
+    success = this->write_command_(command, sizeof(command));
+    this->scan_command_ = PN532_COMMAND_INAUTOPOLL;
+  } else {
+    const uint8_t command[] = {
+        PN532_COMMAND_INLISTPASSIVETARGET,
+        0x01,  // max 1 card
+        0x00,  // baud rate ISO14443A (106 kbit/s)
+    };
+    success = this->write_command_(command, sizeof(command));
+    this->scan_command_ = PN532_COMMAND_INLISTPASSIVETARGET;
+  }
+  this->requested_read_ = success;
+  return success;
 }
 
 void PN532::loop() {
   if (!this->requested_read_)
     return;
+  // the IRQ pin goes low once the response is ready
+  if (this->irq_pin_ != nullptr && this->irq_pin_->digital_read())
+    return;
+
+  this->process_scan_();
+}
+
+bool PN532::is_loop_idle() {
+  return !this->requested_read_ || (this->irq_pin_ != nullptr && this->irq_pin_->digital_read());
+}
 
-  std::vector<uint8_t> read;
-  bool success = this->read_response(PN532_COMMAND_INLISTPASSIVETARGET, read);
+void PN532::process_scan_() {
+  std::vector<uint8_t> &read = this->scan_response_;
+  bool success = this->read_response(this->scan_command_, read);
 
   this->requested_read_ = false;
 
   if (!success) {
     // Something failed
-    this->current_uid_ = {};
-    this->turn_off_rf_();
+    this->current_uid_.clear();
+    if (!this->auto_poll_)
+      this->turn_off_rf_();
     return;
   }
 
   uint8_t num_targets = read[0];
   if (num_targets != 1) {
     // no tags found or too many
-    this->current_uid_ = {};
-    this->turn_off_rf_();
+    this->current_uid_.clear();
+    if (!this->auto_poll_)
+      this->turn_off_rf_();
     return;
   }
 
-  uint8_t nfcid_length = read[5];
-  std::vector<uint8_t> nfcid(read.begin() + 6, read.begin() + 6 + nfcid_length);
-  if (read.size() < 6U + nfcid_length) {
+  // InAutoPoll reports the type and the length of the target data before the data of InListPassiveTarget
+  const size_t offset = this->scan_command_ == PN532_COMMAND_INAUTOPOLL ? 2 : 0;
+  if (read.size() < offset + 6U || read.size() < offset + 6U + read[offset + 5]) {
     // oops, pn532 returned invalid data
     return;
   }
+  uint8_t nfcid_length = read[offset + 5];
+  std::vector<uint8_t> nfcid(read.begin() + offset + 6, read.begin() + offset + 6 + nfcid_length);
+  this->tag_seen_ = true;
 
   bool report = true;
   for (auto *bin_sens : this->binary_sensors_) {
@@ -130,16 +187,12 @@ void PN532::loop() {
     }
   }
 
-  if (nfcid.size() == this->current_uid_.size()) {
-    bool same_uid = false;
-    for (uint8_t i = 0; i < nfcid.size(); i++)
-      same_uid |= nfcid[i] == this->current_uid_[i];
-    if (same_uid)
-      return;
+  if (nfcid == this->current_uid_) {
+    // the tag stays in the field, it has been processed already
+    return;
   }
 
   this->current_uid_ = nfcid;
-
   if (next_task_ == READ) {
     auto tag = this->read_tag_(nfcid);
     for (auto *trigger : this->triggers_)
@@ -189,42 +242,53 @@ void PN532::loop() {
 
   this->read_mode();
 
+  if (this->auto_poll_) {
+    // look for the next tag right away
+    this->start_scan_();
+    return;
+  }
   this->turn_off_rf_();
 }
 
-bool PN532::write_command_(const std::vector<uint8_t> &data) {
-  std::vector<uint8_t> write_data;
+bool PN532::write_command_(const uint8_t *data, uint8_t len) {
+  // preamble, start code, LEN, LCS, TFI, DCS and postamble around the data
+  if (len + 8 > PN532_MAX_COMMAND_FRAME) {
+    ESP_LOGE(TAG, "Command 0x%02X is too long", data[0]);
+    return false;
+  }
+  uint8_t frame[PN532_MAX_COMMAND_FRAME];
+  uint8_t pos = 0;
   // Preamble
-  write_data.push_back(0x00);
+  frame[pos++] = 0x00;
 
   // Start code
-  write_data.push_back(0x00);
-  write_data.push_back(0xFF);
+  frame[pos++] = 0x00;
+  frame[pos++] = 0xFF;
 
   // Length of message, TFI + data bytes
-  const uint8_t real_length = data.size() + 1;
+  const uint8_t real_length = len + 1;
   // LEN
-  write_data.push_back(real_length);
+  frame[pos++] = real_length;
   // LCS (Length checksum)
-  write_data.push_back(~real_length + 1);
+  frame[pos++] = ~real_length + 1;
 
   // TFI (Frame Identifier, 0xD4 means to PN532, 0xD5 means from PN532)
-  write_data.push_back(0xD4);
+  frame[pos++] = 0xD4;
   // calculate checksum, TFI is part of checksum
   uint8_t checksum = 0xD4;
 
   // DATA
-  for (uint8_t dat : data) {
-    write_data.push_back(dat);
-    checksum += dat;
+  for (uint8_t i = 0; i < len; i++) {
+    frame[pos++] = data[i];
+    checksum += data[i];
   }
 
   // DCS (Data checksum)
-  write_data.push_back(~checksum + 1);
+  frame[pos++] = ~checksum + 1;
   // Postamble
-  write_data.push_back(0x00);
+  frame[pos++] = 0x00;
 
-  this->write_data(write_data);
+  this->write_data(frame, pos);
 
   return this->read_ack_();
 }
@@ -232,7 +296,7 @@ bool PN532::write_command_(const std::vector<uint8_t> &data) {
 bool PN532::read_ack_() {
   ESP_LOGV(TAG, "Reading ACK...");
 
-  std::vector<uint8_t> data;
+  uint8_t data[7];
   if (!this->read_data(data, 6)) {
     return false;
   }
@@ -247,17 +311,19 @@ bool PN532::read_ack_() {
 
 void PN532::send_nack_() {
   ESP_LOGV(TAG, "Sending NACK for retransmit");
-  this->write_data({0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00});
+  const uint8_t nack[] = {0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00};
+  this->write_data(nack, sizeof(nack));
   delay(10);
 }
 
 void PN532::turn_off_rf_() {
   ESP_LOGV(TAG, "Turning RF field OFF");
-  this->write_command_({
+  const uint8_t command[] = {
       PN532_COMMAND_RFCONFIGURATION,
       0x01,  // RF Field
       0x00,  // Off
-  });
+  };
+  this->write_command_(command, sizeof(command));
 }
 
 nfc::NfcTag *PN532::read_tag_(std::vector<uint8_t> &uid) {
@@ -344,6 +410,8 @@ void PN532::dump_config() {
   }
 
   LOG_UPDATE_INTERVAL(this);
+  LOG_PIN("  IRQ Pin: ", this->irq_pin_);
+  ESP_LOGCONFIG(TAG, "  Auto Poll: %s", YESNO(this->auto_poll_));
 
   for (auto *child : this->binary_sensors_) {
     LOG_BINARY_SENSOR("  ", "Tag", child);
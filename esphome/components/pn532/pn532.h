@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/esphal.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #include "esphome/components/nfc/nfc_tag.h"
 #include "esphome/components/nfc/nfc.h"
@@ -14,6 +15,10 @@ static const uint8_t PN532_COMMAND_SAMCONFIGURATION = 0x14;
 static const uint8_t PN532_COMMAND_RFCONFIGURATION = 0x32;
 static const uint8_t PN532_COMMAND_INDATAEXCHANGE = 0x40;
 static const uint8_t PN532_COMMAND_INLISTPASSIVETARGET = 0x4A;
+static const uint8_t PN532_COMMAND_INAUTOPOLL = 0x60;
+
+/// The largest command frame that is sent, preamble to postamble, enough for writing a Mifare Classic block.
+static const uint8_t PN532_MAX_COMMAND_FRAME = 64;
 
 class PN532BinarySensor;
 class PN532OnTagTrigger;
@@ -28,6 +33,12 @@ class PN532 : public PollingComponent {
   float get_setup_priority() const override;
 
   void loop() override;
+  bool is_loop_idle() override;
+
+  /// The IRQ pin, which is low while a response is ready, so that it isn't polled over the bus.
+  void set_irq_pin(GPIOPin *irq_pin) { this->irq_pin_ = irq_pin; }
+  /// Let the PN532 poll for tags by itself with InAutoPoll, it only responds when it has found one.
+  void set_auto_poll(bool auto_poll) { this->auto_poll_ = auto_poll; }
 
   void register_tag(PN532BinarySensor *tag) { this->binary_sensors_.push_back(tag); }
   void register_trigger(PN532OnTagTrigger *trig) { this->triggers_.push_back(trig); }
@@ -45,12 +56,18 @@ class PN532 : public PollingComponent {
 
  protected:
   void turn_off_rf_();
-  bool write_command_(const std::vector<uint8_t> &data);
+  bool write_command_(const std::vector<uint8_t> &data) { return this->write_command_(data.data(), data.size()); }
+  bool write_command_(const uint8_t *data, uint8_t len);
   bool read_ack_();
   void send_nack_();
-
-  virtual bool write_data(const std::vector<uint8_t> &data) = 0;
-  virtual bool read_data(std::vector<uint8_t> &data, uint8_t len) = 0;
+  /// Start searching for a tag, with InListPassiveTarget or InAutoPoll.
+  bool start_scan_();
+  /// Process the tag found by the scan.
+  void process_scan_();
+
+  virtual bool write_data(const uint8_t *data, uint8_t len) = 0;
+  /// Read the ready byte and len bytes into data, which has room for len + 1 bytes.
+  virtual bool read_data(uint8_t *data, uint8_t len) = 0;
   virtual bool read_response(uint8_t command, std::vector<uint8_t> &data) = 0;
 
   nfc::NfcTag *read_tag_(std::vector<uint8_t> &uid);
@@ -76,10 +93,21 @@ class PN532 : public PollingComponent {
   bool write_mifare_ultralight_tag_(std::vector<uint8_t> &uid, nfc::NdefMessage *message);
   bool clean_mifare_ultralight_();
 
+  static void gpio_intr(PN532 *arg);
+
+  GPIOPin *irq_pin_{nullptr};
+  bool auto_poll_{false};
   bool requested_read_{false};
+  /// The command that requested_read_ waits for.
+  uint8_t scan_command_{PN532_COMMAND_INLISTPASSIVETARGET};
+  /// Reused for the scan responses, so that they don't allocate.
+  std::vector<uint8_t> scan_response_;
   std::vector<PN532BinarySensor *> binary_sensors_;
   std::vector<PN532OnTagTrigger *> triggers_;
+  /// The last tag that was processed, it isn't processed again while it stays in the field.
   std::vector<uint8_t> current_uid_;
+  /// Whether a tag has been found since the last update.
+  bool tag_seen_{false};
   nfc::NdefMessage *next_task_message_to_write_;
   enum NfcTask {
     READ = 0,
@@ -11,17 +11,16 @@ namespace pn532_i2c {
 
 static const char *TAG = "pn532_i2c";
 
-bool PN532I2C::write_data(const std::vector<uint8_t> &data) { return this->write_bytes_raw(data.data(), data.size()); }
+bool PN532I2C::write_data(const uint8_t *data, uint8_t len) { return this->write_bytes_raw(data, len); }
 
-bool PN532I2C::read_data(std::vector<uint8_t> &data, uint8_t len) {
+bool PN532I2C::read_data(uint8_t *data, uint8_t len) {
   delay(1);
 
-  std::vector<uint8_t> ready;
-  ready.resize(1);
+  uint8_t ready;
   uint32_t start_time = millis();
   while (true) {
-    if (this->read_bytes_raw(ready.data(), 1)) {
-      if (ready[0] == 0x01)
+    if (this->read_bytes_raw(&ready, 1)) {
+      if (ready == 0x01)
         break;
     }
 
@@ -31,8 +30,7 @@ bool PN532I2C::read_data(std::vector<uint8_t> &data, uint8_t len) {
     }
   }
 
-  data.resize(len + 1);
-  this->read_bytes_raw(data.data(), len + 1);
+  this->read_bytes_raw(data, len + 1);
   return true;
 }
 
@@ -44,7 +42,8 @@ bool PN532I2C::read_response(uint8_t command, std::vector<uint8_t> &data) {
   }
 
   ESP_LOGV(TAG, "Reading response of length %d", len);
-  if (!this->read_data(data, 6 + len + 2)) {
+  data.resize(6 + len + 2 + 1);
+  if (!this->read_data(data.data(), 6 + len + 2)) {
     ESP_LOGD(TAG, "No response data");
     return false;
   }
@@ -90,7 +89,7 @@ bool PN532I2C::read_response(uint8_t command, std::vector<uint8_t> &data) {
 }
 
 uint8_t PN532I2C::read_response_length_() {
-  std::vector<uint8_t> data;
+  uint8_t data[7];
   if (!this->read_data(data, 6)) {
     return 0;
   }
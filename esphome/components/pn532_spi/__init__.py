@@ -12,7 +12,7 @@ PN532Spi = pn532_spi_ns.class_('PN532Spi', pn532.PN532, spi.SPIDevice)
 
 CONFIG_SCHEMA = cv.All(pn532.PN532_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(PN532Spi),
-}).extend(spi.spi_device_schema(cs_pin_required=True)))
+}).extend(spi.spi_device_schema(cs_pin_required=True)), pn532.validate_auto_poll)
 
 
 def to_code(config):
@@ -21,19 +21,19 @@ void PN532Spi::setup() {
   PN532::setup();
 }
 
-bool PN532Spi::write_data(const std::vector<uint8_t> &data) {
+bool PN532Spi::write_data(const uint8_t *data, uint8_t len) {
   this->enable();
   delay(2);
   // First byte, communication mode: Write data
   this->write_byte(0x01);
-  ESP_LOGV(TAG, "Writing data: %s", hexencode(data).c_str());
-  this->write_array(data.data(), data.size());
+  ESP_LOGV(TAG, "Writing data: %s", hexencode(data, len).c_str());
+  this->write_array(data, len);
   this->disable();
 
   return true;
 }
 
-bool PN532Spi::read_data(std::vector<uint8_t> &data, uint8_t len) {
+bool PN532Spi::read_data(uint8_t *data, uint8_t len) {
   ESP_LOGV(TAG, "Waiting for ready byte...");
 
   uint32_t start_time = millis();
@@ -61,11 +61,10 @@ bool PN532Spi::read_data(std::vector<uint8_t> &data, uint8_t len) {
 
   ESP_LOGV(TAG, "Reading data...");
 
-  data.resize(len);
-  this->read_array(data.data(), len);
+  data[0] = 0x01;
+  this->read_array(data + 1, len);
   this->disable();
-  data.insert(data.begin(), 0x01);
-  ESP_LOGV(TAG, "Read data: %s", hexencode(data).c_str());
+  ESP_LOGV(TAG, "Read data: %s", hexencode(data, len + 1).c_str());
   return true;
 }
 
@@ -94,10 +93,10 @@ bool PN532Spi::read_response(uint8_t command, std::vector<uint8_t> &data) {
   delay(2);
   this->write_byte(0x03);
 
-  std::vector<uint8_t> header(7);
-  this->read_array(header.data(), 7);
+  uint8_t header[7];
+  this->read_array(header, 7);
 
-  ESP_LOGV(TAG, "Header data: %s", hexencode(header).c_str());
+  ESP_LOGV(TAG, "Header data: %s", hexencode(header, 7).c_str());
 
   if (header[0] != 0x00 && header[1] != 0x00 && header[2] != 0xFF) {
     // invalid packet
@@ -0,0 +1,70 @@
+import os
+import re
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.const import CONF_ID
+from esphome.core import CORE, EsphomeError
+from esphome.writer import get_esp8266_ld_script
+
+CODEOWNERS = ['@esphome/core']
+
+CONF_FLASH_SECTORS = 'flash_sectors'
+CONF_FLASH_WRITE_INTERVAL = 'flash_write_interval'
+
+preferences_ns = cg.esphome_ns.namespace('preferences')
+IntervalSyncer = preferences_ns.class_('IntervalSyncer', cg.Component)
+
+
+def validate_flash_sectors(value):
+    value = cv.int_range(min=1, max=8)(value)
+    if value > 1 and not CORE.is_esp8266:
+        raise cv.Invalid("Rotating across flash sectors is only supported on the ESP8266, "
+                         "the ESP32 NVS does its own wear levelling.")
+    return value
+
+
+ESP8266_FLASH_SECTOR_SIZE = 4096
+# eagle.flash.<flash size><filesystem size>.ld, for example eagle.flash.4m1m.ld or eagle.flash.1m64.ld
+LD_SCRIPT_RE = re.compile(r'^eagle\.flash\.\d+[km](\d*)([km]?)\.ld$')
+
+
+def get_ld_script_fs_size(ld_script):
+    """The size of the filesystem area an ESP8266 linker script reserves in bytes, 0 if none or unknown."""
+    match = LD_SCRIPT_RE.match(os.path.basename(ld_script))
+    if match is None or not match.group(1):
+        return 0
+    return int(match.group(1)) * (1024 * 1024 if match.group(2) == 'm' else 1024)
+
+
+def validate_flash_sectors_area(sectors):
+    # The extra sectors are the last ones of the filesystem area, they must not end up in the OTA space
+    ld_script = get_esp8266_ld_script()
+    fs_size = 0 if ld_script is None else get_ld_script_fs_size(ld_script)
+    if fs_size < (sectors - 1) * ESP8266_FLASH_SECTOR_SIZE:
+        raise EsphomeError("flash_sectors: {} writes to the last {} sectors of the filesystem area, but the linker "
+                           "script {} doesn't reserve one that large. Select a linker script with a filesystem "
+                           "that is not used otherwise, for example with 'board_build.ldscript: "
+                           "eagle.flash.4m1m.ld' in platformio_options."
+                           "".format(sectors, sectors - 1, ld_script or "(board default)"))
+
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(IntervalSyncer),
+    cv.Optional(CONF_FLASH_WRITE_INTERVAL, default='1min'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_FLASH_SECTORS, default=1): validate_flash_sectors,
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    if config[CONF_FLASH_SECTORS] > 1:
+        validate_flash_sectors_area(config[CONF_FLASH_SECTORS])
+        cg.add_define('USE_ESP8266_PREFERENCES_FLASH_SECTORS', config[CONF_FLASH_SECTORS])
+
+    if config[CONF_FLASH_WRITE_INTERVAL].total_milliseconds == 0:
+        # write through on every save
+        return
+    cg.add_define('USE_PREFERENCES_DEFERRED_WRITES')
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+    cg.add(var.set_write_interval(config[CONF_FLASH_WRITE_INTERVAL]))
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
+
+namespace esphome {
+namespace preferences {
+
+/// Periodically commits the preferences that have been saved since the last commit, and once more before shutdown.
+class IntervalSyncer : public Component {
+ public:
+  void set_write_interval(uint32_t write_interval) { this->write_interval_ = write_interval; }
+  void setup() override {
+    this->set_interval(this->write_interval_, []() { global_preferences.sync(); });
+  }
+  void on_shutdown() override { global_preferences.sync(); }
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+ protected:
+  uint32_t write_interval_{60000};
+};
+
+}  // namespace preferences
+}  // namespace esphome
@@ -1,310 +1,457 @@
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
 
+#ifdef USE_WIFI
+#include "esphome/components/wifi/wifi_component.h"
+#endif
+#ifdef USE_API
+#include "esphome/components/api/api_connection.h"
+#endif
+
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain");
+/// Append a string from PROGMEM.
+static void append_progmem(std::string &out, const __FlashStringHelper *str) {
+  PGM_P p = reinterpret_cast<PGM_P>(str);
+  const size_t len = strlen_P(p);
+  const size_t start = out.size();
+  out.resize(start + len);
+  memcpy_P(&out[start], p, len);
+}
+/// Append a label value, escaping backslashes, double quotes and line breaks.
+static void append_label_value(std::string &out, const std::string &value) {
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
+}
+/// Append the metric name and the opening labels of a row.
+static void begin_row(std::string &out, const __FlashStringHelper *metric, const std::string &labels) {
+  append_progmem(out, metric);
+  out += labels;
+}
+static void append_float(std::string &out, float value) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%.2f", value);
+  out += buffer;
+}
+static void append_uint(std::string &out, uint32_t value) {
+  char buffer[12];
+  snprintf(buffer, sizeof(buffer), "%u", value);
+  out += buffer;
+}
 
+void PrometheusHandler::setup() {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
+  this->add_header_(F("#TYPE esphome_sensor_value GAUGE\n"
+                      "#TYPE esphome_sensor_failed GAUGE\n"));
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+    this->add_row_(ROW_SENSOR, obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
+  this->add_header_(F("#TYPE esphome_binary_sensor_value GAUGE\n"
+                      "#TYPE esphome_binary_sensor_failed GAUGE\n"));
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+    this->add_row_(ROW_BINARY_SENSOR, obj);
 #endif
 
 #ifdef USE_FAN
-  this->fan_type_(stream);
+  this->add_header_(F("#TYPE esphome_fan_value GAUGE\n"
+                      "#TYPE esphome_fan_failed GAUGE\n"
+                      "#TYPE esphome_fan_speed GAUGE\n"
+                      "#TYPE esphome_fan_oscillation GAUGE\n"));
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+    this->add_row_(ROW_FAN, obj);
 #endif
 
 #ifdef USE_LIGHT
-  this->light_type_(stream);
+  this->add_header_(F("#TYPE esphome_light_state GAUGE\n"
+                      "#TYPE esphome_light_color GAUGE\n"
+                      "#TYPE esphome_light_effect_active GAUGE\n"));
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+    this->add_row_(ROW_LIGHT, obj);
 #endif
 
 #ifdef USE_COVER
-  this->cover_type_(stream);
+  this->add_header_(F("#TYPE esphome_cover_value GAUGE\n"
+                      "#TYPE esphome_cover_failed GAUGE\n"));
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+    this->add_row_(ROW_COVER, obj);
 #endif
 
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
+  this->add_header_(F("#TYPE esphome_switch_value GAUGE\n"
+                      "#TYPE esphome_switch_failed GAUGE\n"));
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+    this->add_row_(ROW_SWITCH, obj);
 #endif
 
-  req->send(stream);
-}
+  this->rows_.push_back(Row{ROW_INTERNAL, nullptr, ""});
+#ifdef USE_PROFILER
+  this->rows_.push_back(Row{ROW_PROFILER, nullptr, ""});
+#endif
 
-// Type-specific implementation
-#ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
+  this->base_->init();
+  this->base_->add_handler(this);
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
+void PrometheusHandler::add_header_(const __FlashStringHelper *text) {
+  Row row{ROW_HEADER, nullptr, ""};
+  append_progmem(row.labels, text);
+  this->rows_.push_back(std::move(row));
+}
+void PrometheusHandler::add_row_(RowType type, Nameable *obj) {
   if (obj->is_internal())
     return;
+  Row row{type, obj, "{id=\""};
+  append_label_value(row.labels, obj->get_object_id());
+  row.labels += "\",name=\"";
+  append_label_value(row.labels, obj->get_name());
+  row.labels += '"';
+  this->rows_.push_back(std::move(row));
+}
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  struct MetricsState {
+    size_t row{0};
+    std::string buffer;
+    size_t pos{0};
+    bool done{false};
+  };
+  std::shared_ptr<MetricsState> state = std::make_shared<MetricsState>();
+  AsyncWebServerResponse *response = req->beginChunkedResponse(
+      "text/plain; version=0.0.4", [this, state](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        size_t written = 0;
+        while (written < max_len) {
+          if (state->pos == state->buffer.size()) {
+            if (state->done)
+              break;
+            state->buffer.clear();
+            state->pos = 0;
+            if (!this->write_row_(state->row++, state->buffer)) {
+              state->done = true;
+              break;
+            }
+          }
+          const size_t len = std::min(max_len - written, state->buffer.size() - state->pos);
+          memcpy(buffer + written, state->buffer.data() + state->pos, len);
+          state->pos += len;
+          written += len;
+        }
+        return written;
+      });
+  req->send(response);
+}
+
+bool PrometheusHandler::write_row_(size_t row, std::string &out) {
+  if (row >= this->rows_.size())
+    return false;
+  const Row &entry = this->rows_[row];
+  switch (entry.type) {
+    case ROW_HEADER:
+      out += entry.labels;
+      break;
+#ifdef USE_SENSOR
+    case ROW_SENSOR:
+      this->sensor_row_(out, static_cast<sensor::Sensor *>(entry.obj), entry.labels);
+      break;
+#endif
+#ifdef USE_BINARY_SENSOR
+    case ROW_BINARY_SENSOR:
+      this->binary_sensor_row_(out, static_cast<binary_sensor::BinarySensor *>(entry.obj), entry.labels);
+      break;
+#endif
+#ifdef USE_FAN
+    case ROW_FAN:
+      this->fan_row_(out, static_cast<fan::FanState *>(entry.obj), entry.labels);
+      break;
+#endif
+#ifdef USE_LIGHT
+    case ROW_LIGHT:
+      this->light_row_(out, static_cast<light::LightState *>(entry.obj), entry.labels);
+      break;
+#endif
+#ifdef USE_COVER
+    case ROW_COVER:
+      this->cover_row_(out, static_cast<cover::Cover *>(entry.obj), entry.labels);
+      break;
+#endif
+#ifdef USE_SWITCH
+    case ROW_SWITCH:
+      this->switch_row_(out, static_cast<switch_::Switch *>(entry.obj), entry.labels);
+      break;
+#endif
+    case ROW_INTERNAL:
+      this->internal_rows_(out);
+      break;
+#ifdef USE_PROFILER
+    case ROW_PROFILER:
+      this->profiler_rows_(out);
+      break;
+#endif
+    default:
+      break;
+  }
+  return true;
+}
+
+void PrometheusHandler::internal_rows_(std::string &out) {
+  append_progmem(out, F("#TYPE esphome_free_heap_bytes GAUGE\n"
+                        "esphome_free_heap_bytes "));
+  append_uint(out, ESP.getFreeHeap());
+  out += '\n';
+
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component->is_connected()) {
+    append_progmem(out, F("#TYPE esphome_wifi_rssi_dbm GAUGE\n"
+                          "esphome_wifi_rssi_dbm "));
+    out += to_string(int(WiFi.RSSI()));
+    out += '\n';
+  }
+#endif
+
+#ifdef USE_API
+  append_progmem(out, F("#TYPE esphome_api_send_queue_frames GAUGE\n"
+                        "#TYPE esphome_api_send_queue_bytes GAUGE\n"));
+  for (auto *client : api::global_api_server->get_clients()) {
+    std::string labels = "{client=\"";
+    append_label_value(labels, client->get_client_info());
+    labels += '"';
+    begin_row(out, F("esphome_api_send_queue_frames"), labels);
+    out += "} ";
+    append_uint(out, client->get_send_queue_frames());
+    out += '\n';
+    begin_row(out, F("esphome_api_send_queue_bytes"), labels);
+    out += "} ";
+    append_uint(out, client->get_send_queue_bytes());
+    out += '\n';
+  }
+#endif
+}
+
+// Type-specific implementation
+#ifdef USE_SENSOR
+void PrometheusHandler::sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels) {
   if (!isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    begin_row(out, F("esphome_sensor_failed"), labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print('\n');
+    begin_row(out, F("esphome_sensor_value"), labels);
+    out += ",unit=\"";
+    append_label_value(out, obj->get_unit_of_measurement());
+    out += "\"} ";
+    out += value_accuracy_to_string(obj->state, obj->get_accuracy_decimals());
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    begin_row(out, F("esphome_sensor_failed"), labels);
+    out += "} 1\n";
   }
 }
 #endif
 
-// Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
-}
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj,
+                                           const std::string &labels) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    begin_row(out, F("esphome_binary_sensor_failed"), labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print('\n');
+    begin_row(out, F("esphome_binary_sensor_value"), labels);
+    out += "} ";
+    out += obj->state ? '1' : '0';
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    begin_row(out, F("esphome_binary_sensor_failed"), labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
-}
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::FanState *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::fan_row_(std::string &out, fan::FanState *obj, const std::string &labels) {
+  begin_row(out, F("esphome_fan_failed"), labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  begin_row(out, F("esphome_fan_value"), labels);
+  out += "} ";
+  out += obj->state ? '1' : '0';
+  out += '\n';
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print('\n');
+    begin_row(out, F("esphome_fan_speed"), labels);
+    out += "} ";
+    append_uint(out, obj->speed);
+    out += '\n';
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print('\n');
+    begin_row(out, F("esphome_fan_oscillation"), labels);
+    out += "} ";
+    out += obj->oscillating ? '1' : '0';
+    out += '\n';
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_color GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
-}
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::light_row_(std::string &out, light::LightState *obj, const std::string &labels) {
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  begin_row(out, F("esphome_light_state"), labels);
+  out += "} ";
+  out += obj->remote_values.is_on() ? '1' : '0';
+  out += '\n';
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  const char *channels[] = {"brightness", "r", "g", "b", "w"};
+  const float values[] = {brightness, r, g, b, w};
+  for (uint8_t i = 0; i < 5; i++) {
+    begin_row(out, F("esphome_light_color"), labels);
+    out += ",channel=\"";
+    out += channels[i];
+    out += "\"} ";
+    append_float(out, values[i]);
+    out += '\n';
+  }
   // Effect
   std::string effect = obj->get_effect_name();
-  if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
-  } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
-  }
+  begin_row(out, F("esphome_light_effect_active"), labels);
+  out += ",effect=\"";
+  append_label_value(out, effect);
+  out += effect == "None" ? "\"} 0\n" : "\"} 1\n";
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
-}
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::cover_row_(std::string &out, cover::Cover *obj, const std::string &labels) {
   if (!isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
+    begin_row(out, F("esphome_cover_failed"), labels);
+    out += "} 0\n";
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print('\n');
+    begin_row(out, F("esphome_cover_value"), labels);
+    out += "} ";
+    append_float(out, obj->position);
+    out += '\n';
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(obj->get_object_id().c_str());
-      stream->print(F("\",name=\""));
-      stream->print(obj->get_name().c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print('\n');
+      begin_row(out, F("esphome_cover_tilt"), labels);
+      out += "} ";
+      append_float(out, obj->tilt);
+      out += '\n';
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    begin_row(out, F("esphome_cover_failed"), labels);
+    out += "} 1\n";
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
-}
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels) {
+  begin_row(out, F("esphome_switch_failed"), labels);
+  out += "} 0\n";
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+  begin_row(out, F("esphome_switch_value"), labels);
+  out += "} ";
+  out += obj->state ? '1' : '0';
+  out += '\n';
+}
+#endif
+
+#ifdef USE_PROFILER
+void PrometheusHandler::profiler_rows_(std::string &out) {
+  append_progmem(out, F("#TYPE esphome_loop_time_us histogram\n"));
+  this->profiler_histogram_(out, "esphome_loop_time_us", "", global_profiler.get_loop());
+  append_progmem(out, F("#TYPE esphome_loop_jitter_us histogram\n"));
+  this->profiler_histogram_(out, "esphome_loop_jitter_us", "", global_profiler.get_loop_jitter());
+
+  append_progmem(out, F("#TYPE esphome_component_setup_time_us GAUGE\n"));
+  for (auto *profile : global_profiler.get_components()) {
+    if (profile->name == nullptr)
+      continue;
+    append_progmem(out, F("esphome_component_setup_time_us{component=\""));
+    out += profile->name;
+    out += "\"} ";
+    append_uint(out, profile->setup_us);
+    out += '\n';
+  }
+  append_progmem(out, F("#TYPE esphome_component_loop_time_us histogram\n"));
+  for (auto *profile : global_profiler.get_components()) {
+    if (profile->name == nullptr || profile->loop.count == 0)
+      continue;
+    std::string labels = "component=\"" + std::string(profile->name) + "\"";
+    this->profiler_histogram_(out, "esphome_component_loop_time_us", labels, profile->loop);
+  }
+  append_progmem(out, F("#TYPE esphome_scheduler_time_us histogram\n"));
+  for (auto *profile : global_profiler.get_scheduler()) {
+    const char *component = global_profiler.get_component_name(profile->component);
+    if (component == nullptr || profile->name.empty())
+      continue;
+    std::string labels = "component=\"" + std::string(component) + "\",name=\"";
+    append_label_value(labels, profile->name);
+    labels += '"';
+    this->profiler_histogram_(out, "esphome_scheduler_time_us", labels, profile->stats);
+  }
+}
+void PrometheusHandler::profiler_histogram_(std::string &out, const char *metric, const std::string &labels,
+                                            const ProfilerStats &stats) {
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i <= PROFILER_BUCKETS; i++) {
+    out += metric;
+    out += "_bucket{";
+    if (!labels.empty()) {
+      out += labels;
+      out += ',';
+    }
+    out += "le=\"";
+    if (i == PROFILER_BUCKETS) {
+      cumulative = stats.count;
+      out += "+Inf";
+    } else {
+      cumulative += stats.buckets[i];
+      append_uint(out, ProfilerStats::bucket_limit(i));
+    }
+    out += "\"} ";
+    append_uint(out, cumulative);
+    out += '\n';
+  }
+  out += metric;
+  out += "_sum";
+  if (!labels.empty()) {
+    out += '{';
+    out += labels;
+    out += '}';
+  }
+  out += ' ';
+  // total_us is 64-bit
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%.0f", double(stats.total_us));
+  out += buffer;
+  out += '\n';
+  out += metric;
+  out += "_count";
+  if (!labels.empty()) {
+    out += '{';
+    out += labels;
+    out += '}';
+  }
+  out += ' ';
+  append_uint(out, stats.count);
+  out += '\n';
 }
 #endif
 
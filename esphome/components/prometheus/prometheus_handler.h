@@ -3,6 +3,10 @@
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/component.h"
+#include "esphome/core/profiler.h"
+
+#include <string>
+#include <vector>
 
 namespace esphome {
 namespace prometheus {
@@ -20,61 +24,82 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
     return false;
   }
 
+  /// Stream the metrics in chunks, one entity at a time, so that the response never has to be in memory at once.
   void handleRequest(AsyncWebServerRequest *req) override;
 
-  void setup() override {
-    this->base_->init();
-    this->base_->add_handler(this);
-  }
+  void setup() override;
   float get_setup_priority() const override {
     // After WiFi
     return setup_priority::WIFI - 1.0f;
   }
+  ComponentAffinity get_affinity() const override { return COMPONENT_AFFINITY_NETWORK; }
 
  protected:
+  enum RowType : uint8_t {
+    /// The #TYPE lines of a section, the text is in labels.
+    ROW_HEADER,
+    ROW_SENSOR,
+    ROW_BINARY_SENSOR,
+    ROW_FAN,
+    ROW_LIGHT,
+    ROW_COVER,
+    ROW_SWITCH,
+    /// Heap, WiFi and API metrics of the node itself.
+    ROW_INTERNAL,
+    ROW_PROFILER,
+  };
+  struct Row {
+    RowType type;
+    Nameable *obj;
+    /// The opening brace and the id and name labels, computed once at setup.
+    std::string labels;
+  };
+
+  void add_header_(const __FlashStringHelper *text);
+  void add_row_(RowType type, Nameable *obj);
+  /// Append the metrics of one row, false once all rows are written.
+  bool write_row_(size_t row, std::string &out);
+  void internal_rows_(std::string &out);
+
 #ifdef USE_SENSOR
-  /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj);
+  void sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels);
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
   /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj);
+  void binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj, const std::string &labels);
 #endif
 
 #ifdef USE_FAN
-  /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
   /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::FanState *obj);
+  void fan_row_(std::string &out, fan::FanState *obj, const std::string &labels);
 #endif
 
 #ifdef USE_LIGHT
-  /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
   /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj);
+  void light_row_(std::string &out, light::LightState *obj, const std::string &labels);
 #endif
 
 #ifdef USE_COVER
-  /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
   /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj);
+  void cover_row_(std::string &out, cover::Cover *obj, const std::string &labels);
 #endif
 
 #ifdef USE_SWITCH
-  /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
   /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
+  void switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels);
+#endif
+
+#ifdef USE_PROFILER
+  /// Return the main loop and per-component timing collected by the profiler
+  void profiler_rows_(std::string &out);
+  void profiler_histogram_(std::string &out, const char *metric, const std::string &labels,
+                           const ProfilerStats &stats);
 #endif
 
   web_server_base::WebServerBase *base_;
+  std::vector<Row> rows_;
 };
 
 }  // namespace prometheus
@@ -1,5 +1,10 @@
 #include "pulse_counter_sensor.h"
 #include "esphome/core/log.h"
+#include "esphome/core/application.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <soc/pcnt_struct.h>
+#endif
 
 namespace esphome {
 namespace pulse_counter {
@@ -8,7 +13,6 @@ static const char *TAG = "pulse_counter";
 
 const char *EDGE_MODE_TO_STRING[] = {"DISABLE", "INCREMENT", "DECREMENT"};
 
-#ifdef ARDUINO_ARCH_ESP8266
 void ICACHE_RAM_ATTR PulseCounterStorage::gpio_intr(PulseCounterStorage *arg) {
   const uint32_t now = micros();
   const bool discard = now - arg->last_pulse < arg->filter_us;
@@ -17,17 +21,53 @@ void ICACHE_RAM_ATTR PulseCounterStorage::gpio_intr(PulseCounterStorage *arg) {
     return;
 
   PulseCounterCountMode mode = arg->isr_pin->digital_read() ? arg->rising_edge_mode : arg->falling_edge_mode;
-  switch (mode) {
-    case PULSE_COUNTER_DISABLE:
-      break;
-    case PULSE_COUNTER_INCREMENT:
-      arg->counter++;
-      break;
-    case PULSE_COUNTER_DECREMENT:
-      arg->counter--;
-      break;
+  if (mode == PULSE_COUNTER_DISABLE)
+    return;
+#ifdef ARDUINO_ARCH_ESP8266
+  // on the ESP32 the PCNT unit counts, the interrupt is only there for the edge times
+  if (mode == PULSE_COUNTER_INCREMENT) {
+    arg->counter++;
+  } else {
+    arg->counter--;
+  }
+#endif
+  if (arg->edge_times != nullptr) {
+    arg->edge_times[arg->edge_count % arg->edge_times_size] = now;
+    arg->edge_count++;
+    App.wake_loop_isr();
   }
 }
+void PulseCounterStorage::set_period_samples(uint8_t samples) {
+  // one more slot than needed, so the oldest sample survives an edge that arrives while the rate is computed
+  this->edge_times_size = samples + 1;
+  this->edge_times = new uint32_t[this->edge_times_size];
+}
+optional<float> PulseCounterStorage::read_period_rate() {
+  const uint32_t count = this->edge_count;
+  const uint32_t samples = std::min<uint32_t>(count, this->edge_times_size - 1);
+  if (samples < 2)
+    return {};
+  const uint32_t newest = this->edge_times[(count - 1) % this->edge_times_size];
+  const uint32_t oldest = this->edge_times[(count - samples) % this->edge_times_size];
+  if (this->edge_count - count > 1 || newest == oldest)
+    // the oldest sample was overwritten
+    return {};
+  return 60000000.0f * (samples - 1) / float(newest - oldest);
+}
+bool PulseCounterStorage::read_last_edge(uint32_t *count, uint32_t *time) {
+  uint32_t edge_count;
+  do {
+    edge_count = this->edge_count;
+    if (edge_count == 0)
+      return false;
+    *time = this->edge_times[(edge_count - 1) % this->edge_times_size];
+    // an edge that arrived in between could have overwritten the value
+  } while (edge_count != this->edge_count);
+  *count = edge_count;
+  return true;
+}
+
+#ifdef ARDUINO_ARCH_ESP8266
 bool PulseCounterStorage::pulse_counter_setup(GPIOPin *pin) {
   this->pin = pin;
   this->pin->setup();
@@ -44,6 +84,17 @@ pulse_counter_t PulseCounterStorage::read_raw_value() {
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
+/// The PCNT unit is cleared and the interrupt accumulates its count when it reaches this value.
+static const int16_t PCNT_LIMIT = 32000;
+
+void ICACHE_RAM_ATTR PulseCounterStorage::pcnt_intr(void *arg) {
+  auto *storage = reinterpret_cast<PulseCounterStorage *>(arg);
+  const uint32_t status = PCNT.status_unit[storage->pcnt_unit].val;
+  if (status & PCNT_STATUS_H_LIM_M)
+    storage->pcnt_overflow += PCNT_LIMIT;
+  if (status & PCNT_STATUS_L_LIM_M)
+    storage->pcnt_overflow -= PCNT_LIMIT;
+}
 bool PulseCounterStorage::pulse_counter_setup(GPIOPin *pin) {
   this->pin = pin;
   this->pin->setup();
@@ -83,8 +134,8 @@ bool PulseCounterStorage::pulse_counter_setup(GPIOPin *pin) {
       .hctrl_mode = PCNT_MODE_KEEP,
       .pos_mode = rising,
       .neg_mode = falling,
-      .counter_h_lim = 0,
-      .counter_l_lim = 0,
+      .counter_h_lim = PCNT_LIMIT,
+      .counter_l_lim = -PCNT_LIMIT,
       .unit = this->pcnt_unit,
       .channel = PCNT_CHANNEL_0,
   };
@@ -109,6 +160,26 @@ bool PulseCounterStorage::pulse_counter_setup(GPIOPin *pin) {
     }
   }
 
+  // the 16 bit counter is extended in the limit interrupt, it doesn't have to be read before it wraps
+  error = pcnt_isr_service_install(0);
+  if (error != ESP_OK && error != ESP_ERR_INVALID_STATE) {
+    // already installed by another pulse counter is fine
+    ESP_LOGE(TAG, "Installing PCNT interrupt service failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  error = pcnt_isr_handler_add(this->pcnt_unit, PulseCounterStorage::pcnt_intr, this);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Adding PCNT interrupt handler failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  pcnt_event_enable(this->pcnt_unit, PCNT_EVT_H_LIM);
+  pcnt_event_enable(this->pcnt_unit, PCNT_EVT_L_LIM);
+
+  if (this->edge_times != nullptr) {
+    this->isr_pin = this->pin->to_isr();
+    this->pin->attach_interrupt(PulseCounterStorage::gpio_intr, this, CHANGE);
+  }
+
   error = pcnt_counter_pause(this->pcnt_unit);
   if (error != ESP_OK) {
     ESP_LOGE(TAG, "Pausing pulse counter failed: %s", esp_err_to_name(error));
@@ -127,8 +198,13 @@ bool PulseCounterStorage::pulse_counter_setup(GPIOPin *pin) {
   return true;
 }
 pulse_counter_t PulseCounterStorage::read_raw_value() {
-  pulse_counter_t counter;
-  pcnt_get_counter_value(this->pcnt_unit, &counter);
+  pulse_counter_t overflow;
+  int16_t value;
+  do {
+    overflow = this->pcnt_overflow;
+    pcnt_get_counter_value(this->pcnt_unit, &value);
+  } while (overflow != this->pcnt_overflow);
+  pulse_counter_t counter = overflow + value;
   pulse_counter_t ret = counter - this->last_value;
   this->last_value = counter;
   return ret;
@@ -141,6 +217,13 @@ void PulseCounterSensor::setup() {
     this->mark_failed();
     return;
   }
+
+  if (this->restore_total_) {
+    this->total_pref_ = global_preferences.make_preference<uint32_t>(this->get_object_id_hash());
+    this->total_pref_.load(&this->current_total_);
+    if (this->total_sensor_ != nullptr)
+      this->total_sensor_->publish_state(this->current_total_);
+  }
 }
 
 void PulseCounterSensor::dump_config() {
@@ -149,20 +232,53 @@ void PulseCounterSensor::dump_config() {
   ESP_LOGCONFIG(TAG, "  Rising Edge: %s", EDGE_MODE_TO_STRING[this->storage_.rising_edge_mode]);
   ESP_LOGCONFIG(TAG, "  Falling Edge: %s", EDGE_MODE_TO_STRING[this->storage_.falling_edge_mode]);
   ESP_LOGCONFIG(TAG, "  Filtering pulses shorter than %u µs", this->storage_.filter_us);
+  if (this->storage_.edge_times != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Rate from the period of the last %u pulses", this->storage_.edge_times_size - 1);
+  }
   LOG_UPDATE_INTERVAL(this);
 }
 
+bool PulseCounterSensor::is_loop_idle() {
+  return this->storage_.edge_times == nullptr || this->storage_.edge_count == this->last_edge_count_;
+}
+void PulseCounterSensor::loop() {
+  if (this->is_loop_idle())
+    return;
+
+  this->last_edge_count_ = this->storage_.edge_count;
+  auto rate = this->storage_.read_period_rate();
+  if (!rate.has_value())
+    return;
+  this->last_rate_at_ = millis();
+  this->publish_state(*rate);
+}
+
 void PulseCounterSensor::update() {
   pulse_counter_t raw = this->storage_.read_raw_value();
-  float value = (60000.0f * raw) / float(this->get_update_interval());  // per minute
+  if (this->storage_.edge_times == nullptr) {
+    float value = (60000.0f * raw) / float(this->get_update_interval());  // per minute
 
-  ESP_LOGD(TAG, "'%s': Retrieved counter: %0.2f pulses/min", this->get_name().c_str(), value);
-  this->publish_state(value);
+    ESP_LOGD(TAG, "'%s': Retrieved counter: %0.2f pulses/min", this->get_name().c_str(), value);
+    this->publish_state(value);
+  } else if (raw == 0) {
+    // Without new pulses the rate published with the last one gets stale, it can't be higher than one pulse
+    // in the time since then.
+    if (this->last_rate_at_ == 0) {
+      this->publish_state(0.0f);
+    } else {
+      const float value = 60000.0f / float(millis() - this->last_rate_at_);
+      if (std::isnan(this->state) || value < this->state)
+        this->publish_state(value);
+    }
+  }
 
   if (this->total_sensor_ != nullptr) {
     current_total_ += raw;
     ESP_LOGD(TAG, "'%s': Total : %i pulses", this->get_name().c_str(), current_total_);
     this->total_sensor_->publish_state(current_total_);
+    // with deferred preference writes this only marks the total dirty, it's committed with the next batch
+    if (this->restore_total_ && raw != 0)
+      this->total_pref_.save(&this->current_total_);
   }
 }
 
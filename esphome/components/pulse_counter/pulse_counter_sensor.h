@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/esphal.h"
+#include "esphome/core/preferences.h"
 #include "esphome/components/sensor/sensor.h"
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -17,31 +18,41 @@ enum PulseCounterCountMode {
   PULSE_COUNTER_DECREMENT,
 };
 
-#ifdef ARDUINO_ARCH_ESP32
-using pulse_counter_t = int16_t;
-#endif
-#ifdef ARDUINO_ARCH_ESP8266
 using pulse_counter_t = int32_t;
-#endif
 
 struct PulseCounterStorage {
   bool pulse_counter_setup(GPIOPin *pin);
   pulse_counter_t read_raw_value();
+  /** Store the times of the last edges, so the rate can be computed from the period between them.
+   *
+   * Must be called before pulse_counter_setup().
+   */
+  void set_period_samples(uint8_t samples);
+  /// Pulses per minute from the period of the last edges, empty if there aren't two yet.
+  optional<float> read_period_rate();
+  /// The number of counted edges and the time of the newest one, false if there wasn't any yet.
+  bool read_last_edge(uint32_t *count, uint32_t *time);
 
   static void gpio_intr(PulseCounterStorage *arg);
 
 #ifdef ARDUINO_ARCH_ESP8266
   volatile pulse_counter_t counter{0};
-  volatile uint32_t last_pulse{0};
 #endif
+  volatile uint32_t last_pulse{0};
 
   GPIOPin *pin;
 #ifdef ARDUINO_ARCH_ESP32
+  static void pcnt_intr(void *arg);
+
   pcnt_unit_t pcnt_unit;
+  /// Counts of the PCNT unit that were cleared when it reached one of its limits.
+  volatile pulse_counter_t pcnt_overflow{0};
 #endif
-#ifdef ARDUINO_ARCH_ESP8266
-  ISRInternalGPIOPin *isr_pin;
-#endif
+  ISRInternalGPIOPin *isr_pin{nullptr};
+  /// The times (in micros) of the last counted edges, a ring indexed by edge_count.
+  volatile uint32_t *edge_times{nullptr};
+  uint8_t edge_times_size{0};
+  volatile uint32_t edge_count{0};
   PulseCounterCountMode rising_edge_mode{PULSE_COUNTER_INCREMENT};
   PulseCounterCountMode falling_edge_mode{PULSE_COUNTER_DISABLE};
   uint32_t filter_us{0};
@@ -55,9 +66,15 @@ class PulseCounterSensor : public sensor::Sensor, public PollingComponent {
   void set_falling_edge_mode(PulseCounterCountMode mode) { storage_.falling_edge_mode = mode; }
   void set_filter_us(uint32_t filter) { storage_.filter_us = filter; }
   void set_total_sensor(sensor::Sensor *total_sensor) { total_sensor_ = total_sensor; }
+  /// Publish the rate after every pulse, averaged over the period of the last samples edges.
+  void set_period_samples(uint8_t samples) { storage_.set_period_samples(samples); }
+  /// Keep the total across reboots.
+  void set_restore_total(bool restore_total) { restore_total_ = restore_total; }
 
   /// Unit of measurement is "pulses/min".
   void setup() override;
+  void loop() override;
+  bool is_loop_idle() override;
   void update() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   void dump_config() override;
@@ -66,7 +83,12 @@ class PulseCounterSensor : public sensor::Sensor, public PollingComponent {
   GPIOPin *pin_;
   PulseCounterStorage storage_;
   uint32_t current_total_ = 0;
-  sensor::Sensor *total_sensor_;
+  sensor::Sensor *total_sensor_{nullptr};
+  bool restore_total_{false};
+  ESPPreferenceObject total_pref_;
+  /// The edge count the rate was last published for.
+  uint32_t last_edge_count_{0};
+  uint32_t last_rate_at_{0};
 };
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -3,10 +3,12 @@ import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import sensor
 from esphome.const import CONF_COUNT_MODE, CONF_FALLING_EDGE, CONF_ID, CONF_INTERNAL_FILTER, \
-    CONF_PIN, CONF_RISING_EDGE, CONF_NUMBER, CONF_TOTAL, \
+    CONF_PIN, CONF_RISING_EDGE, CONF_NUMBER, CONF_TOTAL, CONF_RESTORE, \
     ICON_PULSE, UNIT_PULSES_PER_MINUTE, UNIT_PULSES
 from esphome.core import CORE
 
+CONF_PERIOD_SAMPLES = 'period_samples'
+
 pulse_counter_ns = cg.esphome_ns.namespace('pulse_counter')
 PulseCounterCountMode = pulse_counter_ns.enum('PulseCounterCountMode')
 COUNT_MODES = {
@@ -58,8 +60,10 @@ CONFIG_SCHEMA = sensor.sensor_schema(UNIT_PULSES_PER_MINUTE, ICON_PULSE, 2).exte
         cv.Required(CONF_FALLING_EDGE): COUNT_MODE_SCHEMA,
     }), validate_count_mode),
     cv.Optional(CONF_INTERNAL_FILTER, default='13us'): validate_internal_filter,
-    cv.Optional(CONF_TOTAL): sensor.sensor_schema(UNIT_PULSES, ICON_PULSE, 0),
-
+    cv.Optional(CONF_TOTAL): sensor.sensor_schema(UNIT_PULSES, ICON_PULSE, 0).extend({
+        cv.Optional(CONF_RESTORE, default=False): cv.boolean,
+    }),
+    cv.Optional(CONF_PERIOD_SAMPLES): cv.int_range(min=2, max=64),
 }).extend(cv.polling_component_schema('60s'))
 
 
@@ -78,3 +82,6 @@ def to_code(config):
     if CONF_TOTAL in config:
         sens = yield sensor.new_sensor(config[CONF_TOTAL])
         cg.add(var.set_total_sensor(sens))
+        cg.add(var.set_restore_total(config[CONF_TOTAL][CONF_RESTORE]))
+    if CONF_PERIOD_SAMPLES in config:
+        cg.add(var.set_period_samples(config[CONF_PERIOD_SAMPLES]))
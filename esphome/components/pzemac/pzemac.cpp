@@ -7,7 +7,7 @@ namespace pzemac {
 static const char *TAG = "pzemac";
 
 static const uint8_t PZEM_CMD_READ_IN_REGISTERS = 0x04;
-static const uint8_t PZEM_REGISTER_COUNT = 10;  // 10x 16-bit registers
+static const uint8_t PZEM_REGISTER_COUNT = 10;  // 10x 16-bit registers, all values in one request
 
 void PZEMAC::on_modbus_data(const std::vector<uint8_t> &data) {
   if (data.size() < 20) {
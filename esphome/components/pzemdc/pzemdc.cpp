@@ -7,7 +7,7 @@ namespace pzemdc {
 static const char *TAG = "pzemdc";
 
 static const uint8_t PZEM_CMD_READ_IN_REGISTERS = 0x04;
-static const uint8_t PZEM_REGISTER_COUNT = 10;  // 10x 16-bit registers
+static const uint8_t PZEM_REGISTER_COUNT = 8;  // 8x 16-bit registers, all values in one request
 
 void PZEMDC::on_modbus_data(const std::vector<uint8_t> &data) {
   if (data.size() < 16) {
@@ -46,7 +46,7 @@ void PZEMDC::on_modbus_data(const std::vector<uint8_t> &data) {
     this->power_sensor_->publish_state(power);
 }
 
-void PZEMDC::update() { this->send(PZEM_CMD_READ_IN_REGISTERS, 0, 8); }
+void PZEMDC::update() { this->send(PZEM_CMD_READ_IN_REGISTERS, 0, PZEM_REGISTER_COUNT); }
 void PZEMDC::dump_config() {
   ESP_LOGCONFIG(TAG, "PZEMDC:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
@@ -2,7 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation, pins
 from esphome.components import i2c
-from esphome.const import CONF_ON_TAG, CONF_TRIGGER_ID, CONF_RESET_PIN
+from esphome.const import CONF_ON_TAG, CONF_TRIGGER_ID, CONF_RESET_PIN, CONF_IRQ_PIN
 from esphome.core import coroutine
 
 CODEOWNERS = ['@glmnet']
@@ -18,6 +18,7 @@ RC522Trigger = rc522_ns.class_('RC522Trigger', automation.Trigger.template(cg.st
 RC522_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(RC522),
     cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
+    cv.Optional(CONF_IRQ_PIN): pins.gpio_input_pin_schema,
     cv.Optional(CONF_ON_TAG): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(RC522Trigger),
     }),
@@ -32,6 +33,10 @@ def setup_rc522(var, config):
         reset = yield cg.gpio_pin_expression(config[CONF_RESET_PIN])
         cg.add(var.set_reset_pin(reset))
 
+    if CONF_IRQ_PIN in config:
+        irq = yield cg.gpio_pin_expression(config[CONF_IRQ_PIN])
+        cg.add(var.set_irq_pin(irq))
+
     for conf in config.get(CONF_ON_TAG, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID])
         cg.add(var.register_trigger(trigger))
@@ -1,5 +1,6 @@
 #include "rc522.h"
 #include "esphome/core/log.h"
+#include "esphome/core/application.h"
 
 // Based on:
 // - https://github.com/miguelbalboa/rfid
@@ -23,6 +24,10 @@ void format_uid(char *buf, const uint8_t *uid, uint8_t uid_length) {
 
 void RC522::setup() {
   initialize_pending_ = true;
+  if (this->irq_pin_ != nullptr) {
+    this->irq_pin_->setup();
+    this->irq_pin_->attach_interrupt(RC522::gpio_intr, this, FALLING);
+  }
   // Pull device out of power down / reset state.
 
   // First set the resetPowerDownPin as digital input, to check the MFRC522 power down mode.
@@ -77,9 +82,16 @@ void RC522::initialize_() {
                                        // command to 0x6363 (ISO 14443-3 part 6.2.4)
   pcd_antenna_on_();                   // Enable the antenna driver pins TX1 and TX2 (they were disabled by the reset)
 
+  if (this->irq_pin_ != nullptr) {
+    pcd_write_register(COM_I_EN_REG, 0xA1);  // IRqInv=1 (active low), RxIEn and TimerIEn
+    pcd_write_register(DIV_I_EN_REG, 0x80);  // IRQPushPull=1
+  }
+
   initialize_pending_ = false;
 }
 
+void ICACHE_RAM_ATTR RC522::gpio_intr(RC522 *arg) { Application::wake_loop_isr(); }
+
 void RC522::dump_config() {
   ESP_LOGCONFIG(TAG, "RC522:");
   switch (this->error_code_) {
@@ -91,6 +103,7 @@ void RC522::dump_config() {
   }
 
   LOG_PIN("  RESET Pin: ", this->reset_pin_);
+  LOG_PIN("  IRQ Pin: ", this->irq_pin_);
 
   LOG_UPDATE_INTERVAL(this);
 
@@ -110,10 +123,25 @@ void RC522::loop() {
     return;
   }
 
-  if (millis() - update_wait_ < this->update_interval_)
-    return;
-
-  auto status = picc_is_new_card_present_();
+  StatusCode status;
+  if (this->irq_pin_ != nullptr) {
+    if (!this->request_pending_) {
+      this->picc_start_request_a_();
+      return;
+    }
+    // the IRQ pin goes low once a card has answered or the timer has run out
+    if (this->irq_pin_->digital_read()) {
+      if (millis() - this->request_start_ > 100) {
+        ESP_LOGW(TAG, "No interrupt for the request, check the IRQ pin!");
+        this->request_pending_ = false;
+      }
+      return;
+    }
+    this->request_pending_ = false;
+    status = this->picc_finish_request_a_();
+  } else {
+    status = picc_is_new_card_present_();
+  }
 
   static StatusCode LAST_STATUS = StatusCode::STATUS_OK;
 
@@ -132,6 +160,14 @@ void RC522::loop() {
   if (status != STATUS_OK)  // We can receive STATUS_TIMEOUT when no card, or unexpected status.
     return;
 
+  this->process_card_();
+}
+
+bool RC522::is_loop_idle() {
+  return this->irq_pin_ != nullptr && this->request_pending_ && this->irq_pin_->digital_read();
+}
+
+void RC522::process_card_() {
   // Try process card
   if (!picc_read_card_serial_()) {
     ESP_LOGW(TAG, "Requesting tag read failed!");
@@ -143,21 +179,26 @@ void RC522::loop() {
     ESP_LOGW(TAG, "Read serial size: %d", uid_.size);
   }
 
-  update_wait_ = millis();
+  this->tag_seen_ = true;
 
   bool report = true;
-  // 1. Go through all triggers
-  for (auto *trigger : this->triggers_)
-    trigger->process(uid_.uiduint8_t, uid_.size);
-
-  // 2. Find a binary sensor
+  // 1. Find a binary sensor
   for (auto *tag : this->binary_sensors_) {
     if (tag->process(uid_.uiduint8_t, uid_.size)) {
-      // 2.1 if found, do not dump
+      // 1.1 if found, do not dump
       report = false;
     }
   }
 
+  // 2. The card stays in the field, it has been processed already
+  if (uid_.size == this->current_uid_.size && memcmp(uid_.uiduint8_t, this->current_uid_.uiduint8_t, uid_.size) == 0)
+    return;
+  this->current_uid_ = uid_;
+
+  // 3. Go through all triggers
+  for (auto *trigger : this->triggers_)
+    trigger->process(uid_.uiduint8_t, uid_.size);
+
   if (report) {
     char buf[32];
     format_uid(buf, uid_.uiduint8_t, uid_.size);
@@ -168,6 +209,11 @@ void RC522::loop() {
 void RC522::update() {
   for (auto *obj : this->binary_sensors_)
     obj->on_scan_end();
+  if (!this->tag_seen_) {
+    // the card has left the field, process it again when it comes back
+    this->current_uid_.size = 0;
+  }
+  this->tag_seen_ = false;
 }
 
 /**
@@ -334,15 +380,7 @@ RC522::StatusCode RC522::pcd_communicate_with_picc_(
   uint8_t bit_framing =
       (rx_align << 4) + tx_last_bits;  // RxAlign = BitFramingReg[6..4]. TxLastBits = BitFramingReg[2..0]
 
-  pcd_write_register(COMMAND_REG, PCD_IDLE);               // Stop any active command.
-  pcd_write_register(COM_IRQ_REG, 0x7F);                   // Clear all seven interrupt request bits
-  pcd_write_register(FIFO_LEVEL_REG, 0x80);                // FlushBuffer = 1, FIFO initialization
-  pcd_write_register(FIFO_DATA_REG, send_len, send_data);  // Write sendData to the FIFO
-  pcd_write_register(BIT_FRAMING_REG, bit_framing);        // Bit adjustments
-  pcd_write_register(COMMAND_REG, command);                // Execute the command
-  if (command == PCD_TRANSCEIVE) {
-    pcd_set_register_bit_mask_(BIT_FRAMING_REG, 0x80);  // StartSend=1, transmission of data starts
-  }
+  pcd_start_communication_(command, send_data, send_len, bit_framing);
 
   // Wait for the command to complete.
   // In PCD_Init() we set the TAuto flag in TModeReg. This means the timer automatically starts when the PCD stops
@@ -364,6 +402,23 @@ RC522::StatusCode RC522::pcd_communicate_with_picc_(
     return STATUS_TIMEOUT;
   }
 
+  return pcd_finish_communication_(back_data, back_len, valid_bits, rx_align, check_crc);
+}
+
+void RC522::pcd_start_communication_(uint8_t command, uint8_t *send_data, uint8_t send_len, uint8_t bit_framing) {
+  pcd_write_register(COMMAND_REG, PCD_IDLE);               // Stop any active command.
+  pcd_write_register(COM_IRQ_REG, 0x7F);                   // Clear all seven interrupt request bits
+  pcd_write_register(FIFO_LEVEL_REG, 0x80);                // FlushBuffer = 1, FIFO initialization
+  pcd_write_register(FIFO_DATA_REG, send_len, send_data);  // Write sendData to the FIFO
+  pcd_write_register(BIT_FRAMING_REG, bit_framing);        // Bit adjustments
+  pcd_write_register(COMMAND_REG, command);                // Execute the command
+  if (command == PCD_TRANSCEIVE) {
+    pcd_set_register_bit_mask_(BIT_FRAMING_REG, 0x80);  // StartSend=1, transmission of data starts
+  }
+}
+
+RC522::StatusCode RC522::pcd_finish_communication_(uint8_t *back_data, uint8_t *back_len, uint8_t *valid_bits,
+                                                   uint8_t rx_align, bool check_crc) {
   // Stop now if any errors except collisions were detected.
   uint8_t error_reg_value = pcd_read_register(
       ERROR_REG);  // ErrorReg[7..0] bits are: WrErr TempErr reserved BufferOvfl CollErr CRCErr ParityErr ProtocolErr
@@ -480,6 +535,37 @@ RC522::StatusCode RC522::picc_is_new_card_present_() {
   return result;
 }
 
+void RC522::picc_start_request_a_() {
+  // Reset baud rates
+  pcd_write_register(TX_MODE_REG, 0x00);
+  pcd_write_register(RX_MODE_REG, 0x00);
+  // Reset ModWidthReg
+  pcd_write_register(MOD_WIDTH_REG, 0x26);
+
+  uint8_t command = PICC_CMD_REQA;
+  pcd_clear_register_bit_mask_(COLL_REG, 0x80);  // ValuesAfterColl=1 => Bits received after collision are cleared.
+  // REQA is a short frame of 7 bits
+  pcd_start_communication_(PCD_TRANSCEIVE, &command, 1, 7);
+  this->request_pending_ = true;
+  this->request_start_ = millis();
+}
+
+RC522::StatusCode RC522::picc_finish_request_a_() {
+  // ComIrqReg[7..0] bits are: Set1 TxIRq RxIRq IdleIRq HiAlertIRq LoAlertIRq ErrIRq TimerIRq
+  if ((pcd_read_register(COM_IRQ_REG) & 0x30) == 0)  // only the timer - nothing received in 25ms
+    return STATUS_TIMEOUT;
+
+  uint8_t buffer_atqa[2];
+  uint8_t buffer_size = sizeof(buffer_atqa);
+  uint8_t valid_bits = 0;
+  auto result = pcd_finish_communication_(buffer_atqa, &buffer_size, &valid_bits, 0, false);
+  if (result == STATUS_OK && (buffer_size != 2 || valid_bits != 0))  // ATQA must be exactly 16 bits.
+    result = STATUS_ERROR;
+
+  ESP_LOGV(TAG, "picc_finish_request_a_() -> %d", result);
+  return result;
+}
+
 /**
  * Simple wrapper around PICC_Select.
  * Returns true if a UID could be read.
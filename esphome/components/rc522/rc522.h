@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/esphal.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 
 namespace esphome {
@@ -19,11 +20,18 @@ class RC522 : public PollingComponent {
   float get_setup_priority() const override { return setup_priority::DATA; };
 
   void loop() override;
+  bool is_loop_idle() override;
 
   void register_tag(RC522BinarySensor *tag) { this->binary_sensors_.push_back(tag); }
   void register_trigger(RC522Trigger *trig) { this->triggers_.push_back(trig); }
 
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
+  /** The IRQ pin, which is low when a card has answered or the timer has run out.
+   *
+   * The REQA that looks for cards is then started without waiting for the answer, which is read once the pin goes low,
+   * instead of polling the interrupt register over the bus.
+   */
+  void set_irq_pin(GPIOPin *irq_pin) { this->irq_pin_ = irq_pin; }
 
  protected:
   enum PcdRegister : uint8_t {
@@ -172,7 +180,13 @@ class RC522 : public PollingComponent {
   };
 
   Uid uid_;
-  uint32_t update_wait_{0};
+  /// The last card that was processed, it isn't processed again while it stays in the field.
+  Uid current_uid_{};
+  /// Whether a card has been found since the last update.
+  bool tag_seen_{false};
+  /// Whether a REQA has been started that the IRQ pin signals the end of.
+  bool request_pending_{false};
+  uint32_t request_start_{0};
 
   void pcd_reset_();
   void initialize_();
@@ -223,12 +237,22 @@ class RC522 : public PollingComponent {
   StatusCode pcd_communicate_with_picc_(uint8_t command, uint8_t wait_i_rq, uint8_t *send_data, uint8_t send_len,
                                         uint8_t *back_data = nullptr, uint8_t *back_len = nullptr,
                                         uint8_t *valid_bits = nullptr, uint8_t rx_align = 0, bool check_crc = false);
+  /// The first half of pcd_communicate_with_picc_(), up to starting the command.
+  void pcd_start_communication_(uint8_t command, uint8_t *send_data, uint8_t send_len, uint8_t bit_framing);
+  /// The second half of pcd_communicate_with_picc_(), once the command has completed.
+  StatusCode pcd_finish_communication_(uint8_t *back_data, uint8_t *back_len, uint8_t *valid_bits, uint8_t rx_align,
+                                       bool check_crc);
   StatusCode pcd_calculate_crc_(
       uint8_t *data,   ///< In: Pointer to the data to transfer to the FIFO for CRC calculation.
       uint8_t length,  ///< In: The number of uint8_ts to transfer.
       uint8_t *result  ///< Out: Pointer to result buffer. Result is written to result[0..1], low uint8_t first.
   );
   RC522::StatusCode picc_is_new_card_present_();
+  /// picc_is_new_card_present_() in two halves, for the IRQ pin.
+  void picc_start_request_a_();
+  RC522::StatusCode picc_finish_request_a_();
+  void process_card_();
+  static void gpio_intr(RC522 *arg);
   bool picc_read_card_serial_();
   StatusCode picc_select_(
       Uid *uid,               ///< Pointer to Uid struct. Normally output, but can also be used to supply a known UID.
@@ -245,6 +269,7 @@ class RC522 : public PollingComponent {
   std::vector<uint8_t> r_c522_read_data_();
 
   GPIOPin *reset_pin_{nullptr};
+  GPIOPin *irq_pin_{nullptr};
   uint8_t reset_count_{0};
   uint32_t reset_timeout_{0};
   bool initialize_pending_{false};
@@ -56,7 +56,8 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance) : data_(data), tolerance_(tolerance) {}
+  RemoteReceiveData(std::vector<int32_t> *data, uint8_t tolerance, uint32_t capture_id = 0)
+      : data_(data), tolerance_(tolerance), capture_id_(capture_id) {}
 
   bool peek_mark(uint32_t length, uint32_t offset = 0) {
     if (int32_t(this->index_ + offset) >= this->size())
@@ -125,6 +126,8 @@ class RemoteReceiveData {
   int32_t size() const { return this->data_->size(); }
 
   std::vector<int32_t> *get_raw_data() { return this->data_; }
+  /// Identifies the capture of the receiver the data belongs to, 0 if it isn't part of a receiver pass.
+  uint32_t get_capture_id() const { return this->capture_id_; }
 
  protected:
   int32_t lower_bound_(uint32_t length) { return int32_t(100 - this->tolerance_) * length / 100U; }
@@ -133,6 +136,7 @@ class RemoteReceiveData {
   uint32_t index_{0};
   std::vector<int32_t> *data_;
   uint8_t tolerance_;
+  uint32_t capture_id_;
 };
 
 template<typename T> class RemoteProtocol {
@@ -144,6 +148,25 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const T &data) = 0;
 };
 
+/** Decode a capture with protocol T at most once.
+ *
+ * All listeners and dumpers of a protocol share the result of the first decode of a capture, including a failed
+ * one, so ten NEC binary sensors walk the pulse train once instead of ten times.
+ */
+template<typename T, typename D> optional<D> decode_cached(RemoteReceiveData src) {
+  static const std::vector<int32_t> *cached_data = nullptr;
+  static uint32_t cached_capture_id = 0;
+  static optional<D> cached;
+  if (src.get_capture_id() == 0)
+    return T().decode(src);
+  if (cached_data != src.get_raw_data() || cached_capture_id != src.get_capture_id()) {
+    cached = T().decode(src);
+    cached_data = src.get_raw_data();
+    cached_capture_id = src.get_capture_id();
+  }
+  return cached;
+}
+
 class RemoteComponentBase {
  public:
   explicit RemoteComponentBase(GPIOPin *pin) : pin_(pin){};
@@ -236,7 +259,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   bool call_listeners_() {
     bool success = false;
     for (auto *listener : this->listeners_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->capture_id_);
       if (listener->on_receive(data))
         success = true;
     }
@@ -245,18 +268,21 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_dumpers_() {
     bool success = false;
     for (auto *dumper : this->dumpers_) {
-      auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+      auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->capture_id_);
       if (dumper->dump(data))
         success = true;
     }
     if (!success) {
       for (auto *dumper : this->secondary_dumpers_) {
-        auto data = RemoteReceiveData(&this->temp_, this->tolerance_);
+        auto data = RemoteReceiveData(&this->temp_, this->tolerance_, this->capture_id_);
         dumper->dump(data);
       }
     }
   }
   void call_listeners_dumpers_() {
+    // a new capture, results decoded from the previous one are stale
+    if (++this->capture_id_ == 0)
+      this->capture_id_ = 1;
     if (this->call_listeners_())
       return;
     // If a listener handled, then do not dump
@@ -268,6 +294,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   std::vector<int32_t> temp_;
   uint8_t tolerance_{25};
+  uint32_t capture_id_{0};
 };
 
 class RemoteReceiverBinarySensorBase : public binary_sensor::BinarySensorInitiallyOff,
@@ -294,8 +321,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = decode_cached<T, D>(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -309,8 +335,7 @@ template<typename T, typename D> class RemoteReceiverBinarySensor : public Remot
 template<typename T, typename D> class RemoteReceiverTrigger : public Trigger<D>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = decode_cached<T, D>(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -343,11 +368,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public Action<Ts...
 template<typename T, typename D> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    auto decoded = decode_cached<T, D>(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
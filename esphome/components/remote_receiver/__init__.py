@@ -12,6 +12,8 @@ RemoteReceiverComponent = remote_receiver_ns.class_('RemoteReceiverComponent',
                                                     remote_base.RemoteReceiverBase,
                                                     cg.Component)
 
+CONF_CAPTURE_SIZE = 'capture_size'
+
 MULTI_CONF = True
 CONFIG_SCHEMA = remote_base.validate_triggers(cv.Schema({
     cv.GenerateID(): cv.declare_id(RemoteReceiverComponent),
@@ -23,6 +25,7 @@ CONFIG_SCHEMA = remote_base.validate_triggers(cv.Schema({
     cv.Optional(CONF_FILTER, default='50us'): cv.positive_time_period_microseconds,
     cv.Optional(CONF_IDLE, default='10ms'): cv.positive_time_period_microseconds,
     cv.Optional(CONF_MEMORY_BLOCKS, default=3): cv.Range(min=1, max=8),
+    cv.SplitDefault(CONF_CAPTURE_SIZE, esp32=1024, esp8266=256): cv.int_range(min=16, max=16384),
 }).extend(cv.COMPONENT_SCHEMA))
 
 
@@ -41,3 +44,4 @@ def to_code(config):
     cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
     cg.add(var.set_filter_us(config[CONF_FILTER]))
     cg.add(var.set_idle_us(config[CONF_IDLE]))
+    cg.add(var.set_capture_size(config[CONF_CAPTURE_SIZE]))
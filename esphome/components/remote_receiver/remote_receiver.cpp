@@ -0,0 +1,62 @@
+#include "remote_receiver.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace remote_receiver {
+
+static const char *TAG = "remote_receiver";
+
+uint32_t RemoteReceiverComponent::get_overflow_count() const {
+#ifdef ARDUINO_ARCH_ESP8266
+  return this->overflow_count_ + this->store_.overflow_count;
+#else
+  return this->overflow_count_;
+#endif
+}
+uint32_t RemoteReceiverComponent::get_filtered_count() const {
+#ifdef ARDUINO_ARCH_ESP8266
+  return this->filtered_count_ + this->store_.filtered_count;
+#else
+  return this->filtered_count_;
+#endif
+}
+
+void RemoteReceiverComponent::start_capture_() {
+  // clear() keeps the capacity reserved in setup()
+  this->temp_.clear();
+  this->merge_next_ = false;
+  this->capture_overflow_ = false;
+}
+void HOT RemoteReceiverComponent::push_pulse_(int32_t value) {
+  if (this->merge_next_) {
+    // the pulse before the glitch continues, it has the same level
+    this->merge_next_ = false;
+    this->temp_.back() += value;
+    return;
+  }
+  const int32_t length = value < 0 ? -value : value;
+  if (length < this->filter_us_ && !this->temp_.empty()) {
+    // a glitch splits one pulse into two, join both parts and the glitch again
+    this->temp_.back() += this->temp_.back() < 0 ? -length : length;
+    this->merge_next_ = true;
+    this->filtered_count_++;
+    return;
+  }
+  if (this->temp_.size() >= this->capture_size_) {
+    this->capture_overflow_ = true;
+    this->overflow_count_++;
+    return;
+  }
+  this->temp_.push_back(value);
+}
+void RemoteReceiverComponent::finish_capture_() {
+  if (this->temp_.empty())
+    return;
+  if (this->capture_overflow_) {
+    ESP_LOGW(TAG, "Signal had more than %u pulses, increase capture_size to receive all of it", this->capture_size_);
+  }
+  this->call_listeners_dumpers_();
+}
+
+}  // namespace remote_receiver
+}  // namespace esphome
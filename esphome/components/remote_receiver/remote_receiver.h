@@ -18,9 +18,11 @@ struct RemoteReceiverComponentStore {
   volatile uint32_t buffer_write_at;
   /// The position last read from
   uint32_t buffer_read_at{0};
-  bool overflow{false};
   uint32_t buffer_size{1000};
-  uint8_t filter_us{10};
+  /// Edges dropped because the buffer was full
+  volatile uint32_t overflow_count{0};
+  /// Edges dropped because the pin was already back at the previous level when the interrupt ran
+  volatile uint32_t filtered_count{0};
   ISRInternalGPIOPin *pin;
 };
 #endif
@@ -47,8 +49,20 @@ class RemoteReceiverComponent : public remote_base::RemoteReceiverBase,
   void set_buffer_size(uint32_t buffer_size) { this->buffer_size_ = buffer_size; }
   void set_filter_us(uint8_t filter_us) { this->filter_us_ = filter_us; }
   void set_idle_us(uint32_t idle_us) { this->idle_us_ = idle_us; }
+  /// The most pulses kept of one signal, the capture is allocated once during setup.
+  void set_capture_size(uint32_t capture_size) { this->capture_size_ = capture_size; }
+
+  /// Pulses that didn't fit into the capture or the edge buffer.
+  uint32_t get_overflow_count() const;
+  /// Pulses shorter than the filter time that were merged into their neighbours.
+  uint32_t get_filtered_count() const;
 
  protected:
+  void start_capture_();
+  /// Append a pulse to the capture, with glitches joined into the surrounding pulse.
+  void push_pulse_(int32_t value);
+  void finish_capture_();
+
 #ifdef ARDUINO_ARCH_ESP32
   void decode_rmt_(rmt_item32_t *item, size_t len);
   RingbufHandle_t ringbuf_;
@@ -58,11 +72,20 @@ class RemoteReceiverComponent : public remote_base::RemoteReceiverBase,
 #ifdef ARDUINO_ARCH_ESP8266
   RemoteReceiverComponentStore store_;
   HighFrequencyLoopRequester high_freq_;
+  /// The buffer position up to which no idle gap was found
+  uint32_t scan_at_{0};
+  uint32_t cycles_per_us_{1};
 #endif
 
   uint32_t buffer_size_{};
   uint8_t filter_us_{10};
   uint32_t idle_us_{10000};
+  uint32_t capture_size_{512};
+  /// The previous pulse was a glitch, the next one continues the pulse before it
+  bool merge_next_{false};
+  bool capture_overflow_{false};
+  uint32_t overflow_count_{0};
+  uint32_t filtered_count_{0};
 };
 
 }  // namespace remote_receiver
@@ -12,6 +12,7 @@ static const char *TAG = "remote_receiver.esp32";
 void RemoteReceiverComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Remote Receiver...");
   this->pin_->setup();
+  this->temp_.reserve(this->capture_size_);
   rmt_config_t rmt{};
   this->config_rmt(rmt);
   rmt.gpio_num = gpio_num_t(this->pin_->get_pin());
@@ -63,6 +64,9 @@ void RemoteReceiverComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Tolerance: %u%%", this->tolerance_);
   ESP_LOGCONFIG(TAG, "  Filter out pulses shorter than: %u us", this->filter_us_);
   ESP_LOGCONFIG(TAG, "  Signal is done after %u us of no changes", this->idle_us_);
+  ESP_LOGCONFIG(TAG, "  Capture Size: %u pulses", this->capture_size_);
+  ESP_LOGCONFIG(TAG, "  Overflowed pulses: %u", this->get_overflow_count());
+  ESP_LOGCONFIG(TAG, "  Filtered pulses: %u", this->get_filtered_count());
   if (this->is_failed()) {
     ESP_LOGE(TAG, "Configuring RMT driver failed: %s", esp_err_to_name(this->error_code_));
   }
@@ -72,19 +76,16 @@ void RemoteReceiverComponent::loop() {
   size_t len = 0;
   auto *item = (rmt_item32_t *) xRingbufferReceive(this->ringbuf_, &len, 0);
   if (item != nullptr) {
-    this->decode_rmt_(item, len);
+    // the ring buffer holds one signal per entry, the RMT ends reception after idle_us without an edge
+    this->decode_rmt_(item, len / sizeof(rmt_item32_t));
     vRingbufferReturnItem(this->ringbuf_, item);
-
-    if (this->temp_.empty())
-      return;
-
-    this->call_listeners_dumpers_();
+    this->finish_capture_();
   }
 }
 void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
   bool prev_level = false;
   uint32_t prev_length = 0;
-  this->temp_.clear();
+  this->start_capture_();
   int32_t multiplier = this->pin_->is_inverted() ? -1 : 1;
 
   ESP_LOGVV(TAG, "START:");
@@ -102,7 +103,6 @@ void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
   }
   ESP_LOGVV(TAG, "\n");
 
-  this->temp_.reserve(len / 4);
   for (size_t i = 0; i < len; i++) {
     if (item[i].duration0 == 0u) {
       // Do nothing
@@ -111,9 +111,9 @@ void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
     } else {
       if (prev_length > 0) {
         if (prev_level) {
-          this->temp_.push_back(this->to_microseconds(prev_length) * multiplier);
+          this->push_pulse_(this->to_microseconds(prev_length) * multiplier);
         } else {
-          this->temp_.push_back(-int32_t(this->to_microseconds(prev_length)) * multiplier);
+          this->push_pulse_(-int32_t(this->to_microseconds(prev_length)) * multiplier);
         }
       }
       prev_level = bool(item[i].level0);
@@ -131,9 +131,9 @@ void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
     } else {
       if (prev_length > 0) {
         if (prev_level) {
-          this->temp_.push_back(this->to_microseconds(prev_length) * multiplier);
+          this->push_pulse_(this->to_microseconds(prev_length) * multiplier);
         } else {
-          this->temp_.push_back(-int32_t(this->to_microseconds(prev_length)) * multiplier);
+          this->push_pulse_(-int32_t(this->to_microseconds(prev_length)) * multiplier);
         }
       }
       prev_level = bool(item[i].level1);
@@ -146,9 +146,9 @@ void RemoteReceiverComponent::decode_rmt_(rmt_item32_t *item, size_t len) {
   }
   if (prev_length > 0) {
     if (prev_level) {
-      this->temp_.push_back(this->to_microseconds(prev_length) * multiplier);
+      this->push_pulse_(this->to_microseconds(prev_length) * multiplier);
     } else {
-      this->temp_.push_back(-int32_t(this->to_microseconds(prev_length)) * multiplier);
+      this->push_pulse_(-int32_t(this->to_microseconds(prev_length)) * multiplier);
     }
   }
 }
@@ -10,21 +10,22 @@ namespace remote_receiver {
 static const char *TAG = "remote_receiver.esp8266";
 
 void ICACHE_RAM_ATTR HOT RemoteReceiverComponentStore::gpio_intr(RemoteReceiverComponentStore *arg) {
-  const uint32_t now = micros();
+  // the cycle counter is a single register read, cheaper than micros()
+  const uint32_t now = ESP.getCycleCount();
   // If the lhs is 1 (rising edge) we should write to an uneven index and vice versa
   const uint32_t next = (arg->buffer_write_at + 1) % arg->buffer_size;
   const bool level = arg->pin->digital_read();
-  if (level != next % 2)
+  if (level != next % 2) {
+    // the pulse was so short that the pin is already back, it's joined with its neighbours
+    arg->filtered_count++;
     return;
+  }
 
   // If next is buffer_read, we have hit an overflow
-  if (next == arg->buffer_read_at)
-    return;
-
-  const uint32_t last_change = arg->buffer[arg->buffer_write_at];
-  const uint32_t time_since_change = now - last_change;
-  if (time_since_change <= arg->filter_us)
+  if (next == arg->buffer_read_at) {
+    arg->overflow_count++;
     return;
+  }
 
   arg->buffer[arg->buffer_write_at = next] = now;
 }
@@ -33,7 +34,8 @@ void RemoteReceiverComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Remote Receiver...");
   this->pin_->setup();
   auto &s = this->store_;
-  s.filter_us = this->filter_us_;
+  this->cycles_per_us_ = F_CPU / 1000000UL;
+  this->temp_.reserve(this->capture_size_);
   s.pin = this->pin_->to_isr();
   s.buffer_size = this->buffer_size_;
 
@@ -53,6 +55,7 @@ void RemoteReceiverComponent::setup() {
   } else {
     s.buffer_write_at = s.buffer_read_at = 0;
   }
+  this->scan_at_ = s.buffer_read_at;
   this->pin_->attach_interrupt(RemoteReceiverComponentStore::gpio_intr, &this->store_, CHANGE);
 }
 void RemoteReceiverComponent::dump_config() {
@@ -66,6 +69,9 @@ void RemoteReceiverComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Tolerance: %u%%", this->tolerance_);
   ESP_LOGCONFIG(TAG, "  Filter out pulses shorter than: %u us", this->filter_us_);
   ESP_LOGCONFIG(TAG, "  Signal is done after %u us of no changes", this->idle_us_);
+  ESP_LOGCONFIG(TAG, "  Capture Size: %u pulses", this->capture_size_);
+  ESP_LOGCONFIG(TAG, "  Overflowed pulses: %u", this->get_overflow_count());
+  ESP_LOGCONFIG(TAG, "  Filtered pulses: %u", this->get_filtered_count());
 }
 
 void RemoteReceiverComponent::loop() {
@@ -77,9 +83,26 @@ void RemoteReceiverComponent::loop() {
   // signals must at least one rising and one leading edge
   if (dist <= 1)
     return;
-  const uint32_t now = micros();
-  if (now - s.buffer[write_at] < this->idle_us_)
-    // The last change was fewer than the configured idle time ago.
+  const uint32_t idle_cycles = this->idle_us_ * this->cycles_per_us_;
+  const uint32_t now = ESP.getCycleCount();
+  // The last change was at least the configured idle time ago.
+  bool complete = now - s.buffer[write_at] >= idle_cycles;
+  if (!complete) {
+    // A noisy receiver may never go idle, but a signal followed by an idle gap is complete anyway.
+    // Continue looking for that gap where the last pass stopped, the first edge is the one after the previous gap.
+    if (this->scan_at_ == s.buffer_read_at)
+      this->scan_at_ = (s.buffer_read_at + 1) % s.buffer_size;
+    while (this->scan_at_ != write_at) {
+      const uint32_t next = (this->scan_at_ + 1) % s.buffer_size;
+      if (s.buffer[next] - s.buffer[this->scan_at_] >= idle_cycles) {
+        complete = true;
+        break;
+      }
+      this->scan_at_ = next;
+    }
+  }
+  // without a gap, the signal is cut once it doesn't fit into the capture anymore
+  if (!complete && dist <= this->capture_size_)
     return;
 
   ESP_LOGVV(TAG, "read_at=%u write_at=%u dist=%u now=%u end=%u", s.buffer_read_at, write_at, dist, now,
@@ -89,29 +112,28 @@ void RemoteReceiverComponent::loop() {
   s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
   uint32_t prev = s.buffer_read_at;
   s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
-  const uint32_t reserve_size = 1 + (s.buffer_size + write_at - s.buffer_read_at) % s.buffer_size;
-  this->temp_.clear();
-  this->temp_.reserve(reserve_size);
+  this->start_capture_();
   int32_t multiplier = s.buffer_read_at % 2 == 0 ? 1 : -1;
 
   for (uint32_t i = 0; prev != write_at; i++) {
-    int32_t delta = s.buffer[s.buffer_read_at] - s.buffer[prev];
-    if (uint32_t(delta) >= this->idle_us_) {
+    const uint32_t delta = s.buffer[s.buffer_read_at] - s.buffer[prev];
+    if (delta >= idle_cycles) {
       // already found a space longer than idle. There must have been two pulses
       break;
     }
 
     ESP_LOGVV(TAG, "  i=%u buffer[%u]=%u - buffer[%u]=%u -> %d", i, s.buffer_read_at, s.buffer[s.buffer_read_at], prev,
-              s.buffer[prev], multiplier * delta);
-    this->temp_.push_back(multiplier * delta);
+              s.buffer[prev], multiplier * int32_t(delta / this->cycles_per_us_));
+    this->push_pulse_(multiplier * int32_t(delta / this->cycles_per_us_));
     prev = s.buffer_read_at;
     s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
     multiplier *= -1;
   }
   s.buffer_read_at = (s.buffer_size + s.buffer_read_at - 1) % s.buffer_size;
-  this->temp_.push_back(this->idle_us_ * multiplier);
+  this->scan_at_ = s.buffer_read_at;
+  this->push_pulse_(this->idle_us_ * multiplier);
 
-  this->call_listeners_dumpers_();
+  this->finish_capture_();
 }
 
 }  // namespace remote_receiver
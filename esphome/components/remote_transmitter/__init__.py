@@ -1,20 +1,26 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome import pins
+from esphome import automation, pins
 from esphome.components import remote_base
-from esphome.const import CONF_CARRIER_DUTY_PERCENT, CONF_ID, CONF_PIN
+from esphome.const import CONF_CARRIER_DUTY_PERCENT, CONF_ID, CONF_PIN, CONF_TRIGGER_ID
 
 AUTO_LOAD = ['remote_base']
 remote_transmitter_ns = cg.esphome_ns.namespace('remote_transmitter')
 RemoteTransmitterComponent = remote_transmitter_ns.class_('RemoteTransmitterComponent',
                                                           remote_base.RemoteTransmitterBase,
                                                           cg.Component)
+TransmitCompleteTrigger = remote_transmitter_ns.class_('TransmitCompleteTrigger', automation.Trigger.template())
+
+CONF_ON_TRANSMIT_COMPLETE = 'on_transmit_complete'
 
 MULTI_CONF = True
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(RemoteTransmitterComponent),
     cv.Required(CONF_PIN): pins.gpio_output_pin_schema,
     cv.Required(CONF_CARRIER_DUTY_PERCENT): cv.All(cv.percentage_int, cv.Range(min=1, max=100)),
+    cv.Optional(CONF_ON_TRANSMIT_COMPLETE): automation.validate_automation({
+        cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(TransmitCompleteTrigger),
+    }),
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -24,3 +30,7 @@ def to_code(config):
     yield cg.register_component(var, config)
 
     cg.add(var.set_carrier_duty_percent(config[CONF_CARRIER_DUTY_PERCENT]))
+
+    for conf in config.get(CONF_ON_TRANSMIT_COMPLETE, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        yield automation.build_automation(trigger, [], conf)
@@ -7,5 +7,13 @@ namespace remote_transmitter {
 
 static const char *TAG = "remote_transmitter";
 
+bool RemoteTransmitterComponent::is_loop_idle() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->transmitting_)
+    return false;
+#endif
+  return this->send_times_left_ == 0;
+}
+
 }  // namespace remote_transmitter
 }  // namespace esphome
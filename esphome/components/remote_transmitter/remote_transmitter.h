@@ -1,11 +1,15 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/automation.h"
 #include "esphome/components/remote_base/remote_base.h"
 
 namespace esphome {
 namespace remote_transmitter {
 
+/// Repeats with a wait of at least this many us are sent from loop() instead of waiting for them.
+static const uint32_t MIN_DEFERRED_WAIT = 20000;
+
 class RemoteTransmitterComponent : public remote_base::RemoteTransmitterBase,
                                    public Component
 #ifdef ARDUINO_ARCH_ESP32
@@ -20,18 +24,47 @@ class RemoteTransmitterComponent : public remote_base::RemoteTransmitterBase,
 
   void dump_config() override;
 
+  void loop() override;
+  bool is_loop_idle() override;
+
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void set_carrier_duty_percent(uint8_t carrier_duty_percent) { this->carrier_duty_percent_ = carrier_duty_percent; }
 
+  /// Called once all repeats of a code are sent.
+  void add_on_transmit_complete_callback(std::function<void()> &&callback) {
+    this->transmit_complete_callback_.add(std::move(callback));
+  }
+
  protected:
+  /** Send the first repeat of a code, the others follow from loop().
+   *
+   * Repeats with a wait that is shorter than a loop iteration are sent right away like before, so the timing of
+   * the protocol is kept.
+   */
   void send_internal(uint32_t send_times, uint32_t send_wait) override;
+  /// Send the remaining repeats until one has to wait for loop().
+  void transmit_next_();
+  /// Block until the code that is being sent is done, a new code replaces its buffers.
+  void finish_transmission_();
+
+  uint32_t send_times_left_{0};
+  uint32_t send_wait_{0};
+  uint32_t sent_at_{0};
+  CallbackManager<void()> transmit_complete_callback_;
+
 #ifdef ARDUINO_ARCH_ESP8266
+  void send_once_();
+
   void calculate_on_off_time_(uint32_t carrier_frequency, uint32_t *on_time_period, uint32_t *off_time_period);
 
   void mark_(uint32_t on_time, uint32_t off_time, uint32_t usec);
 
   void space_(uint32_t usec);
+
+  std::vector<int32_t> send_data_;
+  uint32_t on_time_{0};
+  uint32_t off_time_{0};
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -40,10 +73,21 @@ class RemoteTransmitterComponent : public remote_base::RemoteTransmitterBase,
   uint32_t current_carrier_frequency_{UINT32_MAX};
   bool initialized_{false};
   std::vector<rmt_item32_t> rmt_temp_;
+  /// The timings rmt_temp_ was encoded from, a repeated code doesn't have to be encoded again.
+  std::vector<int32_t> rmt_source_;
+  /// The RMT driver is still sending rmt_temp_.
+  bool transmitting_{false};
   esp_err_t error_code_{ESP_OK};
 #endif
   uint8_t carrier_duty_percent_{50};
 };
 
+class TransmitCompleteTrigger : public Trigger<> {
+ public:
+  explicit TransmitCompleteTrigger(RemoteTransmitterComponent *parent) {
+    parent->add_on_transmit_complete_callback([this]() { this->trigger(); });
+  }
+};
+
 }  // namespace remote_transmitter
 }  // namespace esphome
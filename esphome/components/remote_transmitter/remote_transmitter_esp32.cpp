@@ -73,12 +73,20 @@ void RemoteTransmitterComponent::configure_rmt() {
 void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t send_wait) {
   if (this->is_failed())
     return;
+  this->finish_transmission_();
 
   if (this->current_carrier_frequency_ != this->temp_.get_carrier_frequency()) {
     this->current_carrier_frequency_ = this->temp_.get_carrier_frequency();
     this->configure_rmt();
   }
 
+  this->send_times_left_ = send_times;
+  this->send_wait_ = send_wait;
+  if (this->temp_.get_data() == this->rmt_source_) {
+    this->transmit_next_();
+    return;
+  }
+
   this->rmt_temp_.clear();
   this->rmt_temp_.reserve((this->temp_.get_data().size() + 1) / 2);
   uint32_t rmt_i = 0;
@@ -112,19 +120,60 @@ void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t sen
     this->rmt_temp_.push_back(rmt_item);
   }
 
-  for (uint16_t i = 0; i < send_times; i++) {
-    esp_err_t error = rmt_write_items(this->channel_, this->rmt_temp_.data(), this->rmt_temp_.size(), true);
+  this->rmt_source_ = this->temp_.get_data();
+  this->transmit_next_();
+}
+
+void RemoteTransmitterComponent::transmit_next_() {
+  while (this->send_times_left_ != 0) {
+    this->send_times_left_--;
+    // the last repeat and repeats after a long wait are finished from loop()
+    const bool wait_done = this->send_times_left_ != 0 && this->send_wait_ < MIN_DEFERRED_WAIT;
+    esp_err_t error = rmt_write_items(this->channel_, this->rmt_temp_.data(), this->rmt_temp_.size(), wait_done);
     if (error != ESP_OK) {
       ESP_LOGW(TAG, "rmt_write_items failed: %s", esp_err_to_name(error));
       this->status_set_warning();
     } else {
       this->status_clear_warning();
     }
-    if (i + 1 < send_times) {
-      delay(send_wait / 1000UL);
-      delayMicroseconds(send_wait % 1000UL);
+    if (!wait_done) {
+      this->transmitting_ = error == ESP_OK;
+      this->sent_at_ = micros();
+      return;
+    }
+    delay(this->send_wait_ / 1000UL);
+    delayMicroseconds(this->send_wait_ % 1000UL);
+  }
+}
+
+void RemoteTransmitterComponent::loop() {
+  if (this->transmitting_) {
+    if (rmt_wait_tx_done(this->channel_, 0) != ESP_OK)
+      return;
+    this->transmitting_ = false;
+    this->sent_at_ = micros();
+    if (this->send_times_left_ == 0) {
+      this->transmit_complete_callback_.call();
+      return;
     }
   }
+  if (this->send_times_left_ != 0 && micros() - this->sent_at_ >= this->send_wait_)
+    this->transmit_next_();
+}
+
+void RemoteTransmitterComponent::finish_transmission_() {
+  if (!this->transmitting_ && this->send_times_left_ == 0)
+    return;
+  if (this->transmitting_)
+    rmt_wait_tx_done(this->channel_, portMAX_DELAY);
+  while (this->send_times_left_ != 0) {
+    this->send_times_left_--;
+    delay(this->send_wait_ / 1000UL);
+    delayMicroseconds(this->send_wait_ % 1000UL);
+    rmt_write_items(this->channel_, this->rmt_temp_.data(), this->rmt_temp_.size(), true);
+  }
+  this->transmitting_ = false;
+  this->transmit_complete_callback_.call();
 }
 
 }  // namespace remote_transmitter
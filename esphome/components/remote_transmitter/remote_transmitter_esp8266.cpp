@@ -64,27 +64,63 @@ void RemoteTransmitterComponent::space_(uint32_t usec) {
 }
 void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t send_wait) {
   ESP_LOGD(TAG, "Sending remote code...");
-  uint32_t on_time, off_time;
-  this->calculate_on_off_time_(this->temp_.get_carrier_frequency(), &on_time, &off_time);
-  for (uint32_t i = 0; i < send_times; i++) {
-    {
-      InterruptLock lock;
-      for (int32_t item : this->temp_.get_data()) {
-        if (item > 0) {
-          const auto length = uint32_t(item);
-          this->mark_(on_time, off_time, length);
-        } else {
-          const auto length = uint32_t(-item);
-          this->space_(length);
-        }
-        App.feed_wdt();
-      }
+  this->finish_transmission_();
+  // temp_ is reused by the next transmit() call, the repeats need their own copy
+  this->send_data_ = this->temp_.get_data();
+  this->calculate_on_off_time_(this->temp_.get_carrier_frequency(), &this->on_time_, &this->off_time_);
+  this->send_times_left_ = send_times;
+  this->send_wait_ = send_wait;
+  this->transmit_next_();
+}
+
+void RemoteTransmitterComponent::send_once_() {
+  InterruptLock lock;
+  for (int32_t item : this->send_data_) {
+    if (item > 0) {
+      const auto length = uint32_t(item);
+      this->mark_(this->on_time_, this->off_time_, length);
+    } else {
+      const auto length = uint32_t(-item);
+      this->space_(length);
     }
+    App.feed_wdt();
+  }
+}
 
-    if (i + 1 < send_times) {
-      delay_microseconds_accurate(send_wait);
+void RemoteTransmitterComponent::transmit_next_() {
+  while (this->send_times_left_ != 0) {
+    this->send_times_left_--;
+    this->send_once_();
+    if (this->send_times_left_ == 0) {
+      this->transmit_complete_callback_.call();
+      return;
+    }
+    if (this->send_wait_ >= MIN_DEFERRED_WAIT) {
+      this->sent_at_ = micros();
+      return;
     }
+    delay_microseconds_accurate(this->send_wait_);
+  }
+}
+
+void RemoteTransmitterComponent::loop() {
+  if (this->send_times_left_ != 0 && micros() - this->sent_at_ >= this->send_wait_)
+    this->transmit_next_();
+}
+
+void RemoteTransmitterComponent::finish_transmission_() {
+  if (this->send_times_left_ == 0)
+    return;
+  const uint32_t elapsed = micros() - this->sent_at_;
+  if (elapsed < this->send_wait_)
+    delay_microseconds_accurate(this->send_wait_ - elapsed);
+  while (this->send_times_left_ != 0) {
+    this->send_times_left_--;
+    this->send_once_();
+    if (this->send_times_left_ != 0)
+      delay_microseconds_accurate(this->send_wait_);
   }
+  this->transmit_complete_callback_.call();
 }
 
 }  // namespace remote_transmitter
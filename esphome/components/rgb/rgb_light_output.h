@@ -22,10 +22,24 @@ class RGBLightOutput : public light::LightOutput {
   void write_state(light::LightState *state) override {
     float red, green, blue;
     state->current_values_as_rgb(&red, &green, &blue, false);
+    output::LatchGuard guard;
     this->red_->set_level(red);
     this->green_->set_level(green);
     this->blue_->set_level(blue);
   }
+  bool supports_fade() override {
+    return this->red_->supports_fade() &&
+           this->green_->supports_fade() &&
+           this->blue_->supports_fade();
+  }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
+    float red, green, blue;
+    state->current_values_as_rgb(&red, &green, &blue, false);
+    output::LatchGuard guard;
+    this->red_->set_level_fade(red, length);
+    this->green_->set_level_fade(green, length);
+    this->blue_->set_level_fade(blue, length);
+  }
 
  protected:
   output::FloatOutput *red_;
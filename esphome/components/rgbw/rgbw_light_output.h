@@ -25,11 +25,25 @@ class RGBWLightOutput : public light::LightOutput {
   void write_state(light::LightState *state) override {
     float red, green, blue, white;
     state->current_values_as_rgbw(&red, &green, &blue, &white, this->color_interlock_);
+    output::LatchGuard guard;
     this->red_->set_level(red);
     this->green_->set_level(green);
     this->blue_->set_level(blue);
     this->white_->set_level(white);
   }
+  bool supports_fade() override {
+    return this->red_->supports_fade() && this->green_->supports_fade() && this->blue_->supports_fade() &&
+           this->white_->supports_fade();
+  }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
+    float red, green, blue, white;
+    state->current_values_as_rgbw(&red, &green, &blue, &white, this->color_interlock_);
+    output::LatchGuard guard;
+    this->red_->set_level_fade(red, length);
+    this->green_->set_level_fade(green, length);
+    this->blue_->set_level_fade(blue, length);
+    this->white_->set_level_fade(white, length);
+  }
 
  protected:
   output::FloatOutput *red_;
@@ -33,12 +33,28 @@ class RGBWWLightOutput : public light::LightOutput {
     float red, green, blue, cwhite, wwhite;
     state->current_values_as_rgbww(&red, &green, &blue, &cwhite, &wwhite, this->constant_brightness_,
                                    this->color_interlock_);
+    output::LatchGuard guard;
     this->red_->set_level(red);
     this->green_->set_level(green);
     this->blue_->set_level(blue);
     this->cold_white_->set_level(cwhite);
     this->warm_white_->set_level(wwhite);
   }
+  bool supports_fade() override {
+    return this->red_->supports_fade() && this->green_->supports_fade() && this->blue_->supports_fade() &&
+           this->cold_white_->supports_fade() && this->warm_white_->supports_fade();
+  }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
+    float red, green, blue, cwhite, wwhite;
+    state->current_values_as_rgbww(&red, &green, &blue, &cwhite, &wwhite, this->constant_brightness_,
+                                   this->color_interlock_);
+    output::LatchGuard guard;
+    this->red_->set_level_fade(red, length);
+    this->green_->set_level_fade(green, length);
+    this->blue_->set_level_fade(blue, length);
+    this->cold_white_->set_level_fade(cwhite, length);
+    this->warm_white_->set_level_fade(wwhite, length);
+  }
 
  protected:
   output::FloatOutput *red_;
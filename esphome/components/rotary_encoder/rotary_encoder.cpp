@@ -1,12 +1,18 @@
 #include "rotary_encoder.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/application.h"
 
 namespace esphome {
 namespace rotary_encoder {
 
 static const char *TAG = "rotary_encoder";
 
+/// The count of the PCNT unit is polled this often, in ms.
+static const uint32_t ROTARY_ENCODER_PCNT_POLL_INTERVAL = 20;
+/// The velocity is computed from the change of the position over this interval, in ms.
+static const uint32_t ROTARY_ENCODER_VELOCITY_INTERVAL = 250;
+
 // based on https://github.com/jkDesignDE/MechInputs/blob/master/QEIx4.cpp
 static const uint8_t STATE_LUT_MASK = 0x1C;  // clears upper counter increment/decrement bits and pin states
 static const uint16_t STATE_PIN_A_HIGH = 0x01;
@@ -95,11 +101,13 @@ void ICACHE_RAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensor
   if ((new_state & arg->resolution & STATE_HAS_INCREMENTED) != 0) {
     if (arg->counter < arg->max_value)
       arg->counter++;
+    arg->steps++;
     rotation_dir = 1;
   }
   if ((new_state & arg->resolution & STATE_HAS_DECREMENTED) != 0) {
     if (arg->counter > arg->min_value)
       arg->counter--;
+    arg->steps--;
     rotation_dir = -1;
   }
 
@@ -118,11 +126,139 @@ void ICACHE_RAM_ATTR HOT RotaryEncoderSensorStore::gpio_intr(RotaryEncoderSensor
     } else {
       *std::prev(first_zero) += rotation_dir;  // store the rotation into the previous slot
     }
+    Application::wake_loop_isr();
   }
 
   arg->state = new_state;
 }
 
+#ifdef ARDUINO_ARCH_ESP32
+/// The PCNT unit is cleared and the interrupt accumulates its count when it reaches this value.
+static const int16_t ROTARY_ENCODER_PCNT_LIMIT = 32000;
+/// Rotary encoders take the PCNT units from the top, the pulse counters take them from the bottom.
+static pcnt_unit_t next_rotary_encoder_pcnt_unit = PCNT_UNIT_7;  // NOLINT
+
+void ICACHE_RAM_ATTR RotaryEncoderSensorStore::pcnt_intr(void *arg) {
+  auto *store = reinterpret_cast<RotaryEncoderSensorStore *>(arg);
+  const uint32_t status = PCNT.status_unit[store->pcnt_unit].val;
+  if (status & PCNT_STATUS_H_LIM_M)
+    store->pcnt_overflow += ROTARY_ENCODER_PCNT_LIMIT;
+  if (status & PCNT_STATUS_L_LIM_M)
+    store->pcnt_overflow -= ROTARY_ENCODER_PCNT_LIMIT;
+}
+
+bool RotaryEncoderSensor::setup_pcnt_() {
+  this->store_.pcnt_unit = next_rotary_encoder_pcnt_unit;
+  next_rotary_encoder_pcnt_unit = pcnt_unit_t(int(next_rotary_encoder_pcnt_unit) - 1);  // NOLINT
+  const uint8_t pin_a = this->pin_a_->get_pin();
+  const uint8_t pin_b = this->pin_b_->get_pin();
+
+  // Both channels count both edges of their pin, the level of the other pin gives the direction. A rising edge of A
+  // while B is low is clockwise, like in the state lookup table.
+  pcnt_config_t config_a = {
+      .pulse_gpio_num = pin_a,
+      .ctrl_gpio_num = pin_b,
+      .lctrl_mode = PCNT_MODE_KEEP,
+      .hctrl_mode = PCNT_MODE_REVERSE,
+      .pos_mode = PCNT_COUNT_INC,
+      .neg_mode = PCNT_COUNT_DEC,
+      .counter_h_lim = ROTARY_ENCODER_PCNT_LIMIT,
+      .counter_l_lim = -ROTARY_ENCODER_PCNT_LIMIT,
+      .unit = this->store_.pcnt_unit,
+      .channel = PCNT_CHANNEL_0,
+  };
+  pcnt_config_t config_b = {
+      .pulse_gpio_num = pin_b,
+      .ctrl_gpio_num = pin_a,
+      .lctrl_mode = PCNT_MODE_REVERSE,
+      .hctrl_mode = PCNT_MODE_KEEP,
+      .pos_mode = PCNT_COUNT_INC,
+      .neg_mode = PCNT_COUNT_DEC,
+      .counter_h_lim = ROTARY_ENCODER_PCNT_LIMIT,
+      .counter_l_lim = -ROTARY_ENCODER_PCNT_LIMIT,
+      .unit = this->store_.pcnt_unit,
+      .channel = PCNT_CHANNEL_1,
+  };
+  esp_err_t error = pcnt_unit_config(&config_a);
+  if (error == ESP_OK)
+    error = pcnt_unit_config(&config_b);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Configuring PCNT unit failed: %s", esp_err_to_name(error));
+    return false;
+  }
+
+  if (this->filter_us_ != 0) {
+    uint16_t filter_val = std::min(this->filter_us_ * 80u, 1023u);
+    pcnt_set_filter_value(this->store_.pcnt_unit, filter_val);
+    pcnt_filter_enable(this->store_.pcnt_unit);
+  }
+
+  error = pcnt_isr_service_install(0);
+  if (error != ESP_OK && error != ESP_ERR_INVALID_STATE) {
+    // already installed by another encoder or pulse counter is fine
+    ESP_LOGE(TAG, "Installing PCNT interrupt service failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  error = pcnt_isr_handler_add(this->store_.pcnt_unit, RotaryEncoderSensorStore::pcnt_intr, &this->store_);
+  if (error != ESP_OK) {
+    ESP_LOGE(TAG, "Adding PCNT interrupt handler failed: %s", esp_err_to_name(error));
+    return false;
+  }
+  pcnt_event_enable(this->store_.pcnt_unit, PCNT_EVT_H_LIM);
+  pcnt_event_enable(this->store_.pcnt_unit, PCNT_EVT_L_LIM);
+
+  pcnt_counter_pause(this->store_.pcnt_unit);
+  pcnt_counter_clear(this->store_.pcnt_unit);
+  pcnt_counter_resume(this->store_.pcnt_unit);
+  return true;
+}
+
+int32_t RotaryEncoderSensor::read_pcnt_() {
+  int32_t overflow;
+  int16_t value;
+  do {
+    overflow = this->store_.pcnt_overflow;
+    pcnt_get_counter_value(this->store_.pcnt_unit, &value);
+  } while (overflow != this->store_.pcnt_overflow);
+  return overflow + value;
+}
+
+int32_t RotaryEncoderSensor::pcnt_counts_per_step_() const {
+  switch (this->store_.resolution) {
+    case ROTARY_ENCODER_1_PULSE_PER_CYCLE:
+      return 4;
+    case ROTARY_ENCODER_2_PULSES_PER_CYCLE:
+      return 2;
+    case ROTARY_ENCODER_4_PULSES_PER_CYCLE:
+    default:
+      return 1;
+  }
+}
+
+void RotaryEncoderSensor::poll_pcnt_() {
+  // A step is only taken once the count is a full step away from the last one, so an encoder that wobbles around a
+  // detent doesn't toggle between two steps.
+  const int32_t counts_per_step = this->pcnt_counts_per_step_();
+  int32_t delta = (this->read_pcnt_() - this->pcnt_anchor_) / counts_per_step;
+  if (delta == 0)
+    return;
+  this->pcnt_anchor_ += delta * counts_per_step;
+  this->store_.steps += delta;
+  const int64_t counter = int64_t(this->store_.counter) + delta;
+  if (counter < this->store_.min_value)
+    this->store_.counter = this->store_.min_value;
+  else if (counter > this->store_.max_value)
+    this->store_.counter = this->store_.max_value;
+  else
+    this->store_.counter = counter;
+
+  for (; delta > 0; delta--)
+    this->on_clockwise_callback_.call();
+  for (; delta < 0; delta++)
+    this->on_anticlockwise_callback_.call();
+}
+#endif
+
 void RotaryEncoderSensor::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Rotary Encoder '%s'...", this->name_.c_str());
   this->pin_a_->setup();
@@ -134,14 +270,53 @@ void RotaryEncoderSensor::setup() {
     this->pin_i_->setup();
   }
 
-  this->pin_a_->attach_interrupt(RotaryEncoderSensorStore::gpio_intr, &this->store_, CHANGE);
-  this->pin_b_->attach_interrupt(RotaryEncoderSensorStore::gpio_intr, &this->store_, CHANGE);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->use_pcnt_) {
+    if (!this->setup_pcnt_()) {
+      this->mark_failed();
+      return;
+    }
+    this->set_interval("pcnt", ROTARY_ENCODER_PCNT_POLL_INTERVAL, [this]() { this->poll_pcnt_(); });
+  } else {
+#endif
+    this->pin_a_->attach_interrupt(RotaryEncoderSensorStore::gpio_intr, &this->store_, CHANGE);
+    this->pin_b_->attach_interrupt(RotaryEncoderSensorStore::gpio_intr, &this->store_, CHANGE);
+#ifdef ARDUINO_ARCH_ESP32
+  }
+#endif
+
+  if (this->velocity_sensor_ != nullptr) {
+    this->last_position_at_ = millis();
+    this->set_interval("velocity", ROTARY_ENCODER_VELOCITY_INTERVAL, [this]() { this->update_velocity_(); });
+  }
+}
+float RotaryEncoderSensor::read_position_() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->use_pcnt_)
+    return this->read_pcnt_() / float(this->pcnt_counts_per_step_());
+#endif
+  return this->store_.steps;
+}
+void RotaryEncoderSensor::update_velocity_() {
+  const uint32_t now = millis();
+  const float position = this->read_position_();
+  const float velocity = (position - this->last_position_) * 1000.0f / float(now - this->last_position_at_);
+  this->last_position_ = position;
+  this->last_position_at_ = now;
+  if (velocity != this->velocity_sensor_->state)
+    this->velocity_sensor_->publish_state(velocity);
 }
 void RotaryEncoderSensor::dump_config() {
   LOG_SENSOR("", "Rotary Encoder", this);
   LOG_PIN("  Pin A: ", this->pin_a_);
   LOG_PIN("  Pin B: ", this->pin_b_);
   LOG_PIN("  Pin I: ", this->pin_i_);
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->use_pcnt_) {
+    ESP_LOGCONFIG(TAG, "  PCNT Unit Number: %u", this->store_.pcnt_unit);
+    ESP_LOGCONFIG(TAG, "  Filtering pulses shorter than %u µs", this->filter_us_);
+  }
+#endif
   switch (this->store_.resolution) {
     case ROTARY_ENCODER_1_PULSE_PER_CYCLE:
       ESP_LOGCONFIG(TAG, "  Resolution: 1 Pulse Per Cycle");
@@ -153,6 +328,12 @@ void RotaryEncoderSensor::dump_config() {
       ESP_LOGCONFIG(TAG, "  Resolution: 4 Pulse Per Cycle");
       break;
   }
+  LOG_SENSOR("  ", "Velocity", this->velocity_sensor_);
+}
+bool RotaryEncoderSensor::is_loop_idle() {
+  // The reset pin is polled, everything else is signalled from the interrupt handler.
+  return this->pin_i_ == nullptr && this->store_.rotation_events[0] == 0 &&
+         this->store_.counter == this->store_.last_read;
 }
 void RotaryEncoderSensor::loop() {
   std::array<int8_t, 8> rotation_events;
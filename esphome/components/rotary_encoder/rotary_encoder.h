@@ -7,6 +7,10 @@
 #include "esphome/core/automation.h"
 #include "esphome/components/sensor/sensor.h"
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <driver/pcnt.h>
+#endif
+
 namespace esphome {
 namespace rotary_encoder {
 
@@ -23,6 +27,8 @@ struct RotaryEncoderSensorStore {
   ISRInternalGPIOPin *pin_b;
 
   volatile int32_t counter{0};
+  /// The steps without the min and max value, for the velocity.
+  volatile int32_t steps{0};
   RotaryEncoderResolution resolution{ROTARY_ENCODER_1_PULSE_PER_CYCLE};
   int32_t min_value{INT32_MIN};
   int32_t max_value{INT32_MAX};
@@ -33,6 +39,14 @@ struct RotaryEncoderSensorStore {
   bool rotation_events_overflow{false};
 
   static void gpio_intr(RotaryEncoderSensorStore *arg);
+
+#ifdef ARDUINO_ARCH_ESP32
+  static void pcnt_intr(void *arg);
+
+  pcnt_unit_t pcnt_unit;
+  /// Counts of the PCNT unit that were cleared when it reached one of its limits.
+  volatile int32_t pcnt_overflow{0};
+#endif
 };
 
 class RotaryEncoderSensor : public sensor::Sensor, public Component {
@@ -58,12 +72,24 @@ class RotaryEncoderSensor : public sensor::Sensor, public Component {
   void set_reset_pin(GPIOPin *pin_i) { this->pin_i_ = pin_i; }
   void set_min_value(int32_t min_value);
   void set_max_value(int32_t max_value);
+  /// Publish the rotation speed in steps per second, from the change of the position.
+  void set_velocity_sensor(sensor::Sensor *velocity_sensor) { this->velocity_sensor_ = velocity_sensor; }
+#ifdef ARDUINO_ARCH_ESP32
+  /** Decode the quadrature signal with a PCNT unit instead of an interrupt on every edge.
+   *
+   * The unit counts all four edges of an A-B cycle in hardware, filters glitches shorter than the filter and only
+   * interrupts when its 16 bit counter reaches a limit. The count is polled and converted to steps of the resolution.
+   */
+  void set_use_pcnt(bool use_pcnt) { this->use_pcnt_ = use_pcnt; }
+  void set_filter_us(uint32_t filter_us) { this->filter_us_ = filter_us; }
+#endif
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   void setup() override;
   void dump_config() override;
   void loop() override;
+  bool is_loop_idle() override;
 
   float get_setup_priority() const override;
 
@@ -76,11 +102,32 @@ class RotaryEncoderSensor : public sensor::Sensor, public Component {
   }
 
  protected:
+  /// The position in steps of the resolution, with fractions of a step from the PCNT unit.
+  float read_position_();
+  void update_velocity_();
+#ifdef ARDUINO_ARCH_ESP32
+  bool setup_pcnt_();
+  /// The count of the PCNT unit, including the counts of its limit interrupts.
+  int32_t read_pcnt_();
+  void poll_pcnt_();
+  /// The number of quadrature counts per step of the resolution.
+  int32_t pcnt_counts_per_step_() const;
+#endif
+
   GPIOPin *pin_a_;
   GPIOPin *pin_b_;
   GPIOPin *pin_i_{nullptr};  /// Index pin, if this is not nullptr, the counter will reset to 0 once this pin is HIGH.
 
   RotaryEncoderSensorStore store_{};
+  sensor::Sensor *velocity_sensor_{nullptr};
+  float last_position_{0.0f};
+  uint32_t last_position_at_{0};
+#ifdef ARDUINO_ARCH_ESP32
+  bool use_pcnt_{false};
+  uint32_t filter_us_{0};
+  /// The PCNT count the last step was applied at, the next one is applied once the count is a full step away.
+  int32_t pcnt_anchor_{0};
+#endif
 
   CallbackManager<void()> on_clockwise_callback_;
   CallbackManager<void()> on_anticlockwise_callback_;
@@ -3,7 +3,8 @@ import esphome.config_validation as cv
 from esphome import pins, automation
 from esphome.components import sensor
 from esphome.const import CONF_ID, CONF_RESOLUTION, CONF_MIN_VALUE, CONF_MAX_VALUE, UNIT_STEPS, \
-    ICON_ROTATE_RIGHT, CONF_VALUE, CONF_PIN_A, CONF_PIN_B, CONF_TRIGGER_ID
+    ICON_ROTATE_RIGHT, CONF_VALUE, CONF_PIN_A, CONF_PIN_B, CONF_TRIGGER_ID, CONF_INTERNAL_FILTER
+from esphome.core import CORE
 
 rotary_encoder_ns = cg.esphome_ns.namespace('rotary_encoder')
 RotaryEncoderResolution = rotary_encoder_ns.enum('RotaryEncoderResolution')
@@ -16,6 +17,9 @@ RESOLUTIONS = {
 CONF_PIN_RESET = 'pin_reset'
 CONF_ON_CLOCKWISE = 'on_clockwise'
 CONF_ON_ANTICLOCKWISE = 'on_anticlockwise'
+CONF_USE_PCNT = 'use_pcnt'
+CONF_VELOCITY = 'velocity'
+UNIT_STEPS_PER_SECOND = 'steps/s'
 
 RotaryEncoderSensor = rotary_encoder_ns.class_('RotaryEncoderSensor', sensor.Sensor, cg.Component)
 RotaryEncoderSetValueAction = rotary_encoder_ns.class_('RotaryEncoderSetValueAction',
@@ -37,6 +41,22 @@ def validate_min_max_value(config):
     return config
 
 
+def validate_pcnt(config):
+    if CORE.is_esp8266:
+        if config.get(CONF_USE_PCNT, False):
+            raise cv.Invalid("The ESP8266 has no PCNT peripheral")
+        if CONF_INTERNAL_FILTER in config:
+            raise cv.Invalid("{} is only available on the ESP32".format(CONF_INTERNAL_FILTER))
+    return config
+
+
+def validate_internal_filter(value):
+    value = cv.positive_time_period_microseconds(value)
+    if value.total_microseconds > 13:
+        raise cv.Invalid("Maximum internal filter value for ESP32 is 13us")
+    return value
+
+
 CONFIG_SCHEMA = cv.All(sensor.sensor_schema(UNIT_STEPS, ICON_ROTATE_RIGHT, 0).extend({
     cv.GenerateID(): cv.declare_id(RotaryEncoderSensor),
     cv.Required(CONF_PIN_A): cv.All(pins.internal_gpio_input_pin_schema,
@@ -47,13 +67,16 @@ CONFIG_SCHEMA = cv.All(sensor.sensor_schema(UNIT_STEPS, ICON_ROTATE_RIGHT, 0).ex
     cv.Optional(CONF_RESOLUTION, default=1): cv.enum(RESOLUTIONS, int=True),
     cv.Optional(CONF_MIN_VALUE): cv.int_,
     cv.Optional(CONF_MAX_VALUE): cv.int_,
+    cv.Optional(CONF_USE_PCNT): cv.boolean,
+    cv.Optional(CONF_INTERNAL_FILTER): validate_internal_filter,
+    cv.Optional(CONF_VELOCITY): sensor.sensor_schema(UNIT_STEPS_PER_SECOND, ICON_ROTATE_RIGHT, 1),
     cv.Optional(CONF_ON_CLOCKWISE): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(RotaryEncoderClockwiseTrigger),
     }),
     cv.Optional(CONF_ON_ANTICLOCKWISE): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(RotaryEncoderAnticlockwiseTrigger),
     }),
-}).extend(cv.COMPONENT_SCHEMA), validate_min_max_value)
+}).extend(cv.COMPONENT_SCHEMA), validate_min_max_value, validate_pcnt)
 
 
 def to_code(config):
@@ -73,6 +96,14 @@ def to_code(config):
         cg.add(var.set_min_value(config[CONF_MIN_VALUE]))
     if CONF_MAX_VALUE in config:
         cg.add(var.set_max_value(config[CONF_MAX_VALUE]))
+    if CORE.is_esp32:
+        # the PCNT unit decodes the signal in hardware, unless it is disabled
+        cg.add(var.set_use_pcnt(config.get(CONF_USE_PCNT, True)))
+        filter_us = config.get(CONF_INTERNAL_FILTER)
+        cg.add(var.set_filter_us(10 if filter_us is None else filter_us.total_microseconds))
+    if CONF_VELOCITY in config:
+        sens = yield sensor.new_sensor(config[CONF_VELOCITY])
+        cg.add(var.set_velocity_sensor(sens))
 
     for conf in config.get(CONF_ON_CLOCKWISE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
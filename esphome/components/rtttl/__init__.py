@@ -2,6 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
 from esphome.components.output import FloatOutput
+from esphome.components.esp32_dac.output import ESP32DAC
 from esphome.const import CONF_ID, CONF_OUTPUT, CONF_TRIGGER_ID
 
 CODEOWNERS = ['@glmnet']
@@ -32,8 +33,11 @@ def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
 
-    out = yield cg.get_variable(config[CONF_OUTPUT])
+    out_id, out = yield cg.get_variable_with_full_id(config[CONF_OUTPUT])
     cg.add(var.set_output(out))
+    if out_id.type.inherits_from(ESP32DAC):
+        # render the melody ahead and play it with I2S DMA
+        cg.add(var.set_dac(out))
 
     for conf in config.get(CONF_ON_FINISHED_PLAYBACK, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
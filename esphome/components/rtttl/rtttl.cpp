@@ -82,20 +82,62 @@ void Rtttl::play(std::string rtttl) {
   output_freq_ = 0;
   last_note_ = millis();
   note_duration_ = 1;
+#ifdef USE_ESP32_DAC
+  if (this->dac_ != nullptr)
+    this->play_dac_();
+#endif
 }
 
 void Rtttl::loop() {
+#ifdef USE_ESP32_DAC
+  if (this->dac_ != nullptr) {
+    // the DAC plays the rendered melody by itself
+    if (note_duration_ != 0 && !this->dac_->is_playing())
+      this->finish_playback_();
+    return;
+  }
+#endif
   if (note_duration_ == 0 || millis() - last_note_ < note_duration_)
     return;
 
-  if (!rtttl_[position_]) {
-    output_->set_level(0.0);
-    ESP_LOGD(TAG, "Playback finished");
-    this->on_finished_playback_callback_.call();
-    note_duration_ = 0;
+  uint16_t freq;
+  if (!this->next_note_(&freq)) {
+    this->finish_playback_();
     return;
   }
 
+  // Now play the note
+  if (freq != 0) {
+    if (freq == output_freq_) {
+      // Add small silence gap between same note
+      output_->set_level(0.0);
+      delay(DOUBLE_NOTE_GAP_MS);
+      note_duration_ -= DOUBLE_NOTE_GAP_MS;
+    }
+    output_freq_ = freq;
+
+    ESP_LOGVV(TAG, "playing note: %u Hz for %dms", freq, note_duration_);
+    output_->update_frequency(freq);
+    output_->set_level(0.5);
+  } else {
+    ESP_LOGVV(TAG, "waiting: %dms", note_duration_);
+    output_->set_level(0.0);
+  }
+
+  last_note_ = millis();
+}
+
+void Rtttl::finish_playback_() {
+  output_->set_level(0.0);
+  ESP_LOGD(TAG, "Playback finished");
+  this->on_finished_playback_callback_.call();
+  note_duration_ = 0;
+}
+
+bool Rtttl::next_note_(uint16_t *frequency) {
+  if (!rtttl_[position_])
+    return false;
+
   // align to note: most rtttl's out there does not add and space after the ',' separator but just in case...
   while (rtttl_[position_] == ',' || rtttl_[position_] == ' ')
     position_++;
@@ -155,32 +197,37 @@ void Rtttl::loop() {
   if (scale == 0)
     scale = default_octave_;
 
-  // Now play the note
+  *frequency = 0;
   if (note) {
     auto note_index = (scale - 4) * 12 + note;
-    if (note_index < 0 || note_index >= sizeof(NOTES)) {
+    if (note_index < 0 || note_index >= int(sizeof(NOTES) / sizeof(NOTES[0]))) {
       ESP_LOGE(TAG, "Note out of valid range");
-      return;
+      return true;
     }
-    auto freq = NOTES[note_index];
+    *frequency = NOTES[note_index];
+  }
+  return true;
+}
 
-    if (freq == output_freq_) {
+#ifdef USE_ESP32_DAC
+void Rtttl::play_dac_() {
+  // the whole melody is rendered ahead, so the note timing is exact to the sample
+  std::vector<esp32_dac::Tone> tones;
+  uint16_t freq;
+  uint16_t last_freq = 0;
+  while (this->next_note_(&freq)) {
+    if (freq != 0 && freq == last_freq) {
       // Add small silence gap between same note
-      output_->set_level(0.0);
-      delay(DOUBLE_NOTE_GAP_MS);
+      tones.push_back(esp32_dac::Tone{0, DOUBLE_NOTE_GAP_MS});
       note_duration_ -= DOUBLE_NOTE_GAP_MS;
     }
-    output_freq_ = freq;
-
-    ESP_LOGVV(TAG, "playing note: %d for %dms", note, note_duration_);
-    output_->update_frequency(freq);
-    output_->set_level(0.5);
-  } else {
-    ESP_LOGVV(TAG, "waiting: %dms", note_duration_);
-    output_->set_level(0.0);
+    tones.push_back(esp32_dac::Tone{freq, note_duration_});
+    last_freq = freq;
   }
-
-  last_note_ = millis();
+  this->dac_->play_tones(std::move(tones));
+  note_duration_ = 1;
 }
+#endif
+
 }  // namespace rtttl
 }  // namespace esphome
@@ -4,6 +4,10 @@
 #include "esphome/core/automation.h"
 #include "esphome/components/output/float_output.h"
 
+#ifdef USE_ESP32_DAC
+#include "esphome/components/esp32_dac/esp32_dac.h"
+#endif
+
 namespace esphome {
 namespace rtttl {
 
@@ -12,6 +16,10 @@ extern uint32_t global_rtttl_id;
 class Rtttl : public Component {
  public:
   void set_output(output::FloatOutput *output) { output_ = output; }
+#ifdef USE_ESP32_DAC
+  /// Play the melody with the waveforms of the DAC, instead of stepping the frequency of the output in loop().
+  void set_dac(esp32_dac::ESP32DAC *dac) { dac_ = dac; }
+#endif
   void play(std::string rtttl);
   void stop() {
     note_duration_ = 0;
@@ -21,6 +29,7 @@ class Rtttl : public Component {
 
   bool is_playing() { return note_duration_ != 0; }
   void loop() override;
+  bool is_loop_idle() override { return !this->is_playing(); }
 
   void add_on_finished_playback_callback(std::function<void()> callback) {
     this->on_finished_playback_callback_.add(std::move(callback));
@@ -34,6 +43,12 @@ class Rtttl : public Component {
     }
     return ret;
   }
+  /// Parse the next note into frequency (0 for a pause) and note_duration_, returns false at the end.
+  bool next_note_(uint16_t *frequency);
+  void finish_playback_();
+#ifdef USE_ESP32_DAC
+  void play_dac_();
+#endif
 
   std::string rtttl_;
   size_t position_;
@@ -45,6 +60,9 @@ class Rtttl : public Component {
 
   uint32_t output_freq_;
   output::FloatOutput *output_;
+#ifdef USE_ESP32_DAC
+  esp32_dac::ESP32DAC *dac_{nullptr};
+#endif
 
   CallbackManager<void()> on_finished_playback_callback_;
 };
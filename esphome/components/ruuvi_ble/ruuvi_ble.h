@@ -28,6 +28,10 @@ optional<RuuviParseResult> parse_ruuvi(const esp32_ble_tracker::ESPBTDevice &dev
 
 class RuuviListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    // Ruuvi Innovations Ltd.
+    filter.manufacturer_ids.push_back(0x0499);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
@@ -6,8 +6,8 @@ from esphome import automation
 from esphome.components import mqtt
 from esphome.const import CONF_DEVICE_CLASS, CONF_ABOVE, CONF_ACCURACY_DECIMALS, CONF_ALPHA, \
     CONF_BELOW, CONF_EXPIRE_AFTER, CONF_FILTERS, CONF_FROM, CONF_ICON, CONF_ID, CONF_INTERNAL, \
-    CONF_ON_RAW_VALUE, CONF_ON_VALUE, CONF_ON_VALUE_RANGE, CONF_SEND_EVERY, CONF_SEND_FIRST_AT, \
-    CONF_TO, CONF_TRIGGER_ID, CONF_UNIT_OF_MEASUREMENT, CONF_WINDOW_SIZE, CONF_NAME, CONF_MQTT_ID, \
+    CONF_MIN_INTERVAL, CONF_ON_RAW_VALUE, CONF_ON_VALUE, CONF_ON_VALUE_RANGE, CONF_SEND_EVERY, CONF_SEND_FIRST_AT, \
+    CONF_TO, CONF_TRIGGER_ID, CONF_QUANTILE, CONF_UNIT_OF_MEASUREMENT, CONF_WINDOW_SIZE, CONF_NAME, CONF_MQTT_ID, \
     CONF_FORCE_UPDATE, UNIT_EMPTY, ICON_EMPTY, DEVICE_CLASS_EMPTY, DEVICE_CLASS_BATTERY, \
     DEVICE_CLASS_CURRENT, DEVICE_CLASS_ENERGY, DEVICE_CLASS_HUMIDITY, DEVICE_CLASS_ILLUMINANCE, \
     DEVICE_CLASS_SIGNAL_STRENGTH, DEVICE_CLASS_TEMPERATURE, DEVICE_CLASS_POWER, \
@@ -25,6 +25,11 @@ DEVICE_CLASSES = [
 
 IS_PLATFORM_COMPONENT = True
 
+CONF_REPORT = 'report'
+CONF_DEADBAND = 'deadband'
+CONF_DEADBAND_PERCENT = 'deadband_percent'
+CONF_MAX_INTERVAL = 'max_interval'
+
 
 def validate_send_first_at(value):
     send_first_at = value.get(CONF_SEND_FIRST_AT)
@@ -68,11 +73,14 @@ SensorRawStateTrigger = sensor_ns.class_('SensorRawStateTrigger',
 ValueRangeTrigger = sensor_ns.class_('ValueRangeTrigger', automation.Trigger.template(cg.float_),
                                      cg.Component)
 SensorPublishAction = sensor_ns.class_('SensorPublishAction', automation.Action)
+ReportPolicy = sensor_ns.class_('ReportPolicy', cg.Component)
 
 # Filters
 Filter = sensor_ns.class_('Filter')
 MedianFilter = sensor_ns.class_('MedianFilter', Filter)
 SlidingWindowMovingAverageFilter = sensor_ns.class_('SlidingWindowMovingAverageFilter', Filter)
+QuantileFilter = sensor_ns.class_('QuantileFilter', Filter)
+ExtremumFilter = sensor_ns.class_('ExtremumFilter', Filter)
 ExponentialMovingAverageFilter = sensor_ns.class_('ExponentialMovingAverageFilter', Filter)
 LambdaFilter = sensor_ns.class_('LambdaFilter', Filter)
 OffsetFilter = sensor_ns.class_('OffsetFilter', Filter)
@@ -92,6 +100,22 @@ accuracy_decimals = cv.int_
 icon = cv.icon
 device_class = cv.one_of(*DEVICE_CLASSES, lower=True, space='_')
 
+def validate_report_intervals(value):
+    max_interval = value.get(CONF_MAX_INTERVAL)
+    if max_interval is not None and max_interval < value[CONF_MIN_INTERVAL]:
+        raise cv.Invalid("max_interval must be greater than or equal to min_interval! {} >= {}"
+                         "".format(max_interval, value[CONF_MIN_INTERVAL]))
+    return value
+
+
+REPORT_POLICY_SCHEMA = cv.All(cv.Schema({
+    cv.GenerateID(): cv.declare_id(ReportPolicy),
+    cv.Optional(CONF_DEADBAND, default=0.0): cv.positive_float,
+    cv.Optional(CONF_DEADBAND_PERCENT, default='0%'): cv.percentage,
+    cv.Optional(CONF_MIN_INTERVAL, default='0ms'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_MAX_INTERVAL): cv.positive_time_period_milliseconds,
+}), validate_report_intervals)
+
 SENSOR_SCHEMA = cv.MQTT_COMPONENT_SCHEMA.extend({
     cv.OnlyWith(CONF_MQTT_ID, 'mqtt'): cv.declare_id(mqtt.MQTTSensorComponent),
     cv.GenerateID(): cv.declare_id(Sensor),
@@ -103,6 +127,7 @@ SENSOR_SCHEMA = cv.MQTT_COMPONENT_SCHEMA.extend({
     cv.Optional(CONF_EXPIRE_AFTER): cv.All(cv.requires_component('mqtt'),
                                            cv.Any(None, cv.positive_time_period_milliseconds)),
     cv.Optional(CONF_FILTERS): validate_filters,
+    cv.Optional(CONF_REPORT): REPORT_POLICY_SCHEMA,
     cv.Optional(CONF_ON_VALUE): automation.validate_automation({
         cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SensorStateTrigger),
     }),
@@ -166,6 +191,39 @@ def median_filter_to_code(config, filter_id):
                            config[CONF_SEND_FIRST_AT])
 
 
+QUANTILE_SCHEMA = cv.All(cv.Schema({
+    cv.Required(CONF_QUANTILE): cv.percentage,
+    cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+    cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
+    cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
+}), validate_send_first_at)
+
+
+@FILTER_REGISTRY.register('quantile', QuantileFilter, QUANTILE_SCHEMA)
+def quantile_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW_SIZE], config[CONF_SEND_EVERY],
+                           config[CONF_SEND_FIRST_AT], config[CONF_QUANTILE])
+
+
+EXTREMUM_SCHEMA = cv.All(cv.Schema({
+    cv.Optional(CONF_WINDOW_SIZE, default=5): cv.positive_not_null_int,
+    cv.Optional(CONF_SEND_EVERY, default=5): cv.positive_not_null_int,
+    cv.Optional(CONF_SEND_FIRST_AT, default=1): cv.positive_not_null_int,
+}), validate_send_first_at)
+
+
+@FILTER_REGISTRY.register('min', ExtremumFilter, EXTREMUM_SCHEMA)
+def min_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW_SIZE], config[CONF_SEND_EVERY],
+                           config[CONF_SEND_FIRST_AT], False)
+
+
+@FILTER_REGISTRY.register('max', ExtremumFilter, EXTREMUM_SCHEMA)
+def max_filter_to_code(config, filter_id):
+    yield cg.new_Pvariable(filter_id, config[CONF_WINDOW_SIZE], config[CONF_SEND_EVERY],
+                           config[CONF_SEND_FIRST_AT], True)
+
+
 SLIDING_AVERAGE_SCHEMA = cv.All(cv.Schema({
     cv.Optional(CONF_WINDOW_SIZE, default=15): cv.positive_not_null_int,
     cv.Optional(CONF_SEND_EVERY, default=15): cv.positive_not_null_int,
@@ -274,9 +332,11 @@ def build_filters(config):
 
 @coroutine
 def setup_sensor_core_(var, config):
-    cg.add(var.set_name(config[CONF_NAME]))
+    cg.setup_entity_name(var, config[CONF_NAME])
     if CONF_INTERNAL in config:
         cg.add(var.set_internal(config[CONF_INTERNAL]))
+    if not config.get(CONF_INTERNAL, False):
+        cg.add_define('USE_CONTROLLER_SENSOR')
     if CONF_DEVICE_CLASS in config:
         cg.add(var.set_device_class(config[CONF_DEVICE_CLASS]))
     if CONF_UNIT_OF_MEASUREMENT in config:
@@ -289,6 +349,16 @@ def setup_sensor_core_(var, config):
     if config.get(CONF_FILTERS):  # must exist and not be empty
         filters = yield build_filters(config[CONF_FILTERS])
         cg.add(var.set_filters(filters))
+    if CONF_REPORT in config:
+        conf = config[CONF_REPORT]
+        policy = cg.new_Pvariable(conf[CONF_ID], var)
+        yield cg.register_component(policy, conf)
+        cg.add(policy.set_deadband(conf[CONF_DEADBAND]))
+        cg.add(policy.set_deadband_percent(conf[CONF_DEADBAND_PERCENT]))
+        cg.add(policy.set_min_interval(conf[CONF_MIN_INTERVAL]))
+        if CONF_MAX_INTERVAL in conf:
+            cg.add(policy.set_max_interval(conf[CONF_MAX_INTERVAL]))
+        cg.add(var.set_report_policy(policy))
 
     for conf in config.get(CONF_ON_VALUE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
@@ -15,6 +15,25 @@ void Filter::input(float value) {
   if (out.has_value())
     this->output(*out);
 }
+size_t Filter::new_values(float *values, size_t count) {
+  size_t out = 0;
+  for (size_t i = 0; i < count; i++) {
+    optional<float> value = this->new_value(values[i]);
+    if (value.has_value())
+      values[out++] = *value;
+  }
+  return out;
+}
+void Filter::input_block(float *values, size_t count) {
+  ESP_LOGVV(TAG, "Filter(%p)::input_block(%u values)", this, count);
+  count = this->new_values(values, count);
+  if (this->next_ == nullptr) {
+    for (size_t i = 0; i < count; i++)
+      this->parent_->internal_send_state_to_frontend(values[i]);
+  } else if (count != 0) {
+    this->next_->input_block(values, count);
+  }
+}
 void Filter::output(float value) {
   if (this->next_ == nullptr) {
     ESP_LOGVV(TAG, "Filter(%p)::output(%f) -> SENSOR", this, value);
@@ -39,17 +58,172 @@ uint32_t Filter::calculate_remaining_interval(uint32_t input) {
   }
 }
 
+// SlidingWindowQuantile
+SlidingWindowQuantile::SlidingWindowQuantile(size_t window_size, float quantile) : quantile_(quantile) {
+  this->set_window_size(window_size);
+}
+void SlidingWindowQuantile::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->values_.assign(window_size, 0.0f);
+  this->lower_.assign(window_size, 0);
+  this->upper_.assign(window_size, 0);
+  this->heap_pos_.assign(window_size, 0);
+  this->in_lower_.assign(window_size, false);
+  this->head_ = 0;
+  this->count_ = 0;
+  this->lower_size_ = 0;
+  this->upper_size_ = 0;
+}
+size_t SlidingWindowQuantile::lower_target_() const {
+  if (this->count_ == 0)
+    return 0;
+  return size_t(floorf(this->quantile_ * (this->count_ - 1))) + 1;
+}
+bool SlidingWindowQuantile::higher_priority_(bool lower, size_t a, size_t b) const {
+  if (lower)
+    return this->values_[a] > this->values_[b];
+  return this->values_[a] < this->values_[b];
+}
+void SlidingWindowQuantile::heap_set_(bool lower, size_t pos, size_t slot) {
+  (lower ? this->lower_ : this->upper_)[pos] = slot;
+  this->heap_pos_[slot] = pos;
+  this->in_lower_[slot] = lower;
+}
+void SlidingWindowQuantile::sift_up_(bool lower, size_t pos) {
+  std::vector<size_t> &heap = lower ? this->lower_ : this->upper_;
+  const size_t slot = heap[pos];
+  while (pos > 0) {
+    const size_t parent = (pos - 1) / 2;
+    if (!this->higher_priority_(lower, slot, heap[parent]))
+      break;
+    this->heap_set_(lower, pos, heap[parent]);
+    pos = parent;
+  }
+  this->heap_set_(lower, pos, slot);
+}
+void SlidingWindowQuantile::sift_down_(bool lower, size_t pos) {
+  std::vector<size_t> &heap = lower ? this->lower_ : this->upper_;
+  const size_t size = lower ? this->lower_size_ : this->upper_size_;
+  const size_t slot = heap[pos];
+  while (true) {
+    size_t child = 2 * pos + 1;
+    if (child >= size)
+      break;
+    if (child + 1 < size && this->higher_priority_(lower, heap[child + 1], heap[child]))
+      child++;
+    if (!this->higher_priority_(lower, heap[child], slot))
+      break;
+    this->heap_set_(lower, pos, heap[child]);
+    pos = child;
+  }
+  this->heap_set_(lower, pos, slot);
+}
+void SlidingWindowQuantile::heap_push_(bool lower, size_t slot) {
+  size_t &size = lower ? this->lower_size_ : this->upper_size_;
+  this->heap_set_(lower, size, slot);
+  this->sift_up_(lower, size++);
+}
+size_t SlidingWindowQuantile::heap_pop_(bool lower) {
+  const size_t top = (lower ? this->lower_ : this->upper_)[0];
+  this->heap_remove_(top);
+  return top;
+}
+void SlidingWindowQuantile::heap_remove_(size_t slot) {
+  const bool lower = this->in_lower_[slot];
+  std::vector<size_t> &heap = lower ? this->lower_ : this->upper_;
+  size_t &size = lower ? this->lower_size_ : this->upper_size_;
+  const size_t pos = this->heap_pos_[slot];
+  const size_t last = heap[--size];
+  if (pos == size)
+    return;
+  // move the last element into the gap and restore the heap property in whichever direction it is violated
+  this->heap_set_(lower, pos, last);
+  if (pos > 0 && this->higher_priority_(lower, last, heap[(pos - 1) / 2])) {
+    this->sift_up_(lower, pos);
+  } else {
+    this->sift_down_(lower, pos);
+  }
+}
+void SlidingWindowQuantile::push(float value) {
+  if (this->window_size_ == 0)
+    return;
+
+  const size_t slot = this->head_;
+  if (this->count_ == this->window_size_) {
+    this->heap_remove_(slot);
+  } else {
+    this->count_++;
+  }
+  this->head_ = (this->head_ + 1) % this->window_size_;
+
+  this->values_[slot] = value;
+  if (this->lower_size_ != 0 && value <= this->values_[this->lower_[0]]) {
+    this->heap_push_(true, slot);
+  } else {
+    this->heap_push_(false, slot);
+  }
+
+  // the target only moves by one per push, so this moves at most two values
+  const size_t target = this->lower_target_();
+  while (this->lower_size_ > target)
+    this->heap_push_(false, this->heap_pop_(true));
+  while (this->lower_size_ < target)
+    this->heap_push_(true, this->heap_pop_(false));
+}
+float SlidingWindowQuantile::get() const {
+  if (this->count_ == 0)
+    return NAN;
+  const float low = this->values_[this->lower_[0]];
+  const float fraction = this->quantile_ * (this->count_ - 1) - float(this->lower_size_ - 1);
+  if (fraction <= 0.0f || this->upper_size_ == 0)
+    return low;
+  const float high = this->values_[this->upper_[0]];
+  return low + (high - low) * fraction;
+}
+
+// SlidingWindowExtremum
+SlidingWindowExtremum::SlidingWindowExtremum(size_t window_size, bool maximum) : maximum_(maximum) {
+  this->set_window_size(window_size);
+}
+void SlidingWindowExtremum::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->values_.assign(window_size, 0.0f);
+  this->sequences_.assign(window_size, 0);
+  this->head_ = 0;
+  this->count_ = 0;
+}
+void SlidingWindowExtremum::push(float value) {
+  if (this->window_size_ == 0)
+    return;
+
+  const uint32_t sequence = this->sequence_++;
+  // drop the oldest candidate if it is no longer part of the window
+  if (this->count_ != 0 && sequence - this->sequences_[this->head_] >= this->window_size_) {
+    this->head_ = (this->head_ + 1) % this->window_size_;
+    this->count_--;
+  }
+  // candidates that are not better than the new value can never become the extremum again
+  while (this->count_ != 0) {
+    const size_t back = (this->head_ + this->count_ - 1) % this->window_size_;
+    const float back_value = this->values_[back];
+    if (this->maximum_ ? back_value > value : back_value < value)
+      break;
+    this->count_--;
+  }
+  const size_t slot = (this->head_ + this->count_) % this->window_size_;
+  this->values_[slot] = value;
+  this->sequences_[slot] = sequence;
+  this->count_++;
+}
+
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : window_(window_size, 0.5f), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) { this->window_.set_window_size(window_size); }
 optional<float> MedianFilter::new_value(float value) {
   if (!isnan(value)) {
-    while (this->queue_.size() >= this->window_size_) {
-      this->queue_.pop_front();
-    }
-    this->queue_.push_back(value);
+    this->window_.push(value);
     ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
   }
 
@@ -57,17 +231,8 @@ optional<float> MedianFilter::new_value(float value) {
     this->send_at_ = 0;
 
     float median = 0.0f;
-    if (!this->queue_.empty()) {
-      std::deque<float> median_queue = this->queue_;
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size % 2) {
-        median = median_queue[queue_size / 2];
-      } else {
-        median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-      }
-    }
+    if (!this->window_.empty())
+      median = this->window_.get();
 
     ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f) SENDING", this, median);
     return median;
@@ -77,26 +242,73 @@ optional<float> MedianFilter::new_value(float value) {
 
 uint32_t MedianFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
 
+// QuantileFilter
+QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
+    : window_(window_size, quantile), send_every_(send_every), send_at_(send_every - send_first_at) {}
+optional<float> QuantileFilter::new_value(float value) {
+  if (!isnan(value)) {
+    this->window_.push(value);
+    ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f)", this, value);
+  }
+
+  if (++this->send_at_ >= this->send_every_) {
+    this->send_at_ = 0;
+    const float result = this->window_.get();
+    ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING", this, result);
+    return result;
+  }
+  return {};
+}
+
+uint32_t QuantileFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+
+// ExtremumFilter
+ExtremumFilter::ExtremumFilter(size_t window_size, size_t send_every, size_t send_first_at, bool maximum)
+    : window_(window_size, maximum), send_every_(send_every), send_at_(send_every - send_first_at) {}
+optional<float> ExtremumFilter::new_value(float value) {
+  if (!isnan(value)) {
+    this->window_.push(value);
+    ESP_LOGVV(TAG, "ExtremumFilter(%p)::new_value(%f)", this, value);
+  }
+
+  if (++this->send_at_ >= this->send_every_) {
+    this->send_at_ = 0;
+    const float result = this->window_.empty() ? NAN : this->window_.get();
+    ESP_LOGVV(TAG, "ExtremumFilter(%p)::new_value(%f) SENDING", this, result);
+    return result;
+  }
+  return {};
+}
+
+uint32_t ExtremumFilter::expected_interval(uint32_t input) { return input * this->send_every_; }
+
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : values_(window_size, 0.0f), send_every_(send_every), send_at_(send_every - send_first_at) {}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->values_.assign(window_size, 0.0f);
+  this->head_ = 0;
+  this->count_ = 0;
+  this->sum_ = 0.0f;
+}
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  if (!isnan(value)) {
-    if (this->queue_.size() == this->window_size_) {
-      this->sum_ -= this->queue_.front();
-      this->queue_.pop();
+  if (!isnan(value) && !this->values_.empty()) {
+    if (this->count_ == this->values_.size()) {
+      this->sum_ -= this->values_[this->head_];
+    } else {
+      this->count_++;
     }
-    this->queue_.push(value);
+    this->values_[this->head_] = value;
+    this->head_ = (this->head_ + 1) % this->values_.size();
     this->sum_ += value;
   }
   float average;
-  if (this->queue_.empty())
+  if (this->count_ == 0)
     average = 0.0f;
   else
-    average = this->sum_ / this->queue_.size();
+    average = this->sum_ / this->count_;
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f) -> %f", this, value, average);
 
   if (++this->send_at_ >= this->send_every_) {
@@ -150,11 +362,23 @@ optional<float> LambdaFilter::new_value(float value) {
 OffsetFilter::OffsetFilter(float offset) : offset_(offset) {}
 
 optional<float> OffsetFilter::new_value(float value) { return value + this->offset_; }
+size_t OffsetFilter::new_values(float *values, size_t count) {
+  const float offset = this->offset_;
+  for (size_t i = 0; i < count; i++)
+    values[i] += offset;
+  return count;
+}
 
 // MultiplyFilter
 MultiplyFilter::MultiplyFilter(float multiplier) : multiplier_(multiplier) {}
 
 optional<float> MultiplyFilter::new_value(float value) { return value * this->multiplier_; }
+size_t MultiplyFilter::new_values(float *values, size_t count) {
+  const float multiplier = this->multiplier_;
+  for (size_t i = 0; i < count; i++)
+    values[i] *= multiplier;
+  return count;
+}
 
 // FilterOutValueFilter
 FilterOutValueFilter::FilterOutValueFilter(float value_to_filter_out) : value_to_filter_out_(value_to_filter_out) {}
@@ -268,6 +492,13 @@ void HeartbeatFilter::setup() {
 float HeartbeatFilter::get_setup_priority() const { return setup_priority::HARDWARE; }
 
 optional<float> CalibrateLinearFilter::new_value(float value) { return value * this->slope_ + this->bias_; }
+size_t CalibrateLinearFilter::new_values(float *values, size_t count) {
+  const float slope = this->slope_;
+  const float bias = this->bias_;
+  for (size_t i = 0; i < count; i++)
+    values[i] = values[i] * slope + bias;
+  return count;
+}
 CalibrateLinearFilter::CalibrateLinearFilter(float slope, float bias) : slope_(slope), bias_(bias) {}
 
 optional<float> CalibratePolynomialFilter::new_value(float value) {
@@ -279,6 +510,21 @@ optional<float> CalibratePolynomialFilter::new_value(float value) {
   }
   return res;
 }
+size_t CalibratePolynomialFilter::new_values(float *values, size_t count) {
+  const float *coefficients = this->coefficients_.data();
+  const size_t num_coefficients = this->coefficients_.size();
+  for (size_t i = 0; i < count; i++) {
+    const float value = values[i];
+    float res = 0.0f;
+    float x = 1.0f;
+    for (size_t j = 0; j < num_coefficients; j++) {
+      res += x * coefficients[j];
+      x *= value;
+    }
+    values[i] = res;
+  }
+  return count;
+}
 
 }  // namespace sensor
 }  // namespace esphome
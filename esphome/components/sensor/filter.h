@@ -1,6 +1,6 @@
 #pragma once
 
-#include <queue>
+#include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
@@ -27,11 +27,26 @@ class Filter {
    */
   virtual optional<float> new_value(float value) = 0;
 
+  /** Block version of new_value(), called when a sensor publishes several samples at once.
+   *
+   * The values are filtered in place, all values that should be pushed out are written to the start of the
+   * array in order. The default implementation calls new_value() for every value, stateless filters override
+   * this with a plain loop.
+   *
+   * @param values The new values, also receives the output values.
+   * @param count The number of values.
+   * @return The number of values that should be pushed out.
+   */
+  virtual size_t new_values(float *values, size_t count);
+
   /// Initialize this filter, please note this can be called more than once.
   virtual void initialize(Sensor *parent, Filter *next);
 
   void input(float value);
 
+  /// Pass a block of values through this filter and the ones after it, values is used as scratch space.
+  void input_block(float *values, size_t count);
+
   /// Return the amount of time that this filter is expected to take based on the input time interval.
   virtual uint32_t expected_interval(uint32_t input);
 
@@ -46,9 +61,93 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
+/** Order statistics over a sliding window of the last window_size values.
+ *
+ * The values are kept in a ring buffer, each of them is also a member of one of two heaps: a max-heap with the
+ * lowest values up to and including the requested quantile, and a min-heap with the others. Every slot of the ring
+ * buffer knows its position in the heaps, so that the oldest value can be removed in O(log n) when it drops out of
+ * the window. All storage is allocated up front.
+ */
+class SlidingWindowQuantile {
+ public:
+  /** Construct a SlidingWindowQuantile.
+   *
+   * @param window_size The number of values in the window.
+   * @param quantile The quantile to track, from 0 (minimum) over 0.5 (median) to 1 (maximum).
+   */
+  SlidingWindowQuantile(size_t window_size, float quantile);
+
+  /// Forget all values and change the window size, this allocates.
+  void set_window_size(size_t window_size);
+
+  /// Add a value, dropping the oldest one if the window is full.
+  void push(float value);
+
+  size_t size() const { return this->count_; }
+  bool empty() const { return this->count_ == 0; }
+
+  /// The quantile of the values in the window, linearly interpolated between the two closest ranks.
+  float get() const;
+
+ protected:
+  /// How many of the lowest count_ values belong into the lower heap.
+  size_t lower_target_() const;
+  bool higher_priority_(bool lower, size_t a, size_t b) const;
+  void heap_set_(bool lower, size_t pos, size_t slot);
+  void sift_up_(bool lower, size_t pos);
+  void sift_down_(bool lower, size_t pos);
+  void heap_push_(bool lower, size_t slot);
+  size_t heap_pop_(bool lower);
+  void heap_remove_(size_t slot);
+
+  float quantile_;
+  size_t window_size_{0};
+  /// Ring buffer of the values, head_ is the oldest value once the window is full.
+  std::vector<float> values_;
+  size_t head_{0};
+  size_t count_{0};
+  /// Slots of values_, lower_ is a max-heap and upper_ a min-heap.
+  std::vector<size_t> lower_;
+  size_t lower_size_{0};
+  std::vector<size_t> upper_;
+  size_t upper_size_{0};
+  /// Position of every slot in its heap.
+  std::vector<size_t> heap_pos_;
+  std::vector<bool> in_lower_;
+};
+
+/** Running minimum or maximum over a sliding window of the last window_size values.
+ *
+ * Uses a monotonic queue in a ring buffer, so pushing a value is amortized O(1) and nothing is allocated after
+ * construction.
+ */
+class SlidingWindowExtremum {
+ public:
+  SlidingWindowExtremum(size_t window_size, bool maximum);
+
+  /// Forget all values and change the window size, this allocates.
+  void set_window_size(size_t window_size);
+
+  void push(float value);
+
+  bool empty() const { return this->count_ == 0; }
+  /// The minimum or maximum of the values in the window.
+  float get() const { return this->values_[this->head_]; }
+
+ protected:
+  bool maximum_;
+  size_t window_size_{0};
+  /// Candidates for the extremum in insertion order, with their sequence numbers.
+  std::vector<float> values_;
+  std::vector<uint32_t> sequences_;
+  size_t head_{0};
+  size_t count_{0};
+  uint32_t sequence_{0};
+};
+
 /** Simple median filter.
  *
- * Takes the median of the last <send_every> values and pushes it out every <send_every>.
+ * Takes the median of the last <window_size> values and pushes it out every <send_every>.
  */
 class MedianFilter : public Filter {
  public:
@@ -70,10 +169,62 @@ class MedianFilter : public Filter {
   uint32_t expected_interval(uint32_t input) override;
 
  protected:
-  std::deque<float> queue_;
+  SlidingWindowQuantile window_;
+  size_t send_every_;
+  size_t send_at_;
+};
+
+/** Quantile filter.
+ *
+ * Takes the given quantile of the last <window_size> values and pushes it out every <send_every>, interpolating
+ * between the two closest values like numpy's default.
+ */
+class QuantileFilter : public Filter {
+ public:
+  /** Construct a QuantileFilter.
+   *
+   * @param window_size The number of values that should be used in the quantile calculation.
+   * @param send_every After how many sensor values should a new one be pushed out.
+   * @param send_first_at After how many values to forward the very first value. Must be less than or equal to
+   *   send_every.
+   * @param quantile The quantile between 0 and 1, for example 0.9 for the 90th percentile.
+   */
+  QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile);
+
+  optional<float> new_value(float value) override;
+
+  uint32_t expected_interval(uint32_t input) override;
+
+ protected:
+  SlidingWindowQuantile window_;
+  size_t send_every_;
+  size_t send_at_;
+};
+
+/** Sliding window minimum or maximum filter.
+ *
+ * Takes the minimum or maximum of the last <window_size> values and pushes it out every <send_every>.
+ */
+class ExtremumFilter : public Filter {
+ public:
+  /** Construct an ExtremumFilter.
+   *
+   * @param window_size The number of values to look at.
+   * @param send_every After how many sensor values should a new one be pushed out.
+   * @param send_first_at After how many values to forward the very first value. Must be less than or equal to
+   *   send_every.
+   * @param maximum Whether to take the maximum instead of the minimum.
+   */
+  ExtremumFilter(size_t window_size, size_t send_every, size_t send_first_at, bool maximum);
+
+  optional<float> new_value(float value) override;
+
+  uint32_t expected_interval(uint32_t input) override;
+
+ protected:
+  SlidingWindowExtremum window_;
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple sliding window moving average filter.
@@ -102,10 +253,12 @@ class SlidingWindowMovingAverageFilter : public Filter {
 
  protected:
   float sum_{0.0};
-  std::queue<float> queue_;
+  /// Ring buffer of the last window_size values, head_ is the oldest one once it is full.
+  std::vector<float> values_;
+  size_t head_{0};
+  size_t count_{0};
   size_t send_every_;
   size_t send_at_;
-  size_t window_size_;
 };
 
 /** Simple exponential moving average filter.
@@ -160,6 +313,7 @@ class OffsetFilter : public Filter {
   explicit OffsetFilter(float offset);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float offset_;
@@ -171,6 +325,7 @@ class MultiplyFilter : public Filter {
   explicit MultiplyFilter(float multiplier);
 
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float multiplier_;
@@ -267,6 +422,7 @@ class CalibrateLinearFilter : public Filter {
  public:
   CalibrateLinearFilter(float slope, float bias);
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   float slope_;
@@ -277,6 +433,7 @@ class CalibratePolynomialFilter : public Filter {
  public:
   CalibratePolynomialFilter(const std::vector<float> &coefficients) : coefficients_(coefficients) {}
   optional<float> new_value(float value) override;
+  size_t new_values(float *values, size_t count) override;
 
  protected:
   std::vector<float> coefficients_;
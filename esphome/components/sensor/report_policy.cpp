@@ -0,0 +1,60 @@
+#include "report_policy.h"
+#include "sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace sensor {
+
+static const char *TAG = "sensor.report_policy";
+
+ReportPolicy::ReportPolicy(Sensor *parent) : parent_(parent), pending_(NAN) {}
+
+void ReportPolicy::dump_config() {
+  ESP_LOGCONFIG(TAG, "Report Policy of '%s':", this->parent_->get_name().c_str());
+  ESP_LOGCONFIG(TAG, "  Deadband: %.3f (%.1f%%)", this->deadband_, this->deadband_percent_ * 100.0f);
+  if (this->min_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Min Interval: %u ms", this->min_interval_);
+  if (this->max_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Max Interval: %u ms", this->max_interval_);
+}
+float ReportPolicy::get_setup_priority() const { return setup_priority::HARDWARE; }
+
+void ReportPolicy::input(float state) {
+  if (!this->is_significant_(state)) {
+    // the state went back to about what was reported, a held back change is obsolete
+    this->cancel_timeout("min_interval");
+    return;
+  }
+
+  const uint32_t elapsed = millis() - this->last_report_time_;
+  if (this->has_reported_ && elapsed < this->min_interval_) {
+    this->pending_ = state;
+    this->set_timeout("min_interval", this->min_interval_ - elapsed, [this]() { this->report_(this->pending_); });
+    return;
+  }
+  this->report_(state);
+}
+
+bool ReportPolicy::is_significant_(float state) const {
+  if (!this->has_reported_ || this->parent_->get_force_update())
+    return true;
+  if (std::isnan(state) || std::isnan(this->last_reported_))
+    return std::isnan(state) != std::isnan(this->last_reported_);
+  const float change = fabsf(state - this->last_reported_);
+  return change > this->deadband_ && change > fabsf(this->last_reported_) * this->deadband_percent_;
+}
+
+void ReportPolicy::report_(float state) {
+  this->has_reported_ = true;
+  this->last_reported_ = state;
+  this->last_report_time_ = millis();
+  this->cancel_timeout("min_interval");
+  if (this->max_interval_ != 0) {
+    // re-armed by every report, so it only fires when nothing was reported for max_interval
+    this->set_timeout("max_interval", this->max_interval_, [this]() { this->report_(this->parent_->state); });
+  }
+  this->parent_->internal_report_state(state);
+}
+
+}  // namespace sensor
+}  // namespace esphome
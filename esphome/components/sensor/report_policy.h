@@ -0,0 +1,57 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace sensor {
+
+class Sensor;
+
+/** Decides which filtered states of a sensor are reported to the transports (native API, MQTT, web server).
+ *
+ * All states still update Sensor::state and trigger the on_value automations, only the reports to the
+ * transports are gated, once for all of them. Without a policy every state is reported.
+ *
+ * A state is reported when it differs from the last reported one by more than the deadbands (force_update
+ * sensors report every state). Changes within min_interval of the last report are held back and the latest of
+ * them is reported once the interval is over. With max_interval the current state is reported again if nothing
+ * was reported for that long.
+ */
+class ReportPolicy : public Component {
+ public:
+  explicit ReportPolicy(Sensor *parent);
+
+  /// The absolute change to the last reported state that is not reported, 0 to only drop identical states.
+  void set_deadband(float deadband) { this->deadband_ = deadband; }
+  /// The change relative to the last reported state that is not reported, as a fraction (0.05 for 5%).
+  void set_deadband_percent(float deadband_percent) { this->deadband_percent_ = deadband_percent; }
+  void set_min_interval(uint32_t min_interval) { this->min_interval_ = min_interval; }
+  void set_max_interval(uint32_t max_interval) { this->max_interval_ = max_interval; }
+  /// The longest time between two reports, 0 if states within the deadbands may never be reported.
+  uint32_t get_max_interval() const { return this->max_interval_; }
+
+  void dump_config() override;
+  float get_setup_priority() const override;
+
+  /// Called by the sensor with every filtered state.
+  void input(float state);
+
+ protected:
+  bool is_significant_(float state) const;
+  void report_(float state);
+
+  Sensor *parent_;
+  float deadband_{0.0f};
+  float deadband_percent_{0.0f};
+  uint32_t min_interval_{0};
+  uint32_t max_interval_{0};
+  bool has_reported_{false};
+  float last_reported_{NAN};
+  uint32_t last_report_time_{0};
+  /// The latest significant state held back by min_interval.
+  float pending_;
+};
+
+}  // namespace sensor
+}  // namespace esphome
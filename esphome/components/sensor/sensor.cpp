@@ -5,8 +5,12 @@ namespace esphome {
 namespace sensor {
 
 static const char *TAG = "sensor";
+static const size_t SENSOR_SAMPLE_BLOCK_SIZE = 32;
 
 void Sensor::publish_state(float state) {
+#ifdef USE_STATE_TRACE
+  this->trace_ = global_state_tracer.begin();
+#endif
   this->raw_state = state;
   this->raw_callback_.call(state);
 
@@ -18,6 +22,34 @@ void Sensor::publish_state(float state) {
     this->filter_list_->input(state);
   }
 }
+void Sensor::publish_samples(const float *samples, size_t count) {
+  if (count == 0)
+    return;
+#ifdef USE_STATE_TRACE
+  this->trace_ = global_state_tracer.begin();
+#endif
+  for (size_t i = 0; i < count; i++) {
+    this->raw_state = samples[i];
+    this->raw_callback_.call(samples[i]);
+  }
+
+  ESP_LOGV(TAG, "'%s': Received %u new states", this->name_.c_str(), count);
+
+  if (this->filter_list_ == nullptr) {
+    for (size_t i = 0; i < count; i++)
+      this->internal_send_state_to_frontend(samples[i]);
+    return;
+  }
+  // the filters work in place, so copy the samples over in chunks
+  float block[SENSOR_SAMPLE_BLOCK_SIZE];
+  while (count != 0) {
+    const size_t block_size = std::min(count, SENSOR_SAMPLE_BLOCK_SIZE);
+    memcpy(block, samples, block_size * sizeof(float));
+    this->filter_list_->input_block(block, block_size);
+    samples += block_size;
+    count -= block_size;
+  }
+}
 void Sensor::push_new_value(float state) { this->publish_state(state); }
 std::string Sensor::unit_of_measurement() { return ""; }
 std::string Sensor::icon() { return ""; }
@@ -35,6 +67,9 @@ void Sensor::add_on_state_callback(std::function<void(float)> &&callback) { this
 void Sensor::add_on_raw_state_callback(std::function<void(float)> &&callback) {
   this->raw_callback_.add(std::move(callback));
 }
+void Sensor::add_on_report_callback(std::function<void(float)> &&callback) {
+  this->report_callback_.add(std::move(callback));
+}
 std::string Sensor::get_icon() {
   if (this->icon_.has_value())
     return *this->icon_;
@@ -97,7 +132,29 @@ void Sensor::internal_send_state_to_frontend(float state) {
   this->state = state;
   ESP_LOGD(TAG, "'%s': Sending state %.5f %s with %d decimals of accuracy", this->get_name().c_str(), state,
            this->get_unit_of_measurement().c_str(), this->get_accuracy_decimals());
+#ifdef USE_STATE_TRACE
+  global_state_tracer.record(STATE_TRACE_FILTERED, this->trace_);
+  const StateTrace previous = global_state_tracer.set_current(this->trace_);
+#endif
   this->callback_.call(state);
+  if (this->report_policy_ == nullptr) {
+    this->report_callback_.call(state);
+  } else {
+    this->report_policy_->input(state);
+  }
+#ifdef USE_STATE_TRACE
+  global_state_tracer.set_current(previous);
+#endif
+}
+void Sensor::internal_report_state(float state) {
+#ifdef USE_STATE_TRACE
+  // reports held back by the policy still belong to the last raw state
+  const StateTrace previous = global_state_tracer.set_current(this->trace_);
+  this->report_callback_.call(state);
+  global_state_tracer.set_current(previous);
+#else
+  this->report_callback_.call(state);
+#endif
 }
 bool Sensor::has_state() const { return this->has_state_; }
 uint32_t Sensor::calculate_expected_filter_update_interval() {
@@ -2,7 +2,9 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/state_trace.h"
 #include "esphome/components/sensor/filter.h"
+#include "esphome/components/sensor/report_policy.h"
 
 namespace esphome {
 namespace sensor {
@@ -103,6 +105,17 @@ class Sensor : public Nameable {
    */
   void publish_state(float state);
 
+  /** Publish a block of samples, for example from a sensor that reads a FIFO or samples quickly in loop().
+   *
+   * Every sample is a raw state, but they pass the filters a block at a time (see Filter::new_values()), which
+   * saves most of the per-value overhead for downsampling filter chains. Filters see all samples within
+   * the same millisecond, so time based filters like throttle only let the first one through.
+   *
+   * @param samples The samples, oldest first.
+   * @param count The number of samples.
+   */
+  void publish_samples(const float *samples, size_t count);
+
   /** Push a new value to the MQTT front-end.
    *
    * Note: deprecated, please use publish_state.
@@ -115,6 +128,15 @@ class Sensor : public Nameable {
   void add_on_state_callback(std::function<void(float)> &&callback);
   /// Add a callback that will be called every time the sensor sends a raw value.
   void add_on_raw_state_callback(std::function<void(float)> &&callback);
+  /** Add a callback that will be called with every state that should be sent to the transports.
+   *
+   * These are the filtered states that pass the report policy, or all of them if there is none.
+   */
+  void add_on_report_callback(std::function<void(float)> &&callback);
+
+  /// Gate the states reported to the transports, see ReportPolicy.
+  void set_report_policy(ReportPolicy *report_policy) { this->report_policy_ = report_policy; }
+  ReportPolicy *get_report_policy() const { return this->report_policy_; }
 
   /** This member variable stores the last state that has passed through all filters.
    *
@@ -161,6 +183,8 @@ class Sensor : public Nameable {
   uint32_t calculate_expected_filter_update_interval();
 
   void internal_send_state_to_frontend(float state);
+  /// Send the state to the transports, called by the report policy.
+  void internal_report_state(float state);
 
   bool get_force_update() const { return force_update_; }
   /** Set this sensor's force_update mode.
@@ -195,8 +219,9 @@ class Sensor : public Nameable {
 
   uint32_t hash_base() override;
 
-  CallbackManager<void(float)> raw_callback_;  ///< Storage for raw state callbacks.
-  CallbackManager<void(float)> callback_;      ///< Storage for filtered state callbacks.
+  CallbackManager<void(float)> raw_callback_;     ///< Storage for raw state callbacks.
+  CallbackManager<void(float)> callback_;         ///< Storage for filtered state callbacks.
+  CallbackManager<void(float)> report_callback_;  ///< Storage for the callbacks of the transports.
   /// Override the unit of measurement
   optional<std::string> unit_of_measurement_;
   /// Override the icon advertised to Home Assistant, otherwise sensor's icon will be used.
@@ -204,8 +229,13 @@ class Sensor : public Nameable {
   /// Override the accuracy in decimals, otherwise the sensor's values will be used.
   optional<int8_t> accuracy_decimals_;
   Filter *filter_list_{nullptr};  ///< Store all active filters.
+  ReportPolicy *report_policy_{nullptr};
   bool has_state_{false};
   bool force_update_{false};
+#ifdef USE_STATE_TRACE
+  /// The trace of the last raw state, filters that output later still belong to it.
+  StateTrace trace_{};
+#endif
 };
 
 class PollingSensorComponent : public PollingComponent, public Sensor {
@@ -4,7 +4,7 @@ from esphome import automation
 from esphome.automation import maybe_simple_id
 from esphome.components.output import FloatOutput
 from esphome.const import CONF_ID, CONF_IDLE_LEVEL, CONF_MAX_LEVEL, CONF_MIN_LEVEL, CONF_OUTPUT, \
-    CONF_LEVEL, CONF_RESTORE, CONF_TRANSITION_LENGTH
+    CONF_LEVEL, CONF_RESTORE, CONF_TRANSITION_LENGTH, CONF_ACCELERATION
 
 servo_ns = cg.esphome_ns.namespace('servo')
 Servo = servo_ns.class_('Servo', cg.Component)
@@ -12,6 +12,7 @@ ServoWriteAction = servo_ns.class_('ServoWriteAction', automation.Action)
 ServoDetachAction = servo_ns.class_('ServoDetachAction', automation.Action)
 
 CONF_AUTO_DETACH_TIME = 'auto_detach_time'
+CONF_JERK = 'jerk'
 MULTI_CONF = True
 CONFIG_SCHEMA = cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(Servo),
@@ -21,7 +22,10 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_MAX_LEVEL, default='12%'): cv.percentage,
     cv.Optional(CONF_RESTORE, default=False): cv.boolean,
     cv.Optional(CONF_AUTO_DETACH_TIME, default='0s'): cv.positive_time_period_milliseconds,
-    cv.Optional(CONF_TRANSITION_LENGTH, default='0s'): cv.positive_time_period_milliseconds
+    cv.Optional(CONF_TRANSITION_LENGTH, default='0s'): cv.positive_time_period_milliseconds,
+    # in levels from -1.0 to 1.0 per s² and per s³
+    cv.Optional(CONF_ACCELERATION): cv.float_range(min=0, min_included=False),
+    cv.Optional(CONF_JERK): cv.float_range(min=0, min_included=False),
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -37,6 +41,10 @@ def to_code(config):
     cg.add(var.set_restore(config[CONF_RESTORE]))
     cg.add(var.set_auto_detach_time(config[CONF_AUTO_DETACH_TIME]))
     cg.add(var.set_transition_length(config[CONF_TRANSITION_LENGTH]))
+    if CONF_ACCELERATION in config:
+        cg.add(var.set_acceleration(config[CONF_ACCELERATION]))
+    if CONF_JERK in config:
+        cg.add(var.set_jerk(config[CONF_JERK]))
 
 
 @automation.register_action('servo.write', ServoWriteAction, cv.Schema({
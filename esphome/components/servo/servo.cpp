@@ -15,48 +15,59 @@ void Servo::dump_config() {
   ESP_LOGCONFIG(TAG, "  Max Level: %.1f%%", this->max_level_ * 100.0f);
   ESP_LOGCONFIG(TAG, "  auto detach time: %d ms", this->auto_detach_time_);
   ESP_LOGCONFIG(TAG, "  run duration: %d ms", this->transition_length_);
+  if (this->acceleration_ != 0.0f)
+    ESP_LOGCONFIG(TAG, "  Acceleration: %.2f/s²", this->acceleration_);
+  if (this->jerk_ != 0.0f)
+    ESP_LOGCONFIG(TAG, "  Jerk: %.2f/s³", this->jerk_);
 }
 
-void Servo::loop() {
-  // check if auto_detach_time_ is set and servo reached target
-  if (this->auto_detach_time_ && this->state_ == STATE_TARGET_REACHED) {
-    if (millis() - this->start_millis_ > this->auto_detach_time_) {
-      this->detach();
-      this->start_millis_ = 0;
-      this->state_ = STATE_DETACHED;
-      ESP_LOGD(TAG, "Servo detached on auto_detach_time");
-    }
-  }
-  if (this->target_value_ != this->current_value_ && this->state_ == STATE_ATTACHED) {
-    if (this->transition_length_) {
-      float new_value;
-      float travel_diff = this->target_value_ - this->source_value_;
-      uint32_t target_runtime = target_runtime = abs((int) ((travel_diff) * this->transition_length_ * 1.0f / 2.0f));
-      uint32_t current_runtime = millis() - this->start_millis_;
-      float percentage_run = current_runtime * 1.0f / target_runtime * 1.0f;
-      if (percentage_run > 1.0f) {
-        percentage_run = 1.0f;
-      }
-      new_value = this->target_value_ - (1.0f - percentage_run) * (this->target_value_ - this->source_value_);
-      this->internal_write(new_value);
-    } else {
-      this->internal_write(this->target_value_);
+void Servo::setup() {
+  // the transition length is the time to move over the full range from -1.0 to 1.0
+  if (this->transition_length_ != 0)
+    this->profile_.set_max_velocity(2000.0f / this->transition_length_);
+  this->profile_.set_max_acceleration(this->acceleration_);
+  this->profile_.set_jerk(this->jerk_);
+  this->profile_.set_write_callback([this](float value) {
+    this->internal_write(value);
+    if (!this->profile_.is_moving())
+      this->on_target_reached_();
+  });
+
+  float v;
+  if (this->restore_) {
+    this->rtc_ = global_preferences.make_preference<float>(global_servo_id);
+    global_servo_id++;
+    if (this->rtc_.load(&v)) {
+      this->output_->set_level(v);
+      // continue moves from the restored value
+      if (v >= this->idle_level_ && this->max_level_ != this->idle_level_)
+        this->profile_.reset((v - this->idle_level_) / (this->max_level_ - this->idle_level_));
+      else if (v < this->idle_level_ && this->min_level_ != this->idle_level_)
+        this->profile_.reset(-(v - this->idle_level_) / (this->min_level_ - this->idle_level_));
+      return;
     }
   }
-  if (this->target_value_ == this->current_value_ && this->state_ == STATE_ATTACHED) {
-    this->state_ = STATE_TARGET_REACHED;
-    this->start_millis_ = millis();  // set current stamp for potential auto_detach_time_ check
-    ESP_LOGD(TAG, "Servo reached target");
+  this->detach();
+}
+
+void Servo::on_target_reached_() {
+  this->state_ = STATE_TARGET_REACHED;
+  this->save_level_(this->level_);
+  ESP_LOGD(TAG, "Servo reached target");
+  if (this->auto_detach_time_) {
+    this->set_timeout("detach", this->auto_detach_time_, [this]() {
+      this->detach();
+      ESP_LOGD(TAG, "Servo detached on auto_detach_time");
+    });
   }
 }
 
 void Servo::write(float value) {
   value = clamp(value, -1.0f, 1.0f);
-  this->target_value_ = value;
-  this->source_value_ = this->current_value_;
   this->state_ = STATE_ATTACHED;
-  this->start_millis_ = millis();
+  this->cancel_timeout("detach");
   ESP_LOGD(TAG, "Servo new target: %f", value);
+  this->profile_.move_to(value);
 }
 
 void Servo::internal_write(float value) {
@@ -67,10 +78,7 @@ void Servo::internal_write(float value) {
   else
     level = lerp(value, this->idle_level_, this->max_level_);
   this->output_->set_level(level);
-  if (this->target_value_ == this->current_value_) {
-    this->save_level_(level);
-  }
-  this->current_value_ = value;
+  this->level_ = level;
 }
 
 }  // namespace servo
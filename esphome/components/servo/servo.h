@@ -5,6 +5,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
 #include "esphome/components/output/float_output.h"
+#include "esphome/components/output/motion_profile.h"
 
 namespace esphome {
 namespace servo {
@@ -14,25 +15,17 @@ extern uint32_t global_servo_id;
 class Servo : public Component {
  public:
   void set_output(output::FloatOutput *output) { output_ = output; }
-  void loop() override;
   void write(float value);
   void internal_write(float value);
   void detach() {
+    // stop where it is, the servo doesn't hold its position anymore
+    this->profile_.reset(this->profile_.get_position());
+    this->cancel_timeout("detach");
+    this->state_ = STATE_DETACHED;
     this->output_->set_level(0.0f);
     this->save_level_(0.0f);
   }
-  void setup() override {
-    float v;
-    if (this->restore_) {
-      this->rtc_ = global_preferences.make_preference<float>(global_servo_id);
-      global_servo_id++;
-      if (this->rtc_.load(&v)) {
-        this->output_->set_level(v);
-        return;
-      }
-    }
-    this->detach();
-  }
+  void setup() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   void set_min_level(float min_level) { min_level_ = min_level; }
@@ -41,9 +34,14 @@ class Servo : public Component {
   void set_restore(bool restore) { restore_ = restore; }
   void set_auto_detach_time(uint32_t auto_detach_time) { auto_detach_time_ = auto_detach_time; }
   void set_transition_length(uint32_t transition_length) { transition_length_ = transition_length; }
+  /// The maximum acceleration in levels (from -1.0 to 1.0) per second squared, 0 for none.
+  void set_acceleration(float acceleration) { acceleration_ = acceleration; }
+  /// The maximum jerk in levels per second cubed, this smoothens the start and end of the acceleration.
+  void set_jerk(float jerk) { jerk_ = jerk; }
 
  protected:
   void save_level_(float v) { this->rtc_.save(&v); }
+  void on_target_reached_();
 
   output::FloatOutput *output_;
   float min_level_ = 0.0300f;
@@ -52,12 +50,12 @@ class Servo : public Component {
   bool restore_{false};
   uint32_t auto_detach_time_ = 0;
   uint32_t transition_length_ = 0;
+  float acceleration_ = 0;
+  float jerk_ = 0;
   ESPPreferenceObject rtc_;
-  uint8_t state_;
-  float target_value_ = 0;
-  float source_value_ = 0;
-  float current_value_ = 0;
-  uint32_t start_millis_ = 0;
+  uint8_t state_{STATE_DETACHED};
+  output::MotionProfile profile_;
+  float level_{0.0f};
   enum State {
     STATE_ATTACHED = 0,
     STATE_DETACHED = 1,
@@ -1,6 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import i2c, sensor
+from esphome.components import calibration, i2c, sensor
 from esphome.const import CONF_ID, ICON_RADIATOR, UNIT_PARTS_PER_MILLION, \
     UNIT_PARTS_PER_BILLION, ICON_MOLECULE_CO2
 
@@ -32,13 +32,15 @@ CONFIG_SCHEMA = cv.Schema({
         cv.Required(CONF_HUMIDITY_SOURCE): cv.use_id(sensor.Sensor),
         cv.Required(CONF_TEMPERATURE_SOURCE): cv.use_id(sensor.Sensor)
     }),
-}).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x58))
+}).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x58)).extend(
+    calibration.CALIBRATION_SCHEMA)
 
 
 def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
     yield i2c.register_i2c_device(var, config)
+    yield calibration.register_calibration(var, config)
 
     if CONF_ECO2 in config:
         sens = yield sensor.new_sensor(config[CONF_ECO2])
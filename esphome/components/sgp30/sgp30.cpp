@@ -73,6 +73,16 @@ void SGP30Component::setup() {
     return;
   }
 
+#ifdef USE_CALIBRATION
+  SGP30Baseline baseline;
+  if ((this->eco2_baseline_ == 0 || this->tvoc_baseline_ == 0) && this->calibration_ != nullptr &&
+      this->calibration_->load(&baseline)) {
+    ESP_LOGD(TAG, "Restored eCO2 baseline: 0x%04X, TVOC baseline: 0x%04X", baseline.eco2, baseline.tvoc);
+    this->eco2_baseline_ = baseline.eco2;
+    this->tvoc_baseline_ = baseline.tvoc;
+  }
+#endif
+
   // Sensor baseline reliability timer
   if (this->eco2_baseline_ > 0 && this->tvoc_baseline_ > 0) {
     this->required_warm_up_time_ = IAQ_BASELINE_WARM_UP_SECONDS_WITH_BASELINE_PROVIDED;
@@ -110,6 +120,10 @@ void SGP30Component::read_iaq_baseline_() {
       uint16_t tvocbaseline = (raw_data[1]);
 
       ESP_LOGI(TAG, "Current eCO2 baseline: 0x%04X, TVOC baseline: 0x%04X", eco2baseline, tvocbaseline);
+#ifdef USE_CALIBRATION
+      if (this->calibration_ != nullptr)
+        this->calibration_->save(SGP30Baseline{eco2baseline, tvocbaseline});
+#endif
       this->status_clear_warning();
     });
   } else {
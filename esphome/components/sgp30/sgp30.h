@@ -3,11 +3,21 @@
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/i2c/i2c.h"
+#include "esphome/core/defines.h"
 #include <cmath>
 
+#ifdef USE_CALIBRATION
+#include "esphome/components/calibration/calibration_store.h"
+#endif
+
 namespace esphome {
 namespace sgp30 {
 
+struct SGP30Baseline {
+  uint16_t eco2;
+  uint16_t tvoc;
+};
+
 /// This class implements support for the Sensirion SGP30 i2c GAS (VOC and CO2eq) sensors.
 class SGP30Component : public PollingComponent, public i2c::I2CDevice {
  public:
@@ -17,6 +27,12 @@ class SGP30Component : public PollingComponent, public i2c::I2CDevice {
   void set_tvoc_baseline(uint16_t tvoc_baseline) { tvoc_baseline_ = tvoc_baseline; }
   void set_humidity_sensor(sensor::Sensor *humidity) { humidity_sensor_ = humidity; }
   void set_temperature_sensor(sensor::Sensor *temperature) { temperature_sensor_ = temperature; }
+#ifdef USE_CALIBRATION
+  /// Keep the baselines across reboots, when no baselines are configured.
+  void set_calibration_store(calibration::CalibrationStore *store, uint32_t key) {
+    this->calibration_ = store->add_entry<SGP30Baseline>(key);
+  }
+#endif
 
   void setup() override;
   void update() override;
@@ -50,6 +66,9 @@ class SGP30Component : public PollingComponent, public i2c::I2CDevice {
   /// Input sensor for humidity and temperature compensation.
   sensor::Sensor *humidity_sensor_{nullptr};
   sensor::Sensor *temperature_sensor_{nullptr};
+#ifdef USE_CALIBRATION
+  calibration::CalibrationEntry *calibration_{nullptr};
+#endif
 };
 
 }  // namespace sgp30
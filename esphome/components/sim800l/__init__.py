@@ -5,6 +5,7 @@ from esphome.const import CONF_ID, CONF_TRIGGER_ID
 from esphome.components import uart
 
 DEPENDENCIES = ['uart']
+AUTO_LOAD = ['at_command']
 CODEOWNERS = ['@glmnet']
 MULTI_CONF = True
 
@@ -1,42 +1,23 @@
 #pragma once
 
 #include "esphome/core/component.h"
-#include "esphome/components/uart/uart.h"
 #include "esphome/core/automation.h"
+#include "esphome/components/at_command/at_command.h"
 
 namespace esphome {
 namespace sim800l {
 
-const uint8_t SIM800L_READ_BUFFER_LENGTH = 255;
-
-enum State {
-  STATE_IDLE = 0,
-  STATE_INIT,
-  STATE_CHECK_AT,
-  STATE_CREG,
-  STATE_CREGWAIT,
-  STATE_CSQ,
-  STATE_CSQ_RESPONSE,
-  STATE_IDLEWAIT,
-  STATE_SENDINGSMS1,
-  STATE_SENDINGSMS2,
-  STATE_SENDINGSMS3,
-  STATE_CHECK_SMS,
-  STATE_PARSE_SMS,
-  STATE_PARSE_SMS_RESPONSE,
-  STATE_RECEIVESMS,
-  STATE_READSMS,
-  STATE_RECEIVEDSMS,
-  STATE_DELETEDSMS,
-  STATE_DISABLE_ECHO,
-  STATE_PARSE_SMS_OK
-};
-
-class Sim800LComponent : public uart::UARTDevice, public PollingComponent {
+/** SMS over a SIM800L modem.
+ *
+ * The modem announces new messages with +CMTI, they are read right away. The registration and the signal quality are
+ * checked and stored messages are read every update interval. A message is sent as soon as the modem is registered.
+ */
+class Sim800LComponent : public at_command::ATDevice, public PollingComponent {
  public:
-  /// Retrieve the latest sensor values. This operation takes approximately 16ms.
+  void setup() override;
   void update() override;
   void loop() override;
+  bool is_loop_idle() override { return this->is_at_idle(); }
   void dump_config() override;
   void add_on_sms_received_callback(std::function<void(std::string, std::string)> callback) {
     this->callback_.add(std::move(callback));
@@ -44,22 +25,25 @@ class Sim800LComponent : public uart::UARTDevice, public PollingComponent {
   void send_sms(std::string recipient, std::string message);
 
  protected:
-  void send_cmd_(std::string);
-  void parse_cmd_(std::string);
+  void initialize_();
+  void send_pending_sms_();
+  /// List the stored messages and delete them once they have been passed on.
+  void read_messages_();
+  void on_message_line_(const at_command::ATLine &line);
 
-  std::string sender_;
-  char read_buffer_[SIM800L_READ_BUFFER_LENGTH];
-  size_t read_pos_{0};
-  uint8_t parse_index_{0};
-  uint8_t watch_dog_{0};
-  bool expect_ack_{false};
-  sim800l::State state_{STATE_IDLE};
+  bool initialized_{false};
   bool registered_{false};
   int rssi_{0};
 
+  bool reading_messages_{false};
+  /// The storage index of the message whose text is the next line, -1 if none.
+  int16_t message_index_{-1};
+  std::string sender_;
+  std::vector<uint16_t> read_indices_;
+
   std::string recipient_;
   std::string outgoing_message_;
-  bool send_pending_;
+  bool send_pending_{false};
 
   CallbackManager<void(std::string, std::string)> callback_;
 };
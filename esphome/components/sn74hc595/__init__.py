@@ -1,7 +1,9 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
-from esphome.const import CONF_ID, CONF_NUMBER, CONF_INVERTED, CONF_DATA_PIN, CONF_CLOCK_PIN
+from esphome.components import spi
+from esphome.const import CONF_ID, CONF_NUMBER, CONF_INVERTED, CONF_DATA_PIN, CONF_CLOCK_PIN, \
+    CONF_SPI_ID
 
 DEPENDENCIES = []
 MULTI_CONF = True
@@ -15,23 +17,41 @@ CONF_SN74HC595 = 'sn74hc595'
 CONF_LATCH_PIN = 'latch_pin'
 CONF_OE_PIN = 'oe_pin'
 CONF_SR_COUNT = 'sr_count'
-CONFIG_SCHEMA = cv.Schema({
+
+def validate_interface(config):
+    has_pins = CONF_DATA_PIN in config or CONF_CLOCK_PIN in config
+    if CONF_SPI_ID in config:
+        if has_pins:
+            raise cv.Invalid("data_pin and clock_pin can't be used together with spi_id, the SPI bus "
+                             "provides them")
+    elif CONF_DATA_PIN not in config or CONF_CLOCK_PIN not in config:
+        raise cv.Invalid("Either data_pin and clock_pin or spi_id are required")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.Required(CONF_ID): cv.declare_id(SN74HC595Component),
-    cv.Required(CONF_DATA_PIN): pins.gpio_output_pin_schema,
-    cv.Required(CONF_CLOCK_PIN): pins.gpio_output_pin_schema,
+    cv.Optional(CONF_DATA_PIN): pins.gpio_output_pin_schema,
+    cv.Optional(CONF_CLOCK_PIN): pins.gpio_output_pin_schema,
+    cv.Optional(CONF_SPI_ID): cv.use_id(spi.SPIComponent),
     cv.Required(CONF_LATCH_PIN): pins.gpio_output_pin_schema,
     cv.Optional(CONF_OE_PIN): pins.gpio_output_pin_schema,
     cv.Optional(CONF_SR_COUNT, default=1): cv.int_range(1, 4)
-}).extend(cv.COMPONENT_SCHEMA)
+}).extend(cv.COMPONENT_SCHEMA), validate_interface)
 
 
 def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
-    data_pin = yield cg.gpio_pin_expression(config[CONF_DATA_PIN])
-    cg.add(var.set_data_pin(data_pin))
-    clock_pin = yield cg.gpio_pin_expression(config[CONF_CLOCK_PIN])
-    cg.add(var.set_clock_pin(clock_pin))
+    if CONF_SPI_ID in config:
+        cg.add_define('USE_SN74HC595_SPI')
+        parent = yield cg.get_variable(config[CONF_SPI_ID])
+        cg.add(var.set_spi_parent(parent))
+    else:
+        data_pin = yield cg.gpio_pin_expression(config[CONF_DATA_PIN])
+        cg.add(var.set_data_pin(data_pin))
+        clock_pin = yield cg.gpio_pin_expression(config[CONF_CLOCK_PIN])
+        cg.add(var.set_clock_pin(clock_pin))
     latch_pin = yield cg.gpio_pin_expression(config[CONF_LATCH_PIN])
     cg.add(var.set_latch_pin(latch_pin))
     if CONF_OE_PIN in config:
@@ -15,42 +15,82 @@ void SN74HC595Component::setup() {
   }
 
   // initialize output pins
-  this->clock_pin_->pin_mode(OUTPUT);
-  this->data_pin_->pin_mode(OUTPUT);
   this->latch_pin_->pin_mode(OUTPUT);
-  this->clock_pin_->digital_write(LOW);
-  this->data_pin_->digital_write(LOW);
-  this->latch_pin_->digital_write(LOW);
+#ifdef USE_SN74HC595_SPI
+  if (this->use_spi_) {
+    // the latch pin is the chip select, the rising edge when the transfer ends latches the data
+    this->spi_.set_cs_pin(this->latch_pin_);
+    this->spi_.spi_setup();
+  }
+#endif
+  if (!this->use_spi_) {
+    this->clock_pin_->pin_mode(OUTPUT);
+    this->data_pin_->pin_mode(OUTPUT);
+    this->clock_pin_->digital_write(LOW);
+    this->data_pin_->digital_write(LOW);
+    this->latch_pin_->digital_write(LOW);
+  }
 
   // send state to shift register
   this->write_gpio_();
 }
 
-void SN74HC595Component::dump_config() { ESP_LOGCONFIG(TAG, "SN74HC595:"); }
+void SN74HC595Component::dump_config() {
+  ESP_LOGCONFIG(TAG, "SN74HC595:");
+  ESP_LOGCONFIG(TAG, "  Shift registers: %u", this->sr_count_);
+  ESP_LOGCONFIG(TAG, "  Interface: %s", this->use_spi_ ? "SPI" : "GPIO");
+}
 
-bool SN74HC595Component::digital_read_(uint8_t pin) { return this->output_bits_ >> pin; }
+bool SN74HC595Component::digital_read_(uint8_t pin) { return (this->output_bits_ >> pin) & 1; }
 
 void SN74HC595Component::digital_write_(uint8_t pin, bool value) {
-  uint32_t mask = 1UL << pin;
-  this->output_bits_ &= ~mask;
-  if (value)
-    this->output_bits_ |= mask;
+  this->write_pins(1UL << pin, value ? 1UL << pin : 0);
+}
+
+void SN74HC595Component::write_pins(uint32_t mask, uint32_t value) {
+  const uint32_t bits = (this->output_bits_ & ~mask) | (value & mask);
+  if (bits == this->output_bits_)
+    return;
+  this->output_bits_ = bits;
+  if (!this->dirty_) {
+    // all changes in this loop iteration are shifted out together
+    this->dirty_ = true;
+    this->defer([this]() { this->flush(); });
+  }
+}
+
+void SN74HC595Component::flush() {
+  if (!this->dirty_)
+    return;
+  this->dirty_ = false;
   this->write_gpio_();
 }
 
 bool SN74HC595Component::write_gpio_() {
-  for (int i = this->sr_count_ - 1; i >= 0; i--) {
-    uint8_t data = (uint8_t)(this->output_bits_ >> (8 * i) & 0xff);
-    for (int j = 0; j < 8; j++) {
-      this->data_pin_->digital_write(data & (1 << (7 - j)));
-      this->clock_pin_->digital_write(true);
-      this->clock_pin_->digital_write(false);
-    }
+#ifdef USE_SN74HC595_SPI
+  if (this->use_spi_) {
+    uint8_t data[4];
+    for (int i = this->sr_count_ - 1; i >= 0; i--)
+      data[this->sr_count_ - 1 - i] = (uint8_t)(this->output_bits_ >> (8 * i) & 0xff);
+    this->spi_.enable();
+    this->spi_.write_array(data, this->sr_count_);
+    this->spi_.disable();
   }
+#endif
+  if (!this->use_spi_) {
+    for (int i = this->sr_count_ - 1; i >= 0; i--) {
+      uint8_t data = (uint8_t)(this->output_bits_ >> (8 * i) & 0xff);
+      for (int j = 0; j < 8; j++) {
+        this->data_pin_->digital_write(data & (1 << (7 - j)));
+        this->clock_pin_->digital_write(true);
+        this->clock_pin_->digital_write(false);
+      }
+    }
 
-  // pulse latch to activate new values
-  this->latch_pin_->digital_write(true);
-  this->latch_pin_->digital_write(false);
+    // pulse latch to activate new values
+    this->latch_pin_->digital_write(true);
+    this->latch_pin_->digital_write(false);
+  }
 
   // enable output if configured
   if (this->have_oe_pin_) {
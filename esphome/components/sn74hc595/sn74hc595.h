@@ -2,6 +2,11 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/esphal.h"
+#include "esphome/core/defines.h"
+
+#ifdef USE_SN74HC595_SPI
+#include "esphome/components/spi/spi.h"
+#endif
 
 namespace esphome {
 namespace sn74hc595 {
@@ -22,6 +27,22 @@ class SN74HC595Component : public Component {
     have_oe_pin_ = true;
   }
   void set_sr_count(uint8_t count) { sr_count_ = count; }
+#ifdef USE_SN74HC595_SPI
+  /// Shift the data out through the SPI bus instead of the data and clock pins, the latch pin is its chip select.
+  void set_spi_parent(spi::SPIComponent *parent) {
+    this->spi_.set_spi_parent(parent);
+    this->use_spi_ = true;
+  }
+#endif
+
+  /** Set the pins in mask (bit n = pin n) to the bits of value, all of them change in the same latch pulse.
+   *
+   * Like single pin writes, the chain is shifted out once after the current loop iteration, call flush() to shift it
+   * out right away.
+   */
+  void write_pins(uint32_t mask, uint32_t value);
+  /// Shift out pending changes now.
+  void flush();
 
  protected:
   friend class SN74HC595GPIOPin;
@@ -36,6 +57,13 @@ class SN74HC595Component : public Component {
   uint8_t sr_count_;
   bool have_oe_pin_{false};
   uint32_t output_bits_{0x00};
+  /// Set when output_bits_ changed since they were shifted out, a write is deferred to the end of the loop.
+  bool dirty_{false};
+#ifdef USE_SN74HC595_SPI
+  spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW, spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_8MHZ>
+      spi_;
+#endif
+  bool use_spi_{false};
 };
 
 /// Helper class to expose a SC74HC595 pin as an internal output GPIO pin.
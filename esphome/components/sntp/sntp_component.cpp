@@ -1,61 +1,199 @@
 #include "sntp_component.h"
 #include "esphome/core/log.h"
-
-#ifdef ARDUINO_ARCH_ESP32
-#include "lwip/apps/sntp.h"
-#endif
-#ifdef ARDUINO_ARCH_ESP8266
-#include "sntp.h"
-#endif
+#include "esphome/core/helpers.h"
+#include "esphome/core/util.h"
+#include "lwip/err.h"
+#include "lwip/dns.h"
+#include <algorithm>
 
 namespace esphome {
 namespace sntp {
 
 static const char *TAG = "sntp";
 
+static const uint16_t SNTP_PORT = 123;
+static const size_t SNTP_PACKET_SIZE = 48;
+/// The seconds from the start of NTP era 0 (1900) to the unix epoch.
+static const uint32_t SNTP_UNIX_OFFSET = 2208988800UL;
+/// How long the servers have to answer a query.
+static const uint32_t SNTP_QUERY_TIMEOUT = 1000;
+/// How often a synchronization after the first one is attempted, until the next update().
+static const uint8_t SNTP_MAX_RESYNC_ATTEMPTS = 3;
+
+static uint32_t read_uint32(const uint8_t *data) {
+  return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | data[3];
+}
+static uint64_t read_uint64(const uint8_t *data) { return (uint64_t(read_uint32(data)) << 32) | read_uint32(data + 4); }
+static void write_uint64(uint8_t *data, uint64_t value) {
+  for (int8_t i = 7; i >= 0; i--) {
+    data[i] = value;
+    value >>= 8;
+  }
+}
+/// Convert an NTP timestamp to microseconds since the unix epoch.
+static int64_t ntp_to_epoch_us(const uint8_t *data) {
+  const uint32_t seconds = read_uint32(data);
+  // NTP era 1 starts in 2036
+  const int64_t epoch = seconds >= SNTP_UNIX_OFFSET ? int64_t(seconds - SNTP_UNIX_OFFSET)
+                                                    : int64_t(seconds) + 4294967296LL - SNTP_UNIX_OFFSET;
+  return epoch * 1000000LL + int64_t((uint64_t(read_uint32(data + 4)) * 1000000ULL) >> 32);
+}
+
+void SNTPComponent::set_servers(const std::string &server_1, const std::string &server_2,
+                                const std::string &server_3) {
+  this->servers_.clear();
+  for (const std::string &name : {server_1, server_2, server_3}) {
+    if (!name.empty())
+      this->servers_.push_back(Server{this, name, IPAddress(), false, 0});
+  }
+}
+
 void SNTPComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SNTP...");
+  this->start_query_();
+}
+void SNTPComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "SNTP Time:");
+  for (size_t i = 0; i < this->servers_.size(); i++)
+    ESP_LOGCONFIG(TAG, "  Server %u: '%s'", unsigned(i + 1), this->servers_[i].name.c_str());
+  ESP_LOGCONFIG(TAG, "  Timezone: '%s'", this->timezone_.c_str());
+}
+void SNTPComponent::update() {
+  this->attempts_ = 0;
+  this->start_query_();
+}
+
+void SNTPComponent::start_query_() {
+  if (this->querying_)
+    return;
+  if (!network_is_connected() || !this->udp_.begin(0)) {
+    this->set_timeout("query", SNTP_QUERY_TIMEOUT, [this]() { this->start_query_(); });
+    return;
+  }
+
+  for (auto &server : this->servers_) {
+    server.resolved = false;
+    server.sent_at = 0;
+    ip_addr_t addr;
 #ifdef ARDUINO_ARCH_ESP32
-  if (sntp_enabled()) {
-    sntp_stop();
+    err_t err = dns_gethostbyname_addrtype(server.name.c_str(), &addr, SNTPComponent::dns_found_callback, &server,
+                                           LWIP_DNS_ADDRTYPE_IPV4);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+    err_t err = dns_gethostbyname(server.name.c_str(), &addr, SNTPComponent::dns_found_callback, &server);
+#endif
+    if (err == ERR_OK) {
+#ifdef ARDUINO_ARCH_ESP32
+      server.ip = IPAddress(addr.u_addr.ip4.addr);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+      server.ip = IPAddress(addr.addr);
+#endif
+      server.resolved = true;
+    } else if (err != ERR_INPROGRESS) {
+      ESP_LOGW(TAG, "Error resolving '%s': %d", server.name.c_str(), int(err));
+    }
   }
-  sntp_setoperatingmode(SNTP_OPMODE_POLL);
+  this->querying_ = true;
+  this->attempts_++;
+  this->set_timeout("query", SNTP_QUERY_TIMEOUT, [this]() { this->query_timeout_(); });
+}
+
+#if defined(ARDUINO_ARCH_ESP8266) && LWIP_VERSION_MAJOR == 1
+void SNTPComponent::dns_found_callback(const char *name, ip_addr_t *ipaddr, void *callback_arg) {
+#else
+void SNTPComponent::dns_found_callback(const char *name, const ip_addr_t *ipaddr, void *callback_arg) {
+#endif
+  auto *server = reinterpret_cast<Server *>(callback_arg);
+  if (ipaddr == nullptr)
+    return;
+#ifdef ARDUINO_ARCH_ESP32
+  server->ip = IPAddress(ipaddr->u_addr.ip4.addr);
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
-  sntp_stop();
+  server->ip = IPAddress(ipaddr->addr);
 #endif
+  server->resolved = true;
+}
 
-  sntp_setservername(0, strdup(this->server_1_.c_str()));
-  if (!this->server_2_.empty()) {
-    sntp_setservername(1, strdup(this->server_2_.c_str()));
-  }
-  if (!this->server_3_.empty()) {
-    sntp_setservername(2, strdup(this->server_3_.c_str()));
+void SNTPComponent::query_timeout_() {
+  this->querying_ = false;
+  this->udp_.stop();
+  if (this->has_time_) {
+    if (this->attempts_ < SNTP_MAX_RESYNC_ATTEMPTS) {
+      this->start_query_();
+    } else {
+      ESP_LOGW(TAG, "No server answered, keeping the current time");
+    }
+    return;
   }
 
-  sntp_init();
+  // until there is a time at all, ask again right away and back off to a query per minute
+  const uint32_t backoff = (SNTP_QUERY_TIMEOUT << std::min<uint8_t>(this->attempts_ - 1, 6)) - SNTP_QUERY_TIMEOUT;
+  ESP_LOGD(TAG, "No server answered, retrying in %u s", backoff / 1000);
+  this->set_timeout("query", backoff, [this]() { this->start_query_(); });
 }
-void SNTPComponent::dump_config() {
-  ESP_LOGCONFIG(TAG, "SNTP Time:");
-  ESP_LOGCONFIG(TAG, "  Server 1: '%s'", this->server_1_.c_str());
-  ESP_LOGCONFIG(TAG, "  Server 2: '%s'", this->server_2_.c_str());
-  ESP_LOGCONFIG(TAG, "  Server 3: '%s'", this->server_3_.c_str());
-  ESP_LOGCONFIG(TAG, "  Timezone: '%s'", this->timezone_.c_str());
+
+void SNTPComponent::send_request_(Server *server) {
+  uint8_t msg[SNTP_PACKET_SIZE] = {};
+  // no leap second warning, version 4, client mode
+  msg[0] = 0x23;
+  server->sent_at = micros_64();
+  // the server copies the transmit timestamp into the originate timestamp of the response
+  write_uint64(&msg[40], server->sent_at);
+  this->udp_.beginPacket(server->ip, SNTP_PORT);
+  this->udp_.write(msg, sizeof(msg));
+  this->udp_.endPacket();
+}
+
+bool SNTPComponent::read_responses_() {
+  while (this->udp_.parsePacket() > 0) {
+    const uint64_t received_at = micros_64();
+    uint8_t msg[SNTP_PACKET_SIZE];
+    if (this->udp_.read(msg, sizeof(msg)) != int(sizeof(msg)))
+      continue;
+    const uint64_t originate = read_uint64(&msg[24]);
+    const uint32_t remote_ip = this->udp_.remoteIP();
+    Server *server = nullptr;
+    for (auto &candidate : this->servers_) {
+      if (candidate.sent_at != 0 && candidate.sent_at == originate && uint32_t(candidate.ip) == remote_ip)
+        server = &candidate;
+    }
+    if (server == nullptr)
+      continue;
+
+    const uint8_t leap = msg[0] >> 6, mode = msg[0] & 0x07, stratum = msg[1];
+    if (mode != 4 || leap == 3 || stratum == 0 || stratum > 15) {
+      // also kiss-o'-death responses, which ask to use another server
+      ESP_LOGV(TAG, "'%s' isn't synchronized", server->name.c_str());
+      continue;
+    }
+    const int64_t receive = ntp_to_epoch_us(&msg[32]);
+    const int64_t transmit = ntp_to_epoch_us(&msg[40]);
+    // half of the round trip without the time the server took to answer
+    const int64_t delay = std::max<int64_t>((int64_t(received_at - server->sent_at) - (transmit - receive)) / 2, 0);
+    ESP_LOGD(TAG, "Got the time from '%s' (delay %.1f ms)", server->name.c_str(), delay / 1000.0f);
+    this->synchronize_epoch_us_(transmit + delay + int64_t(micros_64() - received_at));
+    return true;
+  }
+  return false;
 }
-void SNTPComponent::update() {}
+
 void SNTPComponent::loop() {
-  if (this->has_time_)
+  if (!this->querying_)
     return;
-
-  auto time = this->now();
-  if (!time.is_valid())
+  for (auto &server : this->servers_) {
+    if (server.resolved && server.sent_at == 0)
+      this->send_request_(&server);
+  }
+  if (!this->read_responses_())
     return;
 
-  char buf[128];
-  time.strftime(buf, sizeof(buf), "%c");
-  ESP_LOGD(TAG, "Synchronized time: %s", buf);
-  this->time_sync_callback_.call();
+  this->querying_ = false;
   this->has_time_ = true;
+  this->attempts_ = 0;
+  this->udp_.stop();
+  this->cancel_timeout("query");
 }
 
 }  // namespace sntp
@@ -2,12 +2,19 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/time/real_time_clock.h"
+#include <IPAddress.h>
+#include <WiFiUdp.h>
+#include "lwip/ip_addr.h"
 
 namespace esphome {
 namespace sntp {
 
 /// The SNTP component allows you to configure local timekeeping via Simple Network Time Protocol.
 ///
+/// Every synchronization asks all servers at once and takes the first valid answer. Until the first one succeeds the
+/// servers are asked again after a second, backing off to about a minute. Later synchronizations slew the clock
+/// instead of stepping it, see RealTimeClock::synchronize_epoch_us_().
+///
 /// \note
 /// The C library (newlib) available on ESPs only supports TZ strings that specify an offset and DST info;
 /// you cannot specify zone names or paths to zoneinfo files.
@@ -17,20 +24,43 @@ class SNTPComponent : public time::RealTimeClock {
   void setup() override;
   void dump_config() override;
   /// Change the servers used by SNTP for timekeeping
-  void set_servers(const std::string &server_1, const std::string &server_2, const std::string &server_3) {
-    this->server_1_ = server_1;
-    this->server_2_ = server_2;
-    this->server_3_ = server_3;
-  }
+  void set_servers(const std::string &server_1, const std::string &server_2, const std::string &server_3);
   float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
 
   void update() override;
   void loop() override;
+  bool is_loop_idle() override { return !this->querying_; }
 
  protected:
-  std::string server_1_;
-  std::string server_2_;
-  std::string server_3_;
+  struct Server {
+    SNTPComponent *parent;
+    std::string name;
+    IPAddress ip;
+    /// Set by the DNS lookup, which may finish in the lwIP task.
+    bool resolved;
+    /// micros_64() when the request was sent, 0 before. The request carries it as transmit timestamp, so it
+    /// identifies the response.
+    uint64_t sent_at;
+  };
+
+  /// Resolve all servers, loop() asks each one as soon as its address is known.
+  void start_query_();
+  void send_request_(Server *server);
+  /// Read the responses that arrived, returns whether one of them synchronized the clock.
+  bool read_responses_();
+  void query_timeout_();
+
+#if defined(ARDUINO_ARCH_ESP8266) && LWIP_VERSION_MAJOR == 1
+  static void dns_found_callback(const char *name, ip_addr_t *ipaddr, void *callback_arg);
+#else
+  static void dns_found_callback(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+#endif
+
+  std::vector<Server> servers_;
+  WiFiUDP udp_;
+  /// The queries since the last synchronization or update().
+  uint8_t attempts_{0};
+  bool querying_{false};
   bool has_time_{false};
 };
 
@@ -0,0 +1,5 @@
+import esphome.codegen as cg
+
+CODEOWNERS = ['@esphome/core']
+
+spectrum_ns = cg.esphome_ns.namespace('spectrum')
@@ -0,0 +1,110 @@
+#include "fft.h"
+#include "esphome/core/helpers.h"
+#include <cmath>
+#include <utility>
+
+namespace esphome {
+namespace spectrum {
+
+void HOT complex_fft(float *data, size_t n) {
+  // bit-reversal permutation
+  for (size_t i = 1, j = 0; i < n; i++) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1)
+      j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      std::swap(data[2 * i], data[2 * j]);
+      std::swap(data[2 * i + 1], data[2 * j + 1]);
+    }
+  }
+  // iterative radix-2 butterflies
+  for (size_t len = 2; len <= n; len <<= 1) {
+    const float angle = -2.0f * float(M_PI) / len;
+    const float w_re = cosf(angle);
+    const float w_im = sinf(angle);
+    const size_t half = len / 2;
+    for (size_t i = 0; i < n; i += len) {
+      float u_re = 1.0f;
+      float u_im = 0.0f;
+      for (size_t k = 0; k < half; k++) {
+        float *a = data + 2 * (i + k);
+        float *b = data + 2 * (i + k + half);
+        const float t_re = b[0] * u_re - b[1] * u_im;
+        const float t_im = b[0] * u_im + b[1] * u_re;
+        b[0] = a[0] - t_re;
+        b[1] = a[1] - t_im;
+        a[0] += t_re;
+        a[1] += t_im;
+        const float next_re = u_re * w_re - u_im * w_im;
+        u_im = u_re * w_im + u_im * w_re;
+        u_re = next_re;
+      }
+    }
+  }
+}
+
+void HOT real_fft(float *data, size_t n) {
+  // the even samples are the real parts and the odd ones the imaginary parts of a complex signal of half the size
+  const size_t m = n / 2;
+  complex_fft(data, m);
+
+  // split the result into the spectrum of the even and the odd samples and combine them
+  const float z0_re = data[0];
+  const float z0_im = data[1];
+  data[0] = z0_re + z0_im;
+  data[1] = z0_re - z0_im;
+  // W^k by rotating W^(k - 1), like the butterflies
+  const float step_re = cosf(2.0f * float(M_PI) / n);
+  const float step_im = -sinf(2.0f * float(M_PI) / n);
+  float w_re = 1.0f;
+  float w_im = 0.0f;
+  for (size_t k = 1; k <= m / 2; k++) {
+    const float next_re = w_re * step_re - w_im * step_im;
+    w_im = w_re * step_im + w_im * step_re;
+    w_re = next_re;
+    float *zk = data + 2 * k;
+    float *zmk = data + 2 * (m - k);
+    const float e_re = (zk[0] + zmk[0]) * 0.5f;
+    const float e_im = (zk[1] - zmk[1]) * 0.5f;
+    const float o_re = (zk[1] + zmk[1]) * 0.5f;
+    const float o_im = (zmk[0] - zk[0]) * 0.5f;
+    const float wo_re = w_re * o_re - w_im * o_im;
+    const float wo_im = w_re * o_im + w_im * o_re;
+    // X[k] = E + W^k O and X[m - k] = conj(E - W^k O)
+    zk[0] = e_re + wo_re;
+    zk[1] = e_im + wo_im;
+    if (k != m - k) {
+      zmk[0] = e_re - wo_re;
+      zmk[1] = wo_im - e_im;
+    }
+  }
+}
+
+void HOT apply_hann_window(float *data, size_t n) {
+  // cos(2 pi i / (n - 1)) by rotation instead of a cosf() per sample
+  const float step_cos = cosf(2.0f * float(M_PI) / (n - 1));
+  const float step_sin = sinf(2.0f * float(M_PI) / (n - 1));
+  float c = 1.0f;
+  float s = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    data[i] *= 0.5f - 0.5f * c;
+    const float next_c = c * step_cos - s * step_sin;
+    s = s * step_cos + c * step_sin;
+    c = next_c;
+  }
+}
+
+float band_rms(const float *spectrum, size_t n, float bin_hz, float from_hz, float to_hz) {
+  float power = 0.0f;
+  for (size_t k = 1; k < n / 2; k++) {
+    const float hz = k * bin_hz;
+    if (hz >= from_hz && hz < to_hz)
+      power += bin_power(spectrum, n, k);
+  }
+  // Parseval, with the power of the other half of the spectrum and the window's attenuation
+  return sqrtf(2.0f * power / HANN_MEAN_SQUARE) / n;
+}
+
+}  // namespace spectrum
+}  // namespace esphome
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+namespace esphome {
+namespace spectrum {
+
+/// The mean square of the Hann window, the power of windowed signals is divided by it.
+static const float HANN_MEAN_SQUARE = 0.375f;
+
+/// In-place FFT of n complex values stored as interleaved real and imaginary parts, n must be a power of two.
+void complex_fft(float *data, size_t n);
+
+/** In-place FFT of n real values, n must be a power of two of at least 4.
+ *
+ * Runs a complex FFT of half the size, so it takes about half the time and no extra memory. The result is packed into
+ * the n floats: data[0] is X[0] and data[1] is X[n/2] (both real), data[2k] and data[2k + 1] are the real and
+ * imaginary part of X[k] for 0 < k < n/2.
+ */
+void real_fft(float *data, size_t n);
+
+/// |X[k]|² of a real_fft() result, for 0 <= k <= n/2.
+inline float bin_power(const float *spectrum, size_t n, size_t k) {
+  if (k == 0)
+    return spectrum[0] * spectrum[0];
+  if (k == n / 2)
+    return spectrum[1] * spectrum[1];
+  return spectrum[2 * k] * spectrum[2 * k] + spectrum[2 * k + 1] * spectrum[2 * k + 1];
+}
+
+/// Multiply the n values with a Hann window, which keeps the leakage of strong frequencies to the adjacent bins.
+void apply_hann_window(float *data, size_t n);
+
+/** The RMS of the frequencies in [from_hz, to_hz) from the real_fft() result of a Hann windowed signal.
+ *
+ * @param spectrum The real_fft() result.
+ * @param n The number of samples.
+ * @param bin_hz The width of a bin, the sample rate divided by n.
+ */
+float band_rms(const float *spectrum, size_t n, float bin_hz, float from_hz, float to_hz);
+
+}  // namespace spectrum
+}  // namespace esphome
@@ -0,0 +1,70 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, voltage_sampler
+from esphome.const import CONF_SENSOR, CONF_ID, CONF_WINDOW_SIZE, CONF_FROM, CONF_TO, ICON_PULSE, \
+    UNIT_EMPTY, UNIT_HERTZ, UNIT_PERCENT
+from . import spectrum_ns
+
+AUTO_LOAD = ['voltage_sampler']
+
+CONF_RMS = 'rms'
+CONF_PEAK_FREQUENCY = 'peak_frequency'
+CONF_THD = 'thd'
+CONF_HARMONICS = 'harmonics'
+CONF_BANDS = 'bands'
+
+SpectrumSensor = spectrum_ns.class_('SpectrumSensor', cg.PollingComponent)
+
+
+def validate_window_size(value):
+    value = cv.int_range(min=64, max=4096)(value)
+    if value & (value - 1) != 0:
+        raise cv.Invalid("window_size must be a power of two for the FFT")
+    return value
+
+
+def validate_band(value):
+    if value[CONF_FROM] >= value[CONF_TO]:
+        raise cv.Invalid("The band must start below where it ends")
+    return value
+
+
+# The unit of the RMS values is the one of the sampler, usually volts
+value_schema = sensor.sensor_schema(UNIT_EMPTY, ICON_PULSE, 3)
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(SpectrumSensor),
+    cv.Required(CONF_SENSOR): cv.use_id(voltage_sampler.VoltageSampler),
+    cv.Optional(CONF_WINDOW_SIZE, default=1024): validate_window_size,
+    cv.Optional(CONF_HARMONICS, default=10): cv.int_range(min=1, max=50),
+    cv.Optional(CONF_RMS): value_schema,
+    cv.Optional(CONF_PEAK_FREQUENCY): sensor.sensor_schema(UNIT_HERTZ, ICON_PULSE, 1),
+    cv.Optional(CONF_THD): sensor.sensor_schema(UNIT_PERCENT, ICON_PULSE, 1),
+    cv.Optional(CONF_BANDS, default=[]): cv.ensure_list(cv.All(value_schema.extend({
+        cv.Required(CONF_FROM): cv.frequency,
+        cv.Required(CONF_TO): cv.frequency,
+    }), validate_band)),
+}).extend(cv.polling_component_schema('60s'))
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    source = yield cg.get_variable(config[CONF_SENSOR])
+    cg.add(var.set_source(source))
+    cg.add(var.set_window_size(config[CONF_WINDOW_SIZE]))
+    cg.add(var.set_harmonics(config[CONF_HARMONICS]))
+
+    if CONF_RMS in config:
+        sens = yield sensor.new_sensor(config[CONF_RMS])
+        cg.add(var.set_rms_sensor(sens))
+    if CONF_PEAK_FREQUENCY in config:
+        sens = yield sensor.new_sensor(config[CONF_PEAK_FREQUENCY])
+        cg.add(var.set_peak_frequency_sensor(sens))
+    if CONF_THD in config:
+        sens = yield sensor.new_sensor(config[CONF_THD])
+        cg.add(var.set_thd_sensor(sens))
+    for band in config[CONF_BANDS]:
+        sens = yield sensor.new_sensor(band)
+        cg.add(var.add_band(band[CONF_FROM], band[CONF_TO], sens))
@@ -0,0 +1,130 @@
+#include "spectrum_sensor.h"
+#include "fft.h"
+#include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace spectrum {
+
+static const char *TAG = "spectrum";
+
+void SpectrumSensor::setup() {
+  if (!this->source_->is_continuous() || this->source_->get_sample_rate() == 0) {
+    ESP_LOGE(TAG, "The sampler doesn't sample continuously at a fixed rate!");
+    this->mark_failed();
+    return;
+  }
+  this->sample_rate_ = this->source_->get_sample_rate();
+  this->window_ = alloc_large<float>(this->window_size_, BUFFER_LOCATION_PREFER_EXTERNAL);
+  if (this->window_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate the sample window!");
+    this->mark_failed();
+  }
+}
+
+void SpectrumSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "Spectrum:");
+  if (this->is_failed()) {
+    ESP_LOGE(TAG, "  Setup failed!");
+    return;
+  }
+  ESP_LOGCONFIG(TAG, "  Window: %u samples (%.1f ms), %.2f Hz per bin", this->window_size_,
+                this->window_size_ * 1000.0f / this->sample_rate_, float(this->sample_rate_) / this->window_size_);
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "RMS", this->rms_sensor_);
+  LOG_SENSOR("  ", "Peak Frequency", this->peak_frequency_sensor_);
+  LOG_SENSOR("  ", "THD", this->thd_sensor_);
+  for (auto &band : this->bands_) {
+    ESP_LOGCONFIG(TAG, "  Band %.1f-%.1f Hz:", band.from_hz, band.to_hz);
+    LOG_SENSOR("    ", "RMS", band.sensor);
+  }
+}
+
+void SpectrumSensor::update() {
+  if (this->capturing_)
+    return;
+  // the window has to be consecutive samples, throw away what has been sampled before
+  float *block = this->window_;
+  while (this->source_->read_samples(block, this->window_size_) == this->window_size_) {
+  }
+  this->count_ = 0;
+  this->capturing_ = true;
+}
+
+void SpectrumSensor::loop() {
+  if (!this->capturing_)
+    return;
+  this->count_ += this->source_->read_samples(this->window_ + this->count_, this->window_size_ - this->count_);
+  if (this->count_ < this->window_size_)
+    return;
+  this->capturing_ = false;
+  this->process_window_();
+}
+
+float SpectrumSensor::peak_power_(size_t bin) const {
+  float power = 0.0f;
+  for (size_t k = std::max<size_t>(bin, 2) - 1; k <= bin + 1 && k < this->window_size_ / 2u; k++)
+    power += bin_power(this->window_, this->window_size_, k);
+  return power;
+}
+
+void SpectrumSensor::process_window_() {
+  const size_t n = this->window_size_;
+  float *data = this->window_;
+
+  float mean = 0.0f;
+  for (size_t i = 0; i < n; i++)
+    mean += data[i];
+  mean /= n;
+  float sum_squares = 0.0f;
+  for (size_t i = 0; i < n; i++) {
+    data[i] -= mean;
+    sum_squares += data[i] * data[i];
+  }
+  const float rms = sqrtf(sum_squares / n);
+
+  apply_hann_window(data, n);
+  real_fft(data, n);
+  const float bin_hz = float(this->sample_rate_) / n;
+
+  // the strongest frequency, interpolated between the bins around it
+  size_t peak = 1;
+  for (size_t k = 2; k < n / 2; k++) {
+    if (bin_power(data, n, k) > bin_power(data, n, peak))
+      peak = k;
+  }
+  float offset = 0.0f;
+  if (peak + 1 < n / 2) {
+    const float a = sqrtf(bin_power(data, n, peak - 1));
+    const float b = sqrtf(bin_power(data, n, peak));
+    const float c = sqrtf(bin_power(data, n, peak + 1));
+    const float denominator = a - 2.0f * b + c;
+    if (denominator != 0.0f)
+      offset = 0.5f * (a - c) / denominator;
+  }
+  const float peak_frequency = (peak + offset) * bin_hz;
+
+  // the harmonics up to the Nyquist frequency relative to the fundamental
+  const float fundamental = this->peak_power_(peak);
+  float harmonics = 0.0f;
+  for (uint8_t h = 2; h <= this->harmonics_ + 1; h++) {
+    const size_t bin = lroundf(h * peak_frequency / bin_hz);
+    if (bin + 1 >= n / 2)
+      break;
+    harmonics += this->peak_power_(bin);
+  }
+  const float thd = fundamental == 0.0f ? NAN : sqrtf(harmonics / fundamental) * 100.0f;
+
+  ESP_LOGD(TAG, "RMS=%.4f, peak frequency=%.2f Hz, THD=%.1f%%", rms, peak_frequency, thd);
+  if (this->rms_sensor_ != nullptr)
+    this->rms_sensor_->publish_state(rms);
+  if (this->peak_frequency_sensor_ != nullptr)
+    this->peak_frequency_sensor_->publish_state(peak_frequency);
+  if (this->thd_sensor_ != nullptr)
+    this->thd_sensor_->publish_state(thd);
+  for (auto &band : this->bands_)
+    band.sensor->publish_state(band_rms(data, n, bin_hz, band.from_hz, band.to_hz));
+}
+
+}  // namespace spectrum
+}  // namespace esphome
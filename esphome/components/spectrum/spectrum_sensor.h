@@ -0,0 +1,68 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/voltage_sampler/voltage_sampler.h"
+
+namespace esphome {
+namespace spectrum {
+
+struct SpectrumBand {
+  float from_hz;
+  float to_hz;
+  sensor::Sensor *sensor;
+};
+
+/** Spectral features of the signal of a continuous sampler, like mains harmonics or machine vibration.
+ *
+ * Every update a window of consecutive samples is captured, which is Hann windowed and transformed with a real FFT.
+ * All features are published together: the RMS (without the DC offset), the frequency with the most power, the
+ * total harmonic distortion of that frequency and the RMS within frequency bands.
+ */
+class SpectrumSensor : public PollingComponent {
+ public:
+  void setup() override;
+  void update() override;
+  void loop() override;
+  bool is_loop_idle() override { return !this->capturing_; }
+  void dump_config() override;
+  float get_setup_priority() const override {
+    // After the sampler has been initialized
+    return setup_priority::DATA - 1.0f;
+  }
+
+  void set_source(voltage_sampler::VoltageSampler *source) { this->source_ = source; }
+  /// The number of samples per window, a power of two.
+  void set_window_size(uint16_t window_size) { this->window_size_ = window_size; }
+  /// The number of harmonics included in the THD.
+  void set_harmonics(uint8_t harmonics) { this->harmonics_ = harmonics; }
+  void set_rms_sensor(sensor::Sensor *rms_sensor) { this->rms_sensor_ = rms_sensor; }
+  void set_peak_frequency_sensor(sensor::Sensor *peak_frequency_sensor) {
+    this->peak_frequency_sensor_ = peak_frequency_sensor;
+  }
+  void set_thd_sensor(sensor::Sensor *thd_sensor) { this->thd_sensor_ = thd_sensor; }
+  void add_band(float from_hz, float to_hz, sensor::Sensor *sensor) {
+    this->bands_.push_back(SpectrumBand{from_hz, to_hz, sensor});
+  }
+
+ protected:
+  void process_window_();
+  /// The power of the bin and its neighbours, where the Hann window spreads a frequency.
+  float peak_power_(size_t bin) const;
+
+  voltage_sampler::VoltageSampler *source_;
+  uint16_t window_size_;
+  uint8_t harmonics_{10};
+  uint32_t sample_rate_{0};
+  sensor::Sensor *rms_sensor_{nullptr};
+  sensor::Sensor *peak_frequency_sensor_{nullptr};
+  sensor::Sensor *thd_sensor_{nullptr};
+  std::vector<SpectrumBand> bands_;
+
+  float *window_{nullptr};
+  uint16_t count_{0};
+  bool capturing_{false};
+};
+
+}  // namespace spectrum
+}  // namespace esphome
@@ -7,6 +7,8 @@ from .. import speed_ns
 
 SpeedFan = speed_ns.class_('SpeedFan', cg.Component)
 
+CONF_RAMP_TIME = 'ramp_time'
+
 CONFIG_SCHEMA = fan.FAN_SCHEMA.extend({
     cv.GenerateID(CONF_OUTPUT_ID): cv.declare_id(SpeedFan),
     cv.Required(CONF_OUTPUT): cv.use_id(output.FloatOutput),
@@ -17,6 +19,7 @@ CONFIG_SCHEMA = fan.FAN_SCHEMA.extend({
         cv.Optional(CONF_MEDIUM, default=0.66): cv.percentage,
         cv.Optional(CONF_HIGH, default=1.0): cv.percentage,
     }),
+    cv.Optional(CONF_RAMP_TIME): cv.positive_time_period_milliseconds,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -27,6 +30,8 @@ def to_code(config):
     yield cg.register_component(var, config)
     speeds = config[CONF_SPEED]
     cg.add(var.set_speeds(speeds[CONF_LOW], speeds[CONF_MEDIUM], speeds[CONF_HIGH]))
+    if CONF_RAMP_TIME in config:
+        cg.add(var.set_ramp_time(config[CONF_RAMP_TIME]))
 
     if CONF_OSCILLATION_OUTPUT in config:
         oscillation_output = yield cg.get_variable(config[CONF_OSCILLATION_OUTPUT])
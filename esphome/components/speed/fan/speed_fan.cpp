@@ -14,11 +14,24 @@ void SpeedFan::dump_config() {
   if (this->fan_->get_traits().supports_direction()) {
     ESP_LOGCONFIG(TAG, "  Direction: YES");
   }
+  if (this->ramp_time_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Ramp Time: %u ms", this->ramp_time_);
+  }
 }
 void SpeedFan::setup() {
   auto traits = fan::FanTraits(this->oscillating_ != nullptr, true, this->direction_ != nullptr);
   this->fan_->set_traits(traits);
   this->fan_->add_on_state_callback([this]() { this->next_update_ = true; });
+
+  if (this->ramp_time_ != 0) {
+    // accelerate for a quarter of the ramp and round the corners over another quarter, so a change over the full
+    // range takes the ramp time
+    const float ramp = this->ramp_time_ / 1000.0f;
+    this->profile_.set_max_velocity(2.0f / ramp);
+    this->profile_.set_max_acceleration(8.0f / (ramp * ramp));
+    this->profile_.set_jerk(32.0f / (ramp * ramp * ramp));
+  }
+  this->profile_.set_write_callback([this](float speed) { this->output_->set_level(speed); });
 }
 void SpeedFan::loop() {
   if (!this->next_update_) {
@@ -37,7 +50,7 @@ void SpeedFan::loop() {
         speed = this->high_speed_;
     }
     ESP_LOGD(TAG, "Setting speed: %.2f", speed);
-    this->output_->set_level(speed);
+    this->profile_.move_to(speed);
   }
 
   if (this->oscillating_ != nullptr) {
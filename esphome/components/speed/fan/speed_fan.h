@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/output/binary_output.h"
 #include "esphome/components/output/float_output.h"
+#include "esphome/components/output/motion_profile.h"
 #include "esphome/components/fan/fan_state.h"
 
 namespace esphome {
@@ -22,6 +23,8 @@ class SpeedFan : public Component {
     this->medium_speed_ = medium;
     this->high_speed_ = high;
   }
+  /// Ramp the speed along an S-curve instead of jumping to it, taking this long from off to full speed.
+  void set_ramp_time(uint32_t ramp_time) { this->ramp_time_ = ramp_time; }
 
  protected:
   fan::FanState *fan_;
@@ -31,6 +34,8 @@ class SpeedFan : public Component {
   float low_speed_{};
   float medium_speed_{};
   float high_speed_{};
+  uint32_t ramp_time_{0};
+  output::MotionProfile profile_;
   bool next_update_{true};
 };
 
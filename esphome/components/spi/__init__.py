@@ -11,6 +11,8 @@ SPIComponent = spi_ns.class_('SPIComponent', cg.Component)
 SPIDevice = spi_ns.class_('SPIDevice')
 MULTI_CONF = True
 
+CONF_SPI_PRIORITY = 'spi_priority'
+
 CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(SPIComponent),
     cv.Required(CONF_CLK_PIN): pins.gpio_output_pin_schema,
@@ -33,6 +35,10 @@ def to_code(config):
     if CONF_MOSI_PIN in config:
         mosi = yield cg.gpio_pin_expression(config[CONF_MOSI_PIN])
         cg.add(var.set_mosi(mosi))
+    # a software bus on internal pins can skip the virtual GPIOPin calls
+    bus_pins = [config[key] for key in (CONF_CLK_PIN, CONF_MISO_PIN, CONF_MOSI_PIN) if key in config]
+    if not any(key in pin for pin in bus_pins for key in pins.PIN_SCHEMA_REGISTRY):
+        cg.add(var.set_direct_gpio(True))
 
 
 def spi_device_schema(cs_pin_required=True):
@@ -42,6 +48,8 @@ def spi_device_schema(cs_pin_required=True):
     """
     schema = {
         cv.GenerateID(CONF_SPI_ID): cv.use_id(SPIComponent),
+        # devices pause the queued writes (display frames) of devices with the same or a lower priority
+        cv.Optional(CONF_SPI_PRIORITY): cv.int_range(min=0, max=255),
     }
     if cs_pin_required:
         schema[cv.Required(CONF_CS_PIN)] = pins.gpio_output_pin_schema
@@ -57,3 +65,5 @@ def register_spi_device(var, config):
     if CONF_CS_PIN in config:
         pin = yield cg.gpio_pin_expression(config[CONF_CS_PIN])
         cg.add(var.set_cs_pin(pin))
+    if CONF_SPI_PRIORITY in config:
+        cg.add(var.set_spi_priority(config[CONF_SPI_PRIORITY]))
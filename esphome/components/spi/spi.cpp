@@ -2,6 +2,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
+#include <algorithm>
 
 namespace esphome {
 namespace spi {
@@ -18,8 +19,151 @@ void ICACHE_RAM_ATTR HOT SPIComponent::disable() {
     this->active_cs_ = nullptr;
   }
 }
+/// The most bytes sent at once from a queued write before checking the time budget.
+static const size_t QUEUED_WRITE_CHUNK_SIZE = 512;
+/// How long loop() may spend sending queued writes.
+static const uint32_t QUEUED_WRITE_BUDGET = 4;
+/// How often the time devices waited for queued writes is logged.
+static const uint32_t CONTENTION_REPORT_INTERVAL = 60000;
+
+static uint8_t device_priority(const SPIDeviceState *state) { return state != nullptr ? state->priority : 0; }
+
+void SPIComponent::insert_queued_writes_(QueuedWrites &&writes) {
+  // behind all writes with the same or a higher priority, so a device's own writes stay in order
+  const uint8_t priority = device_priority(writes.state);
+  auto it = this->queued_writes_.end();
+  while (it != this->queued_writes_.begin() && device_priority((it - 1)->state) < priority)
+    --it;
+  if (it == this->queued_writes_.begin())
+    this->pause_queued_writes_();
+  this->queued_writes_.insert(it, std::move(writes));
+}
+
+void SPIComponent::pause_queued_writes_() {
+  if (this->queued_writes_.empty() || !this->queued_writes_.front().enabled)
+    return;
+  // the chunks end on whole bytes, the display controller continues where it stopped once its CS is active again
+  this->disable();
+  this->queued_writes_.front().enabled = false;
+}
+
+void SPIComponent::acquire_(GPIOPin *cs, SPIDeviceState *state) {
+  const QueuedWrites &front = this->queued_writes_.front();
+  bool pause = cs != nullptr && device_priority(state) >= device_priority(front.state);
+  for (const auto &writes : this->queued_writes_) {
+    // the device's own writes have to be sent first
+    if (writes.cs == cs)
+      pause = false;
+  }
+  if (pause) {
+    if (front.enabled && state != nullptr)
+      state->preemptions++;
+    this->pause_queued_writes_();
+    return;
+  }
+
+  const uint32_t start = micros();
+  this->flush_queued_writes();
+  if (state == nullptr)
+    return;
+  const uint32_t wait = micros() - start;
+  state->waits++;
+  state->wait_total += wait;
+  state->wait_max = std::max(state->wait_max, wait);
+}
+
+void HOT SPIComponent::begin_transaction_(SPIDeviceState *state, uint32_t data_rate, uint8_t bit_order,
+                                          uint8_t data_mode) {
+  if (state == nullptr) {
+    this->hw_spi_->beginTransaction(SPISettings(data_rate, bit_order, data_mode));
+    this->configured_ = nullptr;
+    return;
+  }
+#ifdef ARDUINO_ARCH_ESP8266
+  // a transaction only configures the peripheral, which still has this device's settings
+  if (this->configured_ == state && SPI1CLK == state->clock_div)
+    return;
+  if (state->clock_div == 0) {
+    this->hw_spi_->beginTransaction(SPISettings(data_rate, bit_order, data_mode));
+    state->clock_div = SPI1CLK;
+  } else {
+    this->hw_spi_->setClockDivider(state->clock_div);
+    this->hw_spi_->setDataMode(data_mode);
+    this->hw_spi_->setBitOrder(bit_order);
+  }
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  // the transaction locks the bus, so it is always started, but with the divider that is already known
+  if (state->clock_div == 0) {
+    this->hw_spi_->beginTransaction(SPISettings(data_rate, bit_order, data_mode));
+    state->clock_div = this->hw_spi_->getClockDivider();
+    state->clock = spiClockDivToFrequency(state->clock_div);
+  } else {
+    if (this->configured_ != state)
+      this->hw_spi_->setClockDivider(state->clock_div);
+    this->hw_spi_->beginTransaction(SPISettings(state->clock, bit_order, data_mode));
+  }
+#endif
+  this->configured_ = state;
+}
+
+void SPIComponent::report_contention_() {
+  for (auto *device : this->devices_) {
+    if (device->waits == 0)
+      continue;
+    ESP_LOGD(TAG, "Device on CS pin %d waited %u times for queued writes: %.1f ms on average, %.1f ms at most",
+             device->cs != nullptr ? device->cs->get_pin() : -1, device->waits,
+             device->wait_total / 1000.0f / device->waits, device->wait_max / 1000.0f);
+    device->waits = 0;
+    device->wait_total = 0;
+    device->wait_max = 0;
+  }
+}
+
+void SPIComponent::loop() {
+  if (!this->queued_writes_.empty())
+    this->process_queued_writes_(QUEUED_WRITE_BUDGET);
+}
+
+void SPIComponent::process_queued_writes_(uint32_t budget) {
+  const uint32_t start = millis();
+  while (!this->queued_writes_.empty()) {
+    QueuedWrites &writes = this->queued_writes_.front();
+    this->in_queued_write_ = true;
+    if (!writes.enabled) {
+      (this->*writes.enable)(writes.cs, writes.state);
+      writes.enabled = true;
+    }
+    while (writes.index < writes.descriptors.size()) {
+      const SPIWriteDescriptor &descriptor = writes.descriptors[writes.index];
+      if (writes.offset == 0 && writes.dc != nullptr)
+        writes.dc->digital_write(descriptor.dc);
+      const size_t chunk = std::min(descriptor.length - writes.offset, QUEUED_WRITE_CHUNK_SIZE);
+      (this->*writes.write)(descriptor.data + writes.offset, chunk);
+      writes.offset += chunk;
+      if (writes.offset >= descriptor.length) {
+        writes.index++;
+        writes.offset = 0;
+      }
+      if (budget != 0 && millis() - start >= budget) {
+        this->in_queued_write_ = false;
+        return;
+      }
+    }
+    this->disable();
+    this->in_queued_write_ = false;
+
+    std::function<void()> callback = std::move(writes.callback);
+    this->queued_writes_.pop_front();
+    if (callback)
+      callback();
+  }
+}
+
 void SPIComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI bus...");
+  if (this->devices_.size() > 1)
+    this->set_interval("contention", CONTENTION_REPORT_INTERVAL, [this]() { this->report_contention_(); });
   this->clk_->setup();
   this->clk_->digital_write(true);
 
@@ -76,6 +220,37 @@ void SPIComponent::setup() {
     this->mosi_->setup();
     this->mosi_->digital_write(false);
   }
+
+  if (this->direct_gpio_) {
+    this->direct_gpio_ = resolve_direct_pin_(this->clk_, &this->direct_clk_) &&
+                         resolve_direct_pin_(this->miso_, &this->direct_miso_) &&
+                         resolve_direct_pin_(this->mosi_, &this->direct_mosi_);
+  }
+}
+
+bool SPIComponent::resolve_direct_pin_(GPIOPin *pin, SPIDirectPin *direct) {
+  if (pin == nullptr)
+    return true;
+  const uint8_t num = pin->get_pin();
+#ifdef ARDUINO_ARCH_ESP8266
+  // GPIO16 has its own registers without set/clear
+  if (num >= 16)
+    return false;
+  volatile uint32_t *set = &GPOS;
+  volatile uint32_t *clear = &GPOC;
+  direct->read = &GPI;
+  direct->mask = 1UL << num;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  volatile uint32_t *set = num < 32 ? &GPIO.out_w1ts : &GPIO.out1_w1ts.val;
+  volatile uint32_t *clear = num < 32 ? &GPIO.out_w1tc : &GPIO.out1_w1tc.val;
+  direct->read = num < 32 ? &GPIO.in : &GPIO.in1.val;
+  direct->mask = num < 32 ? 1UL << num : 1UL << (num - 32);
+#endif
+  direct->set = pin->is_inverted() ? clear : set;
+  direct->clear = pin->is_inverted() ? set : clear;
+  direct->read_invert = pin->is_inverted() ? direct->mask : 0;
+  return true;
 }
 void SPIComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "SPI bus:");
@@ -83,6 +258,12 @@ void SPIComponent::dump_config() {
   LOG_PIN("  MISO Pin: ", this->miso_);
   LOG_PIN("  MOSI Pin: ", this->mosi_);
   ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", YESNO(this->hw_spi_ != nullptr));
+  if (this->hw_spi_ == nullptr)
+    ESP_LOGCONFIG(TAG, "  Direct GPIO access: %s", YESNO(this->direct_gpio_));
+  for (auto *device : this->devices_) {
+    ESP_LOGCONFIG(TAG, "  Device on CS pin %d: priority %u, paused queued writes %u times",
+                  device->cs != nullptr ? device->cs->get_pin() : -1, device->priority, device->preemptions);
+  }
 }
 float SPIComponent::get_setup_priority() const { return setup_priority::BUS; }
 
@@ -104,13 +285,68 @@ void SPIComponent::cycle_clock_(bool value) {
     ;
 }
 
+void SPIComponent::cycle_clock_direct_(bool value) {
+  uint32_t start = ESP.getCycleCount();
+  while (start - ESP.getCycleCount() < this->wait_cycle_)
+    ;
+  *(value ? this->direct_clk_.set : this->direct_clk_.clear) = this->direct_clk_.mask;
+  start += this->wait_cycle_;
+  while (start - ESP.getCycleCount() < this->wait_cycle_)
+    ;
+}
+
 // NOLINTNEXTLINE
 #pragma GCC optimize("unroll-loops")
 // NOLINTNEXTLINE
 #pragma GCC optimize("O2")
 
+template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
+uint8_t HOT SPIComponent::transfer_direct_(uint8_t data) {
+  // Same as transfer_(), but the pins are written through their registers and everything is inlined
+  const SPIDirectPin &mosi = this->direct_mosi_;
+  const SPIDirectPin &miso = this->direct_miso_;
+  *(CLOCK_POLARITY ? this->direct_clk_.set : this->direct_clk_.clear) = this->direct_clk_.mask;
+  uint8_t out_data = 0;
+
+  for (uint8_t i = 0; i < 8; i++) {
+    const uint8_t shift = BIT_ORDER == BIT_ORDER_MSB_FIRST ? 7 - i : i;
+
+    if (CLOCK_PHASE == CLOCK_PHASE_LEADING) {
+      if (WRITE)
+        *(data & (1 << shift) ? mosi.set : mosi.clear) = mosi.mask;
+      this->cycle_clock_direct_(!CLOCK_POLARITY);
+      if (READ)
+        out_data |= uint8_t(((*miso.read ^ miso.read_invert) & miso.mask) != 0) << shift;
+      this->cycle_clock_direct_(CLOCK_POLARITY);
+    } else {
+      this->cycle_clock_direct_(!CLOCK_POLARITY);
+      if (WRITE)
+        *(data & (1 << shift) ? mosi.set : mosi.clear) = mosi.mask;
+      this->cycle_clock_direct_(CLOCK_POLARITY);
+      if (READ)
+        out_data |= uint8_t(((*miso.read ^ miso.read_invert) & miso.mask) != 0) << shift;
+    }
+  }
+
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+  if (WRITE) {
+    SPIComponent::debug_tx(data);
+  }
+  if (READ) {
+    SPIComponent::debug_rx(out_data);
+  }
+#endif
+
+  App.feed_wdt();
+
+  return out_data;
+}
+
 template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
 uint8_t HOT SPIComponent::transfer_(uint8_t data) {
+  if (this->direct_gpio_)
+    return this->transfer_direct_<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, READ, WRITE>(data);
+
   // Clock starts out at idle level
   this->clk_->digital_write(CLOCK_POLARITY);
   uint8_t out_data = 0;
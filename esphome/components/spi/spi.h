@@ -3,6 +3,10 @@
 #include "esphome/core/component.h"
 #include "esphome/core/esphal.h"
 #include <SPI.h>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <vector>
 
 namespace esphome {
 namespace spi {
@@ -61,11 +65,47 @@ enum SPIDataRate : uint32_t {
   DATA_RATE_40MHZ = 40000000,
 };
 
+/// One part of a queued write, sent with the DC pin at the given level if the write has a DC pin.
+struct SPIWriteDescriptor {
+  const uint8_t *data;
+  size_t length;
+  bool dc;
+};
+
+/// The registers to drive an internal pin with, bypassing the virtual GPIOPin calls.
+struct SPIDirectPin {
+  volatile uint32_t *set;
+  volatile uint32_t *clear;
+  volatile uint32_t *read;
+  uint32_t mask;
+  /// Mask to XOR a read value with, the pin's mask if it is inverted.
+  uint32_t read_invert;
+};
+
+/// What the bus keeps per device: its priority, its cached clock settings and how long it waited for the bus.
+struct SPIDeviceState {
+  GPIOPin *cs{nullptr};
+  /// A device pauses the queued writes of devices with the same or a lower priority instead of waiting for them.
+  uint8_t priority{0};
+  /// The clock register for the device's data rate, 0 until it first used the hardware bus.
+  uint32_t clock_div{0};
+  /// The data rate clock_div results in, the SPI driver doesn't compute the divider again when it is requested.
+  uint32_t clock{0};
+  /// The waits for queued writes since the last report, the times in us.
+  uint32_t waits{0};
+  uint32_t wait_total{0};
+  uint32_t wait_max{0};
+  /// How often the device paused the queued writes of another one.
+  uint32_t preemptions{0};
+};
+
 class SPIComponent : public Component {
  public:
   void set_clk(GPIOPin *clk) { clk_ = clk; }
   void set_miso(GPIOPin *miso) { miso_ = miso; }
   void set_mosi(GPIOPin *mosi) { mosi_ = mosi; }
+  /// All pins are internal GPIOs, so a software bus can write their registers directly. Set by codegen.
+  void set_direct_gpio(bool direct_gpio) { direct_gpio_ = direct_gpio; }
 
   void setup() override;
 
@@ -129,16 +169,25 @@ class SPIComponent : public Component {
     }
   }
 
+  /// Register a device for its priority and the contention report, done by SPIDevice. Registering twice is a no-op.
+  void register_device(SPIDeviceState *state) {
+    if (std::find(this->devices_.begin(), this->devices_.end(), state) == this->devices_.end())
+      this->devices_.push_back(state);
+  }
+
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, uint32_t DATA_RATE>
-  void enable(GPIOPin *cs) {
+  void enable(GPIOPin *cs, SPIDeviceState *state = nullptr) {
+    // the bus may still be held by queued writes
+    if (!this->queued_writes_.empty() && !this->in_queued_write_)
+      this->acquire_(cs, state);
+
     if (cs != nullptr) {
       SPIComponent::debug_enable(cs->get_pin());
     }
 
     if (this->hw_spi_ != nullptr) {
       uint8_t data_mode = (uint8_t(CLOCK_POLARITY) << 1) | uint8_t(CLOCK_PHASE);
-      SPISettings settings(DATA_RATE, BIT_ORDER, data_mode);
-      this->hw_spi_->beginTransaction(settings);
+      this->begin_transaction_(state, DATA_RATE, BIT_ORDER, data_mode);
     } else {
       this->clk_->digital_write(CLOCK_POLARITY);
       this->wait_cycle_ = uint32_t(F_CPU) / DATA_RATE / 2ULL;
@@ -152,10 +201,64 @@ class SPIComponent : public Component {
 
   void disable();
 
+  /** Queue a sequence of writes to one device, they are sent from loop() in chunks, a few ms at a time.
+   *
+   * Meant for long transfers like a display frame: the data has to stay valid until the callback ran. Queued writes
+   * are sent in the order of their device's priority. The chip select stays active in between chunks, unless another
+   * device with the same or a higher priority needs the bus: the writes are paused after a whole chunk then, like
+   * the MIPI display controllers allow it. Other devices first finish the queued writes, as does the same device.
+   */
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, uint32_t DATA_RATE>
+  void queue_writes(GPIOPin *cs, GPIOPin *dc, std::vector<SPIWriteDescriptor> &&descriptors,
+                    std::function<void()> &&callback, SPIDeviceState *state = nullptr) {
+    QueuedWrites writes{};
+    writes.cs = cs;
+    writes.dc = dc;
+    writes.state = state;
+    writes.enable = &SPIComponent::enable<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, DATA_RATE>;
+    writes.write = &SPIComponent::write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>;
+    writes.descriptors = std::move(descriptors);
+    writes.callback = std::move(callback);
+    this->insert_queued_writes_(std::move(writes));
+  }
+  /// Send all queued writes now.
+  void flush_queued_writes() { this->process_queued_writes_(0); }
+  bool has_queued_writes() const { return !this->queued_writes_.empty(); }
+
+  void loop() override;
+  bool is_loop_idle() override { return this->queued_writes_.empty(); }
+
   float get_setup_priority() const override;
 
  protected:
+  struct QueuedWrites {
+    GPIOPin *cs;
+    GPIOPin *dc;
+    SPIDeviceState *state;
+    void (SPIComponent::*enable)(GPIOPin *cs, SPIDeviceState *state);
+    void (SPIComponent::*write)(const uint8_t *data, size_t length);
+    std::vector<SPIWriteDescriptor> descriptors;
+    std::function<void()> callback;
+    bool enabled;
+    size_t index;
+    size_t offset;
+  };
+
+  /// Send queued writes until budget ms have passed, 0 means until the queue is empty.
+  void process_queued_writes_(uint32_t budget);
+  void insert_queued_writes_(QueuedWrites &&writes);
+  /// Pause the queued writes in progress, they continue from loop().
+  void pause_queued_writes_();
+  /// Make the bus available to a device while writes are queued, by pausing or finishing them.
+  void acquire_(GPIOPin *cs, SPIDeviceState *state);
+  /// Configure the hardware bus, with the device's cached clock divider if possible.
+  void begin_transaction_(SPIDeviceState *state, uint32_t data_rate, uint8_t bit_order, uint8_t data_mode);
+  void report_contention_();
+
   inline void cycle_clock_(bool value);
+  inline void cycle_clock_direct_(bool value);
+  /// Resolve the registers of the pin, returns false if it can't be driven directly.
+  static bool resolve_direct_pin_(GPIOPin *pin, SPIDirectPin *direct);
 
   static void debug_enable(uint8_t pin);
   static void debug_tx(uint8_t value);
@@ -163,23 +266,46 @@ class SPIComponent : public Component {
 
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
   uint8_t transfer_(uint8_t data);
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
+  uint8_t transfer_direct_(uint8_t data);
 
   GPIOPin *clk_;
   GPIOPin *miso_{nullptr};
   GPIOPin *mosi_{nullptr};
   GPIOPin *active_cs_{nullptr};
   SPIClass *hw_spi_{nullptr};
+  bool direct_gpio_{false};
+  SPIDirectPin direct_clk_{};
+  SPIDirectPin direct_miso_{};
+  SPIDirectPin direct_mosi_{};
   uint32_t wait_cycle_;
+  std::deque<QueuedWrites> queued_writes_;
+  bool in_queued_write_{false};
+  std::vector<SPIDeviceState *> devices_;
+  /// The device the hardware bus was configured for last.
+  SPIDeviceState *configured_{nullptr};
 };
 
 template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, SPIDataRate DATA_RATE>
 class SPIDevice {
  public:
   SPIDevice() = default;
-  SPIDevice(SPIComponent *parent, GPIOPin *cs) : parent_(parent), cs_(cs) {}
+  SPIDevice(SPIComponent *parent, GPIOPin *cs) : parent_(parent), cs_(cs) {
+    this->spi_state_.cs = cs;
+    parent->register_device(&this->spi_state_);
+  }
 
-  void set_spi_parent(SPIComponent *parent) { parent_ = parent; }
-  void set_cs_pin(GPIOPin *cs) { cs_ = cs; }
+  void set_spi_parent(SPIComponent *parent) {
+    parent_ = parent;
+    parent->register_device(&this->spi_state_);
+  }
+  void set_cs_pin(GPIOPin *cs) {
+    cs_ = cs;
+    this->spi_state_.cs = cs;
+  }
+  /// Set the priority of this device's transactions on a shared bus, see SPIComponent::queue_writes().
+  void set_spi_priority(uint8_t priority) { this->spi_state_.priority = priority; }
+  const SPIDeviceState &get_spi_state() const { return this->spi_state_; }
 
   void spi_setup() {
     if (this->cs_) {
@@ -188,10 +314,20 @@ class SPIDevice {
     }
   }
 
-  void enable() { this->parent_->template enable<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, DATA_RATE>(this->cs_); }
+  void enable() {
+    this->parent_->template enable<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, DATA_RATE>(this->cs_, &this->spi_state_);
+  }
 
   void disable() { this->parent_->disable(); }
 
+  /// Queue writes with this device's settings, see SPIComponent::queue_writes().
+  void queue_writes(GPIOPin *dc, std::vector<SPIWriteDescriptor> &&descriptors, std::function<void()> &&callback) {
+    this->parent_->template queue_writes<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE, DATA_RATE>(
+        this->cs_, dc, std::move(descriptors), std::move(callback), &this->spi_state_);
+  }
+  void flush_queued_writes() { this->parent_->flush_queued_writes(); }
+  bool has_queued_writes() const { return this->parent_->has_queued_writes(); }
+
   uint8_t read_byte() { return this->parent_->template read_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(); }
 
   void read_array(uint8_t *data, size_t length) {
@@ -229,6 +365,7 @@ class SPIDevice {
  protected:
   SPIComponent *parent_{nullptr};
   GPIOPin *cs_{nullptr};
+  SPIDeviceState spi_state_{};
 };
 
 }  // namespace spi
@@ -95,6 +95,11 @@ void SSD1306::setup() {
   this->turn_on();
 }
 void SSD1306::display() {
+  if (!this->damage_hashes_.empty()) {
+    // only the changed regions are written, each addressed on its own
+    this->flush_damage_();
+    return;
+  }
   if (this->is_sh1106_()) {
     this->write_display_data();
     return;
@@ -120,6 +125,29 @@ void SSD1306::display() {
 
   this->write_display_data();
 }
+void SSD1306::write_region_(int x, int y, int width, int height) {
+  const int page1 = y / 8;
+  const int page2 = (y + height - 1) / 8;
+  if (this->is_sh1106_()) {
+    // the SH1106 only supports page addressing, its 132 columns are centered on the display
+    for (int page = page1; page <= page2; page++) {
+      this->command(0xB0 + page);
+      this->command((x + 2) & 0x0F);
+      this->command(0x10 | ((x + 2) >> 4));
+      this->write_display_region_(x, page, width, 1);
+    }
+    return;
+  }
+
+  const int offset = this->model_ == SSD1306_MODEL_64_48 ? 0x20 : 0;
+  this->command(SSD1306_COMMAND_COLUMN_ADDRESS);
+  this->command(offset + x);
+  this->command(offset + x + width - 1);
+  this->command(SSD1306_COMMAND_PAGE_ADDRESS);
+  this->command(page1);
+  this->command(page2);
+  this->write_display_region_(x, page1, width, page2 - page1 + 1);
+}
 bool SSD1306::is_sh1106_() const {
   return this->model_ == SH1106_MODEL_96_16 || this->model_ == SH1106_MODEL_128_32 ||
          this->model_ == SH1106_MODEL_128_64;
@@ -194,6 +222,25 @@ void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
     this->buffer_[pos] &= ~(1 << subpos);
   }
 }
+void HOT SSD1306::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  const bool on = color.is_on();
+  // every byte holds a column of 8 rows (a page)
+  for (int page = y / 8; page <= (y + height - 1) / 8; page++) {
+    const int first = std::max(y, page * 8) - page * 8;
+    const int last = std::min(y + height, page * 8 + 8) - page * 8;
+    const uint8_t mask = uint8_t(0xFF << first) & uint8_t(0xFF >> (8 - last));
+    uint8_t *pos = this->buffer_ + page * this->get_width_internal() + x;
+    if (mask == 0xFF) {
+      memset(pos, on ? 0xFF : 0x00, width);
+    } else if (on) {
+      for (int i = 0; i < width; i++)
+        pos[i] |= mask;
+    } else {
+      for (int i = 0; i < width; i++)
+        pos[i] &= ~mask;
+    }
+  }
+}
 void SSD1306::fill(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
@@ -40,11 +40,16 @@ class SSD1306 : public PollingComponent, public display::DisplayBuffer {
  protected:
   virtual void command(uint8_t value) = 0;
   virtual void write_display_data() = 0;
+  /// Write the given pages of the buffer, limited to width columns starting at x, after write_region_() addressed them.
+  virtual void write_display_region_(int x, int page, int width, int pages) {}
+  /// Address the window of the display memory and write it with write_display_region_(), for damage tracking.
+  void write_region_(int x, int y, int width, int height) override;
   void init_reset_();
 
   bool is_sh1106_() const;
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
 
   int get_height_internal() override;
   int get_width_internal() override;
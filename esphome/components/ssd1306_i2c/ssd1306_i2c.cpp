@@ -17,6 +17,8 @@ void I2CSSD1306::setup() {
     return;
   }
 
+  // the bus is slow compared to the display, so only the pages that changed are sent
+  this->init_packed_damage_tracking_(1);
   SSD1306::setup();
 }
 void I2CSSD1306::dump_config() {
@@ -33,28 +35,17 @@ void I2CSSD1306::dump_config() {
 }
 void I2CSSD1306::command(uint8_t value) { this->write_byte(0x00, value); }
 void HOT I2CSSD1306::write_display_data() {
-  if (this->is_sh1106_()) {
-    uint32_t i = 0;
-    for (uint8_t page = 0; page < this->get_height_internal() / 8; page++) {
-      this->command(0xB0 + page);  // row
-      this->command(0x02);         // lower column
-      this->command(0x10);         // higher column
-
-      for (uint8_t x = 0; x < this->get_width_internal() / 16; x++) {
-        uint8_t data[16];
-        for (uint8_t &j : data)
-          j = this->buffer_[i++];
-        this->write_bytes(0x40, data, sizeof(data));
-      }
-    }
-  } else {
-    for (uint32_t i = 0; i < this->get_buffer_length_();) {
-      uint8_t data[16];
-      for (uint8_t &j : data)
-        j = this->buffer_[i++];
-      this->write_bytes(0x40, data, sizeof(data));
-    }
+  this->write_region_(0, 0, this->get_width_internal(), this->get_height_internal());
+}
+void HOT I2CSSD1306::write_display_region_(int x, int page, int width, int pages) {
+  const int display_width = this->get_width_internal();
+  if (width == display_width) {
+    // whole pages follow each other in the buffer and in the addressed window
+    this->write_bytes_long(0x40, this->buffer_ + page * display_width, size_t(width) * pages);
+    return;
   }
+  for (int i = 0; i < pages; i++)
+    this->write_bytes_long(0x40, this->buffer_ + (page + i) * display_width + x, width);
 }
 
 }  // namespace ssd1306_i2c
@@ -83,6 +83,11 @@ void SSD1327::setup() {
   this->turn_on();          // display ON
 }
 void SSD1327::display() {
+  if (!this->damage_hashes_.empty()) {
+    // only the changed regions are written, each addressed on its own
+    this->flush_damage_();
+    return;
+  }
   this->command(SSD1327_SETCOLUMNADDRESS);  // set column address
   this->command(0x00);                      // set column start address
   this->command(0x3F);                      // set column end address
@@ -92,6 +97,16 @@ void SSD1327::display() {
 
   this->write_display_data();
 }
+void SSD1327::write_region_(int x, int y, int width, int height) {
+  // a column address selects two pixels
+  this->command(SSD1327_SETCOLUMNADDRESS);
+  this->command(x / SSD1327_PIXELSPERBYTE);
+  this->command((x + width) / SSD1327_PIXELSPERBYTE - 1);
+  this->command(SSD1327_SETROWADDRESS);
+  this->command(y);
+  this->command(y + height - 1);
+  this->write_display_region_(x, y, width, height);
+}
 void SSD1327::update() {
   if (!this->is_failed()) {
     this->do_update_();
@@ -33,6 +33,10 @@ class SSD1327 : public PollingComponent, public display::DisplayBuffer {
  protected:
   virtual void command(uint8_t value) = 0;
   virtual void write_display_data() = 0;
+  /// Write the given rows of the buffer, limited to width columns starting at x, after write_region_() addressed them.
+  virtual void write_display_region_(int x, int y, int width, int height) {}
+  /// Address the window of the display memory and write it with write_display_region_(), for damage tracking.
+  void write_region_(int x, int y, int width, int height) override;
   void init_reset_();
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
@@ -17,6 +17,8 @@ void I2CSSD1327::setup() {
     return;
   }
 
+  // the bus is slow compared to the display, so only the regions that changed are sent
+  this->init_packed_damage_tracking_(4);
   SSD1327::setup();
 }
 void I2CSSD1327::dump_config() {
@@ -32,12 +34,18 @@ void I2CSSD1327::dump_config() {
 }
 void I2CSSD1327::command(uint8_t value) { this->write_byte(0x00, value); }
 void HOT I2CSSD1327::write_display_data() {
-  for (uint32_t i = 0; i < this->get_buffer_length_();) {
-    uint8_t data[16];
-    for (uint8_t &j : data)
-      j = this->buffer_[i++];
-    this->write_bytes(0x40, data, sizeof(data));
+  this->write_region_(0, 0, this->get_width_internal(), this->get_height_internal());
+}
+void HOT I2CSSD1327::write_display_region_(int x, int y, int width, int height) {
+  // two pixels per byte
+  const int stride = this->get_width_internal() / 2;
+  if (width == this->get_width_internal()) {
+    // whole rows follow each other in the buffer and in the addressed window
+    this->write_bytes_long(0x40, this->buffer_ + y * stride, size_t(stride) * height);
+    return;
   }
+  for (int row = y; row < y + height; row++)
+    this->write_bytes_long(0x40, this->buffer_ + row * stride + x / 2, width / 2);
 }
 
 }  // namespace ssd1327_i2c
@@ -51,6 +51,7 @@ static const uint8_t SSD1351_STARTSCROLL = 0x9F;
 
 void SSD1351::setup() {
   this->init_internal_(this->get_buffer_length_());
+  this->init_damage_tracking_(SSD1351_BYTESPERPIXEL);
 
   this->command(SSD1351_COMMANDLOCK);
   this->data(0x12);
@@ -91,19 +92,28 @@ void SSD1351::setup() {
   this->display();    // ...write buffer, which actually clears the display's memory
   this->turn_on();    // display ON
 }
-void SSD1351::display() {
+void SSD1351::display() { this->write_region_(0, 0, this->get_width_internal(), this->get_height_internal()); }
+void SSD1351::update() {
+  this->do_update_();
+  // only the damaged windows are sent to the display
+  this->flush_damage_();
+}
+void SSD1351::write_region_(int x, int y, int width, int height) {
   this->command(SSD1351_SETCOLUMN);  // set column address
-  this->data(0x00);                  // set column start address
-  this->data(0x7F);                  // set column end address
+  this->data(x);                     // set column start address
+  this->data(x + width - 1);         // set column end address
   this->command(SSD1351_SETROW);     // set row address
-  this->data(0x00);                  // set row start address
-  this->data(0x7F);                  // set last row
+  this->data(y);                     // set row start address
+  this->data(y + height - 1);        // set last row
   this->command(SSD1351_WRITERAM);
-  this->write_display_data();
-}
-void SSD1351::update() {
-  this->do_update_();
-  this->display();
+  const size_t stride = size_t(this->get_width_internal()) * SSD1351_BYTESPERPIXEL;
+  if (width == this->get_width_internal()) {
+    // full lines are contiguous in the buffer
+    this->write_display_data(this->buffer_ + y * stride, height * stride);
+    return;
+  }
+  for (int row = y; row < y + height; row++)
+    this->write_display_data(this->buffer_ + row * stride + x * SSD1351_BYTESPERPIXEL, width * SSD1351_BYTESPERPIXEL);
 }
 void SSD1351::set_brightness(float brightness) {
   // validation
@@ -113,6 +113,7 @@ void ST7789V::setup() {
 
   this->init_internal_(this->get_buffer_length_());
   memset(this->buffer_, 0x00, this->get_buffer_length_());
+  this->init_second_buffer_(this->get_buffer_length_());
 }
 
 void ST7789V::dump_config() {
@@ -127,38 +128,51 @@ void ST7789V::dump_config() {
 float ST7789V::get_setup_priority() const { return setup_priority::PROCESSOR; }
 
 void ST7789V::update() {
-  this->do_update_();
-  this->write_display_data();
+  // the buffer is still being sent from the last update, unless there is a second one to draw into
+  if (!this->has_second_buffer_() && !this->is_rendering_() && this->has_queued_writes())
+    this->flush_queued_writes();
+  if (!this->render_()) {
+    ESP_LOGV(TAG, "Still drawing the last frame, skipping update");
+    return;
+  }
+  if (!this->is_rendering_()) {
+    this->write_display_data();
+    return;
+  }
+  // the render task draws the frame, send it once it is done and the last one was sent
+  this->run_steps("flush", 0, [this]() {
+    if (this->is_rendering_() || this->has_queued_writes())
+      return false;
+    this->write_display_data();
+    this->swap_buffers_();
+    return true;
+  });
 }
 
 void ST7789V::loop() {}
 
 void ST7789V::write_display_data() {
+  static const uint8_t CASET = ST7789_CASET;
+  static const uint8_t RASET = ST7789_RASET;
+  static const uint8_t RAMWR = ST7789_RAMWR;
   uint16_t x1 = 52;   // _offsetx
   uint16_t x2 = 186;  // _offsetx
   uint16_t y1 = 40;   // _offsety
   uint16_t y2 = 279;  // _offsety
 
-  this->enable();
-
-  // set column(x) address
-  this->dc_pin_->digital_write(false);
-  this->write_byte(ST7789_CASET);
-  this->dc_pin_->digital_write(true);
-  this->write_addr_(x1, x2);
-  // set page(y) address
-  this->dc_pin_->digital_write(false);
-  this->write_byte(ST7789_RASET);
-  this->dc_pin_->digital_write(true);
-  this->write_addr_(y1, y2);
-  // write display memory
-  this->dc_pin_->digital_write(false);
-  this->write_byte(ST7789_RAMWR);
-  this->dc_pin_->digital_write(true);
-
-  this->write_array(this->buffer_, this->get_buffer_length_());
-
-  this->disable();
+  encode_addr_(this->column_addr_, x1, x2);
+  encode_addr_(this->page_addr_, y1, y2);
+  // the frame is sent from the SPI bus loop, a few ms at a time
+  this->queue_writes(this->dc_pin_,
+                     {
+                         {&CASET, 1, false},  // set column(x) address
+                         {this->column_addr_, 4, true},
+                         {&RASET, 1, false},  // set page(y) address
+                         {this->page_addr_, 4, true},
+                         {&RAMWR, 1, false},  // write display memory
+                         {this->buffer_, this->get_buffer_length_(), true},
+                     },
+                     nullptr);
 }
 
 void ST7789V::init_reset_() {
@@ -196,12 +210,16 @@ void ST7789V::write_data_(uint8_t value) {
   this->disable();
 }
 
+void ST7789V::encode_addr_(uint8_t *dest, uint16_t addr1, uint16_t addr2) {
+  dest[0] = (addr1 >> 8) & 0xFF;
+  dest[1] = addr1 & 0xFF;
+  dest[2] = (addr2 >> 8) & 0xFF;
+  dest[3] = addr2 & 0xFF;
+}
+
 void ST7789V::write_addr_(uint16_t addr1, uint16_t addr2) {
   static uint8_t BYTE[4];
-  BYTE[0] = (addr1 >> 8) & 0xFF;
-  BYTE[1] = addr1 & 0xFF;
-  BYTE[2] = (addr2 >> 8) & 0xFF;
-  BYTE[3] = addr2 & 0xFF;
+  encode_addr_(BYTE, addr1, addr2);
 
   this->dc_pin_->digital_write(true);
   this->write_array(BYTE, 4);
@@ -270,5 +288,42 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
   this->buffer_[pos] = color565 & 0xff;
 }
 
+void HOT ST7789V::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  const uint16_t color565 = color.to_rgb_565();
+  const size_t stride = size_t(this->get_width_internal()) * 2;
+  uint8_t *first = this->buffer_ + y * stride + x * 2;
+  for (int col = 0; col < width; col++) {
+    first[col * 2] = color565 >> 8;
+    first[col * 2 + 1] = color565 & 0xff;
+  }
+  // the other rows are copies of the first one
+  for (int row = 1; row < height; row++)
+    memcpy(first + row * stride, first, width * 2);
+}
+
+void HOT ST7789V::blit_internal(int x, int y, display::Image *image, int src_x, int src_y, int width, int height,
+                                Color color_on, Color color_off) {
+  const uint16_t value_on = color_on.to_rgb_565();
+  const uint16_t value_off = color_off.to_rgb_565();
+  const display::ImageType type = image->get_type();
+  const size_t stride = size_t(this->get_width_internal()) * 2;
+  for (int row = 0; row < height; row++) {
+    uint8_t *pos = this->buffer_ + (y + row) * stride + x * 2;
+    const int img_y = src_y + row;
+    for (int img_x = src_x; img_x < src_x + width; img_x++) {
+      uint16_t color565;
+      if (type == display::IMAGE_TYPE_BINARY) {
+        color565 = image->get_pixel(img_x, img_y) ? value_on : value_off;
+      } else if (type == display::IMAGE_TYPE_GRAYSCALE) {
+        color565 = image->get_grayscale_pixel(img_x, img_y).to_rgb_565();
+      } else {
+        color565 = image->get_color_pixel(img_x, img_y).to_rgb_565();
+      }
+      *pos++ = color565 >> 8;
+      *pos++ = color565 & 0xff;
+    }
+  }
+}
+
 }  // namespace st7789v
 }  // namespace esphome
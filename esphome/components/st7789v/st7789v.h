@@ -130,11 +130,15 @@ class ST7789V : public PollingComponent,
   GPIOPin *dc_pin_;
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *backlight_pin_{nullptr};
+  /// The column and page address windows of the frame, sent with the queued frame write.
+  uint8_t column_addr_[4];
+  uint8_t page_addr_[4];
 
   void init_reset_();
   void backlight_(bool onoff);
   void write_command_(uint8_t value);
   void write_data_(uint8_t value);
+  static void encode_addr_(uint8_t *dest, uint16_t addr1, uint16_t addr2);
   void write_addr_(uint16_t addr1, uint16_t addr2);
   void write_color_(uint16_t color, uint16_t size);
 
@@ -145,6 +149,9 @@ class ST7789V : public PollingComponent,
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
+  void blit_internal(int x, int y, display::Image *image, int src_x, int src_y, int width, int height, Color color_on,
+                     Color color_off) override;
 };
 
 }  // namespace st7789v
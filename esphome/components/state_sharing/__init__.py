@@ -0,0 +1,48 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import binary_sensor, sensor
+from esphome.const import CONF_BINARY_SENSORS, CONF_ID, CONF_MIN_INTERVAL, CONF_PORT, CONF_SENSORS
+
+DEPENDENCIES = ['network']
+
+CONF_MULTICAST_ADDRESS = 'multicast_address'
+CONF_RESEND_INTERVAL = 'resend_interval'
+CONF_STATE_SHARING_ID = 'state_sharing_id'
+
+state_sharing_ns = cg.esphome_ns.namespace('state_sharing')
+StateSharingComponent = state_sharing_ns.class_('StateSharingComponent', cg.Component)
+IPAddress = cg.global_ns.class_('IPAddress')
+
+
+def validate_multicast_address(value):
+    value = cv.ipv4(value)
+    if not 224 <= value.args[0] <= 239:
+        raise cv.Invalid("{} is not a multicast address (224.0.0.0 to 239.255.255.255)".format(value))
+    return value
+
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(StateSharingComponent),
+    cv.Optional(CONF_MULTICAST_ADDRESS, default='239.255.42.42'): validate_multicast_address,
+    cv.Optional(CONF_PORT, default=18522): cv.port,
+    cv.Optional(CONF_MIN_INTERVAL, default='20ms'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_RESEND_INTERVAL, default='60s'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_SENSORS, default=[]): cv.ensure_list(cv.use_id(sensor.Sensor)),
+    cv.Optional(CONF_BINARY_SENSORS, default=[]): cv.ensure_list(cv.use_id(binary_sensor.BinarySensor)),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    cg.add(var.set_multicast_address(IPAddress(*config[CONF_MULTICAST_ADDRESS].args)))
+    cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_min_interval(config[CONF_MIN_INTERVAL]))
+    cg.add(var.set_resend_interval(config[CONF_RESEND_INTERVAL]))
+    for sensor_id in config[CONF_SENSORS]:
+        sens = yield cg.get_variable(sensor_id)
+        cg.add(var.add_sensor(sens))
+    for binary_sensor_id in config[CONF_BINARY_SENSORS]:
+        sens = yield cg.get_variable(binary_sensor_id)
+        cg.add(var.add_binary_sensor(sens))
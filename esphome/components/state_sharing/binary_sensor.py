@@ -0,0 +1,24 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import binary_sensor
+from esphome.const import CONF_NAME
+from esphome.cpp_helpers import entity_object_id, fnv1_hash
+from . import StateSharingComponent, CONF_STATE_SHARING_ID
+from .sensor import CONF_NODE, CONF_REMOTE_ID
+
+DEPENDENCIES = ['state_sharing']
+
+CONFIG_SCHEMA = binary_sensor.BINARY_SENSOR_SCHEMA.extend({
+    cv.GenerateID(): cv.declare_id(binary_sensor.BinarySensor),
+    cv.GenerateID(CONF_STATE_SHARING_ID): cv.use_id(StateSharingComponent),
+    cv.Required(CONF_NODE): cv.valid_name,
+    cv.Optional(CONF_REMOTE_ID): cv.string,
+})
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_STATE_SHARING_ID])
+    var = yield binary_sensor.new_binary_sensor(config)
+
+    remote_id = entity_object_id(config.get(CONF_REMOTE_ID, config[CONF_NAME]))
+    cg.add(parent.subscribe_binary_sensor(fnv1_hash(config[CONF_NODE]), fnv1_hash(remote_id), var))
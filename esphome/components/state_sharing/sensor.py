@@ -0,0 +1,28 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_NAME, ICON_EMPTY, UNIT_EMPTY
+from esphome.cpp_helpers import entity_object_id, fnv1_hash
+from . import StateSharingComponent, CONF_STATE_SHARING_ID
+
+DEPENDENCIES = ['state_sharing']
+
+CONF_NODE = 'node'
+CONF_REMOTE_ID = 'remote_id'
+
+CONFIG_SCHEMA = sensor.sensor_schema(UNIT_EMPTY, ICON_EMPTY, 1).extend({
+    cv.GenerateID(): cv.declare_id(sensor.Sensor),
+    cv.GenerateID(CONF_STATE_SHARING_ID): cv.use_id(StateSharingComponent),
+    # the name of the node that publishes the sensor
+    cv.Required(CONF_NODE): cv.valid_name,
+    # the object id of the sensor on that node, by default the object id of this sensor
+    cv.Optional(CONF_REMOTE_ID): cv.string,
+})
+
+
+def to_code(config):
+    parent = yield cg.get_variable(config[CONF_STATE_SHARING_ID])
+    var = yield sensor.new_sensor(config)
+
+    remote_id = entity_object_id(config.get(CONF_REMOTE_ID, config[CONF_NAME]))
+    cg.add(parent.subscribe_sensor(fnv1_hash(config[CONF_NODE]), fnv1_hash(remote_id), var))
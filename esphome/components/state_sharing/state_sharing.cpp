@@ -0,0 +1,277 @@
+#include "state_sharing.h"
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+#include "esphome/core/util.h"
+#include <cstring>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <AsyncUDP.h>
+#include <WiFi.h>
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#endif
+
+namespace esphome {
+namespace state_sharing {
+
+static const char *TAG = "state_sharing";
+
+static const uint8_t FRAME_MAGIC = 'S';
+static const size_t FRAME_HEADER_SIZE = 10;
+static const size_t FRAME_STATE_SIZE = 11;
+/// The most states in one frame.
+static const size_t FRAME_MAX_STATES = (STATE_SHARING_MAX_FRAME - FRAME_HEADER_SIZE) / FRAME_STATE_SIZE;
+
+#ifdef USE_SENSOR
+void StateSharingComponent::add_sensor(sensor::Sensor *sensor) {
+  const size_t index = this->published_.size();
+  this->published_.push_back(Published{ENTITY_SENSOR, sensor->get_object_id_hash(), 0, false, false, 0.0f});
+  sensor->add_on_state_callback([this, index](float state) { this->update_(this->published_[index], state); });
+}
+void StateSharingComponent::subscribe_sensor(uint32_t node, uint32_t key, sensor::Sensor *sensor) {
+  this->subscriptions_.push_back(Subscription{ENTITY_SENSOR, node, key, 0, 0, false, sensor});
+}
+#endif
+
+#ifdef USE_BINARY_SENSOR
+void StateSharingComponent::add_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
+  const size_t index = this->published_.size();
+  this->published_.push_back(
+      Published{ENTITY_BINARY_SENSOR, binary_sensor->get_object_id_hash(), 0, false, false, 0.0f});
+  binary_sensor->add_on_state_callback(
+      [this, index](bool state) { this->update_(this->published_[index], state ? 1.0f : 0.0f); });
+}
+void StateSharingComponent::subscribe_binary_sensor(uint32_t node, uint32_t key,
+                                                    binary_sensor::BinarySensor *binary_sensor) {
+  this->subscriptions_.push_back(Subscription{ENTITY_BINARY_SENSOR, node, key, 0, 0, false, binary_sensor});
+}
+#endif
+
+void StateSharingComponent::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up state sharing...");
+  this->node_ = fnv1_hash(App.get_name());
+  this->session_ = random_uint32();
+  // the first states are sent right away
+  this->last_send_ = millis() - this->min_interval_;
+
+  if (this->resend_interval_ != 0 && !this->published_.empty()) {
+    this->set_interval("resend", this->resend_interval_, [this]() {
+      for (auto &published : this->published_) {
+        if (published.has_state) {
+          published.dirty = true;
+          this->dirty_ = true;
+        }
+      }
+    });
+  }
+  this->join_();
+}
+
+void StateSharingComponent::update_(Published &published, float value) {
+  published.value = value;
+  published.seq++;
+  published.has_state = true;
+  published.dirty = true;
+  this->dirty_ = true;
+}
+
+bool StateSharingComponent::join_() {
+  if (!network_is_connected())
+    return false;
+
+#ifdef ARDUINO_ARCH_ESP32
+  if (!this->udp_) {
+    this->udp_.reset(new AsyncUDP());
+    this->udp_->onPacket([this](AsyncUDPPacket &packet) { this->on_packet(packet.data(), packet.length()); });
+  }
+  // the membership belongs to the socket and survives reconnects
+  this->joined_ = this->udp_->listenMulticast(this->address_, this->port_);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  if (!this->udp_)
+    this->udp_.reset(new WiFiUDP());
+  this->udp_->stop();
+  // the membership is bound to the address of the interface, so it is renewed after each reconnect
+  this->joined_ = this->udp_->beginMulticast(WiFi.localIP(), this->address_, this->port_);
+#endif
+
+  if (!this->joined_) {
+    ESP_LOGW(TAG, "Joining %s:%u failed", this->address_.toString().c_str(), this->port_);
+  }
+  return this->joined_;
+}
+
+void StateSharingComponent::loop() {
+#ifdef ARDUINO_ARCH_ESP32
+  const Frame *frame;
+  while ((frame = this->rx_frames_.front()) != nullptr) {
+    this->handle_frame_(frame->data, frame->len);
+    this->rx_frames_.pop();
+  }
+  const uint32_t dropped = this->rx_dropped_.exchange(0);
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %u frames because the loop fell behind", dropped);
+#endif
+
+  if (!network_is_connected()) {
+#ifdef ARDUINO_ARCH_ESP8266
+    this->joined_ = false;
+#endif
+    return;
+  }
+  if (!this->joined_ && !this->join_())
+    return;
+
+#ifdef ARDUINO_ARCH_ESP8266
+  uint8_t buffer[STATE_SHARING_MAX_FRAME];
+  while (int size = this->udp_->parsePacket()) {
+    const int len = this->udp_->read(buffer, sizeof(buffer));
+    // larger frames aren't sent by any node, the rest of them is discarded with the next parsePacket()
+    if (len > 0 && size <= int(sizeof(buffer)))
+      this->handle_frame_(buffer, len);
+  }
+#endif
+
+  if (this->dirty_ && millis() - this->last_send_ >= this->min_interval_)
+    this->send_dirty_();
+}
+
+bool StateSharingComponent::is_loop_idle() {
+#ifdef ARDUINO_ARCH_ESP32
+  // received frames wake the loop, only states waiting for min_interval need polling
+  return this->rx_frames_.empty() && !this->dirty_ && this->joined_;
+#else
+  return false;
+#endif
+}
+
+void StateSharingComponent::send_dirty_() {
+  uint8_t frame[STATE_SHARING_MAX_FRAME];
+  frame[0] = FRAME_MAGIC;
+  memcpy(frame + 1, &this->node_, 4);
+  memcpy(frame + 5, &this->session_, 4);
+  uint8_t count = 0;
+  uint8_t *dst = frame + FRAME_HEADER_SIZE;
+  this->dirty_ = false;
+  for (auto &published : this->published_) {
+    if (!published.dirty)
+      continue;
+    if (count == FRAME_MAX_STATES) {
+      // the rest goes out with the next frame
+      this->dirty_ = true;
+      break;
+    }
+    published.dirty = false;
+    dst[0] = published.type;
+    memcpy(dst + 1, &published.key, 4);
+    memcpy(dst + 5, &published.seq, 2);
+    memcpy(dst + 7, &published.value, 4);
+    dst += FRAME_STATE_SIZE;
+    count++;
+  }
+  frame[9] = count;
+  const size_t len = dst - frame;
+
+#ifdef ARDUINO_ARCH_ESP32
+  const bool ok = this->udp_->writeTo(frame, len, this->address_, this->port_) == len;
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  bool ok = this->udp_->beginPacketMulticast(this->address_, this->port_, WiFi.localIP());
+  if (ok) {
+    this->udp_->write(frame, len);
+    ok = this->udp_->endPacket();
+  }
+#endif
+  this->last_send_ = millis();
+  if (!ok) {
+    ESP_LOGW(TAG, "Sending %u states failed", count);
+    return;
+  }
+  this->sent_frames_++;
+  ESP_LOGV(TAG, "Sent %u states", count);
+}
+
+void StateSharingComponent::handle_frame_(const uint8_t *data, size_t len) {
+  if (len < FRAME_HEADER_SIZE || data[0] != FRAME_MAGIC || len != FRAME_HEADER_SIZE + data[9] * FRAME_STATE_SIZE) {
+    ESP_LOGV(TAG, "Ignoring a frame of %u bytes", len);
+    return;
+  }
+  uint32_t node, session;
+  memcpy(&node, data + 1, 4);
+  memcpy(&session, data + 5, 4);
+  // the multicast loopback
+  if (node == this->node_)
+    return;
+  this->received_frames_++;
+
+  const uint8_t *src = data + FRAME_HEADER_SIZE;
+  for (uint8_t i = 0; i < data[9]; i++, src += FRAME_STATE_SIZE) {
+    uint32_t key;
+    uint16_t seq;
+    float value;
+    memcpy(&key, src + 1, 4);
+    memcpy(&seq, src + 5, 2);
+    memcpy(&value, src + 7, 4);
+    for (auto &subscription : this->subscriptions_) {
+      if (subscription.node != node || subscription.key != key || subscription.type != src[0])
+        continue;
+      if (subscription.has_seq && subscription.session == session && int16_t(seq - subscription.seq) <= 0) {
+        this->dropped_states_++;
+        continue;
+      }
+      subscription.session = session;
+      subscription.seq = seq;
+      subscription.has_seq = true;
+      this->publish_(subscription, value);
+    }
+  }
+}
+
+void StateSharingComponent::publish_(Subscription &subscription, float value) {
+  switch (subscription.type) {
+#ifdef USE_SENSOR
+    case ENTITY_SENSOR:
+      static_cast<sensor::Sensor *>(subscription.entity)->publish_state(value);
+      break;
+#endif
+#ifdef USE_BINARY_SENSOR
+    case ENTITY_BINARY_SENSOR:
+      static_cast<binary_sensor::BinarySensor *>(subscription.entity)->publish_state(value != 0.0f);
+      break;
+#endif
+    default:
+      break;
+  }
+}
+
+void StateSharingComponent::on_packet(const uint8_t *data, size_t len) {
+#ifdef ARDUINO_ARCH_ESP32
+  Frame *frame = this->rx_frames_.slot_to_push();
+  if (frame == nullptr || len > STATE_SHARING_MAX_FRAME) {
+    this->rx_dropped_++;
+    return;
+  }
+  frame->len = len;
+  memcpy(frame->data, data, len);
+  this->rx_frames_.push();
+  App.wake_loop();
+#endif
+}
+
+void StateSharingComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "State Sharing:");
+  ESP_LOGCONFIG(TAG, "  Group: %s:%u", this->address_.toString().c_str(), this->port_);
+  ESP_LOGCONFIG(TAG, "  Node Hash: 0x%08X", this->node_);
+  ESP_LOGCONFIG(TAG, "  Min Interval: %u ms", this->min_interval_);
+  ESP_LOGCONFIG(TAG, "  Resend Interval: %u ms", this->resend_interval_);
+  ESP_LOGCONFIG(TAG, "  Published Entities: %u", this->published_.size());
+  ESP_LOGCONFIG(TAG, "  Subscribed Entities: %u", this->subscriptions_.size());
+}
+
+float StateSharingComponent::get_setup_priority() const { return setup_priority::AFTER_WIFI; }
+
+}  // namespace state_sharing
+}  // namespace esphome
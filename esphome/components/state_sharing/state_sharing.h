@@ -0,0 +1,143 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/spsc_queue.h"
+#include <IPAddress.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+
+#ifdef ARDUINO_ARCH_ESP32
+class AsyncUDP;
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+class WiFiUDP;
+#endif
+
+namespace esphome {
+namespace state_sharing {
+
+/// The largest frame that is sent, well below the MTU so frames are never fragmented.
+static const size_t STATE_SHARING_MAX_FRAME = 512;
+/// How many received frames wait for the loop on the ESP32, they are received in the UDP task.
+static const uint8_t STATE_SHARING_RX_QUEUE_SIZE = 4;
+
+enum EntityType : uint8_t {
+  ENTITY_SENSOR = 0,
+  ENTITY_BINARY_SENSOR = 1,
+};
+
+/** Shares entity states between nodes with UDP multicast, without a round trip through Home Assistant.
+ *
+ * Each node sends the states of its published entities to a multicast group, other nodes publish the states of the
+ * entities they subscribed to. Entities are identified by the hash of the node name and the object id hash of the
+ * entity. Only the newest state of an entity is kept until the next frame, so fast changes are coalesced, and frames
+ * are sent at most every min_interval. Every state carries a sequence number of its entity, receivers drop states
+ * that are not newer than the last one, for example duplicates from a resend. A random session id per boot resets
+ * the sequence numbers of a node that restarted.
+ *
+ * Frame layout, little endian: the magic byte 'S', the node hash (uint32_t), the session id (uint32_t), the number of
+ * states, then for every state its entity type, key (uint32_t), sequence number (uint16_t) and value (float).
+ */
+class StateSharingComponent : public Component {
+ public:
+  void set_port(uint16_t port) { this->port_ = port; }
+  void set_multicast_address(const IPAddress &address) { this->address_ = address; }
+  /// Set the minimum time between two frames sent by this node.
+  void set_min_interval(uint32_t min_interval) { this->min_interval_ = min_interval; }
+  /// Set the interval at which all states are sent again, for nodes that missed them or started later.
+  void set_resend_interval(uint32_t resend_interval) { this->resend_interval_ = resend_interval; }
+
+#ifdef USE_SENSOR
+  /// Send the states of a sensor to the other nodes.
+  void add_sensor(sensor::Sensor *sensor);
+  /// Publish the states of a sensor of another node to a local sensor.
+  void subscribe_sensor(uint32_t node, uint32_t key, sensor::Sensor *sensor);
+#endif
+#ifdef USE_BINARY_SENSOR
+  /// Send the states of a binary sensor to the other nodes.
+  void add_binary_sensor(binary_sensor::BinarySensor *binary_sensor);
+  /// Publish the states of a binary sensor of another node to a local binary sensor.
+  void subscribe_binary_sensor(uint32_t node, uint32_t key, binary_sensor::BinarySensor *binary_sensor);
+#endif
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override;
+  bool is_loop_idle() override;
+
+  uint32_t get_sent_frames() const { return this->sent_frames_; }
+  uint32_t get_received_frames() const { return this->received_frames_; }
+  uint32_t get_dropped_states() const { return this->dropped_states_; }
+
+  /// Queue a received frame for the loop, called from the UDP task on the ESP32.
+  void on_packet(const uint8_t *data, size_t len);
+
+ protected:
+  struct Published {
+    EntityType type;
+    uint32_t key;
+    uint16_t seq;
+    bool has_state;
+    bool dirty;
+    float value;
+  };
+  struct Subscription {
+    EntityType type;
+    uint32_t node;
+    uint32_t key;
+    uint32_t session;
+    uint16_t seq;
+    bool has_seq;
+    /// The sensor or binary sensor, depending on type.
+    void *entity;
+  };
+  struct Frame {
+    uint16_t len;
+    uint8_t data[STATE_SHARING_MAX_FRAME];
+  };
+
+  void update_(Published &published, float value);
+  bool join_();
+  void send_dirty_();
+  void handle_frame_(const uint8_t *data, size_t len);
+  void publish_(Subscription &subscription, float value);
+
+  uint16_t port_;
+  IPAddress address_;
+  uint32_t min_interval_;
+  uint32_t resend_interval_;
+  uint32_t node_{0};
+  uint32_t session_{0};
+  /// The state callbacks refer to their entry by index.
+  std::vector<Published> published_;
+  std::vector<Subscription> subscriptions_;
+  bool dirty_{false};
+  bool joined_{false};
+  uint32_t last_send_{0};
+  uint32_t sent_frames_{0};
+  uint32_t received_frames_{0};
+  uint32_t dropped_states_{0};
+
+#ifdef ARDUINO_ARCH_ESP32
+  std::unique_ptr<AsyncUDP> udp_;
+  /// Filled by on_packet() in the UDP task, emptied by the loop. One slot always stays empty.
+  SPSCQueue<Frame, STATE_SHARING_RX_QUEUE_SIZE + 1> rx_frames_;
+  std::atomic<uint32_t> rx_dropped_{0};
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  std::unique_ptr<WiFiUDP> udp_;
+#endif
+};
+
+}  // namespace state_sharing
+}  // namespace esphome
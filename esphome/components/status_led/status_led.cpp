@@ -28,6 +28,7 @@ void StatusLED::loop() {
     this->pin_->digital_write(false);
   }
 }
+bool StatusLED::is_loop_idle() { return (App.get_app_state() & (STATUS_LED_ERROR | STATUS_LED_WARNING)) == 0u; }
 float StatusLED::get_setup_priority() const { return setup_priority::HARDWARE; }
 float StatusLED::get_loop_priority() const { return 50.0f; }
 
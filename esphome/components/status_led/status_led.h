@@ -13,6 +13,7 @@ class StatusLED : public Component {
   void pre_setup();
   void dump_config() override;
   void loop() override;
+  bool is_loop_idle() override;
   float get_setup_priority() const override;
   float get_loop_priority() const override;
 
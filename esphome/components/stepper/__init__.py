@@ -7,6 +7,8 @@ from esphome.core import CORE, coroutine, coroutine_with_priority
 
 IS_PLATFORM_COMPONENT = True
 
+CONF_STEPPERS = 'steppers'
+
 # pylint: disable=invalid-name
 stepper_ns = cg.esphome_ns.namespace('stepper')
 Stepper = stepper_ns.class_('Stepper')
@@ -14,6 +16,7 @@ Stepper = stepper_ns.class_('Stepper')
 SetTargetAction = stepper_ns.class_('SetTargetAction', automation.Action)
 ReportPositionAction = stepper_ns.class_('ReportPositionAction', automation.Action)
 SetSpeedAction = stepper_ns.class_('SetSpeedAction', automation.Action)
+MoveCoordinatedAction = stepper_ns.class_('MoveCoordinatedAction', automation.Action)
 
 
 def validate_acceleration(value):
@@ -118,6 +121,21 @@ def stepper_set_speed_to_code(config, action_id, template_arg, args):
     yield var
 
 
+@automation.register_action('stepper.move_coordinated', MoveCoordinatedAction, cv.Schema({
+    cv.Required(CONF_STEPPERS): cv.All(cv.ensure_list(cv.Schema({
+        cv.Required(CONF_ID): cv.use_id(Stepper),
+        cv.Required(CONF_TARGET): cv.templatable(cv.int_),
+    })), cv.Length(min=2)),
+}))
+def stepper_move_coordinated_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    for conf in config[CONF_STEPPERS]:
+        paren = yield cg.get_variable(conf[CONF_ID])
+        template_ = yield cg.templatable(conf[CONF_TARGET], args, cg.int32)
+        cg.add(var.add_stepper(paren, template_))
+    yield var
+
+
 @coroutine_with_priority(100.0)
 def to_code(config):
     cg.add_global(stepper_ns.using)
@@ -0,0 +1,189 @@
+#include "step_timer.h"
+#include "esphome/core/helpers.h"
+#include <algorithm>
+#include <cmath>
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace esphome {
+namespace stepper {
+
+static const uint8_t STEP_TIMER_MAX_CHANNELS = 8;
+/// 1.0 in the 0.32 fixed point format of the rates.
+static const float STEP_TIMER_RATE_SCALE = 4294967296.0f;
+
+static StepChannel *step_channels[STEP_TIMER_MAX_CHANNELS];  // NOLINT
+static uint8_t step_channel_count = 0;                        // NOLINT
+static hw_timer_t *step_timer = nullptr;                      // NOLINT
+static bool step_timer_enabled = false;                       // NOLINT
+static portMUX_TYPE step_timer_mux = portMUX_INITIALIZER_UNLOCKED;  // NOLINT
+
+void ICACHE_RAM_ATTR HOT StepTimer::step_(StepChannel *channel) {
+  channel->step_pin->digital_write(true);
+  channel->pulse_high = true;
+  channel->position += channel->direction;
+  channel->step_count++;
+  channel->done++;
+  channel->remaining--;
+
+  for (uint8_t i = 0; i < step_channel_count; i++) {
+    StepChannel *follower = step_channels[i];
+    if (follower->leader != channel)
+      continue;
+    if (follower->remaining != 0) {
+      follower->follow_error += follower->follow_steps;
+      if (follower->follow_error >= follower->leader_steps) {
+        follower->follow_error -= follower->leader_steps;
+        step_(follower);
+      }
+    }
+    // if the leader was planned again and stopped early, the follower finishes its move on its own
+    if (channel->remaining == 0)
+      follower->leader = nullptr;
+  }
+
+  if (channel->remaining == 0) {
+    channel->rate = 0;
+    channel->phase = 0;
+  }
+}
+
+void ICACHE_RAM_ATTR HOT StepTimer::isr_() {
+  portENTER_CRITICAL_ISR(&step_timer_mux);
+  // end the pulses of the last tick first, so that the pulses of followers stepped below last a full tick
+  for (uint8_t i = 0; i < step_channel_count; i++) {
+    StepChannel *channel = step_channels[i];
+    if (channel->pulse_high) {
+      channel->step_pin->digital_write(false);
+      channel->pulse_high = false;
+    }
+  }
+  for (uint8_t i = 0; i < step_channel_count; i++) {
+    StepChannel *channel = step_channels[i];
+    if (channel->remaining == 0 || channel->leader != nullptr)
+      continue;
+    if (channel->remaining <= channel->decel_steps) {
+      const uint32_t rate = channel->rate - channel->decel;
+      channel->rate = channel->rate > channel->min_rate + channel->decel ? rate : channel->min_rate;
+    } else if (channel->done < channel->accel_steps) {
+      channel->rate = std::min(channel->rate + channel->accel, channel->max_rate);
+    }
+    const uint32_t phase = channel->phase + channel->rate;
+    if (phase < channel->phase)
+      step_(channel);
+    channel->phase = phase;
+  }
+  portEXIT_CRITICAL_ISR(&step_timer_mux);
+}
+
+StepChannel *StepTimer::add_channel(ISRInternalGPIOPin *step_pin, ISRInternalGPIOPin *dir_pin) {
+  if (step_channel_count == STEP_TIMER_MAX_CHANNELS)
+    return nullptr;
+  if (step_timer == nullptr) {
+    // 80 Divider -> 1 count=1µs
+    step_timer = timerBegin(1, 80, true);
+    timerAttachInterrupt(step_timer, &StepTimer::isr_, true);
+    timerAlarmWrite(step_timer, INTERVAL, true);
+  }
+  auto *channel = new StepChannel();  // NOLINT(cppcoreguidelines-owning-memory)
+  channel->step_pin = step_pin;
+  channel->dir_pin = dir_pin;
+  portENTER_CRITICAL(&step_timer_mux);
+  step_channels[step_channel_count++] = channel;
+  portEXIT_CRITICAL(&step_timer_mux);
+  return channel;
+}
+
+void StepTimer::plan(StepChannel *channel, int32_t steps, float max_speed, float acceleration, float deceleration) {
+  const float tick = INTERVAL * 1e-6f;
+  const auto n = static_cast<uint32_t>(abs(steps));
+  const float v0 = get_speed(channel);
+  float v_max = std::min(max_speed, 1.0f / (2 * tick));
+  float acc_steps = std::max(0.0f, (v_max * v_max - v0 * v0) / (2 * acceleration));
+  float dec_steps = v_max * v_max / (2 * deceleration);
+  if (acc_steps + dec_steps > n) {
+    // too short to reach the max speed: accelerate up to the speed from which it can just stop in time
+    const float v_peak_sq = std::max(
+        v0 * v0, (2 * acceleration * deceleration * n + deceleration * v0 * v0) / (acceleration + deceleration));
+    v_max = sqrtf(v_peak_sq);
+    acc_steps = (v_peak_sq - v0 * v0) / (2 * acceleration);
+    dec_steps = n - acc_steps;
+  }
+  const auto max_rate = static_cast<uint32_t>(v_max * tick * STEP_TIMER_RATE_SCALE);
+  // the speed after the first step from standstill, so that the last steps of a move don't take forever
+  const auto min_rate = static_cast<uint32_t>(sqrtf(2 * deceleration) * tick * STEP_TIMER_RATE_SCALE);
+
+  if (n != 0)
+    channel->dir_pin->digital_write(steps > 0);
+  portENTER_CRITICAL(&step_timer_mux);
+  channel->leader = nullptr;
+  channel->direction = steps > 0 ? 1 : -1;
+  channel->remaining = n;
+  channel->done = 0;
+  channel->accel_steps = lroundf(acc_steps);
+  channel->decel_steps = ceilf(dec_steps);
+  channel->max_rate = std::max<uint32_t>(max_rate, 1);
+  channel->min_rate = std::min(std::max<uint32_t>(min_rate, 1), channel->max_rate);
+  channel->accel = std::max<uint32_t>(acceleration * tick * tick * STEP_TIMER_RATE_SCALE, 1);
+  channel->decel = std::max<uint32_t>(deceleration * tick * tick * STEP_TIMER_RATE_SCALE, 1);
+  if (n == 0)
+    channel->rate = 0;
+  portEXIT_CRITICAL(&step_timer_mux);
+  if (n != 0)
+    enable_();
+}
+
+void StepTimer::follow(StepChannel *channel, StepChannel *leader, int32_t steps, uint32_t leader_steps) {
+  const auto n = static_cast<uint32_t>(abs(steps));
+  if (n != 0)
+    channel->dir_pin->digital_write(steps > 0);
+  portENTER_CRITICAL(&step_timer_mux);
+  channel->direction = steps > 0 ? 1 : -1;
+  channel->remaining = n;
+  channel->rate = 0;
+  channel->phase = 0;
+  channel->follow_steps = n;
+  channel->leader_steps = leader_steps;
+  channel->follow_error = leader_steps / 2;
+  channel->leader = n != 0 ? leader : nullptr;
+  portEXIT_CRITICAL(&step_timer_mux);
+}
+
+void StepTimer::stop(StepChannel *channel, float deceleration) {
+  const float v = get_speed(channel);
+  const auto stop_steps = std::max<uint32_t>(ceilf(v * v / (2 * deceleration)), 1);
+  portENTER_CRITICAL(&step_timer_mux);
+  if (channel->remaining > stop_steps)
+    channel->remaining = stop_steps;
+  channel->decel_steps = channel->remaining;
+  portEXIT_CRITICAL(&step_timer_mux);
+}
+
+float StepTimer::get_speed(StepChannel *channel) {
+  if (channel->remaining == 0)
+    return 0.0f;
+  return channel->rate / STEP_TIMER_RATE_SCALE / (INTERVAL * 1e-6f);
+}
+
+void StepTimer::enable_() {
+  if (step_timer_enabled)
+    return;
+  step_timer_enabled = true;
+  timerAlarmEnable(step_timer);
+}
+
+void StepTimer::disable_if_idle() {
+  if (!step_timer_enabled)
+    return;
+  for (uint8_t i = 0; i < step_channel_count; i++) {
+    if (step_channels[i]->remaining != 0 || step_channels[i]->pulse_high)
+      return;
+  }
+  step_timer_enabled = false;
+  timerAlarmDisable(step_timer);
+}
+
+}  // namespace stepper
+}  // namespace esphome
+
+#endif
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "esphome/core/esphal.h"
+
+#ifdef ARDUINO_ARCH_ESP32
+
+namespace esphome {
+namespace stepper {
+
+/// The state of one axis, shared between the main loop and the step timer interrupt.
+struct StepChannel {
+  ISRInternalGPIOPin *step_pin;
+  ISRInternalGPIOPin *dir_pin;
+  /// Counted by the interrupt.
+  volatile int32_t position{0};
+  volatile uint32_t step_count{0};
+  /// The steps left in the current move, 0 while stopped.
+  volatile uint32_t remaining{0};
+  int8_t direction{1};
+  bool pulse_high{false};
+  /// The speed in steps per tick as 0.32 fixed point, and the phase it is accumulated into. A step is made every time
+  /// the phase overflows.
+  uint32_t rate{0};
+  uint32_t phase{0};
+  /// The trapezoidal profile of the move, precomputed by StepTimer::plan(): the rate increases by accel every tick
+  /// for the first accel_steps steps, stays at max_rate and decreases by decel every tick (down to min_rate) for the
+  /// last decel_steps steps.
+  uint32_t max_rate{0};
+  uint32_t min_rate{0};
+  uint32_t accel{0};
+  uint32_t decel{0};
+  uint32_t accel_steps{0};
+  uint32_t decel_steps{0};
+  uint32_t done{0};
+  /// In a coordinated move, the axis this one follows. It then makes follow_steps steps evenly spread over the
+  /// leader_steps steps of the leader (Bresenham) instead of following its own profile.
+  StepChannel *volatile leader{nullptr};
+  uint32_t follow_steps{0};
+  uint32_t leader_steps{0};
+  uint32_t follow_error{0};
+};
+
+/** Generates the step pulses of all timer-driven steppers from a single hardware timer interrupt.
+ *
+ * The interrupt runs every INTERVAL µs while an axis moves, so the step rate doesn't depend on the main loop and
+ * isn't disturbed by WiFi. The acceleration ramp is planned in the main loop, the interrupt only does integer
+ * additions. Uses hardware timer 1 of the ESP32 (the AC dimmer uses timer 0).
+ */
+class StepTimer {
+ public:
+  /// The tick of the interrupt in µs. A step pulse is high for one tick, so at most 1 / (2 * INTERVAL) steps/s.
+  static const uint32_t INTERVAL = 25;
+
+  static StepChannel *add_channel(ISRInternalGPIOPin *step_pin, ISRInternalGPIOPin *dir_pin);
+  /// Move the axis by steps, starting from its current speed. The axis must be stopped to change its direction.
+  static void plan(StepChannel *channel, int32_t steps, float max_speed, float acceleration, float deceleration);
+  /// Move the axis by steps, spread evenly over the leader_steps steps of the leader, which is planned afterwards.
+  static void follow(StepChannel *channel, StepChannel *leader, int32_t steps, uint32_t leader_steps);
+  /// Decelerate the axis to a stop as fast as its profile allows.
+  static void stop(StepChannel *channel, float deceleration);
+  /// The current speed of the axis in steps/s.
+  static float get_speed(StepChannel *channel);
+  /// Stop the interrupt while no axis moves.
+  static void disable_if_idle();
+
+ protected:
+  static void isr_();
+  static void step_(StepChannel *channel);
+  static void enable_();
+};
+
+}  // namespace stepper
+}  // namespace esphome
+
+#endif
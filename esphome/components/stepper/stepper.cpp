@@ -40,11 +40,109 @@ int32_t Stepper::should_step_() {
     int32_t mag = this->target_position > this->current_position ? 1 : -1;
     this->last_step_ = now;
     this->current_position += mag;
+    this->step_count_++;
     return mag;
   }
 
   return 0;
 }
 
+void Stepper::measure_step_rate_() {
+  const uint32_t now = millis();
+  const uint32_t dt = now - this->rate_window_start_;
+  if (dt < 1000)
+    return;
+  this->step_rate_ = (this->step_count_ - this->rate_window_steps_) * 1000.0f / dt;
+  this->rate_window_start_ = now;
+  this->rate_window_steps_ = this->step_count_;
+}
+
+void Stepper::report_position(int32_t steps) {
+  this->current_position = steps;
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->step_channel_ != nullptr)
+    this->step_channel_->position = steps;
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+bool Stepper::setup_step_timer_(ISRInternalGPIOPin *step_pin, ISRInternalGPIOPin *dir_pin) {
+  this->step_channel_ = StepTimer::add_channel(step_pin, dir_pin);
+  if (this->step_channel_ == nullptr)
+    return false;
+  this->step_channel_->position = this->current_position;
+  return true;
+}
+
+void Stepper::loop_step_timer_() {
+  StepChannel *channel = this->step_channel_;
+  this->current_position = channel->position;
+  this->step_count_ = channel->step_count;
+  this->current_speed_ = StepTimer::get_speed(channel);
+  this->measure_step_rate_();
+  if (channel->leader != nullptr)
+    // part of a coordinated move
+    return;
+
+  const int32_t pending = this->target_position - this->current_position;
+  if (channel->remaining == 0) {
+    this->planned_target_ = this->target_position;
+    this->replan_ = false;
+    if (pending != 0) {
+      StepTimer::plan(channel, pending, this->max_speed_, this->acceleration_, this->deceleration_);
+    } else {
+      StepTimer::disable_if_idle();
+    }
+    return;
+  }
+
+  if (this->target_position == this->planned_target_ && !this->replan_)
+    return;
+  this->planned_target_ = this->target_position;
+  this->replan_ = false;
+  if (pending != 0 && (pending > 0) == (channel->direction > 0)) {
+    StepTimer::plan(channel, pending, this->max_speed_, this->acceleration_, this->deceleration_);
+  } else {
+    // the move to a target behind the stepper is planned once it stopped
+    StepTimer::stop(channel, this->deceleration_);
+  }
+}
+#endif
+
+void Stepper::move_coordinated(const std::vector<Stepper *> &steppers) {
+#ifdef ARDUINO_ARCH_ESP32
+  Stepper *leader = nullptr;
+  uint32_t leader_steps = 0;
+  for (auto *stepper : steppers) {
+    StepChannel *channel = stepper->step_channel_;
+    if (channel == nullptr || channel->remaining != 0) {
+      ESP_LOGW(TAG, "Coordinated moves need steppers driven by the step timer that stand still!");
+      return;
+    }
+    const auto steps = static_cast<uint32_t>(abs(stepper->target_position - channel->position));
+    if (steps > leader_steps) {
+      leader = stepper;
+      leader_steps = steps;
+    }
+  }
+  if (leader == nullptr)
+    return;
+
+  // the followers have to be attached before the leader starts
+  for (auto *stepper : steppers) {
+    stepper->planned_target_ = stepper->target_position;
+    stepper->replan_ = false;
+    if (stepper == leader)
+      continue;
+    StepTimer::follow(stepper->step_channel_, leader->step_channel_,
+                      stepper->target_position - stepper->step_channel_->position, leader_steps);
+  }
+  StepTimer::plan(leader->step_channel_, leader->target_position - leader->step_channel_->position, leader->max_speed_,
+                  leader->acceleration_, leader->deceleration_);
+#else
+  ESP_LOGW(TAG, "Coordinated moves are only supported on the ESP32!");
+#endif
+}
+
 }  // namespace stepper
 }  // namespace esphome
@@ -2,7 +2,8 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
-#include "esphome/components/stepper/stepper.h"
+#include "esphome/components/stepper/step_timer.h"
+#include <vector>
 
 namespace esphome {
 namespace stepper {
@@ -15,12 +16,30 @@ namespace stepper {
 class Stepper {
  public:
   void set_target(int32_t steps) { this->target_position = steps; }
-  void report_position(int32_t steps) { this->current_position = steps; }
-  void set_acceleration(float acceleration) { this->acceleration_ = acceleration; }
-  void set_deceleration(float deceleration) { this->deceleration_ = deceleration; }
-  void set_max_speed(float max_speed) { this->max_speed_ = max_speed; }
+  void report_position(int32_t steps);
+  void set_acceleration(float acceleration) {
+    this->acceleration_ = acceleration;
+    this->replan_ = true;
+  }
+  void set_deceleration(float deceleration) {
+    this->deceleration_ = deceleration;
+    this->replan_ = true;
+  }
+  void set_max_speed(float max_speed) {
+    this->max_speed_ = max_speed;
+    this->replan_ = true;
+  }
   virtual void on_update_speed() {}
   bool has_reached_target() { return this->current_position == this->target_position; }
+  /// The steps per second made in the last second.
+  float get_step_rate() const { return this->step_rate_; }
+
+  /** Move the steppers to their targets so that they all start and arrive at the same time.
+   *
+   * The stepper with the longest move follows its profile, the others step in proportion to it. Only steppers that
+   * are driven by the step timer and stand still can move coordinated, otherwise they move independently.
+   */
+  static void move_coordinated(const std::vector<Stepper *> &steppers);
 
   int32_t current_position{0};
   int32_t target_position{0};
@@ -28,6 +47,16 @@ class Stepper {
  protected:
   void calculate_speed_(uint32_t now);
   int32_t should_step_();
+  /// Update the step rate from the number of steps made so far, call it in every loop.
+  void measure_step_rate_();
+#ifdef ARDUINO_ARCH_ESP32
+  /// Generate the steps from the step timer interrupt instead of should_step_(), returns false if it is full.
+  bool setup_step_timer_(ISRInternalGPIOPin *step_pin, ISRInternalGPIOPin *dir_pin);
+  /// Plan the moves to the target for the step timer, call it in every loop instead of should_step_().
+  void loop_step_timer_();
+
+  StepChannel *step_channel_{nullptr};
+#endif
 
   float acceleration_{1e6f};
   float deceleration_{1e6f};
@@ -35,6 +64,13 @@ class Stepper {
   float max_speed_{1e6f};
   uint32_t last_calculation_{0};
   uint32_t last_step_{0};
+  uint32_t step_count_{0};
+  float step_rate_{0.0f};
+  uint32_t rate_window_start_{0};
+  uint32_t rate_window_steps_{0};
+  /// The target the step timer moves to, and whether the profile changed since it was planned.
+  int32_t planned_target_{0};
+  bool replan_{false};
 };
 
 template<typename... Ts> class SetTargetAction : public Action<Ts...> {
@@ -61,6 +97,24 @@ template<typename... Ts> class ReportPositionAction : public Action<Ts...> {
   Stepper *parent_;
 };
 
+template<typename... Ts> class MoveCoordinatedAction : public Action<Ts...> {
+ public:
+  void add_stepper(Stepper *stepper, TemplatableValue<int32_t, Ts...> target) {
+    this->steppers_.push_back(stepper);
+    this->targets_.push_back(target);
+  }
+
+  void play(Ts... x) override {
+    for (size_t i = 0; i < this->steppers_.size(); i++)
+      this->steppers_[i]->set_target(this->targets_[i].value(x...));
+    Stepper::move_coordinated(this->steppers_);
+  }
+
+ protected:
+  std::vector<Stepper *> steppers_;
+  std::vector<TemplatableValue<int32_t, Ts...>> targets_;
+};
+
 template<typename... Ts> class SetSpeedAction : public Action<Ts...> {
  public:
   explicit SetSpeedAction(Stepper *parent) : parent_(parent) {}
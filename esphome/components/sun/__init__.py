@@ -8,7 +8,7 @@ CODEOWNERS = ['@OttoWinter']
 sun_ns = cg.esphome_ns.namespace('sun')
 
 Sun = sun_ns.class_('Sun')
-SunTrigger = sun_ns.class_('SunTrigger', cg.PollingComponent, automation.Trigger.template())
+SunTrigger = sun_ns.class_('SunTrigger', cg.Component, automation.Trigger.template())
 SunCondition = sun_ns.class_('SunCondition', automation.Condition)
 
 CONF_SUN_ID = 'sun_id'
@@ -19,6 +19,12 @@ static const double TAU = 6.283185307179586;
 static const double TO_RADIANS = PI / 180.0;
 static const double TO_DEGREES = 180.0 / PI;
 static const double EARTH_TILT = 23.44 * TO_RADIANS;
+static const double SECONDS_PER_DAY = 24.0 * 60.0 * 60.0;
+/// The time between the exact values of the cached elevation, in seconds.
+static const time_t ELEVATION_CACHE_INTERVAL = 60;
+/// Crossings this close to the last one the trigger fired for are the same crossing, in seconds.
+static const double SUN_TRIGGER_HOLDOFF = 60.0;
+static const uint32_t SUN_TRIGGER_RESCHEDULE_INTERVAL = 60 * 60 * 1000;
 
 optional<time::ESPTime> Sun::sunrise(double elevation) {
   auto time = this->time_->now();
@@ -41,10 +47,20 @@ optional<time::ESPTime> Sun::sunset(double elevation) {
   return time::ESPTime::from_epoch_local(epoch);
 }
 double Sun::elevation() {
-  auto time = this->current_sun_time_();
-  if (isnan(time))
-    return NAN;
-  return this->elevation_(time);
+  const time_t now = this->time_->timestamp_now();
+  if (this->elevation_start_ == 0 || now < this->elevation_start_ ||
+      now >= this->elevation_start_ + ELEVATION_CACHE_INTERVAL) {
+    auto time = this->calc_sun_time_(time::ESPTime::from_epoch_utc(now));
+    if (isnan(time)) {
+      this->elevation_start_ = 0;
+      return NAN;
+    }
+    this->elevation_start_ = now;
+    this->elevation_value_ = this->elevation_(time);
+    const double next = this->elevation_(time + ELEVATION_CACHE_INTERVAL / SECONDS_PER_DAY);
+    this->elevation_slope_ = (next - this->elevation_value_) / ELEVATION_CACHE_INTERVAL;
+  }
+  return this->elevation_value_ + this->elevation_slope_ * (now - this->elevation_start_);
 }
 double Sun::azimuth() {
   auto time = this->current_sun_time_();
@@ -52,6 +68,19 @@ double Sun::azimuth() {
     return NAN;
   return this->azimuth_(time);
 }
+double Sun::seconds_until(double elevation, bool rising, double after) {
+  const double now = this->current_sun_time_();
+  if (isnan(now))
+    return NAN;
+  const double earliest = now + after / SECONDS_PER_DAY;
+  const auto today = int32_t(floor(now));
+  for (int32_t day = today; day <= today + 2; day++) {
+    const double event = this->sun_time_for_elevation_(day, elevation, rising);
+    if (!isnan(event) && event > earliest)
+      return (event - now) * SECONDS_PER_DAY;
+  }
+  return NAN;
+}
 // like clamp, but with doubles
 double clampd(double val, double min, double max) {
   if (val < min)
@@ -172,5 +201,27 @@ double Sun::sun_time_for_elevation_(int32_t day_of_year, double elevation, bool
   return (lo + hi) / 2.0;
 }
 
+void SunTrigger::setup() {
+  this->parent_->get_time()->add_on_time_sync_callback([this]() { this->schedule_(); });
+  this->set_interval("reschedule", SUN_TRIGGER_RESCHEDULE_INTERVAL, [this]() { this->schedule_(); });
+  this->schedule_();
+}
+void SunTrigger::schedule_() {
+  // the clock only has a resolution of a second, so the timeout may fire just before the crossing
+  double after = 0.0;
+  if (this->last_trigger_.has_value() && millis() - *this->last_trigger_ < SUN_TRIGGER_HOLDOFF * 1000)
+    after = SUN_TRIGGER_HOLDOFF;
+  const double seconds = this->parent_->seconds_until(this->elevation_, this->sunrise_, after);
+  if (isnan(seconds)) {
+    this->cancel_timeout("crossing");
+    return;
+  }
+  this->set_timeout("crossing", uint32_t(seconds * 1000), [this]() {
+    this->last_trigger_ = millis();
+    this->trigger();
+    this->schedule_();
+  });
+}
+
 }  // namespace sun
 }  // namespace esphome
@@ -18,9 +18,22 @@ class Sun {
   optional<time::ESPTime> sunrise(double elevation = 0.0);
   optional<time::ESPTime> sunset(double elevation = 0.0);
 
+  /** The current elevation in degrees.
+   *
+   * Interpolated linearly between two exact values a minute apart, which is accurate to a few thousandths of a degree,
+   * so conditions checked in every loop don't compute the position of the sun each time.
+   */
   double elevation();
   double azimuth();
 
+  /** The seconds until the sun next crosses elevation, NAN if the time isn't valid or it doesn't within two days.
+   *
+   * @param elevation The elevation in degrees.
+   * @param rising true for a crossing in the morning, false for one in the evening.
+   * @param after Skip crossings sooner than this many seconds.
+   */
+  double seconds_until(double elevation, bool rising, double after = 0.0);
+
  protected:
   double current_sun_time_() { return this->calc_sun_time_(this->time_->utcnow()); }
 
@@ -82,37 +95,32 @@ class Sun {
   double latitude_;
   /// Longitude in degrees, range: -180 to 180.
   double longitude_;
+  /// UTC timestamp of the start of the cached elevation, 0 if there is none.
+  time_t elevation_start_{0};
+  double elevation_value_;
+  /// Change of the elevation in degrees per second.
+  double elevation_slope_;
 };
 
-class SunTrigger : public Trigger<>, public PollingComponent, public Parented<Sun> {
+/** Fires when the sun crosses an elevation.
+ *
+ * The time of the next crossing is computed once and waited for with a timeout, it is recomputed after the trigger
+ * fired, when the time is synchronized and every hour for crossings that were too far away.
+ */
+class SunTrigger : public Trigger<>, public Component, public Parented<Sun> {
  public:
-  SunTrigger() : PollingComponent(1000) {}
-
   void set_sunrise(bool sunrise) { sunrise_ = sunrise; }
   void set_elevation(double elevation) { elevation_ = elevation; }
 
-  void update() override {
-    double current = this->parent_->elevation();
-    if (isnan(current))
-      return;
-
-    bool crossed;
-    if (this->sunrise_) {
-      crossed = this->last_elevation_ <= this->elevation_ && this->elevation_ < current;
-    } else {
-      crossed = this->last_elevation_ >= this->elevation_ && this->elevation_ > current;
-    }
-
-    if (crossed && !isnan(this->last_elevation_)) {
-      this->trigger();
-    }
-    this->last_elevation_ = current;
-  }
+  void setup() override;
 
  protected:
+  void schedule_();
+
   bool sunrise_;
-  double last_elevation_{NAN};
   double elevation_;
+  /// millis() of the last time the trigger fired, to not fire twice for the same crossing.
+  optional<uint32_t> last_trigger_{};
 };
 
 template<typename... Ts> class SunCondition : public Condition<Ts...>, public Parented<Sun> {
@@ -10,6 +10,7 @@ CONF_KEY_COLUMNS = 'key_columns'
 CONF_SLEEP_TIME = 'sleep_time'
 CONF_SCAN_TIME = 'scan_time'
 CONF_DEBOUNCE_TIME = 'debounce_time'
+CONF_CACHE = 'cache'
 
 DEPENDENCIES = ['i2c']
 MULTI_CONF = True
@@ -36,6 +37,7 @@ KEYPAD_SCHEMA = cv.Schema({
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(SX1509Component),
     cv.Optional(CONF_KEYPAD): cv.Schema(KEYPAD_SCHEMA),
+    cv.Optional(CONF_CACHE, default=False): cv.boolean,
 }).extend(cv.COMPONENT_SCHEMA).extend(i2c.i2c_device_schema(0x3E))
 
 
@@ -43,6 +45,8 @@ def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     yield cg.register_component(var, config)
     yield i2c.register_i2c_device(var, config)
+    if config[CONF_CACHE]:
+        cg.add(var.set_cache(True))
     if CONF_KEYPAD in config:
         keypad = config[CONF_KEYPAD]
         cg.add(var.set_rows_cols(keypad[CONF_KEY_ROWS], keypad[CONF_KEY_COLUMNS]))
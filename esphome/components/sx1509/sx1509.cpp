@@ -26,6 +26,8 @@ void SX1509Component::setup() {
     return;
   }
   delayMicroseconds(500);
+  if (this->cache_)
+    this->read_byte_16(REG_DATA_B, &this->output_data_);
   if (this->has_keypad_)
     this->setup_keypad_();
 }
@@ -39,6 +41,7 @@ void SX1509Component::dump_config() {
 }
 
 void SX1509Component::loop() {
+  this->data_valid_ = false;
   if (this->has_keypad_) {
     uint16_t key_data = this->read_key_data();
     for (auto *binary_sensor : this->keypad_binary_sensors_)
@@ -47,6 +50,11 @@ void SX1509Component::loop() {
 }
 
 bool SX1509Component::digital_read(uint8_t pin) {
+  if (this->cache_) {
+    if (!this->data_valid_)
+      this->data_valid_ = this->read_byte_16(REG_DATA_B, &this->data_);
+    return (this->ddr_mask_ & this->data_ & (1 << pin)) != 0;
+  }
   if (this->ddr_mask_ & (1 << pin)) {
     uint16_t temp_reg_data;
     this->read_byte_16(REG_DATA_B, &temp_reg_data);
@@ -59,6 +67,20 @@ bool SX1509Component::digital_read(uint8_t pin) {
 void SX1509Component::digital_write(uint8_t pin, bool bit_value) {
   if ((~this->ddr_mask_) & (1 << pin)) {
     // If the pin is an output, write high/low
+    if (this->cache_) {
+      if (bit_value)
+        this->output_data_ |= (1 << pin);
+      else
+        this->output_data_ &= ~(1 << pin);
+      if (!this->output_dirty_) {
+        this->output_dirty_ = true;
+        this->defer([this]() {
+          this->output_dirty_ = false;
+          this->write_byte_16(REG_DATA_B, this->output_data_);
+        });
+      }
+      return;
+    }
     uint16_t temp_reg_data = 0;
     this->read_byte_16(REG_DATA_B, &temp_reg_data);
     if (bit_value)
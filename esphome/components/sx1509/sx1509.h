@@ -42,6 +42,7 @@ class SX1509Component : public Component, public i2c::I2CDevice {
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
   void loop() override;
+  bool is_loop_idle() override { return !this->has_keypad_ && !this->cache_; }
 
   bool digital_read(uint8_t pin);
   uint16_t read_key_data();
@@ -57,6 +58,12 @@ class SX1509Component : public Component, public i2c::I2CDevice {
   void set_sleep_time(uint16_t sleep_time) { this->sleep_time_ = sleep_time; };
   void set_scan_time(uint8_t scan_time) { this->scan_time_ = scan_time; };
   void set_debounce_time(uint8_t debounce_time = 1) { this->debounce_time_ = debounce_time; };
+  /** Read the inputs at most once per loop and combine the output writes of a loop into one.
+   *
+   * The inputs are read again in the first digital_read() after the next loop(). The outputs are written in the
+   * next scheduler call, from a copy of the data register instead of reading it back before every write.
+   */
+  void set_cache(bool cache) { this->cache_ = cache; }
   void register_keypad_binary_sensor(SX1509Processor *binary_sensor) {
     this->keypad_binary_sensors_.push_back(binary_sensor);
   };
@@ -74,6 +81,13 @@ class SX1509Component : public Component, public i2c::I2CDevice {
   uint8_t scan_time_ = 1;
   uint8_t debounce_time_ = 1;
   std::vector<SX1509Processor *> keypad_binary_sensors_;
+  bool cache_{false};
+  /// The data register as read last, valid until the next loop.
+  uint16_t data_ = 0x00;
+  bool data_valid_{false};
+  /// The data register as it should be written, only used with the cache.
+  uint16_t output_data_ = 0x00;
+  bool output_dirty_{false};
 
   void setup_keypad_();
   void set_debounce_config_(uint8_t config_value);
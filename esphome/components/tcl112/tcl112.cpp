@@ -32,6 +32,9 @@ const uint16_t TCL112_ONE_SPACE = 1100;
 const uint16_t TCL112_ZERO_SPACE = 350;
 const uint32_t TCL112_GAP = TCL112_HEADER_SPACE;
 
+static const climate_ir::IRFrameTiming TCL112_TIMING = {TCL112_HEADER_MARK, TCL112_HEADER_SPACE, TCL112_BIT_MARK,
+                                                        TCL112_ONE_SPACE,   TCL112_ZERO_SPACE,   false};
+
 void Tcl112Climate::transmit_state() {
   uint8_t remote_state[TCL112_STATE_LENGTH] = {0};
 
@@ -124,19 +127,8 @@ void Tcl112Climate::transmit_state() {
 
   data->set_carrier_frequency(38000);
 
-  // Header
-  data->mark(TCL112_HEADER_MARK);
-  data->space(TCL112_HEADER_SPACE);
-  // Data
-  for (uint8_t i : remote_state)
-    for (uint8_t j = 0; j < 8; j++) {
-      data->mark(TCL112_BIT_MARK);
-      bool bit = i & (1 << j);
-      data->space(bit ? TCL112_ONE_SPACE : TCL112_ZERO_SPACE);
-    }
-  // Footer
-  data->mark(TCL112_BIT_MARK);
-  data->space(TCL112_GAP);
+  data->reserve(climate_ir::ir_frame_length(TCL112_STATE_LENGTH));
+  climate_ir::encode_ir_frame(data, TCL112_TIMING, remote_state, TCL112_STATE_LENGTH, TCL112_GAP);
 
   transmit.perform();
 }
@@ -6,154 +6,141 @@ namespace teleinfo {
 
 static const char *TAG = "teleinfo";
 
-/* Helpers */
-static int get_field(char *dest, char *buf_start, char *buf_end, int sep) {
-  char *field_end;
-  int len;
+/* Each frame starts with 0x2 (STX), ends with 0x3 (ETX) and is composed of multiple groups starting by
+ * 0xa (Line Feed) and ending by 0xd ('\r').
+ *
+ * Historical mode: each group contains tag, data and a CRC separated by 0x20 (Space)
+ * 0xa | Tag | 0x20 | Data | 0x20 | CRC | 0xd
+ *     ^^^^^^^^^^^^^^^^^^^^
+ * Checksum is computed on the above in historical mode.
+ *
+ * Standard mode: each group contains tag, data and a CRC separated by 0x9 (\t), some groups have a timestamp
+ * between the tag and the data.
+ * 0xa | Tag | 0x9 | Data | 0x9 | CRC | 0xd
+ *     ^^^^^^^^^^^^^^^^^^^^^^^^^
+ * Checksum is computed on the above in standard mode.
+ */
+static const char TELEINFO_START_FRAME = 0x2;
+static const char TELEINFO_END_FRAME = 0x3;
+static const char TELEINFO_START_GROUP = 0xa;
+static const char TELEINFO_END_GROUP = 0xd;
+
+/// The FNV-1 hash of an empty string, the tag hash is continued from this with every byte of the tag.
+static const uint32_t TELEINFO_HASH_INIT = 2166136261UL;
+
+/// Read at most this many bytes per loop, so a fast meter can't block the other components.
+static const uint8_t TELEINFO_MAX_READ_PER_LOOP = 128;
 
-  field_end = static_cast<char *>(memchr(buf_start, sep, buf_end - buf_start));
-  if (!field_end)
-    return 0;
-  len = field_end - buf_start;
-  strncpy(dest, buf_start, len);
-  dest[len] = '\0';
-
-  return len;
-}
 /* TeleInfo methods */
-bool TeleInfo::check_crc_(const char *grp, const char *grp_end) {
-  int grp_len = grp_end - grp;
-  uint8_t raw_crc = grp[grp_len - 1];
-  uint8_t crc_tmp = 0;
-  int i;
-
-  for (i = 0; i < grp_len - checksum_area_end_; i++)
-    crc_tmp += grp[i];
+void TeleInfo::start_group_() {
+  this->group_len_ = 0;
+  this->tag_len_ = 0;
+  this->tag_hash_ = TELEINFO_HASH_INIT;
+  this->sum_ = 0;
+  this->sum_before_last_ = 0;
+  this->sum_before_second_last_ = 0;
+  this->state_ = GROUP;
+}
+void TeleInfo::receive_group_char_(char c) {
+  if (this->group_len_ >= MAX_GROUP_SIZE - 1) {
+    ESP_LOGW(TAG, "Group too long, dropping it.");
+    this->state_ = FRAME;
+    return;
+  }
+  this->group_[this->group_len_++] = c;
+  this->sum_before_second_last_ = this->sum_before_last_;
+  this->sum_before_last_ = this->sum_;
+  this->sum_ += c;
+
+  if (this->tag_len_ != 0)
+    return;
+  if (c == this->separator_) {
+    this->tag_len_ = this->group_len_ - 1;
+  } else {
+    this->tag_hash_ *= 16777619UL;
+    this->tag_hash_ ^= c;
+  }
+}
+void TeleInfo::end_group_() {
+  this->state_ = FRAME;
+
+  // the shortest group is a tag, the data and the checksum, all separated
+  const uint16_t len = this->group_len_;
+  if (this->tag_len_ == 0 || len < this->tag_len_ + 4) {
+    ESP_LOGE(TAG, "Invalid group.");
+    return;
+  }
+  if (this->tag_len_ >= MAX_TAG_SIZE) {
+    ESP_LOGE(TAG, "Invalid tag.");
+    return;
+  }
 
+  uint8_t raw_crc = this->group_[len - 1];
+  uint8_t crc_tmp = this->checksum_area_end_ == 2 ? this->sum_before_second_last_ : this->sum_before_last_;
   crc_tmp &= 0x3F;
   crc_tmp += 0x20;
   if (raw_crc != crc_tmp) {
     ESP_LOGE(TAG, "bad crc: got %d except %d", raw_crc, crc_tmp);
-    return false;
+    return;
   }
 
-  return true;
-}
-bool TeleInfo::read_chars_until_(bool drop, uint8_t c) {
-  uint8_t received;
-  int j = 0;
-
-  while (available() > 0 && j < 128) {
-    j++;
-    received = read();
-    if (received == c)
-      return true;
-    if (drop)
-      continue;
-    /*
-     * Internal buffer is full, switch to OFF mode.
-     * Data will be retrieved on next update.
-     */
-    if (buf_index_ >= (MAX_BUF_SIZE - 1)) {
-      ESP_LOGW(TAG, "Internal buffer full");
-      state_ = OFF;
-      return false;
-    }
-    buf_[buf_index_++] = received;
+  // the data is the last field before the checksum, after the timestamp if there's one
+  const uint16_t val_end = len - 2;
+  uint16_t val_start = val_end;
+  while (val_start > this->tag_len_ + 1 && this->group_[val_start - 1] != this->separator_)
+    val_start--;
+  if (val_start == val_end || val_end - val_start >= MAX_VAL_SIZE) {
+    ESP_LOGE(TAG, "Invalid Value");
+    return;
   }
 
-  return false;
+  this->group_[this->tag_len_] = '\0';
+  this->group_[val_end] = '\0';
+  this->publish_value_(this->group_, this->tag_hash_, this->group_ + val_start);
 }
 void TeleInfo::setup() { state_ = OFF; }
 void TeleInfo::update() {
-  if (state_ == OFF) {
-    buf_index_ = 0;
+  if (state_ == OFF)
     state_ = ON;
-  }
 }
 void TeleInfo::loop() {
-  switch (state_) {
-    case OFF:
-      break;
-    case ON:
-      /* Dequeue chars until start frame (0x2) */
-      if (read_chars_until_(true, 0x2))
-        state_ = START_FRAME_RECEIVED;
-      break;
-    case START_FRAME_RECEIVED:
-      /* Dequeue chars until end frame (0x3) */
-      if (read_chars_until_(false, 0x3))
-        state_ = END_FRAME_RECEIVED;
-      break;
-    case END_FRAME_RECEIVED:
-      char *buf_finger;
-      char *grp_end;
-      char *buf_end;
-      int field_len;
-
-      buf_finger = buf_;
-      buf_end = buf_ + buf_index_;
-
-      /* Each frame is composed of multiple groups starting by 0xa(Line Feed) and ending by
-       * 0xd ('\r').
-       *
-       * Historical mode: each group contains tag, data and a CRC separated by 0x20 (Space)
-       * 0xa | Tag | 0x20 | Data | 0x20 | CRC | 0xd
-       *     ^^^^^^^^^^^^^^^^^^^^
-       * Checksum is computed on the above in historical mode.
-       *
-       * Standard mode: each group contains tag, data and a CRC separated by 0x9 (\t)
-       * 0xa | Tag | 0x9 | Data | 0x9 | CRC | 0xd
-       *     ^^^^^^^^^^^^^^^^^^^^^^^^^
-       * Checksum is computed on the above in standard mode.
-       */
-      while ((buf_finger = static_cast<char *>(memchr(buf_finger, (int) 0xa, buf_index_ - 1))) &&
-             ((buf_finger - buf_) < buf_index_)) {
-        /* Point to the first char of the group after 0xa */
-        buf_finger += 1;
-
-        /* Group len */
-        grp_end = static_cast<char *>(memchr(buf_finger, 0xd, buf_end - buf_finger));
-        if (!grp_end) {
-          ESP_LOGE(TAG, "No group found");
-          break;
-        }
-
-        if (!check_crc_(buf_finger, grp_end))
-          break;
-
-        /* Get tag */
-        field_len = get_field(tag_, buf_finger, grp_end, separator_);
-        if (!field_len || field_len >= MAX_TAG_SIZE) {
-          ESP_LOGE(TAG, "Invalid tag.");
-          break;
-        }
-
-        /* Advance buf_finger to after the tag and the separator. */
-        buf_finger += field_len + 1;
-
-        /* Get value (after next separator) */
-        field_len = get_field(val_, buf_finger, grp_end, separator_);
-        if (!field_len || field_len >= MAX_VAL_SIZE) {
-          ESP_LOGE(TAG, "Invalid Value");
-          break;
+  for (uint8_t i = 0; this->state_ != OFF && i < TELEINFO_MAX_READ_PER_LOOP && this->available() > 0; i++) {
+    const char c = this->read();
+    switch (this->state_) {
+      case OFF:
+        break;
+      case ON:
+        /* Dequeue chars until start frame (0x2) */
+        if (c == TELEINFO_START_FRAME)
+          this->state_ = FRAME;
+        break;
+      case FRAME:
+      case GROUP:
+        if (c == TELEINFO_END_FRAME) {
+          /* A frame per update */
+          this->state_ = OFF;
+        } else if (c == TELEINFO_START_GROUP) {
+          this->start_group_();
+        } else if (this->state_ == GROUP) {
+          if (c == TELEINFO_END_GROUP)
+            this->end_group_();
+          else
+            this->receive_group_char_(c);
         }
-
-        /* Advance buf_finger to end of group */
-        buf_finger += field_len + 1 + 1 + 1;
-
-        publish_value_(std::string(tag_), std::string(val_));
-      }
-      state_ = OFF;
-      break;
+        break;
+    }
   }
 }
-void TeleInfo::publish_value_(std::string tag, std::string val) {
+void TeleInfo::publish_value_(const char *tag, uint32_t tag_hash, const char *val) {
   /* It will return 0 if tag is not a float. */
-  auto newval = parse_float(val);
-  for (auto element : teleinfo_sensors_)
-    if (tag == element->tag)
-      element->sensor->publish_state(*newval);
+  optional<float> newval;
+  for (auto element : teleinfo_sensors_) {
+    if (element->tag_hash != tag_hash || strcmp(element->tag, tag) != 0)
+      continue;
+    if (!newval.has_value())
+      newval = parse_float(val);
+    element->sensor->publish_state(*newval);
+  }
 }
 void TeleInfo::dump_config() {
   ESP_LOGCONFIG(TAG, "TeleInfo:");
@@ -176,7 +163,7 @@ TeleInfo::TeleInfo(bool historical_mode) {
   }
 }
 void TeleInfo::register_teleinfo_sensor(const char *tag, sensor::Sensor *sensor) {
-  const TeleinfoSensorElement *teleinfo_sensor = new TeleinfoSensorElement{tag, sensor};
+  const TeleinfoSensorElement *teleinfo_sensor = new TeleinfoSensorElement{tag, fnv1_hash(tag, strlen(tag)), sensor};
   teleinfo_sensors_.push_back(teleinfo_sensor);
 }
 
@@ -6,19 +6,24 @@
 
 namespace esphome {
 namespace teleinfo {
-/*
- * 198 bytes should be enough to contain a full session in historical mode with
- * three phases. But go with 1024 just to be sure.
- */
 static const uint8_t MAX_TAG_SIZE = 64;
 static const uint16_t MAX_VAL_SIZE = 256;
-static const uint16_t MAX_BUF_SIZE = 1024;
+/// A group is the tag, the value and the checksum with their separators, or in standard mode also a timestamp.
+static const uint16_t MAX_GROUP_SIZE = MAX_TAG_SIZE + MAX_VAL_SIZE + 16;
 
 struct TeleinfoSensorElement {
   const char *tag;
+  /// The FNV-1 hash of the tag, compared first so most received groups are rejected without comparing strings.
+  uint32_t tag_hash;
   sensor::Sensor *sensor;
 };
 
+/** Reads the frames of french Linky and older electricity meters.
+ *
+ * The frames are parsed while the bytes arrive: the checksum and the hash of the tag of each group are accumulated
+ * byte by byte, and a group is published as soon as its end is received, so only the current group is buffered
+ * instead of the whole frame.
+ */
 class TeleInfo : public PollingComponent, public uart::UARTDevice {
  public:
   TeleInfo(bool historical_mode);
@@ -33,19 +38,26 @@ class TeleInfo : public PollingComponent, public uart::UARTDevice {
   uint32_t baud_rate_;
   int checksum_area_end_;
   int separator_;
-  char buf_[MAX_BUF_SIZE];
-  uint32_t buf_index_{0};
-  char tag_[MAX_TAG_SIZE];
-  char val_[MAX_VAL_SIZE];
+  /// The current group, without its starting line feed.
+  char group_[MAX_GROUP_SIZE];
+  uint16_t group_len_{0};
+  /// The length of the tag, 0 until its separator was received.
+  uint16_t tag_len_{0};
+  uint32_t tag_hash_{0};
+  /// The sums of the group up to the last and the second to last byte, either ends the checksum area.
+  uint8_t sum_{0};
+  uint8_t sum_before_last_{0};
+  uint8_t sum_before_second_last_{0};
   enum State {
     OFF,
     ON,
-    START_FRAME_RECEIVED,
-    END_FRAME_RECEIVED,
+    FRAME,
+    GROUP,
   } state_{OFF};
-  bool read_chars_until_(bool drop, uint8_t c);
-  bool check_crc_(const char *grp, const char *grp_end);
-  void publish_value_(std::string tag, std::string val);
+  void start_group_();
+  void receive_group_char_(char c);
+  void end_group_();
+  void publish_value_(const char *tag, uint32_t tag_hash, const char *val);
 };
 }  // namespace teleinfo
 }  // namespace esphome
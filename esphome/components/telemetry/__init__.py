@@ -0,0 +1,59 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, time, http_request, mqtt
+from esphome.const import CONF_ID, CONF_SENSORS, CONF_TIME_ID, CONF_URL, CONF_TOPIC, CONF_MQTT_ID, \
+    CONF_BUFFER_SIZE, CONF_MQTT
+
+CONF_BATCH_SIZE = 'batch_size'
+CONF_UPLOAD_INTERVAL = 'upload_interval'
+CONF_HTTP_REQUEST = 'http_request'
+CONF_HTTP_REQUEST_ID = 'http_request_id'
+
+telemetry_ns = cg.esphome_ns.namespace('telemetry')
+TelemetryComponent = telemetry_ns.class_('TelemetryComponent', cg.Component)
+
+
+def validate_batch_size(config):
+    if config[CONF_BATCH_SIZE] > config[CONF_BUFFER_SIZE]:
+        raise cv.Invalid("batch_size can't be larger than buffer_size")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(cv.Schema({
+    cv.GenerateID(): cv.declare_id(TelemetryComponent),
+    cv.Required(CONF_SENSORS): cv.All(cv.ensure_list(cv.use_id(sensor.Sensor)), cv.Length(min=1, max=256)),
+    cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
+    cv.Optional(CONF_BUFFER_SIZE, default=256): cv.int_range(min=1, max=8192),
+    cv.Optional(CONF_BATCH_SIZE, default=64): cv.int_range(min=1, max=8192),
+    cv.Optional(CONF_UPLOAD_INTERVAL, default='60s'): cv.positive_not_null_time_period,
+    cv.Exclusive(CONF_HTTP_REQUEST, 'transport'): cv.Schema({
+        cv.GenerateID(CONF_HTTP_REQUEST_ID): cv.use_id(http_request.HttpRequestComponent),
+        cv.Required(CONF_URL): http_request.validate_url,
+    }),
+    cv.Exclusive(CONF_MQTT, 'transport'): cv.Schema({
+        cv.GenerateID(CONF_MQTT_ID): cv.use_id(mqtt.MQTTClientComponent),
+        cv.Required(CONF_TOPIC): cv.publish_topic,
+    }),
+}).extend(cv.COMPONENT_SCHEMA), cv.has_exactly_one_key(CONF_HTTP_REQUEST, CONF_MQTT), validate_batch_size)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    for sensor_id in config[CONF_SENSORS]:
+        sens = yield cg.get_variable(sensor_id)
+        cg.add(var.add_sensor(sens))
+    cg.add(var.set_buffer_size(config[CONF_BUFFER_SIZE]))
+    cg.add(var.set_batch_size(config[CONF_BATCH_SIZE]))
+    cg.add(var.set_upload_interval(config[CONF_UPLOAD_INTERVAL].total_milliseconds))
+    if CONF_TIME_ID in config:
+        time_ = yield cg.get_variable(config[CONF_TIME_ID])
+        cg.add(var.set_time(time_))
+    if CONF_HTTP_REQUEST in config:
+        conf = config[CONF_HTTP_REQUEST]
+        http = yield cg.get_variable(conf[CONF_HTTP_REQUEST_ID])
+        cg.add(var.set_http_request(http, conf[CONF_URL]))
+    if CONF_MQTT in config:
+        yield cg.get_variable(config[CONF_MQTT][CONF_MQTT_ID])
+        cg.add(var.set_mqtt_topic(config[CONF_MQTT][CONF_TOPIC]))
@@ -0,0 +1,171 @@
+#include "telemetry.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace telemetry {
+
+static const char *TAG = "telemetry";
+
+static const uint8_t TELEMETRY_FORMAT_VERSION = 1;
+static const uint8_t TELEMETRY_FLAG_UPTIME = 0x80;
+
+static void append_uint(std::string &out, uint32_t value, uint8_t bytes) {
+  for (uint8_t i = 0; i < bytes; i++)
+    out.push_back(char(value >> (i * 8)));
+}
+static void append_varint(std::string &out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(char(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(char(value));
+}
+
+void TelemetryComponent::add_sensor(sensor::Sensor *sensor) {
+  const uint8_t index = this->sensors_.size();
+  this->sensors_.push_back(sensor);
+  sensor->add_on_state_callback([this, index](float state) { this->add_sample_(index, state); });
+}
+
+void TelemetryComponent::setup() {
+  this->samples_.resize(this->buffer_size_);
+  this->set_interval("upload", this->upload_interval_, [this]() { this->upload(); });
+}
+
+void TelemetryComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "Telemetry:");
+  ESP_LOGCONFIG(TAG, "  Buffer Size: %u samples", this->buffer_size_);
+  ESP_LOGCONFIG(TAG, "  Batch Size: %u samples", this->batch_size_);
+  ESP_LOGCONFIG(TAG, "  Upload Interval: %u ms", this->upload_interval_);
+#ifdef USE_HTTP_REQUEST
+  if (this->http_request_ != nullptr)
+    ESP_LOGCONFIG(TAG, "  URL: %s", this->url_.c_str());
+#endif
+#ifdef USE_MQTT
+  if (!this->topic_.empty())
+    ESP_LOGCONFIG(TAG, "  Topic: %s", this->topic_.c_str());
+#endif
+  for (size_t i = 0; i < this->sensors_.size(); i++)
+    ESP_LOGCONFIG(TAG, "  Sensor %u: '%s'", i, this->sensors_[i]->get_name().c_str());
+}
+
+uint32_t TelemetryComponent::uptime_() {
+  const uint32_t now = millis();
+  if (now < this->last_millis_)
+    this->millis_major_++;
+  this->last_millis_ = now;
+  return ((uint64_t(this->millis_major_) << 32) | now) / 1000;
+}
+
+void TelemetryComponent::add_sample_(uint8_t sensor, float value) {
+  if (this->count_ == this->samples_.size()) {
+    // drop the oldest sample, if it is being uploaded the batch gets smaller
+    this->tail_ = (this->tail_ + 1) % this->samples_.size();
+    this->count_--;
+    this->dropped_count_++;
+    if (this->uploading_ > 0)
+      this->uploading_--;
+  }
+  Sample &sample = this->samples_[(this->tail_ + this->count_) % this->samples_.size()];
+  sample.uptime = this->uptime_();
+  sample.value = value;
+  sample.sensor = sensor;
+  this->count_++;
+
+  if (this->count_ >= this->batch_size_ && this->uploading_ == 0)
+    this->defer("upload", [this]() { this->upload(); });
+}
+
+std::string TelemetryComponent::encode_batch_(size_t count) {
+  // samples taken before the time was synchronized are dated back from their uptime
+  uint8_t flags = TELEMETRY_FLAG_UPTIME;
+  int64_t offset = 0;
+#ifdef USE_TIME
+  if (this->time_ != nullptr) {
+    auto now = this->time_->utcnow();
+    if (now.is_valid()) {
+      flags = 0;
+      offset = int64_t(now.timestamp) - this->uptime_();
+    }
+  }
+#endif
+
+  std::string out;
+  // the largest varint has 5 bytes, most deltas take one
+  out.reserve(7 + count * 6);
+  out.push_back(char(TELEMETRY_FORMAT_VERSION | flags));
+  const Sample &first = this->samples_[this->tail_];
+  append_uint(out, first.uptime + offset, 4);
+  append_uint(out, count, 2);
+  uint32_t last_uptime = first.uptime;
+  for (size_t i = 0; i < count; i++) {
+    const Sample &sample = this->samples_[(this->tail_ + i) % this->samples_.size()];
+    out.push_back(char(sample.sensor));
+    append_varint(out, sample.uptime - last_uptime);
+    last_uptime = sample.uptime;
+    uint32_t raw;
+    memcpy(&raw, &sample.value, sizeof(raw));
+    append_uint(out, raw, 4);
+  }
+  return out;
+}
+
+void TelemetryComponent::upload() {
+  if (this->uploading_ != 0 || this->count_ == 0)
+    return;
+
+  const size_t count = std::min<size_t>(this->count_, this->batch_size_);
+  const std::string payload = this->encode_batch_(count);
+  this->uploading_ = count;
+
+#ifdef USE_HTTP_REQUEST
+  if (this->http_request_ != nullptr) {
+    ESP_LOGD(TAG, "Uploading %u samples (%u bytes) to %s", count, payload.size(), this->url_.c_str());
+    this->http_request_->set_url(this->url_);
+    this->http_request_->set_method("POST");
+    this->http_request_->set_body(payload);
+    this->http_request_->set_headers({{"Content-Type", "application/octet-stream"}});
+    this->http_request_->set_response_callback(
+        [this](int status_code) { this->on_upload_done_(status_code >= 200 && status_code < 300); });
+#ifdef ARDUINO_ARCH_ESP32
+    this->http_request_->send_async();
+#else
+    this->http_request_->send();
+    this->http_request_->close();
+#endif
+    return;
+  }
+#endif
+#ifdef USE_MQTT
+  if (!this->topic_.empty()) {
+    ESP_LOGD(TAG, "Publishing %u samples (%u bytes) to %s", count, payload.size(), this->topic_.c_str());
+    const bool success = global_mqtt_client != nullptr && global_mqtt_client->is_connected() &&
+                         global_mqtt_client->publish(this->topic_, payload.data(), payload.size(), 1);
+    this->on_upload_done_(success);
+    return;
+  }
+#endif
+  this->uploading_ = 0;
+}
+
+void TelemetryComponent::on_upload_done_(bool success) {
+  if (!success) {
+    // the samples stay buffered for the next attempt
+    ESP_LOGW(TAG, "Uploading %u samples failed, %u buffered", this->uploading_, this->count_);
+    this->uploading_ = 0;
+    this->status_set_warning();
+    return;
+  }
+
+  this->tail_ = (this->tail_ + this->uploading_) % this->samples_.size();
+  this->count_ -= this->uploading_;
+  this->uploading_ = 0;
+  this->status_clear_warning();
+  if (this->count_ >= this->batch_size_)
+    this->defer("upload", [this]() { this->upload(); });
+}
+
+}  // namespace telemetry
+}  // namespace esphome
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/components/sensor/sensor.h"
+#include <vector>
+
+#ifdef USE_TIME
+#include "esphome/components/time/real_time_clock.h"
+#endif
+#ifdef USE_HTTP_REQUEST
+#include "esphome/components/http_request/http_request.h"
+#endif
+#ifdef USE_MQTT
+#include "esphome/components/mqtt/mqtt_client.h"
+#endif
+
+namespace esphome {
+namespace telemetry {
+
+/** Buffers the states of sensors and uploads them in batches.
+ *
+ * The samples are kept in a ring buffer and only removed once the upload of the batch holding them succeeded, so
+ * nothing is lost while the connection is down. When the buffer is full the oldest samples are dropped.
+ *
+ * A batch is one binary payload, all numbers little endian:
+ * - uint8: format version (1), bit 7 set if the timestamps are seconds of uptime because the time isn't known
+ * - uint32: timestamp of the first sample
+ * - uint16: number of samples
+ * - for each sample: uint8 index of the sensor in the configuration, varint (7 bits per byte, least significant
+ *   first) seconds since the previous sample, float32 state
+ */
+class TelemetryComponent : public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_CONNECTION; }
+
+  void add_sensor(sensor::Sensor *sensor);
+  void set_buffer_size(uint16_t buffer_size) { this->buffer_size_ = buffer_size; }
+  void set_batch_size(uint16_t batch_size) { this->batch_size_ = batch_size; }
+  void set_upload_interval(uint32_t upload_interval) { this->upload_interval_ = upload_interval; }
+#ifdef USE_TIME
+  void set_time(time::RealTimeClock *time) { this->time_ = time; }
+#endif
+#ifdef USE_HTTP_REQUEST
+  void set_http_request(http_request::HttpRequestComponent *http_request, const std::string &url) {
+    this->http_request_ = http_request;
+    this->url_ = url;
+  }
+#endif
+#ifdef USE_MQTT
+  void set_mqtt_topic(const std::string &topic) { this->topic_ = topic; }
+#endif
+
+  /// Upload the next batch now, if there are samples and no upload is running.
+  void upload();
+
+  size_t get_buffered_count() const { return this->count_; }
+  uint32_t get_dropped_count() const { return this->dropped_count_; }
+
+ protected:
+  struct Sample {
+    uint32_t uptime;
+    float value;
+    uint8_t sensor;
+  };
+
+  void add_sample_(uint8_t sensor, float value);
+  /// Encode the oldest samples into a batch.
+  std::string encode_batch_(size_t count);
+  void on_upload_done_(bool success);
+  /// Seconds since boot, also past the millis() overflow.
+  uint32_t uptime_();
+
+  std::vector<sensor::Sensor *> sensors_;
+  std::vector<Sample> samples_;
+  /// Index of the oldest sample.
+  size_t tail_{0};
+  size_t count_{0};
+  /// The number of the oldest samples in the batch being uploaded.
+  size_t uploading_{0};
+  uint32_t dropped_count_{0};
+  uint16_t buffer_size_{256};
+  uint16_t batch_size_{64};
+  uint32_t upload_interval_{60000};
+  uint32_t last_millis_{0};
+  uint32_t millis_major_{0};
+#ifdef USE_TIME
+  time::RealTimeClock *time_{nullptr};
+#endif
+#ifdef USE_HTTP_REQUEST
+  http_request::HttpRequestComponent *http_request_{nullptr};
+  std::string url_;
+#endif
+#ifdef USE_MQTT
+  std::string topic_;
+#endif
+};
+
+}  // namespace telemetry
+}  // namespace esphome
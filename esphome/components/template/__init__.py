@@ -1,3 +1,56 @@
 import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import binary_sensor, sensor, text_sensor
+from esphome.const import CONF_ID, CONF_LAMBDA, CONF_UPDATE_INTERVAL
+from esphome.core import EsphomeError, coroutine
 
 template_ns = cg.esphome_ns.namespace('template_')
+
+CONF_DEPENDS_ON = 'depends_on'
+
+# Templates that read entities with id(x).state extend their schema with this. Without depends_on the
+# dependencies are detected from the lambda, an empty list keeps the template polling.
+DEPENDS_ON_SCHEMA = cv.Schema({
+    cv.Optional(CONF_DEPENDS_ON): cv.ensure_list(cv.use_id(cg.Nameable)),
+})
+
+
+def _is_dependency_type(type_):
+    return any(type_.inherits_from(base) for base in
+               (sensor.Sensor, binary_sensor.BinarySensor, text_sensor.TextSensor))
+
+
+@coroutine
+def register_dependencies(var, config):
+    """Evaluate the template whenever one of its dependencies publishes a state.
+
+    Polling templates then use update_interval as the maximum time between two evaluations. Lambdas that also read
+    something else than sensors, binary sensors and text sensors, like globals, aren't detected and keep polling.
+    """
+    explicit = CONF_DEPENDS_ON in config
+    if explicit:
+        ids = config[CONF_DEPENDS_ON]
+    elif CONF_LAMBDA in config:
+        ids = config[CONF_LAMBDA].requires_ids
+    else:
+        ids = []
+
+    dependencies = []
+    for id_ in ids:
+        full_id, dep = yield cg.get_variable_with_full_id(id_)
+        if full_id == config[CONF_ID] or any(full_id == other for other, _ in dependencies):
+            continue
+        if not _is_dependency_type(full_id.type):
+            if explicit:
+                raise EsphomeError(u"{} can't be a template dependency, only sensors, binary sensors and "
+                                   u"text sensors can".format(full_id))
+            return
+        dependencies.append((full_id, dep))
+    if not dependencies:
+        return
+
+    for _, dep in dependencies:
+        cg.add(var.add_dependency(dep))
+    if CONF_UPDATE_INTERVAL in config:
+        cg.add(var.set_max_interval(config[CONF_UPDATE_INTERVAL]))
+        cg.add(var.set_update_interval(4294967295))
@@ -3,7 +3,7 @@ import esphome.config_validation as cv
 from esphome import automation
 from esphome.components import binary_sensor
 from esphome.const import CONF_ID, CONF_LAMBDA, CONF_STATE
-from .. import template_ns
+from .. import DEPENDS_ON_SCHEMA, register_dependencies, template_ns
 
 TemplateBinarySensor = template_ns.class_('TemplateBinarySensor', binary_sensor.BinarySensor,
                                           cg.Component)
@@ -11,7 +11,7 @@ TemplateBinarySensor = template_ns.class_('TemplateBinarySensor', binary_sensor.
 CONFIG_SCHEMA = binary_sensor.BINARY_SENSOR_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(TemplateBinarySensor),
     cv.Optional(CONF_LAMBDA): cv.returning_lambda,
-}).extend(cv.COMPONENT_SCHEMA)
+}).extend(DEPENDS_ON_SCHEMA).extend(cv.COMPONENT_SCHEMA)
 
 
 def to_code(config):
@@ -23,6 +23,7 @@ def to_code(config):
         template_ = yield cg.process_lambda(config[CONF_LAMBDA], [],
                                             return_type=cg.optional.template(bool))
         cg.add(var.set_template(template_))
+    yield register_dependencies(var, config)
 
 
 @automation.register_action('binary_sensor.template.publish',
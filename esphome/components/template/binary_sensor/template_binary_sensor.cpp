@@ -6,7 +6,19 @@ namespace template_ {
 
 static const char *TAG = "template.binary_sensor";
 
+void TemplateBinarySensor::setup() {
+  if (this->has_dependencies_)
+    this->evaluate_();
+}
 void TemplateBinarySensor::loop() {
+  // without dependencies the lambda has to be polled in every loop iteration
+  if (!this->has_dependencies_)
+    this->evaluate_();
+}
+void TemplateBinarySensor::schedule_evaluation_() {
+  this->defer("evaluate", [this]() { this->evaluate_(); });
+}
+void TemplateBinarySensor::evaluate_() {
   if (!this->f_.has_value())
     return;
 
@@ -15,7 +27,11 @@ void TemplateBinarySensor::loop() {
     this->publish_state(*s);
   }
 }
-void TemplateBinarySensor::dump_config() { LOG_BINARY_SENSOR("", "Template Binary Sensor", this); }
+void TemplateBinarySensor::dump_config() {
+  LOG_BINARY_SENSOR("", "Template Binary Sensor", this);
+  if (this->has_dependencies_)
+    ESP_LOGCONFIG(TAG, "  Evaluated on dependency updates");
+}
 
 }  // namespace template_
 }  // namespace esphome
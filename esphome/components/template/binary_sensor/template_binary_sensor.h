@@ -2,20 +2,25 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/template/template_dependencies.h"
 
 namespace esphome {
 namespace template_ {
 
-class TemplateBinarySensor : public Component, public binary_sensor::BinarySensor {
+class TemplateBinarySensor : public Component, public binary_sensor::BinarySensor, public TemplateDependencies {
  public:
   void set_template(std::function<optional<bool>()> &&f) { this->f_ = f; }
 
+  void setup() override;
   void loop() override;
   void dump_config() override;
 
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
  protected:
+  void schedule_evaluation_() override;
+  void evaluate_();
+
   optional<std::function<optional<bool>()>> f_{};
 };
 
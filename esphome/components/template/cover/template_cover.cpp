@@ -58,8 +58,13 @@ void TemplateCover::loop() {
     }
   }
 
-  if (changed)
-    this->publish_state();
+  const uint32_t now = millis();
+  if (changed) {
+    // throttled while moving, saved once stopped
+    this->motion_.publish(this, now);
+  } else {
+    this->motion_.loop(this, now);
+  }
 }
 void TemplateCover::set_optimistic(bool optimistic) { this->optimistic_ = optimistic; }
 void TemplateCover::set_assumed_state(bool assumed_state) { this->assumed_state_ = assumed_state; }
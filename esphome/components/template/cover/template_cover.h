@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/cover/cover.h"
+#include "esphome/components/cover/cover_motion.h"
 
 namespace esphome {
 namespace template_ {
@@ -29,6 +30,10 @@ class TemplateCover : public cover::Cover, public Component {
   void set_has_position(bool has_position);
   void set_has_tilt(bool has_tilt);
   void set_restore_mode(TemplateCoverRestoreMode restore_mode) { restore_mode_ = restore_mode; }
+  /// Publish the changes of the lambdas at most this often while the current operation isn't idle.
+  void set_min_publish_interval(uint32_t min_publish_interval) {
+    this->motion_.set_min_publish_interval(min_publish_interval);
+  }
 
   void setup() override;
   void loop() override;
@@ -54,6 +59,8 @@ class TemplateCover : public cover::Cover, public Component {
   bool has_position_{false};
   Trigger<float> *tilt_trigger_;
   bool has_tilt_{false};
+  /// Only used for publishing, the position comes from the lambda.
+  cover::CoverMotion motion_;
 };
 
 }  // namespace template_
@@ -3,14 +3,14 @@ import esphome.config_validation as cv
 from esphome import automation
 from esphome.components import sensor
 from esphome.const import CONF_ID, CONF_LAMBDA, CONF_STATE, UNIT_EMPTY, ICON_EMPTY
-from .. import template_ns
+from .. import DEPENDS_ON_SCHEMA, register_dependencies, template_ns
 
 TemplateSensor = template_ns.class_('TemplateSensor', sensor.Sensor, cg.PollingComponent)
 
 CONFIG_SCHEMA = sensor.sensor_schema(UNIT_EMPTY, ICON_EMPTY, 1).extend({
     cv.GenerateID(): cv.declare_id(TemplateSensor),
     cv.Optional(CONF_LAMBDA): cv.returning_lambda,
-}).extend(cv.polling_component_schema('60s'))
+}).extend(DEPENDS_ON_SCHEMA).extend(cv.polling_component_schema('60s'))
 
 
 def to_code(config):
@@ -22,6 +22,7 @@ def to_code(config):
         template_ = yield cg.process_lambda(config[CONF_LAMBDA], [],
                                             return_type=cg.optional.template(float))
         cg.add(var.set_template(template_))
+    yield register_dependencies(var, config)
 
 
 @automation.register_action('sensor.template.publish', sensor.SensorPublishAction,
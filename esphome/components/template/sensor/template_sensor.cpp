@@ -6,7 +6,14 @@ namespace template_ {
 
 static const char *TAG = "template.sensor";
 
+void TemplateSensor::setup() {
+  // with dependencies the update interval is never, the first evaluation arms the max interval
+  if (this->has_dependencies_)
+    this->update();
+}
 void TemplateSensor::update() {
+  if (this->has_dependencies_)
+    this->set_timeout("max_interval", this->max_interval_, [this]() { this->update(); });
   if (!this->f_.has_value())
     return;
 
@@ -15,11 +22,18 @@ void TemplateSensor::update() {
     this->publish_state(*val);
   }
 }
+void TemplateSensor::schedule_evaluation_() {
+  this->defer("evaluate", [this]() { this->update(); });
+}
 float TemplateSensor::get_setup_priority() const { return setup_priority::HARDWARE; }
 void TemplateSensor::set_template(std::function<optional<float>()> &&f) { this->f_ = f; }
 void TemplateSensor::dump_config() {
   LOG_SENSOR("", "Template Sensor", this);
-  LOG_UPDATE_INTERVAL(this);
+  if (this->has_dependencies_) {
+    ESP_LOGCONFIG(TAG, "  Evaluated on dependency updates, max interval: %ums", this->max_interval_);
+  } else {
+    LOG_UPDATE_INTERVAL(this);
+  }
 }
 
 }  // namespace template_
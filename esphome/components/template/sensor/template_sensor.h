@@ -2,14 +2,16 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
+#include "esphome/components/template/template_dependencies.h"
 
 namespace esphome {
 namespace template_ {
 
-class TemplateSensor : public sensor::Sensor, public PollingComponent {
+class TemplateSensor : public sensor::Sensor, public PollingComponent, public TemplateDependencies {
  public:
   void set_template(std::function<optional<float>()> &&f);
 
+  void setup() override;
   void update() override;
 
   void dump_config() override;
@@ -17,6 +19,8 @@ class TemplateSensor : public sensor::Sensor, public PollingComponent {
   float get_setup_priority() const override;
 
  protected:
+  void schedule_evaluation_() override;
+
   optional<std::function<optional<float>()>> f_;
 };
 
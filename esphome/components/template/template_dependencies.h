@@ -0,0 +1,56 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
+#ifdef USE_BINARY_SENSOR
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#endif
+#ifdef USE_TEXT_SENSOR
+#include "esphome/components/text_sensor/text_sensor.h"
+#endif
+
+namespace esphome {
+namespace template_ {
+
+/** Re-evaluates a template when one of the entities its lambda reads publishes, instead of polling it.
+ *
+ * Codegen registers the dependencies before setup(). The template then only evaluates its lambda once at setup, once
+ * after each loop iteration in which dependencies published (however many did), and when the max interval passed
+ * without an evaluation.
+ */
+class TemplateDependencies {
+ public:
+#ifdef USE_SENSOR
+  void add_dependency(sensor::Sensor *dependency) {
+    this->has_dependencies_ = true;
+    dependency->add_on_state_callback([this](float) { this->schedule_evaluation_(); });
+  }
+#endif
+#ifdef USE_BINARY_SENSOR
+  void add_dependency(binary_sensor::BinarySensor *dependency) {
+    this->has_dependencies_ = true;
+    dependency->add_on_state_callback([this](bool) { this->schedule_evaluation_(); });
+  }
+#endif
+#ifdef USE_TEXT_SENSOR
+  void add_dependency(text_sensor::TextSensor *dependency) {
+    this->has_dependencies_ = true;
+    dependency->add_on_state_callback([this](const std::string &) { this->schedule_evaluation_(); });
+  }
+#endif
+  /// The longest time without an evaluation when none of the dependencies publishes, never by default.
+  void set_max_interval(uint32_t max_interval) { this->max_interval_ = max_interval; }
+
+ protected:
+  /// Evaluate the template in the next loop iteration.
+  virtual void schedule_evaluation_() = 0;
+
+  bool has_dependencies_{false};
+  uint32_t max_interval_{4294967295UL};
+};
+
+}  // namespace template_
+}  // namespace esphome
@@ -4,7 +4,7 @@ from esphome import automation
 from esphome.components import text_sensor
 from esphome.components.text_sensor import TextSensorPublishAction
 from esphome.const import CONF_ID, CONF_LAMBDA, CONF_STATE
-from .. import template_ns
+from .. import DEPENDS_ON_SCHEMA, register_dependencies, template_ns
 
 TemplateTextSensor = template_ns.class_('TemplateTextSensor', text_sensor.TextSensor,
                                         cg.PollingComponent)
@@ -12,7 +12,7 @@ TemplateTextSensor = template_ns.class_('TemplateTextSensor', text_sensor.TextSe
 CONFIG_SCHEMA = text_sensor.TEXT_SENSOR_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(TemplateTextSensor),
     cv.Optional(CONF_LAMBDA): cv.returning_lambda,
-}).extend(cv.polling_component_schema('60s'))
+}).extend(DEPENDS_ON_SCHEMA).extend(cv.polling_component_schema('60s'))
 
 
 def to_code(config):
@@ -24,6 +24,7 @@ def to_code(config):
         template_ = yield cg.process_lambda(config[CONF_LAMBDA], [],
                                             return_type=cg.optional.template(cg.std_string))
         cg.add(var.set_template(template_))
+    yield register_dependencies(var, config)
 
 
 @automation.register_action('text_sensor.template.publish', TextSensorPublishAction, cv.Schema({
@@ -6,7 +6,14 @@ namespace template_ {
 
 static const char *TAG = "template.text_sensor";
 
+void TemplateTextSensor::setup() {
+  // with dependencies the update interval is never, the first evaluation arms the max interval
+  if (this->has_dependencies_)
+    this->update();
+}
 void TemplateTextSensor::update() {
+  if (this->has_dependencies_)
+    this->set_timeout("max_interval", this->max_interval_, [this]() { this->update(); });
   if (!this->f_.has_value())
     return;
 
@@ -15,9 +22,19 @@ void TemplateTextSensor::update() {
     this->publish_state(*val);
   }
 }
+void TemplateTextSensor::schedule_evaluation_() {
+  this->defer("evaluate", [this]() { this->update(); });
+}
 float TemplateTextSensor::get_setup_priority() const { return setup_priority::HARDWARE; }
 void TemplateTextSensor::set_template(std::function<optional<std::string>()> &&f) { this->f_ = f; }
-void TemplateTextSensor::dump_config() { LOG_TEXT_SENSOR("", "Template Sensor", this); }
+void TemplateTextSensor::dump_config() {
+  LOG_TEXT_SENSOR("", "Template Sensor", this);
+  if (this->has_dependencies_) {
+    ESP_LOGCONFIG(TAG, "  Evaluated on dependency updates, max interval: %ums", this->max_interval_);
+  } else {
+    LOG_UPDATE_INTERVAL(this);
+  }
+}
 
 }  // namespace template_
 }  // namespace esphome
@@ -3,14 +3,16 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/text_sensor/text_sensor.h"
+#include "esphome/components/template/template_dependencies.h"
 
 namespace esphome {
 namespace template_ {
 
-class TemplateTextSensor : public text_sensor::TextSensor, public PollingComponent {
+class TemplateTextSensor : public text_sensor::TextSensor, public PollingComponent, public TemplateDependencies {
  public:
   void set_template(std::function<optional<std::string>()> &&f);
 
+  void setup() override;
   void update() override;
 
   float get_setup_priority() const override;
@@ -18,6 +20,8 @@ class TemplateTextSensor : public text_sensor::TextSensor, public PollingCompone
   void dump_config() override;
 
  protected:
+  void schedule_evaluation_() override;
+
   optional<std::function<optional<std::string>()>> f_{};
 };
 
@@ -10,7 +10,7 @@ namespace text_sensor {
 class TextSensorStateTrigger : public Trigger<std::string> {
  public:
   explicit TextSensorStateTrigger(TextSensor *parent) {
-    parent->add_on_state_callback([this](std::string value) { this->trigger(value); });
+    parent->add_on_state_callback([this](const std::string &value) { this->trigger(value); });
   }
 };
 
@@ -9,14 +9,19 @@ static const char *TAG = "text_sensor";
 TextSensor::TextSensor() : TextSensor("") {}
 TextSensor::TextSensor(const std::string &name) : Nameable(name) {}
 
-void TextSensor::publish_state(std::string state) {
+void TextSensor::publish_state(const std::string &state) {
+  if (this->has_state_ && !this->force_update_ && state == this->state) {
+    ESP_LOGV(TAG, "'%s': State '%s' unchanged", this->name_.c_str(), state.c_str());
+    return;
+  }
+  // assigning reuses the buffer of the previous state if it is large enough
   this->state = state;
   this->has_state_ = true;
-  ESP_LOGD(TAG, "'%s': Sending state '%s'", this->name_.c_str(), state.c_str());
-  this->callback_.call(state);
+  ESP_LOGD(TAG, "'%s': Sending state '%s'", this->name_.c_str(), this->state.c_str());
+  this->callback_.call(this->state);
 }
 void TextSensor::set_icon(const std::string &icon) { this->icon_ = icon; }
-void TextSensor::add_on_state_callback(std::function<void(std::string)> callback) {
+void TextSensor::add_on_state_callback(std::function<void(const std::string &)> &&callback) {
   this->callback_.add(std::move(callback));
 }
 std::string TextSensor::get_icon() {
@@ -22,11 +22,18 @@ class TextSensor : public Nameable {
   explicit TextSensor();
   explicit TextSensor(const std::string &name);
 
-  void publish_state(std::string state);
+  /** Publish a new state, ignored if it equals the current one unless force_update is set.
+   *
+   * The state is copied once into `state`, the callbacks get a reference to it.
+   */
+  void publish_state(const std::string &state);
 
   void set_icon(const std::string &icon);
 
-  void add_on_state_callback(std::function<void(std::string)> callback);
+  /// Publish every state, even if it equals the current one.
+  void set_force_update(bool force_update) { this->force_update_ = force_update; }
+
+  void add_on_state_callback(std::function<void(const std::string &)> &&callback);
 
   std::string state;
 
@@ -43,9 +50,10 @@ class TextSensor : public Nameable {
  protected:
   uint32_t hash_base() override;
 
-  CallbackManager<void(std::string)> callback_;
+  CallbackManager<void(const std::string &)> callback_;
   optional<std::string> icon_;
   bool has_state_{false};
+  bool force_update_{false};
 };
 
 }  // namespace text_sensor
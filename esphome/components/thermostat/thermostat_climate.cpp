@@ -1,6 +1,8 @@
 #include "thermostat_climate.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace thermostat {
 
@@ -8,11 +10,18 @@ static const char *TAG = "thermostat.climate";
 
 void ThermostatClimate::setup() {
   this->sensor_->add_on_state_callback([this](float state) {
+    const bool temperature_changed = state != this->current_temperature;
+    const climate::ClimateAction prev_action = this->action;
     this->current_temperature = state;
-    // required action may have changed, recompute, refresh
-    this->switch_to_action_(compute_action_());
-    // current temperature and possibly action changed, so publish the new state
-    this->publish_state();
+    // the action can only change when the temperature crosses a set point +/- the hysteresis
+    if (!this->in_action_band_(state))
+      this->evaluate_action_();
+    if (this->action != prev_action) {
+      this->publish_now_();
+    } else if (temperature_changed) {
+      // only the current temperature changed, coalesce noisy sensors
+      this->publish_throttled_();
+    }
   });
   this->current_temperature = this->sensor_->state;
   // restore all climate data, if possible
@@ -25,17 +34,17 @@ void ThermostatClimate::setup() {
     this->change_away_(false);
   }
   // refresh the climate action based on the restored settings
-  this->switch_to_action_(compute_action_());
+  this->evaluate_action_();
   this->setup_complete_ = true;
-  this->publish_state();
+  this->publish_now_();
 }
 float ThermostatClimate::hysteresis() { return this->hysteresis_; }
 void ThermostatClimate::refresh() {
   this->switch_to_mode_(this->mode);
-  this->switch_to_action_(compute_action_());
+  this->evaluate_action_();
   this->switch_to_fan_mode_(this->fan_mode);
   this->switch_to_swing_mode_(this->swing_mode);
-  this->publish_state();
+  this->publish_now_();
 }
 void ThermostatClimate::control(const climate::ClimateCall &call) {
   if (call.get_mode().has_value())
@@ -206,6 +215,56 @@ climate::ClimateAction ThermostatClimate::compute_action_() {
 
   return target_action;
 }
+void ThermostatClimate::evaluate_action_() {
+  this->switch_to_action_(this->compute_action_());
+
+  this->action_band_low_ = NAN;
+  this->action_band_high_ = NAN;
+  const float temperature = this->current_temperature;
+  if (isnan(temperature) || isnan(this->hysteresis_))
+    return;
+  // compute_action_() only compares the temperature against these, so it gives the same result until one is crossed
+  float set_points[4];
+  uint8_t count = 0;
+  if (this->supports_two_points_) {
+    set_points[count++] = this->target_temperature_low - this->hysteresis_;
+    set_points[count++] = this->target_temperature_low + this->hysteresis_;
+    set_points[count++] = this->target_temperature_high - this->hysteresis_;
+    set_points[count++] = this->target_temperature_high + this->hysteresis_;
+  } else {
+    set_points[count++] = this->target_temperature - this->hysteresis_;
+    set_points[count++] = this->target_temperature + this->hysteresis_;
+  }
+  float low = -INFINITY;
+  float high = INFINITY;
+  for (uint8_t i = 0; i < count; i++) {
+    if (isnan(set_points[i]))
+      return;
+    if (set_points[i] <= temperature)
+      low = std::max(low, set_points[i]);
+    if (set_points[i] >= temperature)
+      high = std::min(high, set_points[i]);
+  }
+  this->action_band_low_ = low;
+  this->action_band_high_ = high;
+}
+bool ThermostatClimate::in_action_band_(float temperature) const {
+  return temperature > this->action_band_low_ && temperature < this->action_band_high_;
+}
+void ThermostatClimate::publish_now_() {
+  this->cancel_timeout("publish");
+  this->last_publish_ = millis();
+  this->publish_state();
+}
+void ThermostatClimate::publish_throttled_() {
+  const uint32_t elapsed = millis() - this->last_publish_;
+  if (elapsed >= this->min_publish_interval_) {
+    this->publish_now_();
+    return;
+  }
+  // replaces a pending publish, which then sends the latest temperature
+  this->set_timeout("publish", this->min_publish_interval_ - elapsed, [this]() { this->publish_now_(); });
+}
 void ThermostatClimate::switch_to_action_(climate::ClimateAction action) {
   // setup_complete_ helps us ensure an action is called immediately after boot
   if ((action == this->action) && this->setup_complete_)
@@ -433,6 +492,9 @@ ThermostatClimate::ThermostatClimate()
       swing_mode_horizontal_trigger_(new Trigger<>()),
       swing_mode_vertical_trigger_(new Trigger<>()) {}
 void ThermostatClimate::set_hysteresis(float hysteresis) { this->hysteresis_ = hysteresis; }
+void ThermostatClimate::set_min_publish_interval(uint32_t min_publish_interval) {
+  this->min_publish_interval_ = min_publish_interval;
+}
 void ThermostatClimate::set_sensor(sensor::Sensor *sensor) { this->sensor_ = sensor; }
 void ThermostatClimate::set_supports_auto(bool supports_auto) { this->supports_auto_ = supports_auto; }
 void ThermostatClimate::set_supports_cool(bool supports_cool) { this->supports_cool_ = supports_cool; }
@@ -520,6 +582,8 @@ void ThermostatClimate::dump_config() {
       ESP_LOGCONFIG(TAG, "  Default Target Temperature High: %.1f°C", this->normal_config_.default_temperature);
   }
   ESP_LOGCONFIG(TAG, "  Hysteresis: %.1f°C", this->hysteresis_);
+  if (this->min_publish_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Minimum Publish Interval: %ums", this->min_publish_interval_);
   ESP_LOGCONFIG(TAG, "  Supports AUTO: %s", YESNO(this->supports_auto_));
   ESP_LOGCONFIG(TAG, "  Supports COOL: %s", YESNO(this->supports_cool_));
   ESP_LOGCONFIG(TAG, "  Supports DRY: %s", YESNO(this->supports_dry_));
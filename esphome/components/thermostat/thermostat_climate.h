@@ -27,6 +27,7 @@ class ThermostatClimate : public climate::Climate, public Component {
   void dump_config() override;
 
   void set_hysteresis(float hysteresis);
+  void set_min_publish_interval(uint32_t min_publish_interval);
   void set_sensor(sensor::Sensor *sensor);
   void set_supports_auto(bool supports_auto);
   void set_supports_cool(bool supports_cool);
@@ -93,6 +94,18 @@ class ThermostatClimate : public climate::Climate, public Component {
   /// Re-compute the required action of this climate controller.
   climate::ClimateAction compute_action_();
 
+  /// Switch to the computed action and remember the temperatures in which it stays the same.
+  void evaluate_action_();
+
+  /// Whether the action can't change at this temperature since the last evaluation.
+  bool in_action_band_(float temperature) const;
+
+  /// Publish the state now, cancelling a pending publish.
+  void publish_now_();
+
+  /// Publish the state once min_publish_interval_ has passed since the last publish.
+  void publish_throttled_();
+
   /// Switch the climate device to the given climate action.
   void switch_to_action_(climate::ClimateAction action);
 
@@ -263,6 +276,17 @@ class ThermostatClimate : public climate::Climate, public Component {
   /// Hysteresis value used for computing climate actions
   float hysteresis_{0};
 
+  /// Temperatures strictly between these bounds give the same action as the last evaluation.
+  ///
+  /// The bounds are the closest set points +/- the hysteresis around the current temperature, NAN if the action must
+  /// be computed again on the next sensor update.
+  float action_band_low_{NAN};
+  float action_band_high_{NAN};
+
+  /// Minimum time between states published only because the current temperature changed, in ms
+  uint32_t min_publish_interval_{0};
+  uint32_t last_publish_{0};
+
   /// setup_complete_ blocks modifying/resetting the temps immediately after boot
   bool setup_complete_{false};
 };
@@ -1,11 +1,8 @@
 #include "automation.h"
-#include "esphome/core/log.h"
 
 namespace esphome {
 namespace time {
 
-static const char *TAG = "automation";
-
 void CronTrigger::add_second(uint8_t second) { this->seconds_[second] = true; }
 void CronTrigger::add_minute(uint8_t minute) { this->minutes_[minute] = true; }
 void CronTrigger::add_hour(uint8_t hour) { this->hours_[hour] = true; }
@@ -16,39 +13,45 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
-  ESPTime time = this->rtc_->now();
-  if (!time.is_valid())
-    return;
-
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ >= time) {
-      // already handled this one
-      return;
+time_t CronTrigger::next_fire(time_t after) const {
+  time_t t = after + 1;
+  struct tm tm = *::localtime(&t);
+  // the calendar repeats after 28 years, a combination that didn't match until then never will
+  const int last_year = tm.tm_year + 28;
+  while (tm.tm_year <= last_year) {
+    // skip to the start of the next month, day, hour... whatever the first field that doesn't match is
+    if (!this->months_[tm.tm_mon + 1]) {
+      tm.tm_mon++;
+      tm.tm_mday = 1;
+      tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+    } else if (!this->days_of_month_[tm.tm_mday] || !this->days_of_week_[tm.tm_wday + 1]) {
+      tm.tm_mday++;
+      tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+    } else if (!this->hours_[tm.tm_hour]) {
+      tm.tm_hour++;
+      tm.tm_min = tm.tm_sec = 0;
+    } else if (!this->minutes_[tm.tm_min]) {
+      tm.tm_min++;
+      tm.tm_sec = 0;
+    } else if (!this->seconds_[tm.tm_sec]) {
+      tm.tm_sec++;
+    } else {
+      return t;
     }
 
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
-
-      if (this->matches(*this->last_check_))
-        this->trigger();
+    // mktime() normalizes the overflowed field and applies the DST rules of the new date
+    tm.tm_isdst = -1;
+    time_t next = ::mktime(&tm);
+    if (next <= t) {
+      // the local time doesn't exist (DST gap), continue after it
+      next = t + 3600 - t % 3600;
+      tm = *::localtime(&next);
     }
+    t = next;
   }
-
-  this->last_check_ = time;
-  if (!time.fields_in_range()) {
-    ESP_LOGW(TAG, "Time is out of range!");
-    ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%ld",
-             time.second, time.minute, time.hour, time.day_of_week, time.day_of_month, time.day_of_year, time.month,
-             time.timestamp);
-  }
-
-  if (this->matches(time))
-    this->trigger();
+  return -1;
 }
-CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
+CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) { rtc->add_cron_trigger(this); }
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
   for (uint8_t it : seconds)
     this->add_second(it);
@@ -73,8 +76,6 @@ void CronTrigger::add_days_of_week(const std::vector<uint8_t> &days_of_week) {
   for (uint8_t it : days_of_week)
     this->add_day_of_week(it);
 }
-float CronTrigger::get_setup_priority() const { return setup_priority::HARDWARE; }
-
 SyncTrigger::SyncTrigger(RealTimeClock *rtc) : rtc_(rtc) {
   rtc->add_on_time_sync_callback([this]() { this->trigger(); });
 }
@@ -7,7 +7,12 @@
 namespace esphome {
 namespace time {
 
-class CronTrigger : public Trigger<>, public Component {
+/** Fires at the times matching a cron-like set of fields.
+ *
+ * The triggers don't poll the time themselves, the RealTimeClock keeps a single deadline for the next firing of all
+ * of its triggers and asks each trigger for its next matching time only after it fired.
+ */
+class CronTrigger : public Trigger<> {
  public:
   explicit CronTrigger(RealTimeClock *rtc);
   void add_second(uint8_t second);
@@ -23,8 +28,8 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
-  void loop() override;
-  float get_setup_priority() const override;
+  /// The first matching timestamp after the given one, or -1 if the fields never match.
+  time_t next_fire(time_t after) const;
 
  protected:
   std::bitset<61> seconds_;
@@ -34,7 +39,10 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClock *rtc_;
-  optional<ESPTime> last_check_;
+
+  friend RealTimeClock;
+  /// The timestamp this trigger fires next, -1 if never.
+  time_t next_fire_{-1};
 };
 
 class SyncTrigger : public Trigger<>, public Component {
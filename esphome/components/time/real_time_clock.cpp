@@ -1,28 +1,78 @@
 #include "real_time_clock.h"
+#include "automation.h"
 #include "esphome/core/log.h"
 #include "lwip/opt.h"
 #ifdef ARDUINO_ARCH_ESP8266
 #include "sys/time.h"
 #endif
 #include "errno.h"
+#include <algorithm>
 
 namespace esphome {
 namespace time {
 
 static const char *TAG = "time";
 
+/// The longest time the cron triggers wait without checking the clock, so a clock step without a time sync (SNTP
+/// corrections) delays them by at most this much.
+static const uint32_t CRON_MAX_WAIT = 60000;
+/// The largest difference to a precise time source that is slewed instead of stepping the clock, in microseconds.
+static const int32_t TIME_MAX_SLEW = 128000;
+#ifndef ARDUINO_ARCH_ESP32
+/// How much a slew changes the clock per second, in microseconds.
+static const int32_t TIME_SLEW_RATE = 500;
+#endif
+
 RealTimeClock::RealTimeClock() = default;
 void RealTimeClock::call_setup() {
   setenv("TZ", this->timezone_.c_str(), 1);
   tzset();
   PollingComponent::call_setup();
+
+  if (!this->cron_triggers_.empty()) {
+    // the clock may jump when it is synchronized, decide anew
+    this->add_on_time_sync_callback([this]() { this->dispatch_cron_(); });
+    this->dispatch_cron_();
+  }
 }
-void RealTimeClock::synchronize_epoch_(uint32_t epoch) {
-  struct timeval timev {
-    .tv_sec = static_cast<time_t>(epoch), .tv_usec = 0,
-  };
-  ESP_LOGVV(TAG, "Got epoch %u", epoch);
-  timezone tz = {0, 0};
+void RealTimeClock::dispatch_cron_() {
+  ESPTime time = this->now();
+  if (!time.is_valid()) {
+    this->last_cron_dispatch_ = 0;
+    this->set_timeout("cron", 1000, [this]() { this->dispatch_cron_(); });
+    return;
+  }
+
+  const time_t now = time.timestamp;
+  // the next fire times are only known from a valid time that didn't go backwards
+  const bool recompute = this->last_cron_dispatch_ == 0 || now < this->last_cron_dispatch_;
+  this->last_cron_dispatch_ = now;
+  time_t next = -1;
+  for (auto *trigger : this->cron_triggers_) {
+    if (recompute) {
+      trigger->next_fire_ = trigger->next_fire(now - 1);
+    }
+    if (trigger->next_fire_ != -1 && trigger->next_fire_ <= now) {
+      // a clock that jumped over several matches fires only once
+      trigger->trigger();
+      trigger->next_fire_ = trigger->next_fire(now);
+    }
+    if (trigger->next_fire_ != -1 && (next == -1 || trigger->next_fire_ < next))
+      next = trigger->next_fire_;
+  }
+
+  uint32_t wait = CRON_MAX_WAIT;
+  if (next != -1) {
+    // wake up right after the second of the next firing started
+    struct timeval tv {};
+    gettimeofday(&tv, nullptr);
+    const int64_t until = (int64_t(next) - tv.tv_sec) * 1000 - tv.tv_usec / 1000 + 1;
+    wait = std::min<int64_t>(std::max<int64_t>(until, 0), CRON_MAX_WAIT);
+  }
+  this->set_timeout("cron", wait, [this]() { this->dispatch_cron_(); });
+}
+static void set_clock(const struct timeval &timev) {
+  struct timezone tz = {0, 0};
   int ret = settimeofday(&timev, &tz);
   if (ret == EINVAL) {
     // Some ESP8266 frameworks abort when timezone parameter is not NULL
@@ -33,6 +83,50 @@ void RealTimeClock::synchronize_epoch_(uint32_t epoch) {
   if (ret != 0) {
     ESP_LOGW(TAG, "setimeofday() failed with code %d", ret);
   }
+}
+static int64_t get_clock_us() {
+  struct timeval tv {};
+  gettimeofday(&tv, nullptr);
+  return int64_t(tv.tv_sec) * 1000000LL + tv.tv_usec;
+}
+
+void RealTimeClock::synchronize_epoch_(uint32_t epoch) {
+  struct timeval timev {
+    .tv_sec = static_cast<time_t>(epoch), .tv_usec = 0,
+  };
+  ESP_LOGVV(TAG, "Got epoch %u", epoch);
+  this->step_clock_(timev);
+}
+void RealTimeClock::synchronize_epoch_us_(int64_t epoch_us) {
+  const int64_t offset = epoch_us - get_clock_us();
+  if (this->now().is_valid() && offset >= -TIME_MAX_SLEW && offset <= TIME_MAX_SLEW) {
+    ESP_LOGV(TAG, "Slewing the clock by %.3f ms", offset / 1000.0f);
+#ifdef ARDUINO_ARCH_ESP32
+    // ESP-IDF slews the clock itself, replacing a slew that is still running
+    struct timeval delta {
+      .tv_sec = static_cast<time_t>(offset / 1000000LL), .tv_usec = static_cast<suseconds_t>(offset % 1000000LL),
+    };
+    if (adjtime(&delta, nullptr) != 0)
+      ESP_LOGW(TAG, "adjtime() failed");
+#else
+    this->slew_remaining_ = offset;
+    this->set_interval("slew", 1000, [this]() { this->slew_(); });
+#endif
+    return;
+  }
+
+  struct timeval timev {
+    .tv_sec = static_cast<time_t>(epoch_us / 1000000LL), .tv_usec = static_cast<suseconds_t>(epoch_us % 1000000LL),
+  };
+  this->step_clock_(timev);
+}
+void RealTimeClock::step_clock_(const struct timeval &timev) {
+#ifndef ARDUINO_ARCH_ESP32
+  this->slew_remaining_ = 0;
+  this->cancel_interval("slew");
+#endif
+  // on the ESP32 this also ends a slew of adjtime()
+  set_clock(timev);
 
   auto time = this->now();
   char buf[128];
@@ -41,6 +135,19 @@ void RealTimeClock::synchronize_epoch_(uint32_t epoch) {
 
   this->time_sync_callback_.call();
 }
+#ifndef ARDUINO_ARCH_ESP32
+void RealTimeClock::slew_() {
+  const int32_t step = std::max(std::min(this->slew_remaining_, TIME_SLEW_RATE), -TIME_SLEW_RATE);
+  const int64_t now = get_clock_us() + step;
+  struct timeval timev {
+    .tv_sec = static_cast<time_t>(now / 1000000LL), .tv_usec = static_cast<suseconds_t>(now % 1000000LL),
+  };
+  set_clock(timev);
+  this->slew_remaining_ -= step;
+  if (this->slew_remaining_ == 0)
+    this->cancel_interval("slew");
+}
+#endif
 
 size_t ESPTime::strftime(char *buffer, size_t buffer_len, const char *format) {
   struct tm c_tm = this->to_c_tm();
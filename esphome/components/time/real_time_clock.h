@@ -5,11 +5,14 @@
 #include "esphome/core/automation.h"
 #include <stdlib.h>
 #include <time.h>
+#include <sys/time.h>
 #include <bitset>
 
 namespace esphome {
 namespace time {
 
+class CronTrigger;
+
 /// A more user-friendly version of struct tm from time.h
 struct ESPTime {
   /** seconds after the minute [0-60]
@@ -131,13 +134,40 @@ class RealTimeClock : public PollingComponent {
     this->time_sync_callback_.add(std::move(callback));
   };
 
+  /// Register a trigger to be fired at its matching times, see CronTrigger.
+  void add_cron_trigger(CronTrigger *trigger) { this->cron_triggers_.push_back(trigger); }
+
  protected:
+  /// Fire the cron triggers that are due and wait for the next one.
+  void dispatch_cron_();
+
   /// Report a unix epoch as current time.
   void synchronize_epoch_(uint32_t epoch);
+  /** Report the current time in microseconds since the unix epoch, from a source more precise than a second.
+   *
+   * Once the clock is valid, differences up to 128 ms are slewed away instead of stepping the clock. On the ESP32
+   * adjtime() changes the rate of the clock, so it neither jumps nor runs backwards. Elsewhere the clock is set
+   * every second by at most 0.5 ms, so it is set back by that much each second while a negative difference is
+   * applied. Only larger differences step the clock and count as a time sync.
+   */
+  void synchronize_epoch_us_(int64_t epoch_us);
+  /// Set the clock, which ends a slew, and call the time sync callbacks.
+  void step_clock_(const struct timeval &timev);
+#ifndef ARDUINO_ARCH_ESP32
+  /// Apply the next part of the slew.
+  void slew_();
+#endif
 
   std::string timezone_{};
 
   CallbackManager<void()> time_sync_callback_;
+  std::vector<CronTrigger *> cron_triggers_;
+  /// The time of the last dispatch, to notice the clock being set back. 0 if the time wasn't valid yet.
+  time_t last_cron_dispatch_{0};
+#ifndef ARDUINO_ARCH_ESP32
+  /// The part of the last synchronization that is still to be applied, in microseconds.
+  int32_t slew_remaining_{0};
+#endif
 };
 
 template<typename... Ts> class TimeHasTimeCondition : public Condition<Ts...> {
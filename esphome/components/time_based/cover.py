@@ -3,7 +3,7 @@ import esphome.config_validation as cv
 from esphome import automation
 from esphome.components import cover
 from esphome.const import CONF_CLOSE_ACTION, CONF_CLOSE_DURATION, CONF_ID, CONF_OPEN_ACTION, \
-    CONF_OPEN_DURATION, CONF_STOP_ACTION, CONF_ASSUMED_STATE
+    CONF_OPEN_DURATION, CONF_STOP_ACTION, CONF_ASSUMED_STATE, CONF_MIN_PUBLISH_INTERVAL
 
 time_based_ns = cg.esphome_ns.namespace('time_based')
 TimeBasedCover = time_based_ns.class_('TimeBasedCover', cover.Cover, cg.Component)
@@ -22,6 +22,7 @@ CONFIG_SCHEMA = cover.COVER_SCHEMA.extend({
 
     cv.Optional(CONF_HAS_BUILT_IN_ENDSTOP, default=False): cv.boolean,
     cv.Optional(CONF_ASSUMED_STATE, default=True): cv.boolean,
+    cv.Optional(CONF_MIN_PUBLISH_INTERVAL, default='1s'): cv.positive_time_period_milliseconds,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -40,3 +41,4 @@ def to_code(config):
 
     cg.add(var.set_has_built_in_endstop(config[CONF_HAS_BUILT_IN_ENDSTOP]))
     cg.add(var.set_assumed_state(config[CONF_ASSUMED_STATE]))
+    cg.add(var.set_min_publish_interval(config[CONF_MIN_PUBLISH_INTERVAL]))
@@ -10,8 +10,9 @@ using namespace esphome::cover;
 
 void TimeBasedCover::dump_config() {
   LOG_COVER("", "Time Based Cover", this);
-  ESP_LOGCONFIG(TAG, "  Open Duration: %.1fs", this->open_duration_ / 1e3f);
-  ESP_LOGCONFIG(TAG, "  Close Duration: %.1fs", this->close_duration_ / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Open Duration: %.1fs", this->motion_.get_open_duration() / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Close Duration: %.1fs", this->motion_.get_close_duration() / 1e3f);
+  ESP_LOGCONFIG(TAG, "  Min Publish Interval: %.1fs", this->motion_.get_min_publish_interval() / 1e3f);
 }
 void TimeBasedCover::setup() {
   auto restore = this->restore_state_();
@@ -38,14 +39,10 @@ void TimeBasedCover::loop() {
     } else {
       this->start_direction_(COVER_OPERATION_IDLE);
     }
-    this->publish_state();
   }
 
-  // Send current position every second
-  if (now - this->last_publish_time_ > 1000) {
-    this->publish_state(false);
-    this->last_publish_time_ = now;
-  }
+  // throttled while moving, saved once stopped
+  this->motion_.publish(this, now);
 }
 float TimeBasedCover::get_setup_priority() const { return setup_priority::DATA; }
 CoverTraits TimeBasedCover::get_traits() {
@@ -121,33 +118,9 @@ void TimeBasedCover::start_direction_(CoverOperation dir) {
 
   const uint32_t now = millis();
   this->start_dir_time_ = now;
-  this->last_recompute_time_ = now;
-}
-void TimeBasedCover::recompute_position_() {
-  if (this->current_operation == COVER_OPERATION_IDLE)
-    return;
-
-  float dir;
-  float action_dur;
-  switch (this->current_operation) {
-    case COVER_OPERATION_OPENING:
-      dir = 1.0f;
-      action_dur = this->open_duration_;
-      break;
-    case COVER_OPERATION_CLOSING:
-      dir = -1.0f;
-      action_dur = this->close_duration_;
-      break;
-    default:
-      return;
-  }
-
-  const uint32_t now = millis();
-  this->position += dir * (now - this->last_recompute_time_) / action_dur;
-  this->position = clamp(this->position, 0.0f, 1.0f);
-
-  this->last_recompute_time_ = now;
+  this->motion_.reset(now);
 }
+void TimeBasedCover::recompute_position_() { this->motion_.recompute(this, millis()); }
 
 }  // namespace time_based
 }  // namespace esphome
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/components/cover/cover.h"
+#include "esphome/components/cover/cover_motion.h"
 
 namespace esphome {
 namespace time_based {
@@ -17,8 +18,11 @@ class TimeBasedCover : public cover::Cover, public Component {
   Trigger<> *get_open_trigger() const { return this->open_trigger_; }
   Trigger<> *get_close_trigger() const { return this->close_trigger_; }
   Trigger<> *get_stop_trigger() const { return this->stop_trigger_; }
-  void set_open_duration(uint32_t open_duration) { this->open_duration_ = open_duration; }
-  void set_close_duration(uint32_t close_duration) { this->close_duration_ = close_duration; }
+  void set_open_duration(uint32_t open_duration) { this->motion_.set_open_duration(open_duration); }
+  void set_close_duration(uint32_t close_duration) { this->motion_.set_close_duration(close_duration); }
+  void set_min_publish_interval(uint32_t min_publish_interval) {
+    this->motion_.set_min_publish_interval(min_publish_interval);
+  }
   cover::CoverTraits get_traits() override;
   void set_has_built_in_endstop(bool value) { this->has_built_in_endstop_ = value; }
   void set_assumed_state(bool value) { this->assumed_state_ = value; }
@@ -33,15 +37,12 @@ class TimeBasedCover : public cover::Cover, public Component {
   void recompute_position_();
 
   Trigger<> *open_trigger_{new Trigger<>()};
-  uint32_t open_duration_;
   Trigger<> *close_trigger_{new Trigger<>()};
-  uint32_t close_duration_;
   Trigger<> *stop_trigger_{new Trigger<>()};
+  cover::CoverMotion motion_;
 
   Trigger<> *prev_command_trigger_{nullptr};
-  uint32_t last_recompute_time_{0};
   uint32_t start_dir_time_{0};
-  uint32_t last_publish_time_{0};
   float target_position_{0};
   bool has_built_in_endstop_{false};
   bool assumed_state_{false};
@@ -160,28 +160,51 @@ void TM1637Display::stop_() {
 }
 
 void TM1637Display::display() {
+  // only the digits from the first to the last changed one are written, nothing if none changed
+  uint8_t first = 0;
+  uint8_t last = 4;
+  if (!this->resend_) {
+    while (first < 4 && this->buffer_[first] == this->sent_[first])
+      first++;
+    while (last > first && this->buffer_[last - 1] == this->sent_[last - 1])
+      last--;
+  }
+  const bool intensity_changed = this->resend_ || this->intensity_ != this->sent_intensity_;
+  if (first == last && !intensity_changed)
+    return;
   ESP_LOGVV(TAG, "Display %02X%02X%02X%02X", buffer_[0], buffer_[1], buffer_[2], buffer_[3]);
+  // send_byte_() returns the level of the ACK bit, high when the display didn't acknowledge
+  bool nack = false;
+
+  if (first != last) {
+    // Write COMM1
+    this->start_();
+    nack |= this->send_byte_(TM1637_I2C_COMM1);
+    this->stop_();
 
-  // Write COMM1
-  this->start_();
-  this->send_byte_(TM1637_I2C_COMM1);
-  this->stop_();
+    // Write COMM2 + first digit address
+    this->start_();
+    nack |= this->send_byte_(TM1637_I2C_COMM2 + first);
 
-  // Write COMM2 + first digit address
-  this->start_();
-  this->send_byte_(TM1637_I2C_COMM2);
+    // Write the data bytes
+    for (uint8_t i = first; i < last; i++) {
+      nack |= this->send_byte_(this->buffer_[i]);
+      this->sent_[i] = this->buffer_[i];
+    }
 
-  // Write the data bytes
-  for (auto b : this->buffer_) {
-    this->send_byte_(b);
+    this->stop_();
   }
 
-  this->stop_();
+  if (intensity_changed) {
+    // Write COMM3 + brightness
+    this->start_();
+    nack |= this->send_byte_(TM1637_I2C_COMM3 + ((this->intensity_ & 0x7) | 0x08));
+    this->stop_();
+    this->sent_intensity_ = this->intensity_;
+  }
 
-  // Write COMM3 + brightness
-  this->start_();
-  this->send_byte_(TM1637_I2C_COMM3 + ((this->intensity_ & 0x7) | 0x08));
-  this->stop_();
+  // without an ACK it is unknown what the display shows, write everything the next time
+  this->resend_ = nack;
 }
 bool TM1637Display::send_byte_(uint8_t b) {
   uint8_t data = b;
@@ -64,6 +64,11 @@ class TM1637Display : public PollingComponent {
   uint8_t intensity_;
   optional<tm1637_writer_t> writer_{};
   uint8_t buffer_[4] = {0};
+  /// The digits and intensity as last written to the display.
+  uint8_t sent_[4] = {0};
+  uint8_t sent_intensity_{0};
+  /// Write all digits and the intensity on the next display(), not only the changed ones.
+  bool resend_{true};
 };
 
 }  // namespace tm1637
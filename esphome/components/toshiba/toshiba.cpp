@@ -10,6 +10,9 @@ const uint16_t TOSHIBA_BIT_MARK = 540;
 const uint16_t TOSHIBA_ZERO_SPACE = 540;
 const uint16_t TOSHIBA_ONE_SPACE = 1620;
 
+static const climate_ir::IRFrameTiming TOSHIBA_TIMING = {TOSHIBA_HEADER_MARK, TOSHIBA_HEADER_SPACE, TOSHIBA_BIT_MARK,
+                                                         TOSHIBA_ONE_SPACE,   TOSHIBA_ZERO_SPACE,   true};
+
 const uint8_t TOSHIBA_COMMAND_DEFAULT = 0x01;
 const uint8_t TOSHIBA_COMMAND_TIMER = 0x02;
 const uint8_t TOSHIBA_COMMAND_POWER = 0x08;
@@ -104,24 +107,9 @@ void ToshibaClimate::transmit_state() {
   auto data = transmit.get_data();
   data->set_carrier_frequency(38000);
 
-  for (uint8_t copy = 0; copy < 2; copy++) {
-    data->mark(TOSHIBA_HEADER_MARK);
-    data->space(TOSHIBA_HEADER_SPACE);
-
-    for (uint8_t byte = 0; byte < message_length; byte++) {
-      for (uint8_t bit = 0; bit < 8; bit++) {
-        data->mark(TOSHIBA_BIT_MARK);
-        if (message[byte] & (1 << (7 - bit))) {
-          data->space(TOSHIBA_ONE_SPACE);
-        } else {
-          data->space(TOSHIBA_ZERO_SPACE);
-        }
-      }
-    }
-
-    data->mark(TOSHIBA_BIT_MARK);
-    data->space(TOSHIBA_GAP_SPACE);
-  }
+  data->reserve(climate_ir::ir_frame_length(message_length) * 2);
+  for (uint8_t copy = 0; copy < 2; copy++)
+    climate_ir::encode_ir_frame(data, TOSHIBA_TIMING, message, message_length, TOSHIBA_GAP_SPACE);
 
   transmit.perform();
 }
@@ -1,7 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, time
-from esphome.const import CONF_ID, CONF_TIME_ID
+from esphome.const import CONF_ID, CONF_TIME_ID, CONF_MIN_PUBLISH_INTERVAL
 
 DEPENDENCIES = ['time']
 
@@ -13,6 +13,7 @@ CONFIG_SCHEMA = sensor.SENSOR_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(TotalDailyEnergy),
     cv.GenerateID(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
     cv.Required(CONF_POWER_ID): cv.use_id(sensor.Sensor),
+    cv.Optional(CONF_MIN_PUBLISH_INTERVAL, default='0s'): cv.positive_time_period_milliseconds,
 }).extend(cv.COMPONENT_SCHEMA)
 
 
@@ -26,3 +27,4 @@ def to_code(config):
     cg.add(var.set_parent(sens))
     time_ = yield cg.get_variable(config[CONF_TIME_ID])
     cg.add(var.set_time(time_))
+    cg.add(var.set_min_publish_interval(config[CONF_MIN_PUBLISH_INTERVAL]))
@@ -19,7 +19,16 @@ void TotalDailyEnergy::setup() {
 
   this->parent_->add_on_state_callback([this](float state) { this->process_new_state_(state); });
 }
-void TotalDailyEnergy::dump_config() { LOG_SENSOR("", "Total Daily Energy", this); }
+void TotalDailyEnergy::dump_config() {
+  LOG_SENSOR("", "Total Daily Energy", this);
+  if (this->min_publish_interval_ != 0)
+    ESP_LOGCONFIG(TAG, "  Min Publish Interval: %u ms", this->min_publish_interval_);
+}
+void TotalDailyEnergy::on_safe_shutdown() {
+  // checkpoint the latest total, the preferences are committed after this
+  float state = this->total_energy_.get();
+  this->pref_.save(&state);
+}
 void TotalDailyEnergy::loop() {
   auto t = this->time_->now();
   if (!t.is_valid())
@@ -32,22 +41,37 @@ void TotalDailyEnergy::loop() {
 
   if (t.day_of_year != this->last_day_of_year_) {
     this->last_day_of_year_ = t.day_of_year;
-    this->total_energy_ = 0;
     this->publish_state_and_save(0);
   }
 }
 void TotalDailyEnergy::publish_state_and_save(float state) {
+  this->total_energy_.reset(state);
+  this->publish_now_();
+}
+void TotalDailyEnergy::publish_now_() {
+  this->cancel_timeout("publish");
+  this->last_publish_ = millis();
+  float state = this->total_energy_.get();
   this->pref_.save(&state);
-  this->total_energy_ = state;
   this->publish_state(state);
 }
+void TotalDailyEnergy::publish_throttled_() {
+  const uint32_t elapsed = millis() - this->last_publish_;
+  if (elapsed >= this->min_publish_interval_) {
+    this->publish_now_();
+    return;
+  }
+  // replaces a pending publish, which then sends the latest total
+  this->set_timeout("publish", this->min_publish_interval_ - elapsed, [this]() { this->publish_now_(); });
+}
 void TotalDailyEnergy::process_new_state_(float state) {
   if (isnan(state))
     return;
   const uint32_t now = millis();
-  float delta_hours = (now - this->last_update_) / 1000.0f / 60.0f / 60.0f;
+  const double delta_hours = (now - this->last_update_) / 1000.0 / 60.0 / 60.0;
   this->last_update_ = now;
-  this->publish_state_and_save(this->total_energy_ + state * delta_hours);
+  this->total_energy_.add(state * delta_hours);
+  this->publish_throttled_();
 }
 
 }  // namespace total_daily_energy
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/time/real_time_clock.h"
@@ -12,8 +13,11 @@ class TotalDailyEnergy : public sensor::Sensor, public Component {
  public:
   void set_time(time::RealTimeClock *time) { time_ = time; }
   void set_parent(Sensor *parent) { parent_ = parent; }
+  /// Publish (and save) the energy at most this often, the integration itself isn't affected.
+  void set_min_publish_interval(uint32_t min_publish_interval) { min_publish_interval_ = min_publish_interval; }
   void setup() override;
   void dump_config() override;
+  void on_safe_shutdown() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
   std::string unit_of_measurement() override { return this->parent_->get_unit_of_measurement() + "h"; }
   std::string icon() override { return this->parent_->get_icon(); }
@@ -24,13 +28,17 @@ class TotalDailyEnergy : public sensor::Sensor, public Component {
 
  protected:
   void process_new_state_(float state);
+  void publish_now_();
+  void publish_throttled_();
 
   ESPPreferenceObject pref_;
   time::RealTimeClock *time_;
   Sensor *parent_;
   uint16_t last_day_of_year_{};
   uint32_t last_update_{0};
-  float total_energy_{0.0f};
+  uint32_t min_publish_interval_{0};
+  uint32_t last_publish_{0};
+  CompensatedSum total_energy_;
 };
 
 }  // namespace total_daily_energy
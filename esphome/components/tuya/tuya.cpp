@@ -7,26 +7,55 @@ namespace tuya {
 
 static const char *TAG = "tuya";
 static const int COMMAND_DELAY = 50;
+/// How long to wait for the MCU to answer a command before sending the next one.
+static const int RESPONSE_TIMEOUT = 500;
+/// Longer messages are taken as a corrupted header.
+static const uint16_t MAX_MESSAGE_LENGTH = 1024;
 
 void Tuya::setup() {
-  this->set_interval("heartbeat", 1000, [this] { this->schedule_empty_command_(TuyaCommandType::HEARTBEAT); });
+  this->set_interval("heartbeat", 1000, [this] { this->send_empty_command_(TuyaCommandType::HEARTBEAT); });
 }
 
 void Tuya::loop() {
-  while (this->available()) {
-    uint8_t c;
-    this->read_byte(&c);
-    this->handle_char_(c);
+  uint8_t buffer[64];
+  size_t len;
+  while ((len = this->read_available(buffer, sizeof(buffer))) != 0) {
+    this->rx_message_.insert(this->rx_message_.end(), buffer, buffer + len);
+    this->parse_messages_();
   }
+  this->process_command_queue_();
 }
 
-void Tuya::schedule_empty_command_(TuyaCommandType command) {
+static optional<TuyaCommandType> get_response_type(TuyaCommandType command) {
+  switch (command) {
+    case TuyaCommandType::DATAPOINT_DELIVER:
+    case TuyaCommandType::DATAPOINT_QUERY:
+      return TuyaCommandType::DATAPOINT_REPORT;
+    case TuyaCommandType::WIFI_TEST:
+    case TuyaCommandType::LOCAL_TIME_QUERY:
+      // answers to requests of the MCU
+      return {};
+    default:
+      return command;
+  }
+}
+
+void Tuya::process_command_queue_() {
   uint32_t delay = millis() - this->last_command_timestamp_;
-  if (delay > COMMAND_DELAY) {
-    send_empty_command_(command);
-  } else {
-    this->set_timeout(COMMAND_DELAY - delay, [this, command] { this->send_empty_command_(command); });
+  if (this->expected_response_.has_value()) {
+    if (delay < RESPONSE_TIMEOUT)
+      return;
+    ESP_LOGW(TAG, "MCU didn't respond to the last command");
+    this->expected_response_.reset();
   }
+  if (delay <= COMMAND_DELAY || this->command_queue_.empty())
+    return;
+
+  TuyaCommand command = std::move(this->command_queue_.front());
+  this->command_queue_.erase(this->command_queue_.begin());
+  this->send_raw_command_(command);
+  this->expected_response_ = get_response_type(command.cmd);
+  this->last_command_timestamp_ = millis();
 }
 
 void Tuya::dump_config() {
@@ -59,70 +88,54 @@ void Tuya::dump_config() {
   this->check_uart_settings(9600);
 }
 
-bool Tuya::validate_message_() {
-  uint32_t at = this->rx_message_.size() - 1;
-  auto *data = &this->rx_message_[0];
-  uint8_t new_byte = data[at];
-
-  // Byte 0: HEADER1 (always 0x55)
-  if (at == 0)
-    return new_byte == 0x55;
-  // Byte 1: HEADER2 (always 0xAA)
-  if (at == 1)
-    return new_byte == 0xAA;
-
-  // Byte 2: VERSION
-  // no validation for the following fields:
-  uint8_t version = data[2];
-  if (at == 2)
-    return true;
-  // Byte 3: COMMAND
-  uint8_t command = data[3];
-  if (at == 3)
-    return true;
-
-  // Byte 4: LENGTH1
-  // Byte 5: LENGTH2
-  if (at <= 5)
-    // no validation for these fields
-    return true;
-
-  uint16_t length = (uint16_t(data[4]) << 8) | (uint16_t(data[5]));
-
-  // wait until all data is read
-  if (at - 6 < length)
-    return true;
-
-  // Byte 6+LEN: CHECKSUM - sum of all bytes (including header) modulo 256
-  uint8_t rx_checksum = new_byte;
-  uint8_t calc_checksum = 0;
-  for (uint32_t i = 0; i < 6 + length; i++)
-    calc_checksum += data[i];
-
-  if (rx_checksum != calc_checksum) {
-    ESP_LOGW(TAG, "Tuya Received invalid message checksum %02X!=%02X", rx_checksum, calc_checksum);
-    return false;
-  }
-
-  // valid message
-  const uint8_t *message_data = data + 6;
-  ESP_LOGV(TAG, "Received Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", command, version,  // NOLINT
-           hexencode(message_data, length).c_str(), this->init_state_);
-  this->handle_command_(command, version, message_data, length);
+void Tuya::parse_messages_() {
+  const uint8_t *data = this->rx_message_.data();
+  const size_t size = this->rx_message_.size();
+  size_t pos = 0;
+  // header (2), version, command, length (2) and checksum
+  while (size - pos >= 7) {
+    // Byte 0: HEADER1 (always 0x55), Byte 1: HEADER2 (always 0xAA)
+    if (data[pos] != 0x55 || data[pos + 1] != 0xAA) {
+      pos++;
+      continue;
+    }
+    // Byte 2: VERSION, Byte 3: COMMAND, Byte 4: LENGTH1, Byte 5: LENGTH2
+    uint8_t version = data[pos + 2];
+    uint8_t command = data[pos + 3];
+    uint16_t length = (uint16_t(data[pos + 4]) << 8) | (uint16_t(data[pos + 5]));
+    if (length > MAX_MESSAGE_LENGTH) {
+      pos++;
+      continue;
+    }
+    // wait until all data is read
+    if (size - pos < 7u + length)
+      break;
 
-  // return false to reset rx buffer
-  return false;
-}
+    // Byte 6+LEN: CHECKSUM - sum of all bytes (including header) modulo 256
+    uint8_t rx_checksum = data[pos + 6 + length];
+    uint8_t calc_checksum = 0;
+    for (uint32_t i = 0; i < 6u + length; i++)
+      calc_checksum += data[pos + i];
+    if (rx_checksum != calc_checksum) {
+      ESP_LOGW(TAG, "Tuya Received invalid message checksum %02X!=%02X", rx_checksum, calc_checksum);
+      pos++;
+      continue;
+    }
 
-void Tuya::handle_char_(uint8_t c) {
-  this->rx_message_.push_back(c);
-  if (!this->validate_message_()) {
-    this->rx_message_.clear();
+    // valid message
+    const uint8_t *message_data = data + pos + 6;
+    ESP_LOGV(TAG, "Received Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", command, version,  // NOLINT
+             hexencode(message_data, length).c_str(), this->init_state_);
+    this->handle_command_(command, version, message_data, length);
+    pos += 7u + length;
   }
+  this->rx_message_.erase(this->rx_message_.begin(), this->rx_message_.begin() + pos);
 }
 
 void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len) {
   this->last_command_timestamp_ = millis();
+  if (this->expected_response_.has_value() && *this->expected_response_ == (TuyaCommandType) command)
+    this->expected_response_.reset();
   switch ((TuyaCommandType) command) {
     case TuyaCommandType::HEARTBEAT:
       ESP_LOGV(TAG, "MCU Heartbeat (0x%02X)", buffer[0]);
@@ -132,7 +145,7 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
       }
       if (this->init_state_ == TuyaInitState::INIT_HEARTBEAT) {
         this->init_state_ = TuyaInitState::INIT_PRODUCT;
-        this->schedule_empty_command_(TuyaCommandType::PRODUCT_QUERY);
+        this->send_empty_command_(TuyaCommandType::PRODUCT_QUERY);
       }
       break;
     case TuyaCommandType::PRODUCT_QUERY: {
@@ -151,7 +164,7 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
       }
       if (this->init_state_ == TuyaInitState::INIT_PRODUCT) {
         this->init_state_ = TuyaInitState::INIT_CONF;
-        this->schedule_empty_command_(TuyaCommandType::CONF_QUERY);
+        this->send_empty_command_(TuyaCommandType::CONF_QUERY);
       }
       break;
     }
@@ -164,16 +177,14 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
         // If mcu returned status gpio, then we can ommit sending wifi state
         if (this->gpio_status_ != -1) {
           this->init_state_ = TuyaInitState::INIT_DATAPOINT;
-          this->schedule_empty_command_(TuyaCommandType::DATAPOINT_QUERY);
+          this->send_empty_command_(TuyaCommandType::DATAPOINT_QUERY);
         } else {
           this->init_state_ = TuyaInitState::INIT_WIFI;
-          this->set_timeout(COMMAND_DELAY, [this] {
-            // If we were following the spec to the letter we would send
-            // state updates until connected to both WiFi and API/MQTT.
-            // Instead we just claim to be connected immediately and move on.
-            uint8_t c[] = {0x04};
-            this->send_command_(TuyaCommandType::WIFI_STATE, c, 1);
-          });
+          // If we were following the spec to the letter we would send
+          // state updates until connected to both WiFi and API/MQTT.
+          // Instead we just claim to be connected immediately and move on.
+          uint8_t c[] = {0x04};
+          this->send_command_(TuyaCommandType::WIFI_STATE, c, 1);
         }
       }
       break;
@@ -181,7 +192,7 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
     case TuyaCommandType::WIFI_STATE:
       if (this->init_state_ == TuyaInitState::INIT_WIFI) {
         this->init_state_ = TuyaInitState::INIT_DATAPOINT;
-        this->schedule_empty_command_(TuyaCommandType::DATAPOINT_QUERY);
+        this->send_empty_command_(TuyaCommandType::DATAPOINT_QUERY);
       }
       break;
     case TuyaCommandType::WIFI_RESET:
@@ -213,28 +224,24 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
         auto now = time_id->now();
 
         if (now.is_valid()) {
-          this->set_timeout(COMMAND_DELAY, [this, now] {
-            uint8_t year = now.year - 2000;
-            uint8_t month = now.month;
-            uint8_t day_of_month = now.day_of_month;
-            uint8_t hour = now.hour;
-            uint8_t minute = now.minute;
-            uint8_t second = now.second;
-            // Tuya days starts from Monday, esphome uses Sunday as day 1
-            uint8_t day_of_week = now.day_of_week - 1;
-            if (day_of_week == 0) {
-              day_of_week = 7;
-            }
-            uint8_t c[] = {0x01, year, month, day_of_month, hour, minute, second, day_of_week};
-            this->send_command_(TuyaCommandType::LOCAL_TIME_QUERY, c, 8);
-          });
+          uint8_t year = now.year - 2000;
+          uint8_t month = now.month;
+          uint8_t day_of_month = now.day_of_month;
+          uint8_t hour = now.hour;
+          uint8_t minute = now.minute;
+          uint8_t second = now.second;
+          // Tuya days starts from Monday, esphome uses Sunday as day 1
+          uint8_t day_of_week = now.day_of_week - 1;
+          if (day_of_week == 0) {
+            day_of_week = 7;
+          }
+          uint8_t c[] = {0x01, year, month, day_of_month, hour, minute, second, day_of_week};
+          this->send_command_(TuyaCommandType::LOCAL_TIME_QUERY, c, 8);
         } else {
           ESP_LOGW(TAG, "TUYA_CMD_LOCAL_TIME_QUERY is not handled because time is not valid");
           // By spec we need to notify MCU that the time was not obtained
-          this->set_timeout(COMMAND_DELAY, [this] {
-            uint8_t c[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-            this->send_command_(TuyaCommandType::LOCAL_TIME_QUERY, c, 8);
-          });
+          uint8_t c[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+          this->send_command_(TuyaCommandType::LOCAL_TIME_QUERY, c, 8);
         }
       } else {
         ESP_LOGW(TAG, "TUYA_CMD_LOCAL_TIME_QUERY is not handled because time is not configured");
@@ -322,18 +329,32 @@ void Tuya::handle_datapoint_(const uint8_t *buffer, size_t len) {
 }
 
 void Tuya::send_command_(TuyaCommandType command, const uint8_t *buffer, uint16_t len) {
+  if (len == 0) {
+    // queries and heartbeats only have to be sent once
+    for (auto &queued : this->command_queue_) {
+      if (queued.cmd == command && queued.payload.empty())
+        return;
+    }
+  }
+  this->command_queue_.push_back(TuyaCommand{command, std::vector<uint8_t>(buffer, buffer + len)});
+}
+
+void Tuya::send_raw_command_(const TuyaCommand &command) {
+  const uint8_t *buffer = command.payload.data();
+  uint16_t len = command.payload.size();
   uint8_t len_hi = len >> 8;
   uint8_t len_lo = len >> 0;
   uint8_t version = 0;
 
-  ESP_LOGV(TAG, "Sending Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", command, version,  // NOLINT
+  ESP_LOGV(TAG, "Sending Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", command.cmd, version,  // NOLINT
            hexencode(buffer, len).c_str(), this->init_state_);
 
-  this->write_array({0x55, 0xAA, version, (uint8_t) command, len_hi, len_lo});
+  uint8_t header[] = {0x55, 0xAA, version, (uint8_t) command.cmd, len_hi, len_lo};
+  this->write_array(header, sizeof(header));
   if (len != 0)
     this->write_array(buffer, len);
 
-  uint8_t checksum = 0x55 + 0xAA + (uint8_t) command + len_hi + len_lo;
+  uint8_t checksum = 0x55 + 0xAA + (uint8_t) command.cmd + len_hi + len_lo;
   for (int i = 0; i < len; i++)
     checksum += buffer[i];
   this->write_byte(checksum);
@@ -354,6 +375,8 @@ void Tuya::set_datapoint_value(TuyaDatapoint datapoint) {
         ESP_LOGV(TAG, "Not sending unchanged value");
         return;
       }
+      // compare later values with this one, the MCU reports it back once it is applied
+      other = datapoint;
     }
   }
   buffer.push_back(datapoint.id);
@@ -389,6 +412,15 @@ void Tuya::set_datapoint_value(TuyaDatapoint datapoint) {
   buffer.push_back(data.size() >> 8);
   buffer.push_back(data.size() >> 0);
   buffer.insert(buffer.end(), data.begin(), data.end());
+
+  // a value still waiting in the queue is replaced, only the last one is sent
+  for (auto &queued : this->command_queue_) {
+    if (queued.cmd == TuyaCommandType::DATAPOINT_DELIVER && !queued.payload.empty() &&
+        queued.payload[0] == datapoint.id) {
+      queued.payload = std::move(buffer);
+      return;
+    }
+  }
   this->send_command_(TuyaCommandType::DATAPOINT_DELIVER, buffer.data(), buffer.size());
 }
 
@@ -52,6 +52,11 @@ enum class TuyaCommandType : uint8_t {
   LOCAL_TIME_QUERY = 0x1C,
 };
 
+struct TuyaCommand {
+  TuyaCommandType cmd;
+  std::vector<uint8_t> payload;
+};
+
 enum class TuyaInitState : uint8_t {
   INIT_HEARTBEAT = 0x00,
   INIT_PRODUCT,
@@ -77,14 +82,16 @@ class Tuya : public Component, public uart::UARTDevice {
   }
 
  protected:
-  void handle_char_(uint8_t c);
   void handle_datapoint_(const uint8_t *buffer, size_t len);
-  bool validate_message_();
+  /// Handle all complete messages in the receive buffer and drop them from it.
+  void parse_messages_();
 
   void handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len);
+  /// Queue a command, commands are sent one at a time once the MCU answered the previous one.
   void send_command_(TuyaCommandType command, const uint8_t *buffer, uint16_t len);
   void send_empty_command_(TuyaCommandType command) { this->send_command_(command, nullptr, 0); }
-  void schedule_empty_command_(TuyaCommandType command);
+  void process_command_queue_();
+  void send_raw_command_(const TuyaCommand &command);
 
 #ifdef USE_TIME
   optional<time::RealTimeClock *> time_id_{};
@@ -93,6 +100,9 @@ class Tuya : public Component, public uart::UARTDevice {
   int gpio_status_ = -1;
   int gpio_reset_ = -1;
   uint32_t last_command_timestamp_ = 0;
+  /// The response the MCU still owes for the last sent command.
+  optional<TuyaCommandType> expected_response_{};
+  std::vector<TuyaCommand> command_queue_;
   std::string product_ = "";
   std::vector<TuyaDatapointListener> listeners_;
   std::vector<TuyaDatapoint> datapoints_;
@@ -23,6 +23,40 @@ int UARTComponent::read() {
     return -1;
   return data;
 }
+void UARTComponent::on_frame(UARTFrameCallback &&callback, uint32_t idle_timeout, optional<uint8_t> delimiter,
+                             size_t length) {
+  this->frame_callback_ = std::move(callback);
+  this->frame_idle_timeout_ = idle_timeout;
+  this->frame_delimiter_ = delimiter;
+  this->frame_length_ = length;
+  this->frame_buffer_.reserve(this->rx_buffer_size_);
+}
+void UARTComponent::loop() {
+  if (!this->frame_callback_)
+    return;
+
+  const uint32_t now = millis();
+  uint8_t chunk[64];
+  size_t len;
+  while ((len = this->read_available(chunk, sizeof(chunk))) != 0) {
+    this->last_rx_ = now;
+    for (size_t i = 0; i < len; i++) {
+      this->frame_buffer_.push_back(chunk[i]);
+      if ((this->frame_delimiter_.has_value() && chunk[i] == *this->frame_delimiter_) ||
+          this->frame_buffer_.size() == this->frame_length_ || this->frame_buffer_.size() >= this->rx_buffer_size_)
+        this->emit_frame_();
+    }
+  }
+
+  const bool idle = this->frame_idle_timeout_ != 0 && now - this->last_rx_ >= this->frame_idle_timeout_;
+  if (idle && !this->frame_buffer_.empty())
+    this->emit_frame_();
+}
+void UARTComponent::emit_frame_() {
+  ESP_LOGVV(TAG, "Received frame of %u bytes", this->frame_buffer_.size());
+  this->frame_callback_(this->frame_buffer_.data(), this->frame_buffer_.size());
+  this->frame_buffer_.clear();
+}
 int UARTComponent::peek() {
   uint8_t data;
   if (!this->peek_byte(&data))
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <HardwareSerial.h>
+#include <vector>
 #include "esphome/core/esphal.h"
 #include "esphome/core/component.h"
 
@@ -15,6 +16,9 @@ enum UARTParityOptions {
 
 const char *parity_to_str(UARTParityOptions parity);
 
+/// Called from the loop of the UART bus with one received frame.
+using UARTFrameCallback = std::function<void(const uint8_t *data, size_t len)>;
+
 #ifdef ARDUINO_ARCH_ESP8266
 class ESP8266SoftwareSerial {
  public:
@@ -23,6 +27,8 @@ class ESP8266SoftwareSerial {
 
   uint8_t read_byte();
   uint8_t peek_byte();
+  /// Copy up to len buffered bytes into data, returns the number of bytes copied.
+  size_t read_array(uint8_t *data, size_t len);
 
   void flush();
 
@@ -63,6 +69,9 @@ class UARTComponent : public Component, public Stream {
 
   void dump_config() override;
 
+  void loop() override;
+  bool is_loop_idle() override { return !this->frame_callback_; }
+
   void write_byte(uint8_t data);
 
   void write_array(const uint8_t *data, size_t len);
@@ -76,6 +85,18 @@ class UARTComponent : public Component, public Stream {
 
   bool read_array(uint8_t *data, size_t len);
 
+  /// Read the bytes that are already buffered without waiting, up to len. Returns the number of bytes read.
+  size_t read_available(uint8_t *data, size_t len);
+
+  /** Receive the data of this bus as frames instead of polling it.
+   *
+   * The bus drains its RX buffer in bulk from loop() and calls the callback with the collected bytes once the line
+   * was idle for idle_timeout ms, the delimiter was received (it is part of the frame) or length bytes are collected.
+   * 0 disables the idle timeout and the length. Frames are never longer than the RX buffer size.
+   */
+  void on_frame(UARTFrameCallback &&callback, uint32_t idle_timeout, optional<uint8_t> delimiter = {},
+                size_t length = 0);
+
   int available() override;
 
   /// Block until all bytes have been written to the UART bus.
@@ -93,10 +114,12 @@ class UARTComponent : public Component, public Stream {
   void set_stop_bits(uint8_t stop_bits) { this->stop_bits_ = stop_bits; }
   void set_data_bits(uint8_t data_bits) { this->data_bits_ = data_bits; }
   void set_parity(UARTParityOptions parity) { this->parity_ = parity; }
+  uint32_t get_baud_rate() const { return this->baud_rate_; }
 
  protected:
   void check_logger_conflict_();
   bool check_read_timeout_(size_t len = 1);
+  void emit_frame_();
   friend class UARTDevice;
 
   HardwareSerial *hw_serial_{nullptr};
@@ -110,6 +133,12 @@ class UARTComponent : public Component, public Stream {
   uint8_t stop_bits_;
   uint8_t data_bits_;
   UARTParityOptions parity_;
+  UARTFrameCallback frame_callback_;
+  std::vector<uint8_t> frame_buffer_;
+  uint32_t frame_idle_timeout_{0};
+  optional<uint8_t> frame_delimiter_;
+  size_t frame_length_{0};
+  uint32_t last_rx_{0};
 };
 
 #ifdef ARDUINO_ARCH_ESP32
@@ -144,6 +173,11 @@ class UARTDevice : public Stream {
     }
     return res;
   }
+  size_t read_available(uint8_t *data, size_t len) { return this->parent_->read_available(data, len); }
+  void on_frame(UARTFrameCallback &&callback, uint32_t idle_timeout, optional<uint8_t> delimiter = {},
+                size_t length = 0) {
+    this->parent_->on_frame(std::move(callback), idle_timeout, delimiter, length);
+  }
 
   int available() override { return this->parent_->available(); }
 
@@ -137,6 +137,14 @@ bool UARTComponent::read_array(uint8_t *data, size_t len) {
 
   return true;
 }
+size_t UARTComponent::read_available(uint8_t *data, size_t len) {
+  const size_t avail = this->hw_serial_->available();
+  if (avail < len)
+    len = avail;
+  if (len == 0)
+    return 0;
+  return this->hw_serial_->readBytes(data, len);
+}
 bool UARTComponent::check_read_timeout_(size_t len) {
   if (this->available() >= len)
     return true;
@@ -148,8 +148,7 @@ bool UARTComponent::read_array(uint8_t *data, size_t len) {
   if (this->hw_serial_ != nullptr) {
     this->hw_serial_->readBytes(data, len);
   } else {
-    for (size_t i = 0; i < len; i++)
-      data[i] = this->sw_serial_->read_byte();
+    this->sw_serial_->read_array(data, len);
   }
   for (size_t i = 0; i < len; i++) {
     ESP_LOGVV(TAG, "    Read 0b" BYTE_TO_BINARY_PATTERN " (0x%02X)", BYTE_TO_BINARY(data[i]), data[i]);
@@ -157,6 +156,16 @@ bool UARTComponent::read_array(uint8_t *data, size_t len) {
 
   return true;
 }
+size_t UARTComponent::read_available(uint8_t *data, size_t len) {
+  if (this->sw_serial_ != nullptr)
+    return this->sw_serial_->read_array(data, len);
+  const size_t avail = this->hw_serial_->available();
+  if (avail < len)
+    len = avail;
+  if (len == 0)
+    return 0;
+  return this->hw_serial_->readBytes(data, len);
+}
 bool UARTComponent::check_read_timeout_(size_t len) {
   if (this->available() >= int(len))
     return true;
@@ -288,6 +297,19 @@ uint8_t ESP8266SoftwareSerial::read_byte() {
   this->rx_out_pos_ = (this->rx_out_pos_ + 1) % this->rx_buffer_size_;
   return data;
 }
+size_t ESP8266SoftwareSerial::read_array(uint8_t *data, size_t len) {
+  const size_t in_pos = this->rx_in_pos_;
+  size_t copied = 0;
+  // at most two runs, up to the end of the ring and from its start
+  while (copied < len && this->rx_out_pos_ != in_pos) {
+    const size_t end = in_pos > this->rx_out_pos_ ? in_pos : this->rx_buffer_size_;
+    const size_t run = std::min(end - this->rx_out_pos_, len - copied);
+    memcpy(data + copied, this->rx_buffer_ + this->rx_out_pos_, run);
+    copied += run;
+    this->rx_out_pos_ = (this->rx_out_pos_ + run) % this->rx_buffer_size_;
+  }
+  return copied;
+}
 uint8_t ESP8266SoftwareSerial::peek_byte() {
   if (this->rx_in_pos_ == this->rx_out_pos_)
     return 0;
@@ -14,6 +14,7 @@ void ULN2003::setup() {
   this->loop();
 }
 void ULN2003::loop() {
+  this->measure_step_rate_();
   bool at_target = this->has_reached_target();
   if (at_target) {
     this->high_freq_.stop();
@@ -6,24 +6,38 @@ from esphome.const import CONF_ECHO_PIN, CONF_ID, CONF_TRIGGER_PIN, \
     CONF_TIMEOUT, UNIT_METER, ICON_ARROW_EXPAND_VERTICAL
 
 CONF_PULSE_TIME = 'pulse_time'
+CONF_INTERRUPT = 'interrupt'
+CONF_SAMPLES = 'samples'
 
 ultrasonic_ns = cg.esphome_ns.namespace('ultrasonic')
 UltrasonicSensorComponent = ultrasonic_ns.class_('UltrasonicSensorComponent',
                                                  sensor.Sensor, cg.PollingComponent)
 
-CONFIG_SCHEMA = sensor.sensor_schema(UNIT_METER, ICON_ARROW_EXPAND_VERTICAL, 2).extend({
+
+
+def validate_interrupt(config):
+    if config[CONF_INTERRUPT]:
+        pins.validate_has_interrupt(config[CONF_ECHO_PIN])
+    elif config[CONF_SAMPLES] != 1:
+        raise cv.Invalid("samples is only supported with interrupt: true")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(sensor.sensor_schema(UNIT_METER, ICON_ARROW_EXPAND_VERTICAL, 2).extend({
     cv.GenerateID(): cv.declare_id(UltrasonicSensorComponent),
     cv.Required(CONF_TRIGGER_PIN): pins.gpio_output_pin_schema,
     cv.Required(CONF_ECHO_PIN): pins.internal_gpio_input_pin_schema,
 
     cv.Optional(CONF_TIMEOUT, default='2m'): cv.distance,
     cv.Optional(CONF_PULSE_TIME, default='10us'): cv.positive_time_period_microseconds,
+    cv.Optional(CONF_INTERRUPT, default=False): cv.boolean,
+    cv.Optional(CONF_SAMPLES, default=1): cv.int_range(min=1, max=7),
 
     cv.Optional('timeout_meter'): cv.invalid("The timeout_meter option has been renamed "
                                              "to 'timeout' in 1.12."),
     cv.Optional('timeout_time'): cv.invalid("The timeout_time option has been removed. Please "
                                             "use 'timeout' in 1.12."),
-}).extend(cv.polling_component_schema('60s'))
+}).extend(cv.polling_component_schema('60s')), validate_interrupt)
 
 
 def to_code(config):
@@ -38,3 +52,6 @@ def to_code(config):
 
     cg.add(var.set_timeout_us(config[CONF_TIMEOUT] / (0.000343 / 2)))
     cg.add(var.set_pulse_time_us(config[CONF_PULSE_TIME]))
+    if config[CONF_INTERRUPT]:
+        cg.add(var.set_use_interrupt(True))
+        cg.add(var.set_samples(config[CONF_SAMPLES]))
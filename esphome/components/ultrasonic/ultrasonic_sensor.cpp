@@ -1,18 +1,56 @@
 #include "ultrasonic_sensor.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 
 namespace esphome {
 namespace ultrasonic {
 
 static const char *TAG = "ultrasonic.sensor";
 
+/// The pause between two pings, so that the echoes of the last one don't reach the next.
+static const uint32_t ULTRASONIC_PING_GAP = 20;
+
+std::vector<UltrasonicSensorComponent *> UltrasonicSensorComponent::queue_;  // NOLINT
+UltrasonicSensorComponent *UltrasonicSensorComponent::active_ = nullptr;     // NOLINT
+
+void ICACHE_RAM_ATTR UltrasonicSensorStore::gpio_intr(UltrasonicSensorStore *arg) {
+  if (!arg->armed)
+    return;
+  const uint32_t now = micros();
+  if (arg->echo_pin->digital_read()) {
+    arg->rise_time = now;
+    arg->has_rise = true;
+  } else if (arg->has_rise) {
+    arg->width = now - arg->rise_time;
+    arg->armed = false;
+    Application::wake_loop_isr();
+  }
+}
+
 void UltrasonicSensorComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Ultrasonic Sensor...");
   this->trigger_pin_->setup();
   this->trigger_pin_->digital_write(false);
   this->echo_pin_->setup();
+  if (this->use_interrupt_) {
+    this->store_.echo_pin = this->echo_pin_->to_isr();
+    this->echo_pin_->attach_interrupt(UltrasonicSensorStore::gpio_intr, &this->store_, CHANGE);
+  }
 }
 void UltrasonicSensorComponent::update() {
+  if (this->use_interrupt_) {
+    if (this->queued_ || active_ == this)
+      // the last reading hasn't finished yet
+      return;
+    this->queued_ = true;
+    this->sample_count_ = 0;
+    queue_.push_back(this);
+    if (active_ == nullptr)
+      start_next_();
+    return;
+  }
+
   this->trigger_pin_->digital_write(true);
   delayMicroseconds(this->pulse_time_us_);
   this->trigger_pin_->digital_write(false);
@@ -21,7 +59,9 @@ void UltrasonicSensorComponent::update() {
       this->echo_pin_->get_pin(), uint8_t(!this->echo_pin_->is_inverted()), this->timeout_us_);
 
   ESP_LOGV(TAG, "Echo took %uµs", time);
-
+  this->publish_time_(time);
+}
+void UltrasonicSensorComponent::publish_time_(uint32_t time) {
   if (time == 0) {
     ESP_LOGD(TAG, "'%s' - Distance measurement timed out!", this->name_.c_str());
     this->publish_state(NAN);
@@ -31,12 +71,69 @@ void UltrasonicSensorComponent::update() {
     this->publish_state(result);
   }
 }
+void UltrasonicSensorComponent::start_next_() {
+  if (queue_.empty()) {
+    active_ = nullptr;
+    return;
+  }
+  active_ = queue_.front();
+  queue_.erase(queue_.begin());
+  active_->queued_ = false;
+  active_->ping_();
+}
+void UltrasonicSensorComponent::ping_() {
+  this->store_.has_rise = false;
+  this->store_.armed = true;
+  this->measuring_ = true;
+  this->trigger_pin_->digital_write(true);
+  delayMicroseconds(this->pulse_time_us_);
+  this->trigger_pin_->digital_write(false);
+  this->trigger_time_ = micros();
+}
+void UltrasonicSensorComponent::loop() {
+  if (!this->measuring_)
+    return;
+  if (!this->store_.armed) {
+    this->finish_ping_(this->store_.width);
+    return;
+  }
+  // like pulseIn(), the timeout applies both to the start of the echo and to its length
+  const uint32_t start = this->store_.has_rise ? this->store_.rise_time : this->trigger_time_;
+  if (micros() - start > this->timeout_us_) {
+    this->store_.armed = false;
+    this->finish_ping_(0);
+  }
+}
+void UltrasonicSensorComponent::finish_ping_(uint32_t width) {
+  this->measuring_ = false;
+  ESP_LOGV(TAG, "Echo took %uµs", width);
+  this->sample_times_[this->sample_count_++] = width;
+  if (this->sample_count_ < this->samples_) {
+    this->set_timeout("ping", ULTRASONIC_PING_GAP, [this]() { this->ping_(); });
+    return;
+  }
+
+  // the median of the pings with an echo rejects single outliers, the reading times out if most had none
+  uint32_t *end = std::remove(this->sample_times_, this->sample_times_ + this->sample_count_, 0u);
+  const uint8_t valid = end - this->sample_times_;
+  uint32_t time = 0;
+  if (valid * 2 > this->sample_count_) {
+    std::sort(this->sample_times_, end);
+    time = this->sample_times_[valid / 2];
+  }
+  this->publish_time_(time);
+  this->set_timeout("next", ULTRASONIC_PING_GAP, []() { start_next_(); });
+}
 void UltrasonicSensorComponent::dump_config() {
   LOG_SENSOR("", "Ultrasonic Sensor", this);
   LOG_PIN("  Echo Pin: ", this->echo_pin_);
   LOG_PIN("  Trigger Pin: ", this->trigger_pin_);
   ESP_LOGCONFIG(TAG, "  Pulse time: %u µs", this->pulse_time_us_);
   ESP_LOGCONFIG(TAG, "  Timeout: %u µs", this->timeout_us_);
+  if (this->use_interrupt_) {
+    ESP_LOGCONFIG(TAG, "  Using Interrupt");
+    ESP_LOGCONFIG(TAG, "  Samples: %u", this->samples_);
+  }
   LOG_UPDATE_INTERVAL(this);
 }
 float UltrasonicSensorComponent::us_to_m(uint32_t us) {
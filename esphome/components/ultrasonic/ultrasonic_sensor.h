@@ -3,14 +3,37 @@
 #include "esphome/core/component.h"
 #include "esphome/core/esphal.h"
 #include "esphome/components/sensor/sensor.h"
+#include <vector>
 
 namespace esphome {
 namespace ultrasonic {
 
+/// The echo pulse of one ping, timed by the interrupt handler.
+struct UltrasonicSensorStore {
+  ISRInternalGPIOPin *echo_pin;
+  /// Set when the sensor was triggered, cleared once the echo pulse ended.
+  volatile bool armed{false};
+  volatile bool has_rise{false};
+  volatile uint32_t rise_time{0};
+  volatile uint32_t width{0};
+
+  static void gpio_intr(UltrasonicSensorStore *arg);
+};
+
 class UltrasonicSensorComponent : public sensor::Sensor, public PollingComponent {
  public:
+  static const uint8_t MAX_SAMPLES = 7;
+
   void set_trigger_pin(GPIOPin *trigger_pin) { trigger_pin_ = trigger_pin; }
   void set_echo_pin(GPIOPin *echo_pin) { echo_pin_ = echo_pin; }
+  /** Time the echo with an interrupt instead of waiting for it with pulseIn().
+   *
+   * The sensors using the interrupt are pinged one after another, so that they don't receive each other's echoes,
+   * and the loop keeps running while they wait for the echo.
+   */
+  void set_use_interrupt(bool use_interrupt) { use_interrupt_ = use_interrupt; }
+  /// Publish the median of this many pings, ignoring the ones without echo (only with the interrupt).
+  void set_samples(uint8_t samples) { samples_ = samples; }
 
   /// Set the timeout for waiting for the echo in µs.
   void set_timeout_us(uint32_t timeout_us);
@@ -22,6 +45,8 @@ class UltrasonicSensorComponent : public sensor::Sensor, public PollingComponent
   void dump_config() override;
 
   void update() override;
+  void loop() override;
+  bool is_loop_idle() override { return !this->measuring_; }
 
   float get_setup_priority() const override;
 
@@ -33,10 +58,29 @@ class UltrasonicSensorComponent : public sensor::Sensor, public PollingComponent
   static float us_to_m(uint32_t us);
   /// Helper function to convert the specified distance in meters to the echo duration in µs.
 
+  /// Start the next queued sensor, once the echoes of the last ping faded.
+  static void start_next_();
+  void ping_();
+  void finish_ping_(uint32_t width);
+  void publish_time_(uint32_t time);
+
+  /// The sensors waiting for their turn and the one that is pinging.
+  static std::vector<UltrasonicSensorComponent *> queue_;    // NOLINT
+  static UltrasonicSensorComponent *active_;                 // NOLINT
+
   GPIOPin *trigger_pin_;
   GPIOPin *echo_pin_;
   uint32_t timeout_us_{};  /// 2 meters.
   uint32_t pulse_time_us_{};
+  bool use_interrupt_{false};
+  uint8_t samples_{1};
+  bool queued_{false};
+  bool measuring_{false};
+  uint32_t trigger_time_{0};
+  /// The echo durations of the pings of the running reading, 0 if there was none.
+  uint32_t sample_times_[MAX_SAMPLES];
+  uint8_t sample_count_{0};
+  UltrasonicSensorStore store_{};
 };
 
 }  // namespace ultrasonic
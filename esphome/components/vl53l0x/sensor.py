@@ -1,7 +1,9 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome import pins
 from esphome.components import i2c, sensor
-from esphome.const import CONF_ID, UNIT_METER, ICON_ARROW_EXPAND_VERTICAL
+from esphome.const import CONF_ID, UNIT_METER, ICON_ARROW_EXPAND_VERTICAL, CONF_ADDRESS, \
+    CONF_ENABLE_PIN, CONF_INTERRUPT_PIN
 
 DEPENDENCIES = ['i2c']
 
@@ -11,13 +13,36 @@ VL53L0XSensor = vl53l0x_ns.class_('VL53L0XSensor', sensor.Sensor, cg.PollingComp
 
 CONF_SIGNAL_RATE_LIMIT = 'signal_rate_limit'
 CONF_LONG_RANGE = 'long_range'
+CONF_TIMING_BUDGET = 'timing_budget'
+CONF_CONTINUOUS = 'continuous'
+CONF_INTER_MEASUREMENT_PERIOD = 'inter_measurement_period'
 
-CONFIG_SCHEMA = sensor.sensor_schema(UNIT_METER, ICON_ARROW_EXPAND_VERTICAL, 2).extend({
+DEFAULT_ADDRESS = 0x29
+
+
+def validate_address(config):
+    # Only the XSHUT reset returns the sensor to the default address, so it starts there after every boot
+    if config[CONF_ADDRESS] != DEFAULT_ADDRESS and CONF_ENABLE_PIN not in config:
+        raise cv.Invalid("An address other than 0x{:02X} requires the enable_pin (XSHUT)"
+                         "".format(DEFAULT_ADDRESS))
+    if CONF_INTER_MEASUREMENT_PERIOD in config and not config[CONF_CONTINUOUS]:
+        raise cv.Invalid("inter_measurement_period requires continuous mode")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(sensor.sensor_schema(UNIT_METER, ICON_ARROW_EXPAND_VERTICAL, 2).extend({
     cv.GenerateID(): cv.declare_id(VL53L0XSensor),
     cv.Optional(CONF_SIGNAL_RATE_LIMIT, default=0.25): cv.float_range(
         min=0.0, max=512.0, min_included=False, max_included=False),
     cv.Optional(CONF_LONG_RANGE, default=False): cv.boolean,
-}).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(0x29))
+    cv.Optional(CONF_TIMING_BUDGET): cv.All(cv.positive_time_period_microseconds,
+                                            cv.Range(min=cv.TimePeriod(milliseconds=20))),
+    cv.Optional(CONF_CONTINUOUS, default=False): cv.boolean,
+    cv.Optional(CONF_INTER_MEASUREMENT_PERIOD): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_INTERRUPT_PIN): pins.gpio_input_pin_schema,
+    cv.Optional(CONF_ENABLE_PIN): pins.gpio_output_pin_schema,
+}).extend(cv.polling_component_schema('60s')).extend(i2c.i2c_device_schema(DEFAULT_ADDRESS)),
+                       validate_address)
 
 
 def to_code(config):
@@ -25,5 +50,15 @@ def to_code(config):
     yield cg.register_component(var, config)
     cg.add(var.set_signal_rate_limit(config[CONF_SIGNAL_RATE_LIMIT]))
     cg.add(var.set_long_range(config[CONF_LONG_RANGE]))
+    if CONF_TIMING_BUDGET in config:
+        cg.add(var.set_timing_budget(config[CONF_TIMING_BUDGET]))
+    if config[CONF_CONTINUOUS]:
+        cg.add(var.set_continuous(config.get(CONF_INTER_MEASUREMENT_PERIOD, 0)))
+    if CONF_INTERRUPT_PIN in config:
+        pin = yield cg.gpio_pin_expression(config[CONF_INTERRUPT_PIN])
+        cg.add(var.set_interrupt_pin(pin))
+    if CONF_ENABLE_PIN in config:
+        pin = yield cg.gpio_pin_expression(config[CONF_ENABLE_PIN])
+        cg.add(var.set_enable_pin(pin))
     yield sensor.register_sensor(var, config)
     yield i2c.register_i2c_device(var, config)
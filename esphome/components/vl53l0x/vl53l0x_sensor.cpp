@@ -1,5 +1,6 @@
 #include "vl53l0x_sensor.h"
 #include "esphome/core/log.h"
+#include "esphome/core/application.h"
 
 /*
  * Most of the code in this integration is based on the VL53L0x library
@@ -15,12 +16,73 @@ namespace vl53l0x {
 
 static const char *TAG = "vl53l0x";
 
+/// The address of every VL53L0X after a reset.
+static const uint8_t VL53L0X_DEFAULT_ADDRESS = 0x29;
+
+std::vector<VL53L0XSensor *> VL53L0XSensor::all_sensors;  // NOLINT
+bool VL53L0XSensor::reset_done = false;                   // NOLINT
+
+VL53L0XSensor::VL53L0XSensor() { VL53L0XSensor::all_sensors.push_back(this); }
+
 void VL53L0XSensor::dump_config() {
   LOG_SENSOR("", "VL53L0X", this);
   LOG_UPDATE_INTERVAL(this);
   LOG_I2C_DEVICE(this);
+  LOG_PIN("  Enable Pin: ", this->enable_pin_);
+  LOG_PIN("  Interrupt Pin: ", this->interrupt_pin_);
+  ESP_LOGCONFIG(TAG, "  Timing Budget: %u us", this->measurement_timing_budget_us_);
+  if (this->continuous_) {
+    if (this->inter_measurement_period_ == 0)
+      ESP_LOGCONFIG(TAG, "  Mode: continuous, back-to-back");
+    else
+      ESP_LOGCONFIG(TAG, "  Mode: continuous, every %u ms", this->inter_measurement_period_);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Mode: single shot");
+  }
+}
+float VL53L0XSensor::get_setup_priority() const {
+  // every sensor that is brought up answers at the default address, the one that stays there has to be the last
+  if (this->address_ == VL53L0X_DEFAULT_ADDRESS)
+    return setup_priority::DATA - 1.0f;
+  return setup_priority::DATA;
+}
+void VL53L0XSensor::reset_all_sensors_() {
+  if (VL53L0XSensor::reset_done)
+    return;
+  for (auto *sensor : VL53L0XSensor::all_sensors) {
+    if (sensor->enable_pin_ != nullptr) {
+      sensor->enable_pin_->setup();
+      sensor->enable_pin_->digital_write(false);
+    } else if (VL53L0XSensor::all_sensors.size() > 1) {
+      ESP_LOGW(TAG, "'%s' - Several sensors share the bus, but this one has no enable pin!", sensor->name_.c_str());
+    }
+  }
+  delay(2);
+  VL53L0XSensor::reset_done = true;
+}
+bool VL53L0XSensor::change_address_() {
+  const uint8_t address = this->address_;
+  if (address == VL53L0X_DEFAULT_ADDRESS)
+    return true;
+  this->set_i2c_address(VL53L0X_DEFAULT_ADDRESS);
+  // the 7-bit device address register
+  bool ok = this->write_byte(0x8A, address & 0x7F);
+  this->set_i2c_address(address);
+  return ok;
 }
 void VL53L0XSensor::setup() {
+  VL53L0XSensor::reset_all_sensors_();
+  if (this->enable_pin_ != nullptr) {
+    // out of reset, the sensor boots within 1.2 ms
+    this->enable_pin_->digital_write(true);
+    delay(2);
+  }
+  if (!this->change_address_()) {
+    ESP_LOGE(TAG, "'%s' - Could not change the address to 0x%02X!", this->name_.c_str(), this->address_);
+    this->mark_failed();
+    return;
+  }
+
   reg(0x89) |= 0x01;
   reg(0x88) = 0x00;
 
@@ -189,8 +251,14 @@ void VL53L0XSensor::setup() {
   reg(0x0B) = 0x01;
 
   measurement_timing_budget_us_ = get_measurement_timing_budget_();
+  if (this->timing_budget_ != 0)
+    measurement_timing_budget_us_ = this->timing_budget_;
   reg(0x01) = 0xE8;
-  set_measurement_timing_budget_(measurement_timing_budget_us_);
+  if (!set_measurement_timing_budget_(measurement_timing_budget_us_)) {
+    ESP_LOGE(TAG, "'%s' - Timing budget of %u us is not possible!", this->name_.c_str(), measurement_timing_budget_us_);
+    this->mark_failed();
+    return;
+  }
   reg(0x01) = 0x01;
 
   if (!perform_single_ref_calibration_(0x40)) {
@@ -205,8 +273,56 @@ void VL53L0XSensor::setup() {
     return;
   }
   reg(0x01) = 0xE8;
+
+  if (this->interrupt_pin_ != nullptr) {
+    // GPIO1 is configured active low above
+    this->interrupt_pin_->setup();
+    this->interrupt_pin_->attach_interrupt(VL53L0XSensor::gpio_intr, this, FALLING);
+  }
+  if (this->continuous_)
+    this->start_continuous_();
+}
+void ICACHE_RAM_ATTR VL53L0XSensor::gpio_intr(VL53L0XSensor *arg) {
+  arg->data_ready_ = true;
+  Application::wake_loop_isr();
+}
+void VL53L0XSensor::start_continuous_() {
+  reg(0x80) = 0x01;
+  reg(0xFF) = 0x01;
+  reg(0x00) = 0x00;
+  reg(0x91) = stop_variable_;
+  reg(0x00) = 0x01;
+  reg(0xFF) = 0x00;
+  reg(0x80) = 0x00;
+
+  if (this->inter_measurement_period_ != 0) {
+    // the period is in oscillator ticks if the oscillator has been calibrated
+    uint32_t period = this->inter_measurement_period_;
+    uint16_t osc_calibrate_val;
+    if (this->read_byte_16(0xF8, &osc_calibrate_val) && osc_calibrate_val != 0)
+      period *= osc_calibrate_val;
+    uint8_t data[4] = {uint8_t(period >> 24), uint8_t(period >> 16), uint8_t(period >> 8), uint8_t(period)};
+    this->write_bytes(0x04, data, 4);
+    reg(0x00) = 0x04;  // VL53L0X_REG_SYSRANGE_MODE_TIMED
+  } else {
+    reg(0x00) = 0x02;  // VL53L0X_REG_SYSRANGE_MODE_BACKTOBACK
+  }
+  this->data_ready_ = false;
+  this->last_poll_ = millis();
 }
 void VL53L0XSensor::update() {
+  if (this->continuous_) {
+    // the measurements are published as they come in, only check that they do
+    if (this->measurements_ == 0) {
+      this->publish_state(NAN);
+      this->status_set_warning();
+    } else {
+      this->status_clear_warning();
+    }
+    this->measurements_ = 0;
+    return;
+  }
+
   if (this->initiated_read_ || this->waiting_for_interrupt_) {
     this->publish_state(NAN);
     this->status_set_warning();
@@ -223,11 +339,50 @@ void VL53L0XSensor::update() {
   reg(0x80) = 0x00;
 
   reg(0x00) = 0x01;
+  this->data_ready_ = false;
+  if (this->interrupt_pin_ != nullptr) {
+    // GPIO1 signals the result, there is no need to poll for the start
+    this->initiated_read_ = false;
+    this->waiting_for_interrupt_ = true;
+    return;
+  }
   this->waiting_for_interrupt_ = false;
   this->initiated_read_ = true;
   // wait for timeout
 }
+bool VL53L0XSensor::is_loop_idle() {
+  if (this->interrupt_pin_ != nullptr)
+    return !this->data_ready_;
+  return !this->continuous_ && !this->initiated_read_ && !this->waiting_for_interrupt_;
+}
 void VL53L0XSensor::loop() {
+  if (this->continuous_) {
+    if (this->interrupt_pin_ != nullptr) {
+      if (!this->data_ready_)
+        return;
+    } else {
+      // no result can be ready before the timing budget (and the period) has passed
+      const uint32_t interval = std::max(this->measurement_timing_budget_us_ / 1000u, this->inter_measurement_period_);
+      if (millis() - this->last_poll_ < interval)
+        return;
+      if ((reg(0x13).get() & 0x07) == 0)
+        return;
+    }
+    this->data_ready_ = false;
+    this->last_poll_ = millis();
+    this->measurements_++;
+    this->read_range_();
+    return;
+  }
+
+  if (this->interrupt_pin_ != nullptr) {
+    if (this->waiting_for_interrupt_ && this->data_ready_) {
+      this->data_ready_ = false;
+      this->waiting_for_interrupt_ = false;
+      this->read_range_();
+    }
+    return;
+  }
   if (this->initiated_read_) {
     if (reg(0x00).get() & 0x01) {
       // waiting
@@ -240,23 +395,26 @@ void VL53L0XSensor::loop() {
   }
   if (this->waiting_for_interrupt_) {
     if (reg(0x13).get() & 0x07) {
-      uint16_t range_mm;
-      this->read_byte_16(0x14 + 10, &range_mm);
-      reg(0x0B) = 0x01;
       this->waiting_for_interrupt_ = false;
-
-      if (range_mm >= 8190) {
-        ESP_LOGW(TAG, "'%s' - Distance is out of range, please move the target closer", this->name_.c_str());
-        this->publish_state(NAN);
-        return;
-      }
-
-      float range_m = range_mm / 1e3f;
-      ESP_LOGD(TAG, "'%s' - Got distance %.3f m", this->name_.c_str(), range_m);
-      this->publish_state(range_m);
+      this->read_range_();
     }
   }
 }
+void VL53L0XSensor::read_range_() {
+  uint16_t range_mm;
+  this->read_byte_16(0x14 + 10, &range_mm);
+  reg(0x0B) = 0x01;
+
+  if (range_mm >= 8190) {
+    ESP_LOGW(TAG, "'%s' - Distance is out of range, please move the target closer", this->name_.c_str());
+    this->publish_state(NAN);
+    return;
+  }
+
+  float range_m = range_mm / 1e3f;
+  ESP_LOGV(TAG, "'%s' - Got distance %.3f m", this->name_.c_str(), range_m);
+  this->publish_state(range_m);
+}
 
 }  // namespace vl53l0x
 }  // namespace esphome
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/esphal.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/i2c/i2c.h"
 
@@ -18,20 +19,53 @@ struct SequenceStepTimeouts {
   uint32_t msrc_dss_tcc_us, pre_range_us, final_range_us;
 };
 
+/** Time-of-flight distance sensor.
+ *
+ * In single-shot mode a measurement is started every update interval. In continuous mode the sensor ranges on its
+ * own (back-to-back or every inter-measurement period) and every measurement is published when it is ready.
+ *
+ * With the GPIO1 interrupt pin the result is only read once the sensor signals it, otherwise the result register is
+ * polled, in continuous mode no more often than the timing budget. With the XSHUT enable pin several sensors can be
+ * on one bus: they are all held in reset and then brought up one by one, each moving to its configured address. All
+ * of them need an enable pin, and the one that stays at the default address is brought up last.
+ */
 class VL53L0XSensor : public sensor::Sensor, public PollingComponent, public i2c::I2CDevice {
  public:
+  VL53L0XSensor();
+
   void setup() override;
 
   void dump_config() override;
-  float get_setup_priority() const override { return setup_priority::DATA; }
+  float get_setup_priority() const override;
   void update() override;
 
   void loop() override;
+  bool is_loop_idle() override;
 
   void set_signal_rate_limit(float signal_rate_limit) { signal_rate_limit_ = signal_rate_limit; }
   void set_long_range(bool long_range) { long_range_ = long_range; }
+  /// The time per measurement in µs, at least 20000. Longer budgets are more accurate. 0 keeps the default (~33 ms).
+  void set_timing_budget(uint32_t timing_budget) { timing_budget_ = timing_budget; }
+  /// Range continuously, every inter_measurement_period ms or back-to-back if 0.
+  void set_continuous(uint32_t inter_measurement_period) {
+    this->continuous_ = true;
+    this->inter_measurement_period_ = inter_measurement_period;
+  }
+  /// The GPIO1 pin, which goes low when a measurement is ready.
+  void set_interrupt_pin(GPIOPin *interrupt_pin) { interrupt_pin_ = interrupt_pin; }
+  /// The XSHUT pin, which holds the sensor in reset while it is low.
+  void set_enable_pin(GPIOPin *enable_pin) { enable_pin_ = enable_pin; }
 
  protected:
+  /// Hold all sensors with an enable pin in reset, so that they can be brought up one by one at the default address.
+  static void reset_all_sensors_();
+  /// Move the sensor from the default address to the configured one.
+  bool change_address_();
+  void start_continuous_();
+  /// Read the result of a measurement that is ready and publish it.
+  void read_range_();
+  static void gpio_intr(VL53L0XSensor *arg);
+
   uint32_t get_measurement_timing_budget_() {
     SequenceStepEnables enables{};
     SequenceStepTimeouts timeouts{};
@@ -249,10 +283,23 @@ class VL53L0XSensor : public sensor::Sensor, public PollingComponent, public i2c
 
   float signal_rate_limit_;
   bool long_range_;
+  uint32_t timing_budget_{0};
+  bool continuous_{false};
+  uint32_t inter_measurement_period_{0};
+  GPIOPin *interrupt_pin_{nullptr};
+  GPIOPin *enable_pin_{nullptr};
   uint32_t measurement_timing_budget_us_;
   bool initiated_read_{false};
   bool waiting_for_interrupt_{false};
+  /// Set by the interrupt when a measurement is ready.
+  volatile bool data_ready_{false};
+  uint32_t last_poll_{0};
+  /// Measurements published since the last update, continuous mode only.
+  uint16_t measurements_{0};
   uint8_t stop_variable_;
+
+  static std::vector<VL53L0XSensor *> all_sensors;
+  static bool reset_done;
 };
 
 }  // namespace vl53l0x
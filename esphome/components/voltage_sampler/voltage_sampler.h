@@ -10,6 +10,22 @@ class VoltageSampler {
  public:
   /// Get a voltage reading, in V.
   virtual float sample() = 0;
+
+  /// Whether this sampler takes samples on its own at a fixed rate, which are then fetched with read_samples().
+  virtual bool is_continuous() { return false; }
+
+  /** Fetch the samples that have been taken since the last call, oldest first.
+   *
+   * Only supported by continuous samplers, others always return 0.
+   *
+   * @param samples Receives the voltages in V.
+   * @param max_count The maximum number of samples to return.
+   * @return The number of samples written to samples, less than max_count once all samples have been read.
+   */
+  virtual size_t read_samples(float *samples, size_t max_count) { return 0; }
+
+  /// The rate at which a continuous sampler takes samples, in Hz. 0 for the others.
+  virtual uint32_t get_sample_rate() { return 0; }
 };
 
 }  // namespace voltage_sampler
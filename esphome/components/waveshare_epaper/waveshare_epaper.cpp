@@ -72,6 +72,12 @@ static const uint8_t PARTIAL_UPDATE_LUT_TTGO[LUT_SIZE_TTGO] = {
 
 void WaveshareEPaper::setup_pins_() {
   this->init_internal_(this->get_buffer_length_());
+  if (this->get_width_internal() % 8 == 0) {
+    this->refresh_planner_.init(this->get_width_internal() / 8u, this->get_height_internal());
+  } else {
+    // rows don't start at a byte boundary, compare the buffer as one long row
+    this->refresh_planner_.init(this->get_buffer_length_(), 1);
+  }
   this->dc_pin_->setup();  // OUTPUT
   this->dc_pin_->digital_write(false);
   if (this->reset_pin_ != nullptr) {
@@ -112,7 +118,16 @@ bool WaveshareEPaper::wait_until_idle_() {
   return true;
 }
 void WaveshareEPaper::update() {
+  if (this->sending_) {
+    ESP_LOGV(TAG, "Still sending the last frame, skipping update");
+    return;
+  }
   this->do_update_();
+  this->refresh_ = this->refresh_planner_.plan(this->buffer_);
+  if (this->refresh_.mode == display::EPAPER_REFRESH_NONE) {
+    ESP_LOGV(TAG, "Nothing changed, skipping refresh");
+    return;
+  }
   this->display();
 }
 void WaveshareEPaper::fill(Color color) {
@@ -133,6 +148,56 @@ void HOT WaveshareEPaper::draw_absolute_pixel_internal(int x, int y, Color color
   else
     this->buffer_[pos] &= ~(0x80 >> subpos);
 }
+void HOT WaveshareEPaper::fill_rect_internal(int x, int y, int width, int height, Color color) {
+  if (this->get_width_internal() % 8 != 0) {
+    // rows don't start at a byte boundary
+    display::DisplayBuffer::fill_rect_internal(x, y, width, height, color);
+    return;
+  }
+
+  const uint32_t stride = this->get_width_internal() / 8u;
+  // flip logic
+  const uint8_t value = color.is_on() ? 0x00 : 0xFF;
+  const int first_byte = x / 8;
+  const int last_byte = (x + width - 1) / 8;
+  uint8_t first_mask = 0xFF >> (x & 0x07);
+  const uint8_t last_mask = 0xFF << (7 - ((x + width - 1) & 0x07));
+  if (first_byte == last_byte)
+    first_mask &= last_mask;
+  for (int row = y; row < y + height; row++) {
+    uint8_t *line = this->buffer_ + row * stride;
+    line[first_byte] = (line[first_byte] & ~first_mask) | (value & first_mask);
+    if (first_byte == last_byte)
+      continue;
+    memset(line + first_byte + 1, value, last_byte - first_byte - 1);
+    line[last_byte] = (line[last_byte] & ~last_mask) | (value & last_mask);
+  }
+}
+void HOT WaveshareEPaper::blit_internal(int x, int y, display::Image *image, int src_x, int src_y, int width,
+                                        int height, Color color_on, Color color_off) {
+  // binary images have the same bit layout as the buffer, byte aligned parts can be copied
+  if (image->get_type() != display::IMAGE_TYPE_BINARY || color_on.is_on() == color_off.is_on() || x % 8 != 0 ||
+      src_x % 8 != 0 || this->get_width_internal() % 8 != 0) {
+    display::DisplayBuffer::blit_internal(x, y, image, src_x, src_y, width, height, color_on, color_off);
+    return;
+  }
+
+  const uint32_t stride = this->get_width_internal() / 8u;
+  const uint32_t img_stride = (image->get_width() + 7u) / 8u;
+  // flip logic, a set bit in the buffer is an off pixel
+  const uint8_t invert = color_on.is_on() ? 0xFF : 0x00;
+  const int full_bytes = width / 8;
+  const uint8_t last_mask = 0xFF << (8 - width % 8);
+  const uint8_t *data = image->get_frame_data();
+  for (int row = 0; row < height; row++) {
+    uint8_t *dst = this->buffer_ + (y + row) * stride + x / 8;
+    const uint8_t *src = data + (src_y + row) * img_stride + src_x / 8;
+    for (int i = 0; i < full_bytes; i++)
+      *dst++ = pgm_read_byte(src++) ^ invert;
+    if (width % 8 != 0)
+      *dst = (*dst & ~last_mask) | ((pgm_read_byte(src) ^ invert) & last_mask);
+  }
+}
 uint32_t WaveshareEPaper::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal() / 8u; }
 void WaveshareEPaper::start_command_() {
   this->dc_pin_->digital_write(false);
@@ -144,7 +209,13 @@ void WaveshareEPaper::start_data_() {
   this->enable();
 }
 void WaveshareEPaper::end_data_() { this->disable(); }
-void WaveshareEPaper::on_safe_shutdown() { this->deep_sleep(); }
+void WaveshareEPaper::on_safe_shutdown() {
+  if (this->sending_) {
+    this->cancel_steps("send");
+    this->sending_ = false;
+  }
+  this->deep_sleep();
+}
 
 // ========================================================
 //                          Type A
@@ -185,6 +256,9 @@ void WaveshareEPaperTypeA::initialize() {
     this->data(0x00);
     this->data(0x80);
   }
+
+  // a tile may be partially refreshed full_update_every - 1 times before the next full refresh
+  this->refresh_planner_.set_max_partial_refreshes(this->full_update_every_ >= 2 ? this->full_update_every_ - 1 : 0);
 }
 void WaveshareEPaperTypeA::dump_config() {
   LOG_DISPLAY("", "Waveshare E-Paper", this);
@@ -215,56 +289,70 @@ void WaveshareEPaperTypeA::dump_config() {
   LOG_UPDATE_INTERVAL(this);
 }
 void HOT WaveshareEPaperTypeA::display() {
-  bool full_update = this->at_update_ == 0;
-  bool prev_full_update = this->at_update_ == 1;
+  const bool full_update = this->refresh_.mode != display::EPAPER_REFRESH_PARTIAL;
 
   if (!this->wait_until_idle_()) {
     this->status_set_warning();
+    this->refresh_planner_.request_full();
     return;
   }
 
-  if (this->full_update_every_ >= 2) {
-    if (full_update != prev_full_update) {
-      if (this->model_ == TTGO_EPAPER_2_13_IN) {
-        this->write_lut_(full_update ? FULL_UPDATE_LUT_TTGO : PARTIAL_UPDATE_LUT_TTGO, LUT_SIZE_TTGO);
-      } else if (this->model_ == TTGO_EPAPER_2_13_IN_B73) {
-        this->write_lut_(full_update ? FULL_UPDATE_LUT_TTGO_B73 : PARTIAL_UPDATE_LUT_TTGO_B73, LUT_SIZE_TTGO_B73);
-      } else {
-        this->write_lut_(full_update ? FULL_UPDATE_LUT : PARTIAL_UPDATE_LUT, LUT_SIZE_WAVESHARE);
-      }
+  if (this->full_update_every_ >= 2 && full_update != this->full_lut_loaded_) {
+    if (this->model_ == TTGO_EPAPER_2_13_IN) {
+      this->write_lut_(full_update ? FULL_UPDATE_LUT_TTGO : PARTIAL_UPDATE_LUT_TTGO, LUT_SIZE_TTGO);
+    } else if (this->model_ == TTGO_EPAPER_2_13_IN_B73) {
+      this->write_lut_(full_update ? FULL_UPDATE_LUT_TTGO_B73 : PARTIAL_UPDATE_LUT_TTGO_B73, LUT_SIZE_TTGO_B73);
+    } else {
+      this->write_lut_(full_update ? FULL_UPDATE_LUT : PARTIAL_UPDATE_LUT, LUT_SIZE_WAVESHARE);
     }
-    this->at_update_ = (this->at_update_ + 1) % this->full_update_every_;
+    this->full_lut_loaded_ = full_update;
+  }
+
+  // the controller keeps the rest of its RAM, partial refreshes only write the changed window
+  const uint32_t stride = this->get_width_internal() / 8u;
+  uint32_t x = 0, y = 0, width = stride, height = this->get_height_internal();
+  if (!full_update) {
+    x = this->refresh_.x;
+    y = this->refresh_.y;
+    width = this->refresh_.width;
+    height = this->refresh_.height;
   }
 
-  // Set x & y regions we want to write to (full)
+  // Set x & y regions we want to write to
   // COMMAND SET RAM X ADDRESS START END POSITION
   this->command(0x44);
-  this->data(0x00);
-  this->data((this->get_width_internal() - 1) >> 3);
+  this->data(x);
+  this->data(x + width - 1);
   // COMMAND SET RAM Y ADDRESS START END POSITION
   this->command(0x45);
-  this->data(0x00);
-  this->data(0x00);
-  this->data(this->get_height_internal() - 1);
-  this->data((this->get_height_internal() - 1) >> 8);
+  this->data(y);
+  this->data(y >> 8);
+  this->data(y + height - 1);
+  this->data((y + height - 1) >> 8);
 
   // COMMAND SET RAM X ADDRESS COUNTER
   this->command(0x4E);
-  this->data(0x00);
+  this->data(x);
   // COMMAND SET RAM Y ADDRESS COUNTER
   this->command(0x4F);
-  this->data(0x00);
-  this->data(0x00);
+  this->data(y);
+  this->data(y >> 8);
 
   if (!this->wait_until_idle_()) {
     this->status_set_warning();
+    this->refresh_planner_.request_full();
     return;
   }
 
   // COMMAND WRITE RAM
   this->command(0x24);
   this->start_data_();
-  this->write_array(this->buffer_, this->get_buffer_length_());
+  if (width == stride) {
+    this->write_array(this->buffer_ + y * stride, width * height);
+  } else {
+    for (uint32_t row = y; row < y + height; row++)
+      this->write_array(this->buffer_ + row * stride + x, width);
+  }
   this->end_data_();
 
   // COMMAND DISPLAY UPDATE CONTROL 2
@@ -816,30 +904,42 @@ void WaveshareEPaper7P5In::initialize() {
 void HOT WaveshareEPaper7P5In::display() {
   // COMMAND DATA START TRANSMISSION 1
   this->command(0x10);
-  this->start_data_();
-  for (size_t i = 0; i < this->get_buffer_length_(); i++) {
-    uint8_t temp1 = this->buffer_[i];
-    for (uint8_t j = 0; j < 8; j++) {
-      uint8_t temp2;
-      if (temp1 & 0x80)
-        temp2 = 0x03;
-      else
-        temp2 = 0x00;
-      temp2 <<= 4;
-      temp1 <<= 1;
-      j++;
-      if (temp1 & 0x80)
-        temp2 |= 0x03;
-      else
-        temp2 |= 0x00;
-      temp1 <<= 1;
-      this->write_byte(temp2);
+  // the converted buffer is 120kB, send it one row per step
+  this->sending_ = true;
+  this->send_row_ = 0;
+  this->run_steps("send", 20, [this]() {
+    const uint32_t stride = this->get_width_internal() / 8u;
+    const uint8_t *row = this->buffer_ + this->send_row_ * stride;
+    // the bus is released between the steps for other devices
+    this->start_data_();
+    for (uint32_t i = 0; i < stride; i++) {
+      uint8_t temp1 = row[i];
+      for (uint8_t j = 0; j < 8; j++) {
+        uint8_t temp2;
+        if (temp1 & 0x80)
+          temp2 = 0x03;
+        else
+          temp2 = 0x00;
+        temp2 <<= 4;
+        temp1 <<= 1;
+        j++;
+        if (temp1 & 0x80)
+          temp2 |= 0x03;
+        else
+          temp2 |= 0x00;
+        temp1 <<= 1;
+        this->write_byte(temp2);
+      }
     }
-    App.feed_wdt();
-  }
-  this->end_data_();
-  // COMMAND DISPLAY REFRESH
-  this->command(0x12);
+    this->end_data_();
+    if (++this->send_row_ < uint32_t(this->get_height_internal()))
+      return false;
+
+    // COMMAND DISPLAY REFRESH
+    this->command(0x12);
+    this->sending_ = false;
+    return true;
+  });
 }
 int WaveshareEPaper7P5In::get_width_internal() { return 640; }
 int WaveshareEPaper7P5In::get_height_internal() { return 384; }
@@ -884,18 +984,29 @@ void WaveshareEPaper7P5InV2::initialize() {
   this->data(0x22);
 }
 void HOT WaveshareEPaper7P5InV2::display() {
-  uint32_t buf_len = this->get_buffer_length_();
   // COMMAND DATA START TRANSMISSION NEW DATA
   this->command(0x13);
   delay(2);
-  for (uint32_t i = 0; i < buf_len; i++) {
-    this->data(~(this->buffer_[i]));
-  }
+  // send the 48kB buffer one row per step
+  this->sending_ = true;
+  this->send_row_ = 0;
+  this->run_steps("send", 20, [this]() {
+    const uint32_t stride = this->get_width_internal() / 8u;
+    const uint8_t *row = this->buffer_ + this->send_row_ * stride;
+    this->start_data_();
+    for (uint32_t i = 0; i < stride; i++)
+      this->write_byte(~row[i]);
+    this->end_data_();
+    if (++this->send_row_ < uint32_t(this->get_height_internal()))
+      return false;
 
-  // COMMAND DISPLAY REFRESH
-  this->command(0x12);
-  delay(100);  // NOLINT
-  this->wait_until_idle_();
+    // COMMAND DISPLAY REFRESH
+    this->command(0x12);
+    delay(100);  // NOLINT
+    this->wait_until_idle_();
+    this->sending_ = false;
+    return true;
+  });
 }
 
 int WaveshareEPaper7P5InV2::get_width_internal() { return 800; }
@@ -3,6 +3,7 @@
 #include "esphome/core/component.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/epaper_refresh.h"
 
 namespace esphome {
 namespace waveshare_epaper {
@@ -37,6 +38,9 @@ class WaveshareEPaper : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_rect_internal(int x, int y, int width, int height, Color color) override;
+  void blit_internal(int x, int y, display::Image *image, int src_x, int src_y, int width, int height, Color color_on,
+                     Color color_off) override;
 
   bool wait_until_idle_();
 
@@ -61,6 +65,14 @@ class WaveshareEPaper : public PollingComponent,
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *dc_pin_;
   GPIOPin *busy_pin_{nullptr};
+  /// Models without partial refreshes only use it to skip unchanged frames.
+  display::EPaperRefreshPlanner refresh_planner_;
+  /// The refresh display() should do.
+  display::EPaperRefresh refresh_{display::EPAPER_REFRESH_FULL, 0, 0, 0, 0};
+  /// Models that send the buffer in steps (see Component::run_steps()) don't draw a new frame until it is sent.
+  bool sending_{false};
+  /// The next row of the buffer to send.
+  uint32_t send_row_{0};
 };
 
 enum WaveshareEPaperTypeAModel {
@@ -104,7 +116,8 @@ class WaveshareEPaperTypeA : public WaveshareEPaper {
   int get_height_internal() override;
 
   uint32_t full_update_every_{30};
-  uint32_t at_update_{0};
+  /// Whether the full update LUT is loaded, the controller starts without one.
+  bool full_lut_loaded_{false};
   WaveshareEPaperTypeAModel model_;
 };
 
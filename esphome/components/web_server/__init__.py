@@ -1,14 +1,18 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import web_server_base
-from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID
+from esphome.components.web_server_base import CONF_WEB_SERVER_BASE_ID, gzip_asset
 from esphome.const import (
-    CONF_CSS_INCLUDE, CONF_CSS_URL, CONF_ID, CONF_JS_INCLUDE, CONF_JS_URL, CONF_PORT,
+    CONF_CSS_INCLUDE, CONF_CSS_URL, CONF_ID, CONF_JS_INCLUDE, CONF_JS_URL, CONF_MIN_INTERVAL, CONF_PORT,
     CONF_AUTH, CONF_USERNAME, CONF_PASSWORD)
 from esphome.core import coroutine_with_priority
 
 AUTO_LOAD = ['json', 'web_server_base']
 
+CONF_CSS_INCLUDE_DATA_ID = 'css_include_data_id'
+CONF_JS_INCLUDE_DATA_ID = 'js_include_data_id'
+CONF_WEBSOCKET = 'websocket'
+
 web_server_ns = cg.esphome_ns.namespace('web_server')
 WebServer = web_server_ns.class_('WebServer', cg.Component, cg.Controller)
 
@@ -17,12 +21,17 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Optional(CONF_PORT, default=80): cv.port,
     cv.Optional(CONF_CSS_URL, default="https://esphome.io/_static/webserver-v1.min.css"): cv.string,
     cv.Optional(CONF_CSS_INCLUDE): cv.file_,
+    cv.GenerateID(CONF_CSS_INCLUDE_DATA_ID): cv.declare_id(cg.uint8),
     cv.Optional(CONF_JS_URL, default="https://esphome.io/_static/webserver-v1.min.js"): cv.string,
     cv.Optional(CONF_JS_INCLUDE): cv.file_,
+    cv.GenerateID(CONF_JS_INCLUDE_DATA_ID): cv.declare_id(cg.uint8),
     cv.Optional(CONF_AUTH): cv.Schema({
         cv.Required(CONF_USERNAME): cv.string_strict,
         cv.Required(CONF_PASSWORD): cv.string_strict,
     }),
+    cv.Optional(CONF_WEBSOCKET): cv.Schema({
+        cv.Optional(CONF_MIN_INTERVAL, default='100ms'): cv.positive_time_period_milliseconds,
+    }),
 
     cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(web_server_base.WebServerBase),
 }).extend(cv.COMPONENT_SCHEMA)
@@ -44,9 +53,10 @@ def to_code(config):
         cg.add(var.set_password(config[CONF_AUTH][CONF_PASSWORD]))
     if CONF_CSS_INCLUDE in config:
         cg.add_define('WEBSERVER_CSS_INCLUDE')
-        with open(config[CONF_CSS_INCLUDE], "r") as myfile:
-            cg.add(var.set_css_include(myfile.read()))
+        cg.add(var.set_css_include(*gzip_asset(config[CONF_CSS_INCLUDE_DATA_ID], config[CONF_CSS_INCLUDE])))
     if CONF_JS_INCLUDE in config:
         cg.add_define('WEBSERVER_JS_INCLUDE')
-        with open(config[CONF_JS_INCLUDE], "r") as myfile:
-            cg.add(var.set_js_include(myfile.read()))
+        cg.add(var.set_js_include(*gzip_asset(config[CONF_JS_INCLUDE_DATA_ID], config[CONF_JS_INCLUDE])))
+    if CONF_WEBSOCKET in config:
+        cg.add_define('WEBSERVER_WEBSOCKET')
+        cg.add(var.set_websocket_min_interval(config[CONF_WEBSOCKET][CONF_MIN_INTERVAL]))
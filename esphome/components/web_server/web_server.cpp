@@ -3,10 +3,13 @@
 #include "esphome/core/application.h"
 #include "esphome/core/util.h"
 #include "esphome/components/json/json_util.h"
+#include "esphome/components/json/json_writer.h"
 
 #include "StreamString.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <memory>
 
 #ifdef USE_LOGGER
 #include <esphome/components/logger/logger.h>
@@ -17,21 +20,21 @@ namespace web_server {
 
 static const char *TAG = "web_server";
 
-void write_row(AsyncResponseStream *stream, Nameable *obj, const std::string &klass, const std::string &action) {
-  if (obj->is_internal())
-    return;
-  stream->print("<tr class=\"");
-  stream->print(klass.c_str());
-  stream->print("\" id=\"");
-  stream->print(klass.c_str());
-  stream->print("-");
-  stream->print(obj->get_object_id().c_str());
-  stream->print("\"><td>");
-  stream->print(obj->get_name().c_str());
-  stream->print("</td><td></td><td>");
-  stream->print(action.c_str());
-  stream->print("</td>");
-  stream->print("</tr>");
+/// The largest body of a batch request, larger ones are rejected.
+static const size_t WEBSERVER_MAX_BATCH_SIZE = 4096;
+
+/// Write the "id" member, the domain prefix followed by the object id.
+static void write_id(json::JsonWriter &writer, const char *prefix, Nameable *obj) {
+  writer.key("id").value(prefix, obj->get_object_id());
+}
+
+/// Append a string from PROGMEM.
+static void append_progmem(std::string &out, const __FlashStringHelper *str) {
+  PGM_P p = reinterpret_cast<PGM_P>(str);
+  const size_t len = strlen_P(p);
+  const size_t start = out.size();
+  out.resize(start + len);
+  memcpy_P(&out[start], p, len);
 }
 
 UrlMatch match_url(const std::string &url, bool only_domain = false) {
@@ -60,61 +63,199 @@ UrlMatch match_url(const std::string &url, bool only_domain = false) {
   return match;
 }
 
-void WebServer::set_css_url(const char *css_url) { this->css_url_ = css_url; }
-void WebServer::set_css_include(const char *css_include) { this->css_include_ = css_include; }
-void WebServer::set_js_url(const char *js_url) { this->js_url_ = js_url; }
-void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_include; }
+static uint8_t hex_value(char c) {
+  if (c >= 'a')
+    return c - 'a' + 10;
+  if (c >= 'A')
+    return c - 'A' + 10;
+  return c - '0';
+}
+static std::string url_decode(const char *begin, const char *end) {
+  std::string out;
+  out.reserve(end - begin);
+  for (const char *p = begin; p < end; p++) {
+    if (*p == '+') {
+      out += ' ';
+    } else if (*p == '%' && end - p > 2 && isxdigit(p[1]) && isxdigit(p[2])) {
+      out += char((hex_value(p[1]) << 4) | hex_value(p[2]));
+      p += 2;
+    } else {
+      out += *p;
+    }
+  }
+  return out;
+}
+/// Parse the query of a command, "name=value&name=value".
+static void parse_query(const char *begin, const char *end, CommandParams &params) {
+  while (begin < end) {
+    const char *param_end = std::find(begin, end, '&');
+    const char *eq = std::find(begin, param_end, '=');
+    if (eq != param_end)
+      params.add(url_decode(begin, eq), url_decode(eq + 1, param_end));
+    begin = param_end == end ? end : param_end + 1;
+  }
+}
+/// The query parameters of a request.
+static CommandParams request_params(AsyncWebServerRequest *request) {
+  CommandParams params;
+  for (size_t i = 0; i < request->params(); i++) {
+    AsyncWebParameter *param = request->getParam(i);
+    if (!param->isPost() && !param->isFile())
+      params.add(param->name().c_str(), param->value().c_str());
+  }
+  return params;
+}
+/// The entity if its object id is id, looking them up by the hash alone could hit another entity.
+template<typename T> static T *match_entity(T *obj, const std::string &id) {
+  return obj != nullptr && obj->get_object_id() == id ? obj : nullptr;
+}
 
-void WebServer::setup() {
-  ESP_LOGCONFIG(TAG, "Setting up web server...");
-  this->setup_controller();
-  this->base_->init();
+bool CommandParams::has(const char *name) const {
+  for (auto &param : this->params_)
+    if (param.first == name)
+      return true;
+  return false;
+}
+const std::string &CommandParams::get(const char *name) const {
+  static const std::string EMPTY;  // NOLINT
+  for (auto &param : this->params_)
+    if (param.first == name)
+      return param.second;
+  return EMPTY;
+}
+float CommandParams::get_float(const char *name) const { return strtof(this->get(name).c_str(), nullptr); }
 
-  this->events_.onConnect([this](AsyncEventSourceClient *client) {
-    // Configure reconnect timeout
-    client->send("", "ping", millis(), 30000);
+void WebServer::set_css_url(const char *css_url) { this->css_url_ = css_url; }
+void WebServer::set_css_include(const uint8_t *data, size_t size, const char *etag) {
+  this->css_include_ = data;
+  this->css_include_size_ = size;
+  this->css_include_etag_ = etag;
+}
+void WebServer::set_js_url(const char *js_url) { this->js_url_ = js_url; }
+void WebServer::set_js_include(const uint8_t *data, size_t size, const char *etag) {
+  this->js_include_ = data;
+  this->js_include_size_ = size;
+  this->js_include_etag_ = etag;
+}
 
+void WebServer::setup_entities_() {
+  auto add = [this](Nameable *obj, const char *klass, const char *action) {
+    if (obj->is_internal())
+      return;
+    this->state_cache_entries_.push_back(CachedState{obj, std::string()});
+    this->index_rows_.push_back(IndexRow{obj, klass, action});
+  };
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors())
+    add(obj, "sensor", "");
+#endif
+#ifdef USE_SWITCH
+  for (auto *obj : App.get_switches())
+    add(obj, "switch", "<button>Toggle</button>");
+#endif
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors())
+    add(obj, "binary_sensor", "");
+#endif
+#ifdef USE_FAN
+  for (auto *obj : App.get_fans())
+    add(obj, "fan", "<button>Toggle</button>");
+#endif
+#ifdef USE_LIGHT
+  for (auto *obj : App.get_lights())
+    add(obj, "light", "<button>Toggle</button>");
+#endif
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : App.get_text_sensors())
+    add(obj, "text_sensor", "");
+#endif
+#ifdef USE_COVER
+  for (auto *obj : App.get_covers())
+    add(obj, "cover", "<button>Open</button><button>Close</button>");
+#endif
+  std::sort(this->state_cache_entries_.begin(), this->state_cache_entries_.end(),
+            [](const CachedState &a, const CachedState &b) { return a.obj < b.obj; });
+}
+WebServer::CachedState *WebServer::find_cached_state_(const Nameable *obj) {
+  auto it = std::lower_bound(this->state_cache_entries_.begin(), this->state_cache_entries_.end(), obj,
+                             [](const CachedState &entry, const Nameable *obj) { return entry.obj < obj; });
+  if (it != this->state_cache_entries_.end() && it->obj == obj)
+    return &*it;
+  return nullptr;
+}
+std::string &WebServer::state_cache_(const Nameable *obj) {
+  CachedState *entry = this->find_cached_state_(obj);
+  if (entry != nullptr)
+    return entry->json;
+  // not cached (internal entities), render into a scratch buffer instead
+  this->uncached_json_.clear();
+  return this->uncached_json_;
+}
+void WebServer::send_state_(const Nameable *obj, const std::string &json) {
+  this->events_.send(json.c_str(), "state");
+#ifdef WEBSERVER_WEBSOCKET
+  CachedState *entry = this->find_cached_state_(obj);
+  if (entry != nullptr) {
+    entry->ws_dirty = true;
+    this->ws_dirty_ = true;
+  }
+#endif
+}
+void WebServer::for_each_state_(const std::function<void(const std::string &)> &f) {
 #ifdef USE_SENSOR
-    for (auto *obj : App.get_sensors())
-      if (!obj->is_internal())
-        client->send(this->sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_sensors())
+    if (!obj->is_internal())
+      f(this->cached_sensor_json_(obj));
 #endif
 
 #ifdef USE_SWITCH
-    for (auto *obj : App.get_switches())
-      if (!obj->is_internal())
-        client->send(this->switch_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_switches())
+    if (!obj->is_internal())
+      f(this->cached_switch_json_(obj));
 #endif
 
 #ifdef USE_BINARY_SENSOR
-    for (auto *obj : App.get_binary_sensors())
-      if (!obj->is_internal())
-        client->send(this->binary_sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_binary_sensors())
+    if (!obj->is_internal())
+      f(this->cached_binary_sensor_json_(obj));
 #endif
 
 #ifdef USE_FAN
-    for (auto *obj : App.get_fans())
-      if (!obj->is_internal())
-        client->send(this->fan_json(obj).c_str(), "state");
+  for (auto *obj : App.get_fans())
+    if (!obj->is_internal())
+      f(this->cached_fan_json_(obj));
 #endif
 
 #ifdef USE_LIGHT
-    for (auto *obj : App.get_lights())
-      if (!obj->is_internal())
-        client->send(this->light_json(obj).c_str(), "state");
+  for (auto *obj : App.get_lights())
+    if (!obj->is_internal())
+      f(this->cached_light_json_(obj));
 #endif
 
 #ifdef USE_TEXT_SENSOR
-    for (auto *obj : App.get_text_sensors())
-      if (!obj->is_internal())
-        client->send(this->text_sensor_json(obj, obj->state).c_str(), "state");
+  for (auto *obj : App.get_text_sensors())
+    if (!obj->is_internal())
+      f(this->cached_text_sensor_json_(obj));
 #endif
 
 #ifdef USE_COVER
-    for (auto *obj : App.get_covers())
-      if (!obj->is_internal())
-        client->send(this->cover_json(obj).c_str(), "state");
+  for (auto *obj : App.get_covers())
+    if (!obj->is_internal())
+      f(this->cached_cover_json_(obj));
 #endif
+}
+
+void WebServer::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up web server...");
+  this->setup_controller();
+  this->setup_entities_();
+  snprintf(this->index_etag_, sizeof(this->index_etag_), "\"%08x\"", fnv1_hash(App.get_compilation_time()));
+  this->base_->init();
+
+  this->events_.onConnect([this](AsyncEventSourceClient *client) {
+    // Configure reconnect timeout
+    client->send("", "ping", millis(), 30000);
+    this->for_each_state_([client](const std::string &json) { client->send(json.c_str(), "state"); });
   });
 
 #ifdef USE_LOGGER
@@ -123,6 +264,13 @@ void WebServer::setup() {
         [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
 #endif
   this->base_->add_handler(&this->events_);
+#ifdef WEBSERVER_WEBSOCKET
+  if (this->using_auth())
+    this->ws_.setAuthentication(this->username_, this->password_);
+  this->ws_.onEvent([this](AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg,
+                           uint8_t *data, size_t len) { this->on_ws_event_(client, type, arg, data, len); });
+  this->base_->add_handler(&this->ws_);
+#endif
   this->base_->add_handler(this);
   this->base_->add_ota_handler();
 
@@ -134,455 +282,800 @@ void WebServer::dump_config() {
   if (this->using_auth()) {
     ESP_LOGCONFIG(TAG, "  Basic authentication enabled");
   }
+#ifdef WEBSERVER_WEBSOCKET
+  ESP_LOGCONFIG(TAG, "  WebSocket Min Interval: %u ms", this->ws_min_interval_);
+#endif
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
 void WebServer::handle_index_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/html");
-  std::string title = App.get_name() + " Web Server";
-  stream->print(F("<!DOCTYPE html><html lang=\"en\"><head><meta charset=UTF-8><title>"));
-  stream->print(title.c_str());
-  stream->print(F("</title>"));
-#ifdef WEBSERVER_CSS_INCLUDE
-  stream->print(F("<link rel=\"stylesheet\" href=\"/0.css\">"));
-#endif
-  if (strlen(this->css_url_) > 0) {
-    stream->print(F("<link rel=\"stylesheet\" href=\""));
-    stream->print(this->css_url_);
-    stream->print(F("\">"));
+  if (web_server_base::etag_matches(request, this->index_etag_)) {
+    web_server_base::send_not_modified(request, this->index_etag_);
+    return;
   }
-  stream->print(F("</head><body><article class=\"markdown-body\"><h1>"));
-  stream->print(title.c_str());
-  stream->print(F("</h1><h2>States</h2><table id=\"states\"><thead><tr><th>Name<th>State<th>Actions<tbody>"));
-  // All content is controlled and created by user - so allowing all origins is fine here.
-  stream->addHeader("Access-Control-Allow-Origin", "*");
-
-#ifdef USE_SENSOR
-  for (auto *obj : App.get_sensors())
-    write_row(stream, obj, "sensor", "");
-#endif
-
-#ifdef USE_SWITCH
-  for (auto *obj : App.get_switches())
-    write_row(stream, obj, "switch", "<button>Toggle</button>");
-#endif
-
-#ifdef USE_BINARY_SENSOR
-  for (auto *obj : App.get_binary_sensors())
-    write_row(stream, obj, "binary_sensor", "");
-#endif
 
-#ifdef USE_FAN
-  for (auto *obj : App.get_fans())
-    write_row(stream, obj, "fan", "<button>Toggle</button>");
-#endif
+  // Stream the page in chunks, one piece at a time, so that large configs don't need the whole page in memory.
+  struct IndexPageState {
+    size_t piece{0};
+    std::string buffer;
+    size_t pos{0};
+    bool done{false};
+  };
+  std::shared_ptr<IndexPageState> state = std::make_shared<IndexPageState>();
+  AsyncWebServerResponse *response = request->beginChunkedResponse(
+      "text/html", [this, state](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        size_t written = 0;
+        while (written < max_len) {
+          if (state->pos == state->buffer.size()) {
+            if (state->done)
+              break;
+            state->buffer.clear();
+            state->pos = 0;
+            if (!this->write_index_piece_(state->piece++, state->buffer)) {
+              state->done = true;
+              break;
+            }
+          }
+          const size_t len = std::min(max_len - written, state->buffer.size() - state->pos);
+          memcpy(buffer + written, state->buffer.data() + state->pos, len);
+          state->pos += len;
+          written += len;
+        }
+        return written;
+      });
+  // All content is controlled and created by user - so allowing all origins is fine here.
+  response->addHeader("Access-Control-Allow-Origin", "*");
+  response->addHeader("ETag", this->index_etag_);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
 
-#ifdef USE_LIGHT
-  for (auto *obj : App.get_lights())
-    write_row(stream, obj, "light", "<button>Toggle</button>");
+bool WebServer::write_index_piece_(size_t piece, std::string &out) {
+  if (piece == 0) {
+    append_progmem(out, F("<!DOCTYPE html><html lang=\"en\"><head><meta charset=UTF-8><title>"));
+    out += App.get_name();
+    append_progmem(out, F(" Web Server</title>"));
+#ifdef WEBSERVER_CSS_INCLUDE
+    append_progmem(out, F("<link rel=\"stylesheet\" href=\"/0.css\">"));
 #endif
+    if (strlen(this->css_url_) > 0) {
+      append_progmem(out, F("<link rel=\"stylesheet\" href=\""));
+      out += this->css_url_;
+      append_progmem(out, F("\">"));
+    }
+    append_progmem(out, F("</head><body><article class=\"markdown-body\"><h1>"));
+    out += App.get_name();
+    append_progmem(out, F(" Web Server</h1><h2>States</h2><table id=\"states\"><thead><tr><th>Name<th>State"
+                          "<th>Actions<tbody>"));
+    return true;
+  }
 
-#ifdef USE_TEXT_SENSOR
-  for (auto *obj : App.get_text_sensors())
-    write_row(stream, obj, "text_sensor", "");
-#endif
+  const size_t row = piece - 1;
+  if (row < this->index_rows_.size()) {
+    const IndexRow &entry = this->index_rows_[row];
+    append_progmem(out, F("<tr class=\""));
+    out += entry.klass;
+    append_progmem(out, F("\" id=\""));
+    out += entry.klass;
+    out += '-';
+    out += entry.obj->get_object_id();
+    append_progmem(out, F("\"><td>"));
+    out += entry.obj->get_name();
+    append_progmem(out, F("</td><td></td><td>"));
+    out += entry.action;
+    append_progmem(out, F("</td></tr>"));
+    return true;
+  }
 
-#ifdef USE_COVER
-  for (auto *obj : App.get_covers())
-    write_row(stream, obj, "cover", "<button>Open</button><button>Close</button>");
-#endif
+  if (row > this->index_rows_.size())
+    return false;
 
-  stream->print(F("</tbody></table><p>See <a href=\"https://esphome.io/web-api/index.html\">ESPHome Web API</a> for "
-                  "REST API documentation.</p>"
-                  "<h2>OTA Update</h2><form method=\"POST\" action=\"/update\" enctype=\"multipart/form-data\"><input "
-                  "type=\"file\" name=\"update\"><input type=\"submit\" value=\"Update\"></form>"
-                  "<h2>Debug Log</h2><pre id=\"log\"></pre>"));
+  append_progmem(out, F("</tbody></table><p>See <a href=\"https://esphome.io/web-api/index.html\">ESPHome Web API</a> "
+                        "for REST API documentation.</p>"
+                        "<h2>OTA Update</h2><form method=\"POST\" action=\"/update\" enctype=\"multipart/form-data\">"
+                        "<input type=\"file\" name=\"update\"><input type=\"submit\" value=\"Update\"></form>"
+                        "<h2>Debug Log</h2><pre id=\"log\"></pre>"));
 #ifdef WEBSERVER_JS_INCLUDE
   if (this->js_include_ != nullptr) {
-    stream->print(F("<script src=\"/0.js\"></script>"));
+    append_progmem(out, F("<script src=\"/0.js\"></script>"));
   }
 #endif
   if (strlen(this->js_url_) > 0) {
-    stream->print(F("<script src=\""));
-    stream->print(this->js_url_);
-    stream->print(F("\"></script>"));
+    append_progmem(out, F("<script src=\""));
+    out += this->js_url_;
+    append_progmem(out, F("\"></script>"));
   }
-  stream->print(F("</article></body></html>"));
-
-  request->send(stream);
+  append_progmem(out, F("</article></body></html>"));
+  return true;
 }
 
 #ifdef WEBSERVER_CSS_INCLUDE
 void WebServer::handle_css_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/css");
-  if (this->css_include_ != nullptr) {
-    stream->print(this->css_include_);
-  }
-
-  request->send(stream);
+  web_server_base::send_gzip_asset(request, "text/css", this->css_include_, this->css_include_size_,
+                                   this->css_include_etag_);
 }
 #endif
 
 #ifdef WEBSERVER_JS_INCLUDE
 void WebServer::handle_js_request(AsyncWebServerRequest *request) {
-  AsyncResponseStream *stream = request->beginResponseStream("text/javascript");
-  if (this->js_include_ != nullptr) {
-    stream->print(this->js_include_);
-  }
-
-  request->send(stream);
+  web_server_base::send_gzip_asset(request, "text/javascript", this->js_include_, this->js_include_size_,
+                                   this->js_include_etag_);
 }
 #endif
 
 #ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state).c_str(), "state");
+  std::string &json = this->state_cache_(obj);
+  json.clear();
+  this->write_sensor_json_(json, obj, state);
+  this->send_state_(obj, json);
 }
+#endif
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, UrlMatch match) {
-  for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->is_internal())
-      continue;
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  sensor::Sensor *obj = App.get_sensor_by_key(fnv1_hash(match.id));
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  const std::string &data = this->cached_sensor_json_(obj);
+  request->send(200, "text/json", data.c_str());
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "sensor-" + obj->get_object_id();
-    std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-    if (!obj->get_unit_of_measurement().empty())
-      state += " " + obj->get_unit_of_measurement();
-    root["state"] = state;
-    root["value"] = value;
-  });
+  std::string out;
+  this->write_sensor_json_(out, obj, value);
+  return out;
+}
+void WebServer::write_sensor_json_(std::string &out, sensor::Sensor *obj, float value) {
+  json::JsonWriter writer(out);
+  writer.begin_object();
+  write_id(writer, "sensor-", obj);
+  std::string state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
+  const std::string unit = obj->get_unit_of_measurement();
+  if (!unit.empty()) {
+    state += ' ';
+    state += unit;
+  }
+  writer.key("state").value(state);
+  writer.key("value").value(value);
+  writer.end_object();
+}
+const std::string &WebServer::cached_sensor_json_(sensor::Sensor *obj) {
+  std::string &json = this->state_cache_(obj);
+  if (json.empty())
+    this->write_sensor_json_(json, obj, obj->state);
+  return json;
 }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, std::string state) {
-  this->events_.send(this->text_sensor_json(obj, state).c_str(), "state");
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
+  std::string &json = this->state_cache_(obj);
+  json.clear();
+  this->write_text_sensor_json_(json, obj, state);
+  this->send_state_(obj, json);
 }
+#endif
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, UrlMatch match) {
-  for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->is_internal())
-      continue;
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->text_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  text_sensor::TextSensor *obj = App.get_text_sensor_by_key(fnv1_hash(match.id));
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  const std::string &data = this->cached_text_sensor_json_(obj);
+  request->send(200, "text/json", data.c_str());
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "text_sensor-" + obj->get_object_id();
-    root["state"] = value;
-    root["value"] = value;
-  });
+  std::string out;
+  this->write_text_sensor_json_(out, obj, value);
+  return out;
+}
+void WebServer::write_text_sensor_json_(std::string &out, text_sensor::TextSensor *obj, const std::string &value) {
+  json::JsonWriter writer(out);
+  writer.begin_object();
+  write_id(writer, "text_sensor-", obj);
+  writer.key("state").value(value);
+  writer.key("value").value(value);
+  writer.end_object();
+}
+const std::string &WebServer::cached_text_sensor_json_(text_sensor::TextSensor *obj) {
+  std::string &json = this->state_cache_(obj);
+  if (json.empty())
+    this->write_text_sensor_json_(json, obj, obj->state);
+  return json;
 }
 #endif
 
 #ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state).c_str(), "state");
+  std::string &json = this->state_cache_(obj);
+  json.clear();
+  this->write_switch_json_(json, obj, state);
+  this->send_state_(obj, json);
 }
+#endif
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "switch-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
-  });
+  std::string out;
+  this->write_switch_json_(out, obj, value);
+  return out;
+}
+void WebServer::write_switch_json_(std::string &out, switch_::Switch *obj, bool value) {
+  json::JsonWriter writer(out);
+  writer.begin_object();
+  write_id(writer, "switch-", obj);
+  writer.key("state").value(value ? "ON" : "OFF");
+  writer.key("value").value(value);
+  writer.end_object();
+}
+const std::string &WebServer::cached_switch_json_(switch_::Switch *obj) {
+  std::string &json = this->state_cache_(obj);
+  if (json.empty())
+    this->write_switch_json_(json, obj, obj->state);
+  return json;
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, UrlMatch match) {
-  for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->is_internal())
-      continue;
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->switch_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      this->defer([obj]() { obj->turn_on(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  switch_::Switch *obj = App.get_switch_by_key(fnv1_hash(match.id));
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_GET) {
+    const std::string &data = this->cached_switch_json_(obj);
+    request->send(200, "text/json", data.c_str());
+  } else {
+    request->send(this->switch_command_(obj, match.method, request_params(request)));
+  }
+}
+int WebServer::switch_command_(switch_::Switch *obj, const std::string &method, const CommandParams &params) {
+  if (method == "toggle") {
+    this->defer([obj]() { obj->toggle(); });
+  } else if (method == "turn_on") {
+    this->defer([obj]() { obj->turn_on(); });
+  } else if (method == "turn_off") {
+    this->defer([obj]() { obj->turn_off(); });
+  } else {
+    return 404;
+  }
+  return 200;
 }
 #endif
 
 #ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
+  std::string &json = this->state_cache_(obj);
+  json.clear();
+  this->write_binary_sensor_json_(json, obj, state);
+  this->send_state_(obj, json);
 }
+#endif
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
-  return json::build_json([obj, value](JsonObject &root) {
-    root["id"] = "binary_sensor-" + obj->get_object_id();
-    root["state"] = value ? "ON" : "OFF";
-    root["value"] = value;
-  });
+  std::string out;
+  this->write_binary_sensor_json_(out, obj, value);
+  return out;
+}
+void WebServer::write_binary_sensor_json_(std::string &out, binary_sensor::BinarySensor *obj, bool value) {
+  json::JsonWriter writer(out);
+  writer.begin_object();
+  write_id(writer, "binary_sensor-", obj);
+  writer.key("state").value(value ? "ON" : "OFF");
+  writer.key("value").value(value);
+  writer.end_object();
+}
+const std::string &WebServer::cached_binary_sensor_json_(binary_sensor::BinarySensor *obj) {
+  std::string &json = this->state_cache_(obj);
+  if (json.empty())
+    this->write_binary_sensor_json_(json, obj, obj->state);
+  return json;
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, UrlMatch match) {
-  for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->is_internal())
-      continue;
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->binary_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  binary_sensor::BinarySensor *obj = App.get_binary_sensor_by_key(fnv1_hash(match.id));
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  const std::string &data = this->cached_binary_sensor_json_(obj);
+  request->send(200, "text/json", data.c_str());
 }
 #endif
 
 #ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
 void WebServer::on_fan_update(fan::FanState *obj) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->fan_json(obj).c_str(), "state");
+  std::string &json = this->state_cache_(obj);
+  json.clear();
+  this->write_fan_json_(json, obj);
+  this->send_state_(obj, json);
 }
+#endif
 std::string WebServer::fan_json(fan::FanState *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "fan-" + obj->get_object_id();
-    root["state"] = obj->state ? "ON" : "OFF";
-    root["value"] = obj->state;
-    if (obj->get_traits().supports_speed()) {
-      switch (obj->speed) {
-        case fan::FAN_SPEED_LOW:
-          root["speed"] = "low";
-          break;
-        case fan::FAN_SPEED_MEDIUM:
-          root["speed"] = "medium";
-          break;
-        case fan::FAN_SPEED_HIGH:
-          root["speed"] = "high";
-          break;
-      }
+  std::string out;
+  this->write_fan_json_(out, obj);
+  return out;
+}
+void WebServer::write_fan_json_(std::string &out, fan::FanState *obj) {
+  json::JsonWriter writer(out);
+  writer.begin_object();
+  write_id(writer, "fan-", obj);
+  writer.key("state").value(obj->state ? "ON" : "OFF");
+  writer.key("value").value(obj->state);
+  if (obj->get_traits().supports_speed()) {
+    switch (obj->speed) {
+      case fan::FAN_SPEED_LOW:
+        writer.key("speed").value("low");
+        break;
+      case fan::FAN_SPEED_MEDIUM:
+        writer.key("speed").value("medium");
+        break;
+      case fan::FAN_SPEED_HIGH:
+        writer.key("speed").value("high");
+        break;
     }
-    if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
-  });
+  }
+  if (obj->get_traits().supports_oscillation())
+    writer.key("oscillation").value(obj->oscillating);
+  writer.end_object();
+}
+const std::string &WebServer::cached_fan_json_(fan::FanState *obj) {
+  std::string &json = this->state_cache_(obj);
+  if (json.empty())
+    this->write_fan_json_(json, obj);
+  return json;
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, UrlMatch match) {
-  for (fan::FanState *obj : App.get_fans()) {
-    if (obj->is_internal())
-      continue;
-    if (obj->get_object_id() != match.id)
-      continue;
+  fan::FanState *obj = App.get_fan_by_key(fnv1_hash(match.id));
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
+    return;
+  }
 
-    if (request->method() == HTTP_GET) {
-      std::string data = this->fan_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("speed")) {
-        String speed = request->getParam("speed")->value();
-        call.set_speed(speed.c_str());
-      }
-      if (request->hasParam("oscillation")) {
-        String speed = request->getParam("oscillation")->value();
-        auto val = parse_on_off(speed.c_str());
-        switch (val) {
-          case PARSE_ON:
-            call.set_oscillating(true);
-            break;
-          case PARSE_OFF:
-            call.set_oscillating(false);
-            break;
-          case PARSE_TOGGLE:
-            call.set_oscillating(!obj->oscillating);
-            break;
-          case PARSE_NONE:
-            request->send(404);
-            return;
-        }
+  if (request->method() == HTTP_GET) {
+    const std::string &data = this->cached_fan_json_(obj);
+    request->send(200, "text/json", data.c_str());
+  } else {
+    request->send(this->fan_command_(obj, match.method, request_params(request)));
+  }
+}
+int WebServer::fan_command_(fan::FanState *obj, const std::string &method, const CommandParams &params) {
+  if (method == "toggle") {
+    this->defer([obj]() { obj->toggle().perform(); });
+  } else if (method == "turn_on") {
+    auto call = obj->turn_on();
+    if (params.has("speed"))
+      call.set_speed(params.get("speed").c_str());
+    if (params.has("oscillation")) {
+      auto val = parse_on_off(params.get("oscillation").c_str());
+      switch (val) {
+        case PARSE_ON:
+          call.set_oscillating(true);
+          break;
+        case PARSE_OFF:
+          call.set_oscillating(false);
+          break;
+        case PARSE_TOGGLE:
+          call.set_oscillating(!obj->oscillating);
+          break;
+        case PARSE_NONE:
+          return 404;
       }
-      this->defer([call]() { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off().perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->defer([call]() { call.perform(); });
+  } else if (method == "turn_off") {
+    this->defer([obj]() { obj->turn_off().perform(); });
+  } else {
+    return 404;
   }
-  request->send(404);
+  return 200;
 }
 #endif
 
 #ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
 void WebServer::on_light_update(light::LightState *obj) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->light_json(obj).c_str(), "state");
+  std::string &json = this->state_cache_(obj);
+  json = this->light_json(obj);
+  this->send_state_(obj, json);
 }
+#endif
 void WebServer::handle_light_request(AsyncWebServerRequest *request, UrlMatch match) {
-  for (light::LightState *obj : App.get_lights()) {
-    if (obj->is_internal())
-      continue;
-    if (obj->get_object_id() != match.id)
-      continue;
+  light::LightState *obj = App.get_light_by_key(fnv1_hash(match.id));
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
+    return;
+  }
 
-    if (request->method() == HTTP_GET) {
-      std::string data = this->light_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("brightness"))
-        call.set_brightness(request->getParam("brightness")->value().toFloat() / 255.0f);
-      if (request->hasParam("r"))
-        call.set_red(request->getParam("r")->value().toFloat() / 255.0f);
-      if (request->hasParam("g"))
-        call.set_green(request->getParam("g")->value().toFloat() / 255.0f);
-      if (request->hasParam("b"))
-        call.set_blue(request->getParam("b")->value().toFloat() / 255.0f);
-      if (request->hasParam("white_value"))
-        call.set_white(request->getParam("white_value")->value().toFloat() / 255.0f);
-      if (request->hasParam("color_temp"))
-        call.set_color_temperature(request->getParam("color_temp")->value().toFloat());
-
-      if (request->hasParam("flash")) {
-        float length_s = request->getParam("flash")->value().toFloat();
-        call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
-      }
+  if (request->method() == HTTP_GET) {
+    const std::string &data = this->cached_light_json_(obj);
+    request->send(200, "text/json", data.c_str());
+  } else {
+    request->send(this->light_command_(obj, match.method, request_params(request)));
+  }
+}
+int WebServer::light_command_(light::LightState *obj, const std::string &method, const CommandParams &params) {
+  if (method == "toggle") {
+    this->defer([obj]() { obj->toggle().perform(); });
+  } else if (method == "turn_on") {
+    auto call = obj->turn_on();
+    if (params.has("brightness"))
+      call.set_brightness(params.get_float("brightness") / 255.0f);
+    if (params.has("r"))
+      call.set_red(params.get_float("r") / 255.0f);
+    if (params.has("g"))
+      call.set_green(params.get_float("g") / 255.0f);
+    if (params.has("b"))
+      call.set_blue(params.get_float("b") / 255.0f);
+    if (params.has("white_value"))
+      call.set_white(params.get_float("white_value") / 255.0f);
+    if (params.has("color_temp"))
+      call.set_color_temperature(params.get_float("color_temp"));
+
+    if (params.has("flash")) {
+      float length_s = params.get_float("flash");
+      call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      if (request->hasParam("transition")) {
-        float length_s = request->getParam("transition")->value().toFloat();
-        call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
-      }
+    if (params.has("transition")) {
+      float length_s = params.get_float("transition");
+      call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      if (request->hasParam("effect")) {
-        const char *effect = request->getParam("effect")->value().c_str();
-        call.set_effect(effect);
-      }
+    if (params.has("effect"))
+      call.set_effect(params.get("effect"));
 
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      auto call = obj->turn_off();
-      if (request->hasParam("transition")) {
-        auto length = (uint32_t) request->getParam("transition")->value().toFloat() * 1000;
-        call.set_transition_length(length);
-      }
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
+    this->defer([call]() mutable { call.perform(); });
+  } else if (method == "turn_off") {
+    auto call = obj->turn_off();
+    if (params.has("transition")) {
+      auto length = (uint32_t) params.get_float("transition") * 1000;
+      call.set_transition_length(length);
     }
-    return;
+    this->defer([call]() mutable { call.perform(); });
+  } else {
+    return 404;
   }
-  request->send(404);
+  return 200;
 }
-std::string WebServer::light_json(light::LightState *obj) {
-  return json::build_json([obj](JsonObject &root) {
+static json::json_build_t light_json_builder(light::LightState *obj) {
+  return [obj](JsonObject &root) {
     root["id"] = "light-" + obj->get_object_id();
     root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
     obj->dump_json(root);
-  });
+  };
+}
+std::string WebServer::light_json(light::LightState *obj) { return json::build_json(light_json_builder(obj)); }
+const std::string &WebServer::cached_light_json_(light::LightState *obj) {
+  // the light state is dumped through ArduinoJson by LightState::dump_json(), only the result is cached
+  std::string &json = this->state_cache_(obj);
+  if (json.empty())
+    json = this->light_json(obj);
+  return json;
 }
 #endif
 
 #ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
 void WebServer::on_cover_update(cover::Cover *obj) {
   if (obj->is_internal())
     return;
-  this->events_.send(this->cover_json(obj).c_str(), "state");
+  std::string &json = this->state_cache_(obj);
+  json.clear();
+  this->write_cover_json_(json, obj);
+  this->send_state_(obj, json);
 }
+#endif
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, UrlMatch match) {
-  for (cover::Cover *obj : App.get_covers()) {
-    if (obj->is_internal())
-      continue;
-    if (obj->get_object_id() != match.id)
-      continue;
+  cover::Cover *obj = App.get_cover_by_key(fnv1_hash(match.id));
+  if (obj == nullptr || obj->get_object_id() != match.id) {
+    request->send(404);
+    return;
+  }
 
-    if (request->method() == HTTP_GET) {
-      std::string data = this->cover_json(obj);
-      request->send(200, "text/json", data.c_str());
-      continue;
-    }
+  if (request->method() == HTTP_GET) {
+    const std::string &data = this->cached_cover_json_(obj);
+    request->send(200, "text/json", data.c_str());
+    return;
+  }
 
-    auto call = obj->make_call();
-    if (match.method == "open") {
-      call.set_command_open();
-    } else if (match.method == "close") {
-      call.set_command_close();
-    } else if (match.method == "stop") {
-      call.set_command_stop();
-    } else if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  request->send(this->cover_command_(obj, match.method, request_params(request)));
+}
+int WebServer::cover_command_(cover::Cover *obj, const std::string &method, const CommandParams &params) {
+  auto call = obj->make_call();
+  if (method == "open") {
+    call.set_command_open();
+  } else if (method == "close") {
+    call.set_command_close();
+  } else if (method == "stop") {
+    call.set_command_stop();
+  } else if (method != "set") {
+    return 404;
+  }
 
-    auto traits = obj->get_traits();
-    if ((request->hasParam("position") && !traits.get_supports_position()) ||
-        (request->hasParam("tilt") && !traits.get_supports_tilt())) {
-      request->send(409);
-      return;
-    }
+  auto traits = obj->get_traits();
+  if ((params.has("position") && !traits.get_supports_position()) ||
+      (params.has("tilt") && !traits.get_supports_tilt())) {
+    return 409;
+  }
 
-    if (request->hasParam("position"))
-      call.set_position(request->getParam("position")->value().toFloat());
-    if (request->hasParam("tilt"))
-      call.set_tilt(request->getParam("tilt")->value().toFloat());
+  if (params.has("position"))
+    call.set_position(params.get_float("position"));
+  if (params.has("tilt"))
+    call.set_tilt(params.get_float("tilt"));
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
+  this->defer([call]() mutable { call.perform(); });
+  return 200;
+}
+std::string WebServer::cover_json(cover::Cover *obj) {
+  std::string out;
+  this->write_cover_json_(out, obj);
+  return out;
+}
+void WebServer::write_cover_json_(std::string &out, cover::Cover *obj) {
+  json::JsonWriter writer(out);
+  writer.begin_object();
+  write_id(writer, "cover-", obj);
+  writer.key("state").value(obj->is_fully_closed() ? "CLOSED" : "OPEN");
+  writer.key("value").value(obj->position);
+  writer.key("current_operation").value(cover::cover_operation_to_str(obj->current_operation));
+
+  if (obj->get_traits().get_supports_tilt())
+    writer.key("tilt").value(obj->tilt);
+  writer.end_object();
+}
+const std::string &WebServer::cached_cover_json_(cover::Cover *obj) {
+  std::string &json = this->state_cache_(obj);
+  if (json.empty())
+    this->write_cover_json_(json, obj);
+  return json;
+}
+#endif
+
+#ifdef USE_DUAL_CORE
+std::function<void()> WebServer::snapshot_state_(Application::EntityType type, Nameable *obj) {
+  if (obj->is_internal())
+    return nullptr;
+  // render the state here in the loop task, the network task only caches and sends it
+  std::string json;
+  switch (type) {
+#ifdef USE_CONTROLLER_FAN
+    case Application::ENTITY_FAN:
+      this->write_fan_json_(json, static_cast<fan::FanState *>(obj));
+      break;
+#endif
+#ifdef USE_CONTROLLER_LIGHT
+    case Application::ENTITY_LIGHT:
+      json = json::build_json_unshared(light_json_builder(static_cast<light::LightState *>(obj)));
+      break;
+#endif
+#ifdef USE_CONTROLLER_COVER
+    case Application::ENTITY_COVER:
+      this->write_cover_json_(json, static_cast<cover::Cover *>(obj));
+      break;
+#endif
+    default:
+      return nullptr;
+  }
+  return [this, obj, json]() {
+    std::string &cached = this->state_cache_(obj);
+    cached = json;
+    this->send_state_(obj, cached);
+  };
+}
+#endif
+
+int WebServer::execute_command_(const std::string &command) {
+  const size_t query = command.find('?');
+  UrlMatch match = match_url(command.substr(0, query));
+  if (!match.valid)
+    return 404;
+  CommandParams params;
+  if (query != std::string::npos)
+    parse_query(command.c_str() + query + 1, command.c_str() + command.size(), params);
+
+#ifdef USE_SWITCH
+  if (match.domain == "switch") {
+    switch_::Switch *obj = match_entity(App.get_switch_by_key(fnv1_hash(match.id)), match.id);
+    return obj == nullptr ? 404 : this->switch_command_(obj, match.method, params);
+  }
+#endif
+
+#ifdef USE_FAN
+  if (match.domain == "fan") {
+    fan::FanState *obj = match_entity(App.get_fan_by_key(fnv1_hash(match.id)), match.id);
+    return obj == nullptr ? 404 : this->fan_command_(obj, match.method, params);
+  }
+#endif
+
+#ifdef USE_LIGHT
+  if (match.domain == "light") {
+    light::LightState *obj = match_entity(App.get_light_by_key(fnv1_hash(match.id)), match.id);
+    return obj == nullptr ? 404 : this->light_command_(obj, match.method, params);
+  }
+#endif
+
+#ifdef USE_COVER
+  if (match.domain == "cover") {
+    cover::Cover *obj = match_entity(App.get_cover_by_key(fnv1_hash(match.id)), match.id);
+    return obj == nullptr ? 404 : this->cover_command_(obj, match.method, params);
+  }
+#endif
+
+  return 404;
+}
+std::string WebServer::execute_batch(const char *data, size_t len) {
+  std::string out = "{\"results\":[";
+  const char *end = data + len;
+  bool first = true;
+  while (data < end) {
+    const char *line_end = std::find(data, end, '\n');
+    std::string command(data, line_end);
+    data = line_end == end ? end : line_end + 1;
+    if (!command.empty() && command.back() == '\r')
+      command.pop_back();
+    if (command.empty())
+      continue;
+    if (!first)
+      out += ',';
+    first = false;
+    out += to_string(this->execute_command_(command));
+  }
+  out += "]}";
+  return out;
+}
+void WebServer::handle_batch_request(AsyncWebServerRequest *request) {
+  const size_t len = request->contentLength();
+  if (len > WEBSERVER_MAX_BATCH_SIZE) {
+    request->send(413);
+    return;
+  }
+  // the body is collected by handleBody(), which isn't called for form encoded bodies
+  if (len != 0 && request->_tempObject == nullptr) {
+    request->send(400);
     return;
   }
-  request->send(404);
+  const std::string results = this->execute_batch(static_cast<const char *>(request->_tempObject), len);
+  request->send(200, "text/json", results.c_str());
 }
-std::string WebServer::cover_json(cover::Cover *obj) {
-  return json::build_json([obj](JsonObject &root) {
-    root["id"] = "cover-" + obj->get_object_id();
-    root["state"] = obj->is_fully_closed() ? "CLOSED" : "OPEN";
-    root["value"] = obj->position;
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
-
-    if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
-  });
+void WebServer::handleBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+  if (request->url() != "/batch" || total > WEBSERVER_MAX_BATCH_SIZE)
+    return;
+  // freed with the request
+  if (index == 0)
+    request->_tempObject = malloc(total);
+  if (request->_tempObject == nullptr || index + len > total)
+    return;
+  memcpy(static_cast<uint8_t *>(request->_tempObject) + index, data, len);
 }
+
+#ifdef WEBSERVER_WEBSOCKET
+void WebServer::on_ws_event_(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  if (type == WS_EVT_CONNECT) {
+    const uint32_t id = client->id();
+    this->defer([this, id]() {
+      this->ws_clients_.push_back(WsClient{id, true});
+      this->ws_dirty_ = true;
+    });
+  } else if (type == WS_EVT_DATA) {
+    network_mark_activity();
+    auto *info = static_cast<AwsFrameInfo *>(arg);
+    // batches are small, so they are only accepted in a single text frame
+    if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_TEXT) {
+      ESP_LOGW(TAG, "Ignoring a fragmented or binary WebSocket message");
+      return;
+    }
+    client->text(this->execute_batch(reinterpret_cast<const char *>(data), len).c_str());
+  }
+}
+size_t WebServer::write_ws_changes_(std::string &message) {
+  message = "{\"states\":[";
+  size_t count = 0;
+  for (auto &entry : this->state_cache_entries_) {
+    if (!entry.ws_dirty)
+      continue;
+    entry.ws_dirty = false;
+    if (count++ != 0)
+      message += ',';
+    message += entry.json;
+  }
+  message += "]}";
+  return count;
+}
+void WebServer::loop() {
+  // closes the oldest clients beyond the limit of the library
+  this->ws_.cleanupClients();
+  const uint32_t now = millis();
+  if (!this->ws_dirty_ || now - this->ws_last_send_ < this->ws_min_interval_)
+    return;
+  this->ws_dirty_ = false;
+  this->ws_last_send_ = now;
+
+  // all clients share the message of the changes, clients that missed one get all states instead. Each message is
+  // copied once into a buffer of the library that is shared by all clients it is queued for.
+  std::string changes;
+  const size_t change_count = this->write_ws_changes_(changes);
+  AsyncWebSocketMessageBuffer *changes_buffer = nullptr;
+  AsyncWebSocketMessageBuffer *all_buffer = nullptr;
+  for (auto it = this->ws_clients_.begin(); it != this->ws_clients_.end();) {
+    AsyncWebSocketClient *client = this->ws_.client(it->id);
+    if (client == nullptr) {
+      it = this->ws_clients_.erase(it);
+      continue;
+    }
+    if (client->queueIsFull()) {
+      // the changes are dropped for this client, it is resynced once it caught up
+      it->resync = true;
+      this->ws_dirty_ = true;
+    } else if (it->resync) {
+      if (all_buffer == nullptr) {
+        std::string all = "{\"states\":[";
+        bool first = true;
+        this->for_each_state_([&all, &first](const std::string &json) {
+          if (!first)
+            all += ',';
+          first = false;
+          all += json;
+        });
+        all += "]}";
+        all_buffer = this->ws_.makeBuffer(reinterpret_cast<uint8_t *>(&all[0]), all.size());
+      }
+      if (all_buffer != nullptr) {
+        client->text(all_buffer);
+        it->resync = false;
+      } else {
+        this->ws_dirty_ = true;
+      }
+    } else if (change_count != 0) {
+      if (changes_buffer == nullptr)
+        changes_buffer = this->ws_.makeBuffer(reinterpret_cast<uint8_t *>(&changes[0]), changes.size());
+      if (changes_buffer != nullptr) {
+        client->text(changes_buffer);
+      } else {
+        it->resync = true;
+        this->ws_dirty_ = true;
+      }
+    }
+    ++it;
+  }
+  // frees the buffers of earlier loops once all their messages are sent
+  this->ws_._cleanBuffers();
+}
+bool WebServer::is_loop_idle() { return !this->ws_dirty_; }
 #endif
 
 bool WebServer::canHandle(AsyncWebServerRequest *request) {
-  if (request->url() == "/")
+  if (request->url() == "/") {
+    request->addInterestingHeader("If-None-Match");
     return true;
+  }
 
 #ifdef WEBSERVER_CSS_INCLUDE
-  if (request->url() == "/0.css")
+  if (request->url() == "/0.css") {
+    request->addInterestingHeader("If-None-Match");
     return true;
+  }
 #endif
 
 #ifdef WEBSERVER_JS_INCLUDE
-  if (request->url() == "/0.js")
+  if (request->url() == "/0.js") {
+    request->addInterestingHeader("If-None-Match");
     return true;
+  }
 #endif
 
+  if (request->url() == "/batch")
+    return request->method() == HTTP_POST;
+
   UrlMatch match = match_url(request->url().c_str(), true);
   if (!match.valid)
     return false;
@@ -627,6 +1120,7 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   if (this->using_auth() && !request->authenticate(this->username_, this->password_)) {
     return request->requestAuthentication();
   }
+  network_mark_activity();
 
   if (request->url() == "/") {
     this->handle_index_request(request);
@@ -647,6 +1141,11 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
+  if (request->url() == "/batch") {
+    this->handle_batch_request(request);
+    return;
+  }
+
   UrlMatch match = match_url(request->url().c_str());
 #ifdef USE_SENSOR
   if (match.domain == "sensor") {
@@ -4,6 +4,9 @@
 #include "esphome/core/controller.h"
 #include "esphome/components/web_server_base/web_server_base.h"
 
+#include <functional>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace esphome {
@@ -17,6 +20,19 @@ struct UrlMatch {
   bool valid;          ///< Whether this match is valid
 };
 
+/// The parameters of a command, from the query of a request or of a line of a batch.
+class CommandParams {
+ public:
+  void add(std::string name, std::string value) { this->params_.emplace_back(std::move(name), std::move(value)); }
+  bool has(const char *name) const;
+  /// The value of the parameter, empty if there is none.
+  const std::string &get(const char *name) const;
+  float get_float(const char *name) const;
+
+ protected:
+  std::vector<std::pair<std::string, std::string>> params_;
+};
+
 /** This class allows users to create a web server with their ESP nodes.
  *
  * Behind the scenes it's using AsyncWebServer to set up the server. It exposes 3 things:
@@ -25,6 +41,11 @@ struct UrlMatch {
  * all state updates in real time + the debug log. Lastly, there's an REST API available
  * under the '/light/...', '/sensor/...', ... URLs. A full documentation for this API
  * can be found under https://esphome.io/web-api/index.html.
+ *
+ * Many commands can be sent at once with a POST to '/batch', the body holds one command per line in the form of the
+ * REST URL, for example "/light/kitchen/turn_on?brightness=128". The response is {"results":[200,404,...]} with the
+ * status of each command. With the websocket option, a WebSocket under '/ws' accepts the same batches as text
+ * messages and pushes the changed states as {"states":[...]}, coalesced to at most one message per min_interval.
  */
 class WebServer : public Controller, public Component, public AsyncWebHandler {
  public:
@@ -41,11 +62,13 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    */
   void set_css_url(const char *css_url);
 
-  /** Set local path to the script that's embedded in the index page. Defaults to
+  /** Set the stylesheet that's served under '/0.css', gzip-compressed at build time.
    *
-   * @param css_include Local path to web server script.
+   * @param data The compressed stylesheet in PROGMEM.
+   * @param size The size of data.
+   * @param etag The ETag of the stylesheet, including the quotes.
    */
-  void set_css_include(const char *css_include);
+  void set_css_include(const uint8_t *data, size_t size, const char *etag);
 
   /** Set the URL to the script that's embedded in the index page. Defaults to
    * https://esphome.io/_static/webserver-v1.min.js
@@ -54,11 +77,18 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    */
   void set_js_url(const char *js_url);
 
-  /** Set local path to the script that's embedded in the index page. Defaults to
+  /** Set the script that's served under '/0.js', gzip-compressed at build time.
    *
-   * @param js_include Local path to web server script.
+   * @param data The compressed script in PROGMEM.
+   * @param size The size of data.
+   * @param etag The ETag of the script, including the quotes.
    */
-  void set_js_include(const char *js_include);
+  void set_js_include(const uint8_t *data, size_t size, const char *etag);
+
+#ifdef WEBSERVER_WEBSOCKET
+  /// Set the minimum time between two state messages to a WebSocket client.
+  void set_websocket_min_interval(uint32_t min_interval) { this->ws_min_interval_ = min_interval; }
+#endif
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -66,11 +96,16 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   void setup() override;
 
   void dump_config() override;
+#ifdef WEBSERVER_WEBSOCKET
+  void loop() override;
+  bool is_loop_idle() override;
+#endif
 
   /// MQTT setup priority.
   float get_setup_priority() const override;
+  ComponentAffinity get_affinity() const override { return COMPONENT_AFFINITY_NETWORK; }
 
-  /// Handle an index request under '/'.
+  /// Handle an index request under '/', the page is streamed in chunks.
   void handle_index_request(AsyncWebServerRequest *request);
 
 #ifdef WEBSERVER_CSS_INCLUDE
@@ -85,8 +120,18 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
   bool using_auth() { return username_ != nullptr && password_ != nullptr; }
 
+  /// Handle a batch of commands under '/batch'.
+  void handle_batch_request(AsyncWebServerRequest *request);
+  /** Run the commands of a batch, one per line.
+   *
+   * @return The status of each command as JSON, {"results":[...]}.
+   */
+  std::string execute_batch(const char *data, size_t len);
+
 #ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
   void on_sensor_update(sensor::Sensor *obj, float state) override;
+#endif
   /// Handle a sensor request under '/sensor/<id>'.
   void handle_sensor_request(AsyncWebServerRequest *request, UrlMatch match);
 
@@ -95,7 +140,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 #endif
 
 #ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
   void on_switch_update(switch_::Switch *obj, bool state) override;
+#endif
 
   /// Handle a switch request under '/switch/<id>/</turn_on/turn_off/toggle>'.
   void handle_switch_request(AsyncWebServerRequest *request, UrlMatch match);
@@ -105,7 +152,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 #endif
 
 #ifdef USE_BINARY_SENSOR
+#ifdef USE_CONTROLLER_BINARY_SENSOR
   void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override;
+#endif
 
   /// Handle a binary sensor request under '/binary_sensor/<id>'.
   void handle_binary_sensor_request(AsyncWebServerRequest *request, UrlMatch match);
@@ -115,7 +164,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 #endif
 
 #ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
   void on_fan_update(fan::FanState *obj) override;
+#endif
 
   /// Handle a fan request under '/fan/<id>/</turn_on/turn_off/toggle>'.
   void handle_fan_request(AsyncWebServerRequest *request, UrlMatch match);
@@ -125,7 +176,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 #endif
 
 #ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
   void on_light_update(light::LightState *obj) override;
+#endif
 
   /// Handle a light request under '/light/<id>/</turn_on/turn_off/toggle>'.
   void handle_light_request(AsyncWebServerRequest *request, UrlMatch match);
@@ -135,7 +188,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  void on_text_sensor_update(text_sensor::TextSensor *obj, std::string state) override;
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+  void on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) override;
+#endif
 
   /// Handle a text sensor request under '/text_sensor/<id>'.
   void handle_text_sensor_request(AsyncWebServerRequest *request, UrlMatch match);
@@ -145,7 +200,9 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 #endif
 
 #ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
   void on_cover_update(cover::Cover *obj) override;
+#endif
 
   /// Handle a cover request under '/cover/<id>/<open/close/stop/set>'.
   void handle_cover_request(AsyncWebServerRequest *request, UrlMatch match);
@@ -158,18 +215,132 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool canHandle(AsyncWebServerRequest *request) override;
   /// Override the web handler's handleRequest method.
   void handleRequest(AsyncWebServerRequest *request) override;
+  /// Override the web handler's handleBody method, collects the body of a batch.
+  void handleBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) override;
   /// This web handle is not trivial.
   bool isRequestHandlerTrivial() override;
 
  protected:
+  /// The last JSON state of an entity, shared by all event source clients and the REST API.
+  struct CachedState {
+    const Nameable *obj;
+    std::string json;
+#ifdef WEBSERVER_WEBSOCKET
+    /// Changed since the last state message to the WebSocket clients.
+    bool ws_dirty;
+#endif
+  };
+#ifdef WEBSERVER_WEBSOCKET
+  struct WsClient {
+    uint32_t id;
+    /// Send all states, the client is new or missed a message because its queue was full.
+    bool resync;
+  };
+#endif
+
+  /// A row of the entity table on the index page.
+  struct IndexRow {
+    Nameable *obj;
+    const char *klass;
+    const char *action;
+  };
+
+  /// Collect the entities for the state cache and the index page.
+  void setup_entities_();
+  /** Render a piece of the index page, the head, one row of the entity table per entity and the foot.
+   *
+   * @return false once piece is past the end of the page.
+   */
+  bool write_index_piece_(size_t piece, std::string &out);
+  /// The cache entry of obj, nullptr for internal entities.
+  CachedState *find_cached_state_(const Nameable *obj);
+  /// The cached JSON state of obj, empty if it has not been rendered yet.
+  std::string &state_cache_(const Nameable *obj);
+  /// Call f with the JSON state of each entity that is not internal, rendering the ones that aren't cached yet.
+  void for_each_state_(const std::function<void(const std::string &)> &f);
+  /// Send the new cached state of obj to the event source clients and queue it for the WebSocket clients.
+  void send_state_(const Nameable *obj, const std::string &json);
+#ifdef USE_DUAL_CORE
+  std::function<void()> snapshot_state_(Application::EntityType type, Nameable *obj) override;
+#endif
+  /// Run one command in the form of a REST URL, returns the HTTP status.
+  int execute_command_(const std::string &command);
+#ifdef WEBSERVER_WEBSOCKET
+  void on_ws_event_(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len);
+  /// Write the states that changed since the last call as a state message, returns the number of states.
+  size_t write_ws_changes_(std::string &message);
+#endif
+
+  // *_command_() run a POST command on obj and return the HTTP status.
+#ifdef USE_SWITCH
+  int switch_command_(switch_::Switch *obj, const std::string &method, const CommandParams &params);
+#endif
+#ifdef USE_FAN
+  int fan_command_(fan::FanState *obj, const std::string &method, const CommandParams &params);
+#endif
+#ifdef USE_LIGHT
+  int light_command_(light::LightState *obj, const std::string &method, const CommandParams &params);
+#endif
+#ifdef USE_COVER
+  int cover_command_(cover::Cover *obj, const std::string &method, const CommandParams &params);
+#endif
+
+  // write_*_json_() append the JSON state of obj to out, cached_*_json_() return the cached state and only
+  // render it if it's not cached yet.
+#ifdef USE_SENSOR
+  const std::string &cached_sensor_json_(sensor::Sensor *obj);
+  void write_sensor_json_(std::string &out, sensor::Sensor *obj, float value);
+#endif
+#ifdef USE_SWITCH
+  const std::string &cached_switch_json_(switch_::Switch *obj);
+  void write_switch_json_(std::string &out, switch_::Switch *obj, bool value);
+#endif
+#ifdef USE_BINARY_SENSOR
+  const std::string &cached_binary_sensor_json_(binary_sensor::BinarySensor *obj);
+  void write_binary_sensor_json_(std::string &out, binary_sensor::BinarySensor *obj, bool value);
+#endif
+#ifdef USE_FAN
+  const std::string &cached_fan_json_(fan::FanState *obj);
+  void write_fan_json_(std::string &out, fan::FanState *obj);
+#endif
+#ifdef USE_LIGHT
+  const std::string &cached_light_json_(light::LightState *obj);
+#endif
+#ifdef USE_TEXT_SENSOR
+  const std::string &cached_text_sensor_json_(text_sensor::TextSensor *obj);
+  void write_text_sensor_json_(std::string &out, text_sensor::TextSensor *obj, const std::string &value);
+#endif
+#ifdef USE_COVER
+  const std::string &cached_cover_json_(cover::Cover *obj);
+  void write_cover_json_(std::string &out, cover::Cover *obj);
+#endif
+
   web_server_base::WebServerBase *base_;
+  /// Sorted by obj.
+  std::vector<CachedState> state_cache_entries_;
+  std::string uncached_json_;
+  std::vector<IndexRow> index_rows_;
+  /// The index page only changes with the firmware, so its ETag is derived from the compilation time.
+  char index_etag_[11];
   AsyncEventSource events_{"/events"};
+#ifdef WEBSERVER_WEBSOCKET
+  AsyncWebSocket ws_{"/ws"};
+  /// Only accessed from the loop.
+  std::vector<WsClient> ws_clients_;
+  uint32_t ws_min_interval_{100};
+  uint32_t ws_last_send_{0};
+  bool ws_dirty_{false};
+#endif
   const char *username_{nullptr};
   const char *password_{nullptr};
   const char *css_url_{nullptr};
-  const char *css_include_{nullptr};
+  const uint8_t *css_include_{nullptr};
+  size_t css_include_size_{0};
+  const char *css_include_etag_{nullptr};
   const char *js_url_{nullptr};
-  const char *js_include_{nullptr};
+  const uint8_t *js_include_{nullptr};
+  size_t js_include_size_{0};
+  const char *js_include_etag_{nullptr};
 };
 
 }  // namespace web_server
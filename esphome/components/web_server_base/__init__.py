@@ -1,7 +1,11 @@
+import gzip
+import hashlib
+import io
+
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import CONF_ID
-from esphome.core import coroutine_with_priority, CORE
+from esphome.core import coroutine_with_priority, CORE, HexInt
 
 CODEOWNERS = ['@OttoWinter']
 DEPENDENCIES = ['network']
@@ -16,6 +20,19 @@ CONFIG_SCHEMA = cv.Schema({
 })
 
 
+def gzip_asset(id_, path):
+    """Compress the file at path into a PROGMEM array, returns the array, its size and an ETag for it."""
+    with open(path, 'rb') as f_handle:
+        content = f_handle.read()
+    buffer = io.BytesIO()
+    # mtime 0 so that the output (and the ETag) only changes with the content
+    with gzip.GzipFile(fileobj=buffer, mode='wb', compresslevel=9, mtime=0) as gz_handle:
+        gz_handle.write(content)
+    data = buffer.getvalue()
+    etag = '"{}"'.format(hashlib.sha1(content).hexdigest()[:16])
+    return cg.progmem_array(id_, [HexInt(x) for x in data]), len(data), etag
+
+
 @coroutine_with_priority(65.0)
 def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
@@ -2,6 +2,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 #include <StreamString.h>
+#include <algorithm>
+#include <cstring>
 
 #ifdef ARDUINO_ARCH_ESP32
 #include <Update.h>
@@ -15,6 +17,41 @@ namespace web_server_base {
 
 static const char *TAG = "web_server_base";
 
+#ifdef ARDUINO_ARCH_ESP32
+/// One flash sector, so that each write of the writer task erases and writes exactly one sector.
+static const size_t OTA_BLOCK_SIZE = 4096;
+/// One block is received while the other one is written.
+static const size_t OTA_BLOCK_COUNT = 2;
+#endif
+
+bool etag_matches(AsyncWebServerRequest *request, const char *etag) {
+  AsyncWebHeader *header = request->getHeader("If-None-Match");
+  return header != nullptr && header->value() == etag;
+}
+
+void send_not_modified(AsyncWebServerRequest *request, const char *etag) {
+  AsyncWebServerResponse *response = request->beginResponse(304);
+  response->addHeader("ETag", etag);
+  request->send(response);
+}
+
+void send_gzip_asset(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data, size_t size,
+                     const char *etag) {
+  if (data == nullptr) {
+    request->send(404);
+    return;
+  }
+  if (etag_matches(request, etag)) {
+    send_not_modified(request, etag);
+    return;
+  }
+  AsyncWebServerResponse *response = request->beginResponse_P(200, content_type, data, size);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
 void report_ota_error() {
   StreamString ss;
   Update.printError(ss);
@@ -32,6 +69,8 @@ void OTARequestHandler::handleUpload(AsyncWebServerRequest *request, const Strin
     success = Update.begin((ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000);
 #endif
 #ifdef ARDUINO_ARCH_ESP32
+    this->start_writer_();
+    this->write_failed_ = false;
     if (Update.isRunning())
       Update.abort();
     success = Update.begin(UPDATE_SIZE_UNKNOWN, U_FLASH);
@@ -45,7 +84,7 @@ void OTARequestHandler::handleUpload(AsyncWebServerRequest *request, const Strin
     return;
   }
 
-  success = Update.write(data, len) == len;
+  success = this->write_(data, len);
   if (!success) {
     report_ota_error();
     return;
@@ -64,6 +103,14 @@ void OTARequestHandler::handleUpload(AsyncWebServerRequest *request, const Strin
   }
 
   if (final) {
+#ifdef ARDUINO_ARCH_ESP32
+    this->submit_block_();
+    this->wait_written_();
+    if (this->write_failed_) {
+      report_ota_error();
+      return;
+    }
+#endif
     if (Update.end(true)) {
       ESP_LOGI(TAG, "OTA update successful!");
       this->parent_->set_timeout(100, []() { App.safe_reboot(); });
@@ -72,6 +119,83 @@ void OTARequestHandler::handleUpload(AsyncWebServerRequest *request, const Strin
     }
   }
 }
+bool OTARequestHandler::write_(const uint8_t *data, size_t len) {
+#ifdef ARDUINO_ARCH_ESP32
+  while (len > 0 && !this->write_failed_) {
+    if (this->block_.data == nullptr) {
+      // blocks the TCP task while the writer task is busy with all blocks
+      xQueueReceive(this->free_blocks_, &this->block_.data, portMAX_DELAY);
+      this->block_.len = 0;
+    }
+    const size_t chunk = std::min(len, OTA_BLOCK_SIZE - this->block_.len);
+    memcpy(this->block_.data + this->block_.len, data, chunk);
+    this->block_.len += chunk;
+    data += chunk;
+    len -= chunk;
+    if (this->block_.len == OTA_BLOCK_SIZE)
+      this->submit_block_();
+  }
+  return !this->write_failed_;
+#else
+  return Update.write(const_cast<uint8_t *>(data), len) == len;
+#endif
+}
+
+#ifdef ARDUINO_ARCH_ESP32
+void OTARequestHandler::start_writer_() {
+  if (this->free_blocks_ == nullptr) {
+    this->block_memory_.reset(new uint8_t[OTA_BLOCK_SIZE * OTA_BLOCK_COUNT]);  // NOLINT
+    this->free_blocks_ = xQueueCreate(OTA_BLOCK_COUNT, sizeof(uint8_t *));
+    this->full_blocks_ = xQueueCreate(OTA_BLOCK_COUNT, sizeof(OTABlock));
+    for (size_t i = 0; i < OTA_BLOCK_COUNT; i++) {
+      uint8_t *block = &this->block_memory_[i * OTA_BLOCK_SIZE];
+      xQueueSend(this->free_blocks_, &block, 0);
+    }
+    xTaskCreatePinnedToCore(&OTARequestHandler::writer_task_,
+                            "ota_writer",    // name
+                            4096,            // stack size
+                            this,            // task pv params
+                            1,               // priority
+                            nullptr,         // handle
+                            tskNO_AFFINITY   // core
+    );
+    return;
+  }
+  // an interrupted upload leaves data behind, drop it and let the writer finish before the update is aborted
+  if (this->block_.data != nullptr) {
+    xQueueSend(this->free_blocks_, &this->block_.data, 0);
+    this->block_.data = nullptr;
+  }
+  this->wait_written_();
+}
+void OTARequestHandler::submit_block_() {
+  if (this->block_.data == nullptr)
+    return;
+  xQueueSend(this->full_blocks_, &this->block_, portMAX_DELAY);
+  this->block_.data = nullptr;
+}
+void OTARequestHandler::wait_written_() {
+  // the writer task returns every block once it is written
+  uint8_t *blocks[OTA_BLOCK_COUNT];
+  for (auto &block : blocks)
+    xQueueReceive(this->free_blocks_, &block, portMAX_DELAY);
+  for (auto *block : blocks)
+    xQueueSend(this->free_blocks_, &block, 0);
+}
+void OTARequestHandler::writer_task_(void *params) {
+  auto *handler = reinterpret_cast<OTARequestHandler *>(params);
+  while (true) {
+    OTABlock block;
+    if (xQueueReceive(handler->full_blocks_, &block, portMAX_DELAY) != pdTRUE)
+      continue;
+    // after a failed write the rest of the upload is dropped, Update keeps the error for the report
+    if (!handler->write_failed_ && Update.write(block.data, block.len) != block.len)
+      handler->write_failed_ = true;
+    xQueueSend(handler->free_blocks_, &block.data, portMAX_DELAY);
+  }
+}
+#endif
+
 void OTARequestHandler::handleRequest(AsyncWebServerRequest *request) {
   AsyncWebServerResponse *response;
   if (!Update.hasError()) {
@@ -4,9 +4,22 @@
 
 #include <ESPAsyncWebServer.h>
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 namespace web_server_base {
 
+/// Whether the client sent the current ETag of a resource in If-None-Match.
+bool etag_matches(AsyncWebServerRequest *request, const char *etag);
+void send_not_modified(AsyncWebServerRequest *request, const char *etag);
+/// Send a gzip-compressed asset from PROGMEM, or 304 if the client already has it.
+void send_gzip_asset(AsyncWebServerRequest *request, const char *content_type, const uint8_t *data, size_t size,
+                     const char *etag);
+
 class WebServerBase : public Component {
  public:
   void init() {
@@ -54,6 +67,21 @@ class WebServerBase : public Component {
   std::vector<AsyncWebHandler *> handlers_;
 };
 
+#ifdef ARDUINO_ARCH_ESP32
+/// A part of the uploaded firmware, waiting to be written to flash.
+struct OTABlock {
+  uint8_t *data;
+  size_t len;
+};
+#endif
+
+/** Receives firmware uploads to /update.
+ *
+ * On the ESP32 the upload arrives in the async TCP task. Blocking it while a flash sector is erased and written would
+ * stall the upload and every other connection, so the data is collected in sector sized blocks that a writer task
+ * writes while the next block is received. When both blocks are in use, the TCP task waits for the writer. The
+ * received data isn't acknowledged in the meantime, so the sender slows down to the flash speed.
+ */
 class OTARequestHandler : public AsyncWebHandler {
  public:
   OTARequestHandler(WebServerBase *parent) : parent_(parent) {}
@@ -67,6 +95,24 @@ class OTARequestHandler : public AsyncWebHandler {
   bool isRequestHandlerTrivial() override { return false; }
 
  protected:
+#ifdef ARDUINO_ARCH_ESP32
+  void start_writer_();
+  /// Hand the current block to the writer task.
+  void submit_block_();
+  /// Wait until the writer task has written all submitted blocks.
+  void wait_written_();
+  static void writer_task_(void *params);
+
+  std::unique_ptr<uint8_t[]> block_memory_;
+  /// Blocks that can be filled, the writer task returns them here.
+  QueueHandle_t free_blocks_{nullptr};
+  /// Filled blocks, in upload order.
+  QueueHandle_t full_blocks_{nullptr};
+  OTABlock block_{nullptr, 0};
+  volatile bool write_failed_{false};
+#endif
+  bool write_(const uint8_t *data, size_t len);
+
   uint32_t last_ota_progress_{0};
   uint32_t ota_read_length_{0};
   WebServerBase *parent_;
@@ -13,6 +13,10 @@ const uint16_t WHIRLPOOL_ONE_SPACE = 1659;
 const uint16_t WHIRLPOOL_ZERO_SPACE = 553;
 const uint32_t WHIRLPOOL_GAP = 7960;
 
+static const climate_ir::IRFrameTiming WHIRLPOOL_TIMING = {WHIRLPOOL_HEADER_MARK, WHIRLPOOL_HEADER_SPACE,
+                                                           WHIRLPOOL_BIT_MARK,    WHIRLPOOL_ONE_SPACE,
+                                                           WHIRLPOOL_ZERO_SPACE,  false};
+
 const uint32_t WHIRLPOOL_CARRIER_FREQUENCY = 38000;
 
 const uint8_t WHIRLPOOL_STATE_LENGTH = 21;
@@ -124,25 +128,14 @@ void WhirlpoolClimate::transmit_state() {
 
   data->set_carrier_frequency(38000);
 
-  // Header
-  data->mark(WHIRLPOOL_HEADER_MARK);
-  data->space(WHIRLPOOL_HEADER_SPACE);
-  // Data
-  auto bytes_sent = 0;
-  for (uint8_t i : remote_state) {
-    for (uint8_t j = 0; j < 8; j++) {
-      data->mark(WHIRLPOOL_BIT_MARK);
-      bool bit = i & (1 << j);
-      data->space(bit ? WHIRLPOOL_ONE_SPACE : WHIRLPOOL_ZERO_SPACE);
-    }
-    bytes_sent++;
-    if (bytes_sent == 6 || bytes_sent == 14) {
-      // Divider
-      data->mark(WHIRLPOOL_BIT_MARK);
-      data->space(WHIRLPOOL_GAP);
-    }
-  }
-  // Footer
+  // a single header, the three sections of the state are separated by a mark and a gap
+  data->reserve(climate_ir::ir_frame_length(WHIRLPOOL_STATE_LENGTH) + 4);
+  data->item(WHIRLPOOL_HEADER_MARK, WHIRLPOOL_HEADER_SPACE);
+  climate_ir::encode_ir_bytes(data, WHIRLPOOL_TIMING, remote_state, 6);
+  data->item(WHIRLPOOL_BIT_MARK, WHIRLPOOL_GAP);
+  climate_ir::encode_ir_bytes(data, WHIRLPOOL_TIMING, remote_state + 6, 8);
+  data->item(WHIRLPOOL_BIT_MARK, WHIRLPOOL_GAP);
+  climate_ir::encode_ir_bytes(data, WHIRLPOOL_TIMING, remote_state + 14, WHIRLPOOL_STATE_LENGTH - 14);
   data->mark(WHIRLPOOL_BIT_MARK);
 
   transmit.perform();
@@ -6,7 +6,7 @@ from esphome.const import CONF_AP, CONF_BSSID, CONF_CHANNEL, CONF_DNS1, CONF_DNS
     CONF_FAST_CONNECT, CONF_GATEWAY, CONF_HIDDEN, CONF_ID, CONF_MANUAL_IP, CONF_NETWORKS, \
     CONF_PASSWORD, CONF_POWER_SAVE_MODE, CONF_REBOOT_TIMEOUT, CONF_SSID, CONF_STATIC_IP, \
     CONF_SUBNET, CONF_USE_ADDRESS, CONF_PRIORITY, CONF_IDENTITY, CONF_CERTIFICATE_AUTHORITY, \
-    CONF_CERTIFICATE, CONF_KEY, CONF_USERNAME, CONF_EAP
+    CONF_CERTIFICATE, CONF_KEY, CONF_USERNAME, CONF_EAP, CONF_INTERVAL, CONF_HYSTERESIS
 from esphome.core import CORE, HexInt, coroutine_with_priority
 from . import wpa2_eap
 
@@ -25,6 +25,7 @@ WIFI_POWER_SAVE_MODES = {
     'NONE': WiFiPowerSaveMode.WIFI_POWER_SAVE_NONE,
     'LIGHT': WiFiPowerSaveMode.WIFI_POWER_SAVE_LIGHT,
     'HIGH': WiFiPowerSaveMode.WIFI_POWER_SAVE_HIGH,
+    'ADAPTIVE': WiFiPowerSaveMode.WIFI_POWER_SAVE_ADAPTIVE,
 }
 WiFiConnectedCondition = wifi_ns.class_('WiFiConnectedCondition', Condition)
 
@@ -131,6 +132,13 @@ def validate(config):
 
 
 CONF_OUTPUT_POWER = 'output_power'
+CONF_POWER_SAVE_QUIET_PERIOD = 'power_save_quiet_period'
+CONF_REUSE_DHCP_LEASE = 'reuse_dhcp_lease'
+CONF_ROAMING = 'roaming'
+ROAMING_SCHEMA = cv.Schema({
+    cv.Optional(CONF_INTERVAL, default='5min'): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_HYSTERESIS, default='10dB'): cv.All(cv.decibel, cv.float_range(min=1.0, max=50.0)),
+})
 CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.GenerateID(): cv.declare_id(WiFiComponent),
     cv.Optional(CONF_NETWORKS): cv.ensure_list(WIFI_NETWORK_STA),
@@ -145,7 +153,10 @@ CONFIG_SCHEMA = cv.All(cv.Schema({
     cv.Optional(CONF_REBOOT_TIMEOUT, default='15min'): cv.positive_time_period_milliseconds,
     cv.SplitDefault(CONF_POWER_SAVE_MODE, esp8266='none', esp32='light'):
         cv.enum(WIFI_POWER_SAVE_MODES, upper=True),
+    cv.Optional(CONF_POWER_SAVE_QUIET_PERIOD, default='5s'): cv.positive_time_period_milliseconds,
     cv.Optional(CONF_FAST_CONNECT, default=False): cv.boolean,
+    cv.Optional(CONF_REUSE_DHCP_LEASE, default=False): cv.boolean,
+    cv.Optional(CONF_ROAMING): ROAMING_SCHEMA,
     cv.Optional(CONF_USE_ADDRESS): cv.string_strict,
     cv.SplitDefault(CONF_OUTPUT_POWER, esp8266=20.0): cv.All(
         cv.decibel, cv.float_range(min=10.0, max=20.5)),
@@ -235,7 +246,12 @@ def to_code(config):
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
     cg.add(var.set_power_save_mode(config[CONF_POWER_SAVE_MODE]))
+    cg.add(var.set_power_save_quiet_period(config[CONF_POWER_SAVE_QUIET_PERIOD]))
     cg.add(var.set_fast_connect(config[CONF_FAST_CONNECT]))
+    cg.add(var.set_reuse_dhcp_lease(config[CONF_REUSE_DHCP_LEASE]))
+    if CONF_ROAMING in config:
+        conf = config[CONF_ROAMING]
+        cg.add(var.set_roaming(conf[CONF_INTERVAL], int(conf[CONF_HYSTERESIS])))
     if CONF_OUTPUT_POWER in config:
         cg.add(var.set_output_power(config[CONF_OUTPUT_POWER]))
 
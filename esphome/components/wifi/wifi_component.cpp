@@ -44,12 +44,28 @@ void WiFiComponent::setup() {
       ESP_LOGV(TAG, "Setting Power Save Option failed!");
     }
 
-    if (this->fast_connect_) {
+    this->fast_connect_pref_ =
+        global_preferences.make_preference<WiFiFastConnectSettings>(fnv1_hash("wifi_fast_connect"), false);
+    this->connect_started_ = millis();
+    if (this->start_fast_connecting_()) {
+      // scanning is only needed if the network of the last connection can't be reached anymore
+    } else if (this->fast_connect_) {
       this->selected_ap_ = this->sta_[0];
       this->start_connecting(this->selected_ap_, false);
     } else {
       this->start_scanning();
     }
+
+    if (this->roam_interval_ != 0) {
+      this->set_interval("roam", this->roam_interval_, [this]() {
+        if (this->state_ != WIFI_COMPONENT_STATE_STA_CONNECTED || this->roam_scanning_)
+          return;
+        ESP_LOGV(TAG, "Scanning for a stronger access point...");
+        this->scan_done_ = false;
+        this->roam_scan_started_ = millis();
+        this->roam_scanning_ = this->wifi_scan_start_(true);
+      });
+    }
   } else if (this->has_ap()) {
     this->setup_ap_config_();
     if (this->output_power_.has_value() && !this->wifi_apply_output_power_(*this->output_power_)) {
@@ -62,9 +78,7 @@ void WiFiComponent::setup() {
   }
 
   this->wifi_apply_hostname_();
-#ifdef ARDUINO_ARCH_ESP32
   network_setup_mdns();
-#endif
 }
 
 void WiFiComponent::loop() {
@@ -98,11 +112,16 @@ void WiFiComponent::loop() {
       case WIFI_COMPONENT_STATE_STA_CONNECTED: {
         if (!this->is_connected()) {
           ESP_LOGW(TAG, "WiFi Connection lost... Reconnecting...");
+          this->connect_started_ = now;
           this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTING;
           this->retry_connect();
         } else {
           this->status_clear_warning();
           this->last_connected_ = now;
+          if (this->roam_scanning_)
+            this->check_roaming_scan_();
+          if (this->power_save_ == WIFI_POWER_SAVE_ADAPTIVE)
+            this->update_adaptive_power_save_();
         }
         break;
       }
@@ -132,6 +151,12 @@ void WiFiComponent::loop() {
 
   network_tick_mdns();
 }
+bool WiFiComponent::is_loop_idle() {
+  // Connection changes are signalled through the event callbacks, which wake the loop.
+  // Out of adaptive power save, the loop has to notice when the traffic got quiet.
+  return !this->has_sta() || (this->state_ == WIFI_COMPONENT_STATE_STA_CONNECTED && !this->roam_scanning_ &&
+                              (this->power_save_ != WIFI_POWER_SAVE_ADAPTIVE || this->power_save_sleeping_));
+}
 
 WiFiComponent::WiFiComponent() { global_wifi_component = this; }
 
@@ -171,9 +196,6 @@ void WiFiComponent::setup_ap_config_() {
 
   this->ap_setup_ = this->wifi_start_ap_(this->ap_);
   ESP_LOGCONFIG(TAG, "  IP Address: %s", this->wifi_soft_ap_ip().toString().c_str());
-#ifdef ARDUINO_ARCH_ESP8266
-  network_setup_mdns(this->wifi_soft_ap_ip(), 1);
-#endif
 
   if (!this->has_sta()) {
     this->state_ = WIFI_COMPONENT_STATE_AP;
@@ -319,6 +341,99 @@ void WiFiComponent::print_connect_params_() {
   ESP_LOGCONFIG(TAG, "  DNS2: %s", WiFi.dnsIP(1).toString().c_str());
 }
 
+bool WiFiComponent::start_fast_connecting_() {
+  WiFiFastConnectSettings settings{};
+  if (!this->fast_connect_pref_.load(&settings))
+    return false;
+
+  for (auto &config : this->sta_) {
+    if (fnv1_hash(config.get_ssid()) != settings.ssid_hash)
+      continue;
+
+    WiFiAP ap = config;
+    bssid_t bssid;
+    std::copy(settings.bssid, settings.bssid + 6, bssid.begin());
+    ap.set_bssid(bssid);
+    ap.set_channel(settings.channel);
+    if (this->reuse_dhcp_lease_ && !config.get_manual_ip().has_value() && settings.ip != 0) {
+      ManualIP lease{};
+      lease.static_ip = IPAddress(settings.ip);
+      lease.gateway = IPAddress(settings.gateway);
+      lease.subnet = IPAddress(settings.subnet);
+      lease.dns1 = IPAddress(settings.dns1);
+      lease.dns2 = IPAddress(settings.dns2);
+      ap.set_manual_ip(lease);
+    }
+
+    ESP_LOGD(TAG, "Connecting to the network of the last connection without scanning...");
+    this->fast_connecting_ = true;
+    this->selected_ap_ = ap;
+    this->start_connecting(ap, false);
+    return true;
+  }
+  return false;
+}
+
+void WiFiComponent::save_fast_connect_settings_() {
+  uint8_t *bssid = WiFi.BSSID();
+  if (bssid == nullptr)
+    return;
+
+  WiFiFastConnectSettings settings{};
+  settings.ssid_hash = fnv1_hash(this->selected_ap_.get_ssid());
+  memcpy(settings.bssid, bssid, sizeof(settings.bssid));
+  settings.channel = WiFi.channel();
+  settings.ip = WiFi.localIP();
+  settings.gateway = WiFi.gatewayIP();
+  settings.subnet = WiFi.subnetMask();
+  settings.dns1 = WiFi.dnsIP(0);
+  settings.dns2 = WiFi.dnsIP(1);
+  this->fast_connect_pref_.save(&settings);
+}
+
+void WiFiComponent::check_roaming_scan_() {
+  if (!this->scan_done_) {
+    if (millis() - this->roam_scan_started_ > 30000) {
+      ESP_LOGV(TAG, "Roaming scan timeout!");
+      this->roam_scanning_ = false;
+    }
+    return;
+  }
+  this->scan_done_ = false;
+  this->scan_generation_++;
+  this->roam_scanning_ = false;
+
+  bssid_t current{};
+  uint8_t *raw_bssid = WiFi.BSSID();
+  if (raw_bssid != nullptr)
+    std::copy(raw_bssid, raw_bssid + 6, current.begin());
+  const std::string ssid = WiFi.SSID().c_str();
+  const int8_t rssi = WiFi.RSSI();
+
+  const WiFiScanResult *best = nullptr;
+  for (auto &res : this->scan_result_) {
+    if (res.get_ssid() != ssid || res.get_bssid() == current)
+      continue;
+    if (best == nullptr || res.get_rssi() > best->get_rssi())
+      best = &res;
+  }
+  if (best == nullptr || best->get_rssi() < rssi + this->roam_hysteresis_) {
+    ESP_LOGV(TAG, "No access point is stronger than the current one (%d dB)", rssi);
+    return;
+  }
+
+  ESP_LOGI(TAG, "Roaming from %d dB to an access point with %d dB on channel %u", rssi, best->get_rssi(),
+           best->get_channel());
+  WiFiAP ap = this->selected_ap_;
+  ap.set_bssid(best->get_bssid());
+  ap.set_channel(best->get_channel());
+  this->roaming_ = true;
+  this->roam_rssi_ = rssi;
+  this->connect_started_ = millis();
+  this->selected_ap_ = ap;
+  this->start_connecting(ap, false);
+}
+
 void WiFiComponent::start_scanning() {
   this->action_started_ = millis();
   ESP_LOGD(TAG, "Starting scan...");
@@ -338,6 +453,7 @@ void WiFiComponent::check_scanning_finished() {
 
   ESP_LOGD(TAG, "Found networks:");
   if (this->scan_result_.empty()) {
+    this->scan_generation_++;
     ESP_LOGD(TAG, "  No network found!");
     this->retry_connect();
     return;
@@ -372,6 +488,7 @@ void WiFiComponent::check_scanning_finished() {
 
                      return a.get_rssi() > b.get_rssi();
                    });
+  this->scan_generation_++;
 
   for (auto &res : this->scan_result_) {
     char bssid_s[18];
@@ -466,16 +583,29 @@ void WiFiComponent::check_connecting_finished() {
       ESP_LOGD(TAG, "Disabling AP...");
       this->wifi_mode_({}, false);
     }
-#ifdef ARDUINO_ARCH_ESP8266
-    network_setup_mdns(this->wifi_sta_ip_(), 0);
-#endif
     this->state_ = WIFI_COMPONENT_STATE_STA_CONNECTED;
     this->num_retried_ = 0;
+    this->fast_connecting_ = false;
+    this->save_fast_connect_settings_();
+    if (this->roaming_) {
+      this->roaming_ = false;
+      this->roam_count_++;
+      const int8_t rssi = WiFi.RSSI();
+      ESP_LOGD(TAG, "Roamed from %d dB to %d dB", this->roam_rssi_, rssi);
+      this->roam_callback_.call(this->roam_rssi_, rssi);
+    }
+
+    const uint32_t connect_time = millis() - this->connect_started_;
+    ESP_LOGD(TAG, "Connecting took %u ms", connect_time);
+    this->connect_time_ = connect_time;
+    this->connect_callback_.call(connect_time);
     return;
   }
 
   uint32_t now = millis();
-  if (now - this->action_started_ > 30000) {
+  // the saved network answers quickly if it is still there, don't delay the scan for long
+  const uint32_t timeout = this->fast_connecting_ ? 10000 : 30000;
+  if (now - this->action_started_ > timeout) {
     ESP_LOGW(TAG, "Timeout while connecting to WiFi.");
     this->retry_connect();
     return;
@@ -510,6 +640,24 @@ void WiFiComponent::check_connecting_finished() {
 }
 
 void WiFiComponent::retry_connect() {
+  this->roaming_ = false;
+  if (this->fast_connecting_) {
+    ESP_LOGW(TAG, "Connecting to the network of the last connection failed, scanning...");
+    this->fast_connecting_ = false;
+    this->error_from_callback_ = false;
+    // don't try the stale settings again on the next boot
+    WiFiFastConnectSettings settings{};
+    this->fast_connect_pref_.save(&settings);
+    this->wifi_disconnect_();
+    if (this->fast_connect_) {
+      this->selected_ap_ = this->sta_[0];
+      this->start_connecting(this->selected_ap_, false);
+    } else {
+      this->start_scanning();
+    }
+    return;
+  }
+
   if (this->selected_ap_.get_bssid()) {
     auto bssid = *this->selected_ap_.get_bssid();
     float priority = this->get_sta_priority(bssid);
@@ -550,6 +698,29 @@ bool WiFiComponent::is_connected() {
          !this->error_from_callback_;
 }
 void WiFiComponent::set_power_save_mode(WiFiPowerSaveMode power_save) { this->power_save_ = power_save; }
+void WiFiComponent::mark_activity() {
+  this->last_activity_ = millis();
+  if (this->power_save_sleeping_)
+    App.wake_loop();
+}
+void WiFiComponent::report_round_trip_time(uint32_t round_trip_time) {
+  ESP_LOGV(TAG, "Round trip time: %u ms (power save %s)", round_trip_time, ONOFF(this->power_save_sleeping_));
+  this->round_trip_time_callback_.call(round_trip_time, this->power_save_sleeping_);
+}
+void WiFiComponent::update_adaptive_power_save_() {
+  // read before millis(), a later mark_activity() can't make it newer than now
+  const uint32_t last_activity = this->last_activity_;
+  const bool sleep = millis() - last_activity >= this->power_save_quiet_period_;
+  if (sleep == this->power_save_sleeping_)
+    return;
+  this->power_save_sleeping_ = sleep;
+  if (!this->wifi_apply_power_save_()) {
+    ESP_LOGV(TAG, "Setting Power Save Option failed!");
+  }
+  this->power_save_switches_++;
+  ESP_LOGV(TAG, "%s power save", sleep ? "Entering" : "Leaving");
+  this->power_save_callback_.call(sleep);
+}
 
 std::string WiFiComponent::format_mac_addr(const uint8_t *mac) {
   char buf[20];
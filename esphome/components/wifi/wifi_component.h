@@ -4,6 +4,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/preferences.h"
 #include <string>
 #include <IPAddress.h>
 
@@ -142,10 +143,25 @@ struct WiFiSTAPriority {
   float priority;
 };
 
+/// The network and DHCP lease of the last successful connection, tried before scanning on the next boot.
+struct WiFiFastConnectSettings {
+  /// FNV-1 hash of the SSID, so that the settings are dropped when the network configuration changes.
+  uint32_t ssid_hash;
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint32_t ip;
+  uint32_t gateway;
+  uint32_t subnet;
+  uint32_t dns1;
+  uint32_t dns2;
+};
+
 enum WiFiPowerSaveMode {
   WIFI_POWER_SAVE_NONE = 0,
   WIFI_POWER_SAVE_LIGHT,
   WIFI_POWER_SAVE_HIGH,
+  /// Light power save while the traffic is quiet, none while there is traffic.
+  WIFI_POWER_SAVE_ADAPTIVE,
 };
 
 /// This component is responsible for managing the ESP WiFi interface.
@@ -170,6 +186,19 @@ class WiFiComponent : public Component {
   void check_scanning_finished();
   void start_connecting(const WiFiAP &ap, bool two);
   void set_fast_connect(bool fast_connect);
+  /** Connect with the IP address, gateway and DNS servers DHCP assigned last time, instead of waiting for DHCP.
+   *
+   * Only use this if the DHCP server hands out the same address to this device, otherwise the address might
+   * be in use by another host by now.
+   */
+  void set_reuse_dhcp_lease(bool reuse_dhcp_lease) { this->reuse_dhcp_lease_ = reuse_dhcp_lease; }
+  /** Scan passively for access points of the same network every interval ms while connected, and switch to one
+   * whose signal is at least hysteresis dB stronger. 0 disables roaming.
+   */
+  void set_roaming(uint32_t interval, int8_t hysteresis) {
+    this->roam_interval_ = interval;
+    this->roam_hysteresis_ = hysteresis;
+  }
   void set_ap_timeout(uint32_t ap_timeout) { ap_timeout_ = ap_timeout; }
 
   void check_connecting_finished();
@@ -183,8 +212,42 @@ class WiFiComponent : public Component {
   bool is_connected();
 
   void set_power_save_mode(WiFiPowerSaveMode power_save);
+  /// Set how long the traffic has to be quiet before the adaptive power save mode enters power save again.
+  void set_power_save_quiet_period(uint32_t quiet_period) { this->power_save_quiet_period_ = quiet_period; }
+  /** Signal that there is traffic, the adaptive power save mode leaves power save until it is quiet again.
+   *
+   * Can be called from any task.
+   */
+  void mark_activity();
+  /// Report the round trip time of a request, measured by a protocol. Only used for diagnostics.
+  void report_round_trip_time(uint32_t round_trip_time);
+  /// Whether the adaptive power save mode is in power save right now.
+  bool is_power_save_active() const { return this->power_save_sleeping_; }
+  /// The number of times the adaptive power save mode switched between power save and none.
+  uint32_t get_power_save_switches() const { return this->power_save_switches_; }
+  /// Called with whether power save is active each time the adaptive power save mode switches.
+  void add_on_power_save_callback(std::function<void(bool)> &&callback) {
+    this->power_save_callback_.add(std::move(callback));
+  }
+  /// Called with each reported round trip time and whether power save was active.
+  void add_on_round_trip_time_callback(std::function<void(uint32_t, bool)> &&callback) {
+    this->round_trip_time_callback_.add(std::move(callback));
+  }
   void set_output_power(float output_power) { output_power_ = output_power; }
 
+  /// The time in ms it took to connect, from boot or from losing the previous connection.
+  optional<uint32_t> get_connect_time() const { return this->connect_time_; }
+  /// Called with the connect time each time a connection is established.
+  void add_on_connect_callback(std::function<void(uint32_t)> &&callback) {
+    this->connect_callback_.add(std::move(callback));
+  }
+  /// The number of times the connection switched to a stronger access point.
+  uint32_t get_roam_count() const { return this->roam_count_; }
+  /// Called with the signal strength before and after each roam.
+  void add_on_roam_callback(std::function<void(int8_t, int8_t)> &&callback) {
+    this->roam_callback_.add(std::move(callback));
+  }
+
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Setup WiFi interface.
@@ -196,6 +259,7 @@ class WiFiComponent : public Component {
 
   /// Reconnect WiFi if required.
   void loop() override;
+  bool is_loop_idle() override;
 
   bool has_sta() const;
   bool has_ap() const;
@@ -205,6 +269,8 @@ class WiFiComponent : public Component {
   void set_use_address(const std::string &use_address);
 
   const std::vector<WiFiScanResult> &get_scan_result() const { return scan_result_; }
+  /// Increases whenever the scan result changes, so that views of it only have to be rebuilt then.
+  uint32_t get_scan_generation() const { return this->scan_generation_; }
 
   IPAddress wifi_soft_ap_ip();
 
@@ -247,13 +313,21 @@ class WiFiComponent : public Component {
   bool wifi_sta_connect_(WiFiAP ap);
   void wifi_pre_setup_();
   wl_status_t wifi_sta_status_();
-  bool wifi_scan_start_();
+  bool wifi_scan_start_(bool passive = false);
   bool wifi_ap_ip_config_(optional<ManualIP> manual_ip);
   bool wifi_start_ap_(const WiFiAP &ap);
   bool wifi_disconnect_();
 
   bool is_captive_portal_active_();
 
+  /// Start connecting to the network saved on the last successful connection, if there is one.
+  bool start_fast_connecting_();
+  void save_fast_connect_settings_();
+  /// Connect to the strongest access point of the current network from the roaming scan, if it's better enough.
+  void check_roaming_scan_();
+  /// Enter or leave power save for the adaptive power save mode.
+  void update_adaptive_power_save_();
+
 #ifdef ARDUINO_ARCH_ESP8266
   static void wifi_event_callback(System_Event_t *event);
   void wifi_scan_done_callback_(void *arg, STATUS status);
@@ -281,9 +355,33 @@ class WiFiComponent : public Component {
   WiFiPowerSaveMode power_save_{WIFI_POWER_SAVE_NONE};
   bool error_from_callback_{false};
   std::vector<WiFiScanResult> scan_result_;
+  uint32_t scan_generation_{0};
   bool scan_done_{false};
   bool ap_setup_{false};
   optional<float> output_power_;
+  ESPPreferenceObject fast_connect_pref_;
+  bool reuse_dhcp_lease_{false};
+  /// Whether the current attempt uses the saved settings, a failure falls back to scanning.
+  bool fast_connecting_{false};
+  uint32_t connect_started_{0};
+  optional<uint32_t> connect_time_{};
+  CallbackManager<void(uint32_t)> connect_callback_;
+  uint32_t roam_interval_{0};
+  int8_t roam_hysteresis_{10};
+  bool roam_scanning_{false};
+  uint32_t roam_scan_started_{0};
+  /// Whether the current attempt switches to another access point, the signal strength before is roam_rssi_.
+  bool roaming_{false};
+  int8_t roam_rssi_{0};
+  uint32_t roam_count_{0};
+  CallbackManager<void(int8_t, int8_t)> roam_callback_;
+  uint32_t power_save_quiet_period_{5000};
+  /// Written by mark_activity() from any task.
+  volatile uint32_t last_activity_{0};
+  bool power_save_sleeping_{false};
+  uint32_t power_save_switches_{0};
+  CallbackManager<void(bool)> power_save_callback_;
+  CallbackManager<void(uint32_t, bool)> round_trip_time_callback_;
 };
 
 extern WiFiComponent *global_wifi_component;
@@ -77,6 +77,9 @@ bool WiFiComponent::wifi_apply_power_save_() {
     case WIFI_POWER_SAVE_HIGH:
       power_save = WIFI_PS_MAX_MODEM;
       break;
+    case WIFI_POWER_SAVE_ADAPTIVE:
+      power_save = this->power_save_sleeping_ ? WIFI_PS_MIN_MODEM : WIFI_PS_NONE;
+      break;
     case WIFI_POWER_SAVE_NONE:
     default:
       power_save = WIFI_PS_NONE;
@@ -461,6 +464,7 @@ void WiFiComponent::wifi_event_callback_(system_event_id_t event, system_event_i
   if (event == SYSTEM_EVENT_SCAN_DONE) {
     this->wifi_scan_done_callback_();
   }
+  App.wake_loop();
 }
 void WiFiComponent::wifi_pre_setup_() {
   auto f = std::bind(&WiFiComponent::wifi_event_callback_, this, std::placeholders::_1, std::placeholders::_2);
@@ -470,13 +474,13 @@ void WiFiComponent::wifi_pre_setup_() {
   this->wifi_mode_(false, false);
 }
 wl_status_t WiFiComponent::wifi_sta_status_() { return WiFi.status(); }
-bool WiFiComponent::wifi_scan_start_() {
+bool WiFiComponent::wifi_scan_start_(bool passive) {
   // enable STA
   if (!this->wifi_mode_(true, {}))
     return false;
 
   // need to use WiFi because of WiFiScanClass allocations :(
-  int16_t err = WiFi.scanNetworks(true, true, false, 200);
+  int16_t err = WiFi.scanNetworks(true, true, passive, passive ? 120 : 200);
   if (err != WIFI_SCAN_RUNNING) {
     ESP_LOGV(TAG, "WiFi.scanNetworks failed! %d", err);
     return false;
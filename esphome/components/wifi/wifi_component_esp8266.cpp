@@ -78,6 +78,9 @@ bool WiFiComponent::wifi_apply_power_save_() {
     case WIFI_POWER_SAVE_HIGH:
       power_save = MODEM_SLEEP_T;
       break;
+    case WIFI_POWER_SAVE_ADAPTIVE:
+      power_save = this->power_save_sleeping_ ? LIGHT_SLEEP_T : NONE_SLEEP_T;
+      break;
     case WIFI_POWER_SAVE_NONE:
     default:
       power_save = NONE_SLEEP_T;
@@ -508,6 +511,7 @@ void WiFiComponent::wifi_event_callback(System_Event_t *event) {
   }
 
   WiFiMockClass::_event_callback(event);
+  App.wake_loop();
 }
 
 bool WiFiComponent::wifi_apply_output_power_(float output_power) {
@@ -557,7 +561,7 @@ wl_status_t WiFiComponent::wifi_sta_status_() {
       return WL_DISCONNECTED;
   }
 }
-bool WiFiComponent::wifi_scan_start_() {
+bool WiFiComponent::wifi_scan_start_(bool passive) {
   static bool FIRST_SCAN = false;
 
   // enable STA
@@ -572,7 +576,10 @@ bool WiFiComponent::wifi_scan_start_() {
   config.show_hidden = 1;
 #ifndef ARDUINO_ESP8266_RELEASE_2_3_0
   config.scan_type = WIFI_SCAN_TYPE_ACTIVE;
-  if (FIRST_SCAN) {
+  if (passive) {
+    config.scan_type = WIFI_SCAN_TYPE_PASSIVE;
+    config.scan_time.passive = 120;
+  } else if (FIRST_SCAN) {
     config.scan_time.active.min = 100;
     config.scan_time.active.max = 200;
   } else {
@@ -610,7 +617,11 @@ void WiFiComponent::wifi_scan_done_callback_(void *arg, STATUS status) {
 
   if (status != OK) {
     ESP_LOGV(TAG, "Scan failed! %d", status);
-    this->retry_connect();
+    // a failed roaming scan doesn't affect the connection
+    if (this->state_ != WIFI_COMPONENT_STATE_STA_CONNECTED)
+      this->retry_connect();
+    else
+      this->scan_done_ = true;
     return;
   }
   auto *head = reinterpret_cast<bss_info *>(arg);
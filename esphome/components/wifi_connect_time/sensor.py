@@ -0,0 +1,18 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID, ICON_TIMER, UNIT_MILLISECOND
+
+DEPENDENCIES = ['wifi']
+wifi_connect_time_ns = cg.esphome_ns.namespace('wifi_connect_time')
+WiFiConnectTimeSensor = wifi_connect_time_ns.class_('WiFiConnectTimeSensor', sensor.Sensor, cg.Component)
+
+CONFIG_SCHEMA = sensor.sensor_schema(UNIT_MILLISECOND, ICON_TIMER, 0).extend({
+    cv.GenerateID(): cv.declare_id(WiFiConnectTimeSensor),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+    yield sensor.register_sensor(var, config)
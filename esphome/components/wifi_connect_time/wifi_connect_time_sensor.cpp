@@ -0,0 +1,20 @@
+#include "wifi_connect_time_sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace wifi_connect_time {
+
+static const char *TAG = "wifi_connect_time.sensor";
+
+void WiFiConnectTimeSensor::setup() {
+  // the first connection is usually made before this component is set up
+  auto connect_time = wifi::global_wifi_component->get_connect_time();
+  if (connect_time.has_value())
+    this->publish_state(*connect_time);
+  wifi::global_wifi_component->add_on_connect_callback(
+      [this](uint32_t connect_time) { this->publish_state(connect_time); });
+}
+void WiFiConnectTimeSensor::dump_config() { LOG_SENSOR("", "WiFi Connect Time", this); }
+
+}  // namespace wifi_connect_time
+}  // namespace esphome
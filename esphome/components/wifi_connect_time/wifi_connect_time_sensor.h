@@ -0,0 +1,22 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/wifi/wifi_component.h"
+
+namespace esphome {
+namespace wifi_connect_time {
+
+/// Publishes the time each WiFi connection took to establish, from boot or from losing the previous one.
+class WiFiConnectTimeSensor : public sensor::Sensor, public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+
+  std::string unique_id() override { return get_mac_address() + "-wificonnecttime"; }
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+};
+
+}  // namespace wifi_connect_time
+}  // namespace esphome
@@ -0,0 +1,29 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID, ICON_COUNTER, ICON_TIMER, UNIT_EMPTY, UNIT_MILLISECOND
+
+DEPENDENCIES = ['wifi']
+wifi_power_save_ns = cg.esphome_ns.namespace('wifi_power_save')
+WiFiPowerSaveSensor = wifi_power_save_ns.class_('WiFiPowerSaveSensor', cg.Component)
+
+CONF_SWITCH_COUNT = 'switch_count'
+CONF_ROUND_TRIP_TIME = 'round_trip_time'
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(WiFiPowerSaveSensor),
+    cv.Optional(CONF_SWITCH_COUNT): sensor.sensor_schema(UNIT_EMPTY, ICON_COUNTER, 0),
+    cv.Optional(CONF_ROUND_TRIP_TIME): sensor.sensor_schema(UNIT_MILLISECOND, ICON_TIMER, 0),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    if CONF_SWITCH_COUNT in config:
+        sens = yield sensor.new_sensor(config[CONF_SWITCH_COUNT])
+        cg.add(var.set_switch_count_sensor(sens))
+    if CONF_ROUND_TRIP_TIME in config:
+        sens = yield sensor.new_sensor(config[CONF_ROUND_TRIP_TIME])
+        cg.add(var.set_round_trip_time_sensor(sens))
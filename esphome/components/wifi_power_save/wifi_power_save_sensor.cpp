@@ -0,0 +1,30 @@
+#include "wifi_power_save_sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace wifi_power_save {
+
+static const char *TAG = "wifi_power_save.sensor";
+
+void WiFiPowerSaveSensor::setup() {
+  if (this->switch_count_sensor_ != nullptr) {
+    this->switch_count_sensor_->publish_state(wifi::global_wifi_component->get_power_save_switches());
+    wifi::global_wifi_component->add_on_power_save_callback([this](bool sleeping) {
+      this->switch_count_sensor_->publish_state(wifi::global_wifi_component->get_power_save_switches());
+    });
+  }
+  if (this->round_trip_time_sensor_ != nullptr) {
+    // the round trip time while the radio sleeps includes the wake up, it is what the clients see
+    wifi::global_wifi_component->add_on_round_trip_time_callback([this](uint32_t round_trip_time, bool sleeping) {
+      this->round_trip_time_sensor_->publish_state(round_trip_time);
+    });
+  }
+}
+void WiFiPowerSaveSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "WiFi Power Save:");
+  LOG_SENSOR("  ", "Switch Count", this->switch_count_sensor_);
+  LOG_SENSOR("  ", "Round Trip Time", this->round_trip_time_sensor_);
+}
+
+}  // namespace wifi_power_save
+}  // namespace esphome
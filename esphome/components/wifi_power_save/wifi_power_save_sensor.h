@@ -0,0 +1,30 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/wifi/wifi_component.h"
+
+namespace esphome {
+namespace wifi_power_save {
+
+/// Publishes how often the adaptive power save mode switched and the round trip time of the API keepalive pings.
+class WiFiPowerSaveSensor : public Component {
+ public:
+  void set_switch_count_sensor(sensor::Sensor *switch_count_sensor) {
+    this->switch_count_sensor_ = switch_count_sensor;
+  }
+  void set_round_trip_time_sensor(sensor::Sensor *round_trip_time_sensor) {
+    this->round_trip_time_sensor_ = round_trip_time_sensor;
+  }
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+ protected:
+  sensor::Sensor *switch_count_sensor_{nullptr};
+  sensor::Sensor *round_trip_time_sensor_{nullptr};
+};
+
+}  // namespace wifi_power_save
+}  // namespace esphome
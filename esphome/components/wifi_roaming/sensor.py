@@ -0,0 +1,34 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID, ICON_COUNTER, ICON_WIFI, UNIT_DECIBEL, UNIT_EMPTY
+
+DEPENDENCIES = ['wifi']
+wifi_roaming_ns = cg.esphome_ns.namespace('wifi_roaming')
+WiFiRoamingSensor = wifi_roaming_ns.class_('WiFiRoamingSensor', cg.Component)
+
+CONF_ROAM_COUNT = 'roam_count'
+CONF_RSSI_BEFORE = 'rssi_before'
+CONF_RSSI_AFTER = 'rssi_after'
+
+CONFIG_SCHEMA = cv.Schema({
+    cv.GenerateID(): cv.declare_id(WiFiRoamingSensor),
+    cv.Optional(CONF_ROAM_COUNT): sensor.sensor_schema(UNIT_EMPTY, ICON_COUNTER, 0),
+    cv.Optional(CONF_RSSI_BEFORE): sensor.sensor_schema(UNIT_DECIBEL, ICON_WIFI, 0),
+    cv.Optional(CONF_RSSI_AFTER): sensor.sensor_schema(UNIT_DECIBEL, ICON_WIFI, 0),
+}).extend(cv.COMPONENT_SCHEMA)
+
+
+def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    yield cg.register_component(var, config)
+
+    if CONF_ROAM_COUNT in config:
+        sens = yield sensor.new_sensor(config[CONF_ROAM_COUNT])
+        cg.add(var.set_roam_count_sensor(sens))
+    if CONF_RSSI_BEFORE in config:
+        sens = yield sensor.new_sensor(config[CONF_RSSI_BEFORE])
+        cg.add(var.set_rssi_before_sensor(sens))
+    if CONF_RSSI_AFTER in config:
+        sens = yield sensor.new_sensor(config[CONF_RSSI_AFTER])
+        cg.add(var.set_rssi_after_sensor(sens))
@@ -0,0 +1,29 @@
+#include "wifi_roaming_sensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace wifi_roaming {
+
+static const char *TAG = "wifi_roaming.sensor";
+
+void WiFiRoamingSensor::setup() {
+  if (this->roam_count_sensor_ != nullptr)
+    this->roam_count_sensor_->publish_state(wifi::global_wifi_component->get_roam_count());
+  wifi::global_wifi_component->add_on_roam_callback([this](int8_t rssi_before, int8_t rssi_after) {
+    if (this->roam_count_sensor_ != nullptr)
+      this->roam_count_sensor_->publish_state(wifi::global_wifi_component->get_roam_count());
+    if (this->rssi_before_sensor_ != nullptr)
+      this->rssi_before_sensor_->publish_state(rssi_before);
+    if (this->rssi_after_sensor_ != nullptr)
+      this->rssi_after_sensor_->publish_state(rssi_after);
+  });
+}
+void WiFiRoamingSensor::dump_config() {
+  ESP_LOGCONFIG(TAG, "WiFi Roaming:");
+  LOG_SENSOR("  ", "Roam Count", this->roam_count_sensor_);
+  LOG_SENSOR("  ", "RSSI Before", this->rssi_before_sensor_);
+  LOG_SENSOR("  ", "RSSI After", this->rssi_after_sensor_);
+}
+
+}  // namespace wifi_roaming
+}  // namespace esphome
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/wifi/wifi_component.h"
+
+namespace esphome {
+namespace wifi_roaming {
+
+/// Publishes the number of roams and the signal strength before and after the last one.
+class WiFiRoamingSensor : public Component {
+ public:
+  void set_roam_count_sensor(sensor::Sensor *roam_count_sensor) { this->roam_count_sensor_ = roam_count_sensor; }
+  void set_rssi_before_sensor(sensor::Sensor *rssi_before_sensor) { this->rssi_before_sensor_ = rssi_before_sensor; }
+  void set_rssi_after_sensor(sensor::Sensor *rssi_after_sensor) { this->rssi_after_sensor_ = rssi_after_sensor; }
+
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+ protected:
+  sensor::Sensor *roam_count_sensor_{nullptr};
+  sensor::Sensor *rssi_before_sensor_{nullptr};
+  sensor::Sensor *rssi_after_sensor_{nullptr};
+};
+
+}  // namespace wifi_roaming
+}  // namespace esphome
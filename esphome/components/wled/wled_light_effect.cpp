@@ -26,7 +26,11 @@ WLEDLightEffect::WLEDLightEffect(const std::string &name) : AddressableLightEffe
 void WLEDLightEffect::start() {
   AddressableLightEffect::start();
 
-  blank_at_ = 0;
+  // blank the LEDs on the first apply()
+  this->last_frame_ = millis() - DEFAULT_BLANK_TIME;
+  this->blank_timeout_ = DEFAULT_BLANK_TIME;
+  this->received_frames_ = 0;
+  this->rendered_frames_ = 0;
 }
 
 void WLEDLightEffect::stop() {
@@ -36,12 +40,11 @@ void WLEDLightEffect::stop() {
     udp_->stop();
     udp_.reset();
   }
+  this->pending_.clear();
 }
 
 void WLEDLightEffect::blank_all_leds_(light::AddressableLight &it) {
-  for (int led = it.size(); led-- > 0;) {
-    it[led].set(light::ESPColor::BLACK);
-  }
+  it.fill_range(0, it.size(), light::ESPColor::BLACK);
 }
 
 void WLEDLightEffect::apply(light::AddressableLight &it, const light::ESPColor &current_color) {
@@ -55,25 +58,46 @@ void WLEDLightEffect::apply(light::AddressableLight &it, const light::ESPColor &
     }
   }
 
-  std::vector<uint8_t> payload;
   while (uint16_t packet_size = udp_->parsePacket()) {
-    payload.resize(packet_size);
+    this->packet_.resize(packet_size);
 
-    if (!udp_->read(&payload[0], payload.size())) {
+    if (!udp_->read(&this->packet_[0], this->packet_.size())) {
       continue;
     }
+    this->received_frames_++;
 
-    if (!this->parse_frame_(it, &payload[0], payload.size())) {
-      ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=0x%02X).", payload.size(), payload[0]);
+    const uint8_t protocol = this->packet_[0];
+    if (protocol == DRGB || protocol == DRGBW) {
+      // a full frame replaces all frames before it, only the newest one of the queued packets is rendered
+      std::swap(this->packet_, this->pending_);
       continue;
     }
+    // WARLS and DNRGB packets may update only part of the LEDs, so they are applied in order
+    if (!this->pending_.empty()) {
+      this->render_(it, this->pending_);
+      this->pending_.clear();
+    }
+    this->render_(it, this->packet_);
+  }
+  if (!this->pending_.empty()) {
+    this->render_(it, this->pending_);
+    this->pending_.clear();
   }
 
-  // FIXME: Use roll-over safe arithmetic
-  if (blank_at_ < millis()) {
+  const uint32_t now = millis();
+  if (this->blank_timeout_ != 0 && now - this->last_frame_ >= this->blank_timeout_) {
     blank_all_leds_(it);
-    blank_at_ = millis() + DEFAULT_BLANK_TIME;
+    this->last_frame_ = now;
+    this->blank_timeout_ = DEFAULT_BLANK_TIME;
+  }
+}
+
+void WLEDLightEffect::render_(light::AddressableLight &it, const std::vector<uint8_t> &packet) {
+  if (!this->parse_frame_(it, packet.data(), packet.size())) {
+    ESP_LOGD(TAG, "Frame: Invalid (size=%zu, first=0x%02X).", packet.size(), packet[0]);
+    return;
   }
+  this->rendered_frames_++;
 }
 
 bool WLEDLightEffect::parse_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size) {
@@ -120,12 +144,13 @@ bool WLEDLightEffect::parse_frame_(light::AddressableLight &it, const uint8_t *p
       return false;
   }
 
+  this->last_frame_ = millis();
   if (timeout == UINT8_MAX) {
-    blank_at_ = UINT32_MAX;
+    this->blank_timeout_ = 0;
   } else if (timeout > 0) {
-    blank_at_ = millis() + timeout * 1000;
+    this->blank_timeout_ = timeout * 1000;
   } else {
-    blank_at_ = millis() + DEFAULT_BLANK_TIME;
+    this->blank_timeout_ = DEFAULT_BLANK_TIME;
   }
 
   return true;
@@ -165,19 +190,8 @@ bool WLEDLightEffect::parse_drgb_frame_(light::AddressableLight &it, const uint8
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 3) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-
-    if (led < max_leds) {
-      it[led].set(light::ESPColor(r, g, b));
-    }
-  }
-
+  // LEDs beyond the end of the light are ignored
+  it.write_rgb_span(payload, size / 3);
   return true;
 }
 
@@ -187,20 +201,7 @@ bool WLEDLightEffect::parse_drgbw_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 4;
-  auto max_leds = it.size();
-
-  for (uint16_t led = 0; led < count; ++led, payload += 4) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-    uint8_t w = payload[3];
-
-    if (led < max_leds) {
-      it[led].set(light::ESPColor(r, g, b, w));
-    }
-  }
-
+  it.write_rgbw_span(payload, size / 4);
   return true;
 }
 
@@ -219,19 +220,9 @@ bool WLEDLightEffect::parse_dnrgb_frame_(light::AddressableLight &it, const uint
     return false;
   }
 
-  auto count = size / 3;
-  auto max_leds = it.size();
-
-  for (; count > 0; count--, payload += 3, led++) {
-    uint8_t r = payload[0];
-    uint8_t g = payload[1];
-    uint8_t b = payload[2];
-
-    if (led < max_leds) {
-      it[led].set(light::ESPColor(r, g, b));
-    }
+  if (led < it.size()) {
+    it.write_rgb_span(payload, size / 3, led);
   }
-
   return true;
 }
 
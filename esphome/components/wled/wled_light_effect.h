@@ -20,9 +20,14 @@ class WLEDLightEffect : public light::AddressableLightEffect {
   void stop() override;
   void apply(light::AddressableLight &it, const light::ESPColor &current_color) override;
   void set_port(uint16_t port) { this->port_ = port; }
+  /// The number of packets received since the effect was started.
+  uint32_t get_received_frames() const { return this->received_frames_; }
+  /// The number of packets that were applied to the LEDs, the others were invalid or replaced by a newer frame.
+  uint32_t get_rendered_frames() const { return this->rendered_frames_; }
 
  protected:
   void blank_all_leds_(light::AddressableLight &it);
+  void render_(light::AddressableLight &it, const std::vector<uint8_t> &packet);
   bool parse_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
   bool parse_notifier_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
   bool parse_warls_frame_(light::AddressableLight &it, const uint8_t *payload, uint16_t size);
@@ -33,8 +38,16 @@ class WLEDLightEffect : public light::AddressableLightEffect {
  protected:
   uint16_t port_{0};
   std::unique_ptr<UDP> udp_;
-  uint32_t blank_at_{0};
-  uint32_t dropped_{0};
+  /// The packet read last, kept to reuse its capacity.
+  std::vector<uint8_t> packet_;
+  /// The newest full frame (DRGB or DRGBW) that wasn't rendered yet, empty if none.
+  std::vector<uint8_t> pending_;
+  /// When the last frame was rendered (or the LEDs were blanked), in ms.
+  uint32_t last_frame_{0};
+  /// The time after the last frame until the LEDs are blanked in ms, 0 never blanks them.
+  uint32_t blank_timeout_{0};
+  uint32_t received_frames_{0};
+  uint32_t rendered_frames_{0};
 };
 
 }  // namespace wled
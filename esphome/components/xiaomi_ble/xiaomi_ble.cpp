@@ -5,7 +5,6 @@
 #ifdef ARDUINO_ARCH_ESP32
 
 #include <vector>
-#include "mbedtls/ccm.h"
 
 namespace esphome {
 namespace xiaomi_ble {
@@ -205,91 +204,76 @@ optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::Service
   return result;
 }
 
-bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address) {
+void XiaomiDecryptor::set_bindkey(const uint8_t *bindkey) {
+  // the key schedule is only computed once per device instead of for every packet
+  this->has_key_ = mbedtls_ccm_setkey(&this->ctx_, MBEDTLS_CIPHER_ID_AES, bindkey, 128) == 0;
+  if (!this->has_key_) {
+    ESP_LOGE(TAG, "mbedtls_ccm_setkey() failed.");
+  }
+  this->has_counter_ = false;
+}
+
+bool XiaomiDecryptor::decrypt(std::vector<uint8_t> &raw, uint64_t address) {
   if (!((raw.size() == 19) || ((raw.size() >= 22) && (raw.size() <= 24)))) {
-    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): data packet has wrong size (%d)!", raw.size());
+    ESP_LOGVV(TAG, "decrypt(): data packet has wrong size (%d)!", raw.size());
     ESP_LOGVV(TAG, "  Packet : %s", hexencode(raw.data(), raw.size()).c_str());
     return false;
   }
-
-  uint8_t mac_reverse[6] = {0};
-  mac_reverse[5] = (uint8_t)(address >> 40);
-  mac_reverse[4] = (uint8_t)(address >> 32);
-  mac_reverse[3] = (uint8_t)(address >> 24);
-  mac_reverse[2] = (uint8_t)(address >> 16);
-  mac_reverse[1] = (uint8_t)(address >> 8);
-  mac_reverse[0] = (uint8_t)(address >> 0);
-
-  XiaomiAESVector vector{.key = {0},
-                         .plaintext = {0},
-                         .ciphertext = {0},
-                         .authdata = {0x11},
-                         .iv = {0},
-                         .tag = {0},
-                         .keysize = 16,
-                         .authsize = 1,
-                         .datasize = 0,
-                         .tagsize = 4,
-                         .ivsize = 12};
-
-  vector.datasize = (raw.size() == 19) ? raw.size() - 12 : raw.size() - 18;
-  int cipher_pos = (raw.size() == 19) ? 5 : 11;
+  if (!this->has_key_) {
+    ESP_LOGVV(TAG, "decrypt(): no bindkey.");
+    return false;
+  }
 
   const uint8_t *v = raw.data();
-
-  memcpy(vector.key, bindkey, vector.keysize);
-  memcpy(vector.ciphertext, v + cipher_pos, vector.datasize);
-  memcpy(vector.tag, v + raw.size() - vector.tagsize, vector.tagsize);
-  memcpy(vector.iv, mac_reverse, 6);             // MAC address reverse
-  memcpy(vector.iv + 6, v + 2, 3);               // sensor type (2) + packet id (1)
-  memcpy(vector.iv + 9, v + raw.size() - 7, 3);  // payload counter
-
-  mbedtls_ccm_context ctx;
-  mbedtls_ccm_init(&ctx);
-
-  int ret = mbedtls_ccm_setkey(&ctx, MBEDTLS_CIPHER_ID_AES, vector.key, vector.keysize * 8);
-  if (ret) {
-    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): mbedtls_ccm_setkey() failed.");
-    mbedtls_ccm_free(&ctx);
+  const size_t datasize = (raw.size() == 19) ? raw.size() - 12 : raw.size() - 18;
+  const int cipher_pos = (raw.size() == 19) ? 5 : 11;
+  const uint8_t *payload_counter = v + raw.size() - 7;
+  const uint8_t *tag = v + raw.size() - 4;
+
+  // retransmissions repeat the frame counter and the payload counter, drop them before spending time on them
+  const uint32_t counter = (uint32_t(v[4]) << 24) | (uint32_t(payload_counter[2]) << 16) |
+                           (uint32_t(payload_counter[1]) << 8) | payload_counter[0];
+  if (this->has_counter_ && counter == this->last_counter_) {
+    ESP_LOGVV(TAG, "decrypt(): replayed data packet (%d).", static_cast<int>(v[4]));
     return false;
   }
 
-  ret = mbedtls_ccm_auth_decrypt(&ctx, vector.datasize, vector.iv, vector.ivsize, vector.authdata, vector.authsize,
-                                 vector.ciphertext, vector.plaintext, vector.tag, vector.tagsize);
+  uint8_t iv[12];
+  for (uint8_t i = 0; i < 6; i++)
+    iv[i] = uint8_t(address >> (i * 8));  // MAC address reverse
+  memcpy(iv + 6, v + 2, 3);               // sensor type (2) + packet id (1)
+  memcpy(iv + 9, payload_counter, 3);     // payload counter
+
+  static const uint8_t AUTHDATA = 0x11;
+  uint8_t plaintext[16];
+  int ret = mbedtls_ccm_auth_decrypt(&this->ctx_, datasize, iv, sizeof(iv), &AUTHDATA, 1, v + cipher_pos, plaintext,
+                                     tag, 4);
   if (ret) {
-    uint8_t mac_address[6] = {0};
-    memcpy(mac_address, mac_reverse + 5, 1);
-    memcpy(mac_address + 1, mac_reverse + 4, 1);
-    memcpy(mac_address + 2, mac_reverse + 3, 1);
-    memcpy(mac_address + 3, mac_reverse + 2, 1);
-    memcpy(mac_address + 4, mac_reverse + 1, 1);
-    memcpy(mac_address + 5, mac_reverse, 1);
-    ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption failed.");
+    ESP_LOGVV(TAG, "decrypt(): authenticated decryption failed.");
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+    uint8_t mac_address[6];
+    for (uint8_t i = 0; i < 6; i++)
+      mac_address[i] = uint8_t(address >> ((5 - i) * 8));
     ESP_LOGVV(TAG, "  MAC address : %s", hexencode(mac_address, 6).c_str());
+#endif
     ESP_LOGVV(TAG, "       Packet : %s", hexencode(raw.data(), raw.size()).c_str());
-    ESP_LOGVV(TAG, "          Key : %s", hexencode(vector.key, vector.keysize).c_str());
-    ESP_LOGVV(TAG, "           Iv : %s", hexencode(vector.iv, vector.ivsize).c_str());
-    ESP_LOGVV(TAG, "       Cipher : %s", hexencode(vector.ciphertext, vector.datasize).c_str());
-    ESP_LOGVV(TAG, "          Tag : %s", hexencode(vector.tag, vector.tagsize).c_str());
-    mbedtls_ccm_free(&ctx);
+    ESP_LOGVV(TAG, "           Iv : %s", hexencode(iv, sizeof(iv)).c_str());
+    ESP_LOGVV(TAG, "       Cipher : %s", hexencode(v + cipher_pos, datasize).c_str());
+    ESP_LOGVV(TAG, "          Tag : %s", hexencode(tag, 4).c_str());
     return false;
   }
+  this->has_counter_ = true;
+  this->last_counter_ = counter;
 
   // replace encrypted payload with plaintext
-  uint8_t *p = vector.plaintext;
-  for (std::vector<uint8_t>::iterator it = raw.begin() + cipher_pos; it != raw.begin() + cipher_pos + vector.datasize;
-       ++it) {
-    *it = *(p++);
-  }
+  memcpy(raw.data() + cipher_pos, plaintext, datasize);
 
   // clear encrypted flag
   raw[0] &= ~0x08;
 
-  ESP_LOGVV(TAG, "decrypt_xiaomi_payload(): authenticated decryption passed.");
-  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", hexencode(raw.data() + cipher_pos, vector.datasize).c_str(),
+  ESP_LOGVV(TAG, "decrypt(): authenticated decryption passed.");
+  ESP_LOGVV(TAG, "  Plaintext : %s, Packet : %d", hexencode(raw.data() + cipher_pos, datasize).c_str(),
             static_cast<int>(raw[4]));
-
-  mbedtls_ccm_free(&ctx);
   return true;
 }
 
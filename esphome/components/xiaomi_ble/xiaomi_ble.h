@@ -5,6 +5,8 @@
 
 #ifdef ARDUINO_ARCH_ESP32
 
+#include "mbedtls/ccm.h"
+
 namespace esphome {
 namespace xiaomi_ble {
 
@@ -44,28 +46,41 @@ struct XiaomiParseResult {
   int raw_offset;
 };
 
-struct XiaomiAESVector {
-  uint8_t key[16];
-  uint8_t plaintext[16];
-  uint8_t ciphertext[16];
-  uint8_t authdata[16];
-  uint8_t iv[16];
-  uint8_t tag[16];
-  size_t keysize;
-  size_t authsize;
-  size_t datasize;
-  size_t tagsize;
-  size_t ivsize;
+/** Decrypts the encrypted payloads of one device.
+ *
+ * The AES-CCM context with the expanded bindkey is kept between packets, mbedtls uses the hardware AES accelerator
+ * of the ESP32 for it. Retransmissions of the last authenticated packet are dropped before they are decrypted.
+ */
+class XiaomiDecryptor {
+ public:
+  XiaomiDecryptor() { mbedtls_ccm_init(&this->ctx_); }
+  XiaomiDecryptor(const XiaomiDecryptor &) = delete;
+  XiaomiDecryptor &operator=(const XiaomiDecryptor &) = delete;
+  ~XiaomiDecryptor() { mbedtls_ccm_free(&this->ctx_); }
+
+  void set_bindkey(const uint8_t *bindkey);
+  /// Replace the encrypted payload of the service data with the plaintext, false if it is a replay or not authentic.
+  bool decrypt(std::vector<uint8_t> &raw, uint64_t address);
+
+ protected:
+  mbedtls_ccm_context ctx_;
+  bool has_key_{false};
+  /// The frame counter and the payload counter of the last authenticated packet.
+  bool has_counter_{false};
+  uint32_t last_counter_{0};
 };
 
 bool parse_xiaomi_value(uint8_t value_type, const uint8_t *data, uint8_t value_length, XiaomiParseResult &result);
 bool parse_xiaomi_message(const std::vector<uint8_t> &message, XiaomiParseResult &result);
 optional<XiaomiParseResult> parse_xiaomi_header(const esp32_ble_tracker::ServiceData &service_data);
-bool decrypt_xiaomi_payload(std::vector<uint8_t> &raw, const uint8_t *bindkey, const uint64_t &address);
 bool report_xiaomi_results(const optional<XiaomiParseResult> &result, const std::string &address);
 
 class XiaomiListener : public esp32_ble_tracker::ESPBTDeviceListener {
  public:
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    // Xiaomi Inc.
+    filter.service_data_uuids.push_back(0xFE95);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 };
 
@@ -14,6 +14,9 @@ class XiaomiCGG1 : public Component, public esp32_ble_tracker::ESPBTDeviceListen
  public:
   void set_address(uint64_t address) { address_ = address; }
 
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    filter.addresses.push_back(this->address_);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 
   void dump_config() override;
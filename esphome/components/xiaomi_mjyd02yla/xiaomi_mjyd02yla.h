@@ -18,6 +18,9 @@ class XiaomiMJYD02YLA : public Component,
   void set_address(uint64_t address) { address_ = address; }
   void set_bindkey(const std::string &bindkey);
 
+  void get_advertisement_filter(esp32_ble_tracker::ESPBTAdvertisementFilter &filter) override {
+    filter.addresses.push_back(this->address_);
+  }
   bool parse_device(const esp32_ble_tracker::ESPBTDevice &device) override;
 
   void dump_config() override;
@@ -30,6 +33,7 @@ class XiaomiMJYD02YLA : public Component,
  protected:
   uint64_t address_;
   uint8_t bindkey_[16];
+  xiaomi_ble::XiaomiDecryptor decryptor_;
   sensor::Sensor *idle_time_{nullptr};
   sensor::Sensor *battery_level_{nullptr};
   sensor::Sensor *illuminance_{nullptr};
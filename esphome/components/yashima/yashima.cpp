@@ -77,6 +77,9 @@ const uint16_t YASHIMA_ONE_SPACE = 517;
 const uint16_t YASHIMA_ZERO_SPACE = 1543;
 const uint32_t YASHIMA_GAP = YASHIMA_HEADER_SPACE;
 
+static const climate_ir::IRFrameTiming YASHIMA_TIMING = {YASHIMA_HEADER_MARK, YASHIMA_HEADER_SPACE, YASHIMA_BIT_MARK,
+                                                         YASHIMA_ONE_SPACE,   YASHIMA_ZERO_SPACE,   true};
+
 const uint32_t YASHIMA_CARRIER_FREQUENCY = 38000;
 
 climate::ClimateTraits YashimaClimate::traits() {
@@ -172,19 +175,9 @@ void YashimaClimate::transmit_state_() {
 
   data->set_carrier_frequency(YASHIMA_CARRIER_FREQUENCY);
 
-  // Header
-  data->mark(YASHIMA_HEADER_MARK);
-  data->space(YASHIMA_HEADER_SPACE);
-  // Data (sent from the MSB to the LSB)
-  for (uint8_t i : remote_state)
-    for (int8_t j = 7; j >= 0; j--) {
-      data->mark(YASHIMA_BIT_MARK);
-      bool bit = i & (1 << j);
-      data->space(bit ? YASHIMA_ONE_SPACE : YASHIMA_ZERO_SPACE);
-    }
-  // Footer
-  data->mark(YASHIMA_BIT_MARK);
-  data->space(YASHIMA_GAP);
+  data->reserve(climate_ir::ir_frame_length(YASHIMA_STATE_LENGTH));
+  // Data is sent from the MSB to the LSB
+  climate_ir::encode_ir_frame(data, YASHIMA_TIMING, remote_state, YASHIMA_STATE_LENGTH, YASHIMA_GAP);
 
   transmit.perform();
 }
@@ -0,0 +1,103 @@
+"""A persistent cache of the results of validating a configuration.
+
+Parsing all included files and running every schema takes most of the time of a batch build
+when nothing changed. The cache stores the hashes of all files a configuration was loaded
+from (packages, includes and secrets too), the included directory listings, the environment
+variables that were read, the command line substitutions and the ESPHome version. The
+custom_components and the files added with `esphome: includes:` aren't loaded as YAML, their
+modification times and sizes are stored as well. As long as none of them changed, the stored
+results are still valid and the configuration doesn't have to be loaded at all.
+"""
+import json
+import logging
+import os
+
+from esphome import const, yaml_util
+from esphome.const import CONF_ESPHOME, CONF_INCLUDES
+from esphome.core import CORE, EsphomeError
+from esphome.helpers import read_file, walk_files, write_file
+
+_LOGGER = logging.getLogger(__name__)
+
+
+def cache_path():  # type: () -> str
+    return CORE.relative_config_path('.esphome', 'validation', f'{CORE.config_filename}.json')
+
+
+def _source_paths():
+    """The directories and files outside of the YAML inputs the results depend on."""
+    paths = [CORE.relative_config_path('custom_components')]
+    if CORE.config is not None:
+        paths += [CORE.relative_config_path(include)
+                  for include in CORE.config.get(CONF_ESPHOME, {}).get(CONF_INCLUDES, [])]
+    return paths
+
+
+def _source_stamps(paths):
+    """Map each file below paths to its modification time and size."""
+    stamps = {}
+    for path in paths:
+        files = [path] if os.path.isfile(path) else walk_files(path)
+        for filename in files:
+            if '__pycache__' in filename:
+                continue
+            try:
+                stat = os.stat(filename)
+            except OSError:
+                continue
+            stamps[filename] = [stat.st_mtime_ns, stat.st_size]
+    return stamps
+
+
+def _read():
+    try:
+        return json.loads(read_file(cache_path()))
+    except (EsphomeError, ValueError):
+        return None
+
+
+def load(substitutions):
+    """Return the results stored for the configuration, None if any of its inputs changed."""
+    if CORE.vscode:
+        # The files come from the editor, which may not have saved them
+        return None
+    data = _read()
+    if data is None or data.get('version') != const.__version__ or \
+            data.get('substitutions') != substitutions:
+        return None
+    try:
+        if not yaml_util.inputs_unchanged(data['inputs']):
+            return None
+        if _source_stamps(data['source_paths']) != data['sources']:
+            return None
+    except (KeyError, AttributeError, TypeError):
+        return None
+    return data
+
+
+def store(substitutions, **results):
+    """Store results of the configuration that was loaded last.
+
+    Results of the same inputs are kept, so each command can add the ones it needs.
+    """
+    if CORE.vscode:
+        return
+    inputs = yaml_util.loaded_inputs()
+    source_paths = _source_paths()
+    sources = _source_stamps(source_paths)
+    data = _read()
+    if data is None or data.get('version') != const.__version__ or \
+            data.get('substitutions') != substitutions or data.get('inputs') != inputs or \
+            data.get('source_paths') != source_paths or data.get('sources') != sources:
+        data = {
+            'version': const.__version__,
+            'substitutions': substitutions,
+            'inputs': inputs,
+            'source_paths': source_paths,
+            'sources': sources,
+        }
+    data.update(results)
+    try:
+        write_file(cache_path(), json.dumps(data, indent=2))
+    except EsphomeError as err:
+        _LOGGER.debug("Could not store the validation results: %s", err)
@@ -165,8 +165,10 @@ CONF_DIV_RATIO = 'div_ratio'
 CONF_DNS1 = 'dns1'
 CONF_DNS2 = 'dns2'
 CONF_DOMAIN = 'domain'
+CONF_DOUBLE_BUFFERED = 'double_buffered'
 CONF_DRY_ACTION = 'dry_action'
 CONF_DRY_MODE = 'dry_mode'
+CONF_DUAL_CORE = 'dual_core'
 CONF_DUMP = 'dump'
 CONF_DURATION = 'duration'
 CONF_EAP = 'eap'
@@ -182,6 +184,7 @@ CONF_ESP8266_RESTORE_FROM_FLASH = 'esp8266_restore_from_flash'
 CONF_ESPHOME = 'esphome'
 CONF_ESPHOME_CORE_VERSION = 'esphome_core_version'
 CONF_EVENT = 'event'
+CONF_EVENT_DRIVEN_LOOP = 'event_driven_loop'
 CONF_EXPIRE_AFTER = 'expire_after'
 CONF_EXTERNAL_VCC = 'external_vcc'
 CONF_FALLING_EDGE = 'falling_edge'
@@ -208,6 +211,7 @@ CONF_FOR = 'for'
 CONF_FORCE_UPDATE = 'force_update'
 CONF_FORMALDEHYDE = 'formaldehyde'
 CONF_FORMAT = 'format'
+CONF_FRAME_RATE = 'frame_rate'
 CONF_FREQUENCY = 'frequency'
 CONF_FROM = 'from'
 CONF_FULL_UPDATE_EVERY = 'full_update_every'
@@ -254,11 +258,13 @@ CONF_INTENSITY = 'intensity'
 CONF_INTERLOCK = 'interlock'
 CONF_INTERNAL = 'internal'
 CONF_INTERNAL_FILTER = 'internal_filter'
+CONF_INTERRUPT_PIN = 'interrupt_pin'
 CONF_INTERVAL = 'interval'
 CONF_INVALID_COOLDOWN = 'invalid_cooldown'
 CONF_INVERT = 'invert'
 CONF_INVERTED = 'inverted'
 CONF_IP_ADDRESS = 'ip_address'
+CONF_IRQ_PIN = 'irq_pin'
 CONF_JS_INCLUDE = 'js_include'
 CONF_JS_URL = 'js_url'
 CONF_JVC = 'jvc'
@@ -290,6 +296,7 @@ CONF_MAX_CURRENT = 'max_current'
 CONF_MAX_DURATION = 'max_duration'
 CONF_MAX_LENGTH = 'max_length'
 CONF_MAX_LEVEL = 'max_level'
+CONF_MAX_LOOP_SLEEP = 'max_loop_sleep'
 CONF_MAX_POWER = 'max_power'
 CONF_MAX_REFRESH_RATE = 'max_refresh_rate'
 CONF_MAX_SPEED = 'max_speed'
@@ -301,9 +308,11 @@ CONF_MEASUREMENT_SEQUENCE_NUMBER = 'measurement_sequence_number'
 CONF_MEDIUM = 'medium'
 CONF_MEMORY_BLOCKS = 'memory_blocks'
 CONF_METHOD = 'method'
+CONF_MIN_INTERVAL = 'min_interval'
 CONF_MIN_LENGTH = 'min_length'
 CONF_MIN_LEVEL = 'min_level'
 CONF_MIN_POWER = 'min_power'
+CONF_MIN_PUBLISH_INTERVAL = 'min_publish_interval'
 CONF_MIN_TEMPERATURE = 'min_temperature'
 CONF_MIN_VALUE = 'min_value'
 CONF_MINUTE = 'minute'
@@ -368,6 +377,7 @@ CONF_OSCILLATION_OUTPUT = 'oscillation_output'
 CONF_OSCILLATION_STATE_TOPIC = 'oscillation_state_topic'
 CONF_OTA = 'ota'
 CONF_OUTPUT = 'output'
+CONF_OUTPUT_GROUP = 'output_group'
 CONF_OUTPUT_ID = 'output_id'
 CONF_OUTPUTS = 'outputs'
 CONF_OVERSAMPLING = 'oversampling'
@@ -399,6 +409,7 @@ CONF_PMC_1_0 = 'pmc_1_0'
 CONF_PMC_10_0 = 'pmc_10_0'
 CONF_PMC_2_5 = 'pmc_2_5'
 CONF_PMC_4_0 = 'pmc_4_0'
+CONF_POOL_SIZE = 'pool_size'
 CONF_PORT = 'port'
 CONF_POSITION = 'position'
 CONF_POSITION_ACTION = 'position_action'
@@ -409,10 +420,13 @@ CONF_POWER_SAVE_MODE = 'power_save_mode'
 CONF_POWER_SUPPLY = 'power_supply'
 CONF_PRESSURE = 'pressure'
 CONF_PRIORITY = 'priority'
+CONF_PROFILE = 'profile'
 CONF_PROTOCOL = 'protocol'
+CONF_PSRAM = 'psram'
 CONF_PULL_MODE = 'pull_mode'
 CONF_PULSE_LENGTH = 'pulse_length'
 CONF_QOS = 'qos'
+CONF_QUANTILE = 'quantile'
 CONF_RANDOM = 'random'
 CONF_RANGE = 'range'
 CONF_RANGE_FROM = 'range_from'
@@ -452,6 +466,7 @@ CONF_RX_PIN = 'rx_pin'
 CONF_SAFE_MODE = 'safe_mode'
 CONF_SAMSUNG = 'samsung'
 CONF_SCAN = 'scan'
+CONF_SCHEDULER = 'scheduler'
 CONF_SCL = 'scl'
 CONF_SCL_PIN = 'scl_pin'
 CONF_SDA = 'sda'
@@ -476,6 +491,7 @@ CONF_SHUNT_RESISTANCE = 'shunt_resistance'
 CONF_SHUNT_VOLTAGE = 'shunt_voltage'
 CONF_SHUTDOWN_MESSAGE = 'shutdown_message'
 CONF_SIZE = 'size'
+CONF_SLACK = 'slack'
 CONF_SLEEP_DURATION = 'sleep_duration'
 CONF_SLEEP_PIN = 'sleep_pin'
 CONF_SLEEP_WHEN_DONE = 'sleep_when_done'
@@ -485,6 +501,7 @@ CONF_SPEED_COMMAND_TOPIC = 'speed_command_topic'
 CONF_SPEED_STATE_TOPIC = 'speed_state_topic'
 CONF_SPI_ID = 'spi_id'
 CONF_SPIKE_REJECTION = 'spike_rejection'
+CONF_SPLIT_SETUP = 'split_setup'
 CONF_SSID = 'ssid'
 CONF_SSL_FINGERPRINTS = 'ssl_fingerprints'
 CONF_STATE = 'state'
@@ -575,6 +592,7 @@ CONF_WIND_SPEED = 'wind_speed'
 CONF_WINDOW_SIZE = 'window_size'
 CONF_ZERO = 'zero'
 
+ENV_BUILD_CACHE = 'ESPHOME_BUILD_CACHE'
 ENV_NOGITIGNORE = 'ESPHOME_NOGITIGNORE'
 ENV_QUICKWIZARD = 'ESPHOME_QUICKWIZARD'
 
@@ -646,6 +664,7 @@ UNIT_MICROMETER = 'µm'
 UNIT_MICROSIEMENS_PER_CENTIMETER = 'µS/cm'
 UNIT_MICROTESLA = 'µT'
 UNIT_MILLIGRAMS_PER_CUBIC_METER = 'mg/m³'
+UNIT_MILLISECOND = 'ms'
 UNIT_MINUTE = 'min'
 UNIT_OHM = 'Ω'
 UNIT_PARTS_PER_BILLION = 'ppb'
@@ -530,6 +530,8 @@ class EsphomeCore:
         self.component_ids = set()
         # Whether ESPHome was started in verbose mode
         self.verbose = False
+        # Arbitrary data integrations can share during code generation, keyed by integration
+        self.data: Dict[str, Any] = {}
 
     def reset(self):
         self.dashboard = False
@@ -551,6 +553,7 @@ class EsphomeCore:
         self.active_coroutines = {}
         self.loaded_integrations = set()
         self.component_ids = set()
+        self.data = {}
 
     @property
     def address(self) -> Optional[str]:
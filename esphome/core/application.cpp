@@ -2,15 +2,31 @@
 #include "esphome/core/log.h"
 #include "esphome/core/version.h"
 #include "esphome/core/esphal.h"
+#include "esphome/core/profiler.h"
+
+#include <algorithm>
+
+#ifdef USE_DUAL_CORE
+#include "esphome/core/controller.h"
+#endif
 
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 namespace esphome {
 
 static const char *TAG = "app";
 
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(ARDUINO_ARCH_ESP32)
+static TaskHandle_t loop_task_handle = nullptr;  // NOLINT
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -27,6 +43,11 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+  // all entities have their names by now
+  this->build_entity_index_();
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(ARDUINO_ARCH_ESP32)
+  loop_task_handle = xTaskGetCurrentTaskHandle();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -59,14 +80,47 @@ void Application::setup() {
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
+#ifdef USE_DUAL_CORE
+  this->start_network_task_();
+#endif
 
   // Dummy function to link some symbols into the binary.
   force_link_symbols();
 }
+bool Application::entity_index_less(const EntityIndexEntry &a, const EntityIndexEntry &b) {
+  return a.type != b.type ? a.type < b.type : a.key < b.key;
+}
+void Application::build_entity_index_() {
+  for (auto &entry : this->entity_index_)
+    entry.key = entry.obj->get_object_id_hash();
+  // entities with the same hash stay in registration order, so the first one registered is found
+  std::stable_sort(this->entity_index_.begin(), this->entity_index_.end(), entity_index_less);
+  this->entity_index_dirty_ = false;
+}
+Nameable *Application::find_entity(EntityType type, uint32_t key, bool include_internal) {
+  if (this->entity_index_dirty_)
+    this->build_entity_index_();
+  const EntityIndexEntry needle{key, type, nullptr};
+  auto it = std::lower_bound(this->entity_index_.begin(), this->entity_index_.end(), needle, entity_index_less);
+  // keys aren't necessarily unique, skip internal entities with the same hash
+  for (; it != this->entity_index_.end() && it->type == type && it->key == key; ++it) {
+    if (include_internal || !it->obj->is_internal())
+      return it->obj;
+  }
+  return nullptr;
+}
 void Application::loop() {
   uint32_t new_app_state = 0;
   const uint32_t start = millis();
+#ifdef USE_PROFILER
+  const uint32_t start_us = micros();
+  global_profiler.record_loop_start(start_us,
+                                    HighFrequencyLoopRequester::is_high_frequency() ? 0 : this->loop_interval_);
+#endif
 
+#ifdef USE_DUAL_CORE
+  this->run_queued_in_loop_();
+#endif
   this->scheduler.call();
   for (Component *component : this->looping_components_) {
     component->call();
@@ -74,11 +128,25 @@ void Application::loop() {
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+#ifdef USE_DUAL_CORE
+  new_app_state |= this->network_app_state_.load(std::memory_order_relaxed);
+#endif
   this->app_state_ = new_app_state;
 
+#ifdef USE_PROFILER
+  global_profiler.record_loop(micros() - start_us);
+#endif
+
   const uint32_t end = millis();
   if (end - start > 200) {
     ESP_LOGV(TAG, "A component took a long time in a loop() cycle (%.2f s).", (end - start) / 1e3f);
+#ifdef USE_PROFILER
+    ComponentProfile *slowest = global_profiler.get_slowest_component();
+    if (slowest != nullptr) {
+      ESP_LOGV(TAG, "Slowest component was '%s' (%.2f ms).", slowest->name != nullptr ? slowest->name : "unknown",
+               slowest->loop.last_us / 1e3f);
+    }
+#endif
     ESP_LOGV(TAG, "Components should block for at most 20-30ms in loop().");
   }
 
@@ -96,7 +164,17 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
+#ifdef USE_EVENT_DRIVEN_LOOP
+    if (this->is_loop_idle_()) {
+      // Nothing to do until the next scheduled item or a wake event
+      delay_time = this->scheduler.next_schedule_in().value_or(this->max_loop_sleep_);
+      delay_time = std::max(delay_time, this->loop_interval_ / 2);
+      delay_time = std::min(delay_time, this->max_loop_sleep_);
+    }
+    this->sleep_(delay_time);
+#else
     delay(delay_time);
+#endif
   }
   this->last_loop_ = now;
 
@@ -152,12 +230,160 @@ void Application::safe_reboot() {
 }
 
 void Application::calculate_looping_components_() {
+  size_t count = 0;
   for (auto *obj : this->components_) {
     if (obj->has_overridden_loop())
-      this->looping_components_.push_back(obj);
+      count++;
+  }
+  this->looping_components_.reserve(count);
+  for (auto *obj : this->components_) {
+    if (!obj->has_overridden_loop())
+      continue;
+#ifdef USE_DUAL_CORE
+    if (obj->get_affinity() == COMPONENT_AFFINITY_NETWORK) {
+      this->network_components_.push_back(obj);
+      continue;
+    }
+#endif
+    this->looping_components_.push_back(obj);
   }
 }
 
+#ifdef USE_DUAL_CORE
+void Application::start_network_task_() {
+  this->loop_task_ = xTaskGetCurrentTaskHandle();
+  if (this->network_components_.empty())
+    return;
+  // Wi-Fi and lwIP run on core 0 and the loop task on core 1 by default
+  const BaseType_t core = xPortGetCoreID() == 0 ? 1 : 0;
+  xTaskCreatePinnedToCore(network_task_main_, "network", NETWORK_TASK_STACK_SIZE, this, 1, &this->network_task_, core);
+  ESP_LOGI(TAG, "Running %u network components on core %d", this->network_components_.size(), core);
+}
+void Application::network_task_main_(void *arg) {
+  auto *app = reinterpret_cast<Application *>(arg);
+  while (true)
+    app->network_loop_();
+}
+void Application::network_loop_() {
+  const uint32_t start = millis();
+  this->run_queued_in_network_();
+  for (auto *controller : this->controllers_)
+    controller->process_controller_updates();
+
+  uint32_t new_app_state = 0;
+  for (Component *component : this->network_components_) {
+    component->call();
+    new_app_state |= component->get_component_state();
+  }
+  this->network_app_state_.store(new_app_state, std::memory_order_relaxed);
+
+  // Sleep for the rest of the loop interval, queued state updates and wake_loop() cut it short
+  const uint32_t elapsed = millis() - start;
+  const uint32_t delay_time = elapsed < this->loop_interval_ ? this->loop_interval_ - elapsed : 1;
+  ulTaskNotifyTake(pdTRUE, std::max<uint32_t>(delay_time / portTICK_PERIOD_MS, 1));
+}
+bool Application::is_network_task() const {
+  return this->network_task_ != nullptr && xTaskGetCurrentTaskHandle() == this->network_task_;
+}
+bool Application::is_loop_task() const {
+  return this->loop_task_ != nullptr && xTaskGetCurrentTaskHandle() == this->loop_task_;
+}
+void Application::wake_network_task() {
+  if (this->network_task_ != nullptr)
+    xTaskNotifyGive(this->network_task_);
+}
+void Application::run_in_loop(std::function<void()> &&f) {
+  if (!this->is_network_task()) {
+    f();
+    return;
+  }
+  // Wait for the loop task to make room, commands must not get lost
+  while (!this->loop_queue_.push(std::move(f)))
+    delay(1);
+  this->wake_loop();
+}
+void Application::run_queued_in_loop_() {
+  std::function<void()> *f;
+  while ((f = this->loop_queue_.front()) != nullptr) {
+    (*f)();
+    // release the captures before the slot is reused
+    *f = nullptr;
+    this->loop_queue_.pop();
+  }
+  const uint32_t dropped = this->network_queue_dropped_.exchange(0);
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %u calls because the network task fell behind", dropped);
+}
+void Application::run_in_network(std::function<void()> &&f) {
+  if (!this->is_network_task_running() || !this->is_loop_task()) {
+    f();
+    return;
+  }
+  // Never wait long, the network task may itself be waiting for room in the loop queue
+  const uint32_t start = millis();
+  while (!this->network_queue_.push(std::move(f))) {
+    if (millis() - start >= NETWORK_QUEUE_TIMEOUT) {
+      this->network_queue_dropped_++;
+      return;
+    }
+    this->wake_network_task();
+    delay(1);
+  }
+  this->wake_network_task();
+}
+void Application::run_queued_in_network_() {
+  std::function<void()> *f;
+  while ((f = this->network_queue_.front()) != nullptr) {
+    (*f)();
+    *f = nullptr;
+    this->network_queue_.pop();
+  }
+}
+#endif
+
+#ifdef USE_EVENT_DRIVEN_LOOP
+bool Application::is_loop_idle_() {
+  for (auto *obj : this->looping_components_) {
+    if (!obj->is_failed() && !obj->is_loop_idle())
+      return false;
+  }
+  return true;
+}
+void Application::sleep_(uint32_t delay_time) {
+#ifdef ARDUINO_ARCH_ESP32
+  // Clears the notification, so wake-ups that happened while the loop was running return immediately here.
+  ulTaskNotifyTake(pdTRUE, delay_time / portTICK_PERIOD_MS);
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  // delay() yields to the SDK until its timer fires, esp_schedule() resumes the loop earlier.
+  delay(delay_time);
+#endif
+}
+void Application::wake_loop() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (loop_task_handle != nullptr)
+    xTaskNotifyGive(loop_task_handle);
+#endif
+#ifdef USE_DUAL_CORE
+  // network callbacks don't know which task their component runs in
+  this->wake_network_task();
+#endif
+#ifdef ARDUINO_ARCH_ESP8266
+  esp_schedule();
+#endif
+}
+void ICACHE_RAM_ATTR Application::wake_loop_isr() {
+#ifdef ARDUINO_ARCH_ESP32
+  if (loop_task_handle == nullptr)
+    return;
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  vTaskNotifyGiveFromISR(loop_task_handle, &higher_priority_task_woken);
+  if (higher_priority_task_woken)
+    portYIELD_FROM_ISR();
+#endif
+}
+#endif
+
 Application App;
 
 }  // namespace esphome
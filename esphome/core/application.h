@@ -8,6 +8,13 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_DUAL_CORE
+#include "esphome/core/spsc_queue.h"
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -35,6 +42,18 @@
 
 namespace esphome {
 
+#ifdef USE_DUAL_CORE
+class Controller;
+
+/// The number of functions the network task can hand to the loop task before it has to wait.
+static const size_t LOOP_QUEUE_SIZE = 16;
+/// The number of functions the loop task can hand to the network task before it has to wait.
+static const size_t NETWORK_QUEUE_SIZE = 16;
+/// How long the loop task waits for room in a full network queue before the function is dropped, in ms.
+static const uint32_t NETWORK_QUEUE_TIMEOUT = 20;
+static const uint32_t NETWORK_TASK_STACK_SIZE = 8192;
+#endif
+
 class Application {
  public:
   void pre_setup(const std::string &name, const char *compilation_time) {
@@ -43,38 +62,90 @@ class Application {
     global_preferences.begin();
   }
 
+  /** Reserve room for the given number of components and entities, called by the generated code before anything is
+   * registered so that the registries are allocated once with their final size.
+   */
+  void reserve_components(size_t count) { this->components_.reserve(count); }
+  void reserve_entities(size_t count) { this->entity_index_.reserve(count); }
+#ifdef USE_BINARY_SENSOR
+  void reserve_binary_sensor(size_t count) { this->binary_sensors_.reserve(count); }
+#endif
+#ifdef USE_SENSOR
+  void reserve_sensor(size_t count) { this->sensors_.reserve(count); }
+#endif
+#ifdef USE_SWITCH
+  void reserve_switch(size_t count) { this->switches_.reserve(count); }
+#endif
+#ifdef USE_TEXT_SENSOR
+  void reserve_text_sensor(size_t count) { this->text_sensors_.reserve(count); }
+#endif
+#ifdef USE_FAN
+  void reserve_fan(size_t count) { this->fans_.reserve(count); }
+#endif
+#ifdef USE_COVER
+  void reserve_cover(size_t count) { this->covers_.reserve(count); }
+#endif
+#ifdef USE_CLIMATE
+  void reserve_climate(size_t count) { this->climates_.reserve(count); }
+#endif
+#ifdef USE_LIGHT
+  void reserve_light(size_t count) { this->lights_.reserve(count); }
+#endif
+
 #ifdef USE_BINARY_SENSOR
   void register_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
     this->binary_sensors_.push_back(binary_sensor);
+    this->index_entity_(ENTITY_BINARY_SENSOR, binary_sensor);
   }
 #endif
 
 #ifdef USE_SENSOR
-  void register_sensor(sensor::Sensor *sensor) { this->sensors_.push_back(sensor); }
+  void register_sensor(sensor::Sensor *sensor) {
+    this->sensors_.push_back(sensor);
+    this->index_entity_(ENTITY_SENSOR, sensor);
+  }
 #endif
 
 #ifdef USE_SWITCH
-  void register_switch(switch_::Switch *a_switch) { this->switches_.push_back(a_switch); }
+  void register_switch(switch_::Switch *a_switch) {
+    this->switches_.push_back(a_switch);
+    this->index_entity_(ENTITY_SWITCH, a_switch);
+  }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  void register_text_sensor(text_sensor::TextSensor *sensor) { this->text_sensors_.push_back(sensor); }
+  void register_text_sensor(text_sensor::TextSensor *sensor) {
+    this->text_sensors_.push_back(sensor);
+    this->index_entity_(ENTITY_TEXT_SENSOR, sensor);
+  }
 #endif
 
 #ifdef USE_FAN
-  void register_fan(fan::FanState *state) { this->fans_.push_back(state); }
+  void register_fan(fan::FanState *state) {
+    this->fans_.push_back(state);
+    this->index_entity_(ENTITY_FAN, state);
+  }
 #endif
 
 #ifdef USE_COVER
-  void register_cover(cover::Cover *cover) { this->covers_.push_back(cover); }
+  void register_cover(cover::Cover *cover) {
+    this->covers_.push_back(cover);
+    this->index_entity_(ENTITY_COVER, cover);
+  }
 #endif
 
 #ifdef USE_CLIMATE
-  void register_climate(climate::Climate *climate) { this->climates_.push_back(climate); }
+  void register_climate(climate::Climate *climate) {
+    this->climates_.push_back(climate);
+    this->index_entity_(ENTITY_CLIMATE, climate);
+  }
 #endif
 
 #ifdef USE_LIGHT
-  void register_light(light::LightState *light) { this->lights_.push_back(light); }
+  void register_light(light::LightState *light) {
+    this->lights_.push_back(light);
+    this->index_entity_(ENTITY_LIGHT, light);
+  }
 #endif
 
   /// Register the component in this Application instance.
@@ -110,6 +181,51 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /// Set the maximum time the event-driven loop sleeps when all components are idle.
+  void set_max_loop_sleep(uint32_t max_loop_sleep) { this->max_loop_sleep_ = max_loop_sleep; }
+
+#ifdef USE_EVENT_DRIVEN_LOOP
+  /** Wake up the main loop if it is currently sleeping, for example after data was received in a network callback.
+   *
+   * Must not be called from an interrupt handler, use wake_loop_isr() there.
+   */
+  void wake_loop();
+  /// Interrupt-safe version of wake_loop(). On the ESP8266 this is a no-op, the loop wakes at the next timeout.
+  static void wake_loop_isr();
+#else
+  void wake_loop() {}
+  static void wake_loop_isr() {}
+#endif
+
+#ifdef USE_DUAL_CORE
+  /** Run f in the loop task, where entities may be commanded and the scheduler may be used.
+   *
+   * Called from the network task, f is queued and run at the start of the next loop() iteration, anywhere else it's
+   * run right away. Network-facing components pass the commands they receive through here.
+   */
+  void run_in_loop(std::function<void()> &&f);
+  /** Run f in the network task, where network-facing components may be used.
+   *
+   * Called from the loop task while the network task runs, f is queued and run in the next iteration of the network
+   * task, anywhere else it's run right away. If the queue is full the loop task waits up to NETWORK_QUEUE_TIMEOUT ms
+   * for the network task to catch up, after that f is dropped and counted in a warning.
+   */
+  void run_in_network(std::function<void()> &&f);
+  /// Whether the calling code runs in the network task.
+  bool is_network_task() const;
+  /// Whether the calling code runs in the loop task, only known once the network task runs.
+  bool is_loop_task() const;
+  /// Whether the network task has been started, state updates for controllers are queued from then on.
+  bool is_network_task_running() const { return this->network_task_ != nullptr; }
+  /// Deliver the state updates of this controller in the network task once it runs.
+  void register_controller(Controller *controller) { this->controllers_.push_back(controller); }
+  /// Wake the network task up if it is sleeping, for example after queueing state updates for it.
+  void wake_network_task();
+#else
+  void run_in_loop(std::function<void()> &&f) { f(); }
+  void run_in_network(std::function<void()> &&f) { f(); }
+#endif
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -129,76 +245,71 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  /// The entity types in the key index.
+  enum EntityType : uint8_t {
+    ENTITY_BINARY_SENSOR,
+    ENTITY_SWITCH,
+    ENTITY_SENSOR,
+    ENTITY_TEXT_SENSOR,
+    ENTITY_FAN,
+    ENTITY_COVER,
+    ENTITY_CLIMATE,
+    ENTITY_LIGHT,
+  };
+
+  /** Find the entity of the given type by its object id hash in O(log n).
+   *
+   * The index is sorted by (type, key) and built on the first lookup after entities have been registered,
+   * so names must not change after setup.
+   */
+  Nameable *find_entity(EntityType type, uint32_t key, bool include_internal);
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<binary_sensor::BinarySensor *>(this->find_entity(ENTITY_BINARY_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<switch_::Switch *>(this->find_entity(ENTITY_SWITCH, key, include_internal));
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<sensor::Sensor *>(this->find_entity(ENTITY_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<text_sensor::TextSensor *>(this->find_entity(ENTITY_TEXT_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::FanState *> &get_fans() { return this->fans_; }
   fan::FanState *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<fan::FanState *>(this->find_entity(ENTITY_FAN, key, include_internal));
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<cover::Cover *>(this->find_entity(ENTITY_COVER, key, include_internal));
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<light::LightState *>(this->find_entity(ENTITY_LIGHT, key, include_internal));
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<climate::Climate *>(this->find_entity(ENTITY_CLIMATE, key, include_internal));
   }
 #endif
 
@@ -211,8 +322,53 @@ class Application {
 
   void calculate_looping_components_();
 
+#ifdef USE_DUAL_CORE
+  /// Start the network task on the core the loop task doesn't run on.
+  void start_network_task_();
+  static void network_task_main_(void *arg);
+  /// One iteration of the network task, the counterpart of loop().
+  void network_loop_();
+  /// Run the functions queued by run_in_loop().
+  void run_queued_in_loop_();
+  /// Run the functions queued by run_in_network().
+  void run_queued_in_network_();
+#endif
+
+  struct EntityIndexEntry {
+    uint32_t key;
+    EntityType type;
+    Nameable *obj;
+  };
+  void index_entity_(EntityType type, Nameable *obj) {
+    this->entity_index_.push_back(EntityIndexEntry{0, type, obj});
+    this->entity_index_dirty_ = true;
+  }
+  static bool entity_index_less(const EntityIndexEntry &a, const EntityIndexEntry &b);
+  void build_entity_index_();
+
+#ifdef USE_EVENT_DRIVEN_LOOP
+  /// Whether all looping components have nothing to do.
+  bool is_loop_idle_();
+  /// Sleep for at most the given number of milliseconds, returns early if the loop is woken up.
+  void sleep_(uint32_t delay_time);
+#endif
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
+#ifdef USE_DUAL_CORE
+  /// The looping components with COMPONENT_AFFINITY_NETWORK, called by the network task.
+  std::vector<Component *> network_components_{};
+  std::vector<Controller *> controllers_{};
+  SPSCQueue<std::function<void()>, LOOP_QUEUE_SIZE> loop_queue_{};
+  SPSCQueue<std::function<void()>, NETWORK_QUEUE_SIZE> network_queue_{};
+  std::atomic<uint32_t> network_queue_dropped_{0};
+  TaskHandle_t loop_task_{nullptr};
+  TaskHandle_t network_task_{nullptr};
+  /// The component states of the network components, merged into app_state_ by loop().
+  std::atomic<uint32_t> network_app_state_{0};
+#endif
+  std::vector<EntityIndexEntry> entity_index_{};
+  bool entity_index_dirty_{false};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -243,6 +399,7 @@ class Application {
   std::string compilation_time_;
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+  uint32_t max_loop_sleep_{1000};
   int dump_config_at_{-1};
   uint32_t app_state_{0};
 };
@@ -188,6 +188,15 @@ template<typename... Ts> class ActionList {
   Action<Ts...> *actions_end_{nullptr};
 };
 
+/// Run-time statistics of an automation.
+struct AutomationStats {
+  /// The number of times the automation was triggered.
+  uint32_t runs{0};
+  /// The time spent in the actions until they finished or started waiting (for example in a delay), in µs.
+  uint32_t total_time{0};
+  uint32_t max_time{0};
+};
+
 template<typename... Ts> class Automation {
  public:
   explicit Automation(Trigger<Ts...> *trigger) : trigger_(trigger) { this->trigger_->set_automation_parent(this); }
@@ -197,16 +206,28 @@ template<typename... Ts> class Automation {
 
   void stop() { this->actions_.stop(); }
 
-  void trigger(Ts... x) { this->actions_.play(x...); }
+  void trigger(Ts... x) {
+    const uint32_t start = micros();
+    this->actions_.play(x...);
+    const uint32_t time = micros() - start;
+    this->stats_.runs++;
+    this->stats_.total_time += time;
+    if (time > this->stats_.max_time)
+      this->stats_.max_time = time;
+  }
 
   bool is_running() { return this->actions_.is_running(); }
 
   /// Return the number of actions in the action part of this automation that are currently running.
   int num_running() { return this->actions_.num_running(); }
 
+  const AutomationStats &get_stats() const { return this->stats_; }
+  void reset_stats() { this->stats_ = {}; }
+
  protected:
   Trigger<Ts...> *trigger_;
   ActionList<Ts...> actions_;
+  AutomationStats stats_;
 };
 
 }  // namespace esphome
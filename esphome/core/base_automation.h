@@ -48,11 +48,12 @@ template<typename... Ts> class NotCondition : public Condition<Ts...> {
 
 template<typename... Ts> class LambdaCondition : public Condition<Ts...> {
  public:
-  explicit LambdaCondition(std::function<bool(Ts...)> &&f) : f_(std::move(f)) {}
+  template<typename F>
+  explicit LambdaCondition(F &&f) : f_(make_persistent_delegate<bool(Ts...)>(std::forward<F>(f))) {}
   bool check(Ts... x) override { return this->f_(x...); }
 
  protected:
-  std::function<bool(Ts...)> f_;
+  Delegate<bool(Ts...)> f_;
 };
 
 template<typename... Ts> class ForCondition : public Condition<Ts...>, public Component {
@@ -102,6 +103,12 @@ class LoopTrigger : public Trigger<>, public Component {
   float get_setup_priority() const override { return setup_priority::DATA; }
 };
 
+/** Plays the following actions after a delay.
+ *
+ * Every run that is waiting keeps its arguments in a run context of this action. The contexts are reused once their
+ * delay passed, so an automation only allocates when more of its runs wait at the same time than ever before, and
+ * the scheduled callback only captures the context instead of a copy of the arguments.
+ */
 template<typename... Ts> class DelayAction : public Action<Ts...>, public Component {
  public:
   explicit DelayAction() = default;
@@ -109,26 +116,58 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
+    DelayRun *run = this->acquire_run_();
+    run->args = std::make_tuple(x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    run->handle = this->set_timeout(this->delay_.value(x...), [this, run]() { this->finish_run_(run); });
   }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override {
+    for (auto *run : this->runs_) {
+      if (run->handle != 0) {
+        this->cancel_handle(run->handle);
+        run->handle = 0;
+      }
+    }
+  }
+
+ protected:
+  struct DelayRun {
+    std::tuple<Ts...> args;
+    /// The handle of the scheduled timeout, 0 while the context is free.
+    uint32_t handle{0};
+  };
+
+  DelayRun *acquire_run_() {
+    for (auto *run : this->runs_) {
+      if (run->handle == 0)
+        return run;
+    }
+    auto *run = new DelayRun();  // NOLINT(cppcoreguidelines-owning-memory)
+    this->runs_.push_back(run);
+    return run;
+  }
+  void finish_run_(DelayRun *run) {
+    run->handle = 0;
+    // the arguments are copied into the call, so the context can be reused by the following actions
+    this->play_next_tuple_(run->args);
+  }
+
+  std::vector<DelayRun *> runs_;
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
  public:
-  explicit LambdaAction(std::function<void(Ts...)> &&f) : f_(std::move(f)) {}
+  template<typename F> explicit LambdaAction(F &&f) : f_(make_persistent_delegate<void(Ts...)>(std::forward<F>(f))) {}
 
   void play(Ts... x) override { this->f_(x...); }
 
  protected:
-  std::function<void(Ts...)> f_;
+  Delegate<void(Ts...)> f_;
 };
 
 template<typename... Ts> class IfAction : public Action<Ts...> {
@@ -252,6 +291,8 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
     this->play_next_tuple_(this->var_);
   }
 
+  bool is_loop_idle() override { return this->num_running_ == 0; }
+
   float get_setup_priority() const override { return setup_priority::DATA; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
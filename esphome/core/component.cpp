@@ -3,6 +3,7 @@
 #include "esphome/core/esphal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
+#include "esphome/core/profiler.h"
 
 namespace esphome {
 
@@ -51,7 +52,7 @@ bool Component::cancel_interval(const std::string &name) {  // NOLINT
 }
 
 void Component::set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  return App.scheduler.set_timeout(this, name, timeout, std::move(f));
+  App.scheduler.set_timeout(this, name, timeout, std::move(f));
 }
 
 bool Component::cancel_timeout(const std::string &name) {  // NOLINT
@@ -64,6 +65,12 @@ void Component::call_setup() { this->setup(); }
 uint32_t Component::get_component_state() const { return this->component_state_; }
 void Component::call() {
   uint32_t state = this->component_state_ & COMPONENT_STATE_MASK;
+#ifdef USE_PROFILER
+  if (state == COMPONENT_STATE_FAILED)
+    return;
+  ComponentProfile *previous = global_profiler.enter(this);
+  const uint32_t start = micros();
+#endif
   switch (state) {
     case COMPONENT_STATE_CONSTRUCTION:
       // State Construction: Call setup and set state to setup
@@ -87,6 +94,10 @@ void Component::call() {
     default:
       break;
   }
+#ifdef USE_PROFILER
+  global_profiler.record_component(this, state == COMPONENT_STATE_CONSTRUCTION, micros() - start);
+  global_profiler.leave(previous);
+#endif
 }
 void Component::mark_failed() {
   ESP_LOGE(TAG, "Component was marked as failed.");
@@ -95,6 +106,13 @@ void Component::mark_failed() {
   this->status_set_error();
 }
 void Component::defer(std::function<void()> &&f) {  // NOLINT
+#ifdef USE_DUAL_CORE
+  // the scheduler belongs to the loop task
+  if (App.is_network_task()) {
+    App.run_in_loop(std::move(f));
+    return;
+  }
+#endif
   App.scheduler.set_timeout(this, "", 0, std::move(f));
 }
 bool Component::cancel_defer(const std::string &name) {  // NOLINT
@@ -103,14 +121,33 @@ bool Component::cancel_defer(const std::string &name) {  // NOLINT
 void Component::defer(const std::string &name, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, name, 0, std::move(f));
 }
-void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
-  App.scheduler.set_timeout(this, "", timeout, std::move(f));
+void Component::run_steps(const std::string &name, uint32_t budget, std::function<bool()> &&step) {  // NOLINT
+  // an interval of 0 runs once per loop iteration, until the last step cancels it
+  App.scheduler.set_interval(this, name, 0, [this, name, budget, step]() {
+    const uint32_t start = millis();
+    do {
+      if (step()) {
+        this->cancel_interval(name);
+        return;
+      }
+      App.feed_wdt();
+    } while (millis() - start < budget);
+  });
+}
+bool Component::cancel_steps(const std::string &name) {  // NOLINT
+  return App.scheduler.cancel_interval(this, name);
+}
+uint32_t Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
+  return App.scheduler.set_timeout(this, "", timeout, std::move(f));
 }
+bool Component::cancel_handle(uint32_t handle) { return App.scheduler.cancel(handle); }  // NOLINT
 void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_interval(this, "", interval, std::move(f));
 }
 bool Component::is_failed() { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::can_proceed() { return true; }
+bool Component::is_loop_idle() { return false; }
+ComponentAffinity Component::get_affinity() const { return COMPONENT_AFFINITY_LOOP; }
 bool Component::status_has_warning() { return this->component_state_ & STATUS_LED_WARNING; }
 bool Component::status_has_error() { return this->component_state_ & STATUS_LED_ERROR; }
 void Component::status_set_warning() {
@@ -166,20 +203,53 @@ void PollingComponent::call_setup() {
 uint32_t PollingComponent::get_update_interval() const { return this->update_interval_; }
 void PollingComponent::set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
 
-const std::string &Nameable::get_name() const { return this->name_; }
+static StringRef copy_to_heap(const std::string &str) {
+  char *buf = new char[str.size() + 1];  // NOLINT
+  memcpy(buf, str.c_str(), str.size() + 1);
+  return StringRef(buf, str.size());
+}
+
+StringRef Nameable::get_name() const { return this->name_; }
 void Nameable::set_name(const std::string &name) {
-  this->name_ = name;
+  this->free_names_();
+  if (!name.empty()) {
+    this->name_ = copy_to_heap(name);
+    this->owns_names_ = true;
+  }
   this->calc_object_id_();
 }
-Nameable::Nameable(const std::string &name) : name_(name) { this->calc_object_id_(); }
+void Nameable::set_static_name(const char *name, const char *object_id, uint32_t object_id_hash) {
+  this->free_names_();
+  this->name_ = StringRef(name);
+  this->object_id_ = StringRef(object_id);
+  this->object_id_hash_ = object_id_hash;
+}
+Nameable::Nameable(const std::string &name) { this->set_name(name); }
 
-const std::string &Nameable::get_object_id() { return this->object_id_; }
+StringRef Nameable::get_object_id() { return this->object_id_; }
 bool Nameable::is_internal() const { return this->internal_; }
 void Nameable::set_internal(bool internal) { this->internal_ = internal; }
 void Nameable::calc_object_id_() {
-  this->object_id_ = sanitize_string_allowlist(to_lowercase_underscore(this->name_), HOSTNAME_CHARACTER_ALLOWLIST);
+  std::string object_id =
+      sanitize_string_allowlist(to_lowercase_underscore(this->name_.str()), HOSTNAME_CHARACTER_ALLOWLIST);
   // FNV-1 hash
-  this->object_id_hash_ = fnv1_hash(this->object_id_);
+  this->object_id_hash_ = fnv1_hash(object_id);
+  if (!object_id.empty()) {
+    this->object_id_ = copy_to_heap(object_id);
+    this->owns_names_ = true;
+  }
+}
+void Nameable::free_names_() {
+  if (this->owns_names_) {
+    // empty names are never allocated
+    if (!this->name_.empty())
+      delete[] this->name_.c_str();  // NOLINT
+    if (!this->object_id_.empty())
+      delete[] this->object_id_.c_str();  // NOLINT
+  }
+  this->name_ = StringRef();
+  this->object_id_ = StringRef();
+  this->owns_names_ = false;
 }
 uint32_t Nameable::get_object_id_hash() { return this->object_id_hash_; }
 
@@ -5,13 +5,28 @@
 #include "Arduino.h"
 
 #include "esphome/core/optional.h"
+#include "esphome/core/string_ref.h"
+#include "esphome/core/defines.h"
 
 namespace esphome {
 
+#ifdef USE_PROFILER
+struct ComponentProfile;
+class Profiler;
+#endif
+
 /** Default setup priorities for components of different types.
  *
  * Components should return one of these setup priorities in get_setup_priority.
  */
+/// The task a component's loop() runs in, see Component::get_affinity().
+enum ComponentAffinity : uint8_t {
+  /// The main application loop, where entities change their state.
+  COMPONENT_AFFINITY_LOOP,
+  /// The network task on the other core, only used with the dual_core option.
+  COMPONENT_AFFINITY_NETWORK,
+};
+
 namespace setup_priority {
 
 /// For communication buses like i2c/spi
@@ -128,6 +143,24 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Whether loop() currently has no work to do, only used by the event-driven application loop.
+   *
+   * When every looping component is idle, the application sleeps until the next scheduled item, a wake
+   * event (see Application::wake_loop()) or the maximum loop sleep time. Components returning true here
+   * must wake the loop when new work arrives, they are still called at least every max_loop_sleep ms.
+   *
+   * Defaults to false, so components that don't opt in keep the loop polling at the loop interval.
+   */
+  virtual bool is_loop_idle();
+
+  /** The task this component's loop() runs in when the application runs on both cores of the ESP32.
+   *
+   * Defaults to COMPONENT_AFFINITY_LOOP. Network-facing components return COMPONENT_AFFINITY_NETWORK, only their
+   * loop() moves to the network task, setup() and the scheduler still run in the loop task. See
+   * Application::run_in_loop() for how they hand work back.
+   */
+  virtual ComponentAffinity get_affinity() const;
+
  protected:
   virtual void call_loop();
   virtual void call_setup();
@@ -157,7 +190,14 @@ class Component {
    */
   bool cancel_interval(const std::string &name);  // NOLINT
 
-  void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
+  /** Set a timeout function without a name.
+   *
+   * @return A handle to cancel the timeout with cancel_handle().
+   */
+  uint32_t set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
+  /// Cancel a timeout or interval by the handle returned when it was set.
+  bool cancel_handle(uint32_t handle);  // NOLINT
 
   /** Set a timeout function with a unique name.
    *
@@ -197,8 +237,32 @@ class Component {
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
 
+  /** Run a long operation in steps, interleaved with the loop() of the other components.
+   *
+   * step is called from the scheduler until it returns true. Every loop iteration runs steps for up to budget ms
+   * and feeds the watchdog between them, then the other components get their turn. The operation keeps its progress
+   * between steps itself, for example in members of the component, so each step should only take a few ms.
+   *
+   * The steps run as an interval with the specified name, which must not be empty. Starting an operation with the
+   * name of a running one replaces it.
+   *
+   * @param name The identifier for this operation.
+   * @param budget The time in ms the steps may take per loop iteration.
+   * @param step The function that does the next part of the operation and returns whether it is done.
+   *
+   * @see cancel_steps()
+   */
+  void run_steps(const std::string &name, uint32_t budget, std::function<bool()> &&step);  // NOLINT
+
+  /// Cancel an operation started with run_steps(), returns whether it was still running.
+  bool cancel_steps(const std::string &name);  // NOLINT
+
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
+#ifdef USE_PROFILER
+  friend Profiler;
+  ComponentProfile *profile_{nullptr};
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -240,15 +304,30 @@ class PollingComponent : public Component {
   uint32_t update_interval_;
 };
 
-/// Helper class that enables naming of objects so that it doesn't have to be re-implement every time.
+/** Helper class that enables naming of objects so that it doesn't have to be re-implement every time.
+ *
+ * The name and object id are not stored as std::strings: codegen sets them with set_static_name() to string literals
+ * and a precomputed hash, only names set at runtime through set_name() are copied to the heap.
+ */
 class Nameable {
  public:
-  Nameable() : Nameable("") {}
+  Nameable() {}
   explicit Nameable(const std::string &name);
-  const std::string &get_name() const;
+  virtual ~Nameable() { this->free_names_(); }
+  // a copy would free the names of the original a second time
+  Nameable(const Nameable &) = delete;
+  Nameable &operator=(const Nameable &) = delete;
+  StringRef get_name() const;
   void set_name(const std::string &name);
-  /// Get the sanitized name of this nameable as an ID. Caching it internally.
-  const std::string &get_object_id();
+  /** Set the name without copying it, for the string literals generated by codegen.
+   *
+   * @param name The name, must stay valid for the lifetime of this object.
+   * @param object_id The sanitized name as calculated by calc_object_id_(), must stay valid as well.
+   * @param object_id_hash The FNV-1 hash of object_id.
+   */
+  void set_static_name(const char *name, const char *object_id, uint32_t object_id_hash);
+  /// Get the sanitized name of this nameable as an ID.
+  StringRef get_object_id();
   uint32_t get_object_id_hash();
 
   bool is_internal() const;
@@ -258,11 +337,14 @@ class Nameable {
   virtual uint32_t hash_base() = 0;
 
   void calc_object_id_();
+  void free_names_();
 
-  std::string name_;
-  std::string object_id_;
-  uint32_t object_id_hash_;
+  StringRef name_;
+  StringRef object_id_;
+  uint32_t object_id_hash_{2166136261UL};
   bool internal_{false};
+  /// Whether name_ and object_id_ have been allocated by set_name().
+  bool owns_names_{false};
 };
 
 }  // namespace esphome
@@ -4,55 +4,177 @@
 
 namespace esphome {
 
+#ifdef USE_DUAL_CORE
+static const char *TAG = "controller";
+
+/// The update only names the entity, the hook reads its state.
+static bool reads_entity_state(Application::EntityType type) {
+  return type == Application::ENTITY_FAN || type == Application::ENTITY_LIGHT || type == Application::ENTITY_COVER ||
+         type == Application::ENTITY_CLIMATE;
+}
+#endif
+
 void Controller::setup_controller() {
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_DUAL_CORE
+  App.register_controller(this);
+#endif
+#ifdef USE_CONTROLLER_BINARY_SENSOR
   for (auto *obj : App.get_binary_sensors()) {
     if (!obj->is_internal())
-      obj->add_on_state_callback([this, obj](bool state) { this->on_binary_sensor_update(obj, state); });
+      obj->add_on_state_callback(
+          [this, obj](bool state) { this->on_state_(Application::ENTITY_BINARY_SENSOR, obj, state); });
   }
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
   for (auto *obj : App.get_fans()) {
     if (!obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_fan_update(obj); });
+      obj->add_on_state_callback([this, obj]() { this->on_state_(Application::ENTITY_FAN, obj, 0); });
   }
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
   for (auto *obj : App.get_lights()) {
     if (!obj->is_internal())
-      obj->add_new_remote_values_callback([this, obj]() { this->on_light_update(obj); });
+      obj->add_new_remote_values_callback([this, obj]() { this->on_state_(Application::ENTITY_LIGHT, obj, 0); });
   }
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
   for (auto *obj : App.get_sensors()) {
     if (!obj->is_internal())
-      obj->add_on_state_callback([this, obj](float state) { this->on_sensor_update(obj, state); });
+      // only the states that pass the sensor's report policy
+      obj->add_on_report_callback(
+          [this, obj](float state) { this->on_state_(Application::ENTITY_SENSOR, obj, state); });
   }
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
   for (auto *obj : App.get_switches()) {
     if (!obj->is_internal())
-      obj->add_on_state_callback([this, obj](bool state) { this->on_switch_update(obj, state); });
+      obj->add_on_state_callback([this, obj](bool state) { this->on_state_(Application::ENTITY_SWITCH, obj, state); });
   }
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
   for (auto *obj : App.get_covers()) {
     if (!obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_cover_update(obj); });
+      obj->add_on_state_callback([this, obj]() { this->on_state_(Application::ENTITY_COVER, obj, 0); });
   }
 #endif
-#ifdef USE_TEXT_SENSOR
+#ifdef USE_CONTROLLER_TEXT_SENSOR
   for (auto *obj : App.get_text_sensors()) {
     if (!obj->is_internal())
-      obj->add_on_state_callback([this, obj](std::string state) { this->on_text_sensor_update(obj, state); });
+      obj->add_on_state_callback([this, obj](const std::string &state) {
+        this->on_state_(Application::ENTITY_TEXT_SENSOR, obj, 0, &state);
+      });
   }
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
   for (auto *obj : App.get_climates()) {
     if (!obj->is_internal())
-      obj->add_on_state_callback([this, obj]() { this->on_climate_update(obj); });
+      obj->add_on_state_callback([this, obj]() { this->on_state_(Application::ENTITY_CLIMATE, obj, 0); });
+  }
+#endif
+}
+
+void Controller::on_state_(Application::EntityType type, Nameable *obj, float value, const std::string *text) {
+#ifdef USE_DUAL_CORE
+  if (App.is_network_task_running() && App.is_loop_task()) {
+    std::function<void()> snapshot;
+    if (reads_entity_state(type)) {
+      snapshot = this->snapshot_state_(type, obj);
+      if (!snapshot)
+        return;
+    }
+    StateUpdate *update = this->updates_.slot_to_push();
+    if (update == nullptr) {
+      this->dropped_updates_++;
+      return;
+    }
+    update->type = type;
+    update->obj = obj;
+    update->value = value;
+    if (text != nullptr)
+      update->text = *text;
+    update->snapshot = std::move(snapshot);
+#ifdef USE_STATE_TRACE
+    update->trace = global_state_tracer.get_current();
+#endif
+    this->updates_.push();
+    App.wake_network_task();
+    return;
+  }
+#endif
+  this->deliver_state_(type, obj, value, text);
+}
+
+void Controller::deliver_state_(Application::EntityType type, Nameable *obj, float value, const std::string *text) {
+  switch (type) {
+#ifdef USE_CONTROLLER_BINARY_SENSOR
+    case Application::ENTITY_BINARY_SENSOR:
+      this->on_binary_sensor_update(static_cast<binary_sensor::BinarySensor *>(obj), value != 0);
+      break;
+#endif
+#ifdef USE_CONTROLLER_FAN
+    case Application::ENTITY_FAN:
+      this->on_fan_update(static_cast<fan::FanState *>(obj));
+      break;
+#endif
+#ifdef USE_CONTROLLER_LIGHT
+    case Application::ENTITY_LIGHT:
+      this->on_light_update(static_cast<light::LightState *>(obj));
+      break;
+#endif
+#ifdef USE_CONTROLLER_SENSOR
+    case Application::ENTITY_SENSOR:
+      this->on_sensor_update(static_cast<sensor::Sensor *>(obj), value);
+      break;
+#endif
+#ifdef USE_CONTROLLER_SWITCH
+    case Application::ENTITY_SWITCH:
+      this->on_switch_update(static_cast<switch_::Switch *>(obj), value != 0);
+      break;
+#endif
+#ifdef USE_CONTROLLER_COVER
+    case Application::ENTITY_COVER:
+      this->on_cover_update(static_cast<cover::Cover *>(obj));
+      break;
+#endif
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+    case Application::ENTITY_TEXT_SENSOR:
+      this->on_text_sensor_update(static_cast<text_sensor::TextSensor *>(obj), *text);
+      break;
+#endif
+#ifdef USE_CONTROLLER_CLIMATE
+    case Application::ENTITY_CLIMATE:
+      this->on_climate_update(static_cast<climate::Climate *>(obj));
+      break;
+#endif
+    default:
+      break;
   }
+}
+
+#ifdef USE_DUAL_CORE
+void Controller::process_controller_updates() {
+  const uint32_t dropped = this->dropped_updates_.exchange(0);
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %u state updates because the network task fell behind", dropped);
+
+  StateUpdate *update;
+  while ((update = this->updates_.front()) != nullptr) {
+#ifdef USE_STATE_TRACE
+    const StateTrace previous = global_state_tracer.set_current(update->trace);
 #endif
+    if (update->snapshot) {
+      update->snapshot();
+      // release the captured state, the slot is reused
+      update->snapshot = nullptr;
+    } else {
+      this->deliver_state_(update->type, update->obj, update->value, &update->text);
+    }
+#ifdef USE_STATE_TRACE
+    global_state_tracer.set_current(previous);
+#endif
+    this->updates_.pop();
+  }
 }
+#endif
 
 }  // namespace esphome
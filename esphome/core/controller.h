@@ -1,6 +1,9 @@
 #pragma once
 
 #include "esphome/core/defines.h"
+#include "esphome/core/application.h"
+#include "esphome/core/state_trace.h"
+#include <functional>
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -28,33 +31,83 @@
 
 namespace esphome {
 
+#ifdef USE_DUAL_CORE
+/// The number of state updates a controller buffers between the loop task and the network task.
+static const size_t CONTROLLER_QUEUE_SIZE = 64;
+#endif
+
+/** Receives the state updates of all entities that aren't internal.
+ *
+ * The hook of an entity type only exists if codegen found an entity of the type that isn't internal
+ * (USE_CONTROLLER_<TYPE>), nodes that only use a type internally don't carry the code to publish it.
+ *
+ * With the dual_core option the updates happen in the loop task while network-facing controllers run in the network
+ * task. From the start of the network task the updates are queued and delivered by process_controller_updates(),
+ * before that (during setup) they are delivered right away. Entities without a state value in the update are
+ * captured by snapshot_state_() when queued.
+ */
 class Controller {
  public:
   void setup_controller();
-#ifdef USE_BINARY_SENSOR
+#ifdef USE_DUAL_CORE
+  /// Deliver the state updates queued by the loop task, called by the network task.
+  void process_controller_updates();
+#endif
+#ifdef USE_CONTROLLER_BINARY_SENSOR
   virtual void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state){};
 #endif
-#ifdef USE_FAN
+#ifdef USE_CONTROLLER_FAN
   virtual void on_fan_update(fan::FanState *obj){};
 #endif
-#ifdef USE_LIGHT
+#ifdef USE_CONTROLLER_LIGHT
   virtual void on_light_update(light::LightState *obj){};
 #endif
-#ifdef USE_SENSOR
+#ifdef USE_CONTROLLER_SENSOR
   virtual void on_sensor_update(sensor::Sensor *obj, float state){};
 #endif
-#ifdef USE_SWITCH
+#ifdef USE_CONTROLLER_SWITCH
   virtual void on_switch_update(switch_::Switch *obj, bool state){};
 #endif
-#ifdef USE_COVER
+#ifdef USE_CONTROLLER_COVER
   virtual void on_cover_update(cover::Cover *obj){};
 #endif
-#ifdef USE_TEXT_SENSOR
-  virtual void on_text_sensor_update(text_sensor::TextSensor *obj, std::string state){};
+#ifdef USE_CONTROLLER_TEXT_SENSOR
+  virtual void on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state){};
 #endif
-#ifdef USE_CLIMATE
+#ifdef USE_CONTROLLER_CLIMATE
   virtual void on_climate_update(climate::Climate *obj){};
 #endif
+
+ protected:
+  /// Deliver the state update to the matching on_*_update() or queue it for the network task.
+  void on_state_(Application::EntityType type, Nameable *obj, float value, const std::string *text = nullptr);
+  void deliver_state_(Application::EntityType type, Nameable *obj, float value, const std::string *text);
+
+#ifdef USE_DUAL_CORE
+  /** Capture the state of a fan, light, cover or climate in the loop task.
+   *
+   * Their updates carry no state value and the on_*_update() hooks read the entity, which the loop task keeps
+   * changing while the network task delivers the queue. The returned function runs in the network task instead of
+   * the hook, an empty function skips the update.
+   */
+  virtual std::function<void()> snapshot_state_(Application::EntityType type, Nameable *obj) = 0;
+
+  struct StateUpdate {
+    Application::EntityType type;
+    Nameable *obj;
+    /// The state of sensors, binary sensors and switches, the others are read from the entity.
+    float value;
+    /// The state of text sensors, keeps its capacity in the queue.
+    std::string text;
+    /// The captured state of fans, lights, covers and climates, see snapshot_state_().
+    std::function<void()> snapshot;
+#ifdef USE_STATE_TRACE
+    StateTrace trace;
+#endif
+  };
+  SPSCQueue<StateUpdate, CONTROLLER_QUEUE_SIZE> updates_{};
+  std::atomic<uint32_t> dropped_updates_{0};
+#endif
 };
 
 }  // namespace esphome
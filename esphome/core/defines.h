@@ -1,8 +1,17 @@
 #pragma once
 // This file is auto-generated! Do not edit!
 
+#ifdef USE_HOST
+// The host build (see tests/benchmarks) only compiles the core and pure-logic components
+#define USE_BINARY_SENSOR
+#define USE_CONTROLLER_BINARY_SENSOR
+#define USE_SENSOR
+#define USE_CONTROLLER_SENSOR
+#define USE_LOGGER_TAG_LEVELS
+#else
 #define USE_API
 #define USE_LOGGER
+#define USE_LOGGER_TAG_LEVELS
 #define USE_BINARY_SENSOR
 #define USE_SENSOR
 #define USE_SWITCH
@@ -23,3 +32,23 @@
 #define USE_TIME
 #define USE_DEEP_SLEEP
 #define USE_CAPTIVE_PORTAL
+#define USE_HTTP_REQUEST
+#define USE_HISTORY
+#define USE_HISTORY_WEB
+#ifdef ARDUINO_ARCH_ESP32
+#define USE_BLUETOOTH_PROXY
+#endif
+#define USE_SN74HC595_SPI
+#ifdef ARDUINO_ARCH_ESP32
+#define USE_ESP32_DAC
+#endif
+#define USE_CALIBRATION
+#define USE_CONTROLLER_BINARY_SENSOR
+#define USE_CONTROLLER_SENSOR
+#define USE_CONTROLLER_SWITCH
+#define USE_CONTROLLER_TEXT_SENSOR
+#define USE_CONTROLLER_FAN
+#define USE_CONTROLLER_COVER
+#define USE_CONTROLLER_LIGHT
+#define USE_CONTROLLER_CLIMATE
+#endif
@@ -34,6 +34,10 @@ GPIOPin::GPIOPin(uint8_t pin, uint8_t mode, bool inverted)
       gpio_read_(pin < 32 ? &GPIO.in : &GPIO.in1.val),
       gpio_mask_(pin < 32 ? (1UL << pin) : (1UL << (pin - 32)))
 #endif
+#ifdef USE_HOST
+      gpio_read_(&host_gpio_in),
+      gpio_mask_(1UL << (pin % 32))
+#endif
 {
 }
 
@@ -122,9 +126,6 @@ void GPIOPin::setup() { this->pin_mode(this->mode_); }
 bool ICACHE_RAM_ATTR HOT GPIOPin::digital_read() {
   return bool((*this->gpio_read_) & this->gpio_mask_) != this->inverted_;
 }
-bool ICACHE_RAM_ATTR HOT ISRInternalGPIOPin::digital_read() {
-  return bool((*this->gpio_read_) & this->gpio_mask_) != this->inverted_;
-}
 void ICACHE_RAM_ATTR HOT GPIOPin::digital_write(bool value) {
 #ifdef ARDUINO_ARCH_ESP8266
   if (this->pin_ != 16) {
@@ -149,29 +150,27 @@ void ICACHE_RAM_ATTR HOT GPIOPin::digital_write(bool value) {
   }
 #endif
 }
-void ICACHE_RAM_ATTR HOT ISRInternalGPIOPin::digital_write(bool value) {
+void ICACHE_RAM_ATTR HOT GPIOPortWriter::apply() {
 #ifdef ARDUINO_ARCH_ESP8266
-  if (this->pin_ != 16) {
-    if (value != this->inverted_) {
-      GPOS = this->gpio_mask_;
-    } else {
-      GPOC = this->gpio_mask_;
-    }
-  } else {
-    if (value != this->inverted_) {
-      GP16O |= 1;
-    } else {
-      GP16O &= ~1;
-    }
-  }
+  if (this->set_[0] != 0)
+    GPOS = this->set_[0];
+  if (this->clear_[0] != 0)
+    GPOC = this->clear_[0];
+  if ((this->set_[1] | this->clear_[1]) != 0)
+    GP16O = (GP16O & ~this->clear_[1]) | this->set_[1];
 #endif
 #ifdef ARDUINO_ARCH_ESP32
-  if (value != this->inverted_) {
-    (*this->gpio_set_) = this->gpio_mask_;
-  } else {
-    (*this->gpio_clear_) = this->gpio_mask_;
-  }
+  if (this->set_[0] != 0)
+    GPIO.out_w1ts = this->set_[0];
+  if (this->clear_[0] != 0)
+    GPIO.out_w1tc = this->clear_[0];
+  if (this->set_[1] != 0)
+    GPIO.out1_w1ts.val = this->set_[1];
+  if (this->clear_[1] != 0)
+    GPIO.out1_w1tc.val = this->clear_[1];
 #endif
+  this->set_[0] = this->set_[1] = 0;
+  this->clear_[0] = this->clear_[1] = 0;
 }
 ISRInternalGPIOPin::ISRInternalGPIOPin(uint8_t pin,
 #ifdef ARDUINO_ARCH_ESP32
@@ -44,8 +44,9 @@ class ISRInternalGPIOPin {
                      volatile uint32_t *gpio_clear, volatile uint32_t *gpio_set,
 #endif
                      volatile uint32_t *gpio_read, uint32_t gpio_mask, bool inverted);
-  bool digital_read();
-  void digital_write(bool value);
+  /// Inlined into the caller, so safe to call from ISRs in IRAM and free of call overhead in tight loops.
+  inline bool digital_read() __attribute__((always_inline));
+  inline void digital_write(bool value) __attribute__((always_inline));
   void clear_interrupt();
 
  protected:
@@ -99,6 +100,8 @@ class GPIOPin {
   ISRInternalGPIOPin *to_isr() const;
 
  protected:
+  friend class GPIOPortWriter;
+
   void attach_interrupt_(void (*func)(void *), void *arg, int mode) const;
   void detach_interrupt_() const;
 
@@ -116,6 +119,67 @@ class GPIOPin {
 template<typename T> void GPIOPin::attach_interrupt(void (*func)(T *), T *arg, int mode) const {
   this->attach_interrupt_(reinterpret_cast<void (*)(void *)>(func), arg, mode);
 }
+
+bool ISRInternalGPIOPin::digital_read() { return bool((*this->gpio_read_) & this->gpio_mask_) != this->inverted_; }
+void ISRInternalGPIOPin::digital_write(bool value) {
+#ifdef ARDUINO_ARCH_ESP8266
+  if (this->pin_ != 16) {
+    if (value != this->inverted_) {
+      GPOS = this->gpio_mask_;
+    } else {
+      GPOC = this->gpio_mask_;
+    }
+  } else {
+    if (value != this->inverted_) {
+      GP16O |= 1;
+    } else {
+      GP16O &= ~1;
+    }
+  }
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+  if (value != this->inverted_) {
+    (*this->gpio_set_) = this->gpio_mask_;
+  } else {
+    (*this->gpio_clear_) = this->gpio_mask_;
+  }
+#endif
+}
+
+/** Collects new levels of several internal pins and writes them with one set and one clear register write per port.
+ *
+ * Meant for parallel buses, where writing the pins one at a time is slow and lets the bus pass through intermediate
+ * values. Only for internal GPIOs, the pins of I/O expanders have to be written with GPIOPin::digital_write().
+ */
+class GPIOPortWriter {
+ public:
+  /// Set the level of the pin on the next apply(), inversion is handled.
+  void write(GPIOPin *pin, bool value) {
+    const uint8_t port = GPIOPortWriter::port_(pin->pin_);
+    if (value != pin->inverted_) {
+      this->set_[port] |= pin->gpio_mask_;
+      this->clear_[port] &= ~pin->gpio_mask_;
+    } else {
+      this->clear_[port] |= pin->gpio_mask_;
+      this->set_[port] &= ~pin->gpio_mask_;
+    }
+  }
+  /// Write all collected levels and start over.
+  void apply();
+
+ protected:
+  /// ESP8266: GPIO0-15 and GPIO16, ESP32: GPIO0-31 and GPIO32-39.
+  static uint8_t port_(uint8_t pin) {
+#ifdef ARDUINO_ARCH_ESP8266
+    return pin < 16 ? 0 : 1;
+#else
+    return pin < 32 ? 0 : 1;
+#endif
+  }
+
+  uint32_t set_[2]{0, 0};
+  uint32_t clear_[2]{0, 0};
+};
 /** This function can be used by the HAL to force-link specific symbols
  * into the generated binary without modifying the linker script.
  *
@@ -11,32 +11,41 @@
 #include "esphome/core/log.h"
 #include "esphome/core/esphal.h"
 
+#ifdef ARDUINO_ARCH_ESP32
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#endif
+
 namespace esphome {
 
 static const char *TAG = "helpers";
 
-std::string get_mac_address() {
-  char tmp[20];
-  uint8_t mac[6];
+static void get_mac_address_raw(uint8_t *mac) {
 #ifdef ARDUINO_ARCH_ESP32
   esp_efuse_mac_get_default(mac);
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
   WiFi.macAddress(mac);
 #endif
+#ifdef USE_HOST
+  // a fixed, locally administered address so that hostnames are stable between runs
+  static const uint8_t HOST_MAC[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+  std::copy(HOST_MAC, HOST_MAC + 6, mac);
+#endif
+}
+
+std::string get_mac_address() {
+  char tmp[20];
+  uint8_t mac[6] = {0};
+  get_mac_address_raw(mac);
   sprintf(tmp, "%02x%02x%02x%02x%02x%02x", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
   return std::string(tmp);
 }
 
 std::string get_mac_address_pretty() {
   char tmp[20];
-  uint8_t mac[6];
-#ifdef ARDUINO_ARCH_ESP32
-  esp_efuse_mac_get_default(mac);
-#endif
-#ifdef ARDUINO_ARCH_ESP8266
-  WiFi.macAddress(mac);
-#endif
+  uint8_t mac[6] = {0};
+  get_mac_address_raw(mac);
   sprintf(tmp, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
   return std::string(tmp);
 }
@@ -185,6 +194,15 @@ void delay_microseconds_accurate(uint32_t usec) {
   }
 }
 
+uint64_t micros_64() {
+#ifdef ARDUINO_ARCH_ESP32
+  return esp_timer_get_time();
+#else
+  // the core counts the overflows of micros() in a timer
+  return micros64();
+#endif
+}
+
 uint8_t reverse_bits_8(uint8_t x) {
   x = ((x & 0xAA) >> 1) | ((x & 0x55) << 1);
   x = ((x & 0xCC) >> 2) | ((x & 0x33) << 2);
@@ -241,18 +259,20 @@ std::string to_string(long double val) {
   sprintf(buf, "%Lf", val);
   return buf;
 }
-optional<float> parse_float(const std::string &str) {
+optional<float> parse_float(const std::string &str) { return parse_float(str.c_str(), str.size()); }
+optional<float> parse_float(const char *str, size_t len) {
   char *end;
-  float value = ::strtof(str.c_str(), &end);
-  if (end == nullptr || end != str.end().base())
+  float value = ::strtof(str, &end);
+  if (end == nullptr || end != str + len)
     return {};
   return value;
 }
-uint32_t fnv1_hash(const std::string &str) {
+uint32_t fnv1_hash(const std::string &str) { return fnv1_hash(str.data(), str.size()); }
+uint32_t fnv1_hash(const char *str, size_t len) {
   uint32_t hash = 2166136261UL;
-  for (char c : str) {
+  for (size_t i = 0; i < len; i++) {
     hash *= 16777619UL;
-    hash ^= c;
+    hash ^= str[i];
   }
   return hash;
 }
@@ -329,5 +349,54 @@ ICACHE_RAM_ATTR InterruptLock::~InterruptLock() { xt_wsr_ps(xt_state_); }
 ICACHE_RAM_ATTR InterruptLock::InterruptLock() { portDISABLE_INTERRUPTS(); }
 ICACHE_RAM_ATTR InterruptLock::~InterruptLock() { portENABLE_INTERRUPTS(); }
 #endif
+#ifdef USE_HOST
+// the host build has no interrupts
+InterruptLock::InterruptLock() {}
+InterruptLock::~InterruptLock() {}
+#endif
+
+/// Stored in front of every large buffer, keeps the buffer 8 byte aligned.
+struct LargeBufferHeader {
+  uint32_t size;
+  uint32_t external;
+};
+static size_t large_buffer_bytes[2] = {0, 0};  // NOLINT
+
+void *alloc_large_bytes(size_t size, BufferLocation location) {
+  const size_t total = sizeof(LargeBufferHeader) + size;
+  void *ptr = nullptr;
+  bool external = false;
+#if defined(BOARD_HAS_PSRAM) && defined(ARDUINO_ARCH_ESP32)
+  if (location == BUFFER_LOCATION_PREFER_EXTERNAL) {
+    ptr = heap_caps_malloc(total, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    external = ptr != nullptr;
+  }
+#endif
+  if (ptr == nullptr) {
+#ifdef ARDUINO_ARCH_ESP32
+    // plain malloc() may hand out PSRAM for large sizes
+    ptr = heap_caps_malloc(total, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+    ptr = malloc(total);  // NOLINT
+#endif
+  }
+  if (ptr == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate %u bytes!", size);
+    return nullptr;
+  }
+  auto *header = static_cast<LargeBufferHeader *>(ptr);
+  header->size = size;
+  header->external = external;
+  large_buffer_bytes[external] += size;
+  return header + 1;
+}
+void free_large(void *ptr) {
+  if (ptr == nullptr)
+    return;
+  auto *header = static_cast<LargeBufferHeader *>(ptr) - 1;
+  large_buffer_bytes[header->external] -= header->size;
+  free(header);  // NOLINT
+}
+size_t get_large_buffer_bytes(bool external) { return large_buffer_bytes[external]; }
 
 }  // namespace esphome
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <string>
 #include <functional>
 #include <vector>
 #include <memory>
+#include <new>
 #include <type_traits>
 
 #include "esphome/core/optional.h"
@@ -42,6 +44,8 @@ std::string to_string(float val);
 std::string to_string(double val);
 std::string to_string(long double val);
 optional<float> parse_float(const std::string &str);
+/// Parse the len characters at str as a float, str has to be null-terminated after them.
+optional<float> parse_float(const char *str, size_t len);
 
 /// Sanitize the hostname by removing characters that are not in the allowlist and truncating it to 63 chars.
 std::string sanitize_hostname(const std::string &hostname);
@@ -109,6 +113,32 @@ uint32_t fast_random_32();
 uint16_t fast_random_16();
 uint8_t fast_random_8();
 
+/** A small and fast pseudo random number generator (xorshift32) with its own state.
+ *
+ * For effects that need many random numbers per frame, everything is inlined. Not suitable for anything security
+ * related, seed it from random_uint32().
+ */
+class FastRandom {
+ public:
+  explicit FastRandom(uint32_t seed = 1) { this->seed(seed); }
+  void seed(uint32_t seed) { this->state_ = seed != 0 ? seed : 1; }
+  uint32_t next_32() {
+    uint32_t x = this->state_;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return this->state_ = x;
+  }
+  uint8_t next_8() { return this->next_32() >> 24; }
+  /// A random float between 0 (inclusive) and 1 (exclusive).
+  float next_float() { return (this->next_32() >> 8) * (1.0f / 16777216.0f); }
+  /// A random number between 0 and max - 1, without a division.
+  uint32_t next_below(uint32_t max) { return (uint64_t(this->next_32()) * max) >> 32; }
+
+ protected:
+  uint32_t state_;
+};
+
 /// Applies gamma correction with the provided gamma to value.
 float gamma_correct(float value, float gamma);
 
@@ -194,16 +224,88 @@ template<bool B, class T = void> using enable_if_t = typename std::enable_if<B,
 template<typename T, enable_if_t<!std::is_pointer<T>::value, int> = 0> T id(T value) { return value; }
 template<typename T, enable_if_t<std::is_pointer<T *>::value, int> = 0> T &id(T *value) { return *value; }
 
+template<typename... X> class Delegate;
+
+/** A non-allocating alternative to std::function: a function pointer plus a small inline buffer for the callable.
+ *
+ * Function pointers, captureless lambdas and lambdas capturing up to two pointers (for example `this`) are stored
+ * inline, so a Delegate never allocates and calling it is a single indirect call. Larger callables are rejected at
+ * compile time, use make_persistent_delegate() for those.
+ *
+ * @tparam R The return type of the callable.
+ * @tparam Ts The arguments of the callable.
+ */
+template<typename R, typename... Ts> class Delegate<R(Ts...)> {
+ public:
+  static constexpr size_t STORAGE_SIZE = 2 * sizeof(void *);
+
+  /// Whether a callable of type F can be stored inline.
+  template<typename F> struct fits {  // NOLINT
+    static constexpr bool value = sizeof(F) <= STORAGE_SIZE && alignof(F) <= alignof(void *) &&  // NOLINT
+                                  std::is_trivially_destructible<F>::value;
+  };
+
+  Delegate() = default;
+  Delegate(std::nullptr_t) {}  // NOLINT
+  template<typename F, typename D = typename std::decay<F>::type,
+           enable_if_t<!std::is_same<D, Delegate>::value && !std::is_same<D, std::nullptr_t>::value, int> = 0>
+  Delegate(F &&callable) {  // NOLINT
+    static_assert(fits<D>::value, "Callable too large for Delegate, use make_persistent_delegate()");
+    new (this->storage_) D(std::forward<F>(callable));
+    this->invoke_ = &Delegate::invoke_callable_<D>;
+  }
+
+  /// Bind a member function to an object without any allocation.
+  template<class C, R (C::*M)(Ts...)> static Delegate from_method(C *obj) {
+    return Delegate([obj](Ts... args) -> R { return (obj->*M)(args...); });
+  }
+
+  R operator()(Ts... args) const { return this->invoke_(this->storage_, args...); }
+  explicit operator bool() const { return this->invoke_ != nullptr; }
+
+ protected:
+  template<typename F> static R invoke_callable_(const void *storage, Ts... args) {
+    return (*reinterpret_cast<F *>(const_cast<void *>(storage)))(args...);
+  }
+
+  R (*invoke_)(const void *, Ts...){nullptr};
+  alignas(void *) uint8_t storage_[STORAGE_SIZE];
+};
+
+/** Create a Delegate for any callable, for callbacks that stay registered for the lifetime of the program.
+ *
+ * Callables that don't fit into a Delegate (for example a std::function) are moved to the heap once and never freed.
+ */
+template<typename Sig, typename F, typename D = typename std::decay<F>::type,
+         enable_if_t<Delegate<Sig>::template fits<D>::value, int> = 0>
+Delegate<Sig> make_persistent_delegate(F &&callable) {
+  return Delegate<Sig>(std::forward<F>(callable));
+}
+template<typename Sig, typename D> struct HeapCallable;  // NOLINT
+template<typename R, typename... Ts, typename D> struct HeapCallable<R(Ts...), D> {
+  D *callable;
+  R operator()(Ts... args) const { return (*this->callable)(args...); }
+};
+template<typename Sig, typename F, typename D = typename std::decay<F>::type,
+         enable_if_t<!Delegate<Sig>::template fits<D>::value, int> = 0>
+Delegate<Sig> make_persistent_delegate(F &&callable) {
+  return Delegate<Sig>(HeapCallable<Sig, D>{new D(std::forward<F>(callable))});  // NOLINT
+}
+
 template<typename... X> class CallbackManager;
 
 /** Simple helper class to allow having multiple subscribers to a signal.
+ *
+ * The callbacks are stored as Delegates, so registering a lambda capturing `this` doesn't allocate.
  *
  * @tparam Ts The arguments for the callback, wrapped in void().
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
   /// Add a callback to the internal callback list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  template<typename F> void add(F &&callback) {
+    this->callbacks_.push_back(make_persistent_delegate<void(Ts...)>(std::forward<F>(callback)));
+  }
 
   /// Call all callbacks in this manager.
   void call(Ts... args) {
@@ -212,7 +314,7 @@ template<typename... Ts> class CallbackManager<void(Ts...)> {
   }
 
  protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
+  std::vector<Delegate<void(Ts...)>> callbacks_;
 };
 
 // https://stackoverflow.com/a/37161919/8924614
@@ -226,6 +328,12 @@ struct is_callable  // NOLINT
   static constexpr auto value = decltype(test<T>(nullptr))::value;  // NOLINT
 };
 
+/** A value of an automation that is either a constant or a lambda evaluated with the trigger arguments.
+ *
+ * Constants are stored as plain members. Lambdas are stored in a Delegate, so the lambdas generated from the
+ * configuration (which don't capture anything) are stored inline without an allocation and called with a single
+ * indirect call.
+ */
 template<typename T, typename... X> class TemplatableValue {
  public:
   TemplatableValue() : type_(EMPTY) {}
@@ -234,7 +342,7 @@ template<typename T, typename... X> class TemplatableValue {
   TemplatableValue(F value) : type_(VALUE), value_(value) {}
 
   template<typename F, enable_if_t<is_callable<F, X...>::value, int> = 0>
-  TemplatableValue(F f) : type_(LAMBDA), f_(f) {}
+  TemplatableValue(F f) : type_(LAMBDA), f_(make_persistent_delegate<T(X...)>(f)) {}
 
   bool has_value() { return this->type_ != EMPTY; }
 
@@ -261,14 +369,14 @@ template<typename T, typename... X> class TemplatableValue {
   }
 
  protected:
-  enum {
+  enum : uint8_t {
     EMPTY,
     VALUE,
     LAMBDA,
   } type_;
 
-  T value_;
-  std::function<T(X...)> f_;
+  T value_{};
+  Delegate<T(X...)> f_;
 };
 
 template<typename... X> class TemplatableStringValue : public TemplatableValue<std::string, X...> {
@@ -285,6 +393,14 @@ template<typename... X> class TemplatableStringValue : public TemplatableValue<s
 
 void delay_microseconds_accurate(uint32_t usec);
 
+/** A monotonic clock in microseconds since boot that doesn't overflow, unlike micros() and millis().
+ *
+ * It isn't affected by setting the time of day either, so it measures intervals across SNTP synchronizations.
+ */
+uint64_t micros_64();
+/// micros_64() in milliseconds.
+inline uint64_t millis_64() { return micros_64() / 1000ULL; }
+
 template<typename T> class Deduplicator {
  public:
   bool next(T value) {
@@ -303,6 +419,30 @@ template<typename T> class Deduplicator {
   T last_value_{};
 };
 
+/** A sum of doubles with Kahan compensation.
+ *
+ * The rounding error of each addition is carried over to the next one, so adding many small values to a large sum,
+ * like the energy of a few seconds to a yearly total, doesn't lose them.
+ */
+class CompensatedSum {
+ public:
+  void add(double value) {
+    const double y = value - this->compensation_;
+    const double t = this->sum_ + y;
+    this->compensation_ = (t - this->sum_) - y;
+    this->sum_ = t;
+  }
+  void reset(double sum = 0.0) {
+    this->sum_ = sum;
+    this->compensation_ = 0.0;
+  }
+  double get() const { return this->sum_; }
+
+ protected:
+  double sum_{0.0};
+  double compensation_{0.0};
+};
+
 template<typename T> class Parented {
  public:
   Parented() {}
@@ -316,5 +456,35 @@ template<typename T> class Parented {
 };
 
 uint32_t fnv1_hash(const std::string &str);
+uint32_t fnv1_hash(const char *str, size_t len);
+
+/// Where a buffer allocated with alloc_large() may be placed.
+enum BufferLocation : uint8_t {
+  /// Internal RAM, for buffers that interrupts or DMA read, which also happens while the flash cache is disabled.
+  BUFFER_LOCATION_INTERNAL,
+  /// PSRAM if the board has it (BOARD_HAS_PSRAM, see the psram option), otherwise internal RAM.
+  BUFFER_LOCATION_PREFER_EXTERNAL,
+};
+
+/** Allocate a large buffer of size bytes, returns nullptr if there is no room.
+ *
+ * With the psram option large, rarely accessed buffers like framebuffers and LED back buffers can go to PSRAM, keeping
+ * internal RAM for the network stacks. The sizes of all large buffers are counted by location for
+ * get_large_buffer_bytes(). Free the buffer with free_large().
+ */
+void *alloc_large_bytes(size_t size, BufferLocation location);
+void free_large(void *ptr);
+/// Allocate a large array of count default-constructed Ts, see alloc_large_bytes().
+template<typename T> T *alloc_large(size_t count, BufferLocation location) {
+  static_assert(std::is_trivially_destructible<T>::value, "free_large() doesn't call destructors");
+  auto *ptr = static_cast<T *>(alloc_large_bytes(count * sizeof(T), location));
+  if (ptr != nullptr) {
+    for (size_t i = 0; i < count; i++)
+      new (ptr + i) T();
+  }
+  return ptr;
+}
+/// The bytes in the large buffers that are allocated in internal RAM (external = false) or in PSRAM (external = true).
+size_t get_large_buffer_bytes(bool external);
 
 }  // namespace esphome
@@ -0,0 +1,385 @@
+#include "esphome/core/mdns_responder.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+
+static const char *TAG = "mdns";
+
+static const size_t MDNS_HEADER_SIZE = 12;
+/// The longest name in wire format, including the empty label at its end.
+static const size_t MDNS_MAX_NAME_LENGTH = 255;
+/// A mask has a bit for each record.
+static const size_t MDNS_MAX_RECORDS = 32;
+/// The TTL of records containing the host name, and of all others (RFC 6762 section 10).
+static const uint32_t MDNS_HOST_TTL = 120;
+static const uint32_t MDNS_OTHER_TTL = 4500;
+/// Legacy queriers don't flush their caches when the address changes (RFC 6762 section 6.7).
+static const uint32_t MDNS_LEGACY_TTL = 10;
+/// A record isn't multicast or sent to the same querier more often (RFC 6762 section 6.2).
+static const uint32_t MDNS_MIN_RESEND_INTERVAL = 1000;
+
+static const uint16_t MDNS_TYPE_A = 1;
+static const uint16_t MDNS_TYPE_PTR = 12;
+static const uint16_t MDNS_TYPE_TXT = 16;
+static const uint16_t MDNS_TYPE_SRV = 33;
+static const uint16_t MDNS_TYPE_ANY = 255;
+static const uint16_t MDNS_CLASS_IN = 1;
+static const uint16_t MDNS_CLASS_ANY = 255;
+/// Set on the class of unique records, and on the class of questions that want a unicast response.
+static const uint16_t MDNS_CLASS_FLAG = 0x8000;
+
+static uint16_t get_uint16(const uint8_t *data) { return (data[0] << 8) | data[1]; }
+static void put_uint16(uint8_t *data, uint16_t value) {
+  data[0] = value >> 8;
+  data[1] = value;
+}
+static void append_uint16(std::string *out, uint16_t value) {
+  out->push_back(value >> 8);
+  out->push_back(value);
+}
+static void append_label(std::string *out, const std::string &label) {
+  out->push_back(label.size());
+  for (char c : label)
+    out->push_back(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+}
+static std::string make_name(const std::string &first, const std::string &rest) {
+  std::string name;
+  append_label(&name, first);
+  name += rest;
+  return name;
+}
+
+/** Read the name at pos in wire format without compression and in lowercase, pos is moved past it.
+ *
+ * Returns the length of the name, 0 if it isn't valid.
+ */
+static size_t read_name(const uint8_t *msg, size_t size, size_t *pos, uint8_t *name) {
+  size_t len = 0;
+  size_t at = *pos;
+  bool jumped = false;
+  // a pointer has to point backwards, so there are no loops
+  size_t limit = at;
+  while (at < size) {
+    const uint8_t label = msg[at];
+    if ((label & 0xC0) == 0xC0) {
+      if (at + 1 >= size)
+        return 0;
+      if (!jumped)
+        *pos = at + 2;
+      jumped = true;
+      at = ((label & 0x3F) << 8) | msg[at + 1];
+      if (at >= limit)
+        return 0;
+      limit = at;
+      continue;
+    }
+    if ((label & 0xC0) != 0 || len + label + 1 > MDNS_MAX_NAME_LENGTH || at + label + 1 > size)
+      return 0;
+    name[len++] = label;
+    for (uint8_t i = 1; i <= label; i++) {
+      const uint8_t c = msg[at + i];
+      name[len++] = c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+    }
+    at += label + 1;
+    if (label == 0) {
+      if (!jumped)
+        *pos = at;
+      return len;
+    }
+  }
+  return 0;
+}
+
+void MDNSResponder::set_hostname(const std::string &hostname) {
+  std::string local;
+  append_label(&local, "local");
+  local.push_back(0);
+  this->host_name_ = make_name(hostname, local);
+
+  this->records_.clear();
+  this->add_record_(this->host_name_, MDNS_TYPE_A, MDNS_HOST_TTL, std::string(4, '\0'), 0);
+}
+
+void MDNSResponder::add_service(const std::string &service, const std::string &protocol, uint16_t port,
+                                const std::vector<std::string> &txt) {
+  if (this->records_.size() + 4 > MDNS_MAX_RECORDS) {
+    ESP_LOGW(TAG, "Too many services, _%s._%s isn't published", service.c_str(), protocol.c_str());
+    return;
+  }
+  // the records of a service are named after the host, like <hostname>._esphomelib._tcp.local
+  const std::string local = this->host_name_.substr(this->host_name_[0] + 1);
+  const std::string type_name = make_name("_" + service, make_name("_" + protocol, local));
+  const std::string instance_name = this->host_name_.substr(0, this->host_name_[0] + 1) + type_name;
+
+  const size_t first = this->records_.size();
+  const uint32_t srv_bit = 1UL << (first + 1), txt_bit = 1UL << (first + 2), a_bit = 1UL << 0;
+  this->add_record_(type_name, MDNS_TYPE_PTR, MDNS_OTHER_TTL, instance_name, srv_bit | txt_bit | a_bit);
+
+  std::string srv;
+  append_uint16(&srv, 0);  // priority
+  append_uint16(&srv, 0);  // weight
+  append_uint16(&srv, port);
+  srv += this->host_name_;
+  this->add_record_(instance_name, MDNS_TYPE_SRV, MDNS_HOST_TTL, srv, a_bit);
+
+  std::string entries;
+  for (const auto &entry : txt) {
+    const size_t len = std::min<size_t>(entry.size(), 255);
+    entries.push_back(len);
+    entries.append(entry, 0, len);
+  }
+  this->add_record_(instance_name, MDNS_TYPE_TXT, MDNS_OTHER_TTL, entries, 0);
+
+  // DNS-SD service type enumeration (RFC 6763 section 9)
+  const std::string services_name = make_name("_services", make_name("_dns-sd", make_name("_udp", local)));
+  this->add_record_(services_name, MDNS_TYPE_PTR, MDNS_OTHER_TTL, type_name, 0);
+}
+
+void MDNSResponder::set_address(const uint8_t *address, uint32_t now) {
+  if (this->records_.empty())
+    return;
+  this->set_rdata_(&this->records_[0], std::string(reinterpret_cast<const char *>(address), 4));
+  for (auto &record : this->records_) {
+    record.queried = false;
+    record.refresh_at = now;
+  }
+  this->announcements_ = 2;
+  this->next_announcement_ = now;
+}
+
+void MDNSResponder::add_record_(const std::string &name, uint16_t type, uint32_t ttl, const std::string &rdata,
+                                uint32_t additional) {
+  Record record{};
+  record.name = name;
+  record.type = type;
+  record.ttl = ttl;
+  record.additional = additional;
+  this->set_rdata_(&record, rdata);
+  this->records_.push_back(record);
+}
+
+void MDNSResponder::set_rdata_(Record *record, const std::string &rdata) {
+  // PTR records are shared between hosts, all others belong to this host only
+  const uint16_t klass = MDNS_CLASS_IN | (record->type == MDNS_TYPE_PTR ? 0 : MDNS_CLASS_FLAG);
+  record->wire = record->name;
+  append_uint16(&record->wire, record->type);
+  append_uint16(&record->wire, klass);
+  append_uint16(&record->wire, record->ttl >> 16);
+  append_uint16(&record->wire, record->ttl);
+  append_uint16(&record->wire, rdata.size());
+  record->wire += rdata;
+}
+
+uint32_t MDNSResponder::find_records_(const uint8_t *name, size_t len, uint16_t type) const {
+  uint32_t records = 0;
+  for (size_t i = 0; i < this->records_.size(); i++) {
+    const Record &record = this->records_[i];
+    if ((type == record.type || type == MDNS_TYPE_ANY) && record.name.size() == len &&
+        memcmp(record.name.data(), name, len) == 0)
+      records |= 1UL << i;
+  }
+  return records;
+}
+
+bool MDNSResponder::rdata_matches_(const Record &record, const uint8_t *msg, size_t size, size_t pos,
+                                   uint16_t len) const {
+  const char *rdata = record.wire.data() + record.name.size() + 10;
+  const size_t rdata_len = record.wire.size() - record.name.size() - 10;
+  if (record.type != MDNS_TYPE_PTR)
+    return len == rdata_len && memcmp(rdata, &msg[pos], len) == 0;
+  // the name in a PTR record may be compressed
+  uint8_t name[MDNS_MAX_NAME_LENGTH];
+  const size_t name_len = read_name(msg, size, &pos, name);
+  return name_len == rdata_len && memcmp(rdata, name, name_len) == 0;
+}
+
+uint32_t MDNSResponder::append_records_(uint32_t records, uint8_t *buffer, size_t capacity, size_t *pos, bool legacy,
+                                        uint16_t *count) const {
+  uint32_t written = 0;
+  for (size_t i = 0; i < this->records_.size(); i++) {
+    const Record &record = this->records_[i];
+    if ((records & (1UL << i)) == 0 || *pos + record.wire.size() > capacity)
+      continue;
+    uint8_t *out = &buffer[*pos];
+    memcpy(out, record.wire.data(), record.wire.size());
+    if (legacy) {
+      uint8_t *fields = out + record.name.size();
+      put_uint16(fields + 2, MDNS_CLASS_IN);
+      put_uint16(fields + 4, 0);
+      put_uint16(fields + 6, std::min(record.ttl, MDNS_LEGACY_TTL));
+    }
+    *pos += record.wire.size();
+    (*count)++;
+    written |= 1UL << i;
+  }
+  return written;
+}
+
+MDNSResponder::Querier *MDNSResponder::find_querier_(uint32_t address, uint32_t now) {
+  Querier *oldest = &this->queriers_[0];
+  for (auto &querier : this->queriers_) {
+    if (querier.address == address) {
+      oldest = &querier;
+      break;
+    }
+    if (now - querier.time > now - oldest->time)
+      oldest = &querier;
+  }
+  if (oldest->address != address || now - oldest->time >= MDNS_MIN_RESEND_INTERVAL) {
+    oldest->address = address;
+    oldest->time = now;
+    oldest->sent = 0;
+  }
+  return oldest;
+}
+
+size_t MDNSResponder::answer(uint8_t *msg, size_t size, size_t capacity, uint32_t querier, bool legacy, uint32_t now,
+                             bool *unicast) {
+  // only standard queries
+  if (size < MDNS_HEADER_SIZE || (msg[2] & 0xF8) != 0 || this->records_.empty())
+    return 0;
+  const uint16_t question_count = get_uint16(&msg[4]);
+  const uint16_t known_count = get_uint16(&msg[6]);
+
+  uint8_t name[MDNS_MAX_NAME_LENGTH];
+  uint32_t asked = 0;
+  bool unicast_requested = true;
+  size_t pos = MDNS_HEADER_SIZE;
+  for (uint16_t i = 0; i < question_count; i++) {
+    const size_t len = read_name(msg, size, &pos, name);
+    if (len == 0 || pos + 4 > size)
+      return 0;
+    const uint16_t type = get_uint16(&msg[pos]);
+    const uint16_t klass = get_uint16(&msg[pos + 2]);
+    pos += 4;
+    if ((klass & MDNS_CLASS_FLAG) == 0)
+      unicast_requested = false;
+    if ((klass & ~MDNS_CLASS_FLAG) == MDNS_CLASS_IN || (klass & ~MDNS_CLASS_FLAG) == MDNS_CLASS_ANY)
+      asked |= this->find_records_(name, len, type);
+  }
+  if (asked == 0)
+    return 0;
+  const size_t questions_end = pos;
+
+  // known-answer suppression (RFC 6762 section 7.1), the list may be cut off if the query didn't fit into the buffer
+  uint32_t known = 0;
+  for (uint16_t i = 0; i < known_count; i++) {
+    const size_t len = read_name(msg, size, &pos, name);
+    if (len == 0 || pos + 10 > size)
+      break;
+    const uint16_t type = get_uint16(&msg[pos]);
+    const uint32_t ttl = (uint32_t(get_uint16(&msg[pos + 4])) << 16) | get_uint16(&msg[pos + 6]);
+    const uint16_t rdata_len = get_uint16(&msg[pos + 8]);
+    pos += 10;
+    if (pos + rdata_len > size)
+      break;
+    const uint32_t candidates = asked & this->find_records_(name, len, type);
+    for (size_t j = 0; j < this->records_.size(); j++) {
+      const Record &record = this->records_[j];
+      if ((candidates & (1UL << j)) != 0 && ttl >= record.ttl / 2 &&
+          this->rdata_matches_(record, msg, size, pos, rdata_len))
+        known |= 1UL << j;
+    }
+    pos += rdata_len;
+  }
+
+  for (size_t i = 0; i < this->records_.size(); i++) {
+    if ((asked & (1UL << i)) != 0) {
+      this->records_[i].queried = true;
+      this->records_[i].last_queried = now;
+    }
+  }
+
+  *unicast = legacy || unicast_requested;
+  uint32_t answers = asked & ~known;
+  if (!*unicast) {
+    for (size_t i = 0; i < this->records_.size(); i++) {
+      if (now - this->records_[i].last_multicast < MDNS_MIN_RESEND_INTERVAL)
+        answers &= ~(1UL << i);
+    }
+  }
+  Querier *entry = this->find_querier_(querier, now);
+  answers &= ~entry->sent;
+  if (answers == 0)
+    return 0;
+  uint32_t additional = 0;
+  for (size_t i = 0; i < this->records_.size(); i++) {
+    if ((answers & (1UL << i)) != 0)
+      additional |= this->records_[i].additional;
+  }
+  additional &= ~(answers | known);
+
+  // legacy responses repeat the ID and the questions, which stay where they are
+  if (!legacy) {
+    put_uint16(&msg[0], 0);
+    put_uint16(&msg[4], 0);
+  }
+  msg[2] = 0x84;
+  msg[3] = 0x00;
+  uint16_t answer_count = 0, additional_count = 0;
+  pos = legacy ? questions_end : MDNS_HEADER_SIZE;
+  const uint32_t written = this->append_records_(answers, msg, capacity, &pos, legacy, &answer_count);
+  if (written == 0)
+    return 0;
+  this->append_records_(additional, msg, capacity, &pos, legacy, &additional_count);
+  put_uint16(&msg[6], answer_count);
+  put_uint16(&msg[8], 0);
+  put_uint16(&msg[10], additional_count);
+
+  entry->sent |= written;
+  if (!*unicast) {
+    for (size_t i = 0; i < this->records_.size(); i++) {
+      if ((written & (1UL << i)) != 0) {
+        this->records_[i].last_multicast = now;
+        this->records_[i].refresh_at = now + this->records_[i].ttl * 750UL;
+      }
+    }
+  }
+  return pos;
+}
+
+size_t MDNSResponder::announce(uint8_t *buffer, size_t capacity, uint32_t now) {
+  if (this->records_.empty() || capacity < MDNS_HEADER_SIZE)
+    return 0;
+  uint32_t records = this->pending_;
+  if (this->announcements_ != 0) {
+    if (int32_t(now - this->next_announcement_) >= 0) {
+      this->announcements_--;
+      this->next_announcement_ = now + 1000;
+      records |= 0xFFFFFFFFUL >> (MDNS_MAX_RECORDS - this->records_.size());
+    }
+  } else {
+    for (size_t i = 0; i < this->records_.size(); i++) {
+      Record &record = this->records_[i];
+      if (int32_t(now - record.refresh_at) < 0)
+        continue;
+      // nobody has the record in its cache, they ask when they need it
+      if (record.queried && now - record.last_queried < record.ttl * 1000UL)
+        records |= 1UL << i;
+      else
+        record.refresh_at = now + record.ttl * 750UL;
+    }
+  }
+  if (records == 0)
+    return 0;
+
+  memset(buffer, 0, MDNS_HEADER_SIZE);
+  buffer[2] = 0x84;
+  uint16_t count = 0;
+  size_t pos = MDNS_HEADER_SIZE;
+  const uint32_t written = this->append_records_(records, buffer, capacity, &pos, false, &count);
+  put_uint16(&buffer[6], count);
+  // a record that doesn't fit on its own is dropped
+  this->pending_ = written != 0 ? records & ~written : 0;
+  for (size_t i = 0; i < this->records_.size(); i++) {
+    if ((written & (1UL << i)) != 0) {
+      this->records_[i].last_multicast = now;
+      this->records_[i].refresh_at = now + this->records_[i].ttl * 750UL;
+    }
+  }
+  return written != 0 ? pos : 0;
+}
+
+}  // namespace esphome
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+/** A minimal mDNS responder (RFC 6762) for the host name and the DNS-SD services of the node.
+ *
+ * It doesn't own a socket, util.cpp passes the packets in and sends what comes out. All records are serialized when
+ * they're set up, so a response only copies the records that were asked for. To keep the multicast traffic low on
+ * networks with many browsers:
+ * - records that the querier lists as known with at least half of their TTL left aren't sent again,
+ * - a record is multicast at most once per second, and sent to the same querier at most once per second,
+ * - after the address changes all records are announced twice. Later a record is only announced again at 3/4 of its
+ *   TTL if it was queried within the TTL, which refreshes the caches of all browsers before they start asking.
+ */
+class MDNSResponder {
+ public:
+  /// Set up the A record of <hostname>.local, this removes all services.
+  void set_hostname(const std::string &hostname);
+  /// Add a service of the host, with TXT entries in the form "key=value".
+  void add_service(const std::string &service, const std::string &protocol, uint16_t port,
+                   const std::vector<std::string> &txt);
+  /// Set the IPv4 address of the host, which restarts the announcements.
+  void set_address(const uint8_t *address, uint32_t now);
+
+  /** Answer a query, the response is written into the buffer of the query.
+   *
+   * @param msg The query, replaced by the response.
+   * @param size The size of the query.
+   * @param capacity The size of the buffer.
+   * @param querier The IP address of the querier, only used to tell queriers apart.
+   * @param legacy Whether the query didn't come from port 5353, then it's answered like a unicast DNS query.
+   * @param now The current time in ms.
+   * @param unicast Set to whether the response is only sent to the querier.
+   * @return The size of the response, 0 if nothing is sent.
+   */
+  size_t answer(uint8_t *msg, size_t size, size_t capacity, uint32_t querier, bool legacy, uint32_t now,
+                bool *unicast);
+  /// Write the announcement that is due into the buffer, returns its size or 0 if none is due. Call until it returns 0.
+  size_t announce(uint8_t *buffer, size_t capacity, uint32_t now);
+
+ protected:
+  struct Record {
+    /// The name in wire format, lowercase.
+    std::string name;
+    uint16_t type;
+    uint32_t ttl;
+    /// The precomputed resource record: name, type, class, TTL, data length and data.
+    std::string wire;
+    /// The records that are added to the additional section when this one is an answer.
+    uint32_t additional;
+    uint32_t last_multicast;
+    uint32_t last_queried;
+    uint32_t refresh_at;
+    bool queried;
+  };
+  struct Querier {
+    uint32_t address;
+    uint32_t time;
+    /// The records sent to the querier since time.
+    uint32_t sent;
+  };
+
+  void add_record_(const std::string &name, uint16_t type, uint32_t ttl, const std::string &rdata,
+                   uint32_t additional);
+  void set_rdata_(Record *record, const std::string &rdata);
+  /// The records that answer a question for the name in wire format.
+  uint32_t find_records_(const uint8_t *name, size_t len, uint16_t type) const;
+  /// Whether the data of a known answer is the data of the record.
+  bool rdata_matches_(const Record &record, const uint8_t *msg, size_t size, size_t pos, uint16_t len) const;
+  /// Append the records that fit, returns the ones that were written.
+  uint32_t append_records_(uint32_t records, uint8_t *buffer, size_t capacity, size_t *pos, bool legacy,
+                           uint16_t *count) const;
+  /// The entry of the querier, reset once its second is over.
+  Querier *find_querier_(uint32_t address, uint32_t now);
+
+  std::string host_name_;
+  std::vector<Record> records_;
+  Querier queriers_[4]{};
+  /// The records that didn't fit into the last announcement.
+  uint32_t pending_{0};
+  uint32_t next_announcement_{0};
+  uint8_t announcements_{0};
+};
+
+}  // namespace esphome
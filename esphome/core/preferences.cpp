@@ -3,6 +3,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
 
+#include <algorithm>
+
 #ifdef ARDUINO_ARCH_ESP8266
 extern "C" {
 #include "spi_flash.h"
@@ -17,6 +19,18 @@ namespace esphome {
 
 static const char *TAG = "preferences";
 
+#if defined(ARDUINO_ARCH_ESP8266) || (defined(ARDUINO_ARCH_ESP32) && !defined(USE_PREFERENCES_DEFERRED_WRITES))
+static uint32_t hash_words(const uint32_t *data, size_t length_words) {
+  // FNV-1 over the words, only used to detect changes
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < length_words; i++) {
+    hash *= 16777619UL;
+    hash ^= data[i];
+  }
+  return hash;
+}
+#endif
+
 ESPPreferenceObject::ESPPreferenceObject() : offset_(0), length_words_(0), type_(0), data_(nullptr) {}
 ESPPreferenceObject::ESPPreferenceObject(size_t offset, size_t length, uint32_t type)
     : offset_(offset), length_words_(length), type_(type) {
@@ -65,6 +79,18 @@ static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 128;
 static const uint32_t ESP8266_FLASH_STORAGE_SIZE = 64;
 #endif
 
+// With more than one sector, each write goes to the next sector (the last ones of the SPIFFS area, before the EEPROM
+// sector) with a header, and the copy with the highest sequence number wins on boot. A single sector uses the
+// original header-less layout, also when the SPIFFS sectors turn out to be in use.
+#ifdef USE_ESP8266_PREFERENCES_FLASH_SECTORS
+static const uint8_t ESP8266_FLASH_SECTORS = USE_ESP8266_PREFERENCES_FLASH_SECTORS;
+#else
+static const uint8_t ESP8266_FLASH_SECTORS = 1;
+#endif
+static const uint32_t ESP8266_FLASH_MAGIC = 0x45535046;  // "ESPF"
+/// magic, sequence number, hash of the storage words
+static const uint32_t ESP8266_FLASH_HEADER_WORDS = 3;
+
 static inline bool esp_rtc_user_mem_read(uint32_t index, uint32_t *dest) {
   if (index >= ESP_RTC_USER_MEM_SIZE_WORDS) {
     return false;
@@ -100,29 +126,85 @@ static const uint32_t get_esp8266_flash_sector() {
 }
 static const uint32_t get_esp8266_flash_address() { return get_esp8266_flash_sector() * SPI_FLASH_SEC_SIZE; }
 
-void ESPPreferences::save_esp8266_flash_() {
+extern "C" uint32_t _SPIFFS_start;
+
+/** Whether the sectors that flash_sectors rotates over may be written.
+ *
+ * They are the last ones of the filesystem area (the preferences sector follows it), so the area has to be large
+ * enough and each sector either erased or holding preferences. Anything else belongs to a filesystem.
+ */
+static bool esp8266_flash_sectors_unused() {
+  union {
+    uint32_t *ptr;
+    uint32_t uint;
+  } data{};
+  data.ptr = &_SPIFFS_start;
+  const uint32_t first_fs_sector = (data.uint - 0x40200000) / SPI_FLASH_SEC_SIZE;
+  const uint32_t last_sector = get_esp8266_flash_sector();
+  if (last_sector < first_fs_sector + ESP8266_FLASH_SECTORS - 1)
+    return false;
+
+  for (uint8_t i = 1; i < ESP8266_FLASH_SECTORS; i++) {
+    const uint32_t address = (last_sector - i) * SPI_FLASH_SEC_SIZE;
+    uint32_t words[16];
+    for (uint32_t offset = 0; offset < SPI_FLASH_SEC_SIZE; offset += sizeof(words)) {
+      {
+        InterruptLock lock;
+        spi_flash_read(address + offset, words, sizeof(words));
+      }
+      if (offset == 0 && words[0] == ESP8266_FLASH_MAGIC)
+        break;
+      for (uint32_t word : words) {
+        if (word != 0xFFFFFFFF)
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ESPPreferences::save_esp8266_flash_() {
   if (!esp8266_flash_dirty)
-    return;
+    return true;
 
   ESP_LOGVV(TAG, "Saving preferences to flash...");
+  uint32_t sector = get_esp8266_flash_sector();
+  uint32_t *data = this->flash_storage_;
+  uint32_t size = ESP8266_FLASH_STORAGE_SIZE * 4;
+  uint8_t next_index = 0;
+  if (this->flash_sectors_ > 1) {
+    next_index = (this->flash_sector_index_ + 1) % this->flash_sectors_;
+    sector -= next_index;
+    this->flash_buffer_[0] = ESP8266_FLASH_MAGIC;
+    this->flash_buffer_[1] = this->flash_sequence_ + 1;
+    this->flash_buffer_[2] = hash_words(this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE);
+    data = this->flash_buffer_;
+    size += ESP8266_FLASH_HEADER_WORDS * 4;
+  }
+
   SpiFlashOpResult erase_res, write_res = SPI_FLASH_RESULT_OK;
   {
     InterruptLock lock;
-    erase_res = spi_flash_erase_sector(get_esp8266_flash_sector());
+    erase_res = spi_flash_erase_sector(sector);
     if (erase_res == SPI_FLASH_RESULT_OK) {
-      write_res = spi_flash_write(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
+      write_res = spi_flash_write(sector * SPI_FLASH_SEC_SIZE, data, size);
     }
   }
   if (erase_res != SPI_FLASH_RESULT_OK) {
     ESP_LOGV(TAG, "Erase ESP8266 flash failed!");
-    return;
+    return false;
   }
   if (write_res != SPI_FLASH_RESULT_OK) {
     ESP_LOGV(TAG, "Write ESP8266 flash failed!");
-    return;
+    return false;
   }
 
+  if (this->flash_sectors_ > 1) {
+    this->flash_sector_index_ = next_index;
+    this->flash_sequence_++;
+  }
   esp8266_flash_dirty = false;
+  return true;
 }
 
 bool ESPPreferenceObject::save_internal_() {
@@ -137,8 +219,11 @@ bool ESPPreferenceObject::save_internal_() {
         esp8266_flash_dirty = true;
       *ptr = v;
     }
-    global_preferences.save_esp8266_flash_();
+#ifdef USE_PREFERENCES_DEFERRED_WRITES
     return true;
+#else
+    return global_preferences.save_esp8266_flash_();
+#endif
   }
 
   for (uint32_t i = 0; i <= this->length_words_; i++) {
@@ -173,9 +258,54 @@ ESPPreferences::ESPPreferences()
     : current_offset_(0) {}
 
 void ESPPreferences::begin() {
-  this->flash_storage_ = new uint32_t[ESP8266_FLASH_STORAGE_SIZE];
+  this->flash_buffer_ = new uint32_t[ESP8266_FLASH_HEADER_WORDS + ESP8266_FLASH_STORAGE_SIZE];
+  this->flash_storage_ = this->flash_buffer_ + ESP8266_FLASH_HEADER_WORDS;
   ESP_LOGVV(TAG, "Loading preferences from flash...");
 
+  if (ESP8266_FLASH_SECTORS > 1) {
+    if (esp8266_flash_sectors_unused()) {
+      this->flash_sectors_ = ESP8266_FLASH_SECTORS;
+    } else {
+      ESP_LOGE(TAG, "The %u sectors before the preferences are not free filesystem sectors, not rotating",
+               ESP8266_FLASH_SECTORS - 1);
+    }
+  }
+  if (this->flash_sectors_ > 1) {
+    // Find the newest valid copy, the sequence numbers are compared with wrap-around
+    const uint32_t last_sector = get_esp8266_flash_sector();
+    bool found = false;
+    for (uint8_t i = 0; i < this->flash_sectors_; i++) {
+      uint32_t header[ESP8266_FLASH_HEADER_WORDS];
+      {
+        InterruptLock lock;
+        spi_flash_read((last_sector - i) * SPI_FLASH_SEC_SIZE, header, sizeof(header));
+      }
+      if (header[0] != ESP8266_FLASH_MAGIC)
+        continue;
+      if (found && int32_t(header[1] - this->flash_sequence_) <= 0)
+        continue;
+      {
+        InterruptLock lock;
+        spi_flash_read((last_sector - i) * SPI_FLASH_SEC_SIZE + sizeof(header), this->flash_storage_,
+                       ESP8266_FLASH_STORAGE_SIZE * 4);
+      }
+      if (hash_words(this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE) != header[2])
+        continue;
+      found = true;
+      this->flash_sector_index_ = i;
+      this->flash_sequence_ = header[1];
+    }
+    if (found) {
+      // the storage might have been overwritten by a later candidate that turned out to be invalid
+      InterruptLock lock;
+      spi_flash_read((last_sector - this->flash_sector_index_) * SPI_FLASH_SEC_SIZE +
+                         ESP8266_FLASH_HEADER_WORDS * 4,
+                     this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
+      return;
+    }
+    // Fall back to the single sector layout, so that existing preferences are kept
+  }
+
   {
     InterruptLock lock;
     spi_flash_read(get_esp8266_flash_address(), this->flash_storage_, ESP8266_FLASH_STORAGE_SIZE * 4);
@@ -224,54 +354,207 @@ ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type
 }
 void ESPPreferences::prevent_write(bool prevent) { this->prevent_write_ = prevent; }
 bool ESPPreferences::is_prevent_write() { return this->prevent_write_; }
+bool ESPPreferences::sync() { return this->save_esp8266_flash_(); }
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
+#ifdef USE_PREFERENCES_DEFERRED_WRITES
+/// The NVS key of the packed blob, which can't collide with the numeric keys of single preferences.
+static const char *PACKED_KEY = "packed";
+/// The first word of the packed blob, followed by the records: (key << 16) | length in words, then the words.
+static const uint32_t PACKED_MAGIC = 0x31504B50UL;
+/// The largest blob the NVS of ESP-IDF 3 can store.
+static const size_t PACKED_MAX_SIZE = 1984;
+
 bool ESPPreferenceObject::save_internal_() {
   if (global_preferences.nvs_handle_ == 0)
     return false;
 
-  char key[32];
-  sprintf(key, "%u", this->offset_);
-  uint32_t len = (this->length_words_ + 1) * 4;
-  esp_err_t err = nvs_set_blob(global_preferences.nvs_handle_, key, this->data_, len);
-  if (err) {
-    ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
+  const size_t length_words = this->length_words_ + 1;
+  auto &record = global_preferences.packed_record_(this->offset_);
+  if (record.data.size() == length_words && std::equal(record.data.begin(), record.data.end(), this->data_))
+    // unchanged, don't wear the flash
+    return true;
+  record.data.assign(this->data_, this->data_ + length_words);
+  record.dirty = true;
+  global_preferences.packed_dirty_ = true;
+  return true;
+}
+bool ESPPreferenceObject::load_internal_() {
+  if (global_preferences.nvs_handle_ == 0)
     return false;
+
+  const size_t length_words = this->length_words_ + 1;
+  auto &record = global_preferences.packed_record_(this->offset_);
+  if (record.data.empty()) {
+    // stored under its own key, by a firmware without deferred writes or because it didn't fit into the packed blob.
+    // The next sync() moves it into the blob if it fits now.
+    if (!global_preferences.read_nvs_(this->offset_, this->data_, length_words))
+      return false;
+    record.data.assign(this->data_, this->data_ + length_words);
+    record.legacy = true;
+    global_preferences.packed_dirty_ = true;
+    return true;
   }
-  err = nvs_commit(global_preferences.nvs_handle_);
-  if (err) {
-    ESP_LOGV(TAG, "nvs_commit('%s', len=%u) failed: %s", key, len, esp_err_to_name(err));
+  if (record.data.size() != length_words) {
+    ESP_LOGVV(TAG, "Packed length does not match. Assuming key changed (%u!=%u)", record.data.size(), length_words);
     return false;
   }
+  memcpy(this->data_, record.data.data(), length_words * 4);
   return true;
 }
-bool ESPPreferenceObject::load_internal_() {
+ESPPreferences::PackedRecord &ESPPreferences::packed_record_(uint32_t key) {
+  if (key >= this->packed_records_.size())
+    this->packed_records_.resize(key + 1, PackedRecord{{}, false, false});
+  return this->packed_records_[key];
+}
+void ESPPreferences::load_packed_() {
+  size_t len;
+  if (nvs_get_blob(this->nvs_handle_, PACKED_KEY, nullptr, &len) != ESP_OK || len < 4 || len % 4 != 0)
+    return;
+  std::vector<uint32_t> blob(len / 4);
+  if (nvs_get_blob(this->nvs_handle_, PACKED_KEY, blob.data(), &len) != ESP_OK || blob[0] != PACKED_MAGIC)
+    return;
+
+  size_t pos = 1;
+  while (pos < blob.size()) {
+    const uint32_t key = blob[pos] >> 16;
+    const size_t length_words = blob[pos] & 0xFFFF;
+    pos++;
+    if (length_words > blob.size() - pos)
+      break;
+    this->packed_record_(key).data.assign(blob.begin() + pos, blob.begin() + pos + length_words);
+    pos += length_words;
+  }
+}
+bool ESPPreferences::sync() {
+  if (!this->packed_dirty_)
+    return true;
+  if (this->nvs_handle_ == 0)
+    return false;
+
+  bool success = true;
+  bool write_blob = false;
+  std::vector<uint32_t> blob{PACKED_MAGIC};
+  std::vector<uint32_t> packed_keys;
+  for (uint32_t key = 0; key < this->current_offset_ && key < this->packed_records_.size(); key++) {
+    auto &record = this->packed_records_[key];
+    if (record.data.empty())
+      continue;
+    if ((blob.size() + 1 + record.data.size()) * 4 <= PACKED_MAX_SIZE) {
+      blob.push_back((key << 16) | record.data.size());
+      blob.insert(blob.end(), record.data.begin(), record.data.end());
+      packed_keys.push_back(key);
+      write_blob |= record.dirty || record.legacy;
+    } else if (record.dirty || !record.legacy) {
+      // doesn't fit, stored under its own key like without deferred writes (once, until the data changes)
+      if (this->commit_nvs_(key, record.data.data(), record.data.size())) {
+        record.dirty = false;
+        record.legacy = true;
+      } else {
+        success = false;
+      }
+    }
+  }
+
+  ESP_LOGVV(TAG, "Committing preferences (%u bytes packed)...", blob.size() * 4);
+  if (write_blob) {
+    esp_err_t err = nvs_set_blob(this->nvs_handle_, PACKED_KEY, blob.data(), blob.size() * 4);
+    if (err) {
+      ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", PACKED_KEY, blob.size() * 4, esp_err_to_name(err));
+      success = false;
+    } else {
+      for (uint32_t key : packed_keys) {
+        auto &record = this->packed_records_[key];
+        if (record.legacy) {
+          // moved into the blob
+          char key_str[12];
+          sprintf(key_str, "%u", key);
+          nvs_erase_key(this->nvs_handle_, key_str);
+        }
+        record.dirty = record.legacy = false;
+      }
+    }
+  }
+  // a single commit for all of them
+  esp_err_t err = nvs_commit(this->nvs_handle_);
+  if (err) {
+    ESP_LOGV(TAG, "nvs_commit() failed: %s", esp_err_to_name(err));
+    success = false;
+  }
+  this->packed_dirty_ = !success;
+  return success;
+}
+ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
+  auto pref = ESPPreferenceObject(this->current_offset_, length, type);
+  this->current_offset_++;
+  return pref;
+}
+#else
+bool ESPPreferenceObject::save_internal_() {
   if (global_preferences.nvs_handle_ == 0)
     return false;
 
-  char key[32];
-  sprintf(key, "%u", this->offset_);
-  uint32_t len = (this->length_words_ + 1) * 4;
+  const size_t length_words = this->length_words_ + 1;
+  if (hash_words(this->data_, length_words) == global_preferences.committed_hashes_[this->offset_])
+    // unchanged since the last commit, don't wear the flash
+    return true;
 
-  uint32_t actual_len;
-  esp_err_t err = nvs_get_blob(global_preferences.nvs_handle_, key, nullptr, &actual_len);
+  if (!global_preferences.commit_nvs_(this->offset_, this->data_, length_words))
+    return false;
+  global_preferences.committed_hashes_[this->offset_] = hash_words(this->data_, length_words);
+  esp_err_t err = nvs_commit(global_preferences.nvs_handle_);
   if (err) {
-    ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", key, esp_err_to_name(err));
+    ESP_LOGV(TAG, "nvs_commit('%u', len=%u) failed: %s", this->offset_, length_words * 4, esp_err_to_name(err));
+    return false;
+  }
+  return true;
+}
+bool ESPPreferenceObject::load_internal_() {
+  if (global_preferences.nvs_handle_ == 0)
+    return false;
+
+  if (!global_preferences.read_nvs_(this->offset_, this->data_, this->length_words_ + 1))
+    return false;
+  global_preferences.committed_hashes_[this->offset_] = hash_words(this->data_, this->length_words_ + 1);
+  return true;
+}
+bool ESPPreferences::sync() { return true; }
+ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
+  auto pref = ESPPreferenceObject(this->current_offset_, length, type);
+  this->current_offset_++;
+  this->committed_hashes_.push_back(0);
+  return pref;
+}
+#endif
+ESPPreferences::ESPPreferences() : current_offset_(0) {}
+bool ESPPreferences::read_nvs_(uint32_t key, uint32_t *data, size_t length_words) {
+  char key_str[12];
+  sprintf(key_str, "%u", key);
+  // a larger blob fails with ESP_ERR_NVS_INVALID_LENGTH, a smaller one is read and its length returned
+  size_t len = length_words * 4;
+  esp_err_t err = nvs_get_blob(this->nvs_handle_, key_str, data, &len);
+  if (err == ESP_ERR_NVS_INVALID_LENGTH || (err == ESP_OK && len != length_words * 4)) {
+    ESP_LOGVV(TAG, "NVS length does not match. Assuming key changed (%u!=%u)", len, length_words * 4);
     return false;
   }
-  if (actual_len != len) {
-    ESP_LOGVV(TAG, "NVS length does not match. Assuming key changed (%u!=%u)", actual_len, len);
+  if (err) {
+    ESP_LOGV(TAG, "nvs_get_blob('%s'): %s - the key might not be set yet", key_str, esp_err_to_name(err));
     return false;
   }
-  err = nvs_get_blob(global_preferences.nvs_handle_, key, this->data_, &len);
+  return true;
+}
+bool ESPPreferences::commit_nvs_(uint32_t key, const uint32_t *data, size_t length_words) {
+  char key_str[12];
+  sprintf(key_str, "%u", key);
+  uint32_t len = length_words * 4;
+  esp_err_t err = nvs_set_blob(this->nvs_handle_, key_str, data, len);
   if (err) {
-    ESP_LOGV(TAG, "nvs_get_blob('%s') failed: %s", key, esp_err_to_name(err));
+    ESP_LOGV(TAG, "nvs_set_blob('%s', len=%u) failed: %s", key_str, len, esp_err_to_name(err));
     return false;
   }
   return true;
 }
-ESPPreferences::ESPPreferences() : current_offset_(0) {}
 void ESPPreferences::begin() {
   auto ns = truncate_string(App.get_name(), 15);
   esp_err_t err = nvs_open(ns.c_str(), NVS_READWRITE, &this->nvs_handle_);
@@ -286,13 +569,34 @@ void ESPPreferences::begin() {
       this->nvs_handle_ = 0;
     }
   }
+#ifdef USE_PREFERENCES_DEFERRED_WRITES
+  if (this->nvs_handle_ != 0)
+    this->load_packed_();
+#endif
 }
+#endif
 
+#ifdef USE_HOST
+bool ESPPreferenceObject::save_internal_() {
+  global_preferences.host_storage_[this->offset_].assign(this->data_, this->data_ + this->length_words_ + 1);
+  return true;
+}
+bool ESPPreferenceObject::load_internal_() {
+  const auto &stored = global_preferences.host_storage_[this->offset_];
+  if (stored.size() != this->length_words_ + 1)
+    return false;
+  memcpy(this->data_, stored.data(), stored.size() * 4);
+  return true;
+}
+ESPPreferences::ESPPreferences() : current_offset_(0) {}
+void ESPPreferences::begin() {}
 ESPPreferenceObject ESPPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
   auto pref = ESPPreferenceObject(this->current_offset_, length, type);
   this->current_offset_++;
+  this->host_storage_.emplace_back();
   return pref;
 }
+bool ESPPreferences::sync() { return true; }
 #endif
 uint32_t ESPPreferenceObject::calculate_crc_() const {
   uint32_t crc = this->type_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "esphome/core/esphal.h"
 #include "esphome/core/defines.h"
@@ -16,6 +17,10 @@ class ESPPreferenceObject {
 
   template<typename T> bool load(T *dest);
 
+  /// Save or load all the words the preference was made with, for records whose size is only known at runtime.
+  bool save_words(const uint32_t *src);
+  bool load_words(uint32_t *dest);
+
   bool is_initialized() const;
 
  protected:
@@ -49,6 +54,10 @@ static bool DEFAULT_IN_FLASH = false;
 static bool DEFAULT_IN_FLASH = true;
 #endif
 
+#ifdef USE_HOST
+static bool DEFAULT_IN_FLASH = false;
+#endif
+
 class ESPPreferences {
  public:
   ESPPreferences();
@@ -68,18 +77,64 @@ class ESPPreferences {
   bool is_prevent_write();
 #endif
 
+  /** Commit all preferences that have changed since the last commit to flash.
+   *
+   * With USE_PREFERENCES_DEFERRED_WRITES the flash backends only mark changed preferences as dirty in save(),
+   * and the preferences component calls this periodically and before shutdown.
+   *
+   * @return Whether all pending writes were committed successfully.
+   */
+  bool sync();
+
  protected:
   friend ESPPreferenceObject;
 
   uint32_t current_offset_;
 #ifdef ARDUINO_ARCH_ESP32
+  /// Read the blob of a preference stored under its own key, with a single NVS lookup.
+  bool read_nvs_(uint32_t key, uint32_t *data, size_t length_words);
+  bool commit_nvs_(uint32_t key, const uint32_t *data, size_t length_words);
+
   uint32_t nvs_handle_;
+#ifdef USE_PREFERENCES_DEFERRED_WRITES
+  /** With deferred writes all preferences live in RAM and are stored together in one packed NVS blob.
+   *
+   * begin() reads the blob once instead of looking up every preference, sync() writes all of them with one
+   * write and one commit. Preferences that don't fit into the blob are stored under their own key.
+   */
+  struct PackedRecord {
+    std::vector<uint32_t> data;
+    /// Changed since the last sync().
+    bool dirty;
+    /// Stored under its own key, written before the packed blob existed or too large for it.
+    bool legacy;
+  };
+  PackedRecord &packed_record_(uint32_t key);
+  void load_packed_();
+
+  std::vector<PackedRecord> packed_records_;
+  bool packed_dirty_{false};
+#else
+  /// Hash of the data last committed (or loaded) for each key, 0 if unknown.
+  std::vector<uint32_t> committed_hashes_;
+#endif
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
-  void save_esp8266_flash_();
+  bool save_esp8266_flash_();
   bool prevent_write_{false};
+  /// Sector header (only used when rotating across sectors) followed by the storage words.
+  uint32_t *flash_buffer_;
   uint32_t *flash_storage_;
   uint32_t current_flash_offset_;
+  /// Number of sectors rotated over, 1 if the configured ones turned out to be in use by something else.
+  uint8_t flash_sectors_{1};
+  /// Index of the sector (counting down from the last one) holding the newest copy.
+  uint8_t flash_sector_index_{0};
+  uint32_t flash_sequence_{0};
+#endif
+#ifdef USE_HOST
+  /// The stored words of every preference, only kept in memory for as long as the process runs.
+  std::vector<std::vector<uint32_t>> host_storage_;
 #endif
 };
 
@@ -106,4 +161,20 @@ template<typename T> bool ESPPreferenceObject::load(T *dest) {
   return true;
 }
 
+inline bool ESPPreferenceObject::save_words(const uint32_t *src) {
+  if (!this->is_initialized())
+    return false;
+  memcpy(this->data_, src, this->length_words_ * 4);
+  return this->save_();
+}
+
+inline bool ESPPreferenceObject::load_words(uint32_t *dest) {
+  memset(this->data_, 0, this->length_words_ * 4);
+  if (!this->load_())
+    return false;
+
+  memcpy(dest, this->data_, this->length_words_ * 4);
+  return true;
+}
+
 }  // namespace esphome
@@ -0,0 +1,165 @@
+#include "esphome/core/profiler.h"
+
+#ifdef USE_PROFILER
+
+#include "esphome/core/component.h"
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+
+#if defined(USE_PROFILER_ALLOCATIONS) && defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+
+void ProfilerStats::record(uint32_t duration_us) {
+  this->count++;
+  this->total_us += duration_us;
+  this->last_us = duration_us;
+  if (duration_us < this->min_us)
+    this->min_us = duration_us;
+  if (duration_us > this->max_us)
+    this->max_us = duration_us;
+  if (duration_us > this->window_max_us)
+    this->window_max_us = duration_us;
+  for (uint8_t i = 0; i < PROFILER_BUCKETS; i++) {
+    if (duration_us <= bucket_limit(i)) {
+      this->buckets[i]++;
+      break;
+    }
+  }
+}
+float ProfilerStats::mean_us() const {
+  if (this->count == 0)
+    return NAN;
+  return this->total_us / float(this->count);
+}
+uint32_t ProfilerStats::take_window_max() {
+  uint32_t ret = this->window_max_us;
+  this->window_max_us = 0;
+  return ret;
+}
+
+void Profiler::set_component_name(Component *component, const char *name) {
+  this->get_component_(component)->name = name;
+}
+ComponentProfile *Profiler::get_component_(Component *component) {
+  if (component->profile_ != nullptr)
+    return component->profile_;
+  auto *profile = new ComponentProfile();
+  profile->component = component;
+  profile->name = nullptr;
+  component->profile_ = profile;
+  this->components_.push_back(profile);
+  return profile;
+}
+void HOT Profiler::record_component(Component *component, bool setup, uint32_t duration_us) {
+  ComponentProfile *profile = this->get_component_(component);
+  if (setup) {
+    profile->setup_us += duration_us;
+  } else {
+    profile->loop.record(duration_us);
+  }
+}
+const char *Profiler::get_component_name(Component *component) {
+  if (component == nullptr || component->profile_ == nullptr)
+    return nullptr;
+  return component->profile_->name;
+}
+ComponentProfile *Profiler::get_slowest_component() {
+  ComponentProfile *slowest = nullptr;
+  for (auto *profile : this->components_) {
+    if (slowest == nullptr || profile->loop.last_us > slowest->loop.last_us)
+      slowest = profile;
+  }
+  return slowest;
+}
+ComponentProfile *HOT Profiler::enter(Component *component) {
+#ifdef USE_DUAL_CORE
+  if (App.is_network_task())
+    return nullptr;
+#endif
+  ComponentProfile *previous = this->current_;
+  // look the profile up first, creating it allocates
+  ComponentProfile *profile = component != nullptr ? this->get_component_(component) : nullptr;
+#if defined(USE_PROFILER_ALLOCATIONS) && defined(ARDUINO_ARCH_ESP32)
+  this->loop_task_ = xTaskGetCurrentTaskHandle();
+#endif
+  this->current_ = profile;
+  return previous;
+}
+void HOT Profiler::leave(ComponentProfile *previous) {
+#ifdef USE_DUAL_CORE
+  if (App.is_network_task())
+    return;
+#endif
+  this->current_ = previous;
+}
+#ifdef USE_PROFILER_ALLOCATIONS
+void HOT Profiler::record_allocation(size_t size) {
+#ifdef ARDUINO_ARCH_ESP32
+  if (this->loop_task_ != nullptr && xTaskGetCurrentTaskHandle() != this->loop_task_)
+    return;
+#endif
+  this->alloc_count_++;
+  this->alloc_bytes_ += size;
+  ComponentProfile *current = this->current_;
+  if (current != nullptr) {
+    current->alloc_count++;
+    current->alloc_bytes += size;
+  }
+}
+#endif
+void HOT Profiler::record_scheduler(Component *component, const std::string &name, uint32_t name_hash,
+                                    uint32_t duration_us) {
+  for (auto *profile : this->scheduler_) {
+    if (profile->component == component && profile->name_hash == name_hash && profile->name == name) {
+      profile->stats.record(duration_us);
+      return;
+    }
+  }
+  auto *profile = new SchedulerProfile();
+  profile->component = component;
+  profile->name = name;
+  profile->name_hash = name_hash;
+  profile->stats.record(duration_us);
+  this->scheduler_.push_back(profile);
+}
+void HOT Profiler::record_loop_start(uint32_t now_us, uint32_t target_interval_ms) {
+  if (this->last_loop_start_us_ != 0) {
+    const uint32_t actual = now_us - this->last_loop_start_us_;
+    const uint32_t target = target_interval_ms * 1000;
+    this->loop_jitter_.record(actual > target ? actual - target : target - actual);
+  }
+  this->last_loop_start_us_ = now_us;
+}
+
+Profiler global_profiler;  // NOLINT
+
+}  // namespace esphome
+
+#ifdef USE_PROFILER_ALLOCATIONS
+// Linked with -Wl,--wrap=malloc etc., the __real_ functions are the original ones. Allocations may happen before
+// global_profiler is constructed, its counters are zero-initialized static storage until then.
+extern "C" {
+void *__real_malloc(size_t size);              // NOLINT
+void *__real_calloc(size_t num, size_t size);  // NOLINT
+void *__real_realloc(void *ptr, size_t size);  // NOLINT
+
+void *__wrap_malloc(size_t size) {  // NOLINT
+  esphome::global_profiler.record_allocation(size);
+  return __real_malloc(size);
+}
+void *__wrap_calloc(size_t num, size_t size) {  // NOLINT
+  esphome::global_profiler.record_allocation(num * size);
+  return __real_calloc(num, size);
+}
+void *__wrap_realloc(void *ptr, size_t size) {  // NOLINT
+  esphome::global_profiler.record_allocation(size);
+  return __real_realloc(ptr, size);
+}
+}
+#endif
+
+#endif  // USE_PROFILER
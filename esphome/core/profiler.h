@@ -0,0 +1,128 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "esphome/core/defines.h"
+#include "esphome/core/esphal.h"
+
+#ifdef USE_PROFILER
+
+namespace esphome {
+
+class Component;
+
+/// Number of histogram buckets, bucket i counts durations of at most PROFILER_BUCKET_BASE_US * 4^i µs.
+static const uint8_t PROFILER_BUCKETS = 8;
+static const uint32_t PROFILER_BUCKET_BASE_US = 16;
+
+/// Accumulated duration statistics of a single code path, all values in microseconds.
+struct ProfilerStats {
+  uint32_t count{0};
+  uint32_t min_us{UINT32_MAX};
+  uint32_t max_us{0};
+  uint64_t total_us{0};
+  /// Duration of the most recent call.
+  uint32_t last_us{0};
+  /// Maximum since the last call to take_window_max().
+  uint32_t window_max_us{0};
+  /// Non-cumulative histogram, durations above the last bucket limit are only part of count.
+  uint32_t buckets[PROFILER_BUCKETS]{};
+
+  void record(uint32_t duration_us);
+  float mean_us() const;
+  /// Return the maximum since the last call and start a new window.
+  uint32_t take_window_max();
+
+  /// Upper (inclusive) limit of the given histogram bucket.
+  static uint32_t bucket_limit(uint8_t bucket) { return PROFILER_BUCKET_BASE_US << (2 * bucket); }
+};
+
+struct ComponentProfile {
+  Component *component;
+  /// Name of the component (its ID in the configuration), nullptr if unknown.
+  const char *name;
+  uint32_t setup_us{0};
+  ProfilerStats loop;
+#ifdef USE_PROFILER_ALLOCATIONS
+  /// Heap allocations made while the component was running, see Profiler::record_allocation().
+  uint32_t alloc_count{0};
+  uint64_t alloc_bytes{0};
+#endif
+};
+
+struct SchedulerProfile {
+  Component *component;
+  std::string name;
+  uint32_t name_hash;
+  ProfilerStats stats;
+};
+
+/** Records how much time is spent in each component, scheduler callback and main loop iteration.
+ *
+ * Enabled with the profiler option of the debug component. The data is exposed through the debug
+ * component (logs and sensors) as well as the Prometheus exporter.
+ *
+ * With USE_PROFILER_ALLOCATIONS, malloc(), calloc() and realloc() are wrapped at link time (and with them operator
+ * new), and every allocation made by the main loop is counted for the component that is running.
+ */
+class Profiler {
+ public:
+  /// Register a human-readable name for the component, called from the generated code.
+  void set_component_name(Component *component, const char *name);
+
+  void record_component(Component *component, bool setup, uint32_t duration_us);
+  /// Record a scheduler callback, name_hash is the hash the scheduler keeps for the name of the item.
+  void record_scheduler(Component *component, const std::string &name, uint32_t name_hash, uint32_t duration_us);
+  /// Record the start of a main loop iteration, calculating the jitter against the target interval.
+  void record_loop_start(uint32_t now_us, uint32_t target_interval_ms);
+  void record_loop(uint32_t duration_us) { this->loop_.record(duration_us); }
+  /** Make the component the running one for the allocation tracking, returns the previous one to pass to leave().
+   *
+   * Only the loop task is tracked, calls from the network task of the dual_core option are ignored.
+   */
+  ComponentProfile *enter(Component *component);
+  void leave(ComponentProfile *previous);
+  /// The component whose setup(), loop() or scheduler callback is running, nullptr outside of them.
+  ComponentProfile *get_current() const { return this->current_; }
+#ifdef USE_PROFILER_ALLOCATIONS
+  /// Called by the malloc() wrappers, must not allocate itself.
+  void record_allocation(size_t size);
+  /// Allocations made by the main loop in total, including the ones outside of any component.
+  uint32_t get_alloc_count() const { return this->alloc_count_; }
+  uint64_t get_alloc_bytes() const { return this->alloc_bytes_; }
+#endif
+
+  const std::vector<ComponentProfile *> &get_components() const { return this->components_; }
+  const std::vector<SchedulerProfile *> &get_scheduler() const { return this->scheduler_; }
+  /// Return the registered name of the component, nullptr if it has none.
+  const char *get_component_name(Component *component);
+  /// Return the component that spent the most time in its last loop() call.
+  ComponentProfile *get_slowest_component();
+  ProfilerStats &get_loop() { return this->loop_; }
+  ProfilerStats &get_loop_jitter() { return this->loop_jitter_; }
+
+ protected:
+  ComponentProfile *get_component_(Component *component);
+
+  /// Items are allocated individually so that pointers stay valid and are cached in Component.
+  std::vector<ComponentProfile *> components_;
+  std::vector<SchedulerProfile *> scheduler_;
+  ProfilerStats loop_;
+  ProfilerStats loop_jitter_;
+  uint32_t last_loop_start_us_{0};
+  ComponentProfile *current_{nullptr};
+#ifdef USE_PROFILER_ALLOCATIONS
+  uint32_t alloc_count_{0};
+  uint64_t alloc_bytes_{0};
+#ifdef ARDUINO_ARCH_ESP32
+  /// Allocations of the other tasks (WiFi, Bluetooth, TCP) are not counted.
+  void *loop_task_{nullptr};
+#endif
+#endif
+};
+
+extern Profiler global_profiler;
+
+}  // namespace esphome
+
+#endif  // USE_PROFILER
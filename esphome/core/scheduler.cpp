@@ -1,6 +1,7 @@
 #include "scheduler.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/profiler.h"
 #include <algorithm>
 
 namespace esphome {
@@ -10,44 +11,54 @@ static const char *TAG = "scheduler";
 static const uint32_t SCHEDULER_DONT_RUN = 4294967295UL;
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 
+#ifndef USE_SCHEDULER_TIMER_WHEEL
+
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
 
-void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
-                                std::function<void()> &&func) {
+SchedulerHandle HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                                           std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
   if (!name.empty())
     this->cancel_timeout(component, name);
 
   if (timeout == SCHEDULER_DONT_RUN)
-    return;
+    return 0;
 
   ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
 
   auto item = make_unique<SchedulerItem>();
   item->component = component;
   item->name = name;
+#ifdef USE_PROFILER
+  item->name_hash = fnv1_hash(name);
+#endif
   item->type = SchedulerItem::TIMEOUT;
   item->timeout = timeout;
   item->last_execution = now;
+  item->slack_delay = 0;
   item->last_execution_major = this->millis_major_;
   item->f = std::move(func);
   item->remove = false;
+  if (++this->last_handle_ == 0)
+    this->last_handle_ = 1;
+  item->handle = this->last_handle_;
   this->push_(std::move(item));
+  return this->last_handle_;
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
   return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
 }
-void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
-                                 std::function<void()> &&func) {
+SchedulerHandle HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+                                            std::function<void()> &&func) {
   const uint32_t now = this->millis_();
 
   if (!name.empty())
     this->cancel_interval(component, name);
 
   if (interval == SCHEDULER_DONT_RUN)
-    return;
+    return 0;
 
   // only put offset in lower half
   uint32_t offset = 0;
@@ -59,25 +70,50 @@ void HOT Scheduler::set_interval(Component *component, const std::string &name,
   auto item = make_unique<SchedulerItem>();
   item->component = component;
   item->name = name;
+#ifdef USE_PROFILER
+  item->name_hash = fnv1_hash(name);
+#endif
   item->type = SchedulerItem::INTERVAL;
   item->interval = interval;
   item->last_execution = now - offset - interval;
   item->last_execution_major = this->millis_major_;
   if (item->last_execution > now)
     item->last_execution_major--;
+  this->align_(item.get());
   item->f = std::move(func);
   item->remove = false;
+  if (++this->last_handle_ == 0)
+    this->last_handle_ = 1;
+  item->handle = this->last_handle_;
   this->push_(std::move(item));
+  return this->last_handle_;
 }
 bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
   return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
 }
+bool HOT Scheduler::cancel(SchedulerHandle handle) {
+  if (handle == 0)
+    return false;
+  for (auto &it : this->items_)
+    if (it->handle == handle && !it->remove) {
+      to_remove_++;
+      it->remove = true;
+      return true;
+    }
+  for (auto &it : this->to_add_)
+    if (it->handle == handle && !it->remove) {
+      it->remove = true;
+      return true;
+    }
+  return false;
+}
+void Scheduler::reserve(size_t count) { this->items_.reserve(count); }
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
   if (this->empty_())
     return {};
   auto &item = this->items_[0];
   const uint32_t now = this->millis_();
-  uint32_t next_time = item->last_execution + item->interval;
+  uint32_t next_time = item->next_execution();
   if (next_time < now)
     return 0;
   return next_time - now;
@@ -133,7 +169,7 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
     {
       // Don't copy-by value yet
       auto &item = this->items_[0];
-      if ((now - item->last_execution) < item->interval)
+      if ((now - item->last_execution) < item->interval + item->slack_delay)
         // Not reached timeout yet, done for this call
         break;
       uint8_t major = item->next_execution_major();
@@ -155,7 +191,17 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
       // Warning: During f(), a lot of stuff can happen, including:
       //  - timeouts/intervals get added, potentially invalidating vector pointers
       //  - timeouts/intervals get cancelled
+#ifdef USE_PROFILER
+      ComponentProfile *previous = global_profiler.enter(item->component);
+      const uint32_t start = micros();
+      item->f();
+      // the item may have moved in the vector during f()
+      auto &ran = this->items_[0];
+      global_profiler.record_scheduler(ran->component, ran->name, ran->name_hash, micros() - start);
+      global_profiler.leave(previous);
+#else
       item->f();
+#endif
     }
 
     {
@@ -179,6 +225,7 @@ void ICACHE_RAM_ATTR HOT Scheduler::call() {
           item->last_execution += amount * item->interval;
           if (item->last_execution < before)
             item->last_execution_major++;
+          this->align_(item.get());
         }
         this->push_(std::move(item));
       }
@@ -268,4 +315,374 @@ bool HOT Scheduler::SchedulerItem::cmp(const std::unique_ptr<SchedulerItem> &a,
   return a_next_exec > b_next_exec;
 }
 
+#else  // USE_SCHEDULER_TIMER_WHEEL
+Scheduler::Scheduler() {
+  for (auto &head : this->heads_)
+    head = INVALID_INDEX;
+}
+SchedulerHandle HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                                           std::function<void()> &&func) {
+  const uint32_t now = millis();
+
+  if (!name.empty())
+    this->cancel_timeout(component, name);
+
+  if (timeout == SCHEDULER_DONT_RUN)
+    return 0;
+
+  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%u)", name.c_str(), timeout);
+
+  return this->schedule_(component, name, SchedulerItem::TIMEOUT, timeout, now, std::move(func));
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
+}
+SchedulerHandle HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
+                                            std::function<void()> &&func) {
+  const uint32_t now = millis();
+
+  if (!name.empty())
+    this->cancel_interval(component, name);
+
+  if (interval == SCHEDULER_DONT_RUN)
+    return 0;
+
+  // only put offset in lower half
+  uint32_t offset = 0;
+  if (interval != 0)
+    offset = (random_uint32() % interval) / 2;
+
+  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%u, offset=%u)", name.c_str(), interval, offset);
+
+  return this->schedule_(component, name, SchedulerItem::INTERVAL, interval, now - offset - interval,
+                         std::move(func));
+}
+bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel(SchedulerHandle handle) {
+  const uint32_t slot = handle & 0xFFFF;
+  if (slot == 0 || slot > this->capacity_)
+    return false;
+  const uint16_t index = slot - 1;
+  SchedulerItem *item = this->item_(index);
+  if (item->generation != (handle >> 16) || item->remove)
+    return false;
+  if (item->list == LIST_NONE && item->f == nullptr)
+    // Released item, handle is stale
+    return false;
+  this->cancel_index_(index);
+  return true;
+}
+void Scheduler::reserve(size_t count) {
+  while (this->capacity_ < count) {
+    if (this->capacity_ + CHUNK_SIZE >= INVALID_INDEX)
+      break;
+    std::unique_ptr<SchedulerItem[]> chunk(new SchedulerItem[CHUNK_SIZE]);
+    this->chunks_.push_back(std::move(chunk));
+    // Push to the free list in reverse so that items are handed out in order
+    for (uint16_t i = CHUNK_SIZE; i > 0; i--) {
+      const uint16_t index = this->capacity_ + i - 1;
+      SchedulerItem *item = this->item_(index);
+      item->generation = 0;
+      item->remove = false;
+      item->list = LIST_NONE;
+      item->next = this->free_head_;
+      this->free_head_ = index;
+    }
+    this->capacity_ += CHUNK_SIZE;
+  }
+  if (this->name_buckets_.size() < this->capacity_)
+    this->index_rehash_();
+}
+optional<uint32_t> HOT Scheduler::next_schedule_in() {
+  if (this->heads_[LIST_DUE] != INVALID_INDEX)
+    return 0;
+  if (this->wheel_count_ == 0)
+    return {};
+
+  const uint32_t now = millis();
+  uint32_t time = this->wheel_time_;
+  for (uint16_t i = 0; i < WHEEL_SLOTS; i++, time++) {
+    // Stop at the next cascade, items from higher levels may end up in the lowest level there
+    if (i != 0 && (time & WHEEL_MASK) == 0)
+      break;
+    if (this->heads_[time & WHEEL_MASK] != INVALID_INDEX)
+      break;
+  }
+  if (int32_t(time - now) <= 0)
+    return 0;
+  return time - now;
+}
+void ICACHE_RAM_ATTR HOT Scheduler::call() {
+  const uint32_t now = millis();
+  this->advance_(now);
+
+  // Only run the items that are due right now, items deferred by the callbacks run in the next call.
+  uint16_t index = this->heads_[LIST_DUE];
+  this->heads_[LIST_BATCH] = index;
+  this->heads_[LIST_DUE] = INVALID_INDEX;
+  this->due_tail_ = INVALID_INDEX;
+  while (index != INVALID_INDEX) {
+    SchedulerItem *item = this->item_(index);
+    item->list = LIST_BATCH;
+    index = item->next;
+  }
+
+  while (this->heads_[LIST_BATCH] != INVALID_INDEX) {
+    index = this->heads_[LIST_BATCH];
+    this->unlink_(index);
+    // The pool is allocated in chunks, so this pointer stays valid even if f() schedules new items.
+    SchedulerItem *item = this->item_(index);
+
+    // Don't run on failed components
+    if (item->component != nullptr && item->component->is_failed()) {
+      this->release_(index);
+      continue;
+    }
+
+#ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
+    const char *type = item->type == SchedulerItem::INTERVAL ? "interval" : "timeout";
+    ESP_LOGVV(TAG, "Running %s '%s' with interval=%u last_execution=%u (now=%u)", type, item->name.c_str(),
+              item->interval, item->last_execution, now);
+#endif
+
+    // While f() runs the item is in no list, but can still be found through its name or handle.
+    // If it gets cancelled during the call it is only marked for removal.
+#ifdef USE_PROFILER
+    ComponentProfile *previous = global_profiler.enter(item->component);
+    const uint32_t start = micros();
+    item->f();
+    global_profiler.record_scheduler(item->component, item->name, item->name_hash, micros() - start);
+    global_profiler.leave(previous);
+#else
+    item->f();
+#endif
+
+    if (item->remove || item->type == SchedulerItem::TIMEOUT) {
+      this->release_(index);
+      continue;
+    }
+
+    if (item->interval != 0) {
+      const uint32_t amount = (now - item->last_execution) / item->interval;
+      item->last_execution += amount * item->interval;
+    }
+    this->insert_(index);
+  }
+}
+void HOT Scheduler::process_to_add() {
+  // Items are inserted into the wheel directly, nothing to do here.
+}
+SchedulerHandle HOT Scheduler::schedule_(Component *component, const std::string &name, SchedulerItem::Type type,
+                                         uint32_t interval, uint32_t last_execution, std::function<void()> &&func) {
+  if (this->wheel_count_ == 0 && int32_t(millis() - this->wheel_time_) > 0) {
+    // Nothing in the wheel, it is safe to skip ahead without processing the passed ticks.
+    this->wheel_time_ = millis();
+  }
+
+  const uint16_t index = this->allocate_();
+  if (index == INVALID_INDEX) {
+    ESP_LOGE(TAG, "Scheduler pool exhausted, dropping '%s'!", name.c_str());
+    return 0;
+  }
+  SchedulerItem *item = this->item_(index);
+  item->component = component;
+  item->name = name;
+  item->type = type;
+  item->remove = false;
+  item->interval = interval;
+  item->last_execution = last_execution;
+  item->f = std::move(func);
+  if (!name.empty()) {
+    item->name_hash = fnv1_hash(name);
+    this->index_add_(index);
+  } else {
+    item->name_hash = 0;
+  }
+  this->insert_(index);
+  return this->make_handle_(index);
+}
+uint16_t HOT Scheduler::allocate_() {
+  if (this->free_head_ == INVALID_INDEX) {
+    this->reserve(this->capacity_ + CHUNK_SIZE);
+    if (this->free_head_ == INVALID_INDEX)
+      return INVALID_INDEX;
+  }
+  const uint16_t index = this->free_head_;
+  this->free_head_ = this->item_(index)->next;
+  return index;
+}
+void HOT Scheduler::release_(uint16_t index) {
+  SchedulerItem *item = this->item_(index);
+  if (!item->name.empty()) {
+    this->index_remove_(index);
+    // clear() keeps the allocated capacity, so re-using this item for a similar name won't allocate.
+    item->name.clear();
+  }
+  item->f = nullptr;
+  item->remove = false;
+  item->generation++;
+  item->list = LIST_NONE;
+  item->next = this->free_head_;
+  this->free_head_ = index;
+}
+void HOT Scheduler::link_(uint16_t list, uint16_t index) {
+  SchedulerItem *item = this->item_(index);
+  item->list = list;
+  if (list == LIST_DUE) {
+    item->prev = this->due_tail_;
+    item->next = INVALID_INDEX;
+    if (this->due_tail_ == INVALID_INDEX) {
+      this->heads_[list] = index;
+    } else {
+      this->item_(this->due_tail_)->next = index;
+    }
+    this->due_tail_ = index;
+    return;
+  }
+
+  item->prev = INVALID_INDEX;
+  item->next = this->heads_[list];
+  if (item->next != INVALID_INDEX)
+    this->item_(item->next)->prev = index;
+  this->heads_[list] = index;
+  if (list < LIST_DUE)
+    this->wheel_count_++;
+}
+void HOT Scheduler::unlink_(uint16_t index) {
+  SchedulerItem *item = this->item_(index);
+  const uint16_t list = item->list;
+  if (item->prev == INVALID_INDEX) {
+    this->heads_[list] = item->next;
+  } else {
+    this->item_(item->prev)->next = item->next;
+  }
+  if (item->next != INVALID_INDEX)
+    this->item_(item->next)->prev = item->prev;
+  if (list == LIST_DUE && this->due_tail_ == index)
+    this->due_tail_ = item->prev;
+  if (list < LIST_DUE)
+    this->wheel_count_--;
+  item->list = LIST_NONE;
+}
+void HOT Scheduler::insert_(uint16_t index) {
+  SchedulerItem *item = this->item_(index);
+  uint32_t expires = item->next_execution();
+  if (item->type == SchedulerItem::INTERVAL)
+    expires += this->slack_delay_(expires, item->interval);
+  const int32_t delta = int32_t(expires - this->wheel_time_);
+  if (item->interval == 0 || delta <= 0) {
+    this->link_(LIST_DUE, index);
+    return;
+  }
+
+  uint32_t udelta = delta;
+  if (udelta > WHEEL_MAX_DELTA) {
+    // Too far in the future, park in the last level and re-cascade once reached.
+    udelta = WHEEL_MAX_DELTA;
+    expires = this->wheel_time_ + udelta;
+  }
+  uint8_t level = 0;
+  while (level + 1 < WHEEL_LEVELS && udelta >= (1UL << (WHEEL_BITS * (level + 1))))
+    level++;
+  const uint16_t slot = (expires >> (WHEEL_BITS * level)) & WHEEL_MASK;
+  this->link_(level * WHEEL_SLOTS + slot, index);
+}
+void HOT Scheduler::cascade_(uint8_t level) {
+  const uint16_t list = level * WHEEL_SLOTS + ((this->wheel_time_ >> (WHEEL_BITS * level)) & WHEEL_MASK);
+  while (this->heads_[list] != INVALID_INDEX) {
+    const uint16_t index = this->heads_[list];
+    this->unlink_(index);
+    this->insert_(index);
+  }
+}
+void HOT Scheduler::advance_(uint32_t now) {
+  while (int32_t(now - this->wheel_time_) >= 0) {
+    if (this->wheel_count_ == 0) {
+      this->wheel_time_ = now + 1;
+      return;
+    }
+    if ((this->wheel_time_ & WHEEL_MASK) == 0) {
+      for (uint8_t level = 1; level < WHEEL_LEVELS; level++) {
+        this->cascade_(level);
+        if (((this->wheel_time_ >> (WHEEL_BITS * level)) & WHEEL_MASK) != 0)
+          break;
+      }
+    }
+    const uint16_t list = this->wheel_time_ & WHEEL_MASK;
+    while (this->heads_[list] != INVALID_INDEX) {
+      const uint16_t index = this->heads_[list];
+      this->unlink_(index);
+      this->link_(LIST_DUE, index);
+    }
+    this->wheel_time_++;
+  }
+}
+uint32_t Scheduler::index_key_(Component *component, uint32_t name_hash, SchedulerItem::Type type) const {
+  return name_hash ^ (reinterpret_cast<uintptr_t>(component) * 2654435761UL) ^ type;
+}
+void HOT Scheduler::index_add_(uint16_t index) {
+  SchedulerItem *item = this->item_(index);
+  const uint32_t bucket =
+      this->index_key_(item->component, item->name_hash, item->type) & (this->name_buckets_.size() - 1);
+  item->name_next = this->name_buckets_[bucket];
+  this->name_buckets_[bucket] = index;
+}
+void HOT Scheduler::index_remove_(uint16_t index) {
+  SchedulerItem *item = this->item_(index);
+  const uint32_t bucket =
+      this->index_key_(item->component, item->name_hash, item->type) & (this->name_buckets_.size() - 1);
+  uint16_t *link = &this->name_buckets_[bucket];
+  while (*link != INVALID_INDEX) {
+    if (*link == index) {
+      *link = item->name_next;
+      return;
+    }
+    link = &this->item_(*link)->name_next;
+  }
+}
+void Scheduler::index_rehash_() {
+  size_t size = 16;
+  while (size < this->capacity_)
+    size <<= 1;
+  this->name_buckets_.assign(size, uint16_t(INVALID_INDEX));
+  for (uint16_t i = 0; i < this->capacity_; i++) {
+    if (!this->item_(i)->name.empty())
+      this->index_add_(i);
+  }
+}
+bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type) {
+  if (name.empty() || this->name_buckets_.empty())
+    return false;
+
+  const uint32_t name_hash = fnv1_hash(name);
+  const uint32_t bucket = this->index_key_(component, name_hash, type) & (this->name_buckets_.size() - 1);
+  bool ret = false;
+  uint16_t index = this->name_buckets_[bucket];
+  while (index != INVALID_INDEX) {
+    SchedulerItem *item = this->item_(index);
+    const uint16_t next = item->name_next;
+    if (!item->remove && item->component == component && item->type == type && item->name_hash == name_hash &&
+        item->name == name) {
+      this->cancel_index_(index);
+      ret = true;
+    }
+    index = next;
+  }
+  return ret;
+}
+void HOT Scheduler::cancel_index_(uint16_t index) {
+  SchedulerItem *item = this->item_(index);
+  if (item->list == LIST_NONE) {
+    // Currently running, the item is released after the call
+    item->remove = true;
+    return;
+  }
+  this->unlink_(index);
+  this->release_(index);
+}
+
+#endif  // USE_SCHEDULER_TIMER_WHEEL
+
 }  // namespace esphome
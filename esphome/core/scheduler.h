@@ -1,6 +1,8 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -8,13 +10,43 @@ namespace esphome {
 
 class Component;
 
+/// Opaque reference to a scheduled timeout/interval returned by the Scheduler. 0 is never a valid handle.
+using SchedulerHandle = uint32_t;
+
+/** The scheduler runs the timeouts and intervals registered by components from the main loop.
+ *
+ * Two backends are available, selected at compile time:
+ *  - The default binary heap of individually allocated items.
+ *  - A hierarchical timing wheel (USE_SCHEDULER_TIMER_WHEEL) with a pool of pre-allocated items,
+ *    O(1) insertion and O(1) cancellation, both by handle and by name (through a hashed index).
+ */
 class Scheduler {
  public:
-  void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
+#ifdef USE_SCHEDULER_TIMER_WHEEL
+  Scheduler();
+#endif
+
+  SchedulerHandle set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                              std::function<void()> &&func);
   bool cancel_timeout(Component *component, const std::string &name);
-  void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> &&func);
+  SchedulerHandle set_interval(Component *component, const std::string &name, uint32_t interval,
+                               std::function<void()> &&func);
   bool cancel_interval(Component *component, const std::string &name);
 
+  /// Cancel a timeout or interval by the handle returned when it was scheduled.
+  bool cancel(SchedulerHandle handle);
+
+  /// Pre-allocate storage for the given number of scheduler items (only has an effect for the timer wheel).
+  void reserve(size_t count);
+
+  /** Allow intervals to run up to this many milliseconds late, so that intervals due close together share a wakeup.
+   *
+   * The deadlines of intervals are moved to the end of the slack window they fall in, every interval due within
+   * the same window runs in the same loop iteration. An interval is never delayed by more than a quarter of its
+   * period. Timeouts are not affected.
+   */
+  void set_slack(uint32_t slack) { this->slack_ = slack; }
+
   optional<uint32_t> next_schedule_in();
 
   void call();
@@ -22,20 +54,28 @@ class Scheduler {
   void process_to_add();
 
  protected:
+#ifndef USE_SCHEDULER_TIMER_WHEEL
   struct SchedulerItem {
     Component *component;
     std::string name;
+#ifdef USE_PROFILER
+    /// Identifies the profile of this item without hashing the name after every run.
+    uint32_t name_hash;
+#endif
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
       uint32_t timeout;
     };
     uint32_t last_execution;
+    /// How long the run after last_execution is delayed to the end of its slack window.
+    uint32_t slack_delay;
     std::function<void()> f;
+    SchedulerHandle handle;
     bool remove;
     uint8_t last_execution_major;
 
-    inline uint32_t next_execution() { return this->last_execution + this->timeout; }
+    inline uint32_t next_execution() { return this->last_execution + this->timeout + this->slack_delay; }
     inline uint8_t next_execution_major() {
       uint32_t next_exec = this->next_execution();
       uint8_t next_exec_major = this->last_execution_major;
@@ -48,6 +88,11 @@ class Scheduler {
   };
 
   uint32_t millis_();
+  void align_(SchedulerItem *item) {
+    item->slack_delay = item->type == SchedulerItem::INTERVAL
+                            ? this->slack_delay_(item->last_execution + item->interval, item->interval)
+                            : 0;
+  }
   void cleanup_();
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
@@ -62,6 +107,86 @@ class Scheduler {
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
+  SchedulerHandle last_handle_{0};
+#else
+  /// Number of bits (slots) per wheel level.
+  static const uint8_t WHEEL_BITS = 6;
+  static const uint16_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+  static const uint16_t WHEEL_MASK = WHEEL_SLOTS - 1;
+  /// 5 levels of 64 slots with a resolution of 1ms cover 2^30ms (~12 days), longer delays are re-cascaded.
+  static const uint8_t WHEEL_LEVELS = 5;
+  static const uint32_t WHEEL_MAX_DELTA = (1UL << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+  /// Items are allocated in chunks so that pointers to them stay valid while the pool grows.
+  static const uint8_t CHUNK_BITS = 4;
+  static const uint16_t CHUNK_SIZE = 1 << CHUNK_BITS;
+  static const uint16_t INVALID_INDEX = 0xFFFF;
+  /// Special list ids in addition to the wheel slots.
+  static const uint16_t LIST_DUE = WHEEL_LEVELS * WHEEL_SLOTS;
+  static const uint16_t LIST_BATCH = LIST_DUE + 1;
+  static const uint16_t LIST_COUNT = LIST_BATCH + 1;
+  static const uint16_t LIST_NONE = 0xFFFF;
+
+  struct SchedulerItem {
+    Component *component;
+    std::string name;
+    uint32_t name_hash;
+    enum Type : uint8_t { TIMEOUT, INTERVAL } type;
+    bool remove;
+    /// Generation counter, incremented every time this item is released to detect stale handles.
+    uint16_t generation;
+    uint32_t interval;
+    uint32_t last_execution;
+    std::function<void()> f;
+    /// Intrusive doubly-linked list for the wheel slot this item is in (indices into the pool).
+    uint16_t prev;
+    uint16_t next;
+    uint16_t list;
+    /// Singly-linked chain in the name hash index.
+    uint16_t name_next;
+
+    inline uint32_t next_execution() const { return this->last_execution + this->interval; }
+  };
+
+  SchedulerItem *item_(uint16_t index) { return &this->chunks_[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)]; }
+  uint16_t allocate_();
+  void release_(uint16_t index);
+  void link_(uint16_t list, uint16_t index);
+  void unlink_(uint16_t index);
+  void insert_(uint16_t index);
+  void cascade_(uint8_t level);
+  void advance_(uint32_t now);
+  uint32_t index_key_(Component *component, uint32_t name_hash, SchedulerItem::Type type) const;
+  void index_add_(uint16_t index);
+  void index_remove_(uint16_t index);
+  void index_rehash_();
+  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  void cancel_index_(uint16_t index);
+  SchedulerHandle make_handle_(uint16_t index) {
+    return (uint32_t(this->item_(index)->generation) << 16) | (uint32_t(index) + 1);
+  }
+  SchedulerHandle schedule_(Component *component, const std::string &name, SchedulerItem::Type type,
+                            uint32_t interval, uint32_t last_execution, std::function<void()> &&func);
+
+  std::vector<std::unique_ptr<SchedulerItem[]>> chunks_;
+  uint16_t free_head_{INVALID_INDEX};
+  uint16_t capacity_{0};
+  /// Heads of the wheel slot lists followed by the due and batch lists.
+  uint16_t heads_[LIST_COUNT];
+  /// The due list is kept in FIFO order so that deferred calls run in the order they were scheduled.
+  uint16_t due_tail_{INVALID_INDEX};
+  /// Number of items in the wheel slots (excluding the due/batch lists).
+  uint16_t wheel_count_{0};
+  std::vector<uint16_t> name_buckets_;
+  /// The next wheel tick (in ms) that has not been processed yet.
+  uint32_t wheel_time_{0};
+#endif
+
+  uint32_t slack_delay_(uint32_t deadline, uint32_t interval) const {
+    const uint32_t window = std::min(this->slack_, interval / 4);
+    return window < 2 ? 0 : (window - deadline % window) % window;
+  }
+
+  uint32_t slack_{0};
 };
 
 }  // namespace esphome
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace esphome {
+
+/** A fixed-size lock-free queue with a single producer and a single consumer.
+ *
+ * The slots are allocated once with the queue and reused, so items that own memory (like std::string) keep their
+ * capacity across pushes. Exactly one task may call the producer methods (slot_to_push()/push()) and exactly one other
+ * task the consumer methods (front()/pop()), each side only writes its own index.
+ *
+ * @tparam T The type of the items.
+ * @tparam N The number of slots, one of them always stays empty to tell a full queue from an empty one.
+ */
+template<typename T, size_t N> class SPSCQueue {
+ public:
+  /// The slot the next item has to be written to before push(), nullptr if the queue is full.
+  T *slot_to_push() {
+    const size_t head = this->head_.load(std::memory_order_relaxed);
+    if (next_(head) == this->tail_.load(std::memory_order_acquire))
+      return nullptr;
+    return &this->slots_[head];
+  }
+  /// Publish the item written to slot_to_push() to the consumer.
+  void push() { this->head_.store(next_(this->head_.load(std::memory_order_relaxed)), std::memory_order_release); }
+  /// Move item into the queue, returns false if the queue is full.
+  bool push(T &&item) {
+    T *slot = this->slot_to_push();
+    if (slot == nullptr)
+      return false;
+    *slot = std::move(item);
+    this->push();
+    return true;
+  }
+
+  /// The oldest item, nullptr if the queue is empty.
+  T *front() {
+    const size_t tail = this->tail_.load(std::memory_order_relaxed);
+    if (tail == this->head_.load(std::memory_order_acquire))
+      return nullptr;
+    return &this->slots_[tail];
+  }
+  /// Release the item returned by front() to the producer.
+  void pop() { this->tail_.store(next_(this->tail_.load(std::memory_order_relaxed)), std::memory_order_release); }
+
+  bool empty() const {
+    return this->tail_.load(std::memory_order_relaxed) == this->head_.load(std::memory_order_acquire);
+  }
+
+ protected:
+  static size_t next_(size_t index) { return index + 1 == N ? 0 : index + 1; }
+
+  T slots_[N]{};
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+};
+
+}  // namespace esphome
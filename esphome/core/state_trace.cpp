@@ -0,0 +1,53 @@
+#include "esphome/core/state_trace.h"
+
+#ifdef USE_STATE_TRACE
+
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+
+static uint8_t current_index() {
+#ifdef USE_DUAL_CORE
+  return App.is_network_task() ? 1 : 0;
+#else
+  return 0;
+#endif
+}
+
+StateTrace HOT StateTracer::begin() {
+  // 0 marks no trace, skip it when wrapping around
+  if (++this->last_id_ == 0)
+    this->last_id_ = 1;
+  return StateTrace{this->last_id_, micros()};
+}
+StateTrace HOT StateTracer::get_current() const { return this->current_[current_index()]; }
+StateTrace HOT StateTracer::set_current(StateTrace trace) {
+  StateTrace &current = this->current_[current_index()];
+  const StateTrace previous = current;
+  current = trace;
+  return previous;
+}
+void HOT StateTracer::record(StateTraceStage stage, StateTrace trace) {
+  if (trace.id == 0)
+    return;
+  this->stages_[stage].record(micros() - trace.start_us);
+}
+const char *StateTracer::get_stage_name(StateTraceStage stage) {
+  switch (stage) {
+    case STATE_TRACE_FILTERED:
+      return "Filtered";
+    case STATE_TRACE_CONTROLLER:
+      return "Controller";
+    case STATE_TRACE_SENT:
+      return "Sent";
+    default:
+      return "Unknown";
+  }
+}
+
+StateTracer global_state_tracer;  // NOLINT
+
+}  // namespace esphome
+
+#endif  // USE_STATE_TRACE
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "esphome/core/profiler.h"
+
+#ifdef USE_STATE_TRACE
+
+namespace esphome {
+
+/// The stages of a sensor state on its way to the network, all measured from the call to publish_state().
+enum StateTraceStage : uint8_t {
+  /// The state came out of the filter chain.
+  STATE_TRACE_FILTERED = 0,
+  /// A controller (the native API or MQTT) got the state, after the dual_core queue and coalescing.
+  STATE_TRACE_CONTROLLER,
+  /// The state was written to a connection.
+  STATE_TRACE_SENT,
+  STATE_TRACE_STAGE_COUNT,
+};
+
+/// A raw sensor state that is being traced, id 0 means that there is none.
+struct StateTrace {
+  uint32_t id;
+  uint32_t start_us;
+};
+
+/** Records how long sensor states take from publish_state() through the filters and controllers to the network.
+ *
+ * Enabled with the trace_state_latency option of the debug component, which logs the per-stage histograms.
+ *
+ * Sensor::publish_state() starts a trace, which is kept with the sensor for filters that output later. While the
+ * state callbacks run the trace is the current one, the controllers pick it up from there and carry it along
+ * where they defer the state (the dual_core queue, coalescing in the native API).
+ */
+class StateTracer {
+ public:
+  /// Start tracing a new raw state.
+  StateTrace begin();
+  /// The trace of the state whose callbacks are running in the calling task.
+  StateTrace get_current() const;
+  /// Make the trace the current one of the calling task, returns the previous one to restore afterwards.
+  StateTrace set_current(StateTrace trace);
+  /// Record that the state reached the stage, traces with an id of 0 are ignored.
+  void record(StateTraceStage stage, StateTrace trace);
+  /// Record the stage for the current trace of the calling task.
+  void record_current(StateTraceStage stage) { this->record(stage, this->get_current()); }
+
+  /// Each stage is only recorded from one task, the loop task or the network task of the dual_core option.
+  ProfilerStats &get_stage(StateTraceStage stage) { return this->stages_[stage]; }
+  static const char *get_stage_name(StateTraceStage stage);
+
+ protected:
+  uint32_t last_id_{0};
+#ifdef USE_DUAL_CORE
+  /// Loop task and network task.
+  StateTrace current_[2]{};
+#else
+  StateTrace current_[1]{};
+#endif
+  ProfilerStats stages_[STATE_TRACE_STAGE_COUNT];
+};
+
+extern StateTracer global_state_tracer;
+
+}  // namespace esphome
+
+#endif  // USE_STATE_TRACE
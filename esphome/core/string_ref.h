@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+
+namespace esphome {
+
+/** A non-owning reference to a null-terminated string, a minimal std::string_view for C++11.
+ *
+ * Converts implicitly to std::string so that existing callers keep working, but only copies when they need to.
+ * The referenced string must outlive the StringRef.
+ */
+class StringRef {
+ public:
+  StringRef() : str_(""), len_(0) {}
+  StringRef(const char *str) : str_(str), len_(strlen(str)) {}  // NOLINT
+  StringRef(const char *str, size_t len) : str_(str), len_(len) {}
+  StringRef(const std::string &str) : str_(str.c_str()), len_(str.size()) {}  // NOLINT
+
+  const char *c_str() const { return this->str_; }
+  const char *data() const { return this->str_; }
+  size_t size() const { return this->len_; }
+  size_t length() const { return this->len_; }
+  bool empty() const { return this->len_ == 0; }
+  const char *begin() const { return this->str_; }
+  const char *end() const { return this->str_ + this->len_; }
+  char operator[](size_t pos) const { return this->str_[pos]; }
+
+  std::string str() const { return std::string(this->str_, this->len_); }
+  operator std::string() const { return this->str(); }  // NOLINT
+
+ protected:
+  const char *str_;
+  size_t len_;
+};
+
+inline bool operator==(const StringRef &a, const StringRef &b) {
+  return a.size() == b.size() && memcmp(a.c_str(), b.c_str(), a.size()) == 0;
+}
+inline bool operator==(const StringRef &a, const std::string &b) { return a == StringRef(b); }
+inline bool operator==(const std::string &a, const StringRef &b) { return StringRef(a) == b; }
+inline bool operator==(const StringRef &a, const char *b) { return a == StringRef(b); }
+inline bool operator==(const char *a, const StringRef &b) { return StringRef(a) == b; }
+inline bool operator!=(const StringRef &a, const StringRef &b) { return !(a == b); }
+inline bool operator!=(const StringRef &a, const std::string &b) { return !(a == b); }
+inline bool operator!=(const std::string &a, const StringRef &b) { return !(a == b); }
+inline bool operator!=(const StringRef &a, const char *b) { return !(a == b); }
+inline bool operator!=(const char *a, const StringRef &b) { return !(a == b); }
+
+inline std::string &operator+=(std::string &a, const StringRef &b) { return a.append(b.c_str(), b.size()); }
+inline std::string operator+(const std::string &a, const StringRef &b) {
+  std::string ret;
+  ret.reserve(a.size() + b.size());
+  ret.append(a).append(b.c_str(), b.size());
+  return ret;
+}
+inline std::string operator+(const StringRef &a, const std::string &b) {
+  std::string ret;
+  ret.reserve(a.size() + b.size());
+  ret.append(a.c_str(), a.size()).append(b);
+  return ret;
+}
+inline std::string operator+(const char *a, const StringRef &b) { return std::string(a) + b; }
+inline std::string operator+(const StringRef &a, const char *b) { return a + std::string(b); }
+
+}  // namespace esphome
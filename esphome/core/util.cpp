@@ -17,11 +17,13 @@
 #endif
 
 #ifdef ARDUINO_ARCH_ESP32
-#include <ESPmDNS.h>
+#include <WiFi.h>
 #endif
 #ifdef ARDUINO_ARCH_ESP8266
-#include <ESP8266mDNS.h>
+#include <ESP8266WiFi.h>
 #endif
+#include <WiFiUdp.h>
+#include "esphome/core/mdns_responder.h"
 
 namespace esphome {
 
@@ -39,64 +41,143 @@ bool network_is_connected() {
   return false;
 }
 
-#ifdef ARDUINO_ARCH_ESP8266
-bool mdns_setup;
+void network_mark_activity() {
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component != nullptr)
+    wifi::global_wifi_component->mark_activity();
 #endif
+}
+
+void network_report_round_trip_time(uint32_t round_trip_time) {
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component != nullptr)
+    wifi::global_wifi_component->report_round_trip_time(round_trip_time);
+#endif
+}
 
 #ifndef WEBSERVER_PORT
 static const uint8_t WEBSERVER_PORT = 80;
 #endif
 
+static const char *TAG = "mdns";
+
+static const uint16_t MDNS_PORT = 5353;
+/// A flood of queries doesn't block the loop for longer than this many answers.
+static const uint8_t MDNS_MAX_QUERIES_PER_LOOP = 8;
+
+static MDNSResponder mdns_responder;  // NOLINT
+static WiFiUDP mdns_udp;              // NOLINT
+/// The address the responder listens on, 0.0.0.0 while it doesn't.
+static IPAddress mdns_address;  // NOLINT
+/// Longer queries are cut off, only their last known answers get lost.
+static uint8_t mdns_buffer[512];  // NOLINT
+
+static IPAddress network_get_ip_address() {
+#ifdef USE_ETHERNET
+  if (ethernet::global_eth_component != nullptr)
+    return ethernet::global_eth_component->get_ip_address();
+#endif
+#ifdef USE_WIFI
+  if (wifi::global_wifi_component != nullptr)
+    return wifi::global_wifi_component->get_ip_address();
+#endif
+  return {};
+}
+
+static void mdns_begin_multicast_packet() {
 #ifdef ARDUINO_ARCH_ESP8266
-void network_setup_mdns(IPAddress address, int interface) {
-  // Latest arduino framework breaks mDNS for AP interface
-  // see https://github.com/esp8266/Arduino/issues/6114
-  if (interface == 1)
-    return;
-  MDNS.begin(App.get_name().c_str(), address);
-  mdns_setup = true;
+  mdns_udp.beginPacketMulticast(IPAddress(224, 0, 0, 251), MDNS_PORT, mdns_address, 255);
 #endif
 #ifdef ARDUINO_ARCH_ESP32
-  void network_setup_mdns() {
-    MDNS.begin(App.get_name().c_str());
+  mdns_udp.beginMulticastPacket();
 #endif
+}
+
+void network_setup_mdns() {
+  mdns_responder.set_hostname(App.get_name());
 #ifdef USE_API
-    if (api::global_api_server != nullptr) {
-      MDNS.addService("esphomelib", "tcp", api::global_api_server->get_port());
-      // DNS-SD (!=mDNS !) requires at least one TXT record for service discovery - let's add version
-      MDNS.addServiceTxt("esphomelib", "tcp", "version", ESPHOME_VERSION);
-      MDNS.addServiceTxt("esphomelib", "tcp", "address", network_get_address().c_str());
-      MDNS.addServiceTxt("esphomelib", "tcp", "mac", get_mac_address().c_str());
-    } else {
-#endif
-      // Publish "http" service if not using native API nor the webserver component
-      // This is just to have *some* mDNS service so that .local resolution works
-      MDNS.addService("http", "tcp", WEBSERVER_PORT);
-      MDNS.addServiceTxt("http", "tcp", "version", ESPHOME_VERSION);
+  if (api::global_api_server != nullptr) {
+    // DNS-SD (!=mDNS !) requires at least one TXT record for service discovery - let's add version
+    mdns_responder.add_service("esphomelib", "tcp", api::global_api_server->get_port(),
+                               {"version=" ESPHOME_VERSION, "address=" + network_get_address(),
+                                "mac=" + get_mac_address()});
+  } else {
+#endif
+    // Publish "http" service if not using native API nor the webserver component
+    // This is just to have *some* mDNS service so that .local resolution works
+    mdns_responder.add_service("http", "tcp", WEBSERVER_PORT, {"version=" ESPHOME_VERSION});
 #ifdef USE_API
-    }
+  }
 #endif
 #ifdef USE_PROMETHEUS
-    MDNS.addService("prometheus-http", "tcp", WEBSERVER_PORT);
+  mdns_responder.add_service("prometheus-http", "tcp", WEBSERVER_PORT, {});
 #endif
-  }
-  void network_tick_mdns() {
+}
+
+void network_tick_mdns() {
+  const IPAddress address = network_get_ip_address();
+  const uint32_t now = millis();
+  if (uint32_t(address) != uint32_t(mdns_address)) {
+    mdns_udp.stop();
+    mdns_address = address;
+    if (uint32_t(address) == 0)
+      return;
 #ifdef ARDUINO_ARCH_ESP8266
-    if (mdns_setup)
-      MDNS.update();
+    const bool started = mdns_udp.beginMulticast(address, IPAddress(224, 0, 0, 251), MDNS_PORT) != 0;
+#endif
+#ifdef ARDUINO_ARCH_ESP32
+    const bool started = mdns_udp.beginMulticast(IPAddress(224, 0, 0, 251), MDNS_PORT) != 0;
 #endif
+    if (!started) {
+      ESP_LOGW(TAG, "Joining the mDNS group failed");
+      mdns_address = IPAddress();
+      return;
+    }
+    const uint8_t bytes[4] = {address[0], address[1], address[2], address[3]};
+    mdns_responder.set_address(bytes, now);
   }
+  if (uint32_t(mdns_address) == 0)
+    return;
 
-  std::string network_get_address() {
+  for (uint8_t i = 0; i < MDNS_MAX_QUERIES_PER_LOOP; i++) {
+    if (mdns_udp.parsePacket() <= 0)
+      break;
+    const int size = mdns_udp.read(mdns_buffer, sizeof(mdns_buffer));
+    if (size <= 0)
+      continue;
+    const bool legacy = mdns_udp.remotePort() != MDNS_PORT;
+    bool unicast;
+    const size_t len = mdns_responder.answer(mdns_buffer, size, sizeof(mdns_buffer), uint32_t(mdns_udp.remoteIP()),
+                                             legacy, now, &unicast);
+    if (len == 0)
+      continue;
+    if (unicast) {
+      mdns_udp.beginPacket(mdns_udp.remoteIP(), mdns_udp.remotePort());
+    } else {
+      mdns_begin_multicast_packet();
+    }
+    mdns_udp.write(mdns_buffer, len);
+    mdns_udp.endPacket();
+  }
+
+  size_t len;
+  while ((len = mdns_responder.announce(mdns_buffer, sizeof(mdns_buffer), now)) != 0) {
+    mdns_begin_multicast_packet();
+    mdns_udp.write(mdns_buffer, len);
+    mdns_udp.endPacket();
+  }
+}
+
+std::string network_get_address() {
 #ifdef USE_ETHERNET
-    if (ethernet::global_eth_component != nullptr)
-      return ethernet::global_eth_component->get_use_address();
+  if (ethernet::global_eth_component != nullptr)
+    return ethernet::global_eth_component->get_use_address();
 #endif
 #ifdef USE_WIFI
-    if (wifi::global_wifi_component != nullptr)
-      return wifi::global_wifi_component->get_use_address();
+  if (wifi::global_wifi_component != nullptr)
+    return wifi::global_wifi_component->get_use_address();
 #endif
-    return "";
-  }
+  return "";
+}
 
 }  // namespace esphome
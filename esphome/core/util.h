@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include "IPAddress.h"
 
@@ -9,14 +10,14 @@ namespace esphome {
 bool network_is_connected();
 /// Get the active network hostname
 std::string network_get_address();
+/// Signal traffic of a protocol, so an adaptive power save mode keeps the radio awake. Can be called from any task.
+void network_mark_activity();
+/// Report the round trip time of a request of a protocol in ms, for the diagnostics of the power save mode.
+void network_report_round_trip_time(uint32_t round_trip_time);
 
 /// Manually set up the network stack (outside of the App.setup() loop, for example in OTA safe mode)
-#ifdef ARDUINO_ARCH_ESP8266
-void network_setup_mdns(IPAddress address, int interface);
-#endif
-#ifdef ARDUINO_ARCH_ESP32
 void network_setup_mdns();
-#endif
+/// Answer mDNS queries and send the announcements that are due, follows changes of the IP address.
 void network_tick_mdns();
 
 }  // namespace esphome
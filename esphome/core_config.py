@@ -10,8 +10,11 @@ from esphome.const import CONF_ARDUINO_VERSION, CONF_BOARD, CONF_BOARD_FLASH_MOD
     CONF_NAME, CONF_ON_BOOT, CONF_ON_LOOP, CONF_ON_SHUTDOWN, CONF_PLATFORM, \
     CONF_PLATFORMIO_OPTIONS, CONF_PRIORITY, CONF_TRIGGER_ID, \
     CONF_ESP8266_RESTORE_FROM_FLASH, ARDUINO_VERSION_ESP8266, \
-    ARDUINO_VERSION_ESP32, ESP_PLATFORMS
-from esphome.core import CORE, coroutine_with_priority
+    ARDUINO_VERSION_ESP32, ESP_PLATFORMS, CONF_SCHEDULER, CONF_TYPE, CONF_POOL_SIZE, CONF_SLACK, \
+    CONF_EVENT_DRIVEN_LOOP, CONF_MAX_LOOP_SLEEP, CONF_SPLIT_SETUP, CONF_DUAL_CORE, \
+    CONF_PSRAM
+from esphome.core import CORE, coroutine_with_priority, TimePeriod
+from esphome.cpp_generator import CallExpression
 from esphome.helpers import copy_file_if_changed, walk_files
 
 _LOGGER = logging.getLogger(__name__)
@@ -83,6 +86,15 @@ def default_build_path():
     return CORE.name
 
 
+SCHEDULER_TYPES = ['heap', 'timer_wheel']
+
+SCHEDULER_SCHEMA = cv.Schema({
+    cv.Optional(CONF_TYPE, default='heap'): cv.one_of(*SCHEDULER_TYPES, lower=True),
+    cv.Optional(CONF_POOL_SIZE, default=32): cv.int_range(min=0, max=4096),
+    cv.Optional(CONF_SLACK, default='0ms'): cv.All(cv.positive_time_period_milliseconds,
+                                                   cv.Range(max=TimePeriod(minutes=1))),
+})
+
 VALID_INCLUDE_EXTS = {'.h', '.hpp', '.tcc', '.ino', '.cpp', '.c'}
 
 
@@ -126,6 +138,14 @@ CONFIG_SCHEMA = cv.Schema({
     }),
     cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
     cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
+    cv.Optional(CONF_SCHEDULER, default={}): SCHEDULER_SCHEMA,
+    cv.Optional(CONF_EVENT_DRIVEN_LOOP, default=False): cv.boolean,
+    cv.Optional(CONF_MAX_LOOP_SLEEP, default='1s'): cv.All(
+        cv.positive_time_period_milliseconds,
+        cv.Range(min=TimePeriod(milliseconds=16), max=TimePeriod(seconds=30))),
+    cv.Optional(CONF_SPLIT_SETUP, default=False): cv.boolean,
+    cv.Optional(CONF_DUAL_CORE): cv.All(cv.boolean, cv.only_on_esp32),
+    cv.Optional(CONF_PSRAM): cv.All(cv.boolean, cv.only_on_esp32),
 
     cv.Optional('esphome_core_version'): cv.invalid("The esphome_core_version option has been "
                                                     "removed in 1.13 - the esphome core source "
@@ -209,6 +229,49 @@ def _esp8266_add_lwip_type():
     cg.add_build_flag('-DPIO_FRAMEWORK_ARDUINO_LWIP2_HIGHER_BANDWIDTH_LOW_FLASH')
 
 
+REGISTRIES = {
+    'App.register_component': 'reserve_components',
+    'App.register_binary_sensor': 'reserve_binary_sensor',
+    'App.register_sensor': 'reserve_sensor',
+    'App.register_switch': 'reserve_switch',
+    'App.register_text_sensor': 'reserve_text_sensor',
+    'App.register_fan': 'reserve_fan',
+    'App.register_cover': 'reserve_cover',
+    'App.register_climate': 'reserve_climate',
+    'App.register_light': 'reserve_light',
+}
+
+
+def _get_app_call(statement):
+    """Return the name of the App method called by the statement, if it's such a call."""
+    expression = getattr(statement, 'expression', None)
+    call = getattr(expression, 'base', None)
+    if not isinstance(call, CallExpression):
+        return None
+    return str(call.base)
+
+
+@coroutine_with_priority(-10000.0)
+def _reserve_registries():
+    # Runs after all components, so every registration is known. The reserve calls go right after
+    # pre_setup(), before anything is registered.
+    counts = {}
+    pre_setup_index = 0
+    for i, statement in enumerate(CORE.main_statements):
+        name = _get_app_call(statement)
+        if name == 'App.pre_setup':
+            pre_setup_index = i + 1
+        elif name in REGISTRIES:
+            counts[name] = counts.get(name, 0) + 1
+
+    entities = sum(count for name, count in counts.items() if name != 'App.register_component')
+    reserves = [cg.App.reserve_entities(entities)] if entities else []
+    for name, method in REGISTRIES.items():
+        if name in counts:
+            reserves.append(getattr(cg.App, method)(counts[name]))
+    CORE.main_statements[pre_setup_index:pre_setup_index] = [cg.statement(x) for x in reserves]
+
+
 @coroutine_with_priority(30.0)
 def _add_automations(config):
     for conf in config.get(CONF_ON_BOOT, []):
@@ -233,6 +296,7 @@ def to_code(config):
     cg.add(cg.App.pre_setup(config[CONF_NAME], cg.RawExpression('__DATE__ ", " __TIME__')))
 
     CORE.add_job(_add_automations, config)
+    CORE.add_job(_reserve_registries)
 
     # Set LWIP build constants for ESP8266
     if CORE.is_esp8266:
@@ -260,5 +324,26 @@ def to_code(config):
     if config.get(CONF_ESP8266_RESTORE_FROM_FLASH, False):
         cg.add_define('USE_ESP8266_PREFERENCES_FLASH')
 
+    scheduler = config[CONF_SCHEDULER]
+    if scheduler[CONF_TYPE] == 'timer_wheel':
+        cg.add_define('USE_SCHEDULER_TIMER_WHEEL')
+    if scheduler[CONF_POOL_SIZE]:
+        cg.add(cg.App.scheduler.reserve(scheduler[CONF_POOL_SIZE]))
+    if scheduler[CONF_SLACK].total_milliseconds:
+        cg.add(cg.App.scheduler.set_slack(scheduler[CONF_SLACK]))
+
+    if config[CONF_EVENT_DRIVEN_LOOP]:
+        cg.add_define('USE_EVENT_DRIVEN_LOOP')
+        cg.add(cg.App.set_max_loop_sleep(config[CONF_MAX_LOOP_SLEEP]))
+
+    if config.get(CONF_DUAL_CORE, False):
+        # Network-facing components loop in their own task on the other core
+        cg.add_define('USE_DUAL_CORE')
+
+    if config.get(CONF_PSRAM, False):
+        # Large buffers go to PSRAM unless their component opts out, see alloc_large()
+        cg.add_build_flag('-DBOARD_HAS_PSRAM')
+        cg.add_build_flag('-mfix-esp32-psram-cache-issue')
+
     if config[CONF_INCLUDES]:
         CORE.add_job(add_includes, config[CONF_INCLUDES])
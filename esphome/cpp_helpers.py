@@ -3,9 +3,34 @@ from esphome.const import CONF_INVERTED, CONF_MODE, CONF_NUMBER, CONF_SETUP_PRIO
 # pylint: disable=unused-import
 from esphome.core import coroutine, ID, CORE, ConfigType
 from esphome.cpp_generator import RawExpression, add, get_variable
-from esphome.cpp_types import App, GPIOPin
+from esphome.cpp_types import App, GPIOPin, BufferLocation
 from esphome.util import Registry, RegistryEntry
 
+# Same as HOSTNAME_CHARACTER_ALLOWLIST in esphome/core/helpers.cpp
+OBJECT_ID_ALLOWLIST = frozenset(b'abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_')
+
+
+def entity_object_id(name):
+    """The object id that Nameable::calc_object_id_() calculates for the given name."""
+    # only ASCII is lowercased, like ::tolower() in the C locale
+    raw = name.encode('utf-8').lower().replace(b' ', b'_')
+    return bytes(c for c in raw if c in OBJECT_ID_ALLOWLIST).decode('ascii')
+
+
+def fnv1_hash(string):
+    """Same as fnv1_hash() in esphome/core/helpers.cpp, for ASCII strings."""
+    hash_ = 2166136261
+    for c in string.encode('ascii'):
+        hash_ = (hash_ * 16777619) & 0xFFFFFFFF
+        hash_ ^= c
+    return hash_
+
+
+def setup_entity_name(var, name):
+    """Set the name of a Nameable from string literals, with the object id and its hash precomputed."""
+    object_id = entity_object_id(name)
+    add(var.set_static_name(name, object_id, fnv1_hash(object_id)))
+
 
 @coroutine
 def gpio_pin_expression(conf):
@@ -50,6 +75,13 @@ def register_component(var, config):
     yield var
 
 
+def buffer_location(psram):
+    """The BufferLocation for the psram option of a component with large buffers."""
+    if psram:
+        return BufferLocation.BUFFER_LOCATION_PREFER_EXTERNAL
+    return BufferLocation.BUFFER_LOCATION_INTERNAL
+
+
 @coroutine
 def register_parented(var, value):
     if isinstance(value, ID):
@@ -29,5 +29,6 @@ JsonObject = arduino_json_ns.class_('JsonObject')
 JsonObjectRef = JsonObject.operator('ref')
 JsonObjectConstRef = JsonObjectRef.operator('const')
 Controller = esphome_ns.class_('Controller')
+BufferLocation = esphome_ns.enum('BufferLocation')
 
 GPIOPin = esphome_ns.class_('GPIOPin')
@@ -12,6 +12,7 @@ import os
 import shutil
 import subprocess
 import threading
+import time
 
 import tornado
 import tornado.concurrent
@@ -30,6 +31,7 @@ from esphome.helpers import mkdir_p, get_bool_env, run_system_command
 from esphome.storage_json import EsphomeStorageJSON, StorageJSON, \
     esphome_storage_path, ext_storage_path, trash_storage_path
 from esphome.util import shlex_quote, get_serial_ports
+from .status import AddressCache, Pinger
 from .util import password_hash
 
 # pylint: disable=unused-import, wrong-import-order
@@ -48,9 +50,13 @@ class DashboardSettings:
         self.using_password = False
         self.on_hassio = False
         self.cookie_secret = None
+        self.update_workers = 1
+        self.update_stages = '100'
 
     def parse_args(self, args):
         self.on_hassio = args.hassio
+        self.update_workers = args.update_workers
+        self.update_stages = args.update_stages
         password = args.password or os.getenv('PASSWORD', '')
         if not self.on_hassio:
             self.username = args.username or os.getenv('USERNAME', '')
@@ -308,7 +314,8 @@ class EsphomeAceEditorHandler(EsphomeCommandWebSocket):
 
 class EsphomeUpdateAllHandler(EsphomeCommandWebSocket):
     def build_command(self, json_message):
-        return ["esphome", "--dashboard", settings.config_dir, "update-all"]
+        return ["esphome", "--dashboard", settings.config_dir, "update-all",
+                "--upload-workers", str(settings.update_workers), "--stages", settings.update_stages]
 
 
 class SerialPortRequestHandler(BaseHandler):
@@ -453,6 +460,111 @@ class MainRequestHandler(BaseHandler):
                     **template_args(), login_enabled=settings.using_auth)
 
 
+# The interval of the status polls, which only run while somebody has the dashboard open
+STATUS_INTERVAL = 2.0
+# How long a request to /ping keeps the status polls running
+STATUS_REQUEST_TIMEOUT = 10.0
+# How long a status poll waits for address lookups and ping replies
+STATUS_POLL_TIMEOUT = 1.0
+
+_STATUS_TARGETS = {}  # type: dict
+
+
+def _list_status_targets():
+    """Return the node name and address of each configuration.
+
+    The storage files are only read again when they changed, so polling hundreds of nodes doesn't parse hundreds of
+    files each time.
+    """
+    targets = {}
+    for path in settings.list_yaml_files():
+        filename = os.path.basename(path)
+        try:
+            mtime = os.path.getmtime(ext_storage_path(settings.config_dir, filename))
+        except OSError:
+            mtime = None
+        target = _STATUS_TARGETS.get(filename)
+        if target is None or target[0] != mtime:
+            entry = DashboardEntry(path)
+            target = (mtime, entry.name, entry.address)
+        targets[filename] = target
+    _STATUS_TARGETS.clear()
+    _STATUS_TARGETS.update(targets)
+    return {filename: (name, address) for filename, (_, name, address) in targets.items()}
+
+
+class StatusHub:
+    """Keeps the online status of the nodes and pushes the changes to the status websockets."""
+
+    def __init__(self):
+        self.sockets = set()
+        self.last_request = -STATUS_REQUEST_TIMEOUT
+        self.io_loop = None
+        self._poll = None
+
+    def start(self, poll):
+        self.io_loop = tornado.ioloop.IOLoop.current()
+        self._poll = poll
+        tornado.ioloop.PeriodicCallback(self.tick, STATUS_INTERVAL * 1000).start()
+
+    @property
+    def active(self):
+        # Only poll if somebody has the dashboard open
+        return bool(self.sockets) or time.monotonic() - self.last_request < STATUS_REQUEST_TIMEOUT
+
+    def tick(self):
+        if self._poll is not None and self.active:
+            self._poll()
+
+    def update(self, results):
+        """Merge the results of a poll, this has to run on the IOLoop."""
+        delta = {key: value for key, value in results.items()
+                 if key not in PING_RESULT or PING_RESULT[key] != value}
+        if not delta:
+            return
+        PING_RESULT.update(delta)
+        for sock in list(self.sockets):
+            try:
+                sock.write_message({'event': 'status', 'data': delta})
+            except tornado.websocket.WebSocketClosedError:
+                self.sockets.discard(sock)
+
+    def update_threadsafe(self, results):
+        self.io_loop.add_callback(self.update, dict(results))
+
+
+class PingStatus:
+    """Pings all nodes in one batch from a shared ICMP socket, on the IOLoop."""
+
+    def __init__(self, pinger):
+        self.pinger = pinger
+        self.addresses = AddressCache()
+        self.running = False
+
+    def request(self):
+        if not self.running:
+            self.running = True
+            tornado.ioloop.IOLoop.current().spawn_callback(self._poll)
+
+    async def _poll(self):
+        try:
+            targets = _list_status_targets()
+            hosts = {address for _, address in targets.values() if address is not None}
+            resolved = await self.addresses.resolve(hosts, STATUS_POLL_TIMEOUT)
+            replied = await self.pinger.ping({ip for ip in resolved.values() if ip is not None},
+                                             STATUS_POLL_TIMEOUT)
+            results = {}
+            for filename, (_, address) in targets.items():
+                if address is None:
+                    results[filename] = None
+                elif address in resolved:
+                    # the status of nodes that are still being resolved stays as it is
+                    results[filename] = resolved[address] in replied
+            STATUS_HUB.update(results)
+        finally:
+            self.running = False
+
+
 def _ping_func(filename, address):
     if os.name == 'nt':
         command = ['ping', '-n', '1', address]
@@ -466,15 +578,11 @@ class MDNSStatusThread(threading.Thread):
     def run(self):
         zc = Zeroconf()
 
-        def on_update(dat):
-            for key, b in dat.items():
-                PING_RESULT[key] = b
-
-        stat = DashboardStatus(zc, on_update)
+        stat = DashboardStatus(zc, STATUS_HUB.update_threadsafe)
         stat.start()
         while not STOP_EVENT.is_set():
-            entries = _list_dashboard_entries()
-            stat.request_query({entry.filename: entry.name + '.local.' for entry in entries})
+            targets = _list_status_targets()
+            stat.request_query({filename: name + '.local.' for filename, (name, _) in targets.items()})
 
             PING_REQUEST.wait()
             PING_REQUEST.clear()
@@ -484,22 +592,22 @@ class MDNSStatusThread(threading.Thread):
 
 
 class PingStatusThread(threading.Thread):
+    """Pings with the ping command, for systems that don't permit ICMP sockets."""
+
     def run(self):
         pool = multiprocessing.Pool(processes=8)
         while not STOP_EVENT.is_set():
-            # Only do pings if somebody has the dashboard open
-
             def callback(ret):
-                PING_RESULT[ret[0]] = ret[1]
+                STATUS_HUB.update_threadsafe({ret[0]: ret[1]})
 
-            entries = _list_dashboard_entries()
+            targets = _list_status_targets()
             queue = collections.deque()
-            for entry in entries:
-                if entry.address is None:
-                    PING_RESULT[entry.filename] = None
+            for filename, (_, address) in targets.items():
+                if address is None:
+                    STATUS_HUB.update_threadsafe({filename: None})
                     continue
 
-                result = pool.apply_async(_ping_func, (entry.filename, entry.address),
+                result = pool.apply_async(_ping_func, (filename, address),
                                           callback=callback)
                 queue.append(result)
 
@@ -528,10 +636,26 @@ class PingStatusThread(threading.Thread):
 class PingRequestHandler(BaseHandler):
     @authenticated
     def get(self):
-        PING_REQUEST.set()
+        STATUS_HUB.last_request = time.monotonic()
         self.write(json.dumps(PING_RESULT))
 
 
+# pylint: disable=abstract-method
+class StatusWebSocket(tornado.websocket.WebSocketHandler):
+    """Sends the status of all nodes once, then only what changed."""
+
+    def open(self):
+        if not is_authenticated(self):
+            self.close()
+            return
+        STATUS_HUB.sockets.add(self)
+        self.write_message({'event': 'status', 'data': PING_RESULT})
+        STATUS_HUB.tick()
+
+    def on_close(self):
+        STATUS_HUB.sockets.discard(self)
+
+
 def is_allowed(configuration):
     return os.path.sep not in configuration
 
@@ -591,6 +715,7 @@ class UndoDeleteRequestHandler(BaseHandler):
 PING_RESULT = {}  # type: dict
 STOP_EVENT = threading.Event()
 PING_REQUEST = threading.Event()
+STATUS_HUB = StatusHub()
 
 
 class LoginHandler(BaseHandler):
@@ -717,6 +842,7 @@ def make_app(debug=False):
         (rel + "download.bin", DownloadBinaryRequestHandler),
         (rel + "serial-ports", SerialPortRequestHandler),
         (rel + "ping", PingRequestHandler),
+        (rel + "status", StatusWebSocket),
         (rel + "delete", DeleteRequestHandler),
         (rel + "undo-delete", UndoDeleteRequestHandler),
         (rel + "wizard.html", WizardRequestHandler),
@@ -758,17 +884,27 @@ def start_web_server(args):
 
             webbrowser.open(f'localhost:{args.port}')
 
-    if settings.status_use_ping:
-        status_thread = PingStatusThread()
-    else:
+    status_thread = None
+    if not settings.status_use_ping:
         status_thread = MDNSStatusThread()
-    status_thread.start()
+        STATUS_HUB.start(PING_REQUEST.set)
+    else:
+        pinger = Pinger()
+        if pinger.available:
+            STATUS_HUB.start(PingStatus(pinger).request)
+        else:
+            _LOGGER.info("Opening an ICMP socket isn't permitted, falling back to the ping command")
+            status_thread = PingStatusThread()
+            STATUS_HUB.start(PING_REQUEST.set)
+    if status_thread is not None:
+        status_thread.start()
     try:
         tornado.ioloop.IOLoop.current().start()
     except KeyboardInterrupt:
         _LOGGER.info("Shutting down...")
         STOP_EVENT.set()
         PING_REQUEST.set()
-        status_thread.join()
+        if status_thread is not None:
+            status_thread.join()
         if args.socket is not None:
             os.remove(args.socket)
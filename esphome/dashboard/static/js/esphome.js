@@ -49,6 +49,46 @@ const nodeGrid = () => {
  *  Online/ Offline Status Indication
  */
 
+const nodeStatus = {};
+
+const setNodeClass = (node, className) => {
+  if (node.classList.contains(className)) {
+    return;
+  }
+  node.classList.remove('status-unknown', 'status-online', 'status-offline', 'status-not-responding');
+  node.classList.add(className);
+};
+
+const setNodeStatus = (filename, status) => {
+  const previous = nodeStatus[filename];
+  if (previous === status) {
+    return;
+  }
+  nodeStatus[filename] = status;
+
+  let node = document.querySelector(`#nodes .card[data-filename="${filename}"]`);
+  if (node === null) {
+    return;
+  }
+
+  if (status === null) {
+    setNodeClass(node, 'status-unknown');
+  } else if (status === true) {
+    setNodeClass(node, 'status-online');
+    node.setAttribute('data-last-connected', Date.now().toString());
+  } else if (previous === true) {
+    // Nodes that just went away are shown as not responding for 5 s before they're offline
+    setNodeClass(node, 'status-not-responding');
+    setTimeout(() => {
+      if (nodeStatus[filename] === false) {
+        setNodeClass(node, 'status-offline');
+      }
+    }, 5000);
+  } else {
+    setNodeClass(node, 'status-offline');
+  }
+};
+
 let isFetchingPing = false;
 
 const fetchPing = () => {
@@ -61,44 +101,35 @@ const fetchPing = () => {
   fetch(`./ping`, { credentials: "same-origin" }).then(res => res.json())
     .then(response => {
       for (let filename in response) {
-        let node = document.querySelector(`#nodes .card[data-filename="${filename}"]`);
-
-        if (node === null) {
-          continue;
-        }
-
-        let status = response[filename];
-        let className;
-
-        if (status === null) {
-          className = 'status-unknown';
-        } else if (status === true) {
-          className = 'status-online';
-          node.setAttribute('data-last-connected', Date.now().toString());
-        } else if (node.hasAttribute('data-last-connected')) {
-          const attr = parseInt(node.getAttribute('data-last-connected'));
-          if (Date.now() - attr <= 5000) {
-            className = 'status-not-responding';
-          } else {
-            className = 'status-offline';
-          }
-        } else {
-          className = 'status-offline';
-        }
-
-        if (node.classList.contains(className)) {
-          continue;
-        }
-
-        node.classList.remove('status-unknown', 'status-online', 'status-offline', 'status-not-responding');
-        node.classList.add(className);
+        setNodeStatus(filename, response[filename]);
       }
 
       isFetchingPing = false;
     });
 };
-setInterval(fetchPing, 2000);
-fetchPing();
+
+// The status socket sends the status of all nodes once and then only what changed. Browsers that can't keep
+// it open poll instead.
+let pingInterval = null;
+
+const startStatusSocket = () => {
+  const socket = new WebSocket(`${wsUrl}status`);
+  socket.addEventListener('message', event => {
+    const data = JSON.parse(event.data);
+    if (data.event === 'status') {
+      for (let filename in data.data) {
+        setNodeStatus(filename, data.data[filename]);
+      }
+    }
+  });
+  socket.addEventListener('close', () => {
+    if (pingInterval === null) {
+      pingInterval = setInterval(fetchPing, 2000);
+      fetchPing();
+    }
+  });
+};
+startStatusSocket();
 
 /**
  *  Log Color Parsing
@@ -0,0 +1,154 @@
+import asyncio
+import logging
+import os
+import socket
+import struct
+import time
+
+_LOGGER = logging.getLogger(__name__)
+
+ICMP_ECHO_REPLY = 0
+ICMP_ECHO_REQUEST = 8
+# How long resolved addresses are reused, and failed lookups aren't retried
+RESOLVE_TTL = 60.0
+RESOLVE_FAILED_TTL = 10.0
+
+
+def _checksum(data):
+    if len(data) % 2:
+        data += b'\0'
+    total = sum(struct.unpack(f'!{len(data) // 2}H', data))
+    total = (total >> 16) + (total & 0xFFFF)
+    total += total >> 16
+    return ~total & 0xFFFF
+
+
+def _echo_request(ident, seq):
+    payload = b'esphome'
+    header = struct.pack('!BBHHH', ICMP_ECHO_REQUEST, 0, 0, ident, seq)
+    checksum = _checksum(header + payload)
+    return struct.pack('!BBHHH', ICMP_ECHO_REQUEST, 0, checksum, ident, seq) + payload
+
+
+def _open_icmp_socket():
+    """Open an unprivileged ICMP socket if the OS allows it, a raw one otherwise.
+
+    Returns the socket and whether it is raw, (None, False) if neither is permitted.
+    """
+    for type_ in (socket.SOCK_DGRAM, socket.SOCK_RAW):
+        try:
+            sock = socket.socket(socket.AF_INET, type_, socket.IPPROTO_ICMP)
+        except OSError:
+            continue
+        sock.setblocking(False)
+        return sock, type_ == socket.SOCK_RAW
+    return None, False
+
+
+class Pinger:
+    """Pings many hosts at once from a single ICMP socket, on the asyncio loop."""
+
+    def __init__(self):
+        self._sock, self._raw = _open_icmp_socket()
+        self._ident = os.getpid() & 0xFFFF
+        self._seq = 0
+        self._pending = set()
+        self._replied = set()
+        self._done = None
+        if self._sock is not None:
+            asyncio.get_event_loop().add_reader(self._sock.fileno(), self._on_readable)
+
+    @property
+    def available(self):
+        return self._sock is not None
+
+    async def ping(self, addresses, timeout):
+        """Ping all IPv4 addresses at once, returns the set of those that replied within the timeout."""
+        self._seq = (self._seq + 1) & 0xFFFF
+        self._pending = set(addresses)
+        self._replied = set()
+        self._done = asyncio.get_event_loop().create_future()
+        packet = _echo_request(self._ident, self._seq)
+        for address in list(self._pending):
+            try:
+                self._sock.sendto(packet, (address, 0))
+            except OSError:
+                # for example no route to the host
+                self._pending.discard(address)
+        if self._pending:
+            try:
+                await asyncio.wait_for(asyncio.shield(self._done), timeout)
+            except asyncio.TimeoutError:
+                pass
+        self._pending = set()
+        return self._replied
+
+    def _on_readable(self):
+        while True:
+            try:
+                data, (address, _) = self._sock.recvfrom(1024)
+            except (BlockingIOError, InterruptedError):
+                return
+            except OSError as err:
+                _LOGGER.debug("Reading ICMP reply failed: %s", err)
+                return
+            # raw sockets, and unprivileged ones on macOS, receive the IPv4 header too
+            if data and data[0] >> 4 == 4:
+                data = data[(data[0] & 0x0F) * 4:]
+            if len(data) < 8:
+                continue
+            type_, _, _, ident, seq = struct.unpack('!BBHHH', data[:8])
+            # unprivileged sockets on Linux replace the identifier with their own
+            if type_ != ICMP_ECHO_REPLY or seq != self._seq or (self._raw and ident != self._ident):
+                continue
+            if address in self._pending:
+                self._pending.discard(address)
+                self._replied.add(address)
+                if not self._pending and not self._done.done():
+                    self._done.set_result(None)
+
+    def close(self):
+        if self._sock is not None:
+            asyncio.get_event_loop().remove_reader(self._sock.fileno())
+            self._sock.close()
+            self._sock = None
+
+
+class AddressCache:
+    """Resolves host names to IPv4 addresses in the background and caches them.
+
+    Lookups of .local names can take seconds for nodes that are offline, so resolve() only waits up to a timeout
+    and leaves slow lookups running for the next call.
+    """
+
+    def __init__(self):
+        self._cache = {}
+        self._lookups = {}
+
+    async def resolve(self, hosts, timeout):
+        """Return a dict of the hosts that are resolved to their address, None if the lookup failed."""
+        now = time.monotonic()
+        result = {}
+        for host in hosts:
+            cached = self._cache.get(host)
+            if cached is not None and cached[1] > now:
+                result[host] = cached[0]
+            elif host not in self._lookups:
+                self._lookups[host] = asyncio.ensure_future(self._lookup(host))
+        waiting = [self._lookups[host] for host in hosts if host not in result]
+        if waiting:
+            await asyncio.wait(waiting, timeout=timeout)
+        for host in hosts:
+            if host not in result and host in self._cache:
+                result[host] = self._cache[host][0]
+        return result
+
+    async def _lookup(self, host):
+        try:
+            infos = await asyncio.get_event_loop().getaddrinfo(host, None, family=socket.AF_INET,
+                                                               type=socket.SOCK_DGRAM)
+            address, ttl = infos[0][4][0], RESOLVE_TTL
+        except (OSError, IndexError):
+            address, ttl = None, RESOLVE_FAILED_TTL
+        self._cache[host] = (address, time.monotonic() + ttl)
+        del self._lookups[host]
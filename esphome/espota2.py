@@ -1,7 +1,10 @@
+import gzip
 import hashlib
 import logging
+import os
 import random
 import socket
+import struct
 import sys
 import time
 
@@ -17,6 +20,10 @@ RESPONSE_UPDATE_PREPARE_OK = 66
 RESPONSE_BIN_MD5_OK = 67
 RESPONSE_RECEIVE_OK = 68
 RESPONSE_UPDATE_END_OK = 69
+RESPONSE_SUPPORTS_COMPRESSION = 70
+RESPONSE_FEATURES = 71
+RESPONSE_DELTA_BASE_OK = 72
+RESPONSE_DELTA_BASE_MISMATCH = 73
 
 RESPONSE_ERROR_MAGIC = 128
 RESPONSE_ERROR_UPDATE_PREPARE = 129
@@ -28,10 +35,19 @@ RESPONSE_ERROR_WRONG_CURRENT_FLASH_CONFIG = 134
 RESPONSE_ERROR_WRONG_NEW_FLASH_CONFIG = 135
 RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136
 RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137
+RESPONSE_ERROR_INVALID_PATCH = 138
 RESPONSE_ERROR_UNKNOWN = 255
 
 OTA_VERSION_1_0 = 1
 
+FEATURE_SUPPORTS_COMPRESSION = 0x01
+FEATURE_SUPPORTS_DELTA = 0x02
+
+PATCH_COPY = 0x01
+PATCH_INSERT = 0x02
+# The base image is indexed in blocks of this size, shorter matches aren't found
+DELTA_BLOCK_SIZE = 32
+
 MAGIC_BYTES = [0x6C, 0x26, 0xF7, 0x5C, 0x45]
 
 _LOGGER = logging.getLogger(__name__)
@@ -132,6 +148,9 @@ def check_error(data, expect):
     if dat == RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE:
         raise OTAError("Error: The OTA partition on the ESP is too small. ESPHome needs to resize "
                        "this partition, please flash over USB.")
+    if dat == RESPONSE_ERROR_INVALID_PATCH:
+        raise OTAError("Error: The ESP could not apply the delta update. See the USB logs for more "
+                       "information.")
     if dat == RESPONSE_ERROR_UNKNOWN:
         raise OTAError("Unknown error from ESP")
     if not isinstance(expect, (list, tuple)):
@@ -154,12 +173,67 @@ def send_check(sock, data, msg):
         raise OTAError(f"Error sending {msg}: {err}") from err
 
 
-def perform_ota(sock, password, file_handle, filename):
-    file_md5 = hashlib.md5(file_handle.read()).hexdigest()
-    file_size = file_handle.tell()
-    _LOGGER.info('Uploading %s (%s bytes)', filename, file_size)
-    file_handle.seek(0)
-    _LOGGER.debug("MD5 of binary is %s", file_md5)
+def _match_length(image, image_pos, base, base_pos):
+    length = 0
+    while True:
+        count = min(256, len(image) - image_pos - length, len(base) - base_pos - length)
+        if count <= 0:
+            return length
+        if image[image_pos + length:image_pos + length + count] == \
+                base[base_pos + length:base_pos + length + count]:
+            length += count
+            continue
+        while image[image_pos + length] == base[base_pos + length]:
+            length += 1
+        return length
+
+
+def _add_insert(patch, data):
+    if data:
+        patch += struct.pack('>BI', PATCH_INSERT, len(data))
+        patch += data
+
+
+def compute_delta(base, image):
+    """Compute a patch that builds image from base, which is the image running on the ESP.
+
+    The patch is a list of commands: COPY (offset and length in base) and INSERT (length and data),
+    all numbers are 4 bytes MSB first. Every block of base at a multiple of DELTA_BLOCK_SIZE is
+    indexed, each position of image is looked up and a match is extended in both directions.
+    """
+    blocks = {}
+    for pos in range(0, len(base) - DELTA_BLOCK_SIZE + 1, DELTA_BLOCK_SIZE):
+        blocks.setdefault(base[pos:pos + DELTA_BLOCK_SIZE], pos)
+
+    patch = bytearray()
+    insert_start = 0
+    pos = 0
+    while pos + DELTA_BLOCK_SIZE <= len(image):
+        base_pos = blocks.get(image[pos:pos + DELTA_BLOCK_SIZE])
+        if base_pos is None:
+            pos += 1
+            continue
+        start = pos
+        while start > insert_start and base_pos > 0 and image[start - 1] == base[base_pos - 1]:
+            start -= 1
+            base_pos -= 1
+        length = _match_length(image, start, base, base_pos)
+        _add_insert(patch, image[insert_start:start])
+        patch += struct.pack('>BII', PATCH_COPY, base_pos, length)
+        pos = insert_start = start + length
+    _add_insert(patch, image[insert_start:])
+    return bytes(patch)
+
+
+def perform_ota(sock, password, file_handle, filename, base_contents=None):
+    file_contents = file_handle.read()
+    _LOGGER.info('Uploading %s (%s bytes)', filename, len(file_contents))
+    patch = None
+    if base_contents is not None and base_contents != file_contents:
+        patch = compute_delta(base_contents, file_contents)
+        _LOGGER.info('Delta to the previous upload is %s bytes', len(patch))
+        if len(patch) >= len(file_contents):
+            patch = None
 
     # Enable nodelay, we need it for phase 1
     sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
@@ -170,8 +244,18 @@ def perform_ota(sock, password, file_handle, filename):
         raise OTAError(f"Unsupported OTA version {version}")
 
     # Features
-    send_check(sock, 0x00, 'features')
-    receive_exactly(sock, 1, 'features', RESPONSE_HEADER_OK)
+    features = FEATURE_SUPPORTS_COMPRESSION
+    if patch is not None:
+        features |= FEATURE_SUPPORTS_DELTA
+    send_check(sock, features, 'features')
+    response, = receive_exactly(sock, 1, 'features', [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION,
+                                                      RESPONSE_FEATURES])
+    if response == RESPONSE_FEATURES:
+        accepted, = receive_exactly(sock, 1, 'accepted features', [])
+    elif response == RESPONSE_SUPPORTS_COMPRESSION:
+        accepted = FEATURE_SUPPORTS_COMPRESSION
+    else:
+        accepted = 0
 
     auth, = receive_exactly(sock, 1, 'auth', [RESPONSE_REQUEST_AUTH, RESPONSE_AUTH_OK])
     if auth == RESPONSE_REQUEST_AUTH:
@@ -194,6 +278,39 @@ def perform_ota(sock, password, file_handle, filename):
         send_check(sock, result, 'auth result')
         receive_exactly(sock, 1, 'auth result', RESPONSE_AUTH_OK)
 
+    upload_contents = file_contents
+    if accepted & FEATURE_SUPPORTS_COMPRESSION:
+        upload_contents = gzip.compress(file_contents, compresslevel=9)
+        _LOGGER.info('Compressed to %s bytes', len(upload_contents))
+    delta = False
+    if accepted & FEATURE_SUPPORTS_DELTA:
+        # A base size of 0 declines the delta update, if the compressed image is smaller anyway
+        if len(patch) < len(upload_contents):
+            base_size = len(base_contents)
+            base_md5 = hashlib.md5(base_contents).hexdigest()
+        else:
+            base_size = 0
+            base_md5 = '0' * 32
+        send_check(sock, list(struct.pack('>I', base_size)), 'delta base size')
+        send_check(sock, base_md5, 'delta base checksum')
+        reply, = receive_exactly(sock, 1, 'delta base', [RESPONSE_DELTA_BASE_OK,
+                                                        RESPONSE_DELTA_BASE_MISMATCH])
+        delta = reply == RESPONSE_DELTA_BASE_OK
+        if delta:
+            _LOGGER.info('Sending the delta to the previous upload')
+            upload_contents = patch
+        elif base_size != 0:
+            _LOGGER.info('ESP is not running the previous upload, sending the whole image')
+
+    if delta:
+        # The size and checksum are those of the image the ESP builds from the patch
+        file_size = len(file_contents)
+        file_md5 = hashlib.md5(file_contents).hexdigest()
+    else:
+        file_size = len(upload_contents)
+        file_md5 = hashlib.md5(upload_contents).hexdigest()
+    _LOGGER.debug("MD5 of binary is %s", file_md5)
+
     file_size_encoded = [
         (file_size >> 24) & 0xFF,
         (file_size >> 16) & 0xFF,
@@ -215,11 +332,11 @@ def perform_ota(sock, password, file_handle, filename):
     sock.settimeout(20.0)
 
     offset = 0
+    upload_size = len(upload_contents)
     progress = ProgressBar()
-    while True:
-        chunk = file_handle.read(1024)
-        if not chunk:
-            break
+    start_time = time.time()
+    while offset < upload_size:
+        chunk = upload_contents[offset:offset + 1024]
         offset += len(chunk)
 
         try:
@@ -228,8 +345,10 @@ def perform_ota(sock, password, file_handle, filename):
             sys.stderr.write('\n')
             raise OTAError(f"Error sending data: {err}") from err
 
-        progress.update(offset / float(file_size))
+        progress.update(offset / float(upload_size))
     progress.done()
+    duration = max(time.time() - start_time, 0.001)
+    _LOGGER.info("Upload took %.2f seconds (%.1f kB/s)", duration, upload_size / duration / 1000)
 
     # Enable nodelay for last checks
     sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
@@ -246,7 +365,7 @@ def perform_ota(sock, password, file_handle, filename):
     time.sleep(1)
 
 
-def run_ota_impl_(remote_host, remote_port, password, filename):
+def run_ota_impl_(remote_host, remote_port, password, filename, base_filename=None):
     if is_ip_address(remote_host):
         _LOGGER.info("Connecting to %s", remote_host)
         ip = remote_host
@@ -271,9 +390,14 @@ def run_ota_impl_(remote_host, remote_port, password, filename):
         _LOGGER.error("Connecting to %s:%s failed: %s", remote_host, remote_port, err)
         return 1
 
+    base_contents = None
+    if base_filename is not None and os.path.isfile(base_filename):
+        with open(base_filename, 'rb') as base_handle:
+            base_contents = base_handle.read()
+
     file_handle = open(filename, 'rb')
     try:
-        perform_ota(sock, password, file_handle, filename)
+        perform_ota(sock, password, file_handle, filename, base_contents)
     except OTAError as err:
         _LOGGER.error(str(err))
         return 1
@@ -284,9 +408,10 @@ def run_ota_impl_(remote_host, remote_port, password, filename):
     return 0
 
 
-def run_ota(remote_host, remote_port, password, filename):
+def run_ota(remote_host, remote_port, password, filename, base_filename=None):
+    """Upload filename, as a delta to base_filename if the ESP still runs that image."""
     try:
-        return run_ota_impl_(remote_host, remote_port, password, filename)
+        return run_ota_impl_(remote_host, remote_port, password, filename, base_filename)
     except OTAError as err:
         _LOGGER.error(err)
         return 1
@@ -20,6 +20,10 @@ def storage_path():  # type: () -> str
     return CORE.relative_config_path('.esphome', f'{CORE.config_filename}.json')
 
 
+def ota_base_path():  # type: () -> str
+    return CORE.relative_config_path('.esphome', f'{CORE.config_filename}.ota-base.bin')
+
+
 def ext_storage_path(base_path, config_filename):  # type: (str, str) -> str
     return os.path.join(base_path, '.esphome', f'{config_filename}.json')
 
@@ -36,7 +40,7 @@ def trash_storage_path(base_path):  # type: (str) -> str
 class StorageJSON:
     def __init__(self, storage_version, name, comment, esphome_version,
                  src_version, arduino_version, address, esp_platform, board, build_path,
-                 firmware_bin_path, loaded_integrations):
+                 firmware_bin_path, loaded_integrations, ota_base_bin_path=None, config_hash=None):
         # Version of the storage JSON schema
         assert storage_version is None or isinstance(storage_version, int)
         self.storage_version = storage_version  # type: int
@@ -65,6 +69,10 @@ class StorageJSON:
         # A list of strings of names of loaded integrations
         self.loaded_integrations = loaded_integrations   # type: List[str]
         self.loaded_integrations.sort()
+        # The absolute path to a copy of the last uploaded firmware binary, the base for delta OTA updates
+        self.ota_base_bin_path = ota_base_bin_path  # type: str
+        # The hash of the configuration the firmware binary was last compiled from
+        self.config_hash = config_hash  # type: str
 
     def as_dict(self):
         return {
@@ -80,6 +88,8 @@ class StorageJSON:
             'build_path': self.build_path,
             'firmware_bin_path': self.firmware_bin_path,
             'loaded_integrations': self.loaded_integrations,
+            'ota_base_bin_path': self.ota_base_bin_path,
+            'config_hash': self.config_hash,
         }
 
     def to_json(self):
@@ -103,6 +113,8 @@ class StorageJSON:
             build_path=esph.build_path,
             firmware_bin_path=esph.firmware_bin,
             loaded_integrations=list(esph.loaded_integrations),
+            ota_base_bin_path=old.ota_base_bin_path if old is not None else None,
+            config_hash=old.config_hash if old is not None else None,
         )
 
     @staticmethod
@@ -139,9 +151,11 @@ class StorageJSON:
         build_path = storage.get('build_path')
         firmware_bin_path = storage.get('firmware_bin_path')
         loaded_integrations = storage.get('loaded_integrations', [])
+        ota_base_bin_path = storage.get('ota_base_bin_path')
+        config_hash = storage.get('config_hash')
         return StorageJSON(storage_version, name, comment, esphome_version,
                            src_version, arduino_version, address, esp_platform, board, build_path,
-                           firmware_bin_path, loaded_integrations)
+                           firmware_bin_path, loaded_integrations, ota_base_bin_path, config_hash)
 
     @staticmethod
     def load(path):  # type: (str) -> Optional[StorageJSON]
@@ -5,10 +5,10 @@ import re
 from esphome.config import iter_components
 from esphome.const import CONF_BOARD_FLASH_MODE, CONF_ESPHOME, CONF_PLATFORMIO_OPTIONS, \
     HEADER_FILE_EXTENSIONS, SOURCE_FILE_EXTENSIONS, __version__, ARDUINO_VERSION_ESP8266, \
-    ENV_NOGITIGNORE
+    ENV_NOGITIGNORE, ENV_BUILD_CACHE
 from esphome.core import CORE, EsphomeError
 from esphome.helpers import mkdir_p, read_file, write_file_if_changed, walk_files, \
-    copy_file_if_changed, get_bool_env
+    copy_file_if_changed, get_bool_env, indent
 from esphome.storage_json import StorageJSON, storage_path
 from esphome.pins import ESP8266_FLASH_SIZES, ESP8266_LD_SCRIPTS
 
@@ -190,6 +190,37 @@ app1,     app,  ota_1,   0x1D0000, 0x1C0000,
 eeprom,   data, 0x99,    0x390000, 0x001000,
 spiffs,   data, spiffs,  0x391000, 0x00F000
 """
+# The flash after the large partitions, used by the persistent_log component
+ESP32_LOG_PARTITION_ADDRESS = 0x3A0000
+ESP32_LOG_PARTITION_MAX_SIZE = 0x400000 - ESP32_LOG_PARTITION_ADDRESS
+KEY_ESP32_LOG_PARTITION_SIZE = 'esp32_log_partition_size'
+
+
+def get_esp8266_ld_script(platformio_options=True):
+    """The linker script of an ESP8266 build, None if the board's default is used.
+
+    With platformio_options, a board_build.ldscript set by the user takes precedence.
+    """
+    if not CORE.is_esp8266:
+        return None
+    if platformio_options:
+        options = CORE.config[CONF_ESPHOME].get(CONF_PLATFORMIO_OPTIONS, {})
+        if 'board_build.ldscript' in options:
+            return options['board_build.ldscript']
+    if CORE.board not in ESP8266_FLASH_SIZES:
+        return None
+    flash_size = ESP8266_FLASH_SIZES[CORE.board]
+    ld_scripts = ESP8266_LD_SCRIPTS[flash_size]
+
+    versions_with_old_ldscripts = [
+        ARDUINO_VERSION_ESP8266['2.4.0'],
+        ARDUINO_VERSION_ESP8266['2.4.1'],
+        ARDUINO_VERSION_ESP8266['2.4.2'],
+    ]
+    if CORE.arduino_version in versions_with_old_ldscripts:
+        # Old ld script path
+        return ld_scripts[0]
+    return ld_scripts[1]
 
 
 def get_ini_content():
@@ -205,10 +236,24 @@ def get_ini_content():
         'upload_speed': UPLOAD_SPEED_OVERRIDE.get(CORE.board, 115200),
     }
 
+    build_cache = os.getenv(ENV_BUILD_CACHE)
+    if build_cache:
+        # share the object files of identical sources, defines and flags with all other nodes
+        from esphome.build_cache import get_build_cache_script
+
+        write_file_if_changed(CORE.relative_build_path('build_cache.py'),
+                              get_build_cache_script(build_cache, CORE.build_path))
+        data['extra_scripts'] = ['build_cache.py']
+
     if CORE.is_esp32:
         data['board_build.partitions'] = "partitions.csv"
         partitions_csv = CORE.relative_build_path('partitions.csv')
-        write_file_if_changed(partitions_csv, ESP32_LARGE_PARTITIONS_CSV)
+        partitions = ESP32_LARGE_PARTITIONS_CSV
+        log_partition_size = CORE.data.get(KEY_ESP32_LOG_PARTITION_SIZE)
+        if log_partition_size is not None:
+            partitions += 'logs,     data, 0x9a,    0x{:06X}, 0x{:06X}\n'.format(ESP32_LOG_PARTITION_ADDRESS,
+                                                                         log_partition_size)
+        write_file_if_changed(partitions_csv, partitions)
 
     # pylint: disable=unsubscriptable-object
     if CONF_BOARD_FLASH_MODE in CORE.config[CONF_ESPHOME]:
@@ -216,26 +261,9 @@ def get_ini_content():
         data['board_build.flash_mode'] = flash_mode
 
     # Build flags
-    if CORE.is_esp8266 and CORE.board in ESP8266_FLASH_SIZES:
-        flash_size = ESP8266_FLASH_SIZES[CORE.board]
-        ld_scripts = ESP8266_LD_SCRIPTS[flash_size]
-
-        versions_with_old_ldscripts = [
-            ARDUINO_VERSION_ESP8266['2.4.0'],
-            ARDUINO_VERSION_ESP8266['2.4.1'],
-            ARDUINO_VERSION_ESP8266['2.4.2'],
-        ]
-        if CORE.arduino_version == ARDUINO_VERSION_ESP8266['2.3.0']:
-            # No ld script support
-            ld_script = None
-        if CORE.arduino_version in versions_with_old_ldscripts:
-            # Old ld script path
-            ld_script = ld_scripts[0]
-        else:
-            ld_script = ld_scripts[1]
-
-        if ld_script is not None:
-            data['board_build.ldscript'] = ld_script
+    ld_script = get_esp8266_ld_script(platformio_options=False)
+    if ld_script is not None:
+        data['board_build.ldscript'] = ld_script
 
     # Ignore libraries that are not explicitly used, but may
     # be added by LDF
@@ -370,7 +398,7 @@ def generate_defines_h():
     return DEFINES_H_FORMAT.format('\n'.join(define_content_l))
 
 
-def write_cpp(code_s):
+def write_cpp(code_s, global_s=None):
     path = CORE.relative_src_path('main.cpp')
     if os.path.isfile(path):
         text = read_file(path)
@@ -381,8 +409,9 @@ def write_cpp(code_s):
         code_format = CPP_BASE_FORMAT
 
     copy_src_tree()
-    global_s = '#include "esphome.h"\n'
-    global_s += CORE.cpp_global_section
+    if global_s is None:
+        global_s = '#include "esphome.h"\n'
+        global_s += CORE.cpp_global_section
 
     full_file = code_format[0] + CPP_INCLUDE_BEGIN + '\n' + global_s + CPP_INCLUDE_END
     full_file += code_format[1] + CPP_AUTO_GENERATE_BEGIN + '\n' + code_s + CPP_AUTO_GENERATE_END
@@ -390,6 +419,113 @@ def write_cpp(code_s):
     write_file_if_changed(path, full_file)
 
 
+SPLIT_SETUP_HEADER = 'esphome_setup.h'
+SPLIT_SETUP_SOURCE_RE = re.compile(r'^esphome_setup_(\d+)\.cpp$')
+# Approximate size of the generated code in each translation unit, in characters
+SPLIT_SETUP_CHUNK_SIZE = 16384
+
+SPLIT_SETUP_HEADER_FORMAT = """\
+// Auto generated code by esphome
+#pragma once
+#include "esphome.h"
+{}
+"""
+SPLIT_SETUP_SOURCE_FORMAT = """\
+// Auto generated code by esphome
+#include "{}"
+
+void {}() {{
+{}}}
+"""
+
+
+def split_setup():
+    """Split the generated code into separate translation units.
+
+    Return the declarations for the shared header, the definitions of the globals in main.cpp and
+    the chunks of the setup code. Pointers declared globally become extern in the header, the
+    local variables of setup() become globals constructed in place so that the statements using
+    them can end up in another chunk. A chunk is only ended before the comment starting the code
+    of a component, so the code of one component never spans two files.
+    """
+    from esphome.cpp_generator import AssignmentExpression, LineComment, \
+        ProgmemAssignmentExpression, VariableDeclarationExpression, statement
+
+    header = []
+    definitions = []
+    for exp in CORE.global_statements:
+        expression = getattr(exp, 'expression', None)
+        if isinstance(expression, VariableDeclarationExpression):
+            header.append(f'extern {expression};')
+            definitions.append(f'{expression};')
+        else:
+            header.append(str(exp).rstrip())
+
+    chunks = [[]]
+    size = 0
+    for exp in CORE.main_statements:
+        expression = getattr(exp, 'expression', None)
+        if isinstance(expression, ProgmemAssignmentExpression):
+            header.append(f'extern const {expression.type} {expression.name}[];')
+            definitions.append(f'const {expression.type} {expression.name}[] PROGMEM = '
+                               f'{expression.rhs};')
+            continue
+        if isinstance(expression, AssignmentExpression) and expression.type is not None:
+            type_, name = expression.type, expression.name
+            header.append(f'extern {type_} &{name};')
+            definitions.append(f'alignas({type_}) static uint8_t {name}_storage[sizeof({type_})];')
+            definitions.append(f'{type_} &{name} = *reinterpret_cast<{type_} *>({name}_storage);')
+            text = f'new (&{name}) {type_}({expression.rhs});'
+        else:
+            text = str(statement(exp)).rstrip()
+        if isinstance(exp, LineComment) and size >= SPLIT_SETUP_CHUNK_SIZE:
+            chunks.append([])
+            size = 0
+        chunks[-1].append(text)
+        size += len(text)
+
+    chunks = [chunk for chunk in chunks if chunk]
+    for i in range(len(chunks)):
+        header.append(f'void esphome_setup_{i}();')
+    return header, definitions, chunks
+
+
+def write_split_cpp():
+    """Write the generated code with setup() split over esphome_setup_N.cpp files.
+
+    The chunks only depend on the shared header, so adding a component only rebuilds the chunks
+    whose code changed and the chunks compile in parallel. The includes of the configuration end up
+    in the shared header, so they must not define anything that isn't inline.
+    """
+    header, definitions, chunks = split_setup()
+    write_file_if_changed(CORE.relative_src_path(SPLIT_SETUP_HEADER),
+                          SPLIT_SETUP_HEADER_FORMAT.format('\n'.join(header)))
+    for i, chunk in enumerate(chunks):
+        code_s = indent('\n'.join(chunk)) + '\n'
+        write_file_if_changed(CORE.relative_src_path(f'esphome_setup_{i}.cpp'),
+                              SPLIT_SETUP_SOURCE_FORMAT.format(SPLIT_SETUP_HEADER,
+                                                               f'esphome_setup_{i}', code_s))
+    remove_split_setup_sources(len(chunks))
+
+    global_s = f'#include "{SPLIT_SETUP_HEADER}"\n'
+    global_s += '\n'.join(definitions) + '\n'
+    code_s = indent(''.join(f'esphome_setup_{i}();\n' for i in range(len(chunks))) + '\n')
+    write_cpp(code_s, global_s)
+
+
+def remove_split_setup_sources(keep=0):
+    """Remove the chunks of an earlier build, those with index >= keep."""
+    src = CORE.relative_src_path()
+    if not os.path.isdir(src):
+        return
+    for name in os.listdir(src):
+        match = SPLIT_SETUP_SOURCE_RE.match(name)
+        if match is not None and int(match.group(1)) >= keep:
+            os.remove(os.path.join(src, name))
+    if keep == 0 and os.path.isfile(os.path.join(src, SPLIT_SETUP_HEADER)):
+        os.remove(os.path.join(src, SPLIT_SETUP_HEADER))
+
+
 def clean_build():
     import shutil
 
@@ -1,5 +1,6 @@
 import fnmatch
 import functools
+import hashlib
 import inspect
 import logging
 import math
@@ -13,7 +14,7 @@ from esphome import core
 from esphome.config_helpers import read_config_file
 from esphome.core import EsphomeError, IPAddress, Lambda, MACAddress, TimePeriod, \
     DocumentRange
-from esphome.helpers import add_class_to_obj
+from esphome.helpers import add_class_to_obj, read_file
 from esphome.util import OrderedDict, filter_yaml_files
 
 _LOGGER = logging.getLogger(__name__)
@@ -24,6 +25,11 @@ _LOGGER = logging.getLogger(__name__)
 SECRET_YAML = 'secrets.yaml'
 _SECRET_CACHE = {}
 _SECRET_VALUES = {}
+# What the last load_yaml() read: the hashes of the files, the listings of the included
+# directories and the environment variables, see loaded_inputs()
+_LOADED_FILES = {}
+_LOADED_DIRS = {}
+_LOADED_ENV = {}
 
 
 class ESPHomeDataBase:
@@ -206,6 +212,7 @@ class ESPHomeLoader(yaml.SafeLoader):  # pylint: disable=too-many-ancestors
     @_add_data_ref
     def construct_env_var(self, node):
         args = node.value.split()
+        _LOADED_ENV[args[0]] = os.environ.get(args[0])
         # Check for a default value
         if len(args) > 1:
             return os.getenv(args[0], ' '.join(args[1:]))
@@ -304,11 +311,48 @@ ESPHomeLoader.add_constructor('!force', ESPHomeLoader.construct_force)
 def load_yaml(fname):
     _SECRET_VALUES.clear()
     _SECRET_CACHE.clear()
+    _LOADED_FILES.clear()
+    _LOADED_DIRS.clear()
+    _LOADED_ENV.clear()
     return _load_yaml_internal(fname)
 
 
+def _content_hash(content):
+    return hashlib.sha256(content.encode()).hexdigest()
+
+
+def loaded_inputs():
+    """Return everything the last load_yaml() depended on, in a form that can be stored as JSON."""
+    return {
+        'files': dict(_LOADED_FILES),
+        'dirs': dict(_LOADED_DIRS),
+        'env': dict(_LOADED_ENV),
+    }
+
+
+def inputs_unchanged(inputs):
+    """Check if loading again would read the same inputs as the ones returned by loaded_inputs().
+
+    This only hashes the files, which is much faster than parsing them.
+    """
+    for name, value in inputs['env'].items():
+        if os.environ.get(name) != value:
+            return False
+    for directory, files in inputs['dirs'].items():
+        if sorted(_walk_files(directory, '*.yaml')) != files:
+            return False
+    for path, content_hash in inputs['files'].items():
+        try:
+            if _content_hash(read_file(path)) != content_hash:
+                return False
+        except EsphomeError:
+            return False
+    return True
+
+
 def _load_yaml_internal(fname):
     content = read_config_file(fname)
+    _LOADED_FILES[os.path.abspath(fname)] = _content_hash(content)
     loader = ESPHomeLoader(content)
     loader.name = fname
     try:
@@ -332,6 +376,12 @@ def _is_file_valid(name):
 
 def _find_files(directory, pattern):
     """Recursively load files in a directory."""
+    files = list(_walk_files(directory, pattern))
+    _LOADED_DIRS[os.path.abspath(directory)] = sorted(os.path.abspath(f) for f in files)
+    return files
+
+
+def _walk_files(directory, pattern):
     for root, dirs, files in os.walk(directory, topdown=True):
         dirs[:] = [d for d in dirs if _is_file_valid(d)]
         for basename in files:
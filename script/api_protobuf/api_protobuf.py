@@ -14,6 +14,14 @@ then run this script with python3 and the files
     esphome/components/api/api_pb2.cpp
 
 will be generated, they still need to be formatted
+
+The messages used by the Python client in esphome/api/api_pb2.py are generated
+with the same protoc (its output works with the pinned protobuf==3.13.0, newer
+protoc versions need a newer runtime) from a copy of api.proto without the
+api_options.proto import, the service and the (...) options, which only
+this script uses:
+
+    protoc --python_out=esphome/api -I <dir of the copy> api.proto
 """
 
 import re
@@ -163,6 +171,15 @@ class TypeInfo():
 
     encode_func = None
 
+    @property
+    def size_func(self):
+        # encode_string -> add_string_field, encode_enum<T> -> add_enum_field<T>
+        return re.sub(r'^encode_(\w+)', r'add_\1_field', self.encode_func)
+
+    @property
+    def calculate_size_content(self):
+        return f'ProtoSize::{self.size_func}(total_size, {self.number}, this->{self.field_name});'
+
     @property
     def dump_content(self):
         o = f'out.append("  {self.name}: ");\n'
@@ -231,7 +248,7 @@ class UInt64Type(TypeInfo):
     encode_func = 'encode_uint64'
 
     def dump(self, name):
-        o = f'sprintf(buffer, "%ull", {name});\n'
+        o = f'sprintf(buffer, "%llu", {name});\n'
         o += f'out.append(buffer);'
         return o
 
@@ -257,7 +274,7 @@ class Fixed64Type(TypeInfo):
     encode_func = 'encode_fixed64'
 
     def dump(self, name):
-        o = f'sprintf(buffer, "%ull", {name});\n'
+        o = f'sprintf(buffer, "%llu", {name});\n'
         o += f'out.append(buffer);'
         return o
 
@@ -301,6 +318,18 @@ class StringType(TypeInfo):
         return o
 
 
+class StringRefType(StringType):
+    """A string field of a zero_copy message, a view of the receive buffer."""
+    cpp_type = 'StringRef'
+    reference_type = 'StringRef '
+    const_reference_type = 'StringRef '
+    decode_length = 'value.as_string_ref()'
+
+    def dump(self, name):
+        o = f'out.append("\'").append({name}.data(), {name}.size()).append("\'");'
+        return o
+
+
 @register_type(11)
 class MessageType(TypeInfo):
     @property
@@ -430,10 +459,16 @@ class SInt64Type(TypeInfo):
         return o
 
 
+def get_type_info(field, zero_copy=False):
+    if zero_copy and field.type == 9:
+        return StringRefType(field)
+    return TYPE_INFO[field.type](field)
+
+
 class RepeatedTypeInfo(TypeInfo):
-    def __init__(self, field):
+    def __init__(self, field, zero_copy=False):
         super().__init__(field)
-        self._ti = TYPE_INFO[field.type](field)
+        self._ti = get_type_info(field, zero_copy)
 
     @property
     def cpp_type(self):
@@ -496,13 +531,33 @@ class RepeatedTypeInfo(TypeInfo):
         # std::vector is specialized for bool, reference does not work
         return isinstance(self._ti, BoolType)
 
+    @property
+    def packed(self):
+        return self._field.options.packed
+
+    @property
+    def encode_func(self):
+        # encode_float -> encode_packed_float, encode_enum<T> -> encode_packed_enum<T>
+        return re.sub(r'^encode_', 'encode_packed_', self._ti.encode_func)
+
     @property
     def encode_content(self):
+        if self.packed:
+            return super().encode_content
         return f"""\
         for (auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{
           buffer.{self._ti.encode_func}({self.number}, it, true);
         }}"""
 
+    @property
+    def calculate_size_content(self):
+        if self.packed:
+            return super().calculate_size_content
+        return f"""\
+        for (const auto {'' if self._ti_is_bool else '&'}it : this->{self.field_name}) {{
+          ProtoSize::{self._ti.size_func}(total_size, {self.number}, it, true);
+        }}"""
+
     @property
     def dump_content(self):
         o = f'for (const auto {"" if self._ti_is_bool else "&"}it : this->{self.field_name}) {{\n'
@@ -532,7 +587,14 @@ def build_enum_type(desc):
     return out, cpp
 
 
+def get_opt(desc, opt, default=None):
+    if not desc.options.HasExtension(opt):
+        return default
+    return desc.options.Extensions[opt]
+
+
 def build_message_type(desc):
+    zero_copy = get_opt(desc, pb.zero_copy, False)
     public_content = []
     protected_content = []
     decode_varint = []
@@ -540,16 +602,18 @@ def build_message_type(desc):
     decode_32bit = []
     decode_64bit = []
     encode = []
+    calculate_size = []
     dump = []
 
     for field in desc.field:
         if field.label == 3:
-            ti = RepeatedTypeInfo(field)
+            ti = RepeatedTypeInfo(field, zero_copy)
         else:
-            ti = TYPE_INFO[field.type](field)
+            ti = get_type_info(field, zero_copy)
         protected_content.extend(ti.protected_content)
         public_content.extend(ti.public_content)
         encode.append(ti.encode_content)
+        calculate_size.append(ti.calculate_size_content)
 
         if ti.decode_varint_content:
             decode_varint.append(ti.decode_varint_content)
@@ -611,6 +675,13 @@ def build_message_type(desc):
     prot = 'void encode(ProtoWriteBuffer buffer) const override;'
     public_content.append(prot)
 
+    o = f"void {desc.name}::calculate_size(uint32_t &total_size) const {{\n"
+    o += indent('\n'.join(calculate_size)) + '\n'
+    o += '}\n'
+    cpp += o
+    prot = 'void calculate_size(uint32_t &total_size) const override;'
+    public_content.append(prot)
+
     o = f"void {desc.name}::dump_to(std::string &out) const {{\n"
     if dump:
         o += f"  char buffer[64];\n"
@@ -699,12 +770,6 @@ class_name = 'APIServerConnectionBase'
 ifdefs = {}
 
 
-def get_opt(desc, opt, default=None):
-    if not desc.options.HasExtension(opt):
-        return default
-    return desc.options.Extensions[opt]
-
-
 def build_service_message_type(mt):
     snake = camel_to_snake(mt.name)
     id_ = get_opt(mt, pb.id)
@@ -0,0 +1,93 @@
+#include "benchmark.h"
+#include "esphome/components/api/api_pb2.h"
+
+namespace esphome {
+namespace benchmark {
+
+using namespace api;
+
+static void bm_proto_varint_encode(State &state) {
+  std::vector<uint8_t> buffer;
+  buffer.reserve(16);
+  uint32_t value = 1;
+  for (auto _ : state) {
+    buffer.clear();
+    ProtoVarInt(value).encode(buffer);
+    value = value * 33 + 1;
+    do_not_optimize(buffer.data());
+  }
+}
+BENCHMARK(bm_proto_varint_encode);
+
+static void bm_proto_varint_parse(State &state) {
+  std::vector<uint8_t> buffer;
+  ProtoVarInt(123456789).encode(buffer);
+  for (auto _ : state) {
+    uint32_t consumed;
+    auto value = ProtoVarInt::parse(buffer.data(), buffer.size(), &consumed);
+    do_not_optimize(value);
+  }
+}
+BENCHMARK(bm_proto_varint_parse);
+
+/// The most frequent message of a connection.
+static void bm_proto_sensor_state_encode(State &state) {
+  SensorStateResponse msg;
+  msg.key = 0x12345678;
+  msg.state = 21.5f;
+  std::vector<uint8_t> buffer;
+  buffer.reserve(32);
+  for (auto _ : state) {
+    buffer.clear();
+    uint32_t size = 0;
+    msg.calculate_size(size);
+    msg.encode(ProtoWriteBuffer(&buffer));
+    do_not_optimize(size);
+    do_not_optimize(buffer.data());
+  }
+}
+BENCHMARK(bm_proto_sensor_state_encode);
+
+static void bm_proto_list_entities_encode(State &state) {
+  ListEntitiesSensorResponse msg;
+  msg.object_id = "living_room_temperature";
+  msg.key = 0x12345678;
+  msg.name = "Living Room Temperature";
+  msg.unique_id = "esphome-livingroom-temperature";
+  msg.icon = "mdi:thermometer";
+  msg.unit_of_measurement = "°C";
+  msg.accuracy_decimals = 1;
+  std::vector<uint8_t> buffer;
+  buffer.reserve(256);
+  for (auto _ : state) {
+    buffer.clear();
+    msg.encode(ProtoWriteBuffer(&buffer));
+    do_not_optimize(buffer.data());
+  }
+}
+BENCHMARK(bm_proto_list_entities_encode);
+
+static void bm_proto_light_command_decode(State &state) {
+  LightCommandRequest request;
+  request.key = 0x12345678;
+  request.has_state = request.state = true;
+  request.has_brightness = true;
+  request.brightness = 0.8f;
+  request.has_rgb = true;
+  request.red = 1.0f;
+  request.green = 0.5f;
+  request.blue = 0.25f;
+  request.has_transition_length = true;
+  request.transition_length = 1000;
+  std::vector<uint8_t> buffer;
+  request.encode(ProtoWriteBuffer(&buffer));
+  for (auto _ : state) {
+    LightCommandRequest msg;
+    msg.decode(buffer.data(), buffer.size());
+    do_not_optimize(msg.brightness);
+  }
+}
+BENCHMARK(bm_proto_light_command_decode);
+
+}  // namespace benchmark
+}  // namespace esphome
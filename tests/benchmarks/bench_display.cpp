@@ -0,0 +1,86 @@
+#include "benchmark.h"
+#include "esphome/components/display/display_buffer.h"
+
+namespace esphome {
+namespace benchmark {
+
+using namespace display;
+
+/// A 128x64 monochrome display like the SSD1306, the buffer layout of its driver.
+class BenchmarkDisplay : public DisplayBuffer {
+ public:
+  BenchmarkDisplay() { this->init_internal_(WIDTH * HEIGHT / 8); }
+
+ protected:
+  static const int WIDTH = 128;
+  static const int HEIGHT = 64;
+
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+      return;
+    const uint16_t pos = x + (y / 8) * WIDTH;
+    const uint8_t subpos = y & 0x07;
+    if (color.is_on()) {
+      this->buffer_[pos] |= (1 << subpos);
+    } else {
+      this->buffer_[pos] &= ~(1 << subpos);
+    }
+  }
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+};
+
+static void bm_display_fill(State &state) {
+  BenchmarkDisplay display;
+  for (auto _ : state) {
+    display.fill(COLOR_ON);
+    clobber_memory();
+  }
+}
+BENCHMARK(bm_display_fill);
+
+static void bm_display_line(State &state) {
+  BenchmarkDisplay display;
+  int i = 0;
+  for (auto _ : state) {
+    display.line(0, i % 64, 127, 63 - i % 64);
+    i++;
+  }
+}
+BENCHMARK(bm_display_line);
+
+static void bm_display_filled_rectangle(State &state) {
+  BenchmarkDisplay display;
+  for (auto _ : state)
+    display.filled_rectangle(10, 10, 100, 40);
+}
+BENCHMARK(bm_display_filled_rectangle);
+
+static void bm_display_circle(State &state) {
+  BenchmarkDisplay display;
+  for (auto _ : state)
+    display.circle(64, 32, 30);
+}
+BENCHMARK(bm_display_circle);
+
+static void bm_display_filled_circle(State &state) {
+  BenchmarkDisplay display;
+  for (auto _ : state)
+    display.filled_circle(64, 32, 30);
+}
+BENCHMARK(bm_display_filled_circle);
+
+/// Draw a 32x32 binary icon, like weather or status icons.
+static void bm_display_image_binary(State &state) {
+  BenchmarkDisplay display;
+  static uint8_t data[32 * 32 / 8];
+  for (size_t i = 0; i < sizeof(data); i++)
+    data[i] = i * 37;
+  Image image(data, 32, 32, IMAGE_TYPE_BINARY);
+  for (auto _ : state)
+    display.image(48, 16, &image);
+}
+BENCHMARK(bm_display_image_binary);
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,40 @@
+#include "benchmark.h"
+#include "esphome/components/json/json_reader.h"
+#include <cstring>
+
+namespace esphome {
+namespace benchmark {
+
+/// Reading an MQTT light command the way LightCall::parse_json() does, once per light of a scene.
+static void bm_json_read_light_command(State &state) {
+  const char *payload = R"({"state":"ON","brightness":180,"color":{"r":255,"g":120,"b":40},"transition":2.5,)"
+                        R"("effect":"None"})";
+  const size_t len = strlen(payload);
+  for (auto _ : state) {
+    json::JsonReader reader(payload, len);
+    StringRef key;
+    float sum = 0.0f, value;
+    char text[64];
+    reader.begin_object();
+    while (reader.next_key(&key)) {
+      if (key == "state" || key == "effect") {
+        reader.read_string(text, sizeof(text));
+      } else if (key == "color") {
+        reader.begin_object();
+        while (reader.next_key(&key)) {
+          if (reader.read_float(&value))
+            sum += value;
+        }
+      } else if (reader.read_float(&value)) {
+        sum += value;
+      }
+    }
+    do_not_optimize(sum);
+    do_not_optimize(reader.finish());
+  }
+  state.set_items_processed(state.iterations() * len);
+}
+BENCHMARK(bm_json_read_light_command);
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,73 @@
+#include "benchmark.h"
+#include "esphome/components/light/light_color_values.h"
+#include "esphome/core/color.h"
+
+namespace esphome {
+namespace benchmark {
+
+using namespace light;
+
+/// One step of a transition, run for every light in every loop iteration while it transitions.
+static void bm_light_color_lerp(State &state) {
+  const LightColorValues start(true, 0.2f, 1.0f, 0.0f, 0.0f, 0.0f, 300.0f);
+  const LightColorValues end(true, 1.0f, 0.0f, 0.5f, 1.0f, 1.0f, 400.0f);
+  float completion = 0.0f;
+  for (auto _ : state) {
+    auto values = LightColorValues::lerp(start, end, completion);
+    completion = completion >= 1.0f ? 0.0f : completion + 0.001f;
+    do_not_optimize(values);
+  }
+}
+BENCHMARK(bm_light_color_lerp);
+
+static void bm_light_as_rgbw_gamma_powf(State &state) {
+  const LightColorValues values(true, 0.7f, 1.0f, 0.5f, 0.25f, 0.1f, 300.0f);
+  for (auto _ : state) {
+    float red, green, blue, white;
+    values.as_rgbw(&red, &green, &blue, &white, 2.8f);
+    do_not_optimize(red + green + blue + white);
+  }
+}
+BENCHMARK(bm_light_as_rgbw_gamma_powf);
+
+static void bm_light_as_rgbw_gamma_table(State &state) {
+  const LightColorValues values(true, 0.7f, 1.0f, 0.5f, 0.25f, 0.1f, 300.0f);
+  LightGammaTable gamma;
+  gamma.calculate(2.8f);
+  for (auto _ : state) {
+    float red, green, blue, white;
+    values.as_rgbw(&red, &green, &blue, &white, gamma);
+    do_not_optimize(red + green + blue + white);
+  }
+}
+BENCHMARK(bm_light_as_rgbw_gamma_table);
+
+static void bm_light_as_rgbww(State &state) {
+  const LightColorValues values(true, 0.7f, 1.0f, 0.5f, 0.25f, 0.1f, 300.0f);
+  LightGammaTable gamma;
+  gamma.calculate(2.8f);
+  for (auto _ : state) {
+    float red, green, blue, cold_white, warm_white;
+    values.as_rgbww(153.0f, 500.0f, &red, &green, &blue, &cold_white, &warm_white, gamma);
+    do_not_optimize(red + green + blue + cold_white + warm_white);
+  }
+}
+BENCHMARK(bm_light_as_rgbww);
+
+/// Blending the colors of a strip, what addressable effects do per LED.
+static void bm_light_color_blend_strip(State &state) {
+  std::vector<Color> leds(150, Color(0xFF8040));
+  Color target(0x2040FF);
+  uint8_t amount = 0;
+  for (auto _ : state) {
+    for (auto &led : leds)
+      led = led.fade_to_black(255 - amount) + target.fade_to_black(amount);
+    amount++;
+    clobber_memory();
+  }
+  state.set_items_processed(state.iterations() * leds.size());
+}
+BENCHMARK(bm_light_color_blend_strip);
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,45 @@
+#include "benchmark.h"
+#include "esphome/components/logger/tag_levels.h"
+
+namespace esphome {
+namespace benchmark {
+
+using namespace logger;
+
+static const char *const OVERRIDDEN_TAGS[] = {"sensor", "api", "mqtt", "wifi", "light",     "dallas",
+                                              "uart",   "i2c", "sntp", "ota",  "scheduler", "component"};
+/// A tag without an override, which had to be compared to all of them.
+static const char *const TAG = "template.sensor";
+
+class ScanTagLevels : public TagLevels {
+ public:
+  int scan(const char *tag) { return this->find_(tag, 5); }
+};
+
+static void setup_overrides(TagLevels &levels) {
+  for (const char *tag : OVERRIDDEN_TAGS)
+    levels.set(tag, 3);
+}
+
+static void bm_logger_tag_level_scan(State &state) {
+  ScanTagLevels levels;
+  setup_overrides(levels);
+  int level = 0;
+  for (auto _ : state)
+    level += levels.scan(TAG);
+  do_not_optimize(level);
+}
+BENCHMARK(bm_logger_tag_level_scan);
+
+static void bm_logger_tag_level_cached(State &state) {
+  TagLevels levels;
+  setup_overrides(levels);
+  int level = 0;
+  for (auto _ : state)
+    level += levels.get(TAG, 5);
+  do_not_optimize(level);
+}
+BENCHMARK(bm_logger_tag_level_cached);
+
+}  // namespace benchmark
+}  // namespace esphome
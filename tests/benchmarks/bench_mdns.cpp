@@ -0,0 +1,61 @@
+#include "benchmark.h"
+#include "esphome/core/mdns_responder.h"
+#include <cstring>
+#include <string>
+
+namespace esphome {
+namespace benchmark {
+
+static MDNSResponder make_responder() {
+  MDNSResponder responder;
+  responder.set_hostname("living-room");
+  responder.add_service("esphomelib", "tcp", 6053,
+                        {"version=1.15.0", "address=living-room.local", "mac=a4cf12d5e6f7"});
+  const uint8_t address[4] = {192, 168, 1, 42};
+  responder.set_address(address, 0);
+  return responder;
+}
+
+static std::string make_browse_query() {
+  std::string query(12, '\0');
+  query[5] = 1;
+  query += std::string("\x0b_esphomelib\x04_tcp\x05local\x00\x00\x0c\x00\x01", 29);
+  return query;
+}
+
+/// A Home Assistant browsing for nodes, each query arrives after the rate limit of the last one is over.
+static void bm_mdns_answer_browse(State &state) {
+  MDNSResponder responder = make_responder();
+  const std::string query = make_browse_query();
+  uint8_t buffer[512];
+  uint32_t now = 0;
+  for (auto _ : state) {
+    memcpy(buffer, query.data(), query.size());
+    now += 1000;
+    bool unicast;
+    do_not_optimize(responder.answer(buffer, query.size(), sizeof(buffer), now, false, now, &unicast));
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(bm_mdns_answer_browse);
+
+/// The same query from a browser that lists the node as a known answer, which is suppressed.
+static void bm_mdns_suppress_known_answer(State &state) {
+  MDNSResponder responder = make_responder();
+  std::string query = make_browse_query();
+  query[7] = 1;
+  query += std::string("\xc0\x0c\x00\x0c\x00\x01\x00\x00\x11\x94\x00\x0e\x0bliving-room\xc0\x0c", 26);
+  uint8_t buffer[512];
+  uint32_t now = 0;
+  for (auto _ : state) {
+    memcpy(buffer, query.data(), query.size());
+    now += 1000;
+    bool unicast;
+    do_not_optimize(responder.answer(buffer, query.size(), sizeof(buffer), now, false, now, &unicast));
+  }
+  state.set_items_processed(state.iterations());
+}
+BENCHMARK(bm_mdns_suppress_known_answer);
+
+}  // namespace benchmark
+}  // namespace esphome
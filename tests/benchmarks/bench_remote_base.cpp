@@ -0,0 +1,79 @@
+#include "benchmark.h"
+#include "esphome/components/remote_base/nec_protocol.h"
+#include "esphome/components/remote_base/rc5_protocol.h"
+#include "esphome/components/remote_base/sony_protocol.h"
+
+namespace esphome {
+namespace benchmark {
+
+using namespace remote_base;
+
+static const uint8_t TOLERANCE = 25;
+
+static void bm_remote_nec_encode(State &state) {
+  NECProtocol protocol;
+  RemoteTransmitData data;
+  const NECData nec{0x1234, 0x78};
+  for (auto _ : state) {
+    data.reset();
+    protocol.encode(&data, nec);
+    do_not_optimize(data.get_data().data());
+  }
+}
+BENCHMARK(bm_remote_nec_encode);
+
+static void bm_remote_nec_decode(State &state) {
+  NECProtocol protocol;
+  RemoteTransmitData data;
+  protocol.encode(&data, NECData{0x1234, 0x78});
+  std::vector<int32_t> raw = data.get_data();
+  for (auto _ : state) {
+    auto decoded = protocol.decode(RemoteReceiveData(&raw, TOLERANCE));
+    do_not_optimize(decoded);
+  }
+}
+BENCHMARK(bm_remote_nec_decode);
+
+static void bm_remote_sony_decode(State &state) {
+  SonyProtocol protocol;
+  RemoteTransmitData data;
+  protocol.encode(&data, SonyData{0xA90, 12});
+  std::vector<int32_t> raw = data.get_data();
+  for (auto _ : state) {
+    auto decoded = protocol.decode(RemoteReceiveData(&raw, TOLERANCE));
+    do_not_optimize(decoded);
+  }
+}
+BENCHMARK(bm_remote_sony_decode);
+
+static void bm_remote_rc5_decode(State &state) {
+  RC5Protocol protocol;
+  RemoteTransmitData data;
+  protocol.encode(&data, RC5Data{0x05, 0x35});
+  std::vector<int32_t> raw = data.get_data();
+  for (auto _ : state) {
+    auto decoded = protocol.decode(RemoteReceiveData(&raw, TOLERANCE));
+    do_not_optimize(decoded);
+  }
+}
+BENCHMARK(bm_remote_rc5_decode);
+
+/// A receiver tries every protocol on each capture, most of them reject it right away.
+static void bm_remote_decode_mismatch(State &state) {
+  NECProtocol nec;
+  SonyProtocol sony;
+  RC5Protocol rc5;
+  RemoteTransmitData data;
+  nec.encode(&data, NECData{0x1234, 0x78});
+  std::vector<int32_t> raw = data.get_data();
+  for (auto _ : state) {
+    auto sony_decoded = sony.decode(RemoteReceiveData(&raw, TOLERANCE));
+    auto rc5_decoded = rc5.decode(RemoteReceiveData(&raw, TOLERANCE));
+    do_not_optimize(sony_decoded);
+    do_not_optimize(rc5_decoded);
+  }
+}
+BENCHMARK(bm_remote_decode_mismatch);
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,63 @@
+#include "benchmark.h"
+#include "esphome/core/scheduler.h"
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace benchmark {
+
+static const uint32_t PENDING_ITEMS = 32;
+
+/// Schedule a named timeout and cancel it again, the path of every retriggered timeout.
+static void bm_scheduler_set_cancel_timeout(State &state) {
+  Scheduler scheduler;
+  Component component;
+  for (auto _ : state) {
+    scheduler.set_timeout(&component, "timeout", 1000, []() {});
+    scheduler.cancel_timeout(&component, "timeout");
+    // the loop runs the scheduler in between, which cleans up cancelled items
+    scheduler.call();
+  }
+}
+BENCHMARK(bm_scheduler_set_cancel_timeout);
+
+/// Replace a named timeout while others are pending, set_timeout() has to find and cancel the old one.
+static void bm_scheduler_replace_timeout(State &state) {
+  Scheduler scheduler;
+  Component component;
+  for (uint32_t i = 0; i < PENDING_ITEMS; i++)
+    scheduler.set_interval(&component, "interval" + std::to_string(i), 60000 + i, []() {});
+  scheduler.call();
+  for (auto _ : state) {
+    scheduler.set_timeout(&component, "timeout", 1000, []() {});
+    scheduler.call();
+  }
+}
+BENCHMARK(bm_scheduler_replace_timeout);
+
+/// A loop iteration of the scheduler with intervals pending but none of them due.
+static void bm_scheduler_call_idle(State &state) {
+  Scheduler scheduler;
+  Component component;
+  for (uint32_t i = 0; i < PENDING_ITEMS; i++)
+    scheduler.set_interval(&component, "interval" + std::to_string(i), 60000 + i, []() {});
+  scheduler.call();
+  for (auto _ : state)
+    scheduler.call();
+}
+BENCHMARK(bm_scheduler_call_idle);
+
+/// Schedule a timeout that is due right away and run it.
+static void bm_scheduler_timeout_fire(State &state) {
+  Scheduler scheduler;
+  Component component;
+  uint32_t fired = 0;
+  for (auto _ : state) {
+    scheduler.set_timeout(&component, "", 0, [&fired]() { fired++; });
+    scheduler.call();
+  }
+  do_not_optimize(fired);
+}
+BENCHMARK(bm_scheduler_timeout_fire);
+
+}  // namespace benchmark
+}  // namespace esphome
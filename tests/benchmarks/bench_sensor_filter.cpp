@@ -0,0 +1,69 @@
+#include "benchmark.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/sensor/filter.h"
+
+namespace esphome {
+namespace benchmark {
+
+using namespace sensor;
+
+/// A sine wave with some noise, so that filters see varying values.
+static float sample(uint32_t i) { return 20.0f + 5.0f * sinf(i * 0.01f) + (i % 7) * 0.1f; }
+
+static void bm_sensor_publish_no_filter(State &state) {
+  Sensor sens;
+  uint32_t i = 0;
+  for (auto _ : state)
+    sens.publish_state(sample(i++));
+  do_not_optimize(sens.state);
+}
+BENCHMARK(bm_sensor_publish_no_filter);
+
+static void bm_sensor_filter_sliding_window_average(State &state) {
+  Sensor sens;
+  sens.add_filter(new SlidingWindowMovingAverageFilter(15, 1, 1));  // NOLINT
+  uint32_t i = 0;
+  for (auto _ : state)
+    sens.publish_state(sample(i++));
+  do_not_optimize(sens.state);
+}
+BENCHMARK(bm_sensor_filter_sliding_window_average);
+
+static void bm_sensor_filter_exponential_average(State &state) {
+  Sensor sens;
+  sens.add_filter(new ExponentialMovingAverageFilter(0.1f, 1));  // NOLINT
+  uint32_t i = 0;
+  for (auto _ : state)
+    sens.publish_state(sample(i++));
+  do_not_optimize(sens.state);
+}
+BENCHMARK(bm_sensor_filter_exponential_average);
+
+static void bm_sensor_filter_median(State &state) {
+  Sensor sens;
+  sens.add_filter(new MedianFilter(15, 1, 1));  // NOLINT
+  uint32_t i = 0;
+  for (auto _ : state)
+    sens.publish_state(sample(i++));
+  do_not_optimize(sens.state);
+}
+BENCHMARK(bm_sensor_filter_median);
+
+/// A typical chain: calibrate, drop outliers, average and only pass on changes.
+static void bm_sensor_filter_chain(State &state) {
+  Sensor sens;
+  sens.add_filters({
+      new CalibrateLinearFilter(1.02f, -0.5f),        // NOLINT
+      new FilterOutValueFilter(0.0f),                 // NOLINT
+      new SlidingWindowMovingAverageFilter(5, 1, 1),  // NOLINT
+      new DeltaFilter(0.05f),                         // NOLINT
+  });
+  uint32_t i = 0;
+  for (auto _ : state)
+    sens.publish_state(sample(i++));
+  do_not_optimize(sens.state);
+}
+BENCHMARK(bm_sensor_filter_chain);
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,62 @@
+#include "benchmark.h"
+#include "esphome/components/spectrum/fft.h"
+#include <cmath>
+#include <vector>
+
+namespace esphome {
+namespace benchmark {
+
+static const size_t FFT_SIZE = 1024;
+
+static void fill_signal(float *data, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    data[i] = sinf(i * 0.3f) + 0.1f * sinf(i * 0.9f);
+}
+
+static void bm_spectrum_real_fft_1024(State &state) {
+  std::vector<float> signal(FFT_SIZE);
+  fill_signal(signal.data(), FFT_SIZE);
+  std::vector<float> data(FFT_SIZE);
+  for (auto _ : state) {
+    data = signal;
+    spectrum::real_fft(data.data(), FFT_SIZE);
+    clobber_memory();
+  }
+  do_not_optimize(data[1]);
+}
+BENCHMARK(bm_spectrum_real_fft_1024);
+
+/// The same transform with the imaginary parts set to zero, what real_fft() saves.
+static void bm_spectrum_complex_fft_1024(State &state) {
+  std::vector<float> signal(FFT_SIZE * 2);
+  fill_signal(signal.data(), FFT_SIZE);
+  for (size_t i = FFT_SIZE; i-- > 0;) {
+    signal[2 * i] = signal[i];
+    signal[2 * i + 1] = 0.0f;
+  }
+  std::vector<float> data(FFT_SIZE * 2);
+  for (auto _ : state) {
+    data = signal;
+    spectrum::complex_fft(data.data(), FFT_SIZE);
+    clobber_memory();
+  }
+  do_not_optimize(data[1]);
+}
+BENCHMARK(bm_spectrum_complex_fft_1024);
+
+static void bm_spectrum_hann_window_1024(State &state) {
+  std::vector<float> signal(FFT_SIZE);
+  fill_signal(signal.data(), FFT_SIZE);
+  std::vector<float> data(FFT_SIZE);
+  for (auto _ : state) {
+    // windowing the same data over and over would end in denormals
+    data = signal;
+    spectrum::apply_hann_window(data.data(), FFT_SIZE);
+    clobber_memory();
+  }
+  do_not_optimize(data[1]);
+}
+BENCHMARK(bm_spectrum_hann_window_1024);
+
+}  // namespace benchmark
+}  // namespace esphome
@@ -0,0 +1,140 @@
+#include "benchmark.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+namespace esphome {
+namespace benchmark {
+
+static uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+State::Iterator State::begin() {
+  this->start_ns_ = now_ns();
+  return Iterator{this, this->iterations_};
+}
+void State::stop_timer_() { this->end_ns_ = now_ns(); }
+
+std::vector<Benchmark> &get_benchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct Options {
+  const char *filter{nullptr};
+  double min_time{0.5};
+  bool csv{false};
+  const char *baseline{nullptr};
+  double max_regression{10.0};
+};
+
+/// Run the benchmark with more and more iterations until a run takes at least the minimum time, in ns per item.
+static double run_benchmark(const Benchmark &bm, const Options &options, uint64_t *iterations) {
+  const uint64_t min_ns = options.min_time * 1e9;
+  uint64_t n = 1;
+  while (true) {
+    State state(n);
+    bm.func(state);
+    const uint64_t elapsed = state.get_elapsed_ns();
+    if (elapsed >= min_ns || n >= 1000000000ULL) {
+      *iterations = n;
+      return double(elapsed) / double(state.get_items_processed());
+    }
+    // aim a bit above the minimum time, but grow at most tenfold per run
+    const double factor = elapsed == 0 ? 10.0 : std::min(10.0, 1.4 * double(min_ns) / double(elapsed));
+    n = std::max(n + 1, uint64_t(double(n) * factor));
+  }
+}
+
+/// Read the "name,ns_per_item,iterations" lines written with --csv.
+static std::map<std::string, double> load_baseline(const char *path) {
+  std::map<std::string, double> baseline;
+  FILE *file = fopen(path, "r");
+  if (file == nullptr) {
+    fprintf(stderr, "Could not open baseline %s\n", path);
+    exit(2);
+  }
+  char line[256];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    char *comma = strchr(line, ',');
+    if (comma == nullptr || strncmp(line, "name,", 5) == 0)
+      continue;
+    *comma = '\0';
+    baseline[line] = atof(comma + 1);
+  }
+  fclose(file);
+  return baseline;
+}
+
+static void print_usage(const char *program) {
+  printf("Usage: %s [--filter=<substring>] [--min-time=<seconds>] [--csv]\n", program);
+  printf("          [--baseline=<csv of an earlier run>] [--max-regression=<percent>]\n");
+}
+
+int main(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strncmp(arg, "--filter=", 9) == 0) {
+      options.filter = arg + 9;
+    } else if (strncmp(arg, "--min-time=", 11) == 0) {
+      options.min_time = atof(arg + 11);
+    } else if (strcmp(arg, "--csv") == 0) {
+      options.csv = true;
+    } else if (strncmp(arg, "--baseline=", 11) == 0) {
+      options.baseline = arg + 11;
+    } else if (strncmp(arg, "--max-regression=", 17) == 0) {
+      options.max_regression = atof(arg + 17);
+    } else {
+      print_usage(argv[0]);
+      return strcmp(arg, "--help") == 0 ? 0 : 2;
+    }
+  }
+
+  std::map<std::string, double> baseline;
+  if (options.baseline != nullptr)
+    baseline = load_baseline(options.baseline);
+
+  if (options.csv) {
+    printf("name,ns_per_item,iterations\n");
+  } else {
+    printf("%-44s %14s %12s %10s\n", "Benchmark", "ns/item", "Iterations", "Change");
+  }
+
+  int regressions = 0;
+  for (const auto &bm : get_benchmarks()) {
+    if (options.filter != nullptr && bm.name.find(options.filter) == std::string::npos)
+      continue;
+    uint64_t iterations;
+    const double ns = run_benchmark(bm, options, &iterations);
+
+    char change[16] = "";
+    auto it = baseline.find(bm.name);
+    if (it != baseline.end() && it->second > 0) {
+      const double percent = (ns / it->second - 1.0) * 100.0;
+      snprintf(change, sizeof(change), "%+.1f%%", percent);
+      if (percent > options.max_regression) {
+        regressions++;
+        fprintf(stderr, "%s regressed by %.1f%% (%.2f ns -> %.2f ns)\n", bm.name.c_str(), percent, it->second, ns);
+      }
+    }
+
+    if (options.csv) {
+      printf("%s,%.3f,%llu\n", bm.name.c_str(), ns, (unsigned long long) iterations);
+    } else {
+      printf("%-44s %14.2f %12llu %10s\n", bm.name.c_str(), ns, (unsigned long long) iterations, change);
+    }
+    fflush(stdout);
+  }
+  return regressions == 0 ? 0 : 1;
+}
+
+}  // namespace benchmark
+}  // namespace esphome
+
+int main(int argc, char **argv) { return esphome::benchmark::main(argc, argv); }
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace benchmark {
+
+/** The state passed to a benchmark, loosely modeled after Google Benchmark.
+ *
+ * Only the body of the range-based for loop over the state is timed, setup before the loop isn't:
+ *
+ * ```cpp
+ * void bm_something(benchmark::State &state) {
+ *   // setup
+ *   for (auto _ : state) {
+ *     // the code to measure
+ *   }
+ * }
+ * BENCHMARK(bm_something);
+ * ```
+ */
+class State {
+ public:
+  explicit State(uint64_t iterations) : iterations_(iterations) {}
+
+  struct Iterator {
+    State *state;
+    uint64_t remaining;
+    /// The loop variable, an empty type marked unused so that it neither costs anything nor causes warnings.
+    struct __attribute__((unused)) Value {};
+    Value operator*() const { return {}; }
+    Iterator &operator++() {
+      this->remaining--;
+      return *this;
+    }
+    bool operator!=(const Iterator &other) const {
+      if (this->remaining != other.remaining)
+        return true;
+      this->state->stop_timer_();
+      return false;
+    }
+  };
+
+  /// Starts the timer, the loop ending stops it.
+  Iterator begin();
+  Iterator end() { return Iterator{this, 0}; }
+
+  uint64_t iterations() const { return this->iterations_; }
+  /// Set how many items all iterations processed together, to report the time per item instead of per iteration.
+  void set_items_processed(uint64_t items) { this->items_processed_ = items; }
+
+  uint64_t get_items_processed() const {
+    return this->items_processed_ == 0 ? this->iterations_ : this->items_processed_;
+  }
+  uint64_t get_elapsed_ns() const { return this->end_ns_ - this->start_ns_; }
+
+ protected:
+  void stop_timer_();
+
+  uint64_t iterations_;
+  uint64_t items_processed_{0};
+  uint64_t start_ns_{0};
+  uint64_t end_ns_{0};
+};
+
+using benchmark_func_t = void (*)(State &);
+
+struct Benchmark {
+  std::string name;
+  benchmark_func_t func;
+};
+
+/// All benchmarks registered with BENCHMARK(), in the order of registration.
+std::vector<Benchmark> &get_benchmarks();
+
+struct Registration {
+  Registration(const char *name, benchmark_func_t func) { get_benchmarks().push_back(Benchmark{name, func}); }
+};
+
+/// Keep the compiler from optimizing away the computation of value.
+template<typename T> inline void do_not_optimize(T const &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+/// Keep the compiler from optimizing away stores to memory.
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+}  // namespace benchmark
+}  // namespace esphome
+
+#define BENCHMARK(func) static ::esphome::benchmark::Registration benchmark_registration_##func(#func, func)
@@ -0,0 +1,59 @@
+#pragma once
+
+// A minimal stand-in for the Arduino core, just enough to build the ESPHome core on the host.
+// Time is the real monotonic clock of the host, GPIOs are plain memory and interrupts don't exist.
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <math.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Esp.h"
+
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+
+static const uint8_t INPUT = 0x01;
+static const uint8_t OUTPUT = 0x02;
+static const uint8_t INPUT_PULLUP = 0x05;
+static const uint8_t OUTPUT_OPEN_DRAIN = 0x12;
+static const uint8_t SPECIAL = 0xF0;
+static const uint8_t FUNCTION_1 = 0x00;
+static const uint8_t FUNCTION_2 = 0x20;
+static const uint8_t FUNCTION_3 = 0x40;
+static const uint8_t FUNCTION_4 = 0x60;
+
+static const uint8_t LOW = 0x0;
+static const uint8_t HIGH = 0x1;
+static const uint8_t RISING = 0x01;
+static const uint8_t FALLING = 0x02;
+static const uint8_t CHANGE = 0x03;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+uint32_t millis();
+uint32_t micros();
+uint64_t micros64();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);      // NOLINT
+void digitalWrite(uint8_t pin, uint8_t val);  // NOLINT
+int digitalRead(uint8_t pin);                 // NOLINT
+
+/// The input register of the simulated GPIOs, GPIOPin reads it like the hardware registers.
+extern volatile uint32_t host_gpio_in;  // NOLINT
+
+uint32_t os_random();
+
+inline double pow10(double x) { return pow(10.0, x); }    // NOLINT
+inline float pow10f(float x) { return powf(10.0f, x); }  // NOLINT
+char *dtostrf(double number, signed char width, unsigned char prec, char *s);
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+/// The ESP object of the Arduino core, restarting the host build exits the process.
+class EspClass {
+ public:
+  void restart();
+  void wdtFeed() {}
+  uint32_t getFreeHeap() { return 0; }
+};
+
+extern EspClass ESP;  // NOLINT
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+class __FlashStringHelper;  // NOLINT
+
+/// Only the parts of the Arduino String the core uses.
+class String : public std::string {
+ public:
+  using std::string::string;
+  String() = default;
+  String(const std::string &str) : std::string(str) {}  // NOLINT
+  const char *c_str() const { return std::string::c_str(); }
+};
@@ -0,0 +1,47 @@
+#include "Arduino.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+static const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+
+uint32_t millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - START).count();
+}
+uint32_t micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+}
+uint64_t micros64() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+}
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+void yield() {}
+
+volatile uint32_t host_gpio_in = 0;  // NOLINT
+
+void pinMode(uint8_t pin, uint8_t mode) {}     // NOLINT
+void digitalWrite(uint8_t pin, uint8_t val) {  // NOLINT
+  if (val) {
+    host_gpio_in |= 1UL << (pin % 32);
+  } else {
+    host_gpio_in &= ~(1UL << (pin % 32));
+  }
+}
+int digitalRead(uint8_t pin) { return (host_gpio_in >> (pin % 32)) & 1; }  // NOLINT
+
+uint32_t os_random() {
+  static std::mt19937 generator(0);  // NOLINT
+  return generator();
+}
+
+char *dtostrf(double number, signed char width, unsigned char prec, char *s) {
+  sprintf(s, "%*.*f", width, prec, number);
+  return s;
+}
+
+EspClass ESP;  // NOLINT
+
+void EspClass::restart() { exit(0); }
@@ -0,0 +1,4 @@
+#pragma once
+
+// On the ESP32 the lwIP options pull in the POSIX time functions, the time component relies on that.
+#include <sys/time.h>
@@ -25,7 +25,7 @@ def test_binary_sensor_sets_mandatory_fields(generate_main):
     main_cpp = generate_main("tests/component_tests/binary_sensor/test_binary_sensor.yaml")
 
     # Then
-    assert "bs_1->set_name(\"test bs1\");" in main_cpp
+    assert "bs_1->set_static_name(\"test bs1\", \"test_bs1\", 3362636122UL);" in main_cpp
     assert "bs_1->set_pin(new GPIOPin" in main_cpp
 
 
@@ -0,0 +1,21 @@
+import pytest
+
+from esphome import build_cache
+
+
+@pytest.mark.parametrize("args, expected", (
+    (["-c", "-Os", "-o", "out/main.o", "src/main.cpp"], (3, 4)),
+    (["-Isrc", "src/a.c", "-c", "-o", "a.o"], (4, 1)),
+    # linking
+    (["-o", "firmware.elf", "main.o", "a.o"], None),
+    # several sources
+    (["-c", "-o", "x.o", "a.cpp", "b.cpp"], None),
+    # response file
+    (["-c", "-o", "x.o", "@args.txt"], None),
+    # missing output path
+    (["-c", "a.cpp", "-o"], None),
+))
+def test_parse_compile_args(args, expected):
+    actual = build_cache.parse_compile_args(args)
+
+    assert actual == expected
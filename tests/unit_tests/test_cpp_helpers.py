@@ -83,3 +83,18 @@ def test_register_component__with_setup_priority(monkeypatch):
     assert add_mock.call_count == 3
     app_mock.register_component.assert_called_with(var)
     assert core_mock.component_ids == []
+
+
+@pytest.mark.parametrize("name, expected", (
+    ("Living Room", "living_room"),
+    ("Temp. (°C)", "temp_c"),
+    ("a-b_c", "a-b_c"),
+))
+def test_entity_object_id(name, expected):
+    assert ch.entity_object_id(name) == expected
+
+
+def test_fnv1_hash():
+    # Same values as fnv1_hash() in esphome/core/helpers.cpp
+    assert ch.fnv1_hash("") == 2166136261
+    assert ch.fnv1_hash("a") == 0x050c5d7e
@@ -0,0 +1,44 @@
+from esphome import yaml_util
+
+
+def test_inputs_unchanged(tmp_path, monkeypatch):
+    monkeypatch.setenv("NODE_PASSWORD", "abc")
+    (tmp_path / "common.yaml").write_text("ssid: !env_var NODE_PASSWORD\n")
+    (tmp_path / "sensors").mkdir()
+    (tmp_path / "sensors" / "a.yaml").write_text("- platform: uptime\n")
+    main = tmp_path / "node.yaml"
+    main.write_text("wifi: !include common.yaml\nsensor: !include_dir_merge_list sensors\n")
+
+    yaml_util.load_yaml(str(main))
+    inputs = yaml_util.loaded_inputs()
+
+    assert set(inputs["files"]) == {str(main), str(tmp_path / "common.yaml"),
+                                    str(tmp_path / "sensors" / "a.yaml")}
+    assert inputs["env"] == {"NODE_PASSWORD": "abc"}
+    assert yaml_util.inputs_unchanged(inputs)
+
+
+def test_inputs_changed(tmp_path, monkeypatch):
+    monkeypatch.setenv("NODE_PASSWORD", "abc")
+    (tmp_path / "common.yaml").write_text("ssid: !env_var NODE_PASSWORD\n")
+    (tmp_path / "sensors").mkdir()
+    main = tmp_path / "node.yaml"
+    main.write_text("wifi: !include common.yaml\nsensor: !include_dir_merge_list sensors\n")
+
+    yaml_util.load_yaml(str(main))
+    inputs = yaml_util.loaded_inputs()
+
+    # a new file in an included directory
+    (tmp_path / "sensors" / "b.yaml").write_text("- platform: uptime\n")
+    assert not yaml_util.inputs_unchanged(inputs)
+    (tmp_path / "sensors" / "b.yaml").unlink()
+    assert yaml_util.inputs_unchanged(inputs)
+
+    # an included file
+    (tmp_path / "common.yaml").write_text("ssid: other\n")
+    assert not yaml_util.inputs_unchanged(inputs)
+    (tmp_path / "common.yaml").write_text("ssid: !env_var NODE_PASSWORD\n")
+
+    # an environment variable
+    monkeypatch.setenv("NODE_PASSWORD", "def")
+    assert not yaml_util.inputs_unchanged(inputs)